@@ -0,0 +1,11 @@
+include(FetchContent)
+FetchContent_Declare(benchmark-module
+	GIT_REPOSITORY https://github.com/google/benchmark
+	GIT_TAG        v1.8.3
+	GIT_SHALLOW    TRUE
+	GIT_PROGRESS   TRUE
+)
+
+set(BENCHMARK_ENABLE_TESTING OFF CACHE INTERNAL "")
+set(BENCHMARK_ENABLE_INSTALL OFF CACHE INTERNAL "")
+FetchContent_MakeAvailable(benchmark-module)
@@ -30,6 +30,10 @@ else()
 		NAMES sundials_kinsol
 	)
 
+	find_library(SUNDIALS_SUNLINSOLKLU_LIBRARY
+		NAMES sundials_sunlinsolklu
+	)
+
 	set(SUNDIALS_LIBRARIES
 		${SUNDIALS_ARKODE_LIBRARY}
 		${SUNDIALS_CVODE_LIBRARY}
@@ -39,6 +43,11 @@ else()
 		${SUNDIALS_KINSOL_LIBRARY}
 	)
 
+	if(SUNDIALS_SUNLINSOLKLU_LIBRARY)
+		set(SundialsKLU_FOUND ON)
+		list(APPEND SUNDIALS_LIBRARIES ${SUNDIALS_SUNLINSOLKLU_LIBRARY})
+	endif()
+
 	include(FindPackageHandleStandardArgs)
 	find_package_handle_standard_args(Sundials DEFAULT_MSG SUNDIALS_ARKODE_LIBRARY SUNDIALS_INCLUDE_DIR)
 
@@ -9,6 +9,8 @@
 #pragma once
 #include <iostream>
 #include <set>
+#include <cstring>
+#include <type_traits>
 
 #include <dpsim-models/Definitions.h>
 #include <dpsim-models/PtrFactory.h>
@@ -40,6 +42,34 @@ namespace CPS {
 	template<class T>
 	class AttributeDynamic;
 
+	/**
+	 * Conversion of attribute values from and to raw bytes, used to move values through queues and shared memory.
+	 * Trivially copyable types and Eigen matrices of them are supported, the size of other types is zero.
+	 * Matrices are converted without their dimensions, so both sides have to agree on them beforehand.
+	 * */
+	template<typename T, typename Enable = void>
+	struct AttributeValueBytes {
+		static std::size_t size(const T& value) { return 0; }
+		static void write(const T& value, unsigned char* data) { }
+		static void read(T& value, const unsigned char* data) { }
+	};
+
+	template<typename T>
+	struct AttributeValueBytes<T, std::enable_if_t<std::is_trivially_copyable<T>::value>> {
+		static std::size_t size(const T& value) { return sizeof(T); }
+		static void write(const T& value, unsigned char* data) { std::memcpy(data, &value, sizeof(T)); }
+		static void read(T& value, const unsigned char* data) { std::memcpy(&value, data, sizeof(T)); }
+	};
+
+	template<typename Scalar, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+	struct AttributeValueBytes<Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols>,
+		std::enable_if_t<std::is_trivially_copyable<Scalar>::value>> {
+		using Type = Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols>;
+		static std::size_t size(const Type& value) { return static_cast<std::size_t>(value.size()) * sizeof(Scalar); }
+		static void write(const Type& value, unsigned char* data) { std::memcpy(data, value.data(), size(value)); }
+		static void read(Type& value, const unsigned char* data) { std::memcpy(value.data(), data, size(value)); }
+	};
+
 	/**
 	 * Custom pointer class for storing attributes as member variables and in the `mAttributes` attribute map.
 	 * Using this type over the normal `std::shared_ptr` allows for disabling certain operator overloads, e.g. the comparison with the nullptr / the number 0
@@ -53,14 +83,13 @@ namespace CPS {
 
 			AttributePointer() : mPtr() {};
 			AttributePointer(const AttributePointer& r) = default;
+			AttributePointer(AttributePointer&& r) noexcept = default;
 			AttributePointer(std::shared_ptr<T> ptr) : mPtr(ptr) {};
 			AttributePointer(std::nullptr_t ptr) : mPtr(ptr) {};
 			explicit AttributePointer(T *ptr) : mPtr(ptr) {};
 
 			template<class U>
-			AttributePointer(AttributePointer<U> ptr) : mPtr() {
-				this->mPtr = ptr.getPtr();
-			};
+			AttributePointer(const AttributePointer<U>& ptr) : mPtr(ptr.getPtr()) {};
 
 			template<class U>
 			AttributePointer(std::shared_ptr<U> ptr) : mPtr(ptr) {};
@@ -76,8 +105,8 @@ namespace CPS {
 				return *this;
 			};
 
-			AttributePointer& operator=(AttributePointer&& r) {
-				this->mPtr = r.getPtr();
+			AttributePointer& operator=(AttributePointer&& r) noexcept {
+				this->mPtr = std::move(r.mPtr);
 				return *this;
 			}
 
@@ -135,6 +164,42 @@ namespace CPS {
 			std::shared_ptr<T> mPtr;
 	};
 
+	/**
+	 * Non-owning reference to an attribute for the hot path of scheduled tasks.
+	 * Copying a handle does not touch the reference count of the attribute, which is shared by all threads reading it.
+	 * The attribute is owned by an `AttributePointer` elsewhere (e.g. in the `AttributeList` of a component),
+	 * so a handle must only be used while its owner is alive and the topology does not change anymore.
+	 * */
+	template<class T>
+	class AttributeHandle {
+		public:
+			using element_type = T;
+
+			AttributeHandle() = default;
+
+			template<class U>
+			AttributeHandle(const AttributePointer<U>& ptr) : mPtr(ptr.get()) {};
+
+			T& operator*() const noexcept {
+				return *mPtr;
+			}
+
+			T* operator->() const noexcept {
+				return mPtr;
+			}
+
+			T* get() const noexcept {
+				return mPtr;
+			}
+
+			bool isNull() const {
+				return mPtr == nullptr;
+			}
+
+		private:
+			T* mPtr = nullptr;
+	};
+
 	/**
 	 * Struct providing an (explicit) comparison function for Attribute Pointers. Can be used in STL containers.
 	 * */
@@ -161,6 +226,7 @@ namespace CPS {
 	class AttributeBase {
 	public:
 		typedef AttributePointer<AttributeBase> Ptr;
+		typedef AttributeHandle<AttributeBase> Handle;
 		typedef std::vector<Ptr> List;
 		typedef std::set<Ptr, AttributeCmp<AttributeBase>> Set;
 		typedef std::map<String, Ptr> Map;
@@ -190,12 +256,44 @@ namespace CPS {
 		 */
 		virtual const std::type_info& getType() = 0;
 
+		/**
+		 * @brief Get the number of bytes written by `serializeTo`, which is fixed once the value has its final dimensions
+		 * @return the size in bytes, or 0 if the type can not be converted to bytes
+		 */
+		virtual std::size_t serializedSize() = 0;
+
+		/**
+		 * @brief Write the attribute value into `size` bytes at `data` without allocating
+		 * @return true if `size` matches `serializedSize`, false otherwise
+		 */
+		virtual bool serializeTo(unsigned char* data, std::size_t size) = 0;
+
+		/**
+		 * @brief Read the attribute value from `size` bytes at `data`, written by an attribute of the same type and dimensions
+		 * @return true if `size` matches `serializedSize`, false otherwise
+		 */
+		virtual bool deserializeFrom(const unsigned char* data, std::size_t size) = 0;
+
 		/**
 		 * @brief Generates a new attribute of the same type and copies the current value in the heap. Does not copy any dependency relations!
 		 * @return Pointer to the copied attribute
 		 */
 		virtual AttributeBase::Ptr cloneValueOntoNewAttribute() = 0;
 
+		/**
+		 * @brief Get a counter which increases whenever the value is changed by `set` or marked by `markChanged`.
+		 * Dynamic attributes add the versions of the attributes their update tasks depend on. Writes through the reference
+		 * returned by `get` are only counted if they are followed by `markChanged`, so consumers may only skip work on
+		 * unchanged versions for attributes that are known to be written this way, e.g. setpoints and imported values.
+		 * @return the version, which never decreases
+		 */
+		virtual std::size_t version() = 0;
+
+		/**
+		 * @brief Increase the version after the value was changed through the reference returned by `get`
+		 */
+		virtual void markChanged() = 0;
+
 		/**
 		 * Append all dependencies of this attribute to the given set.
 		 * For static attributes, this will only append `this`, for dynamic attributes, it will recursively collect and append
@@ -203,6 +301,19 @@ namespace CPS {
 		 * */
 		virtual void appendDependencies(AttributeBase::Set *deps) = 0;
 
+		/**
+		 * Append the attributes this attribute directly depends on, i.e. the dependencies of its update tasks or of the tasks replaced
+		 * by freezing, without following them further. Static attributes have no direct dependencies. The list may contain duplicates.
+		 * */
+		virtual void appendDirectDependencies(AttributeBase::List& deps) = 0;
+
+		/**
+		 * Collapse the reference chains of this attribute into direct accesses of the attribute at the end of the chain.
+		 * A frozen dynamic attribute which references a plain value shares the value's data like a static attribute.
+		 * The references must not be changed afterwards, except by calling `setReference` on the frozen attribute itself.
+		 * */
+		virtual void freeze() = 0;
+
 		/**
 		 * Get a set of all attributes this attribute depends on. For static attributes, this set will only contain `this`.
 		 * For dynamic attributes, this will recursively collect all dependency attributes.
@@ -225,6 +336,10 @@ namespace CPS {
 
 		virtual void executeUpdate(std::shared_ptr<DependentType> &dependent) = 0;
 		virtual AttributeBase::List getDependencies() = 0;
+		/**
+		 * Replaces the dependencies by the attributes at the end of their reference chains.
+		 * */
+		virtual void freeze() { }
 		virtual ~AttributeUpdateTaskBase() = default;
 	};
 
@@ -239,7 +354,7 @@ namespace CPS {
 		public SharedFactory<AttributeUpdateTask<DependentType, DependencyTypes...>> {
 
 	public:
-		using Actor = std::function<void(std::shared_ptr<DependentType>&, typename Attribute<DependencyTypes>::Ptr...)>;
+		using Actor = std::function<void(std::shared_ptr<DependentType>&, const typename Attribute<DependencyTypes>::Ptr&...)>;
 
 	protected:
 		std::tuple<typename Attribute<DependencyTypes>::Ptr...> mDependencies;
@@ -251,7 +366,20 @@ namespace CPS {
 			: mDependencies(std::forward<typename Attribute<DependencyTypes>::Ptr>(dependencies)...), mActorFunction(actorFunction), mKind(kind) {}
 
 		virtual void executeUpdate(std::shared_ptr<DependentType> &dependent) override {
-			mActorFunction(dependent, std::get<typename Attribute<DependencyTypes>::Ptr...>(mDependencies));
+			std::apply([this, &dependent](const auto&... dependencies) {
+				mActorFunction(dependent, dependencies...);
+			}, mDependencies);
+		}
+
+		/**
+		 * Only the getters are frozen, because a setter on the end of a reference chain would also run its update tasks.
+		 * */
+		virtual void freeze() override {
+			if (mKind != UpdateTaskKind::UPDATE_ON_GET)
+				return;
+			std::apply([](auto&... dependencies) {
+				((dependencies = dependencies->resolveReference()), ...);
+			}, mDependencies);
 		}
 
 		/**
@@ -264,6 +392,40 @@ namespace CPS {
 		};
 	};
 
+	/**
+	 * Update task of `setReference`, which makes the dependent attribute share the data of the referenced attribute.
+	 * */
+	template<class T>
+	class AttributeReferenceTask :
+		public AttributeUpdateTaskBase<T>,
+		public SharedFactory<AttributeReferenceTask<T>> {
+
+	protected:
+		typename Attribute<T>::Ptr mReference;
+
+	public:
+		AttributeReferenceTask(typename Attribute<T>::Ptr reference) : mReference(reference) {}
+
+		virtual void executeUpdate(std::shared_ptr<T> &dependent) override {
+			dependent = mReference->asRawPointer();
+		}
+
+		virtual AttributeBase::List getDependencies() override {
+			return AttributeBase::List({mReference});
+		}
+
+		virtual void freeze() override {
+			mReference = mReference->resolveReference();
+		}
+
+		/**
+		 * @return The referenced attribute
+		 * */
+		typename Attribute<T>::Ptr reference() const {
+			return mReference;
+		}
+	};
+
 	/**
 	 * Main Attribute class. The template class `T` holds the attribute's type. This is used as the type for all attribute member variables.
 	 * @param T The type of this attribute
@@ -275,10 +437,13 @@ namespace CPS {
 
 	protected:
 		std::shared_ptr<T> mData;
+		/// Number of changes of the value, see `version`
+		std::size_t mVersion = 0;
 
 	public:
 		using Type = T;
 		using Ptr = AttributePointer<Attribute<T>>;
+		using Handle = AttributeHandle<Attribute<T>>;
 
 		Attribute(T initialValue = T()) :
 			AttributeBase(), mData(std::make_shared<T>()) {
@@ -310,6 +475,12 @@ namespace CPS {
 		 * */
 		virtual std::shared_ptr<T> asRawPointer() = 0;
 
+		/**
+		 * Follow the `setReference` relations starting at this attribute.
+		 * @return The first attribute in the chain which does not only reference another attribute
+		 * */
+		virtual Attribute<T>::Ptr resolveReference() = 0;
+
 		/// Fallback method for all attribute types not covered by the specifications in Attribute.cpp
 		String toString() override {
 			std::stringstream ss;
@@ -342,11 +513,11 @@ namespace CPS {
 		 * @return true if the copy operation was successful, false otherwise
 		 */
 		bool copyValue(AttributeBase::Ptr copyFrom) override {
-			Attribute<T>::Ptr copyFromTyped = std::dynamic_pointer_cast<Attribute<T>>(copyFrom.getPtr());
-			if (copyFromTyped.getPtr() == nullptr) {
+			// Comparing the types avoids the cast and the reference counting of a shared pointer
+			if (copyFrom.isNull() || copyFrom->getType() != typeid(T)) {
 				return false;
 			}
-			this->set(**copyFromTyped);
+			this->set(static_cast<Attribute<T>*>(copyFrom.get())->get());
 			return true;
 		}
 
@@ -358,6 +529,40 @@ namespace CPS {
 			return typeid(T);
 		}
 
+		void markChanged() override {
+			++mVersion;
+		}
+
+		std::size_t serializedSize() override {
+			return AttributeValueBytes<T>::size(this->get());
+		}
+
+		bool serializeTo(unsigned char* data, std::size_t size) override {
+			const T& value = this->get();
+			if (size == 0 || size != AttributeValueBytes<T>::size(value))
+				return false;
+			AttributeValueBytes<T>::write(value, data);
+			return true;
+		}
+
+		bool deserializeFrom(const unsigned char* data, std::size_t size) override {
+			// Dynamic attributes have to pass the value to their setters
+			if (this->isStatic()) {
+				T& value = this->get();
+				if (size == 0 || size != AttributeValueBytes<T>::size(value))
+					return false;
+				AttributeValueBytes<T>::read(value, data);
+				this->markChanged();
+			} else {
+				T value = this->get();
+				if (size == 0 || size != AttributeValueBytes<T>::size(value))
+					return false;
+				AttributeValueBytes<T>::read(value, data);
+				this->set(value);
+			}
+			return true;
+		}
+
 		/**
 		 * @brief Generates a new attribute of the same type and copies the current value in the heap. Does not copy any dependency relations!
 		 * @return Pointer to the copied attribute
@@ -398,10 +603,10 @@ namespace CPS {
 		AttributePointer<Attribute<Real>> deriveReal()
 			// requires std::same_as<T, CPS::Complex> //CPP20
 		{
-			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor getter = [](std::shared_ptr<Real> &dependent, typename Attribute<Complex>::Ptr dependency) {
+			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor getter = [](std::shared_ptr<Real> &dependent, const typename Attribute<Complex>::Ptr &dependency) {
 				*dependent = (**dependency).real();
 			};
-			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor setter = [](std::shared_ptr<Real> &dependent, typename Attribute<Complex>::Ptr dependency) {
+			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor setter = [](std::shared_ptr<Real> &dependent, const typename Attribute<Complex>::Ptr &dependency) {
 				CPS::Complex currentValue = dependency->get();
 				currentValue.real(*dependent);
 				dependency->set(currentValue);
@@ -417,10 +622,10 @@ namespace CPS {
 		AttributePointer<Attribute<Real>> deriveImag()
 			// requires std::same_as<T, CPS::Complex> //CPP20
 		{
-			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor getter = [](std::shared_ptr<Real> &dependent, Attribute<Complex>::Ptr dependency) {
+			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor getter = [](std::shared_ptr<Real> &dependent, const Attribute<Complex>::Ptr &dependency) {
 				*dependent = (**dependency).imag();
 			};
-			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor setter = [](std::shared_ptr<Real> &dependent, Attribute<Complex>::Ptr dependency) {
+			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor setter = [](std::shared_ptr<Real> &dependent, const Attribute<Complex>::Ptr &dependency) {
 				CPS::Complex currentValue = dependency->get();
 				currentValue.imag(*dependent);
 				dependency->set(currentValue);
@@ -437,10 +642,10 @@ namespace CPS {
 		AttributePointer<Attribute<Real>> deriveMag()
 			// requires std::same_as<T, CPS::Complex> //CPP20
 		{
-			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor getter = [](std::shared_ptr<Real> &dependent, Attribute<Complex>::Ptr dependency) {
+			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor getter = [](std::shared_ptr<Real> &dependent, const Attribute<Complex>::Ptr &dependency) {
 				*dependent = Math::abs(**dependency);
 			};
-			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor setter = [](std::shared_ptr<Real> &dependent, Attribute<Complex>::Ptr dependency) {
+			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor setter = [](std::shared_ptr<Real> &dependent, const Attribute<Complex>::Ptr &dependency) {
 				CPS::Complex currentValue = dependency->get();
 				dependency->set(Math::polar(*dependent, Math::phase(currentValue)));
 			};
@@ -456,10 +661,10 @@ namespace CPS {
 		AttributePointer<Attribute<Real>> derivePhase()
 			// requires std::same_as<T, CPS::Complex> //CPP20
 		{
-			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor getter = [](std::shared_ptr<Real> &dependent, Attribute<Complex>::Ptr dependency) {
+			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor getter = [](std::shared_ptr<Real> &dependent, const Attribute<Complex>::Ptr &dependency) {
 				*dependent = Math::phase(**dependency);
 			};
-			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor setter = [](std::shared_ptr<Real> &dependent, Attribute<Complex>::Ptr dependency) {
+			AttributeUpdateTask<CPS::Real, CPS::Complex>::Actor setter = [](std::shared_ptr<Real> &dependent, const Attribute<Complex>::Ptr &dependency) {
 				CPS::Complex currentValue = dependency->get();
 				dependency->set(Math::polar(Math::abs(currentValue), *dependent));
 			};
@@ -475,10 +680,10 @@ namespace CPS {
 		AttributePointer<Attribute<T>> deriveScaled(T scale)
 			// requires std::same_as<T, CPS::Complex> || std::same_as<T, CPS::Real> //CPP20
 		{
-			typename AttributeUpdateTask<T, T>::Actor getter = [scale](std::shared_ptr<T> &dependent, Attribute<T>::Ptr dependency) {
+			typename AttributeUpdateTask<T, T>::Actor getter = [scale](std::shared_ptr<T> &dependent, const Attribute<T>::Ptr &dependency) {
 				*dependent = scale * (**dependency);
 			};
-			typename AttributeUpdateTask<T, T>::Actor setter = [scale](std::shared_ptr<T> &dependent, Attribute<T>::Ptr dependency) {
+			typename AttributeUpdateTask<T, T>::Actor setter = [scale](std::shared_ptr<T> &dependent, const Attribute<T>::Ptr &dependency) {
 				dependency->set((*dependent) / scale);
 			};
 			return derive<T>(getter, setter);
@@ -495,10 +700,10 @@ namespace CPS {
 		AttributePointer<Attribute<U>> deriveCoeff(typename CPS::MatrixVar<U>::Index row, typename CPS::MatrixVar<U>::Index column)
 			// requires std::same_as<T, CPS::MatrixVar<U>> //CPP20
 		{
-			typename AttributeUpdateTask<U, T>::Actor getter = [row, column](std::shared_ptr<U> &dependent, Attribute<T>::Ptr dependency) {
+			typename AttributeUpdateTask<U, T>::Actor getter = [row, column](std::shared_ptr<U> &dependent, const Attribute<T>::Ptr &dependency) {
 				*dependent = (**dependency)(row, column);
 			};
-			typename AttributeUpdateTask<U, T>::Actor setter = [row, column](std::shared_ptr<U> &dependent, Attribute<T>::Ptr dependency) {
+			typename AttributeUpdateTask<U, T>::Actor setter = [row, column](std::shared_ptr<U> &dependent, const Attribute<T>::Ptr &dependency) {
 				CPS::MatrixVar<U> currentValue = dependency->get();
 				currentValue(row, column) = *dependent;
 				dependency->set(currentValue);
@@ -524,8 +729,13 @@ namespace CPS {
 
 		virtual void set(T value) override {
 			*this->mData = value;
+			++this->mVersion;
 		};
 
+		virtual std::size_t version() override {
+			return this->mVersion;
+		}
+
 		virtual T& get() override {
 			return *this->mData;
 		};
@@ -542,9 +752,33 @@ namespace CPS {
 			return this->mData;
 		}
 
+		/**
+		 * Check whether the data is not shared with other attributes or tasks.
+		 * */
+		bool ownsData() const {
+			return this->mData.use_count() == 1;
+		}
+
+		/**
+		 * Move the value into the given storage, e.g. an element of an `AttributeArena`.
+		 * Must only be used while `ownsData` is true, so that nobody keeps the old storage.
+		 * */
+		void relocateData(std::shared_ptr<T> data) {
+			*data = std::move(*this->mData);
+			this->mData = data;
+		}
+
 		virtual void appendDependencies(AttributeBase::Set *deps) override {
 			deps->insert(this->shared_from_this());
 		}
+
+		virtual void appendDirectDependencies(AttributeBase::List& deps) override { }
+
+		virtual typename Attribute<T>::Ptr resolveReference() override {
+			return typename Attribute<T>::Ptr(this->shared_from_this());
+		}
+
+		virtual void freeze() override { }
 	};
 
 	/**
@@ -560,6 +794,22 @@ namespace CPS {
 		std::vector<typename AttributeUpdateTaskBase<T>::Ptr> updateTasksOnce;
 		std::vector<typename AttributeUpdateTaskBase<T>::Ptr> updateTasksOnGet;
 		std::vector<typename AttributeUpdateTaskBase<T>::Ptr> updateTasksOnSet;
+		/// Dependencies of the update tasks before freezing
+		AttributeBase::List mFrozenDependencies;
+		/// Set by freeze(), which collapses the reference chain and keeps the dependencies in mFrozenDependencies
+		Bool mFrozen = false;
+		/// End of the frozen reference chain
+		typename Attribute<T>::Ptr mFrozenReference;
+		/// End of the frozen reference chain if it is updated on get, otherwise the data is shared
+		Attribute<T>* mFrozenSource = nullptr;
+
+		/// Referenced attribute if the only update task in the list is a `setReference` task
+		typename Attribute<T>::Ptr singleReference(const std::vector<typename AttributeUpdateTaskBase<T>::Ptr> &tasks) {
+			if (tasks.size() != 1)
+				return typename Attribute<T>::Ptr();
+			auto task = std::dynamic_pointer_cast<AttributeReferenceTask<T>>(tasks[0]);
+			return task ? task->reference() : typename Attribute<T>::Ptr();
+		}
 
 	public:
 		AttributeDynamic(T initialValue = T()) :
@@ -615,21 +865,71 @@ namespace CPS {
 			updateTasksOnce.clear();
 			updateTasksOnGet.clear();
 			updateTasksOnSet.clear();
+			mFrozenDependencies.clear();
+			mFrozen = false;
+			mFrozenReference = typename Attribute<T>::Ptr();
+			mFrozenSource = nullptr;
 		}
 
 		virtual void setReference(typename Attribute<T>::Ptr reference) override {
-			typename AttributeUpdateTask<T, T>::Actor getter = [](std::shared_ptr<T> &dependent, typename Attribute<T>::Ptr dependency) {
-				dependent = dependency->asRawPointer();
-			};
 			this->clearAllTasks();
 			if(reference->isStatic()) {
-				this->addTask(UpdateTaskKind::UPDATE_ONCE, AttributeUpdateTask<T, T>::make(UpdateTaskKind::UPDATE_ONCE, getter, reference));
+				this->addTask(UpdateTaskKind::UPDATE_ONCE, AttributeReferenceTask<T>::make(reference));
 			} else {
-				this->addTask(UpdateTaskKind::UPDATE_ON_GET, AttributeUpdateTask<T, T>::make(UpdateTaskKind::UPDATE_ON_GET, getter, reference));
+				this->addTask(UpdateTaskKind::UPDATE_ON_GET, AttributeReferenceTask<T>::make(reference));
 			}
 		}
 
+		virtual typename Attribute<T>::Ptr resolveReference() override {
+			if (mFrozenReference.getPtr())
+				return mFrozenReference;
+
+			typename Attribute<T>::Ptr reference = singleReference(updateTasksOnGet);
+			if (!reference.getPtr() && updateTasksOnGet.empty())
+				reference = singleReference(updateTasksOnce);
+			if (reference.getPtr())
+				return reference->resolveReference();
+			return typename Attribute<T>::Ptr(this->shared_from_this());
+		}
+
+		/**
+		 * Implementation for dynamic attributes. The getters of derived attributes access the ends of the reference chains of their
+		 * dependencies. A reference chain which ends at an attribute without UPDATE_ON_GET tasks is replaced by sharing its data, so that
+		 * `get` runs no update tasks. A chain which ends at a derived attribute is replaced by directly calling its `get`.
+		 * */
+		virtual void freeze() override {
+			if (mFrozen)
+				return;
+			mFrozen = true;
+
+			for (typename AttributeUpdateTaskBase<T>::Ptr task : updateTasksOnce) {
+				AttributeBase::List taskDeps = task->getDependencies();
+				mFrozenDependencies.insert(mFrozenDependencies.end(), taskDeps.begin(), taskDeps.end());
+			}
+			for (typename AttributeUpdateTaskBase<T>::Ptr task : updateTasksOnGet) {
+				AttributeBase::List taskDeps = task->getDependencies();
+				mFrozenDependencies.insert(mFrozenDependencies.end(), taskDeps.begin(), taskDeps.end());
+				task->freeze();
+			}
+
+			typename Attribute<T>::Ptr reference = resolveReference();
+			if (reference.getPtr().get() == this)
+				return;
+
+			auto dynamicReference = std::dynamic_pointer_cast<AttributeDynamic<T>>(reference.getPtr());
+			if (dynamicReference && !dynamicReference->updateTasksOnGet.empty())
+				mFrozenSource = reference.getPtr().get();
+			else
+				this->mData = reference->asRawPointer();
+			mFrozenReference = reference;
+
+			updateTasksOnce.clear();
+			updateTasksOnGet.clear();
+		}
+
 		virtual std::shared_ptr<T> asRawPointer() {
+			if (mFrozenSource)
+				return mFrozenSource->asRawPointer();
 			for(typename AttributeUpdateTaskBase<T>::Ptr task : updateTasksOnGet) {
 				task->executeUpdate(this->mData);
 			}
@@ -637,13 +937,39 @@ namespace CPS {
 		}
 
 		virtual void set(T value) override {
-			*this->mData = value;
+			if (mFrozenSource) {
+				*mFrozenSource->asRawPointer() = value;
+				mFrozenSource->markChanged();
+			} else
+				*this->mData = value;
+			++this->mVersion;
 			for(typename AttributeUpdateTaskBase<T>::Ptr task : updateTasksOnSet) {
 				task->executeUpdate(this->mData);
 			}
 		};
 
+		/**
+		 * Implementation for dynamic attributes. The versions only increase, so the sum over this attribute and the dependencies
+		 * of the update tasks (or of the tasks replaced by freezing) changes whenever one of them changes.
+		 * */
+		virtual std::size_t version() override {
+			std::size_t version = this->mVersion;
+			for (auto& dependency : mFrozenDependencies)
+				version += dependency->version();
+			for (typename AttributeUpdateTaskBase<T>::Ptr task : updateTasksOnce) {
+				for (auto& dependency : task->getDependencies())
+					version += dependency->version();
+			}
+			for (typename AttributeUpdateTaskBase<T>::Ptr task : updateTasksOnGet) {
+				for (auto& dependency : task->getDependencies())
+					version += dependency->version();
+			}
+			return version;
+		}
+
 		virtual T& get() override {
+			if (mFrozenSource)
+				return mFrozenSource->get();
 			for(typename AttributeUpdateTaskBase<T>::Ptr task : updateTasksOnGet) {
 				task->executeUpdate(this->mData);
 			}
@@ -655,27 +981,35 @@ namespace CPS {
 		}
 
 		/**
-		 * Implementation for dynamic attributes.This will recursively collect all attributes this attribute depends on, either in the UPDATE_ONCE or the UPDATE_ON_GET tasks.
+		 * Implementation for dynamic attributes.This will recursively collect all attributes this attribute depends on, either in the UPDATE_ONCE or the UPDATE_ON_GET tasks
+		 * or in the tasks replaced by freezing.
 		 * This is done by performing a Depth-First-Search on the dependency graph where the task dependencies of each attribute are the outgoing edges.
 		 * The `deps` set contains all the nodes that have already been visited in the graph
 		 * */
 		virtual void appendDependencies(AttributeBase::Set *deps) override {
 			deps->insert(this->shared_from_this());
 
-			AttributeBase::Set newDeps = AttributeBase::Set();
+			AttributeBase::List directDeps;
+			appendDirectDependencies(directDeps);
+			AttributeBase::Set newDeps(directDeps.begin(), directDeps.end());
+
+			for (auto dependency : newDeps) {
+				dependency->appendDependencies(deps);
+			}
+		}
+
+		virtual void appendDirectDependencies(AttributeBase::List& deps) override {
 			for (typename AttributeUpdateTaskBase<T>::Ptr task : updateTasksOnce) {
 				AttributeBase::List taskDeps = task->getDependencies();
-				newDeps.insert(taskDeps.begin(), taskDeps.end());
+				deps.insert(deps.end(), taskDeps.begin(), taskDeps.end());
 			}
 
 			for (typename AttributeUpdateTaskBase<T>::Ptr task : updateTasksOnGet) {
 				AttributeBase::List taskDeps = task->getDependencies();
-				newDeps.insert(taskDeps.begin(), taskDeps.end());
+				deps.insert(deps.end(), taskDeps.begin(), taskDeps.end());
 			}
 
-			for (auto dependency : newDeps) {
-				dependency->appendDependencies(deps);
-			}
+			deps.insert(deps.end(), mFrozenDependencies.begin(), mFrozenDependencies.end());
 		}
 	};
 
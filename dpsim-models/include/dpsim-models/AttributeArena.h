@@ -0,0 +1,53 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include <dpsim-models/Attribute.h>
+
+namespace CPS {
+	/// Contiguous storage for the values of static attributes
+	///
+	/// The values of the real, complex and matrix attributes are moved into
+	/// one array per type, in the order the attributes were added. The
+	/// attributes keep owning their values through shared pointers into the
+	/// arrays, so the arrays live as long as any of their attributes. Values
+	/// which are shared with other attributes or tasks are not moved, because
+	/// their other owners would keep the old storage. For matrices only the
+	/// matrix objects are contiguous, Eigen allocates their coefficients.
+	class AttributeArena {
+	public:
+		/// Adds a static attribute of one of the arena types,
+		/// returns false if the attribute is not stored in the arena
+		Bool add(AttributeBase::Ptr attribute);
+		/// Moves the values of the added attributes into the arrays,
+		/// returns the number of moved values
+		UInt allocate();
+
+	private:
+		template <typename T>
+		struct Pool {
+			std::vector<std::shared_ptr<AttributeStatic<T>>> attributes;
+			/// Moves the values which are not shared into one array
+			UInt allocate();
+		};
+
+		Pool<Real> mReals;
+		Pool<Complex> mComplexes;
+		Pool<Matrix> mMatrices;
+		Pool<MatrixComp> mComplexMatrices;
+		/// Attributes which are already added
+		std::set<AttributeBase*> mAdded;
+
+		template <typename T>
+		Bool addTyped(AttributeBase::Ptr attribute, Pool<T>& pool);
+	};
+}
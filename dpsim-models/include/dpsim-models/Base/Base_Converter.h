@@ -0,0 +1,45 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim-models/Definitions.h>
+
+namespace CPS {
+namespace Base {
+	/// \brief Converter whose model fidelity can be changed during the simulation
+	///
+	/// The averaged model applies the reference voltages of the control directly.
+	/// The switching function model applies the voltages of two-level legs between
+	/// -Vdc/2 and Vdc/2, which are modulated by a triangular carrier. Switching instants
+	/// within a time step are interpolated, so that the applied voltage is the mean of
+	/// the switched voltage over the step.
+	class Converter {
+	public:
+		enum class Fidelity { Averaged, SwitchingFunction };
+
+		/// Setter for the DC link voltage and the carrier frequency of the switching function model
+		void setSwitchingParameters(Real dcVoltage, Real carrierFrequency);
+		/// Selects the model, which can also be done between time steps
+		void setFidelity(Fidelity fidelity);
+		///
+		Fidelity fidelity() const { return mFidelity; }
+
+	protected:
+		Fidelity mFidelity = Fidelity::Averaged;
+		/// DC link voltage
+		Real mDCVoltage = 0;
+		/// Frequency of the triangular carrier
+		Real mCarrierFrequency = 0;
+
+		/// Mean of a leg voltage over the interval [begin, end], where the leg is
+		/// switched to Vdc/2 while the reference is above the carrier
+		Real switchedLegVoltage(Real reference, Real begin, Real end) const;
+	};
+}
+}
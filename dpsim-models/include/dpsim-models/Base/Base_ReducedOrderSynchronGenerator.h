@@ -61,6 +61,15 @@ namespace Base {
 			/// modelAsCurrentSource=true --> SG is modeled as current source, otherwise as voltage source
 			/// Both implementations are equivalent, but the current source implementation is more efficient
 			virtual void setModelAsCurrentSource(Bool modelAsCurrentSource);
+			/// modelWithConstantConductance=true --> the conductance stamped into the system matrix does not depend
+			/// on the rotor angle and the Norton current is corrected by iterations within the time step instead,
+			/// so that the system matrix does not change. Only applies if the SG is modeled as current source
+			void setModelWithConstantConductance(Bool modelWithConstantConductance);
+			/// Tolerance of the change of the Norton current in the corrector iterations (p.u.)
+			void setCorrectorTolerance(Real tolerance);
+			/// Integrate the exciter and the governor with backward Euler, e.g. for
+			/// long-term simulations with time steps above their time constants
+			void doImplicitControllerIntegration(Bool value);
 			///
 			void setBaseParameters(Real nomPower, Real nomVolt, Real nomFreq);
 			/// Initialization for 3 Order SynGen
@@ -115,6 +124,11 @@ namespace Base {
 			virtual void specificInitialization() = 0;
 			///
         	virtual void stepInPerUnit() = 0;
+			/// Steps the exciter and the turbine governor
+			void stepControllers();
+			/// dq voltage and current from which the electrical torque is calculated
+			const Attribute<Matrix>::Ptr& torqueVoltage() const;
+			const Attribute<Matrix>::Ptr& torqueCurrent() const;
 
 			// ### MNA Section ###
         	///
@@ -128,9 +142,53 @@ namespace Base {
 			virtual void mnaCompPostStep(const Matrix& leftVector) = 0;
 			/// Stamps system matrix
 			virtual void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) = 0;
+			/// The pre steps of machines of the same type are executed by one MnaPreStepBatch
+			Bool mnaCompHasBatchedSteps() const override;
+			Task::Ptr mnaCompCreateBatchedPreStep(const std::vector<MNASimPowerComp<VarType>*>& comps) override;
+
+			/// \brief Pre steps of several machines of the same type
+			///
+			/// The mechanical states of all machines are moved into one array per state,
+			/// which the attributes of the machines keep referencing, so that the swing
+			/// equations of all machines are solved by one loop over these arrays. The
+			/// controllers and the electrical equations of the model are still stepped
+			/// per machine.
+			class MnaPreStepBatch : public Task {
+			public:
+				MnaPreStepBatch(const std::vector<ReducedOrderSynchronGenerator<VarType>*>& gens);
+				void execute(Real time, Int timeStepCount) override;
+
+			private:
+				enum State { OmMech, ThetaMech, Delta, ElecTorque, NumStates };
+				using StateArray = Eigen::Array<Real, Eigen::Dynamic, NumStates>;
+
+				std::vector<ReducedOrderSynchronGenerator<VarType>*> mGens;
+				/// Mechanical states with one row per machine
+				std::shared_ptr<StateArray> mStates;
+				/// Mechanical torque at time k
+				Eigen::ArrayXd mMechTorquePrev;
+				/// dq voltages and currents at time k
+				Eigen::ArrayXd mVd;
+				Eigen::ArrayXd mVq;
+				Eigen::ArrayXd mId;
+				Eigen::ArrayXd mIq;
+				/// 1 / (2 H)
+				Eigen::ArrayXd mInvTwoH;
+				Eigen::ArrayXd mBaseOmMech;
+				Real mTimeStep;
+			};
+
 			/// Model flag indicating whether the machine is modeled as current or voltage source
 			/// Default: currentsource (recommended)
 			Bool mModelAsCurrentSource = true;
+			/// Model flag indicating whether a constant conductance is stamped and corrected by iterations
+			Bool mModelWithConstantConductance = false;
+			/// Tolerance of the corrector iterations (p.u.)
+			Real mCorrectorTolerance = 1e-6;
+			/// Integrate exciter and governor with backward Euler
+			Bool mImplicitControllerIntegration = false;
+			/// Returns true if the Norton current is corrected against a constant conductance
+			Bool hasConstantConductance() const { return mModelAsCurrentSource && mModelWithConstantConductance; }
 			// Model flag indicating the SG order to be used
 			SGOrder mSGOrder;
 
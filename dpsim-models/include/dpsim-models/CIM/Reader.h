@@ -19,6 +19,7 @@
 #include <dpsim-models/SimTerminal.h>
 #include <dpsim-models/Logger.h>
 #include <dpsim-models/SystemTopology.h>
+#include <dpsim-models/CIM/TopologyCache.h>
 
 
 /* ====== WARNING =======
@@ -49,6 +50,7 @@ namespace CIMPP {
 	class EquivalentShunt;
 	class TopologicalNode;
 	class ConductingEquipment;
+	class IdentifiedObject;
 };
 #else
 #include <CIMNamespaces.hpp>
@@ -66,6 +68,9 @@ namespace CIM {
 		Logger::Level mComponentLogLevel;
 		/// Model from CIM++
 		CIMModel *mModel;
+		/// Objects of the CIM model indexed by their type
+		struct ObjectTable;
+		std::unique_ptr<ObjectTable> mObjects;
 		/// All components after mapping
 		IdentifiedObject::List mComponents;
 		/// System frequency (has to be given to convert between reactances
@@ -90,6 +95,8 @@ namespace CIM {
 		std::map<String, TopologicalTerminal::Ptr> mPowerflowTerminals;
 		///
 		Bool mUseProtectionSwitches = false;
+		/// Directory of the binary cache of the CIM data, disabled if empty
+		fs::path mCacheDirectory;
 
 		// #### shunt component settings ####
 		/// activates global shunt capacitor setting
@@ -105,47 +112,63 @@ namespace CIM {
 		/// Resolves unit multipliers.
 		static Real unitValue(Real value, CIMPP::UnitMultiplier mult);
 		///
-		void processSvVoltage(CIMPP::SvVoltage* volt);
+		void processSvVoltage(const TopologyCache::Node &node);
 		///
-		void processSvPowerFlow(CIMPP::SvPowerFlow* flow);
+		void processSvPowerFlow(const TopologyCache::Terminal &term);
 		///
 		template<typename VarType>
-		void processTopologicalNode(CIMPP::TopologicalNode* topNode);
+		void processTopologicalNode(const TopologyCache::Node &topNode);
 		///
 		void addFiles(const fs::path &filename);
 		/// Adds CIM files to list of files to be parsed.
 		void addFiles(const std::list<fs::path> &filenames);
+		/// Sorts the parsed CIM objects by type in a single pass over the model
+		void buildObjectTable();
+		/// Parses the CIM files and extracts the nodes, terminals, state variables
+		/// and equipment parameters. Returns false if the files could not be parsed.
+		Bool parseFiles(TopologyCache &cache);
+		/// Returns the data of the CIM files, from the cache if it contains the same files
+		TopologyCache readTopologyData(const std::list<fs::path> &filenames);
 		/// First, go through all topological nodes and collect them in a list.
 		/// Since all nodes have references to the equipment connected to them (via Terminals), but not
 		/// the other way around (which we need for instantiating the components), we collect that information here as well.
-		void parseFiles();
+		/// The equipment is mapped in parallel beforehand if OpenMP is available.
+		void buildTopology(const TopologyCache &cache);
 		/// Returns list of components and nodes.
 		SystemTopology systemTopology();
 
+		// #### Extraction Functions ####
+		// Store the parameters of the equipment, return false if it is not supported
+		Bool extractACLineSegment(CIMPP::ACLineSegment* line, TopologyCache::Equipment &eq);
+		Bool extractPowerTransformer(CIMPP::PowerTransformer *trans, TopologyCache::Equipment &eq);
+		Bool extractSynchronousMachine(CIMPP::SynchronousMachine* machine, TopologyCache::Equipment &eq);
+		Bool extractExternalNetworkInjection(CIMPP::ExternalNetworkInjection* extnet, TopologyCache::Equipment &eq);
+		Bool extractEquivalentShunt(CIMPP::EquivalentShunt *shunt, TopologyCache::Equipment &eq);
+
 		// #### Mapping Functions ####
 		/// Returns simulation node index which belongs to mRID.
 		Matrix::Index mapTopologicalNode(String mrid);
-		/// Maps CIM components to CPowerSystem components.
-		TopologicalPowerComp::Ptr mapComponent(BaseClass* obj);
+		/// Returns the component for the equipment according to its type.
+		TopologicalPowerComp::Ptr mapEquipment(const TopologyCache::Equipment &eq);
 		/// Returns an RX-Line.
 		/// The voltage should be given in kV and the angle in degree.
 		/// TODO: Introduce different models such as PI and wave model.
-		TopologicalPowerComp::Ptr mapACLineSegment(CIMPP::ACLineSegment* line);
+		TopologicalPowerComp::Ptr mapACLineSegment(const TopologyCache::Equipment &line);
 		/// Returns a transformer, either ideal or with RL elements to model losses.
-		TopologicalPowerComp::Ptr mapPowerTransformer(CIMPP::PowerTransformer *trans);
+		TopologicalPowerComp::Ptr mapPowerTransformer(const TopologyCache::Equipment &trans);
 		/// Returns an IdealVoltageSource with voltage setting according to load flow data
 		/// at machine terminals. The voltage should be given in kV and the angle in degree.
 		/// TODO: Introduce real synchronous generator models here.
-		TopologicalPowerComp::Ptr mapSynchronousMachine(CIMPP::SynchronousMachine* machine);
+		TopologicalPowerComp::Ptr mapSynchronousMachine(const TopologyCache::Equipment &machine);
 		/// Returns an PQload with voltage setting according to load flow data.
 		/// Currently the only option is to create an RL-load.
 		/// The voltage should be given in kV and the angle in degree.
 		/// TODO: Introduce real PQload model here.
-		TopologicalPowerComp::Ptr mapEnergyConsumer(CIMPP::EnergyConsumer* consumer);
+		TopologicalPowerComp::Ptr mapEnergyConsumer(const TopologyCache::Equipment &consumer);
 		/// Returns an external grid injection.
-		TopologicalPowerComp::Ptr mapExternalNetworkInjection(CIMPP::ExternalNetworkInjection* extnet);
+		TopologicalPowerComp::Ptr mapExternalNetworkInjection(const TopologyCache::Equipment &extnet);
 		/// Returns a shunt
-		TopologicalPowerComp::Ptr mapEquivalentShunt(CIMPP::EquivalentShunt *shunt);
+		TopologicalPowerComp::Ptr mapEquivalentShunt(const TopologyCache::Equipment &shunt);
 
 		// #### Helper Functions ####
 		/// Determine base voltage associated with object
@@ -169,6 +192,16 @@ namespace CIM {
 		///
 		SystemTopology loadCIM(Real systemFrequency, const std::list<CPS::String> &filenamesString, Domain domain = Domain::DP, PhaseType phase = PhaseType::Single,
 			GeneratorType genType = GeneratorType::None);
+		/// \brief Applies state variables of delta profiles to the loaded topology
+		///
+		/// Only the given files are parsed, so they have to contain the objects referenced by
+		/// the state variables, e.g. the SV profile together with the TP profile. Initial node
+		/// voltages, terminal powers and the power of SP loads are updated in place.
+		/// Returns the components whose terminals or parameters changed, which have to be
+		/// initialized again before they are simulated with the new values.
+		TopologicalPowerComp::List updateCIM(const std::list<fs::path> &filenames);
+		///
+		TopologicalPowerComp::List updateCIM(const std::list<CPS::String> &filenamesString);
 
 		// #### shunt component settings ####
 		/// set shunt capacitor value
@@ -177,6 +210,9 @@ namespace CIM {
 		void setShuntConductance(Real v);
 		/// If set, some components like loads include protection switches
 		void useProtectionSwitches(Bool value = true);
+		/// Stores the data extracted from the CIM files in a binary cache in the directory.
+		/// Later loads of files with the same content skip the parsing of the XML files.
+		void setCacheDirectory(const fs::path &directory);
 	};
 }
 }
@@ -0,0 +1,96 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <vector>
+
+#include <dpsim-models/Definitions.h>
+#include <dpsim-models/Filesystem.h>
+
+namespace CPS {
+namespace CIM {
+	/// \brief Data of CIM files which is needed to build the system topology
+	///
+	/// The reader extracts the topological nodes, terminals, state variables and
+	/// equipment parameters from the CIM model into this structure and creates the
+	/// components from it. It does not depend on CIM++ nor on the simulation domain,
+	/// so it can be stored in a binary file keyed by a hash of the CIM files to skip
+	/// the XML parsing when the same files are loaded again.
+	///
+	/// The file starts with the magic "DPSIMCIM", uint32 version, uint64 hash of the
+	/// CIM files and the number of nodes and equipment. Strings are stored as uint32
+	/// length and characters, numbers as doubles.
+	class TopologyCache {
+	public:
+		static constexpr uint32_t Version = 1;
+
+		enum class EquipmentType : uint32_t {
+			ACLineSegment,
+			EnergyConsumer,
+			PowerTransformer,
+			SynchronousMachine,
+			ExternalNetworkInjection,
+			EquivalentShunt
+		};
+
+		/// Conducting equipment with its parameters in SI units by name.
+		/// Parameters which are not initialized in the CIM files are missing.
+		struct Equipment {
+			EquipmentType type;
+			String mRID;
+			String name;
+			std::map<String, Real> params;
+
+			Bool has(const String& key) const { return params.find(key) != params.end(); }
+			/// Returns the parameter or throws if it is missing
+			Real param(const String& key) const;
+			/// Returns the parameter or the default value if it is missing
+			Real param(const String& key, Real defaultValue) const;
+		};
+
+		struct Terminal {
+			String mRID;
+			/// mRID of the connected equipment, empty if there is none
+			String equipment;
+			UInt sequenceNumber = 1;
+			/// Power flow from SvPowerFlow
+			Bool hasPower = false;
+			Complex power = 0;
+		};
+
+		struct Node {
+			String mRID;
+			String name;
+			std::vector<Terminal> terminals;
+			/// Voltage from SvVoltage
+			Bool hasVoltage = false;
+			Complex voltage = 0;
+		};
+
+		/// Hash of the CIM files the data was extracted from
+		uint64_t hash = 0;
+		/// Topological nodes in the order of the CIM model
+		std::vector<Node> nodes;
+		std::vector<Equipment> equipment;
+
+		/// Hash of the content of the files in the given order
+		static uint64_t contentHash(const std::list<fs::path>& filenames);
+		/// Name of the cache file for the given hash in the directory
+		static fs::path filename(const fs::path& directory, uint64_t hash);
+
+		/// Writes the data to a binary file
+		void save(const fs::path& filename) const;
+		/// Reads data written by save()
+		static TopologyCache load(const fs::path& filename);
+	};
+}
+}
@@ -22,6 +22,7 @@
 #include <dpsim-models/DP/DP_Ph1_PQLoadCS.h>
 #include <dpsim-models/DP/DP_Ph1_AvVoltageSourceInverterDQ.h>
 #include <dpsim-models/SP/SP_Ph1_AvVoltageSourceInverterDQ.h>
+#include <dpsim-models/Signal/LoadProfileEngine.h>
 
 namespace CPS {
 	/// reads load profiles (csv files only) and assign them to the corresponding load object
@@ -37,6 +38,12 @@ namespace CPS {
 		std::map <String, String> mAssignPattern;
 		/// Skip first row if it has no digits at beginning
 		Bool mSkipFirstRow = true;
+		/// Stream the load profiles instead of reading them up front
+		Bool mStreamProfiles = false;
+		/// Rows read at once when streaming load profiles
+		UInt mWindowRows = 1024;
+		/// Engine which applies the assigned load profiles instead of the loads
+		std::shared_ptr<Signal::LoadProfileEngine> mProfileEngine;
 
 	public:
 		/// set load profile assigning pattern. AUTO for assigning load profile name (csv file name) to load object with the same name (mName)
@@ -65,6 +72,11 @@ namespace CPS {
 		Real time_format_convert(const String& time);
 		/// Skip first row if it has no digits at beginning
 		void doSkipFirstRow(Bool value = true) { mSkipFirstRow = value; }
+		/// Read the assigned load profiles in chunks of windowRows rows while the simulation advances
+		void doStreamLoadProfiles(Bool value = true, UInt windowRows = 1024) { mStreamProfiles = value; mWindowRows = windowRows; }
+		/// Add the assigned load profiles to the engine instead of the loads, weighting factors
+		/// are scaled by the power of the load at assignment. Takes precedence over streaming.
+		void setLoadProfileEngine(std::shared_ptr<Signal::LoadProfileEngine> engine) { mProfileEngine = engine; }
 		///
 		MatrixRow csv2Eigen(const String& path);
 
@@ -105,12 +117,6 @@ namespace CPS {
 		void assignPVGeneration(SystemTopology& sys,
 			Real start_time = -1, Real time_step = 1, Real end_time = -1,
 			CSVReader::Mode mode = CSVReader::Mode::AUTO);
-
-		/// interpolation for PQ data points
-		PQData interpol_linear(std::map<Real, PQData>& data_PQ, Real x);
-
-		/// interpolation for weighting factor data points
-		Real interpol_linear(std::map<Real, Real>& data_wf, Real x);
 	};
 
 
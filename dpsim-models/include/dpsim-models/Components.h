@@ -83,6 +83,7 @@
 #include <dpsim-models/EMT/EMT_Ph1_VoltageSource.h>
 #include <dpsim-models/EMT/EMT_Ph1_VoltageSourceRamp.h>
 #include <dpsim-models/EMT/EMT_Ph1_VoltageSourceNorton.h>
+#include <dpsim-models/EMT/EMT_Ph1_FrequencyDependentNetworkEquivalent.h>
 
 #include <dpsim-models/EMT/EMT_Ph3_Capacitor.h>
 #include <dpsim-models/EMT/EMT_Ph3_Inductor.h>
@@ -116,6 +117,9 @@
 
 #include <dpsim-models/Signal/DecouplingLine.h>
 #include <dpsim-models/Signal/DecouplingLineEMT.h>
+#include <dpsim-models/Signal/HybridInterface.h>
+#include <dpsim-models/Signal/DecouplingLineRemote.h>
+#include <dpsim-models/Signal/FrequencyDependentLineEMT.h>
 #include <dpsim-models/Signal/Exciter.h>
 #include <dpsim-models/Signal/TurbineGovernor.h>
 #include <dpsim-models/Signal/TurbineGovernorType1.h>
@@ -125,3 +129,6 @@
 #include <dpsim-models/Signal/SineWaveGenerator.h>
 #include <dpsim-models/Signal/FrequencyRampGenerator.h>
 #include <dpsim-models/Signal/CosineFMGenerator.h>
+#include <dpsim-models/Signal/Reduction.h>
+#include <dpsim-models/Signal/ProtectionRelay.h>
+#include <dpsim-models/Signal/LoadProfileEngine.h>
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <dpsim-models/MNASimPowerComp.h>
+#include <dpsim-models/Solver/MNAVariableTimeStepInterface.h>
+#include <dpsim-models/Solver/MNAVariableFrequencyInterface.h>
 
 namespace CPS {
 	enum class MNA_SUBCOMP_TASK_ORDER {
@@ -13,7 +15,7 @@ namespace CPS {
 
 	/// Base class for composite power components
 	template <typename VarType>
-	class CompositePowerComp : public MNASimPowerComp<VarType> {
+	class CompositePowerComp : public MNASimPowerComp<VarType>, public MNAVariableTimeStepInterface, public MNAVariableFrequencyInterface {
 
 	private:
 		MNAInterface::List mSubcomponentsMNA;
@@ -61,6 +63,10 @@ namespace CPS {
 		void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
 		/// Add MNA post step dependencies
 		void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+		/// Passes the new time step to the subcomponents with variable time step support
+		void mnaUpdateTimeStep(Real timeStep) override;
+		/// Passes the new shift frequency to the subcomponents with variable frequency support
+		void mnaUpdateShiftFrequency(Real frequency, Real time, Real timeStep) override;
 
 		// #### MNA Parent Functions ####
 		virtual void mnaParentInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
@@ -81,6 +87,12 @@ namespace CPS {
 		virtual void mnaParentAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
 			// By default, the parent has no custom pre-step-dependencies, only the subcomponents' dependencies are added
 		};
+		virtual void mnaParentUpdateTimeStep(Real timeStep) {
+			// By default, the parent has no time step dependent model of its own, only the subcomponents are updated
+		};
+		virtual void mnaParentUpdateShiftFrequency(Real frequency, Real time, Real timeStep) {
+			// By default, the parent has no frequency dependent model of its own, only the subcomponents are updated
+		};
 		virtual void mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
 			// By default, the parent has no custom post-step-dependencies, only the subcomponents' dependencies are added
 		};
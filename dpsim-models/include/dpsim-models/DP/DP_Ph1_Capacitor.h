@@ -9,6 +9,9 @@
 #pragma once
 
 #include <dpsim-models/MNASimPowerComp.h>
+#include <dpsim-models/DP/DP_Ph1_CompanionModelBatch.h>
+#include <dpsim-models/Solver/MNAVariableTimeStepInterface.h>
+#include <dpsim-models/Solver/MNAVariableFrequencyInterface.h>
 #include <dpsim-models/Base/Base_Ph1_Capacitor.h>
 
 namespace CPS {
@@ -24,6 +27,8 @@ namespace Ph1 {
 	class Capacitor :
 		public MNASimPowerComp<Complex>,
 		public Base::Ph1::Capacitor,
+		public MNAVariableTimeStepInterface,
+		public MNAVariableFrequencyInterface,
 		public SharedFactory<Capacitor> {
 	protected:
 		/// DC equivalent current source for harmonics [A]
@@ -32,6 +37,8 @@ namespace Ph1 {
 		MatrixComp mEquivCond;
 		/// Coefficient in front of previous voltage value for harmonics
 		MatrixComp mPrevVoltCoeff;
+		/// Companion model parameters of the given components of this type
+		static std::vector<CompanionModelBatch::Member> companionModelMembers(const std::vector<MNASimPowerComp<Complex>*>& comps);
 	public:
 		/// Defines UID, name and logging level
 		Capacitor(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -50,6 +57,10 @@ namespace Ph1 {
 		// #### MNA section ####
 		/// Initializes internal variables of the component
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+		/// Recomputes the companion model coefficients for the new time step
+		void mnaUpdateTimeStep(Real timeStep) override;
+		/// Recomputes the companion model coefficients for the new shift frequency
+		void mnaUpdateShiftFrequency(Real frequency, Real time, Real timeStep) override;
 		void mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVector) override;
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
@@ -72,6 +83,10 @@ namespace Ph1 {
 		void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
 		/// Add MNA post step dependencies
 		void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+		/// Single frequency steps can be batched as companion models
+		Bool mnaCompHasBatchedSteps() const override;
+		Task::Ptr mnaCompCreateBatchedPreStep(const std::vector<MNASimPowerComp<Complex>*>& comps) override;
+		Task::Ptr mnaCompCreateBatchedPostStep(const std::vector<MNASimPowerComp<Complex>*>& comps, Attribute<Matrix>::Ptr leftVector) override;
 
 		class MnaPreStepHarm : public CPS::Task {
 		public:
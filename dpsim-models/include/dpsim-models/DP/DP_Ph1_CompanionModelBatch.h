@@ -0,0 +1,72 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim-models/MNASimPowerComp.h>
+
+namespace CPS {
+namespace DP {
+namespace Ph1 {
+	/// \brief Batched MNA steps of single frequency companion models
+	///
+	/// A companion model is a conductance in parallel with a current source
+	/// which is calculated from the previous voltage and current of the component.
+	/// The steps of several components of the same type are executed in one loop
+	/// over arrays of their parameters instead of one virtual call per component.
+	class CompanionModelBatch : public Task {
+	public:
+		/// Companion model of one component
+		struct Member {
+			MNASimPowerComp<Complex>* comp;
+			/// Equivalent conductance
+			Complex equivCond;
+			/// Coefficient in front of the previous voltage in the equivalent current
+			Complex voltageCoeff;
+			/// Coefficient in front of the previous current in the equivalent current
+			Complex currentCoeff;
+			/// Equivalent current source, which stays owned by the component
+			Complex* equivCurrent;
+		};
+
+	protected:
+		CompanionModelBatch(const String& name, const std::vector<Member>& members);
+
+		std::vector<Complex> mEquivCond;
+		std::vector<Complex> mVoltageCoeff;
+		std::vector<Complex> mCurrentCoeff;
+		std::vector<Complex*> mEquivCurrent;
+		std::vector<std::shared_ptr<MatrixComp>> mIntfVoltage;
+		std::vector<std::shared_ptr<MatrixComp>> mIntfCurrent;
+		std::vector<std::shared_ptr<Matrix>> mRightVector;
+		/// Rows of the real parts of the terminal voltages, negative for grounded terminals
+		std::vector<Matrix::Index> mRow0;
+		std::vector<Matrix::Index> mRow1;
+		/// Offset of the imaginary parts from the real parts in the system vectors
+		Matrix::Index mComplexOffset = 0;
+	};
+
+	/// Calculates the equivalent current sources and stamps them into the right vectors
+	class CompanionModelPreStepBatch : public CompanionModelBatch {
+	public:
+		CompanionModelPreStepBatch(const std::vector<Member>& members);
+		void execute(Real time, Int timeStepCount) override;
+	};
+
+	/// Updates the interface voltages and currents from the solution
+	class CompanionModelPostStepBatch : public CompanionModelBatch {
+	public:
+		CompanionModelPostStepBatch(const std::vector<Member>& members, Attribute<Matrix>::Ptr leftVector);
+		void execute(Real time, Int timeStepCount) override;
+
+	private:
+		Attribute<Matrix>::Ptr mLeftVector;
+	};
+}
+}
+}
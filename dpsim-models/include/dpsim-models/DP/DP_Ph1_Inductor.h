@@ -9,7 +9,10 @@
 #pragma once
 
 #include <dpsim-models/MNASimPowerComp.h>
+#include <dpsim-models/DP/DP_Ph1_CompanionModelBatch.h>
 #include <dpsim-models/Solver/MNATearInterface.h>
+#include <dpsim-models/Solver/MNAVariableTimeStepInterface.h>
+#include <dpsim-models/Solver/MNAVariableFrequencyInterface.h>
 #include <dpsim-models/Base/Base_Ph1_Inductor.h>
 
 namespace CPS {
@@ -26,6 +29,8 @@ namespace Ph1 {
 		public MNASimPowerComp<Complex>,
 		public Base::Ph1::Inductor,
 		public MNATearInterface,
+		public MNAVariableTimeStepInterface,
+		public MNAVariableFrequencyInterface,
 		public SharedFactory<Inductor> {
 	protected:
 		/// DC equivalent current source for harmonics [A]
@@ -36,6 +41,8 @@ namespace Ph1 {
 		MatrixComp mPrevCurrFac;
 		///
 		void initVars(Real timeStep);
+		/// Companion model parameters of the given components of this type
+		static std::vector<CompanionModelBatch::Member> companionModelMembers(const std::vector<MNASimPowerComp<Complex>*>& comps);
 	public:
 		/// Defines UID, name and log level
 		Inductor(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -54,6 +61,10 @@ namespace Ph1 {
 		// #### MNA section ####
 		/// Initializes MNA specific variables
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+		/// Recomputes the companion model coefficients for the new time step
+		void mnaUpdateTimeStep(Real timeStep) override;
+		/// Recomputes the companion model coefficients for the new shift frequency
+		void mnaUpdateShiftFrequency(Real frequency, Real time, Real timeStep) override;
 		void mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors) override;
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
@@ -75,6 +86,10 @@ namespace Ph1 {
 		void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
 		/// Add MNA post step dependencies
 		void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+		/// Single frequency steps can be batched as companion models
+		Bool mnaCompHasBatchedSteps() const override;
+		Task::Ptr mnaCompCreateBatchedPreStep(const std::vector<MNASimPowerComp<Complex>*>& comps) override;
+		Task::Ptr mnaCompCreateBatchedPostStep(const std::vector<MNASimPowerComp<Complex>*>& comps, Attribute<Matrix>::Ptr leftVector) override;
 
 		// #### Tearing methods ####
 		void mnaTearInitialize(Real omega, Real timestep);
@@ -42,6 +42,29 @@ namespace Ph1 {
 		std::shared_ptr<Capacitor> mSubParallelCapacitor1;
 		/// Right side vectors of subcomponents
 		std::vector<const Matrix*> mRightVectorStamps;
+
+		/// Stamp the RLC elements as one companion model instead of sub components
+		Bool mFlattened = false;
+		/// Equivalent conductance of the flattened series branch
+		Complex mSeriesEquivCond;
+		/// Coefficients of the previous voltage and current in the series equivalent current
+		Complex mSeriesPrevVoltCoeff;
+		Complex mSeriesPrevCurrCoeff;
+		/// Equivalent current source of the flattened series branch
+		Complex mSeriesEquivCurrent;
+		/// Equivalent conductance of the flattened parallel branches
+		Complex mParallelEquivCond;
+		/// Equivalent conductance and previous voltage coefficient of the parallel capacitors
+		Complex mCapEquivCond;
+		Complex mCapPrevVoltCoeff;
+		/// Voltages and capacitor currents of the flattened parallel branches
+		Complex mParallelVoltage0;
+		Complex mParallelVoltage1;
+		Complex mCapCurrent0;
+		Complex mCapCurrent1;
+		/// Equivalent current sources of the parallel capacitors
+		Complex mCapEquivCurrent0;
+		Complex mCapEquivCurrent1;
 	public:
 		/// Defines UID, name and logging level
 		PiLine(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -51,6 +74,12 @@ namespace Ph1 {
 
 		SimPowerComp<Complex>::Ptr clone(String copySuffix);
 
+		/// Stamps the line as a single companion model without sub components and virtual node.
+		/// The series resistance is merged into the inductor history, which gives the same
+		/// solution with one pre and post step and no sub component right vectors.
+		/// Has to be set before the initialization from power flow and does not support tearing.
+		void setFlattened(Bool flattened);
+
 		// #### General ####
 		/// Initializes component from power flow data
 		void initializeFromNodesAndTerminals(Real frequency);
@@ -60,6 +89,12 @@ namespace Ph1 {
 		void mnaCompUpdateCurrent(const Matrix& leftVector);
 		/// Updates internal voltage variable of the component
 		void mnaCompUpdateVoltage(const Matrix& leftVector);
+		/// Initializes the companion model of the flattened line
+		void mnaParentInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+		/// Stamps the companion model of the flattened line
+		void mnaParentApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
+		/// Stamps the equivalent current sources of the flattened line
+		void mnaCompApplyRightSideVectorStamp(Matrix& rightVector) override;
 		/// MNA pre and post step operations
 		void mnaParentPreStep(Real time, Int timeStepCount) override;
 		void mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
@@ -68,15 +68,14 @@ namespace Ph1 {
 		void mnaCompUpdateVoltage(const Matrix& leftVector) override;
 		/// MNA pre step operations
 		void mnaParentPreStep(Real time, Int timeStepCount) override;
-		/// MNA post step operations
-		void mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
+		/// MNA output step operations
+		void mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
 		/// Add MNA pre step dependencies
 		void mnaParentAddPreStepDependencies(AttributeBase::List &prevStepDependencies,
 			AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
-		/// Add MNA post step dependencies
-		void mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies,
-			AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes,
-			Attribute<Matrix>::Ptr &leftVector) override;
+		/// Add MNA output step dependencies
+		void mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies,
+			AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
 	};
 }
 }
@@ -10,6 +10,7 @@
 
 #include <dpsim-models/Base/Base_ReducedOrderSynchronGenerator.h>
 #include <dpsim-models/Solver/MNAVariableCompInterface.h>
+#include <dpsim-models/Solver/MNAIterativeCompInterface.h>
 
 namespace CPS {
 namespace DP {
@@ -17,7 +18,8 @@ namespace Ph1 {
 	/// @brief Base class for DP VBR synchronous generator model single phase
 	class ReducedOrderSynchronGeneratorVBR :
 		public Base::ReducedOrderSynchronGenerator<Complex>,
-		public MNAVariableCompInterface {
+		public MNAVariableCompInterface,
+		public MNAIterativeCompInterface {
 
 	public:
         // Common elements of all VBR models
@@ -31,6 +33,8 @@ namespace Ph1 {
 		Matrix mResistanceMatrixDq;
 		/// Conductance matrix phase A
 		MatrixFixedSize<2, 2> mConductanceMatrix;
+		/// Conductance matrix phase A without the rotor angle dependent part
+		MatrixFixedSize<2, 2> mConstantConductanceMatrix;
 		/// Ka Matrix
 		MatrixComp mKa;
 		/// Kb Matrix
@@ -69,6 +73,9 @@ namespace Ph1 {
 		void calculateAuxiliarVariables();
 		///
 		Matrix get_parkTransformMatrix() const;
+		/// Norton current corrected by the deviation of the conductance matrix
+		/// from the constant conductance matrix at the given terminal voltage
+		Complex correctedNortonCurrent(Complex voltage) const;
 
 		// ### MNA Section ###
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
@@ -78,7 +85,11 @@ namespace Ph1 {
 
     public:
         /// Mark that parameter changes so that system matrix is updated
-		Bool hasParameterChanged() override { return true; };
+		Bool hasParameterChanged() override { return !hasConstantConductance(); };
+		///
+		Bool mnaIsIterative() const override { return hasConstantConductance(); };
+		///
+		Bool mnaCorrectorStep(const Matrix& leftVector) override;
     };
 }
 }
@@ -47,11 +47,11 @@ namespace Ph1 {
 		void mnaCompUpdateVoltage(const Matrix& leftVector) override;
 		void mnaCompUpdateCurrent(const Matrix& leftVector) override;
 		void mnaParentAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
-		void mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+		void mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
 
 		/// MNA pre and post step operations
 		void mnaParentPreStep(Real time, Int timeStepCount) override;
-		void mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
+		void mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
 
 	};
 }
@@ -11,6 +11,7 @@
 #include <dpsim-models/MNASimPowerComp.h>
 #include <dpsim-models/Solver/MNAInterface.h>
 #include <dpsim-models/Solver/DAEInterface.h>
+#include <dpsim-models/Solver/MNAVariableFrequencyInterface.h>
 #include <dpsim-models/Signal/SineWaveGenerator.h>
 #include <dpsim-models/Signal/SignalGenerator.h>
 #include <dpsim-models/Signal/FrequencyRampGenerator.h>
@@ -39,12 +40,18 @@ namespace Ph1 {
 	class VoltageSource :
 		public MNASimPowerComp<Complex>,
 		public DAEInterface,
+		public MNAVariableFrequencyInterface,
 		public SharedFactory<VoltageSource> {
 	private:
 		///
 		void updateVoltage(Real time);
 		///
 		CPS::Signal::SignalGenerator::Ptr mSrcSig;
+		/// Shift frequency minus the nominal frequency the signal is defined for
+		Real mShiftFrequencyOffset = 0;
+		/// Angle the shifted frame is ahead of the nominal frame at mShiftTime
+		Real mShiftAngle = 0;
+		Real mShiftTime = 0;
 	public:
 		const CPS::Attribute<Complex>::Ptr mVoltageRef;
 		const CPS::Attribute<Real>::Ptr mSrcFreq;
@@ -80,6 +87,8 @@ namespace Ph1 {
 		/// Initializes internal variables of the component
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
 		void mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors) override;
+		/// Rotates the source phasor into the frame of the new shift frequency
+		void mnaUpdateShiftFrequency(Real frequency, Real time, Real timeStep) override;
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
 		void mnaCompApplySystemMatrixStampHarm(SparseMatrixRow& systemMatrix, Int freqIdx) override;
@@ -0,0 +1,87 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim-models/MNASimPowerComp.h>
+
+namespace CPS {
+namespace EMT {
+	/// \brief Batched MNA steps of trapezoidal companion models
+	///
+	/// A companion model is a conductance in parallel with a current source
+	/// which is calculated from the previous voltage and current of the component.
+	/// Inductors and capacitors only differ in the coefficients of the current source,
+	/// so the steps of all of them with the same number of phases are executed in one
+	/// loop over arrays of their parameters and node rows.
+	template <int NumPhases>
+	class CompanionModelBatch : public Task {
+	public:
+		using CondMatrix = Eigen::Matrix<Real, NumPhases, NumPhases>;
+		using Vector = Eigen::Matrix<Real, NumPhases, 1>;
+		using Rows = std::array<Matrix::Index, NumPhases>;
+
+		/// Companion model of one component
+		struct Member {
+			MNASimPowerComp<Real>* comp;
+			/// Equivalent conductance
+			CondMatrix equivCond;
+			/// Coefficient in front of the previous voltage in the equivalent current
+			CondMatrix voltageCoeff;
+			/// Coefficient in front of the previous current in the equivalent current
+			Real currentCoeff;
+			/// Equivalent current source, which stays owned by the component
+			Real* equivCurrent;
+		};
+
+		/// Interface of the components whose steps can be executed by the batch
+		class Provider {
+		public:
+			virtual ~Provider() = default;
+			/// Returns the companion model of the component
+			virtual Member companionModelMember() = 0;
+		};
+
+		/// Collects the companion models of components implementing the Provider interface
+		static std::vector<Member> members(const std::vector<MNASimPowerComp<Real>*>& comps);
+
+	protected:
+		CompanionModelBatch(const String& name, const std::vector<Member>& members);
+
+		std::vector<CondMatrix> mEquivCond;
+		std::vector<CondMatrix> mVoltageCoeff;
+		std::vector<Real> mCurrentCoeff;
+		std::vector<Real*> mEquivCurrent;
+		std::vector<std::shared_ptr<Matrix>> mIntfVoltage;
+		std::vector<std::shared_ptr<Matrix>> mIntfCurrent;
+		std::vector<std::shared_ptr<Matrix>> mRightVector;
+		/// Rows of the terminal voltages, negative for grounded terminals
+		std::vector<Rows> mRows0;
+		std::vector<Rows> mRows1;
+	};
+
+	/// Calculates the equivalent current sources and stamps them into the right vectors
+	template <int NumPhases>
+	class CompanionModelPreStepBatch : public CompanionModelBatch<NumPhases> {
+	public:
+		CompanionModelPreStepBatch(const std::vector<typename CompanionModelBatch<NumPhases>::Member>& members);
+		void execute(Real time, Int timeStepCount) override;
+	};
+
+	/// Updates the interface voltages and currents from the solution
+	template <int NumPhases>
+	class CompanionModelPostStepBatch : public CompanionModelBatch<NumPhases> {
+	public:
+		CompanionModelPostStepBatch(const std::vector<typename CompanionModelBatch<NumPhases>::Member>& members, Attribute<Matrix>::Ptr leftVector);
+		void execute(Real time, Int timeStepCount) override;
+
+	private:
+		Attribute<Matrix>::Ptr mLeftVector;
+	};
+}
+}
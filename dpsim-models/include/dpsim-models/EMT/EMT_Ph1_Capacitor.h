@@ -10,6 +10,8 @@
 
 #include <dpsim-models/MNASimPowerComp.h>
 #include <dpsim-models/Solver/MNAInterface.h>
+#include <dpsim-models/EMT/EMT_CompanionModelBatch.h>
+#include <dpsim-models/Solver/MNAVariableTimeStepInterface.h>
 #include <dpsim-models/Base/Base_Ph1_Capacitor.h>
 
 namespace CPS {
@@ -25,6 +27,8 @@ namespace Ph1 {
 	class Capacitor :
 		public MNASimPowerComp<Real>,
 		public Base::Ph1::Capacitor,
+		public EMT::CompanionModelBatch<1>::Provider,
+		public MNAVariableTimeStepInterface,
 		public SharedFactory<Capacitor> {
 	protected:
 		/// DC equivalent current source [A]
@@ -47,6 +51,8 @@ namespace Ph1 {
 		// #### MNA section ####
 		/// Initializes internal variables of the component
 		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
+		/// Recomputes the companion model coefficients for the new time step
+		void mnaUpdateTimeStep(Real timeStep) override;
 		/// Stamps system matrix
 		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
@@ -63,6 +69,13 @@ namespace Ph1 {
 		void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
 		/// Add MNA post step dependencies
 		void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+
+		/// Steps can be batched with the other Ph1 companion models
+		Bool mnaCompHasBatchedSteps() const override;
+		String mnaCompBatchGroup() const override;
+		Task::Ptr mnaCompCreateBatchedPreStep(const std::vector<MNASimPowerComp<Real>*>& comps) override;
+		Task::Ptr mnaCompCreateBatchedPostStep(const std::vector<MNASimPowerComp<Real>*>& comps, Attribute<Matrix>::Ptr leftVector) override;
+		EMT::CompanionModelBatch<1>::Member companionModelMember() override;
 	};
 }
 }
@@ -0,0 +1,106 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim-models/MNASimPowerComp.h>
+#include <dpsim-models/Solver/MNAInterface.h>
+#include <dpsim-models/Solver/MNAVariableTimeStepInterface.h>
+
+namespace CPS {
+namespace EMT {
+namespace Ph1 {
+	/// \brief Frequency dependent network equivalent (FDNE) of an external grid
+	///
+	/// Multiport admittance between each terminal and ground given as rational
+	/// function Y(s) = D + sum_k R_k / (s - p_k). Complex poles have to come
+	/// with their conjugates and conjugate residues, so that the currents are real.
+	/// Each pole has one state per port, which is integrated with the trapezoidal
+	/// rule. The equivalent then stamps a constant conductance matrix and a
+	/// history current into each terminal, like the companion models of the
+	/// inductor and capacitor.
+	class FrequencyDependentNetworkEquivalent :
+		public MNASimPowerComp<Real>,
+		public MNAVariableTimeStepInterface,
+		public SharedFactory<FrequencyDependentNetworkEquivalent> {
+	public:
+		/// Rational admittance model, e.g. fitted by vector fitting
+		struct Model {
+			/// Constant part, ports x ports
+			Matrix constant;
+			/// Poles in rad/s
+			std::vector<Complex> poles;
+			/// Residue matrix of each pole, ports x ports
+			std::vector<MatrixComp> residues;
+
+			UInt ports() const { return static_cast<UInt>(constant.rows()); }
+			/// Admittance matrix at the angular frequency
+			MatrixComp admittance(Real omega) const;
+		};
+
+	protected:
+		Model mModel;
+		/// Equivalent conductance matrix of the trapezoidal rule [S]
+		Matrix mEquivCond;
+		/// Factors of the previous state and the sum of the inputs of the trapezoidal rule per pole
+		std::vector<Complex> mStateFactors;
+		std::vector<Complex> mInputFactors;
+		/// States, ports x poles
+		MatrixComp mStates;
+		/// History current into each terminal [A]
+		Matrix mEquivCurrent;
+
+		/// Computes the trapezoidal rule factors and the equivalent conductance
+		void initVars(Real timeStep);
+		/// Voltages of the terminals
+		void updateTerminalVoltages(const Matrix& leftVector, Matrix& voltages);
+
+	public:
+		/// Defines UID, name and logging level
+		FrequencyDependentNetworkEquivalent(String uid, String name, Logger::Level logLevel = Logger::Level::off);
+		/// Defines name and logging level
+		FrequencyDependentNetworkEquivalent(String name, Logger::Level logLevel = Logger::Level::off)
+			: FrequencyDependentNetworkEquivalent(name, name, logLevel) { }
+
+		SimPowerComp<Real>::Ptr clone(String name);
+
+		// #### General ####
+		/// Sets the model, which has one terminal per port
+		void setParameters(const Model& model);
+		///
+		const Model& model() const { return mModel; }
+		/// Initializes the states for the sinusoidal steady state of the terminal voltages
+		void initializeFromNodesAndTerminals(Real frequency);
+
+		// #### MNA section ####
+		/// Initializes internal variables of the component
+		void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
+		/// Recomputes the companion model coefficients for the new time step
+		void mnaUpdateTimeStep(Real timeStep) override;
+		/// Stamps system matrix
+		void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
+		/// Stamps right side (source) vector
+		void mnaCompApplyRightSideVectorStamp(Matrix& rightVector);
+		/// Update interface voltage from MNA system result
+		void mnaCompUpdateVoltage(const Matrix& leftVector);
+		/// Update interface current from MNA system result
+		void mnaCompUpdateCurrent(const Matrix& leftVector);
+
+		void mnaCompPreStep(Real time, Int timeStepCount) override;
+		void mnaCompPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
+
+		/// Add MNA pre step dependencies
+		void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
+		/// Add MNA post step dependencies
+		void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+	};
+}
+}
+}
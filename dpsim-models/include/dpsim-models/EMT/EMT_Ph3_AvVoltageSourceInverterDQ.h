@@ -16,6 +16,7 @@
 #include <dpsim-models/EMT/EMT_Ph3_VoltageSource.h>
 #include <dpsim-models/EMT/EMT_Ph3_Transformer.h>
 #include <dpsim-models/Base/Base_AvVoltageSourceInverterDQ.h>
+#include <dpsim-models/Base/Base_Converter.h>
 #include <dpsim-models/Signal/PLL.h>
 #include <dpsim-models/Signal/PowerControllerVSI.h>
 
@@ -25,6 +26,7 @@ namespace Ph3 {
 	class AvVoltageSourceInverterDQ :
 		public CompositePowerComp<Real>,
 		public Base::AvVoltageSourceInverterDQ,
+		public Base::Converter,
 		public SharedFactory<AvVoltageSourceInverterDQ> {
 	protected:
 
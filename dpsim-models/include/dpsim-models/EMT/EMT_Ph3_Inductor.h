@@ -10,6 +10,8 @@
 
 #include <dpsim-models/MNASimPowerComp.h>
 #include <dpsim-models/Solver/MNAInterface.h>
+#include <dpsim-models/EMT/EMT_CompanionModelBatch.h>
+#include <dpsim-models/Solver/MNAVariableTimeStepInterface.h>
 #include <dpsim-models/Base/Base_Ph3_Inductor.h>
 
 namespace CPS {
@@ -25,12 +27,14 @@ namespace CPS {
 			class Inductor :
 				public MNASimPowerComp<Real>,
 				public Base::Ph3::Inductor,
+				public EMT::CompanionModelBatch<3>::Provider,
+				public MNAVariableTimeStepInterface,
 				public SharedFactory<Inductor> {
 			protected:
 				/// DC equivalent current source [A]
-				Matrix mEquivCurrent = Matrix::Zero(3, 1);
+				MatrixFixedSize<3, 1> mEquivCurrent = MatrixFixedSize<3, 1>::Zero();
 				/// Equivalent conductance [S]
-				Matrix mEquivCond = Matrix::Zero(3, 3);
+				MatrixFixedSize<3, 3> mEquivCond = MatrixFixedSize<3, 3>::Zero();
 			public:
 				/// Defines UID, name, component parameters and logging level
 				Inductor(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -47,6 +51,8 @@ namespace CPS {
 				// #### MNA section ####
 				/// Initializes internal variables of the component
 				void mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
+				/// Recomputes the companion model coefficients for the new time step
+				void mnaUpdateTimeStep(Real timeStep) override;
 				/// Stamps system matrix
 				void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
 				/// Stamps right side (source) vector
@@ -63,6 +69,13 @@ namespace CPS {
 				void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
 				/// Add MNA post step dependencies
 				void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+
+				/// Steps can be batched with the other Ph3 companion models
+				Bool mnaCompHasBatchedSteps() const override;
+				String mnaCompBatchGroup() const override;
+				Task::Ptr mnaCompCreateBatchedPreStep(const std::vector<MNASimPowerComp<Real>*>& comps) override;
+				Task::Ptr mnaCompCreateBatchedPostStep(const std::vector<MNASimPowerComp<Real>*>& comps, Attribute<Matrix>::Ptr leftVector) override;
+				EMT::CompanionModelBatch<3>::Member companionModelMember() override;
 			};
 		}
 	}
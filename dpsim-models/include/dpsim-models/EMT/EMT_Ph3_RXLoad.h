@@ -74,10 +74,10 @@ namespace CPS {
 
 				/// MNA pre and post step operations
 				void mnaParentPreStep(Real time, Int timeStepCount) override;
-				void mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
+				void mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
 
 				void mnaParentAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
-				void mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+				void mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
 			};
 		}
 	}
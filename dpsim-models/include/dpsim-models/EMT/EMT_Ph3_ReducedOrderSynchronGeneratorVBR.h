@@ -10,6 +10,7 @@
 
 #include <dpsim-models/Base/Base_ReducedOrderSynchronGenerator.h>
 #include <dpsim-models/Solver/MNAVariableCompInterface.h>
+#include <dpsim-models/Solver/MNAIterativeCompInterface.h>
 
 namespace CPS {
 namespace EMT {
@@ -17,7 +18,8 @@ namespace Ph3 {
 	/// @brief Base class for EMT VBR simplefied synchronous generator models
 	class ReducedOrderSynchronGeneratorVBR :
 		public Base::ReducedOrderSynchronGenerator<Real>,
-		public MNAVariableCompInterface {
+		public MNAVariableCompInterface,
+		public MNAIterativeCompInterface {
 
     public:
         // Common elements of all VBR models
@@ -30,12 +32,25 @@ namespace Ph3 {
         /// Resistance matrix in dq0 reference frame
 		MatrixFixedSize<3, 3> mResistanceMatrixDq0;
 
+		/// Inverse of the resistance matrix in dq0 reference frame
+		MatrixFixedSize<3, 3> mConductanceMatrixDq0;
+
 		/// Conductance matrix
 		MatrixFixedSize<3, 3> mConductanceMatrix;
 
+		/// Conductance matrix without the rotor angle dependent part
+		MatrixFixedSize<3, 3> mConstantConductanceMatrix;
+
+		/// Conductance matrix in the system matrix, which only follows significant changes
+		MatrixFixedSize<3, 3> mStampedConductanceMatrix;
+		/// True if the stamped conductance matrix changed since the last system matrix stamp
+		Bool mStampOutdated = false;
+		/// Norton current injected into the network
+		MatrixFixedSize<3, 1> mNortonCurrent;
+
 		///
-		Matrix mAbcToDq0;
-		Matrix mDq0ToAbc;
+		MatrixFixedSize<3, 3> mAbcToDq0;
+		MatrixFixedSize<3, 3> mDq0ToAbc;
 
         /// Constructor
         ReducedOrderSynchronGeneratorVBR(const String & uid, const String & name, Logger::Level logLevel);
@@ -51,9 +66,12 @@ namespace Ph3 {
 		///
         void calculateResistanceMatrix();
         /// Park Transformation according to Kundur
-        Matrix get_parkTransformMatrix() const;
+        MatrixFixedSize<3, 3> get_parkTransformMatrix() const;
 		/// Inverse Park Transformation according to Kundur
-		Matrix get_inverseParkTransformMatrix() const;
+		MatrixFixedSize<3, 3> get_inverseParkTransformMatrix() const;
+		/// Norton current corrected by the deviation of the conductance matrix
+		/// from the constant conductance matrix at the given terminal voltage
+		MatrixFixedSize<3, 1> correctedNortonCurrent(const Matrix& voltage) const;
 
         // ### MNA Section ###
         void mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
@@ -63,7 +81,11 @@ namespace Ph3 {
 
     public:
         /// Mark that parameter changes so that system matrix is updated
-		Bool hasParameterChanged() override { return true; };
+		Bool hasParameterChanged() override { return !hasConstantConductance() && (!mModelAsCurrentSource || mStampOutdated); };
+		///
+		Bool mnaIsIterative() const override { return hasConstantConductance(); };
+		///
+		Bool mnaCorrectorStep(const Matrix& leftVector) override;
     };
 }
 }
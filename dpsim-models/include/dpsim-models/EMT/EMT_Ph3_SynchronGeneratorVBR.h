@@ -100,9 +100,9 @@ namespace Ph3 {
 		/// Phase currents in pu
 		Matrix mIabc = Matrix::Zero(3, 1);
 		///Phase Voltages in pu
-		Matrix mVabc = Matrix::Zero(3, 1);
+		MatrixFixedSize<3, 1> mVabc = MatrixFixedSize<3, 1>::Zero();
 		/// Subtransient voltage in pu
-		Matrix mDVabc = Matrix::Zero(3, 1);
+		MatrixFixedSize<3, 1> mDVabc = MatrixFixedSize<3, 1>::Zero();
 
 		/// Dq stator current vector
 		Matrix mDqStatorCurrents = Matrix::Zero(2, 1);
@@ -113,22 +113,24 @@ namespace Ph3 {
 
 		// ### Useful Matrices ###
 		/// inductance matrix
-		Matrix mDInductanceMat = Matrix::Zero(3, 3);
+		MatrixFixedSize<3, 3> mDInductanceMat = MatrixFixedSize<3, 3>::Zero();
 
 		/// Q axis Rotor flux
 		Matrix mPsikq1kq2 = Matrix::Zero(2, 1);
 		/// D axis rotor flux
 		Matrix mPsifdkd = Matrix::Zero(2, 1);
 		/// Equivalent Stator Conductance Matrix
-		Matrix mConductanceMat = Matrix::Zero(3, 3);
+		MatrixFixedSize<3, 3> mConductanceMat = MatrixFixedSize<3, 3>::Zero();
 		/// Equivalent Stator Current Source
-		Matrix mISourceEq = Matrix::Zero(3, 1);
+		MatrixFixedSize<3, 1> mISourceEq = MatrixFixedSize<3, 1>::Zero();
 		/// Dynamic Voltage Vector
 		Matrix mDVqd = Matrix::Zero(2, 1);
 		/// Equivalent VBR Stator Resistance
 		MatrixFixedSize<3, 3> R_eq_vbr = MatrixFixedSize<3, 3>::Zero(3, 3);
+		/// Inverse of the equivalent VBR Stator Resistance, updated once per step
+		MatrixFixedSize<3, 3> R_eq_vbr_inv = MatrixFixedSize<3, 3>::Zero();
 		/// Equivalent VBR Stator Voltage Source
-		Matrix E_eq_vbr = Matrix::Zero(3, 1);
+		MatrixFixedSize<3, 1> E_eq_vbr = MatrixFixedSize<3, 1>::Zero();
 		/// Park Transformation Matrix
 		MatrixFixedSize<3, 3> mKrs_teta = MatrixFixedSize<3, 3>::Zero(3, 3);
 		/// Inverse Park Transformation Matrix
@@ -145,11 +147,11 @@ namespace Ph3 {
 		MatrixFixedSize<2, 2> K2a = MatrixFixedSize<2, 2>::Zero(2, 2);
 		Matrix K2b = Matrix::Zero(2, 1);
 		Matrix K2 = Matrix::Zero(2, 1);
-		Matrix H_qdr = Matrix::Zero(3, 1);
+		MatrixFixedSize<3, 1> H_qdr = MatrixFixedSize<3, 1>::Zero();
 		Matrix h_qdr;
 		MatrixFixedSize<3, 3> K = MatrixFixedSize<3, 3>::Zero(3, 3);
-		Matrix mEsh_vbr = Matrix::Zero(3, 1);
-		Matrix E_r_vbr = Matrix::Zero(3, 1);
+		MatrixFixedSize<3, 1> mEsh_vbr = MatrixFixedSize<3, 1>::Zero();
+		MatrixFixedSize<3, 1> E_r_vbr = MatrixFixedSize<3, 1>::Zero();
 		MatrixFixedSize<2, 2> K1K2 = MatrixFixedSize<2, 2>::Zero(2, 2);
 
 		/// Auxiliar constants
@@ -231,10 +233,10 @@ namespace Ph3 {
 		void stepInPerUnit();
 
 		/// Park transform as described in Krause
-		Matrix parkTransform(Real theta, Real a, Real b, Real c);
+		MatrixFixedSize<3, 1> parkTransform(Real theta, Real a, Real b, Real c);
 
 		/// Inverse Park transform as described in Krause
-		Matrix inverseParkTransform(Real theta, Real q, Real d, Real zero);
+		MatrixFixedSize<3, 1> inverseParkTransform(Real theta, Real q, Real d, Real zero);
 
 		/// Calculate inductance Matrix L and its derivative
 		void CalculateL();
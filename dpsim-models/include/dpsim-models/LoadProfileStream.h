@@ -0,0 +1,63 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <fstream>
+#include <memory>
+
+#include <dpsim-models/Definitions.h>
+#include <dpsim-models/Filesystem.h>
+#include <dpsim-models/PowerProfile.h>
+
+namespace CPS {
+	/// \brief Reads a load profile from a csv file while the simulation advances
+	///
+	/// Instead of loading the whole profile up front, rows are read in chunks
+	/// ahead of the requested time and dropped once the time has passed them,
+	/// so the memory per load is bounded by the prefetch window. The rows are
+	/// parsed like CSVReader::readLoadProfile does: time and active and
+	/// reactive power in kW, or time and a weighting factor. Values between
+	/// rows are interpolated linearly, values outside of the profile are held.
+	/// Requested times must not decrease.
+	class LoadProfileStream {
+	public:
+		typedef std::shared_ptr<LoadProfileStream> Ptr;
+
+		/// Opens the profile, reading chunks of windowRows rows. The time
+		/// stamps are converted from HH:MM:SS if hhmmss is set.
+		LoadProfileStream(const fs::path& file, Bool hhmmss = false, Bool skipFirstRow = true, UInt windowRows = 1024);
+
+		/// Returns true for profiles of weighting factors instead of power values
+		Bool hasWeightingFactors() const { return mWeightingFactors; }
+		/// Active and reactive power in W at the given time
+		PQData pq(Real time);
+		/// Weighting factor at the given time
+		Real weightingFactor(Real time);
+		/// Rows currently held in memory
+		UInt bufferedRows() const { return static_cast<UInt>(mTimes.size()); }
+
+	private:
+		/// Reads up to one window of rows, returns false at the end of the file
+		Bool readChunk();
+		/// Drops the rows before the given time and interpolates between the remaining ones
+		PQData interpolate(Real time);
+		/// Parses a row, returns false for lines without data
+		Bool parseRow(const String& line, Real& time, PQData& values);
+
+		std::ifstream mFile;
+		Bool mHHMMSS;
+		UInt mWindowRows;
+		Bool mWeightingFactors = false;
+		Bool mEndOfFile = false;
+		/// Prefetched rows, weighting factors are stored as p
+		std::deque<Real> mTimes;
+		std::deque<PQData> mValues;
+	};
+}
@@ -8,7 +8,10 @@
 
 #pragma once
 
+// The build sets the level with DPSIM_LOG_LEVEL, statements below it are compiled out
+#ifndef SPDLOG_ACTIVE_LEVEL
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
 #include <spdlog/spdlog.h>
 
 #if defined(SPDLOG_VER_MAJOR) && SPDLOG_VER_MAJOR >= 1
@@ -49,6 +52,22 @@ namespace CPS {
 		///
 		static void setLogPattern(std::shared_ptr<spdlog::logger> logger, std::string pattern);
 
+		// #### Matrix size limits ####
+		/// Matrices with more entries are only logged with their dimensions,
+		/// so logging a large system does not format it. 0 logs all matrices.
+		static void setMatrixLogLimit(UInt entries);
+		///
+		static UInt matrixLogLimit();
+		/// Matrices with at most this number of nonzeros are written by dumpMatrix, 0 disables the dumps
+		static void setMatrixDumpLimit(UInt nonZeros);
+		/// Writes the matrix in MatrixMarket coordinate format to name.mtx in the
+		/// log directory if dumps are enabled and it is within the dump limit
+		static void dumpMatrix(const String& name, const SparseMatrix& mat);
+		///
+		static void dumpMatrix(const String& name, const SparseMatrixRow& mat);
+		///
+		static void dumpMatrix(const String& name, const Matrix& mat);
+
 		// #### to string methods ####
 		static String matrixToString(const Matrix& mat);
 		static String matrixCompToString(const MatrixComp& mat);
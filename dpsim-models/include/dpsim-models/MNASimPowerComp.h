@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <typeinfo>
+
 #include <dpsim-models/SimPowerComp.h>
 #include <dpsim-models/Solver/MNAInterface.h>
 
@@ -14,6 +17,10 @@ namespace CPS {
 	private:
 		Bool mHasPreStep;
 		Bool mHasPostStep;
+		/// The output step is a task of its own instead of a part of the post step
+		Bool mSeparateOutputStep = false;
+		/// The output step is always part of the post step, e.g. for subcomponents
+		Bool mMergeOutputStep = false;
 
 	public:
 		using Type = VarType;
@@ -21,7 +28,7 @@ namespace CPS {
 		using List = std::vector<Ptr>;
 
 		/// This component's contribution ("stamp") to the right-side vector.
-		/// TODO performance improvements from a sparse representation, at least during copying / summation?
+		/// Solvers can sum it up sparsely using the rows returned by mnaRightVectorStampRows.
 		Attribute<Matrix>::Ptr mRightVector;
 
 		/// List of tasks that relate to using MNA for this component (usually pre-step and/or post-step)
@@ -50,6 +57,7 @@ namespace CPS {
 		void mnaUpdateCurrent(const Matrix& leftVector) final;
 		void mnaPreStep(Real time, Int timeStepCount) final;
 		void mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) final;
+		void mnaOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) final;
 		void mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) final;
 		void mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) final;
 		void mnaInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVector) final;
@@ -67,15 +75,37 @@ namespace CPS {
 		virtual void mnaCompPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
 		virtual void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes);
 		virtual void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector);
+		/// Computes outputs which the component itself does not need, like its terminal current.
+		/// Executed by a task of its own, which is dropped by the scheduler if no other task,
+		/// logger or interface depends on the modified attributes.
+		virtual void mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
+		/// Add MNA output step dependencies, a component without modified attributes has no output step
+		virtual void mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector);
 		virtual void mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVector);
 		virtual void mnaCompApplySystemMatrixStampHarm(SparseMatrixRow& systemMatrix, Int freqIdx);
 		virtual void mnaCompApplyRightSideVectorStampHarm(Matrix& sourceVector);
 		virtual void mnaCompApplyRightSideVectorStampHarm(Matrix& sourceVector, Int freqIdx);
+		/// Returns true if the pre and post steps of this component can be executed
+		/// together with those of other components of the same type
+		virtual Bool mnaCompHasBatchedSteps() const;
+		/// Returns the group of components whose steps are batched together, which is the type by default
+		virtual String mnaCompBatchGroup() const;
+		/// Creates one task executing the pre steps of the given components, which are of the type of this component
+		virtual Task::Ptr mnaCompCreateBatchedPreStep(const std::vector<MNASimPowerComp<VarType>*>& comps);
+		/// Creates one task executing the post steps of the given components, which are of the type of this component
+		virtual Task::Ptr mnaCompCreateBatchedPostStep(const std::vector<MNASimPowerComp<VarType>*>& comps, Attribute<Matrix>::Ptr leftVector);
+
+		/// Executes the output step as part of the post step, required if the tasks of the
+		/// component are not scheduled, like for subcomponents. Must be called before the
+		/// component is initialized.
+		void mnaMergeOutputStep() { mMergeOutputStep = true; }
 
 		const Task::List& mnaTasks() const final;
 		Attribute<Matrix>::Ptr getRightVector() const final;
+		/// Returns the rows of all connected, virtual and subcomponent nodes
+		Bool mnaRightVectorStampRows(std::vector<UInt>& rows) override;
 
-		class MnaPreStep : public CPS::Task {
+		class MnaPreStep : public CPS::Task, public SharedFactory<MnaPreStep> {
 		public:
 			explicit MnaPreStep(MNASimPowerComp<VarType>& comp) :
 				Task(**comp.mName + ".MnaPreStep"), mComp(comp) {
@@ -84,12 +114,23 @@ namespace CPS {
 			void execute(Real time, Int timeStepCount) override {
 				mComp.mnaPreStep(time, timeStepCount);
 			};
+			String batchKey() const override {
+				if (!mComp.mnaCompHasBatchedSteps())
+					return String();
+				return String("MnaPreStep.") + mComp.mnaCompBatchGroup();
+			}
+			Task::Ptr createBatch(const Task::List& tasks) const override {
+				std::vector<MNASimPowerComp<VarType>*> comps;
+				for (auto& task : tasks)
+					comps.push_back(&static_cast<MnaPreStep&>(*task).mComp);
+				return mComp.mnaCompCreateBatchedPreStep(comps);
+			}
 
 		private:
 			MNASimPowerComp<VarType>& mComp;
 		};
 
-		class MnaPostStep : public CPS::Task {
+		class MnaPostStep : public CPS::Task, public SharedFactory<MnaPostStep> {
 		public:
 			MnaPostStep(MNASimPowerComp<VarType>& comp, Attribute<Matrix>::Ptr leftVector) :
 				Task(**comp.mName + ".MnaPostStep"), mComp(comp), mLeftVector(leftVector) {
@@ -98,6 +139,38 @@ namespace CPS {
 			void execute(Real time, Int timeStepCount) override {
 				mComp.mnaPostStep(time, timeStepCount, mLeftVector);
 			};
+			String batchKey() const override {
+				if (!mComp.mnaCompHasBatchedSteps())
+					return String();
+				// Only post steps reading the same solution can be batched
+				return String("MnaPostStep.") + mComp.mnaCompBatchGroup() + "." + std::to_string(reinterpret_cast<std::uintptr_t>(mLeftVector.get()));
+			}
+			Task::Ptr createBatch(const Task::List& tasks) const override {
+				std::vector<MNASimPowerComp<VarType>*> comps;
+				for (auto& task : tasks)
+					comps.push_back(&static_cast<MnaPostStep&>(*task).mComp);
+				return mComp.mnaCompCreateBatchedPostStep(comps, mLeftVector);
+			}
+
+		private:
+			MNASimPowerComp<VarType>& mComp;
+			Attribute<Matrix>::Ptr mLeftVector;
+		};
+
+		class MnaOutputStep : public CPS::Task, public SharedFactory<MnaOutputStep> {
+		public:
+			MnaOutputStep(MNASimPowerComp<VarType>& comp, Attribute<Matrix>::Ptr leftVector) :
+				Task(**comp.mName + ".MnaOutputStep"), mComp(comp), mLeftVector(leftVector) {
+				mComp.mnaCompAddOutputStepDependencies(mAttributeDependencies, mModifiedAttributes, mLeftVector);
+				// Outputs are computed from the states updated in the post step, e.g. of subcomponents
+				AttributeBase::List prevStepDependencies, postStepDependencies, postStepModified;
+				mComp.mnaAddPostStepDependencies(prevStepDependencies, postStepDependencies, postStepModified, mLeftVector);
+				for (auto& attr : postStepModified)
+					mAttributeDependencies.push_back(attr);
+			}
+			void execute(Real time, Int timeStepCount) override {
+				mComp.mnaCompOutputStep(time, timeStepCount, mLeftVector);
+			};
 
 		private:
 			MNASimPowerComp<VarType>& mComp;
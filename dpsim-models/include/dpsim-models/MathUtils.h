@@ -8,10 +8,88 @@
 
 #pragma once
 
+#include <array>
+#include <functional>
+#include <type_traits>
+
 #include <dpsim-models/Definitions.h>
 
 namespace CPS {
 
+	/// Two-phase stamping of sparse matrix elements.
+	/// While recording, the stamps of the Math matrix element functions into the target matrix
+	/// are applied via coeffRef and their positions in the value array are stored.
+	/// While replaying, the same sequence of stamps is written directly to these positions.
+	class MatrixStampSlots {
+	public:
+		/// Starts recording the stamps into the given matrix for the current thread
+		void record(SparseMatrixRow& mat);
+		/// Starts replaying the recorded stamps into the given matrix for the current thread
+		void replay(SparseMatrixRow& mat);
+		/// Stops recording or replaying and resolves the recorded positions
+		void stop();
+		/// Returns true if positions were recorded and the last replay matched the recorded sequence
+		Bool valid() const { return mValid; }
+		/// Returns a reference to the matrix element, using the recorded position if possible
+		Real& element(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column);
+
+		/// Returns the active stamp slots of the current thread or nullptr
+		static MatrixStampSlots*& active();
+	private:
+		enum class Mode { Idle, Record, Replay };
+		///
+		Mode mMode = Mode::Idle;
+		///
+		SparseMatrixRow* mTarget = nullptr;
+		/// Recorded matrix elements in stamping order
+		std::vector<std::pair<Matrix::Index, Matrix::Index>> mElements;
+		/// Positions of the recorded elements in the value array
+		std::vector<Matrix::Index> mSlots;
+		/// Next element to be replayed
+		UInt mCursor = 0;
+		///
+		Bool mValid = false;
+	};
+
+	/// \brief Piecewise linear approximation of a scalar function
+	///
+	/// The function is sampled on an equidistant grid, which is refined until the
+	/// interpolation error at the interval midpoints is below the tolerance.
+	/// Arguments outside of the interval are evaluated with the function itself.
+	class LookupTable {
+	public:
+		typedef std::shared_ptr<const LookupTable> Ptr;
+
+		LookupTable(std::function<Real(Real)> fcn, Real min, Real max, Real tolerance, UInt maxPoints = 1 << 16);
+
+		/// Returns the table of the given name, range and tolerance and creates
+		/// it on first use, so that all instances of a component share the table
+		static Ptr shared(const String& name, std::function<Real(Real)> fcn, Real min, Real max, Real tolerance);
+
+		/// Interpolates the function value
+		Real operator()(Real x) const {
+			if (x < mMin || x > mMax)
+				return mFcn(x);
+			Real pos = (x - mMin) * mInvStep;
+			UInt idx = std::min(static_cast<UInt>(pos), static_cast<UInt>(mValues.size()) - 2);
+			Real frac = pos - idx;
+			return mValues[idx] + frac * (mValues[idx + 1] - mValues[idx]);
+		}
+
+		/// Number of sampling points
+		UInt size() const { return static_cast<UInt>(mValues.size()); }
+		/// Maximum interpolation error at the interval midpoints
+		Real maxError() const { return mMaxError; }
+
+	private:
+		std::function<Real(Real)> mFcn;
+		Real mMin;
+		Real mMax;
+		Real mInvStep;
+		std::vector<Real> mValues;
+		Real mMaxError;
+	};
+
 	class Math {
 	public:
 		typedef Real(*DeriveFnPtr) (Matrix inputs);
@@ -62,14 +140,88 @@ namespace CPS {
 
 		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq = 1, Int freqIdx = 0);
 
-		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Matrix value, Int maxFreq = 1, Int freqIdx = 0);
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, const Matrix& value, Int maxFreq = 1, Int freqIdx = 0);
 
 		static void setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value);
 
-		static void addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Complex value);
+		static void addToMatrixElement(SparseMatrixRow& mat, const std::vector<UInt>& rows, const std::vector<UInt>& columns, Complex value);
 
 		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value);
-		static void addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Real value);
+		static void addToMatrixElement(SparseMatrixRow& mat, const std::vector<UInt>& rows, const std::vector<UInt>& columns, Real value);
+
+		/// Returns a reference to a matrix element, bypassing coeffRef if stamp slots are replayed
+		static Real& matrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column);
+
+		// #### Branch Stamps ####
+		//
+		// Stamps of a conductance (VarType Real, EMT) or an admittance (VarType
+		// Complex, DP and SP) between two terminals. The domain and the number
+		// of phases are template parameters and the harmonic and complex offsets
+		// are computed once per branch, so that a stamp reduces to straight-line
+		// code instead of recomputing the offsets for every element.
+
+		/// Adds a value at (row, column), placing the real and imaginary parts of complex values at complexOffset
+		template <typename VarType, typename Value>
+		static void stampMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Value value, Matrix::Index complexOffset) {
+			if constexpr (std::is_same<VarType, Real>::value) {
+				matrixElement(mat, row, column) += value;
+			} else {
+				const Complex complexValue(value);
+				matrixElement(mat, row, column) += complexValue.real();
+				matrixElement(mat, row + complexOffset, column + complexOffset) += complexValue.real();
+				matrixElement(mat, row, column + complexOffset) -= complexValue.imag();
+				matrixElement(mat, row + complexOffset, column) += complexValue.imag();
+			}
+		}
+
+		/// Adds a value between two single-phase terminals for one of maxFreq frequencies
+		template <typename VarType>
+		static void addBranchToMatrix(SparseMatrixRow& mat, Matrix::Index row0, Matrix::Index row1,
+			Bool connected0, Bool connected1, VarType value, Int maxFreq = 1, Int freqIdx = 0) {
+			// Assume square matrix
+			const Matrix::Index harmonicOffset = mat.rows() / maxFreq;
+			const Matrix::Index complexOffset = harmonicOffset / 2;
+			row0 += harmonicOffset * freqIdx;
+			row1 += harmonicOffset * freqIdx;
+
+			if (connected0)
+				stampMatrixElement<VarType>(mat, row0, row0, value, complexOffset);
+			if (connected1)
+				stampMatrixElement<VarType>(mat, row1, row1, value, complexOffset);
+			if (connected0 && connected1) {
+				stampMatrixElement<VarType>(mat, row0, row1, -value, complexOffset);
+				stampMatrixElement<VarType>(mat, row1, row0, -value, complexOffset);
+			}
+		}
+
+		/// Adds a NumPhases x NumPhases block between two terminals. The domain
+		/// follows from the scalar type of the block unless VarType is given,
+		/// e.g. to stamp a real block as the real part of a complex admittance.
+		template <typename VarType = void, std::size_t NumPhases, typename Derived>
+		static void addBranchToMatrix(SparseMatrixRow& mat, const std::array<UInt, NumPhases>& rows0, const std::array<UInt, NumPhases>& rows1,
+			Bool connected0, Bool connected1, const Eigen::MatrixBase<Derived>& value) {
+			using StampType = std::conditional_t<std::is_void<VarType>::value, typename Derived::Scalar, VarType>;
+			const Matrix::Index complexOffset = mat.rows() / 2;
+
+			if (connected0) {
+				for (std::size_t i = 0; i < NumPhases; i++)
+					for (std::size_t j = 0; j < NumPhases; j++)
+						stampMatrixElement<StampType>(mat, rows0[i], rows0[j], value(i, j), complexOffset);
+			}
+			if (connected1) {
+				for (std::size_t i = 0; i < NumPhases; i++)
+					for (std::size_t j = 0; j < NumPhases; j++)
+						stampMatrixElement<StampType>(mat, rows1[i], rows1[j], value(i, j), complexOffset);
+			}
+			if (!(connected0 && connected1))
+				return;
+			for (std::size_t i = 0; i < NumPhases; i++)
+				for (std::size_t j = 0; j < NumPhases; j++)
+					stampMatrixElement<StampType>(mat, rows0[i], rows1[j], -value(i, j), complexOffset);
+			for (std::size_t i = 0; i < NumPhases; i++)
+				for (std::size_t j = 0; j < NumPhases; j++)
+					stampMatrixElement<StampType>(mat, rows1[i], rows0[j], -value(i, j), complexOffset);
+		}
 
 		static void invertMatrix(const Matrix& mat, Matrix& matInv);
 
@@ -81,12 +233,18 @@ namespace CPS {
 		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix input, Real dt);
 		static Real StateSpaceTrapezoidal(Real states, Real A, Real B, Real C, Real dt, Real u);
 		static Real StateSpaceTrapezoidal(Real states, Real A, Real B, Real dt, Real u);
+		/// Discretizes a state space model with constant A for the trapezoidal rule, so that
+		/// states_new = stateMatrix * states + inputMatrix * B * (u_new + u_old)
+		static void StateSpaceTrapezoidalMatrices(const Matrix& A, Real dt, Matrix& stateMatrix, Matrix& inputMatrix);
 
 		static Matrix StateSpaceEuler(Matrix states, Matrix A, Matrix B, Real dt, Matrix u);
 		static Matrix StateSpaceEuler(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u);
 		static Matrix StateSpaceEuler(Matrix states, Matrix A, Matrix input, Real dt);
 		static Real StateSpaceEuler(Real states, Real A, Real B, Real dt, Real u);
 		static Real StateSpaceEuler(Real states, Real A, Real B, Real C, Real dt, Real u);
+		/// Backward Euler step of a first order model with the input at the end of the step,
+		/// stable for any time step if A is negative
+		static Real StateSpaceImplicitEuler(Real states, Real A, Real B, Real dt, Real u);
 
 		static void FFT(std::vector<Complex>& samples);
 
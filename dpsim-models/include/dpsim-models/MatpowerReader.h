@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <dpsim-models/Filesystem.h>
+#include <dpsim-models/Logger.h>
+#include <dpsim-models/SystemTopology.h>
+
+namespace CPS {
+	/// \brief Creates static phasor power flow systems from MATPOWER cases
+	///
+	/// Reads case files in the MATPOWER text format, e.g. case9.m, and maps
+	/// the buses, generators and branches to SP::Ph1 components like the
+	/// Python reader of .mat files: PQ buses get a Load, PV buses a
+	/// SynchronGenerator and the reference bus a NetworkInjection, branches
+	/// without tap ratio become PiLines and the others Transformers. The
+	/// data can also be passed as matrices, e.g. from NumPy arrays, so large
+	/// cases are created in one call.
+	class MatpowerReader {
+	public:
+		/// Data of a case in MATPOWER units, one row per element
+		struct Case {
+			Real baseMVA = 100;
+			Matrix bus;
+			Matrix gen;
+			Matrix branch;
+		};
+
+		MatpowerReader(String name = "MatpowerReader", Logger::Level logLevel = Logger::Level::info,
+			Logger::Level componentLogLevel = Logger::Level::off);
+
+		/// System frequency, which is not part of the case, used for the line inductances and capacitances
+		void setFrequency(Real frequency) { mFrequency = frequency; }
+
+		/// Parses the baseMVA, bus, gen and branch fields of a case file
+		Case readCase(const fs::path& file);
+		/// Creates the nodes and components of the case
+		SystemTopology createSystem(const Case& data);
+		///
+		SystemTopology loadCase(const fs::path& file) { return createSystem(readCase(file)); }
+
+	private:
+		Logger::Log mSLog;
+		Real mFrequency = 50;
+		/// Log level of the created components, off by default as large cases have many of them
+		Logger::Level mComponentLogLevel;
+	};
+}
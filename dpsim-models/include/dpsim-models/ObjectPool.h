@@ -0,0 +1,97 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace CPS {
+	/// Monotonic memory pool for the objects created while setting up a simulation
+	///
+	/// While a Scope is active, `SharedFactory::make` places the objects in
+	/// the pool instead of allocating each one from the heap. Objects of one
+	/// type are placed next to each other in chunks of their own. Memory is
+	/// not reused when an object is destroyed, it is released with the pool.
+	/// The objects keep the pool alive through their control blocks, so the
+	/// pool may be dropped by its owner before the objects.
+	class ObjectPool {
+	public:
+		using Ptr = std::shared_ptr<ObjectPool>;
+
+		/// Makes the pool the target of `SharedFactory::make` in the current
+		/// thread until the scope ends. Scopes can be nested.
+		class Scope {
+		public:
+			explicit Scope(Ptr pool);
+			~Scope();
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+		private:
+			Ptr mPrevious;
+		};
+
+		/// Allocator for the shared pointer control blocks
+		template <typename U>
+		class Allocator {
+		public:
+			using value_type = U;
+
+			explicit Allocator(Ptr pool) : mPool(std::move(pool)) { }
+			template <typename V>
+			Allocator(const Allocator<V>& other) : mPool(other.pool()) { }
+
+			U* allocate(std::size_t n) {
+				return static_cast<U*>(mPool->allocate(n * sizeof(U), alignof(U), typeid(Allocator<void>)));
+			}
+			void deallocate(U*, std::size_t) { }
+
+			const Ptr& pool() const { return mPool; }
+			template <typename V>
+			bool operator==(const Allocator<V>& other) const { return mPool == other.pool(); }
+			template <typename V>
+			bool operator!=(const Allocator<V>& other) const { return mPool != other.pool(); }
+		private:
+			Ptr mPool;
+		};
+
+		/// Destroys an object without releasing its memory
+		template <typename T>
+		struct Deleter {
+			void operator()(T* object) const { object->~T(); }
+		};
+
+		/// @param chunkSize Minimum size in bytes of the chunks requested from the heap
+		explicit ObjectPool(std::size_t chunkSize = 64 * 1024) : mChunkSize(chunkSize) { }
+
+		/// Pool of the innermost active scope in the current thread, or nullptr
+		static Ptr current();
+
+		/// Returns memory for an object of the given type, which stays valid until the pool is destroyed
+		void* allocate(std::size_t bytes, std::size_t alignment, std::type_index type);
+		/// Number of bytes requested from the heap
+		std::size_t reservedBytes() const;
+
+	private:
+		/// Chunks of the objects of one type and the free space in the last one
+		struct Arena {
+			std::vector<std::unique_ptr<std::byte[]>> chunks;
+			std::byte* next = nullptr;
+			std::size_t remaining = 0;
+		};
+
+		std::size_t mChunkSize;
+		std::size_t mReservedBytes = 0;
+		std::unordered_map<std::type_index, Arena> mArenas;
+		mutable std::mutex mMutex;
+	};
+}
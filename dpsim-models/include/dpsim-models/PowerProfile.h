@@ -7,6 +7,9 @@
  *********************************************************************************/
 
 #pragma once
+
+#include <vector>
+
 #include <dpsim-models/Definitions.h>
 
 namespace CPS {
@@ -15,8 +18,37 @@ namespace CPS {
 		Real q;
 	};
 
+	/// \brief Load profile samples stored as sorted arrays
+	///
+	/// Either pqData or weightingFactors holds one value per time stamp.
+	/// Values between the time stamps are interpolated linearly, values
+	/// outside of the profile are held.
 	struct PowerProfile {
-		std::map<Real, PQData> pqData;
-		std::map<Real, Real> weightingFactors;
+		/// Position of a consumer in the time stamps
+		///
+		/// Advanced as the requested time increases, so that lookups for
+		/// increasing times are constant in amortized time.
+		struct Cursor {
+			std::size_t index = 0;
+		};
+
+		/// Sorted time stamps of the samples
+		std::vector<Real> times;
+		/// Active and reactive power at the time stamps
+		std::vector<PQData> pqData;
+		/// Weighting factors at the time stamps
+		std::vector<Real> weightingFactors;
+
+		/// Returns true if the profile has no samples
+		Bool empty() const { return times.empty(); }
+		/// Sorts the samples by time if they were not appended in order,
+		/// keeping the first sample of repeated time stamps
+		void sort();
+		/// Moves the cursor to the last sample at or before the given time
+		std::size_t seek(Real time, Cursor& cursor) const;
+		/// Interpolated active and reactive power
+		PQData pq(Real time, Cursor& cursor) const;
+		/// Interpolated weighting factor
+		Real weightingFactor(Real time, Cursor& cursor) const;
 	};
 }
@@ -10,6 +10,9 @@
 
 #include <memory>
 #include <utility>
+#include <typeinfo>
+
+#include <dpsim-models/ObjectPool.h>
 
 /// Curiously recurring template pattern (CRTP) to create create new shared_ptr instances.
 /// See: https://en.wikipedia.org/wiki/Curiously_recurring_template_pattern
@@ -17,9 +20,16 @@ template<typename T>
 class SharedFactory {
 
 public:
+	/// Places the object in the object pool of the current scope, if there is one
 	template<typename... Args>
 	static std::shared_ptr<T> make(Args&&... args) {
-		return std::shared_ptr<T>(new T(std::forward<Args>(args)...));
+		auto pool = CPS::ObjectPool::current();
+		if (!pool)
+			return std::shared_ptr<T>(new T(std::forward<Args>(args)...));
+
+		void* memory = pool->allocate(sizeof(T), alignof(T), typeid(T));
+		T* object = new (memory) T(std::forward<Args>(args)...);
+		return std::shared_ptr<T>(object, CPS::ObjectPool::Deleter<T>(), CPS::ObjectPool::Allocator<T>(pool));
 	}
 };
 
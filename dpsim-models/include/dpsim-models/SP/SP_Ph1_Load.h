@@ -17,6 +17,7 @@
 #include <dpsim-models/SP/SP_Ph1_Inductor.h>
 #include <dpsim-models/SP/SP_Ph1_Resistor.h>
 #include <dpsim-models/PowerProfile.h>
+#include <dpsim-models/LoadProfileStream.h>
 
 namespace CPS {
 namespace SP {
@@ -75,6 +76,10 @@ namespace Ph1 {
 		void initializeFromNodesAndTerminals(Real frequency) override;
 		/// Load profile data
 		PowerProfile mLoadProfile;
+		/// Position in mLoadProfile of the last update
+		PowerProfile::Cursor mLoadProfileCursor;
+		/// Load profile read while the simulation advances, replaces mLoadProfile if set
+		LoadProfileStream::Ptr mLoadProfileStream;
 		/// Use the assigned load profile
 		bool use_profile = false;
 		/// Update PQ for this load for power flow calculation at next time step
@@ -92,10 +97,10 @@ namespace Ph1 {
 		/// Updates internal voltage variable of the component
 		void mnaCompUpdateVoltage(const Matrix& leftVector) override;
 
-		/// MNA post step operations
-		void mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
+		/// MNA output step operations
+		void mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
 
-		void mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+		void mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
 	};
 }
 }
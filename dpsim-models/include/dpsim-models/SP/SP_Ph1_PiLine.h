@@ -71,6 +71,8 @@ namespace Ph1 {
 
 		// #### Admittance matrix stamp ####
 		MatrixComp mY_element;
+		/// Out of service lines stamp zero admittances into the power flow
+		Bool mInService = true;
 		/// Series Inductance submodel
 		std::shared_ptr<Inductor> mSubSeriesInductor;
 		/// Series Resistor submodel
@@ -85,6 +87,9 @@ namespace Ph1 {
 		std::shared_ptr<Capacitor> mSubParallelCapacitor1;
 		/// Right side vectors of subcomponents
 		std::vector<const Matrix*> mRightVectorStamps;
+
+		/// Calculates mY_element from the per unit parameters
+		void calculateAdmittanceElement();
 	public:
 		/// nodal active power injection
 		const Attribute<Real>::Ptr mActivePowerInjection;
@@ -111,6 +116,10 @@ namespace Ph1 {
 		void calculatePerUnitParameters(Real baseApparentPower, Real baseOmega);
 		/// Stamps admittance matrix
 		void pfApplyAdmittanceMatrixStamp(SparseMatrixCompRow & Y) override;
+		/// Stamps the change of the admittance matrix since the last stamp
+		Bool pfApplyAdmittanceMatrixUpdate(SparseMatrixCompRow & Y) override;
+		/// Switch the line in or out of service, applied to the power flow with the next admittance matrix update
+		void setInService(Bool inService);
 		/// updates branch current and power flow, input pu value, update with real value
 		void updateBranchFlow(VectorComp& current, VectorComp& powerflow);
 		/// stores nodal injection power in this line object
@@ -119,16 +128,18 @@ namespace Ph1 {
 		// #### Getter ####
 		/// get admittance matrix
 		MatrixComp Y_element();
+		///
+		Bool isInService() const { return mInService; }
 
 		// #### MNA section ####
 		/// Updates internal current variable of the component
 		void mnaCompUpdateCurrent(const Matrix& leftVector) override;
 		/// Updates internal voltage variable of the component
 		void mnaCompUpdateVoltage(const Matrix& leftVector) override;
-		/// MNA post-step operations
-		void mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
-		/// add MNA post-step dependencies
-		void mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
+		/// MNA output step operations
+		void mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) override;
+		/// add MNA output step dependencies
+		void mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) override;
 
 		MNAInterface::List mnaTearGroundComponents() override;
 		void mnaTearInitialize(Real omega, Real timeStep) override;
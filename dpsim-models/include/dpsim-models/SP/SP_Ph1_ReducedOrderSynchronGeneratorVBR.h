@@ -10,6 +10,7 @@
 
 #include <dpsim-models/Base/Base_ReducedOrderSynchronGenerator.h>
 #include <dpsim-models/Solver/MNAVariableCompInterface.h>
+#include <dpsim-models/Solver/MNAIterativeCompInterface.h>
 
 namespace CPS {
 namespace SP {
@@ -17,7 +18,8 @@ namespace Ph1 {
 	/// @brief Base class for SP VBR synchronous generator model single phase
 	class ReducedOrderSynchronGeneratorVBR :
 		public Base::ReducedOrderSynchronGenerator<Complex>,
-		public MNAVariableCompInterface {
+		public MNAVariableCompInterface,
+		public MNAIterativeCompInterface {
 	public:
         // Common elements of all VBR models
 		/// voltage behind reactance phase a
@@ -32,6 +34,9 @@ namespace Ph1 {
 		/// Conductance matrix phase A
 		Matrix mConductanceMatrix;
 
+		/// Conductance matrix phase A without the rotor angle dependent part
+		Matrix mConstantConductanceMatrix;
+
     protected:
         /// Park Transformation
 		///
@@ -54,6 +59,9 @@ namespace Ph1 {
         void calculateResistanceMatrix();
         ///
         Matrix get_DqToComplexATransformMatrix() const;
+		/// Norton current corrected by the deviation of the conductance matrix
+		/// from the constant conductance matrix at the given terminal voltage
+		Complex correctedNortonCurrent(Complex voltage) const;
 
         // ### MNA Section ###
         ///
@@ -64,7 +72,11 @@ namespace Ph1 {
 
     public:
         /// Mark that parameter changes so that system matrix is updated
-		Bool hasParameterChanged() override { return true;};
+		Bool hasParameterChanged() override { return !hasConstantConductance(); };
+		///
+		Bool mnaIsIterative() const override { return hasConstantConductance(); };
+		///
+		Bool mnaCorrectorStep(const Matrix& leftVector) override;
     };
 }
 }
@@ -94,6 +94,9 @@ namespace Ph1 {
 
 		/// Boolean for considering resistive losses with sub resistor
 		Bool mWithResistiveLosses;
+
+		/// Calculates mY_element from the per unit parameters
+		void calculateAdmittanceElement();
 	public:
 		/// base voltage [V]
 		const Attribute<Real>::Ptr mBaseVoltage;
@@ -136,6 +139,11 @@ namespace Ph1 {
 		void calculatePerUnitParameters(Real baseApparentPower, Real baseOmega);
 		/// Stamps admittance matrix
 		void pfApplyAdmittanceMatrixStamp(SparseMatrixCompRow & Y) override;
+		/// Stamps the change of the admittance matrix since the last stamp
+		Bool pfApplyAdmittanceMatrixUpdate(SparseMatrixCompRow & Y) override;
+		/// Change the absolute tap ratio, in the terminal orientation after initialization.
+		/// Applied to the power flow with the next admittance matrix update.
+		void setTapRatio(Real ratioAbs);
 		/// updates branch current and power flow, input pu value, update with real value
 		void updateBranchFlow(VectorComp& current, VectorComp& powerflow);
 		/// stores nodal injection power in this line object
@@ -41,6 +41,15 @@ namespace Ph1 {
 		// we need to save the initialisation values to use them as target values in the transition
 		Real mInitClosedRes;
 		Real mInitOpenRes;
+		/// Conductance in the system matrix, which only follows significant resistance changes
+		Real mStampedConductance = 0;
+		/// True if the stamped conductance changed since the last system matrix stamp
+		Bool mStampOutdated = false;
+		/// Current compensating the deviation of the resistance from the stamped conductance
+		Complex mCompensationCurrent = 0;
+
+		/// Moves the resistance towards the target value of the switch state
+		void updateResistance();
 
 
 
@@ -76,11 +85,11 @@ namespace Ph1 {
 		/// Update interface current from MNA system results
 		void mnaCompUpdateCurrent(const Matrix& leftVector);
 		/// MNA pre step operations
-		// void mnaCompPreStep(Real time, Int timeStepCount);
+		void mnaCompPreStep(Real time, Int timeStepCount) override;
 		/// MNA post step operations
 		void mnaCompPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
 		/// add MNA pre step dependencies
-		/// void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes);
+		void mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) override;
 		/// add MNA post step dependencies
 		void mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector);
 
@@ -90,6 +99,7 @@ namespace Ph1 {
 		/// Stamps system matrix considering the defined switch position
 		void mnaCompApplySwitchSystemMatrixStamp(Bool closed, SparseMatrixRow& systemMatrix, Int freqIdx);
 
+		/// Returns true if the resistance deviates significantly from the stamped conductance
 		Bool hasParameterChanged();
 	};
 }
@@ -32,14 +32,18 @@ namespace Signal {
 		std::shared_ptr<EMT::Ph1::CurrentSource> mSrc1, mSrc2;
 		Attribute<Complex>::Ptr mSrcCur1, mSrcCur2;
 
-		// Ringbuffers for the values of previous timesteps
-		// TODO make these matrix attributes
-		std::vector<Real> mVolt1, mVolt2, mCur1, mCur2;
+		/// Ring buffer of the values of previous time steps with one column
+		/// per time step, which holds v1, v2, i1 and i2 next to each other
+		Eigen::Matrix<Real, 4, Eigen::Dynamic> mHistory;
 		UInt mBufIdx = 0;
 		UInt mBufSize;
+		/// Weight of the oldest value in the interpolation of the delayed values
 		Real mAlpha;
+		/// Coefficients of the source currents, cached over the time steps
+		Real mCoupledFactor, mSelfFactor, mHistoryImpedance, mInitConductance;
 
-		Real interpolate(std::vector<Real>& data);
+		/// Linear interpolation of the delayed values in the order of the history
+		Eigen::Matrix<Real, 4, 1> interpolate() const;
 	public:
 		typedef std::shared_ptr<DecouplingLineEMT> Ptr;
 
@@ -0,0 +1,117 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim-models/DP/DP_Ph1_CurrentSource.h>
+#include <dpsim-models/DP/DP_Ph1_Resistor.h>
+#include <dpsim-models/SimPowerComp.h>
+#include <dpsim-models/SimSignalComp.h>
+#include <dpsim-models/Task.h>
+
+namespace CPS {
+namespace Signal {
+	/// \brief Exchanges the boundary values of the two ends of a split decoupling line
+	class DecouplingLineChannel {
+	public:
+		typedef std::shared_ptr<DecouplingLineChannel> Ptr;
+
+		virtual ~DecouplingLineChannel() = default;
+
+		/// Sends the initial voltage of the local end and returns the one of the remote end
+		virtual Complex exchangeInitialVoltage(Complex voltage) = 0;
+		/// Sends voltage and current of the local end after the given step
+		virtual void send(Int timeStepCount, Complex voltage, Complex current) = 0;
+		/// Waits for voltage and current of the remote end after the given step.
+		/// The requested steps never decrease.
+		virtual void receive(Int timeStepCount, Complex& voltage, Complex& current) = 0;
+	};
+
+	/// \brief One end of a DecouplingLine whose other end is simulated in another process
+	///
+	/// Both processes create the line with the same parameters, each connected
+	/// to its own node. The source current of step k only depends on values of
+	/// the remote end which are older than the line delay, so a process has to
+	/// wait for its peer only if it is ahead by the full delay.
+	class DecouplingLineRemote :
+		public SimSignalComp,
+		public SharedFactory<DecouplingLineRemote> {
+	protected:
+		Real mDelay;
+		Real mResistance;
+		Real mInductance, mCapacitance;
+		Real mSurgeImpedance;
+
+		std::shared_ptr<DP::SimNode> mNode;
+		std::shared_ptr<DP::Ph1::Resistor> mRes;
+		std::shared_ptr<DP::Ph1::CurrentSource> mSrc;
+		Attribute<Complex>::Ptr mSrcCur;
+		DecouplingLineChannel::Ptr mChannel;
+
+		UInt mBufSize;
+		Real mAlpha;
+		// Values of the remote end before the first step
+		Complex mRemoteVolt, mRemoteCur;
+
+		/// Linear interpolation of the delayed local voltage and current, the
+		/// ring buffer slot of step k is k modulo the buffer size
+		void interpolate(Int timeStepCount, Complex& voltage, Complex& current) const;
+		void remoteValues(Int timeStepCount, Complex& voltage, Complex& current);
+	public:
+		typedef std::shared_ptr<DecouplingLineRemote> Ptr;
+
+		const Attribute<Complex>::Ptr mSrcCurRef;
+
+		/// Ring buffer of the local values of previous time steps with one
+		/// column per time step, which holds the real and imaginary parts of
+		/// voltage and current. As an attribute, it is part of checkpoints.
+		const Attribute<Matrix>::Ptr mStates;
+
+		DecouplingLineRemote(String name, Logger::Level logLevel = Logger::Level::info);
+
+		void setParameters(SimNode<Complex>::Ptr node, Real resistance, Real inductance, Real capacitance,
+			DecouplingLineChannel::Ptr channel);
+		void initialize(Real omega, Real timeStep);
+		void step(Real time, Int timeStepCount);
+		void postStep(Int timeStepCount);
+		Task::List getTasks();
+		IdentifiedObject::List getLineComponents();
+
+		class PreStep : public Task {
+		public:
+			PreStep(DecouplingLineRemote& line) :
+				Task(**line.mName + ".MnaPreStep"), mLine(line) {
+				mPrevStepDependencies.push_back(mLine.mStates);
+				mModifiedAttributes.push_back(mLine.mSrc->mCurrentRef);
+			}
+
+			void execute(Real time, Int timeStepCount);
+
+		private:
+			DecouplingLineRemote& mLine;
+		};
+
+		class PostStep : public Task {
+		public:
+			PostStep(DecouplingLineRemote& line) :
+				Task(**line.mName + ".PostStep"), mLine(line) {
+				mAttributeDependencies.push_back(mLine.mRes->mIntfVoltage);
+				mAttributeDependencies.push_back(mLine.mRes->mIntfCurrent);
+				mModifiedAttributes.push_back(mLine.mStates);
+			}
+
+			void execute(Real time, Int timeStepCount);
+
+		private:
+			DecouplingLineRemote& mLine;
+		};
+	};
+}
+}
@@ -10,6 +10,7 @@
 
 #include <dpsim-models/SimSignalComp.h>
 #include <dpsim-models/Logger.h>
+#include <dpsim-models/MathUtils.h>
 
 namespace CPS {
 namespace Signal {
@@ -52,6 +53,13 @@ namespace Signal {
 		Real mMaxVr;
 		/// Minumum regulator voltage (p.u.)
 		Real mMinVr;
+		/// Optional table of the ceiling function
+		LookupTable::Ptr mCeilingTable;
+		/// Integrate with backward instead of forward Euler
+		Bool mImplicitIntegration = false;
+
+		/// Ceiling function of the exciter output
+		Real ceilingFunction(Real Ef) const;
 
 	protected:
 		/// Output of voltage transducer at time k-1
@@ -75,6 +83,12 @@ namespace Signal {
 
 		/// Initializes exciter parameters
 		void setParameters(Real Ta, Real Ka, Real Te, Real Ke, Real Tf, Real Kf, Real Tr, Real maxVr=1.0, Real minVr = -0.9);
+		/// Evaluates the ceiling function with a table shared by all exciters
+		/// for exciter outputs up to the given absolute value
+		void setCeilingFunctionTable(Real tolerance, Real maxEf = 10.);
+		/// Integrate with backward Euler, which allows time steps above the
+		/// time constants, e.g. for long-term simulations
+		void doImplicitIntegration(Bool value) { mImplicitIntegration = value; }
 		/// Initializes exciter variables
 		void initialize(Real Vh_init, Real Vf_init);
 		/// Performs an step to update field voltage value
@@ -16,19 +16,31 @@
 
 namespace CPS {
 namespace Signal {
+	/// FIR filter with the taps applied to a circular buffer of the last inputs.
+	/// The buffer is stored twice in a row, so that the window of the last inputs
+	/// is contiguous at every position and the output is a vectorized dot product.
 	class FIRFilter :
 		public SimSignalComp,
 		public SharedFactory<FIRFilter> {
 	protected:
-		std::vector<Real> mSignal;
+		/// Mirrored circular buffers of length 2 * filter length, one column per filter.
+		/// The column is shared with other filters when the steps are batched.
+		std::shared_ptr<Matrix> mSignal;
+		Int mSignalColumn = 0;
 		std::vector<Real> mFilter;
 
 		Attribute<Real>::Ptr mInput;
 		Int mCurrentIdx;
 		Int mFilterLength;
+		/// Output is only calculated every mDecimation-th step
+		Int mDecimation = 1;
+		Int mStepCount = 0;
 
 		void incrementIndex();
-		Int getIndex(Int index);
+		/// Writes the input at the current index and its mirror
+		void storeInput(Real input);
+		/// Applies the taps to the contiguous window at the current index
+		Real filterWindow() const;
 	public:
 		const Attribute<Real>::Ptr mOutput;
 		/// This is never explicitely set to reference anything, so the outside code is responsible for setting up the reference.
@@ -40,6 +52,9 @@ namespace Signal {
 		void initialize(Real timeStep);
 		void step(Real time);
 		void setInput(Attribute<Real>::Ptr input);
+		/// Only calculate the output every factor-th step and keep it in between,
+		/// the inputs are still stored every step
+		void setDecimation(UInt factor);
 		Task::List getTasks();
 
 		class Step : public Task {
@@ -51,10 +66,29 @@ namespace Signal {
 			}
 
 			void execute(Real time, Int timeStepCount);
+			/// Steps of filters with the same coefficients and decimation can be batched
+			String batchKey() const override;
+			Task::Ptr createBatch(const Task::List& tasks) const override;
 
 		private:
 			FIRFilter& mFilter;
 		};
+
+		/// Steps of several filters with the same coefficients, whose buffers are
+		/// moved into the columns of one matrix. The outputs of all filters are then
+		/// calculated by one matrix vector product of the windows and the taps.
+		class StepBatch : public Task {
+		public:
+			StepBatch(const std::vector<FIRFilter*>& filters);
+
+			void execute(Real time, Int timeStepCount);
+
+		private:
+			std::vector<FIRFilter*> mFilters;
+			std::shared_ptr<Matrix> mSignal;
+			Matrix mTaps;
+			Matrix mOutputs;
+		};
 	};
 }
 }
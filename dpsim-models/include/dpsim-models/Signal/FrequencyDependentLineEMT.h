@@ -0,0 +1,125 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim-models/EMT/EMT_Ph1_CurrentSource.h>
+#include <dpsim-models/EMT/EMT_Ph1_Resistor.h>
+#include <dpsim-models/SimSignalComp.h>
+#include <dpsim-models/Task.h>
+
+namespace CPS {
+namespace Signal {
+	/// \brief Frequency dependent single phase transmission line for EMT
+	///
+	/// The characteristic admittance Yc and the propagation function H without its
+	/// travelling time are given as rational approximations with real poles, e.g. from
+	/// vector fitting:
+	///   Yc(s) = d + sum_i r_i / (s - p_i),   H(s) = exp(-s * delay) * sum_i r_i / (s - p_i)
+	/// The terminal currents follow i_k = Yc * v_k - H * (Yc * v_m + i_m). Both
+	/// convolutions are evaluated by recursive convolution, so the cost of a time step
+	/// is linear in the number of poles. Like DecouplingLineEMT, each terminal is
+	/// represented by a conductance and a current source to ground, which decouples
+	/// the networks at both ends of the line.
+	class FrequencyDependentLineEMT :
+		public SimSignalComp,
+		public SharedFactory<FrequencyDependentLineEMT> {
+	protected:
+		Real mDelay;
+		/// Constant term of the characteristic admittance
+		Real mYcConst;
+		/// Poles and residues of the characteristic admittance
+		Matrix mYcPoles, mYcResidues;
+		/// Poles and residues of the propagation function
+		Matrix mHPoles, mHResidues;
+
+		std::shared_ptr<EMT::SimNode> mNode1, mNode2;
+		std::shared_ptr<EMT::Ph1::Resistor> mRes1, mRes2;
+		std::shared_ptr<EMT::Ph1::CurrentSource> mSrc1, mSrc2;
+
+		/// Recursive convolution coefficients of the previous state, the new
+		/// input and the previous input with one row per pole
+		Matrix mYcCoeffs, mHCoeffs;
+		/// Conductance of the terminal equivalents
+		Real mConductance;
+		/// Convolution states with one row per pole and one column per terminal
+		Matrix mYcStates, mHStates;
+		/// Terminal voltages of the previous time step
+		Eigen::Matrix<Real, 2, 1> mPrevVoltage;
+		/// Delayed waves of the previous time step
+		Eigen::Matrix<Real, 2, 1> mPrevDelayed;
+
+		/// Ring buffer of the waves Yc * v + i of both terminals with one column per time step
+		Eigen::Matrix<Real, 2, Eigen::Dynamic> mHistory;
+		UInt mBufIdx = 0;
+		UInt mBufSize;
+		/// Weight of the oldest value in the interpolation of the delayed values
+		Real mAlpha;
+
+		/// Coefficients of the recursive convolution of r / (s - p) with linear interpolation of the input
+		static Matrix recursiveConvolutionCoeffs(const Matrix& poles, const Matrix& residues, Real timeStep);
+		/// Linear interpolation of the delayed waves
+		Eigen::Matrix<Real, 2, 1> interpolate() const;
+	public:
+		typedef std::shared_ptr<FrequencyDependentLineEMT> Ptr;
+
+		const Attribute<Real>::Ptr mSrcCur1Ref;
+		const Attribute<Real>::Ptr mSrcCur2Ref;
+
+		/// Stands for the convolution states and the wave history, which the
+		/// post-step updates and the pre-step of the next step reads. It carries
+		/// no value and only orders the two tasks across time steps.
+		const Attribute<Matrix>::Ptr mStates;
+
+		FrequencyDependentLineEMT(String name, Logger::Level logLevel = Logger::Level::info);
+
+		/// Sets the fitted characteristic admittance and propagation function.
+		/// Poles and residues are column vectors and all poles have to be negative.
+		void setParameters(SimNode<Real>::Ptr node1, SimNode<Real>::Ptr node2, Real delay,
+			Real ycConst, const Matrix& ycPoles, const Matrix& ycResidues,
+			const Matrix& hPoles, const Matrix& hResidues);
+		void initialize(Real omega, Real timeStep);
+		void step(Real time, Int timeStepCount);
+		void postStep();
+		Task::List getTasks();
+		IdentifiedObject::List getLineComponents();
+
+		class PreStep : public Task {
+		public:
+			PreStep(FrequencyDependentLineEMT& line) :
+				Task(**line.mName + ".MnaPreStep"), mLine(line) {
+				mPrevStepDependencies.push_back(mLine.mStates);
+				mModifiedAttributes.push_back(mLine.mSrc1->mCurrentRef);
+				mModifiedAttributes.push_back(mLine.mSrc2->mCurrentRef);
+			}
+
+			void execute(Real time, Int timeStepCount);
+
+		private:
+			FrequencyDependentLineEMT& mLine;
+		};
+
+		class PostStep : public Task {
+		public:
+			PostStep(FrequencyDependentLineEMT& line) :
+				Task(**line.mName + ".PostStep"), mLine(line) {
+				mAttributeDependencies.push_back(mLine.mRes1->mIntfVoltage);
+				mAttributeDependencies.push_back(mLine.mRes1->mIntfCurrent);
+				mAttributeDependencies.push_back(mLine.mRes2->mIntfVoltage);
+				mAttributeDependencies.push_back(mLine.mRes2->mIntfCurrent);
+				mModifiedAttributes.push_back(mLine.mStates);
+			}
+
+			void execute(Real time, Int timeStepCount);
+
+		private:
+			FrequencyDependentLineEMT& mLine;
+		};
+	};
+}
+}
@@ -0,0 +1,81 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim-models/DP/DP_Ph1_CurrentSource.h>
+#include <dpsim-models/EMT/EMT_Ph3_VoltageSource.h>
+#include <dpsim-models/SimSignalComp.h>
+#include <dpsim-models/Task.h>
+
+namespace CPS {
+namespace Signal {
+	/// \brief Couples a three-phase EMT subnet with a single-phase SP or DP subnet
+	///
+	/// Ideal transformer model of the boundary: the EMT node is driven by a
+	/// voltage source that follows the phasor of the SP/DP node, and the
+	/// SP/DP node is fed by a current source with the phasor of the current
+	/// drawn by the EMT source. The phasor of the EMT current is the positive
+	/// sequence space vector turned back by the angle of the system frequency,
+	/// averaged over a number of EMT steps, e.g. one step of a slower SP/DP
+	/// subnet. Each side uses the values of the previous step of the other.
+	class HybridInterface :
+		public SimSignalComp,
+		public SharedFactory<HybridInterface> {
+	protected:
+		SimNode<Complex>::Ptr mPhasorNode;
+		SimNode<Real>::Ptr mEmtNode;
+		std::shared_ptr<EMT::Ph3::VoltageSource> mEmtSrc;
+		std::shared_ptr<DP::Ph1::CurrentSource> mPhasorSrc;
+
+		Real mOmega = 0;
+		Real mTimeStep = 0;
+		/// Phasors of the EMT current in the last steps, used as ring buffer
+		std::vector<Complex> mCurrentHistory;
+		UInt mBufIdx = 0;
+		UInt mAveragingSteps = 1;
+	public:
+		typedef std::shared_ptr<HybridInterface> Ptr;
+
+		/// Averaged phasor of the EMT current, which is injected into the SP/DP node
+		const Attribute<Complex>::Ptr mCurrentPhasor;
+
+		HybridInterface(String name, Logger::Level logLevel = Logger::Level::info);
+
+		/// The EMT current is averaged over the given number of steps. The
+		/// initial current is the phasor injected into the SP/DP node until
+		/// the EMT subnet has been solved.
+		void setParameters(SimNode<Complex>::Ptr phasorNode, SimNode<Real>::Ptr emtNode,
+			UInt averagingSteps = 1, Complex initialCurrent = 0);
+		void initialize(Real omega, Real timeStep);
+		void step(Real time, Int timeStepCount);
+		Task::List getTasks();
+		/// Sources at the EMT and SP/DP node, which must be added to the topology
+		IdentifiedObject::List getInterfaceComponents();
+
+		class PreStep : public Task {
+		public:
+			PreStep(HybridInterface& intf) :
+				Task(**intf.mName + ".PreStep"), mIntf(intf) {
+				mPrevStepDependencies.push_back(mIntf.mPhasorNode->mVoltage);
+				mPrevStepDependencies.push_back(mIntf.mEmtSrc->mIntfCurrent);
+				mModifiedAttributes.push_back(mIntf.mEmtSrc->mVoltageRef);
+				mModifiedAttributes.push_back(mIntf.mPhasorSrc->mCurrentRef);
+				mModifiedAttributes.push_back(mIntf.mCurrentPhasor);
+			}
+
+			void execute(Real time, Int timeStepCount);
+
+		private:
+			HybridInterface& mIntf;
+		};
+	};
+}
+}
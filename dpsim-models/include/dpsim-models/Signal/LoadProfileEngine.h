@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim-models/SimSignalComp.h>
+#include <dpsim-models/Task.h>
+#include <dpsim-models/PowerProfile.h>
+
+namespace CPS {
+namespace Signal {
+	/// Applies the load profiles of many loads in a single task.
+	///
+	/// The profiles share one time axis and are stored as one matrix per
+	/// power with a row per time stamp and a column per load, so that every
+	/// step only seeks the time once and interpolates all loads in one pass
+	/// over two contiguous rows. Only the power attributes whose value changed
+	/// are written, e.g. none while all profiles hold their value between
+	/// samples. Values between the time stamps are interpolated linearly,
+	/// values outside of the time axis are held.
+	class LoadProfileEngine :
+		public SimSignalComp,
+		public SharedFactory<LoadProfileEngine> {
+	public:
+		/// Number of loads whose power changed in the last step
+		const Attribute<Int>::Ptr mChangedLoadCount;
+
+		LoadProfileEngine(String uid, String name, Logger::Level logLevel = Logger::Level::off);
+		LoadProfileEngine(String name, Logger::Level logLevel = Logger::Level::off) :
+			LoadProfileEngine(name, name, logLevel) { }
+
+		/// Sets the sorted time stamps shared by all profiles. Without it, the
+		/// time stamps of the first profile added are used.
+		void setTimes(const std::vector<Real>& times);
+		/// Adds a load whose power attributes, e.g. "P" and "Q", follow the
+		/// profile. It is resampled to the time axis of the engine. Weighting
+		/// factors are scaled by the nominal powers.
+		void addLoad(AttributeBase::Ptr activePower, AttributeBase::Ptr reactivePower,
+			const PowerProfile& profile, Real activePowerNom = 1, Real reactivePowerNom = 1);
+		/// Adds a load with one sample per time stamp of the engine
+		void addLoad(AttributeBase::Ptr activePower, AttributeBase::Ptr reactivePower,
+			const std::vector<Real>& activePowerSamples, const std::vector<Real>& reactivePowerSamples);
+
+		UInt numLoads() const { return static_cast<UInt>(mActivePowers.size()); }
+		UInt numTimes() const { return static_cast<UInt>(mTimes.size()); }
+		/// Indices of the loads in the order of addition whose power changed in the last step
+		const std::vector<UInt>& changedLoads() const { return mChangedLoads; }
+
+		void initialize(Real timeStep) override;
+		Task::List getTasks() override;
+
+		class Step : public Task {
+		public:
+			Step(LoadProfileEngine& engine);
+			void execute(Real time, Int timeStepCount) override;
+
+		private:
+			LoadProfileEngine& mEngine;
+		};
+
+	private:
+		Attribute<Real>::Ptr realAttribute(AttributeBase::Ptr attr) const;
+		/// Moves the samples of the loads added since the last call into the profile matrices
+		void appendColumns();
+		/// Interpolates all loads and writes the changed powers
+		void apply(Real time);
+
+		/// Sorted time stamps of the rows
+		std::vector<Real> mTimes;
+		/// Last row at or before the time of the last step
+		std::size_t mCursor = 0;
+		/// Samples with a row per time stamp and a column per load
+		MatrixRow mActivePowerProfiles;
+		MatrixRow mReactivePowerProfiles;
+		/// Samples of the loads not yet in the profile matrices
+		std::vector<std::vector<Real>> mNewActivePowerColumns;
+		std::vector<std::vector<Real>> mNewReactivePowerColumns;
+
+		std::vector<Attribute<Real>::Ptr> mActivePowers;
+		std::vector<Attribute<Real>::Ptr> mReactivePowers;
+		/// Interpolated powers of the last step
+		Eigen::Matrix<Real, 1, Eigen::Dynamic> mActivePowerValues;
+		Eigen::Matrix<Real, 1, Eigen::Dynamic> mReactivePowerValues;
+		Eigen::Matrix<Real, 1, Eigen::Dynamic> mNextActivePowerValues;
+		Eigen::Matrix<Real, 1, Eigen::Dynamic> mNextReactivePowerValues;
+		std::vector<UInt> mChangedLoads;
+	};
+}
+}
@@ -29,7 +29,7 @@ namespace Signal {
 		/// Nominal frequency
 		Real mOmegaNom;
 		/// Integration time step
-        Real mTimeStep;
+        Real mTimeStep = 0;
 
 		/// matrix A of state space model
 		Matrix mA = Matrix::Zero(2, 2);
@@ -39,6 +39,13 @@ namespace Signal {
 		Matrix mC = Matrix::Zero(2, 2);
 		/// matrix D of state space model
 		Matrix mD = Matrix::Zero(2, 2);
+		/// state matrix of the model discretized with the trapezoidal rule
+		Matrix mAd = Matrix::Zero(2, 2);
+		/// input matrix of the model discretized with the trapezoidal rule
+		Matrix mBd = Matrix::Zero(2, 2);
+
+		/// Discretizes the state space model for the integration time step
+		void discretizeStateSpaceModel();
 
 	public:
 
@@ -58,6 +58,10 @@ namespace Signal {
 		Matrix mC = Matrix::Zero(2, 6);
 		/// matrix D of state space model
 		Matrix mD = Matrix::Zero(2, 6);
+		/// state matrix of the model discretized with the trapezoidal rule
+		Matrix mAd = Matrix::Zero(6, 6);
+		/// input matrix of the discretized model, which is multiplied with the input dependent B
+		Matrix mBd = Matrix::Zero(6, 6);
 
 	public:
 
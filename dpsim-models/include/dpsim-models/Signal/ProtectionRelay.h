@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <dpsim-models/SimSignalComp.h>
+#include <dpsim-models/Task.h>
+
+namespace CPS {
+namespace Signal {
+	/// Definite-time relay that opens a switch when the magnitude of its input,
+	/// e.g. a line current, stays at or above the threshold for the trip delay.
+	///
+	/// The relay is imminent to trip once the input reaches the speculation
+	/// margin times the threshold. The simulation can then factorize the system
+	/// matrix of the opened switch in the background, see
+	/// Simulation::doSpeculativeFactorization().
+	class ProtectionRelay :
+		public SimSignalComp,
+		public SharedFactory<ProtectionRelay> {
+	public:
+		/// Monitored value, the outside code is responsible for setting up the reference
+		const Attribute<Real>::Ptr mInputRef;
+		/// True after the relay opened the switch
+		const Attribute<Bool>::Ptr mTripped;
+		/// Time at which the input reached the threshold, -1 below the threshold
+		const Attribute<Real>::Ptr mPickupTime;
+
+		ProtectionRelay(String uid, String name, Logger::Level logLevel = Logger::Level::off);
+		ProtectionRelay(String name, Logger::Level logLevel = Logger::Level::off) :
+			ProtectionRelay(name, name, logLevel) { }
+
+		///
+		void setParameters(Real threshold, Real delay = 0, Real speculationMargin = 0.9);
+		/// Sets the state attribute of the switch opened by the relay, e.g. "is_closed"
+		void setSwitch(AttributeBase::Ptr switchState);
+		/// State attribute of the switch, nullptr if not set
+		Attribute<Bool>::Ptr switchState() const { return mSwitchState; }
+		/// True if the relay has not tripped yet and its input is within the speculation margin
+		Bool tripImminent() const;
+
+		void initialize(Real timeStep) override;
+		Task::List getTasks() override;
+
+		class Step : public Task {
+		public:
+			Step(ProtectionRelay& relay);
+			void execute(Real time, Int timeStepCount) override;
+
+		private:
+			ProtectionRelay& mRelay;
+		};
+
+	private:
+		Real mThreshold = 0;
+		Real mDelay = 0;
+		Real mSpeculationMargin = 0.9;
+		Real mTimeStep = 0;
+		Attribute<Bool>::Ptr mSwitchState;
+	};
+}
+}
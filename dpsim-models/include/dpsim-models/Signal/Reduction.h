@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim-models/SimSignalComp.h>
+#include <dpsim-models/Task.h>
+
+namespace CPS {
+namespace Signal {
+	/// Aggregate of a set of attributes computed during the simulation, e.g. the
+	/// total losses, the centre-of-inertia frequency, the minimum bus voltage or
+	/// the maximum line loading, so that only the aggregates have to be logged
+	/// or interfaced instead of all nodes and branches.
+	///
+	/// Each input contributes weight * x, where x is the value of a Real
+	/// attribute or the magnitude of a Complex attribute or of an element of a
+	/// matrix attribute. The mean is the weighted sum divided by the sum of the
+	/// weights. The inputs can be split into chunks, whose partial aggregates
+	/// are computed by separate tasks that the scheduler can execute in parallel.
+	class Reduction :
+		public SimSignalComp,
+		public SharedFactory<Reduction> {
+	public:
+		enum class Operation { Sum, Mean, Min, Max };
+
+		/// Aggregated value
+		const Attribute<Real>::Ptr mOutput;
+
+		Reduction(String uid, String name, Logger::Level logLevel = Logger::Level::off);
+		Reduction(String name, Operation operation = Operation::Sum, Logger::Level logLevel = Logger::Level::off);
+
+		void setOperation(Operation operation) { mOperation = operation; }
+		/// Adds an input, row and column select the element of matrix attributes
+		void addInput(AttributeBase::Ptr input, Real weight = 1, UInt row = 0, UInt col = 0);
+		/// Distributes the inputs over the given number of tasks
+		void setChunks(UInt chunks);
+		/// Only calculate the output every factor-th step and keep it in between
+		void setDecimation(UInt factor);
+
+		void initialize(Real timeStep) override;
+		Task::List getTasks() override;
+
+		/// Index of the input with the minimum or maximum weighted value in the
+		/// order of addition, -1 for sums, means or if there are no inputs
+		Int argument() const { return mArgument; }
+		UInt numInputs() const { return static_cast<UInt>(mInputs.size()); }
+
+		/// Computes the partial aggregate of one chunk of the inputs
+		class ChunkStep : public Task {
+		public:
+			ChunkStep(Reduction& reduction, UInt chunk);
+			void execute(Real time, Int timeStepCount) override;
+
+		private:
+			Reduction& mReduction;
+			UInt mChunk;
+		};
+
+		/// Combines the partial aggregates of the chunks
+		class Step : public Task {
+		public:
+			Step(Reduction& reduction);
+			void execute(Real time, Int timeStepCount) override;
+
+		private:
+			Reduction& mReduction;
+		};
+
+	private:
+		enum class InputType { Real, Complex, Matrix, MatrixComp };
+
+		struct Input {
+			AttributeBase::Ptr attribute;
+			InputType type;
+			Real weight;
+			UInt row;
+			UInt col;
+		};
+
+		/// Weighted sum or extremum, sum of the weights and index of the extremum
+		struct Partial {
+			Real value;
+			Real weights;
+			Int argument;
+		};
+
+		/// Value of an input without its weight
+		static Real inputValue(const Input& input);
+		Partial emptyPartial() const;
+		/// Aggregates the inputs of one chunk
+		Partial reduce(UInt chunk) const;
+		/// Merges the partial aggregate into the first one
+		void combine(Partial& result, const Partial& partial) const;
+		/// Sets the output from the aggregate of all inputs
+		void setOutput(const Partial& result);
+		/// Range of the inputs of a chunk
+		UInt chunkBegin(UInt chunk) const;
+
+		Operation mOperation = Operation::Sum;
+		std::vector<Input> mInputs;
+		UInt mChunks = 1;
+		/// Output is only calculated every mDecimation-th step
+		Int mDecimation = 1;
+		Int mArgument = -1;
+
+		/// Partial aggregates of the chunks, the attributes order the tasks
+		std::vector<Partial> mPartials;
+		std::vector<Attribute<Real>::Ptr> mPartialAttributes;
+	};
+}
+}
@@ -51,6 +51,8 @@ namespace Signal {
 		Real mXg2_prev;
 		/// Reheat output at time k-1
 		Real mXg3_prev;
+		/// Integrate with backward instead of forward Euler
+		Bool mImplicitIntegration = false;
 
 	protected:
 		// ### Variables ###
@@ -73,6 +75,9 @@ namespace Signal {
 		/// Initializes exciter parameters
 		void setParameters(Real T3, Real T4, Real T5, Real Tc, Real Ts, Real R, 
 			Real Tmin, Real Tmax, Real OmRef);
+		/// Integrate with backward Euler, which allows time steps above the
+		/// time constants, e.g. for long-term simulations
+		void doImplicitIntegration(Bool value) { mImplicitIntegration = value; }
 		///
 		void initialize(Real TmRef) override;
 		/// Performs an step to update field voltage value
@@ -78,26 +78,28 @@ namespace CPS {
 		// #### MNA Section ####
 		///
 		void mnaUpdateVoltage(const Matrix& leftVector);
+		/// Solution vector rows read by mnaUpdateVoltage, one per voltage row
+		std::vector<UInt> mnaVoltageRows();
 		///
 		void mnaInitializeHarm(std::vector<Attribute<Matrix>::Ptr> leftVector);
 		///
 		void mnaUpdateVoltageHarm(const Matrix& leftVector, Int freqIdx);
 		/// Return list of MNA tasks
 		const Task::List& mnaTasks();
-		///
+		/// Updates the voltage of one frequency, so that it only waits for the solve of that frequency
 		class MnaPostStepHarm : public Task {
 		public:
-			MnaPostStepHarm(SimNode& node, const std::vector<Attribute<Matrix>::Ptr> &leftVectors) :
+			MnaPostStepHarm(SimNode& node, const Attribute<Matrix>::Ptr &leftVector, Int freqIdx) :
 				Task(**node.mName + ".MnaPostStepHarm"),
-				mNode(node), mLeftVectors(leftVectors) {
-				for (UInt i = 0; i < mLeftVectors.size(); i++)
-					mAttributeDependencies.push_back(mLeftVectors[i]);
+				mNode(node), mLeftVector(leftVector), mFreqIdx(freqIdx) {
+				mAttributeDependencies.push_back(mLeftVector);
 				mModifiedAttributes.push_back(mNode.attribute("v"));
 			}
 			void execute(Real time, Int timeStepCount);
 		private:
 			SimNode& mNode;
-			std::vector< Attribute<Matrix>::Ptr > mLeftVectors;
+			Attribute<Matrix>::Ptr mLeftVector;
+			Int mFreqIdx;
 		};
 	};
 
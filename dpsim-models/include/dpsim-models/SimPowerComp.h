@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <array>
+
 #include <dpsim-models/TopologicalPowerComp.h>
 #include <dpsim-models/SimTerminal.h>
 #include <dpsim-models/SimNode.h>
@@ -97,8 +99,18 @@ namespace CPS {
 		UInt matrixNodeIndex(UInt nodeIndex, UInt phaseIndex);
 		/// TODO replace with access to mMatrixNodeIndices
 		std::vector<UInt> matrixNodeIndices(UInt index);
+		/// Returns the cached matrix node indices of the first NumPhases phases of a terminal
+		template <std::size_t NumPhases = 3>
+		std::array<UInt, NumPhases> matrixNodeIndexArray(UInt nodeIndex) const {
+			std::array<UInt, NumPhases> indices;
+			for (std::size_t phase = 0; phase < NumPhases; phase++)
+				indices[phase] = mMatrixNodeIndices[nodeIndex * 3 + phase];
+			return indices;
+		}
 		/// Get nodes as base type TopologicalNode
 		TopologicalNode::List topologicalNodes();
+		/// Appends the matrix node indices of all non-ground terminal nodes, virtual nodes and subcomponent nodes
+		void collectMatrixNodeIndices(std::vector<UInt>& indices);
 
 		// #### Virtual Nodes ####
 		/// Returns nominal number of virtual nodes for this component type.
@@ -36,6 +36,8 @@ namespace CPS {
 		virtual void mnaPreStep(Real time, Int timeStepCount) = 0;
 		/// MNA post step operations
 		virtual void mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) = 0;
+		/// MNA output step operations, if they are not part of the post step
+		virtual void mnaOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) { }
 		/// Add MNA pre step dependencies
 		virtual void mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) = 0;
 		/// Add MNA post step dependencies
@@ -53,5 +55,8 @@ namespace CPS {
 		virtual const Task::List& mnaTasks() const = 0;
 		// Return right vector attribute
 		virtual Attribute<Matrix>::Ptr getRightVector() const = 0;
+		/// Appends the rows of the right vector this component can write to.
+		/// Returns false if the rows are unknown and the right vector has to be summed up densely.
+		virtual Bool mnaRightVectorStampRows(std::vector<UInt>& rows) { return false; }
 	};
 }
@@ -0,0 +1,28 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim-models/Config.h>
+#include <dpsim-models/Definitions.h>
+
+namespace CPS {
+	/// MNA interface to be used by elements that correct their right side vector
+	/// contribution within the time step instead of changing the system matrix
+	class MNAIterativeCompInterface {
+	public:
+		typedef std::shared_ptr<MNAIterativeCompInterface> Ptr;
+		typedef std::vector<Ptr> List;
+
+		/// Returns true if the element has to be corrected after each solve
+		virtual Bool mnaIsIterative() const = 0;
+		/// Updates the right side vector contribution from the latest solution,
+		/// returns true if the contribution changed less than the tolerance of the element
+		virtual Bool mnaCorrectorStep(const Matrix& leftVector) = 0;
+	};
+}
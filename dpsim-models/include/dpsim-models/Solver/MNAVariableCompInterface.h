@@ -22,5 +22,29 @@ namespace CPS {
 
 		/// Returns true if one of the element paramters has changed
 		virtual Bool hasParameterChanged() = 0;
+
+		/// Sets the deviation of the parameters from their stamped values up to which
+		/// the system matrix is not updated. Components supporting the threshold
+		/// compensate the deviation in their right side vector stamp instead.
+		void setParameterChangeThreshold(Real relative, Real absolute) {
+			mRelativeChangeThreshold = relative;
+			mAbsoluteChangeThreshold = absolute;
+		}
+
+	protected:
+		/// Change thresholds relative to the stamped value and absolute
+		Real mRelativeChangeThreshold = 0;
+		Real mAbsoluteChangeThreshold = 0;
+
+		/// Returns true if the present value deviates significantly from the stamped value.
+		/// The stamped value is only replaced by significant changes, so that small changes
+		/// accumulate until they exceed the threshold.
+		Bool isParameterChangeSignificant(Real stamped, Real present) const {
+			return std::abs(present - stamped) > mAbsoluteChangeThreshold + mRelativeChangeThreshold * std::abs(stamped);
+		}
+		/// Element-wise maximum deviation of parameter matrices
+		Bool isParameterChangeSignificant(const Matrix& stamped, const Matrix& present) const {
+			return (present - stamped).cwiseAbs().maxCoeff() > mAbsoluteChangeThreshold + mRelativeChangeThreshold * stamped.cwiseAbs().maxCoeff();
+		}
 	};
 }
@@ -0,0 +1,27 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim-models/Config.h>
+#include <dpsim-models/Definitions.h>
+
+namespace CPS {
+	/// MNA interface to be used by dynamic phasor elements that follow a change of the shift frequency during the simulation
+	class MNAVariableFrequencyInterface {
+	public:
+		typedef std::shared_ptr<MNAVariableFrequencyInterface> Ptr;
+		typedef std::vector<Ptr> List;
+
+		/// Changes the shift frequency of the phasors from the given time on.
+		/// Companion models recompute their coefficients and keep their history,
+		/// the solver restamps the system matrix. Sources rotate their phasors,
+		/// which are defined relative to the nominal frequency, into the new frame.
+		virtual void mnaUpdateShiftFrequency(Real frequency, Real time, Real timeStep) = 0;
+	};
+}
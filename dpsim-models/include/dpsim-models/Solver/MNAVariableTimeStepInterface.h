@@ -0,0 +1,25 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim-models/Config.h>
+#include <dpsim-models/Definitions.h>
+
+namespace CPS {
+	/// MNA interface to be used by elements with a companion model that can change its time step during the simulation
+	class MNAVariableTimeStepInterface {
+	public:
+		typedef std::shared_ptr<MNAVariableTimeStepInterface> Ptr;
+		typedef std::vector<Ptr> List;
+
+		/// Recomputes the coefficients of the companion model for the new time step.
+		/// The history of the element is kept, the solver restamps the system matrix.
+		virtual void mnaUpdateTimeStep(Real timeStep) = 0;
+	};
+}
@@ -16,7 +16,7 @@ namespace CPS {
 	class ODEInterface {
 	public:
 		using Ptr = std::shared_ptr<ODEInterface>;
-		//typedef std::vector<Ptr> List;
+		typedef std::vector<Ptr> List;
 
 		const CPS::AttributeList::Ptr mAttributeList;
 
@@ -37,6 +37,12 @@ namespace CPS {
 		virtual void odeJacobian(double t, const double y[], double fy[], double J[],
 		                         double tmp1[], double tmp2[], double tmp3[]) = 0;
 
+		/// Structurally nonzero entries (row, column) of the Jacobian, used by
+		/// sparse linear solvers. The values are taken from odeJacobian, whose
+		/// dense matrix is column-major like the SUNDIALS dense matrix. An empty
+		/// pattern is treated as a full matrix.
+		virtual std::vector<std::pair<Int, Int>> odeJacobianPattern() { return {}; }
+
 	protected:
 		explicit ODEInterface(AttributeList::Ptr attrList) :
 		mAttributeList(attrList),
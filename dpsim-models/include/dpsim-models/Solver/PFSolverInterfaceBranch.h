@@ -23,5 +23,24 @@ namespace CPS {
 	public:
 		/// Stamp admittance matrix of the system
 		virtual void pfApplyAdmittanceMatrixStamp(SparseMatrixCompRow & Y) = 0;
+		/// Add the change of the element admittance matrix since the last stamp
+		/// to the entries of the branch in Y, which must already exist, so that
+		/// the sparsity pattern is kept. Returns whether the admittance changed.
+		virtual Bool pfApplyAdmittanceMatrixUpdate(SparseMatrixCompRow & Y) { return false; }
+		/// Flag whether the parameters changed since the admittance matrix was stamped
+		Bool pfAdmittanceChanged() const { return mPfAdmittanceChanged; }
+
+	protected:
+		/// Set by parameter changes which affect the admittance matrix stamp
+		Bool mPfAdmittanceChanged = false;
+
+		/// Add the difference of two element admittance matrices to the entries of the branch buses
+		static void pfStampAdmittanceDifference(SparseMatrixCompRow & Y, UInt bus0, UInt bus1,
+			const MatrixComp& element, const MatrixComp& previous) {
+			Y.coeffRef(bus0, bus0) += element.coeff(0, 0) - previous.coeff(0, 0);
+			Y.coeffRef(bus0, bus1) += element.coeff(0, 1) - previous.coeff(0, 1);
+			Y.coeffRef(bus1, bus1) += element.coeff(1, 1) - previous.coeff(1, 1);
+			Y.coeffRef(bus1, bus0) += element.coeff(1, 0) - previous.coeff(1, 0);
+		}
     };
 }
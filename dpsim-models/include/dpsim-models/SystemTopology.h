@@ -10,6 +10,8 @@
 
 #include <vector>
 #include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 #include <dpsim-models/TopologicalPowerComp.h>
 #include <dpsim-models/SimPowerComp.h>
@@ -107,6 +109,10 @@ namespace CPS {
 		/// Add multiple components
 		void addComponents(const IdentifiedObject::List& components);
 
+		/// Removes the component from the component list and from the lists of
+		/// the components at its nodes
+		void removeComponent(IdentifiedObject::Ptr component);
+
 		/// Initialize nodes from PowerFlow
 		void initWithPowerflow(const SystemTopology& systemPF);
 
@@ -116,6 +122,15 @@ namespace CPS {
 		/// Add multiple components
 		void addTearComponents(const IdentifiedObject::List& components);
 
+		/// Remove the components from the component list and add them as tear components
+		void moveToTearComponents(const IdentifiedObject::List& components);
+
+		/// Replace every DP PiLine without shunt conductance whose propagation
+		/// delay sqrt(L*C) is at least minDelaySteps time steps by a Bergeron
+		/// DecouplingLine. The line ends are then in separate subnets, which
+		/// can be solved independently. Returns the inserted decoupling lines.
+		IdentifiedObject::List decoupleLines(Real timeStep, UInt minDelaySteps);
+
 		// #### Get Objects from SystemTopology ####
 
 		/// Returns TopologicalNode by index in node list
@@ -129,15 +144,9 @@ namespace CPS {
 		/// Returns Component by name
 		template<typename Type>
 		typename std::shared_ptr<Type> component(const String &name) {
-			for (auto comp : mComponents) {
-				if (comp->name() == name) {
-					auto comp2 = std::dynamic_pointer_cast<Type>(comp);
-					if (comp2)
-						return comp2;
-					else
-						return nullptr;
-				}
-			}
+			std::size_t index = findComponent(name);
+			if (index < mComponents.size())
+				return std::dynamic_pointer_cast<Type>(mComponents[index]);
 			return nullptr;
 		}
 
@@ -146,7 +155,18 @@ namespace CPS {
 		// #### Operations on the SystemTopology ####
 
 		/// Copy the whole topology the given number of times and add the resulting components and nodes to the topology.
-		void multiply(Int numberCopies);
+		/// The names of the copies get the suffix "_2", "_3" and so on. The copies are created in parallel
+		/// if requested and OpenMP is available, which requires the clone() of all components to be thread safe.
+		void multiply(Int numberCopies, Bool parallel = false);
+
+		/// Returns a topology of clones of all nodes and power components with the same names
+		/// and the same parameters. Signal components cannot be cloned and are not allowed.
+		SystemTopology copy() const;
+
+		/// Returns the given number of random pairs of node names in different copies created by multiply(),
+		/// which can be connected to couple the copies. The nodes are drawn from the given names of the original topology.
+		static std::vector<std::pair<String, String>> randomInterconnections(Int numberCopies,
+			const std::vector<String>& nodeNames, UInt count, UInt seed = 0);
 
 		///
 		template <typename VarType>
@@ -156,6 +176,13 @@ namespace CPS {
 		template <typename VarType>
 		void splitSubnets(std::vector<CPS::SystemTopology>& splitSystems);
 
+		/// True if the topology holds EMT nodes as well as SP or DP nodes
+		Bool isHybrid() const;
+		/// Splits a hybrid topology into its SP/DP and its EMT part. The signal
+		/// components, e.g. the interfaces between the parts, are put into the
+		/// EMT part, which usually runs with the smaller time step.
+		void splitDomains(SystemTopology& phasorSystem, SystemTopology& emtSystem) const;
+
 #ifdef WITH_GRAPHVIZ
 		Graph::Graph topologyGraph();
 		String render();
@@ -164,6 +191,27 @@ namespace CPS {
 
 	private:
 		template<typename VarType>
-		void multiplyPowerComps(Int numberCopies);
+		void multiplyPowerComps(Int numberCopies, Bool parallel);
+		template<typename VarType>
+		void copyPowerComps(SystemTopology& target) const;
+
+		/// Position of the first object of each name in mComponents and mNodes.
+		/// The indices are rebuilt when a found object has another name, or
+		/// when a name is missing and the lists were changed by a method of
+		/// the topology or changed their length since the last build.
+		std::unordered_map<String, std::size_t> mComponentIndex;
+		std::unordered_map<String, std::size_t> mNodeIndex;
+		/// Incremented by every method changing mComponents or mNodes
+		std::size_t mGeneration = 0;
+		/// Generation and length of the lists when the indices were built
+		std::size_t mIndexedComponentsGeneration = std::numeric_limits<std::size_t>::max();
+		std::size_t mIndexedNodesGeneration = std::numeric_limits<std::size_t>::max();
+		std::size_t mIndexedComponents = 0;
+		std::size_t mIndexedNodes = 0;
+
+		/// Position of the first component with the given name, or the number of components
+		std::size_t findComponent(const String &name);
+		/// Position of the first node with the given name, or the number of nodes
+		std::size_t findNode(const String &name);
 	};
 }
@@ -48,9 +48,32 @@ namespace CPS {
 			return mPrevStepDependencies;
 		}
 
+		/// Tasks with the same non-empty batch key can be replaced by one task executing
+		/// all of them, e.g. the same step of several components of the same type
+		virtual String batchKey() const {
+			return String();
+		}
+
+		/// Creates a task executing all given tasks, which have the batch key of this task
+		virtual Ptr createBatch(const List& tasks) const {
+			return nullptr;
+		}
+
+		/// Tasks whose results leave the simulation, like interface exports, and
+		/// should be executed as early as possible within a step
+		virtual Bool latencyCritical() const {
+			return false;
+		}
+
+		/// Index of the scheduler thread the task should run on, e.g. the thread on
+		/// whose NUMA node its data were allocated, -1 for any thread
+		Int threadHint() const { return mThreadHint; }
+		void setThreadHint(Int thread) { mThreadHint = thread; }
+
 	protected:
 		Task(const std::string &name) : mName(name) {}
 		std::string mName;
+		Int mThreadHint = -1;
 		std::vector<AttributeBase::Ptr> mAttributeDependencies;
 		std::vector<AttributeBase::Ptr> mModifiedAttributes;
 		std::vector<AttributeBase::Ptr> mPrevStepDependencies;
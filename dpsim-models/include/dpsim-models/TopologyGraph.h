@@ -0,0 +1,79 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include <dpsim-models/Definitions.h>
+#include <dpsim-models/SimNode.h>
+#include <dpsim-models/SimPowerComp.h>
+
+namespace CPS {
+	/// \brief Integer indexed connectivity of the nodes and power components of a topology
+	///
+	/// The graph is built in one pass over the components. The nodes of the domain
+	/// are numbered in their order in the node list, without ground. The components
+	/// of the domain keep their order as well. The following are stored in compressed
+	/// row format:
+	/// - the connected nodes of each component;
+	/// - the components at each node;
+	/// - the adjacency of the nodes.
+	/// A component connects its first node with each of its other nodes by one edge.
+	template <typename VarType>
+	class TopologyGraph {
+	public:
+		/// Index of ground and of nodes which are not part of the graph
+		static constexpr UInt noNode = std::numeric_limits<UInt>::max();
+
+		TopologyGraph(const TopologicalNode::List& nodes, const IdentifiedObject::List& components);
+
+		UInt nodeCount() const { return static_cast<UInt>(mNodes.size()); }
+		UInt componentCount() const { return static_cast<UInt>(mComponents.size()); }
+		UInt edgeCount() const { return static_cast<UInt>(mEdgeComponent.size()); }
+
+		const typename SimNode<VarType>::Ptr& node(UInt k) const { return mNodes[k]; }
+		const typename SimPowerComp<VarType>::Ptr& component(UInt c) const { return mComponents[c]; }
+		/// Index of the node, or noNode
+		UInt nodeIndex(const TopologicalNode* node) const;
+
+		/// Indices of the connected nodes of component c, excluding ground
+		const UInt* componentNodesBegin(UInt c) const { return mCompNodes.data() + mCompNodeStart[c]; }
+		const UInt* componentNodesEnd(UInt c) const { return mCompNodes.data() + mCompNodeStart[c+1]; }
+		/// Indices of the components at node k
+		const UInt* nodeComponentsBegin(UInt k) const { return mNodeComps.data() + mNodeCompStart[k]; }
+		const UInt* nodeComponentsEnd(UInt k) const { return mNodeComps.data() + mNodeCompStart[k+1]; }
+		/// Neighbour node and edge index pairs of node k
+		const std::pair<UInt, UInt>* neighboursBegin(UInt k) const { return mAdjacency.data() + mAdjacencyStart[k]; }
+		const std::pair<UInt, UInt>* neighboursEnd(UInt k) const { return mAdjacency.data() + mAdjacencyStart[k+1]; }
+		/// Component of edge e
+		UInt edgeComponent(UInt e) const { return mEdgeComponent[e]; }
+
+		/// Determines the connected island of each node by union-find and returns the
+		/// number of islands. The islands are numbered in the order of their first node.
+		UInt islands(std::vector<UInt>& island) const;
+		/// Returns the components whose edge is a bridge, i.e. whose removal splits an island
+		std::vector<UInt> bridges() const;
+
+	private:
+		typename SimNode<VarType>::List mNodes;
+		typename SimPowerComp<VarType>::List mComponents;
+		std::unordered_map<const TopologicalNode*, UInt> mNodeIndex;
+
+		std::vector<UInt> mCompNodeStart;
+		std::vector<UInt> mCompNodes;
+		std::vector<UInt> mNodeCompStart;
+		std::vector<UInt> mNodeComps;
+		std::vector<UInt> mAdjacencyStart;
+		std::vector<std::pair<UInt, UInt>> mAdjacency;
+		std::vector<std::pair<UInt, UInt>> mEdges;
+		std::vector<UInt> mEdgeComponent;
+	};
+}
@@ -0,0 +1,88 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include <dpsim-models/Definitions.h>
+#include <dpsim-models/Logger.h>
+#include <dpsim-models/SystemTopology.h>
+
+namespace CPS {
+	/// Selects tear components for the diakoptics solver
+	///
+	/// The network nodes are partitioned by multilevel recursive bisection:
+	/// the graph is coarsened by heavy edge matching, the coarsest graph is
+	/// bisected by greedy graph growing and the bisection is refined with
+	/// Fiduccia-Mattheyses passes on every level while uncoarsening. Node
+	/// weights are the number of nonzeros of the node rows in the system
+	/// matrix, so the partitions get similar factorization and solve costs.
+	/// Only two-terminal components implementing MNATearInterface between
+	/// single-phase nodes can be torn, all other components keep their nodes
+	/// in the same partition. The tear list contains the candidates between
+	/// different partitions and is minimized within the balance tolerance.
+	class TopologyPartitioner {
+	public:
+		///
+		TopologyPartitioner(String name = "TopologyPartitioner", Logger::Level logLevel = Logger::Level::info);
+
+		/// Allowed relative excess of the partition weights over the balanced weight
+		void setImbalance(Real imbalance) { mImbalance = imbalance; }
+
+		/// Partitions the system, usually into one subnet per thread, and
+		/// returns the components which have to be torn
+		template <typename VarType>
+		IdentifiedObject::List partition(const SystemTopology& system, UInt numPartitions);
+
+		/// Partitions an undirected graph given by its vertex weights and its
+		/// adjacency lists of (neighbour, edge weight) pairs with the same
+		/// multilevel bisection, returns the partition of each vertex
+		std::vector<UInt> partitionGraph(const std::vector<UInt>& weights,
+			const std::vector<std::vector<std::pair<UInt, UInt>>>& adjacency, UInt numPartitions);
+
+		/// Partition of each node of the last partitioning by node name
+		const std::map<String, UInt>& nodePartitions() const { return mNodePartitions; }
+		/// Sum of the node weights of each partition of the last partitioning
+		const std::vector<UInt>& partitionWeights() const { return mPartitionWeights; }
+
+	private:
+		/// Undirected graph with node and edge weights
+		struct Graph {
+			std::vector<UInt> weights;
+			std::vector<std::vector<std::pair<UInt, UInt>>> adjacency;
+
+			UInt size() const { return static_cast<UInt>(weights.size()); }
+			UInt totalWeight() const;
+		};
+
+		/// Splits the nodes of the graph into numPartitions parts, starting at firstPartition
+		void recursiveBisection(const Graph& graph, const std::vector<UInt>& vertices,
+			UInt numPartitions, UInt firstPartition, Real imbalance, std::vector<UInt>& partition);
+		/// Multilevel bisection with the given target weights of both parts
+		std::vector<UInt> bisect(const Graph& graph, UInt targetWeight0, UInt targetWeight1, Real imbalance);
+		/// Heavy edge matching, returns the coarse vertex of each vertex
+		std::vector<UInt> coarsen(const Graph& graph, Graph& coarse, UInt maxVertexWeight);
+		/// Greedy graph growing bisection of the coarsest graph
+		std::vector<UInt> initialBisection(const Graph& graph, UInt targetWeight0, UInt maxWeight0, UInt maxWeight1);
+		/// Fiduccia-Mattheyses refinement
+		void refine(const Graph& graph, std::vector<UInt>& part, UInt maxWeight0, UInt maxWeight1);
+		///
+		static UInt cut(const Graph& graph, const std::vector<UInt>& part);
+
+		///
+		Logger::Log mSLog;
+		///
+		Real mImbalance = 0.05;
+		///
+		std::map<String, UInt> mNodePartitions;
+		///
+		std::vector<UInt> mPartitionWeights;
+	};
+}
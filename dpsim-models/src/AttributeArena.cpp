@@ -0,0 +1,53 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/AttributeArena.h>
+
+using namespace CPS;
+
+template <typename T>
+Bool AttributeArena::addTyped(AttributeBase::Ptr attribute, Pool<T>& pool) {
+	auto typed = std::dynamic_pointer_cast<AttributeStatic<T>>(attribute.getPtr());
+	if (!typed)
+		return false;
+	pool.attributes.push_back(typed);
+	return true;
+}
+
+Bool AttributeArena::add(AttributeBase::Ptr attribute) {
+	if (!attribute.getPtr() || !attribute->isStatic() || !mAdded.insert(attribute.getPtr().get()).second)
+		return false;
+
+	return addTyped(attribute, mReals)
+		|| addTyped(attribute, mComplexes)
+		|| addTyped(attribute, mMatrices)
+		|| addTyped(attribute, mComplexMatrices);
+}
+
+template <typename T>
+UInt AttributeArena::Pool<T>::allocate() {
+	std::vector<std::shared_ptr<AttributeStatic<T>>> movable;
+	for (auto& attribute : attributes) {
+		if (attribute->ownsData())
+			movable.push_back(attribute);
+	}
+
+	auto storage = std::make_shared<std::vector<T>>(movable.size());
+	for (std::size_t i = 0; i < movable.size(); ++i)
+		movable[i]->relocateData(std::shared_ptr<T>(storage, &(*storage)[i]));
+
+	attributes.clear();
+	return static_cast<UInt>(movable.size());
+}
+
+UInt AttributeArena::allocate() {
+	UInt moved = mReals.allocate() + mComplexes.allocate()
+		+ mMatrices.allocate() + mComplexMatrices.allocate();
+	mAdded.clear();
+	return moved;
+}
@@ -0,0 +1,54 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/Base/Base_Converter.h>
+
+using namespace CPS;
+
+void Base::Converter::setSwitchingParameters(Real dcVoltage, Real carrierFrequency) {
+	mDCVoltage = dcVoltage;
+	mCarrierFrequency = carrierFrequency;
+}
+
+void Base::Converter::setFidelity(Fidelity fidelity) {
+	if (fidelity == Fidelity::SwitchingFunction && (mDCVoltage <= 0 || mCarrierFrequency <= 0))
+		throw SystemError("Switching function model requires DC voltage and carrier frequency");
+	mFidelity = fidelity;
+}
+
+Real Base::Converter::switchedLegVoltage(Real reference, Real begin, Real end) const {
+	Real modulation = std::max(-1., std::min(1., reference / (mDCVoltage / 2.)));
+	Real halfPeriod = 0.5 / mCarrierFrequency;
+
+	// The carrier rises from -1 to 1 in even and falls back in odd half periods.
+	// Within a half period it is linear, so the time the reference is above it
+	// follows from the crossing of both.
+	Real onTime = 0;
+	Real time = begin;
+	Int halfPeriodIdx = static_cast<Int>(std::floor(begin / halfPeriod));
+	while (time < end) {
+		Real segmentEnd = std::min(end, (halfPeriodIdx + 1) * halfPeriod);
+		if (segmentEnd > time) {
+			Real carrierBegin = -1. + 2. * (time / halfPeriod - halfPeriodIdx);
+			Real carrierEnd = -1. + 2. * (segmentEnd / halfPeriod - halfPeriodIdx);
+			if (halfPeriodIdx % 2 != 0) {
+				carrierBegin = -carrierBegin;
+				carrierEnd = -carrierEnd;
+			}
+			Real carrierMin = std::min(carrierBegin, carrierEnd);
+			Real carrierMax = std::max(carrierBegin, carrierEnd);
+			Real fraction = (modulation - carrierMin) / (carrierMax - carrierMin);
+			onTime += (segmentEnd - time) * std::max(0., std::min(1., fraction));
+			time = segmentEnd;
+		}
+		halfPeriodIdx++;
+	}
+
+	Real dutyCycle = onTime / (end - begin);
+	return mDCVoltage / 2. * (2. * dutyCycle - 1.);
+}
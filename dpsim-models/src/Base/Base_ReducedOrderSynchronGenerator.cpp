@@ -60,6 +60,16 @@ void Base::ReducedOrderSynchronGenerator<VarType>::setModelAsCurrentSource(Bool
 		this->setVirtualNodeNumber(2);
 }
 
+template <typename VarType>
+void Base::ReducedOrderSynchronGenerator<VarType>::setModelWithConstantConductance(Bool modelWithConstantConductance) {
+	mModelWithConstantConductance = modelWithConstantConductance;
+}
+
+template <typename VarType>
+void Base::ReducedOrderSynchronGenerator<VarType>::setCorrectorTolerance(Real tolerance) {
+	mCorrectorTolerance = tolerance;
+}
+
 template <typename VarType>
 void Base::ReducedOrderSynchronGenerator<VarType>::setBaseParameters(
 	Real nomPower, Real nomVolt, Real nomFreq) {
@@ -424,47 +434,53 @@ void Base::ReducedOrderSynchronGenerator<VarType>::mnaCompInitialize(Real omega,
 }
 
 template <>
-void Base::ReducedOrderSynchronGenerator<Complex>::mnaCompPreStep(Real time, Int timeStepCount) {
-	mSimTime = time;
-
-	// update controller variables
-	if (mHasExciter) {
-		mEf_prev = **mEf;
-		**mEf = mExciter->step((**mVdq)(0,0), (**mVdq)(1,0), mTimeStep);
-	}
-	if (mHasTurbineGovernor) {
-		mMechTorque_prev = **mMechTorque;
-		**mMechTorque = mTurbineGovernor->step(**mOmMech, mTimeStep);
-	}
+const Attribute<Matrix>::Ptr& Base::ReducedOrderSynchronGenerator<Complex>::torqueVoltage() const {
+	return mVdq;
+}
 
-	// calculate mechanical variables at t=k+1 with forward euler
-	if (mSimTime>0.0) {
-		**mElecTorque = ((**mVdq)(0,0) * (**mIdq)(0,0) + (**mVdq)(1,0) * (**mIdq)(1,0));
-		**mOmMech = **mOmMech + mTimeStep * (1. / (2. * mH) * (mMechTorque_prev - **mElecTorque));
-		**mThetaMech = **mThetaMech + mTimeStep * (**mOmMech * mBase_OmMech);
-		**mDelta = **mDelta + mTimeStep * (**mOmMech - 1.) * mBase_OmMech;
-	}
+template <>
+const Attribute<Matrix>::Ptr& Base::ReducedOrderSynchronGenerator<Complex>::torqueCurrent() const {
+	return mIdq;
+}
 
-	stepInPerUnit();
-	(**mRightVector).setZero();
-	mnaApplyRightSideVectorStamp(**mRightVector);
+template <>
+const Attribute<Matrix>::Ptr& Base::ReducedOrderSynchronGenerator<Real>::torqueVoltage() const {
+	return mVdq0;
 }
 
 template <>
-void Base::ReducedOrderSynchronGenerator<Real>::mnaCompPreStep(Real time, Int timeStepCount) {
-	mSimTime = time;
+const Attribute<Matrix>::Ptr& Base::ReducedOrderSynchronGenerator<Real>::torqueCurrent() const {
+	return mIdq0;
+}
+
+template <typename VarType>
+void Base::ReducedOrderSynchronGenerator<VarType>::stepControllers() {
 	if (mHasExciter) {
 		mEf_prev = **mEf;
-		**mEf = mExciter->step((**mVdq0)(0,0), (**mVdq0)(1,0), mTimeStep);
+		**mEf = mExciter->step((**torqueVoltage())(0,0), (**torqueVoltage())(1,0), mTimeStep);
 	}
 	if (mHasTurbineGovernor) {
 		mMechTorque_prev = **mMechTorque;
 		**mMechTorque = mTurbineGovernor->step(**mOmMech, mTimeStep);
 	}
+}
+
+template <typename VarType>
+void Base::ReducedOrderSynchronGenerator<VarType>::mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
+	modifiedAttributes.push_back(mRightVector);
+	prevStepDependencies.push_back(mIntfVoltage);
+}
+
+template <typename VarType>
+void Base::ReducedOrderSynchronGenerator<VarType>::mnaCompPreStep(Real time, Int timeStepCount) {
+	mSimTime = time;
+
+	// update controller variables
+	stepControllers();
 
 	// calculate mechanical variables at t=k+1 with forward euler
 	if (mSimTime>0.0) {
-		**mElecTorque = ((**mVdq0)(0,0) * (**mIdq0)(0,0) + (**mVdq0)(1,0) * (**mIdq0)(1,0));
+		**mElecTorque = ((**torqueVoltage())(0,0) * (**torqueCurrent())(0,0) + (**torqueVoltage())(1,0) * (**torqueCurrent())(1,0));
 		**mOmMech = **mOmMech + mTimeStep * (1. / (2. * mH) * (mMechTorque_prev - **mElecTorque));
 		**mThetaMech = **mThetaMech + mTimeStep * (**mOmMech * mBase_OmMech);
 		**mDelta = **mDelta + mTimeStep * (**mOmMech - 1.) * mBase_OmMech;
@@ -472,21 +488,90 @@ void Base::ReducedOrderSynchronGenerator<Real>::mnaCompPreStep(Real time, Int ti
 
 	stepInPerUnit();
 	(**mRightVector).setZero();
-	mnaApplyRightSideVectorStamp(**mRightVector);
+	this->mnaApplyRightSideVectorStamp(**mRightVector);
 }
 
 template <typename VarType>
-void Base::ReducedOrderSynchronGenerator<VarType>::mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
-	modifiedAttributes.push_back(mRightVector);
-	prevStepDependencies.push_back(mIntfVoltage);
+Bool Base::ReducedOrderSynchronGenerator<VarType>::mnaCompHasBatchedSteps() const {
+	return true;
 }
 
 template <typename VarType>
-void Base::ReducedOrderSynchronGenerator<VarType>::mnaCompPreStep(Real time, Int timeStepCount) {
-	mSimTime = time;
-	stepInPerUnit();
-	(**mRightVector).setZero();
-	this->mnaApplyRightSideVectorStamp(**mRightVector);
+Task::Ptr Base::ReducedOrderSynchronGenerator<VarType>::mnaCompCreateBatchedPreStep(const std::vector<MNASimPowerComp<VarType>*>& comps) {
+	std::vector<ReducedOrderSynchronGenerator<VarType>*> gens;
+	for (auto comp : comps) {
+		// All components of a batch have the type of this component
+		auto gen = static_cast<ReducedOrderSynchronGenerator<VarType>*>(comp);
+		// The states can only be moved into the batch if no one else holds their values
+		for (auto state : { gen->mOmMech, gen->mThetaMech, gen->mDelta, gen->mElecTorque }) {
+			auto typed = std::dynamic_pointer_cast<AttributeStatic<Real>>(state.getPtr());
+			if (!typed || !typed->ownsData())
+				return nullptr;
+		}
+		gens.push_back(gen);
+	}
+	return std::make_shared<MnaPreStepBatch>(gens);
+}
+
+template <typename VarType>
+Base::ReducedOrderSynchronGenerator<VarType>::MnaPreStepBatch::MnaPreStepBatch(const std::vector<ReducedOrderSynchronGenerator<VarType>*>& gens)
+	: Task(**gens[0]->mName + ".MnaPreStepBatch"), mGens(gens), mTimeStep(gens[0]->mTimeStep) {
+	Eigen::Index numGens = static_cast<Eigen::Index>(mGens.size());
+	mStates = std::make_shared<StateArray>(numGens, NumStates);
+	mMechTorquePrev.resize(numGens);
+	mVd.resize(numGens);
+	mVq.resize(numGens);
+	mId.resize(numGens);
+	mIq.resize(numGens);
+	mInvTwoH.resize(numGens);
+	mBaseOmMech.resize(numGens);
+
+	auto relocate = [this](const Attribute<Real>::Ptr& attr, Eigen::Index k, State state) {
+		std::dynamic_pointer_cast<AttributeStatic<Real>>(attr.getPtr())->relocateData(
+			std::shared_ptr<Real>(mStates, &(*mStates)(k, state)));
+	};
+	for (Eigen::Index k = 0; k < numGens; ++k) {
+		auto gen = mGens[k];
+		gen->mnaAddPreStepDependencies(mPrevStepDependencies, mAttributeDependencies, mModifiedAttributes);
+		relocate(gen->mOmMech, k, OmMech);
+		relocate(gen->mThetaMech, k, ThetaMech);
+		relocate(gen->mDelta, k, Delta);
+		relocate(gen->mElecTorque, k, ElecTorque);
+		mInvTwoH(k) = 1. / (2. * gen->mH);
+		mBaseOmMech(k) = gen->mBase_OmMech;
+	}
+}
+
+template <typename VarType>
+void Base::ReducedOrderSynchronGenerator<VarType>::MnaPreStepBatch::execute(Real time, Int timeStepCount) {
+	for (Eigen::Index k = 0; k < static_cast<Eigen::Index>(mGens.size()); ++k) {
+		auto gen = mGens[k];
+		gen->mSimTime = time;
+		gen->stepControllers();
+
+		const Matrix& voltage = **gen->torqueVoltage();
+		const Matrix& current = **gen->torqueCurrent();
+		mMechTorquePrev(k) = gen->mMechTorque_prev;
+		mVd(k) = voltage(0,0);
+		mVq(k) = voltage(1,0);
+		mId(k) = current(0,0);
+		mIq(k) = current(1,0);
+	}
+
+	// calculate mechanical variables of all machines at t=k+1 with forward euler
+	if (time>0.0) {
+		StateArray& states = *mStates;
+		states.col(ElecTorque) = mVd * mId + mVq * mIq;
+		states.col(OmMech) += mTimeStep * (mInvTwoH * (mMechTorquePrev - states.col(ElecTorque)));
+		states.col(ThetaMech) += mTimeStep * (states.col(OmMech) * mBaseOmMech);
+		states.col(Delta) += mTimeStep * (states.col(OmMech) - 1.) * mBaseOmMech;
+	}
+
+	for (auto gen : mGens) {
+		gen->stepInPerUnit();
+		(**gen->mRightVector).setZero();
+		gen->mnaApplyRightSideVectorStamp(**gen->mRightVector);
+	}
 }
 
 template <typename VarType>
@@ -506,6 +591,7 @@ void Base::ReducedOrderSynchronGenerator<VarType>::addExciter(Real Ta, Real Ka,
 {
 	mExciter = Signal::Exciter::make(**this->mName + "_Exciter", this->mLogLevel);
 	mExciter->setParameters(Ta, Ka, Te, Ke, Tf, Kf, Tr);
+	mExciter->doImplicitIntegration(mImplicitControllerIntegration);
 	mHasExciter = true;
 }
 
@@ -514,6 +600,7 @@ void Base::ReducedOrderSynchronGenerator<VarType>::addExciter(
 	std::shared_ptr<Signal::Exciter> exciter)
 {
 	mExciter = exciter;
+	mExciter->doImplicitIntegration(mImplicitControllerIntegration);
 	mHasExciter = true;
 }
 
@@ -524,6 +611,7 @@ void Base::ReducedOrderSynchronGenerator<VarType>::addGovernor(Real T3, Real T4,
 	mTurbineGovernor = Signal::TurbineGovernorType1::make(**this->mName + "_TurbineGovernor", this->mLogLevel);
 	mTurbineGovernor->setParameters(T3, T4, T5, Tc, Ts, R, Pmin, Pmax, OmRef);
 	mTurbineGovernor->initialize(TmRef);
+	mTurbineGovernor->doImplicitIntegration(mImplicitControllerIntegration);
 	mHasTurbineGovernor = true;
 }
 
@@ -532,9 +620,19 @@ void Base::ReducedOrderSynchronGenerator<VarType>::addGovernor(
 	std::shared_ptr<Signal::TurbineGovernorType1> turbineGovernor)
 {
 	mTurbineGovernor = turbineGovernor;
+	mTurbineGovernor->doImplicitIntegration(mImplicitControllerIntegration);
 	mHasTurbineGovernor = true;
 }
 
+template <typename VarType>
+void Base::ReducedOrderSynchronGenerator<VarType>::doImplicitControllerIntegration(Bool value) {
+	mImplicitControllerIntegration = value;
+	if (mHasExciter)
+		mExciter->doImplicitIntegration(value);
+	if (mHasTurbineGovernor)
+		mTurbineGovernor->doImplicitIntegration(value);
+}
+
 // Declare specializations to move definitions to .cpp
 template class CPS::Base::ReducedOrderSynchronGenerator<Real>;
 template class CPS::Base::ReducedOrderSynchronGenerator<Complex>;
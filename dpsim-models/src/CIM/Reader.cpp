@@ -9,7 +9,9 @@
 #include <CIMModel.hpp>
 #include <IEC61970.hpp>
 #include <CIMExceptions.hpp>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 
 #define READER_CPP
 #include <dpsim-models/CIM/Reader.h>
@@ -17,6 +19,37 @@
 using namespace CPS;
 using namespace CPS::CIM;
 using CIMPP::UnitMultiplier;
+using Equipment = TopologyCache::Equipment;
+using EquipmentType = TopologyCache::EquipmentType;
+
+namespace {
+	/// Stores the value of a CIM attribute unless it is not initialized
+	template <typename T>
+	void extractParam(Equipment& eq, const String& key, const T& value, Real scale = 1) {
+		try {
+			eq.params[key] = static_cast<Real>(value) * scale;
+		}
+		catch (ReadingUninitializedField* e) { }
+	}
+}
+
+struct Reader::ObjectTable {
+	std::vector<CIMPP::TopologicalNode*> topologicalNodes;
+	std::vector<CIMPP::SvVoltage*> svVoltages;
+	std::vector<CIMPP::SvPowerFlow*> svPowerFlows;
+	/// Supported equipment with the functions extracting its parameters
+	std::vector<std::pair<CIMPP::IdentifiedObject*, std::function<Bool(TopologyCache::Equipment&)>>> equipment;
+	/// Tap positions by tap changer
+	std::unordered_map<const CIMPP::TapChanger*, CIMPP::SvTapStep*> tapSteps;
+	/// Dynamic parameters by mRID of the synchronous machine
+	std::unordered_map<String, CIMPP::SynchronousMachineTimeConstantReactance*> machineDynamics;
+	/// Generating units by mRID of the synchronous machine
+	std::unordered_map<String, CIMPP::GeneratingUnit*> generatingUnits;
+	/// BaseVoltage objects by name of the equipment
+	std::unordered_map<String, CIMPP::BaseVoltage*> baseVoltages;
+	/// TopologicalNodes by name of the connected equipment
+	std::unordered_map<String, CIMPP::TopologicalNode*> equipmentNodes;
+};
 
 Reader::Reader(String name, Logger::Level logLevel, Logger::Level componentLogLevel) {
 	mSLog = Logger::get(name + "_CIM", logLevel);
@@ -54,6 +87,8 @@ void Reader::setShuntConductance(Real v) {
 /// If set, some components like loads include protection switches
 void Reader::useProtectionSwitches(Bool value) { mUseProtectionSwitches = value; }
 
+void Reader::setCacheDirectory(const fs::path &directory) { mCacheDirectory = directory; }
+
 Real Reader::unitValue(Real value, CIMPP::UnitMultiplier mult) {
 	switch (mult) {
 	case UnitMultiplier::p:
@@ -92,22 +127,6 @@ Real Reader::unitValue(Real value, CIMPP::UnitMultiplier mult) {
 	return value;
 }
 
-TopologicalPowerComp::Ptr Reader::mapComponent(BaseClass* obj) {
-	if (CIMPP::ACLineSegment *line = dynamic_cast<CIMPP::ACLineSegment*>(obj))
-		return mapACLineSegment(line);
-	if (CIMPP::EnergyConsumer *consumer = dynamic_cast<CIMPP::EnergyConsumer*>(obj))
-		return mapEnergyConsumer(consumer);
-	if (CIMPP::PowerTransformer *trans = dynamic_cast<CIMPP::PowerTransformer*>(obj))
-		return mapPowerTransformer(trans);
-	if (CIMPP::SynchronousMachine *syncMachine = dynamic_cast<CIMPP::SynchronousMachine*>(obj))
-		return mapSynchronousMachine(syncMachine);
-	if (CIMPP::ExternalNetworkInjection *extnet = dynamic_cast<CIMPP::ExternalNetworkInjection*>(obj))
-		return mapExternalNetworkInjection(extnet);
-	if (CIMPP::EquivalentShunt *shunt = dynamic_cast<CIMPP::EquivalentShunt*>(obj))
-		return mapEquivalentShunt(shunt);
-	return nullptr;
-}
-
 void Reader::addFiles(const fs::path &filename) {
 	if (!mModel->addCIMFile(filename.string()))
 		SPDLOG_LOGGER_ERROR(mSLog, "Failed to read file {}", filename);
@@ -118,57 +137,221 @@ void Reader::addFiles(const std::list<fs::path> &filenames) {
 		addFiles(filename);
 }
 
-void Reader::parseFiles() {
+void Reader::buildObjectTable() {
+	mObjects = std::make_unique<ObjectTable>();
+
+	for (auto obj : mModel->Objects) {
+		if (auto topNode = dynamic_cast<CIMPP::TopologicalNode*>(obj)) {
+			mObjects->topologicalNodes.push_back(topNode);
+			for (auto term : topNode->Terminal) {
+				if (term->ConductingEquipment)
+					mObjects->equipmentNodes[term->ConductingEquipment->name] = topNode;
+			}
+		}
+		else if (auto volt = dynamic_cast<CIMPP::SvVoltage*>(obj))
+			mObjects->svVoltages.push_back(volt);
+		else if (auto flow = dynamic_cast<CIMPP::SvPowerFlow*>(obj))
+			mObjects->svPowerFlows.push_back(flow);
+		else if (auto tapStep = dynamic_cast<CIMPP::SvTapStep*>(obj))
+			mObjects->tapSteps[tapStep->TapChanger] = tapStep;
+		else if (auto genDyn = dynamic_cast<CIMPP::SynchronousMachineTimeConstantReactance*>(obj)) {
+			if (genDyn->SynchronousMachine)
+				mObjects->machineDynamics.emplace(genDyn->SynchronousMachine->mRID, genDyn);
+		}
+		else if (auto genUnit = dynamic_cast<CIMPP::GeneratingUnit*>(obj)) {
+			for (auto syncGen : genUnit->RotatingMachine)
+				mObjects->generatingUnits.emplace(syncGen->mRID, genUnit);
+		}
+		else if (auto baseVolt = dynamic_cast<CIMPP::BaseVoltage*>(obj)) {
+			for (auto comp : baseVolt->ConductingEquipment)
+				mObjects->baseVoltages[comp->name] = baseVolt;
+		}
+		else if (auto line = dynamic_cast<CIMPP::ACLineSegment*>(obj))
+			mObjects->equipment.push_back({ line, [this, line](Equipment& eq) { return extractACLineSegment(line, eq); } });
+		else if (auto consumer = dynamic_cast<CIMPP::EnergyConsumer*>(obj))
+			mObjects->equipment.push_back({ consumer, [](Equipment& eq) { eq.type = EquipmentType::EnergyConsumer; return true; } });
+		else if (auto trans = dynamic_cast<CIMPP::PowerTransformer*>(obj))
+			mObjects->equipment.push_back({ trans, [this, trans](Equipment& eq) { return extractPowerTransformer(trans, eq); } });
+		else if (auto syncMachine = dynamic_cast<CIMPP::SynchronousMachine*>(obj))
+			mObjects->equipment.push_back({ syncMachine, [this, syncMachine](Equipment& eq) { return extractSynchronousMachine(syncMachine, eq); } });
+		else if (auto extnet = dynamic_cast<CIMPP::ExternalNetworkInjection*>(obj))
+			mObjects->equipment.push_back({ extnet, [this, extnet](Equipment& eq) { return extractExternalNetworkInjection(extnet, eq); } });
+		else if (auto shunt = dynamic_cast<CIMPP::EquivalentShunt*>(obj))
+			mObjects->equipment.push_back({ shunt, [this, shunt](Equipment& eq) { return extractEquivalentShunt(shunt, eq); } });
+	}
+}
+
+Bool Reader::parseFiles(TopologyCache &cache) {
 	try {
 		mModel->parseFiles();
 	}
 	catch (...) {
 		SPDLOG_LOGGER_ERROR(mSLog, "Failed to parse CIM files");
-		return;
+		return false;
 	}
 
-	SPDLOG_LOGGER_INFO(mSLog, "#### List of TopologicalNodes, associated Terminals and Equipment");
-	for (auto obj : mModel->Objects) {
-		if (CIMPP::TopologicalNode* topNode = dynamic_cast<CIMPP::TopologicalNode*>(obj)) {
-			if (mDomain == Domain::EMT)
-				processTopologicalNode<Real>(topNode);
-			else
-				processTopologicalNode<Complex>(topNode);
+	buildObjectTable();
+
+	// Nodes and terminals come first, because the transformer ends are
+	// distinguished by the sequence numbers of their terminals
+	std::unordered_map<String, std::size_t> nodeIndices;
+	std::unordered_map<String, std::pair<std::size_t, std::size_t>> terminalIndices;
+	for (auto topNode : mObjects->topologicalNodes) {
+		TopologyCache::Node node;
+		node.mRID = topNode->mRID;
+		node.name = topNode->name;
+		for (auto term : topNode->Terminal) {
+			if (!term->sequenceNumber.initialized)
+				term->sequenceNumber = 1;
+
+			TopologyCache::Terminal cacheTerm;
+			cacheTerm.mRID = term->mRID;
+			cacheTerm.sequenceNumber = term->sequenceNumber;
+			if (term->ConductingEquipment)
+				cacheTerm.equipment = term->ConductingEquipment->mRID;
+			terminalIndices[term->mRID] = std::make_pair(cache.nodes.size(), node.terminals.size());
+			node.terminals.push_back(cacheTerm);
 		}
+		nodeIndices[topNode->mRID] = cache.nodes.size();
+		cache.nodes.push_back(node);
+	}
+
+	for (auto& extract : mObjects->equipment) {
+		Equipment eq;
+		eq.mRID = extract.first->mRID;
+		eq.name = extract.first->name;
+		if (extract.second(eq))
+			cache.equipment.push_back(eq);
 	}
 
 	// Collect voltage state variables associated to nodes that are used
 	// for various components.
-	SPDLOG_LOGGER_INFO(mSLog, "#### List of Node voltages and Terminal power flow data");
-	for (auto obj : mModel->Objects) {
-		// Check if object is of class SvVoltage
-		if (CIMPP::SvVoltage* volt = dynamic_cast<CIMPP::SvVoltage*>(obj)) {
-			processSvVoltage(volt);
+	for (auto volt : mObjects->svVoltages) {
+		CIMPP::TopologicalNode* node = volt->TopologicalNode;
+		if (!node) {
+			SPDLOG_LOGGER_WARN(mSLog, "SvVoltage references missing Topological Node, ignoring");
+			continue;
+		}
+		auto search = nodeIndices.find(node->mRID);
+		if (search == nodeIndices.end()) {
+			SPDLOG_LOGGER_WARN(mSLog, "SvVoltage references Topological Node {}"
+				" missing from mTopNodes, ignoring", node->mRID);
+			continue;
 		}
-		// Check if object is of class SvPowerFlow
-		else if (CIMPP::SvPowerFlow* flow = dynamic_cast<CIMPP::SvPowerFlow*>(obj)) {
-			processSvPowerFlow(flow);
+
+		Real voltageAbs = Reader::unitValue(volt->v.value, UnitMultiplier::k);
+
+		try{
+			SPDLOG_LOGGER_INFO(mSLog, "    Angle={}", (float)volt->angle.value);
+		}catch(ReadingUninitializedField* e ){
+			volt->angle.value = 0;
+			std::cerr<< "Uninitialized Angle for SVVoltage at " << volt->TopologicalNode->name << ".Setting default value of " << volt->angle.value << std::endl;
 		}
+		Real voltagePhase = volt->angle.value * PI / 180;
+		cache.nodes[search->second].hasVoltage = true;
+		cache.nodes[search->second].voltage = std::polar<Real>(voltageAbs, voltagePhase);
 	}
 
-	SPDLOG_LOGGER_INFO(mSLog, "#### Create other components");
-	for (auto obj : mModel->Objects) {
+	for (auto flow : mObjects->svPowerFlows) {
+		CIMPP::Terminal* term = flow->Terminal;
+		auto search = term ? terminalIndices.find(term->mRID) : terminalIndices.end();
+		if (search == terminalIndices.end()) {
+			SPDLOG_LOGGER_WARN(mSLog, "SvPowerFlow references missing Terminal, ignoring");
+			continue;
+		}
 
-		// Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
-		if (!dynamic_cast<CIMPP::TopologicalNode*>(obj)
-			&& !dynamic_cast<CIMPP::SvVoltage*>(obj)
-			&& !dynamic_cast<CIMPP::SvPowerFlow*>(obj)) {
+		auto& cacheTerm = cache.nodes[search->second.first].terminals[search->second.second];
+		cacheTerm.hasPower = true;
+		cacheTerm.power = Complex(Reader::unitValue(flow->p.value, UnitMultiplier::M),
+			Reader::unitValue(flow->q.value, UnitMultiplier::M));
+	}
 
-			if (CIMPP::IdentifiedObject* idObj = dynamic_cast<CIMPP::IdentifiedObject*>(obj)) {
+	return true;
+}
 
-				// Check if object is already in equipment list
-				if (mPowerflowEquipment.find(idObj->mRID) == mPowerflowEquipment.end()) {
-					TopologicalPowerComp::Ptr comp = mapComponent(obj);
-					if (comp)
-						mPowerflowEquipment.insert(std::make_pair(comp->uid(), comp));
-				}
+TopologyCache Reader::readTopologyData(const std::list<fs::path> &filenames) {
+	TopologyCache cache;
+	if (mCacheDirectory.empty()) {
+		addFiles(filenames);
+		parseFiles(cache);
+		return cache;
+	}
+
+	uint64_t hash = TopologyCache::contentHash(filenames);
+	fs::path cacheFile = TopologyCache::filename(mCacheDirectory, hash);
+	if (fs::exists(cacheFile)) {
+		try {
+			cache = TopologyCache::load(cacheFile);
+			if (cache.hash == hash) {
+				SPDLOG_LOGGER_INFO(mSLog, "Loaded CIM data from cache {}", cacheFile.string());
+				return cache;
 			}
 		}
+		catch (SystemError &e) {
+			SPDLOG_LOGGER_WARN(mSLog, "Ignoring CIM cache {}: {}", cacheFile.string(), e.descr());
+		}
+		cache = TopologyCache();
+	}
+
+	addFiles(filenames);
+	if (!parseFiles(cache))
+		return cache;
+
+	cache.hash = hash;
+	try {
+		fs::create_directories(mCacheDirectory);
+		cache.save(cacheFile);
+		SPDLOG_LOGGER_INFO(mSLog, "Stored CIM data in cache {}", cacheFile.string());
+	}
+	catch (SystemError &e) {
+		SPDLOG_LOGGER_WARN(mSLog, "Failed to store CIM cache: {}", e.descr());
+	}
+	return cache;
+}
+
+void Reader::buildTopology(const TopologyCache &cache) {
+	// The components are created from the extracted data only, so that
+	// they can be created independently before they are connected to the nodes
+	SPDLOG_LOGGER_INFO(mSLog, "#### Create components");
+	std::vector<TopologicalPowerComp::Ptr> comps(cache.equipment.size());
+	std::exception_ptr error;
+	#pragma omp parallel for schedule(dynamic)
+	for (Int i = 0; i < static_cast<Int>(comps.size()); ++i) {
+		try {
+			comps[i] = mapEquipment(cache.equipment[i]);
+		}
+		catch (...) {
+			#pragma omp critical
+			if (!error)
+				error = std::current_exception();
+		}
+	}
+	if (error)
+		std::rethrow_exception(error);
+
+	for (auto comp : comps) {
+		if (comp)
+			mPowerflowEquipment.insert(std::make_pair(comp->uid(), comp));
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "#### List of TopologicalNodes, associated Terminals and Equipment");
+	for (auto& node : cache.nodes) {
+		if (mDomain == Domain::EMT)
+			processTopologicalNode<Real>(node);
+		else
+			processTopologicalNode<Complex>(node);
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "#### List of Node voltages and Terminal power flow data");
+	for (auto& node : cache.nodes) {
+		if (node.hasVoltage)
+			processSvVoltage(node);
+	}
+	for (auto& node : cache.nodes) {
+		for (auto& term : node.terminals) {
+			if (term.hasPower)
+				processSvPowerFlow(term);
+		}
 	}
 
 	SPDLOG_LOGGER_INFO(mSLog, "#### Check topology for unconnected components");
@@ -191,14 +374,7 @@ void Reader::parseFiles() {
 }
 
 SystemTopology Reader::loadCIM(Real systemFrequency, const fs::path &filename, Domain domain, PhaseType phase, GeneratorType genType) {
-	mFrequency = systemFrequency;
-	mOmega = 2 * PI*mFrequency;
-	mDomain = domain;
-	mPhase = phase;
-	mGeneratorType = genType;
-	addFiles(filename);
-	parseFiles();
-	return systemTopology();
+	return loadCIM(systemFrequency, std::list<fs::path>{ filename }, domain, phase, genType);
 }
 
 SystemTopology Reader::loadCIM(Real systemFrequency, const std::list<fs::path> &filenames, Domain domain, PhaseType phase, GeneratorType genType) {
@@ -207,54 +383,108 @@ SystemTopology Reader::loadCIM(Real systemFrequency, const std::list<fs::path> &
 	mDomain = domain;
 	mPhase = phase;
 	mGeneratorType = genType;
-	addFiles(filenames);
-	parseFiles();
+	buildTopology(readTopologyData(filenames));
 	return systemTopology();
 }
 
-void Reader::processSvVoltage(CIMPP::SvVoltage* volt) {
-	CIMPP::TopologicalNode* node = volt->TopologicalNode;
-	if (!node) {
-		SPDLOG_LOGGER_WARN(mSLog, "SvVoltage references missing Topological Node, ignoring");
-		return;
+TopologicalPowerComp::List Reader::updateCIM(const std::list<CPS::String> &filenamesString) {
+	std::list<fs::path> filenames;
+	for (auto f : filenamesString)
+		filenames.emplace_back(f);
+
+	return updateCIM(filenames);
+}
+
+TopologicalPowerComp::List Reader::updateCIM(const std::list<fs::path> &filenames) {
+	CIMModel model;
+	model.setDependencyCheckOff();
+	for (auto filename : filenames) {
+		if (!model.addCIMFile(filename.string()))
+			SPDLOG_LOGGER_ERROR(mSLog, "Failed to read file {}", filename.string());
 	}
-	auto search = mPowerflowNodes.find(node->mRID);
-	if (search == mPowerflowNodes.end()) {
-		SPDLOG_LOGGER_WARN(mSLog, "SvVoltage references Topological Node {}"
-			" missing from mTopNodes, ignoring", node->mRID);
-		return;
+	try {
+		model.parseFiles();
 	}
+	catch (...) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Failed to parse CIM files");
+		return {};
+	}
+
+	std::map<String, TopologicalPowerComp::Ptr> terminalEquipment;
+	for (auto pfe : mPowerflowEquipment) {
+		for (auto term : pfe.second->topologicalTerminals())
+			terminalEquipment[term->uid()] = pfe.second;
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "#### Update of Node voltages and Terminal power flow data");
+	std::map<String, TopologicalPowerComp::Ptr> changed;
+	for (auto obj : model.Objects) {
+		if (auto volt = dynamic_cast<CIMPP::SvVoltage*>(obj)) {
+			auto search = volt->TopologicalNode ? mPowerflowNodes.find(volt->TopologicalNode->mRID) : mPowerflowNodes.end();
+			if (search == mPowerflowNodes.end()) {
+				SPDLOG_LOGGER_WARN(mSLog, "SvVoltage references unknown Topological Node, ignoring");
+				continue;
+			}
+
+			Real voltagePhase = 0;
+			try {
+				voltagePhase = volt->angle.value * PI / 180;
+			} catch (ReadingUninitializedField* e) { }
+			search->second->setInitialVoltage(std::polar<Real>(Reader::unitValue(volt->v.value, UnitMultiplier::k), voltagePhase));
 
-	Real voltageAbs = Reader::unitValue(volt->v.value, UnitMultiplier::k);
+			SPDLOG_LOGGER_INFO(mSLog, "Node {}: {} V, {} deg", search->second->uid(),
+				std::abs(search->second->initialSingleVoltage()),
+				std::arg(search->second->initialSingleVoltage())*180/PI);
+		}
+		else if (auto flow = dynamic_cast<CIMPP::SvPowerFlow*>(obj)) {
+			auto search = flow->Terminal ? mPowerflowTerminals.find(flow->Terminal->mRID) : mPowerflowTerminals.end();
+			if (search == mPowerflowTerminals.end()) {
+				SPDLOG_LOGGER_WARN(mSLog, "SvPowerFlow references unknown Terminal, ignoring");
+				continue;
+			}
 
-	try{
-		SPDLOG_LOGGER_INFO(mSLog, "    Angle={}", (float)volt->angle.value);
-	}catch(ReadingUninitializedField* e ){
-		volt->angle.value = 0;
-		std::cerr<< "Uninitialized Angle for SVVoltage at " << volt->TopologicalNode->name << ".Setting default value of " << volt->angle.value << std::endl;
+			Complex power(Reader::unitValue(flow->p.value, UnitMultiplier::M),
+				Reader::unitValue(flow->q.value, UnitMultiplier::M));
+			search->second->setPower(power);
+			SPDLOG_LOGGER_INFO(mSLog, "Terminal {}: {} W + j {} Var", search->first, power.real(), power.imag());
+
+			auto comp = terminalEquipment.find(search->first);
+			if (comp == terminalEquipment.end())
+				continue;
+			// Loads only take the terminal power when their parameters are not set yet
+			if (auto load = std::dynamic_pointer_cast<SP::Ph1::Load>(comp->second)) {
+				**load->mActivePower = power.real();
+				**load->mReactivePower = power.imag();
+			}
+			changed[comp->second->uid()] = comp->second;
+		}
 	}
-	Real voltagePhase = volt->angle.value * PI / 180;
-	mPowerflowNodes[node->mRID]->setInitialVoltage(std::polar<Real>(voltageAbs, voltagePhase));
+
+	TopologicalPowerComp::List comps;
+	for (auto comp : changed)
+		comps.push_back(comp.second);
+	return comps;
+}
+
+void Reader::processSvVoltage(const TopologyCache::Node &node) {
+	auto pfNode = mPowerflowNodes[node.mRID];
+	pfNode->setInitialVoltage(node.voltage);
 
 	SPDLOG_LOGGER_INFO(mSLog, "Node {} MatrixNodeIndex {}: {} V, {} deg",
-		mPowerflowNodes[node->mRID]->uid(),
-		mPowerflowNodes[node->mRID]->matrixNodeIndex(),
-		std::abs(mPowerflowNodes[node->mRID]->initialSingleVoltage()),
-		std::arg(mPowerflowNodes[node->mRID]->initialSingleVoltage())*180/PI
+		pfNode->uid(),
+		pfNode->matrixNodeIndex(),
+		std::abs(pfNode->initialSingleVoltage()),
+		std::arg(pfNode->initialSingleVoltage())*180/PI
 	);
 }
 
-void Reader::processSvPowerFlow(CIMPP::SvPowerFlow* flow) {
-	CIMPP::Terminal* term = flow->Terminal;
-
-	mPowerflowTerminals[term->mRID]->setPower(
-		Complex(Reader::unitValue(flow->p.value, UnitMultiplier::M),
-		Reader::unitValue(flow->q.value, UnitMultiplier::M)));
+void Reader::processSvPowerFlow(const TopologyCache::Terminal &term) {
+	mPowerflowTerminals[term.mRID]->setPower(term.power);
 
 	SPDLOG_LOGGER_WARN(mSLog, "Terminal {}: {} W + j {} Var",
-		term->mRID,
-		mPowerflowTerminals[term->mRID]->singleActivePower(),
-		mPowerflowTerminals[term->mRID]->singleReactivePower());
+		term.mRID,
+		mPowerflowTerminals[term.mRID]->singleActivePower(),
+		mPowerflowTerminals[term.mRID]->singleReactivePower());
 }
 
 SystemTopology Reader::systemTopology() {
@@ -298,20 +528,38 @@ Matrix::Index Reader::mapTopologicalNode(String mrid) {
 	return search->second->matrixNodeIndex();
 }
 
-TopologicalPowerComp::Ptr Reader::mapEnergyConsumer(CIMPP::EnergyConsumer* consumer) {
-	SPDLOG_LOGGER_INFO(mSLog, "    Found EnergyConsumer {}", consumer->name);
+TopologicalPowerComp::Ptr Reader::mapEquipment(const Equipment& eq) {
+	switch (eq.type) {
+	case EquipmentType::ACLineSegment:
+		return mapACLineSegment(eq);
+	case EquipmentType::EnergyConsumer:
+		return mapEnergyConsumer(eq);
+	case EquipmentType::PowerTransformer:
+		return mapPowerTransformer(eq);
+	case EquipmentType::SynchronousMachine:
+		return mapSynchronousMachine(eq);
+	case EquipmentType::ExternalNetworkInjection:
+		return mapExternalNetworkInjection(eq);
+	case EquipmentType::EquivalentShunt:
+		return mapEquivalentShunt(eq);
+	}
+	return nullptr;
+}
+
+TopologicalPowerComp::Ptr Reader::mapEnergyConsumer(const Equipment& consumer) {
+	SPDLOG_LOGGER_INFO(mSLog, "    Found EnergyConsumer {}", consumer.name);
 	if (mDomain == Domain::EMT) {
 		if (mPhase == PhaseType::ABC) {
-			return std::make_shared<EMT::Ph3::RXLoad>(consumer->mRID, consumer->name, mComponentLogLevel);
+			return std::make_shared<EMT::Ph3::RXLoad>(consumer.mRID, consumer.name, mComponentLogLevel);
 		}
 		else
 		{
 		SPDLOG_LOGGER_INFO(mSLog, "    RXLoad for EMT not implemented yet");
-		return std::make_shared<DP::Ph1::RXLoad>(consumer->mRID, consumer->name, mComponentLogLevel);
+		return std::make_shared<DP::Ph1::RXLoad>(consumer.mRID, consumer.name, mComponentLogLevel);
 		}
 	}
 	else if (mDomain == Domain::SP) {
-		auto load = std::make_shared<SP::Ph1::Load>(consumer->mRID, consumer->name, mComponentLogLevel);
+		auto load = std::make_shared<SP::Ph1::Load>(consumer.mRID, consumer.name, mComponentLogLevel);
 
 		// TODO: Use EnergyConsumer.P and EnergyConsumer.Q if available, overwrite if existent SvPowerFlow data
 		/*
@@ -332,34 +580,44 @@ TopologicalPowerComp::Ptr Reader::mapEnergyConsumer(CIMPP::EnergyConsumer* consu
 	}
 	else {
 		if (mUseProtectionSwitches)
-			return std::make_shared<DP::Ph1::RXLoadSwitch>(consumer->mRID, consumer->name, mComponentLogLevel);
+			return std::make_shared<DP::Ph1::RXLoadSwitch>(consumer.mRID, consumer.name, mComponentLogLevel);
 		else
-			return std::make_shared<DP::Ph1::RXLoad>(consumer->mRID, consumer->name, mComponentLogLevel);
+			return std::make_shared<DP::Ph1::RXLoad>(consumer.mRID, consumer.name, mComponentLogLevel);
 	}
 }
 
-TopologicalPowerComp::Ptr Reader::mapACLineSegment(CIMPP::ACLineSegment* line) {
-	SPDLOG_LOGGER_INFO(mSLog, "    Found ACLineSegment {} r={} x={} bch={} gch={}", line->name,
-		(float) line->r.value,
-		(float) line->x.value,
-		(float) line->bch.value,
-		(float) line->gch.value);
+Bool Reader::extractACLineSegment(CIMPP::ACLineSegment* line, Equipment& eq) {
+	eq.type = EquipmentType::ACLineSegment;
+	extractParam(eq, "r", line->r.value);
+	extractParam(eq, "x", line->x.value);
+	extractParam(eq, "bch", line->bch.value);
+	extractParam(eq, "gch", line->gch.value);
+	eq.params["baseVoltage"] = determineBaseVoltageAssociatedWithEquipment(line);
+	return true;
+}
 
-	Real resistance = line->r.value;
-	Real inductance = line->x.value / mOmega;
+TopologicalPowerComp::Ptr Reader::mapACLineSegment(const Equipment& line) {
+	SPDLOG_LOGGER_INFO(mSLog, "    Found ACLineSegment {} r={} x={} bch={} gch={}", line.name,
+		line.param("r"),
+		line.param("x"),
+		line.param("bch", 0),
+		line.param("gch", 0));
+
+	Real resistance = line.param("r");
+	Real inductance = line.param("x") / mOmega;
 
 	// By default there is always a small conductance to ground to
 	// avoid problems with floating nodes.
 	Real capacitance = mShuntCapacitorValue;
 	Real conductance = mShuntConductanceValue;
 
-	if(line->bch.value > 1e-9 && !mSetShuntCapacitor)
-		capacitance = Real(line->bch.value / mOmega);
+	if(line.param("bch", 0) > 1e-9 && !mSetShuntCapacitor)
+		capacitance = Real(line.param("bch") / mOmega);
 
-	if(line->gch.value > 1e-9 && !mSetShuntConductance)
-		conductance = Real(line->gch.value);
+	if(line.param("gch", 0) > 1e-9 && !mSetShuntConductance)
+		conductance = Real(line.param("gch"));
 
-	Real baseVoltage = determineBaseVoltageAssociatedWithEquipment(line);
+	Real baseVoltage = line.param("baseVoltage");
 
 	if (mDomain == Domain::EMT) {
 		if (mPhase == PhaseType::ABC) {
@@ -368,85 +626,52 @@ TopologicalPowerComp::Ptr Reader::mapACLineSegment(CIMPP::ACLineSegment* line) {
 			Matrix cap_3ph = CPS::Math::singlePhaseParameterToThreePhase(capacitance);
 			Matrix cond_3ph = CPS::Math::singlePhaseParameterToThreePhase(conductance);
 
-			auto cpsLine = std::make_shared<EMT::Ph3::PiLine>(line->mRID, line->name, mComponentLogLevel);
+			auto cpsLine = std::make_shared<EMT::Ph3::PiLine>(line.mRID, line.name, mComponentLogLevel);
 			cpsLine->setParameters(res_3ph, ind_3ph, cap_3ph, cond_3ph);
 			return cpsLine;
 		}
 		else {
 			SPDLOG_LOGGER_INFO(mSLog, "    PiLine for EMT not implemented yet");
-			auto cpsLine = std::make_shared<DP::Ph1::PiLine>(line->mRID, line->name, mComponentLogLevel);
+			auto cpsLine = std::make_shared<DP::Ph1::PiLine>(line.mRID, line.name, mComponentLogLevel);
 			cpsLine->setParameters(resistance, inductance, capacitance, conductance);
 			return cpsLine;
 		}
 	}
 	else if (mDomain == Domain::SP) {
-		auto cpsLine = std::make_shared<SP::Ph1::PiLine>(line->mRID, line->name, mComponentLogLevel);
+		auto cpsLine = std::make_shared<SP::Ph1::PiLine>(line.mRID, line.name, mComponentLogLevel);
 		cpsLine->setParameters(resistance, inductance, capacitance, conductance);
 		cpsLine->setBaseVoltage(baseVoltage);
 		return cpsLine;
 	}
 	else {
-		auto cpsLine = std::make_shared<DP::Ph1::PiLine>(line->mRID, line->name, mComponentLogLevel);
+		auto cpsLine = std::make_shared<DP::Ph1::PiLine>(line.mRID, line.name, mComponentLogLevel);
 		cpsLine->setParameters(resistance, inductance, capacitance, conductance);
 		return cpsLine;
 	}
 
 }
 
-TopologicalPowerComp::Ptr Reader::mapPowerTransformer(CIMPP::PowerTransformer* trans) {
+Bool Reader::extractPowerTransformer(CIMPP::PowerTransformer* trans, Equipment& eq) {
 	if (trans->PowerTransformerEnd.size() != 2) {
 		SPDLOG_LOGGER_WARN(mSLog, "PowerTransformer {} does not have exactly two windings, ignoring", trans->name);
-		return nullptr;
+		return false;
 	}
-	SPDLOG_LOGGER_INFO(mSLog, "Found PowerTransformer {}", trans->name);
 
 	// assign transformer ends
 	CIMPP::PowerTransformerEnd* end1 = nullptr, *end2 = nullptr;
 	for (auto end : trans->PowerTransformerEnd) {
 		if (end->Terminal->sequenceNumber == 1) end1 = end;
 		else if (end->Terminal->sequenceNumber == 2) end2 = end;
-		else return nullptr;
-	}
-
-	// setting default values for non-set resistances and reactances
-	SPDLOG_LOGGER_INFO(mSLog, "    PowerTransformerEnd_1 {}", end1->name);
-    SPDLOG_LOGGER_INFO(mSLog, "    Srated={} Vrated={}", (float) end1->ratedS.value, (float) end1->ratedU.value);
-	try{
-		SPDLOG_LOGGER_INFO(mSLog, "       R={}", (float) end1->r.value);
-	}catch(ReadingUninitializedField* e1){
-		end1->r.value = 1e-12;
-        SPDLOG_LOGGER_WARN(mSLog, "       Uninitialized value for PowerTrafoEnd1 setting default value of R={}", (float) end1->r.value);
-	}
-	try{
-		SPDLOG_LOGGER_INFO(mSLog, "       X={}", (float) end1->x.value);
-	}catch(ReadingUninitializedField* e1){
-		end1->x.value = 1e-12;
-        SPDLOG_LOGGER_WARN(mSLog, "       Uninitialized value for PowerTrafoEnd1 setting default value of X={}", (float) end1->x.value);
-	}
-    SPDLOG_LOGGER_INFO(mSLog, "    PowerTransformerEnd_2 {}", end2->name);
-    SPDLOG_LOGGER_INFO(mSLog, "    Srated={} Vrated={}", (float) end2->ratedS.value, (float) end2->ratedU.value);
-	try{
-		SPDLOG_LOGGER_INFO(mSLog, "       R={}", (float) end2->r.value);
-	}catch(ReadingUninitializedField* e1){
-		end2->r.value = 1e-12;
-        SPDLOG_LOGGER_WARN(mSLog, "       Uninitialized value for PowerTrafoEnd2 setting default value of R={}", (float) end2->r.value);
-	}
-	try{
-		SPDLOG_LOGGER_INFO(mSLog, "       X={}", (float) end2->x.value);
-	}catch(ReadingUninitializedField* e1){
-		end2->x.value = 1e-12;
-        SPDLOG_LOGGER_WARN(mSLog, "       Uninitialized value for PowerTrafoEnd2 setting default value of X={}", (float) end2->x.value);
+		else return false;
 	}
 
+	eq.type = EquipmentType::PowerTransformer;
 	if (end1->ratedS.value != end2->ratedS.value) {
 		SPDLOG_LOGGER_WARN(mSLog, "    PowerTransformerEnds of {} come with distinct rated power values. Using rated power of PowerTransformerEnd_1.", trans->name);
 	}
-	Real ratedPower = unitValue(end1->ratedS.value, UnitMultiplier::M);
 	Real voltageNode1 = unitValue(end1->ratedU.value, UnitMultiplier::k);
 	Real voltageNode2 = unitValue(end2->ratedU.value, UnitMultiplier::k);
-
-    Real ratioAbsNominal = voltageNode1 / voltageNode2;
-	Real ratioAbs = ratioAbsNominal;
+	Real ratioAbs = voltageNode1 / voltageNode2;
 
 	// use normalStep from RatioTapChanger
 	if (end1->RatioTapChanger) {
@@ -455,34 +680,66 @@ TopologicalPowerComp::Ptr Reader::mapPowerTransformer(CIMPP::PowerTransformer* t
 
 	// if corresponding SvTapStep available, use instead tap position from there
 	if (end1->RatioTapChanger) {
-		for (auto obj : mModel->Objects) {
-			auto tapStep = dynamic_cast<CIMPP::SvTapStep*>(obj);
-			if (tapStep && tapStep->TapChanger == end1->RatioTapChanger) {
-				ratioAbs = voltageNode1 / voltageNode2 * (1 + (tapStep->position - end1->RatioTapChanger->neutralStep) * end1->RatioTapChanger->stepVoltageIncrement.value / 100);
-			}
+		auto search = mObjects->tapSteps.find(end1->RatioTapChanger);
+		if (search != mObjects->tapSteps.end()) {
+			CIMPP::SvTapStep* tapStep = search->second;
+			ratioAbs = voltageNode1 / voltageNode2 * (1 + (tapStep->position - end1->RatioTapChanger->neutralStep) * end1->RatioTapChanger->stepVoltageIncrement.value / 100);
 		}
 	}
 
+	eq.params["ratedPower"] = unitValue(end1->ratedS.value, UnitMultiplier::M);
+	eq.params["ratedVoltage1"] = voltageNode1;
+	eq.params["ratedVoltage2"] = voltageNode2;
+	eq.params["ratio"] = ratioAbs;
+	extractParam(eq, "r1", end1->r.value);
+	extractParam(eq, "x1", end1->x.value);
+	extractParam(eq, "r2", end2->r.value);
+	extractParam(eq, "x2", end2->x.value);
+	return true;
+}
+
+TopologicalPowerComp::Ptr Reader::mapPowerTransformer(const Equipment& trans) {
+	SPDLOG_LOGGER_INFO(mSLog, "Found PowerTransformer {}", trans.name);
+
+	// setting default values for non-set resistances and reactances
+	for (auto key : { "r1", "x1", "r2", "x2" }) {
+		if (!trans.has(key))
+			SPDLOG_LOGGER_WARN(mSLog, "       Uninitialized value {} of PowerTransformer setting default value of 1e-12", key);
+	}
+	Real r1 = trans.param("r1", 1e-12);
+	Real x1 = trans.param("x1", 1e-12);
+	Real r2 = trans.param("r2", 1e-12);
+	Real x2 = trans.param("x2", 1e-12);
+
+	Real ratedPower = trans.param("ratedPower");
+	Real voltageNode1 = trans.param("ratedVoltage1");
+	Real voltageNode2 = trans.param("ratedVoltage2");
+	SPDLOG_LOGGER_INFO(mSLog, "    Srated={} Vrated1={} Vrated2={}", ratedPower, voltageNode1, voltageNode2);
+	SPDLOG_LOGGER_INFO(mSLog, "    R1={} X1={} R2={} X2={}", r1, x1, r2, x2);
+
+    Real ratioAbsNominal = voltageNode1 / voltageNode2;
+	Real ratioAbs = trans.param("ratio");
+
 	// TODO: To be extracted from cim class
 	Real ratioPhase = 0;
 
     // Calculate resistance and inductance referred to higher voltage side
 	Real resistance = 0;
     Real inductance = 0;
-	if (voltageNode1 >= voltageNode2 && abs(end1->x.value) > 1e-12) {
-		inductance = end1->x.value / mOmega;
-		resistance = end1->r.value;
-	} else if (voltageNode1 >= voltageNode2 && abs(end2->x.value) > 1e-12) {
-		inductance = end2->x.value / mOmega * std::pow(ratioAbsNominal, 2);
-		resistance = end2->r.value * std::pow(ratioAbsNominal, 2);
+	if (voltageNode1 >= voltageNode2 && abs(x1) > 1e-12) {
+		inductance = x1 / mOmega;
+		resistance = r1;
+	} else if (voltageNode1 >= voltageNode2 && abs(x2) > 1e-12) {
+		inductance = x2 / mOmega * std::pow(ratioAbsNominal, 2);
+		resistance = r2 * std::pow(ratioAbsNominal, 2);
 	}
-	else if (voltageNode2 > voltageNode1 && abs(end2->x.value) > 1e-12) {
-		inductance = end2->x.value / mOmega;
-		resistance = end2->r.value;
+	else if (voltageNode2 > voltageNode1 && abs(x2) > 1e-12) {
+		inductance = x2 / mOmega;
+		resistance = r2;
 	}
-	else if (voltageNode2 > voltageNode1 && abs(end1->x.value) > 1e-12) {
-		inductance = end1->x.value / mOmega / std::pow(ratioAbsNominal, 2);
-		resistance = end1->r.value / std::pow(ratioAbsNominal, 2);
+	else if (voltageNode2 > voltageNode1 && abs(x1) > 1e-12) {
+		inductance = x1 / mOmega / std::pow(ratioAbsNominal, 2);
+		resistance = r1 / std::pow(ratioAbsNominal, 2);
 	}
 
 	if (mDomain == Domain::EMT) {
@@ -490,7 +747,7 @@ TopologicalPowerComp::Ptr Reader::mapPowerTransformer(CIMPP::PowerTransformer* t
 			Matrix resistance_3ph = CPS::Math::singlePhaseParameterToThreePhase(resistance);
 			Matrix inductance_3ph = CPS::Math::singlePhaseParameterToThreePhase(inductance);
 			Bool withResistiveLosses = resistance > 0;
-			auto transformer = std::make_shared<EMT::Ph3::Transformer>(trans->mRID, trans->name, mComponentLogLevel, withResistiveLosses);
+			auto transformer = std::make_shared<EMT::Ph3::Transformer>(trans.mRID, trans.name, mComponentLogLevel, withResistiveLosses);
 			transformer->setParameters(voltageNode1, voltageNode2, ratedPower, ratioAbs, ratioPhase, resistance_3ph, inductance_3ph);
 			return transformer;
 		}
@@ -501,7 +758,7 @@ TopologicalPowerComp::Ptr Reader::mapPowerTransformer(CIMPP::PowerTransformer* t
 		}
 	}
 	else if (mDomain == Domain::SP) {
-		auto transformer = std::make_shared<SP::Ph1::Transformer>(trans->mRID, trans->name, mComponentLogLevel);
+		auto transformer = std::make_shared<SP::Ph1::Transformer>(trans.mRID, trans.name, mComponentLogLevel);
 		transformer->setParameters(voltageNode1, voltageNode2, ratedPower, ratioAbs, ratioPhase, resistance, inductance);
 		Real baseVolt = voltageNode1 >= voltageNode2 ? voltageNode1 : voltageNode2;
 		transformer->setBaseVoltage(baseVolt);
@@ -509,14 +766,75 @@ TopologicalPowerComp::Ptr Reader::mapPowerTransformer(CIMPP::PowerTransformer* t
 	}
 	else {
 		Bool withResistiveLosses = resistance > 0;
-		auto transformer = std::make_shared<DP::Ph1::Transformer>(trans->mRID, trans->name, mComponentLogLevel, withResistiveLosses);
+		auto transformer = std::make_shared<DP::Ph1::Transformer>(trans.mRID, trans.name, mComponentLogLevel, withResistiveLosses);
 		transformer->setParameters(voltageNode1, voltageNode2, ratedPower, ratioAbs, ratioPhase, resistance, inductance);
 		return transformer;
 	}
 }
 
-TopologicalPowerComp::Ptr Reader::mapSynchronousMachine(CIMPP::SynchronousMachine* machine) {
-	SPDLOG_LOGGER_INFO(mSLog, "    Found  Synchronous machine {}", machine->name);
+Bool Reader::extractSynchronousMachine(CIMPP::SynchronousMachine* machine, Equipment& eq) {
+	eq.type = EquipmentType::SynchronousMachine;
+	extractParam(eq, "ratedPower", machine->ratedS.value, unitValue(1, UnitMultiplier::M));
+	extractParam(eq, "ratedVoltage", machine->ratedU.value, unitValue(1, UnitMultiplier::k));
+
+	auto genDynSearch = mObjects->machineDynamics.find(machine->mRID);
+	if (genDynSearch != mObjects->machineDynamics.end()) {
+		CIMPP::SynchronousMachineTimeConstantReactance* genDyn = genDynSearch->second;
+		eq.params["dynamics"] = 1;
+		// stator
+		extractParam(eq, "Rs", genDyn->statorResistance.value);
+		extractParam(eq, "Ll", genDyn->statorLeakageReactance.value);
+		// reactances
+		extractParam(eq, "Ld", genDyn->xDirectSync.value);
+		extractParam(eq, "Lq", genDyn->xQuadSync.value);
+		extractParam(eq, "Ld_t", genDyn->xDirectTrans.value);
+		extractParam(eq, "Lq_t", genDyn->xQuadTrans.value);
+		extractParam(eq, "Ld_s", genDyn->xDirectSubtrans.value);
+		extractParam(eq, "Lq_s", genDyn->xQuadSubtrans.value);
+		// time constants
+		extractParam(eq, "Td0_t", genDyn->tpdo.value);
+		extractParam(eq, "Tq0_t", genDyn->tpqo.value);
+		extractParam(eq, "Td0_s", genDyn->tppdo.value);
+		extractParam(eq, "Tq0_s", genDyn->tppqo.value);
+		// inertia
+		extractParam(eq, "H", genDyn->inertia.value);
+	}
+
+	auto genUnitSearch = mObjects->generatingUnits.find(machine->mRID);
+	if (genUnitSearch != mObjects->generatingUnits.end()) {
+		CIMPP::GeneratingUnit* genUnit = genUnitSearch->second;
+		// Check whether relevant input data are set, otherwise set default values
+		Real setPointActivePower = 0;
+		Real setPointVoltage = 0;
+		Real maximumReactivePower = 1e12;
+		try{
+			setPointActivePower = unitValue(genUnit->initialP.value, UnitMultiplier::M);
+			SPDLOG_LOGGER_INFO(mSLog, "    setPointActivePower={}", setPointActivePower);
+		}catch(ReadingUninitializedField* e){
+			std::cerr << "Uninitalized setPointActivePower for GeneratingUnit " << machine->name << ". Using default value of " << setPointActivePower << std::endl;
+		}
+		if (machine->RegulatingControl) {
+			setPointVoltage = unitValue(machine->RegulatingControl->targetValue.value, UnitMultiplier::k);
+			SPDLOG_LOGGER_INFO(mSLog, "    setPointVoltage={}", setPointVoltage);
+		} else {
+			std::cerr << "Uninitalized setPointVoltage for GeneratingUnit " <<  machine->name << ". Using default value of " << setPointVoltage << std::endl;
+		}
+		try{
+			maximumReactivePower = unitValue(machine->maxQ.value, UnitMultiplier::M);
+			SPDLOG_LOGGER_INFO(mSLog, "    maximumReactivePower={}", maximumReactivePower);
+		}catch(ReadingUninitializedField* e){
+			std::cerr << "Uninitalized maximumReactivePower for GeneratingUnit " <<  machine->name << ". Using default value of " << maximumReactivePower << std::endl;
+		}
+
+		eq.params["setPointActivePower"] = setPointActivePower;
+		eq.params["setPointVoltage"] = setPointVoltage;
+		eq.params["maximumReactivePower"] = maximumReactivePower;
+	}
+	return true;
+}
+
+TopologicalPowerComp::Ptr Reader::mapSynchronousMachine(const Equipment& machine) {
+	SPDLOG_LOGGER_INFO(mSLog, "    Found  Synchronous machine {}", machine.name);
 
 	if (mDomain == Domain::DP) {
 		SPDLOG_LOGGER_INFO(mSLog, "    Create generator in DP domain.");
@@ -526,81 +844,75 @@ TopologicalPowerComp::Ptr Reader::mapSynchronousMachine(CIMPP::SynchronousMachin
 			|| mGeneratorType == GeneratorType::SG4OrderVBR
 			|| mGeneratorType == GeneratorType::SG3OrderVBR) {
 
-			Real ratedPower = unitValue(machine->ratedS.value, UnitMultiplier::M);
-			Real ratedVoltage = unitValue(machine->ratedU.value, UnitMultiplier::k);
-
-			for (auto obj : mModel->Objects) {
-				// Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
-				if (CIMPP::SynchronousMachineTimeConstantReactance* genDyn =
-					dynamic_cast<CIMPP::SynchronousMachineTimeConstantReactance*>(obj)) {
-					if (genDyn->SynchronousMachine->mRID == machine->mRID) {
-						// stator
-						Real Rs = genDyn->statorResistance.value;
-						Real Ll = genDyn->statorLeakageReactance.value;
-						
-						// reactances
-						Real Ld = genDyn->xDirectSync.value;
-						Real Lq = genDyn->xQuadSync.value;
-						Real Ld_t = genDyn->xDirectTrans.value;
-						Real Lq_t = genDyn->xQuadTrans.value;
-						Real Ld_s = genDyn->xDirectSubtrans.value;
-						Real Lq_s = genDyn->xQuadSubtrans.value;
-						
-						// time constants
-						Real Td0_t = genDyn->tpdo.value;
-						Real Tq0_t = genDyn->tpqo.value;
-						Real Td0_s = genDyn->tppdo.value;
-						Real Tq0_s = genDyn->tppqo.value;
-
-						// inertia
-						Real H = genDyn->inertia.value;
-
-						// not available in CIM -> set to 0, as actually no impact on machine equations
-						Int poleNum = 0;
-						Real nomFieldCurr = 0;
-
-						if (mGeneratorType == GeneratorType::TransientStability) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is TransientStability.");
-							auto gen = DP::Ph1::SynchronGeneratorTrStab::make(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setStandardParametersPU(ratedPower, ratedVoltage, mFrequency, Ld_t, H);
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
-							auto gen = std::make_shared<DP::Ph1::SynchronGenerator6aOrderVBR>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(
-								ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
-								Ld_s, Lq_s, Td0_s, Tq0_s);  
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
-							auto gen = std::make_shared<DP::Ph1::SynchronGenerator6bOrderVBR>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(
-								ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
-								Ld_s, Lq_s, Td0_s, Tq0_s); 
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
-							auto gen = std::make_shared<DP::Ph1::SynchronGenerator4OrderVBR>(
-								machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t); 
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
-							auto gen = std::make_shared<DP::Ph1::SynchronGenerator3OrderVBR>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(
-								ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Td0_t); 
-							return gen;
-						}
-					}
+			Real ratedPower = machine.param("ratedPower");
+			Real ratedVoltage = machine.param("ratedVoltage");
+
+			if (machine.has("dynamics")) {
+				// stator
+				Real Rs = machine.param("Rs");
+				Real Ll = machine.param("Ll");
+				
+				// reactances
+				Real Ld = machine.param("Ld");
+				Real Lq = machine.param("Lq");
+				Real Ld_t = machine.param("Ld_t");
+				Real Lq_t = machine.param("Lq_t");
+				Real Ld_s = machine.param("Ld_s");
+				Real Lq_s = machine.param("Lq_s");
+				
+				// time constants
+				Real Td0_t = machine.param("Td0_t");
+				Real Tq0_t = machine.param("Tq0_t");
+				Real Td0_s = machine.param("Td0_s");
+				Real Tq0_s = machine.param("Tq0_s");
+
+				// inertia
+				Real H = machine.param("H");
+
+				// not available in CIM -> set to 0, as actually no impact on machine equations
+				Int poleNum = 0;
+				Real nomFieldCurr = 0;
+
+				if (mGeneratorType == GeneratorType::TransientStability) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is TransientStability.");
+					auto gen = DP::Ph1::SynchronGeneratorTrStab::make(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setStandardParametersPU(ratedPower, ratedVoltage, mFrequency, Ld_t, H);
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
+					auto gen = std::make_shared<DP::Ph1::SynchronGenerator6aOrderVBR>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(
+						ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
+						Ld_s, Lq_s, Td0_s, Tq0_s);  
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
+					auto gen = std::make_shared<DP::Ph1::SynchronGenerator6bOrderVBR>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(
+						ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
+						Ld_s, Lq_s, Td0_s, Tq0_s); 
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
+					auto gen = std::make_shared<DP::Ph1::SynchronGenerator4OrderVBR>(
+						machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t); 
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
+					auto gen = std::make_shared<DP::Ph1::SynchronGenerator3OrderVBR>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(
+						ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Td0_t); 
+					return gen;
 				}
 			}
 		} else if (mGeneratorType == GeneratorType::IdealVoltageSource) {
 			SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is IdealVoltageSource.");
-			return std::make_shared<DP::Ph1::SynchronGeneratorIdeal>(machine->mRID, machine->name, mComponentLogLevel);
+			return std::make_shared<DP::Ph1::SynchronGeneratorIdeal>(machine.mRID, machine.name, mComponentLogLevel);
 		} else if (mGeneratorType == GeneratorType::None) {
 			throw SystemError("GeneratorType is None. Specify!");
 		} else {
@@ -614,121 +926,86 @@ TopologicalPowerComp::Ptr Reader::mapSynchronousMachine(CIMPP::SynchronousMachin
 			|| mGeneratorType == GeneratorType::SG4OrderVBR
 			|| mGeneratorType == GeneratorType::SG3OrderVBR) {
 
-			Real ratedPower = unitValue(machine->ratedS.value, UnitMultiplier::M);
-			Real ratedVoltage = unitValue(machine->ratedU.value, UnitMultiplier::k);
-
-			for (auto obj : mModel->Objects) {
-				// Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
-				if (CIMPP::SynchronousMachineTimeConstantReactance* genDyn =
-					dynamic_cast<CIMPP::SynchronousMachineTimeConstantReactance*>(obj)) {
-					if (genDyn->SynchronousMachine->mRID == machine->mRID) {
-						// stator
-						Real Rs = genDyn->statorResistance.value;
-						Real Ll = genDyn->statorLeakageReactance.value;
-						
-						// reactances
-						Real Ld = genDyn->xDirectSync.value;
-						Real Lq = genDyn->xQuadSync.value;
-						Real Ld_t = genDyn->xDirectTrans.value;
-						Real Lq_t = genDyn->xQuadTrans.value;
-						Real Ld_s = genDyn->xDirectSubtrans.value;
-						Real Lq_s = genDyn->xQuadSubtrans.value;
-						
-						// time constants
-						Real Td0_t = genDyn->tpdo.value;
-						Real Tq0_t = genDyn->tpqo.value;
-						Real Td0_s = genDyn->tppdo.value;
-						Real Tq0_s = genDyn->tppqo.value;
-
-						// inertia
-						Real H = genDyn->inertia.value;
-
-						// not available in CIM -> set to 0, as actually no impact on machine equations
-						Int poleNum = 0;
-						Real nomFieldCurr = 0;
-
-						if (mGeneratorType == GeneratorType::TransientStability) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is TransientStability.");
-							auto gen = SP::Ph1::SynchronGeneratorTrStab::make(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setStandardParametersPU(ratedPower, ratedVoltage, mFrequency, Ld_t, H);
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
-							auto gen = std::make_shared<SP::Ph1::SynchronGenerator6aOrderVBR>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(
-								ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
-								Ld_s, Lq_s, Td0_s, Tq0_s);  
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
-							auto gen = std::make_shared<SP::Ph1::SynchronGenerator6bOrderVBR>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(
-								ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
-								Ld_s, Lq_s, Td0_s, Tq0_s); 
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
-							auto gen = std::make_shared<SP::Ph1::SynchronGenerator4OrderVBR>(
-								machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t); 
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
-							auto gen = std::make_shared<SP::Ph1::SynchronGenerator3OrderVBR>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(
-								ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Td0_t); 
-							return gen;
-						}
-					}
+			Real ratedPower = machine.param("ratedPower");
+			Real ratedVoltage = machine.param("ratedVoltage");
+
+			if (machine.has("dynamics")) {
+				// stator
+				Real Rs = machine.param("Rs");
+				Real Ll = machine.param("Ll");
+				
+				// reactances
+				Real Ld = machine.param("Ld");
+				Real Lq = machine.param("Lq");
+				Real Ld_t = machine.param("Ld_t");
+				Real Lq_t = machine.param("Lq_t");
+				Real Ld_s = machine.param("Ld_s");
+				Real Lq_s = machine.param("Lq_s");
+				
+				// time constants
+				Real Td0_t = machine.param("Td0_t");
+				Real Tq0_t = machine.param("Tq0_t");
+				Real Td0_s = machine.param("Td0_s");
+				Real Tq0_s = machine.param("Tq0_s");
+
+				// inertia
+				Real H = machine.param("H");
+
+				// not available in CIM -> set to 0, as actually no impact on machine equations
+				Int poleNum = 0;
+				Real nomFieldCurr = 0;
+
+				if (mGeneratorType == GeneratorType::TransientStability) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is TransientStability.");
+					auto gen = SP::Ph1::SynchronGeneratorTrStab::make(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setStandardParametersPU(ratedPower, ratedVoltage, mFrequency, Ld_t, H);
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
+					auto gen = std::make_shared<SP::Ph1::SynchronGenerator6aOrderVBR>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(
+						ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
+						Ld_s, Lq_s, Td0_s, Tq0_s);  
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
+					auto gen = std::make_shared<SP::Ph1::SynchronGenerator6bOrderVBR>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(
+						ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
+						Ld_s, Lq_s, Td0_s, Tq0_s); 
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
+					auto gen = std::make_shared<SP::Ph1::SynchronGenerator4OrderVBR>(
+						machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t); 
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
+					auto gen = std::make_shared<SP::Ph1::SynchronGenerator3OrderVBR>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(
+						ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Td0_t); 
+					return gen;
 				}
 			}
 		} else if (mGeneratorType == GeneratorType::PVNode) {
 			SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is PVNode.");
-			for (auto obj : mModel->Objects) {
-				if (CIMPP::GeneratingUnit* genUnit = dynamic_cast<CIMPP::GeneratingUnit*>(obj)) {
-					for (auto syncGen : genUnit->RotatingMachine) {
-						if (syncGen->mRID == machine->mRID){
-							// Check whether relevant input data are set, otherwise set default values
-							Real setPointActivePower = 0;
-							Real setPointVoltage = 0;
-							Real maximumReactivePower = 1e12;
-							try{
-								setPointActivePower = unitValue(genUnit->initialP.value, UnitMultiplier::M);
-								SPDLOG_LOGGER_INFO(mSLog, "    setPointActivePower={}", setPointActivePower);
-							}catch(ReadingUninitializedField* e){
-								std::cerr << "Uninitalized setPointActivePower for GeneratingUnit " << machine->name << ". Using default value of " << setPointActivePower << std::endl;
-							}
-							if (machine->RegulatingControl) {
-								setPointVoltage = unitValue(machine->RegulatingControl->targetValue.value, UnitMultiplier::k);
-								SPDLOG_LOGGER_INFO(mSLog, "    setPointVoltage={}", setPointVoltage);
-							} else {
-								std::cerr << "Uninitalized setPointVoltage for GeneratingUnit " <<  machine->name << ". Using default value of " << setPointVoltage << std::endl;
-							}
-							try{
-								maximumReactivePower = unitValue(machine->maxQ.value, UnitMultiplier::M);
-								SPDLOG_LOGGER_INFO(mSLog, "    maximumReactivePower={}", maximumReactivePower);
-							}catch(ReadingUninitializedField* e){
-								std::cerr << "Uninitalized maximumReactivePower for GeneratingUnit " <<  machine->name << ". Using default value of " << maximumReactivePower << std::endl;
-							}
-
-							auto gen = std::make_shared<SP::Ph1::SynchronGenerator>(machine->mRID, machine->name, mComponentLogLevel);
-								gen->setParameters(unitValue(machine->ratedS.value, UnitMultiplier::M),
-										unitValue(machine->ratedU.value, UnitMultiplier::k),
-										setPointActivePower,
-										setPointVoltage,
-										PowerflowBusType::PV);
-								gen->setBaseVoltage(unitValue(machine->ratedU.value, UnitMultiplier::k));
-							return gen;
-						}
-					}
-				}
+			if (machine.has("setPointActivePower")) {
+				auto gen = std::make_shared<SP::Ph1::SynchronGenerator>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setParameters(machine.param("ratedPower"),
+							machine.param("ratedVoltage"),
+							machine.param("setPointActivePower"),
+							machine.param("setPointVoltage"),
+							PowerflowBusType::PV);
+					gen->setBaseVoltage(machine.param("ratedVoltage"));
+				return gen;
 			}
-			SPDLOG_LOGGER_INFO(mSLog, "no corresponding initial power for {}", machine->name);
-			return std::make_shared<SP::Ph1::SynchronGenerator>(machine->mRID, machine->name, mComponentLogLevel);
+			SPDLOG_LOGGER_INFO(mSLog, "no corresponding initial power for {}", machine.name);
+			return std::make_shared<SP::Ph1::SynchronGenerator>(machine.mRID, machine.name, mComponentLogLevel);
 		} else if (mGeneratorType == GeneratorType::None) {
 			throw SystemError("GeneratorType is None. Specify!");
 		} else {
@@ -739,96 +1016,89 @@ TopologicalPowerComp::Ptr Reader::mapSynchronousMachine(CIMPP::SynchronousMachin
 		if (mGeneratorType == GeneratorType::FullOrder || mGeneratorType == GeneratorType::FullOrderVBR
 			|| mGeneratorType == GeneratorType::SG4OrderVBR) {
 			
-			Real ratedPower = unitValue(machine->ratedS.value, UnitMultiplier::M);
-			Real ratedVoltage = unitValue(machine->ratedU.value, UnitMultiplier::k);
-
-			for (auto obj : mModel->Objects) {
-				// Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
-				if (CIMPP::SynchronousMachineTimeConstantReactance* genDyn =
-					dynamic_cast<CIMPP::SynchronousMachineTimeConstantReactance*>(obj)) {
-					if (genDyn->SynchronousMachine->mRID == machine->mRID) {
-						
-						// stator
-						Real Rs = genDyn->statorResistance.value;
-						Real Ll = genDyn->statorLeakageReactance.value;
-						
-						// reactances
-						Real Ld = genDyn->xDirectSync.value;
-						Real Lq = genDyn->xQuadSync.value;
-						Real Ld_t = genDyn->xDirectTrans.value;
-						Real Lq_t = genDyn->xQuadTrans.value;
-						Real Ld_s = genDyn->xDirectSubtrans.value;
-						Real Lq_s = genDyn->xQuadSubtrans.value;
-						
-						// time constants
-						Real Td0_t = genDyn->tpdo.value;
-						Real Tq0_t = genDyn->tpqo.value;
-						Real Td0_s = genDyn->tppdo.value;
-						Real Tq0_s = genDyn->tppqo.value;
-
-						// inertia
-						Real H = genDyn->inertia.value;
-
-						// not available in CIM -> set to 0, as actually no impact on machine equations
-						Int poleNum = 0;
-						Real nomFieldCurr = 0;
-
-						if (mGeneratorType == GeneratorType::FullOrder) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is FullOrder.");
-							auto gen = std::make_shared<EMT::Ph3::SynchronGeneratorDQTrapez>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setParametersOperationalPerUnit(
-							ratedPower, ratedVoltage, mFrequency, poleNum, nomFieldCurr,
-							Rs, Ld, Lq, Ld_t, Lq_t, Ld_s, Lq_s, Ll, 
-							Td0_t, Tq0_t, Td0_s, Tq0_s, H); 
-							return gen;
-						} else if (mGeneratorType == GeneratorType::FullOrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is FullOrderVBR.");
-							auto gen = std::make_shared<EMT::Ph3::SynchronGeneratorVBR>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setBaseAndOperationalPerUnitParameters(
-							ratedPower, ratedVoltage, mFrequency, poleNum, nomFieldCurr,
-							Rs, Ld, Lq, Ld_t, Lq_t, Ld_s,
-							Lq_s, Ll, Td0_t, Tq0_t, Td0_s, Tq0_s, H); 
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
-							auto gen = std::make_shared<EMT::Ph3::SynchronGenerator6aOrderVBR>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(
-								ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
-								Ld_s, Lq_s, Td0_s, Tq0_s);  
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
-							auto gen = std::make_shared<EMT::Ph3::SynchronGenerator6bOrderVBR>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(
-								ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
-								Ld_s, Lq_s, Td0_s, Tq0_s); 
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
-							auto gen = std::make_shared<EMT::Ph3::SynchronGenerator4OrderVBR>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(
-								ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t); 
-							return gen;
-						} else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
-							SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
-							auto gen = std::make_shared<EMT::Ph3::SynchronGenerator3OrderVBR>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setOperationalParametersPerUnit(
-								ratedPower, ratedVoltage, mFrequency, H,
-								Ld, Lq, Ll, Ld_t, Td0_t); 
-							return gen;
-						}
-					}
+			Real ratedPower = machine.param("ratedPower");
+			Real ratedVoltage = machine.param("ratedVoltage");
+
+			if (machine.has("dynamics")) {
+				// stator
+				Real Rs = machine.param("Rs");
+				Real Ll = machine.param("Ll");
+				
+				// reactances
+				Real Ld = machine.param("Ld");
+				Real Lq = machine.param("Lq");
+				Real Ld_t = machine.param("Ld_t");
+				Real Lq_t = machine.param("Lq_t");
+				Real Ld_s = machine.param("Ld_s");
+				Real Lq_s = machine.param("Lq_s");
+				
+				// time constants
+				Real Td0_t = machine.param("Td0_t");
+				Real Tq0_t = machine.param("Tq0_t");
+				Real Td0_s = machine.param("Td0_s");
+				Real Tq0_s = machine.param("Tq0_s");
+
+				// inertia
+				Real H = machine.param("H");
+
+				// not available in CIM -> set to 0, as actually no impact on machine equations
+				Int poleNum = 0;
+				Real nomFieldCurr = 0;
+
+				if (mGeneratorType == GeneratorType::FullOrder) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is FullOrder.");
+					auto gen = std::make_shared<EMT::Ph3::SynchronGeneratorDQTrapez>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setParametersOperationalPerUnit(
+					ratedPower, ratedVoltage, mFrequency, poleNum, nomFieldCurr,
+					Rs, Ld, Lq, Ld_t, Lq_t, Ld_s, Lq_s, Ll, 
+					Td0_t, Tq0_t, Td0_s, Tq0_s, H); 
+					return gen;
+				} else if (mGeneratorType == GeneratorType::FullOrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is FullOrderVBR.");
+					auto gen = std::make_shared<EMT::Ph3::SynchronGeneratorVBR>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setBaseAndOperationalPerUnitParameters(
+					ratedPower, ratedVoltage, mFrequency, poleNum, nomFieldCurr,
+					Rs, Ld, Lq, Ld_t, Lq_t, Ld_s,
+					Lq_s, Ll, Td0_t, Tq0_t, Td0_s, Tq0_s, H); 
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
+					auto gen = std::make_shared<EMT::Ph3::SynchronGenerator6aOrderVBR>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(
+						ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
+						Ld_s, Lq_s, Td0_s, Tq0_s);  
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
+					auto gen = std::make_shared<EMT::Ph3::SynchronGenerator6bOrderVBR>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(
+						ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t,
+						Ld_s, Lq_s, Td0_s, Tq0_s); 
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
+					auto gen = std::make_shared<EMT::Ph3::SynchronGenerator4OrderVBR>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(
+						ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Lq_t, Td0_t, Tq0_t); 
+					return gen;
+				} else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
+					SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
+					auto gen = std::make_shared<EMT::Ph3::SynchronGenerator3OrderVBR>(machine.mRID, machine.name, mComponentLogLevel);
+					gen->setOperationalParametersPerUnit(
+						ratedPower, ratedVoltage, mFrequency, H,
+						Ld, Lq, Ll, Ld_t, Td0_t); 
+					return gen;
 				}
 			}
 		} else if (mGeneratorType == GeneratorType::IdealVoltageSource) {
 			SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is IdealVoltageSource.");
-			return std::make_shared<EMT::Ph3::SynchronGeneratorIdeal>(machine->mRID, machine->name, mComponentLogLevel, GeneratorType::IdealVoltageSource);
+			return std::make_shared<EMT::Ph3::SynchronGeneratorIdeal>(machine.mRID, machine.name, mComponentLogLevel, GeneratorType::IdealVoltageSource);
 		} else if (mGeneratorType == GeneratorType::IdealCurrentSource) {
 			SPDLOG_LOGGER_INFO(mSLog, "    GeneratorType is IdealCurrentSource.");
-			return std::make_shared<EMT::Ph3::SynchronGeneratorIdeal>(machine->mRID, machine->name, mComponentLogLevel, GeneratorType::IdealCurrentSource);
+			return std::make_shared<EMT::Ph3::SynchronGeneratorIdeal>(machine.mRID, machine.name, mComponentLogLevel, GeneratorType::IdealCurrentSource);
 		} else if (mGeneratorType == GeneratorType::None) {
 			throw SystemError("GeneratorType is None. Specify!");
 		} else {
@@ -838,14 +1108,32 @@ TopologicalPowerComp::Ptr Reader::mapSynchronousMachine(CIMPP::SynchronousMachin
 	return nullptr;
 }
 
-TopologicalPowerComp::Ptr Reader::mapExternalNetworkInjection(CIMPP::ExternalNetworkInjection* extnet) {
-	SPDLOG_LOGGER_INFO(mSLog, "Found External Network Injection {}", extnet->name);
+Bool Reader::extractExternalNetworkInjection(CIMPP::ExternalNetworkInjection* extnet, Equipment& eq) {
+	eq.type = EquipmentType::ExternalNetworkInjection;
+	eq.params["baseVoltage"] = determineBaseVoltageAssociatedWithEquipment(extnet);
 
-	Real baseVoltage = determineBaseVoltageAssociatedWithEquipment(extnet);
+	// The voltage set-point is assumed to be specified in per unit
+	try {
+		if(extnet->RegulatingControl){
+			eq.params["voltageSetPoint"] = extnet->RegulatingControl->targetValue;
+		} else {
+			SPDLOG_LOGGER_INFO(mSLog, "       No voltage set-point defined for {}. Using 1 per unit.", extnet->name);
+			eq.params["voltageSetPoint"] = 1.;
+		}
+	} catch (ReadingUninitializedField* e ) {
+		std::cerr << "Ignore incomplete RegulatingControl" << std::endl;
+	}
+	return true;
+}
+
+TopologicalPowerComp::Ptr Reader::mapExternalNetworkInjection(const Equipment& extnet) {
+	SPDLOG_LOGGER_INFO(mSLog, "Found External Network Injection {}", extnet.name);
+
+	Real baseVoltage = extnet.param("baseVoltage");
 
 	if (mDomain == Domain::EMT) {
 		if (mPhase == PhaseType::ABC) {
-			return std::make_shared<EMT::Ph3::NetworkInjection>(extnet->mRID, extnet->name, mComponentLogLevel);
+			return std::make_shared<EMT::Ph3::NetworkInjection>(extnet.mRID, extnet.name, mComponentLogLevel);
 		}
 		else {
 			throw SystemError("Mapping of ExternalNetworkInjection for EMT::Ph1 not existent!");
@@ -853,20 +1141,13 @@ TopologicalPowerComp::Ptr Reader::mapExternalNetworkInjection(CIMPP::ExternalNet
 		}
 	} else if(mDomain == Domain::SP) {
 		if (mPhase == PhaseType::Single) {
-			auto cpsextnet = std::make_shared<SP::Ph1::NetworkInjection>(extnet->mRID, extnet->name, mComponentLogLevel);
+			auto cpsextnet = std::make_shared<SP::Ph1::NetworkInjection>(extnet.mRID, extnet.name, mComponentLogLevel);
 			cpsextnet->modifyPowerFlowBusType(PowerflowBusType::VD); // for powerflow solver set as VD component as default
 			cpsextnet->setBaseVoltage(baseVoltage);
 
-			try {
-				if(extnet->RegulatingControl){
-					SPDLOG_LOGGER_INFO(mSLog, "       Voltage set-point={}", (float) extnet->RegulatingControl->targetValue);
-					cpsextnet->setParameters(extnet->RegulatingControl->targetValue*baseVoltage); // assumes that value is specified in CIM data in per unit
-				} else {
-					SPDLOG_LOGGER_INFO(mSLog, "       No voltage set-point defined. Using 1 per unit.");
-					cpsextnet->setParameters(1.*baseVoltage);
-				}
-			} catch (ReadingUninitializedField* e ) {
-				std::cerr << "Ignore incomplete RegulatingControl" << std::endl;
+			if (extnet.has("voltageSetPoint")) {
+				SPDLOG_LOGGER_INFO(mSLog, "       Voltage set-point={}", extnet.param("voltageSetPoint"));
+				cpsextnet->setParameters(extnet.param("voltageSetPoint")*baseVoltage);
 			}
 
 			return cpsextnet;
@@ -877,7 +1158,7 @@ TopologicalPowerComp::Ptr Reader::mapExternalNetworkInjection(CIMPP::ExternalNet
 		}
 	} else {
 		if (mPhase == PhaseType::Single) {
-			return std::make_shared<DP::Ph1::NetworkInjection>(extnet->mRID, extnet->name, mComponentLogLevel);
+			return std::make_shared<DP::Ph1::NetworkInjection>(extnet.mRID, extnet.name, mComponentLogLevel);
 		} else {
 			throw SystemError("Mapping of ExternalNetworkInjection for DP::Ph3 not existent!");
 			return nullptr;
@@ -885,100 +1166,84 @@ TopologicalPowerComp::Ptr Reader::mapExternalNetworkInjection(CIMPP::ExternalNet
 	}
 }
 
-TopologicalPowerComp::Ptr Reader::mapEquivalentShunt(CIMPP::EquivalentShunt* shunt){
-	SPDLOG_LOGGER_INFO(mSLog, "Found shunt {}", shunt->name);
+Bool Reader::extractEquivalentShunt(CIMPP::EquivalentShunt* shunt, Equipment& eq) {
+	eq.type = EquipmentType::EquivalentShunt;
+	extractParam(eq, "g", shunt->g.value);
+	extractParam(eq, "b", shunt->b.value);
+	eq.params["baseVoltage"] = determineBaseVoltageAssociatedWithEquipment(shunt);
+	return true;
+}
 
-	Real baseVoltage = determineBaseVoltageAssociatedWithEquipment(shunt);
+TopologicalPowerComp::Ptr Reader::mapEquivalentShunt(const Equipment& shunt){
+	SPDLOG_LOGGER_INFO(mSLog, "Found shunt {}", shunt.name);
 
-	auto cpsShunt = std::make_shared<SP::Ph1::Shunt>(shunt->mRID, shunt->name, mComponentLogLevel);
-	cpsShunt->setParameters(shunt->g.value, shunt->b.value);
-	cpsShunt->setBaseVoltage(baseVoltage);
+	auto cpsShunt = std::make_shared<SP::Ph1::Shunt>(shunt.mRID, shunt.name, mComponentLogLevel);
+	cpsShunt->setParameters(shunt.param("g"), shunt.param("b"));
+	cpsShunt->setBaseVoltage(shunt.param("baseVoltage"));
 	return cpsShunt;
 }
 
 Real Reader::determineBaseVoltageAssociatedWithEquipment(CIMPP::ConductingEquipment* equipment){
 	Real baseVoltage = 0;
 
-    // first look for baseVolt object to determine baseVoltage
-    for (auto obj : mModel->Objects) {
-        if (CIMPP::BaseVoltage* baseVolt = dynamic_cast<CIMPP::BaseVoltage*>(obj)) {
-            for (auto comp : baseVolt->ConductingEquipment) {
-                if (comp->name == equipment->name) {
-                    baseVoltage = unitValue(baseVolt->nominalVoltage.value,UnitMultiplier::k);
-                }
-            }
-        }
-    }
-    // as second option take baseVoltage of topologicalNode where equipment is connected to
-    if(baseVoltage == 0){
-        for (auto obj : mModel->Objects) {
-			if (CIMPP::TopologicalNode* topNode = dynamic_cast<CIMPP::TopologicalNode*>(obj)) {
-                for (auto term : topNode->Terminal) {
-					if (term->ConductingEquipment->name == equipment->name) {
-                        baseVoltage = unitValue(topNode->BaseVoltage->nominalVoltage.value,UnitMultiplier::k);
-					}
-				}
-			}
-		}
-    }
+	// first look for baseVolt object to determine baseVoltage
+	auto baseVolt = mObjects->baseVoltages.find(equipment->name);
+	if (baseVolt != mObjects->baseVoltages.end())
+		baseVoltage = unitValue(baseVolt->second->nominalVoltage.value, UnitMultiplier::k);
+
+	// as second option take baseVoltage of topologicalNode where equipment is connected to
+	if (baseVoltage == 0) {
+		auto topNode = mObjects->equipmentNodes.find(equipment->name);
+		if (topNode != mObjects->equipmentNodes.end())
+			baseVoltage = unitValue(topNode->second->BaseVoltage->nominalVoltage.value, UnitMultiplier::k);
+	}
 
 	return baseVoltage;
 }
 
-
-
 template<typename VarType>
-void Reader::processTopologicalNode(CIMPP::TopologicalNode* topNode) {
+void Reader::processTopologicalNode(const TopologyCache::Node &topNode) {
 	// Add this node to global node list and assign simulation node incrementally.
 	int matrixNodeIndex = Int(mPowerflowNodes.size());
-	mPowerflowNodes[topNode->mRID] = SimNode<VarType>::make(topNode->mRID, topNode->name, matrixNodeIndex, mPhase);
+	mPowerflowNodes[topNode.mRID] = SimNode<VarType>::make(topNode.mRID, topNode.name, matrixNodeIndex, mPhase);
 
 	if (mPhase == PhaseType::ABC) {
-		SPDLOG_LOGGER_INFO(mSLog, "TopologicalNode {} phase A as simulation node {} ", topNode->mRID, mPowerflowNodes[topNode->mRID]->matrixNodeIndex(PhaseType::A));
-		SPDLOG_LOGGER_INFO(mSLog, "TopologicalNode {} phase B as simulation node {}", topNode->mRID, mPowerflowNodes[topNode->mRID]->matrixNodeIndex(PhaseType::B));
-		SPDLOG_LOGGER_INFO(mSLog, "TopologicalNode {} phase C as simulation node {}", topNode->mRID, mPowerflowNodes[topNode->mRID]->matrixNodeIndex(PhaseType::C));
+		SPDLOG_LOGGER_INFO(mSLog, "TopologicalNode {} phase A as simulation node {} ", topNode.mRID, mPowerflowNodes[topNode.mRID]->matrixNodeIndex(PhaseType::A));
+		SPDLOG_LOGGER_INFO(mSLog, "TopologicalNode {} phase B as simulation node {}", topNode.mRID, mPowerflowNodes[topNode.mRID]->matrixNodeIndex(PhaseType::B));
+		SPDLOG_LOGGER_INFO(mSLog, "TopologicalNode {} phase C as simulation node {}", topNode.mRID, mPowerflowNodes[topNode.mRID]->matrixNodeIndex(PhaseType::C));
 	}
 	else
-		SPDLOG_LOGGER_INFO(mSLog, "TopologicalNode id: {}, name: {} as simulation node {}", topNode->mRID, topNode->name, mPowerflowNodes[topNode->mRID]->matrixNodeIndex());
+		SPDLOG_LOGGER_INFO(mSLog, "TopologicalNode id: {}, name: {} as simulation node {}", topNode.mRID, topNode.name, mPowerflowNodes[topNode.mRID]->matrixNodeIndex());
 
-	for (auto term : topNode->Terminal) {
+	for (auto& term : topNode.terminals) {
 		// Insert Terminal if it does not exist in the map and add reference to node.
 		// This could be optimized because the Terminal is searched twice.
-		auto cpsTerm = SimTerminal<VarType>::make(term->mRID);
-		mPowerflowTerminals.insert(std::make_pair(term->mRID, cpsTerm));
-		cpsTerm->setNode(std::dynamic_pointer_cast<SimNode<VarType>>(mPowerflowNodes[topNode->mRID]));
+		auto cpsTerm = SimTerminal<VarType>::make(term.mRID);
+		mPowerflowTerminals.insert(std::make_pair(term.mRID, cpsTerm));
+		cpsTerm->setNode(std::dynamic_pointer_cast<SimNode<VarType>>(mPowerflowNodes[topNode.mRID]));
 
-		if (!term->sequenceNumber.initialized)
-			term->sequenceNumber = 1;
-
-		SPDLOG_LOGGER_INFO(mSLog, "    Terminal {}, sequenceNumber {}", term->mRID, (int) term->sequenceNumber);
+		SPDLOG_LOGGER_INFO(mSLog, "    Terminal {}, sequenceNumber {}", term.mRID, term.sequenceNumber);
 
 		// Try to process Equipment connected to Terminal.
-		CIMPP::ConductingEquipment *equipment = term->ConductingEquipment;
-		if (!equipment) {
-			SPDLOG_LOGGER_WARN(mSLog, "Terminal {} has no Equipment, ignoring!", term->mRID);
+		if (term.equipment.empty()) {
+			SPDLOG_LOGGER_WARN(mSLog, "Terminal {} has no Equipment, ignoring!", term.mRID);
 		}
 		else {
-			// Insert Equipment if it does not exist in the map and add reference to Terminal.
-			// This could be optimized because the Equipment is searched twice.
-			if (mPowerflowEquipment.find(equipment->mRID) == mPowerflowEquipment.end()) {
-				TopologicalPowerComp::Ptr comp = mapComponent(equipment);
-				if (comp) {
-					mPowerflowEquipment.insert(std::make_pair(equipment->mRID, comp));
-				} else {
-					SPDLOG_LOGGER_WARN(mSLog, "Could not map equipment {}", equipment->mRID);
-					continue;
-				}
+			// The equipment has already been mapped, add reference to Terminal.
+			auto search = mPowerflowEquipment.find(term.equipment);
+			if (search == mPowerflowEquipment.end()) {
+				SPDLOG_LOGGER_WARN(mSLog, "Could not map equipment {}", term.equipment);
+				continue;
 			}
 
-			auto pfEquipment = mPowerflowEquipment.at(equipment->mRID);
+			auto pfEquipment = search->second;
 			std::dynamic_pointer_cast<SimPowerComp<VarType>>(pfEquipment)->setTerminalAt(
-				std::dynamic_pointer_cast<SimTerminal<VarType>>(mPowerflowTerminals[term->mRID]), term->sequenceNumber-1);
+				std::dynamic_pointer_cast<SimTerminal<VarType>>(mPowerflowTerminals[term.mRID]), term.sequenceNumber-1);
 
-			SPDLOG_LOGGER_INFO(mSLog, "        Added Terminal {} to Equipment {}", term->mRID, equipment->mRID);
+			SPDLOG_LOGGER_INFO(mSLog, "        Added Terminal {} to Equipment {}", term.mRID, term.equipment);
 		}
 	}
 }
 
-template void Reader::processTopologicalNode<Real>(CIMPP::TopologicalNode* topNode);
-template void Reader::processTopologicalNode<Complex>(CIMPP::TopologicalNode* topNode);
+template void Reader::processTopologicalNode<Real>(const TopologyCache::Node &topNode);
+template void Reader::processTopologicalNode<Complex>(const TopologyCache::Node &topNode);
@@ -0,0 +1,189 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <dpsim-models/CIM/TopologyCache.h>
+
+using namespace CPS;
+using namespace CPS::CIM;
+
+namespace {
+	template <typename T>
+	void writeValue(std::ofstream& file, const T& value) {
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	T readValue(std::ifstream& file) {
+		T value;
+		if (!file.read(reinterpret_cast<char*>(&value), sizeof(T)))
+			throw SystemError("CIM cache file is truncated.");
+		return value;
+	}
+
+	void writeString(std::ofstream& file, const String& value) {
+		writeValue<uint32_t>(file, static_cast<uint32_t>(value.size()));
+		file.write(value.data(), static_cast<std::streamsize>(value.size()));
+	}
+
+	String readString(std::ifstream& file) {
+		String value(readValue<uint32_t>(file), '\0');
+		if (!file.read(&value[0], static_cast<std::streamsize>(value.size())))
+			throw SystemError("CIM cache file is truncated.");
+		return value;
+	}
+
+	void writeComplex(std::ofstream& file, Complex value) {
+		writeValue<Real>(file, value.real());
+		writeValue<Real>(file, value.imag());
+	}
+
+	Complex readComplex(std::ifstream& file) {
+		Real real = readValue<Real>(file);
+		return { real, readValue<Real>(file) };
+	}
+}
+
+Real TopologyCache::Equipment::param(const String& key) const {
+	auto search = params.find(key);
+	if (search == params.end())
+		throw SystemError("Parameter " + key + " of " + name + " is not initialized");
+	return search->second;
+}
+
+Real TopologyCache::Equipment::param(const String& key, Real defaultValue) const {
+	auto search = params.find(key);
+	return search == params.end() ? defaultValue : search->second;
+}
+
+uint64_t TopologyCache::contentHash(const std::list<fs::path>& filenames) {
+	// 64 bit FNV-1a, the file boundaries are included by hashing the sizes
+	const uint64_t prime = 0x100000001b3;
+	uint64_t hash = 0xcbf29ce484222325;
+	auto update = [&hash, prime](const char* data, std::size_t size) {
+		for (std::size_t i = 0; i < size; ++i) {
+			hash ^= static_cast<unsigned char>(data[i]);
+			hash *= prime;
+		}
+	};
+
+	std::vector<char> buffer(1 << 16);
+	for (auto& filename : filenames) {
+		std::ifstream file(filename, std::ios_base::in|std::ios_base::binary);
+		if (!file.is_open())
+			throw SystemError("Cannot open CIM file " + filename.string());
+
+		uint64_t size = 0;
+		while (file) {
+			file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			update(buffer.data(), static_cast<std::size_t>(file.gcount()));
+			size += static_cast<uint64_t>(file.gcount());
+		}
+		update(reinterpret_cast<const char*>(&size), sizeof(size));
+	}
+	return hash;
+}
+
+fs::path TopologyCache::filename(const fs::path& directory, uint64_t hash) {
+	std::ostringstream name;
+	name << std::hex << std::setw(16) << std::setfill('0') << hash << ".cimcache";
+	return directory / name.str();
+}
+
+void TopologyCache::save(const fs::path& filename) const {
+	std::ofstream file(filename, std::ios_base::out|std::ios_base::trunc|std::ios_base::binary);
+	if (!file.is_open())
+		throw SystemError("Cannot open CIM cache file " + filename.string());
+
+	file.write("DPSIMCIM", 8);
+	writeValue<uint32_t>(file, Version);
+	writeValue<uint64_t>(file, hash);
+
+	writeValue<uint32_t>(file, static_cast<uint32_t>(nodes.size()));
+	for (auto& node : nodes) {
+		writeString(file, node.mRID);
+		writeString(file, node.name);
+		writeValue<uint8_t>(file, node.hasVoltage);
+		writeComplex(file, node.voltage);
+		writeValue<uint32_t>(file, static_cast<uint32_t>(node.terminals.size()));
+		for (auto& term : node.terminals) {
+			writeString(file, term.mRID);
+			writeString(file, term.equipment);
+			writeValue<uint32_t>(file, term.sequenceNumber);
+			writeValue<uint8_t>(file, term.hasPower);
+			writeComplex(file, term.power);
+		}
+	}
+
+	writeValue<uint32_t>(file, static_cast<uint32_t>(equipment.size()));
+	for (auto& eq : equipment) {
+		writeValue<uint32_t>(file, static_cast<uint32_t>(eq.type));
+		writeString(file, eq.mRID);
+		writeString(file, eq.name);
+		writeValue<uint32_t>(file, static_cast<uint32_t>(eq.params.size()));
+		for (auto& param : eq.params) {
+			writeString(file, param.first);
+			writeValue<Real>(file, param.second);
+		}
+	}
+
+	if (!file)
+		throw SystemError("Cannot write CIM cache file " + filename.string());
+}
+
+TopologyCache TopologyCache::load(const fs::path& filename) {
+	std::ifstream file(filename, std::ios_base::in|std::ios_base::binary);
+	if (!file.is_open())
+		throw SystemError("Cannot open CIM cache file " + filename.string());
+
+	char magic[8];
+	if (!file.read(magic, 8) || std::memcmp(magic, "DPSIMCIM", 8) != 0)
+		throw SystemError(filename.string() + " is not a CIM cache file.");
+	if (readValue<uint32_t>(file) != Version)
+		throw SystemError("Unsupported CIM cache version in " + filename.string());
+
+	TopologyCache cache;
+	cache.hash = readValue<uint64_t>(file);
+
+	cache.nodes.resize(readValue<uint32_t>(file));
+	for (auto& node : cache.nodes) {
+		node.mRID = readString(file);
+		node.name = readString(file);
+		node.hasVoltage = readValue<uint8_t>(file) != 0;
+		node.voltage = readComplex(file);
+		node.terminals.resize(readValue<uint32_t>(file));
+		for (auto& term : node.terminals) {
+			term.mRID = readString(file);
+			term.equipment = readString(file);
+			term.sequenceNumber = readValue<uint32_t>(file);
+			term.hasPower = readValue<uint8_t>(file) != 0;
+			term.power = readComplex(file);
+		}
+	}
+
+	cache.equipment.resize(readValue<uint32_t>(file));
+	for (auto& eq : cache.equipment) {
+		uint32_t type = readValue<uint32_t>(file);
+		if (type > static_cast<uint32_t>(EquipmentType::EquivalentShunt))
+			throw SystemError("Unknown equipment type in " + filename.string());
+		eq.type = static_cast<EquipmentType>(type);
+		eq.mRID = readString(file);
+		eq.name = readString(file);
+		uint32_t count = readValue<uint32_t>(file);
+		for (uint32_t i = 0; i < count; ++i) {
+			String key = readString(file);
+			eq.params[key] = readValue<Real>(file);
+		}
+	}
+
+	return cache;
+}
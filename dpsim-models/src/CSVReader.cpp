@@ -398,38 +398,27 @@ PowerProfile CSVReader::readLoadProfile(fs::path file,
 	*/
 	for (; loop != CSVReaderIterator(); loop.next()) {
 		CPS::Real currentTime = (need_that_conversion) ? time_format_convert((*loop).get(0)) : std::stod((*loop).get(0));
+		load_profile.times.push_back(currentTime);
 		if (data_with_weighting_factor) {
 			Real wf = std::stod((*loop).get(1));
-			load_profile.weightingFactors.insert(std::pair<Real, Real>(currentTime, wf));
+			load_profile.weightingFactors.push_back(wf);
 		}
 		else {
 		PQData pq;
 		// multiplied by 1000 due to unit conversion (kw to w)
 		pq.p = std::stod((*loop).get(1)) * 1000;
 		pq.q = std::stod((*loop).get(2)) * 1000;
-		load_profile.pqData.insert(std::pair<Real,PQData>(currentTime,pq));
+		load_profile.pqData.push_back(pq);
 		}
 
 		if (end_time > 0 && currentTime > end_time)
 			break;
 	}
-		std::vector<CPS::Real> times;
-	for (CPS::Real x_ = start_time; x_ <= end_time; x_ += time_step) {
-		times.push_back(x_);
-	}
-
-	for (auto x : times) {
-		if (load_profile.pqData.find(x) == load_profile.pqData.end()) {
-			if (data_with_weighting_factor) {
-				Real y = interpol_linear(load_profile.weightingFactors, x);
-				load_profile.weightingFactors.insert(std::pair<Real, Real>(x, y));
-			}
-			else {
-				PQData y = interpol_linear(load_profile.pqData, x);
-				load_profile.pqData.insert(std::pair<Real,PQData>(x,y));
-			}
-		}
-	}
+	/*
+	 values between the samples are interpolated when they are requested,
+	 see PowerProfile::pq and PowerProfile::weightingFactor
+	*/
+	load_profile.sort();
 
 	return load_profile;
 }
@@ -495,8 +484,16 @@ void CSVReader::assignLoadProfile(CPS::SystemTopology& sys, Real start_time, Rea
 						load_name.erase(remove_if(load_name.begin(), load_name.end(), [](char c) { return !isalnum(c); }), load_name.end());
 						file_name.erase(remove_if(file_name.begin(), file_name.end(), [](char c) { return !isalnum(c); }), file_name.end());
 						if (std::string(file_name.begin(), file_name.end() - 3).compare(load_name) == 0) {
-							load->mLoadProfile = readLoadProfile(file, start_time, time_step, end_time, format);
-							load->use_profile = true;
+							if (mProfileEngine) {
+								mProfileEngine->addLoad(load->mActivePower, load->mReactivePower,
+									readLoadProfile(file, start_time, time_step, end_time, format), **load->mActivePower, **load->mReactivePower);
+							} else {
+								if (mStreamProfiles)
+									load->mLoadProfileStream = std::make_shared<LoadProfileStream>(file, format == DataFormat::HHMMSS, mSkipFirstRow, mWindowRows);
+								else
+									load->mLoadProfile = readLoadProfile(file, start_time, time_step, end_time, format);
+								load->use_profile = true;
+							}
 							SPDLOG_LOGGER_INFO(mSLog, "Assigned {} to {}", file.filename().string(), load->name());
 						}
 					}
@@ -517,8 +514,16 @@ void CSVReader::assignLoadProfile(CPS::SystemTopology& sys, Real start_time, Rea
 						LP_not_assigned_counter++;
 						continue;
 					}
-					load->mLoadProfile = readLoadProfile(fs::path(mPath + file->second + ".csv"), start_time, time_step, end_time);
-					load->use_profile = true;
+					if (mProfileEngine) {
+						mProfileEngine->addLoad(load->mActivePower, load->mReactivePower,
+							readLoadProfile(fs::path(mPath + file->second + ".csv"), start_time, time_step, end_time), **load->mActivePower, **load->mReactivePower);
+					} else {
+						if (mStreamProfiles)
+							load->mLoadProfileStream = std::make_shared<LoadProfileStream>(fs::path(mPath + file->second + ".csv"), false, mSkipFirstRow, mWindowRows);
+						else
+							load->mLoadProfile = readLoadProfile(fs::path(mPath + file->second + ".csv"), start_time, time_step, end_time);
+						load->use_profile = true;
+					}
 					std::cout<<" Assigned "<< file->second<< " to " <<load->name()<<std::endl;
 					SPDLOG_LOGGER_INFO(mSLog, "Assigned {}.csv to {}", file->second, load->name());
 					LP_assigned_counter++;
@@ -535,45 +540,6 @@ void CSVReader::assignLoadProfile(CPS::SystemTopology& sys, Real start_time, Rea
 	}
 }
 
-CPS::PQData CSVReader::interpol_linear(std::map<CPS::Real, CPS::PQData>& pqData, CPS::Real x) {
-	std::map <Real, PQData>::const_iterator entry = pqData.upper_bound(x);
-	PQData y;
-
-	if (entry == pqData.end()) {
-		return (--entry)->second;
-	}
-	if (entry == pqData.begin()) {
-		return entry->second;
-	}
-	std::map <Real, PQData>::const_iterator prev = entry;
-	--prev;
-
-	const CPS::Real delta = (x - prev->first) / (entry->first - prev->first);
-
-	y.p = delta * entry->second.p + (1 - delta)*prev->second.p;
-	y.q = delta * entry->second.q + (1 - delta)*prev->second.q;
-	return y;
-}
-
-CPS::Real CSVReader::interpol_linear(std::map<CPS::Real, CPS::Real>& weightingFactors, CPS::Real x) {
-	std::map <Real, Real>::const_iterator entry = weightingFactors.upper_bound(x);
-	CPS::Real y;
-
-	if (entry == weightingFactors.end()) {
-		return (--entry)->second;
-	}
-	if (entry == weightingFactors.begin()) {
-		return entry->second;
-	}
-	std::map <Real, Real>::const_iterator prev = entry;
-	--prev;
-
-	const CPS::Real delta = (x - prev->first) / (entry->first - prev->first);
-
-	y = delta * entry->second + (1 - delta)*prev->second;
-	return y;
-}
-
 
 
 
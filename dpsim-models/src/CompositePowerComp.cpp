@@ -9,6 +9,8 @@ void CompositePowerComp<VarType>::addMNASubComponent(typename SimPowerComp<VarTy
 	this->mSubComponents.push_back(subc);
 	if (auto mnasubcomp = std::dynamic_pointer_cast<MNASimPowerComp<VarType>>(subc)) {
 		this->mSubcomponentsMNA.push_back(mnasubcomp);
+		// The tasks of subcomponents are not scheduled, their outputs are computed in their post steps
+		mnasubcomp->mnaMergeOutputStep();
 
 		if (contributeToRightVector) {
 			this->mRightVectorStamps.push_back(mnasubcomp->mRightVector);
@@ -52,6 +54,24 @@ void CompositePowerComp<VarType>::mnaCompInitialize(Real omega, Real timeStep, A
 	mnaParentInitialize(omega, timeStep, leftVector);
 }
 
+template <typename VarType>
+void CompositePowerComp<VarType>::mnaUpdateTimeStep(Real timeStep) {
+	for (auto subComp : mSubcomponentsMNA) {
+		if (auto varComp = std::dynamic_pointer_cast<MNAVariableTimeStepInterface>(subComp))
+			varComp->mnaUpdateTimeStep(timeStep);
+	}
+	mnaParentUpdateTimeStep(timeStep);
+}
+
+template <typename VarType>
+void CompositePowerComp<VarType>::mnaUpdateShiftFrequency(Real frequency, Real time, Real timeStep) {
+	for (auto subComp : mSubcomponentsMNA) {
+		if (auto varComp = std::dynamic_pointer_cast<MNAVariableFrequencyInterface>(subComp))
+			varComp->mnaUpdateShiftFrequency(frequency, time, timeStep);
+	}
+	mnaParentUpdateShiftFrequency(frequency, time, timeStep);
+}
+
 template <typename VarType>
 void CompositePowerComp<VarType>::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	for (auto subComp : mSubcomponentsMNA) {
@@ -84,6 +84,20 @@ void DP::Ph1::Capacitor::mnaCompInitialize(Real omega, Real timeStep, Attribute<
 		Logger::complexToString(mEquivCurrent(0,0)));
 }
 
+void DP::Ph1::Capacitor::mnaUpdateTimeStep(Real timeStep) {
+	Real equivCondReal = 2.0 * **mCapacitance / timeStep;
+	for (UInt freq = 0; freq < mNumFreqs; freq++) {
+		Real equivCondImag = 2.*PI * mFrequencies(freq,0) * **mCapacitance;
+		mEquivCond(freq,0) = { equivCondReal, equivCondImag };
+		mPrevVoltCoeff(freq,0) = { equivCondReal, -equivCondImag };
+	}
+}
+
+void DP::Ph1::Capacitor::mnaUpdateShiftFrequency(Real frequency, Real time, Real timeStep) {
+	mFrequencies(0,0) = frequency;
+	mnaUpdateTimeStep(timeStep);
+}
+
 void DP::Ph1::Capacitor::mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors) {
 		updateMatrixNodeIndices();
 
@@ -107,14 +121,8 @@ void DP::Ph1::Capacitor::mnaCompInitializeHarm(Real omega, Real timeStep, std::v
 
 void DP::Ph1::Capacitor::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
-		if (terminalNotGrounded(0))
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freq,0), mNumFreqs, freq);
-		if (terminalNotGrounded(1))
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), mEquivCond(freq,0), mNumFreqs, freq);
-		if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -mEquivCond(freq,0), mNumFreqs, freq);
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -mEquivCond(freq,0), mNumFreqs, freq);
-		}
+		Math::addBranchToMatrix<Complex>(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+			terminalNotGrounded(0), terminalNotGrounded(1), mEquivCond(freq,0), mNumFreqs, freq);
 
 		SPDLOG_LOGGER_INFO(mSLog, "-- Stamp frequency {:d} ---", freq);
 		if (terminalNotGrounded(0))
@@ -133,14 +141,8 @@ void DP::Ph1::Capacitor::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMa
 }
 
 void DP::Ph1::Capacitor::mnaCompApplySystemMatrixStampHarm(SparseMatrixRow& systemMatrix, Int freqIdx) {
-	if (terminalNotGrounded(0))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freqIdx,0));
-	if (terminalNotGrounded(1))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), mEquivCond(freqIdx,0));
-	if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -mEquivCond(freqIdx,0));
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -mEquivCond(freqIdx,0));
-	}
+	Math::addBranchToMatrix(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+		terminalNotGrounded(0), terminalNotGrounded(1), mEquivCond(freqIdx,0));
 
 	SPDLOG_LOGGER_INFO(mSLog, "-- Stamp frequency {:d} ---", freqIdx);
 	if (terminalNotGrounded(0))
@@ -228,6 +230,29 @@ void DP::Ph1::Capacitor::mnaCompPostStep(Real time, Int timeStepCount, Attribute
 	this->mnaUpdateCurrent(**leftVector);
 }
 
+Bool DP::Ph1::Capacitor::mnaCompHasBatchedSteps() const {
+	// Derived types could override the steps of the companion model
+	return mNumFreqs == 1 && typeid(*this) == typeid(Capacitor);
+}
+
+std::vector<DP::Ph1::CompanionModelBatch::Member> DP::Ph1::Capacitor::companionModelMembers(const std::vector<MNASimPowerComp<Complex>*>& comps) {
+	std::vector<CompanionModelBatch::Member> members;
+	for (auto comp : comps) {
+		auto capacitor = static_cast<Capacitor*>(comp);
+		members.push_back({ comp, capacitor->mEquivCond(0,0), -capacitor->mPrevVoltCoeff(0,0), Complex(-1, 0),
+			&capacitor->mEquivCurrent(0,0) });
+	}
+	return members;
+}
+
+Task::Ptr DP::Ph1::Capacitor::mnaCompCreateBatchedPreStep(const std::vector<MNASimPowerComp<Complex>*>& comps) {
+	return std::make_shared<CompanionModelPreStepBatch>(companionModelMembers(comps));
+}
+
+Task::Ptr DP::Ph1::Capacitor::mnaCompCreateBatchedPostStep(const std::vector<MNASimPowerComp<Complex>*>& comps, Attribute<Matrix>::Ptr leftVector) {
+	return std::make_shared<CompanionModelPostStepBatch>(companionModelMembers(comps), leftVector);
+}
+
 void DP::Ph1::Capacitor::MnaPreStepHarm::execute(Real time, Int timeStepCount) {
 	mCapacitor.mnaCompApplyRightSideVectorStampHarm(**mCapacitor.mRightVector);
 }
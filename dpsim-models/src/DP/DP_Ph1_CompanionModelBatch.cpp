@@ -0,0 +1,73 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/DP/DP_Ph1_CompanionModelBatch.h>
+
+using namespace CPS;
+
+DP::Ph1::CompanionModelBatch::CompanionModelBatch(const String& name, const std::vector<Member>& members)
+	: Task(name) {
+	for (auto& member : members) {
+		auto comp = member.comp;
+		mEquivCond.push_back(member.equivCond);
+		mVoltageCoeff.push_back(member.voltageCoeff);
+		mCurrentCoeff.push_back(member.currentCoeff);
+		mEquivCurrent.push_back(member.equivCurrent);
+		// The interface attributes are static, so their values are not moved during the simulation
+		mIntfVoltage.push_back(comp->mIntfVoltage->asRawPointer());
+		mIntfCurrent.push_back(comp->mIntfCurrent->asRawPointer());
+		mRightVector.push_back(comp->mRightVector->asRawPointer());
+		mRow0.push_back(comp->terminalNotGrounded(0) ? static_cast<Matrix::Index>(comp->matrixNodeIndex(0)) : -1);
+		mRow1.push_back(comp->terminalNotGrounded(1) ? static_cast<Matrix::Index>(comp->matrixNodeIndex(1)) : -1);
+	}
+	mComplexOffset = mRightVector[0]->rows() / 2;
+}
+
+DP::Ph1::CompanionModelPreStepBatch::CompanionModelPreStepBatch(const std::vector<Member>& members)
+	: CompanionModelBatch(**members[0].comp->mName + ".MnaPreStepBatch", members) {
+	for (auto& member : members)
+		member.comp->mnaAddPreStepDependencies(mPrevStepDependencies, mAttributeDependencies, mModifiedAttributes);
+}
+
+void DP::Ph1::CompanionModelPreStepBatch::execute(Real time, Int timeStepCount) {
+	for (std::size_t k = 0; k < mEquivCond.size(); ++k) {
+		Complex equivCurrent = mVoltageCoeff[k] * (*mIntfVoltage[k])(0, 0) + mCurrentCoeff[k] * (*mIntfCurrent[k])(0, 0);
+		*mEquivCurrent[k] = equivCurrent;
+
+		Matrix& rightVector = *mRightVector[k];
+		if (mRow0[k] >= 0) {
+			rightVector(mRow0[k], 0) = equivCurrent.real();
+			rightVector(mRow0[k] + mComplexOffset, 0) = equivCurrent.imag();
+		}
+		if (mRow1[k] >= 0) {
+			rightVector(mRow1[k], 0) = -equivCurrent.real();
+			rightVector(mRow1[k] + mComplexOffset, 0) = -equivCurrent.imag();
+		}
+	}
+}
+
+DP::Ph1::CompanionModelPostStepBatch::CompanionModelPostStepBatch(const std::vector<Member>& members, Attribute<Matrix>::Ptr leftVector)
+	: CompanionModelBatch(**members[0].comp->mName + ".MnaPostStepBatch", members), mLeftVector(leftVector) {
+	for (auto& member : members)
+		member.comp->mnaAddPostStepDependencies(mPrevStepDependencies, mAttributeDependencies, mModifiedAttributes, mLeftVector);
+}
+
+void DP::Ph1::CompanionModelPostStepBatch::execute(Real time, Int timeStepCount) {
+	const Matrix& leftVector = **mLeftVector;
+	for (std::size_t k = 0; k < mEquivCond.size(); ++k) {
+		// v1 - v0
+		Complex voltage = 0;
+		if (mRow1[k] >= 0)
+			voltage = Complex(leftVector(mRow1[k], 0), leftVector(mRow1[k] + mComplexOffset, 0));
+		if (mRow0[k] >= 0)
+			voltage -= Complex(leftVector(mRow0[k], 0), leftVector(mRow0[k] + mComplexOffset, 0));
+
+		(*mIntfVoltage[k])(0, 0) = voltage;
+		(*mIntfCurrent[k])(0, 0) = mEquivCond[k] * voltage + *mEquivCurrent[k];
+	}
+}
@@ -58,7 +58,7 @@ void DP::Ph1::Inductor::initializeFromNodesAndTerminals(Real frequency) {
 
 // #### MNA functions ####
 
-void DP::Ph1::Inductor::initVars(Real timeStep) {
+void DP::Ph1::Inductor::mnaUpdateTimeStep(Real timeStep) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		Real a = timeStep / (2. * **mInductance);
 		Real b = timeStep * 2.*PI * mFrequencies(freq,0) / 2.;
@@ -69,7 +69,17 @@ void DP::Ph1::Inductor::initVars(Real timeStep) {
 		Real preCurrFracReal = (1. - b * b) / (1. + b * b);
 		Real preCurrFracImag =  (-2. * b) / (1. + b * b);
 		mPrevCurrFac(freq,0) = { preCurrFracReal, preCurrFracImag };
+	}
+}
 
+void DP::Ph1::Inductor::mnaUpdateShiftFrequency(Real frequency, Real time, Real timeStep) {
+	mFrequencies(0,0) = frequency;
+	mnaUpdateTimeStep(timeStep);
+}
+
+void DP::Ph1::Inductor::initVars(Real timeStep) {
+	mnaUpdateTimeStep(timeStep);
+	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		// In steady-state, these variables should not change
 		mEquivCurrent(freq,0) = mEquivCond(freq,0) * (**mIntfVoltage)(0,freq) + mPrevCurrFac(freq,0) * (**mIntfCurrent)(0,freq);
 		(**mIntfCurrent)(0,freq) = mEquivCond(freq,0) * (**mIntfVoltage)(0,freq) + mEquivCurrent(freq,0);
@@ -103,14 +113,8 @@ void DP::Ph1::Inductor::mnaCompInitializeHarm(Real omega, Real timeStep, std::ve
 
 void DP::Ph1::Inductor::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
-		if (terminalNotGrounded(0))
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freq,0), mNumFreqs, freq);
-		if (terminalNotGrounded(1))
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), mEquivCond(freq,0), mNumFreqs, freq);
-		if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -mEquivCond(freq,0), mNumFreqs, freq);
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -mEquivCond(freq,0), mNumFreqs, freq);
-		}
+		Math::addBranchToMatrix<Complex>(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+			terminalNotGrounded(0), terminalNotGrounded(1), mEquivCond(freq,0), mNumFreqs, freq);
 
 		SPDLOG_LOGGER_INFO(mSLog, "-- Stamp frequency {:d} ---", freq);
 		if (terminalNotGrounded(0))
@@ -129,14 +133,8 @@ void DP::Ph1::Inductor::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMat
 }
 
 void DP::Ph1::Inductor::mnaCompApplySystemMatrixStampHarm(SparseMatrixRow& systemMatrix, Int freqIdx) {
-		if (terminalNotGrounded(0))
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freqIdx,0));
-		if (terminalNotGrounded(1))
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), mEquivCond(freqIdx,0));
-		if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -mEquivCond(freqIdx,0));
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -mEquivCond(freqIdx,0));
-		}
+		Math::addBranchToMatrix(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+			terminalNotGrounded(0), terminalNotGrounded(1), mEquivCond(freqIdx,0));
 
 		SPDLOG_LOGGER_INFO(mSLog, "-- Stamp frequency {:d} ---", freqIdx);
 		if (terminalNotGrounded(0))
@@ -211,6 +209,29 @@ void DP::Ph1::Inductor::mnaCompPostStep(Real time, Int timeStepCount, Attribute<
 	this->mnaUpdateCurrent(**leftVector);
 }
 
+Bool DP::Ph1::Inductor::mnaCompHasBatchedSteps() const {
+	// Derived types could override the steps of the companion model
+	return mNumFreqs == 1 && typeid(*this) == typeid(Inductor);
+}
+
+std::vector<DP::Ph1::CompanionModelBatch::Member> DP::Ph1::Inductor::companionModelMembers(const std::vector<MNASimPowerComp<Complex>*>& comps) {
+	std::vector<CompanionModelBatch::Member> members;
+	for (auto comp : comps) {
+		auto inductor = static_cast<Inductor*>(comp);
+		members.push_back({ comp, inductor->mEquivCond(0,0), inductor->mEquivCond(0,0), inductor->mPrevCurrFac(0,0),
+			&inductor->mEquivCurrent(0,0) });
+	}
+	return members;
+}
+
+Task::Ptr DP::Ph1::Inductor::mnaCompCreateBatchedPreStep(const std::vector<MNASimPowerComp<Complex>*>& comps) {
+	return std::make_shared<CompanionModelPreStepBatch>(companionModelMembers(comps));
+}
+
+Task::Ptr DP::Ph1::Inductor::mnaCompCreateBatchedPostStep(const std::vector<MNASimPowerComp<Complex>*>& comps, Attribute<Matrix>::Ptr leftVector) {
+	return std::make_shared<CompanionModelPostStepBatch>(companionModelMembers(comps), leftVector);
+}
+
 void DP::Ph1::Inductor::MnaPreStepHarm::execute(Real time, Int timeStepCount) {
 	mInductor.mnaCompApplyRightSideVectorStampHarm(**mInductor.mRightVector);
 }
@@ -24,9 +24,16 @@ DP::Ph1::PiLine::PiLine(String uid, String name, Logger::Level logLevel)
 SimPowerComp<Complex>::Ptr DP::Ph1::PiLine::clone(String name) {
 	auto copy = PiLine::make(name, mLogLevel);
 	copy->setParameters(**mSeriesRes, **mSeriesInd, **mParallelCap, **mParallelCond);
+	copy->setFlattened(mFlattened);
 	return copy;
 }
 
+void DP::Ph1::PiLine::setFlattened(Bool flattened) {
+	mFlattened = flattened;
+	// The flattened series branch does not need the node between resistor and inductor
+	setVirtualNodeNumber(flattened ? 0 : 1);
+}
+
 void DP::Ph1::PiLine::initializeFromNodesAndTerminals(Real frequency) {
 
 	// Static calculation
@@ -35,6 +42,32 @@ void DP::Ph1::PiLine::initializeFromNodesAndTerminals(Real frequency) {
 	(**mIntfVoltage)(0,0) = initialSingleVoltage(1) - initialSingleVoltage(0);
 	(**mIntfCurrent)(0,0) = (**mIntfVoltage)(0,0) / impedance;
 
+	// By default there is always a small conductance to ground to
+	// avoid problems with floating nodes.
+	Real defaultParallelCond = 1e-6;
+	**mParallelCond = (**mParallelCond > 0) ? **mParallelCond : defaultParallelCond;
+
+	if (mFlattened) {
+		mParallelVoltage0 = initialSingleVoltage(0);
+		mParallelVoltage1 = initialSingleVoltage(1);
+		Complex capAdmittance = (**mParallelCap >= 0) ? Complex(0, omega * **mParallelCap / 2.) : Complex(0, 0);
+		mCapCurrent0 = capAdmittance * mParallelVoltage0;
+		mCapCurrent1 = capAdmittance * mParallelVoltage1;
+
+		SPDLOG_LOGGER_INFO(mSLog,
+			"\n--- Initialization from powerflow ---"
+			"\nVoltage across: {:s}"
+			"\nCurrent: {:s}"
+			"\nTerminal 0 voltage: {:s}"
+			"\nTerminal 1 voltage: {:s}"
+			"\n--- Initialization from powerflow finished ---",
+			Logger::phasorToString((**mIntfVoltage)(0,0)),
+			Logger::phasorToString((**mIntfCurrent)(0,0)),
+			Logger::phasorToString(initialSingleVoltage(0)),
+			Logger::phasorToString(initialSingleVoltage(1)));
+		return;
+	}
+
 	// Initialization of virtual node
 	mVirtualNodes[0]->setInitialVoltage( initialSingleVoltage(0) + (**mIntfCurrent)(0,0) * **mSeriesRes );
 
@@ -53,11 +86,6 @@ void DP::Ph1::PiLine::initializeFromNodesAndTerminals(Real frequency) {
 	mSubSeriesInductor->initializeFromNodesAndTerminals(frequency);
 	addMNASubComponent(mSubSeriesInductor, MNA_SUBCOMP_TASK_ORDER::TASK_BEFORE_PARENT, MNA_SUBCOMP_TASK_ORDER::TASK_BEFORE_PARENT, true);
 
-	// By default there is always a small conductance to ground to
-	// avoid problems with floating nodes.
-	Real defaultParallelCond = 1e-6;
-	**mParallelCond = (**mParallelCond > 0) ? **mParallelCond : defaultParallelCond;
-
 	// Create parallel sub components
 	mSubParallelResistor0 = std::make_shared<DP::Ph1::Resistor>(**mName + "_con0", mLogLevel);
 	mSubParallelResistor0->setParameters(2. / **mParallelCond);
@@ -105,6 +133,75 @@ void DP::Ph1::PiLine::initializeFromNodesAndTerminals(Real frequency) {
 		Logger::phasorToString(mVirtualNodes[0]->initialSingleVoltage()));
 }
 
+void DP::Ph1::PiLine::mnaParentInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
+	if (!mFlattened)
+		return;
+
+	if (mNumFreqs > 1)
+		throw SystemError("Flattened PiLine " + **mName + " only supports a single frequency.");
+
+	// Trapezoidal companion model of the inductor as in DP::Ph1::Inductor
+	Real a = timeStep / (2. * **mSeriesInd);
+	Real b = timeStep * 2.*PI * mFrequencies(0,0) / 2.;
+	Complex inductorEquivCond = Complex(a, 0) / Complex(1., b);
+	Complex inductorPrevCurrFac = Complex(1., -b) / Complex(1., b);
+
+	// The voltage across the inductor is the branch voltage minus the drop over the
+	// series resistor, which eliminates the virtual node from the branch equation
+	Complex denominator = 1. + inductorEquivCond * **mSeriesRes;
+	mSeriesEquivCond = inductorEquivCond / denominator;
+	mSeriesPrevVoltCoeff = mSeriesEquivCond;
+	mSeriesPrevCurrCoeff = (inductorPrevCurrFac - inductorEquivCond * **mSeriesRes) / denominator;
+	mSeriesEquivCurrent = mSeriesPrevVoltCoeff * (**mIntfVoltage)(0,0) + mSeriesPrevCurrCoeff * (**mIntfCurrent)(0,0);
+
+	// Trapezoidal companion model of the capacitors as in DP::Ph1::Capacitor
+	Real capacitance = (**mParallelCap >= 0) ? **mParallelCap / 2. : 0;
+	Real capOmega = 2.*PI * mFrequencies(0,0);
+	mCapEquivCond = { 2. * capacitance / timeStep, capOmega * capacitance };
+	mCapPrevVoltCoeff = { 2. * capacitance / timeStep, -capOmega * capacitance };
+	mParallelEquivCond = **mParallelCond / 2. + mCapEquivCond;
+	mCapEquivCurrent0 = -mCapCurrent0 - mCapPrevVoltCoeff * mParallelVoltage0;
+	mCapEquivCurrent1 = -mCapCurrent1 - mCapPrevVoltCoeff * mParallelVoltage1;
+
+	SPDLOG_LOGGER_INFO(mSLog,
+		"\n--- Flattened MNA initialization ---"
+		"\nSeries equiv. conductance {:s}"
+		"\nParallel equiv. conductance {:s}"
+		"\n--- Flattened MNA initialization finished ---",
+		Logger::complexToString(mSeriesEquivCond),
+		Logger::complexToString(mParallelEquivCond));
+}
+
+void DP::Ph1::PiLine::mnaParentApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
+	if (!mFlattened)
+		return;
+
+	Math::addBranchToMatrix<Complex>(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+		terminalNotGrounded(0), terminalNotGrounded(1), mSeriesEquivCond);
+	if (terminalNotGrounded(0))
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mParallelEquivCond);
+	if (terminalNotGrounded(1))
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), mParallelEquivCond);
+}
+
+void DP::Ph1::PiLine::mnaCompApplyRightSideVectorStamp(Matrix& rightVector) {
+	if (!mFlattened) {
+		CompositePowerComp<Complex>::mnaCompApplyRightSideVectorStamp(rightVector);
+		return;
+	}
+
+	// Calculate equivalent current sources for next time step. The right vector is
+	// only written at the terminal rows, so it does not have to be cleared.
+	mSeriesEquivCurrent = mSeriesPrevVoltCoeff * (**mIntfVoltage)(0,0) + mSeriesPrevCurrCoeff * (**mIntfCurrent)(0,0);
+	mCapEquivCurrent0 = -mCapCurrent0 - mCapPrevVoltCoeff * mParallelVoltage0;
+	mCapEquivCurrent1 = -mCapCurrent1 - mCapPrevVoltCoeff * mParallelVoltage1;
+
+	if (terminalNotGrounded(0))
+		Math::setVectorElement(rightVector, matrixNodeIndex(0), mSeriesEquivCurrent - mCapEquivCurrent0);
+	if (terminalNotGrounded(1))
+		Math::setVectorElement(rightVector, matrixNodeIndex(1), -mSeriesEquivCurrent - mCapEquivCurrent1);
+}
+
 void DP::Ph1::PiLine::mnaParentAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
 	// add pre-step dependencies of component itself
 	prevStepDependencies.push_back(mIntfCurrent);
@@ -139,10 +236,22 @@ void DP::Ph1::PiLine::mnaCompUpdateVoltage(const Matrix& leftVector) {
 }
 
 void DP::Ph1::PiLine::mnaCompUpdateCurrent(const Matrix& leftVector) {
-	(**mIntfCurrent)(0,0) = mSubSeriesInductor->intfCurrent()(0, 0);
+	if (!mFlattened) {
+		(**mIntfCurrent)(0,0) = mSubSeriesInductor->intfCurrent()(0, 0);
+		return;
+	}
+
+	mParallelVoltage0 = terminalNotGrounded(0) ? Math::complexFromVectorElement(leftVector, matrixNodeIndex(0)) : Complex(0, 0);
+	mParallelVoltage1 = terminalNotGrounded(1) ? Math::complexFromVectorElement(leftVector, matrixNodeIndex(1)) : Complex(0, 0);
+	mCapCurrent0 = mCapEquivCond * mParallelVoltage0 + mCapEquivCurrent0;
+	mCapCurrent1 = mCapEquivCond * mParallelVoltage1 + mCapEquivCurrent1;
+	(**mIntfCurrent)(0,0) = mSeriesEquivCond * (**mIntfVoltage)(0,0) + mSeriesEquivCurrent;
 }
 
 MNAInterface::List DP::Ph1::PiLine::mnaTearGroundComponents() {
+	if (mFlattened)
+		throw SystemError("Tearing is not supported for the flattened PiLine " + **mName + ".");
+
 	MNAInterface::List gndComponents;
 
 	gndComponents.push_back(mSubParallelResistor0);
@@ -128,13 +128,13 @@ void DP::Ph1::RXLoad::mnaParentPreStep(Real time, Int timeStepCount) {
 	mnaCompApplyRightSideVectorStamp(**mRightVector);
 }
 
-void DP::Ph1::RXLoad::mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
+void DP::Ph1::RXLoad::mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
 	attributeDependencies.push_back(leftVector);
 	modifiedAttributes.push_back(mIntfVoltage);
 	modifiedAttributes.push_back(mIntfCurrent);
 }
 
-void DP::Ph1::RXLoad::mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+void DP::Ph1::RXLoad::mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
 	mnaCompUpdateVoltage(**leftVector);
 	mnaCompUpdateCurrent(**leftVector);
 }
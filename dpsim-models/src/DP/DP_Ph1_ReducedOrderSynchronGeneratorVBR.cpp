@@ -79,6 +79,12 @@ void DP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaCompInitialize(Real omega,
 
 	Base::ReducedOrderSynchronGenerator<Complex>::mnaCompInitialize(omega, timeStep, leftVector);
 
+	// Ka and Kb depend on the rotor angle, so only the constant part of the resistance matrix remains
+	MatrixFixedSize<2, 2> constantResistanceMatrix;
+	constantResistanceMatrix <<	mR_const_1ph.real(),	-mR_const_1ph.imag(),
+								mR_const_1ph.imag(),	mR_const_1ph.real();
+	mConstantConductanceMatrix = (constantResistanceMatrix * mBase_Z).inverse();
+
 	if (mModelAsCurrentSource) {
 		// FIXME set variable matrix entries accordingly as shown below
 		mVariableSystemMatrixEntries.push_back(std::make_pair<UInt,UInt>(matrixNodeIndex(0, 0), matrixNodeIndex(0, 0)));
@@ -120,7 +126,8 @@ void DP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaCompApplySystemMatrixStamp(Sp
 	if (mModelAsCurrentSource) {
 		// Stamp conductance matrix
 		// set bottom right block
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mConductanceMatrix);
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0),
+			hasConstantConductance() ? mConstantConductanceMatrix : mConductanceMatrix);
 
 	} else {
 		// Stamp voltage source
@@ -147,7 +154,11 @@ void DP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaCompApplyRightSideVectorStamp
 		mIvbr = Complex(mConductanceMatrix(0,0) * mEvbr.real() + mConductanceMatrix(0,1) * mEvbr.imag(),
 					    mConductanceMatrix(1,0) * mEvbr.real() + mConductanceMatrix(1,1) * mEvbr.imag());
 
-		Math::setVectorElement(rightVector, matrixNodeIndex(0,0), mIvbr);
+		if (hasConstantConductance())
+			// predict the correction with the terminal voltage of the previous step
+			Math::setVectorElement(rightVector, matrixNodeIndex(0,0), correctedNortonCurrent((**mIntfVoltage)(0, 0)));
+		else
+			Math::setVectorElement(rightVector, matrixNodeIndex(0,0), mIvbr);
 
 	} else {
 		Math::setVectorElement(rightVector, mVirtualNodes[1]->matrixNodeIndex(), mEvbr);
@@ -180,6 +191,19 @@ void DP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaCompPostStep(const Matrix& le
 	**mIdq = parkTransform * Iabc / mBase_I_RMS;
 }
 
+Complex DP::Ph1::ReducedOrderSynchronGeneratorVBR::correctedNortonCurrent(Complex voltage) const {
+	MatrixFixedSize<2, 2> deviation = mConductanceMatrix - mConstantConductanceMatrix;
+	return mIvbr - Complex(deviation(0,0) * voltage.real() + deviation(0,1) * voltage.imag(),
+						   deviation(1,0) * voltage.real() + deviation(1,1) * voltage.imag());
+}
+
+Bool DP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaCorrectorStep(const Matrix& leftVector) {
+	Complex current = correctedNortonCurrent(Math::complexFromVectorElement(leftVector, matrixNodeIndex(0, 0)));
+	Complex change = current - Math::complexFromVectorElement(**mRightVector, matrixNodeIndex(0, 0));
+	Math::setVectorElement(**mRightVector, matrixNodeIndex(0, 0), current);
+	return std::abs(change) <= mCorrectorTolerance * mBase_I_RMS;
+}
+
 Matrix DP::Ph1::ReducedOrderSynchronGeneratorVBR::get_parkTransformMatrix() const {
 	Matrix abcToDq0(2, 3);
 
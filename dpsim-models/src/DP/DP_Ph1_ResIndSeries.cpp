@@ -108,14 +108,8 @@ void DP::Ph1::ResIndSeries::mnaCompInitializeHarm(Real omega, Real timeStep, std
 
 void DP::Ph1::ResIndSeries::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	for (Int freq = 0; freq < mNumFreqs; freq++) {
-		if (terminalNotGrounded(0))
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freq,0), mNumFreqs, freq);
-		if (terminalNotGrounded(1))
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), mEquivCond(freq,0), mNumFreqs, freq);
-		if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -mEquivCond(freq,0), mNumFreqs, freq);
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -mEquivCond(freq,0), mNumFreqs, freq);
-		}
+		Math::addBranchToMatrix<Complex>(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+			terminalNotGrounded(0), terminalNotGrounded(1), mEquivCond(freq,0), mNumFreqs, freq);
 
 		SPDLOG_LOGGER_INFO(mSLog, "-- Stamp frequency {:d} ---", freq);
 		if (terminalNotGrounded(0))
@@ -134,14 +128,8 @@ void DP::Ph1::ResIndSeries::mnaCompApplySystemMatrixStamp(SparseMatrixRow& syste
 }
 
 void DP::Ph1::ResIndSeries::mnaCompApplySystemMatrixStampHarm(SparseMatrixRow& systemMatrix, Int freqIdx) {
-		if (terminalNotGrounded(0))
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freqIdx,0));
-		if (terminalNotGrounded(1))
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), mEquivCond(freqIdx,0));
-		if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -mEquivCond(freqIdx,0));
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -mEquivCond(freqIdx,0));
-		}
+		Math::addBranchToMatrix(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+			terminalNotGrounded(0), terminalNotGrounded(1), mEquivCond(freqIdx,0));
 
 		SPDLOG_LOGGER_INFO(mSLog, "-- Stamp frequency {:d} ---", freqIdx);
 		if (terminalNotGrounded(0))
@@ -70,16 +70,9 @@ void DP::Ph1::Resistor::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMat
 	Complex conductance = Complex(1. / **mResistance, 0);
 
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
-		// Set diagonal entries
-		if (terminalNotGrounded(0))
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), conductance, mNumFreqs, freq);
-		if (terminalNotGrounded(1))
-		// Set off diagonal entries
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), conductance, mNumFreqs, freq);
-		if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -conductance, mNumFreqs, freq);
-			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -conductance, mNumFreqs, freq);
-		}
+		// Set diagonal and off diagonal entries
+		Math::addBranchToMatrix<Complex>(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+			terminalNotGrounded(0), terminalNotGrounded(1), conductance, mNumFreqs, freq);
 
 		SPDLOG_LOGGER_INFO(mSLog, "-- Stamp frequency {:d} ---", freq);
 		if (terminalNotGrounded(0))
@@ -95,16 +88,9 @@ void DP::Ph1::Resistor::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMat
 
 void DP::Ph1::Resistor::mnaCompApplySystemMatrixStampHarm(SparseMatrixRow& systemMatrix, Int freqIdx) {
 	Complex conductance = Complex(1. / **mResistance, 0);
-	// Set diagonal entries
-	if (terminalNotGrounded(0))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), conductance);
-	if (terminalNotGrounded(1))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), conductance);
-	// Set off diagonal entries
-	if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -conductance);
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -conductance);
-	}
+	// Set diagonal and off diagonal entries
+	Math::addBranchToMatrix(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+		terminalNotGrounded(0), terminalNotGrounded(1), conductance);
 
 	SPDLOG_LOGGER_INFO(mSLog, "-- Stamp for frequency {:f} ---", mFrequencies(freqIdx,0));
 	if (terminalNotGrounded(0))
@@ -78,13 +78,13 @@ void DP::Ph1::RxLine::mnaParentAddPreStepDependencies(AttributeBase::List &prevS
 	modifiedAttributes.push_back(mRightVector);
 }
 
-void DP::Ph1::RxLine::mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
+void DP::Ph1::RxLine::mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
 	attributeDependencies.push_back(leftVector);
 	modifiedAttributes.push_back(mIntfCurrent);
 	modifiedAttributes.push_back(mIntfVoltage);
 }
 
-void DP::Ph1::RxLine::mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+void DP::Ph1::RxLine::mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
 	mnaCompUpdateVoltage(**leftVector);
 	mnaCompUpdateCurrent(**leftVector);
 }
@@ -51,16 +51,9 @@ void DP::Ph1::Switch::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatri
 	Complex conductance = (**mIsClosed) ?
 		Complex( 1. / **mClosedResistance, 0 ) : Complex( 1. / **mOpenResistance, 0 );
 
-	// Set diagonal entries
-	if (terminalNotGrounded(0))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), conductance);
-	if (terminalNotGrounded(1))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), conductance);
-	// Set off diagonal entries
-	if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -conductance);
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -conductance);
-	}
+	// Set diagonal and off diagonal entries
+	Math::addBranchToMatrix(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+		terminalNotGrounded(0), terminalNotGrounded(1), conductance);
 
 	SPDLOG_LOGGER_TRACE(mSLog, "-- Stamp ---");
 	if (terminalNotGrounded(0))
@@ -78,17 +71,9 @@ void DP::Ph1::Switch::mnaCompApplySwitchSystemMatrixStamp(Bool closed, SparseMat
 		Complex( 1. / **mClosedResistance, 0 ) :
 		Complex( 1. / **mOpenResistance, 0 );
 
-	// Set diagonal entries
-	if (terminalNotGrounded(0))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), conductance);
-	if (terminalNotGrounded(1))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), conductance);
-
-	// Set off diagonal entries
-	if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -conductance);
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -conductance);
-	}
+	// Set diagonal and off diagonal entries
+	Math::addBranchToMatrix(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+		terminalNotGrounded(0), terminalNotGrounded(1), conductance);
 
 	SPDLOG_LOGGER_TRACE(mSLog, "-- Stamp ---");
 	if (terminalNotGrounded(0))
@@ -96,6 +96,9 @@ void DP::Ph1::VoltageSource::mnaCompInitialize(Real omega, Real timeStep, Attrib
 		updateMatrixNodeIndices();
 
 	(**mIntfVoltage)(0,0) = mSrcSig->getSignal();
+	mShiftFrequencyOffset = 0;
+	mShiftAngle = 0;
+	mShiftTime = 0;
 
 	SPDLOG_LOGGER_INFO(mSLog,
 		"\n--- MNA initialization ---"
@@ -106,6 +109,13 @@ void DP::Ph1::VoltageSource::mnaCompInitialize(Real omega, Real timeStep, Attrib
 		Logger::phasorToString((**mIntfCurrent)(0,0)));
 }
 
+void DP::Ph1::VoltageSource::mnaUpdateShiftFrequency(Real frequency, Real time, Real timeStep) {
+	// The angle between the frames is continuous, the phasors do not jump
+	mShiftAngle += 2.*PI * mShiftFrequencyOffset * (time - mShiftTime);
+	mShiftTime = time;
+	mShiftFrequencyOffset = frequency - mFrequencies(0,0);
+}
+
 void DP::Ph1::VoltageSource::mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors) {
 		updateMatrixNodeIndices();
 
@@ -180,6 +190,8 @@ void DP::Ph1::VoltageSource::updateVoltage(Real time) {
 	if(mSrcSig != nullptr) {
 		mSrcSig->step(time);
 		(**mIntfVoltage)(0,0) = mSrcSig->getSignal();
+		if (mShiftFrequencyOffset != 0 || mShiftAngle != 0)
+			(**mIntfVoltage)(0,0) *= std::polar(1., -(mShiftAngle + 2.*PI * mShiftFrequencyOffset * (time - mShiftTime)));
 	} else {
 		throw SystemError("VoltageSource::updateVoltage was called but no signal generator is configured!");
 	}
@@ -0,0 +1,107 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/EMT/EMT_CompanionModelBatch.h>
+
+using namespace CPS;
+
+template <int NumPhases>
+std::vector<typename EMT::CompanionModelBatch<NumPhases>::Member> EMT::CompanionModelBatch<NumPhases>::members(const std::vector<MNASimPowerComp<Real>*>& comps) {
+	std::vector<Member> members;
+	for (auto comp : comps)
+		members.push_back(dynamic_cast<Provider&>(*comp).companionModelMember());
+	return members;
+}
+
+template <int NumPhases>
+EMT::CompanionModelBatch<NumPhases>::CompanionModelBatch(const String& name, const std::vector<Member>& members)
+	: Task(name) {
+	for (auto& member : members) {
+		auto comp = member.comp;
+		mEquivCond.push_back(member.equivCond);
+		mVoltageCoeff.push_back(member.voltageCoeff);
+		mCurrentCoeff.push_back(member.currentCoeff);
+		mEquivCurrent.push_back(member.equivCurrent);
+		// The interface attributes are static, so their values are not moved during the simulation
+		mIntfVoltage.push_back(comp->mIntfVoltage->asRawPointer());
+		mIntfCurrent.push_back(comp->mIntfCurrent->asRawPointer());
+		mRightVector.push_back(comp->mRightVector->asRawPointer());
+
+		Rows rows0, rows1;
+		for (UInt phase = 0; phase < NumPhases; ++phase) {
+			rows0[phase] = comp->terminalNotGrounded(0) ? static_cast<Matrix::Index>(comp->matrixNodeIndex(0, phase)) : -1;
+			rows1[phase] = comp->terminalNotGrounded(1) ? static_cast<Matrix::Index>(comp->matrixNodeIndex(1, phase)) : -1;
+		}
+		mRows0.push_back(rows0);
+		mRows1.push_back(rows1);
+	}
+}
+
+template <int NumPhases>
+EMT::CompanionModelPreStepBatch<NumPhases>::CompanionModelPreStepBatch(const std::vector<typename CompanionModelBatch<NumPhases>::Member>& members)
+	: CompanionModelBatch<NumPhases>(**members[0].comp->mName + ".MnaPreStepBatch", members) {
+	for (auto& member : members)
+		member.comp->mnaAddPreStepDependencies(this->mPrevStepDependencies, this->mAttributeDependencies, this->mModifiedAttributes);
+}
+
+template <int NumPhases>
+void EMT::CompanionModelPreStepBatch<NumPhases>::execute(Real time, Int timeStepCount) {
+	using Vector = typename CompanionModelBatch<NumPhases>::Vector;
+
+	for (std::size_t k = 0; k < this->mEquivCond.size(); ++k) {
+		Eigen::Map<const Vector> voltage(this->mIntfVoltage[k]->data());
+		Eigen::Map<const Vector> current(this->mIntfCurrent[k]->data());
+		Eigen::Map<Vector> equivCurrent(this->mEquivCurrent[k]);
+		equivCurrent = this->mVoltageCoeff[k] * voltage + this->mCurrentCoeff[k] * current;
+
+		Matrix& rightVector = *this->mRightVector[k];
+		for (int phase = 0; phase < NumPhases; ++phase) {
+			if (this->mRows0[k][phase] >= 0)
+				rightVector(this->mRows0[k][phase], 0) = equivCurrent(phase);
+			if (this->mRows1[k][phase] >= 0)
+				rightVector(this->mRows1[k][phase], 0) = -equivCurrent(phase);
+		}
+	}
+}
+
+template <int NumPhases>
+EMT::CompanionModelPostStepBatch<NumPhases>::CompanionModelPostStepBatch(const std::vector<typename CompanionModelBatch<NumPhases>::Member>& members, Attribute<Matrix>::Ptr leftVector)
+	: CompanionModelBatch<NumPhases>(**members[0].comp->mName + ".MnaPostStepBatch", members), mLeftVector(leftVector) {
+	for (auto& member : members)
+		member.comp->mnaAddPostStepDependencies(this->mPrevStepDependencies, this->mAttributeDependencies, this->mModifiedAttributes, mLeftVector);
+}
+
+template <int NumPhases>
+void EMT::CompanionModelPostStepBatch<NumPhases>::execute(Real time, Int timeStepCount) {
+	using Vector = typename CompanionModelBatch<NumPhases>::Vector;
+
+	const Matrix& leftVector = **mLeftVector;
+	for (std::size_t k = 0; k < this->mEquivCond.size(); ++k) {
+		// v1 - v0
+		Eigen::Map<Vector> voltage(this->mIntfVoltage[k]->data());
+		for (int phase = 0; phase < NumPhases; ++phase) {
+			Real value = 0;
+			if (this->mRows1[k][phase] >= 0)
+				value = leftVector(this->mRows1[k][phase], 0);
+			if (this->mRows0[k][phase] >= 0)
+				value -= leftVector(this->mRows0[k][phase], 0);
+			voltage(phase) = value;
+		}
+
+		Eigen::Map<Vector> current(this->mIntfCurrent[k]->data());
+		current = this->mEquivCond[k] * voltage + Eigen::Map<const Vector>(this->mEquivCurrent[k]);
+	}
+}
+
+// Declare specializations to move definitions to .cpp
+template class CPS::EMT::CompanionModelBatch<1>;
+template class CPS::EMT::CompanionModelBatch<3>;
+template class CPS::EMT::CompanionModelPreStepBatch<1>;
+template class CPS::EMT::CompanionModelPreStepBatch<3>;
+template class CPS::EMT::CompanionModelPostStepBatch<1>;
+template class CPS::EMT::CompanionModelPostStepBatch<3>;
@@ -52,15 +52,13 @@ void EMT::Ph1::Capacitor::mnaCompInitialize(Real omega, Real timeStep, Attribute
 	mEquivCurrent = -(**mIntfCurrent)(0,0) + -mEquivCond * (**mIntfVoltage)(0,0);
 }
 
+void EMT::Ph1::Capacitor::mnaUpdateTimeStep(Real timeStep) {
+	mEquivCond = (2.0 * **mCapacitance) / timeStep;
+}
+
 void EMT::Ph1::Capacitor::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
-	if (terminalNotGrounded(0))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond);
-	if (terminalNotGrounded(1))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), mEquivCond);
-	if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -mEquivCond);
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -mEquivCond);
-	}
+	Math::addBranchToMatrix(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+		terminalNotGrounded(0), terminalNotGrounded(1), mEquivCond);
 }
 
 void EMT::Ph1::Capacitor::mnaCompApplyRightSideVectorStamp(Matrix& rightVector) {
@@ -106,3 +104,25 @@ void EMT::Ph1::Capacitor::mnaCompUpdateVoltage(const Matrix& leftVector) {
 void EMT::Ph1::Capacitor::mnaCompUpdateCurrent(const Matrix& leftVector) {
 	(**mIntfCurrent)(0,0) = mEquivCond * (**mIntfVoltage)(0,0) + mEquivCurrent;
 }
+
+Bool EMT::Ph1::Capacitor::mnaCompHasBatchedSteps() const {
+	// Derived types could override the steps of the companion model
+	return typeid(*this) == typeid(Capacitor);
+}
+
+String EMT::Ph1::Capacitor::mnaCompBatchGroup() const {
+	return "EMT.Ph1.CompanionModel";
+}
+
+EMT::CompanionModelBatch<1>::Member EMT::Ph1::Capacitor::companionModelMember() {
+	// The equivalent current is -G * v - i
+	return { this, CompanionModelBatch<1>::CondMatrix::Constant(mEquivCond), -CompanionModelBatch<1>::CondMatrix::Constant(mEquivCond), -1., &mEquivCurrent };
+}
+
+Task::Ptr EMT::Ph1::Capacitor::mnaCompCreateBatchedPreStep(const std::vector<MNASimPowerComp<Real>*>& comps) {
+	return std::make_shared<CompanionModelPreStepBatch<1>>(CompanionModelBatch<1>::members(comps));
+}
+
+Task::Ptr EMT::Ph1::Capacitor::mnaCompCreateBatchedPostStep(const std::vector<MNASimPowerComp<Real>*>& comps, Attribute<Matrix>::Ptr leftVector) {
+	return std::make_shared<CompanionModelPostStepBatch<1>>(CompanionModelBatch<1>::members(comps), leftVector);
+}
@@ -0,0 +1,166 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/EMT/EMT_Ph1_FrequencyDependentNetworkEquivalent.h>
+
+using namespace CPS;
+
+MatrixComp EMT::Ph1::FrequencyDependentNetworkEquivalent::Model::admittance(Real omega) const {
+	MatrixComp y = constant.cast<Complex>();
+	for (std::size_t k = 0; k < poles.size(); ++k)
+		y += residues[k] / (Complex(0, omega) - poles[k]);
+	return y;
+}
+
+EMT::Ph1::FrequencyDependentNetworkEquivalent::FrequencyDependentNetworkEquivalent(String uid, String name, Logger::Level logLevel)
+	: MNASimPowerComp<Real>(uid, name, true, true, logLevel) {
+	**mIntfVoltage = Matrix::Zero(1,1);
+	**mIntfCurrent = Matrix::Zero(1,1);
+	setTerminalNumber(1);
+}
+
+SimPowerComp<Real>::Ptr EMT::Ph1::FrequencyDependentNetworkEquivalent::clone(String name) {
+	auto copy = FrequencyDependentNetworkEquivalent::make(name, mLogLevel);
+	copy->setParameters(mModel);
+	return copy;
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::setParameters(const Model& model) {
+	if (model.constant.rows() != model.constant.cols() || model.residues.size() != model.poles.size())
+		throw SystemError("Invalid network equivalent model of " + **mName);
+	for (auto& residue : model.residues) {
+		if (residue.rows() != model.constant.rows() || residue.cols() != model.constant.cols())
+			throw SystemError("Invalid network equivalent model of " + **mName);
+	}
+	mModel = model;
+	setTerminalNumber(model.ports());
+	**mIntfVoltage = Matrix::Zero(model.ports(), 1);
+	**mIntfCurrent = Matrix::Zero(model.ports(), 1);
+	mStates = MatrixComp::Zero(model.ports(), model.poles.size());
+
+	SPDLOG_LOGGER_INFO(mSLog, "Network equivalent with {} ports and {} poles", model.ports(), model.poles.size());
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::initializeFromNodesAndTerminals(Real frequency) {
+	Real omega = 2 * PI * frequency;
+	UInt ports = mModel.ports();
+	MatrixComp voltage(ports, 1);
+	for (UInt port = 0; port < ports; ++port)
+		voltage(port, 0) = initialSingleVoltage(port);
+
+	// The real signal is the sum of the phasor and its conjugate at -omega, each with half the magnitude
+	for (std::size_t k = 0; k < mModel.poles.size(); ++k) {
+		mStates.col(k) = voltage / (2. * (Complex(0, omega) - mModel.poles[k]))
+			+ voltage.conjugate() / (2. * (Complex(0, -omega) - mModel.poles[k]));
+	}
+	**mIntfVoltage = voltage.real();
+	**mIntfCurrent = (mModel.admittance(omega) * voltage).real();
+
+	SPDLOG_LOGGER_INFO(mSLog,
+		"\n--- Initialization from powerflow ---"
+		"\nVoltages: {:s}"
+		"\nCurrents: {:s}"
+		"\n--- Initialization from powerflow finished ---",
+		Logger::matrixToString(**mIntfVoltage),
+		Logger::matrixToString(**mIntfCurrent));
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::initVars(Real timeStep) {
+	UInt ports = mModel.ports();
+	mStateFactors.resize(mModel.poles.size());
+	mInputFactors.resize(mModel.poles.size());
+	MatrixComp cond = mModel.constant.cast<Complex>();
+	for (std::size_t k = 0; k < mModel.poles.size(); ++k) {
+		Complex denominator = 1. - mModel.poles[k] * timeStep / 2.;
+		mStateFactors[k] = (1. + mModel.poles[k] * timeStep / 2.) / denominator;
+		mInputFactors[k] = timeStep / 2. / denominator;
+		cond += mModel.residues[k] * mInputFactors[k];
+	}
+	// The imaginary parts of conjugate poles cancel out
+	mEquivCond = cond.real();
+	mEquivCurrent = Matrix::Zero(ports, 1);
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
+	updateMatrixNodeIndices();
+	initVars(timeStep);
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::mnaUpdateTimeStep(Real timeStep) {
+	initVars(timeStep);
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
+	UInt ports = mModel.ports();
+	for (UInt row = 0; row < ports; ++row) {
+		if (!terminalNotGrounded(row))
+			continue;
+		for (UInt col = 0; col < ports; ++col) {
+			if (terminalNotGrounded(col))
+				Math::addToMatrixElement(systemMatrix, matrixNodeIndex(row), matrixNodeIndex(col), mEquivCond(row, col));
+		}
+	}
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::mnaCompApplyRightSideVectorStamp(Matrix& rightVector) {
+	// History current of the trapezoidal rule, the current is G * v + i
+	MatrixComp history = MatrixComp::Zero(mModel.ports(), 1);
+	for (std::size_t k = 0; k < mModel.poles.size(); ++k) {
+		history += mModel.residues[k] * (mStateFactors[k] * mStates.col(k)
+			+ mInputFactors[k] * (**mIntfVoltage).cast<Complex>());
+	}
+	mEquivCurrent = history.real();
+
+	// The current flows out of the node into the equivalent
+	for (UInt port = 0; port < mModel.ports(); ++port) {
+		if (terminalNotGrounded(port))
+			Math::setVectorElement(rightVector, matrixNodeIndex(port), -mEquivCurrent(port, 0));
+	}
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
+	modifiedAttributes.push_back(mRightVector);
+	prevStepDependencies.push_back(mIntfVoltage);
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::mnaCompPreStep(Real time, Int timeStepCount) {
+	mnaCompApplyRightSideVectorStamp(**mRightVector);
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
+	attributeDependencies.push_back(leftVector);
+	modifiedAttributes.push_back(mIntfVoltage);
+	modifiedAttributes.push_back(mIntfCurrent);
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::mnaCompPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+	// The states need the voltages of the previous and the current step
+	Matrix voltage(mModel.ports(), 1);
+	updateTerminalVoltages(**leftVector, voltage);
+	MatrixComp inputs = (voltage + **mIntfVoltage).cast<Complex>();
+	for (std::size_t k = 0; k < mModel.poles.size(); ++k)
+		mStates.col(k) = mStateFactors[k] * mStates.col(k) + mInputFactors[k] * inputs;
+	**mIntfVoltage = voltage;
+	mnaCompUpdateCurrent(**leftVector);
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::updateTerminalVoltages(const Matrix& leftVector, Matrix& voltages) {
+	for (UInt port = 0; port < mModel.ports(); ++port) {
+		voltages(port, 0) = 0;
+		if (terminalNotGrounded(port))
+			voltages(port, 0) = Math::realFromVectorElement(leftVector, matrixNodeIndex(port));
+	}
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::mnaCompUpdateVoltage(const Matrix& leftVector) {
+	updateTerminalVoltages(leftVector, **mIntfVoltage);
+}
+
+void EMT::Ph1::FrequencyDependentNetworkEquivalent::mnaCompUpdateCurrent(const Matrix& leftVector) {
+	**mIntfCurrent = mEquivCond * **mIntfVoltage + mEquivCurrent;
+}
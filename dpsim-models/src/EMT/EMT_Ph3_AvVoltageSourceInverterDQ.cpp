@@ -361,8 +361,19 @@ void EMT::Ph3::AvVoltageSourceInverterDQ::mnaParentAddPreStepDependencies(Attrib
 
 void EMT::Ph3::AvVoltageSourceInverterDQ::mnaParentPreStep(Real time, Int timeStepCount) {
 	// pre-step of subcomponents - controlled source
-	if (mWithControl)
-		mSubCtrledVoltageSource->mVoltageRef->set(PEAK1PH_TO_RMS3PH * **mVsref);
+	if (mWithControl) {
+		if (mFidelity == Fidelity::SwitchingFunction) {
+			// Mean leg voltages over the step around the current time. The neutral of the
+			// filter is not connected to the DC midpoint, so the common mode is removed.
+			Matrix legVoltages(3, 1);
+			for (UInt phase = 0; phase < 3; phase++)
+				legVoltages(phase, 0) = switchedLegVoltage((**mVsref)(phase, 0), time - mTimeStep / 2., time + mTimeStep / 2.);
+			legVoltages.array() -= legVoltages.mean();
+			mSubCtrledVoltageSource->mVoltageRef->set(PEAK1PH_TO_RMS3PH * legVoltages);
+		} else {
+			mSubCtrledVoltageSource->mVoltageRef->set(PEAK1PH_TO_RMS3PH * **mVsref);
+		}
+	}
 
 	std::dynamic_pointer_cast<MNAInterface>(mSubCtrledVoltageSource)->mnaPreStep(time, timeStepCount);
 	// pre-step of component itself
@@ -176,7 +176,7 @@ void EMT::Ph3::RXLoad::mnaParentAddPreStepDependencies(AttributeBase::List &prev
 	modifiedAttributes.push_back(mRightVector);
 };
 
-void EMT::Ph3::RXLoad::mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
+void EMT::Ph3::RXLoad::mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
 	attributeDependencies.push_back(leftVector);
 	modifiedAttributes.push_back(mIntfCurrent);
 	modifiedAttributes.push_back(mIntfVoltage);
@@ -186,7 +186,7 @@ void EMT::Ph3::RXLoad::mnaParentPreStep(Real time, Int timeStepCount) {
 	mnaCompApplyRightSideVectorStamp(**mRightVector);
 }
 
-void EMT::Ph3::RXLoad::mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+void EMT::Ph3::RXLoad::mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
 	mnaCompUpdateVoltage(**leftVector);
 	mnaCompUpdateCurrent(**leftVector);
 }
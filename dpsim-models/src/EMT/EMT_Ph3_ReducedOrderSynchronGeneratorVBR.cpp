@@ -33,15 +33,19 @@ void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::initializeResistanceMatrix() {
 	mResistanceMatrixDq0 <<	0.0,	mA,		0.0,
 							mB,		0.0,	0.0,
 					  		0.0,	0.0,	mL0;
+	mConductanceMatrixDq0 = mResistanceMatrixDq0.inverse();
 
 	// initialize conductance matrix
 	mConductanceMatrix = MatrixFixedSize<3, 3>::Zero(3,3);
+	mStampedConductanceMatrix = MatrixFixedSize<3, 3>::Zero(3,3);
+	mNortonCurrent = MatrixFixedSize<3, 1>::Zero(3,1);
 }
 
 void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::calculateResistanceMatrix() {
-	MatrixFixedSize<3, 3> resistanceMatrix =  mDq0ToAbc * mResistanceMatrixDq0 * mAbcToDq0;
-	resistanceMatrix = resistanceMatrix * mBase_Z;
-	mConductanceMatrix = resistanceMatrix.inverse();
+	// The park transforms are inverse to each other, so the inverse of
+	// mDq0ToAbc * mResistanceMatrixDq0 * mAbcToDq0 * mBase_Z follows from the
+	// dq0 conductance matrix computed once at initialization
+	mConductanceMatrix = mDq0ToAbc * mConductanceMatrixDq0 * mAbcToDq0 / mBase_Z;
 }
 
 void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaCompInitialize(Real omega,
@@ -49,6 +53,17 @@ void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaCompInitialize(Real omega,
 
 	Base::ReducedOrderSynchronGenerator<Real>::mnaCompInitialize(omega, timeStep, leftVector);
 
+	// The part of the dq block which is invariant to rotations of the dq frame
+	// gives a conductance matrix that does not depend on the rotor angle
+	MatrixFixedSize<3, 3> constantResistanceMatrixDq0 = mResistanceMatrixDq0;
+	Real diagonal = (mResistanceMatrixDq0(0,0) + mResistanceMatrixDq0(1,1)) / 2.;
+	Real offDiagonal = (mResistanceMatrixDq0(0,1) - mResistanceMatrixDq0(1,0)) / 2.;
+	constantResistanceMatrixDq0(0,0) = diagonal;
+	constantResistanceMatrixDq0(0,1) = offDiagonal;
+	constantResistanceMatrixDq0(1,0) = -offDiagonal;
+	constantResistanceMatrixDq0(1,1) = diagonal;
+	mConstantConductanceMatrix = get_inverseParkTransformMatrix() * constantResistanceMatrixDq0.inverse() * get_parkTransformMatrix() / mBase_Z;
+
 	if (mModelAsCurrentSource) {
 		mVariableSystemMatrixEntries.push_back(std::make_pair<UInt,UInt>(matrixNodeIndex(0, 0), matrixNodeIndex(0, 0)));
 		mVariableSystemMatrixEntries.push_back(std::make_pair<UInt,UInt>(matrixNodeIndex(0, 0), matrixNodeIndex(0, 1)));
@@ -113,15 +128,17 @@ void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaCompApplySystemMatrixStamp(S
 
 	if (mModelAsCurrentSource) {
 		// Stamp conductance matrix
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mConductanceMatrix(0, 0));
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 1), mConductanceMatrix(0, 1));
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 2), mConductanceMatrix(0, 2));
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 1), matrixNodeIndex(0, 0), mConductanceMatrix(1, 0));
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 1), matrixNodeIndex(0, 1), mConductanceMatrix(1, 1));
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 1), matrixNodeIndex(0, 2), mConductanceMatrix(1, 2));
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 2), matrixNodeIndex(0, 0), mConductanceMatrix(2, 0));
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 2), matrixNodeIndex(0, 1), mConductanceMatrix(2, 1));
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 2), matrixNodeIndex(0, 2), mConductanceMatrix(2, 2));
+		const MatrixFixedSize<3, 3>& conductanceMatrix = hasConstantConductance() ? mConstantConductanceMatrix : mStampedConductanceMatrix;
+		mStampOutdated = false;
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), conductanceMatrix(0, 0));
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 1), conductanceMatrix(0, 1));
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 2), conductanceMatrix(0, 2));
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 1), matrixNodeIndex(0, 0), conductanceMatrix(1, 0));
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 1), matrixNodeIndex(0, 1), conductanceMatrix(1, 1));
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 1), matrixNodeIndex(0, 2), conductanceMatrix(1, 2));
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 2), matrixNodeIndex(0, 0), conductanceMatrix(2, 0));
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 2), matrixNodeIndex(0, 1), conductanceMatrix(2, 1));
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 2), matrixNodeIndex(0, 2), conductanceMatrix(2, 2));
 	}
 	else {
 		// Stamp voltage source
@@ -184,9 +201,23 @@ void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaCompApplyRightSideVectorStam
 		// compute equivalent northon circuit in abc reference frame
 		mIvbr = mConductanceMatrix * mEvbr;
 
-		Math::setVectorElement(rightVector, matrixNodeIndex(0,0), mIvbr(0, 0));
-		Math::setVectorElement(rightVector, matrixNodeIndex(0,1), mIvbr(1, 0));
-		Math::setVectorElement(rightVector, matrixNodeIndex(0,2), mIvbr(2, 0));
+		if (hasConstantConductance()) {
+			// predict the correction with the terminal voltage of the previous step
+			mNortonCurrent = correctedNortonCurrent(**mIntfVoltage);
+		}
+		else {
+			// the system matrix is only updated if the conductance matrix changed significantly,
+			// the remaining deviation is compensated with the terminal voltage of the previous step
+			if (isParameterChangeSignificant(mStampedConductanceMatrix, mConductanceMatrix)) {
+				mStampedConductanceMatrix = mConductanceMatrix;
+				mStampOutdated = true;
+			}
+			mNortonCurrent = mIvbr - (mConductanceMatrix - mStampedConductanceMatrix) * **mIntfVoltage;
+		}
+
+		Math::setVectorElement(rightVector, matrixNodeIndex(0,0), mNortonCurrent(0, 0));
+		Math::setVectorElement(rightVector, matrixNodeIndex(0,1), mNortonCurrent(1, 0));
+		Math::setVectorElement(rightVector, matrixNodeIndex(0,2), mNortonCurrent(2, 0));
 	}
 	else {
 		Math::setVectorElement(rightVector, mVirtualNodes[1]->matrixNodeIndex(PhaseType::A), mEvbr(0, 0));
@@ -195,6 +226,25 @@ void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaCompApplyRightSideVectorStam
 	}
 }
 
+MatrixFixedSize<3, 1> EMT::Ph3::ReducedOrderSynchronGeneratorVBR::correctedNortonCurrent(const Matrix& voltage) const {
+	return mIvbr - (mConductanceMatrix - mConstantConductanceMatrix) * voltage;
+}
+
+Bool EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaCorrectorStep(const Matrix& leftVector) {
+	MatrixFixedSize<3, 1> voltage;
+	voltage <<	Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 0)),
+				Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 1)),
+				Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 2));
+	MatrixFixedSize<3, 1> current = correctedNortonCurrent(voltage);
+
+	Real change = 0;
+	for (UInt phase = 0; phase < 3; ++phase) {
+		change = std::max(change, std::abs(current(phase, 0) - Math::realFromVectorElement(**mRightVector, matrixNodeIndex(0, phase))));
+		Math::setVectorElement(**mRightVector, matrixNodeIndex(0, phase), current(phase, 0));
+	}
+	return change <= mCorrectorTolerance * mBase_I;
+}
+
 void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaCompPostStep(const Matrix& leftVector) {
 	// update armature voltage
 	(**mIntfVoltage)(0, 0) = Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 0));
@@ -206,8 +256,12 @@ void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaCompPostStep(const Matrix& l
 
 	// update armature current
 	if (mModelAsCurrentSource) {
-		Matrix Iconductance = mConductanceMatrix * **mIntfVoltage;
-		(**mIntfCurrent) = mIvbr - Iconductance;
+		if (hasConstantConductance()) {
+			MatrixFixedSize<3, 1> Iconductance = mConductanceMatrix * **mIntfVoltage;
+			(**mIntfCurrent) = mIvbr - Iconductance;
+		}
+		else
+			(**mIntfCurrent) = mNortonCurrent - mStampedConductanceMatrix * **mIntfVoltage;
 	}
 	else {
 		(**mIntfCurrent)(0, 0) = Math::realFromVectorElement(leftVector, mVirtualNodes[1]->matrixNodeIndex(PhaseType::A));
@@ -219,8 +273,8 @@ void EMT::Ph3::ReducedOrderSynchronGeneratorVBR::mnaCompPostStep(const Matrix& l
 	**mIdq0 =  mAbcToDq0 * **mIntfCurrent / mBase_I;
 }
 
-Matrix EMT::Ph3::ReducedOrderSynchronGeneratorVBR::get_parkTransformMatrix() const {
-	Matrix abcToDq0(3, 3);
+MatrixFixedSize<3, 3> EMT::Ph3::ReducedOrderSynchronGeneratorVBR::get_parkTransformMatrix() const {
+	MatrixFixedSize<3, 3> abcToDq0;
 
 	abcToDq0 <<
 		2./3.*cos(**mThetaMech),  2./3.*cos(**mThetaMech - 2.*PI/3.),  2./3.*cos(**mThetaMech + 2.*PI/3.),
@@ -230,8 +284,8 @@ Matrix EMT::Ph3::ReducedOrderSynchronGeneratorVBR::get_parkTransformMatrix() con
 	return abcToDq0;
 }
 
-Matrix EMT::Ph3::ReducedOrderSynchronGeneratorVBR::get_inverseParkTransformMatrix() const {
-	Matrix dq0ToAbc(3, 3);
+MatrixFixedSize<3, 3> EMT::Ph3::ReducedOrderSynchronGeneratorVBR::get_inverseParkTransformMatrix() const {
+	MatrixFixedSize<3, 3> dq0ToAbc;
 
 	dq0ToAbc <<
 		cos(**mThetaMech), 		    -sin(**mThetaMech), 		     1.,
@@ -100,7 +100,7 @@ void EMT::Ph3::RxLine::mnaParentAddPreStepDependencies(AttributeBase::List &prev
 	modifiedAttributes.push_back(mRightVector);
 };
 
-void EMT::Ph3::RxLine::mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
+void EMT::Ph3::RxLine::mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
 	attributeDependencies.push_back(leftVector);
 	modifiedAttributes.push_back(mIntfCurrent);
 	modifiedAttributes.push_back(mIntfVoltage);
@@ -110,7 +110,7 @@ void EMT::Ph3::RxLine::mnaParentPreStep(Real time, Int timeStepCount) {
 	mnaCompApplyRightSideVectorStamp(**mRightVector);
 }
 
-void EMT::Ph3::RxLine::mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+void EMT::Ph3::RxLine::mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
 	mnaCompUpdateVoltage(**leftVector);
 	mnaCompUpdateCurrent(**leftVector);
 }
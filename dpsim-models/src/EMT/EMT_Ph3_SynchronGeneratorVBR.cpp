@@ -220,22 +220,21 @@ void EMT::Ph3::SynchronGeneratorVBR::mnaCompInitialize(Real omega, Real timeStep
 	mDVq = mDVqd(0);
 	mDVd = mDVqd(1);
 
-	mDVa = inverseParkTransform(mThetaMech, mDVq, mDVd, 0)(0);
-	mDVb = inverseParkTransform(mThetaMech, mDVq, mDVd, 0)(1);
-	mDVc = inverseParkTransform(mThetaMech, mDVq, mDVd, 0)(2);
-
-	mDVabc <<
-		mDVa,
-		mDVb,
-		mDVc;
-
-	mVa = inverseParkTransform(mThetaMech, mVq, mVd, mV0)(0);
-	mVb = inverseParkTransform(mThetaMech, mVq, mVd, mV0)(1);
-	mVc = inverseParkTransform(mThetaMech, mVq, mVd, mV0)(2);
-
-	mIa = inverseParkTransform(mThetaMech, mIq, mId, mI0)(0);
-	mIb = inverseParkTransform(mThetaMech, mIq, mId, mI0)(1);
-	mIc = inverseParkTransform(mThetaMech, mIq, mId, mI0)(2);
+	// mKrs_teta_inv was evaluated for mThetaMech by CalculateAuxiliarVariables
+	mDVabc = mKrs_teta_inv * MatrixFixedSize<3, 1>(mDVq, mDVd, 0);
+	mDVa = mDVabc(0);
+	mDVb = mDVabc(1);
+	mDVc = mDVabc(2);
+
+	const MatrixFixedSize<3, 1> vabc = mKrs_teta_inv * MatrixFixedSize<3, 1>(mVq, mVd, mV0);
+	mVa = vabc(0);
+	mVb = vabc(1);
+	mVc = vabc(2);
+
+	const MatrixFixedSize<3, 1> iabc = mKrs_teta_inv * MatrixFixedSize<3, 1>(mIq, mId, mI0);
+	mIa = iabc(0);
+	mIb = iabc(1);
+	mIc = iabc(2);
 
 	CalculateL();
 
@@ -318,10 +317,11 @@ void EMT::Ph3::SynchronGeneratorVBR::stepInPerUnit() {
 	R_eq_vbr = mResistanceMat + (2 / (mTimeStep*mBase_OmElec))*mDInductanceMat + K;
 	E_eq_vbr = mEsh_vbr + E_r_vbr;
 
-	MatrixFixedSize<3, 3> R_eq_vbr_mBase_Z = R_eq_vbr*mBase_Z;
+	// Closed-form 3x3 inverse, reused for the stator currents in the post step
+	R_eq_vbr_inv = R_eq_vbr.inverse();
 
-	mConductanceMat = R_eq_vbr_mBase_Z.inverse();
-	mISourceEq = R_eq_vbr.inverse()*E_eq_vbr*mBase_I;
+	mConductanceMat = R_eq_vbr_inv / mBase_Z;
+	mISourceEq = R_eq_vbr_inv*E_eq_vbr*mBase_I;
 }
 
 void EMT::Ph3::SynchronGeneratorVBR::mnaCompPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
@@ -341,9 +341,11 @@ void EMT::Ph3::SynchronGeneratorVBR::mnaCompPostStep(Real time, Int timeStepCoun
 		mVb,
 		mVc;
 
-	mVq = parkTransform(mThetaMech, mVa, mVb, mVc)(0);
-	mVd = parkTransform(mThetaMech, mVa, mVb, mVc)(1);
-	mV0 = parkTransform(mThetaMech, mVa, mVb, mVc)(2);
+	// mKrs_teta and mKrs_teta_inv were evaluated for mThetaMech in the pre step
+	const MatrixFixedSize<3, 1> vdq0 = mKrs_teta * mVabc;
+	mVq = vdq0(0);
+	mVd = vdq0(1);
+	mV0 = vdq0(2);
 
 	if (mHasExciter){
 		// Get exciter output voltage
@@ -351,7 +353,7 @@ void EMT::Ph3::SynchronGeneratorVBR::mnaCompPostStep(Real time, Int timeStepCoun
 		// to the synchronous generator pu system
 		mVfd = (mRfd / mLmd)*mExciter->step(mVd, mVq, mTimeStep);
 	}
-	mIabc = R_eq_vbr.inverse()*(mVabc - E_eq_vbr);
+	mIabc = R_eq_vbr_inv*(mVabc - E_eq_vbr);
 
 	mIa = mIabc(0);
 	mIb = mIabc(1);
@@ -360,9 +362,10 @@ void EMT::Ph3::SynchronGeneratorVBR::mnaCompPostStep(Real time, Int timeStepCoun
 	mIq_hist = mIq;
 	mId_hist = mId;
 
-	mIq = parkTransform(mThetaMech, mIa, mIb, mIc)(0);
-	mId = parkTransform(mThetaMech, mIa, mIb, mIc)(1);
-	mI0 = parkTransform(mThetaMech, mIa, mIb, mIc)(2);
+	const MatrixFixedSize<3, 1> idq0 = mKrs_teta * mIabc;
+	mIq = idq0(0);
+	mId = idq0(1);
+	mI0 = idq0(2);
 
 	// Calculate rotor flux likanges
 	if (mNumDampingWindings == 2) {
@@ -408,13 +411,10 @@ void EMT::Ph3::SynchronGeneratorVBR::mnaCompPostStep(Real time, Int timeStepCoun
 	mDVq = mDVqd(0);
 	mDVd = mDVqd(1);
 
-	mDVa = inverseParkTransform(mThetaMech, mDVq, mDVd, 0)(0);
-	mDVb = inverseParkTransform(mThetaMech, mDVq, mDVd, 0)(1);
-	mDVc = inverseParkTransform(mThetaMech, mDVq, mDVd, 0)(2);
-	mDVabc <<
-		mDVa,
-		mDVb,
-		mDVc;
+	mDVabc = mKrs_teta_inv * MatrixFixedSize<3, 1>(mDVq, mDVd, 0);
+	mDVa = mDVabc(0);
+	mDVb = mDVabc(1);
+	mDVc = mDVabc(2);
 
 	**mIntfVoltage = mVabc*mBase_V;
 	**mIntfCurrent = mIabc*mBase_I;
@@ -428,10 +428,15 @@ void EMT::Ph3::SynchronGeneratorVBR::mnaCompAddPostStepDependencies(AttributeBas
 }
 
 void EMT::Ph3::SynchronGeneratorVBR::CalculateL() {
+	// cos(2*theta -+ 4*PI/3) equals cos(2*theta +- 2*PI/3)
+	const Real cos2Theta = cos(2 * mThetaMech);
+	const Real cos2ThetaMinus = cos(2 * mThetaMech - 2 * PI / 3);
+	const Real cos2ThetaPlus = cos(2 * mThetaMech + 2 * PI / 3);
+
 	mDInductanceMat <<
-		**mLl + mLa - mLb*cos(2 * mThetaMech), -mLa / 2 - mLb*cos(2 * mThetaMech - 2 * PI / 3), -mLa / 2 - mLb*cos(2 * mThetaMech + 2 * PI / 3),
-		-mLa / 2 - mLb*cos(2 * mThetaMech - 2 * PI / 3), **mLl + mLa - mLb*cos(2 * mThetaMech - 4 * PI / 3), -mLa / 2 - mLb*cos(2 * mThetaMech),
-		-mLa / 2 - mLb*cos(2 * mThetaMech + 2 * PI / 3), -mLa / 2 - mLb*cos(2 * mThetaMech), **mLl + mLa - mLb*cos(2 * mThetaMech + 4 * PI / 3);
+		**mLl + mLa - mLb*cos2Theta, -mLa / 2 - mLb*cos2ThetaMinus, -mLa / 2 - mLb*cos2ThetaPlus,
+		-mLa / 2 - mLb*cos2ThetaMinus, **mLl + mLa - mLb*cos2ThetaPlus, -mLa / 2 - mLb*cos2Theta,
+		-mLa / 2 - mLb*cos2ThetaPlus, -mLa / 2 - mLb*cos2Theta, **mLl + mLa - mLb*cos2ThetaMinus;
 }
 
 void EMT::Ph3::SynchronGeneratorVBR::CalculateAuxiliarConstants(Real dt) {
@@ -550,15 +555,24 @@ void EMT::Ph3::SynchronGeneratorVBR::CalculateAuxiliarVariables() {
 		K1, K2, Matrix::Zero(2, 1),
 		0, 0, 0;
 
+	// Shifted angles from a single evaluation of cos and sin of the rotor angle
+	const Real cosTheta = cos(mThetaMech);
+	const Real sinTheta = sin(mThetaMech);
+	const Real halfSqrt3 = sqrt(3.) / 2.;
+	const Real cosThetaMinus = -0.5 * cosTheta + halfSqrt3 * sinTheta;
+	const Real sinThetaMinus = -0.5 * sinTheta - halfSqrt3 * cosTheta;
+	const Real cosThetaPlus = -0.5 * cosTheta - halfSqrt3 * sinTheta;
+	const Real sinThetaPlus = -0.5 * sinTheta + halfSqrt3 * cosTheta;
+
 	mKrs_teta <<
-		2. / 3. * cos(mThetaMech), 2. / 3. * cos(mThetaMech - 2. * M_PI / 3.), 2. / 3. * cos(mThetaMech + 2. * M_PI / 3.),
-		2. / 3. * sin(mThetaMech), 2. / 3. * sin(mThetaMech - 2. * M_PI / 3.), 2. / 3. * sin(mThetaMech + 2. * M_PI / 3.),
+		2. / 3. * cosTheta, 2. / 3. * cosThetaMinus, 2. / 3. * cosThetaPlus,
+		2. / 3. * sinTheta, 2. / 3. * sinThetaMinus, 2. / 3. * sinThetaPlus,
 		1. / 3., 1. / 3., 1. / 3.;
 
 	mKrs_teta_inv <<
-		cos(mThetaMech), sin(mThetaMech), 1.,
-		cos(mThetaMech - 2. * M_PI / 3.), sin(mThetaMech - 2. * M_PI / 3.), 1,
-		cos(mThetaMech + 2. * M_PI / 3.), sin(mThetaMech + 2. * M_PI / 3.), 1.;
+		cosTheta, sinTheta, 1.,
+		cosThetaMinus, sinThetaMinus, 1,
+		cosThetaPlus, sinThetaPlus, 1.;
 
 	K = mKrs_teta_inv*K*mKrs_teta;
 
@@ -573,9 +587,9 @@ void EMT::Ph3::SynchronGeneratorVBR::CalculateAuxiliarVariables() {
 	E_r_vbr = mKrs_teta_inv*H_qdr;
 }
 
-Matrix EMT::Ph3::SynchronGeneratorVBR::parkTransform(Real theta, Real a, Real b, Real c) {
+MatrixFixedSize<3, 1> EMT::Ph3::SynchronGeneratorVBR::parkTransform(Real theta, Real a, Real b, Real c) {
 
-	Matrix dq0vector(3, 1);
+	MatrixFixedSize<3, 1> dq0vector;
 
 	Real q, d, zero;
 
@@ -590,9 +604,9 @@ Matrix EMT::Ph3::SynchronGeneratorVBR::parkTransform(Real theta, Real a, Real b,
 	return dq0vector;
 }
 
-Matrix EMT::Ph3::SynchronGeneratorVBR::inverseParkTransform(Real theta, Real q, Real d, Real zero) {
+MatrixFixedSize<3, 1> EMT::Ph3::SynchronGeneratorVBR::inverseParkTransform(Real theta, Real q, Real d, Real zero) {
 
-	Matrix abcVector(3, 1);
+	MatrixFixedSize<3, 1> abcVector;
 
 	Real a, b, c;
 
@@ -0,0 +1,119 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <dpsim-models/LoadProfileStream.h>
+
+using namespace CPS;
+
+LoadProfileStream::LoadProfileStream(const fs::path& file, Bool hhmmss, Bool skipFirstRow, UInt windowRows) :
+	mFile(file), mHHMMSS(hhmmss), mWindowRows(windowRows > 0 ? windowRows : 1) {
+	if (!mFile.is_open())
+		throw SystemError("Cannot open load profile " + file.string());
+
+	// Ignore the first row if it is a title
+	if (skipFirstRow && std::isdigit(mFile.peek()) == 0) {
+		String title;
+		std::getline(mFile, title);
+	}
+
+	readChunk();
+	if (mTimes.empty())
+		throw SystemError("Load profile " + file.string() + " contains no data");
+}
+
+Bool LoadProfileStream::parseRow(const String& line, Real& time, PQData& values) {
+	const char* cursor = line.c_str();
+	while (std::isspace(*cursor))
+		++cursor;
+	if (*cursor == '\0')
+		return false;
+
+	char* end;
+	if (mHHMMSS) {
+		int hh, mm, ss = 0;
+		time = (std::sscanf(cursor, "%d:%d:%d", &hh, &mm, &ss) >= 2) ? hh * 3600 + mm * 60 + ss : 0;
+		end = const_cast<char*>(std::strchr(cursor, ','));
+		if (!end)
+			return false;
+	} else {
+		time = std::strtod(cursor, &end);
+	}
+
+	// Values follow the time, separated by commas
+	Real columns[2];
+	UInt count = 0;
+	while (count < 2 && *end == ',') {
+		columns[count++] = std::strtod(end + 1, &end);
+		while (std::isspace(*end))
+			++end;
+	}
+	if (count == 0)
+		return false;
+
+	if (count == 1) {
+		mWeightingFactors = true;
+		values = { columns[0], 0 };
+	} else {
+		// Multiplied by 1000 due to unit conversion (kW to W)
+		values = { columns[0] * 1000, columns[1] * 1000 };
+	}
+	return true;
+}
+
+Bool LoadProfileStream::readChunk() {
+	if (mEndOfFile)
+		return false;
+
+	String line;
+	UInt rows = 0;
+	while (rows < mWindowRows && std::getline(mFile, line)) {
+		Real time;
+		PQData values;
+		if (!parseRow(line, time, values))
+			continue;
+		mTimes.push_back(time);
+		mValues.push_back(values);
+		++rows;
+	}
+	if (!mFile)
+		mEndOfFile = true;
+	return rows > 0;
+}
+
+PQData LoadProfileStream::interpolate(Real time) {
+	// Prefetch until a row at or after the requested time is buffered
+	while (mTimes.back() < time && readChunk()) { }
+
+	// Keep the last row before the requested time for the interpolation
+	while (mTimes.size() > 1 && mTimes[1] <= time) {
+		mTimes.pop_front();
+		mValues.pop_front();
+	}
+
+	if (time <= mTimes.front() || mTimes.size() == 1)
+		return mValues.front();
+
+	const Real delta = (time - mTimes[0]) / (mTimes[1] - mTimes[0]);
+	return {
+		delta * mValues[1].p + (1 - delta) * mValues[0].p,
+		delta * mValues[1].q + (1 - delta) * mValues[0].q
+	};
+}
+
+PQData LoadProfileStream::pq(Real time) {
+	return interpolate(time);
+}
+
+Real LoadProfileStream::weightingFactor(Real time) {
+	return interpolate(time).p;
+}
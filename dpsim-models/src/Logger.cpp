@@ -7,7 +7,9 @@
  *********************************************************************************/
 
 #include <memory>
+#include <fstream>
 #include <iomanip>
+#include <mutex>
 
 #include <spdlog/sinks/null_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -27,27 +29,95 @@ void Logger::setLogPattern(std::shared_ptr<spdlog::logger> logger, std::string p
 }
 
 // #### to string methods ####
+namespace {
+	UInt sMatrixLogLimit = 10000;
+	UInt sMatrixDumpLimit = 0;
+
+	Bool exceedsLogLimit(Eigen::Index rows, Eigen::Index cols) {
+		return sMatrixLogLimit > 0 && rows * cols > static_cast<Eigen::Index>(sMatrixLogLimit);
+	}
+
+	String sizeOnly(Eigen::Index rows, Eigen::Index cols) {
+		return fmt::format("\n<{}x{} matrix, larger than the matrix log limit>", rows, cols);
+	}
+
+	template <typename SparseType>
+	void writeMatrixMarket(const String& name, const SparseType& mat) {
+		if (sMatrixDumpLimit == 0 || mat.nonZeros() > static_cast<Eigen::Index>(sMatrixDumpLimit))
+			return;
+
+		fs::path p = Logger::logDir() + "/" + name + ".mtx";
+		if (p.has_parent_path() && !fs::exists(p.parent_path()))
+			fs::create_directories(p.parent_path());
+
+		std::ofstream file(p.string());
+		file << "%%MatrixMarket matrix coordinate real general\n"
+			<< mat.rows() << " " << mat.cols() << " " << mat.nonZeros() << "\n";
+		file << std::setprecision(17);
+		for (Eigen::Index outer = 0; outer < mat.outerSize(); ++outer) {
+			for (typename SparseType::InnerIterator it(mat, outer); it; ++it)
+				file << it.row() + 1 << " " << it.col() + 1 << " " << it.value() << "\n";
+		}
+	}
+}
+
+void Logger::setMatrixLogLimit(UInt entries) {
+	sMatrixLogLimit = entries;
+}
+
+UInt Logger::matrixLogLimit() {
+	return sMatrixLogLimit;
+}
+
+void Logger::setMatrixDumpLimit(UInt nonZeros) {
+	sMatrixDumpLimit = nonZeros;
+}
+
+void Logger::dumpMatrix(const String& name, const SparseMatrix& mat) {
+	writeMatrixMarket(name, mat);
+}
+
+void Logger::dumpMatrix(const String& name, const SparseMatrixRow& mat) {
+	writeMatrixMarket(name, mat);
+}
+
+void Logger::dumpMatrix(const String& name, const Matrix& mat) {
+	if (sMatrixDumpLimit == 0 || mat.size() > static_cast<Eigen::Index>(sMatrixDumpLimit))
+		return;
+	dumpMatrix(name, SparseMatrix(mat.sparseView()));
+}
+
 String Logger::matrixToString(const Matrix& mat) {
+	if (exceedsLogLimit(mat.rows(), mat.cols()))
+		return sizeOnly(mat.rows(), mat.cols());
 	std::stringstream ss;
 	ss << std::scientific << "\n" << mat;
 	return ss.str();
 }
 
 String Logger::matrixCompToString(const MatrixComp& mat) {
+	if (exceedsLogLimit(mat.rows(), mat.cols()))
+		return sizeOnly(mat.rows(), mat.cols());
 	std::stringstream ss;
 	ss << std::scientific << "\n" << mat;
 	return ss.str();
 }
 
 String Logger::sparseMatrixToString(const SparseMatrix& mat) {
+	if (exceedsLogLimit(mat.rows(), mat.cols()))
+		return sizeOnly(mat.rows(), mat.cols());
 	return matrixToString(Matrix(mat));
 }
 
 String Logger::sparseMatrixCompToString(const SparseMatrixComp& mat) {
+	if (exceedsLogLimit(mat.rows(), mat.cols()))
+		return sizeOnly(mat.rows(), mat.cols());
 	return matrixCompToString(MatrixComp(mat));
 }
 
 String Logger::phasorMatrixToString(const MatrixComp& mat) {
+	if (exceedsLogLimit(mat.rows(), mat.cols()))
+		return sizeOnly(mat.rows(), mat.cols());
 	std::stringstream ss;
 	ss << std::scientific << Math::abs(mat) << "\n\n" << Math::phase(mat);
 	return ss.str();
@@ -136,6 +206,10 @@ String Logger::getCSVLineFromData(Real time, const MatrixComp& data) {
 }
 
 Logger::Log Logger::get(const std::string &name, Level filelevel, Level clilevel) {
+	// Components may be created concurrently, e.g. by the CIM reader
+	static std::mutex mutex;
+	std::lock_guard<std::mutex> lock(mutex);
+
 	Logger::Log logger = spdlog::get(name);
 
 	if (!logger) {
@@ -14,9 +14,34 @@ Attribute<Matrix>::Ptr MNASimPowerComp<VarType>::getRightVector() const {
 	return mRightVector;
 }
 
+template<>
+Bool MNASimPowerComp<Real>::mnaRightVectorStampRows(std::vector<UInt>& rows) {
+	this->collectMatrixNodeIndices(rows);
+	return true;
+}
+
+template<>
+Bool MNASimPowerComp<Complex>::mnaRightVectorStampRows(std::vector<UInt>& rows) {
+	std::vector<UInt> nodeIndices;
+	this->collectMatrixNodeIndices(nodeIndices);
+
+	// Same layout as Math::setVectorElement: real and imaginary part per frequency block
+	UInt numFreqs = mNumFreqs > 0 ? mNumFreqs : 1;
+	UInt harmonicOffset = static_cast<UInt>((**mRightVector).rows()) / numFreqs;
+	UInt complexOffset = harmonicOffset / 2;
+	for (UInt freq = 0; freq < numFreqs; ++freq) {
+		for (auto index : nodeIndices) {
+			rows.push_back(index + freq * harmonicOffset);
+			rows.push_back(index + freq * harmonicOffset + complexOffset);
+		}
+	}
+	return true;
+}
+
 template<typename VarType>
 void MNASimPowerComp<VarType>::mnaInitialize(Real omega, Real timeStep) {
 	mMnaTasks.clear();
+	mSeparateOutputStep = false;
 }
 
 template<typename VarType>
@@ -24,11 +49,18 @@ void MNASimPowerComp<VarType>::mnaInitialize(Real omega, Real timeStep, Attribut
 	mMnaTasks.clear();
 	**this->mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 
+	AttributeBase::List outputDependencies, outputs;
+	this->mnaCompAddOutputStepDependencies(outputDependencies, outputs, leftVector);
+	mSeparateOutputStep = !outputs.empty() && !mMergeOutputStep;
+
 	if (mHasPreStep) {
-		this->mMnaTasks.push_back(std::make_shared<typename MNASimPowerComp<VarType>::MnaPreStep>(*this));
+		this->mMnaTasks.push_back(MNASimPowerComp<VarType>::MnaPreStep::make(*this));
 	}
 	if (mHasPostStep) {
-		this->mMnaTasks.push_back(std::make_shared<typename MNASimPowerComp<VarType>::MnaPostStep>(*this, leftVector));
+		this->mMnaTasks.push_back(MNASimPowerComp<VarType>::MnaPostStep::make(*this, leftVector));
+	}
+	if (mSeparateOutputStep) {
+		this->mMnaTasks.push_back(MNASimPowerComp<VarType>::MnaOutputStep::make(*this, leftVector));
 	}
 
 	this->mnaCompInitialize(omega, timeStep, leftVector);
@@ -37,6 +69,7 @@ void MNASimPowerComp<VarType>::mnaInitialize(Real omega, Real timeStep, Attribut
 template<typename VarType>
 void MNASimPowerComp<VarType>::mnaInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVector) {
 	mMnaTasks.clear();
+	mSeparateOutputStep = false;
 	this->mnaCompInitializeHarm(omega, timeStep, leftVector);
 }
 
@@ -69,6 +102,14 @@ void MNASimPowerComp<VarType>::mnaPreStep(Real time, Int timeStepCount) {
 template<typename VarType>
 void MNASimPowerComp<VarType>::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
 	this->mnaCompPostStep(time, timeStepCount, leftVector);
+	if (!mSeparateOutputStep)
+		this->mnaCompOutputStep(time, timeStepCount, leftVector);
+};
+
+template<typename VarType>
+void MNASimPowerComp<VarType>::mnaOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+	if (mSeparateOutputStep)
+		this->mnaCompOutputStep(time, timeStepCount, leftVector);
 };
 
 template<typename VarType>
@@ -79,6 +120,8 @@ void MNASimPowerComp<VarType>::mnaAddPreStepDependencies(AttributeBase::List &pr
 template<typename VarType>
 void MNASimPowerComp<VarType>::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
 	this->mnaCompAddPostStepDependencies(prevStepDependencies, attributeDependencies, modifiedAttributes, leftVector);
+	if (!mSeparateOutputStep)
+		this->mnaCompAddOutputStepDependencies(attributeDependencies, modifiedAttributes, leftVector);
 };
 
 template<typename VarType>
@@ -141,6 +184,16 @@ void MNASimPowerComp<VarType>::mnaCompAddPostStepDependencies(AttributeBase::Lis
 	// Empty default implementation. Can be overridden by child classes if desired.
 }
 
+template<typename VarType>
+void MNASimPowerComp<VarType>::mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+	// Empty default implementation. Can be overridden by child classes if desired.
+}
+
+template<typename VarType>
+void MNASimPowerComp<VarType>::mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
+	// Empty default implementation. Can be overridden by child classes if desired.
+}
+
 template<typename VarType>
 void MNASimPowerComp<VarType>::mnaCompInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVector) {
 	// Empty default implementation. Can be overridden by child classes if desired.
@@ -161,6 +214,27 @@ void MNASimPowerComp<VarType>::mnaCompApplyRightSideVectorStampHarm(Matrix& sour
 	// Empty default implementation. Can be overridden by child classes if desired.
 }
 
+template<typename VarType>
+Bool MNASimPowerComp<VarType>::mnaCompHasBatchedSteps() const {
+	// Components execute their steps individually by default
+	return false;
+}
+
+template<typename VarType>
+String MNASimPowerComp<VarType>::mnaCompBatchGroup() const {
+	return typeid(*this).name();
+}
+
+template<typename VarType>
+Task::Ptr MNASimPowerComp<VarType>::mnaCompCreateBatchedPreStep(const std::vector<MNASimPowerComp<VarType>*>& comps) {
+	return nullptr;
+}
+
+template<typename VarType>
+Task::Ptr MNASimPowerComp<VarType>::mnaCompCreateBatchedPostStep(const std::vector<MNASimPowerComp<VarType>*>& comps, Attribute<Matrix>::Ptr leftVector) {
+	return nullptr;
+}
+
 // Declare specializations to move definitions to .cpp
 template class CPS::MNASimPowerComp<Real>;
 template class CPS::MNASimPowerComp<Complex>;
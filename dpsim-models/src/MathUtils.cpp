@@ -7,9 +7,115 @@
  *********************************************************************************/
 
 #include <dpsim-models/MathUtils.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <sstream>
 
 using namespace CPS;
 
+// #### Stamp Slots ####
+MatrixStampSlots*& MatrixStampSlots::active() {
+	thread_local MatrixStampSlots* slots = nullptr;
+	return slots;
+}
+
+void MatrixStampSlots::record(SparseMatrixRow& mat) {
+	mMode = Mode::Record;
+	mTarget = &mat;
+	mElements.clear();
+	mSlots.clear();
+	mValid = false;
+	active() = this;
+}
+
+void MatrixStampSlots::replay(SparseMatrixRow& mat) {
+	mMode = Mode::Replay;
+	mTarget = &mat;
+	mCursor = 0;
+	active() = this;
+}
+
+void MatrixStampSlots::stop() {
+	if (mMode == Mode::Record) {
+		// Positions are only stable once all elements are inserted
+		mTarget->makeCompressed();
+		const auto* outer = mTarget->outerIndexPtr();
+		const auto* inner = mTarget->innerIndexPtr();
+		for (auto& element : mElements) {
+			const auto* begin = inner + outer[element.first];
+			const auto* end = inner + outer[element.first + 1];
+			mSlots.push_back(std::lower_bound(begin, end, element.second) - inner);
+		}
+		mValid = true;
+	}
+	else if (mMode == Mode::Replay && mCursor != mElements.size()) {
+		mValid = false;
+	}
+	mMode = Mode::Idle;
+	mTarget = nullptr;
+	if (active() == this)
+		active() = nullptr;
+}
+
+Real& MatrixStampSlots::element(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column) {
+	if (&mat == mTarget) {
+		if (mMode == Mode::Record) {
+			mElements.push_back(std::make_pair(row, column));
+		}
+		else if (mMode == Mode::Replay) {
+			if (mCursor < mElements.size()
+				&& mElements[mCursor].first == row && mElements[mCursor].second == column)
+				return mat.valuePtr()[mSlots[mCursor++]];
+
+			// Sequence differs from recording, coeffRef may insert and move the recorded positions
+			mValid = false;
+			mMode = Mode::Idle;
+		}
+	}
+	return mat.coeffRef(row, column);
+}
+
+// #### Lookup Tables ####
+LookupTable::LookupTable(std::function<Real(Real)> fcn, Real min, Real max, Real tolerance, UInt maxPoints)
+	: mFcn(std::move(fcn)), mMin(min), mMax(max) {
+
+	if (!(max > min))
+		throw SystemError("Invalid range of lookup table");
+
+	// Double the number of intervals until the error at the midpoints is small enough
+	for (UInt intervals = 16; ; intervals *= 2) {
+		Real step = (mMax - mMin) / intervals;
+		mValues.resize(intervals + 1);
+		for (UInt i = 0; i <= intervals; ++i)
+			mValues[i] = mFcn(mMin + i * step);
+
+		mMaxError = 0;
+		for (UInt i = 0; i < intervals; ++i) {
+			Real midValue = mFcn(mMin + (i + 0.5) * step);
+			mMaxError = std::max(mMaxError, std::abs(midValue - 0.5 * (mValues[i] + mValues[i + 1])));
+		}
+
+		mInvStep = 1. / step;
+		if (mMaxError <= tolerance || 2 * intervals + 1 > maxPoints)
+			break;
+	}
+}
+
+LookupTable::Ptr LookupTable::shared(const String& name, std::function<Real(Real)> fcn, Real min, Real max, Real tolerance) {
+	static std::mutex mutex;
+	static std::map<String, Ptr> tables;
+
+	std::ostringstream key;
+	key << name << ":" << min << ":" << max << ":" << tolerance;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto& table = tables[key.str()];
+	if (!table)
+		table = std::make_shared<const LookupTable>(std::move(fcn), min, max, tolerance);
+	return table;
+}
+
 // #### Angular Operations ####
 Real Math::radtoDeg(Real rad) {
 	return rad * 180 / PI;
@@ -110,10 +216,10 @@ void Math::setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Ind
 	Eigen::Index harmRow = row + harmonicOffset * freqIdx;
 	Eigen::Index harmCol = column + harmonicOffset * freqIdx;
 
-	mat.coeffRef(harmRow, harmCol) = value.real();
-	mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) = value.real();
-	mat.coeffRef(harmRow, harmCol + complexOffset) = - value.imag();
-	mat.coeffRef(harmRow + complexOffset, harmCol) = value.imag();
+	matrixElement(mat, harmRow, harmCol) = value.real();
+	matrixElement(mat, harmRow + complexOffset, harmCol + complexOffset) = value.real();
+	matrixElement(mat, harmRow, harmCol + complexOffset) = - value.imag();
+	matrixElement(mat, harmRow + complexOffset, harmCol) = value.imag();
 }
 
 void Math::addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq, Int freqIdx) {
@@ -123,43 +229,50 @@ void Math::addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::I
 	Eigen::Index harmRow = row + harmonicOffset * freqIdx;
 	Eigen::Index harmCol = column + harmonicOffset * freqIdx;
 
-	mat.coeffRef(harmRow, harmCol) += value.real();
-	mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) += value.real();
-	mat.coeffRef(harmRow, harmCol + complexOffset) -= value.imag();
-	mat.coeffRef(harmRow + complexOffset, harmCol) += value.imag();
+	matrixElement(mat, harmRow, harmCol) += value.real();
+	matrixElement(mat, harmRow + complexOffset, harmCol + complexOffset) += value.real();
+	matrixElement(mat, harmRow, harmCol + complexOffset) -= value.imag();
+	matrixElement(mat, harmRow + complexOffset, harmCol) += value.imag();
 }
 
-void Math::addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Matrix value, Int maxFreq, Int freqIdx) {
+void Math::addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, const Matrix& value, Int maxFreq, Int freqIdx) {
 	// Assume square matrix
 	Eigen::Index harmonicOffset = mat.rows() / maxFreq;
 	Eigen::Index complexOffset = harmonicOffset / 2;
 	Eigen::Index harmRow = row + harmonicOffset * freqIdx;
 	Eigen::Index harmCol = column + harmonicOffset * freqIdx;
 
-	mat.coeffRef(harmRow, harmCol) += value(0,0);
-	mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) += value(1,1);
-	mat.coeffRef(harmRow, harmCol + complexOffset) += value(0,1);
-	mat.coeffRef(harmRow + complexOffset, harmCol) += value(1,0);
+	matrixElement(mat, harmRow, harmCol) += value(0,0);
+	matrixElement(mat, harmRow + complexOffset, harmCol + complexOffset) += value(1,1);
+	matrixElement(mat, harmRow, harmCol + complexOffset) += value(0,1);
+	matrixElement(mat, harmRow + complexOffset, harmCol) += value(1,0);
 }
 
 void Math::setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value) {
-	mat.coeffRef(row, column) =  value;
+	matrixElement(mat, row, column) = value;
 }
 
-void Math::addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Complex value) {
+void Math::addToMatrixElement(SparseMatrixRow& mat, const std::vector<UInt>& rows, const std::vector<UInt>& columns, Complex value) {
 	for (UInt phase = 0; phase < rows.size(); phase++)
 		addToMatrixElement(mat, rows[phase], columns[phase], value);
 }
 
 void Math::addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value) {
-	mat.coeffRef(row, column) = mat.coeff(row, column) + value;
+	matrixElement(mat, row, column) += value;
 }
 
-void Math::addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Real value) {
+void Math::addToMatrixElement(SparseMatrixRow& mat, const std::vector<UInt>& rows, const std::vector<UInt>& columns, Real value) {
 	for (UInt phase = 0; phase < rows.size(); phase++)
 		addToMatrixElement(mat, rows[phase], columns[phase], value);
 }
 
+Real& Math::matrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column) {
+	MatrixStampSlots* slots = MatrixStampSlots::active();
+	if (slots)
+		return slots->element(mat, row, column);
+	return mat.coeffRef(row, column);
+}
+
 void Math::invertMatrix(const Matrix& mat, Matrix& matInv) {
 	const Int n = Eigen::internal::convert_index<Int>(mat.cols());
 	if(n == 2)
@@ -288,6 +401,18 @@ Real Math::StateSpaceTrapezoidal(Real states, Real A, Real B, Real dt, Real u) {
 	return F2inv * F1*states + F2inv * dt*B*u;
 }
 
+void Math::StateSpaceTrapezoidalMatrices(const Matrix& A, Real dt, Matrix& stateMatrix, Matrix& inputMatrix) {
+	Matrix::Index n = A.rows();
+	Matrix I = Matrix::Identity(n, n);
+
+	Matrix F1 = I + (dt/2.) * A;
+	Matrix F2 = I - (dt/2.) * A;
+	Matrix F2inv = F2.inverse();
+
+	stateMatrix = F2inv*F1;
+	inputMatrix = F2inv*(dt/2.);
+}
+
 Matrix Math::StateSpaceEuler(Matrix states, Matrix A, Matrix B, Real dt, Matrix u) {
 	return states + dt * ( A*states + B*u );
 }
@@ -296,6 +421,10 @@ Real Math::StateSpaceEuler(Real states, Real A, Real B, Real dt, Real u) {
 	return states + dt * ( A*states + B*u );
 }
 
+Real Math::StateSpaceImplicitEuler(Real states, Real A, Real B, Real dt, Real u) {
+	return (states + dt * B * u) / (1. - dt * A);
+}
+
 Matrix Math::StateSpaceEuler(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u) {
 	return states + dt * ( A*states + B*u + C );
 }
@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim-models/MatpowerReader.h>
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include <dpsim-models/SP/SP_Ph1_Load.h>
+#include <dpsim-models/SP/SP_Ph1_NetworkInjection.h>
+#include <dpsim-models/SP/SP_Ph1_PiLine.h>
+#include <dpsim-models/SP/SP_Ph1_SynchronGenerator.h>
+#include <dpsim-models/SP/SP_Ph1_Transformer.h>
+
+using namespace CPS;
+
+namespace {
+	// Columns of the MATPOWER case format
+	enum BusColumn { BUS_I = 0, BUS_TYPE = 1, PD = 2, QD = 3, VM = 7, BASE_KV = 9, BUS_COLUMNS = 13 };
+	enum GenColumn { GEN_BUS = 0, PG = 1, QMAX = 3, VG = 5, PMAX = 8, GEN_COLUMNS = 10 };
+	enum BranchColumn { F_BUS = 0, T_BUS = 1, BR_R = 2, BR_X = 3, BR_B = 4, TAP = 8, BRANCH_COLUMNS = 11 };
+
+	/// Parses the rows of a matrix, separated by semicolons or line breaks
+	Matrix parseMatrix(const String& text, const String& field) {
+		std::vector<std::vector<Real>> rows(1);
+		const char* pos = text.c_str();
+		while (*pos) {
+			if (*pos == ';' || *pos == '\n') {
+				if (!rows.back().empty())
+					rows.emplace_back();
+				++pos;
+			} else if (std::isspace(static_cast<unsigned char>(*pos)) || *pos == ',') {
+				++pos;
+			} else {
+				char* end;
+				Real value = std::strtod(pos, &end);
+				if (end == pos)
+					throw SystemError("Invalid value in field " + field + " of the MATPOWER case.");
+				rows.back().push_back(value);
+				pos = end;
+			}
+		}
+		if (rows.back().empty())
+			rows.pop_back();
+
+		Matrix matrix = Matrix::Zero(rows.size(), rows.empty() ? 0 : rows[0].size());
+		for (std::size_t r = 0; r < rows.size(); ++r) {
+			if (rows[r].size() != static_cast<std::size_t>(matrix.cols()))
+				throw SystemError("Row " + std::to_string(r + 1) + " of field " + field + " of the MATPOWER case has "
+					+ std::to_string(rows[r].size()) + " instead of " + std::to_string(matrix.cols()) + " columns.");
+			for (std::size_t c = 0; c < rows[r].size(); ++c)
+				matrix(r, c) = rows[r][c];
+		}
+		return matrix;
+	}
+
+	String busName(Real bus) {
+		return std::to_string(static_cast<long long>(bus));
+	}
+}
+
+MatpowerReader::MatpowerReader(String name, Logger::Level logLevel, Logger::Level componentLogLevel)
+	: mSLog(Logger::get(name, logLevel)), mComponentLogLevel(componentLogLevel) { }
+
+MatpowerReader::Case MatpowerReader::readCase(const fs::path& file) {
+	std::ifstream input(file);
+	if (!input)
+		throw SystemError("Cannot open MATPOWER case " + file.string());
+
+	// Comments start with a percent sign, which does not occur in the numeric fields
+	String text;
+	String line;
+	String variable = "mpc";
+	while (std::getline(input, line)) {
+		line = line.substr(0, line.find('%'));
+		std::istringstream words(line);
+		String word, name, assignment;
+		if (words >> word && word == "function" && words >> name >> assignment && assignment == "=")
+			variable = name;
+		text += line + '\n';
+	}
+
+	Case data;
+	Bool hasBus = false, hasGen = false, hasBranch = false;
+	String prefix = variable + ".";
+	for (std::size_t pos = text.find(prefix); pos != String::npos; pos = text.find(prefix, pos)) {
+		if (pos > 0 && (std::isalnum(static_cast<unsigned char>(text[pos - 1])) || text[pos - 1] == '_')) {
+			pos += prefix.size();
+			continue;
+		}
+		std::size_t nameEnd = pos + prefix.size();
+		while (nameEnd < text.size() && (std::isalnum(static_cast<unsigned char>(text[nameEnd])) || text[nameEnd] == '_'))
+			++nameEnd;
+		String field = text.substr(pos + prefix.size(), nameEnd - pos - prefix.size());
+		std::size_t valueStart = text.find_first_not_of(" \t\r\n", nameEnd);
+		pos = nameEnd;
+		if (valueStart == String::npos || text[valueStart] != '=')
+			continue;
+		valueStart = text.find_first_not_of(" \t\r\n", valueStart + 1);
+		if (valueStart == String::npos)
+			break;
+
+		if (text[valueStart] == '[') {
+			std::size_t valueEnd = text.find(']', valueStart);
+			if (valueEnd == String::npos)
+				throw SystemError("Field " + field + " of MATPOWER case " + file.string() + " is not closed.");
+			pos = valueEnd + 1;
+			if (field != "bus" && field != "gen" && field != "branch")
+				continue;
+			Matrix matrix = parseMatrix(text.substr(valueStart + 1, valueEnd - valueStart - 1), field);
+			if (field == "bus") {
+				data.bus = matrix;
+				hasBus = true;
+			} else if (field == "gen") {
+				data.gen = matrix;
+				hasGen = true;
+			} else {
+				data.branch = matrix;
+				hasBranch = true;
+			}
+		} else if (field == "baseMVA") {
+			data.baseMVA = std::strtod(text.c_str() + valueStart, nullptr);
+		}
+	}
+	if (!hasBus || !hasGen || !hasBranch)
+		throw SystemError("MATPOWER case " + file.string() + " lacks the bus, gen or branch field.");
+
+	SPDLOG_LOGGER_INFO(mSLog, "Read MATPOWER case {} with {} buses, {} generators and {} branches",
+		file.string(), data.bus.rows(), data.gen.rows(), data.branch.rows());
+	return data;
+}
+
+SystemTopology MatpowerReader::createSystem(const Case& data) {
+	if ((data.bus.rows() > 0 && data.bus.cols() < BUS_COLUMNS)
+		|| (data.gen.rows() > 0 && data.gen.cols() < GEN_COLUMNS)
+		|| (data.branch.rows() > 0 && data.branch.cols() < BRANCH_COLUMNS))
+		throw SystemError("A MATPOWER case requires at least 13 bus, 10 generator and 11 branch columns.");
+
+	const Real mwW = 1e6;
+	const Real kvV = 1e3;
+	const Real omega = 2 * PI * mFrequency;
+
+	SystemTopology system(mFrequency);
+	system.mNodes.reserve(data.bus.rows());
+	system.mComponents.reserve(data.bus.rows() + data.branch.rows());
+
+	std::unordered_map<long long, Eigen::Index> busRows;
+	for (Eigen::Index r = 0; r < data.bus.rows(); ++r)
+		busRows[static_cast<long long>(data.bus(r, BUS_I))] = r;
+	// Nodes are added in the order of their first connection, buses without any are left out
+	std::unordered_map<long long, SimNode<Complex>::Ptr> nodes;
+	auto node = [&](long long bus) {
+		auto& entry = nodes[bus];
+		if (!entry) {
+			entry = SimNode<Complex>::make(std::to_string(bus), PhaseType::Single);
+			system.mNodes.push_back(entry);
+		}
+		return entry;
+	};
+	// The first generator of a bus sets its parameters
+	std::unordered_map<long long, Eigen::Index> genRows;
+	for (Eigen::Index r = 0; r < data.gen.rows(); ++r)
+		genRows.emplace(static_cast<long long>(data.gen(r, GEN_BUS)), r);
+
+	auto genRow = [&](long long bus) {
+		auto gen = genRows.find(bus);
+		if (gen == genRows.end())
+			throw SystemError("Bus " + std::to_string(bus) + " of the MATPOWER case has no generator.");
+		return gen->second;
+	};
+	auto busRow = [&](Real bus) {
+		auto row = busRows.find(static_cast<long long>(bus));
+		if (row == busRows.end())
+			throw SystemError("Branch of the MATPOWER case connects the unknown bus " + busName(bus) + ".");
+		return row->second;
+	};
+
+	// Bus types: 1 = PQ, 2 = PV, 3 = reference, 4 = isolated
+	UInt loads = 0, generators = 0, injections = 0;
+	for (Eigen::Index r = 0; r < data.bus.rows(); ++r) {
+		long long bus = static_cast<long long>(data.bus(r, BUS_I));
+		Int type = static_cast<Int>(data.bus(r, BUS_TYPE));
+		Real baseVoltage = data.bus(r, BASE_KV) * kvV;
+
+		if (type == 1) {
+			auto load = SP::Ph1::Load::make("load" + std::to_string(++loads), mComponentLogLevel);
+			load->setParameters(data.bus(r, PD) * mwW, data.bus(r, QD) * mwW, baseVoltage);
+			load->modifyPowerFlowBusType(PowerflowBusType::PQ);
+			load->connect({ node(bus) });
+			system.mComponents.push_back(load);
+		} else if (type == 2) {
+			Eigen::Index g = genRow(bus);
+			auto gen = SP::Ph1::SynchronGenerator::make("gen" + std::to_string(++generators), mComponentLogLevel);
+			gen->setParameters(std::abs(Complex(data.gen(g, PMAX), data.gen(g, QMAX))), baseVoltage,
+				data.gen(g, PG) * mwW, data.gen(g, VG) * baseVoltage, PowerflowBusType::PV);
+			gen->setBaseVoltage(baseVoltage);
+			gen->connect({ node(bus) });
+			system.mComponents.push_back(gen);
+		} else if (type == 3) {
+			Eigen::Index g = genRow(bus);
+			auto extnet = SP::Ph1::NetworkInjection::make("extnet" + std::to_string(++injections), mComponentLogLevel);
+			extnet->setParameters(data.gen(g, VG) * baseVoltage);
+			extnet->setBaseVoltage(baseVoltage);
+			extnet->modifyPowerFlowBusType(PowerflowBusType::VD);
+			extnet->connect({ node(bus) });
+			system.mComponents.push_back(extnet);
+		} else if (type == 4) {
+			SPDLOG_LOGGER_DEBUG(mSLog, "Bus {} is isolated", bus);
+		} else {
+			throw SystemError("Bus " + std::to_string(bus) + " of the MATPOWER case has the unknown type " + std::to_string(type) + ".");
+		}
+	}
+
+	// The impedances are referred to the base voltage of the to bus
+	UInt lines = 0, transformers = 0;
+	for (Eigen::Index r = 0; r < data.branch.rows(); ++r) {
+		Eigen::Index from = busRow(data.branch(r, F_BUS));
+		Eigen::Index to = busRow(data.branch(r, T_BUS));
+		String ends = busName(data.branch(r, F_BUS)) + "-" + busName(data.branch(r, T_BUS));
+		Real fromBaseVoltage = data.bus(from, BASE_KV) * kvV;
+		Real toBaseVoltage = data.bus(to, BASE_KV) * kvV;
+		Real baseImpedance = toBaseVoltage * toBaseVoltage / (data.baseMVA * mwW);
+		Real resistance = data.branch(r, BR_R) * baseImpedance;
+		Real inductance = data.branch(r, BR_X) * baseImpedance / omega;
+		auto fromNode = node(static_cast<long long>(data.branch(r, F_BUS)));
+		auto toNode = node(static_cast<long long>(data.branch(r, T_BUS)));
+
+		Real tap = data.branch(r, TAP);
+		if (tap == 0) {
+			auto line = SP::Ph1::PiLine::make("line" + std::to_string(++lines) + "_" + ends, mComponentLogLevel);
+			line->setParameters(resistance, inductance, data.branch(r, BR_B) / baseImpedance / omega, 0);
+			line->setBaseVoltage(toBaseVoltage);
+			line->connect({ fromNode, toNode });
+			system.mComponents.push_back(line);
+		} else {
+			Real primaryVoltage = data.bus(from, VM) * fromBaseVoltage / tap;
+			Real secondaryVoltage = data.bus(to, VM) * toBaseVoltage;
+			Real ratio = primaryVoltage / secondaryVoltage;
+			auto transformer = SP::Ph1::Transformer::make("transformer" + std::to_string(++transformers) + "_" + ends, mComponentLogLevel);
+			transformer->setParameters(primaryVoltage, secondaryVoltage, std::abs(ratio), std::arg(Complex(ratio, 0)),
+				resistance, inductance);
+			transformer->setBaseVoltage(toBaseVoltage);
+			transformer->connect({ fromNode, toNode });
+			system.mComponents.push_back(transformer);
+		}
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "Created {} loads, {} generators, {} network injections, {} lines and {} transformers",
+		loads, generators, injections, lines, transformers);
+	return system;
+}
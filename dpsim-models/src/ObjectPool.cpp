@@ -0,0 +1,54 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+
+#include <dpsim-models/ObjectPool.h>
+
+using namespace CPS;
+
+static thread_local ObjectPool::Ptr sCurrentPool;
+
+ObjectPool::Scope::Scope(Ptr pool) : mPrevious(sCurrentPool) {
+	sCurrentPool = std::move(pool);
+}
+
+ObjectPool::Scope::~Scope() {
+	sCurrentPool = std::move(mPrevious);
+}
+
+ObjectPool::Ptr ObjectPool::current() {
+	return sCurrentPool;
+}
+
+void* ObjectPool::allocate(std::size_t bytes, std::size_t alignment, std::type_index type) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	Arena& arena = mArenas[type];
+
+	std::size_t padding = arena.next ? (alignment - reinterpret_cast<std::uintptr_t>(arena.next) % alignment) % alignment : 0;
+	if (!arena.next || padding + bytes > arena.remaining) {
+		// Objects larger than a chunk get a chunk of their own
+		std::size_t size = std::max(mChunkSize, bytes + alignment);
+		arena.chunks.push_back(std::unique_ptr<std::byte[]>(new std::byte[size]));
+		arena.next = arena.chunks.back().get();
+		arena.remaining = size;
+		mReservedBytes += size;
+		padding = (alignment - reinterpret_cast<std::uintptr_t>(arena.next) % alignment) % alignment;
+	}
+
+	std::byte* memory = arena.next + padding;
+	arena.next = memory + bytes;
+	arena.remaining -= padding + bytes;
+	return memory;
+}
+
+std::size_t ObjectPool::reservedBytes() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mReservedBytes;
+}
@@ -0,0 +1,75 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <numeric>
+
+#include <dpsim-models/PowerProfile.h>
+
+using namespace CPS;
+
+void PowerProfile::sort() {
+	if (std::is_sorted(times.begin(), times.end()))
+		return;
+
+	std::vector<std::size_t> order(times.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+		[this](std::size_t a, std::size_t b) { return times[a] < times[b]; });
+
+	std::vector<Real> sortedTimes;
+	std::vector<PQData> sortedPQ;
+	std::vector<Real> sortedFactors;
+	for (auto index : order) {
+		if (!sortedTimes.empty() && sortedTimes.back() == times[index])
+			continue;
+		sortedTimes.push_back(times[index]);
+		if (!pqData.empty())
+			sortedPQ.push_back(pqData[index]);
+		if (!weightingFactors.empty())
+			sortedFactors.push_back(weightingFactors[index]);
+	}
+	times = std::move(sortedTimes);
+	pqData = std::move(sortedPQ);
+	weightingFactors = std::move(sortedFactors);
+}
+
+std::size_t PowerProfile::seek(Real time, Cursor& cursor) const {
+	std::size_t index = cursor.index;
+	if (index >= times.size() || times[index] > time) {
+		// Time went backwards, search from the start
+		auto next = std::upper_bound(times.begin(), times.end(), time);
+		index = (next == times.begin()) ? 0 : static_cast<std::size_t>(next - times.begin()) - 1;
+	} else {
+		while (index + 1 < times.size() && times[index + 1] <= time)
+			++index;
+	}
+	cursor.index = index;
+	return index;
+}
+
+PQData PowerProfile::pq(Real time, Cursor& cursor) const {
+	std::size_t index = seek(time, cursor);
+	if (time <= times[index] || index + 1 == times.size())
+		return pqData[index];
+
+	const Real delta = (time - times[index]) / (times[index + 1] - times[index]);
+	return {
+		delta * pqData[index + 1].p + (1 - delta) * pqData[index].p,
+		delta * pqData[index + 1].q + (1 - delta) * pqData[index].q
+	};
+}
+
+Real PowerProfile::weightingFactor(Real time, Cursor& cursor) const {
+	std::size_t index = seek(time, cursor);
+	if (time <= times[index] || index + 1 == times.size())
+		return weightingFactors[index];
+
+	const Real delta = (time - times[index]) / (times[index + 1] - times[index]);
+	return delta * weightingFactors[index + 1] + (1 - delta) * weightingFactors[index];
+}
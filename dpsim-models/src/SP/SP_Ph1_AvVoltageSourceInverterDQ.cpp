@@ -276,8 +276,8 @@ void SP::Ph1::AvVoltageSourceInverterDQ::addControlStepDependencies(AttributeBas
 void SP::Ph1::AvVoltageSourceInverterDQ::controlStep(Real time, Int timeStepCount) {
 	// Transformation interface forward
 	Complex vcdq, ircdq;
-	vcdq = Math::rotatingFrame2to1(mVirtualNodes[3]->singleVoltage(), mPLL->attributeTyped<Matrix>("output_prev")->get()(0, 0), mThetaN);
-	ircdq = Math::rotatingFrame2to1(-1. * mSubResistorC->attributeTyped<MatrixComp>("i_intf")->get()(0, 0), mPLL->attributeTyped<Matrix>("output_prev")->get()(0, 0), mThetaN);
+	vcdq = Math::rotatingFrame2to1(mVirtualNodes[3]->singleVoltage(), (**mPLL->mOutputPrev)(0, 0), mThetaN);
+	ircdq = Math::rotatingFrame2to1(-1. * (**mSubResistorC->mIntfCurrent)(0, 0), (**mPLL->mOutputPrev)(0, 0), mThetaN);
 	**mVcd = vcdq.real();
 	**mVcq = vcdq.imag();
 	**mIrcd = ircdq.real();
@@ -288,7 +288,7 @@ void SP::Ph1::AvVoltageSourceInverterDQ::controlStep(Real time, Int timeStepCoun
 	mPowerControllerVSI->signalStep(time, timeStepCount);
 
 	// Transformation interface backward
-	(**mVsref)(0,0) = Math::rotatingFrame2to1(Complex(mPowerControllerVSI->attributeTyped<Matrix>("output_curr")->get()(0, 0), mPowerControllerVSI->attributeTyped<Matrix>("output_curr")->get()(1, 0)), mThetaN, mPLL->attributeTyped<Matrix>("output_prev")->get()(0, 0));
+	(**mVsref)(0,0) = Math::rotatingFrame2to1(Complex((**mPowerControllerVSI->mOutputCurr)(0, 0), (**mPowerControllerVSI->mOutputCurr)(1, 0)), mThetaN, (**mPLL->mOutputPrev)(0, 0));
 
 	// Update nominal system angle
 	mThetaN = mThetaN + mTimeStep * **mOmegaN;
@@ -298,8 +298,8 @@ void SP::Ph1::AvVoltageSourceInverterDQ::mnaParentAddPreStepDependencies(Attribu
 	prevStepDependencies.push_back(mVsref);
 	prevStepDependencies.push_back(mIntfCurrent);
 	prevStepDependencies.push_back(mIntfVoltage);
-	attributeDependencies.push_back(mPowerControllerVSI->attributeTyped<Matrix>("output_prev"));
-	attributeDependencies.push_back(mPLL->attributeTyped<Matrix>("output_prev"));
+	attributeDependencies.push_back(mPowerControllerVSI->mOutputPrev);
+	attributeDependencies.push_back(mPLL->mOutputPrev);
 	modifiedAttributes.push_back(mRightVector);
 }
 
@@ -326,9 +326,9 @@ void SP::Ph1::AvVoltageSourceInverterDQ::mnaParentPostStep(Real time, Int timeSt
 
 void SP::Ph1::AvVoltageSourceInverterDQ::mnaCompUpdateCurrent(const Matrix& leftvector) {
 	if (mWithConnectionTransformer)
-		**mIntfCurrent = mConnectionTransformer->attributeTyped<MatrixComp>("i_intf")->get();
+		**mIntfCurrent = **mConnectionTransformer->mIntfCurrent;
 	else
-		**mIntfCurrent = mSubResistorC->attributeTyped<MatrixComp>("i_intf")->get();
+		**mIntfCurrent = **mSubResistorC->mIntfCurrent;
 }
 
 void SP::Ph1::AvVoltageSourceInverterDQ::mnaCompUpdateVoltage(const Matrix& leftVector) {
@@ -83,11 +83,24 @@ void SP::Ph1::Load::modifyPowerFlowBusType(PowerflowBusType powerflowBusType) {
 
 
 void SP::Ph1::Load::updatePQ(Real time) {
-	if (mLoadProfile.weightingFactors.empty()) {
-		**mActivePower = mLoadProfile.pqData.find(time)->second.p;
-		**mReactivePower = mLoadProfile.pqData.find(time)->second.q;
+	if (mLoadProfileStream) {
+		if (!mLoadProfileStream->hasWeightingFactors()) {
+			PQData pq = mLoadProfileStream->pq(time);
+			**mActivePower = pq.p;
+			**mReactivePower = pq.q;
+		} else {
+			Real wf = mLoadProfileStream->weightingFactor(time);
+			**mActivePower = this->attributeTyped<Real>("P_nom")->get()*wf;
+			**mReactivePower = this->attributeTyped<Real>("Q_nom")->get()*wf;
+		}
+	} else if (mLoadProfile.empty()) {
+		return;
+	} else if (mLoadProfile.weightingFactors.empty()) {
+		PQData pq = mLoadProfile.pq(time, mLoadProfileCursor);
+		**mActivePower = pq.p;
+		**mReactivePower = pq.q;
 	} else {
-		Real wf = mLoadProfile.weightingFactors.find(time)->second;
+		Real wf = mLoadProfile.weightingFactor(time, mLoadProfileCursor);
 		///THISISBAD: P_nom and Q_nom do not exist as attributes
 		Real P_new = this->attributeTyped<Real>("P_nom")->get()*wf;
 		Real Q_new = this->attributeTyped<Real>("Q_nom")->get()*wf;
@@ -163,13 +176,13 @@ void SP::Ph1::Load::initializeFromNodesAndTerminals(Real frequency) {
 
 // #### MNA section ####
 
-void SP::Ph1::Load::mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
+void SP::Ph1::Load::mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
 	attributeDependencies.push_back(leftVector);
 	modifiedAttributes.push_back(mIntfCurrent);
 	modifiedAttributes.push_back(mIntfVoltage);
 };
 
-void SP::Ph1::Load::mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+void SP::Ph1::Load::mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
 	mnaCompUpdateVoltage(**leftVector);
 	mnaCompUpdateCurrent(**leftVector);
 }
@@ -93,16 +93,16 @@ void SP::Ph1::PiLine::calculatePerUnitParameters(Real baseApparentPower, Real ba
 	mSLog->flush();
 }
 
-void SP::Ph1::PiLine::pfApplyAdmittanceMatrixStamp(SparseMatrixCompRow & Y) {
-	int bus1 = this->matrixNodeIndex(0);
-	int bus2 = this->matrixNodeIndex(1);
+void SP::Ph1::PiLine::calculateAdmittanceElement() {
+	mY_element = MatrixComp::Zero(2, 2);
+	if (!mInService)
+		return;
 
 	//create the element admittance matrix
 	Complex y = Complex(1, 0) / Complex(mSeriesResPerUnit, 1. * mSeriesIndPerUnit);
 	Complex ys = Complex(mParallelCondPerUnit, 1. * mParallelCapPerUnit) / Complex(2, 0);
 
 	//Fill the internal matrix
-	mY_element = MatrixComp(2, 2);
 	mY_element(0, 0) = y + ys;
 	mY_element(0, 1) = -y;
 	mY_element(1, 0) = -y;
@@ -118,6 +118,14 @@ void SP::Ph1::PiLine::pfApplyAdmittanceMatrixStamp(SparseMatrixCompRow & Y) {
 				throw std::invalid_argument(ss.str());
 				std::cout << "Line>>" << this->name() << ": infinite or nan values in the element Y at: " << i << "," << j << std::endl;
 			}
+}
+
+void SP::Ph1::PiLine::pfApplyAdmittanceMatrixStamp(SparseMatrixCompRow & Y) {
+	int bus1 = this->matrixNodeIndex(0);
+	int bus2 = this->matrixNodeIndex(1);
+
+	calculateAdmittanceElement();
+	mPfAdmittanceChanged = false;
 
 	//set the circuit matrix values
 	Y.coeffRef(bus1, bus1) += mY_element.coeff(0, 0);
@@ -130,6 +138,27 @@ void SP::Ph1::PiLine::pfApplyAdmittanceMatrixStamp(SparseMatrixCompRow & Y) {
 	mSLog->flush();
 }
 
+Bool SP::Ph1::PiLine::pfApplyAdmittanceMatrixUpdate(SparseMatrixCompRow & Y) {
+	if (!mPfAdmittanceChanged)
+		return false;
+
+	MatrixComp previous = mY_element;
+	calculateAdmittanceElement();
+	mPfAdmittanceChanged = false;
+	pfStampAdmittanceDifference(Y, this->matrixNodeIndex(0), this->matrixNodeIndex(1), mY_element, previous);
+
+	SPDLOG_LOGGER_INFO(mSLog, "#### PF Y matrix update, in service: {} ####", mInService);
+	SPDLOG_LOGGER_INFO(mSLog, "{}", mY_element);
+	return true;
+}
+
+void SP::Ph1::PiLine::setInService(Bool inService) {
+	if (inService == mInService)
+		return;
+	mInService = inService;
+	mPfAdmittanceChanged = true;
+}
+
 void SP::Ph1::PiLine::updateBranchFlow(VectorComp& current, VectorComp& powerflow) {
 	**mCurrent = current * mBaseCurrent;
 	**mActivePowerBranch = powerflow.real()*mBaseApparentPower;
@@ -223,13 +252,13 @@ void SP::Ph1::PiLine::initializeFromNodesAndTerminals(Real frequency) {
 		Logger::phasorToString(mVirtualNodes[0]->initialSingleVoltage()));
 }
 
-void SP::Ph1::PiLine::mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
+void SP::Ph1::PiLine::mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
 	attributeDependencies.push_back(leftVector);
 	modifiedAttributes.push_back(mIntfVoltage);
 	modifiedAttributes.push_back(mIntfCurrent);
 }
 
-void SP::Ph1::PiLine::mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+void SP::Ph1::PiLine::mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
 	this->mnaUpdateVoltage(**leftVector);
 	this->mnaUpdateCurrent(**leftVector);
 }
@@ -191,7 +191,7 @@ void SP::Ph1::RXLine::mnaParentAddPreStepDependencies(AttributeBase::List &prevS
 	modifiedAttributes.push_back(mRightVector);
 };
 
-void SP::Ph1::RXLine::mnaParentAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
+void SP::Ph1::RXLine::mnaCompAddOutputStepDependencies(AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
 	attributeDependencies.push_back(leftVector);
 	modifiedAttributes.push_back(mIntfCurrent);
 	modifiedAttributes.push_back(mIntfVoltage);
@@ -201,7 +201,7 @@ void SP::Ph1::RXLine::mnaParentPreStep(Real time, Int timeStepCount) {
 	mnaCompApplyRightSideVectorStamp(**mRightVector);
 }
 
-void SP::Ph1::RXLine::mnaParentPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+void SP::Ph1::RXLine::mnaCompOutputStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
 	mnaCompUpdateVoltage(**leftVector);
 	mnaCompUpdateCurrent(**leftVector);
 }
@@ -48,6 +48,15 @@ void SP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaCompInitialize(Real omega,
 
 	Base::ReducedOrderSynchronGenerator<Complex>::mnaCompInitialize(omega, timeStep, leftVector);
 
+	// The part of the resistance matrix which is invariant to rotations of the dq frame
+	// does not depend on the rotor angle
+	Real diagonal = (mResistanceMatrixDq(0,0) + mResistanceMatrixDq(1,1)) / 2.;
+	Real offDiagonal = (mResistanceMatrixDq(0,1) - mResistanceMatrixDq(1,0)) / 2.;
+	Matrix constantResistanceMatrix = Matrix::Zero(2,2);
+	constantResistanceMatrix <<	diagonal,		offDiagonal,
+								-offDiagonal,	diagonal;
+	mConstantConductanceMatrix = (constantResistanceMatrix * mBase_Z).inverse();
+
 	if (mModelAsCurrentSource) {
 		mVariableSystemMatrixEntries.push_back(std::make_pair<UInt,UInt>(matrixNodeIndex(0, 0), matrixNodeIndex(0, 0)));
 	} else {
@@ -72,7 +81,8 @@ void SP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaCompApplySystemMatrixStamp(Sp
 	if (mModelAsCurrentSource) {
 		// Stamp conductance matrix
 		// set buttom right block
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mConductanceMatrix);
+		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0),
+			hasConstantConductance() ? mConstantConductanceMatrix : mConductanceMatrix);
 	}
 	else {
 		// Stamp voltage source
@@ -99,7 +109,11 @@ void SP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaCompApplyRightSideVectorStamp
 		mIvbr = Complex(mConductanceMatrix(0,0) * mEvbr.real() + mConductanceMatrix(0,1) * mEvbr.imag(),
 					    mConductanceMatrix(1,0) * mEvbr.real() + mConductanceMatrix(1,1) * mEvbr.imag());
 
-		Math::setVectorElement(rightVector, matrixNodeIndex(0,0), mIvbr);
+		if (hasConstantConductance())
+			// predict the correction with the terminal voltage of the previous step
+			Math::setVectorElement(rightVector, matrixNodeIndex(0,0), correctedNortonCurrent((**mIntfVoltage)(0, 0)));
+		else
+			Math::setVectorElement(rightVector, matrixNodeIndex(0,0), mIvbr);
 	}
 	else {
 		Math::setVectorElement(rightVector, mVirtualNodes[1]->matrixNodeIndex(), mEvbr);
@@ -130,6 +144,19 @@ void SP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaCompPostStep(const Matrix& le
 
 }
 
+Complex SP::Ph1::ReducedOrderSynchronGeneratorVBR::correctedNortonCurrent(Complex voltage) const {
+	Matrix deviation = mConductanceMatrix - mConstantConductanceMatrix;
+	return mIvbr - Complex(deviation(0,0) * voltage.real() + deviation(0,1) * voltage.imag(),
+						   deviation(1,0) * voltage.real() + deviation(1,1) * voltage.imag());
+}
+
+Bool SP::Ph1::ReducedOrderSynchronGeneratorVBR::mnaCorrectorStep(const Matrix& leftVector) {
+	Complex current = correctedNortonCurrent(Math::complexFromVectorElement(leftVector, matrixNodeIndex(0, 0)));
+	Complex change = current - Math::complexFromVectorElement(**mRightVector, matrixNodeIndex(0, 0));
+	Math::setVectorElement(**mRightVector, matrixNodeIndex(0, 0), current);
+	return std::abs(change) <= mCorrectorTolerance * mBase_I_RMS;
+}
+
 Matrix SP::Ph1::ReducedOrderSynchronGeneratorVBR::get_DqToComplexATransformMatrix() const {
 	Matrix dqToComplexA(2, 2);
 	dqToComplexA <<
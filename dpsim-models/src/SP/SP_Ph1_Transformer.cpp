@@ -227,7 +227,7 @@ void SP::Ph1::Transformer::calculatePerUnitParameters(Real baseApparentPower, Re
 		mSubSnubCapacitor2->calculatePerUnitParameters(mBaseApparentPower);
 }
 
-void SP::Ph1::Transformer::pfApplyAdmittanceMatrixStamp(SparseMatrixCompRow & Y) {
+void SP::Ph1::Transformer::calculateAdmittanceElement() {
 	// calculate matrix stamp
 	mY_element = MatrixComp(2, 2);
 	Complex y = Complex(1, 0) / mLeakagePerUnit;
@@ -248,6 +248,11 @@ void SP::Ph1::Transformer::pfApplyAdmittanceMatrixStamp(SparseMatrixCompRow & Y)
 				ss << "Transformer>>" << this->name() << ": infinite or nan values in the element Y at: " << i << "," << j;
 				throw std::invalid_argument(ss.str());
 			}
+}
+
+void SP::Ph1::Transformer::pfApplyAdmittanceMatrixStamp(SparseMatrixCompRow & Y) {
+	calculateAdmittanceElement();
+	mPfAdmittanceChanged = false;
 
 	//set the circuit matrix values
 	Y.coeffRef(this->matrixNodeIndex(0), this->matrixNodeIndex(0)) += mY_element.coeff(0, 0);
@@ -268,6 +273,28 @@ void SP::Ph1::Transformer::pfApplyAdmittanceMatrixStamp(SparseMatrixCompRow & Y)
 }
 
 
+Bool SP::Ph1::Transformer::pfApplyAdmittanceMatrixUpdate(SparseMatrixCompRow & Y) {
+	if (!mPfAdmittanceChanged)
+		return false;
+
+	// The snubber subcomponents do not depend on the tap ratio
+	MatrixComp previous = mY_element;
+	calculateAdmittanceElement();
+	mPfAdmittanceChanged = false;
+	pfStampAdmittanceDifference(Y, this->matrixNodeIndex(0), this->matrixNodeIndex(1), mY_element, previous);
+
+	SPDLOG_LOGGER_INFO(mSLog, "#### Y matrix update for tap ratio {} [pu]: {}", mRatioAbsPerUnit, mY_element);
+	return true;
+}
+
+void SP::Ph1::Transformer::setTapRatio(Real ratioAbs) {
+	**mRatio = std::polar(ratioAbs, mRatioPhase);
+	mRatioAbs = ratioAbs;
+	mRatioAbsPerUnit = mRatioAbs / **mNominalVoltageEnd1 * **mNominalVoltageEnd2;
+	mPfAdmittanceChanged = true;
+	SPDLOG_LOGGER_INFO(mSLog, "Tap Ratio={} [/] {} [pu]", mRatioAbs, mRatioAbsPerUnit);
+}
+
 void SP::Ph1::Transformer::updateBranchFlow(VectorComp& current, VectorComp& powerflow) {
 	**mCurrent = current * mBaseCurrent;
 	**mActivePowerBranch = powerflow.real()*mBaseApparentPower;
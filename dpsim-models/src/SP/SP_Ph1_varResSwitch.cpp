@@ -11,7 +11,7 @@
 using namespace CPS;
 
 SP::Ph1::varResSwitch::varResSwitch(String uid, String name, Logger::Level logLevel)
-	: MNASimPowerComp<Complex>(uid, name, false, true, logLevel), Base::Ph1::Switch(mAttributes) {
+	: MNASimPowerComp<Complex>(uid, name, true, true, logLevel), Base::Ph1::Switch(mAttributes) {
 	setTerminalNumber(2);
     **mIntfVoltage = MatrixComp::Zero(1,1);
 	**mIntfCurrent = MatrixComp::Zero(1,1);
@@ -37,24 +37,19 @@ void SP::Ph1::varResSwitch::initializeFromNodesAndTerminals(Real frequency) {
 // #### MNA functions ####
 void SP::Ph1::varResSwitch::mnaCompInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 	updateMatrixNodeIndices();
+	mStampedConductance = (**mIsClosed) ? 1. / **mClosedResistance : 1. / **mOpenResistance;
+	mCompensationCurrent = 0;
 }
 
 Bool SP::Ph1::varResSwitch::mnaIsClosed() { return isClosed(); }
 
 void SP::Ph1::varResSwitch::mnaCompApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
-	Complex conductance = (**mIsClosed) ?
-		Complex( 1. / **mClosedResistance, 0 ) : Complex( 1. / **mOpenResistance, 0 );
+	Complex conductance = Complex(mStampedConductance, 0);
+	mStampOutdated = false;
 
-	// Set diagonal entries
-	if (terminalNotGrounded(0))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), conductance);
-	if (terminalNotGrounded(1))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), conductance);
-	// Set off diagonal entries
-	if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -conductance);
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -conductance);
-	}
+	// Set diagonal and off diagonal entries
+	Math::addBranchToMatrix(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+		terminalNotGrounded(0), terminalNotGrounded(1), conductance);
 }
 
 void SP::Ph1::varResSwitch::mnaCompApplySwitchSystemMatrixStamp(Bool closed, SparseMatrixRow& systemMatrix, Int freqIdx) {
@@ -62,17 +57,9 @@ void SP::Ph1::varResSwitch::mnaCompApplySwitchSystemMatrixStamp(Bool closed, Spa
 		Complex( 1. / **mClosedResistance, 0 ) :
 		Complex( 1. / **mOpenResistance, 0 );
 
-	// Set diagonal entries
-	if (terminalNotGrounded(0))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), conductance);
-	if (terminalNotGrounded(1))
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(1), conductance);
-
-	// Set off diagonal entries
-	if (terminalNotGrounded(0) && terminalNotGrounded(1)) {
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1), -conductance);
-		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(1), matrixNodeIndex(0), -conductance);
-	}
+	// Set diagonal and off diagonal entries
+	Math::addBranchToMatrix(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(1),
+		terminalNotGrounded(0), terminalNotGrounded(1), conductance);
 
 	SPDLOG_LOGGER_INFO(mSLog, "-- Stamp ---");
 	if (terminalNotGrounded(0))
@@ -85,7 +72,33 @@ void SP::Ph1::varResSwitch::mnaCompApplySwitchSystemMatrixStamp(Bool closed, Spa
 	}
 }
 
-void SP::Ph1::varResSwitch::mnaCompApplyRightSideVectorStamp(Matrix& rightVector) {}
+void SP::Ph1::varResSwitch::mnaCompApplyRightSideVectorStamp(Matrix& rightVector) {
+	if (terminalNotGrounded(0))
+		Math::setVectorElement(rightVector, matrixNodeIndex(0), mCompensationCurrent);
+	if (terminalNotGrounded(1))
+		Math::setVectorElement(rightVector, matrixNodeIndex(1), -mCompensationCurrent);
+}
+
+void SP::Ph1::varResSwitch::mnaCompAddPreStepDependencies(AttributeBase::List &prevStepDependencies,
+	AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
+
+	prevStepDependencies.push_back(mIntfVoltage);
+	modifiedAttributes.push_back(mRightVector);
+}
+
+void SP::Ph1::varResSwitch::mnaCompPreStep(Real time, Int timeStepCount) {
+	updateResistance();
+
+	Real conductance = (**mIsClosed) ? 1. / **mClosedResistance : 1. / **mOpenResistance;
+	if (isParameterChangeSignificant(mStampedConductance, conductance)) {
+		mStampedConductance = conductance;
+		mStampOutdated = true;
+	}
+	// The remaining deviation from the stamped conductance is injected
+	// as a current source with the voltage of the previous step
+	mCompensationCurrent = (conductance - mStampedConductance) * (**mIntfVoltage)(0,0);
+	mnaApplyRightSideVectorStamp(**mRightVector);
+}
 
 void SP::Ph1::varResSwitch::mnaCompAddPostStepDependencies(AttributeBase::List &prevStepDependencies,
 	AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes,
@@ -109,12 +122,14 @@ void SP::Ph1::varResSwitch::mnaCompUpdateVoltage(const Matrix& leftVector) {
 }
 
 void SP::Ph1::varResSwitch::mnaCompUpdateCurrent(const Matrix& leftVector) {
-	(**mIntfCurrent)(0,0) = (**mIsClosed) ?
-		(**mIntfVoltage)(0,0) / **mClosedResistance :
-		(**mIntfVoltage)(0,0) / **mOpenResistance;
+	(**mIntfCurrent)(0,0) = mStampedConductance * (**mIntfVoltage)(0,0) + mCompensationCurrent;
 }
 
 Bool SP::Ph1::varResSwitch::hasParameterChanged() {
+	return mStampOutdated;
+}
+
+void SP::Ph1::varResSwitch::updateResistance() {
 //Get present state
 Bool presentState=this->mnaIsClosed();
 
@@ -143,11 +158,7 @@ if (!(mPrevState == presentState)) {
 			mPrevState= this->mnaIsClosed();
 		}
 	}
-	return 1; //recompute system matrix
 }
-else{
-	return 0; // do not recompute system matrix
-	}
 }
 
 void SP::Ph1::varResSwitch::setInitParameters(Real timestep) {
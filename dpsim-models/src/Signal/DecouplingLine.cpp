@@ -104,38 +104,44 @@ void DecouplingLine::initialize(Real omega, Real timeStep) {
 	SPDLOG_LOGGER_INFO(mSLog, "initial currents: i_km {} i_mk {}", cur1, cur2);
 
 	// Resize ring buffers and initialize
-	mVolt1.resize(mBufSize, volt1);
-	mVolt2.resize(mBufSize, volt2);
-	mCur1.resize(mBufSize, cur1);
-	mCur2.resize(mBufSize, cur2);
+	mHistory.resize(4, mBufSize);
+	mHistory.row(0).setConstant(volt1);
+	mHistory.row(1).setConstant(volt2);
+	mHistory.row(2).setConstant(cur1);
+	mHistory.row(3).setConstant(cur2);
+	mBufIdx = 0;
+
+	Real denom = (mSurgeImpedance + mResistance/4) * (mSurgeImpedance + mResistance/4);
+	mCoupledFactor = mSurgeImpedance / denom;
+	mSelfFactor = mResistance/4 / denom;
+	mHistoryImpedance = mSurgeImpedance - mResistance/4;
+	mInitConductance = 1. / (mSurgeImpedance + mResistance/4);
+	mRotation = Complex(cos(-2.*PI*50*mDelay), sin(-2.*PI*50*mDelay));
 }
 
-Complex DecouplingLine::interpolate(std::vector<Complex>& data) {
+Eigen::Matrix<Complex, 4, 1> DecouplingLine::interpolate() const {
 	// linear interpolation of the nearest values
-	Complex c1 = data[mBufIdx];
-	Complex c2 = mBufIdx == mBufSize-1 ? data[0] : data[mBufIdx+1];
-	return mAlpha * c1 + (1-mAlpha) * c2;
+	UInt nextIdx = mBufIdx == mBufSize-1 ? 0 : mBufIdx+1;
+	return mAlpha * mHistory.col(mBufIdx) + (1-mAlpha) * mHistory.col(nextIdx);
 }
 
 void DecouplingLine::step(Real time, Int timeStepCount) {
-	Complex volt1 = interpolate(mVolt1);
-	Complex volt2 = interpolate(mVolt2);
-	Complex cur1 = interpolate(mCur1);
-	Complex cur2 = interpolate(mCur2);
+	Eigen::Matrix<Complex, 4, 1> delayed = interpolate();
+	const Complex& volt1 = delayed(0);
+	const Complex& volt2 = delayed(1);
+	const Complex& cur1 = delayed(2);
+	const Complex& cur2 = delayed(3);
 
 	if (timeStepCount == 0) {
 		// bit of a hack for proper initialization
-		**mSrcCur1Ref = cur1 - volt1 / (mSurgeImpedance + mResistance / 4);
-		**mSrcCur2Ref = cur2 - volt2 / (mSurgeImpedance + mResistance / 4);
+		**mSrcCur1Ref = cur1 - volt1 * mInitConductance;
+		**mSrcCur2Ref = cur2 - volt2 * mInitConductance;
 	} else {
 		// Update currents
-		Real denom = (mSurgeImpedance + mResistance/4) * (mSurgeImpedance + mResistance/4);
-		**mSrcCur1Ref = -mSurgeImpedance / denom * (volt2 + (mSurgeImpedance - mResistance/4) * cur2)
-			- mResistance/4 / denom * (volt1 + (mSurgeImpedance - mResistance/4) * cur1);
-		**mSrcCur2Ref = -mSurgeImpedance / denom * (volt1 + (mSurgeImpedance - mResistance/4) * cur1)
-			- mResistance/4 / denom * (volt2 + (mSurgeImpedance - mResistance/4) * cur2);
-		**mSrcCur1Ref = **mSrcCur1Ref * Complex(cos(-2.*PI*50*mDelay),sin(-2.*PI*50*mDelay));
-		**mSrcCur2Ref = **mSrcCur2Ref * Complex(cos(-2.*PI*50*mDelay),sin(-2.*PI*50*mDelay));
+		Complex wave1 = volt1 + mHistoryImpedance * cur1;
+		Complex wave2 = volt2 + mHistoryImpedance * cur2;
+		**mSrcCur1Ref = (-mCoupledFactor * wave2 - mSelfFactor * wave1) * mRotation;
+		**mSrcCur2Ref = (-mCoupledFactor * wave1 - mSelfFactor * wave2) * mRotation;
 	}
 	mSrcCur1->set(**mSrcCur1Ref);
 	mSrcCur2->set(**mSrcCur2Ref);
@@ -147,10 +153,11 @@ void DecouplingLine::PreStep::execute(Real time, Int timeStepCount) {
 
 void DecouplingLine::postStep() {
 	// Update ringbuffers with new values
-	mVolt1[mBufIdx] = -mRes1->intfVoltage()(0, 0);
-	mVolt2[mBufIdx] = -mRes2->intfVoltage()(0, 0);
-	mCur1[mBufIdx] = -mRes1->intfCurrent()(0, 0) + mSrcCur1->get();
-	mCur2[mBufIdx] = -mRes2->intfCurrent()(0, 0) + mSrcCur2->get();
+	auto values = mHistory.col(mBufIdx);
+	values(0) = -mRes1->intfVoltage()(0, 0);
+	values(1) = -mRes2->intfVoltage()(0, 0);
+	values(2) = -mRes1->intfCurrent()(0, 0) + mSrcCur1->get();
+	values(3) = -mRes2->intfCurrent()(0, 0) + mSrcCur2->get();
 
 	mBufIdx++;
 	if (mBufIdx == mBufSize)
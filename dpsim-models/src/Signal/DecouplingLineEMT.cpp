@@ -69,36 +69,43 @@ void DecouplingLineEMT::initialize(Real omega, Real timeStep) {
 	SPDLOG_LOGGER_INFO(mSLog, "initial currents: i_km {} i_mk {}", cur1, cur2);
 
 	// Resize ring buffers and initialize
-	mVolt1.resize(mBufSize, volt1.real());
-	mVolt2.resize(mBufSize, volt2.real());
-	mCur1.resize(mBufSize, cur1.real());
-	mCur2.resize(mBufSize, cur2.real());
+	mHistory.resize(4, mBufSize);
+	mHistory.row(0).setConstant(volt1.real());
+	mHistory.row(1).setConstant(volt2.real());
+	mHistory.row(2).setConstant(cur1.real());
+	mHistory.row(3).setConstant(cur2.real());
+	mBufIdx = 0;
+
+	Real denom = (mSurgeImpedance + mResistance/4) * (mSurgeImpedance + mResistance/4);
+	mCoupledFactor = mSurgeImpedance / denom;
+	mSelfFactor = mResistance/4 / denom;
+	mHistoryImpedance = mSurgeImpedance - mResistance/4;
+	mInitConductance = 1. / (mSurgeImpedance + mResistance/4);
 }
 
-Real DecouplingLineEMT::interpolate(std::vector<Real>& data) {
+Eigen::Matrix<Real, 4, 1> DecouplingLineEMT::interpolate() const {
 	// linear interpolation of the nearest values
-	Real c1 = data[mBufIdx];
-	Real c2 = mBufIdx == mBufSize-1 ? data[0] : data[mBufIdx+1];
-	return mAlpha * c1 + (1-mAlpha) * c2;
+	UInt nextIdx = mBufIdx == mBufSize-1 ? 0 : mBufIdx+1;
+	return mAlpha * mHistory.col(mBufIdx) + (1-mAlpha) * mHistory.col(nextIdx);
 }
 
 void DecouplingLineEMT::step(Real time, Int timeStepCount) {
-	Real volt1 = interpolate(mVolt1);
-	Real volt2 = interpolate(mVolt2);
-	Real cur1 = interpolate(mCur1);
-	Real cur2 = interpolate(mCur2);
-	Real denom = (mSurgeImpedance + mResistance/4) * (mSurgeImpedance + mResistance/4);
+	Eigen::Matrix<Real, 4, 1> delayed = interpolate();
+	Real volt1 = delayed(0);
+	Real volt2 = delayed(1);
+	Real cur1 = delayed(2);
+	Real cur2 = delayed(3);
 
 	if (timeStepCount == 0) {
 		// initialization
-		**mSrcCur1Ref = cur1 - volt1 / (mSurgeImpedance + mResistance / 4);
-		**mSrcCur2Ref = cur2 - volt2 / (mSurgeImpedance + mResistance / 4);
+		**mSrcCur1Ref = cur1 - volt1 * mInitConductance;
+		**mSrcCur2Ref = cur2 - volt2 * mInitConductance;
 	} else {
 		// Update currents
-		**mSrcCur1Ref = -mSurgeImpedance / denom * (volt2 + (mSurgeImpedance - mResistance/4) * cur2)
-			-mResistance/4 / denom * (volt1 + (mSurgeImpedance - mResistance/4) * cur1);
-		**mSrcCur2Ref = -mSurgeImpedance / denom * (volt1 + (mSurgeImpedance - mResistance/4) * cur1)
-			-mResistance/4 / denom * (volt2 + (mSurgeImpedance - mResistance/4) * cur2);
+		Real wave1 = volt1 + mHistoryImpedance * cur1;
+		Real wave2 = volt2 + mHistoryImpedance * cur2;
+		**mSrcCur1Ref = -mCoupledFactor * wave2 - mSelfFactor * wave1;
+		**mSrcCur2Ref = -mCoupledFactor * wave1 - mSelfFactor * wave2;
 	}
 	mSrcCur1->set(**mSrcCur1Ref);
 	mSrcCur2->set(**mSrcCur2Ref);
@@ -110,10 +117,11 @@ void DecouplingLineEMT::PreStep::execute(Real time, Int timeStepCount) {
 
 void DecouplingLineEMT::postStep() {
 	// Update ringbuffers with new values
-	mVolt1[mBufIdx] = -mRes1->intfVoltage()(0,0);
-	mVolt2[mBufIdx] = -mRes2->intfVoltage()(0,0);
-	mCur1[mBufIdx] = -mRes1->intfCurrent()(0,0) + mSrcCur1->get().real();
-	mCur2[mBufIdx] = -mRes2->intfCurrent()(0,0) + mSrcCur2->get().real();
+	auto values = mHistory.col(mBufIdx);
+	values(0) = -mRes1->intfVoltage()(0,0);
+	values(1) = -mRes2->intfVoltage()(0,0);
+	values(2) = -mRes1->intfCurrent()(0,0) + mSrcCur1->get().real();
+	values(3) = -mRes2->intfCurrent()(0,0) + mSrcCur2->get().real();
 
 	mBufIdx++;
 	if (mBufIdx == mBufSize)
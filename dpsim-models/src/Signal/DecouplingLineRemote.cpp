@@ -0,0 +1,137 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/Signal/DecouplingLineRemote.h>
+
+using namespace CPS;
+using namespace CPS::DP::Ph1;
+using namespace CPS::Signal;
+
+DecouplingLineRemote::DecouplingLineRemote(String name, Logger::Level logLevel) :
+	SimSignalComp(name, name, logLevel),
+	mSrcCurRef(mAttributes->create<Complex>("i_src")),
+	mStates(mAttributes->create<Matrix>("states")) {
+
+	mRes = Resistor::make(name + "_r", logLevel);
+	mSrc = CurrentSource::make(name + "_i", logLevel);
+	mSrcCur = mSrc->mCurrentRef;
+}
+
+void DecouplingLineRemote::setParameters(SimNode<Complex>::Ptr node, Real resistance, Real inductance, Real capacitance,
+	DecouplingLineChannel::Ptr channel) {
+
+	mResistance = resistance;
+	mInductance = inductance;
+	mCapacitance = capacitance;
+	mNode = node;
+	mChannel = channel;
+
+	mSurgeImpedance = sqrt(inductance / capacitance);
+	mDelay = sqrt(inductance * capacitance);
+	SPDLOG_LOGGER_INFO(mSLog, "surge impedance: {}", mSurgeImpedance);
+	SPDLOG_LOGGER_INFO(mSLog, "delay: {}", mDelay);
+
+	mRes->setParameters(mSurgeImpedance + resistance / 4);
+	mRes->connect({node, SimNode<Complex>::GND});
+	mSrc->setParameters(0);
+	mSrc->connect({node, SimNode<Complex>::GND});
+}
+
+void DecouplingLineRemote::initialize(Real omega, Real timeStep) {
+	if (mDelay < timeStep)
+		throw SystemError("Timestep too large for decoupling");
+
+	if (mNode == nullptr || mChannel == nullptr)
+		throw SystemError("node or channel not initialized!");
+
+	mBufSize = static_cast<UInt>(ceil(mDelay / timeStep));
+	mAlpha = 1 - (mBufSize - mDelay / timeStep);
+	SPDLOG_LOGGER_INFO(mSLog, "bufsize {} alpha {}", mBufSize, mAlpha);
+
+	// Both ends compute the initial currents from the same two voltages
+	Complex volt = mNode->initialSingleVoltage();
+	mRemoteVolt = mChannel->exchangeInitialVoltage(volt);
+	Complex initAdmittance = 1. / Complex(mResistance, omega * mInductance) + Complex(0, omega * mCapacitance / 2);
+	Complex cur = volt * initAdmittance - mRemoteVolt / Complex(mResistance, omega * mInductance);
+	mRemoteCur = mRemoteVolt * initAdmittance - volt / Complex(mResistance, omega * mInductance);
+	SPDLOG_LOGGER_INFO(mSLog, "initial voltages: local {} remote {}", volt, mRemoteVolt);
+	SPDLOG_LOGGER_INFO(mSLog, "initial currents: local {} remote {}", cur, mRemoteCur);
+
+	// Resize ring buffer and initialize
+	**mStates = Matrix(4, mBufSize);
+	for (UInt k = 0; k < mBufSize; ++k)
+		(**mStates).col(k) << volt.real(), volt.imag(), cur.real(), cur.imag();
+}
+
+void DecouplingLineRemote::interpolate(Int timeStepCount, Complex& voltage, Complex& current) const {
+	// linear interpolation of the nearest values
+	const Matrix& states = **mStates;
+	UInt idx = static_cast<UInt>(timeStepCount) % mBufSize;
+	UInt next = idx == mBufSize-1 ? 0 : idx+1;
+	voltage = mAlpha * Complex(states(0, idx), states(1, idx)) + (1-mAlpha) * Complex(states(0, next), states(1, next));
+	current = mAlpha * Complex(states(2, idx), states(3, idx)) + (1-mAlpha) * Complex(states(2, next), states(3, next));
+}
+
+void DecouplingLineRemote::remoteValues(Int timeStepCount, Complex& voltage, Complex& current) {
+	if (timeStepCount < 0) {
+		voltage = mRemoteVolt;
+		current = mRemoteCur;
+	} else {
+		mChannel->receive(timeStepCount, voltage, current);
+	}
+}
+
+void DecouplingLineRemote::step(Real time, Int timeStepCount) {
+	Complex volt1, cur1;
+	interpolate(timeStepCount, volt1, cur1);
+
+	// Same interpolation as for the local ring buffers, the oldest buffered step is k - mBufSize
+	Int first = timeStepCount - static_cast<Int>(mBufSize);
+	Int second = mBufSize > 1 ? first + 1 : first;
+	Complex voltA, curA, voltB, curB;
+	remoteValues(first, voltA, curA);
+	remoteValues(second, voltB, curB);
+	Complex volt2 = mAlpha * voltA + (1-mAlpha) * voltB;
+	Complex cur2 = mAlpha * curA + (1-mAlpha) * curB;
+
+	if (timeStepCount == 0) {
+		// bit of a hack for proper initialization
+		**mSrcCurRef = cur1 - volt1 / (mSurgeImpedance + mResistance / 4);
+	} else {
+		// Update current
+		Real denom = (mSurgeImpedance + mResistance/4) * (mSurgeImpedance + mResistance/4);
+		**mSrcCurRef = -mSurgeImpedance / denom * (volt2 + (mSurgeImpedance - mResistance/4) * cur2)
+			- mResistance/4 / denom * (volt1 + (mSurgeImpedance - mResistance/4) * cur1);
+		**mSrcCurRef = **mSrcCurRef * Complex(cos(-2.*PI*50*mDelay),sin(-2.*PI*50*mDelay));
+	}
+	mSrcCur->set(**mSrcCurRef);
+}
+
+void DecouplingLineRemote::PreStep::execute(Real time, Int timeStepCount) {
+	mLine.step(time, timeStepCount);
+}
+
+void DecouplingLineRemote::postStep(Int timeStepCount) {
+	// Update ringbuffer with new values and pass them to the remote end
+	Complex volt = -mRes->intfVoltage()(0, 0);
+	Complex cur = -mRes->intfCurrent()(0, 0) + mSrcCur->get();
+	(**mStates).col(static_cast<UInt>(timeStepCount) % mBufSize) << volt.real(), volt.imag(), cur.real(), cur.imag();
+	mChannel->send(timeStepCount, volt, cur);
+}
+
+void DecouplingLineRemote::PostStep::execute(Real time, Int timeStepCount) {
+	mLine.postStep(timeStepCount);
+}
+
+Task::List DecouplingLineRemote::getTasks() {
+	return Task::List({std::make_shared<PreStep>(*this), std::make_shared<PostStep>(*this)});
+}
+
+IdentifiedObject::List DecouplingLineRemote::getLineComponents() {
+	return IdentifiedObject::List({mRes, mSrc});
+}
@@ -50,6 +50,19 @@ void Signal::Exciter::setParameters(Real Ta, Real Ka, Real Te, Real Ke,
 				mMinVr);
 }
 
+Real Signal::Exciter::ceilingFunction(Real Ef) const {
+	if (mCeilingTable)
+		return (*mCeilingTable)(Ef);
+	return Ef * (0.33 * exp(0.1 * abs(Ef)));
+}
+
+void Signal::Exciter::setCeilingFunctionTable(Real tolerance, Real maxEf) {
+	mCeilingTable = LookupTable::shared("Exciter.ceiling",
+		[](Real Ef) { return Ef * (0.33 * exp(0.1 * abs(Ef))); }, -maxEf, maxEf, tolerance);
+	SPDLOG_LOGGER_INFO(mSLog, "Ceiling function table: {} points, max. error {:e}",
+		mCeilingTable->size(), mCeilingTable->maxError());
+}
+
 void Signal::Exciter::initialize(Real Vh_init, Real Ef_init) {
 
 	SPDLOG_LOGGER_INFO(mSLog, "Initially set excitation system initial values: \n"
@@ -61,7 +74,7 @@ void Signal::Exciter::initialize(Real Vh_init, Real Ef_init) {
 
 	// mVse is the ceiling function in PSAT
 	// mVse = mEf * (0.33 * (exp(0.1 * abs(mEf)) - 1.));
-	**mVse = **mEf * (0.33 * exp(0.1 * abs(**mEf)));
+	**mVse = ceilingFunction(**mEf);
 
 	// mVis = vr2 in PSAT
 	**mVis = - mKf / mTf * **mEf;
@@ -99,25 +112,27 @@ Real Signal::Exciter::step(Real mVd, Real mVq, Real dt) {
 	mVr_prev = **mVr;
 	mEf_prev = **mEf;
 
-	// compute state variables at time k using euler forward
+	// compute state variables at time k using euler forward, or backward with the newest inputs
+	auto integrate = mImplicitIntegration ? Math::StateSpaceImplicitEuler
+		: static_cast<Real(*)(Real, Real, Real, Real, Real)>(Math::StateSpaceEuler);
 
 	// Voltage Transducer equation
-	**mVm = Math::StateSpaceEuler(mVm_prev, -1 / mTr, 1 / mTr, dt, **mVh);
+	**mVm = integrate(mVm_prev, -1 / mTr, 1 / mTr, dt, **mVh);
 
 	// Stabilizing feedback equation
 	// mVse = mEf * (0.33 * (exp(0.1 * abs(mEf)) - 1.));
-	**mVse = mEf_prev * (0.33 * exp(0.1 * abs(mEf_prev)));
-	**mVis = Math::StateSpaceEuler(mVis_prev, -1 / mTf, -mKf / mTf / mTf, dt, mEf_prev);
+	**mVse = ceilingFunction(mEf_prev);
+	**mVis = integrate(mVis_prev, -1 / mTf, -mKf / mTf / mTf, dt, mEf_prev);
 
 	// Voltage regulator equation
-	**mVr = Math::StateSpaceEuler(mVr_prev, -1 / mTa, mKa / mTa, dt, mVref - **mVm - mVis_prev - mKf / mTf * mEf_prev);
+	**mVr = integrate(mVr_prev, -1 / mTa, mKa / mTa, dt, mVref - **mVm - mVis_prev - mKf / mTf * mEf_prev);
 	if (**mVr > mMaxVr)
 		**mVr = mMaxVr;
 	else if (**mVr < mMinVr)
 		**mVr = mMinVr;
 
 	// Exciter equation
-	**mEf = Math::StateSpaceEuler(mEf_prev, - mKe / mTe, 1. / mTe, dt, mVr_prev - **mVse);
+	**mEf = integrate(mEf_prev, - mKe / mTe, 1. / mTe, dt, (mImplicitIntegration ? **mVr : mVr_prev) - **mVse);
 
 	return **mEf;
 }
@@ -26,27 +26,101 @@ FIRFilter::FIRFilter(String name, std::vector<Real> filterCoefficients, Real ini
 }
 
 void FIRFilter::initialize(Real timeStep) {
-	mSignal.assign(mFilterLength, **mInitSample);
+	// Keep a buffer that is already shared by a batch of filters
+	if (mSignal && mSignal->rows() == 2 * mFilterLength)
+		mSignal->col(mSignalColumn).setConstant(**mInitSample);
+	else {
+		mSignal = std::make_shared<Matrix>(Matrix::Constant(2 * mFilterLength, 1, **mInitSample));
+		mSignalColumn = 0;
+	}
+	mCurrentIdx = 0;
+	mStepCount = 0;
 	SPDLOG_LOGGER_INFO(mSLog, "Initialize filter with {}", **mInitSample);
 }
 
+void FIRFilter::setDecimation(UInt factor) {
+	mDecimation = factor > 0 ? static_cast<Int>(factor) : 1;
+}
+
+void FIRFilter::storeInput(Real input) {
+	(*mSignal)(mCurrentIdx, mSignalColumn) = input;
+	(*mSignal)(mCurrentIdx + mFilterLength, mSignalColumn) = input;
+}
+
+Real FIRFilter::filterWindow() const {
+	Eigen::Map<const Matrix> taps(mFilter.data(), mFilterLength, 1);
+	return mSignal->col(mSignalColumn).segment(mCurrentIdx, mFilterLength).dot(taps.col(0));
+}
+
 void FIRFilter::step(Real time) {
-	Real output = 0;
-	///CHECK: Does this copy the value or the reference of the data behind mInput? It should only copy the value.
-	mSignal[mCurrentIdx] = **mInput;
-	for (int i = 0; i < mFilterLength; i++) {
-		output += mFilter[i] * mSignal[getIndex(i)];
+	storeInput(**mInput);
+	if (mStepCount % mDecimation == 0) {
+		Real output = filterWindow();
+		**mOutput = output;
+		SPDLOG_LOGGER_DEBUG(mSLog, "Set output to {}", output);
 	}
 
+	++mStepCount;
 	incrementIndex();
-	**mOutput = output;
-	SPDLOG_LOGGER_DEBUG(mSLog, "Set output to {}", output);
 }
 
 void FIRFilter::Step::execute(Real time, Int timeStepCount) {
 	mFilter.step(time);
 }
 
+String FIRFilter::Step::batchKey() const {
+	String coefficients(reinterpret_cast<const char*>(mFilter.mFilter.data()), mFilter.mFilter.size() * sizeof(Real));
+	return "FIRFilter.Step." + std::to_string(mFilter.mFilterLength) + "." + std::to_string(mFilter.mDecimation)
+		+ "." + std::to_string(std::hash<String>()(coefficients));
+}
+
+Task::Ptr FIRFilter::Step::createBatch(const Task::List& tasks) const {
+	std::vector<FIRFilter*> filters;
+	for (auto& task : tasks) {
+		auto& filter = static_cast<Step&>(*task).mFilter;
+		// The filters have to be initialized and step in lockstep
+		if (!filter.mSignal || filter.mFilter != mFilter.mFilter
+			|| filter.mCurrentIdx != mFilter.mCurrentIdx || filter.mStepCount != mFilter.mStepCount)
+			return nullptr;
+		filters.push_back(&filter);
+	}
+	return std::make_shared<StepBatch>(filters);
+}
+
+FIRFilter::StepBatch::StepBatch(const std::vector<FIRFilter*>& filters) :
+	Task(**filters[0]->mName + ".StepBatch"), mFilters(filters) {
+	Int length = filters[0]->mFilterLength;
+	mSignal = std::make_shared<Matrix>(2 * length, filters.size());
+	for (std::size_t i = 0; i < filters.size(); ++i) {
+		auto filter = filters[i];
+		mSignal->col(i) = filter->mSignal->col(filter->mSignalColumn);
+		filter->mSignal = mSignal;
+		filter->mSignalColumn = static_cast<Int>(i);
+
+		mAttributeDependencies.push_back(filter->mInput);
+		mModifiedAttributes.push_back(filter->mOutput);
+	}
+	mTaps = Eigen::Map<const Matrix>(filters[0]->mFilter.data(), length, 1);
+	mOutputs = Matrix::Zero(filters.size(), 1);
+}
+
+void FIRFilter::StepBatch::execute(Real time, Int timeStepCount) {
+	auto first = mFilters[0];
+	for (auto filter : mFilters)
+		filter->storeInput(**filter->mInput);
+
+	if (first->mStepCount % first->mDecimation == 0) {
+		mOutputs.noalias() = mSignal->middleRows(first->mCurrentIdx, first->mFilterLength).transpose() * mTaps;
+		for (std::size_t i = 0; i < mFilters.size(); ++i)
+			**mFilters[i]->mOutput = mOutputs(i, 0);
+	}
+
+	for (auto filter : mFilters) {
+		++filter->mStepCount;
+		filter->incrementIndex();
+	}
+}
+
 Task::List FIRFilter::getTasks() {
 	return Task::List({std::make_shared<FIRFilter::Step>(*this)});
 }
@@ -55,10 +129,6 @@ void FIRFilter::incrementIndex () {
 	mCurrentIdx = (mCurrentIdx + 1) % mFilterLength;
 }
 
-Int FIRFilter::getIndex(Int index) {
-	return (mCurrentIdx + index) % mFilterLength;
-}
-
 void FIRFilter::setInput(Attribute<Real>::Ptr input) {
 	mInput = input;
 }
@@ -0,0 +1,202 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/Signal/FrequencyDependentLineEMT.h>
+
+using namespace CPS;
+using namespace CPS::EMT::Ph1;
+using namespace CPS::Signal;
+
+FrequencyDependentLineEMT::FrequencyDependentLineEMT(String name, Logger::Level logLevel) :
+	SimSignalComp(name, name, logLevel),
+	mSrcCur1Ref(mAttributes->create<Real>("i_src1")),
+	mSrcCur2Ref(mAttributes->create<Real>("i_src2")),
+	mStates(mAttributes->create<Matrix>("states")) {
+
+	mRes1 = Resistor::make(name + "_r1", logLevel);
+	mRes2 = Resistor::make(name + "_r2", logLevel);
+	mSrc1 = CurrentSource::make(name + "_i1", logLevel);
+	mSrc2 = CurrentSource::make(name + "_i2", logLevel);
+}
+
+void FrequencyDependentLineEMT::setParameters(SimNode<Real>::Ptr node1, SimNode<Real>::Ptr node2, Real delay,
+	Real ycConst, const Matrix& ycPoles, const Matrix& ycResidues,
+	const Matrix& hPoles, const Matrix& hResidues) {
+
+	if (ycPoles.rows() != ycResidues.rows() || hPoles.rows() != hResidues.rows())
+		throw SystemError("Number of poles and residues of " + **mName + " differs");
+	if ((ycPoles.array() >= 0).any() || (hPoles.array() >= 0).any())
+		throw SystemError("Poles of " + **mName + " have to be negative");
+
+	mNode1 = node1;
+	mNode2 = node2;
+	mDelay = delay;
+	mYcConst = ycConst;
+	mYcPoles = ycPoles;
+	mYcResidues = ycResidues;
+	mHPoles = hPoles;
+	mHResidues = hResidues;
+
+	SPDLOG_LOGGER_INFO(mSLog, "delay: {}", mDelay);
+	SPDLOG_LOGGER_INFO(mSLog, "poles of Yc: {}, poles of H: {}", mYcPoles.rows(), mHPoles.rows());
+
+	// The DC characteristic impedance is replaced by the conductance of the
+	// discretized model when the time step is known
+	Real dcAdmittance = mYcConst - (mYcResidues.array() / mYcPoles.array()).sum();
+	mRes1->setParameters(1. / dcAdmittance);
+	mRes1->connect({node1, SimNode<Real>::GND});
+	mRes2->setParameters(1. / dcAdmittance);
+	mRes2->connect({node2, SimNode<Real>::GND});
+	mSrc1->setParameters(0);
+	mSrc1->connect({node1, SimNode<Real>::GND});
+	mSrc2->setParameters(0);
+	mSrc2->connect({node2, SimNode<Real>::GND});
+}
+
+Matrix FrequencyDependentLineEMT::recursiveConvolutionCoeffs(const Matrix& poles, const Matrix& residues, Real timeStep) {
+	// x(t) = alpha * x(t - dt) + lambda * u(t) + mu * u(t - dt) is the exact solution
+	// of dx/dt = p * x + r * u for an input that is linear over the time step
+	Matrix coeffs(poles.rows(), 3);
+	for (Matrix::Index i = 0; i < poles.rows(); i++) {
+		Real p = poles(i, 0);
+		Real r = residues(i, 0);
+		Real alpha = exp(p * timeStep);
+		Real ramp = (alpha - 1.) / (p * p * timeStep);
+		coeffs(i, 0) = alpha;
+		coeffs(i, 1) = r * (-1. / p + ramp);
+		coeffs(i, 2) = r * (alpha / p - ramp);
+	}
+	return coeffs;
+}
+
+void FrequencyDependentLineEMT::initialize(Real omega, Real timeStep) {
+	if (mDelay < timeStep)
+		throw SystemError("Timestep too large for decoupling");
+
+	mBufSize = static_cast<UInt>(ceil(mDelay / timeStep));
+	mAlpha = 1 - (mBufSize - mDelay / timeStep);
+	SPDLOG_LOGGER_INFO(mSLog, "bufsize {} alpha {}", mBufSize, mAlpha);
+
+	mYcCoeffs = recursiveConvolutionCoeffs(mYcPoles, mYcResidues, timeStep);
+	mHCoeffs = recursiveConvolutionCoeffs(mHPoles, mHResidues, timeStep);
+	mConductance = mYcConst + mYcCoeffs.col(1).sum();
+	if (mConductance <= 0)
+		throw SystemError("Characteristic admittance of " + **mName + " is not positive");
+	SPDLOG_LOGGER_INFO(mSLog, "terminal conductance: {}", mConductance);
+
+	mRes1->setParameters(1. / mConductance);
+	mRes2->setParameters(1. / mConductance);
+
+	// Steady state of the fitted line at the system frequency
+	Complex jOmega(0, omega);
+	Complex ycAdmittance = mYcConst;
+	for (Matrix::Index i = 0; i < mYcPoles.rows(); i++)
+		ycAdmittance += mYcResidues(i, 0) / (jOmega - mYcPoles(i, 0));
+	Complex propagation = 0;
+	for (Matrix::Index i = 0; i < mHPoles.rows(); i++)
+		propagation += mHResidues(i, 0) / (jOmega - mHPoles(i, 0));
+	propagation *= std::exp(-jOmega * mDelay);
+
+	Complex volt[2] = { mNode1->initialSingleVoltage(), mNode2->initialSingleVoltage() };
+	Complex cur[2], wave[2];
+	for (UInt k = 0; k < 2; k++) {
+		cur[k] = ycAdmittance * (volt[k] * (1. + propagation * propagation) - 2. * propagation * volt[1-k])
+			/ (1. - propagation * propagation);
+		wave[k] = ycAdmittance * volt[k] + cur[k];
+	}
+	SPDLOG_LOGGER_INFO(mSLog, "initial voltages: v_k {} v_m {}", volt[0], volt[1]);
+	SPDLOG_LOGGER_INFO(mSLog, "initial currents: i_km {} i_mk {}", cur[0], cur[1]);
+
+	// Fill the history with the sinusoidal steady state of the previous time steps,
+	// where the column at the buffer index is the oldest one
+	mHistory.resize(2, mBufSize);
+	for (UInt j = 0; j < mBufSize; j++) {
+		Complex rotation = std::exp(-jOmega * ((mBufSize - j) * timeStep));
+		mHistory(0, j) = (wave[0] * rotation).real();
+		mHistory(1, j) = (wave[1] * rotation).real();
+	}
+	mBufIdx = 0;
+
+	Complex prevRotation = std::exp(-jOmega * timeStep);
+	Complex prevDelayedRotation = std::exp(-jOmega * (mDelay + timeStep));
+	mYcStates.resize(mYcPoles.rows(), 2);
+	mHStates.resize(mHPoles.rows(), 2);
+	for (UInt k = 0; k < 2; k++) {
+		mPrevVoltage(k) = (volt[k] * prevRotation).real();
+		mPrevDelayed(k) = (wave[k] * prevDelayedRotation).real();
+		for (Matrix::Index i = 0; i < mYcPoles.rows(); i++)
+			mYcStates(i, k) = (mYcResidues(i, 0) / (jOmega - mYcPoles(i, 0)) * volt[k] * prevRotation).real();
+		for (Matrix::Index i = 0; i < mHPoles.rows(); i++)
+			mHStates(i, k) = (mHResidues(i, 0) / (jOmega - mHPoles(i, 0)) * wave[1-k] * prevDelayedRotation).real();
+	}
+}
+
+Eigen::Matrix<Real, 2, 1> FrequencyDependentLineEMT::interpolate() const {
+	// linear interpolation of the nearest values
+	UInt nextIdx = mBufIdx == mBufSize-1 ? 0 : mBufIdx+1;
+	return mAlpha * mHistory.col(mBufIdx) + (1-mAlpha) * mHistory.col(nextIdx);
+}
+
+void FrequencyDependentLineEMT::step(Real time, Int timeStepCount) {
+	Eigen::Matrix<Real, 2, 1> delayed = interpolate();
+	Eigen::Matrix<Real, 2, 1> srcCur;
+
+	for (UInt k = 0; k < 2; k++) {
+		// Part of Yc * v_k that does not depend on the new voltage
+		Real ycHistory = mYcCoeffs.col(0).dot(mYcStates.col(k)) + mYcCoeffs.col(2).sum() * mPrevVoltage(k);
+
+		// H is applied to the wave of the opposite terminal, which is known from the history
+		mHStates.col(k) = mHCoeffs.col(0).cwiseProduct(mHStates.col(k))
+			+ mHCoeffs.col(1) * delayed(1-k) + mHCoeffs.col(2) * mPrevDelayed(1-k);
+
+		srcCur(k) = ycHistory - mHStates.col(k).sum();
+	}
+	mPrevDelayed = delayed;
+
+	**mSrcCur1Ref = srcCur(0);
+	**mSrcCur2Ref = srcCur(1);
+	mSrc1->mCurrentRef->set(**mSrcCur1Ref);
+	mSrc2->mCurrentRef->set(**mSrcCur2Ref);
+}
+
+void FrequencyDependentLineEMT::PreStep::execute(Real time, Int timeStepCount) {
+	mLine.step(time, timeStepCount);
+}
+
+void FrequencyDependentLineEMT::postStep() {
+	Eigen::Matrix<Real, 2, 1> volt, cur;
+	volt(0) = -mRes1->intfVoltage()(0,0);
+	volt(1) = -mRes2->intfVoltage()(0,0);
+	cur(0) = -mRes1->intfCurrent()(0,0) + **mSrcCur1Ref;
+	cur(1) = -mRes2->intfCurrent()(0,0) + **mSrcCur2Ref;
+
+	// Update the convolution states of Yc and the ringbuffer with the new waves
+	auto values = mHistory.col(mBufIdx);
+	for (UInt k = 0; k < 2; k++) {
+		mYcStates.col(k) = mYcCoeffs.col(0).cwiseProduct(mYcStates.col(k))
+			+ mYcCoeffs.col(1) * volt(k) + mYcCoeffs.col(2) * mPrevVoltage(k);
+		values(k) = mYcConst * volt(k) + mYcStates.col(k).sum() + cur(k);
+	}
+	mPrevVoltage = volt;
+
+	mBufIdx++;
+	if (mBufIdx == mBufSize)
+		mBufIdx = 0;
+}
+
+void FrequencyDependentLineEMT::PostStep::execute(Real time, Int timeStepCount) {
+	mLine.postStep();
+}
+
+Task::List FrequencyDependentLineEMT::getTasks() {
+	return Task::List({std::make_shared<PreStep>(*this), std::make_shared<PostStep>(*this)});
+}
+
+IdentifiedObject::List FrequencyDependentLineEMT::getLineComponents() {
+	return IdentifiedObject::List({mRes1, mRes2, mSrc1, mSrc2});
+}
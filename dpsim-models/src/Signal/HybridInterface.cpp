@@ -0,0 +1,79 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/Signal/HybridInterface.h>
+
+using namespace CPS;
+using namespace CPS::Signal;
+
+HybridInterface::HybridInterface(String name, Logger::Level logLevel) :
+	SimSignalComp(name, name, logLevel),
+	mCurrentPhasor(mAttributes->create<Complex>("i_phasor")) {
+
+	mEmtSrc = EMT::Ph3::VoltageSource::make(name + "_v", logLevel);
+	mPhasorSrc = DP::Ph1::CurrentSource::make(name + "_i", logLevel);
+}
+
+void HybridInterface::setParameters(SimNode<Complex>::Ptr phasorNode, SimNode<Real>::Ptr emtNode,
+	UInt averagingSteps, Complex initialCurrent) {
+
+	mPhasorNode = phasorNode;
+	mEmtNode = emtNode;
+	mAveragingSteps = std::max<UInt>(averagingSteps, 1);
+	**mCurrentPhasor = initialCurrent;
+
+	// Both sources take the current flowing from the EMT into the SP/DP subnet as positive
+	mEmtSrc->connect({SimNode<Real>::GND, emtNode});
+	mPhasorSrc->setParameters(initialCurrent);
+	mPhasorSrc->connect({SimNode<Complex>::GND, phasorNode});
+}
+
+void HybridInterface::initialize(Real omega, Real timeStep) {
+	mOmega = omega;
+	mTimeStep = timeStep;
+	mCurrentHistory.assign(mAveragingSteps, **mCurrentPhasor);
+	mBufIdx = 0;
+
+	SPDLOG_LOGGER_INFO(mSLog, "initial voltages: phasor {} EMT {}",
+		Logger::phasorToString(mPhasorNode->initialSingleVoltage()),
+		Logger::phasorToString(mEmtNode->initialSingleVoltage()));
+	SPDLOG_LOGGER_INFO(mSLog, "averaging over {} steps", mAveragingSteps);
+}
+
+void HybridInterface::step(Real time, Int timeStepCount) {
+	**mEmtSrc->mVoltageRef = Math::singlePhaseVariableToThreePhase((**mPhasorNode->mVoltage)(0, 0));
+
+	if (timeStepCount > 0) {
+		// Positive sequence space vector of the current of the last step
+		const Complex a = Math::polar(1., 2. / 3. * PI);
+		const Matrix& current = **mEmtSrc->mIntfCurrent;
+		Complex spaceVector = 2. / 3. * (current(0, 0) + a * current(1, 0) + a * a * current(2, 0));
+		mCurrentHistory[mBufIdx] = PEAK1PH_TO_RMS3PH * spaceVector
+			* Math::polar(1., -mOmega * (time - mTimeStep));
+		if (++mBufIdx == mAveragingSteps)
+			mBufIdx = 0;
+
+		Complex sum = 0;
+		for (auto& phasor : mCurrentHistory)
+			sum += phasor;
+		**mCurrentPhasor = sum / static_cast<Real>(mAveragingSteps);
+	}
+	**mPhasorSrc->mCurrentRef = **mCurrentPhasor;
+}
+
+void HybridInterface::PreStep::execute(Real time, Int timeStepCount) {
+	mIntf.step(time, timeStepCount);
+}
+
+Task::List HybridInterface::getTasks() {
+	return Task::List({std::make_shared<PreStep>(*this)});
+}
+
+IdentifiedObject::List HybridInterface::getInterfaceComponents() {
+	return IdentifiedObject::List({mEmtSrc, mPhasorSrc});
+}
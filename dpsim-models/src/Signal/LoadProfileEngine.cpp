@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim-models/Signal/LoadProfileEngine.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace CPS;
+using namespace CPS::Signal;
+
+LoadProfileEngine::LoadProfileEngine(String uid, String name, Logger::Level logLevel) :
+	SimSignalComp(uid, name, logLevel),
+	mChangedLoadCount(mAttributes->create<Int>("changed_load_count", 0)) {
+}
+
+void LoadProfileEngine::setTimes(const std::vector<Real>& times) {
+	if (numLoads() > 0) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Time stamps cannot be changed after loads were added");
+		throw InvalidArgumentException();
+	}
+	if (!std::is_sorted(times.begin(), times.end())) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Time stamps are not sorted");
+		throw InvalidArgumentException();
+	}
+	mTimes = times;
+}
+
+Attribute<Real>::Ptr LoadProfileEngine::realAttribute(AttributeBase::Ptr attr) const {
+	auto real = std::dynamic_pointer_cast<Attribute<Real>>(attr.getPtr());
+	if (!real) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Power {} is not a Real attribute", attr->toString());
+		throw TypeException();
+	}
+	return real;
+}
+
+void LoadProfileEngine::addLoad(AttributeBase::Ptr activePower, AttributeBase::Ptr reactivePower,
+	const PowerProfile& profile, Real activePowerNom, Real reactivePowerNom) {
+	if (profile.empty()) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Profile of {} is empty", activePower->toString());
+		throw InvalidArgumentException();
+	}
+	if (mTimes.empty())
+		mTimes = profile.times;
+
+	std::vector<Real> activePowerSamples(mTimes.size());
+	std::vector<Real> reactivePowerSamples(mTimes.size());
+	PowerProfile::Cursor cursor;
+	for (std::size_t row = 0; row < mTimes.size(); ++row) {
+		if (profile.weightingFactors.empty()) {
+			PQData pq = profile.pq(mTimes[row], cursor);
+			activePowerSamples[row] = pq.p;
+			reactivePowerSamples[row] = pq.q;
+		} else {
+			Real wf = profile.weightingFactor(mTimes[row], cursor);
+			activePowerSamples[row] = activePowerNom * wf;
+			reactivePowerSamples[row] = reactivePowerNom * wf;
+		}
+	}
+	addLoad(activePower, reactivePower, activePowerSamples, reactivePowerSamples);
+}
+
+void LoadProfileEngine::addLoad(AttributeBase::Ptr activePower, AttributeBase::Ptr reactivePower,
+	const std::vector<Real>& activePowerSamples, const std::vector<Real>& reactivePowerSamples) {
+	if (activePowerSamples.size() != mTimes.size() || reactivePowerSamples.size() != mTimes.size()) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Profile of {} has {} and {} samples for {} time stamps", activePower->toString(),
+			activePowerSamples.size(), reactivePowerSamples.size(), mTimes.size());
+		throw InvalidArgumentException();
+	}
+	mActivePowers.push_back(realAttribute(activePower));
+	mReactivePowers.push_back(realAttribute(reactivePower));
+	mNewActivePowerColumns.push_back(activePowerSamples);
+	mNewReactivePowerColumns.push_back(reactivePowerSamples);
+}
+
+void LoadProfileEngine::appendColumns() {
+	if (mNewActivePowerColumns.empty())
+		return;
+
+	Eigen::Index rows = static_cast<Eigen::Index>(mTimes.size());
+	Eigen::Index oldCols = mActivePowerProfiles.cols();
+	Eigen::Index cols = static_cast<Eigen::Index>(numLoads());
+	mActivePowerProfiles.conservativeResize(rows, cols);
+	mReactivePowerProfiles.conservativeResize(rows, cols);
+	for (std::size_t idx = 0; idx < mNewActivePowerColumns.size(); ++idx) {
+		Eigen::Index col = oldCols + static_cast<Eigen::Index>(idx);
+		for (Eigen::Index row = 0; row < rows; ++row) {
+			mActivePowerProfiles(row, col) = mNewActivePowerColumns[idx][row];
+			mReactivePowerProfiles(row, col) = mNewReactivePowerColumns[idx][row];
+		}
+	}
+	mNewActivePowerColumns.clear();
+	mNewReactivePowerColumns.clear();
+}
+
+void LoadProfileEngine::initialize(Real timeStep) {
+	appendColumns();
+	mCursor = 0;
+	// Write all powers in the first step
+	mActivePowerValues.setConstant(numLoads(), std::numeric_limits<Real>::quiet_NaN());
+	mReactivePowerValues.setConstant(numLoads(), std::numeric_limits<Real>::quiet_NaN());
+	mChangedLoads.clear();
+	mChangedLoads.reserve(numLoads());
+	SPDLOG_LOGGER_INFO(mSLog, "Apply profiles of {} loads with {} time stamps", numLoads(), numTimes());
+}
+
+Task::List LoadProfileEngine::getTasks() {
+	return Task::List({ std::make_shared<Step>(*this) });
+}
+
+void LoadProfileEngine::apply(Real time) {
+	mChangedLoads.clear();
+	if (mTimes.empty() || numLoads() == 0) {
+		**mChangedLoadCount = 0;
+		return;
+	}
+
+	if (mCursor >= mTimes.size() || mTimes[mCursor] > time) {
+		// Time went backwards, search from the start
+		auto next = std::upper_bound(mTimes.begin(), mTimes.end(), time);
+		mCursor = (next == mTimes.begin()) ? 0 : static_cast<std::size_t>(next - mTimes.begin()) - 1;
+	} else {
+		while (mCursor + 1 < mTimes.size() && mTimes[mCursor + 1] <= time)
+			++mCursor;
+	}
+
+	Eigen::Index row = static_cast<Eigen::Index>(mCursor);
+	if (time <= mTimes[mCursor] || mCursor + 1 == mTimes.size()) {
+		mNextActivePowerValues = mActivePowerProfiles.row(row);
+		mNextReactivePowerValues = mReactivePowerProfiles.row(row);
+	} else {
+		const Real delta = (time - mTimes[mCursor]) / (mTimes[mCursor + 1] - mTimes[mCursor]);
+		mNextActivePowerValues.noalias() = (1 - delta) * mActivePowerProfiles.row(row) + delta * mActivePowerProfiles.row(row + 1);
+		mNextReactivePowerValues.noalias() = (1 - delta) * mReactivePowerProfiles.row(row) + delta * mReactivePowerProfiles.row(row + 1);
+	}
+
+	for (UInt load = 0; load < numLoads(); ++load) {
+		Real activePower = mNextActivePowerValues(load);
+		Real reactivePower = mNextReactivePowerValues(load);
+		// NaN of the first step compares unequal
+		Bool activeChanged = !(activePower == mActivePowerValues(load));
+		Bool reactiveChanged = !(reactivePower == mReactivePowerValues(load));
+		if (activeChanged)
+			**mActivePowers[load] = activePower;
+		if (reactiveChanged)
+			**mReactivePowers[load] = reactivePower;
+		if (activeChanged || reactiveChanged)
+			mChangedLoads.push_back(load);
+	}
+	mActivePowerValues.swap(mNextActivePowerValues);
+	mReactivePowerValues.swap(mNextReactivePowerValues);
+	**mChangedLoadCount = static_cast<Int>(mChangedLoads.size());
+}
+
+LoadProfileEngine::Step::Step(LoadProfileEngine& engine) :
+	Task(**engine.mName + ".Step"), mEngine(engine) {
+	for (auto& power : engine.mActivePowers)
+		mModifiedAttributes.push_back(power);
+	for (auto& power : engine.mReactivePowers)
+		mModifiedAttributes.push_back(power);
+	mModifiedAttributes.push_back(engine.mChangedLoadCount);
+}
+
+void LoadProfileEngine::Step::execute(Real time, Int timeStepCount) {
+	mEngine.apply(time);
+}
@@ -36,6 +36,7 @@ void PLL::setParameters(Real kpPLL, Real kiPLL, Real omegaNom) {
 void PLL::setSimulationParameters(Real timestep) {
     mTimeStep = timestep;
     SPDLOG_LOGGER_INFO(mSLog, "Integration step = {}", mTimeStep);
+    discretizeStateSpaceModel();
 }
 
 void PLL::setInitialValues(Real input_init, Matrix state_init, Matrix output_init) {
@@ -62,6 +63,16 @@ void PLL::composeStateSpaceMatrices() {
     SPDLOG_LOGGER_INFO(mSLog, "B = \n{}", mB);
     SPDLOG_LOGGER_INFO(mSLog, "C = \n{}", mC);
     SPDLOG_LOGGER_INFO(mSLog, "D = \n{}", mD);
+
+    if (mTimeStep > 0)
+        discretizeStateSpaceModel();
+}
+
+void PLL::discretizeStateSpaceModel() {
+    // A and B are constant, so the discretization is only done once
+    Matrix inputMatrix;
+    Math::StateSpaceTrapezoidalMatrices(mA, mTimeStep, mAd, inputMatrix);
+    mBd = inputMatrix * mB;
 }
 
 void PLL::signalAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -89,7 +100,7 @@ void PLL::signalStep(Real time, Int timeStepCount) {
     SPDLOG_LOGGER_INFO(mSLog, "Time {}:", time);
     SPDLOG_LOGGER_INFO(mSLog, "Input values: inputCurr = ({}, {}), inputPrev = ({}, {}), stateCurr = ({}, {}), statePrev = ({}, {})", (**mInputCurr)(0,0), (**mInputCurr)(1,0), (**mInputPrev)(0,0), (**mInputPrev)(1,0), (**mStateCurr)(0,0), (**mStateCurr)(1,0), (**mStatePrev)(0,0), (**mStatePrev)(1,0));
 
-    **mStateCurr = Math::StateSpaceTrapezoidal(**mStatePrev, mA, mB, mTimeStep, **mInputCurr, **mInputPrev);
+    **mStateCurr = mAd * **mStatePrev + mBd * (**mInputCurr + **mInputPrev);
     **mOutputCurr = mC * **mStateCurr + mD * **mInputCurr;
 
     SPDLOG_LOGGER_INFO(mSLog, "State values: stateCurr = ({}, {})", (**mStateCurr)(0,0), (**mStateCurr)(1,0));
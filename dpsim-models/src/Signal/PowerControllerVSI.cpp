@@ -113,6 +113,9 @@ void PowerControllerVSI::initializeStateSpaceModel(Real omega, Real timeStep, At
 	// update B matrix due to its dependence on Irc
 	updateBMatrixStateSpaceModel();
 
+	// A is constant, so the discretization is only done once
+	Math::StateSpaceTrapezoidalMatrices(mA, mTimeStep, mAd, mBd);
+
 	// initialization of input
 	**mInputCurr << mPref, mQref, **mVc_d, **mVc_q, **mIrc_d, **mIrc_q;
 	SPDLOG_LOGGER_INFO(mSLog, "Initialization of input: \n" + Logger::matrixToString(**mInputCurr));
@@ -157,7 +160,7 @@ void PowerControllerVSI::signalStep(Real time, Int timeStepCount) {
     SPDLOG_LOGGER_DEBUG(mSLog, "Time {}\n: inputCurr = \n{}\n , inputPrev = \n{}\n , statePrev = \n{}", time, **mInputCurr, **mInputPrev, **mStatePrev);
 
 	// calculate new states
-	**mStateCurr = Math::StateSpaceTrapezoidal(**mStatePrev, mA, mB, mTimeStep, **mInputCurr, **mInputPrev);
+	**mStateCurr = mAd * **mStatePrev + mBd * (mB * (**mInputCurr + **mInputPrev));
 	SPDLOG_LOGGER_DEBUG(mSLog, "stateCurr = \n {}", **mStateCurr);
 
 	// calculate new outputs
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim-models/Signal/ProtectionRelay.h>
+
+using namespace CPS;
+using namespace CPS::Signal;
+
+ProtectionRelay::ProtectionRelay(String uid, String name, Logger::Level logLevel) :
+	SimSignalComp(uid, name, logLevel),
+	mInputRef(mAttributes->createDynamic<Real>("input_ref")),
+	mTripped(mAttributes->create<Bool>("tripped", false)),
+	mPickupTime(mAttributes->create<Real>("pickup_time", -1)) {
+}
+
+void ProtectionRelay::setParameters(Real threshold, Real delay, Real speculationMargin) {
+	mThreshold = threshold;
+	mDelay = delay;
+	mSpeculationMargin = speculationMargin;
+	SPDLOG_LOGGER_INFO(mSLog, "Threshold = {}, delay = {}, speculation margin = {}", mThreshold, mDelay, mSpeculationMargin);
+}
+
+void ProtectionRelay::setSwitch(AttributeBase::Ptr switchState) {
+	auto state = std::dynamic_pointer_cast<Attribute<Bool>>(switchState.getPtr());
+	if (!state) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Switch state {} is not a Bool attribute", switchState->toString());
+		throw TypeException();
+	}
+	mSwitchState = state;
+}
+
+Bool ProtectionRelay::tripImminent() const {
+	return !**mTripped && std::abs(**mInputRef) >= mSpeculationMargin * mThreshold;
+}
+
+void ProtectionRelay::initialize(Real timeStep) {
+	if (!mSwitchState.getPtr()) {
+		SPDLOG_LOGGER_ERROR(mSLog, "No switch is set for relay {}", **mName);
+		throw InvalidArgumentException();
+	}
+	mTimeStep = timeStep;
+}
+
+Task::List ProtectionRelay::getTasks() {
+	return Task::List({ std::make_shared<Step>(*this) });
+}
+
+ProtectionRelay::Step::Step(ProtectionRelay& relay) :
+	Task(**relay.mName + ".Step"), mRelay(relay) {
+	mAttributeDependencies.push_back(relay.mInputRef);
+	mModifiedAttributes.push_back(relay.mTripped);
+	mModifiedAttributes.push_back(relay.mPickupTime);
+	if (relay.mSwitchState.getPtr())
+		mModifiedAttributes.push_back(relay.mSwitchState);
+}
+
+void ProtectionRelay::Step::execute(Real time, Int timeStepCount) {
+	if (**mRelay.mTripped)
+		return;
+	if (std::abs(**mRelay.mInputRef) < mRelay.mThreshold) {
+		**mRelay.mPickupTime = -1;
+		return;
+	}
+	if (**mRelay.mPickupTime < 0)
+		**mRelay.mPickupTime = time;
+	// Half a step of tolerance for delays which are multiples of the time step
+	if (time - **mRelay.mPickupTime + 0.5 * mRelay.mTimeStep >= mRelay.mDelay) {
+		**mRelay.mSwitchState = false;
+		**mRelay.mTripped = true;
+		SPDLOG_LOGGER_INFO(mRelay.mSLog, "Tripped at time {}", time);
+	}
+}
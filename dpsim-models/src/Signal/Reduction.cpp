@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim-models/Signal/Reduction.h>
+
+#include <limits>
+
+using namespace CPS;
+using namespace CPS::Signal;
+
+Reduction::Reduction(String uid, String name, Logger::Level logLevel) :
+	SimSignalComp(uid, name, logLevel),
+	mOutput(mAttributes->create<Real>("output", 0.0)) {
+}
+
+Reduction::Reduction(String name, Operation operation, Logger::Level logLevel) :
+	Reduction(name, name, logLevel) {
+	mOperation = operation;
+}
+
+void Reduction::addInput(AttributeBase::Ptr input, Real weight, UInt row, UInt col) {
+	InputType type;
+	if (std::dynamic_pointer_cast<Attribute<Real>>(input.getPtr()))
+		type = InputType::Real;
+	else if (std::dynamic_pointer_cast<Attribute<Complex>>(input.getPtr()))
+		type = InputType::Complex;
+	else if (std::dynamic_pointer_cast<Attribute<Matrix>>(input.getPtr()))
+		type = InputType::Matrix;
+	else if (std::dynamic_pointer_cast<Attribute<MatrixComp>>(input.getPtr()))
+		type = InputType::MatrixComp;
+	else {
+		SPDLOG_LOGGER_ERROR(mSLog, "Input {} is not a Real, Complex or matrix attribute", input->toString());
+		throw TypeException();
+	}
+	mInputs.push_back({ input, type, weight, row, col });
+}
+
+void Reduction::setChunks(UInt chunks) {
+	mChunks = chunks > 0 ? chunks : 1;
+}
+
+void Reduction::setDecimation(UInt factor) {
+	mDecimation = factor > 0 ? static_cast<Int>(factor) : 1;
+}
+
+void Reduction::initialize(Real timeStep) {
+	for (auto& input : mInputs) {
+		if (input.type != InputType::Matrix && input.type != InputType::MatrixComp)
+			continue;
+		Int rows, cols;
+		if (input.type == InputType::Matrix) {
+			auto& value = **std::static_pointer_cast<Attribute<Matrix>>(input.attribute.getPtr());
+			rows = static_cast<Int>(value.rows());
+			cols = static_cast<Int>(value.cols());
+		} else {
+			auto& value = **std::static_pointer_cast<Attribute<MatrixComp>>(input.attribute.getPtr());
+			rows = static_cast<Int>(value.rows());
+			cols = static_cast<Int>(value.cols());
+		}
+		if (static_cast<Int>(input.row) >= rows || static_cast<Int>(input.col) >= cols) {
+			SPDLOG_LOGGER_ERROR(mSLog, "Element ({}, {}) is outside of the {}x{} input {}",
+				input.row, input.col, rows, cols, input.attribute->toString());
+			throw InvalidArgumentException();
+		}
+	}
+
+	mPartials.assign(mChunks, emptyPartial());
+	mArgument = -1;
+	SPDLOG_LOGGER_INFO(mSLog, "Aggregate {} inputs in {} chunks every {} steps", mInputs.size(), mChunks, mDecimation);
+}
+
+Task::List Reduction::getTasks() {
+	Task::List tasks;
+	if (mPartials.size() != mChunks)
+		mPartials.assign(mChunks, emptyPartial());
+	if (mChunks > 1) {
+		if (mPartialAttributes.size() != mChunks) {
+			mPartialAttributes.clear();
+			for (UInt chunk = 0; chunk < mChunks; ++chunk)
+				mPartialAttributes.push_back(AttributeStatic<Real>::make(0.0));
+		}
+		for (UInt chunk = 0; chunk < mChunks; ++chunk)
+			tasks.push_back(std::make_shared<ChunkStep>(*this, chunk));
+	}
+	tasks.push_back(std::make_shared<Step>(*this));
+	return tasks;
+}
+
+Real Reduction::inputValue(const Input& input) {
+	switch (input.type) {
+	case InputType::Real:
+		return **std::static_pointer_cast<Attribute<Real>>(input.attribute.getPtr());
+	case InputType::Complex:
+		return std::abs(**std::static_pointer_cast<Attribute<Complex>>(input.attribute.getPtr()));
+	case InputType::Matrix:
+		return (**std::static_pointer_cast<Attribute<Matrix>>(input.attribute.getPtr()))(input.row, input.col);
+	case InputType::MatrixComp:
+		return std::abs((**std::static_pointer_cast<Attribute<MatrixComp>>(input.attribute.getPtr()))(input.row, input.col));
+	}
+	return 0;
+}
+
+Reduction::Partial Reduction::emptyPartial() const {
+	switch (mOperation) {
+	case Operation::Min:
+		return { std::numeric_limits<Real>::infinity(), 0, -1 };
+	case Operation::Max:
+		return { -std::numeric_limits<Real>::infinity(), 0, -1 };
+	default:
+		return { 0, 0, -1 };
+	}
+}
+
+UInt Reduction::chunkBegin(UInt chunk) const {
+	return static_cast<UInt>(mInputs.size() * chunk / mChunks);
+}
+
+Reduction::Partial Reduction::reduce(UInt chunk) const {
+	Partial result = emptyPartial();
+	UInt end = chunkBegin(chunk + 1);
+	for (UInt idx = chunkBegin(chunk); idx < end; ++idx) {
+		const Input& input = mInputs[idx];
+		Real value = input.weight * inputValue(input);
+		switch (mOperation) {
+		case Operation::Sum:
+		case Operation::Mean:
+			result.value += value;
+			result.weights += input.weight;
+			break;
+		case Operation::Min:
+			if (value < result.value) {
+				result.value = value;
+				result.argument = static_cast<Int>(idx);
+			}
+			break;
+		case Operation::Max:
+			if (value > result.value) {
+				result.value = value;
+				result.argument = static_cast<Int>(idx);
+			}
+			break;
+		}
+	}
+	return result;
+}
+
+void Reduction::combine(Partial& result, const Partial& partial) const {
+	switch (mOperation) {
+	case Operation::Sum:
+	case Operation::Mean:
+		result.value += partial.value;
+		result.weights += partial.weights;
+		break;
+	case Operation::Min:
+		if (partial.argument >= 0 && (result.argument < 0 || partial.value < result.value))
+			result = partial;
+		break;
+	case Operation::Max:
+		if (partial.argument >= 0 && (result.argument < 0 || partial.value > result.value))
+			result = partial;
+		break;
+	}
+}
+
+void Reduction::setOutput(const Partial& result) {
+	switch (mOperation) {
+	case Operation::Sum:
+		**mOutput = result.value;
+		break;
+	case Operation::Mean:
+		**mOutput = result.weights != 0 ? result.value / result.weights : 0;
+		break;
+	case Operation::Min:
+	case Operation::Max:
+		// Keep the output finite without inputs
+		**mOutput = result.argument >= 0 ? result.value : 0;
+		mArgument = result.argument;
+		break;
+	}
+}
+
+Reduction::ChunkStep::ChunkStep(Reduction& reduction, UInt chunk) :
+	Task(**reduction.mName + ".ChunkStep" + std::to_string(chunk)), mReduction(reduction), mChunk(chunk) {
+	UInt end = reduction.chunkBegin(chunk + 1);
+	for (UInt idx = reduction.chunkBegin(chunk); idx < end; ++idx)
+		mAttributeDependencies.push_back(reduction.mInputs[idx].attribute);
+	mModifiedAttributes.push_back(reduction.mPartialAttributes[chunk]);
+}
+
+void Reduction::ChunkStep::execute(Real time, Int timeStepCount) {
+	if (timeStepCount % mReduction.mDecimation != 0)
+		return;
+	mReduction.mPartials[mChunk] = mReduction.reduce(mChunk);
+	**mReduction.mPartialAttributes[mChunk] = mReduction.mPartials[mChunk].value;
+}
+
+Reduction::Step::Step(Reduction& reduction) :
+	Task(**reduction.mName + ".Step"), mReduction(reduction) {
+	if (reduction.mChunks > 1) {
+		for (auto& attr : reduction.mPartialAttributes)
+			mAttributeDependencies.push_back(attr);
+	} else {
+		for (auto& input : reduction.mInputs)
+			mAttributeDependencies.push_back(input.attribute);
+	}
+	mModifiedAttributes.push_back(reduction.mOutput);
+}
+
+void Reduction::Step::execute(Real time, Int timeStepCount) {
+	if (timeStepCount % mReduction.mDecimation != 0)
+		return;
+	if (mReduction.mChunks <= 1) {
+		mReduction.setOutput(mReduction.reduce(0));
+		return;
+	}
+	Partial result = mReduction.emptyPartial();
+	for (auto& partial : mReduction.mPartials)
+		mReduction.combine(result, partial);
+	mReduction.setOutput(result);
+}
@@ -78,14 +78,23 @@ Real TurbineGovernorType1::step(Real Omega, Real dt) {
 	if (Tin<mTmin)
 		Tin = mTmin;
 	
+	// Forward Euler, or backward Euler with the newest inputs
+	auto integrate = mImplicitIntegration ? Math::StateSpaceImplicitEuler
+		: static_cast<Real(*)(Real, Real, Real, Real, Real)>(Math::StateSpaceEuler);
+	Real xg1 = mXg1_prev, xg2 = mXg2_prev;
+
 	/// Governor
-	**mXg1 = Math::StateSpaceEuler(mXg1_prev, -1 / mTs, 1 / mTs, dt, Tin);
+	**mXg1 = integrate(mXg1_prev, -1 / mTs, 1 / mTs, dt, Tin);
+	if (mImplicitIntegration)
+		xg1 = **mXg1;
 
 	/// Servo
-	**mXg2 = Math::StateSpaceEuler(mXg2_prev, -1 / mTc, (1 - mT3 / mTc) / mTc, dt, mXg1_prev);
+	**mXg2 = integrate(mXg2_prev, -1 / mTc, (1 - mT3 / mTc) / mTc, dt, xg1);
+	if (mImplicitIntegration)
+		xg2 = **mXg2;
 
 	/// Reheat
-	**mXg3 = Math::StateSpaceEuler(mXg3_prev, -1 / mT5, (1 - mT4 / mT5) / mT5 , dt, (mXg2_prev + mT3 / mTc * mXg1_prev));
+	**mXg3 = integrate(mXg3_prev, -1 / mT5, (1 - mT4 / mT5) / mT5 , dt, (xg2 + mT3 / mTc * xg1));
 
 	/// Mechanical torque
 	**mTm = **mXg3 + mT4 / mT5 * (**mXg2 + mT3 / mTc * **mXg1);
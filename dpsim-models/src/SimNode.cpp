@@ -86,6 +86,14 @@ std::vector<UInt> SimNode<VarType>::matrixNodeIndices() {
 		return { mMatrixNodeIndex[0] };
 }
 
+template <typename VarType>
+std::vector<UInt> SimNode<VarType>::mnaVoltageRows() {
+	if (mPhaseType == PhaseType::ABC)
+		return mMatrixNodeIndex;
+	else
+		return { mMatrixNodeIndex[0] };
+}
+
 template <typename VarType>
 MatrixVar<VarType> SimNode<VarType>::voltage() { return **mVoltage; }
 
@@ -144,15 +152,15 @@ void SimNode<Real>::mnaInitializeHarm(std::vector<Attribute<Matrix>::Ptr> leftVe
 
 template <>
 void SimNode<Complex>::mnaInitializeHarm(std::vector<Attribute<Matrix>::Ptr> leftVectors) {
-	mMnaTasks = {
-		std::make_shared<MnaPostStepHarm>(*this, leftVectors)
-	};
+	// The tasks write different columns of the voltage and may run concurrently
+	mMnaTasks.clear();
+	for (UInt freq = 0; freq < mNumFreqs; freq++)
+		mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors[freq], freq));
 }
 
 template <>
 void SimNode<Complex>::MnaPostStepHarm::execute(Real time, Int timeStepCount) {
-	for (UInt freq = 0; freq < mNode.mNumFreqs; freq++)
-		mNode.mnaUpdateVoltageHarm(**mLeftVectors[freq], freq);
+	mNode.mnaUpdateVoltageHarm(**mLeftVector, mFreqIdx);
 }
 
 template <>
@@ -177,6 +177,24 @@ TopologicalNode::List SimPowerComp<VarType>::topologicalNodes() {
 	return nodes;
 }
 
+template <typename VarType>
+void SimPowerComp<VarType>::collectMatrixNodeIndices(std::vector<UInt>& indices) {
+	for (auto terminal : mTerminals) {
+		if (!terminal || !terminal->node() || terminal->node()->isGround())
+			continue;
+		auto nodeIndices = terminal->node()->matrixNodeIndices();
+		indices.insert(indices.end(), nodeIndices.begin(), nodeIndices.end());
+	}
+	for (auto virtualNode : mVirtualNodes) {
+		if (!virtualNode)
+			continue;
+		auto nodeIndices = virtualNode->matrixNodeIndices();
+		indices.insert(indices.end(), nodeIndices.begin(), nodeIndices.end());
+	}
+	for (auto subComp : mSubComponents)
+		subComp->collectMatrixNodeIndices(indices);
+}
+
 // #### Virtual Nodes ####
 template <typename VarType>
 void SimPowerComp<VarType>::setVirtualNodeNumber(UInt num) {
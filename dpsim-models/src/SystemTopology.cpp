@@ -10,8 +10,14 @@
 #include <iomanip>
 #include <fstream>
 #include <unordered_map>
+#include <optional>
+#include <random>
 
 #include <dpsim-models/SystemTopology.h>
+#include <dpsim-models/ObjectPool.h>
+#include <dpsim-models/TopologyGraph.h>
+#include <dpsim-models/DP/DP_Ph1_PiLine.h>
+#include <dpsim-models/Signal/DecouplingLine.h>
 
 using namespace CPS;
 
@@ -26,6 +32,7 @@ void SystemTopology::addNode(TopologicalNode::Ptr topNode) {
 	if (auto nodeReal = std::dynamic_pointer_cast<SimNode<Real>>(topNode)) nodeReal->initialize(mFrequencies);
 
 	mNodes.push_back(topNode);
+	++mGeneration;
 }
 
 void SystemTopology::addNodeAt(TopologicalNode::Ptr topNode, UInt index) {
@@ -36,6 +43,8 @@ void SystemTopology::addNodeAt(TopologicalNode::Ptr topNode, UInt index) {
 		mNodes.resize(index+1);
 
 	mNodes[index] = topNode;
+	// The node may replace another one without changing the length of the list
+	++mGeneration;
 }
 
 
@@ -49,6 +58,7 @@ void SystemTopology::addComponent(IdentifiedObject::Ptr component) {
 	if (auto powerCompReal = std::dynamic_pointer_cast<SimPowerComp<Real>>(component)) powerCompReal->initialize(mFrequencies);
 
 	mComponents.push_back(component);
+	++mGeneration;
 }
 
 template <typename VarType>
@@ -72,6 +82,19 @@ void SystemTopology::addComponents(const IdentifiedObject::List& components) {
 		addComponent(comp);
 }
 
+void SystemTopology::removeComponent(IdentifiedObject::Ptr component) {
+	auto it = std::find(mComponents.begin(), mComponents.end(), component);
+	if (it != mComponents.end())
+		mComponents.erase(it);
+	if (auto powerComp = std::dynamic_pointer_cast<TopologicalPowerComp>(component)) {
+		for (auto& compsAtNode : mComponentsAtNode) {
+			auto& nodeComps = compsAtNode.second;
+			nodeComps.erase(std::remove(nodeComps.begin(), nodeComps.end(), powerComp), nodeComps.end());
+		}
+	}
+	++mGeneration;
+}
+
 void SystemTopology::initWithPowerflow(const SystemTopology& systemPF) {
 	for (auto nodePF : systemPF.mNodes) {
 		if (auto node = this->node<TopologicalNode>(nodePF->name())) {
@@ -96,6 +119,42 @@ void SystemTopology::addTearComponents(const IdentifiedObject::List& components)
 		addTearComponent(comp);
 }
 
+void SystemTopology::moveToTearComponents(const IdentifiedObject::List& components) {
+	for (auto comp : components) {
+		auto it = std::find(mComponents.begin(), mComponents.end(), comp);
+		if (it != mComponents.end())
+			mComponents.erase(it);
+		mTearComponents.push_back(comp);
+	}
+	++mGeneration;
+}
+
+IdentifiedObject::List SystemTopology::decoupleLines(Real timeStep, UInt minDelaySteps) {
+	std::vector<std::shared_ptr<DP::Ph1::PiLine>> lines;
+	for (auto comp : mComponents) {
+		auto line = std::dynamic_pointer_cast<DP::Ph1::PiLine>(comp);
+		if (!line || **line->mParallelCond != 0 || **line->mParallelCap <= 0
+			|| line->node(0)->isGround() || line->node(1)->isGround())
+			continue;
+		// The decoupling line needs the voltages and currents of at least one time step ago
+		Real delay = sqrt(**line->mSeriesInd * **line->mParallelCap);
+		if (delay >= std::max<UInt>(minDelaySteps, 1) * timeStep)
+			lines.push_back(line);
+	}
+
+	IdentifiedObject::List decouplingLines;
+	for (auto line : lines) {
+		removeComponent(line);
+
+		auto dline = Signal::DecouplingLine::make(line->name(), line->node(0), line->node(1),
+			**line->mSeriesRes, **line->mSeriesInd, **line->mParallelCap);
+		addComponent(dline);
+		addComponents(dline->getLineComponents());
+		decouplingLines.push_back(dline);
+	}
+	return decouplingLines;
+}
+
 
 template<typename Type>
 typename std::shared_ptr<Type> SystemTopology::node(UInt index) {
@@ -111,18 +170,45 @@ typename std::shared_ptr<Type> SystemTopology::node(UInt index) {
 
 template<typename Type>
 typename std::shared_ptr<Type> SystemTopology::node(std::string_view name) {
-	for (auto topoNode : mNodes) {
-		if (topoNode->name() == name) {
-			auto node = std::dynamic_pointer_cast<Type>(topoNode);
-			if (node)
-				return node;
-			else
-				return nullptr;
-		}
-	}
+	std::size_t index = findNode(String(name));
+	if (index < mNodes.size())
+		return std::dynamic_pointer_cast<Type>(mNodes[index]);
 	return nullptr;
 }
 
+/// Position of the first object with the given name in the list, rebuilding the index if it is outdated
+template <typename List>
+static std::size_t findByName(const List& list, std::unordered_map<String, std::size_t>& index,
+	std::size_t generation, std::size_t& indexedGeneration, std::size_t& indexedSize, const String& name) {
+	auto it = index.find(name);
+	if (it != index.end() && it->second < list.size() && list[it->second] && list[it->second]->name() == name)
+		return it->second;
+	// Objects may have been erased and others added without changing the length
+	// of the list, so a miss is only trusted if the topology was not changed
+	if (it == index.end() && indexedGeneration == generation && indexedSize == list.size())
+		return list.size();
+
+	index.clear();
+	index.reserve(list.size());
+	for (std::size_t i = 0; i < list.size(); ++i) {
+		if (list[i])
+			index.emplace(list[i]->name(), i);
+	}
+	indexedGeneration = generation;
+	indexedSize = list.size();
+
+	it = index.find(name);
+	return it != index.end() ? it->second : list.size();
+}
+
+std::size_t SystemTopology::findComponent(const String &name) {
+	return findByName(mComponents, mComponentIndex, mGeneration, mIndexedComponentsGeneration, mIndexedComponents, name);
+}
+
+std::size_t SystemTopology::findNode(const String &name) {
+	return findByName(mNodes, mNodeIndex, mGeneration, mIndexedNodesGeneration, mIndexedNodes, name);
+}
+
 std::map<String, String, std::less<>> SystemTopology::listIdObjects() const {
 	std::map<String, String, std::less<>> objTypeMap;
 
@@ -136,65 +222,205 @@ std::map<String, String, std::less<>> SystemTopology::listIdObjects() const {
 }
 
 template<typename VarType>
-void SystemTopology::multiplyPowerComps(Int numberCopies) {
-	typename SimNode<VarType>::List newNodes;
-	typename SimPowerComp<VarType>::List newComponents;
-
-	for (int copy = 0; copy < numberCopies; copy++) {
-		std::unordered_map<typename SimNode<VarType>::Ptr, typename SimNode<VarType>::Ptr> nodeMap;
-		String copySuffix = "_" + std::to_string(copy+2);
-
-		// copy nodes
-		typename SimNode<VarType>::Ptr nodePtr;
-		for (size_t nNode = 0; nNode < mNodes.size(); nNode++) {
-			auto nodePtr = this->node<SimNode<VarType>>(static_cast<UInt>(nNode));
-			if (!nodePtr)
+void SystemTopology::multiplyPowerComps(Int numberCopies, Bool parallel) {
+	// Collect the nodes and components of this domain and the positions of the
+	// terminal nodes once, so that the copies only have to look up indices
+	typename SimNode<VarType>::List nodes;
+	std::unordered_map<const TopologicalNode*, Int> nodeIndex;
+	for (auto topNode : mNodes) {
+		auto node = std::dynamic_pointer_cast<SimNode<VarType>>(topNode);
+		// GND is not copied
+		if (!node || node->isGround())
+			continue;
+		nodeIndex.emplace(node.get(), static_cast<Int>(nodes.size()));
+		nodes.push_back(node);
+	}
+
+	typename SimPowerComp<VarType>::List comps;
+	std::vector<std::vector<Int>> compNodes;
+	for (auto genComp : mComponents) {
+		auto comp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(genComp);
+		if (!comp)
+			continue;
+		std::vector<Int> indices;
+		for (UInt nNode = 0; nNode < comp->terminalNumber(); nNode++) {
+			auto node = comp->node(nNode);
+			if (node->isGround()) {
+				indices.push_back(-1);
 				continue;
+			}
+			auto search = nodeIndex.find(node.get());
+			if (search == nodeIndex.end())
+				throw SystemError("Node " + node->name() + " of " + comp->name() + " is not part of the topology");
+			indices.push_back(search->second);
+		}
+		comps.push_back(comp);
+		compNodes.push_back(indices);
+	}
+
+	if (nodes.empty() && comps.empty())
+		return;
+
+	typename SimNode<VarType>::List newNodes(nodes.size() * numberCopies);
+	typename SimPowerComp<VarType>::List newComponents(comps.size() * numberCopies);
+
+	auto pool = ObjectPool::current();
+	std::exception_ptr error;
+	#pragma omp parallel if(parallel)
+	{
+		// Objects created by the worker threads go to the pool of the caller as well
+		std::optional<ObjectPool::Scope> poolScope;
+		if (pool)
+			poolScope.emplace(pool);
+
+		#pragma omp for schedule(static)
+		for (Int copy = 0; copy < numberCopies; copy++) {
+			try {
+				String copySuffix = "_" + std::to_string(copy+2);
+				auto copyNodes = newNodes.begin() + copy * nodes.size();
+
+				for (std::size_t nNode = 0; nNode < nodes.size(); nNode++) {
+					auto nodeCpy = SimNode<VarType>::make(nodes[nNode]->name() + copySuffix, nodes[nNode]->phaseType());
+					nodeCpy->setInitialVoltage(nodes[nNode]->initialVoltage());
+					nodeCpy->initialize(mFrequencies);
+					copyNodes[nNode] = nodeCpy;
+				}
 
-			// GND is not copied
-			if (nodePtr->isGround()) {
-				nodeMap[nodePtr] = nodePtr;
-			} else {
-				auto nodeCpy = SimNode<VarType>::make(nodePtr->name() + copySuffix, nodePtr->phaseType());
-				nodeCpy->setInitialVoltage(nodePtr->initialVoltage());
-				nodeMap[nodePtr] = nodeCpy;
-				newNodes.push_back(nodeCpy);
+				for (std::size_t nComp = 0; nComp < comps.size(); nComp++) {
+					auto& comp = comps[nComp];
+					auto compCopy = comp->clone(comp->name() + copySuffix);
+					if (!compCopy)
+						throw SystemError("copy() not implemented for " + comp->name());
+
+					// map the nodes to their new copies, creating new terminals
+					typename SimNode<VarType>::List nodeCopies;
+					for (auto index : compNodes[nComp])
+						nodeCopies.push_back(index < 0 ? SimNode<VarType>::GND : copyNodes[index]);
+					compCopy->connect(nodeCopies);
+
+					// update the terminal powers for powerflow initialization
+					for (UInt nTerminal = 0; nTerminal < comp->terminalNumber(); nTerminal++) {
+						compCopy->terminal(nTerminal)->setPower(comp->terminal(nTerminal)->power());
+					}
+					compCopy->initialize(mFrequencies);
+					newComponents[copy * comps.size() + nComp] = compCopy;
+				}
+			}
+			catch (...) {
+				#pragma omp critical
+				if (!error)
+					error = std::current_exception();
 			}
 		}
+	}
+	if (error)
+		std::rethrow_exception(error);
+
+	mNodes.insert(mNodes.end(), newNodes.begin(), newNodes.end());
+	mComponents.insert(mComponents.end(), newComponents.begin(), newComponents.end());
+	++mGeneration;
+}
+
+void SystemTopology::multiply(Int numCopies, Bool parallel) {
+	// Place the copies in one pool unless the caller already set one
+	std::optional<ObjectPool::Scope> poolScope;
+	if (!ObjectPool::current())
+		poolScope.emplace(std::make_shared<ObjectPool>());
+
+	// SimPowerComps should be all EMT or all DP anyway, but this way we don't have to look
+	multiplyPowerComps<Real>(numCopies, parallel);
+	multiplyPowerComps<Complex>(numCopies, parallel);
+}
+
+template<typename VarType>
+void SystemTopology::copyPowerComps(SystemTopology& target) const {
+	std::unordered_map<const TopologicalNode*, typename SimNode<VarType>::Ptr> nodeCopies;
+	for (auto topNode : mNodes) {
+		auto node = std::dynamic_pointer_cast<SimNode<VarType>>(topNode);
+		if (!node || node->isGround())
+			continue;
+		auto nodeCpy = SimNode<VarType>::make(node->name(), node->phaseType());
+		nodeCpy->setInitialVoltage(node->initialVoltage());
+		nodeCpy->initialize(mFrequencies);
+		nodeCopies.emplace(node.get(), nodeCpy);
+		target.mNodes.push_back(nodeCpy);
+	}
 
-		// copy components
-		for (auto genComp : mComponents) {
+	auto copyComponents = [&](const IdentifiedObject::List& components, IdentifiedObject::List& copies) {
+		for (auto genComp : components) {
 			auto comp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(genComp);
 			if (!comp)
 				continue;
-			auto copy = comp->clone(comp->name() + copySuffix);
-			if (!copy)
+			auto compCopy = comp->clone(comp->name());
+			if (!compCopy)
 				throw SystemError("copy() not implemented for " + comp->name());
 
-			// map the nodes to their new copies, creating new terminals
-			typename SimNode<VarType>::List nodeCopies;
+			typename SimNode<VarType>::List nodes;
 			for (UInt nNode = 0; nNode < comp->terminalNumber(); nNode++) {
-				nodeCopies.push_back(nodeMap[comp->node(nNode)]);
+				auto node = comp->node(nNode);
+				if (node->isGround()) {
+					nodes.push_back(SimNode<VarType>::GND);
+					continue;
+				}
+				auto search = nodeCopies.find(node.get());
+				if (search == nodeCopies.end())
+					throw SystemError("Node " + node->name() + " of " + comp->name() + " is not part of the topology");
+				nodes.push_back(search->second);
 			}
-			copy->connect(nodeCopies);
+			compCopy->connect(nodes);
 
-			// update the terminal powers for powerflow initialization
-			for (UInt nTerminal = 0; nTerminal < comp->terminalNumber(); nTerminal++) {
-				copy->terminal(nTerminal)->setPower(comp->terminal(nTerminal)->power());
-			}
-			newComponents.push_back(copy);
+			for (UInt nTerminal = 0; nTerminal < comp->terminalNumber(); nTerminal++)
+				compCopy->terminal(nTerminal)->setPower(comp->terminal(nTerminal)->power());
+			compCopy->initialize(mFrequencies);
+			copies.push_back(compCopy);
+		}
+	};
+	copyComponents(mComponents, target.mComponents);
+	copyComponents(mTearComponents, target.mTearComponents);
+}
+
+SystemTopology SystemTopology::copy() const {
+	for (auto components : { &mComponents, &mTearComponents }) {
+		for (auto comp : *components) {
+			if (!std::dynamic_pointer_cast<SimPowerComp<Real>>(comp) && !std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp))
+				throw SystemError("copy() not implemented for " + comp->name());
 		}
 	}
-	for (auto node : newNodes)
-		addNode(node);
-	for (auto comp : newComponents)
-		addComponent(comp);
+
+	SystemTopology target(mSystemFrequency);
+	target.mFrequencies = mFrequencies;
+	copyPowerComps<Real>(target);
+	copyPowerComps<Complex>(target);
+	target.componentsAtNodeList();
+	return target;
 }
 
-void SystemTopology::multiply(Int numCopies) {
-	// SimPowerComps should be all EMT or all DP anyway, but this way we don't have to look
-	multiplyPowerComps<Real>(numCopies);
-	multiplyPowerComps<Complex>(numCopies);
+std::vector<std::pair<String, String>> SystemTopology::randomInterconnections(Int numberCopies,
+	const std::vector<String>& nodeNames, UInt count, UInt seed) {
+
+	std::vector<std::pair<String, String>> connections;
+	if (numberCopies < 1 || nodeNames.empty())
+		return connections;
+
+	// Copy 0 is the original topology without suffix
+	auto copyName = [](const String& name, Int copy) {
+		return copy == 0 ? name : name + "_" + std::to_string(copy+1);
+	};
+
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<Int> copyDist(0, numberCopies);
+	std::uniform_int_distribution<std::size_t> nodeDist(0, nodeNames.size()-1);
+	connections.reserve(count);
+	for (UInt i = 0; i < count; i++) {
+		Int copy1 = copyDist(generator);
+		// Draw the second copy from the remaining ones
+		Int copy2 = std::uniform_int_distribution<Int>(0, numberCopies-1)(generator);
+		if (copy2 >= copy1)
+			copy2++;
+		connections.emplace_back(copyName(nodeNames[nodeDist(generator)], copy1),
+			copyName(nodeNames[nodeDist(generator)], copy2));
+	}
+	return connections;
 }
 
 /// DEPRECATED: Unused
@@ -204,29 +430,54 @@ void SystemTopology::reset() {
 	// }
 }
 
+Bool SystemTopology::isHybrid() const {
+	Bool emtNodes = false, phasorNodes = false;
+	for (auto node : mNodes) {
+		emtNodes |= std::dynamic_pointer_cast<SimNode<Real>>(node) != nullptr;
+		phasorNodes |= std::dynamic_pointer_cast<SimNode<Complex>>(node) != nullptr;
+	}
+	return emtNodes && phasorNodes;
+}
+
+void SystemTopology::splitDomains(SystemTopology& phasorSystem, SystemTopology& emtSystem) const {
+	TopologicalNode::List phasorNodes, emtNodes;
+	for (auto node : mNodes) {
+		if (std::dynamic_pointer_cast<SimNode<Real>>(node))
+			emtNodes.push_back(node);
+		else
+			phasorNodes.push_back(node);
+	}
+	IdentifiedObject::List phasorComps, emtComps;
+	for (auto comp : mComponents) {
+		if (std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp))
+			phasorComps.push_back(comp);
+		else
+			emtComps.push_back(comp);
+	}
+	phasorSystem = SystemTopology(mSystemFrequency, mFrequencies, phasorNodes, phasorComps);
+	emtSystem = SystemTopology(mSystemFrequency, emtNodes, emtComps);
+}
+
 template <typename VarType>
 void SystemTopology::splitSubnets(std::vector<SystemTopology>& splitSystems) {
-	std::unordered_map<typename SimNode<VarType>::Ptr, int> subnet;
-	int numberSubnets = checkTopologySubnets<VarType>(subnet);
-	if (numberSubnets == 1) {
+	TopologyGraph<VarType> graph(mNodes, mComponents);
+	std::vector<UInt> island;
+	UInt numberSubnets = graph.islands(island);
+	if (numberSubnets <= 1) {
 		splitSystems.push_back(*this);
 	} else {
 		std::vector<IdentifiedObject::List> components(numberSubnets);
 		std::vector<TopologicalNode::List> nodes(numberSubnets);
 
 		// Split nodes into subnet groups
-		for (auto node : mNodes) {
-			auto pnode = std::dynamic_pointer_cast<SimNode<VarType>>(node);
-			if (!pnode || node->isGround())
-				continue;
-
-			nodes[subnet[pnode]].push_back(node);
-		}
+		for (UInt k = 0; k < graph.nodeCount(); k++)
+			nodes[island[k]].push_back(graph.node(k));
 
-		// Split components into subnet groups
+		// Split components into subnet groups. The power components of the graph
+		// are in the order of mComponents, so they are matched without casting again.
+		UInt graphComp = 0;
 		for (auto comp : mComponents) {
-			auto pcomp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
-			if (!pcomp) {
+			if (graphComp == graph.componentCount() || graph.component(graphComp) != comp) {
 				// TODO this should only be signal components.
 				// Proper solution would be to pass them to a different "solver"
 				// since they are actually independent of which solver we use
@@ -235,14 +486,12 @@ void SystemTopology::splitSubnets(std::vector<SystemTopology>& splitSystems) {
 				components[0].push_back(comp);
 				continue;
 			}
-			for (UInt nodeIdx = 0; nodeIdx < pcomp->terminalNumber(); nodeIdx++) {
-				if (!pcomp->node(nodeIdx)->isGround()) {
-					components[subnet[pcomp->node(nodeIdx)]].push_back(comp);
-					break;
-				}
-			}
+			const UInt* compNodes = graph.componentNodesBegin(graphComp);
+			if (compNodes != graph.componentNodesEnd(graphComp))
+				components[island[*compNodes]].push_back(comp);
+			graphComp++;
 		}
-		for (int currentNet = 0; currentNet < numberSubnets; currentNet++) {
+		for (UInt currentNet = 0; currentNet < numberSubnets; currentNet++) {
 			splitSystems.emplace_back(mSystemFrequency,
 				nodes[currentNet], components[currentNet]);
 		}
@@ -251,61 +500,12 @@ void SystemTopology::splitSubnets(std::vector<SystemTopology>& splitSystems) {
 
 template <typename VarType>
 int SystemTopology::checkTopologySubnets(std::unordered_map<typename SimNode<VarType>::Ptr, int>& subnet) {
-	std::unordered_map<typename SimNode<VarType>::Ptr, typename SimNode<VarType>::List> neighbours;
-
-	for (auto comp : mComponents) {
-		auto pcomp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
-		if (!pcomp)
-			continue;
-
-		for (UInt nodeIdx1 = 0; nodeIdx1 < pcomp->terminalNumberConnected(); nodeIdx1++) {
-			for (UInt nodeIdx2 = 0; nodeIdx2 < nodeIdx1; nodeIdx2++) {
-				auto node1 = pcomp->node(nodeIdx1);
-				auto node2 = pcomp->node(nodeIdx2);
-				if (node1->isGround() || node2->isGround())
-					continue;
-
-				neighbours[node1].push_back(node2);
-				neighbours[node2].push_back(node1);
-			}
-		}
-	}
-
-	int currentNet = 0;
-	size_t totalNodes = mNodes.size();
-	for (auto tnode : mNodes) {
-		auto node = std::dynamic_pointer_cast<SimNode<VarType>>(tnode);
-		if (!node || tnode->isGround()) {
-			totalNodes--;
-		}
-	}
-
-	while (subnet.size() != totalNodes) {
-		std::list<typename SimNode<VarType>::Ptr> nextSet;
-
-		for (auto tnode : mNodes) {
-			auto node = std::dynamic_pointer_cast<SimNode<VarType>>(tnode);
-			if (!node || tnode->isGround())
-				continue;
-
-			if (subnet.find(node) == subnet.end()) {
-				nextSet.push_back(node);
-				break;
-			}
-		}
-		while (!nextSet.empty()) {
-			auto node = nextSet.front();
-			nextSet.pop_front();
-
-			subnet[node] = currentNet;
-			for (auto neighbour : neighbours[node]) {
-				if (subnet.find(neighbour) == subnet.end())
-					nextSet.push_back(neighbour);
-			}
-		}
-		currentNet++;
-	}
-	return currentNet;
+	TopologyGraph<VarType> graph(mNodes, mComponents);
+	std::vector<UInt> island;
+	UInt numberSubnets = graph.islands(island);
+	for (UInt k = 0; k < graph.nodeCount(); k++)
+		subnet[graph.node(k)] = static_cast<int>(island[k]);
+	return static_cast<int>(numberSubnets);
 }
 
 #ifdef WITH_GRAPHVIZ
@@ -422,8 +622,8 @@ void SystemTopology::renderToFile(String filename) {
 #endif
 
 // Explicit instantiation of template functions to be able to keep the definition in the cpp
-template void SystemTopology::multiplyPowerComps<Real>(Int numberCopies);
-template void SystemTopology::multiplyPowerComps<Complex>(Int numberCopies);
+template void SystemTopology::multiplyPowerComps<Real>(Int numberCopies, Bool parallel);
+template void SystemTopology::multiplyPowerComps<Complex>(Int numberCopies, Bool parallel);
 template std::shared_ptr<TopologicalNode> SystemTopology::node<TopologicalNode>(UInt index);
 template std::shared_ptr<TopologicalNode> SystemTopology::node<TopologicalNode>(std::string_view name);
 template std::shared_ptr<SimNode<Real>> SystemTopology::node<SimNode<Real>>(UInt index);
@@ -0,0 +1,164 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <numeric>
+
+#include <dpsim-models/TopologyGraph.h>
+
+using namespace CPS;
+
+template <typename VarType>
+TopologyGraph<VarType>::TopologyGraph(const TopologicalNode::List& nodes, const IdentifiedObject::List& components) {
+	for (auto& topoNode : nodes) {
+		auto node = std::dynamic_pointer_cast<SimNode<VarType>>(topoNode);
+		if (!node || node->isGround())
+			continue;
+		mNodeIndex.emplace(node.get(), static_cast<UInt>(mNodes.size()));
+		mNodes.push_back(node);
+	}
+
+	mCompNodeStart.push_back(0);
+	for (auto& comp : components) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (!pComp)
+			continue;
+		for (UInt t = 0; t < pComp->terminalNumberConnected(); ++t) {
+			UInt k = nodeIndex(pComp->node(t).get());
+			if (k != noNode)
+				mCompNodes.push_back(k);
+		}
+		mComponents.push_back(pComp);
+		mCompNodeStart.push_back(static_cast<UInt>(mCompNodes.size()));
+	}
+
+	// Components at the nodes and star edges of the components by counting sort
+	mNodeCompStart.assign(mNodes.size() + 1, 0);
+	mAdjacencyStart.assign(mNodes.size() + 1, 0);
+	for (UInt c = 0; c < componentCount(); ++c) {
+		const UInt* begin = componentNodesBegin(c);
+		const UInt* end = componentNodesEnd(c);
+		for (const UInt* k = begin; k != end; ++k) {
+			if (std::find(begin, k, *k) == k)
+				++mNodeCompStart[*k + 1];
+			if (k != begin && *k != *begin) {
+				mEdges.emplace_back(*begin, *k);
+				mEdgeComponent.push_back(c);
+				++mAdjacencyStart[*begin + 1];
+				++mAdjacencyStart[*k + 1];
+			}
+		}
+	}
+	std::partial_sum(mNodeCompStart.begin(), mNodeCompStart.end(), mNodeCompStart.begin());
+	std::partial_sum(mAdjacencyStart.begin(), mAdjacencyStart.end(), mAdjacencyStart.begin());
+
+	std::vector<UInt> fill(mNodeCompStart.begin(), mNodeCompStart.end() - 1);
+	mNodeComps.resize(mNodeCompStart.back());
+	for (UInt c = 0; c < componentCount(); ++c) {
+		const UInt* begin = componentNodesBegin(c);
+		for (const UInt* k = begin; k != componentNodesEnd(c); ++k) {
+			if (std::find(begin, k, *k) == k)
+				mNodeComps[fill[*k]++] = c;
+		}
+	}
+
+	fill.assign(mAdjacencyStart.begin(), mAdjacencyStart.end() - 1);
+	mAdjacency.resize(mAdjacencyStart.back());
+	for (UInt e = 0; e < edgeCount(); ++e) {
+		mAdjacency[fill[mEdges[e].first]++] = { mEdges[e].second, e };
+		mAdjacency[fill[mEdges[e].second]++] = { mEdges[e].first, e };
+	}
+}
+
+template <typename VarType>
+UInt TopologyGraph<VarType>::nodeIndex(const TopologicalNode* node) const {
+	auto search = mNodeIndex.find(node);
+	return search == mNodeIndex.end() ? noNode : search->second;
+}
+
+template <typename VarType>
+UInt TopologyGraph<VarType>::islands(std::vector<UInt>& island) const {
+	std::vector<UInt> parent(nodeCount());
+	std::iota(parent.begin(), parent.end(), 0);
+	auto find = [&parent](UInt k) {
+		while (parent[k] != k)
+			k = parent[k] = parent[parent[k]];
+		return k;
+	};
+	// The smaller root becomes the parent, so the root of an island is its first node
+	for (auto& edge : mEdges) {
+		UInt root0 = find(edge.first);
+		UInt root1 = find(edge.second);
+		if (root0 < root1)
+			parent[root1] = root0;
+		else if (root1 < root0)
+			parent[root0] = root1;
+	}
+
+	UInt count = 0;
+	island.assign(nodeCount(), noNode);
+	for (UInt k = 0; k < nodeCount(); ++k) {
+		UInt root = find(k);
+		if (root == k)
+			island[k] = count++;
+		else
+			island[k] = island[root];
+	}
+	return count;
+}
+
+template <typename VarType>
+std::vector<UInt> TopologyGraph<VarType>::bridges() const {
+	// Iterative depth first search with low links. The edge to the parent is
+	// skipped by its index, so that parallel edges are no bridges.
+	const UInt unvisited = noNode;
+	std::vector<UInt> order(nodeCount(), unvisited);
+	std::vector<UInt> low(nodeCount(), 0);
+	std::vector<UInt> next(mAdjacencyStart.begin(), mAdjacencyStart.end() - 1);
+	std::vector<std::pair<UInt, UInt>> stack;
+	std::vector<UInt> bridgeComps;
+	UInt counter = 0;
+
+	for (UInt root = 0; root < nodeCount(); ++root) {
+		if (order[root] != unvisited)
+			continue;
+		order[root] = low[root] = counter++;
+		stack.emplace_back(root, noNode);
+
+		while (!stack.empty()) {
+			UInt k = stack.back().first;
+			UInt parentEdge = stack.back().second;
+			if (next[k] < mAdjacencyStart[k+1]) {
+				auto& neighbour = mAdjacency[next[k]++];
+				if (neighbour.second == parentEdge)
+					continue;
+				if (order[neighbour.first] == unvisited) {
+					order[neighbour.first] = low[neighbour.first] = counter++;
+					stack.emplace_back(neighbour.first, neighbour.second);
+				} else {
+					low[k] = std::min(low[k], order[neighbour.first]);
+				}
+			} else {
+				stack.pop_back();
+				if (stack.empty())
+					break;
+				UInt parent = stack.back().first;
+				low[parent] = std::min(low[parent], low[k]);
+				if (low[k] > order[parent])
+					bridgeComps.push_back(mEdgeComponent[parentEdge]);
+			}
+		}
+	}
+
+	std::sort(bridgeComps.begin(), bridgeComps.end());
+	bridgeComps.erase(std::unique(bridgeComps.begin(), bridgeComps.end()), bridgeComps.end());
+	return bridgeComps;
+}
+
+template class CPS::TopologyGraph<Real>;
+template class CPS::TopologyGraph<Complex>;
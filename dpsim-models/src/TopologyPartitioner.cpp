@@ -0,0 +1,405 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <set>
+
+#include <dpsim-models/TopologyPartitioner.h>
+#include <dpsim-models/TopologyGraph.h>
+#include <dpsim-models/Solver/MNATearInterface.h>
+
+using namespace CPS;
+
+namespace {
+	const UInt noVertex = std::numeric_limits<UInt>::max();
+	/// Graphs with at most this many vertices are bisected directly
+	const UInt coarsestSize = 20;
+	/// Moves without improvement after which a refinement pass stops
+	const UInt maxNonImprovingMoves = 200;
+	const UInt maxRefinementPasses = 10;
+}
+
+TopologyPartitioner::TopologyPartitioner(String name, Logger::Level logLevel) :
+	mSLog(Logger::get(name, logLevel)) { }
+
+UInt TopologyPartitioner::Graph::totalWeight() const {
+	return std::accumulate(weights.begin(), weights.end(), UInt(0));
+}
+
+template <typename VarType>
+IdentifiedObject::List TopologyPartitioner::partition(const SystemTopology& system, UInt numPartitions) {
+	mNodePartitions.clear();
+	mPartitionWeights.assign(numPartitions, 0);
+
+	TopologyGraph<VarType> topology(system.mNodes, system.mComponents);
+	const UInt numNodes = topology.nodeCount();
+	if (numNodes == 0 || numPartitions <= 1)
+		return {};
+
+	// Nodes connected by components which cannot be torn stay together
+	std::vector<UInt> parent(numNodes);
+	std::iota(parent.begin(), parent.end(), 0);
+	auto find = [&parent](UInt k) {
+		while (parent[k] != k)
+			k = parent[k] = parent[parent[k]];
+		return k;
+	};
+
+	struct Candidate {
+		IdentifiedObject::Ptr component;
+		UInt node0, node1;
+	};
+	std::vector<Candidate> candidates;
+	std::vector<std::set<UInt>> neighbours(numNodes);
+	std::vector<UInt> virtualNodes(numNodes, 0);
+
+	for (UInt c = 0; c < topology.componentCount(); ++c) {
+		auto& pComp = topology.component(c);
+		std::vector<UInt> terminals(topology.componentNodesBegin(c), topology.componentNodesEnd(c));
+		if (terminals.empty())
+			continue;
+
+		if (pComp->hasVirtualNodes())
+			virtualNodes[terminals[0]] += pComp->virtualNodesNumber();
+		for (auto k : terminals)
+			for (auto l : terminals)
+				if (k != l)
+					neighbours[k].insert(l);
+
+		// The diakoptics solver stamps one matrix index per terminal of a torn component
+		Bool tearable = terminals.size() == 2 && terminals[0] != terminals[1]
+			&& std::dynamic_pointer_cast<MNATearInterface>(pComp)
+			&& topology.node(terminals[0])->phaseType() == PhaseType::Single
+			&& topology.node(terminals[1])->phaseType() == PhaseType::Single;
+		if (tearable) {
+			candidates.push_back({pComp, terminals[0], terminals[1]});
+		} else {
+			for (auto k : terminals)
+				parent[find(k)] = find(terminals[0]);
+		}
+	}
+
+	// Graph of the groups of nodes which stay together, the edges are the candidates
+	std::vector<UInt> vertexOfNode(numNodes, noVertex);
+	Graph graph;
+	for (UInt k = 0; k < numNodes; ++k) {
+		UInt root = find(k);
+		if (vertexOfNode[root] == noVertex) {
+			vertexOfNode[root] = graph.size();
+			graph.weights.push_back(0);
+		}
+		vertexOfNode[k] = vertexOfNode[root];
+		// Nonzeros of the rows of the node and of the virtual nodes of its components
+		UInt phases = topology.node(k)->phaseType() == PhaseType::ABC ? 3 : 1;
+		graph.weights[vertexOfNode[k]] += phases * (1 + static_cast<UInt>(neighbours[k].size())) + 3 * virtualNodes[k];
+	}
+
+	std::map<std::pair<UInt, UInt>, UInt> edges;
+	for (auto& candidate : candidates) {
+		UInt v0 = vertexOfNode[candidate.node0];
+		UInt v1 = vertexOfNode[candidate.node1];
+		if (v0 != v1)
+			++edges[std::minmax(v0, v1)];
+	}
+	graph.adjacency.resize(graph.size());
+	for (auto& edge : edges) {
+		graph.adjacency[edge.first.first].emplace_back(edge.first.second, edge.second);
+		graph.adjacency[edge.first.second].emplace_back(edge.first.first, edge.second);
+	}
+
+	auto partition = partitionGraph(graph.weights, graph.adjacency, numPartitions);
+
+	for (UInt k = 0; k < numNodes; ++k)
+		mNodePartitions[topology.node(k)->name()] = partition[vertexOfNode[k]];
+	for (UInt v = 0; v < graph.size(); ++v)
+		mPartitionWeights[partition[v]] += graph.weights[v];
+
+	IdentifiedObject::List tearComponents;
+	for (auto& candidate : candidates) {
+		if (partition[vertexOfNode[candidate.node0]] != partition[vertexOfNode[candidate.node1]])
+			tearComponents.push_back(candidate.component);
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "Partitioned {} nodes into {} subnets with {} of {} tear candidates",
+		numNodes, numPartitions, tearComponents.size(), candidates.size());
+	for (UInt p = 0; p < numPartitions; ++p)
+		SPDLOG_LOGGER_INFO(mSLog, "Subnet {}: weight {}", p, mPartitionWeights[p]);
+	return tearComponents;
+}
+
+std::vector<UInt> TopologyPartitioner::partitionGraph(const std::vector<UInt>& weights,
+	const std::vector<std::vector<std::pair<UInt, UInt>>>& adjacency, UInt numPartitions) {
+	Graph graph;
+	graph.weights = weights;
+	graph.adjacency = adjacency;
+
+	std::vector<UInt> partition(graph.size(), 0);
+	if (numPartitions <= 1 || graph.size() == 0)
+		return partition;
+
+	std::vector<UInt> vertices(graph.size());
+	std::iota(vertices.begin(), vertices.end(), 0);
+	// The imbalances of the bisection levels multiply
+	Real levels = std::ceil(std::log2(static_cast<Real>(numPartitions)));
+	Real levelImbalance = std::pow(1 + mImbalance, 1 / levels) - 1;
+	recursiveBisection(graph, vertices, numPartitions, 0, levelImbalance, partition);
+	return partition;
+}
+
+void TopologyPartitioner::recursiveBisection(const Graph& graph, const std::vector<UInt>& vertices,
+	UInt numPartitions, UInt firstPartition, Real imbalance, std::vector<UInt>& partition) {
+	if (numPartitions == 1 || vertices.size() <= 1) {
+		for (auto v : vertices)
+			partition[v] = firstPartition;
+		return;
+	}
+
+	// Graph induced by the vertices, the edges to other vertices are cut already
+	std::vector<UInt> local(graph.size(), noVertex);
+	for (UInt i = 0; i < vertices.size(); ++i)
+		local[vertices[i]] = i;
+	Graph sub;
+	sub.adjacency.resize(vertices.size());
+	for (UInt i = 0; i < vertices.size(); ++i) {
+		sub.weights.push_back(graph.weights[vertices[i]]);
+		for (auto& edge : graph.adjacency[vertices[i]]) {
+			if (local[edge.first] != noVertex)
+				sub.adjacency[i].emplace_back(local[edge.first], edge.second);
+		}
+	}
+
+	UInt numPartitions0 = numPartitions / 2;
+	UInt totalWeight = sub.totalWeight();
+	UInt targetWeight0 = static_cast<UInt>(std::llround(static_cast<Real>(totalWeight) * numPartitions0 / numPartitions));
+	auto part = bisect(sub, targetWeight0, totalWeight - targetWeight0, imbalance);
+
+	std::vector<UInt> vertices0, vertices1;
+	for (UInt i = 0; i < vertices.size(); ++i)
+		(part[i] == 0 ? vertices0 : vertices1).push_back(vertices[i]);
+	recursiveBisection(graph, vertices0, numPartitions0, firstPartition, imbalance, partition);
+	recursiveBisection(graph, vertices1, numPartitions - numPartitions0, firstPartition + numPartitions0, imbalance, partition);
+}
+
+std::vector<UInt> TopologyPartitioner::bisect(const Graph& graph, UInt targetWeight0, UInt targetWeight1, Real imbalance) {
+	UInt maxWeight0 = static_cast<UInt>(std::ceil(targetWeight0 * (1 + imbalance)));
+	UInt maxWeight1 = static_cast<UInt>(std::ceil(targetWeight1 * (1 + imbalance)));
+	UInt maxVertexWeight = std::max<UInt>(1, std::min(targetWeight0, targetWeight1) / 4);
+
+	// Coarsening
+	std::vector<Graph> levels{graph};
+	std::vector<std::vector<UInt>> coarseVertices;
+	while (levels.back().size() > coarsestSize) {
+		Graph coarse;
+		auto map = coarsen(levels.back(), coarse, maxVertexWeight);
+		if (coarse.size() * 10 > levels.back().size() * 9)
+			break;
+		coarseVertices.push_back(std::move(map));
+		levels.push_back(std::move(coarse));
+	}
+
+	// Bisection of the coarsest graph and refinement while uncoarsening
+	auto part = initialBisection(levels.back(), targetWeight0, maxWeight0, maxWeight1);
+	for (Int level = static_cast<Int>(coarseVertices.size()) - 1; level >= 0; --level) {
+		std::vector<UInt> finePart(levels[level].size());
+		for (UInt v = 0; v < finePart.size(); ++v)
+			finePart[v] = part[coarseVertices[level][v]];
+		part = std::move(finePart);
+		refine(levels[level], part, maxWeight0, maxWeight1);
+	}
+	return part;
+}
+
+std::vector<UInt> TopologyPartitioner::coarsen(const Graph& graph, Graph& coarse, UInt maxVertexWeight) {
+	// Fixed seed for reproducible partitions
+	std::vector<UInt> order(graph.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::shuffle(order.begin(), order.end(), std::mt19937(graph.size()));
+
+	std::vector<UInt> match(graph.size(), noVertex);
+	for (auto v : order) {
+		if (match[v] != noVertex)
+			continue;
+		UInt best = noVertex, bestWeight = 0;
+		for (auto& edge : graph.adjacency[v]) {
+			UInt u = edge.first;
+			if (match[u] == noVertex && u != v && edge.second > bestWeight
+				&& graph.weights[u] + graph.weights[v] <= maxVertexWeight) {
+				best = u;
+				bestWeight = edge.second;
+			}
+		}
+		match[v] = best == noVertex ? v : best;
+		if (best != noVertex)
+			match[best] = v;
+	}
+
+	std::vector<UInt> map(graph.size(), noVertex);
+	for (UInt v = 0; v < graph.size(); ++v) {
+		if (map[v] != noVertex)
+			continue;
+		map[v] = map[match[v]] = coarse.size();
+		coarse.weights.push_back(graph.weights[v] + (match[v] != v ? graph.weights[match[v]] : 0));
+	}
+
+	std::vector<std::map<UInt, UInt>> edges(coarse.size());
+	for (UInt v = 0; v < graph.size(); ++v) {
+		for (auto& edge : graph.adjacency[v]) {
+			if (map[v] != map[edge.first])
+				edges[map[v]][map[edge.first]] += edge.second;
+		}
+	}
+	coarse.adjacency.resize(coarse.size());
+	for (UInt c = 0; c < coarse.size(); ++c)
+		coarse.adjacency[c].assign(edges[c].begin(), edges[c].end());
+	return map;
+}
+
+std::vector<UInt> TopologyPartitioner::initialBisection(const Graph& graph, UInt targetWeight0, UInt maxWeight0, UInt maxWeight1) {
+	std::vector<UInt> best;
+	UInt bestPenalty = 0, bestCut = 0;
+	UInt numSeeds = std::min<UInt>(graph.size(), 8);
+
+	for (UInt s = 0; s < numSeeds; ++s) {
+		// Grow part 0 from the seed, preferring the vertices with the most edges into it
+		std::vector<UInt> part(graph.size(), 1);
+		std::vector<Int> gain(graph.size(), 0);
+		for (UInt v = 0; v < graph.size(); ++v)
+			for (auto& edge : graph.adjacency[v])
+				gain[v] -= static_cast<Int>(edge.second);
+
+		UInt weight0 = 0;
+		UInt next = s * graph.size() / numSeeds;
+		while (next != noVertex) {
+			part[next] = 0;
+			weight0 += graph.weights[next];
+			for (auto& edge : graph.adjacency[next])
+				gain[edge.first] += 2 * static_cast<Int>(edge.second);
+			if (weight0 >= targetWeight0)
+				break;
+
+			next = noVertex;
+			Bool connected = false;
+			for (UInt v = 0; v < graph.size(); ++v) {
+				if (part[v] == 0 || weight0 + graph.weights[v] > maxWeight0)
+					continue;
+				Bool adjacent = std::any_of(graph.adjacency[v].begin(), graph.adjacency[v].end(),
+					[&part](const std::pair<UInt, UInt>& edge) { return part[edge.first] == 0; });
+				if (next == noVertex || (adjacent && !connected) || (adjacent == connected && gain[v] > gain[next])) {
+					next = v;
+					connected = adjacent;
+				}
+			}
+		}
+		refine(graph, part, maxWeight0, maxWeight1);
+
+		UInt weight[2] = {0, 0};
+		for (UInt v = 0; v < graph.size(); ++v)
+			weight[part[v]] += graph.weights[v];
+		UInt penalty = (weight[0] > maxWeight0 ? weight[0] - maxWeight0 : 0) + (weight[1] > maxWeight1 ? weight[1] - maxWeight1 : 0);
+		UInt partCut = cut(graph, part);
+		if (best.empty() || penalty < bestPenalty || (penalty == bestPenalty && partCut < bestCut)) {
+			best = part;
+			bestPenalty = penalty;
+			bestCut = partCut;
+		}
+	}
+	return best;
+}
+
+void TopologyPartitioner::refine(const Graph& graph, std::vector<UInt>& part, UInt maxWeight0, UInt maxWeight1) {
+	const UInt maxWeight[2] = {maxWeight0, maxWeight1};
+	auto penalty = [&maxWeight](const UInt weight[2]) {
+		return (weight[0] > maxWeight[0] ? weight[0] - maxWeight[0] : 0) + (weight[1] > maxWeight[1] ? weight[1] - maxWeight[1] : 0);
+	};
+
+	for (UInt pass = 0; pass < maxRefinementPasses; ++pass) {
+		UInt weight[2] = {0, 0};
+		std::vector<Int> gain(graph.size(), 0);
+		for (UInt v = 0; v < graph.size(); ++v) {
+			weight[part[v]] += graph.weights[v];
+			for (auto& edge : graph.adjacency[v])
+				gain[v] += part[edge.first] != part[v] ? static_cast<Int>(edge.second) : -static_cast<Int>(edge.second);
+		}
+
+		// Vertices ordered by decreasing gain
+		std::set<std::pair<Int, UInt>> queue;
+		for (UInt v = 0; v < graph.size(); ++v)
+			queue.emplace(-gain[v], v);
+
+		Int currentCut = static_cast<Int>(cut(graph, part));
+		UInt bestPenalty = penalty(weight);
+		Int bestCut = currentCut;
+		std::vector<UInt> moves;
+		UInt bestMoves = 0;
+
+		while (!queue.empty() && moves.size() - bestMoves < maxNonImprovingMoves) {
+			UInt currentPenalty = penalty(weight);
+			auto selected = queue.end();
+			for (auto it = queue.begin(); it != queue.end(); ++it) {
+				UInt v = it->second;
+				UInt from = part[v], to = 1 - part[v];
+				UInt moved[2];
+				moved[from] = weight[from] - graph.weights[v];
+				moved[to] = weight[to] + graph.weights[v];
+				if (moved[to] <= maxWeight[to] || penalty(moved) < currentPenalty) {
+					selected = it;
+					break;
+				}
+			}
+			if (selected == queue.end())
+				break;
+
+			UInt v = selected->second;
+			queue.erase(selected);
+			UInt from = part[v];
+			part[v] = 1 - from;
+			weight[from] -= graph.weights[v];
+			weight[1 - from] += graph.weights[v];
+			currentCut -= gain[v];
+			for (auto& edge : graph.adjacency[v]) {
+				UInt u = edge.first;
+				auto it = queue.find({-gain[u], u});
+				if (it == queue.end())
+					continue;
+				queue.erase(it);
+				gain[u] += part[u] == from ? 2 * static_cast<Int>(edge.second) : -2 * static_cast<Int>(edge.second);
+				queue.emplace(-gain[u], u);
+			}
+			moves.push_back(v);
+
+			UInt movePenalty = penalty(weight);
+			if (movePenalty < bestPenalty || (movePenalty == bestPenalty && currentCut < bestCut)) {
+				bestPenalty = movePenalty;
+				bestCut = currentCut;
+				bestMoves = static_cast<UInt>(moves.size());
+			}
+		}
+
+		// Undo the moves after the best state of the pass
+		for (UInt m = static_cast<UInt>(moves.size()); m > bestMoves; --m)
+			part[moves[m - 1]] = 1 - part[moves[m - 1]];
+		if (bestMoves == 0)
+			break;
+	}
+}
+
+UInt TopologyPartitioner::cut(const Graph& graph, const std::vector<UInt>& part) {
+	UInt total = 0;
+	for (UInt v = 0; v < graph.size(); ++v)
+		for (auto& edge : graph.adjacency[v])
+			if (part[edge.first] != part[v])
+				total += edge.second;
+	return total / 2;
+}
+
+template IdentifiedObject::List TopologyPartitioner::partition<Real>(const SystemTopology& system, UInt numPartitions);
+template IdentifiedObject::List TopologyPartitioner::partition<Complex>(const SystemTopology& system, UInt numPartitions);
@@ -36,7 +36,8 @@ namespace DPsim {
 		/// @param idx The id given to the attribute within VILLASnode samples
 		/// @param blockOnRead Whether the simulation should block on every import until the attribute has been updated
 		/// @param syncOnSimulationStart Whether the simulation should block before the first timestep until this attribute has been updated
-        void importAttribute(CPS::AttributeBase::Ptr attr, UInt idx, Bool blockOnRead = false, Bool syncOnSimulationStart = true);
+		/// @param downsampling Only import the attribute on every nth timestep, 0 uses the downsampling of the interface
+        void importAttribute(CPS::AttributeBase::Ptr attr, UInt idx, Bool blockOnRead = false, Bool syncOnSimulationStart = true, UInt downsampling = 0);
 		
 		/// @brief configure an attribute export
 		/// @param attr the attribute which's value should be exported
@@ -44,7 +45,29 @@ namespace DPsim {
 		/// @param waitForOnWrite Whether a sample that is sent from this interface is required to contain an updated value of this attribute
 		/// @param name Name given to the attribute within VILLASnode samples
 		/// @param unit Unit given to the attribute within VILLASnode samples
-		void exportAttribute(CPS::AttributeBase::Ptr attr, UInt idx, Bool waitForOnWrite, const String& name = "", const String& unit = "");
+		/// @param downsampling Only export the attribute on every nth timestep, 0 uses the downsampling of the interface
+		/// @param deadband Only export the attribute if its value changed by more than this, 0 exports it on every downsampled timestep
+		/// @param onChange Only export the attribute if its version changed, for attributes written through `set`
+		/// Real matrices, e.g. `Simulation::mObservedValues`, take one sample entry per element from idx on,
+		/// their size has to be final when they are exported. If all exports are Real values or matrices
+		/// at consecutive entries from 0 on, a sample is filled with a single copy.
+		void exportAttribute(CPS::AttributeBase::Ptr attr, UInt idx, Bool waitForOnWrite, const String& name = "", const String& unit = "", UInt downsampling = 0, Real deadband = 0, Bool onChange = false);
+
+		/// @brief copy the imported values straight from the received samples onto the attributes
+		/// Instead of creating an attribute per value and passing it through the import queue,
+		/// the received samples are handed to the simulation thread, which applies the newest one
+		/// before the time step. Meant for local nodes like shmem, must be set before the simulation starts.
+		/// @param value Whether direct imports are used
+		void setDirectImports(Bool value = true);
+
+		/// @brief send the exports of several steps with one write to the node
+		/// Each exported step becomes one sample carrying the step sequence number and the simulation time
+		/// as origin timestamp. With downsampling, one write covers steps * downsampling time steps.
+		/// Must be set before the simulation starts.
+		/// @param steps Number of exported steps per write, 0 sends every step on its own
+		void setExportBatching(UInt steps);
+
+		void popDpsimAttrsFromQueue(bool isSync = false) override;
 
 	};
 }
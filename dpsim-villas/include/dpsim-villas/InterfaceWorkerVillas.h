@@ -5,6 +5,8 @@
 #include <dpsim-models/PtrFactory.h>
 #include <dpsim/InterfaceWorker.h>
 
+#include <readerwritercircularbuffer.h>
+
 #include <villas/node.hpp>
 #include <villas/exceptions.hpp>
 #include <villas/memory.hpp>
@@ -33,7 +35,11 @@ namespace DPsim {
 		static Bool villasInitialized;
 
 		std::vector<std::tuple<std::function<CPS::AttributeBase::Ptr(Sample*)>, UInt>> mImports;
+		/// Sample index and signal type of every configured import, used for direct imports
+		std::vector<std::pair<UInt, node::SignalType>> mImportSlots;
 		std::vector<std::tuple<std::function<void(CPS::AttributeBase::Ptr, Sample*)>, UInt, Bool>> mExports;
+		/// Sample index of every configured export, used to write export slots
+		std::vector<UInt> mExportIndices;
 
 		// VILLASnode node to send / receive data to / from
 		String mNodeConfig;
@@ -49,6 +55,20 @@ namespace DPsim {
 		std::map<int, node::Signal::Ptr> mExportSignals;
 		std::map<int, node::Signal::Ptr> mImportSignals;
 
+		/// Hand the received samples to the simulation thread instead of creating attribute packets
+		Bool mDirectImports = false;
+		/// Received samples not yet taken by the simulation thread
+		std::unique_ptr<moodycamel::BlockingReaderWriterCircularBuffer<Sample*>> mDirectSamples;
+
+		/// Number of export steps sent with one write, 0 writes every step on its own
+		UInt mBatchSize = 0;
+		/// Samples of the current batch, one per export step
+		std::vector<Sample*> mBatch;
+
+		/// Whether the sample entries of the exports have the layout of the export slots,
+		/// so that a slot is copied at once, -1 before the first slot is written
+		Int mContiguousExports = -1;
+
 	public:
 
 		InterfaceWorkerVillas(const String &nodeConfig, UInt queueLenght = 512, UInt sampleLenght = 64);
@@ -58,12 +78,36 @@ namespace DPsim {
 
 		void readValuesFromEnv(std::vector<Interface::AttributePacket>& updatedAttrs) override;
 		void writeValuesToEnv(std::vector<Interface::AttributePacket>& updatedAttrs) override;
+		void writeSlotToEnv(const ExportRing& ring, const ExportRing::Slot& slot) override;
+		Bool writesEverySlot() const override { return mBatchSize > 0; }
+		std::vector<int> pollFds() override { return mNode->getPollFDs(); }
 
         virtual void configureImport(UInt attributeId, const std::type_info& type, UInt idx);
-        virtual void configureExport(UInt attributeId, const std::type_info& type, UInt idx, Bool waitForOnWrite, const String& name = "", const String& unit = "");
+        /// Real matrices take the width sample entries from idx on, one per element in column-major order
+        virtual void configureExport(UInt attributeId, const std::type_info& type, UInt idx, Bool waitForOnWrite, const String& name = "", const String& unit = "", UInt width = 1);
+
+		/// Pass received samples to the simulation thread, which copies the
+		/// imported values from the sample data onto the attributes
+		void setDirectImports(Bool value = true);
+		Bool hasDirectImports() const { return mDirectImports; }
+		/// Returns the newest received sample and releases older ones. Waits
+		/// for a sample if block is set, otherwise returns nullptr if there is none.
+		Sample* takeSample(Bool block);
+		/// Copies the value of an import from the sample onto the attribute
+		Bool applySample(Sample *smp, UInt attributeId, CPS::AttributeBase::Ptr attr) const;
+		/// Returns a sample from takeSample to the pool
+		void releaseSample(Sample *smp);
+
+		/// Collect the exports of the given number of steps and send them with one write.
+		/// Every step still becomes one sample, stamped with the simulation time of the step.
+		void setExportBatching(UInt steps);
 
 	private:
 		void prepareNode();
+		/// Writes and releases the samples of the current batch
+		void writeBatch();
+		/// Whether all exports are Real values or matrices at the sample entries of their slot values
+		Bool contiguousExports(const ExportRing& ring) const;
 		void setupNodeSignals();
 		void initVillas() const;
 	};
@@ -10,14 +10,62 @@ namespace DPsim {
     InterfaceVillas::InterfaceVillas(const String &nodeConfig, UInt queueLength, UInt sampleLength, const String& name, UInt downsampling)
         : Interface(InterfaceWorkerVillas::make(nodeConfig, queueLength, sampleLength), name, downsampling) { }
 
-    void InterfaceVillas::importAttribute(CPS::AttributeBase::Ptr attr, UInt idx, Bool blockOnRead, Bool syncOnSimulationStart) {
-        Interface::addImport(attr, blockOnRead, syncOnSimulationStart);
+    void InterfaceVillas::importAttribute(CPS::AttributeBase::Ptr attr, UInt idx, Bool blockOnRead, Bool syncOnSimulationStart, UInt downsampling) {
+        Interface::addImport(attr, blockOnRead, syncOnSimulationStart, downsampling);
         std::dynamic_pointer_cast<InterfaceWorkerVillas>(mInterfaceWorker)->configureImport((UInt)mImportAttrsDpsim.size() - 1, attr->getType(), idx);
     }
 
-	void InterfaceVillas::exportAttribute(CPS::AttributeBase::Ptr attr, UInt idx, Bool waitForOnWrite, const String& name, const String& unit) {
-        Interface::addExport(attr);
-        std::dynamic_pointer_cast<InterfaceWorkerVillas>(mInterfaceWorker)->configureExport((UInt)mExportAttrsDpsim.size() - 1, attr->getType(), idx, waitForOnWrite, name, unit);
+	void InterfaceVillas::exportAttribute(CPS::AttributeBase::Ptr attr, UInt idx, Bool waitForOnWrite, const String& name, const String& unit, UInt downsampling, Real deadband, Bool onChange) {
+        Interface::addExport(attr, downsampling, deadband, onChange);
+        UInt width = 1;
+        if (attr->getType() == typeid(Matrix))
+            width = static_cast<UInt>(std::static_pointer_cast<CPS::Attribute<Matrix>>(attr.getPtr())->get().size());
+        std::dynamic_pointer_cast<InterfaceWorkerVillas>(mInterfaceWorker)->configureExport((UInt)mExportAttrsDpsim.size() - 1, attr->getType(), idx, waitForOnWrite, name, unit, width);
+    }
+
+    void InterfaceVillas::setDirectImports(Bool value) {
+        std::dynamic_pointer_cast<InterfaceWorkerVillas>(mInterfaceWorker)->setDirectImports(value);
+    }
+
+    void InterfaceVillas::setExportBatching(UInt steps) {
+        std::dynamic_pointer_cast<InterfaceWorkerVillas>(mInterfaceWorker)->setExportBatching(steps);
+    }
+
+    void InterfaceVillas::popDpsimAttrsFromQueue(bool isSync) {
+        auto worker = std::static_pointer_cast<InterfaceWorkerVillas>(mInterfaceWorker);
+        if (!worker->hasDirectImports()) {
+            Interface::popDpsimAttrsFromQueue(isSync);
+            return;
+        }
+
+        //Every sample updates all imports, so wait for one if any import should block
+        bool block = false;
+        for (UInt i = 0; i < mImportAttrsDpsim.size(); i++)
+            block = block || waitsForImport(i, isSync);
+
+        Sample *sample;
+        if (mSynchronous) {
+            //No reader thread is running, so poll the node until a sample is received or no import blocks
+            do {
+                worker->readValuesFromEnv(mImportPackets);
+                mImportPackets.clear();
+                sample = worker->takeSample(false);
+            } while (sample == nullptr && block);
+        } else {
+            sample = worker->takeSample(block);
+        }
+        if (sample == nullptr)
+            return;
+
+        for (UInt i = 0; i < mImportAttrsDpsim.size(); i++) {
+            if (worker->applySample(sample, i, std::get<0>(mImportAttrsDpsim[i]))) {
+                std::get<1>(mImportAttrsDpsim[i]) = mNextSequenceInterfaceToDpsim;
+                if (mRecorder)
+                    mRecorder->record(mImportStep, i, mNextSequenceInterfaceToDpsim, std::get<0>(mImportAttrsDpsim[i]));
+            }
+        }
+        mNextSequenceInterfaceToDpsim++;
+        worker->releaseSample(sample);
     }
 
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <stdexcept>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include <unistd.h>
 #include <poll.h>
@@ -15,6 +17,7 @@
 #include <dpsim-models/Logger.h>
 #include <villas/signal_list.hpp>
 #include <villas/path.hpp>
+#include <villas/timing.hpp>
 
 using namespace CPS;
 using namespace DPsim;
@@ -139,12 +142,22 @@ void InterfaceWorkerVillas::setupNodeSignals() {
 
 void InterfaceWorkerVillas::close() {
 	SPDLOG_LOGGER_INFO(mLog, "Closing InterfaceVillas...");
+	// Send the steps of an incomplete batch before stopping the node
+	if (!mBatch.empty())
+		writeBatch();
+
 	int ret = mNode->stop();
 	if (ret < 0) {
 		SPDLOG_LOGGER_ERROR(mLog, "Error: failed to stop node in InterfaceVillas. Stop returned code {}", ret);
 		std::exit(1);
 	}
 	mOpened = false;
+
+	// Return the samples the simulation did not apply anymore
+	Sample *pending = nullptr;
+	while (mDirectSamples && mDirectSamples->try_dequeue(pending))
+		node::sample_decref(pending);
+
 	ret = node::pool_destroy(&mSamplePool);
 	if (ret < 0) {
 		SPDLOG_LOGGER_ERROR(mLog, "Error: failed to destroy SamplePool in InterfaceVillas. pool_destroy returned code {}", ret);
@@ -207,7 +220,15 @@ void InterfaceWorkerVillas::readValuesFromEnv(std::vector<Interface::AttributePa
 			}
 
 			if (ret != 0) {
-				for (UInt i = 0; i < mImports.size(); i++) {
+				if (mDirectImports) {
+					// The simulation thread copies the values straight from the sample
+					if (!mDirectSamples->try_enqueue(sample)) {
+						SPDLOG_LOGGER_WARN(mLog, "Simulation does not keep up with InterfaceVillas, dropping received sample");
+						node::sample_decref(sample);
+					}
+					sample = nullptr;
+				}
+				for (UInt i = 0; sample && i < mImports.size(); i++) {
 					auto importedAttr = std::get<0>(mImports[i])(sample);
 					if (!importedAttr.isNull()) {
 						updatedAttrs.emplace_back(Interface::AttributePacket {
@@ -239,7 +260,8 @@ void InterfaceWorkerVillas::readValuesFromEnv(std::vector<Interface::AttributePa
 
 			}
 
-			sample_decref(sample);
+			if (sample)
+				sample_decref(sample);
 		}
 	}
 	catch (const std::exception&) {
@@ -250,6 +272,69 @@ void InterfaceWorkerVillas::readValuesFromEnv(std::vector<Interface::AttributePa
 	}
 }
 
+void InterfaceWorkerVillas::setDirectImports(Bool value) {
+	if (mOpened) {
+		if (mLog != nullptr) {
+			SPDLOG_LOGGER_WARN(mLog, "InterfaceVillas has already been opened! Configuration will remain unchanged.");
+		}
+		return;
+	}
+	mDirectImports = value;
+	if (mDirectImports && !mDirectSamples)
+		mDirectSamples = std::make_unique<moodycamel::BlockingReaderWriterCircularBuffer<Sample*>>(mQueueLength);
+}
+
+InterfaceWorkerVillas::Sample* InterfaceWorkerVillas::takeSample(Bool block) {
+	Sample *newest = nullptr;
+	Sample *next = nullptr;
+	if (block)
+		mDirectSamples->wait_dequeue(newest);
+	else if (!mDirectSamples->try_dequeue(newest))
+		return nullptr;
+
+	// Only the newest values are applied, older samples are outdated
+	while (mDirectSamples->try_dequeue(next)) {
+		node::sample_decref(newest);
+		newest = next;
+	}
+	return newest;
+}
+
+Bool InterfaceWorkerVillas::applySample(Sample *smp, UInt attributeId, AttributeBase::Ptr attr) const {
+	if (attributeId >= mImportSlots.size())
+		return false;
+
+	auto [idx, type] = mImportSlots[attributeId];
+	if (idx >= smp->length) {
+		SPDLOG_LOGGER_ERROR(mLog, "incomplete data received from InterfaceVillas");
+		return false;
+	}
+
+	// configureImport checked the attribute types, so the static casts are safe
+	AttributeBase *base = attr.getPtr().get();
+	switch (type) {
+	case node::SignalType::INTEGER:
+		static_cast<Attribute<Int>*>(base)->set(static_cast<Int>(smp->data[idx].i));
+		break;
+	case node::SignalType::FLOAT:
+		static_cast<Attribute<Real>*>(base)->set(smp->data[idx].f);
+		break;
+	case node::SignalType::COMPLEX:
+		static_cast<Attribute<Complex>*>(base)->set(smp->data[idx].z);
+		break;
+	case node::SignalType::BOOLEAN:
+		static_cast<Attribute<Bool>*>(base)->set(smp->data[idx].b);
+		break;
+	default:
+		return false;
+	}
+	return true;
+}
+
+void InterfaceWorkerVillas::releaseSample(Sample *smp) {
+	node::sample_decref(smp);
+}
+
 void InterfaceWorkerVillas::writeValuesToEnv(std::vector<Interface::AttributePacket>& updatedAttrs) {
 	//Update export sequence IDs
 	for (const auto& packet : updatedAttrs) {
@@ -343,7 +428,151 @@ void InterfaceWorkerVillas::initVillas() const {
 	villas::kernel::rt::init(villasPriority, villasAffinity);
 }
 
-void InterfaceWorkerVillas::configureExport(UInt attributeId, const std::type_info& type, UInt idx, Bool waitForOnWrite, const String& name, const String& unit) {
+void InterfaceWorkerVillas::writeSlotToEnv(const ExportRing& ring, const ExportRing::Slot& slot) {
+	Sample *sample = nullptr;
+	Int ret = 0;
+	bool done = false;
+	try {
+		sample = node::sample_alloc(&mSamplePool);
+		if (sample == nullptr) {
+			SPDLOG_LOGGER_ERROR(mLog, "InterfaceVillas could not allocate a new sample! Not sending any data!");
+			return;
+		}
+
+		// The slot holds a complete set of exports, so all of them go into one sample
+		sample->signals = mNode->getOutputSignals(false);
+		UInt exports = std::min<UInt>(ring.size(), static_cast<UInt>(mExportIndices.size()));
+		if (mContiguousExports < 0)
+			mContiguousExports = contiguousExports(ring) ? 1 : 0;
+		if (mContiguousExports > 0) {
+			// The sample holds the values of the slot in the same layout
+			UInt length = static_cast<UInt>(slot.values.size());
+			if (length > sample->capacity)
+				throw std::out_of_range("not enough space in allocated sample");
+			std::memcpy(sample->data, slot.values.data(), length * sizeof(Real));
+			if (length > sample->length)
+				sample->length = length;
+			exports = 0;
+		}
+		for (UInt i = 0; i < exports; i++) {
+			UInt idx = mExportIndices[i];
+			if (idx >= sample->capacity)
+				throw std::out_of_range("not enough space in allocated sample");
+			if (idx >= sample->length)
+				sample->length = idx + 1;
+
+			switch (ring.kind(i)) {
+			case ExportRing::Kind::Int:
+				sample->data[idx].i = ring.integer(slot, i);
+				break;
+			case ExportRing::Kind::Real:
+				sample->data[idx].f = ring.real(slot, i);
+				break;
+			case ExportRing::Kind::Complex:
+				sample->data[idx].z = ring.complex(slot, i);
+				break;
+			case ExportRing::Kind::Bool:
+				sample->data[idx].b = ring.boolean(slot, i);
+				break;
+			case ExportRing::Kind::Vector:
+				if (idx + ring.width(i) > sample->capacity)
+					throw std::out_of_range("not enough space in allocated sample");
+				if (idx + ring.width(i) > sample->length)
+					sample->length = idx + ring.width(i);
+				std::memcpy(&sample->data[idx], ring.vector(slot, i), ring.width(i) * sizeof(Real));
+				break;
+			case ExportRing::Kind::Bytes:
+			case ExportRing::Kind::Other:
+				throw InvalidAttributeException();
+			}
+		}
+
+		// Identify the sample by the time step it was taken in
+		sample->sequence = slot.sequenceId;
+		sample->flags |= (int) villas::node::SampleFlags::HAS_SEQUENCE;
+		sample->flags |= (int) villas::node::SampleFlags::HAS_DATA;
+		if (mBatchSize > 0)
+			sample->ts.origin = time_from_double(slot.time);
+		else
+			clock_gettime(CLOCK_REALTIME, &sample->ts.origin);
+		sample->flags |= (int) villas::node::SampleFlags::HAS_TS_ORIGIN;
+		done = true;
+
+		if (mBatchSize > 0) {
+			mBatch.push_back(sample);
+			if (mBatch.size() >= mBatchSize)
+				writeBatch();
+			return;
+		}
+
+		do {
+			ret = mNode->write(&sample, 1);
+		} while (ret == 0);
+		if (ret < 0)
+			SPDLOG_LOGGER_ERROR(mLog, "Failed to write samples to InterfaceVillas. Write returned code {}", ret);
+
+		sample_copy(mLastSample, sample);
+		sample_decref(sample);
+	}
+	catch (const std::exception&) {
+		/* Same recovery as in writeValuesToEnv: resend the last successfully
+		 * sent sample or try to send this one again. */
+		if (!done)
+			sample = mLastSample;
+
+		while (ret == 0)
+			ret = mNode->write(&sample, 1);
+
+		sample_decref(sample);
+
+		if (ret < 0)
+			SPDLOG_LOGGER_ERROR(mLog, "Failed to write samples to InterfaceVillas. Write returned code {}", ret);
+	}
+}
+
+Bool InterfaceWorkerVillas::contiguousExports(const ExportRing& ring) const {
+	static_assert(sizeof(node::SignalData) == sizeof(Real), "Real values are copied into the sample data");
+	if (ring.size() != mExportIndices.size())
+		return false;
+	for (UInt i = 0; i < ring.size(); i++) {
+		// Integers, booleans and complex values have another representation in the sample
+		if (ring.kind(i) != ExportRing::Kind::Real && ring.kind(i) != ExportRing::Kind::Vector)
+			return false;
+		if (mExportIndices[i] != ring.offset(i))
+			return false;
+	}
+	return true;
+}
+
+void InterfaceWorkerVillas::setExportBatching(UInt steps) {
+	if (mOpened) {
+		if (mLog != nullptr) {
+			SPDLOG_LOGGER_WARN(mLog, "InterfaceVillas has already been opened! Configuration will remain unchanged.");
+		}
+		return;
+	}
+	mBatchSize = steps;
+	mBatch.reserve(steps);
+}
+
+void InterfaceWorkerVillas::writeBatch() {
+	UInt written = 0;
+	Int ret = 0;
+	do {
+		ret = mNode->write(mBatch.data() + written, mBatch.size() - written);
+		if (ret > 0)
+			written += ret;
+	} while (ret >= 0 && written < mBatch.size());
+	if (ret < 0)
+		SPDLOG_LOGGER_ERROR(mLog, "Failed to write samples to InterfaceVillas. Write returned code {}", ret);
+
+	sample_copy(mLastSample, mBatch.back());
+	for (auto sample : mBatch)
+		sample_decref(sample);
+	mBatch.clear();
+}
+
+void InterfaceWorkerVillas::configureExport(UInt attributeId, const std::type_info& type, UInt idx, Bool waitForOnWrite, const String& name, const String& unit, UInt width) {
 	if (mOpened) {
 		if (mLog != nullptr) {
 			SPDLOG_LOGGER_WARN(mLog, "InterfaceVillas has already been opened! Configuration will remain unchanged.");
@@ -417,11 +646,30 @@ void InterfaceWorkerVillas::configureExport(UInt attributeId, const std::type_in
 			smp->data[idx].b = **attrTyped;
 		}, 0, waitForOnWrite);
 		mExportSignals[idx] = std::make_shared<node::Signal>(name, unit, node::SignalType::BOOLEAN);
+	} else if (type == typeid(Matrix)) {
+		mExports.emplace_back([idx, width](AttributeBase::Ptr attr, Sample *smp) {
+			if (idx + width > smp->capacity)
+				throw std::out_of_range("not enough space in allocated sample");
+			if (idx + width > smp->length)
+				smp->length = idx + width;
+
+			Attribute<Matrix>::Ptr attrTyped = std::dynamic_pointer_cast<Attribute<Matrix>>(attr.getPtr());
+
+			if (attrTyped.isNull() || (**attrTyped).size() != static_cast<Matrix::Index>(width))
+				throw InvalidAttributeException();
+
+			for (UInt k = 0; k < width; k++)
+				smp->data[idx + k].f = (**attrTyped)(k);
+		}, 0, waitForOnWrite);
+		for (UInt k = 0; k < width; k++)
+			mExportSignals[idx + k] = std::make_shared<node::Signal>(width > 1 ? name + "_" + std::to_string(k) : name, unit, node::SignalType::FLOAT);
 	} else {
 		if (mLog != nullptr) {
 			SPDLOG_LOGGER_WARN(mLog, "Unsupported attribute type! Interface configuration will remain unchanged!");
 		}
+		return;
 	}
+	mExportIndices.push_back(idx);
 }
 
 void InterfaceWorkerVillas::configureImport(UInt attributeId, const std::type_info& type, UInt idx) {
@@ -479,5 +727,9 @@ void InterfaceWorkerVillas::configureImport(UInt attributeId, const std::type_in
 		if (mLog != nullptr) {
 			SPDLOG_LOGGER_WARN(mLog, "Unsupported attribute type! Interface configuration will remain unchanged!");
 		}
+		return;
 	}
+	mImportSlots.emplace_back(idx, type == typeid(Int) ? node::SignalType::INTEGER
+		: type == typeid(Real) ? node::SignalType::FLOAT
+		: type == typeid(Complex) ? node::SignalType::COMPLEX : node::SignalType::BOOLEAN);
 }
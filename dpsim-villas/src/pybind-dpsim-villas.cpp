@@ -35,6 +35,8 @@ PYBIND11_MODULE(dpsimpyvillas, m) {
 	py::class_<PyInterfaceVillas, std::shared_ptr<PyInterfaceVillas>>(m, "InterfaceVillas", interface)
 	    .def(py::init<const CPS::String&, CPS::UInt, CPS::UInt, const CPS::String&, CPS::UInt>(), "config"_a, "queue_length"_a=512, "sample_length"_a = 64, "name"_a = "", "downsampling"_a=1) // cppcheck-suppress assignBoolToPointer
 		.def(py::init<py::dict, CPS::UInt, CPS::UInt, const CPS::String&, CPS::UInt>(), "config"_a, "queue_length"_a=512, "sample_length"_a = 64, "name"_a = "", "downsampling"_a=1) // cppcheck-suppress assignBoolToPointer
-		.def("import_attribute", &PyInterfaceVillas::importAttribute, "attr"_a, "idx"_a, "block_on_read"_a = false, "sync_on_start"_a = true) // cppcheck-suppress assignBoolToPointer
-		.def("export_attribute", &PyInterfaceVillas::exportAttribute, "attr"_a, "idx"_a, "wait_for_on_write"_a = true, "name"_a = "", "unit"_a = ""); // cppcheck-suppress assignBoolToPointer
+		.def("import_attribute", &PyInterfaceVillas::importAttribute, "attr"_a, "idx"_a, "block_on_read"_a = false, "sync_on_start"_a = true, "downsampling"_a = 0) // cppcheck-suppress assignBoolToPointer
+		.def("export_attribute", &PyInterfaceVillas::exportAttribute, "attr"_a, "idx"_a, "wait_for_on_write"_a = true, "name"_a = "", "unit"_a = "", "downsampling"_a = 0, "deadband"_a = 0, "on_change"_a = false) // cppcheck-suppress assignBoolToPointer
+		.def("set_direct_imports", &PyInterfaceVillas::setDirectImports, "value"_a = true) // cppcheck-suppress assignBoolToPointer
+		.def("set_export_batching", &PyInterfaceVillas::setExportBatching, "steps"_a);
 }
@@ -0,0 +1,44 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <dpsim-models/Attribute.h>
+
+using namespace CPS;
+
+static void BM_AttributeGetStatic(benchmark::State& state) {
+	auto attr = AttributeStatic<Real>::make(1.0);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(attr->get());
+}
+
+/// Dynamic attribute referencing a static one, as for the terminal voltages of subcomponents
+static void BM_AttributeGetReference(benchmark::State& state) {
+	auto source = AttributeStatic<Real>::make(1.0);
+	auto attr = AttributeDynamic<Real>::make();
+	attr->setReference(source);
+	if (state.range(0))
+		attr->freeze();
+	for (auto _ : state)
+		benchmark::DoNotOptimize(attr->get());
+}
+
+/// Derived attribute which is recomputed by an update task on every get
+static void BM_AttributeGetDerived(benchmark::State& state) {
+	auto source = AttributeStatic<Real>::make(1.0);
+	auto attr = source->deriveScaled(2.0);
+	if (state.range(0))
+		attr->freeze();
+	for (auto _ : state)
+		benchmark::DoNotOptimize(attr->get());
+}
+
+BENCHMARK(BM_AttributeGetStatic);
+BENCHMARK(BM_AttributeGetReference)->ArgName("frozen")->Arg(0)->Arg(1);
+BENCHMARK(BM_AttributeGetDerived)->ArgName("frozen")->Arg(0)->Arg(1);
@@ -0,0 +1,115 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/MathUtils.h>
+
+namespace DPsim {
+namespace Benchmarks {
+	/// Bus count and branches of a grid, buses are numbered from 0
+	struct Grid {
+		UInt buses;
+		std::vector<std::pair<UInt, UInt>> branches;
+	};
+
+	/// WSCC 9-bus system with its three generator transformers
+	inline const Grid& wscc9() {
+		static const Grid grid { 9, { {0, 3}, {1, 6}, {2, 8}, {3, 4}, {3, 5}, {4, 6}, {5, 8}, {6, 7}, {7, 8} } };
+		return grid;
+	}
+
+	/// CIGRE MV benchmark with both feeders, bus 0 is the HV grid
+	inline const Grid& cigreMV() {
+		static const Grid grid { 15, { {0, 1}, {0, 12}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 6}, {6, 7}, {7, 8},
+			{8, 9}, {9, 10}, {10, 11}, {11, 4}, {3, 8}, {12, 13}, {13, 14} } };
+		return grid;
+	}
+
+	/// Grid selected by the first benchmark argument
+	inline const Grid& grid(Int index) {
+		return index == 0 ? wscc9() : cigreMV();
+	}
+
+	/// Nodal admittance matrix of the given number of copies of a grid in the
+	/// real valued DP layout of the MNA solver. As in the WSCC_9bus_mult
+	/// examples, the copies are connected in a chain by lines between their
+	/// last buses. Every bus has a shunt to ground, so the matrix is regular.
+	inline SparseMatrix systemMatrix(const Grid& grid, UInt copies) {
+		UInt nodes = grid.buses * copies;
+		SparseMatrix matrix(2 * nodes, 2 * nodes);
+		std::vector<Eigen::Triplet<Real>> pattern;
+		auto addPattern = [&pattern, nodes](UInt a, UInt b) {
+			for (UInt i : { 0u, nodes })
+				for (UInt j : { 0u, nodes })
+					pattern.emplace_back(a + i, b + j, 0);
+		};
+		for (UInt k = 0; k < nodes; ++k)
+			addPattern(k, k);
+		for (UInt copy = 0; copy < copies; ++copy) {
+			UInt offset = copy * grid.buses;
+			for (auto& branch : grid.branches) {
+				addPattern(offset + branch.first, offset + branch.second);
+				addPattern(offset + branch.second, offset + branch.first);
+			}
+			if (copy > 0) {
+				addPattern(offset - 1, offset + grid.buses - 1);
+				addPattern(offset + grid.buses - 1, offset - 1);
+			}
+		}
+		matrix.setFromTriplets(pattern.begin(), pattern.end());
+		matrix.makeCompressed();
+		return matrix;
+	}
+
+	/// Stamps the branches and shunts of the copies with addToMatrixElement
+	inline void stampSystemMatrix(const Grid& grid, UInt copies, SparseMatrix& matrix) {
+		const Complex line(10, -100);
+		const Complex shunt(1, 5);
+		auto stampBranch = [&matrix](UInt a, UInt b, Complex y) {
+			CPS::Math::addToMatrixElement(matrix, a, a, y);
+			CPS::Math::addToMatrixElement(matrix, b, b, y);
+			CPS::Math::addToMatrixElement(matrix, a, b, -y);
+			CPS::Math::addToMatrixElement(matrix, b, a, -y);
+		};
+		for (UInt k = 0; k < grid.buses * copies; ++k)
+			CPS::Math::addToMatrixElement(matrix, k, k, shunt);
+		for (UInt copy = 0; copy < copies; ++copy) {
+			UInt offset = copy * grid.buses;
+			for (auto& branch : grid.branches)
+				stampBranch(offset + branch.first, offset + branch.second, line);
+			if (copy > 0)
+				stampBranch(offset - 1, offset + grid.buses - 1, line);
+		}
+	}
+
+	/// Entries of the first branch of the first copy, which is switched like a breaker
+	inline std::vector<std::pair<UInt, UInt>> switchedEntries(const Grid& grid, UInt copies) {
+		UInt nodes = grid.buses * copies;
+		UInt a = grid.branches[0].first;
+		UInt b = grid.branches[0].second;
+		std::vector<std::pair<UInt, UInt>> entries;
+		for (UInt i : { 0u, nodes })
+			for (UInt j : { 0u, nodes })
+				for (auto& entry : std::vector<std::pair<UInt, UInt>> { {a, a}, {a, b}, {b, a}, {b, b} })
+					entries.emplace_back(entry.first + i, entry.second + j);
+		return entries;
+	}
+
+	/// Grids and numbers of copies, from the single examples up to synthetic grids of about 1000 buses
+	inline void gridSizes(benchmark::internal::Benchmark* benchmark) {
+		benchmark->ArgNames({ "grid", "copies" });
+		benchmark->ArgsProduct({ { 0, 1 }, { 1, 4, 16, 64 } });
+	}
+}
+}
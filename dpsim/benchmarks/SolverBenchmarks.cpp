@@ -0,0 +1,94 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include "BenchmarkGrids.h"
+
+#include <dpsim/Config.h>
+#include <dpsim/DenseLUAdapter.h>
+#include <dpsim/SparseLUAdapter.h>
+#ifdef WITH_KLU
+#include <dpsim/KLUAdapter.h>
+#endif
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+
+namespace {
+	/// System matrix, variable entries and a preprocessed adapter of one benchmark
+	template <typename Adapter>
+	struct Setup {
+		SparseMatrix matrix;
+		std::vector<std::pair<UInt, UInt>> variableEntries;
+		Adapter adapter;
+
+		Setup(const benchmark::State& state) :
+			adapter(CPS::Logger::get("benchmark", CPS::Logger::Level::off)) {
+			const Grid& selected = grid(static_cast<Int>(state.range(0)));
+			UInt copies = static_cast<UInt>(state.range(1));
+			matrix = systemMatrix(selected, copies);
+			stampSystemMatrix(selected, copies, matrix);
+			variableEntries = switchedEntries(selected, copies);
+			adapter.preprocessing(matrix, variableEntries);
+		}
+
+		/// Changes the conductance of the switched branch
+		void toggle(Real delta) {
+			for (auto& entry : variableEntries)
+				matrix.coeffRef(entry.first, entry.second) += entry.first == entry.second ? delta : -delta;
+		}
+	};
+}
+
+template <typename Adapter>
+static void BM_Factorize(benchmark::State& state) {
+	Setup<Adapter> setup(state);
+	for (auto _ : state)
+		setup.adapter.factorize(setup.matrix);
+	state.counters["rows"] = static_cast<double>(setup.matrix.rows());
+	state.counters["nonzeros"] = static_cast<double>(setup.matrix.nonZeros());
+}
+
+template <typename Adapter>
+static void BM_PartialRefactorize(benchmark::State& state) {
+	Setup<Adapter> setup(state);
+	setup.adapter.factorize(setup.matrix);
+	Real delta = 1e3;
+	for (auto _ : state) {
+		setup.toggle(delta);
+		delta = -delta;
+		setup.adapter.partialRefactorize(setup.matrix, setup.variableEntries);
+	}
+	state.counters["rows"] = static_cast<double>(setup.matrix.rows());
+}
+
+template <typename Adapter>
+static void BM_Solve(benchmark::State& state) {
+	Setup<Adapter> setup(state);
+	setup.adapter.factorize(setup.matrix);
+	Matrix rightSide = Matrix::Ones(setup.matrix.rows(), 1);
+	Matrix leftSide = Matrix::Zero(setup.matrix.rows(), 1);
+	for (auto _ : state) {
+		setup.adapter.solveInPlace(rightSide, leftSide);
+		benchmark::DoNotOptimize(leftSide.data());
+	}
+	state.counters["rows"] = static_cast<double>(setup.matrix.rows());
+}
+
+BENCHMARK_TEMPLATE(BM_Factorize, DenseLUAdapter)->Apply(gridSizes);
+BENCHMARK_TEMPLATE(BM_PartialRefactorize, DenseLUAdapter)->Apply(gridSizes);
+BENCHMARK_TEMPLATE(BM_Solve, DenseLUAdapter)->Apply(gridSizes);
+
+BENCHMARK_TEMPLATE(BM_Factorize, SparseLUAdapter)->Apply(gridSizes);
+BENCHMARK_TEMPLATE(BM_PartialRefactorize, SparseLUAdapter)->Apply(gridSizes);
+BENCHMARK_TEMPLATE(BM_Solve, SparseLUAdapter)->Apply(gridSizes);
+
+#ifdef WITH_KLU
+BENCHMARK_TEMPLATE(BM_Factorize, KLUAdapter)->Apply(gridSizes);
+BENCHMARK_TEMPLATE(BM_PartialRefactorize, KLUAdapter)->Apply(gridSizes);
+BENCHMARK_TEMPLATE(BM_Solve, KLUAdapter)->Apply(gridSizes);
+#endif
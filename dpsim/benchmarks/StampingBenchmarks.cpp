@@ -0,0 +1,46 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include "BenchmarkGrids.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+
+/// Restamps all branches into the existing sparsity pattern, as done for every switch state
+static void BM_StampSystemMatrix(benchmark::State& state) {
+	const Grid& selected = grid(static_cast<Int>(state.range(0)));
+	UInt copies = static_cast<UInt>(state.range(1));
+	SparseMatrix matrix = systemMatrix(selected, copies);
+	for (auto _ : state) {
+		matrix.coeffs().setZero();
+		stampSystemMatrix(selected, copies, matrix);
+		benchmark::DoNotOptimize(matrix.valuePtr());
+	}
+	state.counters["rows"] = static_cast<double>(matrix.rows());
+}
+
+/// Assembles the right side vector from one current injection per bus, as
+/// the sources and history terms do in every step
+static void BM_AssembleRightSide(benchmark::State& state) {
+	const Grid& selected = grid(static_cast<Int>(state.range(0)));
+	UInt nodes = selected.buses * static_cast<UInt>(state.range(1));
+	Matrix rightSide = Matrix::Zero(2 * nodes, 1);
+	std::vector<Complex> injections(nodes);
+	for (UInt k = 0; k < nodes; ++k)
+		injections[k] = std::polar(1.0, 0.1 * k);
+	for (auto _ : state) {
+		rightSide.setZero();
+		for (UInt k = 0; k < nodes; ++k)
+			CPS::Math::addToVectorElement(rightSide, k, injections[k]);
+		benchmark::DoNotOptimize(rightSide.data());
+	}
+	state.counters["rows"] = static_cast<double>(rightSide.rows());
+}
+
+BENCHMARK(BM_StampSystemMatrix)->Apply(gridSizes);
+BENCHMARK(BM_AssembleRightSide)->Apply(gridSizes);
@@ -0,0 +1,363 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+// Runs standard scenarios over a grid of solver implementations, schedulers,
+// thread counts and system sizes and writes the measurements as JSON.
+//
+// Options, each a comma separated list:
+//   -o scenarios=wscc,cigre,smib   WSCC 9-bus multiplied, CIGRE MV with DG, EMT reduced order SG fault
+//   -o copies=0,4,16               additional copies of the WSCC 9-bus system
+//   -o impls=SparseLU,KLU          linear solver implementations
+//   -o schedulers=sequential,openmp,threadlevel,threadlist,workstealing
+//   -o threads=1,2,4               threads of the parallel schedulers
+//   -o repetitions=3               runs of every configuration
+//   -o output=benchmark.json
+// The time step and duration are set by --timestep and --duration.
+
+#include <fstream>
+#include <iostream>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include <DPsim.h>
+#include <dpsim/MNASolver.h>
+#include <dpsim/SequentialScheduler.h>
+#include <dpsim/ThreadLevelScheduler.h>
+#include <dpsim/ThreadListScheduler.h>
+#include <dpsim/WorkStealingScheduler.h>
+#include "../Examples.h"
+#include "../GeneratorFactory.h"
+
+using namespace DPsim;
+using namespace CPS;
+using namespace CPS::CIM;
+
+static std::vector<String> listOption(CommandLineArgs& args, const String& name, const String& defaultValue) {
+	auto option = args.options.find(name);
+	return DPsim::Utils::tokenize(option != args.options.end() ? option->second : defaultValue, ',');
+}
+
+/// Peak resident set size of the process in bytes, which never decreases between runs
+static std::size_t peakRSS() {
+#if defined(__linux__) || defined(__APPLE__)
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+	return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+	return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+// ----- WSCC 9-bus system with copies connected in rings, as in WSCC_9bus_mult_coupled -----
+
+static void multiplyConnected(SystemTopology& sys, int copies, Real resistance, Real inductance, Real capacitance) {
+	sys.multiply(copies);
+	int counter = 0;
+	std::vector<String> nodes = {"BUS5", "BUS8", "BUS6"};
+
+	for (auto origNode : nodes) {
+		std::vector<String> nodeNames{origNode};
+		for (int i = 2; i < copies + 2; i++)
+			nodeNames.push_back(origNode + "_" + std::to_string(i));
+		nodeNames.push_back(origNode);
+
+		int nlines = copies == 1 ? 1 : copies + 1;
+		for (int i = 0; i < nlines; i++) {
+			auto rlNode = std::make_shared<DP::SimNode>("N_add_" + std::to_string(counter));
+			auto res = DP::Ph1::Resistor::make("R_" + std::to_string(counter));
+			res->setParameters(resistance);
+			auto ind = DP::Ph1::Inductor::make("L_" + std::to_string(counter));
+			ind->setParameters(inductance);
+			auto cap1 = DP::Ph1::Capacitor::make("C1_" + std::to_string(counter));
+			cap1->setParameters(capacitance / 2.);
+			auto cap2 = DP::Ph1::Capacitor::make("C2_" + std::to_string(counter));
+			cap2->setParameters(capacitance / 2.);
+
+			sys.addNode(rlNode);
+			res->connect({sys.node<DP::SimNode>(nodeNames[i]), rlNode});
+			ind->connect({rlNode, sys.node<DP::SimNode>(nodeNames[i+1])});
+			cap1->connect({sys.node<DP::SimNode>(nodeNames[i]), DP::SimNode::GND});
+			cap2->connect({sys.node<DP::SimNode>(nodeNames[i+1]), DP::SimNode::GND});
+			counter += 1;
+
+			sys.addComponent(res);
+			sys.addComponent(ind);
+			sys.addComponent(cap1);
+			sys.addComponent(cap2);
+		}
+	}
+}
+
+static std::shared_ptr<Simulation> wscc(const String& name, Int copies) {
+	std::list<fs::path> filenames = DPsim::Utils::findFiles({
+		"WSCC-09_RX_DI.xml",
+		"WSCC-09_RX_EQ.xml",
+		"WSCC-09_RX_SV.xml",
+		"WSCC-09_RX_TP.xml"
+	}, "build/_deps/cim-data-src/WSCC-09/WSCC-09_RX", "CIMPATH");
+
+	CIM::Reader reader(name, Logger::Level::off, Logger::Level::off);
+	SystemTopology sys = reader.loadCIM(60, filenames, Domain::DP, PhaseType::Single, GeneratorType::IdealVoltageSource);
+	if (copies > 0)
+		multiplyConnected(sys, copies, 12.5, 0.16, 1e-6);
+
+	auto sim = std::make_shared<Simulation>(name, Logger::Level::off);
+	sim->setSystem(sys);
+	sim->setDomain(Domain::DP);
+	return sim;
+}
+
+// ----- CIGRE MV with distributed generation, as in DP_CIGRE_MV_withDG -----
+
+static std::shared_ptr<Simulation> cigre(const String& name) {
+	Examples::Grids::CIGREMV::ScenarioConfig scenario;
+	std::list<fs::path> filenames = DPsim::Utils::findFiles({
+		"Rootnet_FULL_NE_28J17h_DI.xml",
+		"Rootnet_FULL_NE_28J17h_EQ.xml",
+		"Rootnet_FULL_NE_28J17h_SV.xml",
+		"Rootnet_FULL_NE_28J17h_TP.xml"
+	}, "dpsim/Examples/CIM/grid-data/CIGRE_MV/NEPLAN/CIGRE_MV_no_tapchanger_noLoad1_LeftFeeder_With_LoadFlow_Results", "CIMPATH");
+
+	String namePF = name + "_Powerflow";
+	CIM::Reader reader(namePF, Logger::Level::off, Logger::Level::off);
+	SystemTopology systemPF = reader.loadCIM(scenario.systemFrequency, filenames, Domain::SP);
+	Examples::Grids::CIGREMV::addInvertersToCIGREMV(systemPF, scenario, Domain::SP);
+
+	Simulation simPF(namePF, Logger::Level::off);
+	simPF.setSystem(systemPF);
+	simPF.setTimeStep(1);
+	simPF.setFinalTime(2);
+	simPF.setDomain(Domain::SP);
+	simPF.setSolverType(Solver::Type::NRP);
+	simPF.setSolverAndComponentBehaviour(Solver::Behaviour::Initialization);
+	simPF.doInitFromNodesAndTerminals(true);
+	simPF.run();
+
+	CIM::Reader reader2(name, Logger::Level::off, Logger::Level::off);
+	SystemTopology systemDP = reader2.loadCIM(scenario.systemFrequency, filenames, Domain::DP);
+	Examples::Grids::CIGREMV::addInvertersToCIGREMV(systemDP, scenario, Domain::DP);
+	systemDP.initWithPowerflow(systemPF);
+
+	auto sim = std::make_shared<Simulation>(name, Logger::Level::off);
+	sim->setSystem(systemDP);
+	sim->setDomain(Domain::DP);
+	sim->doInitFromNodesAndTerminals(true);
+	return sim;
+}
+
+// ----- EMT reduced order synchronous generator with a fault, as in EMT_ReducedOrderSG_SMIB_Fault -----
+
+static std::shared_ptr<Simulation> smib(const String& name, Real finalTime) {
+	const Examples::Grids::SMIB::ReducedOrderSynchronGenerator::Scenario4::GridParams gridParams;
+	const Examples::Components::SynchronousGeneratorKundur::MachineParameters syngenKundur;
+
+	auto n1PF = SimNode<Complex>::make("n1", PhaseType::Single);
+	auto n2PF = SimNode<Complex>::make("n2", PhaseType::Single);
+
+	auto genPF = SP::Ph1::SynchronGenerator::make("Generator", Logger::Level::off);
+	genPF->setParameters(syngenKundur.nomPower, gridParams.VnomMV, gridParams.setPointActivePower,
+		gridParams.setPointVoltage, PowerflowBusType::PV);
+	genPF->setBaseVoltage(gridParams.VnomMV);
+	genPF->modifyPowerFlowBusType(PowerflowBusType::PV);
+
+	auto extnetPF = SP::Ph1::NetworkInjection::make("Slack", Logger::Level::off);
+	extnetPF->setParameters(gridParams.VnomMV);
+	extnetPF->setBaseVoltage(gridParams.VnomMV);
+	extnetPF->modifyPowerFlowBusType(PowerflowBusType::VD);
+
+	auto linePF = SP::Ph1::PiLine::make("PiLine", Logger::Level::off);
+	linePF->setParameters(gridParams.lineResistance, gridParams.lineInductance,
+		gridParams.lineCapacitance, gridParams.lineConductance);
+	linePF->setBaseVoltage(gridParams.VnomMV);
+
+	genPF->connect({ n1PF });
+	linePF->connect({ n1PF, n2PF });
+	extnetPF->connect({ n2PF });
+	auto systemPF = SystemTopology(gridParams.nomFreq,
+		SystemNodeList{n1PF, n2PF},
+		SystemComponentList{genPF, linePF, extnetPF});
+
+	Simulation simPF(name + "_PF", Logger::Level::off);
+	simPF.setSystem(systemPF);
+	simPF.setTimeStep(0.1);
+	simPF.setFinalTime(0.1);
+	simPF.setDomain(Domain::SP);
+	simPF.setSolverType(Solver::Type::NRP);
+	simPF.doInitFromNodesAndTerminals(false);
+	simPF.run();
+
+	Real initActivePower = genPF->getApparentPower().real();
+	Real initReactivePower = genPF->getApparentPower().imag();
+	Complex initElecPower(initActivePower, initReactivePower);
+
+	std::vector<Complex> initialVoltage1{ n1PF->voltage()(0,0),
+		n1PF->voltage()(0,0) * SHIFT_TO_PHASE_B, n1PF->voltage()(0,0) * SHIFT_TO_PHASE_C };
+	auto n1EMT = SimNode<Real>::make("n1EMT", PhaseType::ABC, initialVoltage1);
+	std::vector<Complex> initialVoltage2{ n2PF->voltage()(0,0),
+		n2PF->voltage()(0,0) * SHIFT_TO_PHASE_B, n2PF->voltage()(0,0) * SHIFT_TO_PHASE_C };
+	auto n2EMT = SimNode<Real>::make("n2EMT", PhaseType::ABC, initialVoltage2);
+
+	auto genEMT = GeneratorFactory::createGenEMT("4", "SynGen", Logger::Level::off);
+	genEMT->setOperationalParametersPerUnit(
+		syngenKundur.nomPower, syngenKundur.nomVoltage,
+		syngenKundur.nomFreq, syngenKundur.H,
+		syngenKundur.Ld, syngenKundur.Lq, syngenKundur.Ll,
+		syngenKundur.Ld_t, syngenKundur.Lq_t, syngenKundur.Td0_t, syngenKundur.Tq0_t,
+		syngenKundur.Ld_s, syngenKundur.Lq_s, syngenKundur.Td0_s, syngenKundur.Tq0_s);
+	genEMT->setInitialValues(initElecPower, initActivePower, n1PF->voltage()(0,0));
+	genEMT->setModelAsCurrentSource(true);
+
+	auto extnetEMT = EMT::Ph3::NetworkInjection::make("Slack", Logger::Level::off);
+
+	auto lineEMT = EMT::Ph3::PiLine::make("PiLine", Logger::Level::off);
+	lineEMT->setParameters(Math::singlePhaseParameterToThreePhase(gridParams.lineResistance),
+		Math::singlePhaseParameterToThreePhase(gridParams.lineInductance),
+		Math::singlePhaseParameterToThreePhase(gridParams.lineCapacitance),
+		Math::singlePhaseParameterToThreePhase(gridParams.lineConductance));
+
+	auto fault = EMT::Ph3::Switch::make("Br_fault", Logger::Level::off);
+	fault->setParameters(Math::singlePhaseParameterToThreePhase(gridParams.SwitchOpen),
+		Math::singlePhaseParameterToThreePhase(gridParams.SwitchClosed));
+	fault->openSwitch();
+
+	genEMT->connect({ n1EMT });
+	lineEMT->connect({ n1EMT, n2EMT });
+	extnetEMT->connect({ n2EMT });
+	fault->connect({ EMT::SimNode::GND, n1EMT });
+	auto systemEMT = SystemTopology(gridParams.nomFreq,
+		SystemNodeList{n1EMT, n2EMT},
+		SystemComponentList{genEMT, lineEMT, fault, extnetEMT});
+
+	auto sim = std::make_shared<Simulation>(name, Logger::Level::off);
+	sim->setSystem(systemEMT);
+	sim->setDomain(Domain::EMT);
+	sim->doInitFromNodesAndTerminals(true);
+	sim->doSystemMatrixRecomputation(true);
+
+	// Fault in the middle of the run, cleared after a tenth of the run
+	sim->addEvent(SwitchEvent3Ph::make(0.5 * finalTime, fault, true));
+	sim->addEvent(SwitchEvent3Ph::make(0.6 * finalTime, fault, false));
+	return sim;
+}
+
+static std::shared_ptr<Scheduler> scheduler(const String& name, Int threads) {
+	if (name == "sequential")
+		return std::make_shared<SequentialScheduler>();
+#ifdef WITH_OPENMP
+	else if (name == "openmp")
+		return std::make_shared<OpenMPLevelScheduler>(threads);
+#endif
+	else if (name == "threadlevel")
+		return std::make_shared<ThreadLevelScheduler>(threads);
+	else if (name == "threadlist")
+		return std::make_shared<ThreadListScheduler>(threads);
+	else if (name == "workstealing")
+		return std::make_shared<WorkStealingScheduler>(threads);
+	throw std::invalid_argument("Invalid scheduler: " + name);
+}
+
+/// Factorizations and solves of the MNA solvers of a simulation
+static void solverCounts(const Simulation& sim, uint64_t& factorizations, uint64_t& solves) {
+	factorizations = solves = 0;
+	for (auto& solver : sim.solvers()) {
+		if (auto mna = std::dynamic_pointer_cast<MnaSolver<Real>>(solver)) {
+			factorizations += mna->factorizeTimes().count() + mna->recomputationTimes().count();
+			solves += mna->solveTimes().count();
+		} else if (auto mna = std::dynamic_pointer_cast<MnaSolver<Complex>>(solver)) {
+			factorizations += mna->factorizeTimes().count() + mna->recomputationTimes().count();
+			solves += mna->solveTimes().count();
+		}
+	}
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "ScalingBenchmark", 100e-6, 0.1);
+
+	auto scenarios = listOption(args, "scenarios", "wscc,cigre,smib");
+	auto copiesList = listOption(args, "copies", "0,4,16");
+	auto impls = listOption(args, "impls", "SparseLU");
+	auto schedulers = listOption(args, "schedulers", "sequential,openmp");
+	auto threadsList = listOption(args, "threads", "1,2,4");
+	Int repetitions = args.options.count("repetitions") ? args.getOptionInt("repetitions") : 1;
+	String output = args.options.count("output") ? args.getOptionString("output") : "benchmark.json";
+
+	Logger::setLogDir("logs/" + args.name);
+	json runs = json::array();
+
+	for (auto& scenario : scenarios) {
+		// Only the WSCC system is scaled, the other scenarios have a fixed size
+		auto sizes = scenario == "wscc" ? copiesList : std::vector<String>{ "0" };
+		for (auto& copies : sizes)
+		for (auto& impl : impls)
+		for (auto& schedulerName : schedulers) {
+			auto threadCounts = schedulerName == "sequential" ? std::vector<String>{ "1" } : threadsList;
+			for (auto& threads : threadCounts)
+			for (Int repetition = 0; repetition < repetitions; ++repetition) {
+				String name = args.name + "_" + scenario + "_" + copies + "_" + impl + "_" + schedulerName + "_" + threads;
+				std::shared_ptr<Simulation> sim;
+				if (scenario == "wscc")
+					sim = wscc(name, std::stoi(copies));
+				else if (scenario == "cigre")
+					sim = cigre(name);
+				else if (scenario == "smib")
+					sim = smib(name, args.duration);
+				else
+					throw std::invalid_argument("Invalid scenario: " + scenario);
+
+				sim->setTimeStep(args.timeStep);
+				sim->setFinalTime(args.duration);
+				sim->setSolverType(Solver::Type::MNA);
+				sim->setDirectLinearSolverImplementation(CommandLineArgs::directLinearSolverImpl(impl));
+				sim->setScheduler(scheduler(schedulerName, std::stoi(threads)));
+
+				std::cout << "Running " << name << " (" << repetition + 1 << "/" << repetitions << ")" << std::endl;
+				auto start = std::chrono::steady_clock::now();
+				sim->run();
+				std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - start;
+
+				const Histogram& steps = sim->stepTimes();
+				uint64_t factorizations, solves;
+				solverCounts(*sim, factorizations, solves);
+				runs.push_back({
+					{ "scenario", scenario },
+					{ "copies", std::stoi(copies) },
+					{ "impl", impl },
+					{ "scheduler", schedulerName },
+					{ "threads", std::stoi(threads) },
+					{ "repetition", repetition },
+					{ "time_step", args.timeStep },
+					{ "duration", args.duration },
+					{ "wall_time", wallTime.count() },
+					{ "steps", steps.count() },
+					{ "step_time", {
+						{ "mean", steps.mean() },
+						{ "min", steps.min() },
+						{ "p50", steps.percentile(50) },
+						{ "p90", steps.percentile(90) },
+						{ "p99", steps.percentile(99) },
+						{ "p99_9", steps.percentile(99.9) },
+						{ "max", steps.max() }
+					} },
+					{ "factorizations", factorizations },
+					{ "solves", solves },
+					{ "peak_rss", peakRSS() }
+				});
+			}
+		}
+	}
+
+	std::ofstream file(output);
+	file << json({ { "version", 1 }, { "runs", runs } }).dump(2) << std::endl;
+	std::cout << "Wrote " << runs.size() << " runs to " << output << std::endl;
+}
@@ -0,0 +1,55 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/CIM/Reader.h>
+#include <DPsim.h>
+#include <dpsim/ContingencyAnalysis.h>
+
+using namespace std;
+using namespace DPsim;
+using namespace CPS;
+using namespace CPS::CIM;
+
+
+/*
+ * This example screens all line and transformer outages of the CIGRE MV benchmark system
+ */
+int main(int argc, char** argv){
+
+	// Find CIM files
+	std::list<fs::path> filenames;
+	if (argc <= 1) {
+		filenames = DPsim::Utils::findFiles({
+			"Rootnet_FULL_NE_06J16h_DI.xml",
+			"Rootnet_FULL_NE_06J16h_EQ.xml",
+			"Rootnet_FULL_NE_06J16h_SV.xml",
+			"Rootnet_FULL_NE_06J16h_TP.xml"
+		}, "build/_deps/cim-data-src/CIGRE_MV/NEPLAN/CIGRE_MV_no_tapchanger_With_LoadFlow_Results", "CIMPATH");
+	}
+	else {
+		filenames = std::list<fs::path>(argv + 1, argv + argc);
+	}
+
+	String simName = "CIGRE-MV-NoTap-Contingencies";
+	Logger::setLogDir("logs/" + simName);
+	CPS::Real system_freq = 50;
+
+    CIM::Reader reader(simName, Logger::Level::info, Logger::Level::info);
+    SystemTopology system = reader.loadCIM(system_freq, filenames, CPS::Domain::SP);
+
+	ContingencyAnalysis analysis(simName, system);
+	// The HV/MV transformers are rated 25 MVA
+	for (auto comp : system.mComponents) {
+		if (std::dynamic_pointer_cast<CPS::SP::Ph1::Transformer>(comp))
+			analysis.setBranchRating(comp->name(), 25e6);
+	}
+	analysis.run();
+	analysis.writeResults(Logger::logDir() + "/" + simName + ".csv");
+
+	return 0;
+}
@@ -136,9 +136,14 @@ int main(int argc, char** argv){
 	sim.setSolverType(Solver::Type::NRP);
 	sim.setSolverAndComponentBehaviour(Solver::Behaviour::Simulation);
 	sim.doInitFromNodesAndTerminals(true);
+	// Consecutive snapshots differ only slightly, so start from the last
+	// solution and keep the Jacobian factorization as long as possible
+	sim.doPowerFlowWarmStart(true);
+	sim.doPowerFlowJacobianReuse(true);
 	sim.addLogger(logger);
 
 	sim.run();
+	sim.logLUTimes();
 
 	return 0;
 }
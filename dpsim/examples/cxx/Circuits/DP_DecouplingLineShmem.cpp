@@ -0,0 +1,69 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+
+// The circuit of DP_Decoupling_Wave in DP_DecouplingLine.cpp, split at the
+// decoupling line into two processes. Start the example twice, once with
+// argument 0 for the source side and once with 1 for the load side.
+int main(int argc, char* argv[]) {
+	if (argc < 2 || (String(argv[1]) != "0" && String(argv[1]) != "1")) {
+		std::cerr << "usage: " << argv[0] << " 0|1" << std::endl;
+		std::exit(1);
+	}
+	UInt side = String(argv[1]) == "0" ? 0 : 1;
+
+	Real timeStep = 0.00005;
+	Real finalTime = 0.1;
+	String simName = "DP_DecouplingLineShmem_" + std::to_string(side);
+	Logger::setLogDir("logs/"+simName);
+
+	Real resistance = 5;
+	Real inductance = 0.16;
+	Real capacitance = 1.0e-6;
+
+	// Waits until the other process has attached
+	auto link = ShmemLink::make("dpsim-decoupling-line", side);
+
+	auto n = SimNode::make(side == 0 ? "n1" : "n2");
+	auto dline = CPS::Signal::DecouplingLineRemote::make("DecLine", Logger::Level::debug);
+	dline->setParameters(n, resistance, inductance, capacitance, link);
+
+	auto logger = DataLogger::make(simName);
+	logger->logAttribute(side == 0 ? "v1" : "v2", n->attribute("v"));
+	logger->logAttribute("i_src", dline->attribute("i_src"));
+
+	SystemComponentList components;
+	if (side == 0) {
+		auto vs = Ph1::VoltageSource::make("Vsrc");
+		vs->setParameters(CPS::Math::polar(100000, 0));
+		vs->connect({ SimNode::GND, n });
+		logger->logAttribute("i1", vs->attribute("i_intf"));
+		components = { vs, dline };
+	} else {
+		auto load = Ph1::Resistor::make("R_load");
+		load->setParameters(10000);
+		load->connect({ n, SimNode::GND });
+		logger->logAttribute("i2", load->attribute("i_intf"));
+		components = { load, dline };
+	}
+
+	auto sys = SystemTopology(50, SystemNodeList{n}, components);
+	sys.addComponents(dline->getLineComponents());
+
+	Simulation sim(simName);
+	sim.setSystem(sys);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(finalTime);
+	sim.addLogger(logger);
+
+	sim.run();
+}
@@ -0,0 +1,114 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <random>
+
+#include <DPsim.h>
+#include <dpsim/BatchPowerflow.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// Ensemble of DP_Slack_PiLine_PQLoad_with_PF_Init with randomly perturbed loads.
+// The power flows of all members are solved in one batch, then every dynamic
+// simulation is initialized from the power flow of its scenario.
+int main(int argc, char* argv[]) {
+	String simName = "DP_Slack_PiLine_PQLoad_with_PF_Init_Ensemble";
+	UInt numScenarios = argc > 1 ? std::stoi(argv[1]) : 10;
+
+	// Component parameters
+	Real Vnom = 20e3;
+	Real pLoadNom = 100e3;
+	Real qLoadNom = 50e3;
+	Real lineResistance = 0.05;
+	Real lineInductance = 0.1;
+	Real lineCapacitance = 0.1e-6;
+
+	// Simulation parameters
+	Real timeStep = 0.001;
+	Real finalTime = 0.1;
+
+	// ----- BATCHED POWERFLOW FOR INITIALIZATION -----
+	String simNamePF = simName + "_PF";
+	Logger::setLogDir("logs/" + simNamePF);
+
+	auto n1PF = SimNode<Complex>::make("n1", PhaseType::Single);
+	auto n2PF = SimNode<Complex>::make("n2", PhaseType::Single);
+
+	auto extnetPF = SP::Ph1::NetworkInjection::make("Slack");
+	extnetPF->setParameters(Vnom);
+	extnetPF->setBaseVoltage(Vnom);
+	extnetPF->modifyPowerFlowBusType(PowerflowBusType::VD);
+
+	auto linePF = SP::Ph1::PiLine::make("PiLine");
+	linePF->setParameters(lineResistance, lineInductance, lineCapacitance);
+	linePF->setBaseVoltage(Vnom);
+
+	auto loadPF = SP::Ph1::Load::make("Load");
+	loadPF->setParameters(pLoadNom, qLoadNom, Vnom);
+	loadPF->modifyPowerFlowBusType(PowerflowBusType::PQ);
+
+	extnetPF->connect({ n1PF });
+	linePF->connect({ n1PF, n2PF });
+	loadPF->connect({ n2PF });
+	auto systemPF = SystemTopology(50,
+			SystemNodeList{n1PF, n2PF},
+			SystemComponentList{extnetPF, linePF, loadPF});
+
+	// Load powers normally distributed around the nominal values
+	std::mt19937 generator(42);
+	std::normal_distribution<Real> perturbation(1.0, 0.1);
+	std::vector<Complex> loadPowers;
+	BatchPowerflow batch(simNamePF, systemPF);
+	for (UInt s = 0; s < numScenarios; ++s) {
+		loadPowers.push_back(Complex(pLoadNom * perturbation(generator), qLoadNom * perturbation(generator)));
+		batch.addScenario({ { "Load", loadPowers.back() } });
+	}
+	batch.run();
+
+	// ----- DYNAMIC SIMULATIONS -----
+	for (UInt s = 0; s < numScenarios; ++s) {
+		String simNameDP = simName + "_DP_" + std::to_string(s);
+		Logger::setLogDir("logs/" + simNameDP);
+
+		auto n1DP = SimNode<Complex>::make("n1", PhaseType::Single);
+		auto n2DP = SimNode<Complex>::make("n2", PhaseType::Single);
+
+		auto extnetDP = DP::Ph1::NetworkInjection::make("Slack");
+		extnetDP->setParameters(Complex(Vnom,0));
+
+		auto lineDP = DP::Ph1::PiLine::make("PiLine");
+		lineDP->setParameters(lineResistance, lineInductance, lineCapacitance);
+
+		auto loadDP = DP::Ph1::RXLoad::make("Load");
+		loadDP->setParameters(loadPowers[s].real(), loadPowers[s].imag(), Vnom);
+
+		extnetDP->connect({ n1DP });
+		lineDP->connect({ n1DP, n2DP });
+		loadDP->connect({ n2DP });
+		auto systemDP = SystemTopology(50,
+				SystemNodeList{n1DP, n2DP},
+				SystemComponentList{extnetDP, lineDP, loadDP});
+
+		// Initialization of dynamic topology from the power flow of the scenario
+		batch.initWithPowerflow(s, systemDP);
+
+		auto loggerDP = DataLogger::make(simNameDP);
+		loggerDP->logAttribute("v1", n1DP->attribute("v"));
+		loggerDP->logAttribute("v2", n2DP->attribute("v"));
+		loggerDP->logAttribute("irx", loadDP->attribute("i_intf"));
+
+		Simulation sim(simNameDP);
+		sim.setSystem(systemDP);
+		sim.setTimeStep(timeStep);
+		sim.setFinalTime(finalTime);
+		sim.setDomain(Domain::DP);
+		sim.addLogger(loggerDP);
+		sim.run();
+	}
+}
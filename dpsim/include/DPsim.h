@@ -9,6 +9,12 @@
 #include <dpsim/Config.h>
 #include <dpsim/Utils.h>
 #include <dpsim/Simulation.h>
+#include <dpsim/ModelTemplate.h>
+#include <dpsim/CSVLoggerBackend.h>
+#include <dpsim/BinaryLoggerBackend.h>
+#include <dpsim/CompressedLoggerBackend.h>
+#include <dpsim/MemoryLoggerBackend.h>
+#include <dpsim/ColumnarLoggerBackend.h>
 
 #ifndef _MSC_VER
   #include <dpsim/RealTimeSimulation.h>
@@ -23,6 +29,20 @@
 
 #ifdef WITH_OPENMP
   #include <dpsim/OpenMPLevelScheduler.h>
+  #include <dpsim/OpenMPTaskScheduler.h>
+#endif
+
+#ifdef WITH_HDF5
+  #include <dpsim/HDF5LoggerBackend.h>
+#endif
+
+#ifdef WITH_MPI
+  #include <dpsim/MpiLink.h>
+#endif
+
+#ifdef HAVE_SHM_OPEN
+  #include <dpsim/SharedMemoryLoggerBackend.h>
+  #include <dpsim/ShmemLink.h>
 #endif
 
 namespace DPsim {
@@ -0,0 +1,74 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// \brief Step size controller for offline simulations with trapezoidal companion models
+	///
+	/// The time steps are the base time step times a power of two, the level,
+	/// so that a few system matrices cover all steps and their factorizations
+	/// can be kept. The local truncation error of the trapezoidal rule,
+	/// h^3/12 times the third derivative, is estimated from the third divided
+	/// difference of the last four solutions. A step with an error above the
+	/// tolerance lowers the level at once. The level is raised by one only
+	/// after the error allowed it for a number of steps, so that the
+	/// system matrices are not switched back and forth. Steps are not repeated.
+	class AdaptiveTimeStep {
+	public:
+		typedef std::shared_ptr<AdaptiveTimeStep> Ptr;
+
+		/// The error of a solution entry is relative to the tolerance
+		/// absTol + relTol * max|x| of its solution vector
+		AdaptiveTimeStep(Real baseTimeStep, UInt maxLevel, Real relTol, Real absTol, UInt holdSteps);
+
+		/// Time step of the level
+		Real timeStep(UInt level) const { return mBaseTimeStep * static_cast<Real>(1ULL << level); }
+		/// Time step of the current level
+		Real timeStep() const { return timeStep(mLevel); }
+		UInt level() const { return mLevel; }
+		/// Time at the current step, a multiple of the base time step
+		Real time() const { return static_cast<Real>(mBaseSteps) * mBaseTimeStep; }
+		/// Error of the last step relative to the tolerance
+		Real error() const { return mError; }
+		/// Number of level changes
+		UInt changes() const { return mChanges; }
+
+		/// Adds the solutions of the step at the current time and estimates its error
+		void addSolutions(const std::vector<const Matrix*>& solutions);
+		/// Selects the level of the next step so that it ends at the latest at
+		/// the limit, e.g. the next event, and advances the time by that step.
+		/// Returns true if the level changed.
+		Bool advance(Real limit);
+		/// Restarts at time zero with the base time step
+		void reset();
+
+	private:
+		Real mBaseTimeStep;
+		UInt mMaxLevel;
+		Real mRelTol;
+		Real mAbsTol;
+		UInt mHoldSteps;
+
+		UInt mLevel = 0;
+		uint64_t mBaseSteps = 0;
+		Real mError = 0;
+		/// Consecutive steps in which the error allowed a larger step
+		UInt mRaiseSteps = 0;
+		UInt mChanges = 0;
+		/// Times and solutions of the last four steps, oldest first
+		std::deque<Real> mTimes;
+		std::vector<std::deque<Matrix>> mSolutions;
+	};
+}
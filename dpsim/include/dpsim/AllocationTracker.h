@@ -0,0 +1,49 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// \brief Debug hook counting heap allocations of the calling thread
+	///
+	/// With WITH_ALLOCATION_TRACKING, the library interposes malloc (glibc) or
+	/// replaces the global operator new (other C libraries) and counts the
+	/// allocations of a thread while it is armed. Without it, available() is
+	/// false and the counters stay zero. Aligned allocations through
+	/// posix_memalign or aligned_alloc are not seen.
+	class AllocationTracker {
+	public:
+		/// Whether the library was built with the allocation hook
+		static Bool available();
+		/// Starts counting the allocations of the calling thread
+		static void arm();
+		/// Stops counting, the counters keep their values
+		static void disarm();
+		static Bool armed();
+		/// Allocations and allocated bytes of the calling thread while armed
+		static uint64_t allocations();
+		static uint64_t bytes();
+		static void reset();
+
+		/// Disarms the calling thread for the lifetime of the guard,
+		/// e.g. to log a finding without counting the logger's allocations
+		class Pause {
+		public:
+			Pause() : mWasArmed(armed()) { disarm(); }
+			~Pause() { if (mWasArmed) arm(); }
+
+		private:
+			Bool mWasArmed;
+		};
+	};
+}
@@ -0,0 +1,115 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/DirectLinearSolver.h>
+#include <dpsim-models/SystemTopology.h>
+
+namespace DPsim {
+	/// Result of the power flow of one scenario
+	struct BatchPowerflowResult {
+		///
+		Bool converged = false;
+		/// Newton iterations
+		UInt iterations = 0;
+		/// Node voltages in V, in the order of the nodes of the power flow topology
+		std::vector<Complex> voltages;
+	};
+
+	/// Newton-Raphson power flow of many load scenarios of the same network
+	///
+	/// Meant for the initialization of ensembles of dynamic simulations, e.g.
+	/// Monte-Carlo runs with perturbed loads. The topology is parsed, the
+	/// admittance matrix is assembled and the base case is solved once. All
+	/// scenarios only change the power set-points of loads, so they share the
+	/// sparsity pattern and the symbolic analysis of the Jacobian. Every worker
+	/// thread copies the solved base case and solves its scenarios starting from
+	/// the base case voltages. With Jacobian reuse, a factorization is kept over
+	/// the scenarios of a worker as long as the mismatch contracts fast enough.
+	class BatchPowerflow {
+	public:
+		typedef std::shared_ptr<BatchPowerflow> Ptr;
+
+		/// Logger
+		CPS::Logger::Log mLog;
+
+		/// The system should be set up as for a simulation with Solver::Type::NRP
+		BatchPowerflow(String name, const CPS::SystemTopology& system,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+		~BatchPowerflow();
+
+		/// Add a scenario in which the listed loads consume the given active and
+		/// reactive power in W and var, all other loads keep their set-points.
+		/// Returns the index of the scenario.
+		UInt addScenario(const std::map<String, Complex>& loadPowers);
+		///
+		UInt numScenarios() const { return static_cast<UInt>(mScenarios.size()); }
+		/// Number of worker threads, zero selects the OpenMP default
+		void setNumThreads(UInt numThreads) { mNumThreads = numThreads; }
+		/// Maximum number of Newton iterations per scenario
+		void setMaxIterations(UInt maxIterations) { mMaxIterations = maxIterations; }
+		/// Keep the Jacobian factorization between iterations and scenarios
+		void doJacobianReuse(Bool value) { mJacobianReuse = value; }
+		///
+		void setDirectLinearSolverImplementation(DirectLinearSolverImpl implementation) { mDirectImpl = implementation; }
+
+		/// Solves the base case and all scenarios
+		void run();
+
+		/// Result of the base case
+		const BatchPowerflowResult& baseCase() const { return mBaseCase; }
+		/// Results in the order of the scenarios
+		const std::vector<BatchPowerflowResult>& results() const { return mResults; }
+		/// Set the initial node voltages of a dynamic topology from the power flow
+		/// of a scenario, like SystemTopology::initWithPowerflow. Nodes are
+		/// matched by name.
+		void initWithPowerflow(UInt scenario, CPS::SystemTopology& system) const;
+
+	protected:
+		class Worker;
+
+		/// Change of the specified power of a bus in per unit
+		struct Injection {
+			UInt bus;
+			Real activePower;
+			Real reactivePower;
+		};
+
+		/// Translate the load powers of the scenarios into injection changes
+		void collectInjections();
+		/// Store the node voltages of a solved case
+		void storeVoltages(const Worker& worker, BatchPowerflowResult& result) const;
+
+		String mName;
+		CPS::SystemTopology mSystem;
+		CPS::Logger::Level mLogLevel;
+
+		std::vector<std::map<String, Complex>> mScenarios;
+		UInt mNumThreads = 0;
+		UInt mMaxIterations = 20;
+		Bool mJacobianReuse = true;
+		DirectLinearSolverImpl mDirectImpl = DirectLinearSolverImpl::Undef;
+
+		/// Solved base case, copied by the workers
+		std::unique_ptr<Worker> mBase;
+		/// Injection changes of each scenario
+		std::vector<std::vector<Injection>> mInjections;
+		/// Base voltage of each node in V, in the order of the nodes
+		std::vector<Real> mBaseVoltages;
+
+		BatchPowerflowResult mBaseCase;
+		std::vector<BatchPowerflowResult> mResults;
+	};
+}
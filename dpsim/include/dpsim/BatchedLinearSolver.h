@@ -0,0 +1,82 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Logger.h>
+
+namespace DPsim
+{
+	/// Solves a batch of linear systems of the same dimension at once,
+	/// e.g. the system matrices of several scenarios of the same topology.
+	/// This implementation factorizes and solves the systems one after the other
+	/// on the host, device implementations process the whole batch in one call.
+	class BatchedLinearSolver
+	{
+		protected:
+		/// Dense system matrices of the batch
+		std::vector<Matrix> mSystemMatrices;
+		/// Right side vectors of the batch
+		std::vector<Matrix> mRightSideVectors;
+		/// Solutions of the batch
+		std::vector<Matrix> mLeftSideVectors;
+		/// Systems whose matrix changed since the last factorization
+		std::vector<UInt> mChangedSystems;
+		/// Flags systems contained in the list of changed systems
+		std::vector<Bool> mSystemChanged;
+		/// Host factorizations
+		std::vector<CPS::LUFactorized> mFactorizations;
+		/// Dimension of all systems of the batch
+		UInt mDimension = 0;
+		/// Guards adding and updating systems from parallel simulations
+		std::mutex mMutex;
+		/// Logger
+		CPS::Logger::Log mSLog;
+
+		/// Factorizes the systems in the list of changed systems
+		virtual void factorize();
+		/// Solves all systems of the batch for their right side vectors
+		virtual void solveBatch();
+
+		public:
+		typedef std::shared_ptr<BatchedLinearSolver> Ptr;
+
+		/// Constructor with logging
+		BatchedLinearSolver(CPS::Logger::Log log = CPS::Logger::get("BatchedLinearSolver", CPS::Logger::Level::info)) : mSLog(log) {}
+
+		/// Destructor
+		virtual ~BatchedLinearSolver() = default;
+
+		/// Adds a system to the batch and returns its index in the batch
+		UInt addSystem(const SparseMatrix& systemMatrix);
+
+		/// Replaces the matrix of a system, which is factorized again before the next solve
+		void updateSystem(UInt index, const SparseMatrix& systemMatrix);
+
+		/// Right side vector of a system, to be set before the batched solve
+		Matrix& rightSideVector(UInt index) { return mRightSideVectors[index]; }
+
+		/// Solution of a system after the batched solve
+		const Matrix& leftSideVector(UInt index) const { return mLeftSideVectors[index]; }
+
+		/// Number of systems in the batch
+		UInt size() const { return static_cast<UInt>(mSystemMatrices.size()); }
+
+		/// Dimension of the systems in the batch
+		UInt dimension() const { return mDimension; }
+
+		/// Factorizes changed systems and solves all systems of the batch
+		void solve();
+	};
+}
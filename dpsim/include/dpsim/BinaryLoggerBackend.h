@@ -0,0 +1,55 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+
+#include <dpsim/DataLoggerBackend.h>
+
+namespace DPsim {
+	/// \brief Writes the logged values as raw rows of doubles
+	///
+	/// The file starts with the magic "DPSIMBIN", uint32 version, uint32
+	/// columns including the time, uint32 offset of the first row, uint32
+	/// length and the comma separated column names, padded with zeros up to
+	/// the first row. The rows of doubles in native byte order follow, so
+	/// column c of row r is at offset + (r * columns + c) * 8 and the file
+	/// can be mapped into memory as a matrix.
+	class BinaryLoggerBackend : public DataLoggerBackend {
+	public:
+		static constexpr uint32_t Version = 1;
+
+		/// Writes the rows in blocks of the given number of rows
+		BinaryLoggerBackend(UInt bufferRows = 1024);
+		~BinaryLoggerBackend();
+
+		String extension() const override { return ".bin"; }
+		Bool open(const fs::path& filename) override;
+		void close() override;
+		Bool hasColumns() const override { return mColumns > 0; }
+		void setColumns(const std::vector<String>& names, Notation notation) override;
+		void writeRow(Real time, const Real* values, UInt count) override;
+
+		/// Values per row including the time
+		UInt columns() const { return mColumns; }
+		/// Byte offset of the first row, kept after closing the file
+		UInt dataOffset() const { return mDataOffset; }
+
+	private:
+		void flush();
+
+		UInt mBufferRows;
+		std::ofstream mFile;
+		UInt mColumns = 0;
+		UInt mDataOffset = 0;
+		std::vector<Real> mBuffer;
+		UInt mBufferedRows = 0;
+	};
+}
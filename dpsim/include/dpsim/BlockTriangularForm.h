@@ -0,0 +1,58 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// Block triangular form of the sparsity pattern of a square matrix
+	///
+	/// A maximum transversal matches every column with a row, so that the
+	/// row permuted matrix has a zero-free diagonal. The strongly connected
+	/// components of the graph of the permuted matrix are its irreducible
+	/// diagonal blocks. In MNA matrices, the rows of voltage sources have
+	/// zero diagonal entries. After the matching, the voltage of a node with
+	/// an ideal source to ground is a block of its own, which separates the
+	/// networks attached to the node.
+	class BlockTriangularForm {
+	public:
+		/// Computes the form of the pattern, returns false if the matrix is structurally singular
+		Bool compute(const SparseMatrix& matrix);
+
+		///
+		UInt numBlocks() const { return static_cast<UInt>(mBlockColumns.size()); }
+		/// Columns of each block. Every block only depends on the solution
+		/// of the blocks before it.
+		const std::vector<std::vector<UInt>>& blockColumns() const { return mBlockColumns; }
+		/// Row matched to each column
+		const std::vector<UInt>& columnRows() const { return mColumnRows; }
+		/// Block of each column
+		const std::vector<UInt>& columnBlocks() const { return mColumnBlocks; }
+		/// Blocks whose solution each block depends on
+		const std::vector<std::vector<UInt>>& blockDependencies() const { return mBlockDependencies; }
+
+	private:
+		/// Maximum transversal by depth-first search for augmenting paths
+		Bool computeTransversal();
+		/// Strongly connected components of the permuted matrix (Tarjan)
+		void computeBlocks();
+
+		/// Rows with entries in each column
+		std::vector<std::vector<UInt>> mColumnPattern;
+		/// Columns with entries in each row
+		std::vector<std::vector<UInt>> mRowPattern;
+
+		std::vector<UInt> mColumnRows;
+		std::vector<UInt> mColumnBlocks;
+		std::vector<std::vector<UInt>> mBlockColumns;
+		std::vector<std::vector<UInt>> mBlockDependencies;
+	};
+}
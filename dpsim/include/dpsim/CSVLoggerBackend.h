@@ -0,0 +1,33 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <fstream>
+
+#include <dpsim/DataLoggerBackend.h>
+
+namespace DPsim {
+	/// Writes the logged values as comma separated text with aligned columns
+	class CSVLoggerBackend : public DataLoggerBackend {
+	public:
+		String extension() const override { return ".csv"; }
+		Bool open(const fs::path& filename) override;
+		void close() override;
+		Bool hasColumns() const override { return mHasColumns; }
+		void setColumns(const std::vector<String>& names, Notation notation) override;
+		void writeRow(Real time, const Real* values, UInt count) override;
+
+	private:
+		std::ofstream mFile;
+		Bool mHasColumns = false;
+		Notation mNotation = Notation::Scientific;
+		/// Formatted row, reused to avoid allocations
+		String mLine;
+	};
+}
@@ -0,0 +1,65 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Attribute.h>
+#include <dpsim-models/Filesystem.h>
+
+namespace DPsim {
+	/// \brief Snapshot of the simulation state at the end of a time step
+	///
+	/// Holds the values of static attributes by key together with the
+	/// simulation time and pending events. The file starts with the magic
+	/// "DPSIMCKP", uint32 version, the time, step count and time step, the
+	/// pending event times and the number of values. Each value is stored
+	/// as uint32 key length, key, uint32 type, uint32 rows, uint32 columns
+	/// and the elements as doubles in column-major order, complex elements
+	/// as pairs of real and imaginary part.
+	class Checkpoint {
+	public:
+		static constexpr uint32_t Version = 1;
+
+		enum class Type : uint32_t { Real, Complex, Int, UInt, Bool, Matrix, MatrixComp };
+
+		struct Value {
+			Type type;
+			UInt rows;
+			UInt cols;
+			std::vector<Real> data;
+		};
+
+		/// Simulation time of the next step
+		Real time = 0;
+		/// Number of executed steps
+		Int timeStepCount = 0;
+		/// Time step of the simulation
+		Real timeStep = 0;
+		/// Times of the events which were not executed yet
+		std::vector<Real> eventTimes;
+		/// Attribute values by key
+		std::map<String, Value> values;
+
+		/// Stores the value of a static attribute, returns false for dynamic
+		/// attributes and unsupported types
+		Bool capture(const String& key, CPS::AttributeBase::Ptr attr);
+		/// Sets the attribute to the stored value, returns false if there is
+		/// no value for the key or its type or size does not match
+		Bool restore(const String& key, CPS::AttributeBase::Ptr attr) const;
+
+		/// Writes the checkpoint to a binary file
+		void save(const fs::path& filename) const;
+		/// Reads a checkpoint written by save()
+		static Checkpoint load(const fs::path& filename);
+	};
+}
@@ -0,0 +1,67 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <dpsim/DataLoggerBackend.h>
+
+namespace DPsim {
+	/// \brief Keeps all logged rows in memory, one contiguous array per column
+	///
+	/// No file is written. The columns, including the time as the first one,
+	/// are preallocated for the rows announced by reserve(), which the
+	/// simulation derives from the final time, the time step and the
+	/// downsampling of the logger. If more rows are written, the values are
+	/// moved to a new storage of twice the size. Storages are shared, so
+	/// views of a previous storage or run keep their values.
+	class ColumnarLoggerBackend : public DataLoggerBackend {
+	public:
+		typedef std::shared_ptr<ColumnarLoggerBackend> Ptr;
+
+		/// Column c of row r is values[c * capacity + r]
+		struct Storage {
+			UInt capacity = 0;
+			std::vector<Real> values;
+
+			const Real* column(UInt c) const { return values.data() + static_cast<std::size_t>(c) * capacity; }
+		};
+		typedef std::shared_ptr<Storage> StoragePtr;
+
+		/// Preallocates the given number of rows unless the simulation announces more
+		ColumnarLoggerBackend(UInt initialRows = 1024);
+
+		String extension() const override { return ".mem"; }
+		Bool open(const fs::path& filename) override;
+		void close() override { }
+		Bool hasColumns() const override { return mHasColumns; }
+		void setColumns(const std::vector<String>& names, Notation notation) override;
+		void writeRow(Real time, const Real* values, UInt count) override;
+		Bool writesFiles() const override { return false; }
+		void reserve(UInt rows) override;
+
+		/// Names of the columns including the time
+		const std::vector<String>& columnNames() const { return mNames; }
+		/// Rows written since the columns were set
+		UInt rows() const { return mRows; }
+		/// Storage of the values, shared with views of it
+		StoragePtr storage() const { return mStorage; }
+		std::size_t memoryBytes() const override { return mStorage ? mStorage->values.capacity() * sizeof(Real) : 0; }
+
+	private:
+		void grow(UInt capacity);
+
+		UInt mInitialRows;
+		UInt mReservedRows = 0;
+		Bool mHasColumns = false;
+		std::vector<String> mNames;
+		StoragePtr mStorage;
+		UInt mRows = 0;
+	};
+}
@@ -0,0 +1,84 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/DirectLinearSolver.h>
+
+namespace DPsim
+{
+    /// Sparse LU solver factorizing the system matrices of SP and DP solvers in complex form
+    ///
+    /// The complex admittances are stamped as real blocks [Re -Im; Im Re] with
+    /// the imaginary parts at an offset of half the matrix dimension. Such a
+    /// matrix is the real form of a complex matrix of half the dimension with
+    /// a quarter of the nonzeros, which is factorized instead. The real parts
+    /// of the solution are the upper half of the solution vector, the imaginary
+    /// parts the lower half. Matrices that are not of this form, e.g. of EMT
+    /// solvers or with generator stamps coupling real and imaginary parts
+    /// differently, are factorized as real matrices.
+    class ComplexSparseLUAdapter : public DirectLinearSolver
+    {
+        ///
+        Eigen::SparseLU<CPS::SparseMatrixComp, Eigen::COLAMDOrdering<int> > mComplexLU;
+        /// Factorization of matrices that are not the real form of a complex matrix
+        Eigen::SparseLU<CPS::SparseMatrixRow, Eigen::COLAMDOrdering<int> > mRealLU;
+        /// Complex matrix of the last factorization
+        CPS::SparseMatrixComp mComplexMatrix;
+        /// Complex right side and solution vectors
+        CPS::MatrixComp mComplexRightSide;
+        CPS::MatrixComp mComplexSolution;
+        /// Set if the last matrix was factorized in complex form
+        Bool mComplexForm = false;
+        /// Set once a factorization has been computed
+        Bool mFactorized = false;
+
+        /// Converts the matrix to complex form, returns false if it is not the real form of a complex matrix
+        Bool toComplex(const SparseMatrix& systemMatrix);
+        ///
+        void logForm(const SparseMatrix& systemMatrix, Bool complexForm);
+        /// Factorization in complex form if possible, analyzing the pattern first if requested
+        void compute(SparseMatrix& systemMatrix, Bool analyze);
+
+        protected:
+        /// There are no configuration options
+        void applyConfiguration() override;
+
+        public:
+        /// Constructor with logging
+        using DirectLinearSolver::DirectLinearSolver;
+
+        /// Destructor
+        ~ComplexSparseLUAdapter() override;
+
+        /// preprocessing function pre-ordering the complex or real matrix
+        void preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries) override;
+
+        /// factorization function with partial pivoting
+        void factorize(SparseMatrix& systemMatrix) override;
+
+        /// refactorization without partial pivoting
+        void refactorize(SparseMatrix& systemMatrix) override;
+
+        /// partial refactorization withouth partial pivoting
+        void partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries) override;
+
+        /// solution function for a right hand side
+        Matrix solve(Matrix& rightSideVector) override;
+
+        /// solution function writing into a preallocated left hand side vector
+        void solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector) override;
+
+        /// bytes of the factors and of the complex matrix
+        std::size_t memoryBytes() const override;
+    };
+}
@@ -0,0 +1,66 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+
+#include <dpsim/DataLoggerBackend.h>
+
+namespace DPsim {
+	/// \brief Writes the logged values losslessly compressed with XOR float coding
+	///
+	/// Rows are buffered per column and every chunk of rows is compressed column
+	/// by column. Each value is stored as the XOR with the previous value of its
+	/// column, with the leading and trailing zero bits of the XOR left out
+	/// (Gorilla coding). Slowly varying signals shrink to a few bits per value.
+	///
+	/// File layout, little endian:
+	///  - magic "DPSIMXOR", uint32 version, uint32 columns including the time,
+	///    uint32 length and the comma separated column names
+	///  - per chunk: uint32 rows, and per column uint32 length and the bit stream
+	///
+	/// The bit stream of a column starts with the 64 bits of its first value.
+	/// For each following value, a 0 bit marks a repeated value. Otherwise a 1
+	/// bit is followed by either a 0 bit and the significant bits in the window
+	/// of the previous XOR, or a 1 bit, 5 bits of leading zeros, 6 bits of
+	/// significant bits (0 for 64) and the significant bits. The bits of a byte
+	/// are filled from the most significant one.
+	///
+	/// dpsim.compressed.read in the Python package reads the files.
+	class CompressedLoggerBackend : public DataLoggerBackend {
+	public:
+		static constexpr uint32_t Version = 1;
+
+		/// Compresses chunks of the given number of rows
+		CompressedLoggerBackend(UInt chunkRows = 4096);
+		~CompressedLoggerBackend();
+
+		String extension() const override { return ".dpz"; }
+		Bool open(const fs::path& filename) override;
+		void close() override;
+		Bool hasColumns() const override { return mColumns > 0; }
+		void setColumns(const std::vector<String>& names, Notation notation) override;
+		void writeRow(Real time, const Real* values, UInt count) override;
+
+	private:
+		/// Compresses and writes the buffered rows
+		void flush();
+
+		UInt mChunkRows;
+		std::ofstream mFile;
+		/// Columns including the time
+		UInt mColumns = 0;
+		/// Buffered rows, one chunk per column
+		std::vector<Real> mBuffer;
+		UInt mBufferedRows = 0;
+		/// Compressed column, reused between chunks
+		std::vector<uint8_t> mEncoded;
+	};
+}
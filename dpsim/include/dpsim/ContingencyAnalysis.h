@@ -0,0 +1,136 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/DirectLinearSolver.h>
+#include <dpsim-models/Filesystem.h>
+#include <dpsim-models/SystemTopology.h>
+
+namespace DPsim {
+	class PFSolverPowerPolar;
+
+	/// Result of the power flow of one contingency
+	struct ContingencyResult {
+		/// Name of the branch which is out of service, empty for the base case
+		String branch;
+		/// The outage splits the grid, no power flow was solved
+		Bool islanded = false;
+		///
+		Bool converged = false;
+		/// Newton iterations
+		UInt iterations = 0;
+		/// Lowest bus voltage in per unit and the name of its bus
+		Real minVoltage = 0;
+		String minVoltageBus;
+		/// Highest ratio of apparent branch flow and branch rating, zero if no
+		/// branch has a rating, and the name of its branch
+		Real maxLoading = 0;
+		String maxLoadingBranch;
+	};
+
+	/// N-1 contingency analysis of lines and transformers with the Newton-Raphson power flow
+	///
+	/// The topology is parsed, initialized and the admittance matrix is
+	/// assembled once for the base case. Every worker thread copies the
+	/// solved base case. An outage only changes the four admittance matrix
+	/// entries of the branch, so the sparsity pattern and with it the symbolic
+	/// analysis of the Jacobian stay valid. The solve starts from the base case
+	/// voltages and, with Jacobian reuse, from the factorization of the last
+	/// Jacobian of the worker, which is refreshed only if the mismatch does not
+	/// contract fast enough. Outages which split the grid are reported as
+	/// islanded without solving.
+	class ContingencyAnalysis {
+	public:
+		typedef std::shared_ptr<ContingencyAnalysis> Ptr;
+
+		/// Logger
+		CPS::Logger::Log mLog;
+
+		/// The system should be set up as for a simulation with Solver::Type::NRP
+		ContingencyAnalysis(String name, const CPS::SystemTopology& system,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+		~ContingencyAnalysis();
+
+		/// Apparent power rating of a branch in VA, branches without rating are
+		/// not considered for the loading
+		void setBranchRating(const String& branch, Real apparentPower) { mRatings[branch] = apparentPower; }
+		/// Branches to take out of service one at a time, all lines and
+		/// transformers by default
+		void setContingencies(const std::vector<String>& branches) { mContingencyNames = branches; }
+		/// Number of worker threads, zero selects the OpenMP default
+		void setNumThreads(UInt numThreads) { mNumThreads = numThreads; }
+		/// Maximum number of Newton iterations per contingency
+		void setMaxIterations(UInt maxIterations) { mMaxIterations = maxIterations; }
+		/// Keep the Jacobian factorization between iterations and contingencies
+		void doJacobianReuse(Bool value) { mJacobianReuse = value; }
+		///
+		void setDirectLinearSolverImplementation(DirectLinearSolverImpl implementation) { mDirectImpl = implementation; }
+
+		/// Solves the base case and all contingencies
+		void run();
+
+		/// Result of the base case
+		const ContingencyResult& baseCase() const { return mBaseCase; }
+		/// Results in the order of the contingencies
+		const std::vector<ContingencyResult>& results() const { return mResults; }
+		/// Write the base case and the contingency results as CSV
+		void writeResults(const fs::path& filename) const;
+
+	protected:
+		class Worker;
+
+		/// Admittance matrix entries of a branch
+		struct Branch {
+			String name;
+			UInt bus[2];
+			/// Element admittance matrix
+			Complex y[2][2];
+			/// Positions of the entries (i, j) in the value array of the admittance matrix
+			Int slot[2][2];
+			/// Apparent power rating in VA, zero if not rated
+			Real rating = 0;
+		};
+
+		/// Collect the stamped branches of the base case
+		void collectBranches();
+		/// Evaluate voltages and branch flows of a solved case
+		void evaluate(const Worker& worker, Int outage, ContingencyResult& result) const;
+		/// Check whether all buses are still connected to a slack bus
+		Bool isConnected(Int outage) const;
+
+		String mName;
+		CPS::SystemTopology mSystem;
+		CPS::Logger::Level mLogLevel;
+
+		std::map<String, Real> mRatings;
+		std::vector<String> mContingencyNames;
+		UInt mNumThreads = 0;
+		UInt mMaxIterations = 20;
+		Bool mJacobianReuse = true;
+		DirectLinearSolverImpl mDirectImpl = DirectLinearSolverImpl::Undef;
+
+		/// Solved base case, copied by the workers
+		std::unique_ptr<Worker> mBase;
+		/// All stamped branches and the buses at both ends
+		std::vector<Branch> mBranches;
+		/// Branches which are adjacent to each bus
+		std::vector<std::vector<UInt>> mBusBranches;
+		/// Indices into mBranches of the contingencies
+		std::vector<UInt> mContingencies;
+
+		ContingencyResult mBaseCase;
+		std::vector<ContingencyResult> mResults;
+	};
+}
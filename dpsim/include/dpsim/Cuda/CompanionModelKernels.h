@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cuda_runtime.h>
+
+namespace DPsim {
+	namespace cuda {
+		/// \brief Device arrays of the trapezoidal companion models of one number of phases
+		///
+		/// Structure of arrays, so that neighbouring threads read neighbouring
+		/// values: phase a of model k is at a * count + k and the entry (a, b)
+		/// of the matrices of model k at (a * NumPhases + b) * count + k.
+		/// Rows of grounded terminals are negative.
+		struct CompanionModelArrays {
+			int count;
+			const double* equivCond;
+			const double* voltageCoeff;
+			const double* currentCoeff;
+			const int* rows0;
+			const int* rows1;
+			double* voltage;
+			double* current;
+			double* equivCurrent;
+		};
+
+		/// Calculates the equivalent current sources from the last voltages and
+		/// currents and adds them to the permuted right side vector
+		template <int NumPhases>
+		void companionModelPreStep(const CompanionModelArrays& models, double* rightSide, const int* permutation, cudaStream_t stream);
+
+		/// Updates the voltages and currents from the left side vector
+		template <int NumPhases>
+		void companionModelPostStep(const CompanionModelArrays& models, const double* leftSide, cudaStream_t stream);
+	}
+}
@@ -13,6 +13,7 @@
 #include <list>
 
 #include <dpsim/Solver.h>
+#include <dpsim/SundialsLinearSolver.h>
 
 #include <dpsim-models/SystemTopology.h>
 #include <dpsim-models/Solver/DAEInterface.h>
@@ -20,9 +21,15 @@
 
 #include <ida/ida.h>
 #include <ida/ida_direct.h>
+#include <ida/ida_spils.h>
 #include <sunlinsol/sunlinsol_dense.h>
+#include <sunlinsol/sunlinsol_spgmr.h>
+#include <sunmatrix/sunmatrix_sparse.h>
 #include <sundials/sundials_types.h>
 #include <nvector/nvector_serial.h>
+#ifdef WITH_SUNDIALS_KLU
+#include <sunlinsol/sunlinsol_klu.h>
+#endif
 
 
 namespace DPsim {
@@ -60,23 +67,69 @@ namespace DPsim {
 		SUNMatrix A = NULL;
 		/// Linear solver object
 		SUNLinearSolver LS = NULL;
+		/// Linear solver of the Newton iterations
+		SundialsLinearSolver mLinearSolver;
         long int interalSteps = 0;
         long int resEval=0;
         std::vector<CPS::DAEInterface::ResFn> mResidualFunctions;
 
+		/// Evaluate the residuals of the components in parallel chunks
+		Bool mParallelResidual = false;
+		/// Offsets passed to each residual function in the sequential evaluation
+		std::vector<std::vector<int>> mComponentOffsets;
+		/// Residual contributions of each chunk of components, summed after the evaluation
+		std::vector<std::vector<realtype>> mChunkResiduals;
+
+		/// Residual rows and state columns of a component, and the position of each
+		/// of its Jacobian entries in the compressed sparse column format
+		struct JacobianContribution {
+			std::vector<Int> rows;
+			std::vector<Int> columns;
+			/// Column starts of the entries, the last one is the number of entries
+			std::vector<Int> columnStarts;
+			std::vector<Int> entryRows;
+			std::vector<sunindextype> entryPositions;
+			/// Values of the entries of the last Jacobian evaluation
+			std::vector<realtype> values;
+		};
+		std::vector<JacobianContribution> mJacobianContributions;
+		/// Jacobian pattern in compressed sparse column format for the sparse linear solver
+		std::vector<sunindextype> mJacobianColumnPointers;
+		std::vector<sunindextype> mJacobianRowIndices;
+
 		/// Residual Function of entire System
 		static int residualFunctionWrapper(realtype ttime, N_Vector state, N_Vector dstate_dt, N_Vector resid, void *user_data);
 		int residualFunction(realtype ttime, N_Vector state, N_Vector dstate_dt, N_Vector resid);
+		/// Sums the residuals of the components evaluated in parallel chunks
+		void parallelComponentResiduals(realtype ttime, const realtype* state, const realtype* dstate_dt, realtype* resid);
+		/// Records the offsets of the components by one sequential evaluation
+		void initializeComponentOffsets();
+		/// Detects the rows and columns of each component by perturbing the state
+		/// and compresses them into the Jacobian pattern
+		void initializeJacobianPattern();
+		/// Jacobian dF/dy + cj dF/dy' of the residual for the sparse linear solver
+		static int jacobianWrapper(realtype ttime, realtype cj, N_Vector state, N_Vector dstate_dt, N_Vector resid,
+			SUNMatrix J, void *user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+		int jacobian(realtype ttime, realtype cj, N_Vector state, N_Vector dstate_dt, SUNMatrix J);
 
 	public:
-		/// Create solve object with given parameters
-        DAESolver(String name, const CPS::SystemTopology &system, Real dt, Real t0);
+		/// Create solve object with given parameters. The DAE components provide
+		/// no Jacobian, so the dense solver approximates it by difference
+		/// quotients and GMRES only needs residual evaluations. The sparse
+		/// solver detects the pattern of each component once and assembles the
+		/// Jacobian from difference quotients of the single components.
+        DAESolver(String name, const CPS::SystemTopology &system, Real dt, Real t0,
+			SundialsLinearSolver linearSolver = SundialsLinearSolver::Dense);
 		/// Deallocate all memory
 		~DAESolver();
 		/// Initialize Components & Nodes with inital values
 		void initialize(Real t0);
 		/// Solve system for the current time
 		Real step(Real time);
+		/// Evaluate the residuals of the components in parallel chunks, one per
+		/// OpenMP thread. The contributions are summed, so a component has to
+		/// add to the rows it shares with other components instead of assigning them.
+		void doParallelResidual(Bool value) { mParallelResidual = value; }
 
 		CPS::Task::List getTasks();
 	};
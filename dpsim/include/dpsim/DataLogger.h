@@ -8,11 +8,19 @@
 
 #pragma once
 
+#include <limits>
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <readerwriterqueue.h>
 
 #include <dpsim/Definitions.h>
+#include <dpsim/DataLoggerBackend.h>
 #include <dpsim/Scheduler.h>
 #include <dpsim-models/Filesystem.h>
 #include <dpsim-models/PtrFactory.h>
@@ -24,14 +32,175 @@ namespace DPsim {
 
 	class DataLogger : public SharedFactory<DataLogger> {
 
+	public:
+		/// Value written for each output interval of downsampling steps
+		enum class Decimation {
+			/// Value at the first step of the interval
+			Sample,
+			Mean,
+			Min,
+			Max
+		};
+		/// Crossing direction of a threshold trigger
+		enum class Edge { Rising, Falling, Both };
+
 	protected:
-		std::ofstream mLogFile;
+		/// Output format, CSV by default
+		DataLoggerBackend::Ptr mBackend;
 		String mName;
 		Bool mEnabled;
+		/// Steps are skipped while set, the output stays open
+		Bool mPaused = false;
+		/// Rows are only written if the version of a logged attribute changed
+		Bool mLogOnChange = false;
+		/// Sum of the attribute versions of the last written row
+		std::size_t mLoggedVersion = 0;
 		UInt mDownsampling;
+		/// Expected simulation steps of the next run, 0 if unknown
+		UInt mExpectedSteps = 0;
+		static std::function<DataLoggerBackend::Ptr()> sDefaultBackend;
 		fs::path mFilename;
 
 		std::map<String, CPS::AttributeBase::Ptr> mAttributes;
+		/// Names of the value columns passed to the backend
+		std::vector<String> mColumnNames;
+		DataLoggerBackend::Notation mNotation = DataLoggerBackend::Notation::Scientific;
+		/// Set by the first row passed to the backend
+		Bool mRowsWritten = false;
+		/// Values of the current row, reused between steps
+		std::vector<Real> mRow;
+
+		/// Attribute a column is read from, with the same keys as mAttributes
+		struct ColumnSource {
+			enum class Type { Real, Complex, Matrix, MatrixComp, Other };
+			/// Source attribute, or the logged attribute itself for Type::Other
+			CPS::AttributeBase::Ptr attribute;
+			Type type = Type::Other;
+			/// Coefficient of a matrix and real (0) or imaginary (1) part of a complex value
+			UInt row = 0;
+			UInt col = 0;
+			UInt part = 0;
+		};
+		std::map<String, ColumnSource> mColumnSources;
+
+		/// Source attribute shared by one or more columns, resolved at the first logged row
+		/// The attributes are owned by mAttributes and mColumnSources
+		struct CaptureSource {
+			CPS::AttributeBase::Handle attribute;
+			ColumnSource::Type type;
+			/// Static attributes keep their value object, dynamic ones are resolved once per row
+			Bool isStatic;
+			void* object = nullptr;
+			/// Contiguous real values of the source and the rows of a matrix
+			const Real* data = nullptr;
+			UInt rows = 0;
+			UInt cols = 0;
+		};
+		struct CaptureColumn {
+			/// Index into mCaptureSources or -1 for columns converted by type
+			Int source;
+			UInt row;
+			UInt col;
+			UInt part;
+			CPS::AttributeBase::Handle attribute;
+		};
+		std::vector<CaptureSource> mCaptureSources;
+		std::vector<CaptureColumn> mCaptureColumns;
+
+		/// Registers a logged column and the attribute its value is read from
+		void addColumn(const String& name, CPS::AttributeBase::Ptr derived, CPS::AttributeBase::Ptr source,
+			ColumnSource::Type type, UInt row = 0, UInt col = 0, UInt part = 0);
+		/// Maps every column to its source attribute and offset
+		void prepareCapture();
+		/// Updates the value pointer of a source attribute
+		static void resolveSource(CaptureSource& source);
+
+		/// Rows captured for the writer thread in asynchronous mode
+		struct Block {
+			std::vector<Real> times;
+			std::vector<Real> values;
+			UInt rows = 0;
+		};
+		/// Write rows from a background thread
+		Bool mAsync = false;
+		UInt mBlockRows = 0;
+		/// Values per row, fixed by the first captured row
+		UInt mBlockColumns = 0;
+		std::vector<std::unique_ptr<Block>> mBlocks;
+		/// Block currently filled by the logging task
+		Block* mCurrentBlock = nullptr;
+		/// Filled blocks for the writer thread, a null block stops the thread
+		std::unique_ptr<moodycamel::BlockingReaderWriterQueue<Block*>> mFullBlocks;
+		/// Written blocks returned to the logging task
+		std::unique_ptr<moodycamel::BlockingReaderWriterQueue<Block*>> mFreeBlocks;
+		std::thread mWriterThread;
+		/// Executor whose cores the writer thread runs on, if any
+		Executor::Ptr mExecutor;
+
+		Decimation mDecimation = Decimation::Sample;
+		/// Aggregated values of the current output interval
+		std::vector<Real> mAggregate;
+		UInt mAggregateRows = 0;
+		Real mAggregateTime = 0;
+
+		/// Writes windows of full resolution rows around trigger points
+		Bool mWindowed = false;
+		/// Rows outside of windows pass the decimation instead of being dropped
+		Bool mLogOutsideWindows = false;
+		UInt mPreRows = 0;
+		UInt mPostRows = 0;
+		/// Circular buffer of the latest rows before a trigger
+		std::vector<Real> mPreTimes;
+		std::vector<Int> mPreSteps;
+		std::vector<Real> mPreValues;
+		UInt mPreBegin = 0;
+		UInt mPreCount = 0;
+		/// Rows left in the current window
+		UInt mPostRemaining = 0;
+		/// Window requested by trigger()
+		Bool mTriggerPending = false;
+		/// Sorted trigger times and the next one to be reached
+		std::vector<Real> mTriggerTimes;
+		std::size_t mNextTriggerTime = 0;
+		struct ThresholdTrigger {
+			String column;
+			Real threshold;
+			Edge edge;
+			/// Column index, resolved with the column sources
+			Int index = -1;
+			Real previous = std::numeric_limits<Real>::quiet_NaN();
+		};
+		std::vector<ThresholdTrigger> mThresholdTriggers;
+
+		/// Interval of the output grid rows are interpolated to, 0 if rows are written at the steps
+		Real mGridInterval = 0;
+		/// Index of the next grid point
+		uint64_t mGridIndex = 0;
+		/// Time and values of the previous step
+		Real mGridPrevTime = 0;
+		std::vector<Real> mGridPrevRow;
+		/// Interpolated row at a grid point
+		std::vector<Real> mGridRow;
+		/// Interpolates the rows at the grid points up to the time and passes them on
+		void resampleRow(Real time);
+
+		/// Passes a captured row through the trigger window and decimation
+		void processRow(Real time, Int timeStepCount, const Real* values, UInt count);
+		/// Returns true if the row starts or extends a window
+		Bool checkTriggers(Real time, const Real* values);
+		/// Aggregates a row into the current output interval
+		void decimateRow(Real time, Int timeStepCount, const Real* values, UInt count);
+		/// Writes the aggregated values of the current output interval
+		void flushDecimation();
+		/// Writes or drops the buffered pre-trigger rows and the current interval
+		void flushPending();
+
+		/// Passes a row to the backend or captures it for the writer thread
+		void writeRow(Real time, const Real* values, UInt count);
+		/// Writes the captured blocks until a null block is received
+		void writerFunction();
+		/// Hands the current block to the writer thread and waits for it to finish
+		void stopWriter();
 
 		void logDataLine(Real time, Real data);
 		void logDataLine(Real time, const Matrix& data);
@@ -42,7 +211,44 @@ namespace DPsim {
 		typedef std::vector<DataLogger::Ptr> List;
 
 		DataLogger(Bool enabled = true);
-		DataLogger(String name, Bool enabled = true, UInt downsampling = 1);
+		/// Creates a logger writing to the log directory in the format of the given backend,
+		/// which defaults to CSV
+		DataLogger(String name, Bool enabled = true, UInt downsampling = 1, DataLoggerBackend::Ptr backend = nullptr);
+		~DataLogger();
+
+		/// Creates the backend of loggers constructed without one, which
+		/// includes the node value logs of the solvers. Loggers use CSV if no
+		/// factory is set.
+		static void setDefaultBackend(std::function<DataLoggerBackend::Ptr()> factory) { sDefaultBackend = factory; }
+
+		/// Moves the file output to a background thread. Logging a row then only
+		/// copies its values into one of the given number of preallocated blocks,
+		/// which are passed to the writer thread when full. If the writer falls
+		/// behind by all blocks, logging waits for a block to be written.
+		/// Must be called before the first row is logged.
+		void setAsync(UInt blockRows = 1024, UInt blocks = 4);
+		/// Runs the writer thread of asynchronous logging on the cores of the executor
+		void setExecutor(Executor::Ptr executor) { mExecutor = executor; }
+
+		/// Writes one row per interval of downsampling steps with the given
+		/// statistic of the logged attributes over the interval. Aggregated rows
+		/// carry the time of the first step of the interval.
+		void setDecimation(Decimation mode);
+		/// Only writes windows of preRows rows before and postRows rows after
+		/// each trigger at full resolution. Rows outside of the windows are
+		/// dropped, or decimated as without windows if logOutside is set.
+		void setTriggerWindow(UInt preRows, UInt postRows, Bool logOutside = false);
+		/// Triggers a window at the first row logged at or after the given time,
+		/// e.g. the time of a SwitchEvent
+		void addTriggerTime(Real time);
+		/// Triggers a window when the logged column crosses the threshold
+		void addThresholdTrigger(const String& column, Real threshold, Edge edge = Edge::Both);
+		/// Triggers a window at the next logged row
+		void trigger() { mTriggerPending = true; }
+
+		/// Replaces the backend before the first row is logged and opens the
+		/// file with the extension of the new backend
+		void setBackend(DataLoggerBackend::Ptr backend);
 
 		void open();
 		void close();
@@ -51,6 +257,34 @@ namespace DPsim {
 			open();
 		}
 
+		const String& name() const { return mName; }
+		Bool isEnabled() const { return mEnabled; }
+		/// Skips the logging of steps without closing the output
+		void setPaused(Bool paused) { mPaused = paused; }
+		/// Only writes sampled rows in which the version of a logged attribute
+		/// changed, see `AttributeBase::version`. Meant for attributes written
+		/// through `set`, e.g. setpoints, and ignored for decimation and windows.
+		void setLogOnChange(Bool value) { mLogOnChange = value; }
+		Bool isPaused() const { return mPaused; }
+		UInt downsampling() const { return mDownsampling; }
+		/// Writes rows at multiples of the interval, linearly interpolated between
+		/// the steps, instead of at every downsampling step. Meant for simulations
+		/// with varying time steps. Decimation and windows then apply to the
+		/// grid rows. An interval of zero writes rows at the steps.
+		void setOutputGrid(Real interval);
+		Real outputGrid() const { return mGridInterval; }
+		/// Changes the downsampling during the simulation, an open aggregate is written first
+		void setDownsampling(UInt downsampling);
+		/// Passes the expected number of rows of a run with the given number of
+		/// steps to the backend, so that in-memory backends can preallocate them
+		void reserveSteps(UInt steps);
+		const fs::path& filename() const { return mFilename; }
+		DataLoggerBackend::Ptr backend() const { return mBackend; }
+		/// Bytes of the row, block and pre-trigger buffers and of the backend
+		std::size_t memoryBytes() const;
+		/// Names of the value columns, known once the first row is logged
+		const std::vector<String>& columnNames() const { return mColumnNames; }
+
 		void logPhasorNodeValues(Real time, const Matrix& data, Int freqNum = 1);
 		void logEMTNodeValues(Real time, const Matrix& data);
 
@@ -0,0 +1,51 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Filesystem.h>
+
+namespace DPsim {
+	/// \brief Output format of a DataLogger
+	///
+	/// A backend receives the column names once and then one row of values per
+	/// logged step, always as Real values without any string conversion, and
+	/// decides how they are stored.
+	class DataLoggerBackend {
+	public:
+		typedef std::shared_ptr<DataLoggerBackend> Ptr;
+
+		/// Notation of the values in text formats, ignored by binary formats
+		enum class Notation { Fixed, Scientific };
+
+		virtual ~DataLoggerBackend() = default;
+
+		/// Extension of the output files including the dot
+		virtual String extension() const = 0;
+		/// Creates or truncates the output file, returns false on failure
+		virtual Bool open(const fs::path& filename) = 0;
+		/// Writes pending rows and closes the output file
+		virtual void close() = 0;
+		/// Returns true once the columns of the open file are set
+		virtual Bool hasColumns() const = 0;
+		/// Sets the names of the value columns, the time column is added by the backend
+		virtual void setColumns(const std::vector<String>& names, Notation notation) = 0;
+		/// Writes the values of all columns at the given time
+		virtual void writeRow(Real time, const Real* values, UInt count) = 0;
+		/// Returns false for backends keeping the values in memory, which need no log directory
+		virtual Bool writesFiles() const { return true; }
+		/// Expected number of rows of the next run, 0 if unknown, passed before the columns are set
+		virtual void reserve(UInt rows) { }
+		/// Bytes of the values held in memory by the backend
+		virtual std::size_t memoryBytes() const { return 0; }
+	};
+}
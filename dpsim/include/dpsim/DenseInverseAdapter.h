@@ -0,0 +1,79 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/DirectLinearSolver.h>
+
+namespace DPsim
+{
+    /// Solver for small systems, e.g. of hardware-in-the-loop models, that
+    /// solves with the precomputed inverse of the system matrix
+    ///
+    /// A solve is a single dense matrix-vector product without the dependencies
+    /// of the triangular solves, which takes the same operations but less time
+    /// for a few dozen unknowns. The inversion costs more than the factorization,
+    /// so the LU factorization is used for the solves instead if the system
+    /// matrix was refactorized after less than a few solves, and for large systems.
+    class DenseInverseAdapter : public DirectLinearSolver
+    {
+        ///
+        Eigen::PartialPivLU<Matrix> mLU;
+        /// Inverse of the system matrix if it is used for the solves
+        Matrix mInverse;
+        Bool mUseInverse = false;
+        /// Set once a factorization has been computed
+        Bool mFactorized = false;
+        /// Solves since the last factorization
+        UInt mSolves = 0;
+
+        /// Dimension up to which the inverse is computed
+        static constexpr Int mMaxInverseDimension = 256;
+        /// Solves after a factorization for which the inversion pays off
+        static constexpr UInt mMinSolvesPerInversion = 8;
+
+        /// Factorization, inverting the matrix if the last one was used for enough solves
+        void compute(SparseMatrix& systemMatrix);
+
+        protected:
+        /// There are no configuration options
+        void applyConfiguration() override;
+
+        public:
+        /// Constructor with logging
+        using DirectLinearSolver::DirectLinearSolver;
+
+        /// Destructor
+        ~DenseInverseAdapter() override;
+
+        /// preprocessing function, no preprocessing is needed
+        void preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries) override;
+
+        /// factorization function with partial pivoting
+        void factorize(SparseMatrix& systemMatrix) override;
+
+        /// refactorization without partial pivoting
+        void refactorize(SparseMatrix& systemMatrix) override;
+
+        /// partial refactorization withouth partial pivoting
+        void partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries) override;
+
+        /// solution function for a right hand side
+        Matrix solve(Matrix& rightSideVector) override;
+
+        /// solution function writing into a preallocated left hand side vector
+        void solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector) override;
+
+        /// bytes of the factors and of the inverse
+        std::size_t memoryBytes() const override;
+    };
+}
@@ -25,6 +25,23 @@ namespace DPsim
     {
         Eigen::PartialPivLU<Matrix> LUFactorized;
 
+        /// Single precision factorization of mixed precision solves
+        Eigen::PartialPivLU<Eigen::MatrixXf> mLowPrecisionLU;
+        /// System matrix for the double precision residuals of the refinement
+        SparseMatrix mSystemMatrix;
+        Bool mMixedPrecision = false;
+        /// Set when a mixed precision solve fell back to the double precision factorization
+        Bool mUseDoubleFactorization = false;
+        /// Set once a factorization has been computed
+        Bool mFactorized = false;
+
+        /// Factorization in the configured precision
+        void compute(SparseMatrix& systemMatrix);
+
+        protected:
+        /// Applies the factorization precision
+        void applyConfiguration() override;
+
         public:
 		/// Constructor with logging
 		using DirectLinearSolver::DirectLinearSolver;
@@ -46,5 +63,11 @@ namespace DPsim
 
 		/// solution function for a right hand side
 		Matrix solve(Matrix& rightSideVector) override;
+
+		/// solution function writing into a preallocated left hand side vector
+		void solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector) override;
+
+		/// bytes of the factors and of the system matrix kept for mixed precision
+		std::size_t memoryBytes() const override;
     };
 }
@@ -12,6 +12,7 @@
 #include <dpsim-models/Solver/MNAInterface.h>
 #include <dpsim-models/SimSignalComp.h>
 #include <dpsim/DataLogger.h>
+#include <dpsim/DirectLinearSolver.h>
 #include <dpsim/Solver.h>
 
 #include <unordered_map>
@@ -35,10 +36,23 @@ namespace DPsim {
 			UInt mVirtualNodeNum;
 			/// Offset of block in system matrix
 			UInt sysOff;
+			/// Sparse block of the subnet in the system matrix
+			SparseMatrix systemMatrix;
 			/// Factorization of the subnet's block
-			CPS::LUFactorized luFactorization;
+			std::shared_ptr<DirectLinearSolver> linearSolver;
+			/// Right and left side vectors of the solves with the block
+			Matrix rightVector;
+			Matrix solution;
 			/// List of all right side vector contributions
 			std::vector<const Matrix*> rightVectorStamps;
+			/// Columns of the tear topology with entries in the rows of the subnet
+			std::vector<UInt> tearColumns;
+			/// Rows of the subnet in the tear topology, restricted to its tear columns
+			CPS::SparseMatrix tearTopology;
+			/// Boundary voltages C^T * v of the subnet, in the order of the tear columns
+			Matrix tearVoltages;
+			/// Currents of the tear columns of the subnet
+			Matrix tearCurrents;
 			/// Left-side vector of the subnet AFTER complete step
 			CPS::Attribute<Matrix>::Ptr leftVector;
 		};
@@ -58,21 +72,18 @@ namespace DPsim {
 		typename CPS::SimPowerComp<VarType>::List mTearComponents;
 		CPS::SimSignalComp::List mSimSignalComps;
 
+		/// Linear solver implementation of the subnets
+		DirectLinearSolverImpl mImplementationInUse;
+
 		Matrix mRightSideVector;
 		Matrix mLeftSideVector;
-		/// Complete matrix in block form
-		Matrix mSystemMatrix;
-		/// Inverse of the complete system matrix (only used for initialization)
-		Matrix mSystemInverse;
 		/// Topology of the network removal
-		Matrix mTearTopology;
+		CPS::SparseMatrix mTearTopology;
 		/// Impedance of the removed network
 		CPS::SparseMatrixRow mTearImpedance;
 		/// (Factorization of the) impedance matrix for the removed network, including
 		/// the influence of other subnets
 		CPS::LUFactorized mTotalTearImpedance;
-		/// Currents through the removed network
-		Matrix mTearCurrents;
 		/// Voltages across the removed network
 		Matrix mTearVoltages;
 
@@ -92,20 +103,28 @@ namespace DPsim {
 
 		void initMatrices();
 		void applyTearComponentStamp(UInt compIdx);
+		/// Extracts the boundary of a subnet from the tear topology
+		void createSubnetTearTopology(Subnet& net);
+		/// Adds the influence of a subnet on the removed network to the removed impedance
+		void addSubnetTearImpedance(const Subnet& net, Matrix& totalTearImpedance);
+		std::shared_ptr<DirectLinearSolver> createLinearSolver();
 
 		void log(Real time);
 
 	public:
 
-		/// Currents through the removed network (as "seen" from the other subnets)
-		const CPS::Attribute<Matrix>::Ptr mMappedTearCurrents;
+		/// Currents through the removed network
+		const CPS::Attribute<Matrix>::Ptr mTearCurrents;
 
 		/// Solutions of the split systems
 		const CPS::Attribute<Matrix>::Ptr mOrigLeftSideVector;
 
-		DiakopticsSolver(String name, CPS::SystemTopology system, CPS::IdentifiedObject::List tearComponents, Real timeStep, CPS::Logger::Level logLevel);
+		DiakopticsSolver(String name, CPS::SystemTopology system, CPS::IdentifiedObject::List tearComponents, Real timeStep, CPS::Logger::Level logLevel,
+			DirectLinearSolverImpl implementation = DirectLinearSolverImpl::Undef);
 
 		CPS::Task::List getTasks();
+		/// Left and right side vector loggers
+		std::vector<std::shared_ptr<DataLogger>> dataLoggers() override { return { mLeftVectorLog, mRightVectorLog }; }
 
 		class SubnetSolveTask : public CPS::Task {
 		public:
@@ -132,7 +151,7 @@ namespace DPsim {
 			PreSolveTask(DiakopticsSolver<VarType>& solver) :
 				Task(solver.mName + ".PreSolve"), mSolver(solver) {
 				mAttributeDependencies.push_back(solver.mOrigLeftSideVector);
-				mModifiedAttributes.push_back(solver.mMappedTearCurrents);
+				mModifiedAttributes.push_back(solver.mTearCurrents);
 			}
 
 			void execute(Real time, Int timeStepCount);
@@ -145,7 +164,7 @@ namespace DPsim {
 		public:
 			SolveTask(DiakopticsSolver<VarType>& solver, UInt net) :
 				Task(solver.mName + ".Solve_" + std::to_string(net)), mSolver(solver), mSubnet(solver.mSubnets[net]) {
-				mAttributeDependencies.push_back(solver.mMappedTearCurrents);
+				mAttributeDependencies.push_back(solver.mTearCurrents);
 				mModifiedAttributes.push_back(mSubnet.leftVector);
 			}
 
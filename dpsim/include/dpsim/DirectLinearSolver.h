@@ -21,6 +21,22 @@
 
 namespace DPsim
 {
+	enum DirectLinearSolverImpl{
+		Undef = 0,
+		KLU,
+		SparseLU,
+		DenseLU,
+		CUDADense,
+		CUDASparse,
+		CUDAMagma,
+		Plugin,
+		ParallelSparseLU,
+		Iterative,
+		ComplexSparseLU,
+		Auto,
+		DenseInverse
+	};
+
 	class DirectLinearSolver
 	{
 		public:
@@ -51,6 +67,13 @@ namespace DPsim
 		/// preprocessing function pre-ordering and scaling the matrix
 		virtual void preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries) = 0;
 
+		/// Uses the preprocessing of another solver of a matrix with the same sparsity pattern
+		/// instead of preprocessing the matrix. Returns false if the solver cannot share it.
+		virtual Bool adoptSymbolicAnalysis(const DirectLinearSolver& analyzed, SparseMatrix& systemMatrix)
+		{
+			return false;
+		}
+
 		/// factorization function with partial pivoting
 		virtual void factorize(SparseMatrix& systemMatrix) = 0;
 
@@ -63,12 +86,33 @@ namespace DPsim
 		/// solution function for a right hand side
 		virtual Matrix solve(Matrix& rightSideVector) = 0;
 
+		/// solution function writing into a preallocated left hand side vector, does not allocate if dimensions match
+		virtual void solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector) = 0;
+
 		virtual void setConfiguration(DirectLinearSolverConfiguration& configuration)
 		{
 			mConfiguration = configuration;
 			this->applyConfiguration();
 		}
 
+		/// logs solver specific statistics, e.g. the convergence of iterative solvers
+		virtual void logStatistics()
+		{
+			// no statistics for direct solvers by default
+		}
+
+		/// number of refactorizations that fell back to a factorization with pivoting
+		virtual UInt pivotFaults() const
+		{
+			return 0;
+		}
+
+		/// heap bytes of the factorization and of the copies of the system matrix
+		virtual std::size_t memoryBytes() const
+		{
+			return 0;
+		}
+
 		protected:
 		/// Stores logger of solver class
 		CPS::Logger::Log mSLog;
@@ -82,5 +126,20 @@ namespace DPsim
 			// warn user that no configuration setting is used
 			SPDLOG_LOGGER_WARN(mSLog, "Linear solver configuration is not used!");
 		}
+
+		/// Refines a solution of a low precision factorization with double precision residuals.
+		/// The correction solve maps a residual to the correction of the solution. Returns false
+		/// if the relative residual is still above the configured tolerance after the refinement.
+		template <typename CorrectionSolve>
+		Bool refineSolution(const SparseMatrix& systemMatrix, const Matrix& rightSideVector, Matrix& leftSideVector, CorrectionSolve correctionSolve)
+		{
+			Real threshold = mConfiguration.getRefinementTolerance() * rightSideVector.norm();
+			Matrix residual = rightSideVector - systemMatrix * leftSideVector;
+			for (UInt step = 0; step < mConfiguration.getRefinementSteps() && residual.norm() > threshold; ++step) {
+				leftSideVector += correctionSolve(residual);
+				residual = rightSideVector - systemMatrix * leftSideVector;
+			}
+			return residual.norm() <= threshold;
+		}
 	};
 }
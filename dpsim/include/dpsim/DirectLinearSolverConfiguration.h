@@ -41,12 +41,39 @@ namespace DPsim
 		DO_BTF
 	};
 
+	// Define host-device transfers of GPU solvers, if applicable
+	enum class GPU_TRANSFER_METHOD {
+		SYNCHRONOUS,
+		PINNED_ASYNC,		// pinned host buffers with asynchronous copies on the solver stream
+		PINNED_ASYNC_GRAPH	// additionally replays the solve sequence as captured CUDA graph
+	};
+
+	// Define preconditioner of iterative solvers, if applicable
+	enum class ITERATIVE_PRECONDITIONER {
+		ILUT,	// incomplete LU with threshold dropping
+		LU		// complete sparse LU of a prior system matrix
+	};
+
+	// Define precision of the factorization, if applicable
+	enum class FACTORIZATION_PRECISION {
+		DOUBLE,
+		MIXED	// single precision factorization with double precision refinement
+	};
+
 	class DirectLinearSolverConfiguration
 	{
 		SCALING_METHOD mScalingMethod;
 		FILL_IN_REDUCTION_METHOD mFillInReductionMethod;
 		PARTIAL_REFACTORIZATION_METHOD mPartialRefactorizationMethod;
 		USE_BTF mUseBTF;
+		GPU_TRANSFER_METHOD mGpuTransferMethod;
+		ITERATIVE_PRECONDITIONER mIterativePreconditioner;
+		Real mIterativeTolerance;
+		UInt mIterativeMaxIterations;
+		UInt mPreconditionerRefreshIterations;
+		FACTORIZATION_PRECISION mFactorizationPrecision;
+		UInt mRefinementSteps;
+		Real mRefinementTolerance;
 
 		public:
 		DirectLinearSolverConfiguration();
@@ -59,6 +86,26 @@ namespace DPsim
 
 		void setBTF(USE_BTF useBTF);
 
+		void setGpuTransferMethod(GPU_TRANSFER_METHOD gpuTransferMethod);
+
+		void setIterativePreconditioner(ITERATIVE_PRECONDITIONER iterativePreconditioner);
+
+		/// Relative residual norm at which iterative solvers stop
+		void setIterativeTolerance(Real tolerance);
+
+		void setIterativeMaxIterations(UInt maxIterations);
+
+		/// Number of iterations of the last solve above which a partial refactorization refreshes the preconditioner
+		void setPreconditionerRefreshIterations(UInt refreshIterations);
+
+		void setFactorizationPrecision(FACTORIZATION_PRECISION factorizationPrecision);
+
+		/// Maximum number of refinement steps of mixed precision solves
+		void setRefinementSteps(UInt refinementSteps);
+
+		/// Relative residual norm above which mixed precision solves fall back to a double precision factorization
+		void setRefinementTolerance(Real tolerance);
+
 		SCALING_METHOD getScalingMethod() const;
 
 		FILL_IN_REDUCTION_METHOD getFillInReductionMethod() const;
@@ -67,6 +114,22 @@ namespace DPsim
 
 		USE_BTF getBTF() const;
 
+		GPU_TRANSFER_METHOD getGpuTransferMethod() const;
+
+		ITERATIVE_PRECONDITIONER getIterativePreconditioner() const;
+
+		Real getIterativeTolerance() const;
+
+		UInt getIterativeMaxIterations() const;
+
+		UInt getPreconditionerRefreshIterations() const;
+
+		FACTORIZATION_PRECISION getFactorizationPrecision() const;
+
+		UInt getRefinementSteps() const;
+
+		Real getRefinementTolerance() const;
+
 		String getScalingMethodString() const;
 
 		String getFillInReductionMethodString() const;
@@ -74,5 +137,11 @@ namespace DPsim
 		String getPartialRefactorizationMethodString() const;
 
 		String getBTFString() const;
+
+		String getGpuTransferMethodString() const;
+
+		String getIterativePreconditionerString() const;
+
+		String getFactorizationPrecisionString() const;
 	};
 }
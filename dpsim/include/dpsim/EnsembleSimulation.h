@@ -0,0 +1,68 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Simulation.h>
+#include <dpsim/BatchedLinearSolver.h>
+
+namespace DPsim {
+	/// Steps several scenarios of the same topology in lock-step, solving the
+	/// system matrices of all scenarios with one batched linear solver per step.
+	/// The scenarios may differ in their parameters, loads and events.
+	class EnsembleSimulation {
+
+	protected:
+		/// Name of the ensemble
+		String mName;
+		/// Scenarios of the ensemble
+		std::vector<Simulation::Ptr> mScenarios;
+		/// Batched linear solver shared by all scenarios
+		BatchedLinearSolver::Ptr mBatchedLinearSolver;
+		/// Executor stepping the scenarios in parallel, OpenMP is used if not set
+		Executor::Ptr mExecutor;
+		///
+		Bool mInitialized = false;
+
+	public:
+		typedef std::shared_ptr<EnsembleSimulation> Ptr;
+
+		/// Ensemble logger
+		CPS::Logger::Log mLog;
+
+		/// Creates an ensemble with a batched linear solver, which defaults to
+		/// the GPU implementation if available
+		EnsembleSimulation(String name, BatchedLinearSolver::Ptr batchedLinearSolver = nullptr,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		/// Adds a scenario, which must not be initialized yet
+		void addScenario(Simulation::Ptr scenario);
+		/// Steps the scenarios in parallel on the workers of the executor
+		void setExecutor(Executor::Ptr executor) { mExecutor = executor; }
+
+		// #### Simulation Control ####
+		/// Initializes all scenarios with the shared batched linear solver
+		void initialize();
+		/// Starts all scenarios without advancing in time
+		void start();
+		/// Stops all scenarios
+		void stop();
+		/// Advances all scenarios by one time step
+		Real step();
+		/// Runs all scenarios until the final time is elapsed
+		void run();
+
+		// #### Getter ####
+		String name() const { return mName; }
+		std::vector<Simulation::Ptr>& scenarios() { return mScenarios; }
+		BatchedLinearSolver::Ptr batchedLinearSolver() { return mBatchedLinearSolver; }
+	};
+}
@@ -8,8 +8,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <deque>
 #include <queue>
+#include <type_traits>
+#include <vector>
 
 #include <dpsim/Config.h>
 #include <dpsim-models/Definitions.h>
@@ -17,6 +20,7 @@
 #include <dpsim-models/Logger.h>
 #include <dpsim-models/Base/Base_Ph1_Switch.h>
 #include <dpsim-models/Base/Base_Ph3_Switch.h>
+#include <dpsim-models/Base/Base_Converter.h>
 #include <dpsim-models/PtrFactory.h>
 
 namespace DPsim {
@@ -24,6 +28,12 @@ namespace DPsim {
 	class EventComparator;
 	class EventQueue;
 
+	/// New state of a switch, identified by its state attribute
+	struct SwitchChange {
+		const CPS::AttributeBase* state;
+		CPS::Bool closed;
+	};
+
 	class Event {
 
 		friend class EventComparator;
@@ -36,6 +46,12 @@ namespace DPsim {
 		using Ptr = std::shared_ptr<Event>;
 
 		virtual void execute() = 0;
+		/// Appends the switch states set by the event, which lets the solvers
+		/// prepare the system matrix of the new topology in advance
+		virtual void switchChanges(std::vector<SwitchChange>& changes) const { }
+
+		/// Simulation time at which the event is executed
+		CPS::Real time() const { return mTime; }
 
 		Event(CPS::Real t) :
 			mTime(t)
@@ -67,6 +83,12 @@ namespace DPsim {
 		void execute() {
 			mAttribute->set(mNewValue);
 		}
+
+		void switchChanges(std::vector<SwitchChange>& changes) const {
+			// Boolean attributes might be the state of a switch, others are ignored by the solvers
+			if constexpr (std::is_same<T, CPS::Bool>::value)
+				changes.push_back({ mAttribute.getPtr().get(), mNewValue });
+		}
 	};
 
 	class SwitchEvent : public Event, public SharedFactory<SwitchEvent> {
@@ -90,6 +112,10 @@ namespace DPsim {
 			else
 				mSwitch->open();
 		}
+
+		void switchChanges(std::vector<SwitchChange>& changes) const {
+			changes.push_back({ mSwitch->mIsClosed.getPtr().get(), mNewState });
+		}
 	};
 
 	class SwitchEvent3Ph : public Event, public SharedFactory<SwitchEvent3Ph> {
@@ -113,19 +139,88 @@ namespace DPsim {
 			else
 				mSwitch->openSwitch();
 		}
+
+		void switchChanges(std::vector<SwitchChange>& changes) const {
+			changes.push_back({ mSwitch->mSwitchClosed.getPtr().get(), mNewState });
+		}
 	};
 
+	class ConverterFidelityEvent : public Event, public SharedFactory<ConverterFidelityEvent> {
+
+	protected:
+		std::shared_ptr<CPS::Base::Converter> mConverter;
+		CPS::Base::Converter::Fidelity mFidelity;
+
+	public:
+		using SharedFactory<ConverterFidelityEvent>::make;
+
+		ConverterFidelityEvent(CPS::Real t, const std::shared_ptr<CPS::Base::Converter> &converter, CPS::Base::Converter::Fidelity fidelity) :
+			Event(t),
+			mConverter(converter),
+			mFidelity(fidelity)
+		{ }
+
+		void execute() {
+			mConverter->setFidelity(mFidelity);
+		}
+	};
 
 	class EventQueue {
 
 	protected:
 		std::priority_queue<Event::Ptr, std::deque<Event::Ptr>, EventComparator> mEvents;
+		/// Events added by addEvent, restored by rewind()
+		std::vector<Event::Ptr> mAdded;
+
+		/// Node of the list of injected events
+		struct InjectedEvent {
+			Event::Ptr event;
+			InjectedEvent* next;
+		};
+		/// Events injected since the last drain, latest first
+		std::atomic<InjectedEvent*> mInjected { nullptr };
+		/// Batches and events handled since the last report, updated in place so
+		/// that the step does not allocate
+		CPS::UInt mHandledBatches = 0;
+		CPS::UInt mHandledEvents = 0;
+		/// Time of the last handled batch
+		CPS::Real mLastHandledTime = 0;
 
 	public:
-		///
+		/// Events are executed at steps up to this time before them
+		static constexpr CPS::Real timeTolerance = 100e-9;
+
+		EventQueue() = default;
+		EventQueue(const EventQueue&) = delete;
+		EventQueue& operator=(const EventQueue&) = delete;
+		~EventQueue();
+
+		/// Adds an event from the simulation thread, e.g. before the simulation starts
 		void addEvent(Event::Ptr e);
-		///
+		/// Adds an event from any thread without locking, also while the
+		/// simulation is running. The event is moved into the queue by the next
+		/// handleEvents(), events whose time has already passed are executed then.
+		void injectEvent(Event::Ptr e);
+		/// Moves the injected events into the queue
+		void drainInjected();
+		/// Executes all due events as one batch, so that the solvers see
+		/// their combined changes in the following step. The batch is only
+		/// recorded, the output is left to reportHandled().
 		void handleEvents(CPS::Real currentTime);
+		/// Logs the number of batches and events handled since the last report
+		void reportHandled(CPS::Logger::Log log);
+		/// Times of the events which were not executed yet, in order
+		std::vector<CPS::Real> pendingTimes() const;
+		/// Time of the next event which was not executed yet, infinity if there is none
+		CPS::Real nextTime() const;
+		/// Events which are executed together with the next event
+		std::vector<Event::Ptr> nextEvents() const;
+		/// Removes the events which handleEvents would have executed up to
+		/// the given time, without executing them
+		void dropHandled(CPS::Real lastTime);
+		/// Restores the queue to the events added by addEvent, e.g. for a reset
+		/// of the simulation. Injected events are discarded.
+		void rewind();
 	};
 }
 
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// \brief Append-only binary log of typed solver diagnostics
+	///
+	/// Records have a fixed size and are handed from the simulation threads to
+	/// a writer thread through a bounded lock-free queue, so that logging an
+	/// event neither formats strings nor blocks the step. Records are dropped
+	/// and counted if the queue is full. The file starts with the magic bytes
+	/// "DPSIMEVT", the format version and the record size, followed by the
+	/// records. It is decoded by `dpsim.eventlog` in Python.
+	class EventLog {
+	public:
+		typedef std::shared_ptr<EventLog> Ptr;
+
+		static constexpr char Magic[8] = { 'D', 'P', 'S', 'I', 'M', 'E', 'V', 'T' };
+		static constexpr uint32_t Version = 1;
+
+		enum class Type : uint32_t {
+			/// Code: new switch status, values: previous switch status
+			SwitchChange = 1,
+			/// Code: Recomputation, values: duration in seconds
+			Recomputation = 2,
+			/// Code: number of pivot faults so far, values: none
+			PivotFault = 3,
+			/// Code: Timer, values: count, mean and maximum in seconds
+			Timing = 4,
+			/// Recorded by the user
+			Custom = 5
+		};
+
+		enum Recomputation : uint32_t { Refactorization = 0, LowRankUpdate = 1 };
+		enum Timer : uint32_t { StepTime = 0, Factorization = 1, RecomputationTime = 2, Solve = 3 };
+
+		struct Record {
+			/// Simulation time of the step
+			double time;
+			/// Time step count
+			int64_t step;
+			uint32_t type;
+			uint32_t code;
+			double values[3];
+		};
+
+		/// Creates the file and starts the writer thread. The queue holds
+		/// `capacity` records, rounded up to a power of two.
+		EventLog(const String& filename, UInt capacity = 1 << 16);
+		~EventLog() { close(); }
+
+		/// Sets the time and step of the following records, called by the simulation at the start of each step
+		void setStep(Real time, Int step) {
+			mTime.store(time, std::memory_order_relaxed);
+			mStep.store(step, std::memory_order_relaxed);
+		}
+
+		/// Queues a record for the current step, may be called concurrently
+		void record(Type type, uint32_t code, double value0 = 0, double value1 = 0, double value2 = 0);
+		/// Writes the queued records and closes the file
+		void close();
+
+		/// Number of records dropped because the queue was full
+		uint64_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
+		/// Number of records written so far
+		uint64_t written() const { return mWritten.load(std::memory_order_relaxed); }
+
+	private:
+		/// Slot of the queue, the sequence tells whether it is free or filled for a position
+		struct Slot {
+			std::atomic<uint64_t> sequence;
+			Record record;
+		};
+
+		/// Writes the queued records to the file, returns the number of records
+		std::size_t drain();
+		void run();
+
+		std::ofstream mFile;
+		std::unique_ptr<Slot[]> mSlots;
+		uint64_t mMask;
+		alignas(64) std::atomic<uint64_t> mEnqueue { 0 };
+		alignas(64) uint64_t mDequeue = 0;
+		std::vector<Record> mBuffer;
+
+		std::atomic<Real> mTime { 0 };
+		std::atomic<Int> mStep { 0 };
+		std::atomic<uint64_t> mDropped { 0 };
+		std::atomic<uint64_t> mWritten { 0 };
+		std::atomic<bool> mRunning { false };
+		std::thread mWriter;
+	};
+}
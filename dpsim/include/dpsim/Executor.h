@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// \brief Pool of worker threads on a set of cores, shared by the parts of a simulation
+	///
+	/// The global executor runs on all cores the process may use. Partitions
+	/// reserve cores of it, which no other partition gets until the partition
+	/// is destroyed, so that e.g. several simulations in one process run on
+	/// non-overlapping cores. Short jobs like the parallel initialization of
+	/// components are submitted to the workers of an executor. Long-running
+	/// threads like the scheduler threads, the interface threads and the
+	/// writer threads of asynchronous loggers stay dedicated threads, but are
+	/// started by the executor so that they run on its cores.
+	class Executor : public std::enable_shared_from_this<Executor> {
+	public:
+		typedef std::shared_ptr<Executor> Ptr;
+
+		/// Creates an executor on the given CPUs, on all CPUs the process may use if empty
+		Executor(const std::vector<Int>& cpus = {});
+		~Executor();
+
+		/// Executor of the process on all CPUs it may use
+		static Ptr global();
+
+		/// Reserves the given number of free cores, throws if there are not enough
+		Ptr partition(UInt cores);
+		/// Reserves the free cores in the given number of partitions of equal size
+		std::vector<Ptr> split(UInt parts);
+
+		/// CPUs of the executor
+		const std::vector<Int>& cpus() const { return mCpus; }
+		/// Number of threads that run in parallel on the cores
+		UInt concurrency() const { return static_cast<UInt>(mCpus.size()); }
+		/// Number of cores not reserved by partitions
+		UInt freeCores();
+
+		/// Queues a job for the workers, which are started on the first job
+		std::future<void> submit(std::function<void()> job);
+		/// Calls func for the indices 0 to count - 1 on the workers and the calling
+		/// thread. The first exception is rethrown after all indices are done.
+		/// Called from a worker, the indices are run by the calling thread only.
+		void parallelFor(UInt count, const std::function<void(UInt)>& func);
+
+		/// Starts a dedicated thread on the cores, pinned to one core if index is not negative
+		std::thread spawn(Int index, std::function<void()> func);
+		/// Pins the calling thread to the core index modulo the number of cores
+		void pin(Int index) const;
+		/// Lets the calling thread run on all cores of the executor
+		void pin() const;
+
+	private:
+		/// Partition of the parent on the given CPUs
+		Executor(Ptr parent, const std::vector<Int>& cpus);
+
+		/// Returns the cores of a partition
+		void release(const std::vector<Int>& cpus);
+		void workerFunction();
+
+		/// Executor the cores were reserved from, null for the global one
+		Ptr mParent;
+		std::vector<Int> mCpus;
+		/// Whether each core is reserved by a partition
+		std::vector<Bool> mReserved;
+		std::mutex mPartitionMutex;
+
+		std::vector<std::thread> mWorkers;
+		std::deque<std::packaged_task<void()>> mJobs;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		Bool mStopping = false;
+	};
+}
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Attribute.h>
+
+#include <readerwritercircularbuffer.h>
+
+namespace DPsim {
+	/// \brief Single-producer, single-consumer ring of preallocated export samples
+	///
+	/// Every slot holds the values of all exported attributes of one step in
+	/// a fixed layout, so taking a snapshot does not allocate. Real, Int and
+	/// Bool attributes take one value, Complex attributes take two values and
+	/// Real matrices take one value per element in column-major order;
+	/// attributes of other types are cloned into the slot. The simulation
+	/// thread fills the slots with push(), the interface thread takes the
+	/// newest filled slot with acquire() and hands it back with release().
+	class ExportRing {
+	public:
+		typedef std::shared_ptr<ExportRing> Ptr;
+
+		enum class Kind { Real, Int, Bool, Complex, Vector, Bytes, Other };
+
+		struct Slot {
+			/// Sequence ID of the snapshot
+			UInt sequenceId = 0;
+			/// Simulation time of the snapshot
+			Real time = 0;
+			/// Set for the last slot before the interface is closed
+			Bool close = false;
+			/// Values of the Real, Int, Bool, Complex and Vector attributes
+			std::vector<Real> values;
+			/// Serialized values of the attributes of other types with a fixed size, e.g. matrices
+			std::vector<unsigned char> bytes;
+			/// Copies of the attributes of other types
+			std::vector<CPS::AttributeBase::Ptr> others;
+		};
+
+		/// Creates the layout for the given attributes and the slots. An
+		/// attribute with a positive deadband is only updated if its value
+		/// changed by more than the deadband since it was last updated.
+		ExportRing(const std::vector<CPS::AttributeBase::Ptr>& attributes, UInt capacity = 64,
+			const std::vector<Real>& deadbands = {});
+
+		/// Number of exported attributes
+		UInt size() const { return static_cast<UInt>(mAttributes.size()); }
+		/// Type of the exported attribute
+		Kind kind(UInt index) const { return mKinds[index]; }
+		/// Position of the first value of the export in Slot::values
+		UInt offset(UInt index) const { return mOffsets[index]; }
+		/// Number of values of the export in Slot::values, 0 for Kind::Bytes and Kind::Other
+		UInt width(UInt index) const { return mWidths[index]; }
+
+		/// Snapshots all attributes into the next free slot. Blocks only if the
+		/// consumer is behind by the full capacity of the ring. If due is given,
+		/// only the marked attributes outside of their deadband are updated and
+		/// the others keep their last value. Returns false without filling a
+		/// slot if no attribute was updated.
+		Bool push(UInt sequenceId, Real time = 0, const std::vector<bool>* due = nullptr);
+		/// Enqueues a slot telling the consumer to stop
+		void pushClose();
+
+		/// Waits for filled slots and returns the newest one, releasing the
+		/// older ones. Returns nullptr if only a close slot was pending.
+		/// Sets closed if a close slot was dequeued. If newest is not set,
+		/// the slots are returned one by one in the order they were filled.
+		const Slot* acquire(Bool& closed, Bool newest = true);
+		/// Like acquire(), but returns nullptr right away if no slot is filled
+		const Slot* tryAcquire(Bool& closed, Bool newest = true);
+		/// Returns the slot of the last acquire() to the producer
+		void release();
+
+		Real real(const Slot& slot, UInt index) const { return slot.values[mOffsets[index]]; }
+		Int integer(const Slot& slot, UInt index) const { return static_cast<Int>(slot.values[mOffsets[index]]); }
+		Bool boolean(const Slot& slot, UInt index) const { return slot.values[mOffsets[index]] != 0; }
+		Complex complex(const Slot& slot, UInt index) const {
+			return { slot.values[mOffsets[index]], slot.values[mOffsets[index] + 1] };
+		}
+		/// Elements of a Kind::Vector export in column-major order, see width()
+		const Real* vector(const Slot& slot, UInt index) const { return &slot.values[mOffsets[index]]; }
+		/// Serialized value of a Kind::Bytes export, see `AttributeBase::deserializeFrom`
+		const unsigned char* bytes(const Slot& slot, UInt index) const { return &slot.bytes[mOffsets[index]]; }
+		/// Number of bytes of a Kind::Bytes export
+		std::size_t byteSize(UInt index) const { return mByteSizes[index]; }
+		/// Creates an attribute holding the value of the export. This
+		/// allocates and is meant for interface workers without slot support.
+		CPS::AttributeBase::Ptr value(const Slot& slot, UInt index) const;
+		/// Bytes of the values in the slots
+		std::size_t memoryBytes() const;
+
+	private:
+		/// Reads the value of a Real, Int, Bool or Complex attribute into values
+		void read(UInt index, Real* values) const;
+		/// Whether the current value differs from the last one by more than the deadband
+		Bool changed(UInt index);
+		/// Takes the dequeued slot and, if newest is set, the newer filled ones
+		const Slot* take(UInt index, Bool& closed, Bool newest);
+
+		std::vector<CPS::AttributeBase::Ptr> mAttributes;
+		std::vector<Real> mDeadbands;
+		std::vector<Kind> mKinds;
+		/// Position of each attribute in Slot::values, Slot::bytes or Slot::others
+		std::vector<UInt> mOffsets;
+		/// Number of values of each attribute in Slot::values
+		std::vector<UInt> mWidths;
+		/// Rows and columns of the Kind::Vector attributes, fixed when the ring is created
+		std::vector<std::pair<Matrix::Index, Matrix::Index>> mShapes;
+		/// Size of the serialized values, fixed when the ring is created
+		std::vector<std::size_t> mByteSizes;
+		/// Copies of the Kind::Bytes attributes taken when the ring is created,
+		/// which the consumer can clone without reading the live attributes
+		std::vector<CPS::AttributeBase::Ptr> mPrototypes;
+		std::vector<Slot> mSlots;
+		/// Last values of all attributes, copied into every filled slot
+		Slot mLast;
+		/// Scratch buffer for the current value of one attribute
+		std::vector<Real> mCurrent;
+		Bool mHasLast = false;
+		/// Indices of the slots the producer may fill
+		moodycamel::BlockingReaderWriterCircularBuffer<UInt> mFree;
+		/// Indices of the filled slots in order
+		moodycamel::BlockingReaderWriterCircularBuffer<UInt> mFilled;
+		/// Slot held by the consumer between acquire() and release()
+		Int mHeld = -1;
+	};
+}
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Logger.h>
+
+namespace DPsim {
+	/// \brief Solve step generated for a fixed system matrix, compiled and loaded at runtime
+	///
+	/// The system matrix is ordered with AMD and factorized once with partial
+	/// pivoting. The assembly of the right side vector from the stamps of the
+	/// components and the forward and backward substitutions are emitted as C
+	/// code with the rows, permutations and factor values as literals, so that
+	/// the step has no loops over index arrays and no branches. The code is
+	/// compiled with the C compiler given by the CC environment variable, cc by
+	/// default, which is split at whitespace and run directly without a shell,
+	/// and loaded with dlopen like the solver plugins. Libraries are cached
+	/// with their source in the private directory dpsim-codegen of
+	/// XDG_CACHE_HOME or ~/.cache, so repeated runs of the same model do not
+	/// compile again. A cached library is only loaded if the directory and
+	/// files are owned by the user, not writable by others, and the cached
+	/// source equals the generated code.
+	class GeneratedStep {
+	public:
+		/// Row of the stamp of a component that is added to the right side vector
+		struct Scatter {
+			UInt stamp;
+			UInt row;
+		};
+
+		GeneratedStep(CPS::Logger::Log log) : mSLog(log) { }
+		~GeneratedStep();
+
+		/// Generates, compiles and loads the step for the system matrix. The
+		/// scattered rows are added first, then the dense stamps with the
+		/// indices after the scattered ones. Throws if the compilation fails
+		/// or the matrix is singular.
+		void generate(const SparseMatrix& systemMatrix, const std::vector<Scatter>& scatter, UInt numStamps, UInt numDenseStamps);
+
+		/// Assembles the right side vector from the stamps and solves the system
+		void step(const double* const* stamps, double* rightSide, double* leftSide) const {
+			mStep(stamps, rightSide, leftSide);
+		}
+
+		/// Number of multiply-adds of the substitutions
+		UInt numTerms() const { return mNumTerms; }
+		/// Systems of more rows are not generated, as the dense factorization and the code grow quadratically
+		static constexpr UInt MaxRows = 4000;
+
+	private:
+		typedef void (*StepFunction)(const double* const*, double*, double*);
+
+		/// Emits the C code of the step
+		String emit(const SparseMatrix& systemMatrix, const std::vector<Scatter>& scatter, UInt numStamps, UInt numDenseStamps);
+		/// Compiles the code into a library unless it is cached and loads it
+		void load(const String& code);
+
+		CPS::Logger::Log mSLog;
+		void* mDlHandle = nullptr;
+		StepFunction mStep = nullptr;
+		UInt mNumTerms = 0;
+	};
+}
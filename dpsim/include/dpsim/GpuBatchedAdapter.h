@@ -0,0 +1,73 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/BatchedLinearSolver.h>
+
+#include <cuda_runtime.h>
+#include <cublas_v2.h>
+
+namespace DPsim
+{
+    /// Batched linear solver factorizing and solving all systems of the batch
+    /// with one batched LU kernel call each
+    class GpuBatchedAdapter : public BatchedLinearSolver
+    {
+        protected:
+
+        // #### Attributes required for GPU ####
+        /// Blas-Handle
+        cublasHandle_t mCublasHandle = nullptr;
+        /// Stream
+        cudaStream_t mStream = nullptr;
+
+        /// Batch data on the device
+        struct GpuData {
+            /// Contiguous copies of the system matrices
+            double *matrices;
+            /// Pointers to the system matrices
+            double **matrixPointers;
+            /// Contiguous right and left hand side vectors
+            double *vectors;
+            /// Pointers to the vectors
+            double **vectorPointers;
+            /// Pivoting-Sequences
+            int *pivSeq;
+            /// Errorinfo per system
+            int *errInfo;
+            /// Number of systems the device memory can hold
+            UInt systems;
+        } mDeviceCopy;
+
+        /// Pinned host buffer for the right and left hand side vectors of the batch
+        double *mPinnedVectors = nullptr;
+        /// Host copy of the error info of the factorization
+        std::vector<int> mErrInfo;
+
+        void allocateDeviceMemory();
+
+        void freeDeviceMemory();
+
+        /// Factorizes all systems of the batch, as the factors of unchanged
+        /// systems are overwritten in place when the batch is uploaded again
+        void factorize() override;
+
+        /// Solves all systems of the batch with one batched kernel call
+        void solveBatch() override;
+
+        public:
+        /// Constructor with logging
+        GpuBatchedAdapter(CPS::Logger::Log log = CPS::Logger::get("GpuBatchedAdapter", CPS::Logger::Level::info));
+
+        /// Destructor
+        virtual ~GpuBatchedAdapter();
+    };
+}
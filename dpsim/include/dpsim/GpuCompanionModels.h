@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <dpsim/GpuSparseAdapter.h>
+#include <dpsim/Cuda/CompanionModelKernels.h>
+#include <dpsim-models/EMT/EMT_CompanionModelBatch.h>
+
+namespace DPsim {
+	/// \brief Trapezoidal companion models of EMT inductors and capacitors kept on the device
+	///
+	/// Executes the steps of the CompanionModelBatch tasks as kernels on the
+	/// stream of the sparse GPU solve. The equivalent current sources are added
+	/// to the right side vector and the voltages and currents are updated from
+	/// the solution on the device, so that the state of the models is not
+	/// transferred in each step. The interface voltages and currents of the
+	/// components are only written in the steps they are copied back in.
+	template <int NumPhases>
+	class GpuCompanionModels : public GpuSparseAdapter::DeviceStep {
+	public:
+		/// The components have to implement CompanionModelBatch<NumPhases>::Provider
+		GpuCompanionModels(const std::vector<CPS::MNASimPowerComp<Real>*>& comps);
+		~GpuCompanionModels();
+
+		/// Copies the coefficients, node rows and interface values of the components to the device
+		void upload() override;
+		/// Writes the values on the device into the interface attributes and equivalent currents
+		void download() override;
+
+		void preSolve(double* rightSide, const int* permutation, cudaStream_t stream) override;
+		void postSolve(const double* leftSide, Bool copyBack, cudaStream_t stream) override;
+
+		/// Number of components
+		UInt size() const { return static_cast<UInt>(mComps.size()); }
+
+	private:
+		cuda::CompanionModelArrays arrays() const;
+
+		std::vector<CPS::MNASimPowerComp<Real>*> mComps;
+		std::vector<std::shared_ptr<Matrix>> mIntfVoltage;
+		std::vector<std::shared_ptr<Matrix>> mIntfCurrent;
+		std::vector<Real*> mEquivCurrent;
+
+		cuda::Vector<double> mEquivCond = 0;
+		cuda::Vector<double> mVoltageCoeff = 0;
+		cuda::Vector<double> mCurrentCoeff = 0;
+		cuda::Vector<int> mRows0 = 0;
+		cuda::Vector<int> mRows1 = 0;
+		/// Voltages, currents and equivalent currents, in one block for one transfer
+		cuda::Vector<double> mStates = 0;
+
+		/// Pinned host copy of the states
+		double* mPinnedStates = nullptr;
+		/// Stream of the last steps
+		cudaStream_t mStream = nullptr;
+		/// Whether the last post step copied the states
+		Bool mCopyPending = false;
+	};
+}
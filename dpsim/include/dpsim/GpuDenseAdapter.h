@@ -44,6 +44,8 @@ namespace DPsim
 			UInt size;
 			/// Device copy of Vector
 			double *vector;
+			/// Number of right hand sides the device vector can hold
+			UInt vectorCols;
 
 			/// Device-Workspace for getrf
 			double *workSpace;
@@ -51,14 +53,66 @@ namespace DPsim
 			int *pivSeq;
 			/// Errorinfo
 			int *errInfo;
-		} mDeviceCopy;
+
+			/// Single precision copies of matrix, vector and workspace for mixed precision solves
+			float *lowPrecisionMatrix;
+			float *lowPrecisionVector;
+			UInt lowPrecisionVectorCols;
+			float *lowPrecisionWorkSpace;
+		} mDeviceCopy = {};
+
+		/// Dense host copy of the system matrix, reused between factorizations
+		Matrix mHostSystemMatrix;
+
+		// #### Attributes for mixed precision solves ####
+		/// Sparse system matrix for the double precision residuals of the refinement
+		SparseMatrix mSystemMatrix;
+		Bool mMixedPrecision = false;
+		/// Set when a mixed precision solve fell back to the double precision factorization
+		Bool mUseDoubleFactorization = false;
+
+		// #### Attributes for pinned asynchronous transfers ####
+		/// Pinned host buffer for right and left hand side vectors
+		double *mPinnedVector = nullptr;
+		/// Number of right hand sides the pinned buffer can hold
+		UInt mPinnedCols = 0;
+		/// Pinned host copy of the error info
+		int *mPinnedErrInfo = nullptr;
+		/// Captured solve sequence and its number of right hand sides
+		cudaGraph_t mSolveGraph = nullptr;
+		cudaGraphExec_t mSolveGraphExec = nullptr;
+		UInt mSolveGraphCols = 0;
 
 		void allocateDeviceMemory();
 
-		void copySystemMatrixToDevice(Matrix systemMatrix);
+		void copySystemMatrixToDevice(const Matrix& systemMatrix);
 
 		void LUfactorization();
 
+		/// Grows the device and pinned host vectors to hold the given number of right hand sides
+		void reserveRightHandSides(UInt nrhs);
+
+		/// Enqueues transfer, solve and transfer back on the solver stream
+		void enqueueSolve(UInt nrhs);
+
+		/// Releases the captured solve sequence
+		void destroySolveGraph();
+
+		/// Allocates the single precision matrix, vector and workspace
+		void allocateLowPrecisionMemory();
+
+		/// Copies the system matrix in single precision to the device and factorizes it
+		void LUfactorizationLowPrecision();
+
+		/// Factorization in the configured precision
+		void compute(SparseMatrix& systemMatrix);
+
+		/// Solves with the single precision factorization
+		Matrix solveLowPrecision(const Matrix& rightSideVector);
+
+		/// Applies the factorization precision
+		void applyConfiguration() override;
+
         public:
 		/// Constructor with logging
 		using DirectLinearSolver::DirectLinearSolver;
@@ -83,5 +137,8 @@ namespace DPsim
 
 		/// solution function for a right hand side
 		virtual Matrix solve(Matrix& rightSideVector) override;
+
+		/// solution function writing into a preallocated left hand side vector
+		virtual void solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector) override;
     };
 }
@@ -46,6 +46,8 @@ namespace DPsim
 		/// LHS-Vector
 		magma_d_matrix mHostLhsVec;
 		magma_d_matrix mDevLhsVec;
+		/// Permuted RHS-Vector on host, preallocated during factorization
+		Matrix mPermutedRhsVec;
 
 		// TODO: fix mSLog for solvers (all solvers)
 		// using Solver::mSLog;
@@ -78,5 +80,8 @@ namespace DPsim
 
 		/// solution function for a right hand side
 		virtual Matrix solve(Matrix& rightSideVector) override;
+
+		/// solution function writing into a preallocated left hand side vector
+		virtual void solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector) override;
     };
 }
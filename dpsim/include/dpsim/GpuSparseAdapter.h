@@ -36,6 +36,8 @@ namespace DPsim
 		/// Systemmatrix on Device
 		std::unique_ptr<cuda::CudaMatrix<double, int>> mSysMat = nullptr;
 		std::unique_ptr<Eigen::PermutationMatrix<Eigen::Dynamic>> mTransp = nullptr;
+		/// Row of the permuted RHS-Vector of each row on Device
+		cuda::Vector<int> mGpuPermutation = 0;
 
 		/// RHS-Vector
 		cuda::Vector<double> mGpuRhsVec = 0;
@@ -43,22 +45,74 @@ namespace DPsim
 		cuda::Vector<double> mGpuLhsVec = 0;
 		/// Intermediate Vector
 		cuda::Vector<double> mGpuIntermediateVec = 0;
+		/// Permuted RHS-Vector on host, preallocated during factorization
+		Matrix mPermutedRhsVec;
+
+		// #### Attributes for pinned asynchronous transfers ####
+		/// Stream of the transfers and triangular solves
+		cudaStream_t mStream = nullptr;
+		/// Pinned host buffer of the permuted RHS-Vector
+		double *mPinnedRhsVec = nullptr;
+		/// Pinned host buffer of the LHS-Vector
+		double *mPinnedLhsVec = nullptr;
+
+		// #### Attributes for refactorizations of the same pattern ####
+		/// Dimension the vectors are allocated for
+		size_t mDim = 0;
+		/// Pattern of the factorized system matrix before the permutation
+		std::vector<int> mRowPtr;
+		std::vector<int> mColInd;
+		/// Index of the system matrix value of each value of the permuted matrix
+		std::vector<int> mValueMap;
+		/// Host buffer of the permuted values
+		std::vector<double> mPermutedValues;
 
 		void iluPreconditioner();
 
+		/// Creates the handles, the stream and the matrix descriptors once
+		void createHandles();
+		/// Allocates the device and pinned vectors if the dimension changed
+		void allocateVectors(size_t N);
+		/// Permutes, analyzes and factorizes the system matrix
 		void performFactorization(SparseMatrix& systemMatrix);
+		/// Only copies the values and factorizes on the device if the pattern is unchanged
+		void performRefactorization(SparseMatrix& systemMatrix);
+		/// Numerical factorization of the matrix on the device, returns false on a zero pivot
+		Bool factorizeOnDevice();
+		///
+		Bool hasSamePattern(const SparseMatrix& systemMatrix) const;
 
 		private:
 		///Required shared Variables
 		cuda::Vector<char> pBuffer = 0;
+		size_t mBufferSize = 0;
+		cusparseMatDescr_t descr_M = nullptr;
 		cusparseMatDescr_t descr_L = nullptr;
 		cusparseMatDescr_t descr_U = nullptr;
+		csrilu02Info_t info_M = nullptr;
 		csrsv2Info_t info_L = nullptr;
 		csrsv2Info_t info_U = nullptr;
 
 		void checkCusparseStatus(cusparseStatus_t status, std::string additionalInfo="cuSparse Error:");
 
         public:
+		/// Part of a simulation step that is executed on the device, on the
+		/// stream of the solve, so that its state does not leave the device
+		class DeviceStep {
+		public:
+			virtual ~DeviceStep() = default;
+			/// Copies the state from the host, e.g. after the initialization
+			virtual void upload() = 0;
+			/// Writes the values copied back by the last post solve to the host,
+			/// copies the current values first if they were not copied back
+			virtual void download() = 0;
+			/// Adds to the permuted RHS-Vector, the row i is at permutation[i]
+			virtual void preSolve(double* rightSide, const int* permutation, cudaStream_t stream) = 0;
+			/// Updates from the LHS-Vector, which is not permuted. If copyBack is set,
+			/// the values needed on the host are copied asynchronously.
+			virtual void postSolve(const double* leftSide, Bool copyBack, cudaStream_t stream) = 0;
+		};
+
 		/// Constructor with logging
 		using DirectLinearSolver::DirectLinearSolver;
 
@@ -82,5 +136,16 @@ namespace DPsim
 
 		/// solution function for a right hand side
 		virtual Matrix solve(Matrix& rightSideVector) override;
+
+		/// solution function writing into a preallocated left hand side vector
+		virtual void solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector) override;
+
+		/// Solution with device steps before and after the triangular solves. The right
+		/// side vector only contains the contributions of the components on the host.
+		void solveWithDeviceSteps(const Matrix& rightSideVector, Matrix& leftSideVector,
+			const std::vector<DeviceStep*>& steps, Bool copyBack);
+
+		/// Stream of the transfers and solves, the default stream for synchronous transfers
+		cudaStream_t stream() const { return mStream; }
     };
 }
@@ -0,0 +1,50 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <hdf5.h>
+
+#include <dpsim/DataLoggerBackend.h>
+
+namespace DPsim {
+	/// \brief Writes the logged values as columns of an HDF5 file
+	///
+	/// Every column, including the time, is a one-dimensional chunked dataset
+	/// of doubles at the root of the file, named like the column. Rows are
+	/// buffered per column and appended one chunk at a time. The order of the
+	/// columns is stored in the string attribute "columns" of the root group.
+	class HDF5LoggerBackend : public DataLoggerBackend {
+	public:
+		/// Rows are buffered and written in chunks of the given number of rows
+		HDF5LoggerBackend(UInt chunkRows = 4096);
+		~HDF5LoggerBackend();
+
+		String extension() const override { return ".h5"; }
+		Bool open(const fs::path& filename) override;
+		void close() override;
+		Bool hasColumns() const override { return !mDatasets.empty(); }
+		void setColumns(const std::vector<String>& names, Notation notation) override;
+		void writeRow(Real time, const Real* values, UInt count) override;
+
+	private:
+		/// Appends the buffered rows to the datasets
+		void flush();
+
+		UInt mChunkRows;
+		hid_t mFile = H5I_INVALID_HID;
+		/// Datasets of the time and the value columns
+		std::vector<hid_t> mDatasets;
+		/// Buffered rows, one chunk per column
+		std::vector<Real> mBuffer;
+		/// Rows in the buffer
+		UInt mBufferedRows = 0;
+		/// Rows already written to the datasets
+		hsize_t mWrittenRows = 0;
+	};
+}
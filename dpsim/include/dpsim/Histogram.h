@@ -0,0 +1,93 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Logger.h>
+
+namespace DPsim {
+	/// \brief Streaming histogram of durations with constant memory
+	///
+	/// Durations are counted in logarithmic buckets of nanoseconds with linear
+	/// sub-buckets, similar to an HDR histogram, so that percentiles have a
+	/// relative error below 1/64. Count, sum, minimum and maximum are exact.
+	/// There must only be one recording thread, but other threads may query the
+	/// histogram at any time and see a consistent state up to the last few samples.
+	class Histogram {
+	public:
+		/// Number of sub-buckets per power of two as a power of two
+		static constexpr UInt SubBucketBits = 6;
+		static constexpr UInt SubBuckets = 1 << SubBucketBits;
+		/// Number of powers of two above the linear range, covering about 20 hours
+		static constexpr UInt Magnitudes = 40;
+		/// Total number of buckets
+		static constexpr UInt Buckets = 2 * SubBuckets + (Magnitudes - 1) * SubBuckets;
+
+		Histogram() { reset(); }
+
+		/// Adds a duration in seconds
+		void record(Real seconds) {
+			Real ns = seconds * 1e9;
+			uint64_t value = ns > 0 ? static_cast<uint64_t>(ns + 0.5) : 0;
+			auto& bucket = mCounts[bucketIndex(value)];
+			bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+			mSum.store(mSum.load(std::memory_order_relaxed) + seconds, std::memory_order_relaxed);
+			if (seconds < mMin.load(std::memory_order_relaxed))
+				mMin.store(seconds, std::memory_order_relaxed);
+			if (seconds > mMax.load(std::memory_order_relaxed))
+				mMax.store(seconds, std::memory_order_relaxed);
+			mCount.store(mCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+		/// Discards all samples
+		void reset();
+
+		// #### Getter ####
+		uint64_t count() const { return mCount.load(std::memory_order_acquire); }
+		Real sum() const { return mSum.load(std::memory_order_relaxed); }
+		Real mean() const;
+		/// Smallest sample, zero without samples
+		Real min() const;
+		/// Largest sample, zero without samples
+		Real max() const;
+		/// Upper bound of the bucket containing the given percentile in [0, 100]
+		Real percentile(Real percent) const;
+		/// Upper bound in seconds and number of samples of all non-empty buckets
+		std::vector<std::pair<Real, uint64_t>> buckets() const;
+
+		/// Logs count, mean, maximum and the main percentiles under the given title
+		void log(CPS::Logger::Log log, const String& title) const;
+
+	private:
+		static UInt bucketIndex(uint64_t value) {
+			if (value < 2 * SubBuckets)
+				return static_cast<UInt>(value);
+			UInt msb = 63 - static_cast<UInt>(__builtin_clzll(value));
+			UInt shift = msb - SubBucketBits;
+			if (shift >= Magnitudes)
+				return Buckets - 1;
+			return 2 * SubBuckets + (shift - 1) * SubBuckets + static_cast<UInt>((value >> shift) - SubBuckets);
+		}
+		/// Largest value in nanoseconds counted in the given bucket
+		static uint64_t bucketUpperBound(UInt index);
+
+		std::array<std::atomic<uint64_t>, Buckets> mCounts;
+		std::atomic<uint64_t> mCount;
+		std::atomic<Real> mSum;
+		std::atomic<Real> mMin;
+		std::atomic<Real> mMax;
+	};
+}
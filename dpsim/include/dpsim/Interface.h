@@ -8,7 +8,8 @@
 #include <dpsim/Config.h>
 #include <dpsim/Definitions.h>
 #include <dpsim/Scheduler.h>
-#include <dpsim/Interface.h>
+#include <dpsim/ExportRing.h>
+#include <dpsim/InterfaceRecorder.h>
 #include <dpsim-models/Attribute.h>
 #include <dpsim-models/Task.h>
 
@@ -17,6 +18,7 @@
 namespace DPsim {
 
 	class InterfaceWorker;
+	class InterfaceGroup;
 
 	class Interface :
 		public SharedFactory<Interface> {
@@ -40,20 +42,64 @@ namespace DPsim {
 			mInterfaceWorker(intf),
 			mName(name),
 			mDownsampling(downsampling) {
-				mQueueDpsimToInterface = std::make_shared<moodycamel::BlockingReaderWriterQueue<AttributePacket>>();
 				mQueueInterfaceToDpsim = std::make_shared<moodycamel::BlockingReaderWriterQueue<AttributePacket>>();
 			};
 
 		virtual void open();
 		virtual void close();
 
+		/// @brief exchange the attributes on the simulation thread instead of separate interface threads
+		/// The PreStep and PostStep tasks then call the interface worker directly, which avoids the
+		/// queues and thread handoffs. Imports are polled without blocking unless an import blocks on read.
+		/// Must be set before the simulation starts.
+		/// @param value Whether the interface runs synchronously
+		void setSynchronous(Bool value = true);
+		Bool isSynchronous() const { return mSynchronous; }
+
+		/// @brief skip the exports of the following time steps, imports are still read
+		/// Meant for non-critical interfaces like monitoring, e.g. while a real-time
+		/// simulation is short of time. Can be changed during the simulation.
+		void setExportsSuspended(Bool value) { mExportsSuspended = value; }
+		Bool exportsSuspended() const { return mExportsSuspended; }
+		/// @brief skip the imports of the following time steps, the imported attributes keep their values
+		void setImportsSuspended(Bool value) { mImportsSuspended = value; }
+		Bool importsSuspended() const { return mImportsSuspended; }
+
+		/// @brief stop waiting for blocking imports after a deadline and extrapolate them instead
+		/// If an import with blockOnRead has not been updated within the deadline after the start of
+		/// its read, Real and Complex imports are extrapolated to the current time step by a polynomial
+		/// through the values of their last updates, other imports keep their value. A late update is
+		/// applied in the following time step. Must be set before the simulation starts.
+		/// @param deadline Time in seconds to wait for the imports, 0 waits without deadline
+		/// @param order Order of the extrapolation polynomial, 0 holds the last value
+		void setImportDeadline(Real deadline, UInt order = 1);
+		/// Number of imports extrapolated because they missed the deadline
+		UInt extrapolatedImports() const { return mExtrapolatedImports; }
+
+		/// @brief record every applied import with its time step into a file
+		/// The recording can be fed back with an `InterfaceReplay` to reproduce the
+		/// imports of the run offline. Must be set before the simulation starts.
+		/// @param filename Recording file, an empty name disables the recording
+		void recordImports(const String& filename);
+
+		/// @brief run the reader and writer threads on the cores of the executor
+		/// The threads of an interface group run on the executor of its first interface.
+		/// Must be set before the simulation starts.
+		void setExecutor(Executor::Ptr executor) { mExecutor = executor; }
+
 		// Function used in the interface's simulation task to read all imported attributes from the queue
 		// Called once before every simulation timestep
-		virtual void pushDpsimAttrsToQueue();
+		// Only the exports marked due by the last exportsDue call are updated if onlyDue is set
+		virtual void pushDpsimAttrsToQueue(Real time = 0, bool onlyDue = false);
 		// Function used in the interface's simulation task to write all exported attributes to the queue
 		// Called once after every simulation timestep
 		virtual void popDpsimAttrsFromQueue(bool isSync = false);
 
+		/// Marks the imports whose rate matches the time step, returns false if there is none
+		bool importsDue(Int timeStepCount);
+		/// Marks the exports whose rate matches the time step, returns false if there is none
+		bool exportsDue(Int timeStepCount);
+
 		// Function called by the Simulation to perform interface synchronization
 		virtual void syncExports();
 		/// Function called by the Simulation to perform interface synchronization
@@ -63,6 +109,10 @@ namespace DPsim {
 
 		void setLogger(CPS::Logger::Log log);
 
+		const String& name() const { return mName; }
+		/// Bytes of the export ring and of the packets pending in the import queue
+		std::size_t memoryBytes() const;
+
 		virtual ~Interface() {
 			if (mOpened)
 				close();
@@ -83,29 +133,83 @@ namespace DPsim {
 		UInt mNextSequenceInterfaceToDpsim = 1;
 		UInt mDownsampling;
 		std::atomic<bool> mOpened;
+		Bool mSynchronous = false;
+		Bool mExportsSuspended = false;
+		Bool mImportsSuspended = false;
+		/// Time step of the imports read next, -1 before the first step
+		Int mImportStep = -1;
+		/// File name of the import recording, empty if the imports are not recorded
+		String mRecordFile;
+		/// Recorder of the imports, created when the interface is opened
+		InterfaceRecorder::Ptr mRecorder;
 		std::thread mInterfaceWriterThread;
 		std::thread mInterfaceReaderThread;
-
-		std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> mQueueDpsimToInterface;
+		/// Executor whose cores the threads run on, if any
+		Executor::Ptr mExecutor;
+		/// Group whose threads read and write this interface instead of its own threads
+		InterfaceGroup* mGroup = nullptr;
+		friend class InterfaceGroup;
+
+		/// Snapshots of the exported attributes, created when the interface is opened
+		ExportRing::Ptr mExportRing;
 		std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> mQueueInterfaceToDpsim;
-
-		virtual void addImport(CPS::AttributeBase::Ptr attr, bool blockOnRead = false, bool syncOnSimulationStart = true);
-		virtual void addExport(CPS::AttributeBase::Ptr attr);
+		/// Packets read by the simulation thread in synchronous mode
+		std::vector<AttributePacket> mImportPackets;
+
+		/// Import and export rates in time steps, by attribute ID
+		std::vector<UInt> mImportRates;
+		std::vector<UInt> mExportRates;
+		/// Minimum change of an export before it is sent again, by attribute ID
+		std::vector<Real> mExportDeadbands;
+		/// Whether the export is only sent if its attribute version changed, by attribute ID
+		std::vector<bool> mExportOnChange;
+		/// Attribute version of the export when it was last sent, by attribute ID
+		std::vector<std::size_t> mExportVersions;
+		/// Whether the attribute is updated in the current time step, by attribute ID
+		std::vector<bool> mImportDue;
+		std::vector<bool> mExportDue;
+		/// Set when opened if any export has its own rate, a deadband or is sent on change
+		bool mExportsFiltered = false;
+
+		/// Deadline of the blocking imports in seconds, 0 if they block without deadline
+		Real mImportDeadline = 0;
+		/// Order of the extrapolation of imports that missed the deadline
+		UInt mExtrapolationOrder = 1;
+		/// Time steps and values of the last updates of each Real or Complex import, newest last
+		std::vector<std::vector<std::pair<Int, Complex>>> mImportHistory;
+		UInt mExtrapolatedImports = 0;
+
+		/// Copies a received value onto the imported attribute
+		void applyImportPacket(const AttributePacket& packet);
+		/// Extrapolates the pending blocking imports from their history
+		void extrapolateImports(UInt currentSequenceId);
+		/// Whether reading has to wait for an update of the import
+		bool waitsForImport(UInt attributeId, bool isSync) const;
+
+		/// @param downsampling Rate of the import in time steps, 0 uses the rate of the interface
+		virtual void addImport(CPS::AttributeBase::Ptr attr, bool blockOnRead = false, bool syncOnSimulationStart = true, UInt downsampling = 0);
+		/// @param downsampling Rate of the export in time steps, 0 uses the rate of the interface
+		/// @param deadband Send the export only if it changed by more than this, 0 sends it at every rate step
+		/// @param onChange Send the export only if the version of the attribute changed, see `AttributeBase::version`
+		virtual void addExport(CPS::AttributeBase::Ptr attr, UInt downsampling = 0, Real deadband = 0, Bool onChange = false);
 
 	public:
 
 		class WriterThread {
 			private:
-				std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> mQueueDpsimToInterface;
+				ExportRing::Ptr mExportRing;
 				std::shared_ptr<InterfaceWorker> mInterfaceWorker;
+				bool mEverySlot;
 
 			public:
 				WriterThread(
-						std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>> queueDpsimToInterface,
-				 		std::shared_ptr<InterfaceWorker> intf
+						ExportRing::Ptr exportRing,
+				 		std::shared_ptr<InterfaceWorker> intf,
+						bool everySlot = false
 					) :
-					mQueueDpsimToInterface(queueDpsimToInterface),
-					mInterfaceWorker(intf) {};
+					mExportRing(exportRing),
+					mInterfaceWorker(intf),
+					mEverySlot(everySlot) {};
 				void operator() () const;
 		};
  
@@ -153,6 +257,7 @@ namespace DPsim {
 			}
 
 			void execute(Real time, Int timeStepCount) override;
+			Bool latencyCritical() const override { return true; }
 
 		private:
 			Interface& mIntf;
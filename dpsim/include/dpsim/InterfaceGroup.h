@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dpsim/Interface.h>
+
+namespace DPsim {
+	/// \brief One reader and one writer thread shared by several interfaces
+	///
+	/// Every interface normally runs its own reader and writer thread, so a
+	/// simulation connected to many external nodes has twice as many threads
+	/// competing with the scheduler. The interfaces of a group are read by one
+	/// thread waiting with epoll on the poll file descriptors of all their
+	/// workers, which dispatches to the interface whose descriptor became
+	/// readable. One writer thread sends the export snapshots of all interfaces
+	/// whenever the simulation announces new ones. The workers have to provide
+	/// poll file descriptors, see `InterfaceWorker::pollFds`.
+	///
+	/// The interfaces are still added to the simulation one by one. The threads
+	/// are started when the last interface of the group has been opened and are
+	/// stopped when the first one is closed. The group has to outlive the simulation.
+	class InterfaceGroup :
+		public SharedFactory<InterfaceGroup> {
+
+	public:
+		typedef std::shared_ptr<InterfaceGroup> Ptr;
+
+		InterfaceGroup() = default;
+		~InterfaceGroup();
+
+		/// Adds an interface, which must not be synchronous. Must be called before the simulation starts.
+		void addInterface(Interface::Ptr intf);
+
+		/// Called by a member interface when it has been opened
+		void memberOpened();
+		/// Called by a member interface before its worker is closed
+		void memberClosed();
+		/// Called by a member interface after it snapshotted its exports
+		void notifyExports();
+
+	private:
+		void readerLoop();
+		void writerLoop();
+		void stop();
+
+		std::vector<Interface::Ptr> mInterfaces;
+		UInt mOpenedMembers = 0;
+		std::atomic<bool> mRunning { false };
+		int mEpoll = -1;
+		std::thread mReaderThread;
+		std::thread mWriterThread;
+
+		/// Set by notifyExports, cleared by the writer thread
+		std::mutex mExportMutex;
+		std::condition_variable mExportCondition;
+		Bool mExportsPending = false;
+	};
+}
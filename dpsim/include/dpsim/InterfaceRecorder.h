@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Attribute.h>
+
+namespace DPsim {
+	/// \brief Records the imported values of an interface into a binary file
+	///
+	/// The file starts with the magic bytes "DPSIMREC", the format version, the
+	/// number of imports and the serialized size of each import. It is followed
+	/// by one record per applied import with the time step, the attribute ID,
+	/// the sequence ID and the serialized value, see `AttributeBase::serializeTo`.
+	/// Imports applied before the first time step are recorded with step -1.
+	/// The records are written by the simulation thread through a file buffer.
+	class InterfaceRecorder {
+	public:
+		typedef std::shared_ptr<InterfaceRecorder> Ptr;
+
+		static constexpr char Magic[8] = { 'D', 'P', 'S', 'I', 'M', 'R', 'E', 'C' };
+		static constexpr uint32_t Version = 1;
+
+		/// Creates the file and writes the header, the imports must have a fixed serialized size
+		InterfaceRecorder(const String& filename, const std::vector<CPS::AttributeBase::Ptr>& imports);
+		~InterfaceRecorder() { close(); }
+
+		/// Appends the value applied to an import in the given time step
+		void record(Int step, UInt attributeId, UInt sequenceId, const CPS::AttributeBase::Ptr& value);
+		/// Flushes and closes the file
+		void close();
+
+		/// Number of records written so far
+		uint64_t records() const { return mRecords; }
+
+	private:
+		std::ofstream mFile;
+		/// Serialized size of each import
+		std::vector<uint64_t> mSizes;
+		/// Buffer for one serialized value
+		std::vector<unsigned char> mBuffer;
+		uint64_t mRecords = 0;
+	};
+}
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <dpsim/Interface.h>
+
+namespace DPsim {
+	/// Interface type replaying the imports recorded by another interface with `Interface::recordImports`
+	class InterfaceReplay :
+		public Interface,
+		public SharedFactory<InterfaceReplay> {
+
+	public:
+		/// @brief create a new InterfaceReplay instance
+		/// @param filename Recording of the imports
+		/// @param realTimeStep Time step of a real-time replay, 0 replays at full speed
+		/// @param name Name of this interface. Currently only used for naming the simulation tasks
+		/// @param downsampling Only import and export attributes on every nth timestep
+		InterfaceReplay(const String& filename, Real realTimeStep = 0, const String& name = "", UInt downsampling = 1);
+
+		/// @brief configure an attribute import, in the same order as in the recorded interface
+		/// @param attr the attribute that should be updated with the replayed values
+		/// @param blockOnRead Whether the simulation should block on every import until the attribute has been updated
+		/// @param syncOnSimulationStart Whether the simulation should block before the first timestep until this attribute has been updated
+		/// @param downsampling Only import the attribute on every nth timestep, 0 uses the downsampling of the interface
+		void importAttribute(CPS::AttributeBase::Ptr attr, Bool blockOnRead = false, Bool syncOnSimulationStart = true, UInt downsampling = 0);
+
+		/// @brief configure an attribute export, which is snapshotted as usual but discarded
+		void exportAttribute(CPS::AttributeBase::Ptr attr, UInt downsampling = 0);
+
+		void popDpsimAttrsFromQueue(bool isSync = false) override;
+	};
+}
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <dpsim/Interface.h>
+
+namespace DPsim {
+	/// Interface type exchanging fixed-layout binary frames over UDP without VILLASnode, see `InterfaceWorkerUdp`
+	class InterfaceUdp :
+		public Interface,
+		public SharedFactory<InterfaceUdp> {
+
+	public:
+		/// @brief create a new InterfaceUdp instance
+		/// @param localAddress IPv4 address the imports are received on
+		/// @param localPort Port the imports are received on
+		/// @param remoteAddress IPv4 address the exports are sent to
+		/// @param remotePort Port the exports are sent to
+		/// @param name Name of this interface. Currently only used for naming the simulation tasks
+		/// @param downsampling Only import and export attributes on every nth timestep
+		InterfaceUdp(const String& localAddress, UInt localPort, const String& remoteAddress, UInt remotePort,
+			const String& name = "", UInt downsampling = 1);
+
+		/// @brief configure an attribute import, the imports take the values of a frame in the order they are added
+		/// @param attr the attribute that should be updated with the imported values
+		/// @param blockOnRead Whether the simulation should block on every import until the attribute has been updated
+		/// @param syncOnSimulationStart Whether the simulation should block before the first timestep until this attribute has been updated
+		/// @param downsampling Only import the attribute on every nth timestep, 0 uses the downsampling of the interface
+		void importAttribute(CPS::AttributeBase::Ptr attr, Bool blockOnRead = false, Bool syncOnSimulationStart = true, UInt downsampling = 0);
+
+		/// @brief configure an attribute export, the exports fill the values of a frame in the order they are added
+		/// @param attr the attribute which's value should be exported
+		/// @param downsampling Only export the attribute on every nth timestep, 0 uses the downsampling of the interface
+		/// @param deadband Only export the attribute if its value changed by more than this, 0 exports it on every downsampled timestep
+		/// @param onChange Only export the attribute if its version changed, for attributes written through `set`
+		void exportAttribute(CPS::AttributeBase::Ptr attr, UInt downsampling = 0, Real deadband = 0, Bool onChange = false);
+
+		/// @brief busy poll the device queue when receiving instead of sleeping in the kernel
+		/// Must be set before the simulation starts.
+		/// @param microseconds Busy poll time per receive, see SO_BUSY_POLL, 0 disables busy polling
+		void setBusyPoll(UInt microseconds);
+
+		/// @brief send the exports of several steps with one system call
+		/// Must be set before the simulation starts.
+		/// @param frames Number of exported steps per send, 1 sends every step on its own
+		void setSendBatch(UInt frames);
+	};
+}
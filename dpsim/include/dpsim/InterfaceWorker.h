@@ -19,6 +19,8 @@ namespace DPsim {
     protected:
         bool mOpened;
         UInt mCurrentSequenceInterfaceToDpsim = 1;
+        /// Packets passed to `writeValuesToEnv` by the default `writeSlotToEnv`
+        std::vector<Interface::AttributePacket> mSlotPackets;
     
     public:
         using Ptr = std::shared_ptr<InterfaceWorker>;
@@ -43,6 +45,37 @@ namespace DPsim {
 		 */
         virtual void writeValuesToEnv(std::vector<Interface::AttributePacket>& updatedAttrs) = 0;
 
+        /**
+         * Function that will be called on loop in its separate thread.
+         * Receives the newest snapshot of all exported attributes, the slot stays valid until the function returns.
+         * The default implementation converts the slot into attribute packets and calls `writeValuesToEnv`,
+         * workers should override it to write the values without allocating.
+         */
+        virtual void writeSlotToEnv(const ExportRing& ring, const ExportRing::Slot& slot) {
+            for (UInt i = 0; i < ring.size(); i++) {
+                mSlotPackets.push_back(Interface::AttributePacket {
+                    ring.value(slot, i),
+                    i,
+                    slot.sequenceId,
+                    Interface::AttributePacketFlags::PACKET_NO_FLAGS
+                });
+            }
+            writeValuesToEnv(mSlotPackets);
+        }
+
+        /**
+         * Whether `writeSlotToEnv` has to receive every snapshot in order, e.g. to batch several time steps.
+         * By default only the newest snapshot is passed and outdated ones are skipped.
+         */
+        virtual Bool writesEverySlot() const { return false; }
+
+        /**
+         * File descriptors that become readable when `readValuesFromEnv` has data, valid after `open`.
+         * Workers returning descriptors can share the reader thread of an `InterfaceGroup`,
+         * their `readValuesFromEnv` is then only called when one of them is readable.
+         */
+        virtual std::vector<int> pollFds() { return {}; }
+
         /**
          * Open the interface and set up the connection to the environment
          * This is guaranteed to be called before any calls to `readValuesFromEnv` and `writeValuesToEnv`
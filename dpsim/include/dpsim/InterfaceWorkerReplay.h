@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <dpsim/InterfaceWorker.h>
+
+namespace DPsim {
+	/// \brief Interface worker feeding back the imports recorded by an `InterfaceRecorder`
+	///
+	/// The whole recording is loaded when the worker is opened. By default the
+	/// records of a time step are passed on as soon as the interface announces
+	/// the step, so the simulation runs at full speed and, with a synchronous
+	/// interface, receives every import in the same step as in the recorded run.
+	/// With a real-time step, the records of step n are passed on n time steps
+	/// after the first read instead, which reproduces the arrival times of a
+	/// real-time run and is meant for interfaces with a reader thread.
+	/// Exports are discarded.
+	class InterfaceWorkerReplay :
+		public InterfaceWorker,
+		public SharedFactory<InterfaceWorkerReplay> {
+
+	public:
+		using Ptr = std::shared_ptr<InterfaceWorkerReplay>;
+
+		/// @param filename Recording written by an `InterfaceRecorder`
+		/// @param realTimeStep Time step of the real-time replay, 0 replays the steps as announced
+		InterfaceWorkerReplay(const String& filename, Real realTimeStep = 0) :
+			mFilename(filename),
+			mRealTimeStep(realTimeStep) {}
+
+		/// Sets the attribute of an import, which is used as prototype for the replayed values
+		void configureImport(UInt attributeId, CPS::AttributeBase::Ptr attr);
+		/// Announces the time step whose imports are read next, called by the simulation thread
+		void setStep(Int step) { mStep.store(step, std::memory_order_release); }
+
+		void open() override;
+		void close() override;
+		void readValuesFromEnv(std::vector<Interface::AttributePacket>& updatedAttrs) override;
+		void writeValuesToEnv(std::vector<Interface::AttributePacket>& updatedAttrs) override { updatedAttrs.clear(); }
+		void writeSlotToEnv(const ExportRing& ring, const ExportRing::Slot& slot) override {}
+
+		/// Number of records passed on so far
+		std::size_t replayedRecords() const { return mNext; }
+		/// Number of records of the recording
+		std::size_t records() const { return mRecords.size(); }
+
+	private:
+		struct Record {
+			Int step;
+			UInt attributeId;
+			UInt sequenceId;
+			/// Position of the serialized value in mData
+			std::size_t offset;
+		};
+
+		String mFilename;
+		Real mRealTimeStep;
+		/// Time step of the next import read
+		std::atomic<Int> mStep { -1 };
+		/// Prototypes of the imported attributes, by attribute ID
+		std::vector<CPS::AttributeBase::Ptr> mPrototypes;
+		/// Serialized size of each import
+		std::vector<uint64_t> mSizes;
+		std::vector<Record> mRecords;
+		std::vector<unsigned char> mData;
+		/// Index of the next record to pass on
+		std::size_t mNext = 0;
+		/// Wall time of the first read of a real-time replay
+		std::chrono::steady_clock::time_point mStart;
+		Bool mStarted = false;
+	};
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <vector>
+
+#include <dpsim/InterfaceWorker.h>
+
+namespace DPsim {
+	/// \brief Interface worker exchanging fixed-layout binary frames over UDP
+	///
+	/// Meant for tight hardware-in-the-loop loops, e.g. with FPGA-based I/O,
+	/// where the sample pools and signal lists of VILLASnode are not needed.
+	/// A frame is a `FrameHeader` followed by the values as doubles in host
+	/// byte order. Real, Int and Bool attributes take one value, Complex
+	/// attributes take two values and exported Real matrices take one value
+	/// per element in column-major order. Exported frames contain all exports in the
+	/// order they were added, received frames are mapped onto the imports in
+	/// the order they were added. Several frames are received with one
+	/// `recvmmsg` call and, if configured, sent with one `sendmmsg` call.
+	class InterfaceWorkerUdp :
+		public InterfaceWorker,
+		public SharedFactory<InterfaceWorkerUdp> {
+
+	public:
+		using Ptr = std::shared_ptr<InterfaceWorkerUdp>;
+
+		struct FrameHeader {
+			/// Sequence ID of the exported step, or of the received frame
+			uint32_t sequence;
+			/// Number of values following the header
+			uint32_t values;
+			/// Simulation time of the exported step
+			double time;
+		};
+
+		/// @param localAddress IPv4 address the socket is bound to
+		/// @param localPort Port the imports are received on
+		/// @param remoteAddress IPv4 address the exports are sent to
+		/// @param remotePort Port the exports are sent to
+		InterfaceWorkerUdp(const String& localAddress, UInt localPort, const String& remoteAddress, UInt remotePort);
+
+		/// Sets the attribute of an import, which determines the number of values it takes from a frame
+		void configureImport(UInt attributeId, CPS::AttributeBase::Ptr attr);
+		/// Busy poll the device queue for the given time in microseconds when receiving,
+		/// see SO_BUSY_POLL. The socket is then read without blocking.
+		void setBusyPoll(UInt microseconds) { mBusyPoll = microseconds; }
+		/// Send the exports of several steps with one `sendmmsg` call
+		void setSendBatch(UInt frames) { mSendBatch = frames > 0 ? frames : 1; }
+		/// Maximum number of frames received with one `recvmmsg` call
+		void setReceiveBatch(UInt frames) { mReceiveBatch = frames > 0 ? frames : 1; }
+
+		void open() override;
+		void close() override;
+		void readValuesFromEnv(std::vector<Interface::AttributePacket>& updatedAttrs) override;
+		void writeValuesToEnv(std::vector<Interface::AttributePacket>& updatedAttrs) override;
+		void writeSlotToEnv(const ExportRing& ring, const ExportRing::Slot& slot) override;
+		Bool writesEverySlot() const override { return mSendBatch > 1; }
+		std::vector<int> pollFds() override { return { mSocket }; }
+
+	private:
+		/// Sends the frames collected for the send batch
+		void flush();
+
+		String mLocalAddress;
+		UInt mLocalPort;
+		String mRemoteAddress;
+		UInt mRemotePort;
+		UInt mBusyPoll = 0;
+		UInt mSendBatch = 1;
+		UInt mReceiveBatch = 16;
+
+		int mSocket = -1;
+		sockaddr_in mRemote;
+
+		/// Prototypes and number of frame values of the imports, by attribute ID
+		std::vector<CPS::AttributeBase::Ptr> mImports;
+		std::vector<UInt> mImportValues;
+
+		/// Preallocated frames and message headers of the send batch
+		std::vector<double> mSendFrames;
+		std::vector<iovec> mSendVecs;
+		std::vector<mmsghdr> mSendMsgs;
+		std::size_t mSendFrameDoubles = 0;
+		UInt mSendPending = 0;
+
+		/// Preallocated frames and message headers of the receive batch
+		std::vector<double> mReceiveFrames;
+		std::vector<iovec> mReceiveVecs;
+		std::vector<mmsghdr> mReceiveMsgs;
+		std::size_t mReceiveFrameDoubles = 0;
+	};
+}
@@ -0,0 +1,96 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/DirectLinearSolver.h>
+
+namespace DPsim
+{
+	/// Preconditioned BiCGSTAB solver behind the direct linear solver interface
+	///
+	/// The solves start from the previous left hand side vector, so that only
+	/// a few iterations are needed when the solution changes little between
+	/// time steps. The preconditioner is an incomplete LU or the complete
+	/// sparse LU of a prior system matrix. Factorizations compute it for the
+	/// new matrix, partial refactorizations only update the matrix and keep
+	/// the preconditioner until the last solve needed more iterations than
+	/// configured. A solve which does not converge is repeated once with a
+	/// preconditioner of the current matrix.
+	class IterativeAdapter : public DirectLinearSolver
+	{
+		/// System matrix of the iterations
+		SparseMatrix mSystemMatrix;
+		/// Preconditioners, only the configured one is computed
+		Eigen::IncompleteLUT<Real> mIncompleteLU;
+		Eigen::SparseLU<CPS::SparseMatrix, Eigen::COLAMDOrdering<int> > mLU;
+		Bool mPatternAnalyzed = false;
+
+		ITERATIVE_PRECONDITIONER mPreconditioner = ITERATIVE_PRECONDITIONER::LU;
+		Real mTolerance = 1e-10;
+		UInt mMaxIterations = 100;
+		UInt mRefreshIterations = 10;
+
+		/// Solution of the last solve without given initial guess
+		Matrix mLastSolution;
+		/// Work vectors of the iterations
+		Matrix mResidual, mShadowResidual, mDirection, mPreconditioned, mProduct, mIntermediate, mCorrection, mIntermediateProduct;
+
+		/// Convergence statistics
+		UInt mNumSolves = 0;
+		UInt mNumIterations = 0;
+		UInt mMaxSolveIterations = 0;
+		UInt mLastIterations = 0;
+		UInt mNumRefreshes = 0;
+		UInt mNumFailures = 0;
+		Real mMaxResidual = 0;
+
+		/// Computes the preconditioner of the current system matrix
+		void refreshPreconditioner();
+		/// Applies the inverse of the preconditioner
+		void precondition(const Matrix& vector, Matrix& result);
+		/// BiCGSTAB iterations for one right hand side, returns false if not converged
+		Bool iterate(const Matrix& rightSideVector, Matrix& leftSideVector, UInt& iterations, Real& residual);
+
+		protected:
+		/// Applies tolerance, iteration limits and preconditioner type
+		void applyConfiguration() override;
+
+		public:
+		/// Constructor with logging
+		using DirectLinearSolver::DirectLinearSolver;
+
+		/// Destructor
+		~IterativeAdapter() override;
+
+		/// preprocessing function storing the matrix
+		void preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries) override;
+
+		/// factorization function computing the preconditioner
+		void factorize(SparseMatrix& systemMatrix) override;
+
+		/// refactorization computing the preconditioner of the new matrix
+		void refactorize(SparseMatrix& systemMatrix) override;
+
+		/// partial refactorization keeping the preconditioner while it is effective
+		void partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries) override;
+
+		/// solution function for a right hand side, starting from the last solution
+		Matrix solve(Matrix& rightSideVector) override;
+
+		/// solution function starting from the left hand side vector if its dimensions match
+		void solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector) override;
+
+		/// logs the iteration counts and preconditioner refreshes
+		void logStatistics() override;
+	};
+}
@@ -40,7 +40,8 @@ namespace DPsim
 		/// KLU-specific structs
         klu_common mCommon;
 		klu_numeric* mNumeric = nullptr;
-		klu_symbolic* mSymbolic = nullptr;
+		/// Symbolic analysis, possibly shared with adapters of matrices with the same pattern
+		std::shared_ptr<klu_symbolic> mSymbolic;
 
 		/// Flags to indicate mode of operation
 		/// Define which ordering to choose in preprocessing
@@ -52,6 +53,9 @@ namespace DPsim
 		/// Temporary value to store the number of nonzeros
 		Int nnz;
 
+		/// Number of refactorizations with a too small pivot
+		UInt mPivotFaults = 0;
+
     public:
 		/// Destructor
 		~KLUAdapter() override;
@@ -74,9 +78,21 @@ namespace DPsim
 		/// partial refactorization withouth partial pivoting
 		void partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries) override;
 
+		/// shares the symbolic analysis of another KLU adapter without varying entries
+		Bool adoptSymbolicAnalysis(const DirectLinearSolver& analyzed, SparseMatrix& systemMatrix) override;
+
 		/// solution function for a right hand side
 		Matrix solve(Matrix& rightSideVector) override;
 
+		/// solution function writing into a preallocated left hand side vector
+		void solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector) override;
+
+		/// number of refactorizations that fell back to a factorization with pivoting
+		UInt pivotFaults() const override { return mPivotFaults; }
+
+		/// bytes allocated by KLU for the symbolic and numeric factorization
+		std::size_t memoryBytes() const override;
+
 		protected:
 
 		/// Function to print matrix in MatrixMarket's coo format
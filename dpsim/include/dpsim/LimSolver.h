@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Solver.h>
+#include <dpsim/Scheduler.h>
+#include <dpsim-models/SimPowerComp.h>
+#include <dpsim-models/SimSignalComp.h>
+#include <dpsim-models/Solver/MNAInterface.h>
+#include <dpsim-models/SystemTopology.h>
+
+namespace DPsim {
+	/// \brief Explicit EMT solver using the latency insertion method (LIM)
+	///
+	/// Every node phase, called a point, has a shunt capacitance and conductance
+	/// to ground and every branch a series inductance and resistance. The
+	/// branch currents at half steps and the point voltages at full steps are
+	/// updated alternately (leapfrog), with the resistances and conductances
+	/// averaged over the step,
+	///
+	///   (L/dt)(i' - i) + R (i' + i)/2 = v_p - v_q
+	///   (C/dt)(v' - v) + G (v' + v)/2 = h + sum of the branch currents into the point,
+	///
+	/// so each update only reads values of the previous half step and all
+	/// branches, and then all points, are updated in parallel without a
+	/// linear solve. A resistor in series with an inductor over an internal
+	/// point without other elements, like in the PiLine and RxLine, forms one
+	/// branch. Branches without inductance and points without capacitance
+	/// get a fictitious one, the latency factor times the time step times their
+	/// resistance respectively admittance, which adds a lag of about that
+	/// many steps.
+	///
+	/// Supported are the EMT resistors, inductors, capacitors to ground and
+	/// current and voltage sources of one and three phases, and composite
+	/// components consisting of them. Three-phase parameters have to be
+	/// diagonal. A voltage source needs a grounded terminal and fixes the
+	/// voltage of the other one. Switches and nonlinear components are not
+	/// supported.
+	class LimSolver : public Solver {
+	public:
+		typedef std::shared_ptr<LimSolver> Ptr;
+
+		LimSolver(String name, CPS::SystemTopology system, Real timeStep,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		/// Multiple of the time step used for the fictitious inductances and capacitances
+		void setLatencyFactor(Real factor) { mLatencyFactor = factor; }
+
+		/// Assigns the points, builds the branches and initializes the components
+		void initialize() override;
+		///
+		CPS::Task::List getTasks() override;
+		///
+		CPS::AttributeBase::Map stateAttributes() override;
+
+		// #### Getter ####
+		UInt numPoints() const { return mNumPoints; }
+		UInt numBranches() const { return static_cast<UInt>(mBranchPoints.size()); }
+		/// Voltages of all points
+		const Matrix& pointVoltages() const { return **mPointVoltages; }
+
+		class SolveTask : public CPS::Task {
+		public:
+			SolveTask(LimSolver& solver);
+
+			void execute(Real time, Int timeStepCount);
+
+		private:
+			LimSolver& mSolver;
+		};
+
+	protected:
+		enum class ElementType { Resistor, Inductor, Capacitor, CurrentSource, VoltageSource };
+
+		/// Leaf component mapped to the points and branches
+		struct Element {
+			CPS::SimPowerComp<Real>::Ptr comp;
+			ElementType type;
+			/// Points of terminal 1 and terminal 0 of each phase, -1 for ground
+			std::vector<Int> points1;
+			std::vector<Int> points0;
+			/// Resistance, inductance or capacitance of each phase
+			std::vector<Real> values;
+			/// Branch of each phase of series elements, -1 otherwise
+			std::vector<Int> branches;
+			/// Sign of the branch current in the direction from terminal 1 to terminal 0
+			std::vector<Real> signs;
+		};
+
+		/// Internal point of a merged branch, whose voltage is the one of the
+		/// previous point on the branch minus the drop over the element between them
+		struct InternalPoint {
+			UInt point;
+			Int from;
+			UInt branch;
+			Real resistance;
+			Real inductance;
+		};
+
+		/// Collects the nodes and components and assigns the points
+		void identifyTopologyObjects();
+		/// Adds the virtual nodes of a component and its subcomponents
+		void collectVirtualNodes(CPS::SimPowerComp<Real>::Ptr comp);
+		/// Adds the leaf components of a component, recursing into subcomponents
+		void addComponent(CPS::SimPowerComp<Real>::Ptr comp);
+		/// Builds the branches, merging series resistors and inductors
+		void createBranches();
+		/// Computes the update coefficients including the fictitious values
+		void computeCoefficients();
+		/// Sets the point voltages and branch currents from the initialized components
+		void initializeState();
+		/// Runs one leapfrog step and writes the results to the nodes and components
+		void solve(Real time, Int timeStepCount);
+		/// Writes the point voltages to the nodes and the interface values to the components
+		void updateComponents(const Matrix& previousVoltages);
+
+		/// Parameter of a phase, the diagonal element for three phases
+		Real phaseValue(const Matrix& value, UInt phase, const String& name) const;
+		/// Point of the phase of a node, -1 for ground
+		Int point(CPS::SimNode<Real>::Ptr node, UInt phase) const;
+
+		CPS::SystemTopology mSystem;
+		/// Multiple of the time step of the fictitious values
+		Real mLatencyFactor = 1;
+
+		/// Network and virtual nodes with points, ordered by their first point
+		CPS::SimNode<Real>::List mNodes;
+		/// Virtual nodes of the voltage sources, whose indices follow the points
+		CPS::SimNode<Real>::List mSourceNodes;
+		UInt mNumPoints = 0;
+		UInt mNumIndices = 0;
+		std::vector<Element> mElements;
+		/// Components with subcomponents, which only get the voltage between their terminals
+		CPS::SimPowerComp<Real>::List mComposites;
+		CPS::SimSignalComp::List mSignalComps;
+		/// Sources updated by their pre-step
+		CPS::MNAInterface::List mSources;
+		/// Right vector of the sources, only sized for their stamps
+		CPS::Attribute<Matrix>::Ptr mSourceVector;
+
+		/// Points of the branches, the current flows from the first to the second one
+		std::vector<std::pair<Int, Int>> mBranchPoints;
+		std::vector<Real> mBranchResistance;
+		std::vector<Real> mBranchInductance;
+		Matrix mBranchA;
+		Matrix mBranchB;
+		/// Branch currents at the half steps
+		CPS::Attribute<Matrix>::Ptr mBranchCurrents;
+		Matrix mPreviousCurrents;
+
+		/// Conductance and capacitance of the points to ground
+		Matrix mPointConductance;
+		Matrix mPointCapacitance;
+		Matrix mPointA;
+		Matrix mPointB;
+		/// Point voltages at the full steps
+		CPS::Attribute<Matrix>::Ptr mPointVoltages;
+		/// Injected currents of the current sources
+		Matrix mInjection;
+		/// Branches of each point, encoded as branch + 1 entering and -(branch + 1) leaving
+		std::vector<UInt> mIncidenceStart;
+		std::vector<Int> mIncidence;
+		/// Voltage source element of each point fixed by one, -1 otherwise
+		std::vector<Int> mFixedBy;
+		std::vector<InternalPoint> mInternalPoints;
+	};
+}
@@ -17,9 +17,11 @@
 #include <dpsim/Config.h>
 #include <dpsim/Solver.h>
 #include <dpsim/DataLogger.h>
+#include <dpsim/Histogram.h>
 #include <dpsim-models/AttributeList.h>
 #include <dpsim-models/Solver/MNASwitchInterface.h>
 #include <dpsim-models/Solver/MNAVariableCompInterface.h>
+#include <dpsim-models/Solver/MNAIterativeCompInterface.h>
 #include <dpsim-models/SimSignalComp.h>
 #include <dpsim-models/SimPowerComp.h>
 
@@ -80,6 +82,25 @@ namespace DPsim {
 		Matrix mRightSideVector;
 		/// List of all right side vector contributions
 		std::vector<const Matrix*> mRightVectorStamps;
+		/// Precomputed (stamp, row) pairs for sparse assembly of the right side vector
+		std::vector<std::pair<const Matrix*, UInt>> mRightVectorScatter;
+		/// Right side vector contributions without known rows, summed up densely
+		std::vector<const Matrix*> mRightVectorDenseStamps;
+		/// Voltage attributes of the network nodes
+		std::vector<typename CPS::Attribute<CPS::MatrixVar<VarType>>::Ptr> mNodeVoltages;
+		/// Entry of the node voltages read from the solution vector
+		struct NodeVoltageEntry {
+			/// Index of the node in mNodeVoltages
+			UInt node;
+			/// Row and column in the node voltage
+			UInt row, col;
+			/// Rows of the real and imaginary part in the solution vector
+			Matrix::Index realRow, imagRow;
+		};
+		/// Precomputed gather of all network node voltages, ordered by node
+		std::vector<NodeVoltageEntry> mNodeVoltageGather;
+		/// Solution vector rows of the observed node voltages and their rows in the observed values
+		std::vector<std::pair<Matrix::Index, Matrix::Index>> mObservedGather;
 
 		// #### MNA specific attributes related to harmonics / additional frequencies ####
 		/// Source vector of known quantities
@@ -93,6 +114,14 @@ namespace DPsim {
 		CPS::MNAVariableCompInterface::List mVariableComps;
 		/// List of variable components if they must be accessed as MNAInterface objects
 		CPS::MNAInterface::List mMNAIntfVariableComps;
+		/// List of components that correct their right side vector contribution after each solve
+		CPS::MNAIterativeCompInterface::List mIterativeComps;
+
+		// #### Event interpolation ####
+		/// Power components whose interface voltage and current are interpolated
+		typename CPS::SimPowerComp<VarType>::List mInterpolatedComps;
+		/// State saved by saveState()
+		Matrix mSavedState;
 
 		// #### Attributes related to switching ####
 		/// Index of the next switching event
@@ -109,13 +138,15 @@ namespace DPsim {
 		std::shared_ptr<DataLogger> mLeftVectorLog;
 		/// Right side vector logger
 		std::shared_ptr<DataLogger> mRightVectorLog;
+		/// Left side vector logger of each frequency in frequency parallel mode
+		std::vector<std::shared_ptr<DataLogger>> mLeftVectorHarmLogs;
 
 		/// LU factorization measurements
-		std::vector<Real> mFactorizeTimes;
+		Histogram mFactorizeTimes;
 		/// Right-hand side solution measurements
-		std::vector<Real> mSolveTimes;
+		Histogram mSolveTimes;
 		/// LU refactorization measurements
-		std::vector<Real> mRecomputationTimes;
+		Histogram mRecomputationTimes;
 
 		/// Constructor should not be called by users but by Simulation
 		MnaSolver(String name,
@@ -134,16 +165,44 @@ namespace DPsim {
 		void initializeSystemWithVariableMatrix();
 		/// Identify Nodes and SimPowerComps and SimSignalComps
 		void identifyTopologyObjects();
-		/// Assign simulation node index according to index in the vector.
+		/// Adds the component to the lists of its kind
+		void identifyComponent(CPS::IdentifiedObject::Ptr comp);
+		/// Removes the component from the system and the lists of its kind
+		void forgetComponent(CPS::IdentifiedObject::Ptr comp);
+		/// Assign simulation node index according to index in the vector
+		/// or, with matrix node reordering, to the position in the node order.
 		void assignMatrixNodeIndices();
+		/// Reverse Cuthill-McKee order of the nodes in the graph of the
+		/// component connections, including the virtual nodes
+		std::vector<UInt> computeNodeOrder();
 		/// Collects virtual nodes inside components.
 		/// The MNA algorithm handles these nodes in the same way as network nodes.
 		void collectVirtualNodes();
 		// TODO: check if this works with AC sources
 		void steadyStateInitialization();
+		/// Solution vector and interface voltages and currents of the power components
+		/// in one real vector, which is the state extrapolated during steady-state initialization
+		Matrix steadyStateInitializationState();
+		/// Writes back a state in the layout of steadyStateInitializationState()
+		void setSteadyStateInitializationState(const Matrix& state);
+		/// Solution vector and interface voltages and currents of the power
+		/// components, their subcomponents and the switches
+		Matrix interpolationState();
+		/// Writes back a state in the layout of interpolationState()
+		void setInterpolationState(const Matrix& state);
 
 		/// Create left and right side vector
 		void createEmptyVectors();
+		/// Registers the right vector stamp of a component and its rows for sparse assembly
+		void collectRightVectorStamp(CPS::MNAInterface::Ptr comp);
+		/// Sums up the component stamps (computed by the pre-step tasks) into the right side vector
+		void assembleRightSideVector();
+		/// Precomputes the solution vector rows of all network node voltages
+		void collectNodeVoltageGather();
+		/// Updates the voltages of all network nodes from the solution vector in one pass
+		void updateNodeVoltages();
+		/// Copies the observed node voltages from the solution vector
+		void updateObservedValues();
 		/// Create system matrix
 		virtual void createEmptySystemMatrix() = 0;
 		/// Sets all entries in the matrix with the given switch index to zero
@@ -152,10 +211,15 @@ namespace DPsim {
 		virtual void switchedMatrixEmpty(std::size_t swIdx, Int freqIdx) = 0;
 		/// Applies a component stamp to the matrix with the given switch index
 		virtual void switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) = 0;
+		/// Makes the factorized matrix with the given switch index available, building it on first use
+		virtual void switchedMatrixRequest(std::size_t index) = 0;
 		/// Applies a component and switch stamp to the matrix with the given switch index
 		virtual void switchedMatrixStamp(std::size_t swIdx, Int freqIdx, CPS::MNAInterface::List& components, CPS::MNASwitchInterface::List& switches) { }
 		/// Checks whether the status of variable MNA elements have changed
 		Bool hasVariableComponentChanged();
+		/// Lets the iterative components correct their right side vector contributions
+		/// with the latest solution, returns true if all of them converged
+		Bool correctIterativeComponents();
 
 		// #### Methods to implement for system recomputation over time ####
 		/// Stamps components into the variable system matrix
@@ -170,10 +234,14 @@ namespace DPsim {
 
 		/// Create a solve task for this solver implementation
 		virtual std::shared_ptr<CPS::Task> createSolveTask() = 0;
+		/// Create the tasks solving the system during the simulation
+		virtual CPS::Task::List createSolveTasks() { return { createSolveTask() }; }
 		/// Create a solve task for this solver implementation
 		virtual std::shared_ptr<CPS::Task> createLogTask() = 0;
 		/// Create a solve task for this solver implementation
 		virtual std::shared_ptr<CPS::Task> createSolveTaskHarm(UInt freqIdx) = 0;
+		/// Create a logging task for the solution of one frequency
+		virtual std::shared_ptr<CPS::Task> createLogTaskHarm(UInt freqIdx) = 0;
 
 		// #### Scheduler Task Methods ####
 		/// Solves system for single frequency
@@ -182,6 +250,8 @@ namespace DPsim {
 		virtual void solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx) = 0;
 		/// Logs left and right vector
 		virtual void log(Real time, Int timeStepCount) override;
+		/// Logs the left vector of one frequency in frequency parallel mode
+		void logHarm(Real time, Int timeStepCount, UInt freqIdx);
 
 	public:
 		/// Solution vector of unknown quantities
@@ -205,9 +275,31 @@ namespace DPsim {
 		///
 		Matrix& leftSideVector() { return **mLeftSideVector; }
 		///
+		const Matrix* solution() const override { return mLeftSideVector.getPtr() ? &mLeftSideVector->get() : nullptr; }
+		///
+		Bool supportsStateInterpolation() override;
+		///
+		void saveState() override { mSavedState = interpolationState(); }
+		///
+		void interpolateState(Real weight) override;
+		///
 		Matrix& rightSideVector() { return mRightSideVector; }
+		/// Durations of the LU factorizations
+		const Histogram& factorizeTimes() const { return mFactorizeTimes; }
+		/// Durations of the solves
+		const Histogram& solveTimes() const { return mSolveTimes; }
+		/// Durations of the refactorizations
+		const Histogram& recomputationTimes() const { return mRecomputationTimes; }
 		///
 		virtual CPS::Task::List getTasks() override;
+		/// Left and right side vector loggers
+		std::vector<std::shared_ptr<DataLogger>> dataLoggers() override {
+			std::vector<std::shared_ptr<DataLogger>> loggers = { mLeftVectorLog, mRightVectorLog };
+			loggers.insert(loggers.end(), mLeftVectorHarmLogs.begin(), mLeftVectorHarmLogs.end());
+			return loggers;
+		}
+		/// Solution vectors, the right side vector is assembled again in every step
+		CPS::AttributeBase::Map stateAttributes() override;
 
 	};
 }
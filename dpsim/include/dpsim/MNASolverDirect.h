@@ -8,27 +8,41 @@
 
 #pragma once
 
+#include <atomic>
 #include <iostream>
 #include <vector>
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <bitset>
+#include <future>
 #include <memory>
+#include <mutex>
 
 #include <dpsim/Config.h>
+#include <dpsim/Checkpoint.h>
 #include <dpsim/Solver.h>
+#include <dpsim/BlockTriangularForm.h>
 #include <dpsim/DataLogger.h>
 #include <dpsim/DirectLinearSolver.h>
 #include <dpsim/DirectLinearSolverConfiguration.h>
 #include <dpsim/DenseLUAdapter.h>
+#include <dpsim/DenseInverseAdapter.h>
 #ifdef WITH_KLU
 #include <dpsim/KLUAdapter.h>
 #endif
 #include <dpsim/SparseLUAdapter.h>
+#include <dpsim/ParallelSparseLUAdapter.h>
+#include <dpsim/ComplexSparseLUAdapter.h>
+#include <dpsim/IterativeAdapter.h>
+#ifdef WITH_MNASOLVERPLUGIN
+#include <dpsim/GeneratedStep.h>
+#endif
 #ifdef WITH_CUDA
 #include <dpsim/GpuDenseAdapter.h>
 #ifdef WITH_CUDA_SPARSE
 #include <dpsim/GpuSparseAdapter.h>
+#include <dpsim/GpuCompanionModels.h>
 #endif
 #ifdef WITH_MAGMA
 #include <dpsim/GpuMagmaAdapter.h>
@@ -37,6 +51,8 @@
 #include <dpsim-models/AttributeList.h>
 #include <dpsim-models/Solver/MNASwitchInterface.h>
 #include <dpsim-models/Solver/MNAVariableCompInterface.h>
+#include <dpsim-models/Solver/MNAVariableTimeStepInterface.h>
+#include <dpsim-models/Solver/MNAVariableFrequencyInterface.h>
 #include <dpsim-models/SimSignalComp.h>
 #include <dpsim-models/SimPowerComp.h>
 #include <dpsim/MNASolver.h>
@@ -44,15 +60,26 @@
 
 namespace DPsim {
 
-	enum DirectLinearSolverImpl{
-		Undef = 0,
-		KLU,
-		SparseLU,
-		DenseLU,
-		CUDADense,
-		CUDASparse,
-		CUDAMagma,
-		Plugin
+	/// Cached system matrix contribution of a switch or variable element
+	struct IncrementalStamp {
+		/// Element stamping into the system matrix
+		std::shared_ptr<CPS::MNAInterface> comp;
+		/// Set for variable elements, which flag changes themselves
+		CPS::MNAVariableCompInterface::Ptr varComp;
+		/// Set for switches without variable element interface, which change with their state
+		CPS::MNASwitchInterface::Ptr switchComp;
+		/// Switch state of the cached contribution
+		Bool switchClosed = false;
+		/// Indicates that the element has to be restamped
+		Bool changed = false;
+		/// Contribution of the element alone, with fixed sparsity pattern
+		SparseMatrix stamp;
+		/// Recorded positions of the element stamps in the contribution
+		CPS::MatrixStampSlots slots;
+		/// Values of the contribution currently added to the system matrix
+		std::vector<Real> values;
+		/// Positions of the contribution entries in the value array of the system matrix
+		std::vector<UInt> systemSlots;
 	};
 
 	/// Solver class using Modified Nodal Analysis (MNA).
@@ -65,6 +92,26 @@ namespace DPsim {
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<SparseMatrix> > mSwitchedMatrices;
 		/// Map of direct linear solvers related to the system matrices
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector< std::shared_ptr< DirectLinearSolver> > > mDirectLinearSolvers;
+		/// Guards the factorization times if the switch states are factorized in parallel
+		std::mutex mFactorizeTimesMutex;
+		/// Switch states of lazily built system matrices, most recently used first
+		std::list< std::bitset<SWITCH_NUM> > mSwitchedMatrixCacheOrder;
+		/// Frequencies solved together per switch status, indexed by the leading frequency
+		/// whose factorization is shared by all frequencies with an identical system matrix
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector< std::vector<UInt> > > mFrequencyGroups;
+		/// Batched source vectors of the frequency groups, indexed by the leading frequency
+		std::vector<Matrix> mRightSideVectorBatch;
+		/// Batched solutions of the frequency groups, indexed by the leading frequency
+		std::vector<Matrix> mLeftSideVectorBatch;
+		/// Selection state of a frequency of the parallel solve, only written by the task solving it
+		struct HarmonicSelection {
+			Bool dropped = false;
+			UInt skippedSolves = 0;
+		};
+		/// Selection states indexed by frequency
+		std::vector<HarmonicSelection> mHarmonicSelections;
+		/// Maximum magnitude of the source vector of the first frequency in the last solve
+		std::atomic<Real> mFundamentalMagnitude { 0 };
 
 		// #### Data structures for system recomputation over time ####
 		/// System matrix including all static elements
@@ -73,13 +120,255 @@ namespace DPsim {
 		SparseMatrix mVariableSystemMatrix;
 		/// LU factorization of variable system matrix
 		std::shared_ptr<DirectLinearSolver> mDirectLinearSolverVariableSystemMatrix;
+		/// Values of the base matrix aligned with the sparsity pattern of the variable system matrix
+		std::vector<Real> mBaseSystemValues;
+		/// Recorded positions of the switch and variable element stamps in the variable system matrix
+		CPS::MatrixStampSlots mVariableStampSlots;
+		/// Entries of both switch states and of the varying entries with zero values, kept in the
+		/// variable system matrix so that its sparsity pattern does not change between refactorizations
+		SparseMatrix mVariablePattern;
 		/// LU factorization indicator
 		DirectLinearSolverImpl mImplementationInUse;
+		/// Set if the implementation is selected by benchmarks at initialization
+		Bool mAutoImplementation = false;
 		/// LU factorization configuration
 		DirectLinearSolverConfiguration mConfigurationInUse;
 
+		// #### Data structures for low-rank updates of the variable system matrix ####
+		/// System matrix the LU factorization of the variable system matrix belongs to
+		SparseMatrix mFactorizedSystemMatrix;
+		/// Rows of the difference between variable and factorized system matrix
+		std::vector<UInt> mLowRankRows;
+		/// Columns of the difference between variable and factorized system matrix
+		std::vector<UInt> mLowRankCols;
+		/// Dense block of the difference at the low-rank rows and columns
+		Matrix mLowRankCorrection;
+		/// Solutions of the factorized system for the unit vectors of the low-rank rows
+		Matrix mLowRankBasis;
+		/// LU factorization of the capacitance matrix of the Woodbury identity
+		CPS::LUFactorized mLowRankCapacitance;
+		/// Number of low-rank updates
+		Int mNumLowRankUpdates = 0;
+
+		// #### Data structures for incremental solves of sparse source vector changes ####
+		/// Source vector and solution of the last full or incremental solve
+		Matrix mIncrementalRightSide;
+		Matrix mIncrementalSolution;
+		/// Switch status of the system matrix the solution belongs to
+		std::bitset<SWITCH_NUM> mIncrementalStatus;
+		/// Solutions of the system for the unit vectors of changed rows, computed on first use
+		std::unordered_map<UInt, Matrix> mInverseColumns;
+		/// Changed rows of the current step
+		std::vector<UInt> mChangedRows;
+		/// Incremental solves since the last full solve
+		UInt mIncrementalSteps = 0;
+		/// Incremental solves after which a full solve removes the accumulated rounding errors
+		static constexpr UInt mIncrementalResyncSteps = 1000;
+		/// Number of incremental solves
+		Int mNumIncrementalSolves = 0;
+
+		// #### Data structures for the Kron reduction of static subnetworks ####
+		/// Static subnetwork eliminated from the switched system matrices
+		struct KronCluster {
+			/// Rows of the eliminated unknowns
+			std::vector<UInt> rows;
+			/// Rows of the kept unknowns coupled to the eliminated ones
+			std::vector<UInt> boundary;
+			/// Solution at the eliminated rows per unit solution at the boundary rows
+			Matrix reconstruction;
+			/// Solution at the boundary and eliminated rows of the current step
+			Matrix boundarySolution;
+			Matrix solution;
+		};
+		/// Eliminated subnetworks
+		std::vector<KronCluster> mKronClusters;
+		/// Rows of the full system in the order of the reduced system, empty if not reduced
+		std::vector<UInt> mKronKeptRows;
+		/// Source vector and solution of the reduced system
+		Matrix mKronRightSide;
+		Matrix mKronSolution;
+		/// Subnetworks coupled to more boundary rows are kept, as their equivalent fills in
+		/// the reduced system matrix densely at these rows
+		UInt mKronMaxBoundaryRows = 12;
+
+		// #### Data structures for batched solves with other simulations ####
+		/// Index of the system in the batched linear solver, negative if not yet added
+		Int mBatchIndex = -1;
+		/// Switch status of the system matrix in the batched linear solver
+		std::bitset<SWITCH_NUM> mBatchSwitchStatus;
+		/// Indicates that the right side vector was handed to the batched linear solver
+		Bool mBatchedSolvePending = false;
+
+		// #### Data structures for the steps of components on the device ####
+		/// Components whose pre and post steps run on the device, their tasks are not scheduled
+		std::unordered_set<const CPS::MNAInterface*> mGpuResidentComps;
+		/// Interface attributes of these components, which the solve task modifies
+		CPS::AttributeBase::List mGpuResidentAttributes;
+		/// The state on the device is uploaded before the first solve after the initialization
+		Bool mGpuResidentUploaded = false;
+#ifdef WITH_CUDA_SPARSE
+		/// Companion models on the device by number of phases
+		std::vector<std::unique_ptr<GpuSparseAdapter::DeviceStep>> mGpuDeviceSteps;
+		std::vector<GpuSparseAdapter::DeviceStep*> mGpuDeviceStepList;
+#endif
+
+		// #### Data structures for the generated step ####
+#ifdef WITH_MNASOLVERPLUGIN
+		/// Step generated for the system matrix of one switch status
+		std::unique_ptr<GeneratedStep> mGeneratedStep;
+#endif
+		/// Switch status the step is generated for
+		std::bitset<SWITCH_NUM> mGeneratedStepStatus;
+		/// Stamps in the order of the generated assembly and their values in the current step
+		std::vector<const Matrix*> mGeneratedStamps;
+		std::vector<const double*> mGeneratedStampValues;
+
+		// #### Data structures for incremental stamping of variable elements ####
+		/// Cached contributions of switches and variable elements to the variable system matrix
+		std::vector<IncrementalStamp> mIncrementalStamps;
+		/// Only switching events update the system matrix while set
+		Bool mFreezeVariableComponents = false;
+
+		// #### Data structures for the solve of the diagonal blocks of the block triangular form ####
+		/// Independent diagonal blocks of the same dependency level, which are solved by one task
+		struct BlockGroup {
+			/// Matched rows and columns of the blocks, the row of each column at the same position
+			std::vector<UInt> rows;
+			std::vector<UInt> cols;
+			/// Groups with solutions the group depends on
+			std::vector<UInt> dependencies;
+			/// Component stamps contributing to the rows of the group
+			std::vector<std::pair<const Matrix*, UInt>> rightVectorScatter;
+			/// Solution at the columns of the group
+			CPS::Attribute<Matrix>::Ptr solution;
+			/// Right side vector of the group and solution of its diagonal block
+			Matrix rightVector;
+			Matrix blockSolution;
+		};
+		/// Diagonal block and coupling to the previous groups for one switch status
+		struct BlockGroupSystem {
+			/// Diagonal block of the group, rows and columns in the order of the group
+			SparseMatrix diagonal;
+			/// Entries of the group rows in the columns of other groups, global column indices
+			SparseMatrix coupling;
+			///
+			std::shared_ptr<DirectLinearSolver> solver;
+		};
+		/// Block groups in solve order
+		std::vector<BlockGroup> mBlockGroups;
+		/// Factorized systems of the block groups per switch status
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<BlockGroupSystem> > mBlockGroupSystems;
+		/// Minimum number of rows of a block group, smaller blocks of the same level are merged
+		UInt mMinBlockGroupSize = 32;
+
+		// #### Data structures for adaptive time steps ####
+		/// Switched system matrices and factorizations of one time step
+		struct TimeStepSystems {
+			std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<SparseMatrix> > matrices;
+			std::unordered_map< std::bitset<SWITCH_NUM>, std::vector< std::shared_ptr< DirectLinearSolver> > > solvers;
+			std::list< std::bitset<SWITCH_NUM> > cacheOrder;
+		};
+		/// Systems of the other time steps used so far, reused when the time step returns to them
+		std::map<Real, TimeStepSystems> mTimeStepSystems;
+		/// Components with a companion model depending on the time step
+		CPS::MNAVariableTimeStepInterface::List mTimeStepComps;
+		/// Components following a change of the shift frequency
+		CPS::MNAVariableFrequencyInterface::List mShiftFrequencyComps;
+		/// Builds and factorizes the switched system matrices after a parameter change of the
+		/// components, only the current one if they are built on demand
+		void rebuildSwitchedMatrices(Bool keepSharedAnalysis = false);
+		/// Matrix rows of the virtual nodes of removed components, decoupled by a
+		/// unit diagonal until virtual nodes of added components take them
+		std::vector<UInt> mFreeMatrixRows;
+		/// Stamps the unit diagonal of the free matrix rows
+		void stampFreeMatrixRows(SparseMatrix& sys);
+		/// Virtual nodes of a component and its subcomponents
+		static typename CPS::SimNode<VarType>::List componentVirtualNodes(const CPS::IdentifiedObject::Ptr& comp);
+
+		// #### Data structures for parameter changes ####
+		/// Components whose parameters are changed
+		CPS::MNAInterface::List mChangedComps;
+		/// System matrix stamps of the changed components before the change
+		SparseMatrix mChangedStamps;
+		/// Sum of the system matrix stamps of the components
+		SparseMatrix componentStamps(const CPS::MNAInterface::List& comps) const;
+
+		// #### Data structures for forward sensitivities ####
+		/// Copy of the simulation with a perturbed parameter, whose difference to
+		/// the solution is the finite difference of the sensitivity
+		struct SensitivityShadow {
+			SensitivityParameter parameter;
+			/// Component stamping the parameter, none for signal components
+			CPS::MNAInterface::Ptr comp;
+			/// Unperturbed value and its perturbation
+			Real value = 0;
+			Real step = 0;
+			/// Change of the system matrix by the perturbation
+			SparseMatrix matrixChange;
+			/// Attributes of the components after the pre-step of the next step
+			Checkpoint state;
+			/// Right side vector of the next step
+			Matrix rightSide;
+		};
+		std::vector<SensitivityShadow> mSensitivityShadows;
+		/// Static attributes of the nodes and components, exchanged for the shadow steps
+		std::vector<std::pair<String, CPS::AttributeBase::Ptr>> mSensitivityAttributes;
+		/// Tasks of the signal components, run in their order for the shadow steps
+		CPS::Task::List mSensitivitySignalTasks;
+		/// Derivatives of the left side vector, one column per parameter
+		CPS::Attribute<Matrix>::Ptr mSensitivities;
+		/// The shadows start again from the solution after a reset
+		Bool mSensitivitiesStarted = false;
+		/// Starts all shadows at the present state with zero sensitivities
+		void initializeSensitivities();
+		/// Solves the shadows of the step with one multi-column solve and runs
+		/// their post-steps and the pre-steps of the next step
+		void propagateSensitivities(Real time, Int timeStepCount);
+		Checkpoint captureSensitivityState() const;
+		void restoreSensitivityState(const Checkpoint& state);
+		/// Sets the parameter and updates the companion model of its component
+		void setSensitivityParameter(SensitivityShadow& shadow, Real value);
+
+		// #### Data structures for the prefetch of switched system matrices ####
+		/// System matrix of an upcoming switch status, factorized by a background task
+		struct SwitchedMatrixPrefetch {
+			std::bitset<SWITCH_NUM> status;
+			SparseMatrix matrix;
+			std::shared_ptr<DirectLinearSolver> solver;
+			Real factorizeTime = 0;
+			std::future<void> done;
+		};
+		/// Prefetch in progress or finished but not used yet
+		std::unique_ptr<SwitchedMatrixPrefetch> mPrefetch;
+		/// Index of each switch by its state attribute
+		std::unordered_map<const CPS::AttributeBase*, UInt> mSwitchStateIndices;
+		/// Moves the prefetched system into the cache of switched matrices
+		void usePrefetch();
+		/// Waits for the background task and drops the prefetched system
+		void dropPrefetch();
+		/// Removes the least recently used switched matrices beyond the cache size
+		void evictSwitchedMatrices();
+
+		// #### Data structures for the symbolic analysis shared by the switched system matrices ####
+		/// Union of the sparsity patterns of all switch states with zero values,
+		/// analyzed once for the factorizations of all switched matrices
+		struct SharedSymbolicAnalysis {
+			SparseMatrix pattern;
+			std::shared_ptr<DirectLinearSolver> solver;
+		};
+		/// Shared analysis, also read by the prefetch task
+		std::shared_ptr<const SharedSymbolicAnalysis> mSharedAnalysis;
+		/// Stamps all components and both states of each switch onto the common pattern
+		/// of matrices with the size of the given one and analyzes it
+		void createSharedAnalysis(const SparseMatrix& sys);
+		/// Extends the matrix to the common pattern and uses the shared analysis if
+		/// there is one and the solver supports it, otherwise preprocesses the matrix
+		void preprocessSwitchedMatrix(SparseMatrix& sys, DirectLinearSolver& solver,
+			const SharedSymbolicAnalysis* analysis);
+
 		using MnaSolver<VarType>::mSwitches;
 		using MnaSolver<VarType>::mMNAIntfSwitches;
+		using MnaSolver<VarType>::mSimSignalComps;
 		using MnaSolver<VarType>::mMNAComponents;
 		using MnaSolver<VarType>::mVariableComps;
 		using MnaSolver<VarType>::mMNAIntfVariableComps;
@@ -92,7 +381,9 @@ namespace DPsim {
 		using MnaSolver<VarType>::mIsInInitialization;
 		using MnaSolver<VarType>::mRightSideVectorHarm;
 		using MnaSolver<VarType>::mLeftSideVectorHarm;
+		using MnaSolver<VarType>::mName;
 		using MnaSolver<VarType>::mFrequencyParallel;
+		using MnaSolver<VarType>::mHarmonicDropTolerance;
 		using MnaSolver<VarType>::mSLog;
 		using MnaSolver<VarType>::mSystemMatrixRecomputation;
 		using MnaSolver<VarType>::hasVariableComponentChanged;
@@ -101,6 +392,30 @@ namespace DPsim {
 		using MnaSolver<VarType>::mSolveTimes;
 		using MnaSolver<VarType>::mRecomputationTimes;
 		using MnaSolver<VarType>::mListVariableSystemMatrixEntries;
+		using MnaSolver<VarType>::mStepPhases;
+		using MnaSolver<VarType>::mEventLog;
+		using MnaSolver<VarType>::mExecutor;
+		using MnaSolver<VarType>::mLazySwitchedMatrices;
+		using MnaSolver<VarType>::mSwitchedMatrixCacheSize;
+		using MnaSolver<VarType>::mSharedSymbolicAnalysis;
+		using MnaSolver<VarType>::mLowRankSystemMatrixUpdates;
+		using MnaSolver<VarType>::mLowRankUpdateMaxRank;
+		using MnaSolver<VarType>::mIncrementalSystemMatrixStamping;
+		using MnaSolver<VarType>::mIncrementalSolve;
+		using MnaSolver<VarType>::mIncrementalSolveMaxRows;
+		using MnaSolver<VarType>::mKronReduction;
+		using MnaSolver<VarType>::mBatchedLinearSolver;
+		using MnaSolver<VarType>::mBlockParallelSolve;
+		using MnaSolver<VarType>::mSparseRightVectorAssembly;
+		using MnaSolver<VarType>::mRightVectorScatter;
+		using MnaSolver<VarType>::mRightVectorDenseStamps;
+		using MnaSolver<VarType>::mMaxCorrectorIterations;
+		using MnaSolver<VarType>::mIterativeComps;
+		using MnaSolver<VarType>::mGpuResidentStep;
+		using MnaSolver<VarType>::mGpuResidentCopyInterval;
+		using MnaSolver<VarType>::mStepGeneration;
+		using MnaSolver<VarType>::mTimeStep;
+		using MnaSolver<VarType>::mSystem;
 
 		// #### General
 		/// Create system matrix
@@ -113,6 +428,13 @@ namespace DPsim {
 		void switchedMatrixEmpty(std::size_t swIdx, Int freqIdx) override;
 		/// Applies a component stamp to the matrix with the given switch index
 		void switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) override;
+		/// Applies a component and switch stamp to the matrix with the given switch index and frequency index
+		void switchedMatrixStamp(std::size_t swIdx, Int freqIdx, CPS::MNAInterface::List& components, CPS::MNASwitchInterface::List& switches) override;
+		/// Builds and factorizes the matrix with the given switch index if it is not cached,
+		/// evicting the least recently used matrix if the cache is full
+		void switchedMatrixRequest(std::size_t index) override;
+		/// Creates an empty system matrix and linear solver for the given switch status
+		void createEmptySwitchedMatrix(const std::bitset<SWITCH_NUM>& bit);
 
 		// #### Methods for system recomputation over time ####
 		/// Stamps components into the variable system matrix
@@ -123,20 +445,94 @@ namespace DPsim {
 		std::shared_ptr<CPS::Task> createSolveTaskRecomp() override;
 		/// Recomputes systems matrix
 		virtual void recomputeSystemMatrix(Real time);
+		/// Stamps both states of each switch and the varying entries onto the reserved pattern
+		void createVariablePattern();
+		/// Records the positions of switch and variable element stamps in the variable system matrix
+		void initializeVariableStampSlots();
+		/// Rebuilds the variable system matrix writing stamps directly to the recorded positions,
+		/// returns false if the stamps did not match the recording
+		Bool restampVariableSystemMatrix();
+		/// Updates the low-rank correction of the factorized system matrix,
+		/// returns false if the rank is too large and a refactorization is required
+		Bool updateLowRankCorrection();
+		/// Applies the low-rank correction to the solution of the factorized system
+		void applyLowRankCorrection(Matrix& leftSideVector);
+		/// Caches the contributions of switches and variable elements and their positions in the system matrix
+		void initializeIncrementalStamps();
+		/// Flags the switches and variable elements that changed, returns true if any changed
+		Bool hasIncrementalStampChanged();
+		/// Like the change checks above, but only for switches
+		Bool hasSwitchChanged();
+		/// Replaces the cached contributions of changed elements in the system matrix,
+		/// returns false if the sparsity pattern of a contribution changed
+		Bool restampChangedElements();
+
+		// #### Methods for the solve of the diagonal blocks of the block triangular form ####
+		/// Computes the block triangular form of the system matrices and factorizes the block groups
+		void initializeBlockSolve();
+		/// Extracts and factorizes the systems of the block groups for a switch status
+		void factorizeBlockGroups(const std::bitset<SWITCH_NUM>& status);
+		/// Assembles the right side of a block group and solves its diagonal block
+		void solveBlockGroup(UInt group);
+		/// Updates the node voltages after all block groups are solved
+		void finishBlockSolve();
+
+		// #### Methods for the steps of components on the device ####
+		/// Moves the companion models of the EMT inductors and capacitors to the
+		/// device if the CUDA sparse solver is used for the precomputed system matrices
+		void initializeGpuResidentStep();
+		/// Solves the system with the pre and post steps of the components on the device
+		void solveGpuResident(DirectLinearSolver& linearSolver, Int timeStepCount);
+		/// Writes the state on the device to the components, which is uploaded again
+		/// before the next solve, e.g. after their companion models changed
+		void synchronizeGpuResidentState();
+
+		// #### Methods for the generated step ####
+		/// Generates the step for the system matrix of the current switch status
+		void initializeGeneratedStep();
+		/// Drops the generated step, e.g. after the system matrix changed
+		void dropGeneratedStep();
+		/// Returns true if the step was solved with the generated step
+		Bool solveGenerated();
 
 		// #### Scheduler Task Methods ####
 		/// Create a solve task for this solver implementation
 		std::shared_ptr<CPS::Task> createSolveTask() override;
+		/// Create one task per block group if the block triangular form is used
+		CPS::Task::List createSolveTasks() override;
 		/// Create a solve task for this solver implementation
 		std::shared_ptr<CPS::Task> createLogTask() override;
 		/// Create a solve task for this solver implementation
 		std::shared_ptr<CPS::Task> createSolveTaskHarm(UInt freqIdx) override;
+		/// Create a logging task for the solution of one frequency
+		std::shared_ptr<CPS::Task> createLogTaskHarm(UInt freqIdx) override;
+		/// Frequencies whose solutions the solve task of a frequency may write,
+		/// i.e. the frequencies sharing its system matrix in any switch status
+		std::vector<UInt> harmonicSolveFrequencies(UInt freqIdx) const;
 		/// Logging of system matrices and source vector
 		void logSystemMatrices() override;
 		/// Solves system for single frequency
 		void solve(Real time, Int timeStepCount) override;
 		/// Solves system for multiple frequencies
 		void solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx) override;
+		/// Checks if the source vector of a frequency is negligible compared to
+		/// the one of the first frequency, in which case its solution is zero
+		Bool harmonicNegligible(UInt freqIdx, const Matrix& rightSideVector);
+		/// Solves with the last solution and the inverse columns of the changed source
+		/// vector rows if there are few of them, otherwise solves fully
+		void solveIncremental(DirectLinearSolver& linearSolver);
+		/// Drops the last solution and the inverse columns, e.g. after a refactorization
+		void resetIncrementalSolve();
+		/// Eliminates the static subnetworks without sources from the switched system
+		/// matrices and factorizes the reduced matrices
+		void initializeKronReduction();
+		/// Solves the reduced system and reconstructs the solution at the eliminated rows
+		void solveKronReduced(DirectLinearSolver& linearSolver);
+		/// Assembles the right side vector and hands it to the batched linear solver
+		void prepareBatchedSolve(Real time, Int timeStepCount);
+		/// Takes the solution from the batched linear solver, or solves directly
+		/// if the step was not split for a batched solve
+		void solveBatched(Real time, Int timeStepCount);
 
 		/// Logging of the right-hand-side solution time
 		void logSolveTime();
@@ -147,6 +543,14 @@ namespace DPsim {
 
 		/// Returns a pointer to an object of type DirectLinearSolver
 		std::shared_ptr<DirectLinearSolver> createDirectSolverImplementation(CPS::Logger::Log mSLog);
+		/// Benchmarks the available implementations and configurations on the current
+		/// system matrix and factorizes all system matrices again with the fastest one
+		void selectDirectSolverImplementation();
+		/// Mean time of a solve, and of a partial refactorization if the system matrix
+		/// is recomputed, with the implementation in use. Infinite if the solution is wrong.
+		Real benchmarkDirectSolver(const SparseMatrix& systemMatrix, UInt rounds);
+		/// Returns true if the linear solver in use solves multiple right side vectors in one call
+		Bool hasMultipleRightSideVectorSupport() const;
 
 	public:
 		/// Constructor should not be called by users but by Simulation
@@ -158,7 +562,8 @@ namespace DPsim {
 		/// Destructor
 		virtual ~MnaSolverDirect() = default;
 
-		/// Sets the linear solver to "implementation" and creates an object
+		/// Sets the linear solver to "implementation" and creates an object.
+		/// With Auto, the fastest implementation for the system matrix is selected at initialization.
 		void setDirectLinearSolverImplementation(DirectLinearSolverImpl implementation);
 
 		/// Sets the linear solver configuration
@@ -166,6 +571,74 @@ namespace DPsim {
 
 		/// log LU decomposition times
 		void logLUTimes() override;
+		///
+		void reportMemory(MemoryReport& report) const override;
+
+		/// Time steps can be changed with precomputed or lazily built switched system matrices.
+		/// Components without variable time step support are assumed to not depend on it.
+		Bool supportsTimeStepChange() override;
+		/// Updates the companion models and switches to the system matrices of the time step,
+		/// which are built and factorized on the first change to the time step
+		void changeTimeStep(Real timeStep) override;
+		/// The shift frequency can be changed in single frequency dynamic phasor
+		/// simulations under the same conditions as the time step. Components
+		/// without variable frequency support are assumed to not depend on it.
+		Bool supportsShiftFrequencyChange() override;
+		/// Updates the companion models and sources and rebuilds the system matrices.
+		/// The systems of other time steps are dropped.
+		void changeShiftFrequency(Real frequency, Real time) override;
+		/// Topology edits require the switched system matrices under the same
+		/// conditions as time step changes, without low-rank updates, GPU
+		/// resident steps and sensitivities.
+		Bool supportsTopologyEdits() override;
+		/// Added components connect to network nodes of the solver. They are
+		/// initialized like at the start and their virtual nodes take the matrix
+		/// rows of removed virtual nodes, so the size of the system does not change.
+		/// The switched system matrices are rebuilt, with the shared symbolic
+		/// analysis kept if the sparsity pattern does not grow.
+		void editTopology(const CPS::IdentifiedObject::List& added, const CPS::IdentifiedObject::List& removed) override;
+
+		/// Drops the prefetched system and the state of incremental solves
+		void reset() override;
+		/// Parameters can be changed with precomputed or lazily built switched system matrices
+		Bool supportsParameterChange() override;
+		///
+		void beginParameterChange(const CPS::IdentifiedObject::List& comps) override;
+		/// Adds the difference of the stamps to all switched system matrices built so far and
+		/// refactorizes them, keeping their symbolic analysis. Components with variable time
+		/// step support update their companion models first, other components are assumed
+		/// to stamp their parameters directly.
+		void finishParameterChange() override;
+		/// Takes the parameters of the components of this solver, which change their
+		/// stamps like for finishParameterChange. Each parameter gets a shadow of the
+		/// component states stepped with the perturbed parameter. The shadows of a step
+		/// are solved together against the present factorization, the change of the
+		/// system matrix by a perturbation is moved to the right side with the
+		/// unperturbed solution, which only affects the sensitivities in second order.
+		/// The sensitivities start at zero with the first solved step. Requires the
+		/// support of parameter changes without step generation or steps on the device.
+		UInt setSensitivityParameters(const std::vector<SensitivityParameter>& parameters) override;
+		///
+		CPS::Attribute<Matrix>::Ptr sensitivities() const override { return mSensitivities; }
+
+		/// Stamps and factorizes the lazily built system matrix of the upcoming
+		/// switch status on a background thread. The solve of the first step in
+		/// that status picks it up, waiting for the factorization if needed.
+		/// The parameters of the components must not change until then.
+		void prefetchSwitchStates(const std::vector<SwitchChange>& changes) override;
+		/// Waits for a running factorization before it is dropped
+		void discardPrefetch() override;
+
+		/// Keeps the current linearization of variable components, e.g. to save the
+		/// refactorizations while a real-time simulation is short of time.
+		/// Switching events still update the system matrix. Changes made while frozen
+		/// are applied by the next update after unfreezing.
+		void setFreezeVariableComponents(Bool freeze) override;
+
+		///
+		void initialize() override;
+		/// Leaves out the tasks of the components whose steps run on the device
+		CPS::Task::List getTasks() override;
 
 		// #### MNA Solver Tasks ####
 		///
@@ -175,13 +648,18 @@ namespace DPsim {
 				Task(solver.mName + ".Solve"), mSolver(solver) {
 
 				for (auto it : solver.mMNAComponents) {
-					if (it->getRightVector()->get().size() != 0)
+					if (it->getRightVector()->get().size() != 0 && !solver.mGpuResidentComps.count(it.get()))
 						mAttributeDependencies.push_back(it->getRightVector());
 				}
 				for (auto node : solver.mNodes) {
 					mModifiedAttributes.push_back(node->mVoltage);
 				}
+				// The steps of these components are part of the solve
+				for (auto attr : solver.mGpuResidentAttributes)
+					mModifiedAttributes.push_back(attr);
 				mModifiedAttributes.push_back(solver.mLeftSideVector);
+				if (!solver.mObservedGather.empty())
+					mModifiedAttributes.push_back(solver.mObservedValues);
 			}
 
 			void execute(Real time, Int timeStepCount) {
@@ -193,10 +671,58 @@ namespace DPsim {
 		};
 
 		///
-		class SolveTaskHarm : public CPS::Task {
+		class BlockSolveTask : public CPS::Task {
 		public:
-			SolveTaskHarm(MnaSolverDirect<VarType>& solver, UInt freqIdx) :
-				Task(solver.mName + ".Solve"), mSolver(solver), mFreqIdx(freqIdx) {
+			BlockSolveTask(MnaSolverDirect<VarType>& solver, UInt group) :
+				Task(solver.mName + ".Solve_" + std::to_string(group)), mSolver(solver), mGroup(group) {
+
+				for (auto it : solver.mMNAComponents) {
+					if (it->getRightVector()->get().size() != 0)
+						mAttributeDependencies.push_back(it->getRightVector());
+				}
+				for (auto dependency : solver.mBlockGroups[group].dependencies)
+					mAttributeDependencies.push_back(solver.mBlockGroups[dependency].solution);
+				mModifiedAttributes.push_back(solver.mBlockGroups[group].solution);
+			}
+
+			void execute(Real time, Int timeStepCount) {
+				mSolver.solveBlockGroup(mGroup);
+			}
+
+		private:
+			MnaSolverDirect<VarType>& mSolver;
+			UInt mGroup;
+		};
+
+		///
+		class BlockFinishTask : public CPS::Task {
+		public:
+			BlockFinishTask(MnaSolverDirect<VarType>& solver) :
+				Task(solver.mName + ".Solve"), mSolver(solver) {
+
+				for (auto& group : solver.mBlockGroups)
+					mAttributeDependencies.push_back(group.solution);
+				for (auto node : solver.mNodes) {
+					mModifiedAttributes.push_back(node->mVoltage);
+				}
+				mModifiedAttributes.push_back(solver.mLeftSideVector);
+				if (!solver.mObservedGather.empty())
+					mModifiedAttributes.push_back(solver.mObservedValues);
+			}
+
+			void execute(Real time, Int timeStepCount) {
+				mSolver.finishBlockSolve();
+			}
+
+		private:
+			MnaSolverDirect<VarType>& mSolver;
+		};
+
+		///
+		class BatchedSolveTask : public SplitTask {
+		public:
+			BatchedSolveTask(MnaSolverDirect<VarType>& solver) :
+				SplitTask(solver.mName + ".Solve"), mSolver(solver) {
 
 				for (auto it : solver.mMNAComponents) {
 					if (it->getRightVector()->get().size() != 0)
@@ -205,9 +731,37 @@ namespace DPsim {
 				for (auto node : solver.mNodes) {
 					mModifiedAttributes.push_back(node->mVoltage);
 				}
-				for(auto leftVec : solver.mLeftSideVectorHarm) {
-					mModifiedAttributes.push_back(leftVec);
+				mModifiedAttributes.push_back(solver.mLeftSideVector);
+				if (!solver.mObservedGather.empty())
+					mModifiedAttributes.push_back(solver.mObservedValues);
+			}
+
+			void prepare(Real time, Int timeStepCount) {
+				mSolver.prepareBatchedSolve(time, timeStepCount);
+			}
+
+			void execute(Real time, Int timeStepCount) {
+				mSolver.solveBatched(time, timeStepCount);
+			}
+
+		private:
+			MnaSolverDirect<VarType>& mSolver;
+		};
+
+		///
+		class SolveTaskHarm : public CPS::Task {
+		public:
+			SolveTaskHarm(MnaSolverDirect<VarType>& solver, UInt freqIdx) :
+				Task(solver.mName + ".Solve"), mSolver(solver), mFreqIdx(freqIdx) {
+
+				for (auto it : solver.mMNAComponents) {
+					if (it->getRightVector()->get().size() != 0)
+						mAttributeDependencies.push_back(it->getRightVector());
 				}
+				// Only the solutions of the frequencies solved together are written, so that
+				// the node updates and logging of each frequency follow its own solve
+				for (auto freq : solver.harmonicSolveFrequencies(freqIdx))
+					mModifiedAttributes.push_back(solver.mLeftSideVectorHarm[freq]);
 			}
 
 			void execute(Real time, Int timeStepCount) {
@@ -237,6 +791,8 @@ namespace DPsim {
 					mModifiedAttributes.push_back(node->mVoltage);
 				}
 				mModifiedAttributes.push_back(solver.mLeftSideVector);
+				if (!solver.mObservedGather.empty())
+					mModifiedAttributes.push_back(solver.mObservedValues);
 			}
 
 			void execute(Real time, Int timeStepCount) {
@@ -262,5 +818,21 @@ namespace DPsim {
 		private:
 			MnaSolverDirect<VarType>& mSolver;
 		};
+
+		///
+		class LogTaskHarm : public CPS::Task {
+		public:
+			LogTaskHarm(MnaSolverDirect<VarType>& solver, UInt freqIdx) :
+				Task(solver.mName + ".Log"), mSolver(solver), mFreqIdx(freqIdx) {
+				mAttributeDependencies.push_back(solver.mLeftSideVectorHarm[freqIdx]);
+				mModifiedAttributes.push_back(Scheduler::external);
+			}
+
+			void execute(Real time, Int timeStepCount) { mSolver.logHarm(time, timeStepCount, mFreqIdx); }
+
+		private:
+			MnaSolverDirect<VarType>& mSolver;
+			UInt mFreqIdx;
+		};
 	};
 }
@@ -28,4 +28,31 @@ struct dpsim_mna_plugin {
 
 extern struct dpsim_mna_plugin* get_mna_plugin(const char *name);
 
+/* Version 2 of the plugin interface, queried with get_mna_plugin_v2.
+ * Optional entry points may be NULL, in which case the next less
+ * specific one is used, ending with a full lu_decomp. */
+#define DPSIM_MNA_PLUGIN_ABI_VERSION 2
+
+struct dpsim_matrix_entry {
+	int row;
+	int col;
+};
+
+struct dpsim_mna_plugin_v2 {
+	int abi_version;	//set to DPSIM_MNA_PLUGIN_ABI_VERSION by the plugin
+	void (*log)(const char *);
+	//matrix entries that may change during the simulation, valid until cleanup
+	int (*init)(struct dpsim_csr_matrix*, const struct dpsim_matrix_entry *variable_entries, int variable_entry_number);
+	int (*lu_decomp)(struct dpsim_csr_matrix*);
+	//optional, sparsity pattern unchanged since the last decomposition
+	int (*refactor)(struct dpsim_csr_matrix*);
+	//optional, only the variable entries changed since the last decomposition
+	int (*partial_refactor)(struct dpsim_csr_matrix*);
+	//column-major buffers of row_number x rhs_number values owned by the caller
+	int (*solve_in_place)(const double *rhs_values, double *lhs_values, int rhs_number);
+	void (*cleanup)(void);
+};
+
+extern struct dpsim_mna_plugin_v2* get_mna_plugin_v2(const char *name);
+
 #endif
@@ -13,7 +13,11 @@
 #include <dpsim/MNASolverDirect.h>
 #include <dpsim/DirectLinearSolverConfiguration.h>
 #include <dpsim/DenseLUAdapter.h>
+#include <dpsim/DenseInverseAdapter.h>
 #include <dpsim/SparseLUAdapter.h>
+#include <dpsim/ParallelSparseLUAdapter.h>
+#include <dpsim/ComplexSparseLUAdapter.h>
+#include <dpsim/IterativeAdapter.h>
 #ifdef WITH_KLU
 #include <dpsim/KLUAdapter.h>
 #endif
@@ -51,7 +55,12 @@ class MnaSolverFactory {
 	#endif // WITH_MAGMA
 #endif // WITH_CUDA
 			DirectLinearSolverImpl::DenseLU,
+			DirectLinearSolverImpl::DenseInverse,
 			DirectLinearSolverImpl::SparseLU,
+			DirectLinearSolverImpl::ParallelSparseLU,
+			DirectLinearSolverImpl::Iterative,
+			DirectLinearSolverImpl::ComplexSparseLU,
+			DirectLinearSolverImpl::Auto,
 #ifdef WITH_KLU
 			DirectLinearSolverImpl::KLU
 #endif //WITH_KLU
@@ -91,6 +100,41 @@ class MnaSolverFactory {
 			denseSolver->setDirectLinearSolverImplementation(DirectLinearSolverImpl::DenseLU);
 			return denseSolver;
 		}
+		case DirectLinearSolverImpl::DenseInverse:
+		{
+			log->info("creating DenseInverseAdapter solver implementation");
+			std::shared_ptr<MnaSolverDirect<VarType>> inverseSolver = std::make_shared<MnaSolverDirect<VarType>>(name, domain, logLevel);
+			inverseSolver->setDirectLinearSolverImplementation(DirectLinearSolverImpl::DenseInverse);
+			return inverseSolver;
+		}
+		case DirectLinearSolverImpl::ParallelSparseLU:
+		{
+			log->info("creating ParallelSparseLUAdapter solver implementation");
+			std::shared_ptr<MnaSolverDirect<VarType>> parallelSolver = std::make_shared<MnaSolverDirect<VarType>>(name, domain, logLevel);
+			parallelSolver->setDirectLinearSolverImplementation(DirectLinearSolverImpl::ParallelSparseLU);
+			return parallelSolver;
+		}
+		case DirectLinearSolverImpl::Iterative:
+		{
+			log->info("creating IterativeAdapter solver implementation");
+			std::shared_ptr<MnaSolverDirect<VarType>> iterativeSolver = std::make_shared<MnaSolverDirect<VarType>>(name, domain, logLevel);
+			iterativeSolver->setDirectLinearSolverImplementation(DirectLinearSolverImpl::Iterative);
+			return iterativeSolver;
+		}
+		case DirectLinearSolverImpl::Auto:
+		{
+			log->info("creating solver with implementation selected at initialization");
+			std::shared_ptr<MnaSolverDirect<VarType>> autoSolver = std::make_shared<MnaSolverDirect<VarType>>(name, domain, logLevel);
+			autoSolver->setDirectLinearSolverImplementation(DirectLinearSolverImpl::Auto);
+			return autoSolver;
+		}
+		case DirectLinearSolverImpl::ComplexSparseLU:
+		{
+			log->info("creating ComplexSparseLUAdapter solver implementation");
+			std::shared_ptr<MnaSolverDirect<VarType>> complexSolver = std::make_shared<MnaSolverDirect<VarType>>(name, domain, logLevel);
+			complexSolver->setDirectLinearSolverImplementation(DirectLinearSolverImpl::ComplexSparseLU);
+			return complexSolver;
+		}
 #ifdef WITH_KLU
 		case DirectLinearSolverImpl::KLU:
 		{
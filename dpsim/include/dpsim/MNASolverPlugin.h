@@ -19,7 +19,18 @@ namespace DPsim {
 		using Solver::mSLog;
 		String mPluginName;
 		struct dpsim_mna_plugin *mPlugin;
+		/// Set instead of mPlugin if the plugin provides the version 2 interface
+		struct dpsim_mna_plugin_v2 *mPluginV2;
 		void *mDlHandle;
+		/// Variable matrix entries handed to a version 2 plugin
+		std::vector<struct dpsim_matrix_entry> mVariableEntries;
+		/// Switch status of the matrix decomposed by the plugin
+		std::bitset<SWITCH_NUM> mPluginSwitchStatus;
+
+		/// Loads the plugin, preferring the version 2 interface
+		void loadPlugin();
+		/// Hands a matrix to the plugin for a full decomposition
+		int decompose(SparseMatrix& systemMatrix);
 
 		/// Initialize cuSparse-library
         void initialize() override;
@@ -45,10 +56,16 @@ namespace DPsim {
 					if (it->getRightVector()->get().size() != 0)
 						mAttributeDependencies.push_back(it->getRightVector());
 				}
+				for (auto it : solver.mMNAIntfVariableComps) {
+					if (it->getRightVector()->get().size() != 0)
+						mAttributeDependencies.push_back(it->getRightVector());
+				}
 				for (auto node : solver.mNodes) {
 					mModifiedAttributes.push_back(node->mVoltage);
 				}
 				mModifiedAttributes.push_back(solver.mLeftSideVector);
+				if (!solver.mObservedGather.empty())
+					mModifiedAttributes.push_back(solver.mObservedValues);
 			}
 
 			void execute(Real time, Int timeStepCount) { mSolver.solve(time, timeStepCount); }
@@ -0,0 +1,66 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <dpsim/DataLoggerBackend.h>
+
+namespace DPsim {
+	/// \brief Keeps the latest logged rows in a ring buffer in memory
+	///
+	/// No file is written. The rows of doubles, including the time in the first
+	/// column, are stored row by row. Row n, counted from the start of the
+	/// simulation, is stored in slot n % capacity. The values stay available
+	/// after the simulation until the columns are set by the next run, which
+	/// allocates a new buffer, so views of the old buffer remain valid.
+	///
+	/// The ring is not synchronized with the writer. It must only be read while
+	/// the simulation does not step, e.g. between calls of next().
+	class MemoryLoggerBackend : public DataLoggerBackend {
+	public:
+		typedef std::shared_ptr<MemoryLoggerBackend> Ptr;
+		typedef std::shared_ptr<std::vector<Real>> Buffer;
+
+		/// Keeps the given number of latest rows
+		MemoryLoggerBackend(UInt capacity = 65536);
+
+		String extension() const override { return ".mem"; }
+		Bool open(const fs::path& filename) override;
+		void close() override { }
+		Bool hasColumns() const override { return mHasColumns; }
+		void setColumns(const std::vector<String>& names, Notation notation) override;
+		void writeRow(Real time, const Real* values, UInt count) override;
+		Bool writesFiles() const override { return false; }
+
+		/// Values per row including the time
+		UInt columns() const { return mColumns; }
+		/// Rows in the ring buffer
+		UInt capacity() const { return mCapacity; }
+		/// Names of the columns including the time
+		const std::vector<String>& columnNames() const { return mNames; }
+		/// Rows written since the columns were set
+		UInt rowsWritten() const { return mRowsWritten; }
+		/// Rows currently held, at most the capacity
+		UInt rows() const { return mRowsWritten < mCapacity ? mRowsWritten : mCapacity; }
+		/// Slot of the oldest row held
+		UInt firstSlot() const { return mRowsWritten < mCapacity ? 0 : mRowsWritten % mCapacity; }
+		/// Storage of the ring buffer, shared with views of it
+		Buffer buffer() const { return mBuffer; }
+		std::size_t memoryBytes() const override { return mBuffer ? mBuffer->capacity() * sizeof(Real) : 0; }
+
+	private:
+		UInt mCapacity;
+		UInt mColumns = 0;
+		Bool mHasColumns = false;
+		std::vector<String> mNames;
+		Buffer mBuffer;
+		UInt mRowsWritten = 0;
+	};
+}
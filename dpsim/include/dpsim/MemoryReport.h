@@ -0,0 +1,65 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Logger.h>
+
+namespace DPsim {
+	/// \brief Heap memory held by the parts of a simulation
+	///
+	/// Every entry gives the bytes of one item of a subsystem, e.g. the
+	/// switched system matrices of a solver. The sizes are computed from the
+	/// dimensions and capacities of the containers, so they are estimates
+	/// which leave out the bookkeeping of the allocator and small members.
+	class MemoryReport {
+	public:
+		struct Entry {
+			String subsystem;
+			String item;
+			std::size_t bytes;
+		};
+
+		/// Adds an item, items without bytes are skipped
+		void add(const String& subsystem, const String& item, std::size_t bytes) {
+			if (bytes > 0)
+				mEntries.push_back({ subsystem, item, bytes });
+		}
+
+		const std::vector<Entry>& entries() const { return mEntries; }
+		/// Total bytes of all items
+		std::size_t total() const;
+		/// Total bytes per subsystem
+		std::map<String, std::size_t> subsystems() const;
+
+		/// Logs the total of each subsystem and its items
+		void log(CPS::Logger::Log log) const;
+
+		// #### Sizes of the common containers ####
+		template <typename Scalar, int Options, typename Index>
+		static std::size_t sparseBytes(const Eigen::SparseMatrix<Scalar, Options, Index>& matrix) {
+			return static_cast<std::size_t>(matrix.data().allocatedSize()) * (sizeof(Scalar) + sizeof(Index))
+				+ static_cast<std::size_t>(matrix.outerSize() + 1) * sizeof(Index);
+		}
+		template <typename Derived>
+		static std::size_t denseBytes(const Eigen::PlainObjectBase<Derived>& matrix) {
+			return static_cast<std::size_t>(matrix.size()) * sizeof(typename Derived::Scalar);
+		}
+		template <typename T>
+		static std::size_t vectorBytes(const std::vector<T>& vector) {
+			return vector.capacity() * sizeof(T);
+		}
+
+	private:
+		std::vector<Entry> mEntries;
+	};
+}
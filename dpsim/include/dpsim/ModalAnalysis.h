@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Checkpoint.h>
+#include <dpsim/DirectLinearSolver.h>
+#include <dpsim/Simulation.h>
+
+namespace DPsim {
+	/// \brief Small-signal modal analysis around the operating point of a simulation
+	///
+	/// The state of the simulation consists of all real and complex values of
+	/// its checkpoint, i.e. the solution of the solver and the states of the
+	/// power and signal components such as machines and controllers. The
+	/// Jacobian J of the map from the state before to the state after one time
+	/// step is computed by restoring perturbed states and stepping once per
+	/// state. Values that neither change nor influence other values, like
+	/// parameters, and values that are overwritten in every step, like
+	/// interface currents, are eliminated, which only removes eigenvalues one
+	/// and zero of J. The state matrix is then A = (J - I) / dt.
+	///
+	/// The modes closest to the shift are computed by Arnoldi iterations on
+	/// (A - shift I)^-1, whose systems are solved with a single factorization
+	/// of a DirectLinearSolver. A complex shift is handled as the real system
+	/// of twice the size. The eigenvalues are mapped back to continuous time
+	/// by lambda = ln(1 + theta dt) / dt for an eigenvalue theta of A.
+	///
+	/// The operating point has to be a steady state of the simulation, e.g.
+	/// reached by stepping a dynamic phasor simulation, whose frequencies are
+	/// then relative to the system frequency. No event may be pending in the
+	/// next step. The simulation is restored to the operating point afterwards
+	/// and its loggers are paused while it is linearized.
+	class ModalAnalysis {
+	public:
+		typedef std::shared_ptr<ModalAnalysis> Ptr;
+
+		struct Mode {
+			/// Continuous time eigenvalue
+			Complex eigenvalue;
+			/// Frequency of the oscillation in Hz
+			Real frequency = 0;
+			/// Damping ratio, -Re(lambda) / |lambda|
+			Real dampingRatio = 0;
+			/// Residual of the Ritz pair of the inverted operator relative to its eigenvalue
+			Real residual = 0;
+			/// Right eigenvector over the states, scaled to a largest entry of one
+			CPS::VectorComp shape;
+		};
+
+		/// Logger
+		CPS::Logger::Log mLog;
+
+		ModalAnalysis(String name, Simulation::Ptr simulation,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		/// Modes closest to this eigenvalue in 1/s are computed
+		void setShift(Complex shift) { mShift = shift; }
+		/// Number of modes returned by computeModes
+		void setNumModes(UInt numModes) { mNumModes = numModes; }
+		/// Dimension of the Krylov subspace of the Arnoldi iterations
+		void setKrylovDimension(UInt dimension) { mKrylovDimension = dimension; }
+		/// Perturbation of a state relative to its magnitude above one
+		void setPerturbation(Real perturbation) { mPerturbation = perturbation; }
+		/// Entries of the step Jacobian below this magnitude are dropped
+		void setDropTolerance(Real tolerance) { mDropTolerance = tolerance; }
+		/// Solver of the shifted systems, SparseLU by default
+		void setLinearSolver(DirectLinearSolverImpl implementation) { mImplementation = implementation; }
+
+		/// Computes the state matrix at the current state of the initialized simulation
+		void linearize();
+		/// Computes the modes closest to the shift, linearizes first if required
+		const std::vector<Mode>& computeModes();
+
+		// #### Getter ####
+		String name() const { return mName; }
+		/// State matrix A over the remaining states
+		const SparseMatrix& stateMatrix() const { return mStateMatrix; }
+		/// Names of the remaining states, the checkpoint key and element index
+		/// with the suffix .re or .im for complex values
+		const std::vector<String>& stateNames() const { return mStateNames; }
+		/// Modes of the last computation, the closest to the shift first
+		const std::vector<Mode>& modes() const { return mModes; }
+
+	protected:
+		/// Real and complex values of a checkpoint as one vector
+		CPS::Vector flatten(const Checkpoint& state) const;
+		/// Checkpoint with the values of the vector, the others taken from the operating point
+		Checkpoint unflatten(const CPS::Vector& values) const;
+		/// Restores the state, steps once and returns the new state
+		CPS::Vector stepFrom(const CPS::Vector& values);
+		/// Removes the states whose row or column only has a diagonal of zero or one
+		std::vector<UInt> reduceStates(const SparseMatrix& jacobian) const;
+		std::shared_ptr<DirectLinearSolver> createLinearSolver() const;
+		/// Pauses or resumes the loggers that were enabled and not paused by the user
+		void setLogging(DataLogger::List& loggers, Bool enabled);
+
+		String mName;
+		Simulation::Ptr mSimulation;
+		Complex mShift = 0;
+		UInt mNumModes = 10;
+		UInt mKrylovDimension = 60;
+		Real mPerturbation = 1e-7;
+		Real mDropTolerance = 1e-7;
+		DirectLinearSolverImpl mImplementation = DirectLinearSolverImpl::SparseLU;
+
+		/// State at the operating point
+		Checkpoint mOperatingPoint;
+		/// Checkpoint value and element of every flattened state
+		std::vector<std::pair<String, UInt>> mFlatStates;
+		Bool mLinearized = false;
+
+		SparseMatrix mStateMatrix;
+		std::vector<String> mStateNames;
+		std::vector<Mode> mModes;
+	};
+}
@@ -0,0 +1,81 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Logger.h>
+#include <dpsim-models/ObjectPool.h>
+#include <dpsim-models/SystemTopology.h>
+
+namespace DPsim {
+	/// Template of the topology of many simulations of the same grid, e.g. parameter sweeps
+	///
+	/// The template keeps the nodes and power components of a topology and the
+	/// terminal connections of the components by index. The template itself is
+	/// never simulated. Each scenario gets its own clones of the nodes and
+	/// components, with the same names, parameters, initial voltages and terminal
+	/// powers. The clones are placed in one object pool per scenario, so a
+	/// scenario takes a few contiguous chunks of memory and is released as a whole.
+	/// The components must implement clone(). Signal components are not supported.
+	class ModelTemplate {
+	public:
+		typedef std::shared_ptr<ModelTemplate> Ptr;
+
+		///
+		ModelTemplate(String name, const CPS::SystemTopology& topology,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		/// Creates the topology of one scenario
+		CPS::SystemTopology instantiate() const;
+		/// Creates the topologies of the given number of scenarios, in parallel if
+		/// requested, which requires the clone() of all components to be thread safe
+		std::vector<CPS::SystemTopology> instantiate(UInt count, Bool parallel = false) const;
+
+		///
+		String name() const { return mName; }
+		/// Bytes of the object pools of the scenarios created so far
+		std::size_t scenarioBytes() const;
+
+	private:
+		/// Nodes and power components of one domain with the template node
+		/// index of each terminal, -1 for ground
+		template <typename VarType>
+		struct Index {
+			typename CPS::SimNode<VarType>::List nodes;
+			typename CPS::SimPowerComp<VarType>::List components;
+			std::vector<std::vector<Int>> componentNodes;
+		};
+
+		template <typename VarType>
+		static void collect(const CPS::SystemTopology& topology, Index<VarType>& index);
+		template <typename VarType>
+		void clone(const Index<VarType>& index, CPS::SystemTopology& topology) const;
+
+		///
+		String mName;
+		///
+		CPS::Logger::Log mSLog;
+		///
+		Real mSystemFrequency;
+		///
+		Matrix mFrequencies;
+		///
+		Index<Real> mRealIndex;
+		///
+		Index<Complex> mComplexIndex;
+		/// Pools of the created scenarios, which stay alive as long as their objects
+		mutable std::vector<std::weak_ptr<CPS::ObjectPool>> mPools;
+		///
+		mutable std::mutex mPoolsMutex;
+	};
+}
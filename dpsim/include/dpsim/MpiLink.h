@@ -0,0 +1,71 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <mpi.h>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Signal/DecouplingLineRemote.h>
+
+namespace DPsim {
+	/// \brief Channel of a split decoupling line between two MPI ranks
+	///
+	/// Both ranks simulate one end of the line and create a link to the other
+	/// rank with the same tag. The values of every step are sent with
+	/// MPI_Isend, and receives for the following steps are posted in advance,
+	/// so the transfer overlaps with the computation of the next steps and a
+	/// rank only waits if the peer is behind by the full line delay.
+	///
+	/// MPI has to be initialized before the link is created and finalized
+	/// after it is destroyed. The initial voltage is record 0 and the values
+	/// after step k are record k + 1, like for ShmemLink.
+	class MpiLink :
+		public CPS::Signal::DecouplingLineChannel,
+		public SharedFactory<MpiLink> {
+	public:
+		typedef std::shared_ptr<MpiLink> Ptr;
+
+		/// @param peer Rank simulating the other end of the line
+		/// @param tag Message tag, distinguishes several lines between the same ranks
+		/// @param depth Number of sends in flight and receives posted in advance
+		MpiLink(int peer, int tag = 0, UInt depth = 16, MPI_Comm comm = MPI_COMM_WORLD);
+		~MpiLink();
+
+		Complex exchangeInitialVoltage(Complex voltage) override;
+		void send(Int timeStepCount, Complex voltage, Complex current) override;
+		void receive(Int timeStepCount, Complex& voltage, Complex& current) override;
+
+	private:
+		static constexpr int RecordSize = 4;
+
+		void sendRecord(uint64_t index, const Real* values);
+		const Real* receiveRecord(uint64_t index);
+		void postReceive(UInt slot);
+
+		int mPeer;
+		int mTag;
+		UInt mDepth;
+		MPI_Comm mComm;
+
+		/// Buffers and requests of the sends in flight, record n uses slot n % depth
+		std::vector<Real> mSendBuffers;
+		std::vector<MPI_Request> mSendRequests;
+		uint64_t mSent = 0;
+
+		/// Buffers and requests of the posted receives, record n arrives in slot n % depth
+		std::vector<Real> mRecvBuffers;
+		std::vector<MPI_Request> mRecvRequests;
+		uint64_t mReceived = 0;
+
+		/// The last two received records, a line reads at most two per step
+		Real mHistory[2][RecordSize];
+	};
+}
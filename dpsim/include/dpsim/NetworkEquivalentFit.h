@@ -0,0 +1,71 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/ModelTemplate.h>
+#include <dpsim-models/EMT/EMT_Ph1_FrequencyDependentNetworkEquivalent.h>
+#include <dpsim-models/Logger.h>
+#include <dpsim-models/SystemTopology.h>
+
+namespace DPsim {
+	/// Offline fit of a frequency dependent network equivalent of an external grid
+	///
+	/// The external grid is given as SP topology. For each frequency of the
+	/// sweep, a copy of the topology is initialized at that frequency and its
+	/// MNA system matrix is stamped. Sources are short circuited by their
+	/// stamps. The admittance matrix at the boundary nodes is the inverse of the
+	/// impedance matrix, whose columns are the solutions for unit currents
+	/// injected into the boundary nodes. The admittances are fitted with common
+	/// poles by vector fitting, see Gustavsen and Semlyen, "Rational
+	/// approximation of frequency domain responses by vector fitting", 1999.
+	/// Passivity of the fitted model is not enforced.
+	class NetworkEquivalentFit {
+	public:
+		typedef std::shared_ptr<NetworkEquivalentFit> Ptr;
+		typedef CPS::EMT::Ph1::FrequencyDependentNetworkEquivalent::Model Model;
+
+		/// The components of the topology must implement clone()
+		NetworkEquivalentFit(String name, const CPS::SystemTopology& external,
+			const std::vector<String>& boundaryNodes, CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		/// Computes the admittance matrices at the boundary nodes for the frequencies in Hz
+		void sweep(const std::vector<Real>& frequencies);
+		/// Fits a model with the given number of poles to the admittances of the sweep
+		Model fit(UInt numPoles, UInt iterations = 10);
+
+		///
+		const std::vector<Real>& frequencies() const { return mFrequencies; }
+		/// Admittance matrices of the sweep, in the order of the boundary nodes
+		const std::vector<MatrixComp>& admittances() const { return mAdmittances; }
+		/// Largest deviation of the fitted model from the sweep relative to the largest admittance
+		Real fitError() const { return mFitError; }
+
+	private:
+		/// Admittance matrix at the boundary nodes for one frequency
+		MatrixComp admittance(Real frequency) const;
+		/// Real basis functions of the poles, conjugate pairs are combined
+		MatrixComp basis(const std::vector<Complex>& poles) const;
+		/// Entries of the upper triangle of the admittances, one column per frequency
+		MatrixComp responses() const;
+
+		String mName;
+		CPS::Logger::Log mSLog;
+		ModelTemplate mTemplate;
+		std::vector<String> mBoundaryNodes;
+
+		std::vector<Real> mFrequencies;
+		std::vector<MatrixComp> mAdmittances;
+		Real mFitError = 0;
+	};
+}
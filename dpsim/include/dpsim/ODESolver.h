@@ -9,6 +9,7 @@
 #pragma once
 
 #include <dpsim/Solver.h>
+#include <dpsim/SundialsLinearSolver.h>
 
 #include <dpsim-models/Solver/ODEInterface.h>
 
@@ -17,15 +18,28 @@
 #include <sunmatrix/sunmatrix_dense.h>  // access to dense SUNMatrix
 #include <sunlinsol/sunlinsol_dense.h>  // access to dense SUNLinearSolver
 #include <arkode/arkode_direct.h>       // access to ARKDls interface
+#include <arkode/arkode_spils.h>        // access to ARKSpils interface
+#include <sunmatrix/sunmatrix_sparse.h> // access to sparse SUNMatrix
+#include <sunlinsol/sunlinsol_spgmr.h>  // access to SPGMR SUNLinearSolver
+#ifdef WITH_SUNDIALS_KLU
+#include <sunlinsol/sunlinsol_klu.h>    // access to KLU SUNLinearSolver
+#endif
 
 //using namespace CPS; // led to problems
 
 namespace DPsim {
 	/// Solver class for ODE (Ordinary Differential Equation) systems
+	///
+	/// Several components can be integrated by one solver. Their states are
+	/// stacked into one state vector and the Jacobian is block diagonal, so
+	/// there is only one integrator and one task for all of them.
 	class ODESolver: public Solver {
 	protected:
-		/// Component to simulate, possible specialized component needed
-		CPS::ODEInterface::Ptr mComponent;
+		/// Components to simulate, possible specialized components needed
+		CPS::ODEInterface::List mComponents;
+		/// Position of the states of each component in the state vector,
+		/// the last entry is the total number of states
+		std::vector<Int> mStateOffsets;
 
 		/// Number of differential Variables (states)
 		Int mProbDim;
@@ -43,6 +57,13 @@ namespace DPsim {
 		SUNMatrix A {nullptr};
 		/// Empty linear solver object
 		SUNLinearSolver LS {nullptr};
+		/// Linear solver of the Newton iterations
+		SundialsLinearSolver mLinearSolver = SundialsLinearSolver::Dense;
+		/// Jacobian pattern in compressed sparse column format for the sparse linear solver
+		std::vector<sunindextype> mJacobianColumnPointers;
+		std::vector<sunindextype> mJacobianRowIndices;
+		/// Dense Jacobian of each component, gathered into the Jacobian of the solver
+		std::vector<std::vector<realtype>> mJacobianBlocks;
 
 		/// Constant time step
 		Real mTimestep;
@@ -63,8 +84,8 @@ namespace DPsim {
 		int mFlag {0};
 
 		// Similar to DAE-Solver
-		CPS::ODEInterface::StSpFn mStSpFunction;
-		CPS::ODEInterface::JacFn mJacFunction;
+		std::vector<CPS::ODEInterface::StSpFn> mStSpFunctions;
+		std::vector<CPS::ODEInterface::JacFn> mJacFunctions;
 
 		/// use wrappers similar to DAE_Solver
 		static int StateSpaceWrapper(realtype t, N_Vector y, N_Vector ydot, void *user_data);
@@ -74,21 +95,34 @@ namespace DPsim {
 		                           N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
 		int Jacobian(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
 		             N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+		/// Creates the Jacobian matrix and linear solver and attaches them to ARKode
+		void createLinearSolver();
+		/// Compresses the block diagonal Jacobian pattern of the components
+		void initializeJacobianPattern();
+		/// Evaluates the Jacobian blocks of all components
+		void evaluateJacobianBlocks(realtype t, N_Vector y, N_Vector fy,
+		                            N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
 		/// ARKode- standard error detection function; in DAE-solver not detection function is used -> for efficiency purposes?
 		int check_flag(void *flagvalue, const std::string &funcname, int opt);
 
 	public:
 		/// Create solve object with corresponding component and information on the integration type
 		ODESolver(String name, const CPS::ODEInterface::Ptr &comp, bool implicit_integration, Real timestep);
+		/// Create solve object which integrates all components together
+		ODESolver(String name, const CPS::ODEInterface::List &comps, bool implicit_integration, Real timestep);
 		/// Deallocate all memory
 		~ODESolver();
+		/// Select the linear solver of the implicit integration
+		void setLinearSolver(SundialsLinearSolver linearSolver);
 
 		class SolveTask : public CPS::Task {
 		public:
 			SolveTask(ODESolver& solver)
 			: Task(solver.mName + ".Solve"), mSolver(solver) {
-				mAttributeDependencies.push_back(solver.mComponent->mOdePreState);
-				mModifiedAttributes.push_back(solver.mComponent->mOdePostState);
+				for (auto comp : solver.mComponents) {
+					mAttributeDependencies.push_back(comp->mOdePreState);
+					mModifiedAttributes.push_back(comp->mOdePostState);
+				}
 			}
 
 			void execute(Real time, Int timeStepCount);
@@ -0,0 +1,40 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+
+#include <vector>
+
+namespace DPsim {
+	/// Scheduler creating one OpenMP task per task of the dependency graph, with
+	/// a dependency on each predecessor instead of a barrier after each level.
+	/// The tasks are prioritized by their HLFET priority, which is based on the
+	/// measured costs if a measurement file is given.
+	class OpenMPTaskScheduler : public Scheduler {
+	public:
+		OpenMPTaskScheduler(Int threads = -1, String outMeasurementFile = String(), String inMeasurementFile = String());
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void stop();
+
+	private:
+		Int mNumThreads;
+		String mOutMeasurementFile;
+		String mInMeasurementFile;
+		/// Scheduled tasks in topological order
+		CPS::Task::List mTasks;
+		/// Indices of the predecessors of each task
+		std::vector<std::vector<Int>> mPredecessors;
+		/// OpenMP task priority of each task
+		std::vector<Int> mPriorities;
+		/// One dependency object per task, only their addresses are used
+		std::vector<char> mDependencies;
+	};
+};
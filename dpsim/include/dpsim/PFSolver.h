@@ -13,6 +13,8 @@
 
 #include <dpsim/Solver.h>
 #include <dpsim/Scheduler.h>
+#include <dpsim/DirectLinearSolver.h>
+#include <dpsim/DirectLinearSolverConfiguration.h>
 #include "dpsim-models/SystemTopology.h"
 #include "dpsim-models/Components.h"
 
@@ -46,8 +48,20 @@ namespace DPsim {
         /// Admittance matrix
         CPS::SparseMatrixCompRow mY;
 
-        /// Jacobian matrix
-        CPS::Matrix mJ;
+        /// Jacobian matrix, its sparsity pattern is kept between iterations
+        SparseMatrix mJ;
+        /// Implementation of the linear solver for the Jacobian
+        DirectLinearSolverImpl mImplementationInUse = DirectLinearSolverImpl::SparseLU;
+        /// Configuration of the linear solver for the Jacobian
+        DirectLinearSolverConfiguration mConfigurationInUse;
+        /// Linear solver for the Jacobian, created on initialization
+        std::shared_ptr<DirectLinearSolver> mJacobianSolver;
+        /// Set once the sparsity pattern of the Jacobian has been analyzed
+        /// and factorized, later iterations only refactorize
+        CPS::Bool mJacobianPatternAnalyzed = false;
+        /// Right hand side and increments of the linear solve, reused between iterations
+        Matrix mJacobianRightSide;
+        Matrix mJacobianSolution;
         /// Solution vector
         CPS::Vector mX;
 	    /// Vector of mismatch values
@@ -84,6 +98,19 @@ namespace DPsim {
 		CPS::Real mBaseApparentPower;
         /// Convergence flag
         CPS::Bool isConverged = false;
+        /// Start each step from the solution of the previous step if it converged
+        CPS::Bool mWarmStart = false;
+        /// Keep the factorized Jacobian for further iterations and steps
+        /// while the mismatch contracts fast enough (dishonest Newton)
+        CPS::Bool mJacobianReuse = false;
+        /// Largest ratio of the mismatch norms of two iterations for which the Jacobian is kept
+        CPS::Real mJacobianReuseContraction = 0.25;
+        /// Set by admittance matrix updates, so that a reused Jacobian is refreshed
+        CPS::Bool mAdmittanceMatrixChanged = false;
+        /// Number of Jacobian factorizations since initialization
+        CPS::UInt mNumFactorizations = 0;
+        /// Number of linear solves since initialization
+        CPS::UInt mNumSolves = 0;
         /// Flag whether solution vectors are initialized
         CPS::Bool solutionInitialized = false;
         /// Flag whether complex solution vectors are initialized
@@ -93,7 +120,8 @@ namespace DPsim {
         virtual void generateInitialSolution(Real time, bool keep_last_solution = false) = 0;
         /// Calculate mismatch
         virtual void calculateMismatch() = 0;
-        /// Calculate the Jacobian
+        /// Calculate the Jacobian. Its sparsity pattern must not change after
+        /// the first call, the pattern is reset on initialization.
         virtual void calculateJacobian() = 0;
         /// Update solution in each iteration
         virtual void updateSolution() = 0;
@@ -113,14 +141,25 @@ namespace DPsim {
         /// Determine base voltages for each node
         void determineNodeBaseVoltages();
 
+        /// Create a linear solver of the selected implementation
+        std::shared_ptr<DirectLinearSolver> createLinearSolver();
+        /// Compose the susceptance matrix -Im(Y) for the given buses, as used by the
+        /// decoupled and DC formulations. Without shunts, the diagonal is the sum of
+        /// the branch susceptances, so that it only depends on the series reactances.
+        void composeSusceptanceMatrix(const std::vector<CPS::UInt>& buses, Bool withShunts, SparseMatrix& matrix);
         /// Compose admittance matrix
 		void composeAdmittanceMatrix();
+        /// Patch the admittance matrix in place with the changes of lines and
+        /// transformers since they were stamped, e.g. of tap ratios or line
+        /// status. The sparsity pattern and with it the symbolic analysis of the
+        /// Jacobian stay valid. Returns whether the admittance matrix changed.
+        virtual Bool updateAdmittanceMatrix();
         /// Gets the real part of admittance matrix element
         CPS::Real G(int i, int j);
         /// Gets the imaginary part of admittance matrix element
         CPS::Real B(int i, int j);
         /// Solves the powerflow problem
-        Bool solvePowerflow();
+        virtual Bool solvePowerflow();
         /// Check whether below tolerance
         CPS::Bool checkConvergence();
         /// Logging for integer vectors
@@ -147,11 +186,36 @@ namespace DPsim {
         void modifyPowerFlowBusComponent(CPS::String name, CPS::PowerflowBusType powerFlowBusType);
         /// set solver and component to initialization or simulation behaviour
 		void setSolverAndComponentBehaviour(Solver::Behaviour behaviour) override;
+        /// Set the tolerance of the mismatch
+        void setTolerance(Real tolerance) { mTolerance = tolerance; }
+        /// Set the maximum number of iterations per step
+        void setMaxIterations(CPS::UInt maxIterations) { mMaxIterations = maxIterations; }
+        /// Start each step from the solution of the previous step, useful for quasi-static time series
+        void doWarmStart(Bool value) { mWarmStart = value; }
+        /// Only recompute and refactorize the Jacobian if an iteration reduces the
+        /// mismatch norm by less than the given factor. The factorization is also
+        /// kept between steps, so a step with a small change of the injections
+        /// usually needs only a few solves.
+        void doJacobianReuse(Bool value, Real contraction = 0.25) {
+            mJacobianReuse = value;
+            mJacobianReuseContraction = contraction;
+        }
+        /// Log the number of Jacobian factorizations and linear solves
+        void logLUTimes() override;
+        /// Select the linear solver for the Jacobian, call before initialization
+        void setDirectLinearSolverImplementation(DirectLinearSolverImpl implementation);
+        /// Set the configuration of the linear solver for the Jacobian, call before initialization
+        void setDirectLinearSolverConfiguration(DirectLinearSolverConfiguration& configuration) override;
 
         class SolveTask : public CPS::Task {
 		public:
 			SolveTask(PFSolver& solver) :
 				Task(solver.mName + ".Solve"), mSolver(solver) {
+				// Solve after load profiles were applied, e.g. by a Signal::LoadProfileEngine
+				for (auto load : solver.mLoads) {
+					mAttributeDependencies.push_back(load->mActivePower);
+					mAttributeDependencies.push_back(load->mReactivePower);
+				}
 				mModifiedAttributes.push_back(Scheduler::external);
 			}
 
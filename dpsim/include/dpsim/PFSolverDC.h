@@ -0,0 +1,45 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/PFSolverPowerPolar.h>
+
+namespace DPsim {
+    /// DC powerflow solver.
+    ///
+    /// Linear approximation assuming flat voltage magnitudes, small angle
+    /// differences and negligible resistances: the angles of the PQ and PV
+    /// buses follow from one solve of B' D = P with the susceptance matrix
+    /// B' factorized on initialization. The voltage magnitudes of PQ buses
+    /// are one, those of PV and VD buses the set points. Slack power, reactive
+    /// powers and branch flows are evaluated from these voltages with the
+    /// full admittance matrix.
+    class PFSolverDC : public PFSolverPowerPolar {
+    protected:
+        /// Susceptance matrix without shunts for the PQ and PV buses
+        SparseMatrix mBPrime;
+        /// Factorization of mBPrime
+        std::shared_ptr<DirectLinearSolver> mBPrimeSolver;
+        /// Specified active powers and resulting angles
+        Matrix mPowerRightSide, mAngles;
+
+        /// Solves the linear DC powerflow problem
+        Bool solvePowerflow() override;
+        /// Also refactorizes B' with the changed admittances
+        Bool updateAdmittanceMatrix() override;
+    public:
+        /// Constructor to be used in simulation examples.
+        PFSolverDC(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep, CPS::Logger::Level logLevel);
+        ///
+        virtual ~PFSolverDC() { };
+
+        /// Initialization of the solver and factorization of B'
+        void initialize() override;
+    };
+}
@@ -0,0 +1,51 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/PFSolverPowerPolar.h>
+
+namespace DPsim {
+    /// Fast decoupled powerflow solver.
+    ///
+    /// Alternates between solving B' dD = dP / V for the angles of the PQ and
+    /// PV buses and B'' dV = dQ / V for the magnitudes of the PQ buses. Both
+    /// matrices are constant, they are factorized once on initialization
+    /// and each iteration costs two solves. B' neglects the shunt
+    /// susceptances, B'' includes them. The iterations converge linearly, so
+    /// more of them are allowed than for Newton-Raphson.
+    class PFSolverFastDecoupled : public PFSolverPowerPolar {
+    protected:
+        /// Susceptance matrix of the P-D subproblem
+        SparseMatrix mBPrime;
+        /// Susceptance matrix of the Q-V subproblem
+        SparseMatrix mBDoublePrime;
+        /// Factorization of mBPrime
+        std::shared_ptr<DirectLinearSolver> mBPrimeSolver;
+        /// Factorization of mBDoublePrime, not created without PQ buses
+        std::shared_ptr<DirectLinearSolver> mBDoublePrimeSolver;
+        /// Right hand sides and increments of the two subproblems
+        Matrix mAngleRightSide, mAngleIncrement;
+        Matrix mMagnitudeRightSide, mMagnitudeIncrement;
+
+        /// Factorize a constant matrix with a new solver instance
+        std::shared_ptr<DirectLinearSolver> factorizeConstantMatrix(SparseMatrix& matrix);
+        /// Solves the powerflow problem with decoupled iterations
+        Bool solvePowerflow() override;
+        /// Also refactorizes B' and B'' with the changed admittances
+        Bool updateAdmittanceMatrix() override;
+    public:
+        /// Constructor to be used in simulation examples.
+        PFSolverFastDecoupled(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep, CPS::Logger::Level logLevel);
+        ///
+        virtual ~PFSolverFastDecoupled() { };
+
+        /// Initialization of the solver and factorization of B' and B''
+        void initialize() override;
+    };
+}
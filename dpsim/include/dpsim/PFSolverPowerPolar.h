@@ -30,6 +30,33 @@ namespace DPsim {
         CPS::Vector Pesp;
         CPS::Vector Qesp;
 
+        /// Positions of Jacobian entries in the value array of mJ,
+        /// one for each of the blocks J1 to J4, negative if the entry does not exist
+        struct JacobianSlots {
+            CPS::Int block[4];
+        };
+        /// Slots of the off-diagonal entries, by nonzero of mY in row-major order
+        std::vector<JacobianSlots> mJacobianOffDiagonal;
+        /// Slots of the diagonal entries, by position in mPQPVBusIndices
+        std::vector<JacobianSlots> mJacobianDiagonal;
+
+        /// Real and imaginary parts of the bus voltages, computed from sol_V and sol_D
+        /// once per evaluation instead of a sine and cosine per admittance matrix entry
+        CPS::Vector mVoltageReal;
+        CPS::Vector mVoltageImag;
+        /// Element admittance matrices in the order of mLines and mTransformers
+        std::vector<CPS::MatrixComp> mLineAdmittances;
+        std::vector<CPS::MatrixComp> mTransformerAdmittances;
+        /// Terminal voltages, currents and flows, reused for all branches
+        CPS::VectorComp mBranchVoltage;
+        CPS::VectorComp mBranchCurrent;
+        CPS::VectorComp mBranchFlow;
+        /// Generators in PV mode, by position in mPVBusIndices
+        std::vector<std::vector<std::shared_ptr<CPS::SP::Ph1::SynchronGenerator>>> mPVBusGenerators;
+        /// Line or, if no line is connected, transformer storing the nodal injection, by position in mSystem.mNodes
+        std::vector<std::shared_ptr<CPS::SP::Ph1::PiLine>> mInjectionLines;
+        std::vector<std::shared_ptr<CPS::SP::Ph1::Transformer>> mInjectionTransformers;
+
         // Core methods
         /// Generate initial solution for current time step
         void generateInitialSolution(Real time, bool keep_last_solution = false);
@@ -43,6 +70,17 @@ namespace DPsim {
         void calculateMismatch();
 
         // Helper methods
+        /// Creates the sparsity pattern of the Jacobian from the nonzeros of the admittance matrix
+        void initializeJacobianPattern();
+        /// Collects the branch admittances and the components which receive results,
+        /// so that the per step updates need no searches over the topology
+        void initializeResultTargets();
+        /// Also refreshes the element admittances used for the branch flows
+        Bool updateAdmittanceMatrix() override;
+        /// Update mVoltageReal and mVoltageImag from sol_V and sol_D
+        void updateVoltages();
+        /// Complex power injection V_k conj(sum_j Y_kj V_j) of a bus from mVoltageReal and mVoltageImag
+        CPS::Complex S(CPS::UInt k) const;
         /// Resize solution vector
         void resize_sol(CPS::Int n);
         /// Resize complex solution vector
@@ -70,5 +108,7 @@ namespace DPsim {
         PFSolverPowerPolar(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep, CPS::Logger::Level logLevel);
         ///
 		virtual ~PFSolverPowerPolar() { };
+        ///
+        void initialize() override;
     };
 }
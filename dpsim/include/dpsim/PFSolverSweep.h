@@ -0,0 +1,95 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <Eigen/LU>
+
+#include <dpsim/PFSolverPowerPolar.h>
+
+namespace DPsim {
+    /// Backward/forward sweep powerflow solver for radial and weakly meshed grids.
+    ///
+    /// A spanning tree of the lines and transformers is grown from the VD bus
+    /// on initialization. Each iteration sums the load, shunt and branch
+    /// currents from the leaves to the VD bus and then updates the bus voltages
+    /// from the VD bus to the leaves, which costs O(n) and needs no
+    /// factorization. Branches outside of the tree close meshes. They are cut
+    /// and replaced by current injections at both ends, which are corrected
+    /// after each forward sweep with the breakpoint impedance matrix of the
+    /// tree (loop compensation). The reactive power of PV buses is corrected
+    /// with the reactance of the tree path to the VD bus. The iterations
+    /// converge linearly, so more of them are allowed than for Newton-Raphson.
+    class PFSolverSweep : public PFSolverPowerPolar {
+    protected:
+        /// Branch connecting a bus to its parent in the tree. The admittances
+        /// are those of the branch element, with the bus as second terminal.
+        struct TreeBranch {
+            /// Parent bus
+            UInt parent;
+            /// Admittance between the bus and itself, to the parent, and vice versa
+            CPS::Complex self;
+            CPS::Complex toParent;
+            CPS::Complex fromParent;
+            /// Current into the branch at the parent, selfParent V_parent - parentGain J
+            CPS::Complex selfParent;
+            CPS::Complex parentGain;
+        };
+        /// Branch closing a mesh, replaced by current injections at its ends
+        struct Link {
+            UInt from;
+            UInt to;
+            /// Series admittance, minus the admittance between the ends
+            CPS::Complex series;
+            /// Shunt admittances at both ends
+            CPS::Complex shuntFrom;
+            CPS::Complex shuntTo;
+            /// Ratio of the series currents at the two ends
+            CPS::Complex ratio;
+        };
+
+        /// Buses connected to the VD bus in breadth-first order, starting with the VD bus
+        std::vector<UInt> mOrder;
+        /// Branch to the parent, by bus
+        std::vector<TreeBranch> mBranches;
+        /// Admittance of the bus to ground that is not part of a branch, by bus
+        CPS::VectorComp mBusShunts;
+        /// Impedance of the tree path from the VD bus, by bus
+        CPS::VectorComp mPathImpedances;
+        /// Meshes closed by branches outside of the tree
+        std::vector<Link> mLinks;
+        /// Factorized breakpoint impedance matrix plus the link impedances
+        Eigen::PartialPivLU<CPS::MatrixComp> mLinkImpedances;
+        /// Series currents of the links, kept between steps
+        CPS::VectorComp mLinkCurrents;
+
+        /// Complex bus voltages and currents drawn by the subtrees from their parent branches
+        CPS::VectorComp mVoltages;
+        CPS::VectorComp mSubtreeCurrents;
+        /// Reactive powers of the PV buses, kept between steps
+        CPS::Vector mPVReactivePowers;
+
+        /// Builds the tree and links from the element admittances of the
+        /// lines and transformers
+        void buildTree();
+        /// Solves the powerflow problem with sweeps
+        Bool solvePowerflow() override;
+        /// Also rebuilds the tree with the changed admittances
+        Bool updateAdmittanceMatrix() override;
+    public:
+        /// Constructor to be used in simulation examples.
+        PFSolverSweep(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep, CPS::Logger::Level logLevel);
+        ///
+        virtual ~PFSolverSweep() { };
+
+        /// Initialization of the solver and of the tree
+        void initialize() override;
+        /// Number of branches closing meshes, zero for radial grids
+        UInt meshes() const { return static_cast<UInt>(mLinks.size()); }
+    };
+}
@@ -0,0 +1,99 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/DirectLinearSolver.h>
+
+namespace DPsim
+{
+    /// Sparse LU solver for large single networks, which factorizes and
+    /// solves in parallel
+    ///
+    /// The graph of the matrix is partitioned by nested dissection into one
+    /// domain per thread. The separators of all bisection levels form the
+    /// border of a bordered block diagonal form: the domains are only coupled
+    /// through the separator. The domain blocks are factorized and solved
+    /// concurrently by sparse LU. The separator is solved with the dense LU of
+    /// its Schur complement, which the domains contribute to in parallel.
+    /// Matrix indices matched by a maximum transversal, e.g. a voltage source
+    /// current and its node voltage, stay together so that every domain block
+    /// has a zero-free diagonal.
+    class ParallelSparseLUAdapter : public DirectLinearSolver
+    {
+        /// Diagonal block of one domain and its coupling to the separator
+        struct Domain {
+            /// Matrix indices of the domain
+            std::vector<UInt> indices;
+            /// Separator indices coupled to the domain by its columns
+            std::vector<UInt> borderColumns;
+            /// Separator indices coupled to the domain by its rows
+            std::vector<UInt> borderRows;
+            ///
+            CPS::SparseMatrix block;
+            /// Domain rows of the border columns
+            CPS::SparseMatrix columnCoupling;
+            /// Border rows of the domain columns
+            CPS::SparseMatrix rowCoupling;
+            ///
+            Eigen::SparseLU<CPS::SparseMatrix, Eigen::COLAMDOrdering<int> > lu;
+            /// Schur complement contribution of the last factorization
+            Matrix schurUpdate;
+            /// Intermediate solution of the last solve
+            Matrix solution;
+        };
+
+        /// Separator index or index in its domain of every matrix index
+        std::vector<UInt> mLocalIndices;
+        /// Domain of every matrix index, the separator is numDomains
+        std::vector<UInt> mIndexDomains;
+        ///
+        std::vector<std::unique_ptr<Domain>> mDomains;
+        /// Matrix indices of the separator
+        std::vector<UInt> mSeparator;
+        /// Schur complement of the separator
+        Matrix mSchurComplement;
+        ///
+        Eigen::PartialPivLU<Matrix> mSchurLU;
+
+        /// Nested dissection of the matrix graph
+        void partition(const SparseMatrix& systemMatrix, UInt numDomains);
+        /// Copies the matrix entries into the domain and separator blocks
+        void distribute(const SparseMatrix& systemMatrix);
+
+        public:
+        /// Constructor with logging
+        using DirectLinearSolver::DirectLinearSolver;
+
+        /// Destructor
+        ~ParallelSparseLUAdapter() override;
+
+        /// preprocessing function partitioning the matrix and pre-ordering the domain blocks
+        void preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries) override;
+
+        /// factorization function with partial pivoting in the domain blocks and the separator
+        void factorize(SparseMatrix& systemMatrix) override;
+
+        /// refactorization without partial pivoting
+        void refactorize(SparseMatrix& systemMatrix) override;
+
+        /// partial refactorization withouth partial pivoting
+        void partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries) override;
+
+        /// solution function for a right hand side
+        Matrix solve(Matrix& rightSideVector) override;
+
+        /// solution function writing into a preallocated left hand side vector
+        void solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector) override;
+    };
+}
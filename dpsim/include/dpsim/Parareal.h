@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <dpsim/Checkpoint.h>
+#include <dpsim/Executor.h>
+#include <dpsim/Simulation.h>
+
+namespace DPsim {
+	/// \brief Parareal time-parallel integration for offline studies
+	///
+	/// The time span of the simulation is split into slices. A coarse
+	/// simulation, e.g. with a larger time step or in the quasi-dynamic mode,
+	/// propagates the state over all slices sequentially, while one fine
+	/// simulation per slice propagates it with the regular time step, all
+	/// slices concurrently. Each iteration corrects the states at the slice
+	/// boundaries with the difference of the fine and the coarse propagation
+	/// of the previous iteration,
+	///
+	///   U[n+1] = G(U[n]) + F(U_prev[n]) - G(U_prev[n]),
+	///
+	/// until they change less than the tolerance. After k iterations the first
+	/// k slices are exact, so the fine simulations of converged slices are not
+	/// run again. The speedup is bounded by the number of slices divided by the
+	/// number of iterations.
+	///
+	/// The states are exchanged as checkpoints, so all simulations must be
+	/// created for the same topology and final time. Real and complex values
+	/// are corrected, integer and boolean values like switch states are taken
+	/// from the fine propagation. The loggers of a fine simulation hold its
+	/// slice of the last iteration in which it was run.
+	class Parareal {
+	public:
+		typedef std::shared_ptr<Parareal> Ptr;
+		/// Creates a simulation that is not initialized yet, the coarse one if
+		/// the argument is true
+		typedef std::function<Simulation::Ptr(Bool coarse)> Factory;
+
+		/// Logger
+		CPS::Logger::Log mLog;
+
+		Parareal(String name, Factory factory, UInt numSlices,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		/// Runs the fine simulations on the workers of the executor, OpenMP is used if not set
+		void setExecutor(Executor::Ptr executor) { mExecutor = executor; }
+		/// Largest change of a boundary value between two iterations, relative
+		/// to the magnitude of values above one
+		void setTolerance(Real tolerance) { mTolerance = tolerance; }
+		/// Maximum number of iterations, the number of slices by default
+		void setMaxIterations(UInt maxIterations) { mMaxIterations = maxIterations; }
+
+		/// Creates and initializes the simulations and computes the slice boundaries
+		void initialize();
+		/// Iterates until the boundary states converged
+		void run();
+
+		// #### Getter ####
+		String name() const { return mName; }
+		UInt numSlices() const { return mNumSlices; }
+		/// Iterations of the last run, each running the fine simulations of the unconverged slices
+		UInt iterations() const { return mIterations; }
+		Bool converged() const { return mConverged; }
+		/// Largest relative change of a boundary value in the last iteration
+		Real residual() const { return mResidual; }
+		/// States at the boundaries of the slices, from the initial to the final state
+		const std::vector<Checkpoint>& boundaryStates() const { return mStates; }
+		Simulation::Ptr coarseSimulation() { return mCoarse; }
+		std::vector<Simulation::Ptr>& fineSimulations() { return mFine; }
+
+	protected:
+		/// Restores the state into the simulation and steps over the slice
+		Checkpoint propagate(Simulation::Ptr simulation, const Checkpoint& state, UInt slice, UInt steps);
+		/// Sets the state to coarse + fine - previousCoarse and returns the largest
+		/// relative change to the previous state
+		Real correct(Checkpoint& state, const Checkpoint& coarse, const Checkpoint& fine, const Checkpoint& previousCoarse) const;
+
+		String mName;
+		Factory mFactory;
+		UInt mNumSlices;
+		Executor::Ptr mExecutor;
+		Real mTolerance = 1e-6;
+		UInt mMaxIterations = 0;
+		///
+		Bool mInitialized = false;
+
+		Simulation::Ptr mCoarse;
+		/// One fine simulation per slice
+		std::vector<Simulation::Ptr> mFine;
+		/// Start time of each slice and the final time
+		std::vector<Real> mBoundaries;
+		/// Steps of each slice with the coarse and the fine time step
+		std::vector<UInt> mCoarseSteps;
+		std::vector<UInt> mFineSteps;
+
+		/// Corrected states at the slice boundaries
+		std::vector<Checkpoint> mStates;
+		/// Coarse propagations of the states of the previous iteration, by end boundary
+		std::vector<Checkpoint> mCoarseStates;
+		/// Fine propagations of the states of the previous iteration, by end boundary
+		std::vector<Checkpoint> mFineStates;
+
+		UInt mIterations = 0;
+		Bool mConverged = false;
+		Real mResidual = 0;
+	};
+}
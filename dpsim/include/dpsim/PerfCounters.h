@@ -0,0 +1,49 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// \brief Hardware performance counters of the calling thread
+	///
+	/// The counters are opened as one group with perf_event_open on the first use
+	/// in a thread, so that they are read consistently by a single system call.
+	/// Only user space events are counted. If the counters can not be opened,
+	/// e.g. on other platforms or due to the perf_event_paranoid setting,
+	/// all values read are zero.
+	class PerfCounters {
+	public:
+		enum Event { Cycles, Instructions, CacheMisses, BranchMisses, NumEvents };
+		typedef std::array<uint64_t, NumEvents> Values;
+
+		/// Counters of the calling thread
+		static PerfCounters& thread();
+		/// Names of the events, used as column names
+		static const char* eventName(UInt event);
+
+		PerfCounters(const PerfCounters&) = delete;
+		PerfCounters& operator=(const PerfCounters&) = delete;
+		~PerfCounters();
+
+		Bool available() const { return mGroupFd >= 0; }
+		/// Current counts since the counters were opened
+		Values read() const;
+
+	private:
+		PerfCounters();
+
+		/// File descriptor of the group leader, -1 if unavailable
+		int mGroupFd = -1;
+		std::array<int, NumEvents> mFds;
+	};
+}
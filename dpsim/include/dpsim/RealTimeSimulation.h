@@ -11,6 +11,7 @@
 #include <signal.h>
 
 #include <chrono>
+#include <functional>
 
 #include <dpsim/Config.h>
 #include <dpsim/Simulation.h>
@@ -20,13 +21,107 @@ namespace DPsim {
 	/// Extending Simulation class by real-time functionality.
 	class RealTimeSimulation : public Simulation {
 
+	public:
+		/// \brief Measure to stay in real time while the slack of the steps is low
+		///
+		/// The slack is the time left until the deadline of the next step after a
+		/// step has been computed. A policy is engaged once the slack has been below
+		/// its threshold, a fraction of the time step, for a number of consecutive
+		/// steps, and released once it has been above the threshold plus a margin.
+		/// Both callbacks run on the simulation thread between two steps.
+		struct DegradationPolicy {
+			String name;
+			Real threshold;
+			std::function<void()> engage;
+			std::function<void()> release;
+			Bool engaged = false;
+			/// Consecutive steps below the threshold and above threshold plus margin
+			UInt stepsLow = 0;
+			UInt stepsHigh = 0;
+		};
+
 	protected:
 		Timer mTimer;
 
+		/// SCHED_FIFO priority of the simulation thread, 0 keeps the current policy
+		Int mRealTimePriority = 0;
+		/// Lock all pages of the process into memory before the start
+		Bool mLockMemory = false;
+		/// Dry steps computed before the start to perform the lazy allocations
+		UInt mWarmUpSteps = 0;
+		/// Report the heap allocations of the steps after the warm-up
+		Bool mTrackAllocations = false;
+		/// Number of allocating steps which are logged individually
+		static constexpr Int AllocationReports = 10;
+
+		std::vector<DegradationPolicy> mDegradationPolicies;
+		UInt mEngageSteps = 1;
+		UInt mReleaseSteps = 1000;
+		Real mReleaseMargin = 0.1;
+
+		void setupRealTime();
+		/// Computes the warm-up steps and rewinds the state to the start
+		void warmUp();
+		/// Steps the simulation, checking for allocations if enabled
+		void trackedStep();
+		void updateTimerAttributes();
+		/// Updates the slack attributes and engages or releases the degradation policies
+		void monitorSlack();
+		void releaseDegradationPolicies();
+
 	public:
+		/// Number of missed time steps
+		const CPS::Attribute<Int>::Ptr mOverruns;
+		/// Wake-up latency of the last, the worst and the average step in seconds
+		const CPS::Attribute<Real>::Ptr mLatencyLast;
+		const CPS::Attribute<Real>::Ptr mLatencyMax;
+		const CPS::Attribute<Real>::Ptr mLatencyMean;
+		/// Slack of the last and the tightest step in seconds, negative for an overrun
+		const CPS::Attribute<Real>::Ptr mSlack;
+		const CPS::Attribute<Real>::Ptr mSlackMin;
+		/// Number of engaged degradation policies
+		const CPS::Attribute<Int>::Ptr mDegradedPolicies;
+		/// Steps which allocated on the heap after the warm-up, if tracked
+		const CPS::Attribute<Int>::Ptr mAllocatingSteps;
+
 		/// Standard constructor
 		RealTimeSimulation(String name, CPS::Logger::Level logLevel = CPS::Logger::Level::info);
 
+		/// Spin on the clock between the steps instead of sleeping.
+		/// Recommended for time steps below 50 us on an isolated core.
+		void setBusyWait(Bool busyWait = true);
+		/// Runs the simulation thread with the given SCHED_FIFO priority
+		void setRealTimePriority(Int priority) { mRealTimePriority = priority; }
+		/// Locks the memory of the process to avoid page faults during the run
+		void setLockMemory(Bool lock = true) { mLockMemory = lock; }
+		/// Computes the given number of steps before the start, without loggers,
+		/// interfaces and events, and rewinds the state afterwards. Solvers and
+		/// components then have made their lazy allocations before the first
+		/// real-time step. Only state held in attributes is rewound, like for
+		/// checkpoints, so components with other internal state should be avoided.
+		void setWarmUp(UInt steps) { mWarmUpSteps = steps; }
+		/// Reports steps which allocate on the heap after the warm-up.
+		/// Requires a build with WITH_ALLOCATION_TRACKING and only sees the
+		/// allocations of the simulation thread, not of scheduler workers.
+		void setTrackAllocations(Bool track = true) { mTrackAllocations = track; }
+
+		// #### Degradation policies ####
+		/// Registers a policy which is engaged while the slack is below threshold times the time step
+		void addDegradationPolicy(const String& name, Real threshold,
+			std::function<void()> engage, std::function<void()> release);
+		/// Pauses all data loggers of the simulation
+		void addLoggerPausePolicy(Real threshold);
+		/// Multiplies the downsampling of all data loggers of the simulation by factor
+		void addLoggerDownsamplingPolicy(Real threshold, UInt factor);
+		/// Keeps the current linearization of variable components in the solvers
+		void addFreezePolicy(Real threshold);
+		/// Skips the exports of a non-critical interface
+		void addExportSuspendPolicy(Interface::Ptr intf, Real threshold);
+		/// @param engageSteps Consecutive steps below the threshold before a policy is engaged
+		/// @param releaseSteps Consecutive steps above threshold plus margin before it is released
+		/// @param margin Hysteresis as fraction of the time step
+		void setDegradationHysteresis(UInt engageSteps, UInt releaseSteps, Real margin);
+
 		/** Perform the main simulation loop in real time.
 		 *
 		 * @param startSynch If true, the simulation waits for the first external value before starting the timing.
@@ -11,6 +11,11 @@
 #include <dpsim-models/Task.h>
 
 #include <dpsim/Definitions.h>
+#include <dpsim/Executor.h>
+#include <dpsim/PerfCounters.h>
+#include <dpsim/StepPhases.h>
+#include <dpsim/TaskGraphCache.h>
+#include <dpsim/Tracer.h>
 #include <dpsim-models/Logger.h>
 
 #include <atomic>
@@ -18,8 +23,13 @@
 #include <condition_variable>
 #include <deque>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
 
+#if defined(__x86_64__) || defined(__i386__)
+  #include <immintrin.h>
+#endif
+
 namespace DPsim {
 	// TODO extend / subclass
 	class SchedulingException {};
@@ -51,11 +61,49 @@ namespace DPsim {
 		virtual void step(Real time, Int timeStepCount) = 0;
 		/// Called on simulation stop to reliably clean up e.g. running helper threads
 		virtual void stop() {}
+		/// Continues the schedule with the given time step count, e.g. after a
+		/// reset of the simulation. Threads ended by stop() are started again.
+		virtual void restart(Int timeStepCount) {}
+		/// Replaces the schedule between two steps, e.g. after the tasks changed
+		/// with a topology edit, and continues with the given time step count
+		virtual void recreateSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges, Int timeStepCount) {
+			createSchedule(tasks, inEdges, outEdges);
+			restart(timeStepCount);
+		}
 
 		/// Helper function that resolves the task-attribute dependencies to task-task dependencies
 		/// and inserts a root task
 		void resolveDeps(CPS::Task::List& tasks, Edges& inEdges, Edges& outEdges);
 
+		/// Reuse the task dependencies resolved for a task list with the same structure
+		void setTaskGraphCache(TaskGraphCache::Ptr cache) { mTaskGraphCache = cache; }
+
+		/// Merge chains and groups of sibling tasks whose summed cost stays below the threshold
+		/// into fused tasks before scheduling. The costs are read from a measurement file,
+		/// without a file every task costs one, so the threshold is the number of fused tasks.
+		/// A threshold of zero disables the fusion.
+		void setTaskFusion(TaskTime::rep threshold, String inMeasurementFile = String()) {
+			mFusionThreshold = threshold;
+			mFusionMeasurementFile = inMeasurementFile;
+		}
+
+		/// Rewrites the resolved task graph by merging cheap tasks if task fusion is enabled
+		void fuseTasks(CPS::Task::List& tasks, Edges& inEdges, Edges& outEdges);
+
+		/// Orders connected tasks, like the blocks of a control diagram, once by their
+		/// attribute dependencies and fuses them into one task. The fused task only
+		/// depends on the attributes that are not modified by the tasks themselves.
+		/// Returns nullptr if the dependencies between the tasks are cyclic.
+		static CPS::Task::Ptr fuseTaskGraph(const CPS::Task::List& tasks);
+
+		/// Replace independent tasks of the same batch key, like the post steps of all
+		/// inductors in a level of the task graph, by one batched task before scheduling
+		void setTaskBatching(Bool batching) { mTaskBatching = batching; }
+		Bool taskBatching() const { return mTaskBatching; }
+
+		/// Rewrites the resolved task graph by batching tasks if task batching is enabled
+		void batchTasks(CPS::Task::List& tasks, Edges& inEdges, Edges& outEdges);
+
 		// Special attribute that can be returned in the modified attributes of a task
 		// to mark that this task has external side-effects (like logging / interfacing)
 		// and thus has to be executed even though it doesn't modify any attribute.
@@ -66,6 +114,26 @@ namespace DPsim {
 			return getAveragedMeasurement(task.get());
 		}
 
+		/// Records the start and end of every task execution in the given tracer,
+		/// which needs a buffer for each thread of the scheduler
+		void setTracer(Tracer::Ptr tracer) { mTracer = tracer; }
+
+		/// Keep an exponentially weighted moving average of the execution time per task
+		/// instead of all measurements, smoothing is the weight of a new measurement
+		void setMeasurementSmoothing(Real smoothing) { mMeasurementSmoothing = smoothing; }
+
+		/// Read the hardware performance counters around each measured task execution.
+		/// The counts are summed per task type and written next to the measurements.
+		void setPerfCounters(Bool enable) { mPerfCounters = enable; }
+
+		/// Adds the execution time of each task to its phase of the step
+		void setStepPhases(StepPhases::Ptr phases) { mStepPhases = phases; }
+
+		/// Runs the threads of the scheduler on the cores of the executor, thread i
+		/// on its core i. Must be called before the schedule is created.
+		void setExecutor(Executor::Ptr executor) { mExecutor = executor; }
+		Executor::Ptr executor() const { return mExecutor; }
+
 		/// Root task that has a dependency on the external attribute
 		/// which means that it should not be removed from the task graph
 		class Root : public CPS::Task {
@@ -94,8 +162,44 @@ namespace DPsim {
 		void writeMeasurements(CPS::String filename);
 		/// Read measurement data from file to use it for the scheduling
 		void readMeasurements(CPS::String filename, std::unordered_map<CPS::String, TaskTime::rep>& measurements);
+		/// Reads the task costs from a measurement file, or assigns a constant cost
+		/// to each task if no file is given
+		void readTaskCosts(CPS::String filename, const CPS::Task::List& tasks, std::unordered_map<CPS::String, TaskTime::rep>& costs);
+		/// Computes the HLFET priority of each task of a topologically sorted list,
+		/// which is the cost of the longest path from the task to the end of the step
+		static void hlfetPriorities(const CPS::Task::List& tasks, const Edges& outEdges,
+			const std::unordered_map<CPS::String, TaskTime::rep>& costs, std::unordered_map<CPS::Task::Ptr, int64_t>& priorities);
 		///
 		TaskTime getAveragedMeasurement(CPS::Task* task);
+		/// Executes a task and records it in the trace and the step phases if enabled
+		void executeTask(CPS::Task* task, Real time, Int timeStepCount, Int thread = 0) {
+			StepPhases::Scope phase(mStepPhases.get(), task);
+			if (!mTracer) {
+				task->execute(time, timeStepCount);
+				return;
+			}
+			auto start = Tracer::now();
+			task->execute(time, timeStepCount);
+			mTracer->record(thread, task, timeStepCount, start, Tracer::now());
+		}
+
+		/// Executes a task and records its execution time, and its hardware counts if enabled
+		void measureTask(CPS::Task* task, Real time, Int timeStepCount, Int thread = 0) {
+			PerfCounters::Values counts;
+			if (mPerfCounters)
+				counts = PerfCounters::thread().read();
+			auto start = std::chrono::steady_clock::now();
+			executeTask(task, time, timeStepCount, thread);
+			auto end = std::chrono::steady_clock::now();
+			updateMeasurement(task, end-start);
+			if (mPerfCounters)
+				updateCounters(task, counts);
+		}
+		/// Adds the counts since start to the counts of the task, with the same
+		/// thread-safety as updateMeasurement
+		void updateCounters(CPS::Task* task, const PerfCounters::Values& start);
+		/// Write the counts summed per task type to file
+		void writeCounters(CPS::String filename);
 
 		///
 		CPS::Task::Ptr mRoot;
@@ -103,11 +207,99 @@ namespace DPsim {
 		CPS::Logger::Level mLogLevel;
 		/// Logger
 		CPS::Logger::Log mSLog;
+		/// Tracer of the task executions, if tracing is enabled
+		Tracer::Ptr mTracer;
+		/// Phases of the step, if the phases are measured
+		StepPhases::Ptr mStepPhases;
+		/// Executor whose cores the threads run on, if any
+		Executor::Ptr mExecutor;
+		/// Cache of resolved task dependencies, if caching is enabled
+		TaskGraphCache::Ptr mTaskGraphCache;
+		/// Weight of a new measurement in the moving average, zero keeps all measurements
+		Real mMeasurementSmoothing = 0;
+		/// Maximum cost of a fused task, zero disables the fusion
+		TaskTime::rep mFusionThreshold = 0;
+		/// Task costs used for the fusion
+		String mFusionMeasurementFile;
+		/// Batch tasks of the same batch key within a level
+		Bool mTaskBatching = false;
+		/// Read the hardware performance counters of measured tasks
+		Bool mPerfCounters = false;
 	private:
 		// TODO more sophisticated measurement method might be necessary for
 		// longer simulations (risk of high memory requirements and integer
 		// overflow)
 		std::unordered_map<CPS::Task*, std::vector<TaskTime>> mMeasurements;
+		/// Moving averages of the execution times if smoothing is used
+		std::unordered_map<CPS::Task*, Real> mMeasurementAverages;
+		/// Hardware counts and number of counted executions per task
+		std::unordered_map<CPS::Task*, std::pair<PerfCounters::Values, UInt>> mCounters;
+	};
+
+	/// \brief Waits on an atomic word in three phases
+	///
+	/// A waiting thread first busy-spins for a calibrated time, then yields the
+	/// processor, and finally sleeps on a futex until it is woken. Wakers only
+	/// issue the wake system call if a thread actually sleeps, so waits that end
+	/// while spinning cost no more than a plain spin loop.
+	class AdaptiveWait {
+	public:
+		/// Sets the duration of the spinning and yielding phases of all adaptive waits
+		static void setBudgets(Real spinMicroseconds, Real yieldMicroseconds);
+
+		/// Waits until done returns true, which must only change after word was
+		/// modified followed by a call to wake
+		template <typename Predicate>
+		void wait(std::atomic<Int>& word, Predicate done) {
+			for (UInt i = 0; i < sSpinIterations; i++) {
+				if (done())
+					return;
+				relax();
+			}
+			auto yieldEnd = std::chrono::steady_clock::now() + sYieldTime;
+			while (std::chrono::steady_clock::now() < yieldEnd) {
+				if (done())
+					return;
+				std::this_thread::yield();
+			}
+			mSleepers.fetch_add(1, std::memory_order_seq_cst);
+			while (true) {
+				Int value = word.load(std::memory_order_seq_cst);
+				if (done())
+					break;
+				sleep(word, value);
+			}
+			mSleepers.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		/// Wakes the threads sleeping on word, must follow a sequentially consistent modification of word
+		void wake(std::atomic<Int>& word) {
+			if (mSleepers.load(std::memory_order_seq_cst) > 0)
+				wakeAll(word);
+		}
+
+	private:
+		/// Hints the processor that the thread is spinning
+		static void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+			_mm_pause();
+#else
+			std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+		}
+		/// Sleeps while word still has the given value
+		static void sleep(std::atomic<Int>& word, Int value);
+		static void wakeAll(std::atomic<Int>& word);
+
+		/// Number of spin iterations of the given duration, measured on this processor
+		static UInt calibrate(Real microseconds);
+
+		/// Number of spin iterations, calibrated to the spin time
+		static UInt sSpinIterations;
+		static std::chrono::nanoseconds sYieldTime;
+
+		/// Number of threads sleeping or about to sleep
+		std::atomic<Int> mSleepers{0};
 	};
 
 	/// A barrier is used to synchronize threads. Threads running into the barrier
@@ -118,9 +310,10 @@ namespace DPsim {
 		/// Constructor without parameters is forbidden.
 		Barrier() = delete;
 		/// Limit sets the number of threads that need to reach the barrier
-		/// to release it.
-		Barrier(Int limit, Bool useCondition = false) :
-			mLimit(limit), mCount(0), mGeneration(0), mUseCondition(useCondition) {}
+		/// to release it. Waits use a mutex and condition variable if useCondition
+		/// is set, an AdaptiveWait if useAdaptiveWait is set and busy-spinning otherwise.
+		Barrier(Int limit, Bool useCondition = false, Bool useAdaptiveWait = false) :
+			mLimit(limit), mCount(0), mGeneration(0), mUseCondition(useCondition), mUseAdaptiveWait(useAdaptiveWait) {}
 
 		/// Blocks until |limit| calls have been made, at which point all threads
 		/// return. Provides synchronization, i.e. all writes from before this call
@@ -148,7 +341,11 @@ namespace DPsim {
 				// (This generates the same code on x86.)
 				if (mCount.fetch_add(1, std::memory_order_acq_rel) == mLimit-1) {
 					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
+					release();
+				} else if (mUseAdaptiveWait) {
+					mWait.wait(mGeneration, [this, gen]() {
+						return mGeneration.load(std::memory_order_acquire) != gen;
+					});
 				} else {
 					while (mGeneration.load(std::memory_order_acquire) == gen);
 				}
@@ -173,12 +370,22 @@ namespace DPsim {
 				// No release here, as this call does not provide any synchronization anyway.
 				if (mCount.fetch_add(1, std::memory_order_acquire) == mLimit-1) {
 					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
+					release();
 				}
 			}
 		}
 
 	private:
+		/// Starts the next generation, waking sleeping threads if adaptive waits are used
+		void release() {
+			if (mUseAdaptiveWait) {
+				mGeneration.fetch_add(1, std::memory_order_seq_cst);
+				mWait.wake(mGeneration);
+			} else {
+				mGeneration.fetch_add(1, std::memory_order_release);
+			}
+		}
+
 		/// Barrier limit which has to be reached before the barrier is released.
 		Int mLimit;
 		/// Barrier counter which is tested against limit
@@ -186,6 +393,8 @@ namespace DPsim {
 		/// Allows multiple use of the barrier
 		std::atomic<Int> mGeneration;
 		Bool mUseCondition;
+		Bool mUseAdaptiveWait;
+		AdaptiveWait mWait;
 
 		std::mutex mMutex;
 		std::condition_variable mCondition;
@@ -201,19 +410,104 @@ namespace DPsim {
 		std::vector<Barrier*> mBarriers;
 	};
 
+	/// Task executing several tasks merged by the task fusion in order
+	class FusedTask : public CPS::Task {
+	public:
+		typedef std::shared_ptr<FusedTask> Ptr;
+
+		FusedTask(const CPS::Task::List& tasks);
+		/// Fused task with the given dependencies instead of the union of the ones of the tasks
+		FusedTask(const CPS::Task::List& tasks, const CPS::AttributeBase::List& attributeDependencies,
+			const CPS::AttributeBase::List& modifiedAttributes, const CPS::AttributeBase::List& prevStepDependencies);
+
+		void execute(Real time, Int timeStepCount) {
+			for (auto& task : mTasks)
+				task->execute(time, timeStepCount);
+		}
+
+		const CPS::Task::List& tasks() const { return mTasks; }
+
+	private:
+		CPS::Task::List mTasks;
+	};
+
+	/// Task of a solver running at a multiple of the simulation time step. The
+	/// task is executed in every multiple-th step with the step count of the
+	/// solver, in the other steps the attributes it modifies keep their values.
+	class MultiRateTask : public CPS::Task {
+	public:
+		typedef std::shared_ptr<MultiRateTask> Ptr;
+
+		MultiRateTask(CPS::Task::Ptr task, UInt multiple);
+
+		void execute(Real time, Int timeStepCount) {
+			if (timeStepCount % mMultiple == 0)
+				mTask->execute(time, timeStepCount / mMultiple);
+		}
+
+		const CPS::Task::Ptr& task() const { return mTask; }
+		UInt multiple() const { return static_cast<UInt>(mMultiple); }
+
+	private:
+		CPS::Task::Ptr mTask;
+		Int mMultiple;
+	};
+
+	/// Task at which a step can be split into two parts, so that work shared
+	/// by several simulations, like a batched solve, can be done in between.
+	/// The first part of the step ends with prepare, the second begins with execute.
+	class SplitTask : public CPS::Task {
+	public:
+		typedef std::shared_ptr<SplitTask> Ptr;
+
+		SplitTask(String name) : Task(name) {}
+
+		/// Work that is done before the step is split
+		virtual void prepare(Real time, Int timeStepCount) = 0;
+	};
+
 	class Counter {
 	public:
 		Counter() : mValue(0) {}
 
 		void inc() {
-			mValue.fetch_add(1, std::memory_order_release);
+			if (mUseAdaptiveWait) {
+				mValue.fetch_add(1, std::memory_order_seq_cst);
+				mWait.wake(mValue);
+			} else {
+				mValue.fetch_add(1, std::memory_order_release);
+			}
 		}
 
+		/// Waits until the counter reached at least the given value
 		void wait(Int value) {
-			while (mValue.load(std::memory_order_acquire) != value);
+			if (mUseAdaptiveWait) {
+				mWait.wait(mValue, [this, value]() {
+					return mValue.load(std::memory_order_acquire) >= value;
+				});
+			} else {
+				while (mValue.load(std::memory_order_acquire) < value);
+			}
+		}
+
+		/// Uses an AdaptiveWait instead of busy-spinning,
+		/// must only be called while no thread waits on the counter
+		void setAdaptiveWait(Bool adaptive) {
+			mUseAdaptiveWait = adaptive;
+		}
+
+		Int get() const {
+			return mValue.load(std::memory_order_acquire);
+		}
+
+		/// Must only be called while no thread waits on the counter
+		void set(Int value) {
+			mValue.store(value, std::memory_order_release);
 		}
 
 	private:
 		std::atomic<Int> mValue;
+		Bool mUseAdaptiveWait = false;
+		AdaptiveWait mWait;
 	};
 }
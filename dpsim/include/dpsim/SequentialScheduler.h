@@ -27,8 +27,18 @@ namespace DPsim {
 		void step(Real time, Int timeStepCount);
 		void stop();
 
+		/// Performs the first part of a simulation step up to and including
+		/// the preparation of the first split task
+		void stepBeforeSplit(Real time, Int timeStepCount);
+		/// Performs the remaining part of a simulation step
+		void stepAfterSplit(Real time, Int timeStepCount);
+		/// Returns true if the schedule contains a split task
+		Bool hasSplitTask() const { return mSplitIndex < mSchedule.size(); }
+
 	private:
 		CPS::Task::List mSchedule;
+		/// Position of the first split task in the schedule
+		std::size_t mSplitIndex = 0;
 
 		std::unordered_map<size_t, std::vector<std::chrono::nanoseconds>> mMeasurements;
 		std::vector<std::chrono::nanoseconds> mStepMeasurements;
@@ -0,0 +1,77 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <dpsim/DataLoggerBackend.h>
+
+namespace DPsim {
+	/// \brief Writes the logged values into a ring buffer in POSIX shared memory
+	///
+	/// The shared memory object is named like the log file without the log
+	/// directory, e.g. /dev/shm/name.shm for a logger with the name "name". It
+	/// starts with a Header, followed by the comma separated column names, which
+	/// include the time, and the ring buffer of capacity rows of doubles. Row n,
+	/// counted from the start of the simulation, is stored in slot n % capacity.
+	///
+	/// Readers map the object read-only. The column layout is valid when the
+	/// sequence is even and non-zero. To read the latest rows, a reader loads
+	/// writeIndex, copies the rows before it and loads writeIndex again: rows
+	/// older than the second writeIndex - capacity + 1 may have been overwritten
+	/// while copying and must be discarded.
+	class SharedMemoryLoggerBackend : public DataLoggerBackend {
+	public:
+		struct Header {
+			/// "DPSIMRB" with a terminating zero
+			char magic[8];
+			uint32_t version;
+			/// Values per row including the time
+			uint32_t columns;
+			/// Rows in the ring buffer
+			uint64_t capacity;
+			/// Byte offsets from the start of the object
+			uint64_t namesOffset;
+			uint64_t namesSize;
+			uint64_t dataOffset;
+			/// Odd while the column layout is written
+			std::atomic<uint64_t> sequence;
+			/// Rows written since the columns were set
+			std::atomic<uint64_t> writeIndex;
+		};
+
+		static constexpr uint32_t Version = 1;
+
+		/// Keeps the given number of latest rows
+		SharedMemoryLoggerBackend(UInt capacity = 65536);
+		~SharedMemoryLoggerBackend();
+
+		String extension() const override { return ".shm"; }
+		Bool open(const fs::path& filename) override;
+		void close() override;
+		Bool hasColumns() const override { return mHeader != nullptr; }
+		void setColumns(const std::vector<String>& names, Notation notation) override;
+		void writeRow(Real time, const Real* values, UInt count) override;
+
+	private:
+		void unmap();
+
+		UInt mCapacity;
+		/// Name of the shared memory object
+		String mName;
+		int mFd = -1;
+		std::size_t mSize = 0;
+		Header* mHeader = nullptr;
+		Real* mData = nullptr;
+		UInt mColumns = 0;
+		/// Rows written, the writer is the only one modifying the index
+		uint64_t mWriteIndex = 0;
+	};
+}
@@ -0,0 +1,94 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Signal/DecouplingLineRemote.h>
+
+namespace DPsim {
+	/// \brief Lock-step channel between two DPsim processes in POSIX shared memory
+	///
+	/// Each side writes records of a fixed number of values with increasing
+	/// indices into its own ring of the shared memory object and reads the
+	/// records of the other side. Reading a record busy-polls until the peer
+	/// has written it, writing busy-polls until the peer has released the
+	/// record which is overwritten. No system call is made after the peers
+	/// have attached, so the handshake costs only a few cache line transfers.
+	///
+	/// Side 0 creates the object, side 1 attaches to it, and the constructor
+	/// returns once both sides are attached. As a DecouplingLineChannel, the
+	/// initial voltage is record 0 and the values after step k are record k + 1.
+	/// The capacity has to exceed twice the line delay in time steps.
+	class ShmemLink :
+		public CPS::Signal::DecouplingLineChannel,
+		public SharedFactory<ShmemLink> {
+	public:
+		typedef std::shared_ptr<ShmemLink> Ptr;
+
+		/// Counters written by one side, kept on their own cache line
+		struct alignas(64) Side {
+			/// See State
+			std::atomic<uint32_t> state;
+			/// Records written
+			std::atomic<uint64_t> written;
+			/// Oldest record of the peer which may still be read
+			std::atomic<uint64_t> released;
+		};
+
+		struct Header {
+			/// "DPSIMLK" with a terminating zero
+			char magic[8];
+			uint32_t version;
+			/// Values per record
+			uint32_t values;
+			/// Records in each ring
+			uint64_t capacity;
+			/// Set by side 0 once the header is written
+			std::atomic<uint32_t> initialized;
+			Side sides[2];
+		};
+
+		enum State : uint32_t { Detached = 0, Attached = 1, Closed = 2 };
+
+		static constexpr uint32_t Version = 1;
+
+		/// Creates (side 0) or attaches to (side 1) the shared memory object
+		/// with the given name and waits for the other side
+		ShmemLink(const String& name, UInt side, UInt values = 4, UInt capacity = 1024);
+		~ShmemLink();
+
+		/// Writes the next record, the index has to increase by one on every call
+		void write(uint64_t index, const Real* values);
+		/// Waits for a record of the peer. The returned values stay valid until the next call.
+		const Real* read(uint64_t index);
+
+		Complex exchangeInitialVoltage(Complex voltage) override;
+		void send(Int timeStepCount, Complex voltage, Complex current) override;
+		void receive(Int timeStepCount, Complex& voltage, Complex& current) override;
+
+	private:
+		void waitForPeer(const std::atomic<uint64_t>& counter, uint64_t minimum) const;
+
+		String mName;
+		UInt mSide;
+		UInt mValues;
+		UInt mCapacity;
+		int mFd = -1;
+		std::size_t mSize = 0;
+		Header* mHeader = nullptr;
+		Real* mOwnRing = nullptr;
+		Real* mPeerRing = nullptr;
+		/// Record passed to write() by the channel functions
+		std::vector<Real> mRecord;
+	};
+}
@@ -3,18 +3,30 @@
 #pragma once
 
 #include "dpsim/MNASolverFactory.h"
+#include <atomic>
+#include <exception>
+#include <thread>
 #include <vector>
 
 #include <dpsim/Config.h>
+#include <dpsim/Checkpoint.h>
 #include <dpsim/DataLogger.h>
 #include <dpsim/Solver.h>
+#include <dpsim/SundialsLinearSolver.h>
 #include <dpsim/Scheduler.h>
 #include <dpsim/Event.h>
+#include <dpsim/Histogram.h>
+#include <dpsim/StepPhases.h>
+#include <dpsim/EventLog.h>
+#include <dpsim/Executor.h>
+#include <dpsim/AdaptiveTimeStep.h>
 #include <dpsim-models/Definitions.h>
 #include <dpsim-models/Logger.h>
 #include <dpsim-models/SystemTopology.h>
 #include <dpsim-models/SimNode.h>
 #include <dpsim-models/Attribute.h>
+#include <dpsim-models/ObjectPool.h>
+#include <dpsim-models/Signal/ProtectionRelay.h>
 #include <dpsim/Interface.h>
 #include <nlohmann/json.hpp>
 
@@ -55,6 +67,9 @@ namespace DPsim {
 		/// By default the initialization is disabled.
 		const CPS::Attribute<Bool>::Ptr mSteadyStateInit;
 
+		/// Voltages of the observed nodes as column vector, see observeNodes()
+		const CPS::Attribute<Matrix>::Ptr mObservedValues;
+
 	protected:
 		/// Time variable that is incremented at every step
 		Real mTime = 0;
@@ -76,7 +91,51 @@ namespace DPsim {
 		/// Simulation log level
 		CPS::Logger::Level mLogLevel;
 		/// (Real) time needed for the timesteps
-		std::vector<Real> mStepTimes;
+		Histogram mStepTimes;
+		/// Time needed for the first part of a step split for a batched solve
+		std::chrono::duration<double> mSplitStepTime;
+		/// Measure the phases of each step
+		Bool mStepPhaseProfiling = false;
+		/// Phases of the steps, if they are measured
+		StepPhases::Ptr mStepPhases;
+		/// Binary log of the diagnostic events of the solvers
+		EventLog::Ptr mEventLog;
+		/// Executor shared by the scheduler, solvers, interfaces and loggers, if any
+		Executor::Ptr mExecutor;
+		/// Largest time step as power of two of the time step, zero disables adaptive time steps
+		UInt mAdaptiveMaxLevel = 0;
+		///
+		Real mAdaptiveRelTol = 1e-3;
+		///
+		Real mAdaptiveAbsTol = 1e-6;
+		/// Steps the error has to allow a larger time step before it is raised
+		UInt mAdaptiveHoldSteps = 10;
+		/// Step size controller, if adaptive time steps are enabled
+		AdaptiveTimeStep::Ptr mAdaptiveTimeStep;
+		/// Executes events between two steps at their instant
+		Bool mEventInterpolation = false;
+		/// Factorizes the system matrices of upcoming switch events in the background
+		Bool mSwitchedMatrixPrefetch = false;
+		/// Time of the events the system matrices were last prefetched for
+		Real mPrefetchedEventTime = -1;
+		/// Factorizes the system matrix after the trip of imminent protection relays in the background
+		Bool mSpeculativeFactorization = false;
+		/// Relays of the system, collected during the initialization
+		std::vector<std::shared_ptr<CPS::Signal::ProtectionRelay>> mProtectionRelays;
+		/// True while a speculative factorization may be pending in the solvers
+		Bool mSpeculating = false;
+		/// Number of tripped relays at the last speculation
+		UInt mTrippedRelays = 0;
+		/// Measured frequency the shift frequency of dynamic phasors follows, if set
+		CPS::Attribute<Real>::Ptr mShiftFrequencySource;
+		/// Deviation of the measured frequency which changes the shift frequency
+		Real mShiftFrequencyTolerance = 0.05;
+		/// Current shift frequency
+		Real mShiftFrequency = 0;
+		/// Angle the shifted frame is ahead of the nominal frame at mShiftTime
+		Real mShiftAngle = 0;
+		Real mShiftTime = 0;
+		UInt mShiftFrequencyChanges = 0;
 
 		// #### Solver Settings ####
 		///
@@ -95,28 +154,132 @@ namespace DPsim {
 		Bool mInitFromNodesAndTerminals = true;
 		/// Enable recomputation of system matrix during simulation
 		Bool mSystemMatrixRecomputation = false;
+		/// Enable sparse assembly of the right side vector
+		Bool mSparseRightVectorAssembly = false;
+		/// Factorize switch state dependent system matrices on first use
+		Bool mLazySwitchedMatrices = false;
+		/// Maximum number of cached switch state dependent system matrices, zero means unbounded
+		UInt mSwitchedMatrixCacheSize = 0;
+		/// Analyze the union of the patterns of all switched system matrices once
+		Bool mSharedSymbolicAnalysis = false;
+		/// Apply changes of the variable system matrix as low-rank corrections
+		Bool mLowRankSystemMatrixUpdates = false;
+		/// Maximum rank of the low-rank correction before a full refactorization is done
+		UInt mLowRankUpdateMaxRank = 12;
+		/// Only restamp the variable elements that changed
+		Bool mIncrementalSystemMatrixStamping = false;
+		/// Update the last solution for sparse changes of the source vector
+		Bool mIncrementalSolve = false;
+		///
+		UInt mIncrementalSolveMaxRows = 8;
+		/// Eliminate the internal nodes of static subnetworks without sources
+		Bool mKronReduction = false;
+		/// Execute the signal components as one task
+		Bool mSignalGraphFusion = false;
+		/// Execute the steps of the EMT companion models on the device
+		Bool mGpuResidentStep = false;
+		///
+		UInt mGpuResidentCopyInterval = 1;
+		/// Generate a solve step specialized to the system matrix
+		Bool mStepGeneration = false;
+		/// Solve the diagonal blocks of the block triangular form of the system matrix in separate tasks
+		Bool mBlockParallelSolve = false;
+		/// Number the matrix node indices in reverse Cuthill-McKee order of the network graph
+		Bool mMatrixNodeReordering = false;
+		/// Maximum number of solves per time step repeated for the corrections of iterative components
+		UInt mMaxCorrectorIterations = 10;
+		/// Initialize the components of the MNA solvers in parallel
+		Bool mParallelComponentInitialization = false;
+		/// Precompute the system matrices of the switch states in parallel
+		Bool mParallelSwitchedMatrixInitialization = false;
+		/// Collapse the reference chains of the attributes after scheduling
+		Bool mAttributeFreezing = true;
+		/// Move the values of the static attributes into contiguous arrays
+		Bool mAttributeArena = false;
+		/// Allocate the solvers, tasks and attributes from a pool of the simulation
+		Bool mObjectPooling = false;
+		/// Initialize each subnet solver on the NUMA node of the thread running its tasks
+		Bool mNumaLocalSubnets = false;
+		/// Pool for the objects created during the initialization
+		CPS::ObjectPool::Ptr mObjectPool;
+		/// Batched linear solver shared with other simulations of the same topology
+		BatchedLinearSolver::Ptr mBatchedLinearSolver;
+		/// Start each power flow step from the solution of the previous step
+		Bool mPowerFlowWarmStart = false;
+		/// Keep the factorized power flow Jacobian between iterations and steps
+		Bool mPowerFlowJacobianReuse = false;
+		/// Multiple of the time step of the fictitious elements of the LIM solver
+		Real mLimLatencyFactor = 1;
+		/// Integrate the ODE components with an implicit method
+		Bool mImplicitODEIntegration = false;
+		/// Linear solver of the implicit ODE and the DAE integration
+		SundialsLinearSolver mODELinearSolver = SundialsLinearSolver::Dense;
+		/// Evaluate the residuals of the DAE components in parallel chunks
+		Bool mParallelDAEResidual = false;
+		/// Integrate all ODE components with one solver instead of one solver per component
+		Bool mAggregatedODEIntegration = false;
+		/// Treat the SP network algebraically and integrate the controllers implicitly
+		Bool mQuasiDynamic = false;
 
 		/// If tearing components exist, the Diakoptics
 		/// solver is selected automatically.
 		CPS::IdentifiedObject::List mTearComponents = CPS::IdentifiedObject::List();
+		/// Number of subnets for the automatic selection of tear components, zero disables it
+		UInt mAutomaticTearingPartitions = 0;
+		/// Minimum delay in time steps of the lines replaced by decoupling lines, zero disables it
+		UInt mLineDecouplingDelaySteps = 0;
+		/// Time step multiples of the solvers by the name of a node or component they contain
+		std::map<String, UInt> mTimeStepMultiples;
+		/// Time step multiple of the solvers without a named node or component
+		UInt mDefaultTimeStepMultiple = 1;
 		/// Determines if the system matrix is split into
 		/// several smaller matrices, one for each frequency.
 		/// This can only be done if the network is composed
 		/// of linear components that do no create cross
 		/// frequency coupling.
 		Bool mFreqParallel = false;
+		/// Relative magnitude below which frequencies of the parallel computation are not solved
+		Real mHarmonicDropTolerance = 0;
 		///
 		Bool mInitialized = false;
+		/// State at the end of the initialization, restored by reset()
+		Checkpoint mInitialState;
+		/// Attributes of the initial state by checkpoint key
+		CPS::AttributeBase::Map mInitialStateAttributes;
+		/// Parameters set by the last reset
+		std::map<String, Real> mParameterOverrides;
+		/// Parameters of the sensitivities by checkpoint key with their relative perturbation
+		std::vector<std::pair<String, Real>> mSensitivityParameters;
 
 		// #### Initialization ####
 		/// steady state initialization time limit
 		Real mSteadStIniTimeLimit = 10;
 		/// steady state initialization accuracy limit
 		Real mSteadStIniAccLimit = 0.0001;
+		/// number of steps extrapolated during steady state initialization
+		UInt mSteadStIniExtrapolationDepth = 0;
 
 		// #### Task dependencies und scheduling ####
 		/// Scheduler used for task scheduling
 		std::shared_ptr<Scheduler> mScheduler;
+		/// Cache of the resolved task dependencies shared with other simulations
+		TaskGraphCache::Ptr mTaskGraphCache;
+		/// Warm-up steps measured with each scheduler candidate, automatic selection is off with zero
+		UInt mAutoSchedulingSteps = 0;
+		/// Largest thread count of the candidates, the hardware concurrency with zero
+		Int mAutoSchedulingMaxThreads = 0;
+		/// Names of the observed nodes with the row of their first value in mObservedValues
+		std::vector<std::pair<String, UInt>> mObservedNodes;
+
+		// #### Background run ####
+		///
+		std::thread mAsyncThread;
+		///
+		std::atomic<Bool> mAsyncRunning { false };
+		///
+		std::atomic<Bool> mAsyncCancel { false };
+		/// Exception thrown by the background run
+		std::exception_ptr mAsyncError;
 		/// List of all tasks to be scheduled
 		CPS::Task::List mTasks;
 		/// Task dependencies as incoming / outgoing edges
@@ -134,6 +297,23 @@ namespace DPsim {
 
 		/// The data loggers
 		DataLogger::List mLoggers;
+		/// Write every logger to its own binary shard from its own thread
+		Bool mShardedLogging = false;
+		/// Loggers writing shards, including the ones of the solvers
+		DataLogger::List mShardLoggers;
+
+		/// Switches the enabled loggers to binary shards and asynchronous writing
+		void setupShardedLogging();
+		/// Passes the sensitivity parameters to the solvers of their components
+		void setupSensitivities();
+		/// Collapse the reference chains of all simulation attributes
+		void freezeAttributes();
+		/// Move the node and component attribute values into an attribute arena
+		void allocateAttributeArena();
+		/// Closes the loggers and writes the index of the shards
+		void closeLoggers();
+		/// Collects the attributes of nodes, components and solvers by checkpoint key
+		CPS::AttributeBase::Map stateAttributes();
 
 		/// Helper function for constructors
 		void create();
@@ -142,9 +322,44 @@ namespace DPsim {
 		void createSolvers();
 		/// Subroutine for MNA only because there are many MNA options
 		template <typename VarType>
-		void createMNASolver();
+		void createMNASolver(CPS::SystemTopology& system, CPS::Domain domain, const String& nameSuffix = "");
+		/// Solves the SP/DP and the EMT part of a hybrid topology with separate MNA solvers
+		void createHybridSolvers();
+		/// Configures the components of the topology for the quasi-dynamic mode
+		void setupQuasiDynamicMode();
 		/// Prepare schedule for simulation
 		void prepSchedule();
+		/// Smallest time step multiple set for the names, the default if none is set
+		UInt timeStepMultiple(const std::vector<String>& names) const;
+		/// Checks the solvers and creates the step size controller
+		void setupAdaptiveTimeStepping();
+		/// Estimates the error of the step, selects the next time step and advances the time
+		void advanceAdaptiveTimeStep();
+		/// Resamples loggers without an output grid to the time step times their downsampling
+		void setLoggerOutputGrids();
+		/// Checks the solvers for event interpolation
+		void setupEventInterpolation();
+		/// Steps over the next event if it lies between the last and the current
+		/// step, returns false without stepping otherwise
+		Bool stepInterpolatedEvent();
+		/// Passes the switch changes of the next events to the solvers, once per event time
+		void prefetchSwitchedMatrices();
+		/// Passes the trips of the imminent protection relays to the solvers and
+		/// discards the speculation once no relay is imminent anymore
+		void speculateProtectionTrips();
+		/// Collects the relays of the system if speculative factorization is enabled
+		void collectProtectionRelays();
+		/// Measures the warm-up steps with each scheduler candidate from the initial
+		/// state and continues from it with the fastest one
+		void selectScheduler();
+		/// Checks the solvers for shift frequency changes
+		void setupShiftFrequencyTracking();
+		/// Moves the shift frequency to the measured frequency if it deviates by more than the tolerance
+		void trackShiftFrequency();
+		/// Interpolates the state of all solvers and saves it as the start of the next interpolation
+		void interpolateStates(Real weight);
+		/// Logs an interpolated state to the loggers which were not paused by the user
+		void logInterpolatedState(Real time, const std::vector<Bool>& paused);
 
 	public:
 		/// Simulation logger
@@ -157,7 +372,8 @@ namespace DPsim {
 		Simulation(String name, CPS::Logger::Level logLevel = CPS::Logger::Level::info);
 
 		/// Desctructor
-		virtual ~Simulation() { }
+		/// Cancels and waits for a background run
+		virtual ~Simulation();
 
 		// #### Simulation Settings ####
 		///
@@ -166,7 +382,10 @@ namespace DPsim {
 		void setTimeStep(Real timeStep) { **mTimeStep = timeStep; }
 		///
 		void setFinalTime(Real finalTime) { **mFinalTime = finalTime; }
-		///
+		/// Domain of the system. A topology with EMT as well as SP/DP nodes, e.g.
+		/// coupled by Signal::HybridInterface, gets an MNA solver per domain, and
+		/// the domain selects SP or DP for its phasor part. The parts can run with
+		/// different time steps, see setTimeStepMultiple().
 		void setDomain(CPS::Domain domain = CPS::Domain::DP) { mDomain = domain; }
 		///
 		void setSolverType(Solver::Type solverType = Solver::Type::MNA) { mSolverType = solverType; }
@@ -184,14 +403,232 @@ namespace DPsim {
 		void setTearingComponents(CPS::IdentifiedObject::List tearComponents = CPS::IdentifiedObject::List()) {
 			mTearComponents = tearComponents;
 		}
+		/// Let a graph partitioner select the tear components which split the
+		/// system into the given number of balanced subnets, usually the number
+		/// of threads. Only used if no tear components are set.
+		void doAutomaticTearing(UInt numPartitions) { mAutomaticTearingPartitions = numPartitions; }
+		/// Replace the DP PiLines with a propagation delay of at least the given
+		/// number of time steps by decoupling lines, so that the subnets between
+		/// them get separate solvers if subnets are split.
+		void doAutomaticLineDecoupling(UInt minDelaySteps) { mLineDecouplingDelaySteps = minDelaySteps; }
+		/// Run the solver of the subnet containing the node or component with the
+		/// given name, or the ODE solver of the component, at a multiple of the
+		/// time step. A subnet with several named objects takes the smallest
+		/// multiple. The subnets exchange values only in the steps they run in,
+		/// the values of a slower subnet are held in between.
+		void setTimeStepMultiple(const String& name, UInt multiple);
+		/// Time step multiple of the solvers without a named node or component
+		void setDefaultTimeStepMultiple(UInt multiple);
 		/// Set the scheduling method
 		void setScheduler(const std::shared_ptr<Scheduler> &scheduler) {
 			mScheduler = scheduler;
 		}
+		/// Select the scheduler and thread count during the initialization. The
+		/// given number of steps is run with the sequential scheduler and with the
+		/// thread level, thread list and OpenMP level schedulers for 2, 4, ...
+		/// threads up to the maximum, and the simulation continues from the initial
+		/// state with the lowest median step time. The trial steps are not logged,
+		/// simulations with interfaces or adaptive time steps keep their scheduler.
+		void doAutomaticScheduling(UInt warmupSteps = 200, Int maxThreads = 0) {
+			mAutoSchedulingSteps = warmupSteps;
+			mAutoSchedulingMaxThreads = maxThreads;
+		}
+		/// Copy the voltages of the given nodes of the system from the solution into
+		/// mObservedValues in every step, which can then be exported as one attribute
+		/// instead of one derived attribute per node. Each phase of a node takes one
+		/// row, or two rows with the real and imaginary part in the SP and DP domains.
+		/// The system has to be set before, the MNA solver is required.
+		void observeNodes(const std::vector<String>& names);
+		/// Reuse the task dependencies resolved by other simulations or runs of the
+		/// same model and solver configuration instead of resolving them again
+		void setTaskGraphCache(TaskGraphCache::Ptr cache) { mTaskGraphCache = cache; }
 		/// Compute phasors of different frequencies in parallel
 		void doFrequencyParallelization(Bool value) { mFreqParallel = value; }
+		/// Skip the solve of a frequency of the parallel computation while the
+		/// magnitude of its source vector is below the tolerance times the one of
+		/// the first frequency. Its solution is zero then. The tasks of the skipped
+		/// frequencies end at once, so the scheduler threads take over other tasks.
+		void setHarmonicDropTolerance(Real tolerance) { mHarmonicDropTolerance = tolerance; }
 		///
 		void doSystemMatrixRecomputation(Bool value) { mSystemMatrixRecomputation = value; }
+		///
+		void doSparseRightVectorAssembly(Bool value) { mSparseRightVectorAssembly = value; }
+		///
+		void doLazySwitchedMatrices(Bool value) { mLazySwitchedMatrices = value; }
+		///
+		void setSwitchedMatrixCacheSize(UInt size) { mSwitchedMatrixCacheSize = size; }
+		/// Stamp the switched system matrices onto the union of their sparsity patterns,
+		/// which is analyzed once, so that only the numeric factorization runs per switch
+		/// state. The analysis is shared by solvers that support it, e.g. KLU, and only
+		/// if the system has no variable components.
+		void doSharedSymbolicAnalysis(Bool value) { mSharedSymbolicAnalysis = value; }
+		/// Factorize the lazily built system matrix of the switch states after the
+		/// next scheduled switch events on a background thread, so that the step of
+		/// the events does not have to factorize it
+		void doSwitchedMatrixPrefetch(Bool value) { mSwitchedMatrixPrefetch = value; }
+		/// Factorize the lazily built system matrix with the switches of all
+		/// protection relays that are imminent to trip opened on a background
+		/// thread. If they trip, the step after the trip uses the factorization,
+		/// otherwise it is discarded once the relays fall back below their
+		/// speculation margin. Shares the background factorization with
+		/// doSwitchedMatrixPrefetch(), the latest request wins.
+		void doSpeculativeFactorization(Bool value) { mSpeculativeFactorization = value; }
+		///
+		void doLowRankSystemMatrixUpdates(Bool value) { mLowRankSystemMatrixUpdates = value; }
+		///
+		void setLowRankUpdateMaxRank(UInt rank) { mLowRankUpdateMaxRank = rank; }
+		///
+		void doIncrementalSystemMatrixStamping(Bool value) { mIncrementalSystemMatrixStamping = value; }
+		/// Solve steps in which only a few entries of the source vector changed, e.g.
+		/// of one source driven by an interface, by adding the changes times the
+		/// columns of the inverse system matrix to the last solution. The columns are
+		/// computed with one solve each on first use. Applies to the precomputed
+		/// switched system matrices.
+		void doIncrementalSolve(Bool value) { mIncrementalSolve = value; }
+		/// Steps with more changed source vector entries are solved fully
+		void setIncrementalSolveMaxRows(UInt rows) { mIncrementalSolveMaxRows = rows; }
+		/// Eliminate the nodes of static subnetworks, which are connected to the rest
+		/// of the grid by a few boundary nodes and contain no switches, variable
+		/// elements or sources, from the precomputed system matrices (Kron reduction).
+		/// Their equivalent is added at the boundary nodes and their voltages are
+		/// reconstructed from the boundary voltages after each solve.
+		void doKronReduction(Bool value) { mKronReduction = value; }
+		/// Order the tasks of the signal components, like the blocks of the
+		/// controllers, once by their attribute dependencies and execute them as
+		/// one task instead of scheduling each block separately
+		void doSignalGraphFusion(Bool value) { mSignalGraphFusion = value; }
+		/// Execute the pre and post steps of the EMT inductors and capacitors as
+		/// kernels on the device of the CUDASparse linear solver, which keeps their
+		/// companion models on the device. Only the source vector of the other
+		/// components and the solution are transferred in each step.
+		void doGpuResidentStep(Bool value) { mGpuResidentStep = value; }
+		/// The interface voltages and currents of the components on the device are
+		/// copied back every given number of steps, e.g. the logging interval, and
+		/// never if zero
+		void setGpuResidentCopyInterval(UInt steps) { mGpuResidentCopyInterval = steps; }
+		/// Generate C code for the assembly of the source vector and the solve with
+		/// the factorized system matrix of the initial switch status, with all rows
+		/// and factor values as literals, and compile and load it at initialization.
+		/// Meant for fixed models, e.g. in hardware-in-the-loop setups. Steps in
+		/// other switch statuses and after parameter or time step changes use the
+		/// configured linear solver.
+		void doStepGeneration(Bool value) { mStepGeneration = value; }
+		/// Factorize the independent diagonal blocks of the block triangular form
+		/// of the MNA system matrix separately and solve them in parallel tasks,
+		/// e.g. the feeders attached to a bus with an ideal voltage source
+		void doBlockParallelSolve(Bool value) { mBlockParallelSolve = value; }
+		/// Number the matrix node indices in reverse Cuthill-McKee order of the
+		/// graph of the component connections, so that connected nodes get
+		/// close indices in the solution vector and the system matrix
+		void doMatrixNodeReordering(Bool value) { mMatrixNodeReordering = value; }
+		/// Components which stamp a constant conductance, like synchronous generators
+		/// modeled with constant conductance, correct their contribution to the right
+		/// side vector after each solve. The system is solved again with the same
+		/// factorization until they converge or the number of iterations is reached.
+		void setMaxCorrectorIterations(UInt iterations) { mMaxCorrectorIterations = iterations; }
+		/// Initialize the components from the power flow and their MNA parts in
+		/// parallel OpenMP loops. The power components, the signal components and
+		/// the MNA initialization remain separate phases.
+		void doParallelComponentInitialization(Bool value) { mParallelComponentInitialization = value; }
+		/// Stamp and factorize the precomputed system matrices of all switch states
+		/// in a parallel OpenMP loop, each with its own linear solver. The stamps of
+		/// the components are called concurrently and must only read their state.
+		void doParallelSwitchedMatrixInitialization(Bool value) { mParallelSwitchedMatrixInitialization = value; }
+		/// Collapse the reference chains of the node, component and solver
+		/// attributes at the end of the initialization. Attribute references
+		/// must then not be changed during the simulation.
+		void doAttributeFreezing(Bool value) { mAttributeFreezing = value; }
+		/// Break the time of each step down into event handling, pre-step tasks,
+		/// right side assembly, system matrix recomputation, solve, node voltage
+		/// update, post-step tasks, logging and interfaces. The durations of the
+		/// last step are available as attributes of stepPhases().
+		void doStepPhaseProfiling(Bool value) { mStepPhaseProfiling = value; }
+		/// Write switch status changes, system matrix recomputations, pivot faults
+		/// and timing summaries of the solvers as binary records to the event log
+		void setEventLog(EventLog::Ptr log) { mEventLog = log; }
+		/// Run the threads of the scheduler, the parallel initialization, the
+		/// interface threads and the writer threads of asynchronous loggers on the
+		/// cores of the executor, e.g. a partition of Executor::global() per
+		/// simulation if several simulations run in one process. Parallel
+		/// initialization then uses the workers of the executor instead of OpenMP.
+		/// Must be set before the simulation is initialized.
+		void setExecutor(Executor::Ptr executor) { mExecutor = executor; }
+		/// Adapt the time step of an offline MNA simulation to the local truncation
+		/// error of the trapezoidal companion models. The steps are the time step
+		/// times a power of two up to 2^maxLevel, and the system matrices of each
+		/// step are factorized once. Events on the grid of the time step are hit
+		/// exactly. Loggers without an output grid are resampled to the time step
+		/// times their downsampling. A maximum level of zero disables it.
+		/// Execute events which lie between two steps at their instant instead of
+		/// at the next step. The step over the event is interpolated back to the
+		/// event, a full step after the event is interpolated back by half of it,
+		/// which damps the numerical chatter of the trapezoidal rule, and a last
+		/// step is interpolated back onto the grid. The factorized system matrices
+		/// are reused. The interface voltages and currents of the power components
+		/// are interpolated, which holds the state of the companion models.
+		/// Loggers without an output grid are resampled to the time step times
+		/// their downsampling.
+		void doEventInterpolation(Bool value = true) { mEventInterpolation = value; }
+		/// Let the shift frequency of a dynamic phasor simulation follow a measured
+		/// system frequency in Hz, e.g. the center of inertia frequency or a PLL
+		/// output, so that the phasors rotate slowly during frequency excursions
+		/// and larger time steps keep their accuracy. The shift frequency is moved
+		/// to the measurement after each step in which they differ by more than
+		/// the tolerance, which restamps and refactorizes the system matrices.
+		/// The phasors of the solution are relative to the shifted frame, which
+		/// is ahead of the nominal frame by shiftAngle().
+		void setShiftFrequencyTracking(CPS::Attribute<Real>::Ptr frequency, Real tolerance = 0.05) {
+			mShiftFrequencySource = frequency;
+			mShiftFrequencyTolerance = tolerance;
+		}
+		void doAdaptiveTimeStepping(UInt maxLevel, Real relTol = 1e-3, Real absTol = 1e-6, UInt holdSteps = 10) {
+			mAdaptiveMaxLevel = maxLevel;
+			mAdaptiveRelTol = relTol;
+			mAdaptiveAbsTol = absTol;
+			mAdaptiveHoldSteps = holdSteps;
+		}
+		/// Move the values of the static real, complex and matrix attributes of
+		/// the nodes and components into one array per type at the end of the
+		/// initialization, in the order of the nodes and components
+		void doAttributeArena(Bool value) { mAttributeArena = value; }
+		/// Allocate the objects created during the initialization, e.g. solvers,
+		/// tasks and attributes, from a pool that is released with the simulation
+		void doObjectPooling(Bool value) { mObjectPooling = value; }
+		/// Initialize each subnet solver on a thread pinned like the scheduler
+		/// thread that runs its tasks, so that its matrices, vectors and the
+		/// component states sized during the initialization are first touched on
+		/// the NUMA node of that thread. Requires a ThreadScheduler which pins its
+		/// threads, either with an executor or with setRealTimeThreads().
+		void doNumaLocalSubnets(Bool value) { mNumaLocalSubnets = value; }
+		/// Start each power flow step from the solution of the previous step
+		void doPowerFlowWarmStart(Bool value) { mPowerFlowWarmStart = value; }
+		/// Keep the factorized power flow Jacobian while the Newton iterations contract fast enough
+		void doPowerFlowJacobianReuse(Bool value) { mPowerFlowJacobianReuse = value; }
+		/// Multiple of the time step used for the fictitious inductances and
+		/// capacitances the LIM solver inserts into branches and nodes without them
+		void setLimLatencyFactor(Real factor) { mLimLatencyFactor = factor; }
+		/// Integrate the ODE components with the implicit instead of the explicit method
+		void doImplicitODEIntegration(Bool value) { mImplicitODEIntegration = value; }
+		/// Linear solver of the Newton iterations of the implicit ODE and the DAE integration
+		void setODELinearSolver(SundialsLinearSolver solver) { mODELinearSolver = solver; }
+		/// Evaluate the residuals of the DAE components in parallel chunks
+		void doParallelDAEResidual(Bool value) { mParallelDAEResidual = value; }
+		/// Stack the states of all ODE components into one integrator with a
+		/// block diagonal Jacobian instead of creating one integrator per component
+		void doAggregatedODEIntegration(Bool value) { mAggregatedODEIntegration = value; }
+		/// Quasi-dynamic mode for long-term simulations with large time steps. The
+		/// SP network is solved once per step with a factorization that only changes
+		/// with the switch states: the reduced order generators stamp a constant
+		/// conductance and correct their Norton current by iterations. Exciters,
+		/// governors and the ODE components are integrated implicitly.
+		void doQuasiDynamicMode(Bool value) { mQuasiDynamic = value; }
+		/// Solve the system together with other simulations of the same topology
+		void setBatchedLinearSolver(BatchedLinearSolver::Ptr solver) { mBatchedLinearSolver = solver; }
+		/// Let the simulation loggers and the node value loggers of all solvers
+		/// write binary shards, each from its own thread. At the end of the
+		/// simulation, the file <name>.index in the log directory lists the
+		/// shard, byte offset and row stride of every column.
+		void doShardedLogging(Bool value = true) { mShardedLogging = value; }
 
 		// #### Initialization ####
 		/// activate steady state initialization
@@ -200,6 +637,12 @@ namespace DPsim {
 		void setSteadStIniTimeLimit(Real v) { mSteadStIniTimeLimit = v; }
 		/// set steady state initialization accuracy limit
 		void setSteadStIniAccLimit(Real v) { mSteadStIniAccLimit = v; }
+		/// Extrapolate the steady state from the given number of consecutive steps
+		/// by reduced rank extrapolation of the solution vector and the component
+		/// interface quantities. The extrapolated state is the starting point of the
+		/// following steps, so the slowly decaying modes of lightly damped systems
+		/// are removed after a few steps. Zero disables the extrapolation.
+		void setSteadStIniExtrapolationDepth(UInt depth) { mSteadStIniExtrapolationDepth = depth; }
 
 		// #### Simulation Control ####
 		/// Create solver instances etc.
@@ -212,22 +655,104 @@ namespace DPsim {
 		Real next();
 		/// Run simulation until total time is elapsed.
 		void run();
+		/// Advance by the given number of steps without returning to the caller
+		/// in between, stopping early at the final time. Returns the time reached.
+		Real stepN(UInt count);
+		/// Advance until the given time or the final time is reached and return the time reached
+		Real stepUntil(Real time);
+		/// Run the simulation like run() in a background thread and return immediately
+		void runAsync();
+		/// Request the background run to stop after the current step
+		void cancelAsync() { mAsyncCancel = true; }
+		/// Wait for the background run to finish and rethrow its exception, if any
+		void waitAsync();
+		/// True while the background run has not finished
+		Bool isRunningAsync() const { return mAsyncRunning; }
 		/// Solve system A * x = z for x and current time
 		virtual Real step();
+		/// First part of a step, up to handing the right side vector to the batched linear solver
+		void stepBeforeBatchedSolve();
+		/// Second part of a step, after the batched linear solver solved all systems
+		Real stepAfterBatchedSolve();
 		/// Synchronize simulation with remotes by exchanging intial state over interfaces
 		void sync() const;
 		/// Create the schedule for the independent tasks
 		void schedule();
 
+		/// Captures the state after the last step in memory, see saveCheckpoint()
+		Checkpoint captureState();
+		/// Continues from a state captured by a simulation of the same
+		/// topology. The time step may differ, the step count is derived from
+		/// the time of the state. Events are restored to the added ones and
+		/// those before the state are dropped, so the simulation can also go
+		/// back in time. The solvers drop the state derived from previous steps.
+		void restoreState(const Checkpoint& state);
+		/// Creates an independent simulation that continues from the current
+		/// state, e.g. to explore contingencies from a common operating point.
+		/// The topology is cloned with SystemTopology::copy() and the state is
+		/// transferred with captureState(), the task graph cache, executor,
+		/// object pool and the solver configuration are shared. Events, loggers
+		/// and interfaces are not copied and the scheduler is sequential.
+		Ptr fork(String name = String());
+		/// Removes the components with the given names and adds the given ones
+		/// between two steps without initializing the simulation again. The
+		/// other components keep their state, the solver keeps the node indices
+		/// and refactorizes its system matrices and the tasks are scheduled
+		/// again. Requires a single solver that supports it, see
+		/// Solver::supportsTopologyEdits(), so subnets should not be split.
+		/// Added components connect to existing nodes and are initialized like
+		/// at the start, checkpoints and reset() of the previous topology only
+		/// restore the components that are still part of the system.
+		void editTopology(const CPS::IdentifiedObject::List& added, const std::vector<String>& removed = {});
+		/// Write the state after the last step to a binary checkpoint file.
+		/// The checkpoint contains the values of all static numeric attributes
+		/// of the nodes, components including their subcomponents and the
+		/// solvers, the simulation time and the times of the pending events.
+		void saveCheckpoint(const fs::path& filename);
+		/// Continue from a checkpoint saved by a simulation of the same
+		/// topology and time step. The simulation is initialized first if
+		/// necessary, so steady-state initialization can be disabled for the
+		/// forked runs. Events which were executed before the checkpoint are
+		/// dropped, parameter changes of a variant are applied afterwards.
+		void loadCheckpoint(const fs::path& filename);
+		/// Restores the state at the end of the initialization and continues
+		/// from the given time, keeping the solvers with their factorizations,
+		/// the schedule and the scheduler threads. Parameters are given as
+		/// real state attributes by checkpoint key, e.g.
+		/// "components/R1.R", and replace the initial values until the next
+		/// reset. Only the system matrix stamps of the components owning them
+		/// are updated. Events are restored to the added ones, and the
+		/// loggers are reopened for the new run. Simulations with adaptive
+		/// time steps or shift frequency tracking cannot be reset.
+		void reset(Real startTime = 0, const std::map<String, Real>& parameters = {});
+		/// Reopens the enabled loggers of the simulation and its solvers, so
+		/// file backends overwrite the output of the previous run
+		void reopenLoggers();
+		/// Computes the derivatives of the solution with respect to a real
+		/// state attribute given by checkpoint key, e.g. "components/R1.R",
+		/// alongside the simulation. The solvers provide them as their
+		/// sensitivities with one column per parameter of their components.
+		/// The perturbation of the finite differences is relative to the
+		/// magnitude of the parameter above one.
+		void addSensitivityParameter(const String& key, Real perturbation = 1e-6) {
+			mSensitivityParameters.emplace_back(key, perturbation);
+		}
+
 		/// Schedule an event in the simulation
 		void addEvent(Event::Ptr e) {
 			mEvents.addEvent(e);
 		}
+		/// Schedule an event from any thread while the simulation is running,
+		/// e.g. a fault injected by a control loop. It is taken over at the
+		/// start of the next step.
+		void injectEvent(Event::Ptr e) {
+			mEvents.injectEvent(e);
+		}
 		/// Add a new data logger
 		void addLogger(DataLogger::Ptr logger) {
 			mLoggers.push_back(logger);
 		}
-		/// Write step time measurements to log file
+		/// Write the histogram of the step times to log file
 		void logStepTimes(String logName);
 
 		/// Write LU decomposition times measurements to log file
@@ -252,7 +777,24 @@ namespace DPsim {
 		Real timeStep() const { return **mTimeStep; }
 		DataLogger::List& loggers() { return mLoggers; }
 		std::shared_ptr<Scheduler> scheduler() { return mScheduler; }
-		std::vector<Real>& stepTimes() { return mStepTimes; }
+		/// Solvers created by initialize()
+		const Solver::List& solvers() const { return mSolvers; }
+		const Histogram& stepTimes() const { return mStepTimes; }
+		/// Phases of the steps, created by initialize() if step phase profiling is enabled
+		StepPhases::Ptr stepPhases() const { return mStepPhases; }
+		///
+		EventLog::Ptr eventLog() const { return mEventLog; }
+		///
+		Executor::Ptr executor() const { return mExecutor; }
+		/// Current shift frequency of the dynamic phasors
+		Real shiftFrequency() const { return mShiftFrequency; }
+		/// Angle the shifted frame is ahead of the nominal frame at the current time
+		Real shiftAngle() const { return mShiftAngle + 2. * PI * (mShiftFrequency - mSystem.mSystemFrequency) * (mTime - mShiftTime); }
+		/// Step size controller, created by initialize() if adaptive time steps are enabled
+		AdaptiveTimeStep::Ptr adaptiveTimeStep() const { return mAdaptiveTimeStep; }
+		/// Bytes held by the solvers, components per type, nodes, loggers and
+		/// interfaces. Logged at the end of initialize().
+		MemoryReport memoryReport() const;
 
 		// #### Set component attributes during simulation ####
 		/// CHECK: Can these be deleted? getIdObjAttribute + "**attr =" should suffice
@@ -15,6 +15,12 @@
 #include <dpsim/Definitions.h>
 #include <dpsim/Config.h>
 #include <dpsim/DirectLinearSolverConfiguration.h>
+#include <dpsim/BatchedLinearSolver.h>
+#include <dpsim/Event.h>
+#include <dpsim/EventLog.h>
+#include <dpsim/Executor.h>
+#include <dpsim/MemoryReport.h>
+#include <dpsim/StepPhases.h>
 #include <dpsim-models/Logger.h>
 #include <dpsim-models/SystemTopology.h>
 #include <dpsim-models/Task.h>
@@ -26,6 +32,17 @@ namespace DPsim {
 		UInt systemIndex;
 	};
 
+	/// Real parameter of a component whose sensitivity is computed
+	struct SensitivityParameter {
+		/// Component owning the parameter
+		CPS::IdentifiedObject::Ptr component;
+		CPS::Attribute<Real>::Ptr attribute;
+		/// Perturbation relative to the magnitude of the parameter above one
+		Real perturbation;
+	};
+
+	class DataLogger;
+
 	/// Base class for more specific solvers such as MNA, ODE or IDA.
 	class Solver {
 	public:
@@ -43,8 +60,15 @@ namespace DPsim {
 		CPS::Logger::Log mSLog;
 		/// Time step for fixed step solvers
 		Real mTimeStep;
+		/// Number of simulation time steps per solver time step
+		UInt mTimeStepMultiple = 1;
+		/// Scheduler thread running the tasks of the solver, -1 for any thread
+		Int mThreadHint = -1;
 		/// Activates parallelized computation of frequencies
 		Bool mFrequencyParallel = false;
+		/// Frequencies of the parallel computation whose source vector is below this
+		/// fraction of the one of the first frequency are not solved, zero solves all
+		Real mHarmonicDropTolerance = 0;
 
 		// #### Initialization ####
 		/// steady state initialization time limit
@@ -53,6 +77,8 @@ namespace DPsim {
 		Real mSteadStIniAccLimit = 0.0001;
 		/// Activates steady state initialization
 		Bool mSteadyStateInit = false;
+		/// Number of steps extrapolated by reduced rank extrapolation during steady state initialization, zero disables it
+		UInt mSteadStIniExtrapolationDepth = 0;
 		/// Determines if solver is in initialization phase, which requires different behavior
 		Bool mIsInInitialization = false;
 		/// Activates powerflow initialization
@@ -60,6 +86,56 @@ namespace DPsim {
 		Bool mInitFromNodesAndTerminals = true;
 		/// Enable recomputation of system matrix during simulation
 		Bool mSystemMatrixRecomputation = false;
+		/// Enable sparse assembly of the right side vector from the component stamps
+		Bool mSparseRightVectorAssembly = false;
+		/// Factorize switch state dependent system matrices on first use instead of precomputing all of them
+		Bool mLazySwitchedMatrices = false;
+		/// Maximum number of cached switch state dependent system matrices, zero means unbounded
+		UInt mSwitchedMatrixCacheSize = 0;
+		/// Analyze the union of the patterns of all switch state dependent system matrices once and share it
+		Bool mSharedSymbolicAnalysis = false;
+		/// Apply changes of the variable system matrix as low-rank corrections instead of refactorizing
+		Bool mLowRankSystemMatrixUpdates = false;
+		/// Maximum rank of the low-rank correction before a full refactorization is done
+		UInt mLowRankUpdateMaxRank = 12;
+		/// Only restamp the variable elements that changed instead of rebuilding the system matrix
+		Bool mIncrementalSystemMatrixStamping = false;
+		/// Update the last solution for the changed entries of the source vector instead of solving fully
+		Bool mIncrementalSolve = false;
+		/// Maximum number of changed source vector entries of an incremental solve
+		UInt mIncrementalSolveMaxRows = 8;
+		/// Eliminate the internal nodes of static subnetworks without sources from the system matrix
+		Bool mKronReduction = false;
+		/// Order the tasks of the signal components once and execute them as one task
+		Bool mSignalGraphFusion = false;
+		/// Execute the steps of the EMT companion models on the device of the CUDA sparse solver
+		Bool mGpuResidentStep = false;
+		/// Steps after which their interface values are copied back to the host, never if zero
+		UInt mGpuResidentCopyInterval = 1;
+		/// Generate, compile and load a solve step specialized to the system matrix
+		Bool mStepGeneration = false;
+		/// Batched linear solver shared with other simulations of the same topology
+		BatchedLinearSolver::Ptr mBatchedLinearSolver;
+		/// Factorize and solve the diagonal blocks of the block triangular form of the system matrix in separate tasks
+		Bool mBlockParallelSolve = false;
+		/// Number the matrix node indices in reverse Cuthill-McKee order of the network graph
+		Bool mMatrixNodeReordering = false;
+		/// Maximum number of solves per time step repeated for the corrections of iterative components
+		UInt mMaxCorrectorIterations = 10;
+		/// Initialize the components in parallel
+		Bool mParallelComponentInitialization = false;
+		/// Stamp and factorize the system matrices of the switch states in parallel
+		Bool mParallelSwitchedMatrixInitialization = false;
+		/// Phases of the step the solver adds its internal phases to, if the phases are measured
+		StepPhases::Ptr mStepPhases;
+		/// Log the solver writes its diagnostic events to, if any
+		EventLog::Ptr mEventLog;
+		/// Executor running the parallel initialization and background jobs, if any
+		Executor::Ptr mExecutor;
+		/// Names of the observed nodes with the row of their first value in mObservedValues
+		std::vector<std::pair<String, UInt>> mObservedNodes;
+		/// Voltages of the observed nodes, shared by the solvers of all subnets
+		CPS::Attribute<Matrix>::Ptr mObservedValues;
 
 		/// Solver behaviour initialization or simulation
         Behaviour mBehaviour = Solver::Behaviour::Simulation;
@@ -76,8 +152,9 @@ namespace DPsim {
 
 		// #### Solver settings ####
 		/// Solver types:
-		/// Modified Nodal Analysis, Differential Algebraic, Newton Raphson
-		enum class Type { MNA, DAE, NRP };
+		/// Modified Nodal Analysis, Differential Algebraic, Newton Raphson,
+		/// fast decoupled, DC and sweep powerflow, latency insertion method
+		enum class Type { MNA, DAE, NRP, FDP, DCP, SWP, LIM };
 		///
 		void setTimeStep(Real timeStep) {
 			mTimeStep = timeStep;
@@ -87,9 +164,72 @@ namespace DPsim {
 			mFrequencyParallel = freqParallel;
 		}
 		///
+		void setHarmonicDropTolerance(Real tolerance) { mHarmonicDropTolerance = tolerance; }
+		///
 		virtual void setSystem(const CPS::SystemTopology &system) {}
 		///
 		void doSystemMatrixRecomputation(Bool value) { mSystemMatrixRecomputation = value; }
+		///
+		void doSparseRightVectorAssembly(Bool value) { mSparseRightVectorAssembly = value; }
+		///
+		void doLazySwitchedMatrices(Bool value) { mLazySwitchedMatrices = value; }
+		///
+		void setSwitchedMatrixCacheSize(UInt size) { mSwitchedMatrixCacheSize = size; }
+		///
+		void doSharedSymbolicAnalysis(Bool value) { mSharedSymbolicAnalysis = value; }
+		///
+		void doLowRankSystemMatrixUpdates(Bool value) { mLowRankSystemMatrixUpdates = value; }
+		///
+		void setLowRankUpdateMaxRank(UInt rank) { mLowRankUpdateMaxRank = rank; }
+		///
+		void doIncrementalSystemMatrixStamping(Bool value) { mIncrementalSystemMatrixStamping = value; }
+		///
+		void doIncrementalSolve(Bool value) { mIncrementalSolve = value; }
+		///
+		void setIncrementalSolveMaxRows(UInt rows) { mIncrementalSolveMaxRows = rows; }
+		///
+		void doKronReduction(Bool value) { mKronReduction = value; }
+		///
+		void doSignalGraphFusion(Bool value) { mSignalGraphFusion = value; }
+		///
+		void doGpuResidentStep(Bool value) { mGpuResidentStep = value; }
+		///
+		void setGpuResidentCopyInterval(UInt steps) { mGpuResidentCopyInterval = steps; }
+		///
+		void doStepGeneration(Bool value) { mStepGeneration = value; }
+		/// Solve the system together with the other systems of a batched linear solver
+		void setBatchedLinearSolver(BatchedLinearSolver::Ptr solver) { mBatchedLinearSolver = solver; }
+		///
+		void doBlockParallelSolve(Bool value) { mBlockParallelSolve = value; }
+		///
+		void doMatrixNodeReordering(Bool value) { mMatrixNodeReordering = value; }
+		///
+		void setMaxCorrectorIterations(UInt iterations) { mMaxCorrectorIterations = iterations; }
+		///
+		void doParallelComponentInitialization(Bool value) { mParallelComponentInitialization = value; }
+		///
+		void doParallelSwitchedMatrixInitialization(Bool value) { mParallelSwitchedMatrixInitialization = value; }
+		///
+		void setStepPhases(StepPhases::Ptr phases) { mStepPhases = phases; }
+		///
+		void setEventLog(EventLog::Ptr log) { mEventLog = log; }
+		/// Run the parallel initialization and background jobs like the prefetching
+		/// of system matrices on the executor instead of OpenMP threads
+		void setExecutor(Executor::Ptr executor) { mExecutor = executor; }
+		/// Copy the voltages of the given nodes from the solution into their rows of values
+		/// in every step, see Simulation::observeNodes. Nodes of other subnets are ignored.
+		void setObservedNodes(const std::vector<std::pair<String, UInt>>& nodes, CPS::Attribute<Matrix>::Ptr values) {
+			mObservedNodes = nodes;
+			mObservedValues = values;
+		}
+		/// Run the tasks of the solver only in every given simulation step. The
+		/// time step of the solver has to be set to the same multiple.
+		void setTimeStepMultiple(UInt multiple) { mTimeStepMultiple = multiple; }
+		UInt timeStepMultiple() const { return mTimeStepMultiple; }
+		/// Run the tasks of the solver on the given scheduler thread, e.g. the
+		/// thread on whose NUMA node the solver was initialized
+		void setThreadHint(Int thread) { mThreadHint = thread; }
+		Int threadHint() const { return mThreadHint; }
 
 		// #### Initialization ####
 		///
@@ -100,6 +240,8 @@ namespace DPsim {
 		void setSteadStIniTimeLimit(Real v) { mSteadStIniTimeLimit = v; }
 		/// set steady state initialization accuracy limit
 		void setSteadStIniAccLimit(Real v) { mSteadStIniAccLimit = v; }
+		/// set number of steps used for extrapolating the steady state
+		void setSteadStIniExtrapolationDepth(UInt depth) { mSteadStIniExtrapolationDepth = depth; }
 		/// set solver and component to initialization or simulation behaviour
 		virtual void setSolverAndComponentBehaviour(Solver::Behaviour behaviour) {}
 		/// activate powerflow initialization
@@ -114,11 +256,79 @@ namespace DPsim {
 		{
 			// no default implementation for all types of solvers
 		}
+		/// Keep the current stamps of variable components while frozen, if applicable
+		virtual void setFreezeVariableComponents(Bool freeze)
+		{
+			// only solvers recomputing a system matrix have stamps to freeze
+		}
+		/// Adds the memory of the system matrices, factorizations and vectors to the report
+		virtual void reportMemory(MemoryReport& report) const
+		{
+			// solvers without large data structures report nothing
+		}
+
+		// #### Adaptive time steps ####
+		/// Returns true if the time step can be changed during the simulation, logs why not otherwise
+		virtual Bool supportsTimeStepChange() { return false; }
+		/// Changes the time step of the initialized solver before the next step
+		virtual void changeTimeStep(Real timeStep) { mTimeStep = timeStep; }
+		/// Solution of the last step the local truncation error is estimated from, nullptr if not available
+		virtual const Matrix* solution() const { return nullptr; }
+
+		// #### Frequency-adaptive dynamic phasors ####
+		/// Returns true if the shift frequency can be changed during the simulation, logs why not otherwise
+		virtual Bool supportsShiftFrequencyChange() { return false; }
+		/// Changes the shift frequency of the phasors from the given time on
+		virtual void changeShiftFrequency(Real frequency, Real time) { }
+
+		// #### Topology edits ####
+		/// Returns true if components can be added and removed during the simulation, logs why not otherwise
+		virtual Bool supportsTopologyEdits() { return false; }
+		/// Removes and adds components between two steps, the removed components are part of the solver
+		virtual void editTopology(const CPS::IdentifiedObject::List& added, const CPS::IdentifiedObject::List& removed) { }
+
+		// #### Event interpolation ####
+		/// Returns true if the state can be interpolated between steps, logs why not otherwise
+		virtual Bool supportsStateInterpolation() { return false; }
+		/// Saves the present state as the start of an interpolation
+		virtual void saveState() { }
+		/// Sets the state to the linear interpolation between the saved state,
+		/// at weight 0, and the present state, at weight 1
+		virtual void interpolateState(Real weight) { }
+
+		// #### Reset ####
+		/// Drops the state derived from previous steps, e.g. after the simulation was reset
+		virtual void reset() { }
+		/// Returns true if the stamps of components can be updated after parameter changes, logs why not otherwise
+		virtual Bool supportsParameterChange() { return false; }
+		/// Saves the system matrix stamps of the components before their parameters are changed
+		virtual void beginParameterChange(const CPS::IdentifiedObject::List& comps) { }
+		/// Replaces the saved stamps by the stamps of the changed parameters and refactorizes the system matrices
+		virtual void finishParameterChange() { }
+
+		// #### Sensitivities ####
+		/// Propagates the derivatives of the solution with respect to the parameters
+		/// of its own components alongside the solution, ignoring the others.
+		/// Returns the number of parameters taken, zero if not supported.
+		virtual UInt setSensitivityParameters(const std::vector<SensitivityParameter>& parameters) { return 0; }
+		/// Derivatives of the solution with one column per taken parameter, nullptr if not computed
+		virtual CPS::Attribute<Matrix>::Ptr sensitivities() const { return nullptr; }
+
+		// #### Switched system matrix prefetch ####
+		/// Prepares the system matrix of the switch states after the given changes
+		/// in the background, if system matrices are built on demand
+		virtual void prefetchSwitchStates(const std::vector<SwitchChange>& changes) { }
+		/// Drops a prefetched system matrix that is not needed anymore
+		virtual void discardPrefetch() { }
 
 		// #### Simulation ####
 		/// Get tasks for scheduler
 		virtual CPS::Task::List getTasks() = 0;
 		/// Log results
 		virtual void log(Real time, Int timeStepCount) { };
+		/// Data loggers owned by the solver
+		virtual std::vector<std::shared_ptr<DataLogger>> dataLoggers() { return {}; }
+		/// Attributes holding the solver state between steps, saved in checkpoints
+		virtual CPS::AttributeBase::Map stateAttributes() { return {}; }
 	};
 }
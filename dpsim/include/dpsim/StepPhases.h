@@ -0,0 +1,107 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+
+#include <dpsim/Definitions.h>
+#include <dpsim/Histogram.h>
+#include <dpsim-models/AttributeList.h>
+#include <dpsim-models/Task.h>
+
+namespace DPsim {
+	/// \brief Breakdown of the time of each simulation step into phases
+	///
+	/// The scheduler adds the execution time of each task to the phase of the task,
+	/// the simulation adds the event handling, and the MNA solvers add the
+	/// assembly of the right side vector, the recomputation of the system matrix
+	/// and the update of the node voltages, which are subtracted from the solve
+	/// phase. Durations may be added concurrently. At the end of each step the
+	/// durations are published to one attribute per phase, which can be logged or
+	/// exported like any other attribute, and recorded in one histogram per phase.
+	/// Tasks of parallel schedulers are summed, so the phases of a step can add up
+	/// to more than its wall time.
+	class StepPhases : public CPS::AttributeList {
+	public:
+		typedef std::shared_ptr<StepPhases> Ptr;
+
+		enum Phase {
+			Events, PreStep, RightSide, Recomputation, Solve, NodeUpdate,
+			PostStep, Logging, Interfaces, Other, NumPhases
+		};
+
+		/// Adds the duration of its lifetime to a phase, does nothing without phases
+		class Scope {
+		public:
+			Scope(StepPhases* phases, Phase phase) : mPhases(phases), mPhase(phase) {
+				if (mPhases)
+					mStart = std::chrono::steady_clock::now();
+			}
+			Scope(StepPhases* phases, const CPS::Task* task) :
+				Scope(phases, phases ? phases->phase(task) : Other) {}
+			~Scope() {
+				if (mPhases)
+					mPhases->add(mPhase, std::chrono::steady_clock::now() - mStart);
+			}
+
+		private:
+			StepPhases* mPhases;
+			Phase mPhase;
+			std::chrono::steady_clock::time_point mStart;
+		};
+
+		StepPhases();
+
+		/// Name of the phase, also used as attribute name
+		static const char* name(UInt phase);
+		/// Phase of a solver task derived from its name
+		static Phase phaseOfName(const String& name);
+
+		/// Assigns the phase of a task, must not be called while a step is running
+		void setPhase(const CPS::Task* task, Phase phase) { mTaskPhases[task] = phase; }
+		/// Phase of a task, tasks without assigned phase belong to Other
+		Phase phase(const CPS::Task* task) const {
+			auto it = mTaskPhases.find(task);
+			return it == mTaskPhases.end() ? Other : it->second;
+		}
+
+		/// Adds a duration to a phase of the current step
+		void add(Phase phase, std::chrono::steady_clock::duration duration) {
+			mCurrent[phase].fetch_add(static_cast<uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()), std::memory_order_relaxed);
+		}
+		/// Publishes the durations of the current step and starts the next step
+		void finishStep();
+		/// Discards the durations of the current step, the histograms and the task phases
+		void reset();
+
+		/// Attribute with the duration of the phase in the last step in seconds,
+		/// which is also available by the name of the phase
+		const CPS::Attribute<Real>::Ptr& time(Phase phase) const { return mTimes[phase]; }
+		/// Durations of the phase in all steps
+		const Histogram& histogram(Phase phase) const { return mHistograms[phase]; }
+
+		/// Logs the histogram of every phase with samples
+		void log(CPS::Logger::Log log) const;
+
+	private:
+		///
+		std::array<std::atomic<uint64_t>, NumPhases> mCurrent;
+		///
+		std::array<Histogram, NumPhases> mHistograms;
+		///
+		std::array<CPS::Attribute<Real>::Ptr, NumPhases> mTimes;
+		///
+		std::unordered_map<const CPS::Task*, Phase> mTaskPhases;
+	};
+}
@@ -0,0 +1,23 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+namespace DPsim {
+	/// Linear solver for the Newton iterations of the implicit SUNDIALS integrators
+	enum class SundialsLinearSolver {
+		/// Dense Jacobian matrix and LU factorization
+		Dense,
+		/// Sparse Jacobian matrix with the pattern provided by the components,
+		/// factorized by KLU. Requires SUNDIALS with KLU support (WITH_SUNDIALS_KLU).
+		SparseKLU,
+		/// Matrix-free GMRES with difference quotient Jacobian-vector products,
+		/// for large stiff systems
+		GMRES
+	};
+}
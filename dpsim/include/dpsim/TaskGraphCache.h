@@ -0,0 +1,73 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Filesystem.h>
+#include <dpsim-models/Task.h>
+
+namespace DPsim {
+	/// \brief Resolved task dependencies of repeatedly scheduled task graphs
+	///
+	/// The edges resolved from the attribute dependencies are stored as pairs of
+	/// task indices in the order they were found, so the in and out edge lists are
+	/// restored in the same order. The graphs are keyed by a hash of the task names
+	/// and of the attribute structure: the attribute dependencies, modified
+	/// attributes and previous step dependencies of each task and the direct
+	/// dependencies of every attribute reached, with the attributes numbered by
+	/// their first appearance. Changing a reference or the attributes of a task
+	/// changes the hash, so the edges are resolved again.
+	/// The cache can be shared by several simulations and, with a directory, by
+	/// several runs. The files are named `<hash>.taskgraph` and contain the magic
+	/// "DPSIMTGC", uint32 version, uint64 hash, uint32 number of tasks and edges
+	/// and the uint32 index pairs of the edges.
+	class TaskGraphCache {
+	public:
+		typedef std::shared_ptr<TaskGraphCache> Ptr;
+
+		static constexpr uint32_t Version = 2;
+
+		struct Graph {
+			/// Number of tasks including the root task
+			UInt numTasks = 0;
+			/// Indices of the source and target task of each edge
+			std::vector<std::pair<uint32_t, uint32_t>> edges;
+		};
+
+		/// Keeps the graphs in memory only, or in the directory as well if it is not empty
+		explicit TaskGraphCache(const fs::path& directory = fs::path());
+
+		/// Structural hash of the tasks
+		static uint64_t hash(const CPS::Task::List& tasks);
+
+		/// Looks up the graph in memory and then in the directory
+		Bool lookup(uint64_t hash, Graph& graph);
+		///
+		void store(uint64_t hash, const Graph& graph);
+
+		///
+		UInt hits() const { return mHits; }
+		///
+		UInt misses() const { return mMisses; }
+
+	private:
+		fs::path filename(uint64_t hash) const;
+
+		fs::path mDirectory;
+		std::unordered_map<uint64_t, Graph> mGraphs;
+		UInt mHits = 0;
+		UInt mMisses = 0;
+		std::mutex mMutex;
+	};
+}
@@ -13,11 +13,25 @@
 namespace DPsim {
 	class ThreadListScheduler : public ThreadScheduler {
 	public:
-		ThreadListScheduler(Int threads = 1, String outMeasurementFile = String(), String inMeasurementFile = String(), Bool useConditionVariables = false);
+		ThreadListScheduler(Int threads = 1, String outMeasurementFile = String(), String inMeasurementFile = String(), Bool useConditionVariables = false, Bool useAdaptiveWait = false);
 
 		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+
+		/// Recompute the schedule every interval steps from moving averages of the
+		/// measured task execution times, zero disables the adaptive rescheduling
+		void doAdaptiveRescheduling(UInt interval, Real smoothing = 0.1);
 
 	private:
+		/// Assigns the tasks to threads by HLFET list scheduling with the given task costs
+		void listSchedule(const std::unordered_map<String, TaskTime::rep>& measurements, Int nextTimeStepCount);
+
 		String mInMeasurementFile;
+		/// Scheduled tasks in topological order and their dependencies
+		CPS::Task::List mOrdered;
+		Edges mInEdges, mOutEdges;
+		/// Number of steps between schedule recomputations
+		UInt mRescheduleInterval = 0;
+		UInt mStepsSinceSchedule = 0;
 	};
 };
@@ -10,30 +10,100 @@
 
 #include <dpsim/Scheduler.h>
 
+#include <atomic>
+#include <memory>
 #include <thread>
+#include <unordered_set>
 #include <vector>
 
 namespace DPsim {
 	class ThreadScheduler : public Scheduler {
 	public:
-		ThreadScheduler(Int threads, String outMeasurementFile, Bool useConditionVariable);
+		/// Threads wait with condition variables if useConditionVariable is set, with
+		/// a spin-yield-futex AdaptiveWait if useAdaptiveWait is set and by spinning otherwise
+		ThreadScheduler(Int threads, String outMeasurementFile, Bool useConditionVariable, Bool useAdaptiveWait = false);
 		virtual ~ThreadScheduler();
 
 		void step(Real time, Int timeStepCount);
 		virtual void stop();
+		void restart(Int timeStepCount) override;
+		/// Discards the schedule of the waiting threads before the new one is created
+		void recreateSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges, Int timeStepCount) override;
+
+		/// Pins thread i to CPU cpus[i % cpus.size()] and runs all threads with the given
+		/// SCHED_FIFO priority if it is non-zero, like villas::kernel::rt::init does for
+		/// the interface thread. With first touch, each worker allocates its own schedule
+		/// after being pinned, so that it is placed on the local NUMA node.
+		/// Must be called before the schedule is created and requires WITH_RT.
+		void setRealTimeThreads(const std::vector<Int>& cpus, Int priority = 0, Bool firstTouch = true);
+
+		/// Lets the threads start the tasks of the next step as soon as the tasks they
+		/// depend on across steps are done, instead of waiting for the whole step.
+		/// A step then returns when the tasks of the calling thread are done, while
+		/// other threads may still work on it, so attributes must not be accessed
+		/// from outside of tasks until the simulation is stopped. Intended for offline
+		/// runs and must be called before the schedule is created.
+		void doPipelining(Bool pipelining);
+
+		/// Executes the latency critical tasks, i.e. the interface exports, and the
+		/// tasks they depend on before all other tasks of a step, so that the
+		/// outgoing samples are sent right after the solution. Other post-steps and
+		/// the loggers follow in the rest of the step. Must be called before the
+		/// schedule is created.
+		void doLatencyFirst(Bool latencyFirst) { mLatencyFirst = latencyFirst; }
+
+		/// Number of threads executing the schedule
+		Int threadCount() const { return mNumThreads; }
+		/// Applies the CPU affinity of thread idx to the calling thread, e.g. to allocate
+		/// the data of its tasks on its NUMA node before the threads are started.
+		/// Returns false if the threads are not pinned.
+		Bool pinThread(Int idx);
 
 	protected:
-		void finishSchedule(const Edges& inEdges);
+		/// Builds the schedule entries and starts the threads if not yet running,
+		/// the counters start at the time step count of the next step
+		void finishSchedule(const Edges& inEdges, Int nextTimeStepCount = 0);
+		/// Appends the task to the schedule of the thread, or of the thread of its hint
 		void scheduleTask(int thread, CPS::Task::Ptr task);
+		/// Discards the schedule, must only be called between steps and waits
+		/// for pipelined steps to finish
+		void clearSchedule();
+		/// Latency critical tasks and all tasks they transitively depend on
+		static std::unordered_set<CPS::Task::Ptr> criticalTasks(const CPS::Task::List& tasks, const Edges& inEdges);
 
 		Int mNumThreads;
+		/// Measure the execution time of each task
+		Bool mMeasureTasks;
+		/// Wait for other threads with an AdaptiveWait
+		Bool mUseAdaptiveWait;
+		String mOutMeasurementFile;
+		/// Schedule the latency critical tasks first
+		Bool mLatencyFirst = false;
 
 	private:
-		void doStep(Int scheduleIdx);
+		void doStep(Int scheduleIdx, Real time, Int timeStepCount);
 		static void threadFunction(ThreadScheduler* sched, Int idx);
+		static void pipelineFunction(ThreadScheduler* sched, Int idx);
+		/// Waits until all threads finished all published steps
+		void drainPipeline();
+		/// Starts the threads with the counters at the time step count of the next step
+		void startThreads(Int nextTimeStepCount);
+		/// Lets the threads finish the published steps and joins them
+		void joinThreads();
+		/// Applies the CPU affinity and priority to the calling thread and allocates
+		/// its schedule if first touch is used
+		void initThread(Int idx);
 
-		String mOutMeasurementFile;
 		Barrier mStartBarrier;
+		/// Synchronizes the initialization of newly started threads
+		Barrier mInitBarrier;
+
+		/// CPUs to pin the threads to, empty for no pinning
+		std::vector<Int> mCpus;
+		/// SCHED_FIFO priority of the threads, zero keeps the default policy
+		Int mPriority = 0;
+		/// Let each worker allocate its own schedule
+		Bool mFirstTouch = false;
 
 		std::vector<std::thread> mThreads;
 
@@ -42,11 +112,25 @@ namespace DPsim {
 			CPS::Task* task;
 			Counter endCounter;
 			std::vector<Counter*> reqCounters;
+			/// Tasks which must have finished the previous step, only used for pipelining
+			std::vector<Counter*> prevCounters;
 		};
 		std::vector<ScheduleEntry*> mSchedules;
 
 		Bool mJoining = false;
 		Real mTime = 0;
 		Int mTimeStepCount = 0;
+
+		/// Number of steps whose parameters can be published ahead of the slowest thread
+		static constexpr Int mPipelineDepth = 16;
+		Bool mPipelined = false;
+		/// Times of the published steps, indexed by the step count modulo the depth
+		Real mPipelineTimes[mPipelineDepth] = {};
+		/// Count of the next step to be published
+		Counter mPublishedSteps;
+		/// Count of the next step each thread starts
+		std::unique_ptr<Counter[]> mStartedSteps;
+		/// Step count at which the threads stop
+		std::atomic<Int> mPipelineEnd;
 	};
 }
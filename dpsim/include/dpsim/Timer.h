@@ -45,9 +45,18 @@ namespace DPsim {
 		long long mTicks;
 		int mFlags;
 
+		/// Wake-up latency statistics, measured against the tick deadline
+		Ticks mLatencyLast;
+		Ticks mLatencyMax;
+		Ticks mLatencySum;
+		long long mWakeups;
+
 	public:
 		enum Flags : int {
-			fail_on_overrun = 1
+			fail_on_overrun = 1,
+			/// Spin on the clock until the deadline instead of blocking in the kernel.
+			/// Avoids the wake-up latency at small time steps, but occupies a core.
+			busy_wait = 2
 		};
 
 		Timer(int flags = 0);
@@ -78,11 +87,37 @@ namespace DPsim {
 			return mTickInterval;
 		}
 
+		/// Deadline of the next tick, valid after start()
+		IntervalTimePoint nextTick() const {
+			return mNextTick;
+		}
+
+		/// Delay between the deadline and the return of the last sleep()
+		Ticks latencyLast() const {
+			return mLatencyLast;
+		}
+
+		Ticks latencyMax() const {
+			return mLatencyMax;
+		}
+
+		Ticks latencyMean() const {
+			return mWakeups > 0 ? Ticks(mLatencySum / mWakeups) : Ticks::zero();
+		}
+
 		// Setter
 		void setStartTime(const StartTimePoint &start) {
 			mStartAt = start;
 		}
 
+		int flags() const {
+			return mFlags;
+		}
+
+		void setFlags(int flags) {
+			mFlags = flags;
+		}
+
 		void setInterval(const Ticks &intv) {
 			mTickInterval = intv;
 		}
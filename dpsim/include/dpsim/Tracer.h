@@ -0,0 +1,84 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+#endif
+
+#include <dpsim/Definitions.h>
+#include <dpsim-models/Task.h>
+
+namespace DPsim {
+	/// \brief Records the start and end of task executions per thread
+	///
+	/// Each thread writes to its own ring buffer of fixed capacity, which keeps
+	/// the most recent events, so recording needs no synchronization or allocation.
+	/// Timestamps are taken from the time stamp counter where available.
+	/// The trace can be exported in the Chrome trace event format, which is
+	/// also read by Perfetto.
+	class Tracer {
+	public:
+		typedef std::shared_ptr<Tracer> Ptr;
+
+		/// Creates buffers for the given number of threads, events of other threads are dropped
+		Tracer(UInt threads, UInt capacity = 1 << 16);
+
+		/// Current timestamp in ticks
+		static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+			return __rdtsc();
+#else
+			return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+		}
+
+		/// Records an execution of a task, must only be called by the given thread
+		void record(Int thread, const CPS::Task* task, Int timeStepCount, uint64_t start, uint64_t end) {
+			if (thread < 0 || thread >= static_cast<Int>(mBuffers.size()))
+				return;
+			auto& buffer = mBuffers[thread];
+			buffer.events[buffer.next] = { task, timeStepCount, start, end };
+			if (++buffer.next == buffer.events.size()) {
+				buffer.next = 0;
+				buffer.wrapped = true;
+			}
+		}
+
+		/// Discards all events
+		void clear();
+
+		/// Writes the events in the Chrome trace event format, the traced tasks must still exist
+		void writeChromeTrace(String filename) const;
+
+	private:
+		struct Event {
+			const CPS::Task* task;
+			Int timeStepCount;
+			uint64_t start;
+			uint64_t end;
+		};
+		/// Buffer of one thread, aligned to avoid false sharing between threads
+		struct alignas(64) Buffer {
+			std::vector<Event> events;
+			std::size_t next = 0;
+			Bool wrapped = false;
+		};
+
+		std::vector<Buffer> mBuffers;
+		/// Reference points to convert ticks to wall clock time
+		uint64_t mStartTicks;
+		std::chrono::steady_clock::time_point mStartTime;
+	};
+}
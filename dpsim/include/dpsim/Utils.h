@@ -86,6 +86,8 @@ public:
 
 	void parseArguments(int argc, char *argv[]);
 	void showUsage();
+	/// Linear solver implementation of a --linear-solver-impl value, e.g. "KLU"
+	static DirectLinearSolverImpl directLinearSolverImpl(const String& name);
 	void showCopyright();
 
 	double timeStep;
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <dpsim/Checkpoint.h>
+#include <dpsim/Executor.h>
+#include <dpsim/Simulation.h>
+#include <dpsim-models/Signal/DecouplingLineRemote.h>
+
+namespace DPsim {
+	/// \brief In-process link of a split decoupling line for waveform relaxation
+	///
+	/// Each end is a DecouplingLineChannel for the DecouplingLineRemote of one
+	/// subnet. Within a window, the values sent by an end are only collected.
+	/// The peer reads the values of the previous iteration of the window, or
+	/// the last accepted value in the first iteration, so both subnets run the
+	/// window without waiting for each other. Values before the window were
+	/// accepted in earlier windows. If the line delay covers the window, no
+	/// value of the window is read and the first iteration is exact.
+	class WaveformLink :
+		public SharedFactory<WaveformLink> {
+	public:
+		typedef std::shared_ptr<WaveformLink> Ptr;
+
+		WaveformLink();
+
+		/// Channel of one end, side 0 or 1
+		CPS::Signal::DecouplingLineChannel::Ptr end(UInt side);
+
+		/// Starts the window of the given steps beginning with the step count
+		void beginWindow(Int first, UInt steps);
+		/// Passes the values sent in the last iteration to the peers and returns
+		/// their largest change to the previous iteration, relative to values
+		/// above one. Zero if no end read values of the window.
+		Real exchange();
+		/// Accepts the values of the last exchanged iteration
+		void commitWindow();
+		/// True if an end read values of the window in the last exchanged iteration
+		Bool readsWindow() const { return mReadWindow; }
+
+	private:
+		class End;
+
+		struct Record {
+			Complex voltage;
+			Complex current;
+		};
+
+		struct Side {
+			std::shared_ptr<End> channel;
+			/// Accepted values of previous windows, starting with the step committedStart
+			std::deque<Record> committed;
+			Int committedStart = 0;
+			/// Values sent in the running iteration of the window
+			std::vector<Record> sent;
+			/// Values sent in the previous iteration of the window, read by the peer
+			std::vector<Record> previous;
+			Bool hasPrevious = false;
+			/// Lowest step this end read from the peer in the window
+			Int lowestRead = 0;
+			/// This end read a value of the window from the peer
+			Bool readWindow = false;
+			/// Initial voltage, set once by the exchange of the initial voltages
+			Complex initialVoltage;
+			Bool hasInitialVoltage = false;
+		};
+
+		Complex exchangeInitialVoltage(UInt side, Complex voltage);
+		void send(UInt side, Int timeStepCount, Complex voltage, Complex current);
+		void receive(UInt side, Int timeStepCount, Complex& voltage, Complex& current);
+
+		Side mSides[2];
+		Int mWindowStart = 0;
+		UInt mWindowSteps = 0;
+		Bool mReadWindow = false;
+
+		/// The initial voltages are exchanged while the subnets initialize concurrently
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+	};
+
+	/// \brief Waveform relaxation of subnets coupled by split decoupling lines
+	///
+	/// Every subnet is a simulation of its own, whose ends of the coupling
+	/// lines are DecouplingLineRemote components with the channels of a
+	/// WaveformLink. The subnets simulate a window of many steps concurrently,
+	/// using the boundary waveforms of their neighbours from the previous
+	/// iteration. Then the waveforms are exchanged and the window is repeated
+	/// from its start state until the waveforms change less than the tolerance,
+	/// so the subnets synchronize once per window instead of every step.
+	///
+	/// The iterations run with the loggers of the subnets paused. The
+	/// converged window is run once more with the loggers enabled. If the
+	/// line delays cover the window, which is detected in the first window,
+	/// every window is exact and only run once.
+	class WaveformRelaxation {
+	public:
+		typedef std::shared_ptr<WaveformRelaxation> Ptr;
+
+		/// Logger
+		CPS::Logger::Log mLog;
+
+		WaveformRelaxation(String name, CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		/// Adds a subnet, which must not be initialized yet
+		void addSubnet(Simulation::Ptr subnet);
+		/// Adds a link whose ends are used by the subnets
+		void addLink(WaveformLink::Ptr link) { mLinks.push_back(link); }
+		/// Number of time steps of a window
+		void setWindowSteps(UInt steps) { mWindowSteps = steps; }
+		/// Largest change of a boundary value between two iterations, relative
+		/// to the magnitude of values above one
+		void setTolerance(Real tolerance) { mTolerance = tolerance; }
+		/// Maximum number of iterations of a window before it is accepted
+		void setMaxIterations(UInt maxIterations) { mMaxIterations = maxIterations; }
+		/// Runs the subnets on the workers of the executor, OpenMP is used if not set
+		void setExecutor(Executor::Ptr executor) { mExecutor = executor; }
+
+		/// Initializes the subnets concurrently, as the lines exchange their initial voltages
+		void initialize();
+		/// Runs all windows until the final time
+		void run();
+
+		// #### Getter ####
+		String name() const { return mName; }
+		std::vector<Simulation::Ptr>& subnets() { return mSubnets; }
+		/// Windows of the last run
+		UInt windows() const { return mWindows; }
+		/// Runs of the windows of the last run, including the logged ones
+		UInt iterations() const { return mIterations; }
+		/// Windows that were accepted without converging
+		UInt unconvergedWindows() const { return mUnconvergedWindows; }
+
+	protected:
+		/// Steps all subnets concurrently
+		void stepSubnets(UInt steps);
+		/// Pauses or resumes the loggers that were enabled and not paused by the user
+		void setLogging(Bool enabled);
+
+		String mName;
+		std::vector<Simulation::Ptr> mSubnets;
+		std::vector<WaveformLink::Ptr> mLinks;
+		Executor::Ptr mExecutor;
+		UInt mWindowSteps = 100;
+		Real mTolerance = 1e-6;
+		UInt mMaxIterations = 20;
+		///
+		Bool mInitialized = false;
+
+		/// Loggers of the subnets and their solvers which are paused during the iterations
+		DataLogger::List mLoggers;
+		/// The line delays cover the window, so one run per window is exact
+		Bool mExact = false;
+
+		UInt mWindows = 0;
+		UInt mIterations = 0;
+		UInt mUnconvergedWindows = 0;
+	};
+}
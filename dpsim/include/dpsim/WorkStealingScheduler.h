@@ -0,0 +1,85 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DPsim {
+	/// Scheduler assigning each task to a thread by HLFET list scheduling like the
+	/// ThreadListScheduler, but only as a preference: tasks are queued by their
+	/// thread once ready, and idle threads steal ready tasks from other threads.
+	class WorkStealingScheduler : public Scheduler {
+	public:
+		WorkStealingScheduler(Int threads = 1, String outMeasurementFile = String(), String inMeasurementFile = String(), Bool useConditionVariables = false);
+		virtual ~WorkStealingScheduler();
+
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void stop();
+		void restart(Int timeStepCount) override;
+		/// Joins the waiting workers before the new schedule starts its own
+		void recreateSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges, Int timeStepCount) override;
+
+	private:
+		/// Queue of ready tasks of a thread, ordered by ascending priority
+		struct ReadyQueue {
+			std::mutex mutex;
+			std::deque<UInt> tasks;
+		};
+
+		/// Queues a ready task at its preferred thread
+		void pushReady(UInt task);
+		/// Takes the ready task of highest priority, first from the own queue, then from other threads
+		Bool popReady(Int thread, UInt& task);
+		/// Lets the workers leave their loop and joins them
+		void joinThreads();
+		/// Executes tasks until all tasks of the step are done
+		void doStep(Int thread);
+		static void threadFunction(WorkStealingScheduler* sched, Int idx);
+
+		Int mNumThreads;
+		String mOutMeasurementFile;
+		String mInMeasurementFile;
+		Barrier mStartBarrier;
+		Barrier mEndBarrier;
+
+		std::vector<std::thread> mThreads;
+
+		/// Scheduled tasks in topological order
+		CPS::Task::List mTasks;
+		/// HLFET priority of each task
+		std::vector<int64_t> mPriorities;
+		/// Preferred thread of each task
+		std::vector<Int> mOwners;
+		/// Number of predecessors of each task
+		std::vector<Int> mNumPredecessors;
+		/// Successors of each task
+		std::vector<std::vector<UInt>> mSuccessors;
+		/// Tasks without predecessors
+		std::vector<UInt> mInitialTasks;
+
+		/// Predecessors of each task not finished in the current step
+		std::unique_ptr<std::atomic<Int>[]> mPendingPredecessors;
+		/// Tasks not finished in the current step
+		std::atomic<Int> mRemainingTasks;
+		/// Ready tasks per thread
+		std::vector<std::unique_ptr<ReadyQueue>> mReadyQueues;
+
+		Bool mJoining = false;
+		Real mTime = 0;
+		Int mTimeStepCount = 0;
+	};
+}
@@ -0,0 +1,101 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/AdaptiveTimeStep.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace CPS;
+using namespace DPsim;
+
+AdaptiveTimeStep::AdaptiveTimeStep(Real baseTimeStep, UInt maxLevel, Real relTol, Real absTol, UInt holdSteps) :
+	mBaseTimeStep(baseTimeStep),
+	mMaxLevel(std::min<UInt>(maxLevel, 30)),
+	mRelTol(relTol),
+	mAbsTol(absTol),
+	mHoldSteps(std::max<UInt>(holdSteps, 1)) { }
+
+void AdaptiveTimeStep::addSolutions(const std::vector<const Matrix*>& solutions) {
+	if (mSolutions.size() != solutions.size()) {
+		mSolutions.assign(solutions.size(), std::deque<Matrix>());
+		mTimes.clear();
+	}
+	mTimes.push_back(time());
+	for (std::size_t i = 0; i < solutions.size(); ++i)
+		mSolutions[i].push_back(*solutions[i]);
+	if (mTimes.size() > 4) {
+		mTimes.pop_front();
+		for (auto& history : mSolutions)
+			history.pop_front();
+	}
+
+	mError = 0;
+	if (mTimes.size() < 4)
+		return;
+
+	// Third divided difference, the third derivative is six times of it
+	Real h = mTimes[3] - mTimes[2];
+	for (auto& x : mSolutions) {
+		if (x[3].size() == 0)
+			continue;
+		Matrix d01 = (x[1] - x[0]) / (mTimes[1] - mTimes[0]);
+		Matrix d12 = (x[2] - x[1]) / (mTimes[2] - mTimes[1]);
+		Matrix d23 = (x[3] - x[2]) / (mTimes[3] - mTimes[2]);
+		Matrix d012 = (d12 - d01) / (mTimes[2] - mTimes[0]);
+		Matrix d123 = (d23 - d12) / (mTimes[3] - mTimes[1]);
+		Matrix d0123 = (d123 - d012) / (mTimes[3] - mTimes[0]);
+
+		Real truncation = h * h * h / 2. * d0123.cwiseAbs().maxCoeff();
+		Real tolerance = mAbsTol + mRelTol * x[3].cwiseAbs().maxCoeff();
+		mError = std::max(mError, truncation / tolerance);
+	}
+}
+
+Bool AdaptiveTimeStep::advance(Real limit) {
+	UInt level = mLevel;
+	if (mTimes.size() == 4) {
+		// The error scales with h^3, the factor is the allowed change of the step
+		Real factor = mError > 0 ? 0.8 * std::cbrt(1. / mError) : 2.;
+		if (mError > 1) {
+			for (; level > 0 && factor < 1; --level)
+				factor *= 2;
+			mRaiseSteps = 0;
+		} else if (factor >= 2 && level < mMaxLevel) {
+			if (++mRaiseSteps >= mHoldSteps) {
+				++level;
+				mRaiseSteps = 0;
+			}
+		} else {
+			mRaiseSteps = 0;
+		}
+	}
+
+	// The step must not pass the limit, which is reached exactly if it is on the base grid
+	Real remaining = (limit - time()) / mBaseTimeStep;
+	while (level > 0 && static_cast<Real>(1ULL << level) > remaining + 1e-6)
+		--level;
+
+	Bool changed = level != mLevel;
+	if (changed) {
+		mLevel = level;
+		++mChanges;
+	}
+	mBaseSteps += 1ULL << mLevel;
+	return changed;
+}
+
+void AdaptiveTimeStep::reset() {
+	mLevel = 0;
+	mBaseSteps = 0;
+	mError = 0;
+	mRaiseSteps = 0;
+	mChanges = 0;
+	mTimes.clear();
+	mSolutions.clear();
+}
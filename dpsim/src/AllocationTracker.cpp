@@ -0,0 +1,144 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/AllocationTracker.h>
+
+#include <cstdlib>
+#include <new>
+
+using namespace DPsim;
+
+namespace {
+	// Initial-exec thread locals are accessed without calling the allocator
+	__attribute__((tls_model("initial-exec"))) thread_local bool tArmed = false;
+	__attribute__((tls_model("initial-exec"))) thread_local uint64_t tAllocations = 0;
+	__attribute__((tls_model("initial-exec"))) thread_local uint64_t tBytes = 0;
+
+	inline void count(std::size_t size) {
+		if (tArmed) {
+			++tAllocations;
+			tBytes += size;
+		}
+	}
+}
+
+#ifdef WITH_ALLOCATION_TRACKING
+#ifdef __GLIBC__
+// Interposing malloc also sees the allocations of Eigen and C libraries,
+// operator new of libstdc++ allocates through malloc as well
+extern "C" {
+	void* __libc_malloc(std::size_t size);
+	void* __libc_calloc(std::size_t count, std::size_t size);
+	void* __libc_realloc(void* ptr, std::size_t size);
+
+	void* malloc(std::size_t size) noexcept {
+		count(size);
+		return __libc_malloc(size);
+	}
+
+	void* calloc(std::size_t num, std::size_t size) noexcept {
+		count(num * size);
+		return __libc_calloc(num, size);
+	}
+
+	void* realloc(void* ptr, std::size_t size) noexcept {
+		count(size);
+		return __libc_realloc(ptr, size);
+	}
+}
+#else
+static void* trackedAllocation(std::size_t size) {
+	count(size);
+	void* ptr = std::malloc(size ? size : 1);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new(std::size_t size) {
+	return trackedAllocation(size);
+}
+
+void* operator new[](std::size_t size) {
+	return trackedAllocation(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return trackedAllocation(size);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return trackedAllocation(size);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	std::free(ptr);
+}
+#endif
+
+Bool AllocationTracker::available() {
+	return true;
+}
+#else
+Bool AllocationTracker::available() {
+	return false;
+}
+#endif
+
+void AllocationTracker::arm() {
+	tArmed = true;
+}
+
+void AllocationTracker::disarm() {
+	tArmed = false;
+}
+
+Bool AllocationTracker::armed() {
+	return tArmed;
+}
+
+uint64_t AllocationTracker::allocations() {
+	return tAllocations;
+}
+
+uint64_t AllocationTracker::bytes() {
+	return tBytes;
+}
+
+void AllocationTracker::reset() {
+	tAllocations = 0;
+	tBytes = 0;
+}
@@ -0,0 +1,177 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include <dpsim/BatchPowerflow.h>
+#include <dpsim/PFSolverPowerPolar.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+/// Power flow solver of one thread, which changes the specified injections for the scenarios
+class BatchPowerflow::Worker : public PFSolverPowerPolar {
+public:
+	Worker(String name, const SystemTopology& system, Logger::Level logLevel) :
+		PFSolverPowerPolar(name, system, 1, logLevel) { }
+
+	Worker(const Worker& base) = default;
+
+	void setup(DirectLinearSolverImpl implementation, UInt maxIterations, Bool jacobianReuse) {
+		setDirectLinearSolverImplementation(implementation);
+		setMaxIterations(maxIterations);
+		doJacobianReuse(jacobianReuse);
+		setSolverAndComponentBehaviour(Solver::Behaviour::Simulation);
+		initialize();
+	}
+
+	/// A copy has to factorize its Jacobians with its own solver
+	void resetLinearSolver() {
+		mJacobianSolver = createLinearSolver();
+		mJacobianPatternAnalyzed = false;
+	}
+
+	Bool solveBase() {
+		generateInitialSolution(0);
+		return solvePowerflow();
+	}
+
+	/// Solves the power flow with the changed injections, starting from the base case
+	Bool solveScenario(const std::vector<Injection>& injections, const Worker& base) {
+		Pesp = base.Pesp;
+		Qesp = base.Qesp;
+		for (auto& injection : injections) {
+			Pesp(injection.bus) += injection.activePower;
+			Qesp(injection.bus) += injection.reactivePower;
+		}
+		sol_V = base.sol_V;
+		sol_D = base.sol_D;
+		return solvePowerflow();
+	}
+
+	const std::vector<std::shared_ptr<SP::Ph1::Load>>& loads() const { return mLoads; }
+	Bool isSlackBus(UInt k) const {
+		return std::find(mVDBusIndices.begin(), mVDBusIndices.end(), k) != mVDBusIndices.end();
+	}
+	Bool isPVBus(UInt k) const {
+		return std::find(mPVBusIndices.begin(), mPVBusIndices.end(), k) != mPVBusIndices.end();
+	}
+	Real baseApparentPower() const { return mBaseApparentPower; }
+	Real baseVoltage(const TopologicalNode::Ptr& node) const { return mBaseVoltageAtNode.at(node); }
+	UInt iterations() const { return mIterations; }
+	Complex voltage(UInt k) const { return std::polar(sol_V.coeff(k), sol_D.coeff(k)); }
+};
+
+BatchPowerflow::BatchPowerflow(String name, const SystemTopology& system, Logger::Level logLevel) :
+	mLog(Logger::get(name, logLevel)), mName(name), mSystem(system), mLogLevel(logLevel) { }
+
+BatchPowerflow::~BatchPowerflow() = default;
+
+UInt BatchPowerflow::addScenario(const std::map<String, Complex>& loadPowers) {
+	mScenarios.push_back(loadPowers);
+	return static_cast<UInt>(mScenarios.size() - 1);
+}
+
+void BatchPowerflow::collectInjections() {
+	std::map<String, std::shared_ptr<SP::Ph1::Load>> loads;
+	for (auto load : mBase->loads())
+		loads[load->name()] = load;
+
+	mInjections.assign(mScenarios.size(), {});
+	for (UInt s = 0; s < mScenarios.size(); ++s) {
+		for (auto& loadPower : mScenarios[s]) {
+			auto it = loads.find(loadPower.first);
+			if (it == loads.end())
+				throw SystemError("Scenario load " + loadPower.first + " is not a load of the power flow");
+			auto load = it->second;
+			UInt bus = load->matrixNodeIndex(0);
+			if (mBase->isSlackBus(bus)) {
+				SPDLOG_LOGGER_WARN(mLog, "Load {} at a slack bus does not change the power flow", load->name());
+				continue;
+			}
+
+			// The specified injection of the bus is the negative load
+			Injection injection;
+			injection.bus = bus;
+			injection.activePower = (load->attributeTyped<Real>("P")->get() - loadPower.second.real()) / mBase->baseApparentPower();
+			injection.reactivePower = mBase->isPVBus(bus) ? 0 :
+				(load->attributeTyped<Real>("Q")->get() - loadPower.second.imag()) / mBase->baseApparentPower();
+			mInjections[s].push_back(injection);
+		}
+	}
+}
+
+void BatchPowerflow::storeVoltages(const Worker& worker, BatchPowerflowResult& result) const {
+	result.voltages.resize(mSystem.mNodes.size());
+	for (UInt i = 0; i < mSystem.mNodes.size(); ++i)
+		result.voltages[i] = worker.voltage(mSystem.mNodes[i]->matrixNodeIndex()) * mBaseVoltages[i];
+}
+
+void BatchPowerflow::run() {
+	auto start = std::chrono::steady_clock::now();
+
+	mBase = std::make_unique<Worker>(mName, mSystem, mLogLevel);
+	mBase->setup(mDirectImpl, mMaxIterations, mJacobianReuse);
+	collectInjections();
+	mBaseVoltages.clear();
+	for (auto node : mSystem.mNodes)
+		mBaseVoltages.push_back(mBase->baseVoltage(node));
+
+	mBaseCase = BatchPowerflowResult();
+	mBaseCase.converged = mBase->solveBase();
+	mBaseCase.iterations = mBase->iterations();
+	storeVoltages(*mBase, mBaseCase);
+	if (!mBaseCase.converged)
+		SPDLOG_LOGGER_WARN(mLog, "Base case did not converge, the scenarios start from its last iterate");
+
+	mResults.assign(mScenarios.size(), BatchPowerflowResult());
+
+#ifdef WITH_OPENMP
+	Int numThreads = mNumThreads > 0 ? static_cast<Int>(mNumThreads) : omp_get_max_threads();
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		Worker worker(*mBase);
+		worker.resetLinearSolver();
+
+#ifdef WITH_OPENMP
+		#pragma omp for schedule(dynamic)
+#endif
+		for (Int s = 0; s < static_cast<Int>(mScenarios.size()); ++s) {
+			BatchPowerflowResult& result = mResults[s];
+			result.converged = worker.solveScenario(mInjections[s], *mBase);
+			result.iterations = worker.iterations();
+			storeVoltages(worker, result);
+		}
+	}
+
+	UInt diverged = 0;
+	for (auto& result : mResults) {
+		if (!result.converged)
+			++diverged;
+	}
+	std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+	SPDLOG_LOGGER_INFO(mLog, "{} scenarios in {:.6f} s: {} not converged",
+		mResults.size(), duration.count(), diverged);
+	mLog->flush();
+}
+
+void BatchPowerflow::initWithPowerflow(UInt scenario, SystemTopology& system) const {
+	if (scenario >= mResults.size())
+		throw SystemError("No power flow result for scenario " + std::to_string(scenario));
+
+	for (UInt i = 0; i < mSystem.mNodes.size(); ++i) {
+		if (auto node = system.node<TopologicalNode>(mSystem.mNodes[i]->name()))
+			node->setInitialVoltage(mResults[scenario].voltages[i]);
+	}
+}
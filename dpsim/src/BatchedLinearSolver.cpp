@@ -0,0 +1,79 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/BatchedLinearSolver.h>
+
+using namespace DPsim;
+
+namespace DPsim
+{
+	UInt BatchedLinearSolver::addSystem(const SparseMatrix& systemMatrix)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		if (systemMatrix.rows() != systemMatrix.cols())
+			throw CPS::SystemError("Batched linear solver requires square system matrices.");
+		if (mSystemMatrices.empty())
+			mDimension = static_cast<UInt>(systemMatrix.rows());
+		else if (static_cast<UInt>(systemMatrix.rows()) != mDimension)
+			throw CPS::SystemError("Systems of a batched linear solver must have the same dimension.");
+
+		UInt index = size();
+		mSystemMatrices.push_back(Matrix(systemMatrix));
+		mRightSideVectors.push_back(Matrix::Zero(mDimension, 1));
+		mLeftSideVectors.push_back(Matrix::Zero(mDimension, 1));
+		mFactorizations.emplace_back();
+		mSystemChanged.push_back(true);
+		mChangedSystems.push_back(index);
+
+		SPDLOG_LOGGER_DEBUG(mSLog, "Added system {} of dimension {} to batch", index, mDimension);
+		return index;
+	}
+
+	void BatchedLinearSolver::updateSystem(UInt index, const SparseMatrix& systemMatrix)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mSystemMatrices[index] = Matrix(systemMatrix);
+		if (!mSystemChanged[index]) {
+			mSystemChanged[index] = true;
+			mChangedSystems.push_back(index);
+		}
+	}
+
+	void BatchedLinearSolver::solve()
+	{
+		if (!mChangedSystems.empty()) {
+			factorize();
+			for (auto index : mChangedSystems)
+				mSystemChanged[index] = false;
+			mChangedSystems.clear();
+		}
+		solveBatch();
+	}
+
+	void BatchedLinearSolver::factorize()
+	{
+#ifdef WITH_OPENMP
+		#pragma omp parallel for
+#endif
+		for (std::size_t i = 0; i < mChangedSystems.size(); ++i) {
+			UInt index = mChangedSystems[i];
+			mFactorizations[index].compute(mSystemMatrices[index]);
+		}
+	}
+
+	void BatchedLinearSolver::solveBatch()
+	{
+#ifdef WITH_OPENMP
+		#pragma omp parallel for
+#endif
+		for (std::size_t i = 0; i < mSystemMatrices.size(); ++i)
+			mLeftSideVectors[i] = mFactorizations[i].solve(mRightSideVectors[i]);
+	}
+}
@@ -0,0 +1,85 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/BinaryLoggerBackend.h>
+
+#include <algorithm>
+
+using namespace CPS;
+using namespace DPsim;
+
+BinaryLoggerBackend::BinaryLoggerBackend(UInt bufferRows) :
+	mBufferRows(bufferRows) {
+	if (mBufferRows == 0)
+		throw SystemError("Binary logger requires a buffer of at least one row.");
+}
+
+BinaryLoggerBackend::~BinaryLoggerBackend() {
+	close();
+}
+
+Bool BinaryLoggerBackend::open(const fs::path& filename) {
+	close();
+	mFile = std::ofstream(filename, std::ios_base::out|std::ios_base::trunc|std::ios_base::binary);
+	mDataOffset = 0;
+	return mFile.is_open();
+}
+
+void BinaryLoggerBackend::close() {
+	if (!mFile.is_open())
+		return;
+
+	flush();
+	mFile.close();
+	mColumns = 0;
+}
+
+void BinaryLoggerBackend::setColumns(const std::vector<String>& names, Notation notation) {
+	if (!mFile.is_open())
+		return;
+
+	String joined = "time";
+	for (auto& name : names)
+		joined += "," + name;
+
+	// Aligns the rows for memory mapping
+	mColumns = static_cast<UInt>(names.size()) + 1;
+	mDataOffset = static_cast<UInt>((24 + joined.size() + 7) / 8 * 8);
+	uint32_t header[4] = { Version, mColumns, mDataOffset, static_cast<uint32_t>(joined.size()) };
+	mFile.write("DPSIMBIN", 8);
+	mFile.write(reinterpret_cast<const char*>(header), sizeof(header));
+	mFile.write(joined.data(), static_cast<std::streamsize>(joined.size()));
+	String padding(mDataOffset - 24 - joined.size(), '\0');
+	mFile.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+	mBuffer.resize(static_cast<std::size_t>(mColumns) * mBufferRows);
+	mBufferedRows = 0;
+}
+
+void BinaryLoggerBackend::writeRow(Real time, const Real* values, UInt count) {
+	if (mColumns == 0)
+		return;
+
+	Real* row = mBuffer.data() + static_cast<std::size_t>(mBufferedRows) * mColumns;
+	UInt columns = std::min<UInt>(count, mColumns - 1);
+	row[0] = time;
+	std::copy(values, values + columns, row + 1);
+	std::fill(row + 1 + columns, row + mColumns, 0);
+
+	if (++mBufferedRows == mBufferRows)
+		flush();
+}
+
+void BinaryLoggerBackend::flush() {
+	if (mBufferedRows == 0)
+		return;
+
+	mFile.write(reinterpret_cast<const char*>(mBuffer.data()),
+		static_cast<std::streamsize>(sizeof(Real) * mColumns * mBufferedRows));
+	mBufferedRows = 0;
+}
@@ -0,0 +1,185 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include <dpsim/BlockTriangularForm.h>
+
+using namespace DPsim;
+
+namespace {
+	const UInt unmatched = std::numeric_limits<UInt>::max();
+}
+
+Bool BlockTriangularForm::compute(const SparseMatrix& matrix) {
+	UInt size = static_cast<UInt>(matrix.rows());
+	mColumnPattern.assign(size, {});
+	mRowPattern.assign(size, {});
+	for (Int row = 0; row < matrix.outerSize(); ++row) {
+		for (SparseMatrix::InnerIterator it(matrix, row); it; ++it) {
+			mRowPattern[row].push_back(static_cast<UInt>(it.col()));
+			mColumnPattern[it.col()].push_back(static_cast<UInt>(row));
+		}
+	}
+
+	mBlockColumns.clear();
+	mBlockDependencies.clear();
+	if (!computeTransversal())
+		return false;
+	computeBlocks();
+	return true;
+}
+
+Bool BlockTriangularForm::computeTransversal() {
+	UInt size = static_cast<UInt>(mColumnPattern.size());
+	mColumnRows.assign(size, unmatched);
+	std::vector<UInt> rowColumns(size, unmatched);
+
+	// Cheap assignment of the diagonal or the first free row of each column
+	for (UInt col = 0; col < size; ++col) {
+		if (std::binary_search(mColumnPattern[col].begin(), mColumnPattern[col].end(), col)) {
+			mColumnRows[col] = col;
+			rowColumns[col] = col;
+		}
+	}
+	for (UInt col = 0; col < size; ++col) {
+		if (mColumnRows[col] != unmatched)
+			continue;
+		for (UInt row : mColumnPattern[col]) {
+			if (rowColumns[row] == unmatched) {
+				mColumnRows[col] = row;
+				rowColumns[row] = col;
+				break;
+			}
+		}
+	}
+
+	// Augmenting paths for the remaining columns
+	std::vector<UInt> visited(size, unmatched);
+	std::vector<std::pair<UInt, UInt>> stack;
+	for (UInt start = 0; start < size; ++start) {
+		if (mColumnRows[start] != unmatched)
+			continue;
+
+		Bool augmented = false;
+		stack.assign(1, { start, 0 });
+		while (!stack.empty() && !augmented) {
+			auto& frame = stack.back();
+			auto& pattern = mColumnPattern[frame.first];
+			if (frame.second == pattern.size()) {
+				stack.pop_back();
+				continue;
+			}
+			// Looking ahead for a free row keeps the paths short, so
+			// that few diagonal matches of the cheap assignment move
+			auto free = pattern.end();
+			if (frame.second == 0)
+				free = std::find_if(pattern.begin(), pattern.end(), [&rowColumns](UInt r) { return rowColumns[r] == unmatched; });
+			UInt row;
+			if (free != pattern.end()) {
+				row = *free;
+			} else {
+				row = pattern[frame.second++];
+				if (visited[row] == start)
+					continue;
+				visited[row] = start;
+			}
+
+			if (rowColumns[row] == unmatched) {
+				// Shift the matches along the path
+				for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+					UInt previous = mColumnRows[it->first];
+					mColumnRows[it->first] = row;
+					rowColumns[row] = it->first;
+					row = previous;
+				}
+				augmented = true;
+			} else {
+				stack.push_back({ rowColumns[row], 0 });
+			}
+		}
+		if (!augmented)
+			return false;
+	}
+	return true;
+}
+
+void BlockTriangularForm::computeBlocks() {
+	UInt size = static_cast<UInt>(mColumnPattern.size());
+	mColumnBlocks.assign(size, unmatched);
+
+	// Column k depends on the columns with entries in the row matched to k.
+	// Tarjan's algorithm finishes a component after all components it
+	// depends on, so the blocks are found in their solve order.
+	std::vector<UInt> index(size, unmatched), lowLink(size, 0);
+	std::vector<UInt> componentStack;
+	std::vector<Bool> onStack(size, false);
+	std::vector<std::pair<UInt, UInt>> callStack;
+	UInt nextIndex = 0;
+
+	for (UInt root = 0; root < size; ++root) {
+		if (index[root] != unmatched)
+			continue;
+
+		callStack.assign(1, { root, 0 });
+		index[root] = lowLink[root] = nextIndex++;
+		componentStack.push_back(root);
+		onStack[root] = true;
+
+		while (!callStack.empty()) {
+			auto& frame = callStack.back();
+			UInt col = frame.first;
+			auto& successors = mRowPattern[mColumnRows[col]];
+			if (frame.second < successors.size()) {
+				UInt next = successors[frame.second++];
+				if (index[next] == unmatched) {
+					index[next] = lowLink[next] = nextIndex++;
+					componentStack.push_back(next);
+					onStack[next] = true;
+					callStack.push_back({ next, 0 });
+				} else if (onStack[next]) {
+					lowLink[col] = std::min(lowLink[col], index[next]);
+				}
+				continue;
+			}
+
+			if (lowLink[col] == index[col]) {
+				UInt block = static_cast<UInt>(mBlockColumns.size());
+				mBlockColumns.emplace_back();
+				UInt member;
+				do {
+					member = componentStack.back();
+					componentStack.pop_back();
+					onStack[member] = false;
+					mColumnBlocks[member] = block;
+					mBlockColumns[block].push_back(member);
+				} while (member != col);
+				std::sort(mBlockColumns[block].begin(), mBlockColumns[block].end());
+			}
+			callStack.pop_back();
+			if (!callStack.empty()) {
+				UInt parent = callStack.back().first;
+				lowLink[parent] = std::min(lowLink[parent], lowLink[col]);
+			}
+		}
+	}
+
+	mBlockDependencies.assign(mBlockColumns.size(), {});
+	for (UInt block = 0; block < mBlockColumns.size(); ++block) {
+		auto& dependencies = mBlockDependencies[block];
+		for (UInt col : mBlockColumns[block]) {
+			for (UInt other : mRowPattern[mColumnRows[col]]) {
+				if (mColumnBlocks[other] != block)
+					dependencies.push_back(mColumnBlocks[other]);
+			}
+		}
+		std::sort(dependencies.begin(), dependencies.end());
+		dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+	}
+}
@@ -0,0 +1,52 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/CSVLoggerBackend.h>
+
+#include <iterator>
+
+#include <fmt/format.h>
+
+using namespace DPsim;
+
+Bool CSVLoggerBackend::open(const fs::path& filename) {
+	mFile = std::ofstream(filename, std::ios_base::out|std::ios_base::trunc);
+	mHasColumns = false;
+	return mFile.is_open();
+}
+
+void CSVLoggerBackend::close() {
+	mFile.close();
+}
+
+void CSVLoggerBackend::setColumns(const std::vector<String>& names, Notation notation) {
+	mLine.clear();
+	fmt::format_to(std::back_inserter(mLine), "{:>14}", "time");
+	for (auto& name : names)
+		fmt::format_to(std::back_inserter(mLine), ", {:>13}", name);
+	mLine += '\n';
+	mFile << mLine;
+
+	mNotation = notation;
+	mHasColumns = true;
+}
+
+void CSVLoggerBackend::writeRow(Real time, const Real* values, UInt count) {
+	// Same formatting as std::scientific and std::to_string with the previous stream output
+	mLine.clear();
+	fmt::format_to(std::back_inserter(mLine), "{:>14e}", time);
+	if (mNotation == Notation::Fixed) {
+		for (UInt i = 0; i < count; ++i)
+			fmt::format_to(std::back_inserter(mLine), ", {:>13f}", values[i]);
+	} else {
+		for (UInt i = 0; i < count; ++i)
+			fmt::format_to(std::back_inserter(mLine), ", {:>13e}", values[i]);
+	}
+	mLine += '\n';
+	mFile << mLine;
+}
@@ -0,0 +1,209 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <dpsim/Checkpoint.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+namespace {
+	template <typename T>
+	void writeValue(std::ofstream& file, const T& value) {
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	T readValue(std::ifstream& file) {
+		T value;
+		if (!file.read(reinterpret_cast<char*>(&value), sizeof(T)))
+			throw SystemError("Checkpoint file is truncated.");
+		return value;
+	}
+
+	void writeString(std::ofstream& file, const String& value) {
+		writeValue<uint32_t>(file, static_cast<uint32_t>(value.size()));
+		file.write(value.data(), static_cast<std::streamsize>(value.size()));
+	}
+
+	String readString(std::ifstream& file) {
+		String value(readValue<uint32_t>(file), '\0');
+		if (!file.read(&value[0], static_cast<std::streamsize>(value.size())))
+			throw SystemError("Checkpoint file is truncated.");
+		return value;
+	}
+
+	template <typename M>
+	Checkpoint::Value fromMatrix(Checkpoint::Type type, const M& matrix) {
+		Checkpoint::Value value { type, static_cast<UInt>(matrix.rows()), static_cast<UInt>(matrix.cols()), {} };
+		const Real* data = reinterpret_cast<const Real*>(matrix.data());
+		UInt count = static_cast<UInt>(matrix.size() * sizeof(typename M::Scalar) / sizeof(Real));
+		value.data.assign(data, data + count);
+		return value;
+	}
+
+	template <typename M>
+	M toMatrix(const Checkpoint::Value& value) {
+		M matrix(value.rows, value.cols);
+		std::copy(value.data.begin(), value.data.end(), reinterpret_cast<Real*>(matrix.data()));
+		return matrix;
+	}
+}
+
+Bool Checkpoint::capture(const String& key, AttributeBase::Ptr attr) {
+	if (!attr->isStatic())
+		return false;
+
+	AttributeBase* base = attr.getPtr().get();
+	if (auto real = dynamic_cast<Attribute<Real>*>(base))
+		values[key] = { Type::Real, 1, 1, { real->get() } };
+	else if (auto complex = dynamic_cast<Attribute<Complex>*>(base))
+		values[key] = { Type::Complex, 1, 1, { complex->get().real(), complex->get().imag() } };
+	else if (auto integer = dynamic_cast<Attribute<Int>*>(base))
+		values[key] = { Type::Int, 1, 1, { static_cast<Real>(integer->get()) } };
+	else if (auto uinteger = dynamic_cast<Attribute<UInt>*>(base))
+		values[key] = { Type::UInt, 1, 1, { static_cast<Real>(uinteger->get()) } };
+	else if (auto boolean = dynamic_cast<Attribute<Bool>*>(base))
+		values[key] = { Type::Bool, 1, 1, { boolean->get() ? 1. : 0. } };
+	else if (auto matrix = dynamic_cast<Attribute<Matrix>*>(base))
+		values[key] = fromMatrix(Type::Matrix, matrix->get());
+	else if (auto matrixComp = dynamic_cast<Attribute<MatrixComp>*>(base))
+		values[key] = fromMatrix(Type::MatrixComp, matrixComp->get());
+	else
+		return false;
+	return true;
+}
+
+Bool Checkpoint::restore(const String& key, AttributeBase::Ptr attr) const {
+	auto entry = values.find(key);
+	if (entry == values.end() || !attr->isStatic())
+		return false;
+
+	const Value& value = entry->second;
+	AttributeBase* base = attr.getPtr().get();
+	switch (value.type) {
+	case Type::Real:
+		if (auto real = dynamic_cast<Attribute<Real>*>(base)) {
+			real->set(value.data[0]);
+			return true;
+		}
+		return false;
+	case Type::Complex:
+		if (auto complex = dynamic_cast<Attribute<Complex>*>(base)) {
+			complex->set({ value.data[0], value.data[1] });
+			return true;
+		}
+		return false;
+	case Type::Int:
+		if (auto integer = dynamic_cast<Attribute<Int>*>(base)) {
+			integer->set(static_cast<Int>(value.data[0]));
+			return true;
+		}
+		return false;
+	case Type::UInt:
+		if (auto uinteger = dynamic_cast<Attribute<UInt>*>(base)) {
+			uinteger->set(static_cast<UInt>(value.data[0]));
+			return true;
+		}
+		return false;
+	case Type::Bool:
+		if (auto boolean = dynamic_cast<Attribute<Bool>*>(base)) {
+			boolean->set(value.data[0] != 0);
+			return true;
+		}
+		return false;
+	case Type::Matrix:
+		if (auto matrix = dynamic_cast<Attribute<Matrix>*>(base)) {
+			if (matrix->get().rows() != value.rows || matrix->get().cols() != value.cols)
+				return false;
+			matrix->set(toMatrix<Matrix>(value));
+			return true;
+		}
+		return false;
+	case Type::MatrixComp:
+		if (auto matrixComp = dynamic_cast<Attribute<MatrixComp>*>(base)) {
+			if (matrixComp->get().rows() != value.rows || matrixComp->get().cols() != value.cols)
+				return false;
+			matrixComp->set(toMatrix<MatrixComp>(value));
+			return true;
+		}
+		return false;
+	}
+	return false;
+}
+
+void Checkpoint::save(const fs::path& filename) const {
+	std::ofstream file(filename, std::ios_base::out|std::ios_base::trunc|std::ios_base::binary);
+	if (!file.is_open())
+		throw SystemError("Cannot open checkpoint file " + filename.string());
+
+	file.write("DPSIMCKP", 8);
+	writeValue<uint32_t>(file, Version);
+	writeValue<Real>(file, time);
+	writeValue<int64_t>(file, timeStepCount);
+	writeValue<Real>(file, timeStep);
+
+	writeValue<uint32_t>(file, static_cast<uint32_t>(eventTimes.size()));
+	for (auto eventTime : eventTimes)
+		writeValue<Real>(file, eventTime);
+
+	writeValue<uint32_t>(file, static_cast<uint32_t>(values.size()));
+	for (auto& entry : values) {
+		writeString(file, entry.first);
+		writeValue<uint32_t>(file, static_cast<uint32_t>(entry.second.type));
+		writeValue<uint32_t>(file, entry.second.rows);
+		writeValue<uint32_t>(file, entry.second.cols);
+		file.write(reinterpret_cast<const char*>(entry.second.data.data()),
+			static_cast<std::streamsize>(sizeof(Real) * entry.second.data.size()));
+	}
+
+	if (!file)
+		throw SystemError("Cannot write checkpoint file " + filename.string());
+}
+
+Checkpoint Checkpoint::load(const fs::path& filename) {
+	std::ifstream file(filename, std::ios_base::in|std::ios_base::binary);
+	if (!file.is_open())
+		throw SystemError("Cannot open checkpoint file " + filename.string());
+
+	char magic[8];
+	if (!file.read(magic, 8) || std::memcmp(magic, "DPSIMCKP", 8) != 0)
+		throw SystemError(filename.string() + " is not a checkpoint file.");
+	if (readValue<uint32_t>(file) != Version)
+		throw SystemError("Unsupported checkpoint version in " + filename.string());
+
+	Checkpoint checkpoint;
+	checkpoint.time = readValue<Real>(file);
+	checkpoint.timeStepCount = static_cast<Int>(readValue<int64_t>(file));
+	checkpoint.timeStep = readValue<Real>(file);
+
+	checkpoint.eventTimes.resize(readValue<uint32_t>(file));
+	for (auto& eventTime : checkpoint.eventTimes)
+		eventTime = readValue<Real>(file);
+
+	uint32_t count = readValue<uint32_t>(file);
+	for (uint32_t i = 0; i < count; ++i) {
+		String key = readString(file);
+		Value value;
+		value.type = static_cast<Type>(readValue<uint32_t>(file));
+		value.rows = readValue<uint32_t>(file);
+		value.cols = readValue<uint32_t>(file);
+
+		std::size_t elements = static_cast<std::size_t>(value.rows) * value.cols;
+		if (value.type == Type::Complex || value.type == Type::MatrixComp)
+			elements *= 2;
+		value.data.resize(elements);
+		if (!file.read(reinterpret_cast<char*>(value.data.data()), static_cast<std::streamsize>(sizeof(Real) * elements)))
+			throw SystemError("Checkpoint file is truncated.");
+		checkpoint.values[key] = std::move(value);
+	}
+	return checkpoint;
+}
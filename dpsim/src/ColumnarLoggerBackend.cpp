@@ -0,0 +1,67 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/ColumnarLoggerBackend.h>
+
+#include <algorithm>
+
+using namespace CPS;
+using namespace DPsim;
+
+ColumnarLoggerBackend::ColumnarLoggerBackend(UInt initialRows) :
+	mInitialRows(std::max<UInt>(initialRows, 1)),
+	mStorage(std::make_shared<Storage>()) {
+}
+
+Bool ColumnarLoggerBackend::open(const fs::path& filename) {
+	// The rows of the previous run stay readable until the columns are set
+	mHasColumns = false;
+	return true;
+}
+
+void ColumnarLoggerBackend::reserve(UInt rows) {
+	mReservedRows = rows;
+}
+
+void ColumnarLoggerBackend::setColumns(const std::vector<String>& names, Notation notation) {
+	mNames.clear();
+	mNames.push_back("time");
+	mNames.insert(mNames.end(), names.begin(), names.end());
+
+	// A new storage instead of resizing, views of the previous run keep their values
+	mStorage = std::make_shared<Storage>();
+	mRows = 0;
+	grow(std::max(mInitialRows, mReservedRows));
+	mHasColumns = true;
+}
+
+void ColumnarLoggerBackend::grow(UInt capacity) {
+	auto storage = std::make_shared<Storage>();
+	storage->capacity = capacity;
+	storage->values.assign(static_cast<std::size_t>(capacity) * mNames.size(), 0);
+	for (UInt c = 0; c < mNames.size() && mRows > 0; ++c)
+		std::copy(mStorage->column(c), mStorage->column(c) + mRows,
+			storage->values.begin() + static_cast<std::size_t>(c) * capacity);
+	mStorage = storage;
+}
+
+void ColumnarLoggerBackend::writeRow(Real time, const Real* values, UInt count) {
+	if (!mHasColumns)
+		return;
+
+	if (mRows == mStorage->capacity)
+		grow(2 * mStorage->capacity);
+
+	UInt capacity = mStorage->capacity;
+	Real* data = mStorage->values.data();
+	data[mRows] = time;
+	UInt columns = static_cast<UInt>(mNames.size());
+	for (UInt c = 1; c < columns; ++c)
+		data[static_cast<std::size_t>(c) * capacity + mRows] = c <= count ? values[c - 1] : 0;
+	++mRows;
+}
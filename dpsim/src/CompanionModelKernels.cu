@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/Cuda/CompanionModelKernels.h>
+
+namespace DPsim {
+namespace cuda {
+
+namespace {
+	constexpr int ThreadsPerBlock = 256;
+
+	__device__ void addTo(double* address, double value) {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ < 600
+		// No native atomic add of doubles before compute capability 6.0
+		unsigned long long* bits = reinterpret_cast<unsigned long long*>(address);
+		unsigned long long old = *bits, assumed;
+		do {
+			assumed = old;
+			old = atomicCAS(bits, assumed, __double_as_longlong(value + __longlong_as_double(assumed)));
+		} while (assumed != old);
+#else
+		atomicAdd(address, value);
+#endif
+	}
+
+	template <int NumPhases>
+	__global__ void preStepKernel(CompanionModelArrays models, double* rightSide, const int* permutation) {
+		const int n = models.count;
+		const int k = blockIdx.x * blockDim.x + threadIdx.x;
+		if (k >= n)
+			return;
+
+		for (int a = 0; a < NumPhases; ++a) {
+			double value = models.currentCoeff[k] * models.current[a * n + k];
+			for (int b = 0; b < NumPhases; ++b)
+				value += models.voltageCoeff[(a * NumPhases + b) * n + k] * models.voltage[b * n + k];
+			models.equivCurrent[a * n + k] = value;
+
+			// Models sharing a node add to the same row
+			const int row0 = models.rows0[a * n + k];
+			const int row1 = models.rows1[a * n + k];
+			if (row0 >= 0)
+				addTo(&rightSide[permutation[row0]], value);
+			if (row1 >= 0)
+				addTo(&rightSide[permutation[row1]], -value);
+		}
+	}
+
+	template <int NumPhases>
+	__global__ void postStepKernel(CompanionModelArrays models, const double* leftSide) {
+		const int n = models.count;
+		const int k = blockIdx.x * blockDim.x + threadIdx.x;
+		if (k >= n)
+			return;
+
+		// v1 - v0
+		double voltage[NumPhases];
+		for (int a = 0; a < NumPhases; ++a) {
+			const int row0 = models.rows0[a * n + k];
+			const int row1 = models.rows1[a * n + k];
+			voltage[a] = (row1 >= 0 ? leftSide[row1] : 0.) - (row0 >= 0 ? leftSide[row0] : 0.);
+			models.voltage[a * n + k] = voltage[a];
+		}
+		for (int a = 0; a < NumPhases; ++a) {
+			double current = models.equivCurrent[a * n + k];
+			for (int b = 0; b < NumPhases; ++b)
+				current += models.equivCond[(a * NumPhases + b) * n + k] * voltage[b];
+			models.current[a * n + k] = current;
+		}
+	}
+
+	int numBlocks(int count) {
+		return (count + ThreadsPerBlock - 1) / ThreadsPerBlock;
+	}
+}
+
+template <int NumPhases>
+void companionModelPreStep(const CompanionModelArrays& models, double* rightSide, const int* permutation, cudaStream_t stream) {
+	if (models.count > 0)
+		preStepKernel<NumPhases><<<numBlocks(models.count), ThreadsPerBlock, 0, stream>>>(models, rightSide, permutation);
+}
+
+template <int NumPhases>
+void companionModelPostStep(const CompanionModelArrays& models, const double* leftSide, cudaStream_t stream) {
+	if (models.count > 0)
+		postStepKernel<NumPhases><<<numBlocks(models.count), ThreadsPerBlock, 0, stream>>>(models, leftSide);
+}
+
+template void companionModelPreStep<1>(const CompanionModelArrays&, double*, const int*, cudaStream_t);
+template void companionModelPreStep<3>(const CompanionModelArrays&, double*, const int*, cudaStream_t);
+template void companionModelPostStep<1>(const CompanionModelArrays&, const double*, cudaStream_t);
+template void companionModelPostStep<3>(const CompanionModelArrays&, const double*, cudaStream_t);
+
+}
+}
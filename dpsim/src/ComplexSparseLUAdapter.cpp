@@ -0,0 +1,157 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/ComplexSparseLUAdapter.h>
+#include <dpsim/MemoryReport.h>
+
+using namespace DPsim;
+
+namespace DPsim
+{
+    ComplexSparseLUAdapter::~ComplexSparseLUAdapter() = default;
+
+    void ComplexSparseLUAdapter::applyConfiguration()
+    {
+        SPDLOG_LOGGER_INFO(mSLog, "Complex sparse LU has no configuration options");
+    }
+
+    Bool ComplexSparseLUAdapter::toComplex(const SparseMatrix& systemMatrix)
+    {
+        const Int n = static_cast<Int>(systemMatrix.rows());
+        if (n == 0 || n % 2 != 0 || systemMatrix.cols() != n)
+            return false;
+        const Int half = n / 2;
+
+        // The upper half rows hold the real parts and the negated imaginary parts
+        std::vector<Eigen::Triplet<Complex>> entries;
+        entries.reserve(static_cast<std::size_t>(systemMatrix.nonZeros() / 2));
+        for (Int row = 0; row < half; ++row) {
+            for (SparseMatrix::InnerIterator it(systemMatrix, row); it; ++it) {
+                if (it.col() < half)
+                    entries.emplace_back(row, it.col(), Complex(it.value(), 0));
+                else
+                    entries.emplace_back(row, it.col() - half, Complex(0, -it.value()));
+            }
+        }
+        CPS::SparseMatrixComp complexMatrix(half, half);
+        complexMatrix.setFromTriplets(entries.begin(), entries.end());
+
+        // The lower half rows have to repeat them as [Im Re]
+        std::vector<Eigen::Triplet<Real>> realForm;
+        realForm.reserve(4 * static_cast<std::size_t>(complexMatrix.nonZeros()));
+        for (Int col = 0; col < complexMatrix.outerSize(); ++col) {
+            for (CPS::SparseMatrixComp::InnerIterator it(complexMatrix, col); it; ++it) {
+                Int row = static_cast<Int>(it.row());
+                realForm.emplace_back(row, col, it.value().real());
+                realForm.emplace_back(row + half, col + half, it.value().real());
+                realForm.emplace_back(row, col + half, -it.value().imag());
+                realForm.emplace_back(row + half, col, it.value().imag());
+            }
+        }
+        SparseMatrix reconstructed(n, n);
+        reconstructed.setFromTriplets(realForm.begin(), realForm.end());
+        if ((reconstructed - systemMatrix).norm() > 1e-12 * systemMatrix.norm())
+            return false;
+
+        mComplexMatrix = std::move(complexMatrix);
+        return true;
+    }
+
+    void ComplexSparseLUAdapter::logForm(const SparseMatrix& systemMatrix, Bool complexForm)
+    {
+        if (complexForm)
+            SPDLOG_LOGGER_INFO(mSLog, "System matrix of dimension {} is factorized in complex form", systemMatrix.rows());
+        else
+            SPDLOG_LOGGER_INFO(mSLog, "System matrix of dimension {} is not the real form of a complex matrix, it is factorized as real matrix",
+                systemMatrix.rows());
+    }
+
+    void ComplexSparseLUAdapter::compute(SparseMatrix& systemMatrix, Bool analyze)
+    {
+        Bool complexForm = toComplex(systemMatrix);
+        if (complexForm != mComplexForm) {
+            logForm(systemMatrix, complexForm);
+            analyze = true;
+        }
+        mComplexForm = complexForm;
+
+        if (mComplexForm) {
+            if (analyze)
+                mComplexLU.analyzePattern(mComplexMatrix);
+            mComplexLU.factorize(mComplexMatrix);
+        } else {
+            if (analyze)
+                mRealLU.analyzePattern(systemMatrix);
+            mRealLU.factorize(systemMatrix);
+        }
+        mFactorized = true;
+    }
+
+    void ComplexSparseLUAdapter::preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
+    {
+        mComplexForm = toComplex(systemMatrix);
+        logForm(systemMatrix, mComplexForm);
+        if (mComplexForm)
+            mComplexLU.analyzePattern(mComplexMatrix);
+        else
+            mRealLU.analyzePattern(systemMatrix);
+        mFactorized = false;
+    }
+
+    void ComplexSparseLUAdapter::factorize(SparseMatrix& systemMatrix)
+    {
+        compute(systemMatrix, false);
+    }
+
+    void ComplexSparseLUAdapter::refactorize(SparseMatrix& systemMatrix)
+    {
+        /* Eigen's SparseLU does not use refactorization. The pattern is analyzed again, since the complex pattern is rebuilt */
+        compute(systemMatrix, true);
+    }
+
+    void ComplexSparseLUAdapter::partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
+    {
+        compute(systemMatrix, true);
+    }
+
+    Matrix ComplexSparseLUAdapter::solve(Matrix& rightSideVector)
+    {
+        Matrix leftSideVector;
+        solveInPlace(rightSideVector, leftSideVector);
+        return leftSideVector;
+    }
+
+    void ComplexSparseLUAdapter::solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector)
+    {
+        if (!mComplexForm) {
+            leftSideVector = mRealLU.solve(rightSideVector);
+            return;
+        }
+
+        const Eigen::Index half = rightSideVector.rows() / 2;
+        mComplexRightSide.resize(half, rightSideVector.cols());
+        mComplexRightSide.real() = rightSideVector.topRows(half);
+        mComplexRightSide.imag() = rightSideVector.bottomRows(half);
+        mComplexSolution = mComplexLU.solve(mComplexRightSide);
+
+        leftSideVector.resize(rightSideVector.rows(), rightSideVector.cols());
+        leftSideVector.topRows(half) = mComplexSolution.real();
+        leftSideVector.bottomRows(half) = mComplexSolution.imag();
+    }
+
+    std::size_t ComplexSparseLUAdapter::memoryBytes() const
+    {
+        if (!mFactorized)
+            return 0;
+        // The supernodal factors hold a value and a row index per nonzero
+        if (!mComplexForm)
+            return static_cast<std::size_t>(mRealLU.nnzL() + mRealLU.nnzU()) * (sizeof(Real) + sizeof(int));
+        return static_cast<std::size_t>(mComplexLU.nnzL() + mComplexLU.nnzU()) * (sizeof(Complex) + sizeof(int))
+            + static_cast<std::size_t>(mComplexMatrix.nonZeros()) * (sizeof(Complex) + sizeof(int));
+    }
+}
@@ -0,0 +1,187 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/CompressedLoggerBackend.h>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _MSC_VER
+  #include <intrin.h>
+#endif
+
+using namespace CPS;
+using namespace DPsim;
+
+namespace {
+	/// Appends bits to a byte vector, starting with the most significant bit of each byte
+	class BitWriter {
+	public:
+		BitWriter(std::vector<uint8_t>& bytes) : mBytes(bytes) {
+			mBytes.clear();
+		}
+
+		/// Writes the lowest bits of the value, most significant first
+		void write(uint64_t value, unsigned bits) {
+			while (bits > 0) {
+				if (mUsed == 0)
+					mBytes.push_back(0);
+				unsigned space = 8 - mUsed;
+				unsigned take = std::min(space, bits);
+				uint8_t part = static_cast<uint8_t>((value >> (bits - take)) & ((1u << take) - 1));
+				mBytes.back() |= static_cast<uint8_t>(part << (space - take));
+				mUsed = (mUsed + take) % 8;
+				bits -= take;
+			}
+		}
+
+	private:
+		std::vector<uint8_t>& mBytes;
+		/// Bits used in the last byte
+		unsigned mUsed = 0;
+	};
+
+	unsigned leadingZeros(uint64_t value) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanReverse64(&index, value);
+		return 63 - static_cast<unsigned>(index);
+#else
+		return static_cast<unsigned>(__builtin_clzll(value));
+#endif
+	}
+
+	unsigned trailingZeros(uint64_t value) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return static_cast<unsigned>(index);
+#else
+		return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+	}
+
+	void encodeColumn(const Real* values, UInt rows, std::vector<uint8_t>& bytes) {
+		BitWriter writer(bytes);
+		if (rows == 0)
+			return;
+
+		uint64_t previous;
+		std::memcpy(&previous, values, sizeof(previous));
+		writer.write(previous, 64);
+
+		// No window before the first non-zero XOR
+		unsigned windowLeading = 64, windowTrailing = 0;
+		for (UInt i = 1; i < rows; ++i) {
+			uint64_t current;
+			std::memcpy(&current, values + i, sizeof(current));
+			uint64_t delta = current ^ previous;
+			previous = current;
+
+			if (delta == 0) {
+				writer.write(0, 1);
+				continue;
+			}
+
+			unsigned leading = std::min(leadingZeros(delta), 31u);
+			unsigned trailing = trailingZeros(delta);
+			if (windowLeading < 64 && leading >= windowLeading && trailing >= windowTrailing) {
+				writer.write(0b10, 2);
+				writer.write(delta >> windowTrailing, 64 - windowLeading - windowTrailing);
+			} else {
+				unsigned significant = 64 - leading - trailing;
+				writer.write(0b11, 2);
+				writer.write(leading, 5);
+				writer.write(significant & 63, 6);
+				writer.write(delta >> trailing, significant);
+				windowLeading = leading;
+				windowTrailing = trailing;
+			}
+		}
+	}
+
+	void writeUInt32(std::ofstream& file, uint32_t value) {
+		uint8_t bytes[4] = {
+			static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+			static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)
+		};
+		file.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+	}
+}
+
+CompressedLoggerBackend::CompressedLoggerBackend(UInt chunkRows) :
+	mChunkRows(chunkRows) {
+	if (mChunkRows == 0)
+		throw SystemError("Compressed logger requires a chunk size of at least one row.");
+}
+
+CompressedLoggerBackend::~CompressedLoggerBackend() {
+	close();
+}
+
+Bool CompressedLoggerBackend::open(const fs::path& filename) {
+	close();
+	mFile = std::ofstream(filename, std::ios_base::out|std::ios_base::trunc|std::ios_base::binary);
+	return mFile.is_open();
+}
+
+void CompressedLoggerBackend::close() {
+	if (!mFile.is_open())
+		return;
+
+	flush();
+	mFile.close();
+	mColumns = 0;
+}
+
+void CompressedLoggerBackend::setColumns(const std::vector<String>& names, Notation notation) {
+	if (!mFile.is_open())
+		return;
+
+	String joined = "time";
+	for (auto& name : names)
+		joined += "," + name;
+
+	mColumns = static_cast<UInt>(names.size()) + 1;
+	mFile.write("DPSIMXOR", 8);
+	writeUInt32(mFile, Version);
+	writeUInt32(mFile, mColumns);
+	writeUInt32(mFile, static_cast<uint32_t>(joined.size()));
+	mFile.write(joined.data(), static_cast<std::streamsize>(joined.size()));
+
+	mBuffer.assign(static_cast<std::size_t>(mColumns) * mChunkRows, 0);
+	mBufferedRows = 0;
+}
+
+void CompressedLoggerBackend::writeRow(Real time, const Real* values, UInt count) {
+	if (mColumns == 0)
+		return;
+
+	UInt columns = std::min<UInt>(count, mColumns - 1);
+	mBuffer[mBufferedRows] = time;
+	for (UInt i = 0; i < columns; ++i)
+		mBuffer[(i + 1) * mChunkRows + mBufferedRows] = values[i];
+	for (UInt i = columns; i < mColumns - 1; ++i)
+		mBuffer[(i + 1) * mChunkRows + mBufferedRows] = 0;
+
+	if (++mBufferedRows == mChunkRows)
+		flush();
+}
+
+void CompressedLoggerBackend::flush() {
+	if (mBufferedRows == 0)
+		return;
+
+	writeUInt32(mFile, mBufferedRows);
+	for (UInt i = 0; i < mColumns; ++i) {
+		encodeColumn(&mBuffer[i * mChunkRows], mBufferedRows, mEncoded);
+		writeUInt32(mFile, static_cast<uint32_t>(mEncoded.size()));
+		mFile.write(reinterpret_cast<const char*>(mEncoded.data()), static_cast<std::streamsize>(mEncoded.size()));
+	}
+	mBufferedRows = 0;
+}
@@ -0,0 +1,276 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include <dpsim/ContingencyAnalysis.h>
+#include <dpsim/PFSolverPowerPolar.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+/// Power flow solver of one thread, which changes its admittance matrix for the outages
+class ContingencyAnalysis::Worker : public PFSolverPowerPolar {
+public:
+	Worker(String name, const SystemTopology& system, Logger::Level logLevel) :
+		PFSolverPowerPolar(name, system, 1, logLevel) { }
+
+	Worker(const Worker& base) = default;
+
+	void setup(DirectLinearSolverImpl implementation, UInt maxIterations, Bool jacobianReuse) {
+		setDirectLinearSolverImplementation(implementation);
+		setMaxIterations(maxIterations);
+		doJacobianReuse(jacobianReuse);
+		setSolverAndComponentBehaviour(Solver::Behaviour::Simulation);
+		initialize();
+	}
+
+	/// A copy has to factorize its Jacobians with its own solver
+	void resetLinearSolver() {
+		mJacobianSolver = createLinearSolver();
+		mJacobianPatternAnalyzed = false;
+	}
+
+	Bool solveBase() {
+		generateInitialSolution(0);
+		return solvePowerflow();
+	}
+
+	/// Solves the power flow without the branch, starting from the base case
+	Bool solveOutage(const Branch& branch, const Worker& base) {
+		Complex* values = mY.valuePtr();
+		const Complex* baseValues = base.mY.valuePtr();
+		for (UInt i = 0; i < 2; ++i)
+			for (UInt j = 0; j < 2; ++j)
+				values[branch.slot[i][j]] = baseValues[branch.slot[i][j]] - branch.y[i][j];
+
+		sol_V = base.sol_V;
+		sol_D = base.sol_D;
+		Bool converged = solvePowerflow();
+
+		for (UInt i = 0; i < 2; ++i)
+			for (UInt j = 0; j < 2; ++j)
+				values[branch.slot[i][j]] = baseValues[branch.slot[i][j]];
+		return converged;
+	}
+
+	const SparseMatrixCompRow& admittance() const { return mY; }
+	const std::vector<UInt>& slackBuses() const { return mVDBusIndices; }
+	const std::vector<std::shared_ptr<SP::Ph1::PiLine>>& lines() const { return mLines; }
+	const std::vector<std::shared_ptr<SP::Ph1::Transformer>>& transformers() const { return mTransformers; }
+	Real baseApparentPower() const { return mBaseApparentPower; }
+	UInt iterations() const { return mIterations; }
+	Real magnitude(UInt k) const { return sol_V.coeff(k); }
+	Complex voltage(UInt k) const { return std::polar(sol_V.coeff(k), sol_D.coeff(k)); }
+};
+
+ContingencyAnalysis::ContingencyAnalysis(String name, const SystemTopology& system, Logger::Level logLevel) :
+	mLog(Logger::get(name, logLevel)), mName(name), mSystem(system), mLogLevel(logLevel) { }
+
+ContingencyAnalysis::~ContingencyAnalysis() = default;
+
+void ContingencyAnalysis::collectBranches() {
+	const SparseMatrixCompRow& Y = mBase->admittance();
+	UInt numBuses = static_cast<UInt>(Y.rows());
+
+	auto slot = [&Y](UInt row, UInt col) {
+		const Int* begin = Y.innerIndexPtr() + Y.outerIndexPtr()[row];
+		const Int* end = Y.innerIndexPtr() + Y.outerIndexPtr()[row + 1];
+		const Int* it = std::lower_bound(begin, end, static_cast<Int>(col));
+		if (it == end || *it != static_cast<Int>(col))
+			throw SystemError("Branch entry missing in the admittance matrix");
+		return static_cast<Int>(it - Y.innerIndexPtr());
+	};
+
+	auto addBranch = [&](const String& name, PFSolverInterfaceBranch& stamp, UInt bus0, UInt bus1) {
+		if (bus0 == bus1)
+			return;
+		SparseMatrixCompRow element(numBuses, numBuses);
+		stamp.pfApplyAdmittanceMatrixStamp(element);
+
+		Branch branch;
+		branch.name = name;
+		branch.bus[0] = bus0;
+		branch.bus[1] = bus1;
+		for (UInt i = 0; i < 2; ++i) {
+			for (UInt j = 0; j < 2; ++j) {
+				branch.y[i][j] = element.coeff(branch.bus[i], branch.bus[j]);
+				branch.slot[i][j] = slot(branch.bus[i], branch.bus[j]);
+			}
+		}
+		mBranches.push_back(branch);
+	};
+
+	mBranches.clear();
+	for (auto line : mBase->lines())
+		addBranch(line->name(), *line, line->matrixNodeIndex(0), line->matrixNodeIndex(1));
+	for (auto trafo : mBase->transformers()) {
+		// Same as for the admittance matrix of the power flow solver
+		if (**trafo->mResistance == 0 && **trafo->mInductance == 0)
+			continue;
+		addBranch(trafo->name(), *trafo, trafo->matrixNodeIndex(0), trafo->matrixNodeIndex(1));
+	}
+
+	mBusBranches.assign(numBuses, {});
+	for (UInt b = 0; b < mBranches.size(); ++b) {
+		mBusBranches[mBranches[b].bus[0]].push_back(b);
+		mBusBranches[mBranches[b].bus[1]].push_back(b);
+	}
+
+	for (auto& rating : mRatings) {
+		auto it = std::find_if(mBranches.begin(), mBranches.end(),
+			[&rating](const Branch& branch) { return branch.name == rating.first; });
+		if (it == mBranches.end())
+			SPDLOG_LOGGER_WARN(mLog, "Rating for unknown branch {} ignored", rating.first);
+		else
+			it->rating = rating.second;
+	}
+
+	mContingencies.clear();
+	if (mContingencyNames.empty()) {
+		for (UInt b = 0; b < mBranches.size(); ++b)
+			mContingencies.push_back(b);
+	} else {
+		for (auto& name : mContingencyNames) {
+			auto it = std::find_if(mBranches.begin(), mBranches.end(),
+				[&name](const Branch& branch) { return branch.name == name; });
+			if (it == mBranches.end())
+				throw SystemError("Contingency " + name + " is not a line or transformer of the power flow");
+			mContingencies.push_back(static_cast<UInt>(it - mBranches.begin()));
+		}
+	}
+}
+
+Bool ContingencyAnalysis::isConnected(Int outage) const {
+	std::vector<Bool> reached(mBusBranches.size(), false);
+	std::vector<UInt> queue(mBase->slackBuses().begin(), mBase->slackBuses().end());
+	for (auto k : queue)
+		reached[k] = true;
+
+	for (UInt next = 0; next < queue.size(); ++next) {
+		for (auto b : mBusBranches[queue[next]]) {
+			if (static_cast<Int>(b) == outage)
+				continue;
+			for (auto k : mBranches[b].bus) {
+				if (!reached[k]) {
+					reached[k] = true;
+					queue.push_back(k);
+				}
+			}
+		}
+	}
+	return queue.size() == mBusBranches.size();
+}
+
+void ContingencyAnalysis::evaluate(const Worker& worker, Int outage, ContingencyResult& result) const {
+	result.minVoltage = std::numeric_limits<Real>::infinity();
+	for (auto node : mSystem.mNodes) {
+		Real v = worker.magnitude(node->matrixNodeIndex());
+		if (v < result.minVoltage) {
+			result.minVoltage = v;
+			result.minVoltageBus = node->name();
+		}
+	}
+
+	result.maxLoading = 0;
+	result.maxLoadingBranch.clear();
+	for (UInt b = 0; b < mBranches.size(); ++b) {
+		const Branch& branch = mBranches[b];
+		if (static_cast<Int>(b) == outage || branch.rating <= 0)
+			continue;
+		Complex v0 = worker.voltage(branch.bus[0]);
+		Complex v1 = worker.voltage(branch.bus[1]);
+		Complex s0 = v0 * std::conj(branch.y[0][0] * v0 + branch.y[0][1] * v1);
+		Complex s1 = v1 * std::conj(branch.y[1][0] * v0 + branch.y[1][1] * v1);
+		Real loading = std::max(std::abs(s0), std::abs(s1)) * worker.baseApparentPower() / branch.rating;
+		if (loading > result.maxLoading) {
+			result.maxLoading = loading;
+			result.maxLoadingBranch = branch.name;
+		}
+	}
+}
+
+void ContingencyAnalysis::run() {
+	auto start = std::chrono::steady_clock::now();
+
+	mBase = std::make_unique<Worker>(mName, mSystem, mLogLevel);
+	mBase->setup(mDirectImpl, mMaxIterations, mJacobianReuse);
+	collectBranches();
+
+	mBaseCase = ContingencyResult();
+	mBaseCase.islanded = !isConnected(-1);
+	mBaseCase.converged = mBase->solveBase();
+	mBaseCase.iterations = mBase->iterations();
+	evaluate(*mBase, -1, mBaseCase);
+	if (!mBaseCase.converged)
+		SPDLOG_LOGGER_WARN(mLog, "Base case did not converge, the contingencies start from its last iterate");
+
+	mResults.assign(mContingencies.size(), ContingencyResult());
+
+#ifdef WITH_OPENMP
+	Int numThreads = mNumThreads > 0 ? static_cast<Int>(mNumThreads) : omp_get_max_threads();
+	#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		Worker worker(*mBase);
+		worker.resetLinearSolver();
+
+#ifdef WITH_OPENMP
+		#pragma omp for schedule(dynamic)
+#endif
+		for (Int i = 0; i < static_cast<Int>(mContingencies.size()); ++i) {
+			Int outage = mContingencies[i];
+			ContingencyResult& result = mResults[i];
+			result.branch = mBranches[outage].name;
+			if (!isConnected(outage)) {
+				result.islanded = true;
+				continue;
+			}
+			result.converged = worker.solveOutage(mBranches[outage], *mBase);
+			result.iterations = worker.iterations();
+			evaluate(worker, outage, result);
+		}
+	}
+
+	UInt islanded = 0, diverged = 0;
+	for (auto& result : mResults) {
+		if (result.islanded)
+			++islanded;
+		else if (!result.converged)
+			++diverged;
+	}
+	std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+	SPDLOG_LOGGER_INFO(mLog, "{} contingencies in {:.6f} s: {} islanded, {} not converged",
+		mResults.size(), duration.count(), islanded, diverged);
+	mLog->flush();
+}
+
+void ContingencyAnalysis::writeResults(const fs::path& filename) const {
+	std::ofstream file(filename, std::ios_base::out|std::ios_base::trunc);
+	if (!file.is_open())
+		throw SystemError("Cannot open result file " + filename.string());
+
+	file << "branch,islanded,converged,iterations,min_voltage,min_voltage_bus,max_loading,max_loading_branch\n";
+	auto write = [&file](const ContingencyResult& result, const String& name) {
+		file << name << ',' << result.islanded << ',' << result.converged << ',' << result.iterations << ',';
+		if (result.islanded)
+			file << ",,,\n";
+		else
+			file << result.minVoltage << ',' << result.minVoltageBus << ',' << result.maxLoading << ',' << result.maxLoadingBranch << '\n';
+	};
+	write(mBaseCase, "base");
+	for (auto& result : mResults)
+		write(result, result.branch);
+}
@@ -10,15 +10,23 @@
 #include <dpsim-models/SimPowerComp.h>
 #include <dpsim-models/Solver/MNAInterface.h>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace DPsim;
 using namespace CPS;
 
 //#define NVECTOR_DATA(vec) NV_DATA_S (vec) // Returns pointer to the first element of array vec
 
-DAESolver::DAESolver(String name, const CPS::SystemTopology &system, Real dt, Real t0) :
+DAESolver::DAESolver(String name, const CPS::SystemTopology &system, Real dt, Real t0, SundialsLinearSolver linearSolver) :
 	Solver(name, CPS::Logger::Level::info),
 	mSystem(system),
-	mTimestep(dt) {
+	mTimestep(dt),
+	mLinearSolver(linearSolver) {
 
     // Defines offset vector of the residual which is composed as follows:
     // mOffset[0] = # nodal voltage equations
@@ -163,11 +171,33 @@ void DAESolver::initialize(Real t0) {
 // 	if (check_flag(&ret, "IDASStolerances", 1)) {
 //		throw CPS::Exception();
 //	}
+    initializeComponentOffsets();
+
     std::cout << "Call IDA Solver Stuff" << std::endl;
     // Allocate and connect Matrix A and solver LS to IDA
-    A = SUNDenseMatrix(mNEQ, mNEQ);
-    LS = SUNDenseLinearSolver(state, A);
-    ret = IDADlsSetLinearSolver(mem, LS, A);
+    switch (mLinearSolver) {
+    case SundialsLinearSolver::Dense:
+        A = SUNDenseMatrix(mNEQ, mNEQ);
+        LS = SUNDenseLinearSolver(state, A);
+        ret = IDADlsSetLinearSolver(mem, LS, A);
+        break;
+    case SundialsLinearSolver::SparseKLU:
+#ifdef WITH_SUNDIALS_KLU
+        initializeJacobianPattern();
+        A = SUNSparseMatrix(mNEQ, mNEQ, mJacobianRowIndices.size(), CSC_MAT);
+        LS = SUNKLU(state, A);
+        ret = IDADlsSetLinearSolver(mem, LS, A);
+        ret = IDADlsSetJacFn(mem, &DAESolver::jacobianWrapper);
+        break;
+#else
+        throw CPS::SystemError("The sparse DAE linear solver requires SUNDIALS with KLU support");
+#endif
+    case SundialsLinearSolver::GMRES:
+        // Matrix-free, the Jacobian-vector products are approximated by difference quotients
+        LS = SUNSPGMR(state, PREC_NONE, 0);
+        ret = IDASpilsSetLinearSolver(mem, LS);
+        break;
+    }
 
     //Optional IDA input functions
     //ret = IDASetMaxNumSteps(mem, -1);  //Max. number of timesteps until tout (-1 = unlimited)
@@ -200,6 +230,11 @@ int DAESolver::residualFunction(realtype ttime, N_Vector state, N_Vector dstate_
         mOffsets[0] += 1;
     }
 
+    if (mParallelResidual && mComponentOffsets.size() == mResidualFunctions.size()) {
+        parallelComponentResiduals(ttime, NV_DATA_S(state), NV_DATA_S(dstate_dt), residual);
+        return 0;
+    }
+
     // Call all registered component residual functions
     for (auto resFn : mResidualFunctions) {
         resFn(ttime, NV_DATA_S(state), NV_DATA_S(dstate_dt), NV_DATA_S(resid), mOffsets);
@@ -210,6 +245,253 @@ int DAESolver::residualFunction(realtype ttime, N_Vector state, N_Vector dstate_
     return 0;
 }
 
+void DAESolver::initializeComponentOffsets() {
+    // The residual functions advance the offsets, so their start offsets are only known sequentially
+    std::vector<int> offsets = { static_cast<int>(mNodes.size()), 0 };
+    std::vector<realtype> scratch(mNEQ, 0);
+    mComponentOffsets.clear();
+    for (auto& resFn : mResidualFunctions) {
+        mComponentOffsets.push_back(offsets);
+        resFn(0, NV_DATA_S(state), NV_DATA_S(dstate_dt), scratch.data(), offsets);
+    }
+}
+
+void DAESolver::parallelComponentResiduals(realtype ttime, const realtype* state, const realtype* dstate_dt, realtype* resid) {
+    Int numComps = static_cast<Int>(mResidualFunctions.size());
+    Int numChunks = 1;
+#ifdef WITH_OPENMP
+    numChunks = std::max(1, std::min<Int>(omp_get_max_threads(), numComps));
+#endif
+    if (static_cast<Int>(mChunkResiduals.size()) != numChunks)
+        mChunkResiduals.assign(numChunks, std::vector<realtype>(mNEQ, 0));
+
+    // Contiguous chunks of components, each adding to its own residual vector
+#ifdef WITH_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (Int chunk = 0; chunk < numChunks; ++chunk) {
+        auto& buffer = mChunkResiduals[chunk];
+        std::fill(buffer.begin(), buffer.end(), 0);
+        for (Int c = chunk * numComps / numChunks; c < (chunk + 1) * numComps / numChunks; ++c) {
+            std::vector<int> offsets = mComponentOffsets[c];
+            mResidualFunctions[c](ttime, state, dstate_dt, buffer.data(), offsets);
+        }
+    }
+
+    // The node rows are set by the solver, the component rows are the sums of the chunks
+    const Int numNodes = static_cast<Int>(mNodes.size());
+#ifdef WITH_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (Int row = 0; row < mNEQ; ++row) {
+        realtype sum = row < numNodes ? resid[row] : 0;
+        for (auto& buffer : mChunkResiduals)
+            sum += buffer[row];
+        resid[row] = sum;
+    }
+}
+
+void DAESolver::initializeJacobianPattern() {
+    const Int numComps = static_cast<Int>(mResidualFunctions.size());
+    const realtype* state0 = NV_DATA_S(state);
+    const realtype* dstate0 = NV_DATA_S(dstate_dt);
+    mJacobianContributions.assign(numComps, JacobianContribution());
+    std::vector<std::vector<std::pair<Int, Int>>> componentEntries(numComps);
+
+    // Deterministic perturbations of different size per column, so that the
+    // changes of several columns perturbed together do not cancel
+    auto perturbation = [](Int col, realtype value) {
+        return 1e-3 * (1 + std::abs(value)) * (0.5 + ((static_cast<uint64_t>(col) * 2654435761u) % 1000) / 1000.);
+    };
+
+#ifdef WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+        std::vector<realtype> y(state0, state0 + mNEQ);
+        std::vector<realtype> yp(dstate0, dstate0 + mNEQ);
+        std::vector<realtype> buffer(mNEQ);
+        std::vector<realtype> base(mNEQ);
+
+#ifdef WITH_OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (Int c = 0; c < numComps; ++c) {
+            auto& contribution = mJacobianContributions[c];
+            auto evaluate = [&]() {
+                std::vector<int> offsets = mComponentOffsets[c];
+                mResidualFunctions[c](0, y.data(), yp.data(), buffer.data(), offsets);
+            };
+            auto perturb = [&](Int lo, Int hi, realtype sign) {
+                for (Int col = lo; col < hi; ++col) {
+                    y[col] += sign * perturbation(col, state0[col]);
+                    yp[col] += sign * perturbation(col, dstate0[col]);
+                }
+            };
+            auto restore = [&](Int lo, Int hi) {
+                std::copy(state0 + lo, state0 + hi, y.begin() + lo);
+                std::copy(dstate0 + lo, dstate0 + hi, yp.begin() + lo);
+            };
+
+            // The rows of the component change if all columns are perturbed
+            std::fill(buffer.begin(), buffer.end(), 0);
+            evaluate();
+            base = buffer;
+            std::fill(buffer.begin(), buffer.end(), 0);
+            perturb(0, mNEQ, 1);
+            evaluate();
+            restore(0, mNEQ);
+            for (Int row = 0; row < mNEQ; ++row) {
+                if (buffer[row] != base[row])
+                    contribution.rows.push_back(row);
+            }
+            if (contribution.rows.empty())
+                continue;
+
+            // Bisect the columns the rows depend on, an unchanged evaluation rules out all perturbed columns
+            std::function<void(Int, Int)> probe = [&](Int lo, Int hi) {
+                for (Int row : contribution.rows)
+                    buffer[row] = 0;
+                perturb(lo, hi, 1);
+                evaluate();
+                restore(lo, hi);
+                std::vector<Int> changed;
+                for (Int row : contribution.rows) {
+                    if (buffer[row] != base[row])
+                        changed.push_back(row);
+                }
+                if (changed.empty())
+                    return;
+                if (hi - lo == 1) {
+                    for (Int row : changed)
+                        componentEntries[c].emplace_back(row, lo);
+                    return;
+                }
+                Int mid = lo + (hi - lo) / 2;
+                probe(lo, mid);
+                probe(mid, hi);
+            };
+            probe(0, mNEQ);
+        }
+    }
+
+    // Column-major order without duplicates, with the diagonal needed for the Newton matrix
+    std::vector<std::pair<Int, Int>> entries;
+    for (Int k = 0; k < mNEQ; ++k)
+        entries.emplace_back(k, k);
+    for (auto& compEntries : componentEntries)
+        entries.insert(entries.end(), compEntries.begin(), compEntries.end());
+    std::sort(entries.begin(), entries.end(), [](const std::pair<Int, Int>& a, const std::pair<Int, Int>& b) {
+        return a.second < b.second || (a.second == b.second && a.first < b.first);
+    });
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+    mJacobianColumnPointers.assign(mNEQ + 1, 0);
+    mJacobianRowIndices.clear();
+    for (auto& entry : entries) {
+        mJacobianRowIndices.push_back(entry.first);
+        ++mJacobianColumnPointers[entry.second + 1];
+    }
+    for (Int col = 0; col < mNEQ; ++col)
+        mJacobianColumnPointers[col + 1] += mJacobianColumnPointers[col];
+
+    auto position = [this](Int row, Int col) {
+        auto first = mJacobianRowIndices.begin() + mJacobianColumnPointers[col];
+        auto last = mJacobianRowIndices.begin() + mJacobianColumnPointers[col + 1];
+        return static_cast<sunindextype>(std::lower_bound(first, last, row) - mJacobianRowIndices.begin());
+    };
+    for (Int c = 0; c < numComps; ++c) {
+        auto& contribution = mJacobianContributions[c];
+        auto& compEntries = componentEntries[c];
+        std::sort(compEntries.begin(), compEntries.end(), [](const std::pair<Int, Int>& a, const std::pair<Int, Int>& b) {
+            return a.second < b.second || (a.second == b.second && a.first < b.first);
+        });
+        for (auto& entry : compEntries) {
+            if (contribution.columns.empty() || contribution.columns.back() != entry.second) {
+                contribution.columns.push_back(entry.second);
+                contribution.columnStarts.push_back(static_cast<Int>(contribution.entryRows.size()));
+            }
+            contribution.entryRows.push_back(entry.first);
+            contribution.entryPositions.push_back(position(entry.first, entry.second));
+        }
+        contribution.columnStarts.push_back(static_cast<Int>(contribution.entryRows.size()));
+        contribution.values.assign(contribution.entryRows.size(), 0);
+    }
+
+    SPDLOG_LOGGER_INFO(mSLog, "Detected a sparse Jacobian with {} entries for {} equations", mJacobianRowIndices.size(), mNEQ);
+}
+
+int DAESolver::jacobianWrapper(realtype ttime, realtype cj, N_Vector state, N_Vector dstate_dt, N_Vector resid,
+    SUNMatrix J, void *user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3) {
+    DAESolver *self = reinterpret_cast<DAESolver *>(user_data);
+    return self->jacobian(ttime, cj, state, dstate_dt, J);
+}
+
+int DAESolver::jacobian(realtype ttime, realtype cj, N_Vector state, N_Vector dstate_dt, SUNMatrix J) {
+    const Int numComps = static_cast<Int>(mResidualFunctions.size());
+    const realtype* y0 = NV_DATA_S(state);
+    const realtype* yp0 = NV_DATA_S(dstate_dt);
+
+    // Difference quotients of each component along its columns, dF/dy + cj dF/dy'
+#ifdef WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+        std::vector<realtype> y(y0, y0 + mNEQ);
+        std::vector<realtype> yp(yp0, yp0 + mNEQ);
+        std::vector<realtype> buffer(mNEQ, 0);
+        std::vector<realtype> base(mNEQ, 0);
+
+#ifdef WITH_OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (Int c = 0; c < numComps; ++c) {
+            auto& contribution = mJacobianContributions[c];
+            if (contribution.columns.empty())
+                continue;
+            auto evaluate = [&]() {
+                for (Int row : contribution.rows)
+                    buffer[row] = 0;
+                std::vector<int> offsets = mComponentOffsets[c];
+                mResidualFunctions[c](ttime, y.data(), yp.data(), buffer.data(), offsets);
+            };
+            evaluate();
+            for (Int row : contribution.rows)
+                base[row] = buffer[row];
+
+            for (std::size_t k = 0; k < contribution.columns.size(); ++k) {
+                Int col = contribution.columns[k];
+                realtype h = std::sqrt(UNIT_ROUNDOFF) * std::max(std::abs(y0[col]), RCONST(1.0));
+                y[col] += h;
+                yp[col] += cj * h;
+                evaluate();
+                y[col] = y0[col];
+                yp[col] = yp0[col];
+                for (Int e = contribution.columnStarts[k]; e < contribution.columnStarts[k + 1]; ++e) {
+                    Int row = contribution.entryRows[e];
+                    contribution.values[e] = (buffer[row] - base[row]) / h;
+                }
+            }
+        }
+    }
+
+    std::copy(mJacobianColumnPointers.begin(), mJacobianColumnPointers.end(), SM_INDEXPTRS_S(J));
+    std::copy(mJacobianRowIndices.begin(), mJacobianRowIndices.end(), SM_INDEXVALS_S(J));
+    realtype* values = SM_DATA_S(J);
+    std::fill(values, values + mJacobianRowIndices.size(), 0);
+    // The node rows are the voltages of the nodes minus the states
+    for (Int row = 0; row < static_cast<Int>(mNodes.size()); ++row) {
+        auto first = mJacobianRowIndices.begin() + mJacobianColumnPointers[row];
+        auto last = mJacobianRowIndices.begin() + mJacobianColumnPointers[row + 1];
+        values[std::lower_bound(first, last, row) - mJacobianRowIndices.begin()] += -1;
+    }
+    for (auto& contribution : mJacobianContributions) {
+        for (std::size_t e = 0; e < contribution.values.size(); ++e)
+            values[contribution.entryPositions[e]] += contribution.values[e];
+    }
+    return 0;
+}
+
 Real DAESolver::step(Real time) {
 
     Real NextTime = time + mTimestep;
@@ -241,5 +523,6 @@ DAESolver::~DAESolver() {
     N_VDestroy(state);
     N_VDestroy(dstate_dt);
     SUNLinSolFree(LS);
-    SUNMatDestroy(A);
+    if (A)
+        SUNMatDestroy(A);
 }
@@ -6,38 +6,286 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
+#include <limits>
+#include <sstream>
 
 #include <dpsim/DataLogger.h>
+#include <dpsim/CSVLoggerBackend.h>
 #include <dpsim-models/Logger.h>
 
+using namespace CPS;
 using namespace DPsim;
 
+std::function<DataLoggerBackend::Ptr()> DataLogger::sDefaultBackend;
+
+/// Backend of loggers constructed without one
+static DataLoggerBackend::Ptr defaultBackend(const std::function<DataLoggerBackend::Ptr()>& factory) {
+	auto backend = factory ? factory() : nullptr;
+	return backend ? backend : std::make_shared<CSVLoggerBackend>();
+}
+
 DataLogger::DataLogger(Bool enabled) :
-	mLogFile(),
+	mBackend(defaultBackend(sDefaultBackend)),
 	mEnabled(enabled),
 	mDownsampling(1) {
-	mLogFile.setstate(std::ios_base::badbit);
 }
 
-DataLogger::DataLogger(String name, Bool enabled, UInt downsampling) :
+DataLogger::DataLogger(String name, Bool enabled, UInt downsampling, DataLoggerBackend::Ptr backend) :
+	mBackend(backend ? backend : defaultBackend(sDefaultBackend)),
 	mName(name),
 	mEnabled(enabled),
 	mDownsampling(downsampling) {
 	if (!mEnabled)
 		return;
 
-	mFilename = CPS::Logger::logDir() + "/" + name + ".csv";
+	mFilename = CPS::Logger::logDir() + "/" + name + mBackend->extension();
 
-	if (mFilename.has_parent_path() && !fs::exists(mFilename.parent_path()))
+	if (mBackend->writesFiles() && mFilename.has_parent_path() && !fs::exists(mFilename.parent_path()))
 		fs::create_directory(mFilename.parent_path());
 
 	open();
 }
 
+DataLogger::~DataLogger() {
+	flushPending();
+	stopWriter();
+}
+
+void DataLogger::setAsync(UInt blockRows, UInt blocks) {
+	if (mWriterThread.joinable() || mBlockColumns > 0)
+		throw SystemError("Asynchronous logging must be enabled before the first row is logged.");
+	if (blockRows == 0 || blocks == 0)
+		throw SystemError("Asynchronous logging requires at least one block of one row.");
+
+	mAsync = true;
+	mBlockRows = blockRows;
+	mBlocks.clear();
+	for (UInt i = 0; i < blocks; ++i)
+		mBlocks.push_back(std::make_unique<Block>());
+}
+
+void DataLogger::setDecimation(Decimation mode) {
+	mDecimation = mode;
+}
+
+void DataLogger::setTriggerWindow(UInt preRows, UInt postRows, Bool logOutside) {
+	mWindowed = true;
+	mLogOutsideWindows = logOutside;
+	mPreRows = preRows;
+	mPostRows = postRows;
+	mPreTimes.clear();
+	mPreSteps.clear();
+	mPreValues.clear();
+	mPreBegin = mPreCount = 0;
+	mPostRemaining = 0;
+}
+
+void DataLogger::addTriggerTime(Real time) {
+	mTriggerTimes.insert(std::upper_bound(mTriggerTimes.begin() + mNextTriggerTime, mTriggerTimes.end(), time), time);
+}
+
+void DataLogger::addThresholdTrigger(const String& column, Real threshold, Edge edge) {
+	if (mAttributes.find(column) == mAttributes.end())
+		throw SystemError("Trigger column " + column + " is not logged by " + mName);
+	mThresholdTriggers.push_back({ column, threshold, edge });
+	// Resolve the column index with the next row
+	mCaptureColumns.clear();
+}
+
+Bool DataLogger::checkTriggers(Real time, const Real* values) {
+	Bool fire = mTriggerPending;
+	mTriggerPending = false;
+
+	for (; mNextTriggerTime < mTriggerTimes.size() && mTriggerTimes[mNextTriggerTime] <= time; ++mNextTriggerTime)
+		fire = true;
+
+	// The previous values are updated for every row, so crossings inside a window extend it
+	for (auto& trigger : mThresholdTriggers) {
+		Real value = values[trigger.index];
+		Bool rising = trigger.previous < trigger.threshold && value >= trigger.threshold;
+		Bool falling = trigger.previous > trigger.threshold && value <= trigger.threshold;
+		if ((rising && trigger.edge != Edge::Falling) || (falling && trigger.edge != Edge::Rising))
+			fire = true;
+		trigger.previous = value;
+	}
+	return fire;
+}
+
+void DataLogger::processRow(Real time, Int timeStepCount, const Real* values, UInt count) {
+	if (!mWindowed) {
+		decimateRow(time, timeStepCount, values, count);
+		return;
+	}
+
+	if (checkTriggers(time, values)) {
+		if (mPostRemaining == 0) {
+			// Keeps the output in time order
+			flushDecimation();
+			for (UInt i = 0; i < mPreCount; ++i) {
+				UInt slot = (mPreBegin + i) % mPreRows;
+				writeRow(mPreTimes[slot], mPreValues.data() + static_cast<std::size_t>(slot) * count, count);
+			}
+			mPreBegin = mPreCount = 0;
+		}
+		mPostRemaining = mPostRows + 1;
+	}
+
+	if (mPostRemaining > 0) {
+		writeRow(time, values, count);
+		--mPostRemaining;
+		return;
+	}
+
+	if (mPreRows == 0) {
+		if (mLogOutsideWindows)
+			decimateRow(time, timeStepCount, values, count);
+		return;
+	}
+
+	if (mPreTimes.empty()) {
+		mPreTimes.resize(mPreRows);
+		mPreSteps.resize(mPreRows);
+		mPreValues.resize(static_cast<std::size_t>(mPreRows) * count);
+	}
+
+	// The oldest row leaves the buffer without having been part of a window
+	UInt slot = (mPreBegin + mPreCount) % mPreRows;
+	if (mPreCount == mPreRows) {
+		if (mLogOutsideWindows)
+			decimateRow(mPreTimes[slot], mPreSteps[slot], mPreValues.data() + static_cast<std::size_t>(slot) * count, count);
+		mPreBegin = (mPreBegin + 1) % mPreRows;
+	} else {
+		++mPreCount;
+	}
+	mPreTimes[slot] = time;
+	mPreSteps[slot] = timeStepCount;
+	std::copy(values, values + count, mPreValues.begin() + static_cast<std::size_t>(slot) * count);
+}
+
+void DataLogger::decimateRow(Real time, Int timeStepCount, const Real* values, UInt count) {
+	Bool intervalStart = timeStepCount % mDownsampling == 0;
+	if (mDecimation == Decimation::Sample) {
+		if (intervalStart)
+			writeRow(time, values, count);
+		return;
+	}
+
+	if (intervalStart)
+		flushDecimation();
+
+	if (mAggregateRows == 0) {
+		mAggregate.assign(values, values + count);
+		mAggregateTime = time;
+	} else {
+		for (UInt i = 0; i < count; ++i) {
+			switch (mDecimation) {
+			case Decimation::Mean: mAggregate[i] += values[i]; break;
+			case Decimation::Min: mAggregate[i] = std::min(mAggregate[i], values[i]); break;
+			case Decimation::Max: mAggregate[i] = std::max(mAggregate[i], values[i]); break;
+			case Decimation::Sample: break;
+			}
+		}
+	}
+	++mAggregateRows;
+}
+
+void DataLogger::flushDecimation() {
+	if (mAggregateRows == 0)
+		return;
+
+	if (mDecimation == Decimation::Mean) {
+		for (auto& value : mAggregate)
+			value /= mAggregateRows;
+	}
+	writeRow(mAggregateTime, mAggregate.data(), static_cast<UInt>(mAggregate.size()));
+	mAggregateRows = 0;
+}
+
+void DataLogger::flushPending() {
+	if (mLogOutsideWindows && mPreCount > 0) {
+		UInt count = static_cast<UInt>(mPreValues.size() / mPreRows);
+		for (UInt i = 0; i < mPreCount; ++i) {
+			UInt slot = (mPreBegin + i) % mPreRows;
+			decimateRow(mPreTimes[slot], mPreSteps[slot], mPreValues.data() + static_cast<std::size_t>(slot) * count, count);
+		}
+	}
+	mPreBegin = mPreCount = 0;
+	flushDecimation();
+}
+
+void DataLogger::writeRow(Real time, const Real* values, UInt count) {
+	mRowsWritten = true;
+	if (!mAsync) {
+		mBackend->writeRow(time, values, count);
+		return;
+	}
+
+	if (!mWriterThread.joinable()) {
+		// The first row fixes the size of the blocks
+		if (mBlockColumns == 0) {
+			mBlockColumns = count;
+			for (auto& block : mBlocks) {
+				block->times.resize(mBlockRows);
+				block->values.resize(static_cast<std::size_t>(mBlockRows) * count);
+			}
+		}
+		mFullBlocks = std::make_unique<moodycamel::BlockingReaderWriterQueue<Block*>>(mBlocks.size() + 1);
+		mFreeBlocks = std::make_unique<moodycamel::BlockingReaderWriterQueue<Block*>>(mBlocks.size());
+		for (auto& block : mBlocks) {
+			block->rows = 0;
+			mFreeBlocks->enqueue(block.get());
+		}
+		if (mExecutor)
+			mWriterThread = mExecutor->spawn(-1, [this]() { writerFunction(); });
+		else
+			mWriterThread = std::thread(&DataLogger::writerFunction, this);
+	}
+
+	if (!mCurrentBlock)
+		mFreeBlocks->wait_dequeue(mCurrentBlock);
+
+	UInt columns = std::min(count, mBlockColumns);
+	Real* row = mCurrentBlock->values.data() + static_cast<std::size_t>(mCurrentBlock->rows) * mBlockColumns;
+	std::copy(values, values + columns, row);
+	std::fill(row + columns, row + mBlockColumns, std::numeric_limits<Real>::quiet_NaN());
+	mCurrentBlock->times[mCurrentBlock->rows] = time;
+
+	if (++mCurrentBlock->rows == mBlockRows) {
+		mFullBlocks->enqueue(mCurrentBlock);
+		mCurrentBlock = nullptr;
+	}
+}
+
+void DataLogger::writerFunction() {
+	while (true) {
+		Block* block;
+		mFullBlocks->wait_dequeue(block);
+		if (!block)
+			return;
+
+		for (UInt i = 0; i < block->rows; ++i)
+			mBackend->writeRow(block->times[i], block->values.data() + static_cast<std::size_t>(i) * mBlockColumns, mBlockColumns);
+		block->rows = 0;
+		mFreeBlocks->enqueue(block);
+	}
+}
+
+void DataLogger::stopWriter() {
+	if (!mWriterThread.joinable())
+		return;
+
+	if (mCurrentBlock && mCurrentBlock->rows > 0)
+		mFullBlocks->enqueue(mCurrentBlock);
+	mCurrentBlock = nullptr;
+	mFullBlocks->enqueue(nullptr);
+	mWriterThread.join();
+}
+
 void DataLogger::open() {
-	mLogFile = std::ofstream(mFilename, std::ios_base::out|std::ios_base::trunc);
-	if (!mLogFile.is_open()) {
+	if (!mBackend->open(mFilename)) {
 		// TODO: replace by exception
 		std::cerr << "Cannot open log file " << mFilename << std::endl;
 		mEnabled = false;
@@ -45,16 +293,40 @@ void DataLogger::open() {
 }
 
 void DataLogger::close() {
-	mLogFile.close();
+	flushPending();
+	// A new run starts again at the first grid point
+	mGridIndex = 0;
+	mGridPrevRow.clear();
+	stopWriter();
+	mBackend->close();
+}
+
+void DataLogger::setBackend(DataLoggerBackend::Ptr backend) {
+	if (mRowsWritten)
+		throw SystemError("The backend of logger " + mName + " must be set before the first row is logged.");
+
+	close();
+	// Nothing was written to the file of the previous backend
+	if (mEnabled && fs::exists(mFilename))
+		fs::remove(mFilename);
+
+	mBackend = backend;
+	if (!mEnabled)
+		return;
+
+	mFilename = CPS::Logger::logDir() + "/" + mName + mBackend->extension();
+	if (mExpectedSteps > 0)
+		reserveSteps(mExpectedSteps);
+	open();
+	if (mEnabled && !mColumnNames.empty())
+		mBackend->setColumns(mColumnNames, mNotation);
 }
 
 void DataLogger::setColumnNames(std::vector<String> names) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
-		mLogFile << std::right << std::setw(14) << "time";
-		for (auto name : names) {
-			mLogFile << ", " << std::right << std::setw(13) << name;
-		}
-		mLogFile << '\n';
+	if (!mBackend->hasColumns()) {
+		mNotation = DataLoggerBackend::Notation::Scientific;
+		mBackend->setColumns(names, mNotation);
+		mColumnNames = names;
 	}
 }
 
@@ -62,34 +334,31 @@ void DataLogger::logDataLine(Real time, Real data) {
 	if (!mEnabled)
 		return;
 
-	mLogFile << std::scientific << std::right << std::setw(14) << time;
-	mLogFile << ", " << std::right << std::setw(13) << data;
-	mLogFile << '\n';
+	writeRow(time, &data, 1);
 }
 
 void DataLogger::logDataLine(Real time, const Matrix& data) {
 	if (!mEnabled)
 		return;
 
-	mLogFile << std::scientific << std::right << std::setw(14) << time;
-	for (Int i = 0; i < data.rows(); ++i) {
-		mLogFile << ", " << std::right << std::setw(13) << data(i, 0);
-	}
-	mLogFile << '\n';
+	// The first column of a column-major matrix is contiguous
+	writeRow(time, data.data(), static_cast<UInt>(data.rows()));
 }
 
 void DataLogger::logDataLine(Real time, const MatrixComp& data) {
 	if (!mEnabled)
 		return;
-	mLogFile << std::scientific << std::right << std::setw(14) << time;
+
+	mRow.resize(2 * data.rows());
 	for (Int i = 0; i < data.rows(); ++i) {
-		mLogFile << ", " << std::right << std::setw(13) << data(i, 0);
+		mRow[2 * i] = data(i, 0).real();
+		mRow[2 * i + 1] = data(i, 0).imag();
 	}
-	mLogFile << '\n';
+	writeRow(time, mRow.data(), static_cast<UInt>(mRow.size()));
 }
 
 void DataLogger::logPhasorNodeValues(Real time, const Matrix& data, Int freqNum) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (!mBackend->hasColumns()) {
 		std::vector<String> names;
 
 		Int harmonicOffset = data.rows() / freqNum;
@@ -115,7 +384,7 @@ void DataLogger::logPhasorNodeValues(Real time, const Matrix& data, Int freqNum)
 }
 
 void DataLogger::logEMTNodeValues(Real time, const Matrix& data) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (!mBackend->hasColumns()) {
 		std::vector<String> names;
 		for (Int i = 0; i < data.rows(); ++i) {
 			std::stringstream name;
@@ -127,21 +396,202 @@ void DataLogger::logEMTNodeValues(Real time, const Matrix& data) {
 	logDataLine(time, data);
 }
 
+/// Numeric value of a logged attribute, attributes of other types are logged as NaN
+static Real attributeValue(const CPS::AttributeBase::Handle& attr) {
+	if (auto attrReal = dynamic_cast<CPS::Attribute<Real>*>(attr.get()))
+		return attrReal->get();
+	if (auto attrInt = dynamic_cast<CPS::Attribute<Int>*>(attr.get()))
+		return static_cast<Real>(attrInt->get());
+	if (auto attrUInt = dynamic_cast<CPS::Attribute<UInt>*>(attr.get()))
+		return static_cast<Real>(attrUInt->get());
+	if (auto attrBool = dynamic_cast<CPS::Attribute<Bool>*>(attr.get()))
+		return attrBool->get() ? 1 : 0;
+	return std::numeric_limits<Real>::quiet_NaN();
+}
+
+void DataLogger::setDownsampling(UInt downsampling) {
+	if (downsampling == 0)
+		throw SystemError("Downsampling of a data logger has to be at least 1");
+
+	if (mEnabled)
+		flushDecimation();
+	mDownsampling = downsampling;
+}
+
+void DataLogger::setOutputGrid(Real interval) {
+	if (interval < 0)
+		throw SystemError("Output grid of a data logger must not be negative");
+
+	if (mEnabled)
+		flushDecimation();
+	mGridInterval = interval;
+	mGridIndex = 0;
+	mGridPrevRow.clear();
+}
+
+void DataLogger::reserveSteps(UInt steps) {
+	mExpectedSteps = steps;
+	// Windows write fewer rows, decimation and sampling one per interval
+	mBackend->reserve(mWindowed ? 0 : steps / mDownsampling + 1);
+}
+
+std::size_t DataLogger::memoryBytes() const {
+	std::size_t bytes = (mRow.capacity() + mAggregate.capacity() + mPreTimes.capacity()
+		+ mPreValues.capacity() + mTriggerTimes.capacity()) * sizeof(Real)
+		+ mPreSteps.capacity() * sizeof(Int);
+	for (auto& block : mBlocks)
+		bytes += (block->times.capacity() + block->values.capacity()) * sizeof(Real);
+	return bytes + mBackend->memoryBytes();
+}
+
 void DataLogger::log(Real time, Int timeStepCount) {
-	if (!mEnabled || !(timeStepCount % mDownsampling == 0))
+	// Windows and aggregates need the values of every step
+	Bool everyStep = mWindowed || mDecimation != Decimation::Sample || mGridInterval > 0;
+	if (!mEnabled || mPaused || !(everyStep || timeStepCount % mDownsampling == 0))
 		return;
 
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
-		mLogFile << std::right << std::setw(14) << "time";
+	if (!mBackend->hasColumns()) {
+		std::vector<String> names;
 		for (auto it : mAttributes)
-			mLogFile << ", " << std::right << std::setw(13) << it.first;
-		mLogFile << '\n';
+			names.push_back(it.first);
+		mNotation = DataLoggerBackend::Notation::Fixed;
+		mBackend->setColumns(names, mNotation);
+		mColumnNames = names;
+	}
+
+	if (mCaptureColumns.size() != mAttributes.size())
+		prepareCapture();
+
+	if (mLogOnChange && !everyStep) {
+		// The versions only increase, so their sum changes with any of them
+		std::size_t version = 0;
+		for (auto& column : mCaptureColumns)
+			version += column.attribute->version();
+		if (mRowsWritten && version == mLoggedVersion)
+			return;
+		mLoggedVersion = version;
+	}
+
+	for (auto& source : mCaptureSources) {
+		if (!source.isStatic)
+			resolveSource(source);
+	}
+
+	mRow.resize(mCaptureColumns.size());
+	for (std::size_t i = 0; i < mCaptureColumns.size(); ++i) {
+		const CaptureColumn& column = mCaptureColumns[i];
+		if (column.source < 0) {
+			mRow[i] = attributeValue(column.attribute);
+			continue;
+		}
+		const CaptureSource& source = mCaptureSources[column.source];
+		if (column.row >= source.rows || column.col >= source.cols) {
+			mRow[i] = std::numeric_limits<Real>::quiet_NaN();
+			continue;
+		}
+		UInt index = column.col * source.rows + column.row;
+		mRow[i] = (source.type == ColumnSource::Type::Complex || source.type == ColumnSource::Type::MatrixComp)
+			? source.data[2 * index + column.part] : source.data[index];
 	}
 
-	mLogFile << std::scientific << std::right << std::setw(14) << time;
-	for (auto it : mAttributes)
-		mLogFile << ", " << std::right << std::setw(13) << it.second->toString();
-	mLogFile << '\n';
+	if (mGridInterval > 0)
+		resampleRow(time);
+	else if (everyStep)
+		processRow(time, timeStepCount, mRow.data(), static_cast<UInt>(mRow.size()));
+	else
+		writeRow(time, mRow.data(), static_cast<UInt>(mRow.size()));
+}
+
+void DataLogger::resampleRow(Real time) {
+	UInt count = static_cast<UInt>(mRow.size());
+	// Tolerance for grid points that the step times reach up to rounding
+	Real eps = 1e-9 * mGridInterval;
+
+	if (mGridPrevRow.size() != mRow.size()) {
+		mGridIndex = static_cast<uint64_t>(std::max(0., std::ceil((time - eps) / mGridInterval)));
+		mGridRow.resize(count);
+	} else {
+		for (Real gridTime = mGridIndex * mGridInterval; gridTime < time - eps; gridTime = ++mGridIndex * mGridInterval) {
+			Real weight = (gridTime - mGridPrevTime) / (time - mGridPrevTime);
+			for (UInt i = 0; i < count; ++i)
+				mGridRow[i] = mGridPrevRow[i] + weight * (mRow[i] - mGridPrevRow[i]);
+			// Every grid row starts an output interval of the decimation
+			processRow(gridTime, static_cast<Int>(mGridIndex * mDownsampling), mGridRow.data(), count);
+		}
+	}
+	if (std::abs(mGridIndex * mGridInterval - time) <= eps) {
+		processRow(time, static_cast<Int>(mGridIndex * mDownsampling), mRow.data(), count);
+		++mGridIndex;
+	}
+	mGridPrevTime = time;
+	mGridPrevRow = mRow;
+}
+
+void DataLogger::resolveSource(CaptureSource& source) {
+	using Type = ColumnSource::Type;
+
+	// Complex values are stored as pairs of real and imaginary part
+	auto attr = source.attribute.get();
+	switch (source.type) {
+	case Type::Real:
+		source.object = &static_cast<CPS::Attribute<Real>*>(attr)->get();
+		source.data = static_cast<const Real*>(source.object);
+		source.rows = source.cols = 1;
+		break;
+	case Type::Complex:
+		source.object = &static_cast<CPS::Attribute<Complex>*>(attr)->get();
+		source.data = reinterpret_cast<const Real*>(source.object);
+		source.rows = source.cols = 1;
+		break;
+	case Type::Matrix: {
+		auto& matrix = static_cast<CPS::Attribute<Matrix>*>(attr)->get();
+		source.object = &matrix;
+		source.data = matrix.data();
+		source.rows = static_cast<UInt>(matrix.rows());
+		source.cols = static_cast<UInt>(matrix.cols());
+		break;
+	}
+	case Type::MatrixComp: {
+		auto& matrix = static_cast<CPS::Attribute<MatrixComp>*>(attr)->get();
+		source.object = &matrix;
+		source.data = reinterpret_cast<const Real*>(matrix.data());
+		source.rows = static_cast<UInt>(matrix.rows());
+		source.cols = static_cast<UInt>(matrix.cols());
+		break;
+	}
+	case Type::Other:
+		break;
+	}
+}
+
+void DataLogger::prepareCapture() {
+	mCaptureSources.clear();
+	mCaptureColumns.clear();
+
+	std::map<CPS::AttributeBase*, Int> sourceIndices;
+	for (auto& it : mAttributes) {
+		auto& columnSource = mColumnSources[it.first];
+		CaptureColumn column { -1, columnSource.row, columnSource.col, columnSource.part, it.second };
+		if (columnSource.attribute.getPtr() && columnSource.type != ColumnSource::Type::Other) {
+			auto key = columnSource.attribute.getPtr().get();
+			auto found = sourceIndices.find(key);
+			if (found == sourceIndices.end()) {
+				CaptureSource source { columnSource.attribute, columnSource.type, columnSource.attribute->isStatic() };
+				resolveSource(source);
+				found = sourceIndices.emplace(key, static_cast<Int>(mCaptureSources.size())).first;
+				mCaptureSources.push_back(source);
+			}
+			column.source = found->second;
+		}
+		mCaptureColumns.push_back(column);
+	}
+
+	for (auto& trigger : mThresholdTriggers) {
+		auto it = mAttributes.find(trigger.column);
+		if (it == mAttributes.end())
+			throw SystemError("Trigger column " + trigger.column + " is not logged by " + mName);
+		trigger.index = static_cast<Int>(std::distance(mAttributes.begin(), it));
+	}
 }
 
 void DataLogger::Step::execute(Real time, Int timeStepCount) {
@@ -152,67 +602,57 @@ CPS::Task::Ptr DataLogger::getTask() {
 	return std::make_shared<DataLogger::Step>(*this);
 }
 
+void DataLogger::addColumn(const String& name, CPS::AttributeBase::Ptr derived, CPS::AttributeBase::Ptr source, ColumnSource::Type type, UInt row, UInt col, UInt part) {
+	mAttributes[name] = derived;
+	mColumnSources[name] = { source, type, row, col, part };
+}
+
 void DataLogger::logAttribute(const std::vector<String> &name, CPS::AttributeBase::Ptr attr) {
 	if (auto attrMatrix = std::dynamic_pointer_cast<CPS::Attribute<Matrix>>(attr.getPtr())) {
-		if ((**attrMatrix).rows() == 1 && (**attrMatrix).cols() == 1) {
-			logAttribute(name[0], attrMatrix->deriveCoeff<CPS::Real>(0, 0));
-		}
-		else if ((**attrMatrix).cols() == 1) {
-			for (UInt k = 0; k < (**attrMatrix).rows(); ++k) {
-				logAttribute(name[k],
-					attrMatrix->deriveCoeff<CPS::Real>(k, 0));
-			}
-		}
-		else {
-			for (UInt k = 0; k < (**attrMatrix).rows(); ++k) {
-				for (UInt l = 0; l < (**attrMatrix).cols(); ++l) {
-					logAttribute(name[k*(**attrMatrix).cols()+l],
-						attrMatrix->deriveCoeff<CPS::Real>(k, l));
-				}
+		UInt rows = static_cast<UInt>((**attrMatrix).rows());
+		UInt cols = static_cast<UInt>((**attrMatrix).cols());
+		for (UInt k = 0; k < rows; ++k) {
+			for (UInt l = 0; l < cols; ++l) {
+				addColumn(name[k*cols+l], attrMatrix->deriveCoeff<CPS::Real>(k, l), attrMatrix,
+					ColumnSource::Type::Matrix, k, l);
 			}
 		}
 	} else if (auto attrMatrix = std::dynamic_pointer_cast<CPS::Attribute<MatrixComp>>(attr.getPtr())) {
-		if ((**attrMatrix).rows() == 1 && (**attrMatrix).cols() == 1) {
-			logAttribute(name[0], attrMatrix->deriveCoeff<CPS::Complex>(0, 0));
-		}
-		else if ((**attrMatrix).cols() == 1) {
-			for (UInt k = 0; k < (**attrMatrix).rows(); ++k) {
-				logAttribute(name[k],
-					attrMatrix->deriveCoeff<CPS::Complex>(k, 0));
-			}
-		}
-		else {
-			for (UInt k = 0; k < (**attrMatrix).rows(); ++k) {
-				for (UInt l = 0; l < (**attrMatrix).cols(); ++l) {
-					logAttribute(name[k*(**attrMatrix).cols()+l],
-						attrMatrix->deriveCoeff<CPS::Complex>(k, l));
-				}
+		UInt rows = static_cast<UInt>((**attrMatrix).rows());
+		UInt cols = static_cast<UInt>((**attrMatrix).cols());
+		for (UInt k = 0; k < rows; ++k) {
+			for (UInt l = 0; l < cols; ++l) {
+				auto coeff = attrMatrix->deriveCoeff<CPS::Complex>(k, l);
+				addColumn(name[k*cols+l] + ".re", coeff->deriveReal(), attrMatrix, ColumnSource::Type::MatrixComp, k, l, 0);
+				addColumn(name[k*cols+l] + ".im", coeff->deriveImag(), attrMatrix, ColumnSource::Type::MatrixComp, k, l, 1);
 			}
 		}
-	}	
+	}
 }
 
 void DataLogger::logAttribute(const String &name, CPS::AttributeBase::Ptr attr, UInt rowsMax, UInt colsMax) {
+	using Type = ColumnSource::Type;
+
 	if (auto attrReal = std::dynamic_pointer_cast<CPS::Attribute<Real>>(attr.getPtr())) {
-		mAttributes[name] = attrReal;
+		addColumn(name, attrReal, attrReal, Type::Real);
 	} else if (auto attrComp = std::dynamic_pointer_cast<CPS::Attribute<Complex>>(attr.getPtr())) {
-		mAttributes[name + ".re"] = attrComp->deriveReal();
-		mAttributes[name + ".im"] = attrComp->deriveImag();
+		addColumn(name + ".re", attrComp->deriveReal(), attrComp, Type::Complex, 0, 0, 0);
+		addColumn(name + ".im", attrComp->deriveImag(), attrComp, Type::Complex, 0, 0, 1);
 	} else if (auto attrMatrix = std::dynamic_pointer_cast<CPS::Attribute<Matrix>>(attr.getPtr())) {
 		UInt rows = static_cast<UInt>((**attrMatrix).rows());
 		UInt cols = static_cast<UInt>((**attrMatrix).cols());
 		if (rowsMax == 0 || rowsMax > rows) rowsMax = rows;
 		if (colsMax == 0 || colsMax > cols) colsMax = cols;
 		if (rows == 1 && cols == 1) {
-			mAttributes[name] = attrMatrix->deriveCoeff<Real>(0,0);
+			addColumn(name, attrMatrix->deriveCoeff<Real>(0,0), attrMatrix, Type::Matrix, 0, 0);
 		} else if (cols == 1) {
 			for (UInt k = 0; k < rowsMax; ++k) {
-				mAttributes[name + "_" + std::to_string(k)] = attrMatrix->deriveCoeff<Real>(k,0);
+				addColumn(name + "_" + std::to_string(k), attrMatrix->deriveCoeff<Real>(k,0), attrMatrix, Type::Matrix, k, 0);
 			}
 		} else {
 			for (UInt k = 0; k < rowsMax; ++k) {
 				for (UInt l = 0; l < colsMax; ++l) {
-					mAttributes[name + "_" + std::to_string(k) + "_" + std::to_string(l)] = attrMatrix->deriveCoeff<Real>(k,l);
+					addColumn(name + "_" + std::to_string(k) + "_" + std::to_string(l), attrMatrix->deriveCoeff<Real>(k,l), attrMatrix, Type::Matrix, k, l);
 				}
 			}
 		}
@@ -222,22 +662,23 @@ void DataLogger::logAttribute(const String &name, CPS::AttributeBase::Ptr attr,
 		if (rowsMax == 0 || rowsMax > rows) rowsMax = rows;
 		if (colsMax == 0 || colsMax > cols) colsMax = cols;
 		if (rows == 1 && cols == 1) {
-			mAttributes[name + ".re"] = attrMatrix->deriveCoeff<Complex>(0,0)->deriveReal();
-			mAttributes[name + ".im"] = attrMatrix->deriveCoeff<Complex>(0,0)->deriveImag();
+			addColumn(name + ".re", attrMatrix->deriveCoeff<Complex>(0,0)->deriveReal(), attrMatrix, Type::MatrixComp, 0, 0, 0);
+			addColumn(name + ".im", attrMatrix->deriveCoeff<Complex>(0,0)->deriveImag(), attrMatrix, Type::MatrixComp, 0, 0, 1);
 		} else if (cols == 1) {
 			for (UInt k = 0; k < rowsMax; ++k) {
-				mAttributes[name + "_" + std::to_string(k) + ".re"] = attrMatrix->deriveCoeff<Complex>(k,0)->deriveReal();
-				mAttributes[name + "_" + std::to_string(k) + ".im"] = attrMatrix->deriveCoeff<Complex>(k,0)->deriveImag();
+				addColumn(name + "_" + std::to_string(k) + ".re", attrMatrix->deriveCoeff<Complex>(k,0)->deriveReal(), attrMatrix, Type::MatrixComp, k, 0, 0);
+				addColumn(name + "_" + std::to_string(k) + ".im", attrMatrix->deriveCoeff<Complex>(k,0)->deriveImag(), attrMatrix, Type::MatrixComp, k, 0, 1);
 			}
 		} else {
 			for (UInt k = 0; k < rowsMax; ++k) {
 				for (UInt l = 0; l < colsMax; ++l) {
-					mAttributes[name + "_" + std::to_string(k) + "_" + std::to_string(l) + ".re"] = attrMatrix->deriveCoeff<Complex>(k,l)->deriveReal();
-					mAttributes[name + "_" + std::to_string(k) + "_" + std::to_string(l) + ".im"] = attrMatrix->deriveCoeff<Complex>(k,l)->deriveImag();
+					String coeff = name + "_" + std::to_string(k) + "_" + std::to_string(l);
+					addColumn(coeff + ".re", attrMatrix->deriveCoeff<Complex>(k,l)->deriveReal(), attrMatrix, Type::MatrixComp, k, l, 0);
+					addColumn(coeff + ".im", attrMatrix->deriveCoeff<Complex>(k,l)->deriveImag(), attrMatrix, Type::MatrixComp, k, l, 1);
 				}
 			}
 		}
 	} else {
-		mAttributes[name] = attr;
+		addColumn(name, attr, attr, Type::Other);
 	}
 }
@@ -0,0 +1,90 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/DenseInverseAdapter.h>
+#include <dpsim/MemoryReport.h>
+
+using namespace DPsim;
+
+namespace DPsim
+{
+    DenseInverseAdapter::~DenseInverseAdapter() = default;
+
+    void DenseInverseAdapter::applyConfiguration()
+    {
+        SPDLOG_LOGGER_INFO(mSLog, "Dense inverse has no configuration options");
+    }
+
+    void DenseInverseAdapter::preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
+    {
+        /* No preprocessing phase needed by PartialPivLU */
+    }
+
+    void DenseInverseAdapter::compute(SparseMatrix& systemMatrix)
+    {
+        mLU.compute(Matrix(systemMatrix));
+
+        Bool useInverse = systemMatrix.rows() <= mMaxInverseDimension
+            && (!mFactorized || mSolves >= mMinSolvesPerInversion);
+        if (useInverse != mUseInverse || !mFactorized) {
+            if (useInverse)
+                SPDLOG_LOGGER_DEBUG(mSLog, "Solving with the inverse of the system matrix of dimension {}", systemMatrix.rows());
+            else
+                SPDLOG_LOGGER_DEBUG(mSLog, "Solving with the LU factorization of the system matrix of dimension {}", systemMatrix.rows());
+        }
+        mUseInverse = useInverse;
+
+        if (mUseInverse)
+            mInverse = mLU.inverse();
+        else
+            mInverse.resize(0, 0);
+        mFactorized = true;
+        mSolves = 0;
+    }
+
+    void DenseInverseAdapter::factorize(SparseMatrix& systemMatrix)
+    {
+        compute(systemMatrix);
+    }
+
+    void DenseInverseAdapter::refactorize(SparseMatrix& systemMatrix)
+    {
+        /* only a simple dense factorization */
+        compute(systemMatrix);
+    }
+
+    void DenseInverseAdapter::partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
+    {
+        /* only a simple dense factorization */
+        compute(systemMatrix);
+    }
+
+    Matrix DenseInverseAdapter::solve(Matrix& rightSideVector)
+    {
+        Matrix leftSideVector;
+        solveInPlace(rightSideVector, leftSideVector);
+        return leftSideVector;
+    }
+
+    void DenseInverseAdapter::solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector)
+    {
+        ++mSolves;
+        if (mUseInverse)
+            leftSideVector.noalias() = mInverse * rightSideVector;
+        else
+            leftSideVector = mLU.solve(rightSideVector);
+    }
+
+    std::size_t DenseInverseAdapter::memoryBytes() const
+    {
+        if (!mFactorized)
+            return 0;
+        return MemoryReport::denseBytes(mLU.matrixLU()) + mLU.permutationP().size() * sizeof(int)
+            + MemoryReport::denseBytes(mInverse);
+    }
+}
@@ -7,6 +7,7 @@
  *********************************************************************************/
 
 #include <dpsim/DenseLUAdapter.h>
+#include <dpsim/MemoryReport.h>
 
 using namespace DPsim;
 
@@ -20,25 +21,76 @@ namespace DPsim
         /* No preprocessing phase needed by PartialPivLU */
     }
 
+    void DenseLUAdapter::applyConfiguration()
+    {
+        mMixedPrecision = mConfiguration.getFactorizationPrecision() == FACTORIZATION_PRECISION::MIXED;
+        SPDLOG_LOGGER_INFO(mSLog, "Dense LU " + mConfiguration.getFactorizationPrecisionString());
+    }
+
+    void DenseLUAdapter::compute(SparseMatrix& systemMatrix)
+    {
+        if (mMixedPrecision) {
+            mSystemMatrix = systemMatrix;
+            mLowPrecisionLU.compute(Matrix(systemMatrix).cast<float>());
+            mUseDoubleFactorization = false;
+        } else {
+            LUFactorized.compute(Matrix(systemMatrix));
+        }
+        mFactorized = true;
+    }
+
     void DenseLUAdapter::factorize(SparseMatrix& systemMatrix)
     {
-        LUFactorized.compute(Matrix(systemMatrix));
+        compute(systemMatrix);
     }
 
     void DenseLUAdapter::refactorize(SparseMatrix& systemMatrix)
     {
 		/* only a simple dense factorization */
-        LUFactorized.compute(Matrix(systemMatrix));
+        compute(systemMatrix);
     }
 
     void DenseLUAdapter::partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
     {
 		/* only a simple dense factorization */
-        LUFactorized.compute(Matrix(systemMatrix));
+        compute(systemMatrix);
     }
 
     Matrix DenseLUAdapter::solve(Matrix& mRightHandSideVector)
     {
-        return LUFactorized.solve(mRightHandSideVector);
+        Matrix leftSideVector;
+        solveInPlace(mRightHandSideVector, leftSideVector);
+        return leftSideVector;
+    }
+
+    void DenseLUAdapter::solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector)
+    {
+        if (!mMixedPrecision || mUseDoubleFactorization) {
+            leftSideVector = LUFactorized.solve(rightSideVector);
+            return;
+        }
+
+        leftSideVector = mLowPrecisionLU.solve(rightSideVector.cast<float>()).cast<Real>();
+        auto correctionSolve = [this](const Matrix& residual) -> Matrix {
+            return mLowPrecisionLU.solve(residual.cast<float>()).cast<Real>();
+        };
+        if (!refineSolution(mSystemMatrix, rightSideVector, leftSideVector, correctionSolve)) {
+            SPDLOG_LOGGER_WARN(mSLog, "Mixed precision refinement did not converge, falling back to a double precision factorization");
+            LUFactorized.compute(Matrix(mSystemMatrix));
+            mUseDoubleFactorization = true;
+            leftSideVector = LUFactorized.solve(rightSideVector);
+        }
+    }
+
+    std::size_t DenseLUAdapter::memoryBytes() const
+    {
+        std::size_t bytes = MemoryReport::sparseBytes(mSystemMatrix);
+        if (!mFactorized)
+            return bytes;
+        if (mMixedPrecision)
+            bytes += MemoryReport::denseBytes(mLowPrecisionLU.matrixLU()) + mLowPrecisionLU.permutationP().size() * sizeof(int);
+        if (!mMixedPrecision || mUseDoubleFactorization)
+            bytes += MemoryReport::denseBytes(LUFactorized.matrixLU()) + LUFactorized.permutationP().size() * sizeof(int);
+        return bytes;
     }
 }
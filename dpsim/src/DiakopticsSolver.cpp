@@ -13,6 +13,11 @@
 #include <dpsim-models/MathUtils.h>
 #include <dpsim-models/Solver/MNATearInterface.h>
 #include <dpsim/Definitions.h>
+#include <dpsim/DenseLUAdapter.h>
+#include <dpsim/SparseLUAdapter.h>
+#ifdef WITH_KLU
+#include <dpsim/KLUAdapter.h>
+#endif
 
 using namespace CPS;
 using namespace DPsim;
@@ -22,9 +27,11 @@ namespace DPsim {
 template <typename VarType>
 DiakopticsSolver<VarType>::DiakopticsSolver(String name,
 	SystemTopology system, IdentifiedObject::List tearComponents,
-	Real timeStep, Logger::Level logLevel) :
+	Real timeStep, Logger::Level logLevel, DirectLinearSolverImpl implementation) :
 	Solver(name, logLevel),
-	mMappedTearCurrents(AttributeStatic<Matrix>::make()),
+	// To avoid regression we use SparseLU in case of undefined implementation, like the MNA solver factory
+	mImplementationInUse(implementation == DirectLinearSolverImpl::Undef ? DirectLinearSolverImpl::SparseLU : implementation),
+	mTearCurrents(AttributeStatic<Matrix>::make()),
 	mOrigLeftSideVector(AttributeStatic<Matrix>::make()) {
 	mTimeStep = timeStep;
 
@@ -207,13 +214,10 @@ void DiakopticsSolver<Complex>::setLogColumns() {
 template <typename VarType>
 void DiakopticsSolver<VarType>::createMatrices() {
 	UInt totalSize = mSubnets.back().sysOff + mSubnets.back().sysSize;
-	mSystemMatrix = Matrix::Zero(totalSize, totalSize);
-	mSystemInverse = Matrix::Zero(totalSize, totalSize);
 
 	mRightSideVector = Matrix::Zero(totalSize, 1);
 	mLeftSideVector = Matrix::Zero(totalSize, 1);
 	**mOrigLeftSideVector = Matrix::Zero(totalSize, 1);
-	**mMappedTearCurrents = Matrix::Zero(totalSize, 1);
 
 	for (auto& net : mSubnets) {
 		// The subnets' components expect to be passed a left-side vector matching
@@ -221,6 +225,8 @@ void DiakopticsSolver<VarType>::createMatrices() {
 		// copy the solution there
 		net.leftVector = AttributeStatic<Matrix>::make();
 		net.leftVector->set(Matrix::Zero(net.sysSize, 1));
+		net.rightVector = Matrix::Zero(net.sysSize, 1);
+		net.solution = Matrix::Zero(net.sysSize, 1);
 	}
 
 	createTearMatrices(totalSize);
@@ -228,17 +234,17 @@ void DiakopticsSolver<VarType>::createMatrices() {
 
 template <>
 void DiakopticsSolver<Real>::createTearMatrices(UInt totalSize) {
-	mTearTopology = Matrix::Zero(totalSize, mTearComponents.size());
+	mTearTopology = CPS::SparseMatrix(totalSize, mTearComponents.size());
 	mTearImpedance = CPS::SparseMatrixRow(mTearComponents.size(), mTearComponents.size());
-	mTearCurrents = Matrix::Zero(mTearComponents.size(), 1);
+	**mTearCurrents = Matrix::Zero(mTearComponents.size(), 1);
 	mTearVoltages = Matrix::Zero(mTearComponents.size(), 1);
 }
 
 template <>
 void DiakopticsSolver<Complex>::createTearMatrices(UInt totalSize) {
-	mTearTopology = Matrix::Zero(totalSize, 2*mTearComponents.size());
+	mTearTopology = CPS::SparseMatrix(totalSize, 2*mTearComponents.size());
 	mTearImpedance = CPS::SparseMatrixRow(2*mTearComponents.size(), 2*mTearComponents.size());
-	mTearCurrents = Matrix::Zero(2*mTearComponents.size(), 1);
+	**mTearCurrents = Matrix::Zero(2*mTearComponents.size(), 1);
 	mTearVoltages = Matrix::Zero(2*mTearComponents.size(), 1);
 }
 
@@ -265,36 +271,55 @@ void DiakopticsSolver<VarType>::initComponents() {
 		comp->initialize(mSystem.mSystemOmega, mTimeStep);
 }
 
+template <typename VarType>
+std::shared_ptr<DirectLinearSolver> DiakopticsSolver<VarType>::createLinearSolver() {
+	switch (mImplementationInUse) {
+		case DirectLinearSolverImpl::DenseLU:
+			return std::make_shared<DenseLUAdapter>(mSLog);
+		case DirectLinearSolverImpl::SparseLU:
+			return std::make_shared<SparseLUAdapter>(mSLog);
+		#ifdef WITH_KLU
+		case DirectLinearSolverImpl::KLU:
+			return std::make_shared<KLUAdapter>(mSLog);
+		#endif
+		default:
+			throw CPS::SystemError("unsupported linear solver implementation for the diakoptics solver.");
+	}
+}
+
 template <typename VarType>
 void DiakopticsSolver<VarType>::initMatrices() {
+	std::vector<std::pair<UInt, UInt>> noVariableEntries;
 	for (auto& net : mSubnets) {
-		// We can't directly pass the block reference to mnaApplySystemMatrixStamp,
-		// because it expects a concrete Matrix. It can't be changed to accept some common
-		// base class like DenseBase because that would make it a template function (as
-		// Eigen uses CRTP for polymorphism), which is impossible for virtual functions.
-		CPS::SparseMatrixRow partSys = CPS::SparseMatrixRow(net.sysSize, net.sysSize);
+		net.systemMatrix = SparseMatrix(net.sysSize, net.sysSize);
 		for (auto comp : net.components) {
-			comp->mnaApplySystemMatrixStamp(partSys);
+			comp->mnaApplySystemMatrixStamp(net.systemMatrix);
 		}
-		auto block = mSystemMatrix.block(net.sysOff, net.sysOff, net.sysSize, net.sysSize);
-		block = partSys;
-		SPDLOG_LOGGER_INFO(mSLog, "Block: \n{}", block);
-		net.luFactorization = Eigen::PartialPivLU<Matrix>(partSys);
-		SPDLOG_LOGGER_INFO(mSLog, "Factorization: \n{}", net.luFactorization.matrixLU());
+		net.systemMatrix.makeCompressed();
+		SPDLOG_LOGGER_INFO(mSLog, "Block: \n{}", net.systemMatrix);
+		net.linearSolver = createLinearSolver();
+		net.linearSolver->preprocessing(net.systemMatrix, noVariableEntries);
+		net.linearSolver->factorize(net.systemMatrix);
 	}
-	SPDLOG_LOGGER_INFO(mSLog, "Complete system matrix: \n{}", mSystemMatrix);
 
 	// initialize tear topology matrix and impedance matrix of removed network
 	for (UInt compIdx = 0; compIdx < mTearComponents.size(); ++compIdx) {
 		applyTearComponentStamp(compIdx);
 	}
+	mTearTopology.makeCompressed();
 	SPDLOG_LOGGER_INFO(mSLog, "Topology matrix: \n{}", mTearTopology);
 	SPDLOG_LOGGER_INFO(mSLog, "Removed impedance matrix: \n{}", mTearImpedance);
-	// TODO this can be sped up as well by using the block diagonal form of Yinv
 	for (auto& net : mSubnets) {
-		mSystemInverse.block(net.sysOff, net.sysOff, net.sysSize, net.sysSize) = net.luFactorization.inverse();
+		createSubnetTearTopology(net);
 	}
-	mTotalTearImpedance = Eigen::PartialPivLU<Matrix>(mTearImpedance + mTearTopology.transpose() * mSystemInverse * mTearTopology);
+
+	// The system matrix is block diagonal, so C^T * Y^-1 * C is the sum of
+	// the contributions of the subnets, which only need solves for their tear columns
+	Matrix totalTearImpedance = mTearImpedance;
+	for (auto& net : mSubnets) {
+		addSubnetTearImpedance(net, totalTearImpedance);
+	}
+	mTotalTearImpedance = Eigen::PartialPivLU<Matrix>(totalTearImpedance);
 	SPDLOG_LOGGER_INFO(mSLog, "Total removed impedance matrix LU decomposition: \n{}", mTotalTearImpedance.matrixLU());
 
 	// Compute subnet right side (source) vectors for debugging
@@ -308,11 +333,47 @@ void DiakopticsSolver<VarType>::initMatrices() {
 	}
 }
 
+template <typename VarType>
+void DiakopticsSolver<VarType>::createSubnetTearTopology(Subnet& net) {
+	net.tearColumns.clear();
+	std::vector<Eigen::Triplet<Real>> entries;
+	for (Int col = 0; col < mTearTopology.outerSize(); ++col) {
+		Bool inSubnet = false;
+		for (CPS::SparseMatrix::InnerIterator it(mTearTopology, col); it; ++it) {
+			if (it.row() >= net.sysOff && it.row() < net.sysOff + net.sysSize) {
+				entries.emplace_back(it.row() - net.sysOff, net.tearColumns.size(), it.value());
+				inSubnet = true;
+			}
+		}
+		if (inSubnet)
+			net.tearColumns.push_back(col);
+	}
+	net.tearTopology = CPS::SparseMatrix(net.sysSize, net.tearColumns.size());
+	net.tearTopology.setFromTriplets(entries.begin(), entries.end());
+	net.tearVoltages = Matrix::Zero(net.tearColumns.size(), 1);
+	net.tearCurrents = Matrix::Zero(net.tearColumns.size(), 1);
+}
+
+template <typename VarType>
+void DiakopticsSolver<VarType>::addSubnetTearImpedance(const Subnet& net, Matrix& totalTearImpedance) {
+	if (net.tearColumns.empty())
+		return;
+
+	// Y_net^-1 * C_net with one right side per tear column
+	Matrix tearColumns = net.tearTopology;
+	Matrix solution = net.linearSolver->solve(tearColumns);
+	Matrix contribution = net.tearTopology.transpose() * solution;
+	for (UInt i = 0; i < net.tearColumns.size(); ++i) {
+		for (UInt j = 0; j < net.tearColumns.size(); ++j)
+			totalTearImpedance(net.tearColumns[i], net.tearColumns[j]) += contribution(i, j);
+	}
+}
+
 template <>
 void DiakopticsSolver<Real>::applyTearComponentStamp(UInt compIdx) {
 	auto comp = mTearComponents[compIdx];
-	mTearTopology(mNodeSubnetMap[comp->node(0)]->sysOff + comp->node(0)->matrixNodeIndex(), compIdx) = 1;
-	mTearTopology(mNodeSubnetMap[comp->node(1)]->sysOff + comp->node(1)->matrixNodeIndex(), compIdx) = -1;
+	mTearTopology.coeffRef(mNodeSubnetMap[comp->node(0)]->sysOff + comp->node(0)->matrixNodeIndex(), compIdx) = 1;
+	mTearTopology.coeffRef(mNodeSubnetMap[comp->node(1)]->sysOff + comp->node(1)->matrixNodeIndex(), compIdx) = -1;
 
 	auto tearComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
 	tearComp->mnaTearApplyMatrixStamp(mTearImpedance);
@@ -325,10 +386,10 @@ void DiakopticsSolver<Complex>::applyTearComponentStamp(UInt compIdx) {
 	auto net1 = mNodeSubnetMap[comp->node(0)];
 	auto net2 = mNodeSubnetMap[comp->node(1)];
 
-	mTearTopology(net1->sysOff + comp->node(0)->matrixNodeIndex(), compIdx) = 1;
-	mTearTopology(net1->sysOff + net1->mCmplOff + comp->node(0)->matrixNodeIndex(), mTearComponents.size() + compIdx) = 1;
-	mTearTopology(net2->sysOff + comp->node(1)->matrixNodeIndex(), compIdx) = -1;
-	mTearTopology(net2->sysOff + net2->mCmplOff + comp->node(1)->matrixNodeIndex(), mTearComponents.size() + compIdx) = -1;
+	mTearTopology.coeffRef(net1->sysOff + comp->node(0)->matrixNodeIndex(), compIdx) = 1;
+	mTearTopology.coeffRef(net1->sysOff + net1->mCmplOff + comp->node(0)->matrixNodeIndex(), mTearComponents.size() + compIdx) = 1;
+	mTearTopology.coeffRef(net2->sysOff + comp->node(1)->matrixNodeIndex(), compIdx) = -1;
+	mTearTopology.coeffRef(net2->sysOff + net2->mCmplOff + comp->node(1)->matrixNodeIndex(), mTearComponents.size() + compIdx) = -1;
 
 	auto tearComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
 	tearComp->mnaTearApplyMatrixStamp(mTearImpedance);
@@ -375,7 +436,11 @@ void DiakopticsSolver<VarType>::SubnetSolveTask::execute(Real time, Int timeStep
 
 	auto lBlock = (**mSolver.mOrigLeftSideVector).block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
 	// Solve Y' * v' = I
-	lBlock = mSubnet.luFactorization.solve(rBlock);
+	mSubnet.rightVector = rBlock;
+	mSubnet.linearSolver->solveInPlace(mSubnet.rightVector, mSubnet.solution);
+	lBlock = mSubnet.solution;
+	// Boundary part C^T * v' of the subnet
+	mSubnet.tearVoltages.noalias() = mSubnet.tearTopology.transpose() * mSubnet.solution;
 }
 
 template <typename VarType>
@@ -385,34 +450,50 @@ void DiakopticsSolver<VarType>::PreSolveTask::execute(Real time, Int timeStepCou
 		auto tComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
 		tComp->mnaTearApplyVoltageStamp(mSolver.mTearVoltages);
 	}
-	// -C^T * v'
-	mSolver.mTearVoltages -= mSolver.mTearTopology.transpose() * **mSolver.mOrigLeftSideVector;
+	// -C^T * v' as the sum of the boundary parts of the subnets
+	for (auto& net : mSolver.mSubnets) {
+		for (UInt k = 0; k < net.tearColumns.size(); ++k)
+			mSolver.mTearVoltages(net.tearColumns[k]) -= net.tearVoltages(k);
+	}
 	// Solve Z' * i = E - C^T * v'
-	mSolver.mTearCurrents = mSolver.mTotalTearImpedance.solve(mSolver.mTearVoltages);
-	// C * i
-	**mSolver.mMappedTearCurrents = mSolver.mTearTopology * mSolver.mTearCurrents;
-	mSolver.mLeftSideVector = **mSolver.mOrigLeftSideVector;
+	**mSolver.mTearCurrents = mSolver.mTotalTearImpedance.solve(mSolver.mTearVoltages);
 }
 
 template <typename VarType>
 void DiakopticsSolver<VarType>::SolveTask::execute(Real time, Int timeStepCount) {
 	auto lBlock = mSolver.mLeftSideVector.block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
-	auto rBlock = (**mSolver.mMappedTearCurrents).block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
+	auto origBlock = (**mSolver.mOrigLeftSideVector).block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
+	if (mSubnet.tearColumns.empty()) {
+		lBlock = origBlock;
+		**mSubnet.leftVector = lBlock;
+		return;
+	}
+
+	for (UInt k = 0; k < mSubnet.tearColumns.size(); ++k)
+		mSubnet.tearCurrents(k) = (**mSolver.mTearCurrents)(mSubnet.tearColumns[k]);
 	// Solve Y' * x = C * i
 	// v = v' + x
-	lBlock += mSubnet.luFactorization.solve(rBlock);
+	mSubnet.rightVector = mSubnet.tearTopology * mSubnet.tearCurrents;
+	mSubnet.linearSolver->solveInPlace(mSubnet.rightVector, mSubnet.solution);
+	lBlock = origBlock + mSubnet.solution;
 	**mSubnet.leftVector = lBlock;
+	// Boundary part C^T * v of the subnet for the torn components
+	mSubnet.tearVoltages.noalias() = mSubnet.tearTopology.transpose() * **mSubnet.leftVector;
 }
 
 template <typename VarType>
 void DiakopticsSolver<VarType>::PostSolveTask::execute(Real time, Int timeStepCount) {
 	// pass the voltages and current of the solution to the torn components
-	mSolver.mTearVoltages = -mSolver.mTearTopology.transpose() * mSolver.mLeftSideVector;
+	mSolver.mTearVoltages.setZero();
+	for (auto& net : mSolver.mSubnets) {
+		for (UInt k = 0; k < net.tearColumns.size(); ++k)
+			mSolver.mTearVoltages(net.tearColumns[k]) -= net.tearVoltages(k);
+	}
 	for (UInt compIdx = 0; compIdx < mSolver.mTearComponents.size(); ++compIdx) {
 		auto comp = mSolver.mTearComponents[compIdx];
 		auto tComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
 		Complex voltage = Math::complexFromVectorElement(mSolver.mTearVoltages, compIdx);
-		Complex current = Math::complexFromVectorElement(mSolver.mTearCurrents, compIdx);
+		Complex current = Math::complexFromVectorElement(**mSolver.mTearCurrents, compIdx);
 		tComp->mnaTearPostStep(voltage, current);
 	}
 
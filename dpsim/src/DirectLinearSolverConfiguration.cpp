@@ -18,6 +18,14 @@ namespace DPsim
 		mPartialRefactorizationMethod = PARTIAL_REFACTORIZATION_METHOD::FACTORIZATION_PATH;
 		mUseBTF = USE_BTF::DO_BTF;
 		mFillInReductionMethod = FILL_IN_REDUCTION_METHOD::AMD;
+		mGpuTransferMethod = GPU_TRANSFER_METHOD::SYNCHRONOUS;
+		mIterativePreconditioner = ITERATIVE_PRECONDITIONER::LU;
+		mIterativeTolerance = 1e-10;
+		mIterativeMaxIterations = 100;
+		mPreconditionerRefreshIterations = 10;
+		mFactorizationPrecision = FACTORIZATION_PRECISION::DOUBLE;
+		mRefinementSteps = 2;
+		mRefinementTolerance = 1e-10;
 	}
 
 	void DirectLinearSolverConfiguration::setFillInReductionMethod(FILL_IN_REDUCTION_METHOD fillInReductionMethod)
@@ -40,6 +48,46 @@ namespace DPsim
 		mUseBTF = useBTF;
 	}
 
+	void DirectLinearSolverConfiguration::setGpuTransferMethod(GPU_TRANSFER_METHOD gpuTransferMethod)
+	{
+		mGpuTransferMethod = gpuTransferMethod;
+	}
+
+	void DirectLinearSolverConfiguration::setIterativePreconditioner(ITERATIVE_PRECONDITIONER iterativePreconditioner)
+	{
+		mIterativePreconditioner = iterativePreconditioner;
+	}
+
+	void DirectLinearSolverConfiguration::setIterativeTolerance(Real tolerance)
+	{
+		mIterativeTolerance = tolerance;
+	}
+
+	void DirectLinearSolverConfiguration::setIterativeMaxIterations(UInt maxIterations)
+	{
+		mIterativeMaxIterations = maxIterations;
+	}
+
+	void DirectLinearSolverConfiguration::setPreconditionerRefreshIterations(UInt refreshIterations)
+	{
+		mPreconditionerRefreshIterations = refreshIterations;
+	}
+
+	void DirectLinearSolverConfiguration::setFactorizationPrecision(FACTORIZATION_PRECISION factorizationPrecision)
+	{
+		mFactorizationPrecision = factorizationPrecision;
+	}
+
+	void DirectLinearSolverConfiguration::setRefinementSteps(UInt refinementSteps)
+	{
+		mRefinementSteps = refinementSteps;
+	}
+
+	void DirectLinearSolverConfiguration::setRefinementTolerance(Real tolerance)
+	{
+		mRefinementTolerance = tolerance;
+	}
+
 	SCALING_METHOD DirectLinearSolverConfiguration::getScalingMethod() const
 	{
 		return mScalingMethod;
@@ -60,6 +108,46 @@ namespace DPsim
 		return mUseBTF;
 	}
 
+	GPU_TRANSFER_METHOD DirectLinearSolverConfiguration::getGpuTransferMethod() const
+	{
+		return mGpuTransferMethod;
+	}
+
+	ITERATIVE_PRECONDITIONER DirectLinearSolverConfiguration::getIterativePreconditioner() const
+	{
+		return mIterativePreconditioner;
+	}
+
+	Real DirectLinearSolverConfiguration::getIterativeTolerance() const
+	{
+		return mIterativeTolerance;
+	}
+
+	UInt DirectLinearSolverConfiguration::getIterativeMaxIterations() const
+	{
+		return mIterativeMaxIterations;
+	}
+
+	UInt DirectLinearSolverConfiguration::getPreconditionerRefreshIterations() const
+	{
+		return mPreconditionerRefreshIterations;
+	}
+
+	FACTORIZATION_PRECISION DirectLinearSolverConfiguration::getFactorizationPrecision() const
+	{
+		return mFactorizationPrecision;
+	}
+
+	UInt DirectLinearSolverConfiguration::getRefinementSteps() const
+	{
+		return mRefinementSteps;
+	}
+
+	Real DirectLinearSolverConfiguration::getRefinementTolerance() const
+	{
+		return mRefinementTolerance;
+	}
+
 	String DirectLinearSolverConfiguration::getScalingMethodString() const
 	{
 		switch(mScalingMethod)
@@ -118,4 +206,42 @@ namespace DPsim
 				return "without BTF";
 		}
 	}
+
+	String DirectLinearSolverConfiguration::getGpuTransferMethodString() const
+	{
+		switch(mGpuTransferMethod)
+		{
+			case GPU_TRANSFER_METHOD::PINNED_ASYNC:
+				return "with pinned asynchronous transfers";
+			case GPU_TRANSFER_METHOD::PINNED_ASYNC_GRAPH:
+				return "with pinned asynchronous transfers in a CUDA graph";
+			case GPU_TRANSFER_METHOD::SYNCHRONOUS:
+			default:
+				return "with synchronous transfers";
+		}
+	}
+
+	String DirectLinearSolverConfiguration::getIterativePreconditionerString() const
+	{
+		switch(mIterativePreconditioner)
+		{
+			case ITERATIVE_PRECONDITIONER::ILUT:
+				return "incomplete LU preconditioner";
+			case ITERATIVE_PRECONDITIONER::LU:
+			default:
+				return "prior LU preconditioner";
+		}
+	}
+
+	String DirectLinearSolverConfiguration::getFactorizationPrecisionString() const
+	{
+		switch(mFactorizationPrecision)
+		{
+			case FACTORIZATION_PRECISION::MIXED:
+				return "with single precision factorization and double precision refinement";
+			case FACTORIZATION_PRECISION::DOUBLE:
+			default:
+				return "with double precision factorization";
+		}
+	}
 }
@@ -0,0 +1,111 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/EnsembleSimulation.h>
+#include <dpsim/SequentialScheduler.h>
+#ifdef WITH_CUDA
+#include <dpsim/GpuBatchedAdapter.h>
+#endif
+
+using namespace CPS;
+using namespace DPsim;
+
+EnsembleSimulation::EnsembleSimulation(String name, BatchedLinearSolver::Ptr batchedLinearSolver, Logger::Level logLevel)
+	: mName(name), mBatchedLinearSolver(batchedLinearSolver), mLog(Logger::get(name, logLevel)) {
+
+	if (!mBatchedLinearSolver) {
+#ifdef WITH_CUDA
+		mBatchedLinearSolver = std::make_shared<GpuBatchedAdapter>(mLog);
+#else
+		mBatchedLinearSolver = std::make_shared<BatchedLinearSolver>(mLog);
+#endif
+	}
+}
+
+void EnsembleSimulation::addScenario(Simulation::Ptr scenario) {
+	if (mInitialized)
+		throw SystemError("Scenarios cannot be added to an initialized ensemble.");
+	mScenarios.push_back(scenario);
+}
+
+void EnsembleSimulation::initialize() {
+	if (mScenarios.empty())
+		throw SystemError("Ensemble " + mName + " has no scenarios.");
+
+	auto timeStep = mScenarios[0]->timeStep();
+	auto finalTime = mScenarios[0]->finalTime();
+
+	for (auto scenario : mScenarios) {
+		if (scenario->timeStep() != timeStep || scenario->finalTime() != finalTime)
+			throw SystemError("All scenarios of an ensemble require the same time step and final time.");
+
+		scenario->setBatchedLinearSolver(mBatchedLinearSolver);
+		scenario->initialize();
+
+		auto scheduler = std::dynamic_pointer_cast<SequentialScheduler>(scenario->scheduler());
+		if (!scheduler || !scheduler->hasSplitTask())
+			throw SystemError("Scenario " + scenario->name() + " does not support batched solves.");
+	}
+
+	SPDLOG_LOGGER_INFO(mLog, "Initialized ensemble {} with {} scenarios", mName, mScenarios.size());
+	mInitialized = true;
+}
+
+void EnsembleSimulation::start() {
+	if (!mInitialized)
+		initialize();
+
+	for (auto scenario : mScenarios)
+		scenario->start();
+}
+
+void EnsembleSimulation::stop() {
+	for (auto scenario : mScenarios)
+		scenario->stop();
+
+	SPDLOG_LOGGER_INFO(mLog, "Ensemble finished.");
+	mLog->flush();
+}
+
+Real EnsembleSimulation::step() {
+	if (mExecutor) {
+		mExecutor->parallelFor(static_cast<UInt>(mScenarios.size()), [this](UInt i) {
+			mScenarios[i]->stepBeforeBatchedSolve();
+		});
+		mBatchedLinearSolver->solve();
+		mExecutor->parallelFor(static_cast<UInt>(mScenarios.size()), [this](UInt i) {
+			mScenarios[i]->stepAfterBatchedSolve();
+		});
+		return mScenarios[0]->time();
+	}
+
+#ifdef WITH_OPENMP
+	#pragma omp parallel for
+#endif
+	for (std::size_t i = 0; i < mScenarios.size(); ++i)
+		mScenarios[i]->stepBeforeBatchedSolve();
+
+	mBatchedLinearSolver->solve();
+
+#ifdef WITH_OPENMP
+	#pragma omp parallel for
+#endif
+	for (std::size_t i = 0; i < mScenarios.size(); ++i)
+		mScenarios[i]->stepAfterBatchedSolve();
+
+	return mScenarios[0]->time();
+}
+
+void EnsembleSimulation::run() {
+	start();
+
+	while (mScenarios[0]->time() < mScenarios[0]->finalTime())
+		step();
+
+	stop();
+}
@@ -8,27 +8,105 @@
 
 #include <dpsim/Event.h>
 
+#include <limits>
+
 using namespace DPsim;
 using namespace CPS;
 
+EventQueue::~EventQueue() {
+	drainInjected();
+}
+
 void EventQueue::addEvent(Event::Ptr e) {
 	mEvents.push(e);
+	mAdded.push_back(e);
+}
+
+void EventQueue::injectEvent(Event::Ptr e) {
+	auto node = new InjectedEvent { e, mInjected.load(std::memory_order_relaxed) };
+	while (!mInjected.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void EventQueue::drainInjected() {
+	// The consumer takes the whole list at once, so there is no ABA problem
+	auto node = mInjected.exchange(nullptr, std::memory_order_acquire);
+	while (node) {
+		mEvents.push(node->event);
+		auto next = node->next;
+		delete node;
+		node = next;
+	}
 }
 
 void EventQueue::handleEvents(Real currentTime) {
-	Event::Ptr e;
+	drainInjected();
 
+	UInt handled = 0;
 	while (!mEvents.empty()) {
-		e = mEvents.top();
+		Event::Ptr e = mEvents.top();
 		// if current time larger or equal to event time, execute event
-		if ( currentTime > e->mTime || (e->mTime - currentTime) < 100e-9) {
+		if (currentTime > e->mTime || (e->mTime - currentTime) < timeTolerance) {
 			e->execute();
-			std::cout << std::scientific << currentTime << ": Handle event time" << std::endl;
-			//std::cout << std::scientific << e->mTime << ": Original event time" << std::endl;
-			//std::cout << std::scientific << (e->mTime - currentTime)*1e9 << ": Difference to specified event time in ns" << std::endl;
 			mEvents.pop();
+			++handled;
 		} else {
 			break;
 		}
 	}
+	if (handled > 0) {
+		++mHandledBatches;
+		mHandledEvents += handled;
+		mLastHandledTime = currentTime;
+	}
+}
+
+void EventQueue::reportHandled(Logger::Log log) {
+	if (mHandledBatches > 0)
+		SPDLOG_LOGGER_INFO(log, "Handled {} events in {} batches, the last at {:e}",
+			mHandledEvents, mHandledBatches, mLastHandledTime);
+	mHandledBatches = 0;
+	mHandledEvents = 0;
+}
+
+std::vector<Real> EventQueue::pendingTimes() const {
+	auto events = mEvents;
+	std::vector<Real> times;
+	while (!events.empty()) {
+		times.push_back(events.top()->mTime);
+		events.pop();
+	}
+	return times;
+}
+
+Real EventQueue::nextTime() const {
+	return mEvents.empty() ? std::numeric_limits<Real>::infinity() : mEvents.top()->mTime;
+}
+
+std::vector<Event::Ptr> EventQueue::nextEvents() const {
+	auto events = mEvents;
+	std::vector<Event::Ptr> next;
+	while (!events.empty() && events.top()->mTime - nextTime() < timeTolerance) {
+		next.push_back(events.top());
+		events.pop();
+	}
+	return next;
+}
+
+void EventQueue::rewind() {
+	drainInjected();
+	mEvents = decltype(mEvents)();
+	for (auto& e : mAdded)
+		mEvents.push(e);
+	mHandledBatches = 0;
+	mHandledEvents = 0;
+}
+
+void EventQueue::dropHandled(Real lastTime) {
+	while (!mEvents.empty()) {
+		Real time = mEvents.top()->mTime;
+		if (lastTime > time || (time - lastTime) < timeTolerance)
+			mEvents.pop();
+		else
+			break;
+	}
 }
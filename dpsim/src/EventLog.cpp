@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/EventLog.h>
+
+#include <chrono>
+
+using namespace CPS;
+using namespace DPsim;
+
+constexpr char EventLog::Magic[8];
+constexpr uint32_t EventLog::Version;
+
+EventLog::EventLog(const String& filename, UInt capacity) :
+	mFile(filename, std::ios::binary | std::ios::trunc) {
+	if (!mFile.good())
+		throw SystemError("Cannot open event log " + filename);
+
+	uint64_t size = 1;
+	while (size < capacity)
+		size <<= 1;
+	mSlots.reset(new Slot[size]);
+	for (uint64_t i = 0; i < size; i++)
+		mSlots[i].sequence.store(i, std::memory_order_relaxed);
+	mMask = size - 1;
+	mBuffer.reserve(size);
+
+	uint32_t recordSize = sizeof(Record);
+	mFile.write(Magic, sizeof(Magic));
+	mFile.write(reinterpret_cast<const char*>(&Version), sizeof(Version));
+	mFile.write(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+
+	mRunning = true;
+	mWriter = std::thread(&EventLog::run, this);
+}
+
+void EventLog::record(Type type, uint32_t code, double value0, double value1, double value2) {
+	// Claim a free slot, see Vyukov's bounded queue
+	uint64_t pos = mEnqueue.load(std::memory_order_relaxed);
+	Slot* slot;
+	while (true) {
+		slot = &mSlots[pos & mMask];
+		uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+		int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+		if (diff == 0) {
+			if (mEnqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			mDropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		} else {
+			pos = mEnqueue.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->record = Record {
+		mTime.load(std::memory_order_relaxed),
+		mStep.load(std::memory_order_relaxed),
+		static_cast<uint32_t>(type), code,
+		{ value0, value1, value2 }
+	};
+	slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+std::size_t EventLog::drain() {
+	mBuffer.clear();
+	while (true) {
+		Slot& slot = mSlots[mDequeue & mMask];
+		if (slot.sequence.load(std::memory_order_acquire) != mDequeue + 1)
+			break;
+		mBuffer.push_back(slot.record);
+		slot.sequence.store(mDequeue + mMask + 1, std::memory_order_release);
+		++mDequeue;
+	}
+
+	if (!mBuffer.empty()) {
+		mFile.write(reinterpret_cast<const char*>(mBuffer.data()), mBuffer.size() * sizeof(Record));
+		mWritten.fetch_add(mBuffer.size(), std::memory_order_relaxed);
+	}
+	return mBuffer.size();
+}
+
+void EventLog::run() {
+	while (mRunning.load(std::memory_order_acquire)) {
+		if (drain() == 0)
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+}
+
+void EventLog::close() {
+	if (!mWriter.joinable())
+		return;
+	mRunning = false;
+	mWriter.join();
+	drain();
+	mFile.close();
+}
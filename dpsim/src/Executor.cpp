@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/Executor.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+#ifdef __linux__
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+using namespace CPS;
+using namespace DPsim;
+
+namespace {
+	/// Executor whose worker runs the calling thread, if any
+	thread_local const Executor* tWorkerOf = nullptr;
+
+	std::vector<Int> processCpus() {
+		std::vector<Int> cpus;
+#ifdef __linux__
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0) {
+			for (Int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+				if (CPU_ISSET(cpu, &cpuSet))
+					cpus.push_back(cpu);
+			}
+		}
+#endif
+		if (cpus.empty()) {
+			Int count = std::max<Int>(1, static_cast<Int>(std::thread::hardware_concurrency()));
+			for (Int cpu = 0; cpu < count; cpu++)
+				cpus.push_back(cpu);
+		}
+		return cpus;
+	}
+
+	void setAffinity(const std::vector<Int>& cpus) {
+#ifdef __linux__
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		for (auto cpu : cpus)
+			CPU_SET(cpu, &cpuSet);
+		pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#endif
+	}
+}
+
+Executor::Executor(const std::vector<Int>& cpus) :
+	mCpus(cpus.empty() ? processCpus() : cpus),
+	mReserved(mCpus.size(), false) { }
+
+Executor::Executor(Ptr parent, const std::vector<Int>& cpus) :
+	mParent(parent), mCpus(cpus), mReserved(cpus.size(), false) { }
+
+Executor::~Executor() {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopping = true;
+	}
+	mCondition.notify_all();
+	for (auto& worker : mWorkers)
+		worker.join();
+
+	if (mParent)
+		mParent->release(mCpus);
+}
+
+Executor::Ptr Executor::global() {
+	static Ptr executor = std::make_shared<Executor>();
+	return executor;
+}
+
+UInt Executor::freeCores() {
+	std::lock_guard<std::mutex> lock(mPartitionMutex);
+	return static_cast<UInt>(std::count(mReserved.begin(), mReserved.end(), false));
+}
+
+Executor::Ptr Executor::partition(UInt cores) {
+	std::lock_guard<std::mutex> lock(mPartitionMutex);
+	std::vector<std::size_t> free;
+	for (std::size_t i = 0; i < mCpus.size() && free.size() < cores; i++) {
+		if (!mReserved[i])
+			free.push_back(i);
+	}
+	if (cores == 0 || free.size() < cores)
+		throw SystemError("Cannot reserve " + std::to_string(cores) + " cores, only " + std::to_string(free.size()) + " are free");
+
+	std::vector<Int> cpus;
+	for (auto i : free) {
+		mReserved[i] = true;
+		cpus.push_back(mCpus[i]);
+	}
+	return Ptr(new Executor(shared_from_this(), cpus));
+}
+
+std::vector<Executor::Ptr> Executor::split(UInt parts) {
+	UInt cores = parts > 0 ? freeCores() / parts : 0;
+	std::vector<Ptr> partitions;
+	for (UInt i = 0; i < parts; i++)
+		partitions.push_back(partition(cores));
+	return partitions;
+}
+
+void Executor::release(const std::vector<Int>& cpus) {
+	std::lock_guard<std::mutex> lock(mPartitionMutex);
+	for (std::size_t i = 0; i < mCpus.size(); i++) {
+		if (std::find(cpus.begin(), cpus.end(), mCpus[i]) != cpus.end())
+			mReserved[i] = false;
+	}
+}
+
+std::future<void> Executor::submit(std::function<void()> job) {
+	std::packaged_task<void()> task(std::move(job));
+	auto future = task.get_future();
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mWorkers.empty()) {
+			for (UInt i = 0; i < concurrency(); i++)
+				mWorkers.emplace_back(&Executor::workerFunction, this);
+		}
+		mJobs.push_back(std::move(task));
+	}
+	mCondition.notify_one();
+	return future;
+}
+
+void Executor::workerFunction() {
+	pin();
+	tWorkerOf = this;
+	while (true) {
+		std::packaged_task<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mCondition.wait(lock, [this]() { return mStopping || !mJobs.empty(); });
+			if (mJobs.empty())
+				return;
+			job = std::move(mJobs.front());
+			mJobs.pop_front();
+		}
+		job();
+	}
+}
+
+void Executor::parallelFor(UInt count, const std::function<void(UInt)>& func) {
+	if (count == 0)
+		return;
+
+	std::atomic<UInt> next { 0 };
+	std::exception_ptr error;
+	std::mutex errorMutex;
+	auto run = [&]() {
+		for (UInt i = next++; i < count; i = next++) {
+			try {
+				func(i);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (!error)
+					error = std::current_exception();
+			}
+		}
+	};
+
+	// Workers waiting for helpers queued behind them would never finish
+	std::vector<std::future<void>> helpers;
+	if (tWorkerOf != this) {
+		UInt numHelpers = std::min(concurrency(), count) - 1;
+		for (UInt i = 0; i < numHelpers; i++)
+			helpers.push_back(submit(run));
+	}
+	run();
+	for (auto& helper : helpers)
+		helper.wait();
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+std::thread Executor::spawn(Int index, std::function<void()> func) {
+	return std::thread([this, index, func = std::move(func)]() {
+		if (index < 0)
+			pin();
+		else
+			pin(index);
+		func();
+	});
+}
+
+void Executor::pin(Int index) const {
+	setAffinity({ mCpus[static_cast<std::size_t>(index) % mCpus.size()] });
+}
+
+void Executor::pin() const {
+	setAffinity(mCpus);
+}
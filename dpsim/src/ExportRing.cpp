@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/ExportRing.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace CPS;
+using namespace DPsim;
+
+ExportRing::ExportRing(const std::vector<AttributeBase::Ptr>& attributes, UInt capacity, const std::vector<Real>& deadbands) :
+	mAttributes(attributes),
+	mDeadbands(deadbands),
+	mFree(capacity),
+	mFilled(capacity) {
+	if (capacity == 0)
+		throw SystemError("Export ring requires at least one slot.");
+	mDeadbands.resize(mAttributes.size(), 0);
+
+	UInt values = 0;
+	UInt bytes = 0;
+	UInt others = 0;
+	UInt maxWidth = 2;
+	mByteSizes.resize(mAttributes.size(), 0);
+	mPrototypes.resize(mAttributes.size());
+	mWidths.resize(mAttributes.size(), 0);
+	mShapes.resize(mAttributes.size(), { 0, 0 });
+	for (UInt i = 0; i < mAttributes.size(); ++i) {
+		auto& attr = mAttributes[i];
+		const std::type_info& type = attr->getType();
+		if (type == typeid(Real)) {
+			mKinds.push_back(Kind::Real);
+			mWidths[i] = 1;
+		} else if (type == typeid(Int)) {
+			mKinds.push_back(Kind::Int);
+			mWidths[i] = 1;
+		} else if (type == typeid(Bool)) {
+			mKinds.push_back(Kind::Bool);
+			mWidths[i] = 1;
+		} else if (type == typeid(Complex)) {
+			mKinds.push_back(Kind::Complex);
+			mWidths[i] = 2;
+		} else if (type == typeid(Matrix)) {
+			// Matrices keep their dimensions after the initialization, so the width is fixed
+			const Matrix& value = static_cast<Attribute<Matrix>*>(attr.get())->get();
+			mKinds.push_back(Kind::Vector);
+			mShapes[i] = { value.rows(), value.cols() };
+			mWidths[i] = static_cast<UInt>(value.size());
+			maxWidth = std::max(maxWidth, mWidths[i]);
+		} else if (std::size_t size = attr->serializedSize()) {
+			// Complex matrices are serialized, their size is fixed for the same reason
+			mKinds.push_back(Kind::Bytes);
+			mOffsets.push_back(bytes);
+			mByteSizes[i] = size;
+			mPrototypes[i] = attr->cloneValueOntoNewAttribute();
+			bytes += static_cast<UInt>(size);
+		} else {
+			mKinds.push_back(Kind::Other);
+			mOffsets.push_back(others++);
+		}
+		if (mKinds[i] != Kind::Bytes && mKinds[i] != Kind::Other) {
+			mOffsets.push_back(values);
+			values += mWidths[i];
+		}
+	}
+	mCurrent.resize(maxWidth);
+
+	mLast.values.resize(values);
+	mLast.bytes.resize(bytes);
+	mLast.others.resize(others);
+	mSlots.resize(capacity);
+	for (UInt i = 0; i < capacity; ++i) {
+		mSlots[i].values.resize(values);
+		mSlots[i].bytes.resize(bytes);
+		mSlots[i].others.resize(others);
+		mFree.try_enqueue(i);
+	}
+}
+
+void ExportRing::read(UInt index, Real* values) const {
+	AttributeBase* attr = mAttributes[index].get();
+	// The kinds are checked by the constructor, so the static casts are safe
+	switch (mKinds[index]) {
+	case Kind::Real:
+		values[0] = static_cast<Attribute<Real>*>(attr)->get();
+		break;
+	case Kind::Int:
+		values[0] = static_cast<Attribute<Int>*>(attr)->get();
+		break;
+	case Kind::Bool:
+		values[0] = static_cast<Attribute<Bool>*>(attr)->get() ? 1 : 0;
+		break;
+	case Kind::Complex: {
+		const Complex& value = static_cast<Attribute<Complex>*>(attr)->get();
+		values[0] = value.real();
+		values[1] = value.imag();
+		break;
+	}
+	case Kind::Vector: {
+		// A matrix whose size changed keeps its last values
+		const Matrix& value = static_cast<Attribute<Matrix>*>(attr)->get();
+		if (value.size() == static_cast<Matrix::Index>(mWidths[index]))
+			std::memcpy(values, value.data(), mWidths[index] * sizeof(Real));
+		break;
+	}
+	case Kind::Bytes:
+	case Kind::Other:
+		break;
+	}
+}
+
+Bool ExportRing::changed(UInt index) {
+	if (mKinds[index] == Kind::Bytes || mKinds[index] == Kind::Other || mDeadbands[index] <= 0)
+		return true;
+
+	const Real* last = &mLast.values[mOffsets[index]];
+	// Keep the last values if the matrix size changed
+	std::copy(last, last + mWidths[index], mCurrent.begin());
+	read(index, mCurrent.data());
+	switch (mKinds[index]) {
+	case Kind::Bool:
+		return mCurrent[0] != last[0];
+	case Kind::Complex:
+		return std::abs(Complex(mCurrent[0] - last[0], mCurrent[1] - last[1])) > mDeadbands[index];
+	case Kind::Vector:
+		for (UInt k = 0; k < mWidths[index]; ++k) {
+			if (std::abs(mCurrent[k] - last[k]) > mDeadbands[index])
+				return true;
+		}
+		return false;
+	default:
+		return std::abs(mCurrent[0] - last[0]) > mDeadbands[index];
+	}
+}
+
+Bool ExportRing::push(UInt sequenceId, Real time, const std::vector<bool>* due) {
+	Bool updated = false;
+	for (UInt i = 0; i < mAttributes.size(); ++i) {
+		// Until the first push, there are no last values to keep
+		if (due && mHasLast && (!(*due)[i] || !changed(i)))
+			continue;
+
+		// A value whose size changed keeps its last serialized value
+		if (mKinds[i] == Kind::Bytes)
+			mAttributes[i]->serializeTo(&mLast.bytes[mOffsets[i]], mByteSizes[i]);
+		else if (mKinds[i] == Kind::Other)
+			mLast.others[mOffsets[i]] = mAttributes[i]->cloneValueOntoNewAttribute();
+		else
+			read(i, &mLast.values[mOffsets[i]]);
+		updated = true;
+	}
+	if (!updated)
+		return false;
+	mHasLast = true;
+
+	UInt index;
+	mFree.wait_dequeue(index);
+
+	// The sizes match, so the assignments copy without allocating
+	Slot& slot = mSlots[index];
+	slot.sequenceId = sequenceId;
+	slot.time = time;
+	slot.close = false;
+	slot.values = mLast.values;
+	slot.bytes = mLast.bytes;
+	slot.others = mLast.others;
+
+	mFilled.try_enqueue(index);
+	return true;
+}
+
+void ExportRing::pushClose() {
+	UInt index;
+	mFree.wait_dequeue(index);
+	mSlots[index].close = true;
+	mFilled.try_enqueue(index);
+}
+
+const ExportRing::Slot* ExportRing::acquire(Bool& closed, Bool newest) {
+	release();
+
+	UInt index;
+	mFilled.wait_dequeue(index);
+	return take(index, closed, newest);
+}
+
+const ExportRing::Slot* ExportRing::tryAcquire(Bool& closed, Bool newest) {
+	release();
+
+	UInt index;
+	if (!mFilled.try_dequeue(index))
+		return nullptr;
+	return take(index, closed, newest);
+}
+
+const ExportRing::Slot* ExportRing::take(UInt index, Bool& closed, Bool newest) {
+	if (!newest) {
+		if (mSlots[index].close) {
+			closed = true;
+			mFree.try_enqueue(index);
+			return nullptr;
+		}
+		mHeld = static_cast<Int>(index);
+		return &mSlots[mHeld];
+	}
+
+	do {
+		if (mSlots[index].close) {
+			closed = true;
+			mFree.try_enqueue(index);
+		} else {
+			// Only the newest values are written, older slots are outdated
+			release();
+			mHeld = static_cast<Int>(index);
+		}
+	} while (mFilled.try_dequeue(index));
+
+	return mHeld < 0 ? nullptr : &mSlots[mHeld];
+}
+
+void ExportRing::release() {
+	if (mHeld < 0)
+		return;
+
+	mFree.try_enqueue(static_cast<UInt>(mHeld));
+	mHeld = -1;
+}
+
+std::size_t ExportRing::memoryBytes() const {
+	std::size_t bytes = 0;
+	for (auto& slot : mSlots)
+		bytes += slot.values.capacity() * sizeof(Real) + slot.bytes.capacity()
+			+ slot.others.capacity() * sizeof(AttributeBase::Ptr);
+	return bytes + mLast.values.capacity() * sizeof(Real) + mLast.bytes.capacity();
+}
+
+AttributeBase::Ptr ExportRing::value(const Slot& slot, UInt index) const {
+	switch (mKinds[index]) {
+	case Kind::Real:
+		return AttributePointer<AttributeBase>(AttributeStatic<Real>::make(real(slot, index)));
+	case Kind::Int:
+		return AttributePointer<AttributeBase>(AttributeStatic<Int>::make(integer(slot, index)));
+	case Kind::Bool:
+		return AttributePointer<AttributeBase>(AttributeStatic<Bool>::make(boolean(slot, index)));
+	case Kind::Complex:
+		return AttributePointer<AttributeBase>(AttributeStatic<Complex>::make(complex(slot, index)));
+	case Kind::Vector:
+		return AttributePointer<AttributeBase>(AttributeStatic<Matrix>::make(
+			Eigen::Map<const Matrix>(vector(slot, index), mShapes[index].first, mShapes[index].second)));
+	case Kind::Bytes: {
+		auto attr = mPrototypes[index]->cloneValueOntoNewAttribute();
+		attr->deserializeFrom(bytes(slot, index), mByteSizes[index]);
+		return attr;
+	}
+	case Kind::Other:
+		break;
+	}
+	return slot.others[mOffsets[index]];
+}
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/GeneratedStep.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <Eigen/OrderingMethods>
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+namespace {
+	/// Exact representation of the value as a hexadecimal floating point literal
+	String literal(Real value) {
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%a", value);
+		return buffer;
+	}
+
+	/// 64 bit FNV-1a of the code, the cached source is compared as well so collisions only cost a compilation
+	uint64_t digest(const String& code) {
+		uint64_t hash = 0xcbf29ce484222325;
+		for (unsigned char c : code) {
+			hash ^= c;
+			hash *= 0x100000001b3;
+		}
+		return hash;
+	}
+
+	/// True if the path is owned by the user and not writable by others
+	Bool isPrivate(const struct stat& info) {
+		return info.st_uid == geteuid() && (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+	}
+
+	/// Private cache directory of the user, created with mode 0700. Throws if
+	/// it exists but is owned by another user or writable by others.
+	std::filesystem::path cacheDirectory() {
+		namespace fs = std::filesystem;
+
+		fs::path directory;
+		const char* cacheHome = std::getenv("XDG_CACHE_HOME");
+		const char* home = std::getenv("HOME");
+		if (cacheHome != nullptr && *cacheHome != '\0')
+			directory = fs::path(cacheHome) / "dpsim-codegen";
+		else if (home != nullptr && *home != '\0')
+			directory = fs::path(home) / ".cache" / "dpsim-codegen";
+		else
+			directory = fs::temp_directory_path() / ("dpsim-codegen-" + std::to_string(geteuid()));
+
+		if (directory.has_parent_path())
+			fs::create_directories(directory.parent_path());
+		if (mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST)
+			throw SystemError("Cannot create the generated step cache " + directory.string() + ": " + std::strerror(errno));
+
+		struct stat info;
+		if (lstat(directory.c_str(), &info) != 0 || !S_ISDIR(info.st_mode) || !isPrivate(info))
+			throw SystemError("The generated step cache " + directory.string() + " is not a directory private to the user");
+		return directory;
+	}
+
+	/// True if the library and its source are private to the user and the source equals the code
+	Bool isCached(const String& code, const std::filesystem::path& source, const std::filesystem::path& library) {
+		struct stat info;
+		if (lstat(library.c_str(), &info) != 0 || !S_ISREG(info.st_mode) || !isPrivate(info))
+			return false;
+		if (lstat(source.c_str(), &info) != 0 || !S_ISREG(info.st_mode) || !isPrivate(info)
+			|| static_cast<std::size_t>(info.st_size) != code.size())
+			return false;
+
+		std::ifstream file(source, std::ios_base::in | std::ios_base::binary);
+		std::ostringstream cached;
+		cached << file.rdbuf();
+		return file.good() && cached.str() == code;
+	}
+
+	/// Arguments of the compiler command. CC is split at whitespace like make
+	/// does, e.g. "ccache gcc" or "gcc -m64", but quotes are not interpreted.
+	std::vector<String> compilerCommand(const std::filesystem::path& source, const std::filesystem::path& library) {
+		const char* compiler = std::getenv("CC");
+		std::vector<String> args;
+		std::istringstream words(compiler != nullptr ? compiler : "");
+		for (String word; words >> word;)
+			args.push_back(word);
+		if (args.empty())
+			args.push_back("cc");
+		for (const String& arg : { String("-O2"), String("-shared"), String("-fPIC"), String("-o"), library.string(), source.string() })
+			args.push_back(arg);
+		return args;
+	}
+
+	String commandLine(const std::vector<String>& args) {
+		String line;
+		for (auto& arg : args)
+			line += (line.empty() ? "" : " ") + arg;
+		return line;
+	}
+
+	/// Runs the compiler without a shell and returns its exit status, 127 if it could not be executed, -1 if it could not be run
+	int compile(std::vector<String> args) {
+		std::vector<char*> argv;
+		for (auto& arg : args)
+			argv.push_back(arg.data());
+		argv.push_back(nullptr);
+
+		pid_t pid = fork();
+		if (pid < 0)
+			return -1;
+		if (pid == 0) {
+			execvp(argv[0], argv.data());
+			_exit(127);
+		}
+		int status;
+		while (waitpid(pid, &status, 0) < 0) {
+			if (errno != EINTR)
+				return -1;
+		}
+		return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+	}
+}
+
+GeneratedStep::~GeneratedStep() {
+	if (mDlHandle != nullptr)
+		dlclose(mDlHandle);
+}
+
+void GeneratedStep::generate(const SparseMatrix& systemMatrix, const std::vector<Scatter>& scatter, UInt numStamps, UInt numDenseStamps) {
+	load(emit(systemMatrix, scatter, numStamps, numDenseStamps));
+}
+
+String GeneratedStep::emit(const SparseMatrix& systemMatrix, const std::vector<Scatter>& scatter, UInt numStamps, UInt numDenseStamps) {
+	const Int n = static_cast<Int>(systemMatrix.rows());
+	if (n > static_cast<Int>(MaxRows))
+		throw SystemError("The system of " + std::to_string(n) + " rows is too large for a generated step");
+
+	// Fill-reducing symmetric ordering, order[i] is the row of the system at position i
+	Eigen::SparseMatrix<Real, Eigen::ColMajor, int> colMajor = systemMatrix;
+	Eigen::AMDOrdering<int>::PermutationType ordering;
+	Eigen::AMDOrdering<int>()(colMajor, ordering);
+	const int* order = ordering.indices().data();
+	std::vector<Int> position(n);
+	for (Int i = 0; i < n; ++i)
+		position[order[i]] = i;
+
+	Matrix lu = Matrix::Zero(n, n);
+	for (Int k = 0; k < systemMatrix.outerSize(); ++k) {
+		for (SparseMatrix::InnerIterator it(systemMatrix, k); it; ++it)
+			lu(position[it.row()], position[it.col()]) = it.value();
+	}
+
+	// Right-looking LU with partial pivoting, exact zeros stay zero and are not emitted
+	std::vector<Int> pivotRows(n);
+	for (Int i = 0; i < n; ++i)
+		pivotRows[i] = i;
+	std::vector<Int> pivotColumns;
+	for (Int k = 0; k < n; ++k) {
+		Int pivot;
+		Real maximum = lu.col(k).tail(n - k).cwiseAbs().maxCoeff(&pivot);
+		if (maximum == 0)
+			throw SystemError("The system matrix is singular, no step is generated");
+		pivot += k;
+		if (pivot != k) {
+			lu.row(k).swap(lu.row(pivot));
+			std::swap(pivotRows[k], pivotRows[pivot]);
+		}
+		pivotColumns.clear();
+		for (Int j = k + 1; j < n; ++j) {
+			if (lu(k, j) != 0)
+				pivotColumns.push_back(j);
+		}
+		for (Int i = k + 1; i < n; ++i) {
+			if (lu(i, k) == 0)
+				continue;
+			lu(i, k) /= lu(k, k);
+			for (Int j : pivotColumns)
+				lu(i, j) -= lu(i, k) * lu(k, j);
+		}
+	}
+
+	std::ostringstream code;
+	code << "/* Generated by DPsim for a system of " << n << " rows, do not edit */\n"
+	     << "void dpsim_generated_step(const double* const* s, double* b, double* x) {\n"
+	     << "\tdouble z[" << std::max<Int>(n, 1) << "];\n";
+
+	code << "\tfor (int i = 0; i < " << n << "; ++i)\n\t\tb[i] = 0;\n";
+	for (auto& entry : scatter)
+		code << "\tb[" << entry.row << "] += s[" << entry.stamp << "][" << entry.row << "];\n";
+	for (UInt stamp = numStamps - numDenseStamps; stamp < numStamps; ++stamp)
+		code << "\tfor (int i = 0; i < " << n << "; ++i)\n\t\tb[i] += s[" << stamp << "][i];\n";
+
+	// L z = P b, the unit diagonal of L is not stored
+	mNumTerms = 0;
+	for (Int i = 0; i < n; ++i) {
+		code << "\tz[" << i << "] = b[" << order[pivotRows[i]] << "]";
+		for (Int j = 0; j < i; ++j) {
+			if (lu(i, j) != 0) {
+				code << " - " << literal(lu(i, j)) << " * z[" << j << "]";
+				++mNumTerms;
+			}
+		}
+		code << ";\n";
+	}
+	// U y = z, with y in place of z and scattered to the rows of the system
+	for (Int i = n - 1; i >= 0; --i) {
+		code << "\tz[" << i << "] = (z[" << i << "]";
+		for (Int j = i + 1; j < n; ++j) {
+			if (lu(i, j) != 0) {
+				code << " - " << literal(lu(i, j)) << " * z[" << j << "]";
+				++mNumTerms;
+			}
+		}
+		code << ") * " << literal(1. / lu(i, i)) << ";\n";
+		code << "\tx[" << order[i] << "] = z[" << i << "];\n";
+	}
+	code << "}\n";
+	return code.str();
+}
+
+void GeneratedStep::load(const String& code) {
+	namespace fs = std::filesystem;
+
+	std::ostringstream name;
+	name << "dpsim_step_" << std::hex << std::setw(16) << std::setfill('0') << digest(code);
+	fs::path directory = cacheDirectory();
+	fs::path library = directory / (name.str() + ".so");
+	fs::path cachedSource = directory / (name.str() + ".c");
+
+	if (!isCached(code, cachedSource, library)) {
+		// Other simulations may generate the same step concurrently, so the library is built under a unique name and renamed
+		String unique = name.str() + "." + std::to_string(getpid()) + "." + std::to_string(reinterpret_cast<std::uintptr_t>(this));
+		fs::path source = directory / (unique + ".c");
+		fs::path temporary = directory / (unique + ".so");
+		{
+			std::ofstream file(source);
+			file << code;
+			if (!file.good())
+				throw SystemError("Cannot write the generated step " + source.string());
+		}
+
+		auto args = compilerCommand(source, temporary);
+		SPDLOG_LOGGER_INFO(mSLog, "Compiling generated step: {}", commandLine(args));
+		int status = compile(args);
+		if (status != 0) {
+			fs::remove(source);
+			fs::remove(temporary);
+			throw SystemError("Compiling the generated step failed with status " + std::to_string(status) + ": " + commandLine(args));
+		}
+		// The source is kept next to the library to verify it before the library is reused
+		fs::rename(temporary, library);
+		fs::rename(source, cachedSource);
+	} else {
+		SPDLOG_LOGGER_INFO(mSLog, "Using cached generated step {}", library.string());
+	}
+
+	if ((mDlHandle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL)) == nullptr) {
+		SPDLOG_LOGGER_ERROR(mSLog, "error opening generated step {}: {}", library.string(), dlerror());
+		throw SystemError("error opening generated step.");
+	}
+	mStep = reinterpret_cast<StepFunction>(dlsym(mDlHandle, "dpsim_generated_step"));
+	if (mStep == nullptr) {
+		SPDLOG_LOGGER_ERROR(mSLog, "error reading symbol from generated step {}: {}", library.string(), dlerror());
+		throw SystemError("error reading symbol from generated step.");
+	}
+}
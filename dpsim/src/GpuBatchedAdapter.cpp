@@ -0,0 +1,151 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/GpuBatchedAdapter.h>
+#include <dpsim/GpuDenseAdapter.h>
+#include <algorithm>
+
+using namespace DPsim;
+
+namespace DPsim
+{
+    GpuBatchedAdapter::GpuBatchedAdapter(CPS::Logger::Log log) : BatchedLinearSolver(log)
+    {
+        mDeviceCopy = {};
+
+        cublasStatus_t status = CUBLAS_STATUS_SUCCESS;
+        cudaError_t error = cudaSuccess;
+        if((status = cublasCreate(&mCublasHandle)) != CUBLAS_STATUS_SUCCESS)
+            std::cerr << "cublasCreate() failed (initializing cublas-library)" << std::endl;
+        if((error = cudaStreamCreateWithFlags(&mStream, cudaStreamNonBlocking)) != cudaSuccess)
+            std::cerr << cudaGetErrorString(error) << std::endl;
+        if((status = cublasSetStream(mCublasHandle, mStream)) != CUBLAS_STATUS_SUCCESS)
+            std::cerr << "cublasSetStream() failed" << std::endl;
+    }
+
+    GpuBatchedAdapter::~GpuBatchedAdapter()
+    {
+        freeDeviceMemory();
+
+        //Handle & Stream
+        if(mCublasHandle)
+            cublasDestroy(mCublasHandle);
+        if(mStream)
+            cudaStreamDestroy(mStream);
+    }
+
+    void GpuBatchedAdapter::freeDeviceMemory()
+    {
+        if(mPinnedVectors)
+            cudaFreeHost(mPinnedVectors);
+        mPinnedVectors = nullptr;
+
+        cudaFree(mDeviceCopy.matrices);
+        cudaFree(mDeviceCopy.matrixPointers);
+        cudaFree(mDeviceCopy.vectors);
+        cudaFree(mDeviceCopy.vectorPointers);
+        cudaFree(mDeviceCopy.pivSeq);
+        cudaFree(mDeviceCopy.errInfo);
+        mDeviceCopy = {};
+    }
+
+    void GpuBatchedAdapter::allocateDeviceMemory()
+    {
+        freeDeviceMemory();
+
+        UInt n = mDimension;
+        UInt systems = size();
+
+        //Allocate memory for...
+        //Matrices and their pointers
+        CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.matrices, n * n * systems * sizeof(Real)))
+        CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.matrixPointers, systems * sizeof(double*)))
+        //Vectors and their pointers
+        CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.vectors, n * systems * sizeof(Real)))
+        CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.vectorPointers, systems * sizeof(double*)))
+        //Pivoting-Sequences
+        CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.pivSeq, n * systems * sizeof(int)))
+        //Errorcodes
+        CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.errInfo, systems * sizeof(int)))
+        //Pinned host vectors
+        CUDA_ERROR_HANDLER(cudaMallocHost((void**)&mPinnedVectors, n * systems * sizeof(Real)))
+
+        std::vector<double*> matrixPointers(systems), vectorPointers(systems);
+        for (UInt i = 0; i < systems; ++i) {
+            matrixPointers[i] = mDeviceCopy.matrices + i * n * n;
+            vectorPointers[i] = mDeviceCopy.vectors + i * n;
+        }
+        CUDA_ERROR_HANDLER(cudaMemcpy(mDeviceCopy.matrixPointers, matrixPointers.data(), systems * sizeof(double*), cudaMemcpyHostToDevice))
+        CUDA_ERROR_HANDLER(cudaMemcpy(mDeviceCopy.vectorPointers, vectorPointers.data(), systems * sizeof(double*), cudaMemcpyHostToDevice))
+
+        mDeviceCopy.systems = systems;
+        mErrInfo.resize(systems);
+    }
+
+    void GpuBatchedAdapter::factorize()
+    {
+        if (mDeviceCopy.systems != size())
+            allocateDeviceMemory();
+
+        UInt n = mDimension;
+        for (UInt i = 0; i < size(); ++i)
+            CUDA_ERROR_HANDLER(cudaMemcpyAsync(mDeviceCopy.matrices + i * n * n, mSystemMatrices[i].data(), n * n * sizeof(Real), cudaMemcpyHostToDevice, mStream))
+
+        //LU-factorization of the whole batch
+        cublasStatus_t status = cublasDgetrfBatched(
+            mCublasHandle,
+            n,
+            mDeviceCopy.matrixPointers,
+            n,
+            mDeviceCopy.pivSeq,
+            mDeviceCopy.errInfo,
+            size());
+        if(status != CUBLAS_STATUS_SUCCESS)
+            std::cerr << "cublasDgetrfBatched() failed (calculating LU-factorizations)" << std::endl;
+
+        CUDA_ERROR_HANDLER(cudaMemcpyAsync(mErrInfo.data(), mDeviceCopy.errInfo, size() * sizeof(int), cudaMemcpyDeviceToHost, mStream))
+        CUDA_ERROR_HANDLER(cudaStreamSynchronize(mStream))
+
+        for (UInt i = 0; i < size(); ++i) {
+            if (mErrInfo[i] > 0)
+                SPDLOG_LOGGER_WARN(mSLog, "System {} of the batch is singular", i);
+        }
+        SPDLOG_LOGGER_DEBUG(mSLog, "Factorized batch of {} systems", size());
+    }
+
+    void GpuBatchedAdapter::solveBatch()
+    {
+        UInt n = mDimension;
+        for (UInt i = 0; i < size(); ++i)
+            std::copy(mRightSideVectors[i].data(), mRightSideVectors[i].data() + n, mPinnedVectors + i * n);
+
+        CUDA_ERROR_HANDLER(cudaMemcpyAsync(mDeviceCopy.vectors, mPinnedVectors, n * size() * sizeof(Real), cudaMemcpyHostToDevice, mStream))
+
+        int info = 0;
+        cublasStatus_t status = cublasDgetrsBatched(
+            mCublasHandle,
+            CUBLAS_OP_N,
+            n,
+            1,
+            mDeviceCopy.matrixPointers,
+            n,
+            mDeviceCopy.pivSeq,
+            mDeviceCopy.vectorPointers,
+            n,
+            &info,
+            size());
+        if(status != CUBLAS_STATUS_SUCCESS || info < 0)
+            std::cerr << "cublasDgetrsBatched() failed (Solving A*x = b)" << std::endl;
+
+        CUDA_ERROR_HANDLER(cudaMemcpyAsync(mPinnedVectors, mDeviceCopy.vectors, n * size() * sizeof(Real), cudaMemcpyDeviceToHost, mStream))
+        CUDA_ERROR_HANDLER(cudaStreamSynchronize(mStream))
+
+        for (UInt i = 0; i < size(); ++i)
+            std::copy(mPinnedVectors + i * n, mPinnedVectors + (i + 1) * n, mLeftSideVectors[i].data());
+    }
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/GpuCompanionModels.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+namespace {
+	template <typename T>
+	void copyToDevice(const std::vector<T>& values, cuda::Vector<T>& device) {
+		device = cuda::Vector<T>(values.size());
+		if (!values.empty() && cudaMemcpy(device.data(), values.data(), values.size() * sizeof(T), cudaMemcpyHostToDevice) != cudaSuccess)
+			throw SolverException();
+	}
+}
+
+template <int NumPhases>
+GpuCompanionModels<NumPhases>::GpuCompanionModels(const std::vector<MNASimPowerComp<Real>*>& comps)
+	: mComps(comps) {
+	for (auto comp : comps) {
+		// The interface attributes are static, so their values are not moved during the simulation
+		mIntfVoltage.push_back(comp->mIntfVoltage->asRawPointer());
+		mIntfCurrent.push_back(comp->mIntfCurrent->asRawPointer());
+	}
+}
+
+template <int NumPhases>
+GpuCompanionModels<NumPhases>::~GpuCompanionModels() {
+	if (mPinnedStates != nullptr)
+		cudaFreeHost(mPinnedStates);
+}
+
+template <int NumPhases>
+void GpuCompanionModels<NumPhases>::upload() {
+	auto members = EMT::CompanionModelBatch<NumPhases>::members(mComps);
+	const std::size_t n = members.size();
+	const std::size_t values = n * NumPhases;
+
+	std::vector<double> equivCond(values * NumPhases), voltageCoeff(values * NumPhases), currentCoeff(n);
+	std::vector<double> states(3 * values);
+	std::vector<int> rows0(values), rows1(values);
+	mEquivCurrent.clear();
+	for (std::size_t k = 0; k < n; ++k) {
+		auto& member = members[k];
+		auto comp = member.comp;
+		mEquivCurrent.push_back(member.equivCurrent);
+		currentCoeff[k] = member.currentCoeff;
+		for (int a = 0; a < NumPhases; ++a) {
+			for (int b = 0; b < NumPhases; ++b) {
+				equivCond[(a * NumPhases + b) * n + k] = member.equivCond(a, b);
+				voltageCoeff[(a * NumPhases + b) * n + k] = member.voltageCoeff(a, b);
+			}
+			states[a * n + k] = (*mIntfVoltage[k])(a, 0);
+			states[values + a * n + k] = (*mIntfCurrent[k])(a, 0);
+			states[2 * values + a * n + k] = member.equivCurrent[a];
+			rows0[a * n + k] = comp->terminalNotGrounded(0) ? static_cast<int>(comp->matrixNodeIndex(0, a)) : -1;
+			rows1[a * n + k] = comp->terminalNotGrounded(1) ? static_cast<int>(comp->matrixNodeIndex(1, a)) : -1;
+		}
+	}
+
+	copyToDevice(equivCond, mEquivCond);
+	copyToDevice(voltageCoeff, mVoltageCoeff);
+	copyToDevice(currentCoeff, mCurrentCoeff);
+	copyToDevice(rows0, mRows0);
+	copyToDevice(rows1, mRows1);
+	copyToDevice(states, mStates);
+
+	if (mPinnedStates != nullptr)
+		cudaFreeHost(mPinnedStates);
+	mPinnedStates = nullptr;
+	if (!states.empty() && cudaMallocHost((void**)&mPinnedStates, states.size() * sizeof(double)) != cudaSuccess)
+		throw SolverException();
+	mCopyPending = false;
+}
+
+template <int NumPhases>
+cuda::CompanionModelArrays GpuCompanionModels<NumPhases>::arrays() const {
+	const std::size_t values = mComps.size() * NumPhases;
+	return {
+		static_cast<int>(mComps.size()),
+		mEquivCond.data(), mVoltageCoeff.data(), mCurrentCoeff.data(),
+		mRows0.data(), mRows1.data(),
+		mStates.data(), mStates.data() + values, mStates.data() + 2 * values
+	};
+}
+
+template <int NumPhases>
+void GpuCompanionModels<NumPhases>::preSolve(double* rightSide, const int* permutation, cudaStream_t stream) {
+	cuda::companionModelPreStep<NumPhases>(arrays(), rightSide, permutation, stream);
+	mStream = stream;
+	mCopyPending = false;
+}
+
+template <int NumPhases>
+void GpuCompanionModels<NumPhases>::postSolve(const double* leftSide, Bool copyBack, cudaStream_t stream) {
+	cuda::companionModelPostStep<NumPhases>(arrays(), leftSide, stream);
+	mStream = stream;
+	if (!copyBack || mPinnedStates == nullptr)
+		return;
+
+	if (cudaMemcpyAsync(mPinnedStates, mStates.data(), 3 * mComps.size() * NumPhases * sizeof(double), cudaMemcpyDeviceToHost, stream) != cudaSuccess)
+		throw SolverException();
+	mCopyPending = true;
+}
+
+template <int NumPhases>
+void GpuCompanionModels<NumPhases>::download() {
+	if (mPinnedStates == nullptr)
+		return;
+
+	const std::size_t n = mComps.size();
+	const std::size_t values = n * NumPhases;
+	if (cudaStreamSynchronize(mStream) != cudaSuccess)
+		throw SolverException();
+	if (!mCopyPending && cudaMemcpy(mPinnedStates, mStates.data(), 3 * values * sizeof(double), cudaMemcpyDeviceToHost) != cudaSuccess)
+		throw SolverException();
+	mCopyPending = false;
+
+	for (std::size_t k = 0; k < n; ++k) {
+		for (int a = 0; a < NumPhases; ++a) {
+			(*mIntfVoltage[k])(a, 0) = mPinnedStates[a * n + k];
+			(*mIntfCurrent[k])(a, 0) = mPinnedStates[values + a * n + k];
+			mEquivCurrent[k][a] = mPinnedStates[2 * values + a * n + k];
+		}
+	}
+}
+
+template class DPsim::GpuCompanionModels<1>;
+template class DPsim::GpuCompanionModels<3>;
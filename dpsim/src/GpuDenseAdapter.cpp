@@ -7,6 +7,7 @@
  *********************************************************************************/
 
 #include <dpsim/GpuDenseAdapter.h>
+#include <algorithm>
 
 using namespace DPsim;
 
@@ -20,12 +21,21 @@ namespace DPsim
         if(mStream)
             cudaStreamDestroy(mStream);
 
+        destroySolveGraph();
+        if(mPinnedVector)
+            cudaFreeHost(mPinnedVector);
+        if(mPinnedErrInfo)
+            cudaFreeHost(mPinnedErrInfo);
+
         //Memory allocated on device
         cudaFree(mDeviceCopy.matrix);
         cudaFree(mDeviceCopy.vector);
         cudaFree(mDeviceCopy.workSpace);
         cudaFree(mDeviceCopy.pivSeq);
         cudaFree(mDeviceCopy.errInfo);
+        cudaFree(mDeviceCopy.lowPrecisionMatrix);
+        cudaFree(mDeviceCopy.lowPrecisionVector);
+        cudaFree(mDeviceCopy.lowPrecisionWorkSpace);
 
         cudaDeviceReset();
     }
@@ -49,6 +59,7 @@ namespace DPsim
         //Allocate memory for...
         //Vector
         CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.vector, mDeviceCopy.size * sizeof(Real)))
+        mDeviceCopy.vectorCols = 1;
         //Matrix
         CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.matrix, mDeviceCopy.size * mDeviceCopy.size * sizeof(Real)))
         //Pivoting-Sequence
@@ -72,12 +83,85 @@ namespace DPsim
         CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.workSpace, workSpaceSize))
     }
 
-    void GpuDenseAdapter::copySystemMatrixToDevice(Matrix systemMatrix)
+    void GpuDenseAdapter::allocateLowPrecisionMemory()
+    {
+        CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.lowPrecisionVector, mDeviceCopy.size * sizeof(float)))
+        mDeviceCopy.lowPrecisionVectorCols = 1;
+        CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.lowPrecisionMatrix, mDeviceCopy.size * mDeviceCopy.size * sizeof(float)))
+
+        int workSpaceSize = 0;
+        cusolverStatus_t status = CUSOLVER_STATUS_SUCCESS;
+        if((status =
+            cusolverDnSgetrf_bufferSize(
+            mCusolverHandle,
+            mDeviceCopy.size,
+            mDeviceCopy.size,
+            mDeviceCopy.lowPrecisionMatrix,
+            mDeviceCopy.size,
+            &workSpaceSize)
+            ) != CUSOLVER_STATUS_SUCCESS)
+            std::cerr << "cusolverDnSgetrf_bufferSize() failed (calculating required space for LU-factorization)" << std::endl;
+        CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.lowPrecisionWorkSpace, workSpaceSize * sizeof(float)))
+    }
+
+    void GpuDenseAdapter::copySystemMatrixToDevice(const Matrix& systemMatrix)
     {
         auto *data = systemMatrix.data();
         CUDA_ERROR_HANDLER(cudaMemcpy(mDeviceCopy.matrix, data, mDeviceCopy.size * mDeviceCopy.size * sizeof(Real), cudaMemcpyHostToDevice))
     }
 
+    void GpuDenseAdapter::reserveRightHandSides(UInt nrhs)
+    {
+        if (nrhs > mDeviceCopy.vectorCols) {
+            cudaFree(mDeviceCopy.vector);
+            CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.vector, mDeviceCopy.size * nrhs * sizeof(Real)))
+            mDeviceCopy.vectorCols = nrhs;
+            destroySolveGraph();
+        }
+        if (mConfiguration.getGpuTransferMethod() != GPU_TRANSFER_METHOD::SYNCHRONOUS && nrhs > mPinnedCols) {
+            if (mPinnedVector)
+                cudaFreeHost(mPinnedVector);
+            CUDA_ERROR_HANDLER(cudaMallocHost((void**)&mPinnedVector, mDeviceCopy.size * nrhs * sizeof(Real)))
+            if (!mPinnedErrInfo)
+                CUDA_ERROR_HANDLER(cudaMallocHost((void**)&mPinnedErrInfo, sizeof(int)))
+            mPinnedCols = nrhs;
+            destroySolveGraph();
+        }
+    }
+
+    void GpuDenseAdapter::enqueueSolve(UInt nrhs)
+    {
+        CUDA_ERROR_HANDLER(cudaMemcpyAsync(mDeviceCopy.vector, mPinnedVector, mDeviceCopy.size * nrhs * sizeof(Real), cudaMemcpyHostToDevice, mStream))
+
+        cusolverStatus_t status = cusolverDnDgetrs(
+            mCusolverHandle,
+            CUBLAS_OP_N,
+            mDeviceCopy.size,
+            nrhs,
+            mDeviceCopy.matrix,
+            mDeviceCopy.size,
+            mDeviceCopy.pivSeq,
+            mDeviceCopy.vector,
+            mDeviceCopy.size,
+            mDeviceCopy.errInfo);
+        if(status != CUSOLVER_STATUS_SUCCESS)
+            std::cerr << "cusolverDnDgetrs() failed (Solving A*x = b)" << std::endl;
+
+        CUDA_ERROR_HANDLER(cudaMemcpyAsync(mPinnedVector, mDeviceCopy.vector, mDeviceCopy.size * nrhs * sizeof(Real), cudaMemcpyDeviceToHost, mStream))
+        CUDA_ERROR_HANDLER(cudaMemcpyAsync(mPinnedErrInfo, mDeviceCopy.errInfo, sizeof(int), cudaMemcpyDeviceToHost, mStream))
+    }
+
+    void GpuDenseAdapter::destroySolveGraph()
+    {
+        if(mSolveGraphExec)
+            cudaGraphExecDestroy(mSolveGraphExec);
+        if(mSolveGraph)
+            cudaGraphDestroy(mSolveGraph);
+        mSolveGraphExec = nullptr;
+        mSolveGraph = nullptr;
+        mSolveGraphCols = 0;
+    }
+
     void GpuDenseAdapter::LUfactorization()
     {
          //Variables for error-handling
@@ -106,14 +190,99 @@ namespace DPsim
         }
     }
 
+    void GpuDenseAdapter::LUfactorizationLowPrecision()
+    {
+        Eigen::MatrixXf lowPrecisionMatrix = mHostSystemMatrix.cast<float>();
+        CUDA_ERROR_HANDLER(cudaMemcpy(mDeviceCopy.lowPrecisionMatrix, lowPrecisionMatrix.data(), mDeviceCopy.size * mDeviceCopy.size * sizeof(float), cudaMemcpyHostToDevice))
+
+        int info;
+        cusolverStatus_t status = cusolverDnSgetrf(
+            mCusolverHandle,
+            mDeviceCopy.size,
+            mDeviceCopy.size,
+            mDeviceCopy.lowPrecisionMatrix,
+            mDeviceCopy.size,
+            mDeviceCopy.lowPrecisionWorkSpace,
+            mDeviceCopy.pivSeq,
+            mDeviceCopy.errInfo);
+
+        CUDA_ERROR_HANDLER(cudaDeviceSynchronize())
+
+        if(status != CUSOLVER_STATUS_SUCCESS) {
+            std::cerr << "cusolverDnSgetrf() failed (calculating LU-factorization)" << std::endl;
+        }
+        CUDA_ERROR_HANDLER(cudaMemcpy(&info, mDeviceCopy.errInfo, sizeof(int), cudaMemcpyDeviceToHost))
+        if(0 > info) {
+            std::cerr << -info << "-th parameter is wrong" << std::endl;
+        }
+    }
+
+    Matrix GpuDenseAdapter::solveLowPrecision(const Matrix& rightSideVector)
+    {
+        UInt nrhs = static_cast<UInt>(rightSideVector.cols());
+        if (nrhs > mDeviceCopy.lowPrecisionVectorCols) {
+            cudaFree(mDeviceCopy.lowPrecisionVector);
+            CUDA_ERROR_HANDLER(cudaMalloc((void**)&mDeviceCopy.lowPrecisionVector, mDeviceCopy.size * nrhs * sizeof(float)))
+            mDeviceCopy.lowPrecisionVectorCols = nrhs;
+        }
+
+        Eigen::MatrixXf vector = rightSideVector.cast<float>();
+        CUDA_ERROR_HANDLER(cudaMemcpy(mDeviceCopy.lowPrecisionVector, vector.data(), mDeviceCopy.size * nrhs * sizeof(float), cudaMemcpyHostToDevice))
+
+        cusolverStatus_t status = cusolverDnSgetrs(
+            mCusolverHandle,
+            CUBLAS_OP_N,
+            mDeviceCopy.size,
+            nrhs,
+            mDeviceCopy.lowPrecisionMatrix,
+            mDeviceCopy.size,
+            mDeviceCopy.pivSeq,
+            mDeviceCopy.lowPrecisionVector,
+            mDeviceCopy.size,
+            mDeviceCopy.errInfo);
+
+        CUDA_ERROR_HANDLER(cudaDeviceSynchronize())
+
+        if(status != CUSOLVER_STATUS_SUCCESS)
+            std::cerr << "cusolverDnSgetrs() failed (Solving A*x = b)" << std::endl;
+
+        CUDA_ERROR_HANDLER(cudaMemcpy(vector.data(), mDeviceCopy.lowPrecisionVector, mDeviceCopy.size * nrhs * sizeof(float), cudaMemcpyDeviceToHost))
+        return vector.cast<Real>();
+    }
+
+    void GpuDenseAdapter::applyConfiguration()
+    {
+        mMixedPrecision = mConfiguration.getFactorizationPrecision() == FACTORIZATION_PRECISION::MIXED;
+        SPDLOG_LOGGER_INFO(mSLog, "GPU dense LU " + mConfiguration.getFactorizationPrecisionString());
+    }
+
+    void GpuDenseAdapter::compute(SparseMatrix& systemMatrix)
+    {
+        mHostSystemMatrix = systemMatrix;
+        if (mMixedPrecision) {
+            // The double precision factorization is only computed on a fallback
+            mSystemMatrix = systemMatrix;
+            LUfactorizationLowPrecision();
+            mUseDoubleFactorization = false;
+        } else {
+            //Copy Systemmatrix to device
+            copySystemMatrixToDevice(mHostSystemMatrix);
+            //LU factorization
+            LUfactorization();
+        }
+    }
+
     void GpuDenseAdapter::preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
     {
         mDeviceCopy.size = systemMatrix.rows();
 
         //Allocate Memory on Device
         allocateDeviceMemory();
+        if (mMixedPrecision)
+            allocateLowPrecisionMemory();
         //Copy Systemmatrix to device
-        copySystemMatrixToDevice(Matrix(systemMatrix));
+        mHostSystemMatrix = systemMatrix;
+        copySystemMatrixToDevice(mHostSystemMatrix);
 
         // Debug logging, whether LU-factorization and copying was successfull
         /*DPsim::Matrix mat;
@@ -125,45 +294,81 @@ namespace DPsim
 
     void GpuDenseAdapter::factorize(SparseMatrix& systemMatrix)
     {
-        //Copy Systemmatrix to device
-        copySystemMatrixToDevice(Matrix(systemMatrix));
-        //LU factorization
-        LUfactorization();
-        /*CUDA_ERROR_HANDLER(cudaMemcpy(buffer, mDeviceCopy.matrix, mDeviceCopy.size * mDeviceCopy.size * sizeof(Real), cudaMemcpyDeviceToHost))
-        this->SPDLOG_LOGGER_INFO(mSLog, "LU decomposition Gpu: \n{}", mat);*/
+        compute(systemMatrix);
     }
 
     void GpuDenseAdapter::refactorize(SparseMatrix& systemMatrix)
     {
-        //Copy Systemmatrix to device
-        copySystemMatrixToDevice(Matrix(systemMatrix));
-        //LU factorization
-        LUfactorization();
-        /*CUDA_ERROR_HANDLER(cudaMemcpy(buffer, mDeviceCopy.matrix, mDeviceCopy.size * mDeviceCopy.size * sizeof(Real), cudaMemcpyDeviceToHost))
-        this->SPDLOG_LOGGER_INFO(mSLog, "LU decomposition Gpu: \n{}", mat);*/
+        compute(systemMatrix);
     }
 
     void GpuDenseAdapter::partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
     {
-        //Copy Systemmatrix to device
-        copySystemMatrixToDevice(Matrix(systemMatrix));
-        //LU factorization
-        LUfactorization();
-        /*CUDA_ERROR_HANDLER(cudaMemcpy(buffer, mDeviceCopy.matrix, mDeviceCopy.size * mDeviceCopy.size * sizeof(Real), cudaMemcpyDeviceToHost))
-        this->SPDLOG_LOGGER_INFO(mSLog, "LU decomposition Gpu: \n{}", mat);*/
+        compute(systemMatrix);
     }
 
     Matrix GpuDenseAdapter::solve(Matrix& mRightHandSideVector)
     {
-        Matrix leftSideVector = mRightHandSideVector;
+        Matrix leftSideVector(mRightHandSideVector.rows(), mRightHandSideVector.cols());
+        solveInPlace(mRightHandSideVector, leftSideVector);
+        return leftSideVector;
+    }
 
-        CUDA_ERROR_HANDLER(cudaMemcpy(mDeviceCopy.vector, &mRightHandSideVector(0), mDeviceCopy.size * sizeof(Real), cudaMemcpyHostToDevice))
+    void GpuDenseAdapter::solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector)
+    {
+        if (mMixedPrecision && !mUseDoubleFactorization) {
+            leftSideVector = solveLowPrecision(rightSideVector);
+            auto correctionSolve = [this](const Matrix& residual) { return solveLowPrecision(residual); };
+            if (refineSolution(mSystemMatrix, rightSideVector, leftSideVector, correctionSolve))
+                return;
+
+            SPDLOG_LOGGER_WARN(mSLog, "Mixed precision refinement did not converge, falling back to a double precision factorization");
+            copySystemMatrixToDevice(mHostSystemMatrix);
+            LUfactorization();
+            mUseDoubleFactorization = true;
+        }
+
+        // no-op if the dimensions already match
+        leftSideVector.resize(rightSideVector.rows(), rightSideVector.cols());
+
+        // multiple right hand sides are solved in one call
+        UInt nrhs = static_cast<UInt>(rightSideVector.cols());
+        reserveRightHandSides(nrhs);
+
+        auto transferMethod = mConfiguration.getGpuTransferMethod();
+        if (transferMethod != GPU_TRANSFER_METHOD::SYNCHRONOUS) {
+            // stage through pinned memory and only wait for the solver stream
+            std::copy(rightSideVector.data(), rightSideVector.data() + mDeviceCopy.size * nrhs, mPinnedVector);
+
+            if (transferMethod == GPU_TRANSFER_METHOD::PINNED_ASYNC_GRAPH) {
+                if (!mSolveGraphExec || mSolveGraphCols != nrhs) {
+                    destroySolveGraph();
+                    CUDA_ERROR_HANDLER(cudaStreamBeginCapture(mStream, cudaStreamCaptureModeThreadLocal))
+                    enqueueSolve(nrhs);
+                    CUDA_ERROR_HANDLER(cudaStreamEndCapture(mStream, &mSolveGraph))
+                    CUDA_ERROR_HANDLER(cudaGraphInstantiateWithFlags(&mSolveGraphExec, mSolveGraph, 0))
+                    mSolveGraphCols = nrhs;
+                }
+                CUDA_ERROR_HANDLER(cudaGraphLaunch(mSolveGraphExec, mStream))
+            } else {
+                enqueueSolve(nrhs);
+            }
+            CUDA_ERROR_HANDLER(cudaStreamSynchronize(mStream))
+
+            if(0 > *mPinnedErrInfo) {
+                std::cerr << -*mPinnedErrInfo << "-th parameter is wrong" << std::endl;
+            }
+            std::copy(mPinnedVector, mPinnedVector + mDeviceCopy.size * nrhs, leftSideVector.data());
+            return;
+        }
+
+        CUDA_ERROR_HANDLER(cudaMemcpy(mDeviceCopy.vector, rightSideVector.data(), mDeviceCopy.size * nrhs * sizeof(Real), cudaMemcpyHostToDevice))
 
         cusolverStatus_t status = cusolverDnDgetrs(
             mCusolverHandle,
             CUBLAS_OP_N,
             mDeviceCopy.size,
-            1, /* nrhs */
+            nrhs,
             mDeviceCopy.matrix,
             mDeviceCopy.size,
             mDeviceCopy.pivSeq,
@@ -181,9 +386,6 @@ namespace DPsim
             std::cerr << -info << "-th parameter is wrong" << std::endl;
         }
 
-        CUDA_ERROR_HANDLER(cudaMemcpy(&(leftSideVector)(0), mDeviceCopy.vector, mDeviceCopy.size * sizeof(Real), cudaMemcpyDeviceToHost))
-        //return LUFactorizedSparse.solve(mRightHandSideVector);
-
-        return leftSideVector;
+        CUDA_ERROR_HANDLER(cudaMemcpy(leftSideVector.data(), mDeviceCopy.vector, mDeviceCopy.size * nrhs * sizeof(Real), cudaMemcpyDeviceToHost))
     }
 }
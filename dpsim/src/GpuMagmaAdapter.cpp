@@ -70,6 +70,7 @@ namespace DPsim
         // apply permutation
         //std::cout << "Before System Matrix:" << std::endl << hMat[0] << std::endl;
         hMat = *mTransp * hMat;
+        mPermutedRhsVec = Matrix::Zero(size, 1);
         //std::cout << "permutation:" << std::endl << mTransp->toDenseMatrix() << std::endl;
         //std::cout << "inverse permutation:" << std::endl << mTransp->inverse().toDenseMatrix() << std::endl;
         //std::cout << "System Matrix:" << std::endl << hMat[0] << std::endl;
@@ -135,14 +136,23 @@ namespace DPsim
 
     Matrix GpuMagmaAdapter::solve(Matrix& mRightHandSideVector)
     {
-        Matrix leftSideVector = mRightHandSideVector;
-        int size = mRightHandSideVector.rows();
+        Matrix leftSideVector(mRightHandSideVector.rows(), mRightHandSideVector.cols());
+        solveInPlace(mRightHandSideVector, leftSideVector);
+        return leftSideVector;
+    }
+
+    void GpuMagmaAdapter::solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector)
+    {
+        int size = rightSideVector.rows();
         int one = 0;
 
-        mRightHandSideVector = *mTransp * mRightHandSideVector;
+        // no-op if the dimensions already match
+        leftSideVector.resize(rightSideVector.rows(), rightSideVector.cols());
+
+        mPermutedRhsVec = *mTransp * rightSideVector;
 
         //Copy right vector to device
-        magma_dvset(size, 1, mRightHandSideVector.data(), &mHostRhsVec, mMagmaQueue);
+        magma_dvset(size, 1, mPermutedRhsVec.data(), &mHostRhsVec, mMagmaQueue);
         magma_dmtransfer(mHostRhsVec, &mDevRhsVec, Magma_CPU, Magma_DEV, mMagmaQueue);
         magma_dvinit(&mDevLhsVec, Magma_DEV, mHostRhsVec.num_rows, mHostRhsVec.num_cols, 0.0, mMagmaQueue);
 
@@ -152,7 +162,5 @@ namespace DPsim
         //Copy Solution back
         magma_dmtransfer(mDevLhsVec, &mHostLhsVec, Magma_DEV, Magma_CPU, mMagmaQueue);
         magma_dvcopy(mDevLhsVec, &size, &one, leftSideVector.data(), mMagmaQueue);
-
-        return leftSideVector;
     }
 }
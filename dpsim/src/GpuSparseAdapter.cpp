@@ -7,6 +7,7 @@
  *********************************************************************************/
 
 #include <dpsim/GpuSparseAdapter.h>
+#include <algorithm>
 
 using namespace DPsim;
 
@@ -20,15 +21,26 @@ namespace DPsim
     GpuSparseAdapter::~GpuSparseAdapter()
     {
         if (mCusparsehandle != nullptr) {
+            cusparseDestroyMatDescr(descr_M);
             cusparseDestroyMatDescr(descr_L);
             cusparseDestroyMatDescr(descr_U);
-            cusparseDestroyCsrsv2Info(info_L);
-            cusparseDestroyCsrsv2Info(info_U);
+            if (info_M != nullptr)
+                cusparseDestroyCsrilu02Info(info_M);
+            if (info_L != nullptr)
+                cusparseDestroyCsrsv2Info(info_L);
+            if (info_U != nullptr)
+                cusparseDestroyCsrsv2Info(info_U);
             cusparseDestroy(mCusparsehandle);
         }
         if (mCusolverhandle != nullptr) {
             cusolverSpDestroy(mCusolverhandle);
         }
+        if (mPinnedRhsVec != nullptr)
+            cudaFreeHost(mPinnedRhsVec);
+        if (mPinnedLhsVec != nullptr)
+            cudaFreeHost(mPinnedLhsVec);
+        if (mStream != nullptr)
+            cudaStreamDestroy(mStream);
     }
 
     inline void GpuSparseAdapter::checkCusparseStatus(cusparseStatus_t status, std::string additionalInfo)
@@ -40,8 +52,11 @@ namespace DPsim
 	    }
     }
 
-    void GpuSparseAdapter::performFactorization(SparseMatrix& systemMatrix)
+    void GpuSparseAdapter::createHandles()
     {
+        if (mCusparsehandle != nullptr)
+            return;
+
         cusparseStatus_t csp_status;
         cusolverStatus_t cso_status;
         csp_status = cusparseCreate(&mCusparsehandle);
@@ -53,28 +68,17 @@ namespace DPsim
             throw SolverException();
         }
 
-        size_t N = systemMatrix.rows();
-        auto hMat = systemMatrix;
-
-        mGpuRhsVec = cuda::Vector<double>(N);
-        mGpuLhsVec = cuda::Vector<double>(N);
-        mGpuIntermediateVec = cuda::Vector<double>(N);
-
-        cusparseMatDescr_t descr_M = 0;
-        csrilu02Info_t info_M  = 0;
-        int structural_zero;
-        int numerical_zero;
-
-        size_t nnz = hMat.nonZeros();
+        if (mConfiguration.getGpuTransferMethod() != GPU_TRANSFER_METHOD::SYNCHRONOUS) {
+            // Solves only wait for their own stream instead of the whole device
+            if (mStream == nullptr && cudaStreamCreateWithFlags(&mStream, cudaStreamNonBlocking) != cudaSuccess)
+                throw SolverException();
+            checkCusparseStatus(cusparseSetStream(mCusparsehandle, mStream), "failed to set stream:");
+        }
 
-        // step 1: create a descriptor which contains
-        // - matrix M is base-1
-        // - matrix L is base-1
-        // - matrix L is lower triangular
-        // - matrix L has unit diagonal
-        // - matrix U is base-1
-        // - matrix U is upper triangular
-        // - matrix U has non-unit diagonal
+        // Descriptors of the matrices, which do not depend on the system matrix
+        // - matrix M is base-0
+        // - matrix L is base-0, lower triangular with unit diagonal
+        // - matrix U is base-0, upper triangular with non-unit diagonal
         checkCusparseStatus(cusparseCreateMatDescr(&descr_M));
         checkCusparseStatus(cusparseSetMatIndexBase(descr_M, CUSPARSE_INDEX_BASE_ZERO));
         checkCusparseStatus(cusparseSetMatType(descr_M, CUSPARSE_MATRIX_TYPE_GENERAL));
@@ -90,23 +94,75 @@ namespace DPsim
         checkCusparseStatus(cusparseSetMatType(descr_U, CUSPARSE_MATRIX_TYPE_GENERAL));
         checkCusparseStatus(cusparseSetMatFillMode(descr_U, CUSPARSE_FILL_MODE_UPPER));
         checkCusparseStatus(cusparseSetMatDiagType(descr_U, CUSPARSE_DIAG_TYPE_NON_UNIT));
+    }
+
+    void GpuSparseAdapter::allocateVectors(size_t N)
+    {
+        if (N == mDim)
+            return;
+        mDim = N;
+
+        mGpuRhsVec = cuda::Vector<double>(N);
+        mGpuLhsVec = cuda::Vector<double>(N);
+        mGpuIntermediateVec = cuda::Vector<double>(N);
+        mPermutedRhsVec = Matrix::Zero(N, 1);
+
+        if (mStream != nullptr) {
+            if (mPinnedRhsVec != nullptr)
+                cudaFreeHost(mPinnedRhsVec);
+            if (mPinnedLhsVec != nullptr)
+                cudaFreeHost(mPinnedLhsVec);
+            if (cudaMallocHost((void**)&mPinnedRhsVec, N * sizeof(Real)) != cudaSuccess
+                || cudaMallocHost((void**)&mPinnedLhsVec, N * sizeof(Real)) != cudaSuccess)
+                throw SolverException();
+        }
+    }
+
+    Bool GpuSparseAdapter::hasSamePattern(const SparseMatrix& systemMatrix) const
+    {
+        if (!mSysMat || static_cast<size_t>(systemMatrix.rows()) != mDim
+            || static_cast<size_t>(systemMatrix.nonZeros()) != mValueMap.size())
+            return false;
+        return std::equal(mRowPtr.begin(), mRowPtr.end(), systemMatrix.outerIndexPtr())
+            && std::equal(mColInd.begin(), mColInd.end(), systemMatrix.innerIndexPtr());
+    }
+
+    void GpuSparseAdapter::performFactorization(SparseMatrix& systemMatrix)
+    {
+        cusparseStatus_t csp_status;
+        cusolverStatus_t cso_status;
+        createHandles();
+
+        size_t N = systemMatrix.rows();
+        auto hMat = systemMatrix;
+        hMat.makeCompressed();
+        allocateVectors(N);
 
-        // step 2: create a empty info structure
+        int structural_zero;
+        size_t nnz = hMat.nonZeros();
+
+        // step 2: create empty info structures, the ones of a previous pattern are dropped
         // we need one info for csrilu02 and two info's for csrsv2
+        if (info_M != nullptr)
+            cusparseDestroyCsrilu02Info(info_M);
+        if (info_L != nullptr)
+            cusparseDestroyCsrsv2Info(info_L);
+        if (info_U != nullptr)
+            cusparseDestroyCsrsv2Info(info_U);
         checkCusparseStatus(cusparseCreateCsrilu02Info(&info_M));
         checkCusparseStatus(cusparseCreateCsrsv2Info(&info_L));
         checkCusparseStatus(cusparseCreateCsrsv2Info(&info_U));
 
         // step 2a: permutate Matrix M' = P*M
         int p_nnz = 0;
-        int p[N];
+        std::vector<int> p(N);
 
         cso_status = cusolverSpDcsrzfdHost(
             mCusolverhandle, N,nnz, descr_M,
             hMat.valuePtr(),
             hMat.outerIndexPtr(),
             hMat.innerIndexPtr(),
-            p, &p_nnz);
+            p.data(), &p_nnz);
 
         if (cso_status != CUSOLVER_STATUS_SUCCESS) {
             //SPDLOG_LOGGER_ERROR(mSLog, "cusolverSpDcsrzfdHost returend an error");
@@ -114,7 +170,23 @@ namespace DPsim
         // create Eigen::PermutationMatrix from the p
         mTransp = std::unique_ptr<Eigen::PermutationMatrix<Eigen::Dynamic> >(
                 new Eigen::PermutationMatrix<Eigen::Dynamic>(
-                Eigen::Map< Eigen::Matrix<int, Eigen::Dynamic, 1> >(p, N, 1)));
+                Eigen::Map< Eigen::Matrix<int, Eigen::Dynamic, 1> >(p.data(), N, 1)));
+        mGpuPermutation = cuda::Vector<int>(N);
+        if (cudaMemcpy(mGpuPermutation.data(), mTransp->indices().data(), N * sizeof(int), cudaMemcpyHostToDevice) != cudaSuccess)
+            throw SolverException();
+
+        // Positions of the values in the permuted matrix, so that refactorizations
+        // of the same pattern only permute and copy the values
+        SparseMatrix positions = hMat;
+        for (size_t k = 0; k < nnz; ++k)
+            positions.valuePtr()[k] = static_cast<Real>(k);
+        positions = *mTransp * positions;
+        mValueMap.resize(nnz);
+        for (size_t k = 0; k < nnz; ++k)
+            mValueMap[k] = static_cast<int>(positions.valuePtr()[k]);
+        mRowPtr.assign(hMat.outerIndexPtr(), hMat.outerIndexPtr() + N + 1);
+        mColInd.assign(hMat.innerIndexPtr(), hMat.innerIndexPtr() + nnz);
+        mPermutedValues.resize(nnz);
 
         // apply permutation
         hMat = *mTransp * hMat;
@@ -145,9 +217,12 @@ namespace DPsim
                                                 d_csrColInd, info_U, &pBufferSize_U);
         checkCusparseStatus(csp_status, "failed to get cusparse bufferSize:");
 
-        // Buffer
+        // Buffer, only grown
         pBufferSize = std::max({pBufferSize_M, pBufferSize_L, pBufferSize_U});
-        pBuffer = cuda::Vector<char>(pBufferSize);
+        if (static_cast<size_t>(pBufferSize) > mBufferSize) {
+            pBuffer = cuda::Vector<char>(pBufferSize);
+            mBufferSize = pBufferSize;
+        }
         // step 4: perform analysis of incomplete Cholesky on M
         //         perform analysis of triangular solve on L
         //         perform analysis of triangular solve on U
@@ -180,26 +255,46 @@ namespace DPsim
         checkCusparseStatus(csp_status, "failed to analyse cusparse problem:");
 
         // step 5: M = L * U
+        if (!factorizeOnDevice())
+            throw SolverException();
+    }
+
+    Bool GpuSparseAdapter::factorizeOnDevice()
+    {
+        cusparseStatus_t csp_status;
+        int numerical_zero;
 
-        csp_status = cusparseDcsrilu02(mCusparsehandle, N, nnz, descr_M, d_csrVal,
-                                    d_csrRowPtr, d_csrColInd, info_M, CUSPARSE_SOLVE_POLICY_NO_LEVEL,
+        csp_status = cusparseDcsrilu02(mCusparsehandle, mDim, mSysMat->non_zero, descr_M, mSysMat->val.data(),
+                                    mSysMat->row.data(), mSysMat->col.data(), info_M, CUSPARSE_SOLVE_POLICY_NO_LEVEL,
                                     pBuffer.data());
         checkCusparseStatus(csp_status, "failed to perform cusparse ILU:");
 
         csp_status = cusparseXcsrilu02_zeroPivot(mCusparsehandle, info_M, &numerical_zero);
         if (csp_status == CUSPARSE_STATUS_ZERO_PIVOT){
             //SPDLOG_LOGGER_ERROR(mSLog, "U({},{}) is zero\n", numerical_zero, numerical_zero);
-            checkCusparseStatus(csp_status);
             std::cout << "csp_status zero pivot" << std::endl;
-            throw SolverException();
+            return false;
+        }
+        return true;
+    }
+
+    void GpuSparseAdapter::performRefactorization(SparseMatrix& systemMatrix)
+    {
+        // The analysis only depends on the pattern, so only the values are copied to the device
+        if (!hasSamePattern(systemMatrix)) {
+            performFactorization(systemMatrix);
+            return;
         }
 
-        //std::cout << *mSysMat.get() << std::endl;
+        const Real* values = systemMatrix.valuePtr();
+        for (size_t k = 0; k < mValueMap.size(); ++k)
+            mPermutedValues[k] = values[mValueMap[k]];
+        if (cudaMemcpy(mSysMat->val.data(), mPermutedValues.data(), mPermutedValues.size() * sizeof(Real), cudaMemcpyHostToDevice) != cudaSuccess)
+            throw SolverException();
 
-        csp_status = cusparseDestroyCsrilu02Info(info_M);
-        checkCusparseStatus(csp_status, "failed to destroy info:");
-        csp_status = cusparseDestroyMatDescr(descr_M);
-        checkCusparseStatus(csp_status, "failed to destroy MatDescr:");
+        // The permutation to a zero-free diagonal may not fit the new values
+        if (!factorizeOnDevice())
+            performFactorization(systemMatrix);
     }
 
     void GpuSparseAdapter::preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
@@ -214,31 +309,55 @@ namespace DPsim
 
     void GpuSparseAdapter::refactorize(SparseMatrix& systemMatrix)
     {
-        performFactorization(systemMatrix);
+        performRefactorization(systemMatrix);
     }
 
     void GpuSparseAdapter::partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
     {
-        performFactorization(systemMatrix);
+        performRefactorization(systemMatrix);
     }
 
     Matrix GpuSparseAdapter::solve(Matrix& mRightHandSideVector)
     {
-        Matrix leftSideVector = mRightHandSideVector;
+        Matrix leftSideVector(mRightHandSideVector.rows(), mRightHandSideVector.cols());
+        solveInPlace(mRightHandSideVector, leftSideVector);
+        return leftSideVector;
+    }
+
+    void GpuSparseAdapter::solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector)
+    {
+        solveWithDeviceSteps(rightSideVector, leftSideVector, {}, false);
+    }
+
+    void GpuSparseAdapter::solveWithDeviceSteps(const Matrix& rightSideVector, Matrix& leftSideVector,
+        const std::vector<DeviceStep*>& steps, Bool copyBack)
+    {
         cudaError_t status;
         cusparseStatus_t csp_status;
-        int size = mRightHandSideVector.rows();
+        int size = rightSideVector.rows();
+
+        // no-op if the dimensions already match
+        leftSideVector.resize(rightSideVector.rows(), rightSideVector.cols());
 
         //Copy right vector to device
         //Permutate right side: R' = P * R
-        mRightHandSideVector = *mTransp * mRightHandSideVector;
-        status = cudaMemcpy(mGpuRhsVec.data(), &mRightHandSideVector(0), size * sizeof(Real), cudaMemcpyHostToDevice);
+        Bool pinned = mPinnedRhsVec != nullptr;
+        if (pinned) {
+            Eigen::Map<Matrix>(mPinnedRhsVec, size, 1) = *mTransp * rightSideVector;
+            status = cudaMemcpyAsync(mGpuRhsVec.data(), mPinnedRhsVec, size * sizeof(Real), cudaMemcpyHostToDevice, mStream);
+        } else {
+            mPermutedRhsVec = *mTransp * rightSideVector;
+            status = cudaMemcpy(mGpuRhsVec.data(), mPermutedRhsVec.data(), size * sizeof(Real), cudaMemcpyHostToDevice);
+        }
         if (status != cudaSuccess) {
             //SPDLOG_LOGGER_ERROR(mSLog, "Cuda Error: {}", cudaGetErrorString(status));
             std::cout << "status not cudasuccess" << std::endl;
             throw SolverException();
         }
 
+        for (auto step : steps)
+            step->preSolve(mGpuRhsVec.data(), mGpuPermutation.data(), mStream);
+
         const double alpha = 1.;
         // Solve
         // step 6: solve L*z = x
@@ -259,13 +378,23 @@ namespace DPsim
                                         pBuffer.data());
         checkCusparseStatus(csp_status, "failed to solve U*y=z:");
 
+        for (auto step : steps)
+            step->postSolve(mGpuLhsVec.data(), copyBack, mStream);
+
         //Copy Solution back
-        status = cudaMemcpy(&(leftSideVector)(0), mGpuLhsVec.data(), size * sizeof(Real), cudaMemcpyDeviceToHost);
+        if (pinned) {
+            status = cudaMemcpyAsync(mPinnedLhsVec, mGpuLhsVec.data(), size * sizeof(Real), cudaMemcpyDeviceToHost, mStream);
+            if (status == cudaSuccess)
+                status = cudaStreamSynchronize(mStream);
+            if (status == cudaSuccess)
+                std::copy(mPinnedLhsVec, mPinnedLhsVec + size, leftSideVector.data());
+        } else {
+            status = cudaMemcpy(leftSideVector.data(), mGpuLhsVec.data(), size * sizeof(Real), cudaMemcpyDeviceToHost);
+        }
         if (status != cudaSuccess) {
             //SPDLOG_LOGGER_ERROR(mSLog, "Cuda Error: {}", cudaGetErrorString(status));
             std::cout << "status not cudasuccess" << std::endl;
             throw SolverException();
         }
-        return leftSideVector;
     }
 }
@@ -0,0 +1,118 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/HDF5LoggerBackend.h>
+
+#include <algorithm>
+
+using namespace CPS;
+using namespace DPsim;
+
+HDF5LoggerBackend::HDF5LoggerBackend(UInt chunkRows) :
+	mChunkRows(chunkRows) {
+	if (mChunkRows == 0)
+		throw SystemError("HDF5 logger requires a chunk size of at least one row.");
+}
+
+HDF5LoggerBackend::~HDF5LoggerBackend() {
+	close();
+}
+
+Bool HDF5LoggerBackend::open(const fs::path& filename) {
+	close();
+	mFile = H5Fcreate(filename.string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+	return mFile >= 0;
+}
+
+void HDF5LoggerBackend::close() {
+	if (mFile < 0)
+		return;
+
+	flush();
+	for (auto dataset : mDatasets)
+		H5Dclose(dataset);
+	mDatasets.clear();
+	H5Fclose(mFile);
+	mFile = H5I_INVALID_HID;
+	mWrittenRows = 0;
+}
+
+void HDF5LoggerBackend::setColumns(const std::vector<String>& names, Notation notation) {
+	if (mFile < 0)
+		return;
+
+	std::vector<String> columns = { "time" };
+	columns.insert(columns.end(), names.begin(), names.end());
+
+	hsize_t dims = 0, maxDims = H5S_UNLIMITED, chunk = mChunkRows;
+	hid_t space = H5Screate_simple(1, &dims, &maxDims);
+	hid_t properties = H5Pcreate(H5P_DATASET_CREATE);
+	H5Pset_chunk(properties, 1, &chunk);
+	for (auto column : columns) {
+		// Slashes would create groups
+		std::replace(column.begin(), column.end(), '/', '_');
+		hid_t dataset = H5Dcreate2(mFile, column.c_str(), H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, properties, H5P_DEFAULT);
+		if (dataset < 0) {
+			H5Pclose(properties);
+			H5Sclose(space);
+			throw SystemError("Cannot create HDF5 dataset " + column);
+		}
+		mDatasets.push_back(dataset);
+	}
+	H5Pclose(properties);
+	H5Sclose(space);
+
+	// Store the column order, which is lost in the alphabetical order of the datasets
+	String joined;
+	for (auto& column : columns)
+		joined += (joined.empty() ? "" : ",") + column;
+	hid_t type = H5Tcopy(H5T_C_S1);
+	H5Tset_size(type, joined.size() + 1);
+	hid_t scalar = H5Screate(H5S_SCALAR);
+	hid_t attribute = H5Acreate2(mFile, "columns", type, scalar, H5P_DEFAULT, H5P_DEFAULT);
+	H5Awrite(attribute, type, joined.c_str());
+	H5Aclose(attribute);
+	H5Sclose(scalar);
+	H5Tclose(type);
+
+	mBuffer.assign(mDatasets.size() * mChunkRows, 0);
+	mBufferedRows = 0;
+}
+
+void HDF5LoggerBackend::writeRow(Real time, const Real* values, UInt count) {
+	if (mDatasets.empty())
+		return;
+
+	UInt columns = std::min<UInt>(count, static_cast<UInt>(mDatasets.size()) - 1);
+	mBuffer[mBufferedRows] = time;
+	for (UInt i = 0; i < columns; ++i)
+		mBuffer[(i + 1) * mChunkRows + mBufferedRows] = values[i];
+
+	if (++mBufferedRows == mChunkRows)
+		flush();
+}
+
+void HDF5LoggerBackend::flush() {
+	if (mBufferedRows == 0)
+		return;
+
+	hsize_t rows = mBufferedRows;
+	hsize_t size = mWrittenRows + rows;
+	hid_t memSpace = H5Screate_simple(1, &rows, nullptr);
+	for (std::size_t i = 0; i < mDatasets.size(); ++i) {
+		H5Dset_extent(mDatasets[i], &size);
+		hid_t fileSpace = H5Dget_space(mDatasets[i]);
+		H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &mWrittenRows, nullptr, &rows, nullptr);
+		H5Dwrite(mDatasets[i], H5T_NATIVE_DOUBLE, memSpace, fileSpace, H5P_DEFAULT, &mBuffer[i * mChunkRows]);
+		H5Sclose(fileSpace);
+	}
+	H5Sclose(memSpace);
+
+	mWrittenRows = size;
+	mBufferedRows = 0;
+}
@@ -0,0 +1,77 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/Histogram.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace CPS;
+using namespace DPsim;
+
+void Histogram::reset() {
+	for (auto& bucket : mCounts)
+		bucket.store(0, std::memory_order_relaxed);
+	mSum.store(0, std::memory_order_relaxed);
+	mMin.store(std::numeric_limits<Real>::infinity(), std::memory_order_relaxed);
+	mMax.store(0, std::memory_order_relaxed);
+	mCount.store(0, std::memory_order_release);
+}
+
+uint64_t Histogram::bucketUpperBound(UInt index) {
+	if (index < 2 * SubBuckets)
+		return index;
+	UInt shift = (index - 2 * SubBuckets) / SubBuckets + 1;
+	uint64_t sub = (index - 2 * SubBuckets) % SubBuckets + SubBuckets;
+	return ((sub + 1) << shift) - 1;
+}
+
+Real Histogram::mean() const {
+	auto num = count();
+	return num > 0 ? sum() / static_cast<Real>(num) : 0;
+}
+
+Real Histogram::min() const {
+	return count() > 0 ? mMin.load(std::memory_order_relaxed) : 0;
+}
+
+Real Histogram::max() const {
+	return count() > 0 ? mMax.load(std::memory_order_relaxed) : 0;
+}
+
+Real Histogram::percentile(Real percent) const {
+	auto num = count();
+	if (num == 0)
+		return 0;
+
+	percent = std::clamp(percent, 0., 100.);
+	uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(percent / 100. * static_cast<Real>(num) + 0.5));
+	uint64_t seen = 0;
+	for (UInt i = 0; i < Buckets; i++) {
+		seen += mCounts[i].load(std::memory_order_relaxed);
+		if (seen >= rank)
+			return std::min(static_cast<Real>(bucketUpperBound(i)) * 1e-9, max());
+	}
+	return max();
+}
+
+std::vector<std::pair<Real, uint64_t>> Histogram::buckets() const {
+	std::vector<std::pair<Real, uint64_t>> result;
+	for (UInt i = 0; i < Buckets; i++) {
+		auto num = mCounts[i].load(std::memory_order_relaxed);
+		if (num > 0)
+			result.emplace_back(static_cast<Real>(bucketUpperBound(i)) * 1e-9, num);
+	}
+	return result;
+}
+
+void Histogram::log(CPS::Logger::Log log, const String& title) const {
+	SPDLOG_LOGGER_INFO(log, "{}: count {:d}, mean {:.9f}, min {:.9f}, max {:.9f}", title, count(), mean(), min(), max());
+	SPDLOG_LOGGER_INFO(log, "{}: p50 {:.9f}, p90 {:.9f}, p99 {:.9f}, p99.9 {:.9f}", title,
+		percentile(50), percentile(90), percentile(99), percentile(99.9));
+}
@@ -2,6 +2,13 @@
 
 #include <dpsim/Interface.h>
 #include <dpsim/InterfaceWorker.h>
+#ifdef HAVE_EPOLL
+#include <dpsim/InterfaceGroup.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
 
 using namespace CPS;
 
@@ -11,24 +18,80 @@ namespace DPsim {
         mInterfaceWorker->open();
         mOpened = true;
 
+        if (!mRecordFile.empty()) {
+            std::vector<CPS::AttributeBase::Ptr> imports;
+            for (const auto& [attr, _seqId, _blockOnRead, _syncOnStart] : mImportAttrsDpsim)
+                imports.push_back(attr);
+            mRecorder = std::make_shared<InterfaceRecorder>(mRecordFile, imports);
+        }
+
+        if (!mExportAttrsDpsim.empty()) {
+            std::vector<CPS::AttributeBase::Ptr> exports;
+            for (const auto& [attr, _seqId] : mExportAttrsDpsim)
+                exports.push_back(attr);
+            //The simulation thread writes every slot itself, so one slot is enough
+            mExportRing = std::make_shared<ExportRing>(exports, mSynchronous ? 1 : 64, mExportDeadbands);
+        }
+
+        mImportHistory.assign(mImportAttrsDpsim.size(), {});
+        for (auto& history : mImportHistory)
+            history.reserve(mExtrapolationOrder + 1);
+
+        mExportsFiltered = false;
+        for (UInt i = 0; i < mExportRates.size(); i++) {
+            if (mExportRates[i] != mDownsampling || mExportDeadbands[i] > 0 || mExportOnChange[i])
+                mExportsFiltered = true;
+        }
+
+        if (mSynchronous)
+            return;
+
+#ifdef HAVE_EPOLL
+        if (mGroup) {
+            mGroup->memberOpened();
+            return;
+        }
+#endif
+
         if (!mImportAttrsDpsim.empty()) {
-            mInterfaceReaderThread = std::thread(Interface::ReaderThread(mQueueInterfaceToDpsim, mInterfaceWorker, mOpened));
+            Interface::ReaderThread reader(mQueueInterfaceToDpsim, mInterfaceWorker, mOpened);
+            mInterfaceReaderThread = mExecutor ? mExecutor->spawn(-1, reader) : std::thread(reader);
         }
         if (!mExportAttrsDpsim.empty()) {
-            mInterfaceWriterThread = std::thread(Interface::WriterThread(mQueueDpsimToInterface, mInterfaceWorker));
+            Interface::WriterThread writer(mExportRing, mInterfaceWorker, mInterfaceWorker->writesEverySlot());
+            mInterfaceWriterThread = mExecutor ? mExecutor->spawn(-1, writer) : std::thread(writer);
         }
     }
 
     void Interface::close() {
 	    mOpened = false;
-        mQueueDpsimToInterface->emplace(AttributePacket {
-            nullptr,
-            0,
-            0,
-            AttributePacketFlags::PACKET_CLOSE_INTERFACE
-        });
+
+        if (mExtrapolatedImports > 0 && mLog)
+            SPDLOG_LOGGER_INFO(mLog, "Extrapolated {} imports which missed the deadline", mExtrapolatedImports);
+
+        if (mRecorder) {
+            if (mLog)
+                SPDLOG_LOGGER_INFO(mLog, "Recorded {} imports to {}", mRecorder->records(), mRecordFile);
+            mRecorder->close();
+            mRecorder = nullptr;
+        }
+
+        if (mSynchronous) {
+            mInterfaceWorker->close();
+            return;
+        }
+
+#ifdef HAVE_EPOLL
+        if (mGroup) {
+            //The group threads are stopped before the first worker of the group is closed
+            mGroup->memberClosed();
+            mInterfaceWorker->close();
+            return;
+        }
+#endif
 
         if (!mExportAttrsDpsim.empty()) {
+            mExportRing->pushClose();
             mInterfaceWriterThread.join();
         }
 
@@ -50,31 +113,111 @@ namespace DPsim {
     }
 
     void Interface::PreStep::execute(Real time, Int timeStepCount) {
-        if (timeStepCount % mIntf.mDownsampling == 0)
+        mIntf.mImportStep = timeStepCount;
+        if (!mIntf.mImportsSuspended && mIntf.importsDue(timeStepCount))
             mIntf.popDpsimAttrsFromQueue();
     }
 
     void Interface::PostStep::execute(Real time, Int timeStepCount) {
-        if (timeStepCount % mIntf.mDownsampling == 0)
-            mIntf.pushDpsimAttrsToQueue();
+        if (!mIntf.mExportsSuspended && mIntf.exportsDue(timeStepCount))
+            mIntf.pushDpsimAttrsToQueue(time, true);
+    }
+
+    bool Interface::importsDue(Int timeStepCount) {
+        bool any = false;
+        for (UInt i = 0; i < mImportRates.size(); i++) {
+            mImportDue[i] = timeStepCount % mImportRates[i] == 0;
+            any = any || mImportDue[i];
+        }
+        return any;
+    }
+
+    bool Interface::exportsDue(Int timeStepCount) {
+        if (!mExportsFiltered)
+            return timeStepCount % mDownsampling == 0;
+
+        bool any = false;
+        for (UInt i = 0; i < mExportRates.size(); i++) {
+            mExportDue[i] = timeStepCount % mExportRates[i] == 0;
+            if (mExportDue[i] && mExportOnChange[i]) {
+                //Unchanged attributes keep their last sent value
+                std::size_t version = std::get<0>(mExportAttrsDpsim[i])->version();
+                mExportDue[i] = version != mExportVersions[i];
+                mExportVersions[i] = version;
+            }
+            any = any || mExportDue[i];
+        }
+        return any;
+    }
+
+    bool Interface::waitsForImport(UInt attributeId, bool isSync) const {
+        const auto &[_attr, _seqId, blockOnRead, syncOnStart] = mImportAttrsDpsim[attributeId];
+        if (isSync) {
+            return syncOnStart;
+        } else {
+            return blockOnRead && mImportDue[attributeId];
+        }
     }
 
-    void Interface::addImport(CPS::AttributeBase::Ptr attr, bool blockOnRead, bool syncOnSimulationStart) {
+    void Interface::addImport(CPS::AttributeBase::Ptr attr, bool blockOnRead, bool syncOnSimulationStart, UInt downsampling) {
         if (mOpened) {
             SPDLOG_LOGGER_ERROR(mLog, "Cannot modify interface configuration after simulation start!");
             std::exit(1);
         }
 
         mImportAttrsDpsim.emplace_back(attr, 0, blockOnRead, syncOnSimulationStart);
+        mImportRates.push_back(downsampling > 0 ? downsampling : mDownsampling);
+        mImportDue.push_back(true);
     }
 
-    void Interface::addExport(CPS::AttributeBase::Ptr attr) {
+    void Interface::addExport(CPS::AttributeBase::Ptr attr, UInt downsampling, Real deadband, Bool onChange) {
         if (mOpened) {
             SPDLOG_LOGGER_ERROR(mLog, "Cannot modify interface configuration after simulation start!");
             std::exit(1);
         }
 
         mExportAttrsDpsim.emplace_back(attr, 0);
+        mExportRates.push_back(downsampling > 0 ? downsampling : mDownsampling);
+        mExportDeadbands.push_back(deadband);
+        mExportOnChange.push_back(onChange);
+        //The first due step always sends the export
+        mExportVersions.push_back(std::numeric_limits<std::size_t>::max());
+        mExportDue.push_back(true);
+    }
+
+    void Interface::setSynchronous(Bool value) {
+        if (mOpened) {
+            SPDLOG_LOGGER_ERROR(mLog, "Cannot modify interface configuration after simulation start!");
+            std::exit(1);
+        }
+
+        mSynchronous = value;
+    }
+
+    void Interface::setImportDeadline(Real deadline, UInt order) {
+        if (mOpened) {
+            SPDLOG_LOGGER_ERROR(mLog, "Cannot modify interface configuration after simulation start!");
+            std::exit(1);
+        }
+
+        mImportDeadline = deadline;
+        mExtrapolationOrder = order;
+    }
+
+    void Interface::recordImports(const String& filename) {
+        if (mOpened) {
+            SPDLOG_LOGGER_ERROR(mLog, "Cannot modify interface configuration after simulation start!");
+            std::exit(1);
+        }
+
+        mRecordFile = filename;
+    }
+
+    std::size_t Interface::memoryBytes() const {
+        std::size_t bytes = mQueueInterfaceToDpsim->size_approx() * sizeof(AttributePacket);
+        if (mExportRing)
+            bytes += mExportRing->memoryBytes();
+        return bytes;
     }
 
     void Interface::setLogger(CPS::Logger::Log log) {
@@ -104,79 +247,147 @@ namespace DPsim {
         };
         UInt currentSequenceId = mNextSequenceInterfaceToDpsim;
 
+        //Look for all attributes that have not been updated in the current while loop (i. e. whose sequence ID is lower than the next expected sequence ID)
+        auto pending = [this, currentSequenceId, isSync]() {
+            for (UInt i = 0; i < mImportAttrsDpsim.size(); i++) {
+                if (waitsForImport(i, isSync) && std::get<1>(mImportAttrsDpsim[i]) < currentSequenceId)
+                    return true;
+            }
+            return false;
+        };
+
+        //The deadline does not apply to the synchronization on simulation start
+        bool deadline = mImportDeadline > 0 && !isSync;
+        auto due = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<Real>(mImportDeadline));
+
+        if (mSynchronous) {
+            //Poll the interface on the simulation thread, repeating only while a blocking attribute is outdated
+            do {
+                mInterfaceWorker->readValuesFromEnv(mImportPackets);
+                for (const auto &packet : mImportPackets)
+                    applyImportPacket(packet);
+                mImportPackets.clear();
+                if (deadline && pending() && std::chrono::steady_clock::now() >= due) {
+                    extrapolateImports(currentSequenceId);
+                    return;
+                }
+            } while (pending());
+            return;
+        }
+
         //Wait for and dequeue all attributes that read should block on
-        //The std::find_if will look for all attributes that have not been updated in the current while loop (i. e. whose sequence ID is lower than the next expected sequence ID)
-        while (std::find_if(
-                mImportAttrsDpsim.cbegin(),
-                mImportAttrsDpsim.cend(),
-                [currentSequenceId, isSync](auto attrTuple) {
-                    auto &[_attr, seqId, blockOnRead, syncOnStart] = attrTuple;
-                    if (isSync) {
-                        return syncOnStart && seqId < currentSequenceId;
-                    } else {
-                        return blockOnRead && seqId < currentSequenceId;
-                    }
-                }) != mImportAttrsDpsim.cend()) {
-            mQueueInterfaceToDpsim->wait_dequeue(receivedPacket);
-            if (!std::get<0>(mImportAttrsDpsim[receivedPacket.attributeId])->copyValue(receivedPacket.value)) {
-                SPDLOG_LOGGER_WARN(mLog, "Failed to copy received value onto attribute in Interface!");
+        while (pending()) {
+            if (!deadline) {
+                mQueueInterfaceToDpsim->wait_dequeue(receivedPacket);
+            } else if (!mQueueInterfaceToDpsim->wait_dequeue_timed(receivedPacket, std::max<std::int64_t>(0,
+                    std::chrono::duration_cast<std::chrono::microseconds>(due - std::chrono::steady_clock::now()).count()))) {
+                //Late updates stay in the queue and are applied in the next step
+                extrapolateImports(currentSequenceId);
+                break;
             }
-            std::get<1>(mImportAttrsDpsim[receivedPacket.attributeId]) = receivedPacket.sequenceId;
-            mNextSequenceInterfaceToDpsim = receivedPacket.sequenceId + 1;
+            applyImportPacket(receivedPacket);
         }
 
         //Fetch all remaining queue packets
         while (mQueueInterfaceToDpsim->try_dequeue(receivedPacket)) {
-            if (!std::get<0>(mImportAttrsDpsim[receivedPacket.attributeId])->copyValue(receivedPacket.value)) {
-                SPDLOG_LOGGER_WARN(mLog, "Failed to copy received value onto attribute in Interface!");
+            applyImportPacket(receivedPacket);
+        }
+    }
+
+    void Interface::applyImportPacket(const AttributePacket& packet) {
+        if (!std::get<0>(mImportAttrsDpsim[packet.attributeId])->copyValue(packet.value)) {
+            SPDLOG_LOGGER_WARN(mLog, "Failed to copy received value onto attribute in Interface!");
+        }
+        std::get<1>(mImportAttrsDpsim[packet.attributeId]) = packet.sequenceId;
+        mNextSequenceInterfaceToDpsim = packet.sequenceId + 1;
+        if (mRecorder)
+            mRecorder->record(mImportStep, packet.attributeId, packet.sequenceId, packet.value);
+
+        if (mImportDeadline > 0) {
+            //Keep the values of the last updates, several updates in one step keep the newest
+            auto& attr = std::get<0>(mImportAttrsDpsim[packet.attributeId]);
+            Complex value;
+            if (attr->getType() == typeid(Real))
+                value = static_cast<Attribute<Real>*>(attr.get())->get();
+            else if (attr->getType() == typeid(Complex))
+                value = static_cast<Attribute<Complex>*>(attr.get())->get();
+            else
+                return;
+
+            auto& history = mImportHistory[packet.attributeId];
+            if (!history.empty() && history.back().first == mImportStep)
+                history.back().second = value;
+            else {
+                if (history.size() > mExtrapolationOrder)
+                    history.erase(history.begin());
+                history.emplace_back(mImportStep, value);
+            }
+        }
+    }
+
+    void Interface::extrapolateImports(UInt currentSequenceId) {
+        for (UInt i = 0; i < mImportAttrsDpsim.size(); i++) {
+            if (!waitsForImport(i, false) || std::get<1>(mImportAttrsDpsim[i]) >= currentSequenceId)
+                continue;
+            mExtrapolatedImports++;
+
+            //Lagrange polynomial through the last updates, evaluated at the current step
+            auto& history = mImportHistory[i];
+            if (history.size() < 2)
+                continue;
+            Complex value = 0;
+            for (std::size_t k = 0; k < history.size(); k++) {
+                Real weight = 1;
+                for (std::size_t l = 0; l < history.size(); l++) {
+                    if (l != k)
+                        weight *= Real(mImportStep - history[l].first) / Real(history[k].first - history[l].first);
+                }
+                value += weight * history[k].second;
             }
-            std::get<1>(mImportAttrsDpsim[receivedPacket.attributeId]) = receivedPacket.sequenceId;
-            mNextSequenceInterfaceToDpsim = receivedPacket.sequenceId + 1;
+
+            auto& attr = std::get<0>(mImportAttrsDpsim[i]);
+            if (attr->getType() == typeid(Real))
+                static_cast<Attribute<Real>*>(attr.get())->set(value.real());
+            else
+                static_cast<Attribute<Complex>*>(attr.get())->set(value);
         }
     }
 
-    void Interface::pushDpsimAttrsToQueue() {
-        for (UInt i = 0; i < mExportAttrsDpsim.size(); i++) {
-            mQueueDpsimToInterface->emplace(AttributePacket {
-                std::get<0>(mExportAttrsDpsim[i])->cloneValueOntoNewAttribute(),
-                i,
-                std::get<1>(mExportAttrsDpsim[i]),
-                AttributePacketFlags::PACKET_NO_FLAGS
-            });
-            std::get<1>(mExportAttrsDpsim[i]) = mCurrentSequenceDpsimToInterface;
-            mCurrentSequenceDpsimToInterface++;
+    void Interface::pushDpsimAttrsToQueue(Real time, bool onlyDue) {
+        if (!mExportRing)
+            return;
+
+        //Snapshot all exports into one preallocated slot without allocating
+        //Exports which are not due or stay within their deadband keep their last sent value
+        if (!mExportRing->push(mCurrentSequenceDpsimToInterface, time, onlyDue && mExportsFiltered ? &mExportDue : nullptr))
+            return;
+        if (mSynchronous) {
+            //Write the slot right away instead of handing it to the writer thread
+            bool closed = false;
+            const ExportRing::Slot* slot = mExportRing->acquire(closed);
+            mInterfaceWorker->writeSlotToEnv(*mExportRing, *slot);
+            mExportRing->release();
         }
+#ifdef HAVE_EPOLL
+        else if (mGroup) {
+            mGroup->notifyExports();
+        }
+#endif
+        for (auto& exportAttr : mExportAttrsDpsim)
+            std::get<1>(exportAttr) = mCurrentSequenceDpsimToInterface;
+        mCurrentSequenceDpsimToInterface++;
     }
 
     void Interface::WriterThread::operator() () const {
         bool interfaceClosed = false;
-        std::vector<Interface::AttributePacket> attrsToWrite;
         while (!interfaceClosed) {
-            AttributePacket nextPacket = {
-                nullptr,
-                0,
-                0,
-                AttributePacketFlags::PACKET_NO_FLAGS
-            };
-
-            //Wait for at least one packet
-            mQueueDpsimToInterface->wait_dequeue(nextPacket);
-            if (nextPacket.flags & AttributePacketFlags::PACKET_CLOSE_INTERFACE) {
-                interfaceClosed = true;
-            } else {
-                attrsToWrite.push_back(nextPacket);
-            }
-
-            //See if there are more packets
-            while(mQueueDpsimToInterface->try_dequeue(nextPacket)) {
-                if (nextPacket.flags & AttributePacketFlags::PACKET_CLOSE_INTERFACE) {
-                    interfaceClosed = true;
-                } else {
-                    attrsToWrite.push_back(nextPacket);
-                }
-            }
-            mInterfaceWorker->writeValuesToEnv(attrsToWrite);
+            //Wait for at least one slot, only the newest one is written unless the worker needs every slot
+            const ExportRing::Slot* slot = mExportRing->acquire(interfaceClosed, !mEverySlot);
+            if (slot != nullptr)
+                mInterfaceWorker->writeSlotToEnv(*mExportRing, *slot);
         }
+        mExportRing->release();
     }
 
     void Interface::ReaderThread::operator() () const {
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/InterfaceGroup.h>
+#include <dpsim/InterfaceWorker.h>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+using namespace CPS;
+
+namespace DPsim {
+
+    InterfaceGroup::~InterfaceGroup() {
+        stop();
+        for (auto& intf : mInterfaces)
+            intf->mGroup = nullptr;
+    }
+
+    void InterfaceGroup::addInterface(Interface::Ptr intf) {
+        if (intf->mOpened || mRunning)
+            throw SystemError("Cannot add interface " + intf->name() + " to a group after simulation start");
+        if (intf->mSynchronous)
+            throw SystemError("Synchronous interface " + intf->name() + " cannot be part of an interface group");
+        if (intf->mGroup)
+            throw SystemError("Interface " + intf->name() + " is already part of an interface group");
+
+        intf->mGroup = this;
+        mInterfaces.push_back(intf);
+    }
+
+    void InterfaceGroup::memberOpened() {
+        if (++mOpenedMembers < mInterfaces.size())
+            return;
+
+        mEpoll = ::epoll_create1(0);
+        if (mEpoll < 0)
+            throw SystemError("Cannot create epoll instance: " + String(std::strerror(errno)));
+
+        for (UInt i = 0; i < mInterfaces.size(); i++) {
+            if (mInterfaces[i]->mImportAttrsDpsim.empty())
+                continue;
+            auto fds = mInterfaces[i]->mInterfaceWorker->pollFds();
+            if (fds.empty())
+                throw SystemError("Worker of interface " + mInterfaces[i]->name() + " has no poll file descriptors");
+            for (int fd : fds) {
+                epoll_event event;
+                std::memset(&event, 0, sizeof(event));
+                event.events = EPOLLIN;
+                event.data.u32 = i;
+                if (::epoll_ctl(mEpoll, EPOLL_CTL_ADD, fd, &event) < 0)
+                    throw SystemError("Cannot add poll file descriptor of interface " + mInterfaces[i]->name() + ": " + std::strerror(errno));
+            }
+        }
+
+        mRunning = true;
+        auto executor = mInterfaces.front()->mExecutor;
+        if (executor) {
+            mReaderThread = executor->spawn(-1, [this]() { readerLoop(); });
+            mWriterThread = executor->spawn(-1, [this]() { writerLoop(); });
+        } else {
+            mReaderThread = std::thread(&InterfaceGroup::readerLoop, this);
+            mWriterThread = std::thread(&InterfaceGroup::writerLoop, this);
+        }
+    }
+
+    void InterfaceGroup::memberClosed() {
+        stop();
+        if (mOpenedMembers > 0)
+            mOpenedMembers--;
+    }
+
+    void InterfaceGroup::stop() {
+        if (!mRunning)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(mExportMutex);
+            mRunning = false;
+        }
+        mExportCondition.notify_one();
+        mReaderThread.join();
+        mWriterThread.join();
+        ::close(mEpoll);
+        mEpoll = -1;
+    }
+
+    void InterfaceGroup::notifyExports() {
+        {
+            std::lock_guard<std::mutex> lock(mExportMutex);
+            mExportsPending = true;
+        }
+        mExportCondition.notify_one();
+    }
+
+    void InterfaceGroup::readerLoop() {
+        std::vector<epoll_event> events(mInterfaces.size() > 0 ? 4 * mInterfaces.size() : 1);
+        std::vector<Interface::AttributePacket> attrsRead;
+        std::vector<bool> ready(mInterfaces.size());
+        while (mRunning) {
+            //Wake up regularly to notice when the group is stopped
+            int count = ::epoll_wait(mEpoll, events.data(), static_cast<int>(events.size()), 1);
+            if (count < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw SystemError("Failed to wait for interface imports: " + String(std::strerror(errno)));
+            }
+
+            //An interface with several ready descriptors is read once
+            std::fill(ready.begin(), ready.end(), false);
+            for (int e = 0; e < count; e++)
+                ready[events[e].data.u32] = true;
+
+            for (UInt i = 0; i < mInterfaces.size(); i++) {
+                if (!ready[i])
+                    continue;
+                auto& intf = mInterfaces[i];
+                intf->mInterfaceWorker->readValuesFromEnv(attrsRead);
+                for (const auto& packet : attrsRead)
+                    intf->mQueueInterfaceToDpsim->enqueue(packet);
+                attrsRead.clear();
+            }
+        }
+    }
+
+    void InterfaceGroup::writerLoop() {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mExportMutex);
+                mExportCondition.wait(lock, [this]() { return mExportsPending || !mRunning; });
+                if (!mRunning)
+                    break;
+                mExportsPending = false;
+            }
+
+            for (auto& intf : mInterfaces) {
+                if (!intf->mExportRing)
+                    continue;
+                auto& worker = intf->mInterfaceWorker;
+                bool everySlot = worker->writesEverySlot();
+                bool closed = false;
+                while (const ExportRing::Slot* slot = intf->mExportRing->tryAcquire(closed, !everySlot)) {
+                    worker->writeSlotToEnv(*intf->mExportRing, *slot);
+                    if (!everySlot)
+                        break;
+                }
+                intf->mExportRing->release();
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/InterfaceRecorder.h>
+
+#include <algorithm>
+
+using namespace CPS;
+using namespace DPsim;
+
+constexpr char InterfaceRecorder::Magic[8];
+constexpr uint32_t InterfaceRecorder::Version;
+
+InterfaceRecorder::InterfaceRecorder(const String& filename, const std::vector<AttributeBase::Ptr>& imports) :
+	mFile(filename, std::ios::binary | std::ios::trunc) {
+	if (!mFile.good())
+		throw SystemError("Cannot open interface recording " + filename);
+
+	std::size_t maxSize = 0;
+	for (auto& attr : imports) {
+		std::size_t size = attr->serializedSize();
+		if (size == 0)
+			throw SystemError("Interface recording supports only imports with a fixed serialized size");
+		mSizes.push_back(size);
+		maxSize = std::max(maxSize, size);
+	}
+	mBuffer.resize(maxSize);
+
+	uint32_t count = static_cast<uint32_t>(mSizes.size());
+	mFile.write(Magic, sizeof(Magic));
+	mFile.write(reinterpret_cast<const char*>(&Version), sizeof(Version));
+	mFile.write(reinterpret_cast<const char*>(&count), sizeof(count));
+	mFile.write(reinterpret_cast<const char*>(mSizes.data()), mSizes.size() * sizeof(uint64_t));
+}
+
+void InterfaceRecorder::record(Int step, UInt attributeId, UInt sequenceId, const AttributeBase::Ptr& value) {
+	if (!mFile.is_open() || attributeId >= mSizes.size())
+		return;
+	// Values whose size changed can not be replayed and are skipped
+	if (!value->serializeTo(mBuffer.data(), mSizes[attributeId]))
+		return;
+
+	int32_t header[3] = {
+		static_cast<int32_t>(step),
+		static_cast<int32_t>(attributeId),
+		static_cast<int32_t>(sequenceId)
+	};
+	mFile.write(reinterpret_cast<const char*>(header), sizeof(header));
+	mFile.write(reinterpret_cast<const char*>(mBuffer.data()), mSizes[attributeId]);
+	mRecords++;
+}
+
+void InterfaceRecorder::close() {
+	if (mFile.is_open())
+		mFile.close();
+}
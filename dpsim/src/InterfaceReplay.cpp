@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/InterfaceReplay.h>
+#include <dpsim/InterfaceWorkerReplay.h>
+
+namespace DPsim {
+
+    InterfaceReplay::InterfaceReplay(const String& filename, Real realTimeStep, const String& name, UInt downsampling)
+        : Interface(InterfaceWorkerReplay::make(filename, realTimeStep), name, downsampling) { }
+
+    void InterfaceReplay::importAttribute(CPS::AttributeBase::Ptr attr, Bool blockOnRead, Bool syncOnSimulationStart, UInt downsampling) {
+        Interface::addImport(attr, blockOnRead, syncOnSimulationStart, downsampling);
+        std::static_pointer_cast<InterfaceWorkerReplay>(mInterfaceWorker)->configureImport((UInt)mImportAttrsDpsim.size() - 1, attr);
+    }
+
+    void InterfaceReplay::exportAttribute(CPS::AttributeBase::Ptr attr, UInt downsampling) {
+        Interface::addExport(attr, downsampling);
+    }
+
+    void InterfaceReplay::popDpsimAttrsFromQueue(bool isSync) {
+        //The worker passes on the records up to the step of the imports
+        std::static_pointer_cast<InterfaceWorkerReplay>(mInterfaceWorker)->setStep(mImportStep);
+        Interface::popDpsimAttrsFromQueue(isSync);
+    }
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/InterfaceUdp.h>
+#include <dpsim/InterfaceWorkerUdp.h>
+
+namespace DPsim {
+
+    InterfaceUdp::InterfaceUdp(const String& localAddress, UInt localPort, const String& remoteAddress, UInt remotePort,
+        const String& name, UInt downsampling)
+        : Interface(InterfaceWorkerUdp::make(localAddress, localPort, remoteAddress, remotePort), name, downsampling) { }
+
+    void InterfaceUdp::importAttribute(CPS::AttributeBase::Ptr attr, Bool blockOnRead, Bool syncOnSimulationStart, UInt downsampling) {
+        Interface::addImport(attr, blockOnRead, syncOnSimulationStart, downsampling);
+        std::static_pointer_cast<InterfaceWorkerUdp>(mInterfaceWorker)->configureImport((UInt)mImportAttrsDpsim.size() - 1, attr);
+    }
+
+    void InterfaceUdp::exportAttribute(CPS::AttributeBase::Ptr attr, UInt downsampling, Real deadband, Bool onChange) {
+        Interface::addExport(attr, downsampling, deadband, onChange);
+    }
+
+    void InterfaceUdp::setBusyPoll(UInt microseconds) {
+        std::static_pointer_cast<InterfaceWorkerUdp>(mInterfaceWorker)->setBusyPoll(microseconds);
+    }
+
+    void InterfaceUdp::setSendBatch(UInt frames) {
+        std::static_pointer_cast<InterfaceWorkerUdp>(mInterfaceWorker)->setSendBatch(frames);
+    }
+}
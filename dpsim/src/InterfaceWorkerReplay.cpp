@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/InterfaceWorkerReplay.h>
+#include <dpsim/InterfaceRecorder.h>
+
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+using namespace CPS;
+using namespace DPsim;
+
+void InterfaceWorkerReplay::configureImport(UInt attributeId, AttributeBase::Ptr attr) {
+	if (mPrototypes.size() <= attributeId)
+		mPrototypes.resize(attributeId + 1);
+	mPrototypes[attributeId] = attr;
+}
+
+void InterfaceWorkerReplay::open() {
+	std::ifstream file(mFilename, std::ios::binary);
+	if (!file.good())
+		throw SystemError("Cannot open interface recording " + mFilename);
+
+	char magic[sizeof(InterfaceRecorder::Magic)];
+	uint32_t version = 0;
+	uint32_t count = 0;
+	file.read(magic, sizeof(magic));
+	file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	file.read(reinterpret_cast<char*>(&count), sizeof(count));
+	if (!file.good() || std::memcmp(magic, InterfaceRecorder::Magic, sizeof(magic)) != 0 || version != InterfaceRecorder::Version)
+		throw SystemError("Invalid interface recording " + mFilename);
+	if (count != mPrototypes.size())
+		throw SystemError("Interface recording " + mFilename + " has " + std::to_string(count) +
+			" imports, the interface has " + std::to_string(mPrototypes.size()));
+
+	mSizes.resize(count);
+	file.read(reinterpret_cast<char*>(mSizes.data()), count * sizeof(uint64_t));
+	for (UInt i = 0; i < count; i++) {
+		if (!mPrototypes[i].getPtr() || mPrototypes[i]->serializedSize() != mSizes[i])
+			throw SystemError("Import " + std::to_string(i) + " does not match the interface recording " + mFilename);
+	}
+
+	mRecords.clear();
+	mData.clear();
+	int32_t header[3];
+	while (file.read(reinterpret_cast<char*>(header), sizeof(header))) {
+		UInt attributeId = static_cast<UInt>(header[1]);
+		if (attributeId >= count)
+			throw SystemError("Invalid record in interface recording " + mFilename);
+		std::size_t offset = mData.size();
+		mData.resize(offset + mSizes[attributeId]);
+		if (!file.read(reinterpret_cast<char*>(&mData[offset]), mSizes[attributeId]))
+			break;
+		mRecords.push_back({ header[0], attributeId, static_cast<UInt>(header[2]), offset });
+	}
+
+	mNext = 0;
+	mStarted = false;
+	mOpened = true;
+	if (mLog)
+		SPDLOG_LOGGER_INFO(mLog, "Loaded {} records from interface recording {}", mRecords.size(), mFilename);
+}
+
+void InterfaceWorkerReplay::close() {
+	mOpened = false;
+}
+
+void InterfaceWorkerReplay::readValuesFromEnv(std::vector<Interface::AttributePacket>& updatedAttrs) {
+	if (mNext == mRecords.size()) {
+		// Avoid spinning the reader thread once the recording is exhausted
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		return;
+	}
+
+	Int lastStep;
+	if (mRealTimeStep > 0) {
+		auto now = std::chrono::steady_clock::now();
+		if (!mStarted) {
+			mStart = now;
+			mStarted = true;
+		}
+		auto due = [this](Int step) {
+			return mStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+				std::chrono::duration<Real>(step * mRealTimeStep));
+		};
+		Int nextStep = mRecords[mNext].step;
+		if (due(nextStep) > now) {
+			std::this_thread::sleep_until(std::min(due(nextStep), now + std::chrono::milliseconds(1)));
+			return;
+		}
+		lastStep = static_cast<Int>((now - mStart) / std::chrono::duration<Real>(mRealTimeStep));
+	} else {
+		lastStep = mStep.load(std::memory_order_acquire);
+		if (mRecords[mNext].step > lastStep) {
+			std::this_thread::yield();
+			return;
+		}
+	}
+
+	for (; mNext < mRecords.size() && mRecords[mNext].step <= lastStep; mNext++) {
+		const Record& record = mRecords[mNext];
+		auto value = mPrototypes[record.attributeId]->cloneValueOntoNewAttribute();
+		value->deserializeFrom(&mData[record.offset], mSizes[record.attributeId]);
+		updatedAttrs.push_back(Interface::AttributePacket {
+			value,
+			record.attributeId,
+			record.sequenceId,
+			Interface::AttributePacketFlags::PACKET_NO_FLAGS
+		});
+	}
+}
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/InterfaceWorkerUdp.h>
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+using namespace CPS;
+using namespace DPsim;
+
+namespace {
+	/// Number of doubles taken by the frame header
+	constexpr std::size_t HeaderDoubles = sizeof(InterfaceWorkerUdp::FrameHeader) / sizeof(double);
+	static_assert(sizeof(InterfaceWorkerUdp::FrameHeader) % sizeof(double) == 0, "Frame header is not aligned to the values");
+
+	sockaddr_in socketAddress(const String& address, UInt port) {
+		sockaddr_in addr;
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(static_cast<uint16_t>(port));
+		if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1)
+			throw SystemError("Invalid IPv4 address " + address);
+		return addr;
+	}
+}
+
+InterfaceWorkerUdp::InterfaceWorkerUdp(const String& localAddress, UInt localPort, const String& remoteAddress, UInt remotePort) :
+	mLocalAddress(localAddress),
+	mLocalPort(localPort),
+	mRemoteAddress(remoteAddress),
+	mRemotePort(remotePort) { }
+
+void InterfaceWorkerUdp::configureImport(UInt attributeId, AttributeBase::Ptr attr) {
+	const std::type_info& type = attr->getType();
+	UInt values;
+	if (type == typeid(Real) || type == typeid(Int) || type == typeid(Bool))
+		values = 1;
+	else if (type == typeid(Complex))
+		values = 2;
+	else
+		throw InvalidAttributeException();
+
+	if (mImports.size() <= attributeId) {
+		mImports.resize(attributeId + 1);
+		mImportValues.resize(attributeId + 1, 0);
+	}
+	mImports[attributeId] = attr;
+	mImportValues[attributeId] = values;
+}
+
+void InterfaceWorkerUdp::open() {
+	mRemote = socketAddress(mRemoteAddress, mRemotePort);
+	sockaddr_in local = socketAddress(mLocalAddress, mLocalPort);
+
+	mSocket = ::socket(AF_INET, SOCK_DGRAM, 0);
+	if (mSocket < 0)
+		throw SystemError("Cannot create UDP socket: " + String(std::strerror(errno)));
+
+	int reuse = 1;
+	::setsockopt(mSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+	if (::bind(mSocket, reinterpret_cast<sockaddr*>(&local), sizeof(local)) < 0)
+		throw SystemError("Cannot bind UDP socket to " + mLocalAddress + ":" + std::to_string(mLocalPort) + ": " + std::strerror(errno));
+
+	if (mBusyPoll > 0) {
+		int busyPoll = static_cast<int>(mBusyPoll);
+		if (::setsockopt(mSocket, SOL_SOCKET, SO_BUSY_POLL, &busyPoll, sizeof(busyPoll)) < 0 && mLog)
+			SPDLOG_LOGGER_WARN(mLog, "Cannot enable busy polling of the UDP socket: {}", std::strerror(errno));
+	}
+
+	// Every receive buffer takes the largest frame the imports can use
+	UInt importValues = 0;
+	for (auto values : mImportValues)
+		importValues += values;
+	mReceiveFrameDoubles = HeaderDoubles + importValues;
+	mReceiveFrames.assign(mReceiveBatch * mReceiveFrameDoubles, 0);
+	mReceiveVecs.resize(mReceiveBatch);
+	mReceiveMsgs.resize(mReceiveBatch);
+	for (UInt i = 0; i < mReceiveBatch; i++) {
+		mReceiveVecs[i].iov_base = &mReceiveFrames[i * mReceiveFrameDoubles];
+		mReceiveVecs[i].iov_len = mReceiveFrameDoubles * sizeof(double);
+		std::memset(&mReceiveMsgs[i], 0, sizeof(mmsghdr));
+		mReceiveMsgs[i].msg_hdr.msg_iov = &mReceiveVecs[i];
+		mReceiveMsgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	mSendPending = 0;
+	mOpened = true;
+	if (mLog)
+		SPDLOG_LOGGER_INFO(mLog, "Opened UDP interface on {}:{} sending to {}:{}", mLocalAddress, mLocalPort, mRemoteAddress, mRemotePort);
+}
+
+void InterfaceWorkerUdp::close() {
+	if (mSocket >= 0) {
+		flush();
+		::close(mSocket);
+		mSocket = -1;
+	}
+	mOpened = false;
+}
+
+void InterfaceWorkerUdp::readValuesFromEnv(std::vector<Interface::AttributePacket>& updatedAttrs) {
+	if (mBusyPoll == 0) {
+		// Wait a bounded time so that the reader thread notices when the interface is closed
+		pollfd pfd = { mSocket, POLLIN, 0 };
+		if (::poll(&pfd, 1, 1) <= 0)
+			return;
+	}
+
+	for (auto& msg : mReceiveMsgs)
+		msg.msg_hdr.msg_flags = 0;
+	int frames = ::recvmmsg(mSocket, mReceiveMsgs.data(), mReceiveBatch, MSG_DONTWAIT, nullptr);
+	if (frames < 0) {
+		if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && mLog)
+			SPDLOG_LOGGER_ERROR(mLog, "Failed to receive from UDP interface: {}", std::strerror(errno));
+		return;
+	}
+
+	// The frames are passed on in order, the newest one ends up on the attributes
+	for (int f = 0; f < frames; f++) {
+		const double* frame = &mReceiveFrames[f * mReceiveFrameDoubles];
+		std::size_t length = mReceiveMsgs[f].msg_len;
+		if (length < sizeof(FrameHeader))
+			continue;
+		FrameHeader header;
+		std::memcpy(&header, frame, sizeof(header));
+		std::size_t values = std::min<std::size_t>(header.values, length / sizeof(double) - HeaderDoubles);
+
+		const double* value = frame + HeaderDoubles;
+		std::size_t offset = 0;
+		for (UInt i = 0; i < mImports.size(); i++) {
+			if (offset + mImportValues[i] > values)
+				break;
+			const std::type_info& type = mImports[i]->getType();
+			AttributeBase::Ptr attr;
+			if (type == typeid(Real))
+				attr = AttributePointer<AttributeBase>(AttributeStatic<Real>::make(value[offset]));
+			else if (type == typeid(Int))
+				attr = AttributePointer<AttributeBase>(AttributeStatic<Int>::make(static_cast<Int>(value[offset])));
+			else if (type == typeid(Bool))
+				attr = AttributePointer<AttributeBase>(AttributeStatic<Bool>::make(value[offset] != 0));
+			else
+				attr = AttributePointer<AttributeBase>(AttributeStatic<Complex>::make(Complex(value[offset], value[offset + 1])));
+			offset += mImportValues[i];
+
+			updatedAttrs.emplace_back(Interface::AttributePacket {
+				attr,
+				i,
+				mCurrentSequenceInterfaceToDpsim,
+				Interface::AttributePacketFlags::PACKET_NO_FLAGS
+			});
+			mCurrentSequenceInterfaceToDpsim++;
+		}
+	}
+}
+
+void InterfaceWorkerUdp::writeValuesToEnv(std::vector<Interface::AttributePacket>& updatedAttrs) {
+	// All exports are written from the slots of the export ring
+	updatedAttrs.clear();
+}
+
+void InterfaceWorkerUdp::writeSlotToEnv(const ExportRing& ring, const ExportRing::Slot& slot) {
+	std::size_t frameDoubles = HeaderDoubles;
+	for (UInt i = 0; i < ring.size(); i++)
+		frameDoubles += std::max<UInt>(ring.width(i), 1);
+
+	// The layout of the exports is fixed, so the frames are only allocated for the first slot
+	if (frameDoubles != mSendFrameDoubles) {
+		flush();
+		mSendFrameDoubles = frameDoubles;
+		mSendFrames.assign(mSendBatch * mSendFrameDoubles, 0);
+		mSendVecs.resize(mSendBatch);
+		mSendMsgs.resize(mSendBatch);
+		for (UInt i = 0; i < mSendBatch; i++) {
+			mSendVecs[i].iov_base = &mSendFrames[i * mSendFrameDoubles];
+			mSendVecs[i].iov_len = mSendFrameDoubles * sizeof(double);
+			std::memset(&mSendMsgs[i], 0, sizeof(mmsghdr));
+			mSendMsgs[i].msg_hdr.msg_name = &mRemote;
+			mSendMsgs[i].msg_hdr.msg_namelen = sizeof(mRemote);
+			mSendMsgs[i].msg_hdr.msg_iov = &mSendVecs[i];
+			mSendMsgs[i].msg_hdr.msg_iovlen = 1;
+		}
+	}
+
+	double* frame = &mSendFrames[mSendPending * mSendFrameDoubles];
+	FrameHeader header = { slot.sequenceId, static_cast<uint32_t>(mSendFrameDoubles - HeaderDoubles), slot.time };
+	std::memcpy(frame, &header, sizeof(header));
+
+	double* value = frame + HeaderDoubles;
+	for (UInt i = 0; i < ring.size(); i++) {
+		switch (ring.kind(i)) {
+		case ExportRing::Kind::Real:
+		case ExportRing::Kind::Int:
+		case ExportRing::Kind::Bool:
+			*value++ = ring.real(slot, i);
+			break;
+		case ExportRing::Kind::Complex: {
+			Complex c = ring.complex(slot, i);
+			*value++ = c.real();
+			*value++ = c.imag();
+			break;
+		}
+		case ExportRing::Kind::Vector:
+			std::memcpy(value, ring.vector(slot, i), ring.width(i) * sizeof(double));
+			value += ring.width(i);
+			break;
+		case ExportRing::Kind::Bytes:
+		case ExportRing::Kind::Other:
+			throw InvalidAttributeException();
+		}
+	}
+
+	if (++mSendPending == mSendBatch)
+		flush();
+}
+
+void InterfaceWorkerUdp::flush() {
+	UInt sent = 0;
+	while (sent < mSendPending) {
+		int ret = ::sendmmsg(mSocket, &mSendMsgs[sent], mSendPending - sent, 0);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			if (mLog)
+				SPDLOG_LOGGER_ERROR(mLog, "Failed to send to UDP interface: {}", std::strerror(errno));
+			break;
+		}
+		sent += static_cast<UInt>(ret);
+	}
+	mSendPending = 0;
+}
@@ -0,0 +1,197 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+
+#include <dpsim/IterativeAdapter.h>
+
+using namespace DPsim;
+
+namespace DPsim
+{
+	IterativeAdapter::~IterativeAdapter() = default;
+
+	void IterativeAdapter::applyConfiguration()
+	{
+		mPreconditioner = mConfiguration.getIterativePreconditioner();
+		mTolerance = mConfiguration.getIterativeTolerance();
+		mMaxIterations = mConfiguration.getIterativeMaxIterations();
+		mRefreshIterations = mConfiguration.getPreconditionerRefreshIterations();
+
+		SPDLOG_LOGGER_INFO(mSLog, "BiCGSTAB with {}, relative tolerance {:e}, at most {} iterations, refresh after {} iterations",
+			mConfiguration.getIterativePreconditionerString(), mTolerance, mMaxIterations, mRefreshIterations);
+	}
+
+	void IterativeAdapter::preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
+	{
+		mSystemMatrix = systemMatrix;
+		mPatternAnalyzed = false;
+	}
+
+	void IterativeAdapter::factorize(SparseMatrix& systemMatrix)
+	{
+		mSystemMatrix = systemMatrix;
+		refreshPreconditioner();
+	}
+
+	void IterativeAdapter::refactorize(SparseMatrix& systemMatrix)
+	{
+		mSystemMatrix = systemMatrix;
+		refreshPreconditioner();
+	}
+
+	void IterativeAdapter::partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
+	{
+		mSystemMatrix = systemMatrix;
+		// The preconditioner of a prior matrix stays while the iterations converge fast
+		if (!mPatternAnalyzed || mLastIterations > mRefreshIterations)
+			refreshPreconditioner();
+	}
+
+	void IterativeAdapter::refreshPreconditioner()
+	{
+		switch (mPreconditioner) {
+			case ITERATIVE_PRECONDITIONER::ILUT:
+				mIncompleteLU.compute(mSystemMatrix);
+				break;
+			case ITERATIVE_PRECONDITIONER::LU:
+			default: {
+				CPS::SparseMatrix matrix = mSystemMatrix;
+				if (!mPatternAnalyzed)
+					mLU.analyzePattern(matrix);
+				mLU.factorize(matrix);
+				if (mLU.info() != Eigen::Success)
+					throw CPS::SystemError("LU factorization of the preconditioner failed.");
+			}
+		}
+		mPatternAnalyzed = true;
+		mLastIterations = 0;
+		++mNumRefreshes;
+	}
+
+	void IterativeAdapter::precondition(const Matrix& vector, Matrix& result)
+	{
+		if (mPreconditioner == ITERATIVE_PRECONDITIONER::ILUT)
+			result = mIncompleteLU.solve(vector);
+		else
+			result = mLU.solve(vector);
+	}
+
+	Bool IterativeAdapter::iterate(const Matrix& rightSideVector, Matrix& leftSideVector, UInt& iterations, Real& residual)
+	{
+		iterations = 0;
+		Real threshold = mTolerance * rightSideVector.norm();
+		if (threshold == 0) {
+			leftSideVector.setZero();
+			residual = 0;
+			return true;
+		}
+
+		mResidual.noalias() = rightSideVector - mSystemMatrix * leftSideVector;
+		residual = mResidual.norm();
+		if (residual <= threshold) {
+			residual /= rightSideVector.norm();
+			return true;
+		}
+
+		mShadowResidual = mResidual;
+		mDirection.setZero(mResidual.rows(), 1);
+		mProduct.setZero(mResidual.rows(), 1);
+		Real rho = 1, alpha = 1, omega = 1;
+		Bool converged = false;
+		while (iterations < mMaxIterations) {
+			++iterations;
+			Real rhoNext = mShadowResidual.col(0).dot(mResidual.col(0));
+			if (rhoNext == 0 || omega == 0)
+				break;
+			Real beta = (rhoNext / rho) * (alpha / omega);
+			rho = rhoNext;
+			mDirection = mResidual + beta * (mDirection - omega * mProduct);
+
+			precondition(mDirection, mPreconditioned);
+			mProduct.noalias() = mSystemMatrix * mPreconditioned;
+			Real denominator = mShadowResidual.col(0).dot(mProduct.col(0));
+			if (denominator == 0)
+				break;
+			alpha = rho / denominator;
+			mIntermediate = mResidual - alpha * mProduct;
+			if (mIntermediate.norm() <= threshold) {
+				leftSideVector += alpha * mPreconditioned;
+				residual = mIntermediate.norm();
+				converged = true;
+				break;
+			}
+
+			precondition(mIntermediate, mCorrection);
+			mIntermediateProduct.noalias() = mSystemMatrix * mCorrection;
+			omega = mIntermediateProduct.col(0).dot(mIntermediate.col(0)) / mIntermediateProduct.squaredNorm();
+			leftSideVector += alpha * mPreconditioned + omega * mCorrection;
+			mResidual = mIntermediate - omega * mIntermediateProduct;
+			residual = mResidual.norm();
+			if (residual <= threshold) {
+				converged = true;
+				break;
+			}
+		}
+		residual /= rightSideVector.norm();
+		return converged;
+	}
+
+	Matrix IterativeAdapter::solve(Matrix& mRightHandSideVector)
+	{
+		Matrix leftSideVector = mLastSolution;
+		solveInPlace(mRightHandSideVector, leftSideVector);
+		return leftSideVector;
+	}
+
+	void IterativeAdapter::solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector)
+	{
+		if (leftSideVector.rows() != rightSideVector.rows() || leftSideVector.cols() != rightSideVector.cols())
+			leftSideVector.setZero(rightSideVector.rows(), rightSideVector.cols());
+
+		UInt maxIterations = 0;
+		for (Int col = 0; col < rightSideVector.cols(); ++col) {
+			Matrix solution = leftSideVector.col(col);
+			Matrix initialGuess = solution;
+			UInt iterations;
+			Real residual;
+			Bool converged = iterate(rightSideVector.col(col), solution, iterations, residual);
+			if (!converged) {
+				// Retry with a preconditioner of the current matrix
+				UInt failedIterations = iterations;
+				refreshPreconditioner();
+				solution = initialGuess;
+				converged = iterate(rightSideVector.col(col), solution, iterations, residual);
+				iterations += failedIterations;
+				if (!converged) {
+					++mNumFailures;
+					SPDLOG_LOGGER_WARN(mSLog, "BiCGSTAB did not converge, relative residual {:e}", residual);
+				}
+			}
+			leftSideVector.col(col) = solution;
+
+			++mNumSolves;
+			mNumIterations += iterations;
+			mMaxSolveIterations = std::max(mMaxSolveIterations, iterations);
+			mMaxResidual = std::max(mMaxResidual, residual);
+			maxIterations = std::max(maxIterations, iterations);
+		}
+		mLastIterations = maxIterations;
+		mLastSolution = leftSideVector;
+	}
+
+	void IterativeAdapter::logStatistics()
+	{
+		if (mNumSolves == 0)
+			return;
+		SPDLOG_LOGGER_INFO(mSLog, "Iterative solves: {}, mean iterations: {:.2f}, maximum iterations: {}, "
+			"maximum relative residual: {:e}, preconditioner computations: {}, not converged: {}",
+			mNumSolves, static_cast<Real>(mNumIterations) / mNumSolves, mMaxSolveIterations,
+			mMaxResidual, mNumRefreshes, mNumFailures);
+	}
+}
@@ -7,6 +7,7 @@
  *********************************************************************************/
 
 #include <dpsim/KLUAdapter.h>
+#include <dpsim/MemoryReport.h>
 
 using namespace DPsim;
 
@@ -14,8 +15,6 @@ namespace DPsim
 {
 KLUAdapter::~KLUAdapter()
 {
-    if (mSymbolic)
-        klu_free_symbolic(&mSymbolic, &mCommon);
     if (mNumeric)
         klu_free_numeric(&mNumeric, &mCommon);
 }
@@ -43,10 +42,7 @@ KLUAdapter::KLUAdapter(CPS::Logger::Log log) : KLUAdapter()
 void KLUAdapter::preprocessing(SparseMatrix &systemMatrix,
                                std::vector<std::pair<UInt, UInt>> &listVariableSystemMatrixEntries)
 {
-    if (mSymbolic)
-    {
-        klu_free_symbolic(&mSymbolic, &mCommon);
-    }
+    mSymbolic.reset();
 
     const Int n = Eigen::internal::convert_index<Int>(systemMatrix.rows());
 
@@ -66,7 +62,14 @@ void KLUAdapter::preprocessing(SparseMatrix &systemMatrix,
     }
 
     // this call also works if mVaryingColumns, mVaryingRows are empty
-    mSymbolic = klu_analyze_partial(n, Ap, Ai, &mVaryingColumns[0], &mVaryingRows[0], varying_entries, mPreordering, &mCommon);
+    klu_symbolic* symbolic = klu_analyze_partial(n, Ap, Ai, &mVaryingColumns[0], &mVaryingRows[0], varying_entries, mPreordering, &mCommon);
+    /* the symbolic object may outlive this adapter if it is shared,
+     * so it is freed with its own common struct */
+    mSymbolic = std::shared_ptr<klu_symbolic>(symbolic, [](klu_symbolic* symbolic) {
+        klu_common common;
+        klu_defaults(&common);
+        klu_free_symbolic(&symbolic, &common);
+    });
 
     /* store non-zero value of current preprocessed matrix. only used until
      * to-do in refactorize-function is resolved. Can be removed then. */
@@ -84,7 +87,7 @@ void KLUAdapter::factorize(SparseMatrix &systemMatrix)
     auto Ai = Eigen::internal::convert_index<Int *>(systemMatrix.innerIndexPtr());
     auto Ax = Eigen::internal::convert_index<Real *>(systemMatrix.valuePtr());
 
-    mNumeric = klu_factor(Ap, Ai, Ax, mSymbolic, &mCommon);
+    mNumeric = klu_factor(Ap, Ai, Ax, mSymbolic.get(), &mCommon);
 
 	Int varying_entries = Eigen::internal::convert_index<Int>(mChangedEntries.size());
 
@@ -94,18 +97,19 @@ void KLUAdapter::factorize(SparseMatrix &systemMatrix)
     {
 		if(mPartialRefactorizationMethod == DPsim::PARTIAL_REFACTORIZATION_METHOD::FACTORIZATION_PATH)
 		{
-        	klu_compute_path(mSymbolic, mNumeric, &mCommon, Ap, Ai, &mVaryingColumns[0], &mVaryingRows[0], varying_entries);
+        	klu_compute_path(mSymbolic.get(), mNumeric, &mCommon, Ap, Ai, &mVaryingColumns[0], &mVaryingRows[0], varying_entries);
 		}
 		else if(mPartialRefactorizationMethod == DPsim::PARTIAL_REFACTORIZATION_METHOD::REFACTORIZATION_RESTART)
 		{
-			klu_determine_start(mSymbolic, mNumeric, &mCommon, Ap, Ai, &mVaryingColumns[0], &mVaryingRows[0], varying_entries);
+			klu_determine_start(mSymbolic.get(), mNumeric, &mCommon, Ap, Ai, &mVaryingColumns[0], &mVaryingRows[0], varying_entries);
 		}
     }
 }
 
 void KLUAdapter::refactorize(SparseMatrix &systemMatrix)
 {
-    /* TODO: remove if-else when zero<->non-zero issue during matrix stamping has been fixed. Also remove in partialRefactorize then. */
+    /* The MNA solver reserves the entries of switches and variable elements, so the pattern
+     * only changes if a stamp leaves the reserved entries. Also checked in partialRefactorize. */
     if (systemMatrix.nonZeros() != nnz)
     {
         preprocessing(systemMatrix, mChangedEntries);
@@ -116,7 +120,7 @@ void KLUAdapter::refactorize(SparseMatrix &systemMatrix)
         auto Ap = Eigen::internal::convert_index<Int *>(systemMatrix.outerIndexPtr());
         auto Ai = Eigen::internal::convert_index<Int *>(systemMatrix.innerIndexPtr());
         auto Ax = Eigen::internal::convert_index<Real *>(systemMatrix.valuePtr());
-        klu_refactor(Ap, Ai, Ax, mSymbolic, mNumeric, &mCommon);
+        klu_refactor(Ap, Ai, Ax, mSymbolic.get(), mNumeric, &mCommon);
     }
 }
 
@@ -125,6 +129,7 @@ void KLUAdapter::partialRefactorize(SparseMatrix &systemMatrix,
 {
     if (systemMatrix.nonZeros() != nnz)
     {
+        SPDLOG_LOGGER_DEBUG(mSLog, "Sparsity pattern changed from {} to {} nonzeros, analyzing again", nnz, systemMatrix.nonZeros());
         preprocessing(systemMatrix, listVariableSystemMatrixEntries);
         factorize(systemMatrix);
     }
@@ -136,42 +141,66 @@ void KLUAdapter::partialRefactorize(SparseMatrix &systemMatrix,
 
 		if(mPartialRefactorizationMethod == PARTIAL_REFACTORIZATION_METHOD::FACTORIZATION_PATH)
 		{
-	        klu_partial_factorization_path(Ap, Ai, Ax, mSymbolic, mNumeric, &mCommon);
+	        klu_partial_factorization_path(Ap, Ai, Ax, mSymbolic.get(), mNumeric, &mCommon);
 		}
 		else if(mPartialRefactorizationMethod == PARTIAL_REFACTORIZATION_METHOD::REFACTORIZATION_RESTART)
 		{
-			klu_partial_refactorization_restart(Ap, Ai, Ax, mSymbolic, mNumeric, &mCommon);
+			klu_partial_refactorization_restart(Ap, Ai, Ax, mSymbolic.get(), mNumeric, &mCommon);
 		}
 		else
 		{
-			klu_refactor(Ap, Ai, Ax, mSymbolic, mNumeric, &mCommon);
+			klu_refactor(Ap, Ai, Ax, mSymbolic.get(), mNumeric, &mCommon);
 		}
 
         if (mCommon.status == KLU_PIVOT_FAULT)
         {
             /* pivot became too small => fully factorize again */
+            ++mPivotFaults;
             factorize(systemMatrix);
         }
     }
 }
 
+Bool KLUAdapter::adoptSymbolicAnalysis(const DirectLinearSolver &analyzed, SparseMatrix &systemMatrix)
+{
+    auto other = dynamic_cast<const KLUAdapter *>(&analyzed);
+    /* the factorization path of varying entries is not shared */
+    if (!other || !other->mSymbolic || !other->mChangedEntries.empty()
+        || other->mSymbolic->n != Eigen::internal::convert_index<Int>(systemMatrix.rows())
+        || other->nnz != Eigen::internal::convert_index<Int>(systemMatrix.nonZeros()))
+        return false;
+
+    mSymbolic = other->mSymbolic;
+    mChangedEntries.clear();
+    mVaryingColumns.clear();
+    mVaryingRows.clear();
+    nnz = other->nnz;
+    return true;
+}
+
 Matrix KLUAdapter::solve(Matrix &rightSideVector)
 {
-    Matrix x = rightSideVector;
+    Matrix x(rightSideVector.rows(), rightSideVector.cols());
+    solveInPlace(rightSideVector, x);
+    return x;
+}
+
+void KLUAdapter::solveInPlace(const Matrix &rightSideVector, Matrix &leftSideVector)
+{
+    /* assignment reuses the storage of leftSideVector if the dimensions match */
+    leftSideVector = rightSideVector;
 
     /* number of right hands sides
      * usually one, KLU can handle multiple right hand sides */
-    Int rhsCols = Eigen::internal::convert_index<Int>(rightSideVector.cols());
+    Int rhsCols = Eigen::internal::convert_index<Int>(leftSideVector.cols());
 
     /* leading dimension, also called "n" */
-    Int rhsRows = Eigen::internal::convert_index<Int>(rightSideVector.rows());
+    Int rhsRows = Eigen::internal::convert_index<Int>(leftSideVector.rows());
 
 	/* tsolve refers to transpose solve. Input matrix is stored in compressed row format,
 	 * KLU operates on compressed column format. This way, the transpose of the matrix is factored.
 	 * This has to be taken into account only here during right-hand solving. */
-    klu_tsolve(mSymbolic, mNumeric, rhsRows, rhsCols, x.const_cast_derived().data(), &mCommon);
-
-    return x;
+    klu_tsolve(mSymbolic.get(), mNumeric, rhsRows, rhsCols, leftSideVector.data(), &mCommon);
 }
 
 void KLUAdapter::printMatrixMarket(SparseMatrix &matrix, int counter) const
@@ -256,5 +285,16 @@ void KLUAdapter::applyConfiguration()
 	}
 
 	SPDLOG_LOGGER_INFO(mSLog, "Matrix is permuted " + mConfiguration.getBTFString());
+
+	// KLU has no single precision factorization
+	if (mConfiguration.getFactorizationPrecision() == FACTORIZATION_PRECISION::MIXED)
+		SPDLOG_LOGGER_WARN(mSLog, "KLU only factorizes in double precision, mixed precision is not used");
+}
+
+std::size_t KLUAdapter::memoryBytes() const
+{
+	// KLU tracks the memory of all objects allocated with its common struct
+	return mCommon.memusage + MemoryReport::vectorBytes(mChangedEntries)
+		+ MemoryReport::vectorBytes(mVaryingColumns) + MemoryReport::vectorBytes(mVaryingRows);
 }
 } // namespace DPsim
@@ -0,0 +1,593 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/LimSolver.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <dpsim-models/Components.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+LimSolver::LimSolver(String name, SystemTopology system, Real timeStep, Logger::Level logLevel) :
+	Solver(name + "_LIM", logLevel), mSystem(system) {
+	mTimeStep = timeStep;
+	mSourceVector = AttributeStatic<Matrix>::make();
+	mBranchCurrents = AttributeStatic<Matrix>::make();
+	mPointVoltages = AttributeStatic<Matrix>::make();
+}
+
+Int LimSolver::point(SimNode<Real>::Ptr node, UInt phase) const {
+	if (node->isGround())
+		return -1;
+	if (phase == 1)
+		return static_cast<Int>(node->matrixNodeIndex(PhaseType::B));
+	if (phase == 2)
+		return static_cast<Int>(node->matrixNodeIndex(PhaseType::C));
+	return static_cast<Int>(node->matrixNodeIndex(PhaseType::Single));
+}
+
+Real LimSolver::phaseValue(const Matrix& value, UInt phase, const String& name) const {
+	for (Int row = 0; row < value.rows(); ++row) {
+		for (Int col = 0; col < value.cols(); ++col) {
+			if (row != col && value(row, col) != 0)
+				throw SystemError("The LIM solver requires decoupled phases, " + name + " has a non-diagonal parameter matrix.");
+		}
+	}
+	return value(phase, phase);
+}
+
+void LimSolver::collectVirtualNodes(SimPowerComp<Real>::Ptr comp) {
+	Bool voltageSource = std::dynamic_pointer_cast<EMT::Ph1::VoltageSource>(comp)
+		|| std::dynamic_pointer_cast<EMT::Ph3::VoltageSource>(comp);
+	for (auto node : comp->virtualNodes()) {
+		if (std::find(mNodes.begin(), mNodes.end(), node) != mNodes.end()
+			|| std::find(mSourceNodes.begin(), mSourceNodes.end(), node) != mSourceNodes.end())
+			continue;
+		// The branch current of a voltage source is not solved for, its virtual node only takes the stamps
+		if (voltageSource)
+			mSourceNodes.push_back(node);
+		else
+			mNodes.push_back(node);
+	}
+	for (auto subComp : comp->subComponents())
+		collectVirtualNodes(subComp);
+}
+
+void LimSolver::identifyTopologyObjects() {
+	for (auto baseNode : mSystem.mNodes) {
+		if (baseNode->isGround())
+			continue;
+		auto node = std::dynamic_pointer_cast<SimNode<Real>>(baseNode);
+		if (!node)
+			throw SystemError("The LIM solver only supports EMT nodes, " + baseNode->name() + " is not one.");
+		mNodes.push_back(node);
+	}
+
+	SimPowerComp<Real>::List powerComps;
+	for (auto comp : mSystem.mComponents) {
+		if (auto sigComp = std::dynamic_pointer_cast<SimSignalComp>(comp)) {
+			mSignalComps.push_back(sigComp);
+			continue;
+		}
+		auto powerComp = std::dynamic_pointer_cast<SimPowerComp<Real>>(comp);
+		if (!powerComp)
+			throw SystemError("The LIM solver only supports EMT components, " + comp->name() + " is not one.");
+		powerComps.push_back(powerComp);
+	}
+
+	// Composite components create their subcomponents and virtual nodes on initialization
+	for (auto comp : powerComps) {
+		comp->checkForUnconnectedTerminals();
+		if (mInitFromNodesAndTerminals)
+			comp->initializeFromNodesAndTerminals(mSystem.mSystemFrequency);
+	}
+	for (auto comp : powerComps)
+		collectVirtualNodes(comp);
+
+	UInt index = 0;
+	for (auto node : mNodes) {
+		UInt phases = node->phaseType() == PhaseType::ABC ? 3 : 1;
+		for (UInt phase = 0; phase < phases; ++phase)
+			node->setMatrixNodeIndex(phase, index++);
+	}
+	mNumPoints = index;
+	for (auto node : mSourceNodes) {
+		UInt phases = node->phaseType() == PhaseType::ABC ? 3 : 1;
+		for (UInt phase = 0; phase < phases; ++phase)
+			node->setMatrixNodeIndex(phase, index++);
+	}
+	mNumIndices = index;
+
+	**mSourceVector = Matrix::Zero(mNumIndices, 1);
+	for (auto comp : powerComps)
+		addComponent(comp);
+
+	SPDLOG_LOGGER_INFO(mSLog, "Assigned {} points to {} nodes, {} indices to the virtual nodes of the voltage sources",
+		mNumPoints, mNodes.size(), mNumIndices - mNumPoints);
+}
+
+void LimSolver::addComponent(SimPowerComp<Real>::Ptr comp) {
+	Element element;
+	element.comp = comp;
+	UInt phases = 1;
+	std::vector<Real> values;
+
+	if (auto resistor = std::dynamic_pointer_cast<EMT::Ph1::Resistor>(comp)) {
+		element.type = ElementType::Resistor;
+		values = { **resistor->mResistance };
+	} else if (auto resistor = std::dynamic_pointer_cast<EMT::Ph3::Resistor>(comp)) {
+		element.type = ElementType::Resistor;
+		phases = 3;
+		for (UInt phase = 0; phase < phases; ++phase)
+			values.push_back(phaseValue(**resistor->mResistance, phase, comp->name()));
+	} else if (auto inductor = std::dynamic_pointer_cast<EMT::Ph1::Inductor>(comp)) {
+		element.type = ElementType::Inductor;
+		values = { **inductor->mInductance };
+	} else if (auto inductor = std::dynamic_pointer_cast<EMT::Ph3::Inductor>(comp)) {
+		element.type = ElementType::Inductor;
+		phases = 3;
+		for (UInt phase = 0; phase < phases; ++phase)
+			values.push_back(phaseValue(**inductor->mInductance, phase, comp->name()));
+	} else if (auto capacitor = std::dynamic_pointer_cast<EMT::Ph1::Capacitor>(comp)) {
+		element.type = ElementType::Capacitor;
+		values = { **capacitor->mCapacitance };
+	} else if (auto capacitor = std::dynamic_pointer_cast<EMT::Ph3::Capacitor>(comp)) {
+		element.type = ElementType::Capacitor;
+		phases = 3;
+		for (UInt phase = 0; phase < phases; ++phase)
+			values.push_back(phaseValue(**capacitor->mCapacitance, phase, comp->name()));
+	} else if (std::dynamic_pointer_cast<EMT::Ph1::CurrentSource>(comp)) {
+		element.type = ElementType::CurrentSource;
+	} else if (std::dynamic_pointer_cast<EMT::Ph3::CurrentSource>(comp)) {
+		element.type = ElementType::CurrentSource;
+		phases = 3;
+	} else if (std::dynamic_pointer_cast<EMT::Ph1::VoltageSource>(comp)) {
+		element.type = ElementType::VoltageSource;
+	} else if (std::dynamic_pointer_cast<EMT::Ph3::VoltageSource>(comp)) {
+		element.type = ElementType::VoltageSource;
+		phases = 3;
+	} else if (comp->hasSubComponents()) {
+		mComposites.push_back(comp);
+		for (auto subComp : comp->subComponents())
+			addComponent(subComp);
+		return;
+	} else {
+		throw SystemError("Component " + comp->name() + " is not supported by the LIM solver.");
+	}
+
+	if (element.type == ElementType::CurrentSource || element.type == ElementType::VoltageSource) {
+		auto mnaComp = std::dynamic_pointer_cast<MNAInterface>(comp);
+		mnaComp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mSourceVector);
+		mSources.push_back(mnaComp);
+	}
+
+	for (UInt phase = 0; phase < phases; ++phase) {
+		element.points1.push_back(comp->terminalNumber() > 1 ? point(comp->node(1), phase) : -1);
+		element.points0.push_back(point(comp->node(0), phase));
+	}
+	element.values = values;
+	element.branches.assign(phases, -1);
+	element.signs.assign(phases, 1);
+	mElements.push_back(element);
+}
+
+void LimSolver::createBranches() {
+	mPointConductance = Matrix::Zero(mNumPoints, 1);
+	mPointCapacitance = Matrix::Zero(mNumPoints, 1);
+	mFixedBy.assign(mNumPoints, -1);
+
+	// Series elements by point, and points with other elements that cannot be internal points of a branch
+	struct Segment { UInt element; UInt phase; };
+	std::vector<Segment> segments;
+	std::vector<std::vector<UInt>> pointSegments(mNumPoints);
+	std::vector<Bool> connected(mNumPoints, false);
+
+	for (UInt e = 0; e < mElements.size(); ++e) {
+		auto& element = mElements[e];
+		for (UInt phase = 0; phase < element.points0.size(); ++phase) {
+			Int p1 = element.points1[phase];
+			Int p0 = element.points0[phase];
+			switch (element.type) {
+			case ElementType::Resistor:
+				if (p1 >= 0 && p0 >= 0)
+					break;
+				if (p1 >= 0 || p0 >= 0) {
+					mPointConductance(std::max(p1, p0), 0) += 1. / element.values[phase];
+					connected[std::max(p1, p0)] = true;
+				}
+				continue;
+			case ElementType::Inductor:
+				break;
+			case ElementType::Capacitor:
+				if (p1 >= 0 && p0 >= 0)
+					throw SystemError("The LIM solver only supports capacitors to ground, " + element.comp->name() + " is not grounded.");
+				if (p1 >= 0 || p0 >= 0) {
+					mPointCapacitance(std::max(p1, p0), 0) += element.values[phase];
+					connected[std::max(p1, p0)] = true;
+				}
+				continue;
+			case ElementType::CurrentSource:
+				if (p1 >= 0) connected[p1] = true;
+				if (p0 >= 0) connected[p0] = true;
+				continue;
+			case ElementType::VoltageSource: {
+				if (p1 >= 0 && p0 >= 0)
+					throw SystemError("The LIM solver requires a grounded terminal of the voltage source " + element.comp->name() + ".");
+				if (p1 < 0 && p0 < 0)
+					continue;
+				Int fixed = std::max(p1, p0);
+				if (mFixedBy[fixed] >= 0)
+					throw SystemError("The voltage sources " + mElements[mFixedBy[fixed]].comp->name() + " and "
+						+ element.comp->name() + " fix the same node.");
+				mFixedBy[fixed] = static_cast<Int>(e);
+				connected[fixed] = true;
+				continue;
+			}
+			}
+			for (Int p : { p1, p0 }) {
+				if (p >= 0)
+					pointSegments[p].push_back(static_cast<UInt>(segments.size()));
+			}
+			segments.push_back({ e, phase });
+		}
+	}
+
+	// A point only connecting two series elements is internal to a branch
+	auto internal = [&](Int p) { return p >= 0 && !connected[p] && pointSegments[p].size() == 2; };
+	std::vector<Bool> visited(segments.size(), false);
+
+	auto walk = [&](Int start, UInt first) {
+		UInt branch = static_cast<UInt>(mBranchPoints.size());
+		Real resistance = 0;
+		Real inductance = 0;
+		Int current = start;
+		UInt segment = first;
+		while (true) {
+			visited[segment] = true;
+			auto& element = mElements[segments[segment].element];
+			UInt phase = segments[segment].phase;
+			Real value = element.values[phase];
+			Real segmentResistance = element.type == ElementType::Resistor ? value : 0;
+			Real segmentInductance = element.type == ElementType::Inductor ? value : 0;
+			resistance += segmentResistance;
+			inductance += segmentInductance;
+
+			// The element current flows from terminal 1 to terminal 0
+			Bool forward = element.points1[phase] == current;
+			element.branches[phase] = static_cast<Int>(branch);
+			element.signs[phase] = forward ? 1 : -1;
+			Int next = forward ? element.points0[phase] : element.points1[phase];
+
+			if (!internal(next) || next == start) {
+				mBranchPoints.push_back({ start, next });
+				break;
+			}
+			mInternalPoints.push_back({ static_cast<UInt>(next), current, branch, segmentResistance, segmentInductance });
+			auto& candidates = pointSegments[next];
+			UInt following = candidates[0] == segment ? candidates[1] : candidates[0];
+			if (visited[following]) {
+				mBranchPoints.push_back({ start, next });
+				break;
+			}
+			current = next;
+			segment = following;
+		}
+		mBranchResistance.push_back(resistance);
+		mBranchInductance.push_back(inductance);
+	};
+
+	// Walk from the ends of the branches, the remaining segments form loops of internal points
+	for (UInt s = 0; s < segments.size(); ++s) {
+		if (visited[s])
+			continue;
+		auto& element = mElements[segments[s].element];
+		UInt phase = segments[s].phase;
+		if (!internal(element.points1[phase]))
+			walk(element.points1[phase], s);
+		else if (!internal(element.points0[phase]))
+			walk(element.points0[phase], s);
+	}
+	for (UInt s = 0; s < segments.size(); ++s) {
+		if (visited[s])
+			continue;
+		auto& element = mElements[segments[s].element];
+		Int start = element.points1[segments[s].phase];
+		connected[start] = true;
+		walk(start, s);
+	}
+
+	// Incidence of the branch ends by point
+	std::vector<std::vector<Int>> incidence(mNumPoints);
+	for (UInt k = 0; k < mBranchPoints.size(); ++k) {
+		if (mBranchPoints[k].first >= 0)
+			incidence[mBranchPoints[k].first].push_back(-static_cast<Int>(k + 1));
+		if (mBranchPoints[k].second >= 0)
+			incidence[mBranchPoints[k].second].push_back(static_cast<Int>(k + 1));
+	}
+	mIncidenceStart.assign(mNumPoints + 1, 0);
+	mIncidence.clear();
+	for (UInt p = 0; p < mNumPoints; ++p) {
+		mIncidence.insert(mIncidence.end(), incidence[p].begin(), incidence[p].end());
+		mIncidenceStart[p + 1] = static_cast<UInt>(mIncidence.size());
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "Created {} branches from {} series elements, {} points are internal to branches",
+		mBranchPoints.size(), segments.size(), mInternalPoints.size());
+}
+
+void LimSolver::computeCoefficients() {
+	UInt numBranches = static_cast<UInt>(mBranchPoints.size());
+	mBranchA = Matrix::Zero(numBranches, 1);
+	mBranchB = Matrix::Zero(numBranches, 1);
+	UInt fictitiousInductances = 0;
+	for (UInt k = 0; k < numBranches; ++k) {
+		Real resistance = mBranchResistance[k];
+		Real inductance = mBranchInductance[k];
+		if (inductance <= 0) {
+			if (resistance <= 0)
+				throw SystemError("A branch of the LIM solver has neither resistance nor inductance.");
+			inductance = mLatencyFactor * mTimeStep * resistance;
+			mBranchInductance[k] = inductance;
+			++fictitiousInductances;
+		}
+		Real denominator = inductance / mTimeStep + resistance / 2;
+		mBranchA(k, 0) = (inductance / mTimeStep - resistance / 2) / denominator;
+		mBranchB(k, 0) = 1. / denominator;
+	}
+
+	std::vector<Bool> isInternal(mNumPoints, false);
+	for (auto& internal : mInternalPoints)
+		isInternal[internal.point] = true;
+
+	mPointA = Matrix::Zero(mNumPoints, 1);
+	mPointB = Matrix::Zero(mNumPoints, 1);
+	Matrix capacitance = mPointCapacitance;
+	UInt fictitiousCapacitances = 0;
+	for (UInt p = 0; p < mNumPoints; ++p) {
+		if (mFixedBy[p] >= 0 || isInternal[p])
+			continue;
+		if (capacitance(p, 0) <= 0) {
+			Real admittance = mPointConductance(p, 0);
+			for (UInt i = mIncidenceStart[p]; i < mIncidenceStart[p + 1]; ++i) {
+				UInt k = static_cast<UInt>(std::abs(mIncidence[i]) - 1);
+				admittance += 1. / (mBranchResistance[k] + mBranchInductance[k] / mTimeStep);
+			}
+			if (admittance <= 0)
+				throw SystemError("A node of the LIM solver is floating.");
+			capacitance(p, 0) = mLatencyFactor * mTimeStep * admittance;
+			++fictitiousCapacitances;
+		}
+		Real denominator = capacitance(p, 0) / mTimeStep + mPointConductance(p, 0) / 2;
+		mPointA(p, 0) = (capacitance(p, 0) / mTimeStep - mPointConductance(p, 0) / 2) / denominator;
+		mPointB(p, 0) = 1. / denominator;
+	}
+
+	// The leapfrog steps are stable if the time step is below the delay of each branch
+	UInt unstable = 0;
+	for (UInt k = 0; k < numBranches; ++k) {
+		Real minCapacitance = std::numeric_limits<Real>::infinity();
+		for (Int p : { mBranchPoints[k].first, mBranchPoints[k].second }) {
+			if (p >= 0 && mFixedBy[p] < 0)
+				minCapacitance = std::min(minCapacitance, capacitance(p, 0));
+		}
+		if (std::isfinite(minCapacitance) && mTimeStep > std::sqrt(mBranchInductance[k] * minCapacitance))
+			++unstable;
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "Inserted {} fictitious inductances and {} fictitious capacitances with the latency factor {}",
+		fictitiousInductances, fictitiousCapacitances, mLatencyFactor);
+	if (unstable > 0)
+		SPDLOG_LOGGER_WARN(mSLog, "The time step exceeds the delay sqrt(LC) of {} branches, the LIM steps may be unstable", unstable);
+}
+
+void LimSolver::initializeState() {
+	**mPointVoltages = Matrix::Zero(mNumPoints, 1);
+	**mBranchCurrents = Matrix::Zero(mBranchPoints.size(), 1);
+	mInjection = Matrix::Zero(mNumPoints, 1);
+	if (!mInitFromNodesAndTerminals) {
+		mPreviousCurrents = **mBranchCurrents;
+		return;
+	}
+
+	for (auto node : mNodes) {
+		if (node->phaseType() == PhaseType::ABC) {
+			Complex voltage = RMS3PH_TO_PEAK1PH * node->initialSingleVoltage(PhaseType::A);
+			(**mPointVoltages)(point(node, 0), 0) = voltage.real();
+			(**mPointVoltages)(point(node, 1), 0) = (voltage * SHIFT_TO_PHASE_B).real();
+			(**mPointVoltages)(point(node, 2), 0) = (voltage * SHIFT_TO_PHASE_C).real();
+		} else {
+			(**mPointVoltages)(point(node, 0), 0) = node->initialSingleVoltage().real();
+		}
+	}
+
+	// The inductor currents are the initial branch currents, resistor currents only for branches without inductor
+	std::vector<Bool> fromInductor(mBranchPoints.size(), false);
+	for (auto& element : mElements) {
+		if (element.type != ElementType::Resistor && element.type != ElementType::Inductor)
+			continue;
+		for (UInt phase = 0; phase < element.branches.size(); ++phase) {
+			Int k = element.branches[phase];
+			if (k < 0 || fromInductor[k])
+				continue;
+			(**mBranchCurrents)(k, 0) = element.signs[phase] * (**element.comp->mIntfCurrent)(phase, 0);
+			fromInductor[k] = element.type == ElementType::Inductor;
+		}
+	}
+	mPreviousCurrents = **mBranchCurrents;
+}
+
+void LimSolver::initialize() {
+	SPDLOG_LOGGER_INFO(mSLog, "---- Start initialization ----");
+	identifyTopologyObjects();
+	createBranches();
+	computeCoefficients();
+	initializeState();
+
+	for (auto comp : mSignalComps)
+		comp->initialize(mSystem.mSystemOmega, mTimeStep);
+	updateComponents(**mPointVoltages);
+	SPDLOG_LOGGER_INFO(mSLog, "---- Initialization finished ----");
+	mSLog->flush();
+}
+
+void LimSolver::solve(Real time, Int timeStepCount) {
+	for (auto source : mSources)
+		source->mnaPreStep(time, timeStepCount);
+
+	mInjection.setZero();
+	for (auto& element : mElements) {
+		if (element.type != ElementType::CurrentSource)
+			continue;
+		for (UInt phase = 0; phase < element.points0.size(); ++phase) {
+			Real current = (**element.comp->mIntfCurrent)(phase, 0);
+			if (element.points1[phase] >= 0) mInjection(element.points1[phase], 0) += current;
+			if (element.points0[phase] >= 0) mInjection(element.points0[phase], 0) -= current;
+		}
+	}
+
+	Matrix& voltages = **mPointVoltages;
+	Matrix& currents = **mBranchCurrents;
+	Matrix previousVoltages = voltages;
+	mPreviousCurrents = currents;
+
+	// Branch currents of the half step from the voltages of the last step
+	const Int numBranches = static_cast<Int>(mBranchPoints.size());
+#ifdef WITH_OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (Int k = 0; k < numBranches; ++k) {
+		Int p = mBranchPoints[k].first;
+		Int q = mBranchPoints[k].second;
+		Real drop = (p >= 0 ? voltages(p, 0) : 0) - (q >= 0 ? voltages(q, 0) : 0);
+		currents(k, 0) = mBranchA(k, 0) * currents(k, 0) + mBranchB(k, 0) * drop;
+	}
+
+	// Point voltages of the step from the branch currents of the half step
+	const Int numPoints = static_cast<Int>(mNumPoints);
+#ifdef WITH_OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (Int p = 0; p < numPoints; ++p) {
+		if (mPointB(p, 0) == 0)
+			continue;
+		Real current = mInjection(p, 0);
+		for (UInt i = mIncidenceStart[p]; i < mIncidenceStart[p + 1]; ++i) {
+			Int entry = mIncidence[i];
+			current += entry > 0 ? currents(entry - 1, 0) : -currents(-entry - 1, 0);
+		}
+		voltages(p, 0) = mPointA(p, 0) * voltages(p, 0) + mPointB(p, 0) * current;
+	}
+
+	for (UInt p = 0; p < mNumPoints; ++p) {
+		if (mFixedBy[p] < 0)
+			continue;
+		auto& element = mElements[mFixedBy[p]];
+		for (UInt phase = 0; phase < element.points0.size(); ++phase) {
+			// The interface voltage of the source is v1 - v0
+			if (element.points1[phase] == static_cast<Int>(p))
+				voltages(p, 0) = (**element.comp->mIntfVoltage)(phase, 0);
+			else if (element.points0[phase] == static_cast<Int>(p))
+				voltages(p, 0) = -(**element.comp->mIntfVoltage)(phase, 0);
+		}
+	}
+
+	// Internal points follow their branch in order from its start
+	for (auto& internal : mInternalPoints) {
+		Real current = currents(internal.branch, 0);
+		Real previous = mPreviousCurrents(internal.branch, 0);
+		Real drop = internal.resistance * (current + previous) / 2 + internal.inductance * (current - previous) / mTimeStep;
+		voltages(internal.point, 0) = (internal.from >= 0 ? voltages(internal.from, 0) : 0) - drop;
+	}
+
+	updateComponents(previousVoltages);
+}
+
+void LimSolver::updateComponents(const Matrix& previousVoltages) {
+	const Matrix& voltages = **mPointVoltages;
+	const Matrix& currents = **mBranchCurrents;
+	auto voltage = [&voltages](Int p) { return p >= 0 ? voltages(p, 0) : 0.; };
+	auto previousVoltage = [&previousVoltages](Int p) { return p >= 0 ? previousVoltages(p, 0) : 0.; };
+
+	for (auto node : mNodes)
+		node->mnaUpdateVoltage(voltages);
+
+	for (auto& element : mElements) {
+		Matrix& intfVoltage = **element.comp->mIntfVoltage;
+		Matrix& intfCurrent = **element.comp->mIntfCurrent;
+		for (UInt phase = 0; phase < element.points0.size(); ++phase) {
+			Int p1 = element.points1[phase];
+			Int p0 = element.points0[phase];
+			Real v = voltage(p1) - voltage(p0);
+			switch (element.type) {
+			case ElementType::Resistor:
+			case ElementType::Inductor:
+				intfVoltage(phase, 0) = v;
+				if (element.branches[phase] >= 0)
+					intfCurrent(phase, 0) = element.signs[phase] * currents(element.branches[phase], 0);
+				else
+					intfCurrent(phase, 0) = v / element.values[phase];
+				break;
+			case ElementType::Capacitor:
+				intfVoltage(phase, 0) = v;
+				intfCurrent(phase, 0) = element.values[phase] * (v - previousVoltage(p1) + previousVoltage(p0)) / mTimeStep;
+				break;
+			case ElementType::CurrentSource:
+				intfVoltage(phase, 0) = v;
+				break;
+			case ElementType::VoltageSource: {
+				// The source delivers the current the rest of the network draws from the fixed point
+				Int fixed = std::max(p1, p0);
+				if (fixed < 0)
+					break;
+				Real current = mInjection(fixed, 0) - mPointConductance(fixed, 0) * voltages(fixed, 0)
+					- mPointCapacitance(fixed, 0) * (voltages(fixed, 0) - previousVoltages(fixed, 0)) / mTimeStep;
+				for (UInt i = mIncidenceStart[fixed]; i < mIncidenceStart[fixed + 1]; ++i) {
+					Int entry = mIncidence[i];
+					current += entry > 0 ? currents(entry - 1, 0) : -currents(-entry - 1, 0);
+				}
+				intfCurrent(phase, 0) = fixed == p1 ? current : -current;
+				break;
+			}
+			}
+		}
+	}
+
+	for (auto comp : mComposites) {
+		Matrix& intfVoltage = **comp->mIntfVoltage;
+		for (UInt phase = 0; phase < static_cast<UInt>(intfVoltage.rows()); ++phase) {
+			Real v1 = comp->terminalNumber() > 1 ? voltage(point(comp->node(1), phase)) : 0;
+			intfVoltage(phase, 0) = comp->terminalNumber() > 1 ? v1 - voltage(point(comp->node(0), phase)) : voltage(point(comp->node(0), phase));
+		}
+	}
+}
+
+LimSolver::SolveTask::SolveTask(LimSolver& solver) :
+	Task(solver.mName + ".Solve"), mSolver(solver) {
+	// Signal components reading the voltages run after the step and act on the next one
+	mModifiedAttributes.push_back(Scheduler::external);
+	for (auto node : solver.mNodes)
+		mModifiedAttributes.push_back(node->mVoltage);
+}
+
+void LimSolver::SolveTask::execute(Real time, Int timeStepCount) {
+	mSolver.solve(time, timeStepCount);
+}
+
+Task::List LimSolver::getTasks() {
+	Task::List tasks{ std::make_shared<SolveTask>(*this) };
+	for (auto comp : mSignalComps) {
+		for (auto task : comp->getTasks())
+			tasks.push_back(task);
+	}
+	return tasks;
+}
+
+AttributeBase::Map LimSolver::stateAttributes() {
+	return {
+		{ "lim_point_voltages", mPointVoltages },
+		{ "lim_branch_currents", mBranchCurrents }
+	};
+}
@@ -9,13 +9,110 @@
 
 #include <dpsim/MNASolver.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim-models/ObjectPool.h>
 #include <memory>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <map>
+#include <numeric>
+#include <set>
+#include <type_traits>
 
 using namespace DPsim;
 using namespace CPS;
 
 namespace DPsim {
 
+namespace {
+	/// Calls func for each component, distributed over the workers of the executor or,
+	/// without executor, over OpenMP threads if parallel is set. The first exception
+	/// thrown by a component is rethrown after all threads finished.
+	template <typename List, typename Func>
+	void forEachComponent(const List& comps, Bool parallel, Executor* executor, Func func) {
+		auto pool = ObjectPool::current();
+		if (parallel && executor && comps.size() > 1) {
+			executor->parallelFor(static_cast<UInt>(comps.size()), [&](UInt i) {
+				std::optional<ObjectPool::Scope> poolScope;
+				if (pool)
+					poolScope.emplace(pool);
+				func(comps[i]);
+			});
+			return;
+		}
+
+		std::exception_ptr error;
+		#pragma omp parallel if(parallel && comps.size() > 1)
+		{
+			// Subcomponents created by the worker threads go to the pool of the caller as well
+			std::optional<ObjectPool::Scope> poolScope;
+			if (pool)
+				poolScope.emplace(pool);
+
+			#pragma omp for schedule(dynamic)
+			for (std::size_t i = 0; i < comps.size(); ++i) {
+				try {
+					func(comps[i]);
+				}
+				catch (...) {
+					#pragma omp critical
+					if (!error)
+						error = std::current_exception();
+				}
+			}
+		}
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	void appendState(std::vector<Real>& state, const Matrix& values) {
+		state.insert(state.end(), values.data(), values.data() + values.size());
+	}
+
+	void appendState(std::vector<Real>& state, const MatrixComp& values) {
+		for (Eigen::Index i = 0; i < values.size(); ++i) {
+			state.push_back(values.data()[i].real());
+			state.push_back(values.data()[i].imag());
+		}
+	}
+
+	void readState(const Real*& state, Matrix& values) {
+		std::copy(state, state + values.size(), values.data());
+		state += values.size();
+	}
+
+	void readState(const Real*& state, MatrixComp& values) {
+		for (Eigen::Index i = 0; i < values.size(); ++i, state += 2)
+			values.data()[i] = Complex(state[0], state[1]);
+	}
+
+	/// Reduced rank extrapolation of the limit of a sequence of states x_0 ... x_k.
+	/// The weights of x_1 ... x_k minimize the norm of the combined differences and sum up to one.
+	Bool reducedRankExtrapolation(const std::vector<Matrix>& states, Matrix& limit) {
+		Eigen::Index numDiffs = static_cast<Eigen::Index>(states.size()) - 1;
+		Matrix diffs(states[0].rows(), numDiffs);
+		for (Eigen::Index i = 0; i < numDiffs; ++i)
+			diffs.col(i) = states[i+1] - states[i];
+
+		Matrix gram = diffs.transpose() * diffs;
+		Real trace = gram.trace();
+		if (!(trace > 0))
+			return false;
+		// Regularize, the differences become nearly dependent close to convergence
+		gram.diagonal().array() += 1e-12 * trace;
+		Matrix weights = gram.ldlt().solve(Matrix::Ones(numDiffs, 1));
+		Real sum = weights.sum();
+		if (!std::isfinite(sum) || sum == 0)
+			return false;
+
+		limit = Matrix::Zero(states[0].rows(), 1);
+		for (Eigen::Index i = 0; i < numDiffs; ++i)
+			limit += (weights(i, 0) / sum) * states[i+1];
+		return limit.allFinite();
+	}
+}
 
 template <typename VarType>
 MnaSolver<VarType>::MnaSolver(String name, CPS::Domain domain, CPS::Logger::Level logLevel) :
@@ -43,6 +140,9 @@ void MnaSolver<VarType>::initialize() {
 		SPDLOG_LOGGER_INFO(mSLog, "Computing network harmonics in parallel.");
 		for(Int freq = 0; freq < mSystem.mFrequencies.size(); ++freq) {
 			mLeftSideVectorHarm.push_back(AttributeStatic<Matrix>::make());
+			// One logger per frequency, so that the frequencies are logged in parallel
+			mLeftVectorHarmLogs.push_back(std::make_shared<DataLogger>(
+				mName + "_LeftVector_" + std::to_string(freq), mLogLevel != CPS::Logger::Level::off));
 		}
 	}
 	else {
@@ -67,6 +167,8 @@ void MnaSolver<VarType>::initialize() {
 	SPDLOG_LOGGER_INFO(mSLog, "-- Create empty MNA system matrices and vectors");
 	createEmptyVectors();
 	createEmptySystemMatrix();
+	if (!mFrequencyParallel)
+		collectNodeVoltageGather();
 
 	// Initialize components from powerflow solution and
 	// calculate MNA specific initialization values.
@@ -105,26 +207,27 @@ void MnaSolver<Real>::initializeComponents() {
 	allMNAComps.insert(allMNAComps.end(), mMNAComponents.begin(), mMNAComponents.end());
 	allMNAComps.insert(allMNAComps.end(), mMNAIntfVariableComps.begin(), mMNAIntfVariableComps.end());
 
-	for (auto comp : allMNAComps) {
+	// The components only read the nodes and terminals and write their own state,
+	// so each phase can run in parallel after the previous one.
+	forEachComponent(allMNAComps, mParallelComponentInitialization, mExecutor.get(), [this](const MNAInterface::Ptr& comp) {
 		auto pComp = std::dynamic_pointer_cast<SimPowerComp<Real>>(comp);
-		if (!pComp)	continue;
+		if (!pComp)	return;
 		pComp->checkForUnconnectedTerminals();
 		if (mInitFromNodesAndTerminals)
 			pComp->initializeFromNodesAndTerminals(mSystem.mSystemFrequency);
-	}
+	});
 
 	// Initialize signal components.
-	for (auto comp : mSimSignalComps)
+	forEachComponent(mSimSignalComps, mParallelComponentInitialization, mExecutor.get(), [this](const SimSignalComp::Ptr& comp) {
 		comp->initialize(mSystem.mSystemOmega, mTimeStep);
+	});
 
 	// Initialize MNA specific parts of components.
-	for (auto comp : allMNAComps) {
+	forEachComponent(allMNAComps, mParallelComponentInitialization, mExecutor.get(), [this](const MNAInterface::Ptr& comp) {
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
-		const Matrix& stamp = comp->getRightVector()->get();
-		if (stamp.size() != 0) {
-			mRightVectorStamps.push_back(&stamp);
-		}
-	}
+	});
+	for (auto comp : allMNAComps)
+		collectRightVectorStamp(comp);
 
 	for (auto comp : mMNAIntfSwitches)
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
@@ -139,17 +242,18 @@ void MnaSolver<Complex>::initializeComponents() {
 	allMNAComps.insert(allMNAComps.end(), mMNAIntfVariableComps.begin(), mMNAIntfVariableComps.end());
 
 	// Initialize power components with frequencies and from powerflow results
-	for (auto comp : allMNAComps) {
+	forEachComponent(allMNAComps, mParallelComponentInitialization, mExecutor.get(), [this](const MNAInterface::Ptr& comp) {
 		auto pComp = std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp);
-		if (!pComp)	continue;
+		if (!pComp)	return;
 		pComp->checkForUnconnectedTerminals();
 		if (mInitFromNodesAndTerminals)
 			pComp->initializeFromNodesAndTerminals(mSystem.mSystemFrequency);
-	}
+	});
 
 	// Initialize signal components.
-	for (auto comp : mSimSignalComps)
+	forEachComponent(mSimSignalComps, mParallelComponentInitialization, mExecutor.get(), [this](const SimSignalComp::Ptr& comp) {
 		comp->initialize(mSystem.mSystemOmega, mTimeStep);
+	});
 
 	SPDLOG_LOGGER_INFO(mSLog, "-- Initialize MNA properties of components");
 	if (mFrequencyParallel) {
@@ -167,19 +271,142 @@ void MnaSolver<Complex>::initializeComponents() {
 	}
 	else {
 		// Initialize MNA specific parts of components.
-		for (auto comp : allMNAComps) {
+		forEachComponent(allMNAComps, mParallelComponentInitialization, mExecutor.get(), [this](const MNAInterface::Ptr& comp) {
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
-			const Matrix& stamp = comp->getRightVector()->get();
-			if (stamp.size() != 0) {
-				mRightVectorStamps.push_back(&stamp);
-			}
-		}
+		});
+		for (auto comp : allMNAComps)
+			collectRightVectorStamp(comp);
 
 		for (auto comp : mMNAIntfSwitches)
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
 	}
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::collectRightVectorStamp(CPS::MNAInterface::Ptr comp) {
+	const Matrix& stamp = comp->getRightVector()->get();
+	if (stamp.size() == 0)
+		return;
+	mRightVectorStamps.push_back(&stamp);
+
+	std::vector<UInt> rows;
+	if (!mSparseRightVectorAssembly || !comp->mnaRightVectorStampRows(rows)) {
+		mRightVectorDenseStamps.push_back(&stamp);
+		return;
+	}
+
+	std::sort(rows.begin(), rows.end());
+	rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+	for (auto row : rows) {
+		if (row < static_cast<UInt>(stamp.rows()))
+			mRightVectorScatter.push_back(std::make_pair(&stamp, row));
+	}
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::assembleRightSideVector() {
+	// Reset source vector
+	mRightSideVector.setZero();
+
+	// Add together the right side vector (computed by the components'
+	// pre-step tasks)
+	if (mSparseRightVectorAssembly) {
+		for (const auto& entry : mRightVectorScatter)
+			mRightSideVector(entry.second, 0) += (*entry.first)(entry.second, 0);
+		for (auto stamp : mRightVectorDenseStamps)
+			mRightSideVector += *stamp;
+	} else {
+		for (auto stamp : mRightVectorStamps)
+			mRightSideVector += *stamp;
+	}
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::collectNodeVoltageGather() {
+	mNodeVoltages.clear();
+	mNodeVoltageGather.clear();
+
+	// Same layout as Math::complexFromVectorElement
+	const Matrix::Index numFreqs = std::is_same<VarType, Complex>::value ? mSystem.mFrequencies.size() : 1;
+	const Matrix::Index harmonicOffset = (**mLeftSideVector).rows() / numFreqs;
+	const Matrix::Index complexOffset = harmonicOffset / 2;
+
+	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx) {
+		UInt node = static_cast<UInt>(mNodeVoltages.size());
+		mNodeVoltages.push_back(mNodes[nodeIdx]->mVoltage);
+
+		std::vector<UInt> rows = mNodes[nodeIdx]->mnaVoltageRows();
+		for (Matrix::Index freq = 0; freq < numFreqs; ++freq) {
+			for (UInt phase = 0; phase < rows.size(); ++phase) {
+				Matrix::Index realRow = rows[phase] + harmonicOffset * freq;
+				mNodeVoltageGather.push_back({ node, phase, static_cast<UInt>(freq), realRow, realRow + complexOffset });
+			}
+		}
+	}
+	SPDLOG_LOGGER_INFO(mSLog, "Gathering {} node voltage entries from the solution vector", mNodeVoltageGather.size());
+
+	// Observed nodes take their fundamental voltage per phase, complex values as real and imaginary part
+	mObservedGather.clear();
+	if (!mObservedValues.getPtr())
+		return;
+	for (auto& entry : mNodeVoltageGather) {
+		if (entry.col != 0)
+			continue;
+		const String& name = mNodes[entry.node]->name();
+		for (auto& [observed, row] : mObservedNodes) {
+			if (observed != name)
+				continue;
+			if (std::is_same<VarType, Complex>::value) {
+				mObservedGather.emplace_back(entry.realRow, row + 2 * entry.row);
+				mObservedGather.emplace_back(entry.imagRow, row + 2 * entry.row + 1);
+			} else {
+				mObservedGather.emplace_back(entry.realRow, row + entry.row);
+			}
+		}
+	}
+	SPDLOG_LOGGER_INFO(mSLog, "Gathering {} observed values from the solution vector", mObservedGather.size());
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::updateObservedValues() {
+	if (mObservedGather.empty())
+		return;
+	const Matrix& leftVector = **mLeftSideVector;
+	Matrix& values = **mObservedValues;
+	for (auto& [solutionRow, row] : mObservedGather)
+		values(row, 0) = leftVector(solutionRow, 0);
+}
+
+template <>
+void MnaSolver<Real>::updateNodeVoltages() {
+	const Matrix& leftVector = **mLeftSideVector;
+	UInt node = static_cast<UInt>(mNodeVoltages.size());
+	Matrix* voltage = nullptr;
+	for (auto& entry : mNodeVoltageGather) {
+		if (entry.node != node) {
+			node = entry.node;
+			voltage = &**mNodeVoltages[node];
+		}
+		(*voltage)(entry.row, entry.col) = leftVector(entry.realRow, 0);
+	}
+	updateObservedValues();
+}
+
+template <>
+void MnaSolver<Complex>::updateNodeVoltages() {
+	const Matrix& leftVector = **mLeftSideVector;
+	UInt node = static_cast<UInt>(mNodeVoltages.size());
+	MatrixComp* voltage = nullptr;
+	for (auto& entry : mNodeVoltageGather) {
+		if (entry.node != node) {
+			node = entry.node;
+			voltage = &**mNodeVoltages[node];
+		}
+		(*voltage)(entry.row, entry.col) = Complex(leftVector(entry.realRow, 0), leftVector(entry.imagRow, 0));
+	}
+	updateObservedValues();
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::initializeSystem() {
 	SPDLOG_LOGGER_INFO(mSLog, "-- Initialize MNA system matrices and source vector");
@@ -221,19 +448,27 @@ void MnaSolver<VarType>::initializeSystemWithParallelFrequencies() {
 
 template <typename VarType>
 void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
-	// iterate over all possible switch state combinations
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-		switchedMatrixEmpty(i);
+	if (mLazySwitchedMatrices && mSwitches.size() > 0) {
+		// Only build the matrix of the initial switch state,
+		// other states are factorized when they occur first
+		updateSwitchStatus();
+		switchedMatrixRequest(mCurrentSwitchStatus.to_ullong());
 	}
-
-	if (mSwitches.size() < 1) {
+	else if (mSwitches.size() < 1) {
+		switchedMatrixEmpty(0);
 		switchedMatrixStamp(0, mMNAComponents);
 	}
 	else {
-		// Generate switching state dependent system matrices
-		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
+		// Generate switching state dependent system matrices. The first state
+		// creates what the factorizations share, e.g. a common symbolic analysis.
+		switchedMatrixEmpty(0);
+		switchedMatrixStamp(0, mMNAComponents);
+		std::vector<std::size_t> states((1ULL << mSwitches.size()) - 1);
+		std::iota(states.begin(), states.end(), 1);
+		forEachComponent(states, mParallelSwitchedMatrixInitialization, mExecutor.get(), [this](std::size_t i) {
+			switchedMatrixEmpty(i);
 			switchedMatrixStamp(i, mMNAComponents);
-		}
+		});
 		updateSwitchStatus();
 	}
 
@@ -291,11 +526,34 @@ Bool MnaSolver<VarType>::hasVariableComponentChanged() {
 	return false;
 }
 
+template <typename VarType>
+Bool MnaSolver<VarType>::correctIterativeComponents() {
+	Bool converged = true;
+	// All components are corrected, also after the first one that did not converge
+	for (auto comp : mIterativeComps)
+		converged &= comp->mnaCorrectorStep(**mLeftSideVector);
+	return converged;
+}
+
+template <typename VarType>
+CPS::AttributeBase::Map MnaSolver<VarType>::stateAttributes() {
+	CPS::AttributeBase::Map attributes;
+	if (mLeftSideVector.getPtr())
+		attributes["left_vector"] = mLeftSideVector;
+	for (UInt freq = 0; freq < mLeftSideVectorHarm.size(); ++freq)
+		attributes["left_vector_" + std::to_string(freq)] = mLeftSideVectorHarm[freq];
+	return attributes;
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::updateSwitchStatus() {
+	auto previous = mCurrentSwitchStatus;
 	for (UInt i = 0; i < mSwitches.size(); ++i) {
 		mCurrentSwitchStatus.set(i, mSwitches[i]->mnaIsClosed());
 	}
+	if (mEventLog && previous != mCurrentSwitchStatus)
+		mEventLog->record(EventLog::Type::SwitchChange, static_cast<uint32_t>(mCurrentSwitchStatus.to_ullong()),
+			static_cast<double>(previous.to_ullong()));
 }
 
 template <typename VarType>
@@ -309,36 +567,66 @@ void MnaSolver<VarType>::identifyTopologyObjects() {
 		}
 	}
 
-	for (auto comp : mSystem.mComponents) {
+	for (auto comp : mSystem.mComponents)
+		identifyComponent(comp);
+}
 
-		auto swComp = std::dynamic_pointer_cast<CPS::MNASwitchInterface>(comp);
-		if (swComp) {
-			mSwitches.push_back(swComp);
-			auto mnaComp = std::dynamic_pointer_cast<CPS::MNAInterface>(swComp);
-			if (mnaComp) mMNAIntfSwitches.push_back(mnaComp);
-		}
+template <typename VarType>
+void MnaSolver<VarType>::identifyComponent(CPS::IdentifiedObject::Ptr comp) {
+	auto swComp = std::dynamic_pointer_cast<CPS::MNASwitchInterface>(comp);
+	if (swComp) {
+		mSwitches.push_back(swComp);
+		auto mnaComp = std::dynamic_pointer_cast<CPS::MNAInterface>(swComp);
+		if (mnaComp) mMNAIntfSwitches.push_back(mnaComp);
+	}
 
-		auto varComp = std::dynamic_pointer_cast<CPS::MNAVariableCompInterface>(comp);
-		if (varComp) {
-			mVariableComps.push_back(varComp);
-			auto mnaComp = std::dynamic_pointer_cast<CPS::MNAInterface>(varComp);
-			if (mnaComp) mMNAIntfVariableComps.push_back(mnaComp);
-		}
+	auto varComp = std::dynamic_pointer_cast<CPS::MNAVariableCompInterface>(comp);
+	if (varComp) {
+		mVariableComps.push_back(varComp);
+		auto mnaComp = std::dynamic_pointer_cast<CPS::MNAInterface>(varComp);
+		if (mnaComp) mMNAIntfVariableComps.push_back(mnaComp);
+	}
 
-		if (!(swComp || varComp)) {
-			auto mnaComp = std::dynamic_pointer_cast<CPS::MNAInterface>(comp);
-			if (mnaComp) mMNAComponents.push_back(mnaComp);
+	auto iterComp = std::dynamic_pointer_cast<CPS::MNAIterativeCompInterface>(comp);
+	if (iterComp && iterComp->mnaIsIterative())
+		mIterativeComps.push_back(iterComp);
 
-			auto sigComp = std::dynamic_pointer_cast<CPS::SimSignalComp>(comp);
-			if (sigComp) mSimSignalComps.push_back(sigComp);
-		}
+	if (!(swComp || varComp)) {
+		auto mnaComp = std::dynamic_pointer_cast<CPS::MNAInterface>(comp);
+		if (mnaComp) mMNAComponents.push_back(mnaComp);
+
+		auto sigComp = std::dynamic_pointer_cast<CPS::SimSignalComp>(comp);
+		if (sigComp) mSimSignalComps.push_back(sigComp);
 	}
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::forgetComponent(CPS::IdentifiedObject::Ptr comp) {
+	auto erase = [&comp](auto& list) {
+		list.erase(std::remove_if(list.begin(), list.end(), [&comp](const auto& entry) {
+			return std::dynamic_pointer_cast<CPS::IdentifiedObject>(entry) == comp;
+		}), list.end());
+	};
+	erase(mSwitches);
+	erase(mMNAIntfSwitches);
+	erase(mVariableComps);
+	erase(mMNAIntfVariableComps);
+	erase(mIterativeComps);
+	erase(mMNAComponents);
+	erase(mSimSignalComps);
+	erase(mSystem.mComponents);
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::assignMatrixNodeIndices() {
+	std::vector<UInt> order(mNodes.size());
+	std::iota(order.begin(), order.end(), 0);
+	if (mMatrixNodeReordering)
+		order = computeNodeOrder();
+
 	UInt matrixNodeIndexIdx = 0;
-	for (UInt idx = 0; idx < mNodes.size(); ++idx) {
+	mNumNetMatrixNodeIndices = 0;
+	for (UInt idx : order) {
 		mNodes[idx]->setMatrixNodeIndex(0, matrixNodeIndexIdx);
 		SPDLOG_LOGGER_INFO(mSLog, "Assigned index {} to phase A of node {}", matrixNodeIndexIdx, idx);
 		++matrixNodeIndexIdx;
@@ -350,8 +638,9 @@ void MnaSolver<VarType>::assignMatrixNodeIndices() {
 			SPDLOG_LOGGER_INFO(mSLog, "Assigned index {} to phase C of node {}", matrixNodeIndexIdx, idx);
 			++matrixNodeIndexIdx;
 		}
-		// This should be true when the final network node is reached, not considering virtual nodes
-		if (idx == mNumNetNodes-1) mNumNetMatrixNodeIndices = matrixNodeIndexIdx;
+		// Network nodes come before the virtual nodes in the node list
+		if (idx < mNumNetNodes)
+			mNumNetMatrixNodeIndices += mNodes[idx]->phaseType() == CPS::PhaseType::ABC ? 3 : 1;
 	}
 	// Total number of network nodes including virtual nodes is matrixNodeIndexIdx + 1, which is why the variable is incremented after assignment
 	mNumMatrixNodeIndices = matrixNodeIndexIdx;
@@ -376,7 +665,8 @@ void MnaSolver<Complex>::createEmptyVectors() {
 	if (mFrequencyParallel) {
 		for(Int freq = 0; freq < mSystem.mFrequencies.size(); ++freq) {
 			mRightSideVectorHarm.push_back(Matrix::Zero(2*(mNumMatrixNodeIndices), 1));
-			mLeftSideVectorHarm.push_back(AttributeStatic<Matrix>::make(Matrix::Zero(2*(mNumMatrixNodeIndices), 1)));
+			// The attributes are created by initialize, the tasks refer to them by frequency
+			**mLeftSideVectorHarm[freq] = Matrix::Zero(2*(mNumMatrixNodeIndices), 1);
 		}
 	}
 	else {
@@ -385,6 +675,92 @@ void MnaSolver<Complex>::createEmptyVectors() {
 	}
 }
 
+template <typename VarType>
+std::vector<UInt> MnaSolver<VarType>::computeNodeOrder() {
+	std::map<CPS::TopologicalNode::Ptr, UInt> nodePositions;
+	for (UInt idx = 0; idx < mNodes.size(); ++idx)
+		nodePositions[mNodes[idx]] = idx;
+
+	// Nodes of the same component are connected in the system matrix
+	std::vector<std::set<UInt>> neighbours(mNodes.size());
+	auto connect = [&nodePositions, &neighbours](CPS::IdentifiedObject::Ptr comp) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (!pComp)
+			return;
+		std::vector<UInt> positions;
+		for (UInt t = 0; t < pComp->terminalNumberConnected(); ++t) {
+			auto it = nodePositions.find(pComp->node(t));
+			if (it != nodePositions.end())
+				positions.push_back(it->second);
+		}
+		for (UInt node = 0; node < pComp->virtualNodesNumber(); ++node) {
+			auto it = nodePositions.find(pComp->virtualNode(node));
+			if (it != nodePositions.end())
+				positions.push_back(it->second);
+		}
+		if (pComp->hasSubComponents()) {
+			for (auto pSubComp : pComp->subComponents()) {
+				for (UInt node = 0; node < pSubComp->virtualNodesNumber(); ++node) {
+					auto it = nodePositions.find(pSubComp->virtualNode(node));
+					if (it != nodePositions.end())
+						positions.push_back(it->second);
+				}
+			}
+		}
+		for (auto k : positions)
+			for (auto l : positions)
+				if (k != l)
+					neighbours[k].insert(l);
+	};
+	for (auto comp : mSystem.mComponents)
+		connect(comp);
+
+	// Breadth-first search from nodes of minimum degree, visiting the
+	// neighbours in the order of increasing degree
+	std::vector<UInt> byDegree(mNodes.size());
+	std::iota(byDegree.begin(), byDegree.end(), 0);
+	std::stable_sort(byDegree.begin(), byDegree.end(), [&neighbours](UInt a, UInt b) {
+		return neighbours[a].size() < neighbours[b].size();
+	});
+	std::vector<UInt> order;
+	std::vector<Bool> visited(mNodes.size(), false);
+	for (UInt start : byDegree) {
+		if (visited[start])
+			continue;
+		visited[start] = true;
+		UInt head = static_cast<UInt>(order.size());
+		order.push_back(start);
+		while (head < order.size()) {
+			std::vector<UInt> next;
+			for (UInt neighbour : neighbours[order[head++]]) {
+				if (!visited[neighbour]) {
+					visited[neighbour] = true;
+					next.push_back(neighbour);
+				}
+			}
+			std::stable_sort(next.begin(), next.end(), [&neighbours](UInt a, UInt b) {
+				return neighbours[a].size() < neighbours[b].size();
+			});
+			order.insert(order.end(), next.begin(), next.end());
+		}
+	}
+	std::reverse(order.begin(), order.end());
+
+	UInt bandwidth = 0, reorderedBandwidth = 0;
+	std::vector<UInt> positions(mNodes.size());
+	for (UInt pos = 0; pos < order.size(); ++pos)
+		positions[order[pos]] = pos;
+	for (UInt k = 0; k < mNodes.size(); ++k) {
+		for (UInt l : neighbours[k]) {
+			bandwidth = std::max(bandwidth, l > k ? l - k : k - l);
+			reorderedBandwidth = std::max(reorderedBandwidth,
+				positions[l] > positions[k] ? positions[l] - positions[k] : positions[k] - positions[l]);
+		}
+	}
+	SPDLOG_LOGGER_INFO(mSLog, "Reordered matrix node indices, node bandwidth {} instead of {}", reorderedBandwidth, bandwidth);
+	return order;
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::collectVirtualNodes() {
 	// We have not added virtual nodes yet so the list has only network nodes
@@ -457,6 +833,8 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 	Real max = 1.0;
 	Matrix diff = Matrix::Zero(2 * mNumNodes, 1);
 	Matrix prevLeftSideVector = Matrix::Zero(2 * mNumNodes, 1);
+	std::vector<Matrix> extrapolationStates;
+	UInt numExtrapolations = 0;
 
 	SPDLOG_LOGGER_INFO(mSLog, "Time step is {:f}s for steady-state initialization", initTimeStep);
 
@@ -523,9 +901,25 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 		// If difference is smaller than some epsilon, break
 		if ((maxDiff / max) < mSteadStIniAccLimit)
 			break;
+
+		// Continue from the extrapolated steady state of the last steps
+		if (mSteadStIniExtrapolationDepth > 0) {
+			extrapolationStates.push_back(steadyStateInitializationState());
+			if (extrapolationStates.size() == mSteadStIniExtrapolationDepth + 2) {
+				Matrix limit;
+				if (reducedRankExtrapolation(extrapolationStates, limit)) {
+					setSteadyStateInitializationState(limit);
+					prevLeftSideVector = **mLeftSideVector;
+					++numExtrapolations;
+				}
+				extrapolationStates.clear();
+			}
+		}
 	}
 
 	SPDLOG_LOGGER_INFO(mSLog, "Max difference: {:f} or {:f}% at time {:f}", maxDiff, maxDiff / max, time);
+	if (mSteadStIniExtrapolationDepth > 0)
+		SPDLOG_LOGGER_INFO(mSLog, "Extrapolated the steady state {} times in {} steps", numExtrapolations, timeStepCount);
 
 	// Reset system for actual simulation
 	mRightSideVector.setZero();
@@ -533,6 +927,88 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 	SPDLOG_LOGGER_INFO(mSLog, "--- Finished steady-state initialization ---");
 }
 
+template <typename VarType>
+Matrix MnaSolver<VarType>::steadyStateInitializationState() {
+	std::vector<Real> state;
+	appendState(state, **mLeftSideVector);
+	for (auto comp : mMNAComponents) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (!pComp)
+			continue;
+		appendState(state, **pComp->mIntfVoltage);
+		appendState(state, **pComp->mIntfCurrent);
+	}
+	return Eigen::Map<Matrix>(state.data(), static_cast<Eigen::Index>(state.size()), 1);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::setSteadyStateInitializationState(const Matrix& state) {
+	const Real* values = state.data();
+	readState(values, **mLeftSideVector);
+	for (auto comp : mMNAComponents) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (!pComp)
+			continue;
+		readState(values, **pComp->mIntfVoltage);
+		readState(values, **pComp->mIntfCurrent);
+	}
+}
+
+template <typename VarType>
+Matrix MnaSolver<VarType>::interpolationState() {
+	std::vector<Real> state;
+	appendState(state, **mLeftSideVector);
+	for (auto comp : mInterpolatedComps) {
+		appendState(state, **comp->mIntfVoltage);
+		appendState(state, **comp->mIntfCurrent);
+	}
+	return Eigen::Map<Matrix>(state.data(), static_cast<Eigen::Index>(state.size()), 1);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::setInterpolationState(const Matrix& state) {
+	const Real* values = state.data();
+	readState(values, **mLeftSideVector);
+	for (auto comp : mInterpolatedComps) {
+		readState(values, **comp->mIntfVoltage);
+		readState(values, **comp->mIntfCurrent);
+	}
+}
+
+template <typename VarType>
+Bool MnaSolver<VarType>::supportsStateInterpolation() {
+	if (mFrequencyParallel) {
+		SPDLOG_LOGGER_ERROR(mSLog, "State interpolation does not support frequency parallelization");
+		return false;
+	}
+
+	// The companion models keep their history in the interface voltage and current
+	mInterpolatedComps.clear();
+	std::function<void(typename SimPowerComp<VarType>::Ptr)> collect = [&](typename SimPowerComp<VarType>::Ptr comp) {
+		mInterpolatedComps.push_back(comp);
+		for (auto subComp : comp->subComponents())
+			collect(subComp);
+	};
+	for (auto comp : mMNAComponents) {
+		if (auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp))
+			collect(pComp);
+	}
+	for (auto comp : mMNAIntfSwitches) {
+		if (auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp))
+			collect(pComp);
+	}
+	SPDLOG_LOGGER_INFO(mSLog, "Interpolating the interface voltages and currents of {} components, "
+		"other component states are assumed to follow the solution", mInterpolatedComps.size());
+	return true;
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::interpolateState(Real weight) {
+	Matrix present = interpolationState();
+	setInterpolationState(mSavedState + weight * (present - mSavedState));
+	updateNodeVoltages();
+}
+
 template <typename VarType>
 Task::List MnaSolver<VarType>::getTasks() {
 	Task::List l;
@@ -552,14 +1028,29 @@ Task::List MnaSolver<VarType>::getTasks() {
 			l.push_back(task);
 	}
 	// TODO signal components should be moved out of MNA solver
+	Task::List signalTasks;
 	for (auto comp : mSimSignalComps) {
 		for (auto task : comp->getTasks()) {
-			l.push_back(task);
+			signalTasks.push_back(task);
 		}
 	}
+	Task::Ptr signalGraph;
+	if (mSignalGraphFusion && signalTasks.size() > 1) {
+		signalGraph = Scheduler::fuseTaskGraph(signalTasks);
+		if (!signalGraph)
+			SPDLOG_LOGGER_WARN(mSLog, "Signal components have cyclic dependencies, their tasks are not fused");
+		else
+			SPDLOG_LOGGER_INFO(mSLog, "Fused {} signal component tasks into one task", signalTasks.size());
+	}
+	if (signalGraph)
+		l.push_back(signalGraph);
+	else
+		l.insert(l.end(), signalTasks.begin(), signalTasks.end());
 	if (mFrequencyParallel) {
-		for (UInt i = 0; i < mSystem.mFrequencies.size(); ++i)
+		for (UInt i = 0; i < mSystem.mFrequencies.size(); ++i) {
 			l.push_back(createSolveTaskHarm(i));
+			l.push_back(createLogTaskHarm(i));
+		}
 	} else if (mSystemMatrixRecomputation) {
 		for (auto comp : this->mMNAIntfVariableComps) {
 			for (auto task : comp->mnaTasks())
@@ -567,7 +1058,8 @@ Task::List MnaSolver<VarType>::getTasks() {
 		}
 		l.push_back(createSolveTaskRecomp());
 	} else {
-		l.push_back(createSolveTask());
+		for (auto task : createSolveTasks())
+			l.push_back(task);
 		l.push_back(createLogTask());
 	}
 	return l;
@@ -589,6 +1081,14 @@ void MnaSolver<VarType>::log(Real time, Int timeStepCount) {
 	}
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::logHarm(Real time, Int timeStepCount, UInt freqIdx) {
+	if (mLogLevel == Logger::Level::off)
+		return;
+
+	mLeftVectorHarmLogs[freqIdx]->logPhasorNodeValues(time, **mLeftSideVectorHarm[freqIdx]);
+}
+
 }
 
 template class DPsim::MnaSolver<Real>;
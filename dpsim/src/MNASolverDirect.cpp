@@ -8,6 +8,12 @@
 
 #include <dpsim/MNASolverDirect.h>
 #include <dpsim/SequentialScheduler.h>
+#include <algorithm>
+#include <set>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <type_traits>
 
 using namespace DPsim;
 using namespace CPS;
@@ -22,7 +28,8 @@ MnaSolverDirect<VarType>::MnaSolverDirect(String name, CPS::Domain domain, CPS::
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::switchedMatrixEmpty(std::size_t index) {
-	mSwitchedMatrices[std::bitset<SWITCH_NUM>(index)][0].setZero();
+	// The states may be stamped concurrently, so the maps are not modified
+	mSwitchedMatrices.at(std::bitset<SWITCH_NUM>(index))[0].setZero();
 }
 
 template <typename VarType>
@@ -34,20 +41,228 @@ template <typename VarType>
 void MnaSolverDirect<VarType>::switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp)
 {
 	auto bit = std::bitset<SWITCH_NUM>(index);
-	auto& sys = mSwitchedMatrices[bit][0];
+	auto& sys = mSwitchedMatrices.at(bit)[0];
+	auto& solver = *mDirectLinearSolvers.at(bit)[0];
 	for (auto component : comp) {
 		component->mnaApplySystemMatrixStamp(sys);
 	}
 	for (UInt i = 0; i < mSwitches.size(); ++i)
 		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sys, 0);
+	stampFreeMatrixRows(sys);
 
 	// Compute LU-factorization for system matrix
-	mDirectLinearSolvers[bit][0]->preprocessing(sys, mListVariableSystemMatrixEntries);
+	if (mSharedSymbolicAnalysis && !mSharedAnalysis && !mSwitches.empty() && mListVariableSystemMatrixEntries.empty())
+		createSharedAnalysis(sys);
+	preprocessSwitchedMatrix(sys, solver, mSharedAnalysis.get());
 	auto start = std::chrono::steady_clock::now();
-	mDirectLinearSolvers[bit][0]->factorize(sys);
+	solver.factorize(sys);
 	auto end = std::chrono::steady_clock::now();
 	std::chrono::duration<Real> diff = end-start;
-	mFactorizeTimes.push_back(diff.count());
+	std::lock_guard<std::mutex> lock(mFactorizeTimesMutex);
+	mFactorizeTimes.record(diff.count());
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::createSharedAnalysis(const SparseMatrix& sys) {
+	auto analysis = std::make_shared<SharedSymbolicAnalysis>();
+	analysis->pattern = SparseMatrix(sys.rows(), sys.cols());
+	for (auto component : mMNAComponents)
+		component->mnaApplySystemMatrixStamp(analysis->pattern);
+	for (UInt i = 0; i < mSwitches.size(); ++i) {
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(true, analysis->pattern, 0);
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(false, analysis->pattern, 0);
+	}
+	stampFreeMatrixRows(analysis->pattern);
+	analysis->pattern.makeCompressed();
+	analysis->pattern.coeffs().setZero();
+
+	analysis->solver = createDirectSolverImplementation(mSLog);
+	analysis->solver->preprocessing(analysis->pattern, mListVariableSystemMatrixEntries);
+	mSharedAnalysis = analysis;
+	SPDLOG_LOGGER_INFO(mSLog, "Shared symbolic analysis of the switched system matrices with {:d} nonzeros",
+		analysis->pattern.nonZeros());
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::preprocessSwitchedMatrix(SparseMatrix& sys, DirectLinearSolver& solver,
+	const SharedSymbolicAnalysis* analysis) {
+	if (analysis) {
+		// The explicit zeros of the pattern are kept by the sparse sum
+		sys += analysis->pattern;
+		sys.makeCompressed();
+		if (solver.adoptSymbolicAnalysis(*analysis->solver, sys))
+			return;
+	}
+	solver.preprocessing(sys, mListVariableSystemMatrixEntries);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::switchedMatrixStamp(std::size_t swIdx, Int freqIdx, CPS::MNAInterface::List& components, CPS::MNASwitchInterface::List& switches)
+{
+	auto bit = std::bitset<SWITCH_NUM>(swIdx);
+	auto& sys = mSwitchedMatrices[bit][freqIdx];
+	for (auto comp : components)
+		comp->mnaApplySystemMatrixStampHarm(sys, freqIdx);
+	for (UInt i = 0; i < switches.size(); ++i)
+		switches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sys, freqIdx);
+	sys.makeCompressed();
+
+	UInt numFreqs = static_cast<UInt>(mSwitchedMatrices[bit].size());
+	auto& groups = mFrequencyGroups[bit];
+	groups.resize(numFreqs);
+	groups[freqIdx].clear();
+	mRightSideVectorBatch.resize(numFreqs);
+	mLeftSideVectorBatch.resize(numFreqs);
+	mHarmonicSelections.resize(numFreqs);
+
+	// Frequencies with identical system matrices share one factorization and are solved together
+	for (Int leader = 0; leader < freqIdx; ++leader) {
+		if (groups[leader].empty() || groups[leader][0] != static_cast<UInt>(leader))
+			continue;
+		auto& leaderSys = mSwitchedMatrices[bit][leader];
+		if (leaderSys.nonZeros() == sys.nonZeros()
+			&& std::equal(sys.outerIndexPtr(), sys.outerIndexPtr() + sys.outerSize() + 1, leaderSys.outerIndexPtr())
+			&& std::equal(sys.innerIndexPtr(), sys.innerIndexPtr() + sys.nonZeros(), leaderSys.innerIndexPtr())
+			&& std::equal(sys.valuePtr(), sys.valuePtr() + sys.nonZeros(), leaderSys.valuePtr())) {
+			groups[leader].push_back(freqIdx);
+			mDirectLinearSolvers[bit][freqIdx] = mDirectLinearSolvers[bit][leader];
+			SPDLOG_LOGGER_DEBUG(mSLog, "System matrix for frequency {:d} equals frequency {:d}, sharing factorization", freqIdx, leader);
+			return;
+		}
+	}
+	groups[freqIdx].push_back(freqIdx);
+
+	// Do not refactorize a linear solver shared with another frequency
+	for (Int other = 0; other < static_cast<Int>(numFreqs); ++other) {
+		if (other != freqIdx && mDirectLinearSolvers[bit][other] == mDirectLinearSolvers[bit][freqIdx]) {
+			mDirectLinearSolvers[bit][freqIdx] = createDirectSolverImplementation(mSLog);
+			break;
+		}
+	}
+
+	// Compute LU-factorization for system matrix
+	mDirectLinearSolvers[bit][freqIdx]->preprocessing(sys, mListVariableSystemMatrixEntries);
+	auto start = std::chrono::steady_clock::now();
+	mDirectLinearSolvers[bit][freqIdx]->factorize(sys);
+	auto end = std::chrono::steady_clock::now();
+	std::chrono::duration<Real> diff = end-start;
+	mFactorizeTimes.record(diff.count());
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::switchedMatrixRequest(std::size_t index) {
+	auto bit = std::bitset<SWITCH_NUM>(index);
+	if (!mSwitchedMatrixCacheOrder.empty() && mSwitchedMatrixCacheOrder.front() == bit)
+		return;
+
+	auto cached = std::find(mSwitchedMatrixCacheOrder.begin(), mSwitchedMatrixCacheOrder.end(), bit);
+	if (cached != mSwitchedMatrixCacheOrder.end()) {
+		mSwitchedMatrixCacheOrder.splice(mSwitchedMatrixCacheOrder.begin(), mSwitchedMatrixCacheOrder, cached);
+		return;
+	}
+
+	if (mPrefetch && mPrefetch->status == bit) {
+		usePrefetch();
+		return;
+	}
+
+	SPDLOG_LOGGER_DEBUG(mSLog, "Factorizing system matrix for switch status {:s}", bit.to_string());
+	createEmptySwitchedMatrix(bit);
+	switchedMatrixEmpty(index);
+	switchedMatrixStamp(index, mMNAComponents);
+	mSwitchedMatrixCacheOrder.push_front(bit);
+	evictSwitchedMatrices();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::evictSwitchedMatrices() {
+	if (mSwitchedMatrixCacheSize > 0) {
+		while (mSwitchedMatrixCacheOrder.size() > std::max<UInt>(mSwitchedMatrixCacheSize, 1)) {
+			auto evicted = mSwitchedMatrixCacheOrder.back();
+			mSwitchedMatrices.erase(evicted);
+			mDirectLinearSolvers.erase(evicted);
+			mSwitchedMatrixCacheOrder.pop_back();
+		}
+	}
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::prefetchSwitchStates(const std::vector<SwitchChange>& changes) {
+	if (!mLazySwitchedMatrices || mSwitches.empty() || mSystemMatrixRecomputation || mFrequencyParallel)
+		return;
+
+	if (mSwitchStateIndices.empty()) {
+		for (UInt i = 0; i < mSwitches.size(); ++i) {
+			auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(mSwitches[i]);
+			if (!idObj)
+				continue;
+			auto state = idObj->attributes().find("is_closed");
+			if (state != idObj->attributes().end())
+				mSwitchStateIndices[state->second.getPtr().get()] = i;
+		}
+	}
+
+	auto bit = mCurrentSwitchStatus;
+	for (auto& change : changes) {
+		auto index = mSwitchStateIndices.find(change.state);
+		if (index != mSwitchStateIndices.end())
+			bit[index->second] = change.closed;
+	}
+	if (mSwitchedMatrices.count(bit) > 0 || (mPrefetch && mPrefetch->status == bit))
+		return;
+
+	// Only the latest upcoming status is kept
+	if (mPrefetch)
+		dropPrefetch();
+
+	SPDLOG_LOGGER_DEBUG(mSLog, "Prefetching system matrix for switch status {:s}", bit.to_string());
+	auto prefetch = std::make_unique<SwitchedMatrixPrefetch>();
+	prefetch->status = bit;
+	auto& current = mSwitchedMatrices[mCurrentSwitchStatus][0];
+	prefetch->matrix = SparseMatrix(current.rows(), current.cols());
+	prefetch->solver = createDirectSolverImplementation(mSLog);
+	// The task only touches the prefetch, the components are only read by their stamps
+	auto job = [this, p = prefetch.get(), analysis = mSharedAnalysis]() {
+		for (auto component : mMNAComponents)
+			component->mnaApplySystemMatrixStamp(p->matrix);
+		for (UInt i = 0; i < mSwitches.size(); ++i)
+			mSwitches[i]->mnaApplySwitchSystemMatrixStamp(p->status[i], p->matrix, 0);
+		stampFreeMatrixRows(p->matrix);
+		preprocessSwitchedMatrix(p->matrix, *p->solver, analysis.get());
+		auto start = std::chrono::steady_clock::now();
+		p->solver->factorize(p->matrix);
+		std::chrono::duration<Real> diff = std::chrono::steady_clock::now() - start;
+		p->factorizeTime = diff.count();
+	};
+	if (mExecutor)
+		prefetch->done = mExecutor->submit(job);
+	else
+		prefetch->done = std::async(std::launch::async, job);
+	mPrefetch = std::move(prefetch);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::usePrefetch() {
+	auto prefetch = std::move(mPrefetch);
+	prefetch->done.get();
+	mFactorizeTimes.record(prefetch->factorizeTime);
+
+	mSwitchedMatrices[prefetch->status] = { std::move(prefetch->matrix) };
+	mDirectLinearSolvers[prefetch->status] = { prefetch->solver };
+	mSwitchedMatrixCacheOrder.push_front(prefetch->status);
+	evictSwitchedMatrices();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::dropPrefetch() {
+	auto prefetch = std::move(mPrefetch);
+	prefetch->done.wait();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::discardPrefetch() {
+	if (mPrefetch)
+		dropPrefetch();
 }
 
 template <typename VarType>
@@ -66,8 +281,8 @@ void MnaSolverDirect<VarType>::stampVariableSystemMatrix() {
 	mBaseSystemMatrix.setZero();
 	for (auto statElem : mMNAComponents)
 		statElem->mnaApplySystemMatrixStamp(mBaseSystemMatrix);
-	SPDLOG_LOGGER_INFO(mSLog, "Base matrix with only static elements: {}", Logger::matrixToString(mBaseSystemMatrix));
-	mSLog->flush();
+	SPDLOG_LOGGER_INFO(mSLog, "Base matrix with only static elements: {}", Logger::sparseMatrixToString(mBaseSystemMatrix));
+	Logger::dumpMatrix(mName + "_base_matrix", mBaseSystemMatrix);
 
 	// Continue from base matrix
 	mVariableSystemMatrix = mBaseSystemMatrix;
@@ -82,9 +297,11 @@ void MnaSolverDirect<VarType>::stampVariableSystemMatrix() {
 	for (auto varElem : mMNAIntfVariableComps)
 		varElem->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
 
-	SPDLOG_LOGGER_INFO(mSLog, "Initial system matrix with variable elements {}", Logger::matrixToString(mVariableSystemMatrix));
-	/* TODO: find replacement for flush() */
-	mSLog->flush();
+	SPDLOG_LOGGER_INFO(mSLog, "Initial system matrix with variable elements {}", Logger::sparseMatrixToString(mVariableSystemMatrix));
+	Logger::dumpMatrix(mName + "_variable_matrix", mVariableSystemMatrix);
+
+	createVariablePattern();
+	initializeVariableStampSlots();
 
 	// Calculate factorization of current matrix
 	mDirectLinearSolverVariableSystemMatrix->preprocessing(mVariableSystemMatrix, mListVariableSystemMatrixEntries);
@@ -93,58 +310,388 @@ void MnaSolverDirect<VarType>::stampVariableSystemMatrix() {
 	mDirectLinearSolverVariableSystemMatrix->factorize(mVariableSystemMatrix);
 	auto end = std::chrono::steady_clock::now();
 	std::chrono::duration<Real> diff = end-start;
-	mFactorizeTimes.push_back(diff.count());
+	mFactorizeTimes.record(diff.count());
+
+	if (mLowRankSystemMatrixUpdates)
+		mFactorizedSystemMatrix = mVariableSystemMatrix;
+
+	if (mIncrementalSystemMatrixStamping)
+		initializeIncrementalStamps();
 }
 
 template <typename VarType>
-void MnaSolverDirect<VarType>::solveWithSystemMatrixRecomputation(Real time, Int timeStepCount) {
-	// Reset source vector
-	mRightSideVector.setZero();
+void MnaSolverDirect<VarType>::createVariablePattern() {
+	mVariablePattern = SparseMatrix(mBaseSystemMatrix.rows(), mBaseSystemMatrix.cols());
+	for (auto sw : mMNAIntfSwitches) {
+		if (auto switchComp = std::dynamic_pointer_cast<CPS::MNASwitchInterface>(sw)) {
+			switchComp->mnaApplySwitchSystemMatrixStamp(true, mVariablePattern, 0);
+			switchComp->mnaApplySwitchSystemMatrixStamp(false, mVariablePattern, 0);
+		}
+	}
+	for (auto& entry : mListVariableSystemMatrixEntries)
+		mVariablePattern.coeffRef(entry.first, entry.second) += 0.;
+	mVariablePattern.makeCompressed();
+	mVariablePattern.coeffs().setZero();
+	SPDLOG_LOGGER_INFO(mSLog, "Reserved {:d} entries of switches and variable elements in the system matrix",
+		mVariablePattern.nonZeros());
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::initializeVariableStampSlots() {
+	// The explicit zeros of the reserved pattern are kept by the sparse sum, so that
+	// entries flipping between zero and non-zero do not change the sparsity pattern
+	if (mVariablePattern.nonZeros() > 0)
+		mVariableSystemMatrix += mVariablePattern;
+	mVariableSystemMatrix.makeCompressed();
+
+	// Base values have to be aligned with the pattern of the variable matrix
+	mBaseSystemValues.clear();
+	for (Int row = 0; row < mVariableSystemMatrix.outerSize(); ++row) {
+		for (SparseMatrix::InnerIterator it(mVariableSystemMatrix, row); it; ++it)
+			mBaseSystemValues.push_back(mBaseSystemMatrix.coeff(it.row(), it.col()));
+	}
+	std::copy(mBaseSystemValues.begin(), mBaseSystemValues.end(), mVariableSystemMatrix.valuePtr());
+
+	mVariableStampSlots.record(mVariableSystemMatrix);
+	for (auto sw : mMNAIntfSwitches)
+		sw->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
+	for (auto varElem : mMNAIntfVariableComps)
+		varElem->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
+	mVariableStampSlots.stop();
+
+	// Stamps outside of the previous pattern invalidate the aligned base values
+	if (static_cast<std::size_t>(mVariableSystemMatrix.nonZeros()) != mBaseSystemValues.size())
+		mBaseSystemValues.clear();
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::restampVariableSystemMatrix() {
+	if (!mVariableStampSlots.valid() || mBaseSystemValues.empty()
+		|| static_cast<std::size_t>(mVariableSystemMatrix.nonZeros()) != mBaseSystemValues.size())
+		return false;
+
+	std::copy(mBaseSystemValues.begin(), mBaseSystemValues.end(), mVariableSystemMatrix.valuePtr());
+
+	mVariableStampSlots.replay(mVariableSystemMatrix);
+	for (auto sw : mMNAIntfSwitches)
+		sw->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
+	for (auto comp : mMNAIntfVariableComps)
+		comp->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
+	mVariableStampSlots.stop();
+
+	return mVariableStampSlots.valid();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::initializeIncrementalStamps() {
+	mIncrementalStamps.clear();
+	mVariableSystemMatrix.makeCompressed();
+
+	std::vector<IncrementalStamp> stamps;
+	for (auto sw : mMNAIntfSwitches) {
+		IncrementalStamp entry;
+		entry.comp = sw;
+		entry.varComp = std::dynamic_pointer_cast<CPS::MNAVariableCompInterface>(sw);
+		if (!entry.varComp) {
+			entry.switchComp = std::dynamic_pointer_cast<CPS::MNASwitchInterface>(sw);
+			entry.switchClosed = entry.switchComp->mnaIsClosed();
+		}
+		stamps.push_back(entry);
+	}
+	for (auto varElem : mMNAIntfVariableComps) {
+		IncrementalStamp entry;
+		entry.comp = varElem;
+		entry.varComp = std::dynamic_pointer_cast<CPS::MNAVariableCompInterface>(varElem);
+		stamps.push_back(entry);
+	}
+
+	const Int* outer = mVariableSystemMatrix.outerIndexPtr();
+	const Int* inner = mVariableSystemMatrix.innerIndexPtr();
+	for (auto& entry : stamps) {
+		entry.stamp = SparseMatrix(mVariableSystemMatrix.rows(), mVariableSystemMatrix.cols());
+		entry.slots.record(entry.stamp);
+		entry.comp->mnaApplySystemMatrixStamp(entry.stamp);
+		entry.slots.stop();
+
+		for (Int row = 0; row < entry.stamp.outerSize(); ++row) {
+			for (SparseMatrix::InnerIterator it(entry.stamp, row); it; ++it) {
+				const Int* begin = inner + outer[it.row()];
+				const Int* end = inner + outer[it.row() + 1];
+				const Int* slot = std::lower_bound(begin, end, static_cast<Int>(it.col()));
+				if (slot == end || *slot != it.col()) {
+					SPDLOG_LOGGER_WARN(mSLog, "Entry ({}, {}) not found in system matrix, disabling incremental stamping", it.row(), it.col());
+					return;
+				}
+				entry.systemSlots.push_back(static_cast<UInt>(slot - inner));
+				entry.values.push_back(it.value());
+			}
+		}
+	}
+	mIncrementalStamps = std::move(stamps);
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::hasIncrementalStampChanged() {
+	Bool changed = false;
+	for (auto& entry : mIncrementalStamps) {
+		// Every element is asked for changes, so that each one can track its own state
+		if (entry.varComp)
+			entry.changed = entry.varComp->hasParameterChanged();
+		else
+			entry.changed = entry.switchComp->mnaIsClosed() != entry.switchClosed;
+		changed |= entry.changed;
+	}
+	return changed;
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::hasSwitchChanged() {
+	Bool changed = false;
+	if (mIncrementalStamps.empty()) {
+		for (auto varElem : mVariableComps) {
+			if (std::dynamic_pointer_cast<CPS::MNASwitchInterface>(varElem) && varElem->hasParameterChanged())
+				changed = true;
+		}
+		return changed;
+	}
+
+	for (auto& entry : mIncrementalStamps) {
+		if (entry.switchComp)
+			entry.changed = entry.switchComp->mnaIsClosed() != entry.switchClosed;
+		else if (std::dynamic_pointer_cast<CPS::MNASwitchInterface>(entry.varComp))
+			entry.changed = entry.varComp->hasParameterChanged();
+		else
+			entry.changed = false;
+		changed |= entry.changed;
+	}
+	return changed;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::setFreezeVariableComponents(Bool freeze) {
+	if (freeze != mFreezeVariableComponents)
+		SPDLOG_LOGGER_INFO(mSLog, "{} variable components", freeze ? "Freezing" : "Unfreezing");
+	mFreezeVariableComponents = freeze;
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::restampChangedElements() {
+	Real* systemValues = mVariableSystemMatrix.valuePtr();
+	for (auto& entry : mIncrementalStamps) {
+		if (!entry.changed)
+			continue;
+
+		// Restamping keeps the pattern, so the values stay aligned with the cached slots
+		entry.stamp.coeffs().setZero();
+		entry.slots.replay(entry.stamp);
+		entry.comp->mnaApplySystemMatrixStamp(entry.stamp);
+		entry.slots.stop();
+		if (!entry.slots.valid() || !entry.stamp.isCompressed())
+			return false;
+
+		const Real* stampValues = entry.stamp.valuePtr();
+		for (UInt i = 0; i < entry.systemSlots.size(); ++i) {
+			systemValues[entry.systemSlots[i]] += stampValues[i] - entry.values[i];
+			entry.values[i] = stampValues[i];
+		}
+		if (entry.switchComp)
+			entry.switchClosed = entry.switchComp->mnaIsClosed();
+		entry.changed = false;
+	}
+	return true;
+}
 
-	// Add together the right side vector (computed by the components'
-	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
+template <typename VarType>
+void MnaSolverDirect<VarType>::solveWithSystemMatrixRecomputation(Real time, Int timeStepCount) {
+	// Reset and assemble source vector
+	{
+		StepPhases::Scope phase(mStepPhases.get(), StepPhases::RightSide);
+		MnaSolver<VarType>::assembleRightSideVector();
+	}
 
 	// Get switch and variable comp status and update system matrix and lu factorization accordingly
-	if (hasVariableComponentChanged())
+	Bool changed;
+	if (mFreezeVariableComponents)
+		changed = hasSwitchChanged();
+	else
+		changed = mIncrementalStamps.empty() ? hasVariableComponentChanged() : hasIncrementalStampChanged();
+	if (changed) {
+		StepPhases::Scope phase(mStepPhases.get(), StepPhases::Recomputation);
 		recomputeSystemMatrix(time);
+	}
 
 	// Calculate new solution vector
 	auto start = std::chrono::steady_clock::now();
-	**mLeftSideVector = mDirectLinearSolverVariableSystemMatrix->solve(mRightSideVector);
+	mDirectLinearSolverVariableSystemMatrix->solveInPlace(mRightSideVector, **mLeftSideVector);
+	if (!mLowRankRows.empty())
+		applyLowRankCorrection(**mLeftSideVector);
+	// Iterative components keep the system matrix constant and correct their sources instead
+	for (UInt iteration = 0; iteration < mMaxCorrectorIterations && !MnaSolver<VarType>::correctIterativeComponents(); ++iteration) {
+		MnaSolver<VarType>::assembleRightSideVector();
+		mDirectLinearSolverVariableSystemMatrix->solveInPlace(mRightSideVector, **mLeftSideVector);
+		if (!mLowRankRows.empty())
+			applyLowRankCorrection(**mLeftSideVector);
+	}
 	auto end = std::chrono::steady_clock::now();
 	std::chrono::duration<Real> diff = end-start;
-	mSolveTimes.push_back(diff.count());
+	mSolveTimes.record(diff.count());
+
+	// Single pass over all node voltages (dependent on x, updating all v attributes)
+	{
+		StepPhases::Scope phase(mStepPhases.get(), StepPhases::NodeUpdate);
+		MnaSolver<VarType>::updateNodeVoltages();
+	}
 
-	// TODO split into separate task? (dependent on x, updating all v attributes)
-	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
-		mNodes[nodeIdx]->mnaUpdateVoltage(**mLeftSideVector);
+	if (!mSensitivityShadows.empty() && !mIsInInitialization)
+		propagateSensitivities(time, timeStepCount);
 
 	// Components' states will be updated by the post-step tasks
 }
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::recomputeSystemMatrix(Real time) {
-	// Start from base matrix
-	mVariableSystemMatrix = mBaseSystemMatrix;
+	// Only replace the contributions of changed elements if possible
+	if (mIncrementalStamps.empty() || !restampChangedElements()) {
+		if (!restampVariableSystemMatrix()) {
+			// Start from base matrix
+			mVariableSystemMatrix = mBaseSystemMatrix;
 
-	// Now stamp switches into matrix
-	for (auto sw : mMNAIntfSwitches)
-		sw->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
+			// Now stamp switches into matrix
+			for (auto sw : mMNAIntfSwitches)
+				sw->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
 
-	// Now stamp variable elements into matrix
-	for (auto comp : mMNAIntfVariableComps)
-		comp->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
+			// Now stamp variable elements into matrix
+			for (auto comp : mMNAIntfVariableComps)
+				comp->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
+
+			initializeVariableStampSlots();
+		}
+
+		if (!mIncrementalStamps.empty())
+			initializeIncrementalStamps();
+	}
+
+	// Try to express the change as low-rank correction of the existing factorization
+	auto start = std::chrono::steady_clock::now();
+	if (mLowRankSystemMatrixUpdates && updateLowRankCorrection()) {
+		auto end = std::chrono::steady_clock::now();
+		std::chrono::duration<Real> diff = end-start;
+		mRecomputationTimes.record(diff.count());
+		++mNumLowRankUpdates;
+		if (mEventLog)
+			mEventLog->record(EventLog::Type::Recomputation, EventLog::LowRankUpdate, diff.count());
+		return;
+	}
 
 	// Refactorization of matrix assuming that structure remained
 	// constant by omitting analyzePattern
-	auto start = std::chrono::steady_clock::now();
+	UInt pivotFaults = mDirectLinearSolverVariableSystemMatrix->pivotFaults();
 	mDirectLinearSolverVariableSystemMatrix->partialRefactorize(mVariableSystemMatrix, mListVariableSystemMatrixEntries);
 	auto end = std::chrono::steady_clock::now();
 	std::chrono::duration<Real> diff = end-start;
-	mRecomputationTimes.push_back(diff.count());
+	mRecomputationTimes.record(diff.count());
 	++mNumRecomputations;
+
+	if (mEventLog) {
+		mEventLog->record(EventLog::Type::Recomputation, EventLog::Refactorization, diff.count());
+		UInt faults = mDirectLinearSolverVariableSystemMatrix->pivotFaults();
+		if (faults != pivotFaults)
+			mEventLog->record(EventLog::Type::PivotFault, faults);
+	}
+
+	if (mLowRankSystemMatrixUpdates) {
+		mFactorizedSystemMatrix = mVariableSystemMatrix;
+		mLowRankRows.clear();
+		mLowRankCols.clear();
+	}
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::updateLowRankCorrection() {
+	// Collect the entries that differ from the factorized matrix
+	std::vector<std::pair<UInt, UInt>> entries = mListVariableSystemMatrixEntries;
+	std::sort(entries.begin(), entries.end());
+	entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+	std::vector<std::pair<UInt, UInt>> changedEntries;
+	std::vector<Real> changedValues;
+	for (auto entry : entries) {
+		Real delta = mVariableSystemMatrix.coeff(entry.first, entry.second)
+			- mFactorizedSystemMatrix.coeff(entry.first, entry.second);
+		if (delta != 0) {
+			changedEntries.push_back(entry);
+			changedValues.push_back(delta);
+		}
+	}
+
+	std::vector<UInt> rows, cols;
+	for (auto entry : changedEntries) {
+		rows.push_back(entry.first);
+		cols.push_back(entry.second);
+	}
+	std::sort(rows.begin(), rows.end());
+	rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+	std::sort(cols.begin(), cols.end());
+	cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+
+	if (rows.size() > mLowRankUpdateMaxRank || cols.size() > mLowRankUpdateMaxRank) {
+		SPDLOG_LOGGER_DEBUG(mSLog, "Rank of system matrix change ({:d}) too large, refactorizing", std::max(rows.size(), cols.size()));
+		return false;
+	}
+
+	mLowRankRows = rows;
+	mLowRankCols = cols;
+	if (mLowRankRows.empty())
+		return true;
+
+	// Dense block C of the difference such that A = A0 + U C V^T
+	mLowRankCorrection = Matrix::Zero(mLowRankRows.size(), mLowRankCols.size());
+	for (UInt i = 0; i < changedEntries.size(); ++i) {
+		auto row = std::lower_bound(mLowRankRows.begin(), mLowRankRows.end(), changedEntries[i].first) - mLowRankRows.begin();
+		auto col = std::lower_bound(mLowRankCols.begin(), mLowRankCols.end(), changedEntries[i].second) - mLowRankCols.begin();
+		mLowRankCorrection(row, col) = changedValues[i];
+	}
+
+	// Z = A0^-1 U
+	Matrix unitVector = Matrix::Zero(mVariableSystemMatrix.rows(), 1);
+	Matrix basisVector;
+	mLowRankBasis.resize(mVariableSystemMatrix.rows(), mLowRankRows.size());
+	for (UInt i = 0; i < mLowRankRows.size(); ++i) {
+		unitVector(mLowRankRows[i], 0) = 1;
+		mDirectLinearSolverVariableSystemMatrix->solveInPlace(unitVector, basisVector);
+		mLowRankBasis.col(i) = basisVector.col(0);
+		unitVector(mLowRankRows[i], 0) = 0;
+	}
+
+	// Capacitance matrix I + C V^T Z
+	Matrix basisRows(mLowRankCols.size(), mLowRankRows.size());
+	for (UInt i = 0; i < mLowRankCols.size(); ++i)
+		basisRows.row(i) = mLowRankBasis.row(mLowRankCols[i]);
+	Matrix capacitance = Matrix::Identity(mLowRankRows.size(), mLowRankRows.size()) + mLowRankCorrection * basisRows;
+	mLowRankCapacitance.compute(capacitance);
+
+	return true;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::applyLowRankCorrection(Matrix& leftSideVector) {
+	// x = y - Z (I + C V^T Z)^-1 C V^T y with y = A0^-1 b
+	Matrix reducedSolution(mLowRankCols.size(), 1);
+	for (UInt i = 0; i < mLowRankCols.size(); ++i)
+		reducedSolution(i, 0) = leftSideVector(mLowRankCols[i], 0);
+	leftSideVector -= mLowRankBasis * mLowRankCapacitance.solve(mLowRankCorrection * reducedSolution);
+}
+
+template<>
+void MnaSolverDirect<Real>::createEmptySwitchedMatrix(const std::bitset<SWITCH_NUM>& bit) {
+	mSwitchedMatrices[bit].push_back(SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices));
+	mDirectLinearSolvers[bit].push_back(createDirectSolverImplementation(mSLog));
+}
+
+template<>
+void MnaSolverDirect<Complex>::createEmptySwitchedMatrix(const std::bitset<SWITCH_NUM>& bit) {
+	mSwitchedMatrices[bit].push_back(SparseMatrix(2*(mNumTotalMatrixNodeIndices), 2*(mNumTotalMatrixNodeIndices)));
+	mDirectLinearSolvers[bit].push_back(createDirectSolverImplementation(mSLog));
 }
 
 template<>
@@ -155,12 +702,12 @@ void MnaSolverDirect<Real>::createEmptySystemMatrix() {
 	if (mSystemMatrixRecomputation) {
 		mBaseSystemMatrix = SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 		mVariableSystemMatrix = SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
+	} else if (mLazySwitchedMatrices && mSwitches.size() > 0) {
+		// Matrices are created on first use of a switch state
+		mSwitchedMatrixCacheOrder.clear();
 	} else {
-		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++){
-			auto bit = std::bitset<SWITCH_NUM>(i);
-			mSwitchedMatrices[bit].push_back(SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices));
-			mDirectLinearSolvers[bit].push_back(createDirectSolverImplementation(mSLog));
-		}
+		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+			createEmptySwitchedMatrix(std::bitset<SWITCH_NUM>(i));
 	}
 }
 
@@ -180,18 +727,20 @@ void MnaSolverDirect<Complex>::createEmptySystemMatrix() {
 	} else if (mSystemMatrixRecomputation) {
 		mBaseSystemMatrix = SparseMatrix(2*(mNumMatrixNodeIndices), 2*(mNumMatrixNodeIndices));
 		mVariableSystemMatrix = SparseMatrix(2*(mNumMatrixNodeIndices), 2*(mNumMatrixNodeIndices));
+	} else if (mLazySwitchedMatrices && mSwitches.size() > 0) {
+		// Matrices are created on first use of a switch state
+		mSwitchedMatrixCacheOrder.clear();
 	} else {
-		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-			auto bit = std::bitset<SWITCH_NUM>(i);
-			mSwitchedMatrices[bit].push_back(SparseMatrix(2*(mNumTotalMatrixNodeIndices), 2*(mNumTotalMatrixNodeIndices)));
-			mDirectLinearSolvers[bit].push_back(createDirectSolverImplementation(mSLog));
-		}
+		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+			createEmptySwitchedMatrix(std::bitset<SWITCH_NUM>(i));
 	}
 }
 
 template <typename VarType>
 std::shared_ptr<CPS::Task> MnaSolverDirect<VarType>::createSolveTask()
 {
+	if (mBatchedLinearSolver)
+		return std::make_shared<MnaSolverDirect<VarType>::BatchedSolveTask>(*this);
 	return std::make_shared<MnaSolverDirect<VarType>::SolveTask>(*this);
 }
 
@@ -207,6 +756,35 @@ std::shared_ptr<CPS::Task> MnaSolverDirect<VarType>::createSolveTaskHarm(UInt fr
 	return std::make_shared<MnaSolverDirect<VarType>::SolveTaskHarm>(*this, freqIdx);
 }
 
+template <typename VarType>
+std::shared_ptr<CPS::Task> MnaSolverDirect<VarType>::createLogTaskHarm(UInt freqIdx)
+{
+	return std::make_shared<MnaSolverDirect<VarType>::LogTaskHarm>(*this, freqIdx);
+}
+
+template <typename VarType>
+std::vector<UInt> MnaSolverDirect<VarType>::harmonicSolveFrequencies(UInt freqIdx) const
+{
+	std::vector<UInt> freqs;
+	// The groups of switch statuses factorized later are not known yet
+	if (mLazySwitchedMatrices && mSwitches.size() > 0) {
+		for (UInt freq = 0; freq < mLeftSideVectorHarm.size(); ++freq)
+			freqs.push_back(freq);
+		return freqs;
+	}
+
+	freqs.push_back(freqIdx);
+	for (auto& groups : mFrequencyGroups) {
+		if (freqIdx >= groups.second.size())
+			continue;
+		for (auto freq : groups.second[freqIdx]) {
+			if (std::find(freqs.begin(), freqs.end(), freq) == freqs.end())
+				freqs.push_back(freq);
+		}
+	}
+	return freqs;
+}
+
 template <typename VarType>
 std::shared_ptr<CPS::Task> MnaSolverDirect<VarType>::createLogTask()
 {
@@ -214,146 +792,1540 @@ std::shared_ptr<CPS::Task> MnaSolverDirect<VarType>::createLogTask()
 }
 
 template <typename VarType>
-void MnaSolverDirect<VarType>::solve(Real time, Int timeStepCount) {
-	// Reset source vector
-	mRightSideVector.setZero();
+CPS::Task::List MnaSolverDirect<VarType>::createSolveTasks()
+{
+	if (mBlockGroups.empty())
+		return { createSolveTask() };
 
-	// Add together the right side vector (computed by the components'
-	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
+	CPS::Task::List l;
+	for (UInt group = 0; group < mBlockGroups.size(); ++group)
+		l.push_back(std::make_shared<MnaSolverDirect<VarType>::BlockSolveTask>(*this, group));
+	l.push_back(std::make_shared<MnaSolverDirect<VarType>::BlockFinishTask>(*this));
+	return l;
+}
 
-	if (!mIsInInitialization)
-		MnaSolver<VarType>::updateSwitchStatus();
+template <typename VarType>
+void MnaSolverDirect<VarType>::initialize() {
+	MnaSolver<VarType>::initialize();
 
-	if (mSwitchedMatrices.size() > 0) {
-		auto start = std::chrono::steady_clock::now();
-		**mLeftSideVector = mDirectLinearSolvers[mCurrentSwitchStatus][0]->solve(mRightSideVector);
-		auto end = std::chrono::steady_clock::now();
-		std::chrono::duration<Real> diff = end-start;
-		mSolveTimes.push_back(diff.count());
+	if (mAutoImplementation) {
+		if (mBatchedLinearSolver)
+			SPDLOG_LOGGER_WARN(mSLog, "The linear solver is not selected automatically for batched solves, using sparse LU");
+		else
+			selectDirectSolverImplementation();
 	}
 
+	if (mKronReduction) {
+		if (mFrequencyParallel || mSystemMatrixRecomputation || mBatchedLinearSolver || mBlockParallelSolve
+			|| mIncrementalSolve || (mLazySwitchedMatrices && mSwitches.size() > 0))
+			SPDLOG_LOGGER_WARN(mSLog, "Kron reduction requires precomputed system matrices without block, batched or incremental solves, the system is not reduced");
+		else
+			initializeKronReduction();
+	}
 
-	// TODO split into separate task? (dependent on x, updating all v attributes)
-	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
-		mNodes[nodeIdx]->mnaUpdateVoltage(**mLeftSideVector);
+	initializeGpuResidentStep();
+	initializeGeneratedStep();
 
-	// Components' states will be updated by the post-step tasks
+	if (!mBlockParallelSolve)
+		return;
+	if (mFrequencyParallel || mSystemMatrixRecomputation || mBatchedLinearSolver || (mLazySwitchedMatrices && mSwitches.size() > 0)) {
+		SPDLOG_LOGGER_WARN(mSLog, "Block parallel solve requires precomputed system matrices, the system is solved as a whole");
+		return;
+	}
+	initializeBlockSolve();
 }
 
 template <typename VarType>
-void MnaSolverDirect<VarType>::solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx) {
-	mRightSideVectorHarm[freqIdx].setZero();
+void MnaSolverDirect<VarType>::initializeBlockSolve() {
+	mBlockGroups.clear();
+	mBlockGroupSystems.clear();
 
-	// Sum of right side vectors (computed by the components' pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVectorHarm[freqIdx] += stamp->col(freqIdx);
+	// The blocks have to be valid for the system matrices of all switch states
+	SparseMatrix pattern;
+	Bool first = true;
+	for (auto& matrices : mSwitchedMatrices) {
+		if (first)
+			pattern = matrices.second[0].cwiseAbs();
+		else
+			pattern = pattern + matrices.second[0].cwiseAbs();
+		first = false;
+	}
 
-	**mLeftSideVectorHarm[freqIdx] = mDirectLinearSolvers[mCurrentSwitchStatus][freqIdx]->solve(mRightSideVectorHarm[freqIdx]);
-}
+	BlockTriangularForm form;
+	if (!form.compute(pattern)) {
+		SPDLOG_LOGGER_WARN(mSLog, "System matrix is structurally singular, the system is solved as a whole");
+		return;
+	}
+	SPDLOG_LOGGER_INFO(mSLog, "Block triangular form of the system matrix has {} diagonal blocks", form.numBlocks());
 
-template <typename VarType>
-void MnaSolverDirect<VarType>::logSystemMatrices() {
-	if (mFrequencyParallel) {
-		for (UInt i = 0; i < mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)].size(); ++i) {
-			SPDLOG_LOGGER_INFO(mSLog, "System matrix for frequency: {:d} \n{:s}", i, Logger::matrixToString(mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][i]));
-		}
+	// Blocks of the same dependency level are independent of each other
+	std::vector<UInt> levels(form.numBlocks(), 0);
+	std::vector<std::vector<UInt>> levelBlocks;
+	for (UInt block = 0; block < form.numBlocks(); ++block) {
+		for (UInt dependency : form.blockDependencies()[block])
+			levels[block] = std::max(levels[block], levels[dependency] + 1);
+		if (levels[block] >= levelBlocks.size())
+			levelBlocks.resize(levels[block] + 1);
+		levelBlocks[levels[block]].push_back(block);
+	}
 
-		for (UInt i = 0; i < mRightSideVectorHarm.size(); ++i) {
-			SPDLOG_LOGGER_INFO(mSLog, "Right side vector for frequency: {:d} \n{:s}", i, Logger::matrixToString(mRightSideVectorHarm[i]));
+	// Merge small blocks of a level, so that tasks are not dominated by their overhead
+	std::vector<UInt> blockGroups(form.numBlocks());
+	for (auto& blocks : levelBlocks) {
+		Int open = -1;
+		for (UInt block : blocks) {
+			if (open < 0 || mBlockGroups[open].cols.size() >= mMinBlockGroupSize) {
+				open = static_cast<Int>(mBlockGroups.size());
+				mBlockGroups.emplace_back();
+			}
+			auto& group = mBlockGroups[open];
+			for (UInt col : form.blockColumns()[block]) {
+				group.cols.push_back(col);
+				group.rows.push_back(form.columnRows()[col]);
+			}
+			blockGroups[block] = open;
 		}
+	}
+	if (mBlockGroups.size() < 2) {
+		SPDLOG_LOGGER_INFO(mSLog, "No independent blocks, the system is solved as a whole");
+		mBlockGroups.clear();
+		return;
+	}
 
+	for (UInt block = 0; block < form.numBlocks(); ++block) {
+		for (UInt dependency : form.blockDependencies()[block])
+			mBlockGroups[blockGroups[block]].dependencies.push_back(blockGroups[dependency]);
 	}
-	else if (mSystemMatrixRecomputation) {
-		SPDLOG_LOGGER_INFO(mSLog, "Summarizing matrices: ");
-		SPDLOG_LOGGER_INFO(mSLog, "Base matrix with only static elements: {}", Logger::matrixToString(mBaseSystemMatrix));
-		SPDLOG_LOGGER_INFO(mSLog, "Initial system matrix with variable elements {}", Logger::matrixToString(mVariableSystemMatrix));
-		SPDLOG_LOGGER_INFO(mSLog, "Right side vector: {}", Logger::matrixToString(mRightSideVector));
-	} else {
-		if (mSwitches.size() < 1) {
-			SPDLOG_LOGGER_INFO(mSLog, "System matrix: \n{}", mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
-		}
-		else {
-			SPDLOG_LOGGER_INFO(mSLog, "Initial switch status: {:s}", mCurrentSwitchStatus.to_string());
 
-			for (auto sys : mSwitchedMatrices) {
-				SPDLOG_LOGGER_INFO(mSLog, "Switching System matrix {:s} \n{:s}",
-				sys.first.to_string(), Logger::matrixToString(sys.second[0]));
-			}
+	std::vector<UInt> rowGroups(pattern.rows());
+	for (UInt g = 0; g < mBlockGroups.size(); ++g) {
+		auto& group = mBlockGroups[g];
+		std::sort(group.dependencies.begin(), group.dependencies.end());
+		group.dependencies.erase(std::unique(group.dependencies.begin(), group.dependencies.end()), group.dependencies.end());
+		for (UInt row : group.rows)
+			rowGroups[row] = g;
+
+		group.solution = AttributeStatic<Matrix>::make();
+		group.solution->set(Matrix::Zero(group.cols.size(), 1));
+		group.rightVector = Matrix::Zero(group.rows.size(), 1);
+		group.blockSolution = Matrix::Zero(group.cols.size(), 1);
+	}
+
+	// Split the right side vector assembly over the groups
+	if (mSparseRightVectorAssembly) {
+		for (const auto& entry : mRightVectorScatter)
+			mBlockGroups[rowGroups[entry.second]].rightVectorScatter.push_back(entry);
+	}
+	for (auto& group : mBlockGroups) {
+		for (auto stamp : mSparseRightVectorAssembly ? mRightVectorDenseStamps : mRightVectorStamps) {
+			for (UInt row : group.rows)
+				group.rightVectorScatter.push_back(std::make_pair(stamp, row));
 		}
-		SPDLOG_LOGGER_INFO(mSLog, "Right side vector: \n{}", mRightSideVector);
 	}
-}
 
-template<typename VarType>
-void MnaSolverDirect<VarType>::logLUTimes() {
-	logFactorizationTime();
-	logRecomputationTime();
-	logSolveTime();
-}
+	for (auto& matrices : mSwitchedMatrices)
+		factorizeBlockGroups(matrices.first);
 
-template<typename VarType>
-void MnaSolverDirect<VarType>::logSolveTime(){
-	Real solveSum = 0.0;
-	Real solveMax = 0.0;
-	for(auto meas : mSolveTimes)
-	{
-		solveSum += meas;
-		if(meas > solveMax)
-			solveMax = meas;
+	for (UInt g = 0; g < mBlockGroups.size(); ++g) {
+		SPDLOG_LOGGER_INFO(mSLog, "Block group {} has {} rows and depends on {} groups",
+			g, mBlockGroups[g].rows.size(), mBlockGroups[g].dependencies.size());
 	}
-  	SPDLOG_LOGGER_INFO(mSLog, "Cumulative solve times: {:.12f}", solveSum);
-	SPDLOG_LOGGER_INFO(mSLog, "Average solve time: {:.12f}", solveSum/static_cast<double>(mSolveTimes.size()));
-	SPDLOG_LOGGER_INFO(mSLog, "Maximum solve time: {:.12f}", solveMax);
-	SPDLOG_LOGGER_INFO(mSLog, "Number of solves: {:d}", mSolveTimes.size());
 }
 
-
 template <typename VarType>
-void MnaSolverDirect<VarType>::logFactorizationTime()
-{
-	for (auto meas : mFactorizeTimes) {
-		SPDLOG_LOGGER_INFO(mSLog, "LU factorization time: {:.12f}", meas);
+void MnaSolverDirect<VarType>::factorizeBlockGroups(const std::bitset<SWITCH_NUM>& status) {
+	const SparseMatrix& matrix = mSwitchedMatrices[status][0];
+	auto& systems = mBlockGroupSystems[status];
+	systems.resize(mBlockGroups.size());
+
+	std::vector<Int> colPositions(matrix.cols(), -1);
+	std::vector<std::pair<UInt, UInt>> noVariableEntries;
+	for (UInt g = 0; g < mBlockGroups.size(); ++g) {
+		auto& group = mBlockGroups[g];
+		auto& system = systems[g];
+		for (UInt i = 0; i < group.cols.size(); ++i)
+			colPositions[group.cols[i]] = i;
+
+		std::vector<Eigen::Triplet<Real>> diagonal, coupling;
+		for (UInt i = 0; i < group.rows.size(); ++i) {
+			for (SparseMatrix::InnerIterator it(matrix, group.rows[i]); it; ++it) {
+				if (colPositions[it.col()] >= 0)
+					diagonal.emplace_back(i, colPositions[it.col()], it.value());
+				else
+					coupling.emplace_back(i, it.col(), it.value());
+			}
+		}
+		for (UInt col : group.cols)
+			colPositions[col] = -1;
+
+		system.diagonal = SparseMatrix(group.rows.size(), group.cols.size());
+		system.diagonal.setFromTriplets(diagonal.begin(), diagonal.end());
+		system.diagonal.makeCompressed();
+		system.coupling = SparseMatrix(group.rows.size(), matrix.cols());
+		system.coupling.setFromTriplets(coupling.begin(), coupling.end());
+		system.coupling.makeCompressed();
+
+		system.solver = createDirectSolverImplementation(mSLog);
+		system.solver->preprocessing(system.diagonal, noVariableEntries);
+		system.solver->factorize(system.diagonal);
 	}
 }
 
 template <typename VarType>
-void MnaSolverDirect<VarType>::logRecomputationTime(){
-       Real recompSum = 0.0;
-	   Real recompMax = 0.0;
-       for (auto meas : mRecomputationTimes){
-               recompSum += meas;
-			   if(meas > recompMax)
-					recompMax = meas;
-       }
-	   // Sometimes, refactorization is not used
-	   if(mRecomputationTimes.size() != 0){
-		    SPDLOG_LOGGER_INFO(mSLog, "Cumulative refactorization times: {:.12f}",recompSum);
-       		SPDLOG_LOGGER_INFO(mSLog, "Average refactorization time: {:.12f}", recompSum/((double)mRecomputationTimes.size()));
-			SPDLOG_LOGGER_INFO(mSLog, "Maximum refactorization time: {:.12f}", recompMax);
-       		SPDLOG_LOGGER_INFO(mSLog, "Number of refactorizations: {:d}", mRecomputationTimes.size());
-	   }
-}
+void MnaSolverDirect<VarType>::solveBlockGroup(UInt g) {
+	auto& group = mBlockGroups[g];
 
-template<typename VarType>
-std::shared_ptr<DirectLinearSolver> MnaSolverDirect<VarType>::createDirectSolverImplementation(CPS::Logger::Log mSLog) {
-	switch(this->mImplementationInUse)
+	// The shared switch status is only updated after all groups are solved
+	std::bitset<SWITCH_NUM> status;
+	for (UInt i = 0; i < mSwitches.size(); ++i)
+		status.set(i, mSwitches[i]->mnaIsClosed());
+	auto& system = mBlockGroupSystems.at(status)[g];
+
+	for (UInt row : group.rows)
+		mRightSideVector(row, 0) = 0;
+	for (const auto& entry : group.rightVectorScatter)
+		mRightSideVector(entry.second, 0) += (*entry.first)(entry.second, 0);
+
+	// Solve D * x_g = b_g - C * x with the solutions of the previous groups
+	Matrix& leftSideVector = **mLeftSideVector;
+	for (UInt i = 0; i < group.rows.size(); ++i)
+		group.rightVector(i, 0) = mRightSideVector(group.rows[i], 0);
+	group.rightVector.noalias() -= system.coupling * leftSideVector;
+	system.solver->solveInPlace(group.rightVector, group.blockSolution);
+
+	Matrix& solution = **group.solution;
+	for (UInt i = 0; i < group.cols.size(); ++i) {
+		leftSideVector(group.cols[i], 0) = group.blockSolution(i, 0);
+		solution(i, 0) = group.blockSolution(i, 0);
+	}
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::finishBlockSolve() {
+	MnaSolver<VarType>::updateSwitchStatus();
+
+	MnaSolver<VarType>::updateNodeVoltages();
+}
+
+template <typename VarType>
+Task::List MnaSolverDirect<VarType>::getTasks() {
+	auto tasks = MnaSolver<VarType>::getTasks();
+	if (mGpuResidentComps.empty())
+		return tasks;
+
+	std::unordered_set<const Task*> residentTasks;
+	for (auto comp : mMNAComponents) {
+		if (!mGpuResidentComps.count(comp.get()))
+			continue;
+		for (auto& task : comp->mnaTasks())
+			residentTasks.insert(task.get());
+	}
+	tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
+		[&residentTasks](const Task::Ptr& task) { return residentTasks.count(task.get()) > 0; }), tasks.end());
+	return tasks;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::initializeGpuResidentStep() {
+	mGpuResidentComps.clear();
+	mGpuResidentAttributes.clear();
+	if (!mGpuResidentStep)
+		return;
+#ifdef WITH_CUDA_SPARSE
+	mGpuDeviceSteps.clear();
+	mGpuDeviceStepList.clear();
+	if (mImplementationInUse != DirectLinearSolverImpl::CUDASparse) {
+		SPDLOG_LOGGER_WARN(mSLog, "Steps on the device require the CUDASparse linear solver, the components are stepped on the host");
+		return;
+	}
+	if (mFrequencyParallel || mSystemMatrixRecomputation || mBatchedLinearSolver || mBlockParallelSolve
+		|| mIncrementalSolve || !mKronKeptRows.empty() || (!mIterativeComps.empty() && mMaxCorrectorIterations > 0)) {
+		SPDLOG_LOGGER_WARN(mSLog, "Steps on the device require precomputed system matrices without block, batched, incremental or corrector solves, the components are stepped on the host");
+		return;
+	}
+
+	// Inductors and capacitors whose steps the companion model batches could execute
+	std::vector<MNASimPowerComp<Real>*> comps1, comps3;
+	for (auto comp : mMNAComponents) {
+		auto powerComp = std::dynamic_pointer_cast<MNASimPowerComp<Real>>(comp);
+		if (!powerComp || !powerComp->mnaCompHasBatchedSteps())
+			continue;
+		if (dynamic_cast<EMT::CompanionModelBatch<1>::Provider*>(powerComp.get()))
+			comps1.push_back(powerComp.get());
+		else if (dynamic_cast<EMT::CompanionModelBatch<3>::Provider*>(powerComp.get()))
+			comps3.push_back(powerComp.get());
+		else
+			continue;
+		mGpuResidentComps.insert(comp.get());
+		mGpuResidentAttributes.push_back(powerComp->mIntfVoltage);
+		mGpuResidentAttributes.push_back(powerComp->mIntfCurrent);
+	}
+	if (!comps1.empty())
+		mGpuDeviceSteps.push_back(std::make_unique<GpuCompanionModels<1>>(comps1));
+	if (!comps3.empty())
+		mGpuDeviceSteps.push_back(std::make_unique<GpuCompanionModels<3>>(comps3));
+	for (auto& step : mGpuDeviceSteps)
+		mGpuDeviceStepList.push_back(step.get());
+
+	// Their right vectors are added on the device
+	std::unordered_set<const Matrix*> stamps;
+	for (auto comp : mMNAComponents) {
+		if (mGpuResidentComps.count(comp.get()))
+			stamps.insert(&comp->getRightVector()->get());
+	}
+	auto resident = [&stamps](const Matrix* stamp) { return stamps.count(stamp) > 0; };
+	mRightVectorStamps.erase(std::remove_if(mRightVectorStamps.begin(), mRightVectorStamps.end(), resident), mRightVectorStamps.end());
+	mRightVectorDenseStamps.erase(std::remove_if(mRightVectorDenseStamps.begin(), mRightVectorDenseStamps.end(), resident), mRightVectorDenseStamps.end());
+	mRightVectorScatter.erase(std::remove_if(mRightVectorScatter.begin(), mRightVectorScatter.end(),
+		[&resident](const std::pair<const Matrix*, UInt>& entry) { return resident(entry.first); }), mRightVectorScatter.end());
+
+	mGpuResidentUploaded = false;
+	SPDLOG_LOGGER_INFO(mSLog, "{} single-phase and {} three-phase companion models are stepped on the device", comps1.size(), comps3.size());
+#else
+	SPDLOG_LOGGER_WARN(mSLog, "Steps on the device require CUDA sparse support, the components are stepped on the host");
+#endif
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::solveGpuResident(DirectLinearSolver& linearSolver, Int timeStepCount) {
+#ifdef WITH_CUDA_SPARSE
+	if (!mGpuResidentUploaded) {
+		for (auto step : mGpuDeviceStepList)
+			step->upload();
+		mGpuResidentUploaded = true;
+	}
+
+	// Copy back in the steps the loggers with the same interval write
+	Bool copyBack = mGpuResidentCopyInterval > 0 && timeStepCount % mGpuResidentCopyInterval == 0;
+	// Only the CUDA sparse solver is created while components are stepped on the device
+	static_cast<GpuSparseAdapter&>(linearSolver).solveWithDeviceSteps(mRightSideVector, **mLeftSideVector, mGpuDeviceStepList, copyBack);
+	if (copyBack) {
+		for (auto step : mGpuDeviceStepList)
+			step->download();
+	}
+#endif
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::synchronizeGpuResidentState() {
+#ifdef WITH_CUDA_SPARSE
+	if (!mGpuResidentUploaded)
+		return;
+	for (auto step : mGpuDeviceStepList)
+		step->download();
+	mGpuResidentUploaded = false;
+#endif
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::initializeGeneratedStep() {
+	dropGeneratedStep();
+	if (!mStepGeneration)
+		return;
+#ifdef WITH_MNASOLVERPLUGIN
+	if (mFrequencyParallel || mSystemMatrixRecomputation || mBatchedLinearSolver || mBlockParallelSolve || mIncrementalSolve
+		|| !mKronKeptRows.empty() || !mGpuResidentComps.empty() || (!mIterativeComps.empty() && mMaxCorrectorIterations > 0)) {
+		SPDLOG_LOGGER_WARN(mSLog, "Step generation requires precomputed system matrices without block, batched, incremental, device or corrector solves, no step is generated");
+		return;
+	}
+	if (mLazySwitchedMatrices && mSwitches.size() > 0)
+		switchedMatrixRequest(mCurrentSwitchStatus.to_ullong());
+	auto matrices = mSwitchedMatrices.find(mCurrentSwitchStatus);
+	if (matrices == mSwitchedMatrices.end())
+		return;
+
+	// Scattered rows first, then the dense stamps, in the order of assembleRightSideVector
+	std::vector<GeneratedStep::Scatter> scatter;
+	std::map<const Matrix*, UInt> indices;
+	mGeneratedStamps.clear();
+	std::vector<const Matrix*> denseStamps;
+	if (mSparseRightVectorAssembly) {
+		for (auto& entry : mRightVectorScatter) {
+			auto index = indices.emplace(entry.first, static_cast<UInt>(mGeneratedStamps.size()));
+			if (index.second)
+				mGeneratedStamps.push_back(entry.first);
+			scatter.push_back({ index.first->second, entry.second });
+		}
+		denseStamps = mRightVectorDenseStamps;
+	} else {
+		denseStamps = mRightVectorStamps;
+	}
+	mGeneratedStamps.insert(mGeneratedStamps.end(), denseStamps.begin(), denseStamps.end());
+	mGeneratedStampValues.resize(mGeneratedStamps.size());
+
+	auto start = std::chrono::steady_clock::now();
+	try {
+		mGeneratedStep = std::make_unique<GeneratedStep>(mSLog);
+		mGeneratedStep->generate(matrices->second[0], scatter,
+			static_cast<UInt>(mGeneratedStamps.size()), static_cast<UInt>(denseStamps.size()));
+	} catch (const SystemError& e) {
+		SPDLOG_LOGGER_WARN(mSLog, "No step is generated: {}", e.descr());
+		mGeneratedStep.reset();
+		return;
+	} catch (const std::exception& e) {
+		SPDLOG_LOGGER_WARN(mSLog, "No step is generated: {}", e.what());
+		mGeneratedStep.reset();
+		return;
+	}
+	mGeneratedStepStatus = mCurrentSwitchStatus;
+	std::chrono::duration<Real> duration = std::chrono::steady_clock::now() - start;
+	SPDLOG_LOGGER_INFO(mSLog, "Generated step with {} stamps and {} substitution terms in {} s",
+		mGeneratedStamps.size(), mGeneratedStep->numTerms(), duration.count());
+#else
+	SPDLOG_LOGGER_WARN(mSLog, "Step generation requires support for dynamic libraries, no step is generated");
+#endif
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::dropGeneratedStep() {
+#ifdef WITH_MNASOLVERPLUGIN
+	if (mGeneratedStep)
+		SPDLOG_LOGGER_INFO(mSLog, "The system matrix changed, the generated step is not used anymore");
+	mGeneratedStep.reset();
+#endif
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::solveGenerated() {
+#ifdef WITH_MNASOLVERPLUGIN
+	if (!mGeneratedStep || mIsInInitialization)
+		return false;
+	// Other switch statuses use the factorizations of the linear solver
+	MnaSolver<VarType>::updateSwitchStatus();
+	if (mCurrentSwitchStatus != mGeneratedStepStatus)
+		return false;
+
+	auto start = std::chrono::steady_clock::now();
+	for (std::size_t k = 0; k < mGeneratedStamps.size(); ++k)
+		mGeneratedStampValues[k] = mGeneratedStamps[k]->data();
+	mGeneratedStep->step(mGeneratedStampValues.data(), mRightSideVector.data(), (**mLeftSideVector).data());
+	std::chrono::duration<Real> diff = std::chrono::steady_clock::now() - start;
+	mSolveTimes.record(diff.count());
+
+	StepPhases::Scope phase(mStepPhases.get(), StepPhases::NodeUpdate);
+	MnaSolver<VarType>::updateNodeVoltages();
+	return true;
+#else
+	return false;
+#endif
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::solve(Real time, Int timeStepCount) {
+	// The generated step assembles the source vector itself
+	if (solveGenerated())
+		return;
+
+	// Reset and assemble source vector
+	{
+		StepPhases::Scope phase(mStepPhases.get(), StepPhases::RightSide);
+		MnaSolver<VarType>::assembleRightSideVector();
+	}
+
+	if (!mIsInInitialization)
+		MnaSolver<VarType>::updateSwitchStatus();
+
+	if (mLazySwitchedMatrices && mSwitches.size() > 0)
+		switchedMatrixRequest(mCurrentSwitchStatus.to_ullong());
+
+	if (mSwitchedMatrices.size() > 0) {
+		auto start = std::chrono::steady_clock::now();
+		auto& linearSolver = mDirectLinearSolvers[mCurrentSwitchStatus][0];
+		if (!mKronKeptRows.empty())
+			solveKronReduced(*linearSolver);
+		else if (mIncrementalSolve)
+			solveIncremental(*linearSolver);
+		else if (!mGpuResidentComps.empty())
+			solveGpuResident(*linearSolver, timeStepCount);
+		else
+			linearSolver->solveInPlace(mRightSideVector, **mLeftSideVector);
+		// Iterative components correct their sources with the solution of the same factorization
+		for (UInt iteration = 0; iteration < mMaxCorrectorIterations && !MnaSolver<VarType>::correctIterativeComponents(); ++iteration) {
+			MnaSolver<VarType>::assembleRightSideVector();
+			if (!mKronKeptRows.empty())
+				solveKronReduced(*linearSolver);
+			else
+				linearSolver->solveInPlace(mRightSideVector, **mLeftSideVector);
+		}
+		auto end = std::chrono::steady_clock::now();
+		std::chrono::duration<Real> diff = end-start;
+		mSolveTimes.record(diff.count());
+	}
+
+
+	// Single pass over all node voltages (dependent on x, updating all v attributes)
+	StepPhases::Scope phase(mStepPhases.get(), StepPhases::NodeUpdate);
+	MnaSolver<VarType>::updateNodeVoltages();
+
+	// Components' states will be updated by the post-step tasks
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::solveIncremental(DirectLinearSolver& linearSolver) {
+	Matrix& leftSideVector = **mLeftSideVector;
+	Bool incremental = mIncrementalSolution.rows() == mRightSideVector.rows()
+		&& mIncrementalStatus == mCurrentSwitchStatus && mIncrementalSteps < mIncrementalResyncSteps;
+	if (incremental) {
+		mChangedRows.clear();
+		for (Matrix::Index row = 0; row < mRightSideVector.rows() && incremental; ++row) {
+			if (mRightSideVector(row, 0) != mIncrementalRightSide(row, 0)) {
+				mChangedRows.push_back(static_cast<UInt>(row));
+				incremental = mChangedRows.size() <= mIncrementalSolveMaxRows;
+			}
+		}
+	}
+
+	if (!incremental) {
+		// The columns belong to the factorization of one switch status
+		if (mIncrementalStatus != mCurrentSwitchStatus)
+			mInverseColumns.clear();
+		linearSolver.solveInPlace(mRightSideVector, leftSideVector);
+		mIncrementalStatus = mCurrentSwitchStatus;
+		mIncrementalRightSide = mRightSideVector;
+		mIncrementalSolution = leftSideVector;
+		mIncrementalSteps = 0;
+		return;
+	}
+
+	for (auto row : mChangedRows) {
+		auto column = mInverseColumns.find(row);
+		if (column == mInverseColumns.end()) {
+			// Rows of other sources than in the last steps replace the cached columns
+			if (mInverseColumns.size() >= 4 * mIncrementalSolveMaxRows)
+				mInverseColumns.clear();
+			Matrix unit = Matrix::Zero(mRightSideVector.rows(), 1);
+			unit(row, 0) = 1;
+			column = mInverseColumns.emplace(row, linearSolver.solve(unit)).first;
+		}
+		mIncrementalSolution.noalias() += (mRightSideVector(row, 0) - mIncrementalRightSide(row, 0)) * column->second;
+		mIncrementalRightSide(row, 0) = mRightSideVector(row, 0);
+	}
+	leftSideVector = mIncrementalSolution;
+	++mIncrementalSteps;
+	++mNumIncrementalSolves;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::resetIncrementalSolve() {
+	mInverseColumns.clear();
+	mIncrementalSolution.resize(0, 0);
+	mIncrementalRightSide.resize(0, 0);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::initializeKronReduction() {
+	mKronClusters.clear();
+	mKronKeptRows.clear();
+	if (mSwitchedMatrices.empty())
+		return;
+	// The eliminated entries do not depend on the switch status, any matrix can be used
+	const SparseMatrix& matrix = mSwitchedMatrices.begin()->second[0];
+	const UInt n = static_cast<UInt>(matrix.rows());
+
+	// Rows with sources and the rows and columns of switches are kept
+	std::vector<Bool> kept(n, false);
+	std::vector<UInt> rows;
+	for (auto comp : mMNAComponents) {
+		if (comp->getRightVector()->get().size() == 0)
+			continue;
+		rows.clear();
+		if (!comp->mnaRightVectorStampRows(rows)) {
+			SPDLOG_LOGGER_WARN(mSLog, "Kron reduction requires the source vector rows of all components, the system is not reduced");
+			return;
+		}
+		for (auto row : rows) {
+			if (row < n)
+				kept[row] = true;
+		}
+	}
+	SparseMatrix switchPattern(n, n);
+	for (auto sw : mSwitches) {
+		sw->mnaApplySwitchSystemMatrixStamp(true, switchPattern, 0);
+		sw->mnaApplySwitchSystemMatrixStamp(false, switchPattern, 0);
+	}
+	switchPattern.makeCompressed();
+	for (Int k = 0; k < switchPattern.outerSize(); ++k) {
+		for (SparseMatrix::InnerIterator it(switchPattern, k); it; ++it) {
+			kept[it.row()] = true;
+			kept[it.col()] = true;
+		}
+	}
+
+	// Subnetworks are the connected sets of the other rows
+	std::vector<UInt> parent(n);
+	std::iota(parent.begin(), parent.end(), 0);
+	auto root = [&parent](UInt i) {
+		while (parent[i] != i)
+			i = parent[i] = parent[parent[i]];
+		return i;
+	};
+	for (Int k = 0; k < matrix.outerSize(); ++k) {
+		for (SparseMatrix::InnerIterator it(matrix, k); it; ++it) {
+			if (!kept[it.row()] && !kept[it.col()])
+				parent[root(static_cast<UInt>(it.row()))] = root(static_cast<UInt>(it.col()));
+		}
+	}
+	std::map<UInt, UInt> clusterIndices;
+	std::vector<Int> rowClusters(n, -1);
+	for (UInt row = 0; row < n; ++row) {
+		if (kept[row])
+			continue;
+		auto index = clusterIndices.emplace(root(row), static_cast<UInt>(mKronClusters.size()));
+		if (index.second)
+			mKronClusters.emplace_back();
+		rowClusters[row] = index.first->second;
+		mKronClusters[index.first->second].rows.push_back(row);
+	}
+	for (Int k = 0; k < matrix.outerSize(); ++k) {
+		for (SparseMatrix::InnerIterator it(matrix, k); it; ++it) {
+			if (rowClusters[it.row()] >= 0 && kept[it.col()])
+				mKronClusters[rowClusters[it.row()]].boundary.push_back(static_cast<UInt>(it.col()));
+			else if (rowClusters[it.col()] >= 0 && kept[it.row()])
+				mKronClusters[rowClusters[it.col()]].boundary.push_back(static_cast<UInt>(it.row()));
+		}
+	}
+
+	// Equivalent of each subnetwork at its boundary, A_BB - A_BE * A_EE^-1 * A_EB
+	std::vector<Matrix> equivalents;
+	std::vector<KronCluster> clusters;
+	std::vector<Int> positions(n, -1);
+	for (auto& cluster : mKronClusters) {
+		std::sort(cluster.boundary.begin(), cluster.boundary.end());
+		cluster.boundary.erase(std::unique(cluster.boundary.begin(), cluster.boundary.end()), cluster.boundary.end());
+		if (cluster.boundary.size() > mKronMaxBoundaryRows)
+			continue;
+
+		const UInt size = static_cast<UInt>(cluster.rows.size());
+		for (UInt i = 0; i < size; ++i)
+			positions[cluster.rows[i]] = i;
+		for (UInt i = 0; i < cluster.boundary.size(); ++i)
+			positions[cluster.boundary[i]] = size + i;
+
+		std::vector<Eigen::Triplet<Real>> internal;
+		Matrix coupling = Matrix::Zero(size, cluster.boundary.size());
+		Matrix equivalent = Matrix::Zero(cluster.boundary.size(), size);
+		for (UInt row : cluster.rows) {
+			for (SparseMatrix::InnerIterator it(matrix, row); it; ++it) {
+				// Column of an eliminated row
+				Int pos = positions[it.row()];
+				if (pos < 0)
+					continue;
+				if (pos < static_cast<Int>(size))
+					internal.emplace_back(pos, positions[row], it.value());
+				else
+					equivalent(pos - size, positions[row]) = it.value();
+			}
+		}
+		for (UInt col : cluster.boundary) {
+			for (SparseMatrix::InnerIterator it(matrix, col); it; ++it) {
+				Int pos = positions[it.row()];
+				if (pos >= 0 && pos < static_cast<Int>(size))
+					coupling(pos, positions[col] - size) = it.value();
+			}
+		}
+		for (UInt row : cluster.rows)
+			positions[row] = -1;
+		for (UInt row : cluster.boundary)
+			positions[row] = -1;
+
+		SparseMatrix internalMatrix(size, size);
+		internalMatrix.setFromTriplets(internal.begin(), internal.end());
+		internalMatrix.makeCompressed();
+		Eigen::SparseLU<SparseMatrix> lu;
+		lu.compute(internalMatrix);
+		if (lu.info() != Eigen::Success)
+			continue;
+
+		cluster.reconstruction = -lu.solve(coupling);
+		cluster.boundarySolution = Matrix::Zero(cluster.boundary.size(), 1);
+		cluster.solution = Matrix::Zero(size, 1);
+		equivalents.push_back(equivalent * cluster.reconstruction);
+		clusters.push_back(std::move(cluster));
+	}
+	mKronClusters.swap(clusters);
+
+	std::fill(kept.begin(), kept.end(), true);
+	for (auto& cluster : mKronClusters) {
+		for (UInt row : cluster.rows)
+			kept[row] = false;
+	}
+	for (UInt row = 0; row < n; ++row) {
+		if (kept[row]) {
+			positions[row] = static_cast<Int>(mKronKeptRows.size());
+			mKronKeptRows.push_back(row);
+		}
+	}
+	if (mKronKeptRows.size() == n) {
+		SPDLOG_LOGGER_INFO(mSLog, "No static subnetworks to eliminate, the system is not reduced");
+		mKronKeptRows.clear();
+		return;
+	}
+
+	// Reduce and factorize the matrices of all switch states
+	const UInt reduced = static_cast<UInt>(mKronKeptRows.size());
+	mSharedAnalysis = nullptr;
+	for (auto& sys : mSwitchedMatrices) {
+		std::vector<Eigen::Triplet<Real>> entries;
+		for (Int k = 0; k < sys.second[0].outerSize(); ++k) {
+			for (SparseMatrix::InnerIterator it(sys.second[0], k); it; ++it) {
+				if (kept[it.row()] && kept[it.col()])
+					entries.emplace_back(positions[it.row()], positions[it.col()], it.value());
+			}
+		}
+		for (UInt c = 0; c < mKronClusters.size(); ++c) {
+			auto& boundary = mKronClusters[c].boundary;
+			for (UInt i = 0; i < boundary.size(); ++i) {
+				for (UInt j = 0; j < boundary.size(); ++j)
+					entries.emplace_back(positions[boundary[i]], positions[boundary[j]], equivalents[c](i, j));
+			}
+		}
+		SparseMatrix reducedMatrix(reduced, reduced);
+		reducedMatrix.setFromTriplets(entries.begin(), entries.end());
+		reducedMatrix.makeCompressed();
+		sys.second[0] = reducedMatrix;
+
+		auto& solver = mDirectLinearSolvers[sys.first][0];
+		solver = createDirectSolverImplementation(mSLog);
+		solver->preprocessing(sys.second[0], mListVariableSystemMatrixEntries);
+		solver->factorize(sys.second[0]);
+	}
+	mKronRightSide = Matrix::Zero(reduced, 1);
+	mKronSolution = Matrix::Zero(reduced, 1);
+
+	SPDLOG_LOGGER_INFO(mSLog, "Kron reduction eliminated {:d} of {:d} unknowns in {:d} static subnetworks",
+		n - reduced, n, mKronClusters.size());
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::solveKronReduced(DirectLinearSolver& linearSolver) {
+	// The source vector is zero at the eliminated rows
+	for (UInt i = 0; i < mKronKeptRows.size(); ++i)
+		mKronRightSide(i, 0) = mRightSideVector(mKronKeptRows[i], 0);
+	linearSolver.solveInPlace(mKronRightSide, mKronSolution);
+
+	Matrix& leftSideVector = **mLeftSideVector;
+	for (UInt i = 0; i < mKronKeptRows.size(); ++i)
+		leftSideVector(mKronKeptRows[i], 0) = mKronSolution(i, 0);
+	for (auto& cluster : mKronClusters) {
+		for (UInt i = 0; i < cluster.boundary.size(); ++i)
+			cluster.boundarySolution(i, 0) = leftSideVector(cluster.boundary[i], 0);
+		cluster.solution.noalias() = cluster.reconstruction * cluster.boundarySolution;
+		for (UInt i = 0; i < cluster.rows.size(); ++i)
+			leftSideVector(cluster.rows[i], 0) = cluster.solution(i, 0);
+	}
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::prepareBatchedSolve(Real time, Int timeStepCount) {
+	// Reset and assemble source vector
+	MnaSolver<VarType>::assembleRightSideVector();
+
+	if (!mIsInInitialization)
+		MnaSolver<VarType>::updateSwitchStatus();
+
+	if (mLazySwitchedMatrices && mSwitches.size() > 0)
+		switchedMatrixRequest(mCurrentSwitchStatus.to_ullong());
+
+	if (mBatchIndex < 0) {
+		mBatchIndex = mBatchedLinearSolver->addSystem(mSwitchedMatrices[mCurrentSwitchStatus][0]);
+		mBatchSwitchStatus = mCurrentSwitchStatus;
+		SPDLOG_LOGGER_INFO(mSLog, "Added system to batched linear solver at index {}", mBatchIndex);
+	} else if (mBatchSwitchStatus != mCurrentSwitchStatus) {
+		mBatchedLinearSolver->updateSystem(mBatchIndex, mSwitchedMatrices[mCurrentSwitchStatus][0]);
+		mBatchSwitchStatus = mCurrentSwitchStatus;
+	}
+
+	mBatchedLinearSolver->rightSideVector(mBatchIndex) = mRightSideVector;
+	mBatchedSolvePending = true;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::solveBatched(Real time, Int timeStepCount) {
+	// Steps that are not split, e.g. during steady-state initialization, are solved directly
+	if (!mBatchedSolvePending) {
+		solve(time, timeStepCount);
+		return;
+	}
+	mBatchedSolvePending = false;
+
+	**mLeftSideVector = mBatchedLinearSolver->leftSideVector(mBatchIndex);
+
+	MnaSolver<VarType>::updateNodeVoltages();
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::harmonicNegligible(UInt freqIdx, const Matrix& rightSideVector) {
+	if (mHarmonicDropTolerance <= 0)
+		return false;
+
+	// The source vectors already are the spectrum of the excitation including
+	// the history of the companion models, a zero source vector has a zero solution
+	Real magnitude = rightSideVector.cwiseAbs().maxCoeff();
+	if (freqIdx == 0) {
+		mFundamentalMagnitude.store(magnitude, std::memory_order_relaxed);
+		return false;
+	}
+	Bool negligible = magnitude <= mHarmonicDropTolerance * mFundamentalMagnitude.load(std::memory_order_relaxed);
+
+	auto& selection = mHarmonicSelections[freqIdx];
+	if (negligible != selection.dropped) {
+		SPDLOG_LOGGER_DEBUG(mSLog, "{} frequency {:d}", negligible ? "Dropped" : "Selected", freqIdx);
+		selection.dropped = negligible;
+		if (negligible)
+			(**mLeftSideVectorHarm[freqIdx]).setZero();
+	}
+	if (negligible)
+		++selection.skippedSolves;
+	return negligible;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx) {
+	auto groups = mFrequencyGroups.find(mCurrentSwitchStatus);
+	if (groups == mFrequencyGroups.end() || groups->second[freqIdx].size() == 1) {
+		mRightSideVectorHarm[freqIdx].setZero();
+
+		// Sum of right side vectors (computed by the components' pre-step tasks)
+		for (auto stamp : mRightVectorStamps)
+			mRightSideVectorHarm[freqIdx] += stamp->col(freqIdx);
+
+		if (!harmonicNegligible(freqIdx, mRightSideVectorHarm[freqIdx]))
+			mDirectLinearSolvers[mCurrentSwitchStatus][freqIdx]->solveInPlace(mRightSideVectorHarm[freqIdx], **mLeftSideVectorHarm[freqIdx]);
+		return;
+	}
+
+	// Frequencies sharing the system matrix are solved by the task of the leading frequency
+	const auto& group = groups->second[freqIdx];
+	if (group.empty())
+		return;
+
+	std::vector<UInt> selected;
+	for (auto freq : group) {
+		mRightSideVectorHarm[freq].setZero();
+		for (auto stamp : mRightVectorStamps)
+			mRightSideVectorHarm[freq] += stamp->col(freq);
+		if (!harmonicNegligible(freq, mRightSideVectorHarm[freq]))
+			selected.push_back(freq);
+	}
+	if (selected.empty())
+		return;
+
+	auto& solver = mDirectLinearSolvers[mCurrentSwitchStatus][freqIdx];
+	if (hasMultipleRightSideVectorSupport()) {
+		auto& rightSideVectorBatch = mRightSideVectorBatch[freqIdx];
+		auto& leftSideVectorBatch = mLeftSideVectorBatch[freqIdx];
+		rightSideVectorBatch.resize(mRightSideVectorHarm[freqIdx].rows(), selected.size());
+		for (UInt col = 0; col < selected.size(); ++col)
+			rightSideVectorBatch.col(col) = mRightSideVectorHarm[selected[col]];
+		solver->solveInPlace(rightSideVectorBatch, leftSideVectorBatch);
+		for (UInt col = 0; col < selected.size(); ++col)
+			**mLeftSideVectorHarm[selected[col]] = leftSideVectorBatch.col(col);
+	} else {
+		for (auto freq : selected)
+			solver->solveInPlace(mRightSideVectorHarm[freq], **mLeftSideVectorHarm[freq]);
+	}
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::hasMultipleRightSideVectorSupport() const {
+	switch(mImplementationInUse)
 	{
 		case DirectLinearSolverImpl::DenseLU:
-			return std::make_shared<DenseLUAdapter>(mSLog);
+		case DirectLinearSolverImpl::DenseInverse:
 		case DirectLinearSolverImpl::SparseLU:
-			return std::make_shared<SparseLUAdapter>(mSLog);
+		case DirectLinearSolverImpl::ParallelSparseLU:
+		case DirectLinearSolverImpl::ComplexSparseLU:
+		case DirectLinearSolverImpl::KLU:
+		case DirectLinearSolverImpl::CUDADense:
+			return true;
+		default:
+			return false;
+	}
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::logSystemMatrices() {
+	if (mFrequencyParallel) {
+		for (UInt i = 0; i < mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)].size(); ++i) {
+			SPDLOG_LOGGER_INFO(mSLog, "System matrix for frequency: {:d} \n{:s}", i, Logger::sparseMatrixToString(mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][i]));
+			Logger::dumpMatrix(mName + "_matrix_freq" + std::to_string(i), mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][i]);
+		}
+
+		for (UInt i = 0; i < mRightSideVectorHarm.size(); ++i) {
+			SPDLOG_LOGGER_INFO(mSLog, "Right side vector for frequency: {:d} \n{:s}", i, Logger::matrixToString(mRightSideVectorHarm[i]));
+		}
+
+	}
+	else if (mSystemMatrixRecomputation) {
+		SPDLOG_LOGGER_INFO(mSLog, "Summarizing matrices: ");
+		SPDLOG_LOGGER_INFO(mSLog, "Base matrix with only static elements: {}", Logger::sparseMatrixToString(mBaseSystemMatrix));
+		SPDLOG_LOGGER_INFO(mSLog, "Initial system matrix with variable elements {}", Logger::sparseMatrixToString(mVariableSystemMatrix));
+		SPDLOG_LOGGER_INFO(mSLog, "Right side vector: {}", Logger::matrixToString(mRightSideVector));
+	} else {
+		if (mSwitches.size() < 1) {
+			SPDLOG_LOGGER_INFO(mSLog, "System matrix: {}", Logger::sparseMatrixToString(mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]));
+			Logger::dumpMatrix(mName + "_matrix", mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
+		}
+		else {
+			SPDLOG_LOGGER_INFO(mSLog, "Initial switch status: {:s}", mCurrentSwitchStatus.to_string());
+
+			for (const auto& sys : mSwitchedMatrices) {
+				SPDLOG_LOGGER_INFO(mSLog, "Switching System matrix {:s} \n{:s}",
+				sys.first.to_string(), Logger::sparseMatrixToString(sys.second[0]));
+				Logger::dumpMatrix(mName + "_matrix_" + sys.first.to_string(), sys.second[0]);
+			}
+		}
+		SPDLOG_LOGGER_INFO(mSLog, "Right side vector: {}", Logger::matrixToString(mRightSideVector));
+	}
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::supportsTimeStepChange() {
+	if (mFrequencyParallel || mSystemMatrixRecomputation || mBlockParallelSolve || mBatchedLinearSolver || mKronReduction) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Time step changes require the switched system matrices without frequency parallelization, block solves, batched solves or Kron reduction");
+		return false;
+	}
+	mTimeStepComps.clear();
+	std::set<String> assumedTypes;
+	for (auto comp : mMNAComponents) {
+		if (auto varComp = std::dynamic_pointer_cast<CPS::MNAVariableTimeStepInterface>(comp))
+			mTimeStepComps.push_back(varComp);
+		else if (auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp))
+			assumedTypes.insert(idObj->type());
+	}
+	for (auto& type : assumedTypes)
+		SPDLOG_LOGGER_INFO(mSLog, "Components of type {} are assumed to not depend on the time step", type);
+	return true;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::changeTimeStep(Real timeStep) {
+	if (timeStep == mTimeStep)
+		return;
+	// The prefetched matrix belongs to the previous time step
+	if (mPrefetch)
+		dropPrefetch();
+
+	// The companion models are updated on the host
+	synchronizeGpuResidentState();
+	dropGeneratedStep();
+
+	auto& previous = mTimeStepSystems[mTimeStep];
+	previous.matrices.swap(mSwitchedMatrices);
+	previous.solvers.swap(mDirectLinearSolvers);
+	previous.cacheOrder.swap(mSwitchedMatrixCacheOrder);
+
+	mTimeStep = timeStep;
+	resetIncrementalSolve();
+	for (auto comp : mTimeStepComps)
+		comp->mnaUpdateTimeStep(timeStep);
+
+	auto cached = mTimeStepSystems.find(timeStep);
+	if (cached != mTimeStepSystems.end()) {
+		mSwitchedMatrices.swap(cached->second.matrices);
+		mDirectLinearSolvers.swap(cached->second.solvers);
+		mSwitchedMatrixCacheOrder.swap(cached->second.cacheOrder);
+		mTimeStepSystems.erase(cached);
+		if (mLazySwitchedMatrices && mSwitches.size() > 0)
+			switchedMatrixRequest(mCurrentSwitchStatus.to_ullong());
+		return;
+	}
+
+	SPDLOG_LOGGER_DEBUG(mSLog, "Factorizing system matrices for time step {:e}", timeStep);
+	rebuildSwitchedMatrices();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::reset() {
+	if (mPrefetch)
+		dropPrefetch();
+	resetIncrementalSolve();
+	mSensitivitiesStarted = false;
+	// The components are initialized again on the host
+	mGpuResidentUploaded = false;
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::supportsParameterChange() {
+	if (mFrequencyParallel || mSystemMatrixRecomputation || mBlockParallelSolve || mBatchedLinearSolver || mKronReduction) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Parameter changes require the switched system matrices without frequency parallelization, block solves, batched solves or Kron reduction");
+		return false;
+	}
+	return true;
+}
+
+template <typename VarType>
+SparseMatrix MnaSolverDirect<VarType>::componentStamps(const CPS::MNAInterface::List& comps) const {
+	Eigen::Index size = mSwitchedMatrices.empty() ? 0 : mSwitchedMatrices.begin()->second[0].rows();
+	SparseMatrix stamps(size, size);
+	for (auto comp : comps)
+		comp->mnaApplySystemMatrixStamp(stamps);
+	stamps.makeCompressed();
+	return stamps;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::beginParameterChange(const IdentifiedObject::List& comps) {
+	// The companion models are updated on the host, from the state before the change
+	synchronizeGpuResidentState();
+	mChangedComps.clear();
+	for (auto comp : mMNAComponents) {
+		auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
+		if (idObj && std::find(comps.begin(), comps.end(), idObj) != comps.end())
+			mChangedComps.push_back(comp);
+	}
+	mChangedStamps = componentStamps(mChangedComps);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::finishParameterChange() {
+	if (mChangedComps.empty())
+		return;
+	if (mPrefetch)
+		dropPrefetch();
+	mGpuResidentUploaded = false;
+	dropGeneratedStep();
+
+	for (auto comp : mChangedComps) {
+		if (auto varComp = std::dynamic_pointer_cast<CPS::MNAVariableTimeStepInterface>(comp))
+			varComp->mnaUpdateTimeStep(mTimeStep);
+	}
+
+	// The stamps only touch entries of the changed components, which are part of every pattern
+	SparseMatrix delta = componentStamps(mChangedComps) - mChangedStamps;
+	auto start = std::chrono::steady_clock::now();
+	for (auto& sys : mSwitchedMatrices) {
+		sys.second[0] += delta;
+		mDirectLinearSolvers[sys.first][0]->refactorize(sys.second[0]);
+	}
+	auto end = std::chrono::steady_clock::now();
+	std::chrono::duration<Real> diff = end-start;
+	SPDLOG_LOGGER_INFO(mSLog, "Updated the stamps of {} components in {} system matrices in {:.6f} s",
+		mChangedComps.size(), mSwitchedMatrices.size(), diff.count());
+
+	// The systems of other time steps contain the previous stamps
+	mTimeStepSystems.clear();
+	resetIncrementalSolve();
+	mChangedComps.clear();
+	mChangedStamps = SparseMatrix();
+}
+
+template <typename VarType>
+UInt MnaSolverDirect<VarType>::setSensitivityParameters(const std::vector<SensitivityParameter>& parameters) {
+	mSensitivityShadows.clear();
+	mSensitivitiesStarted = false;
+	for (auto& parameter : parameters) {
+		SensitivityShadow shadow;
+		Bool owned = false;
+		for (auto comp : mMNAComponents) {
+			if (std::dynamic_pointer_cast<IdentifiedObject>(comp) == parameter.component) {
+				shadow.comp = comp;
+				owned = true;
+			}
+		}
+		for (auto comp : mSimSignalComps)
+			owned = owned || comp == parameter.component;
+		if (!owned)
+			continue;
+		shadow.parameter = parameter;
+		mSensitivityShadows.push_back(shadow);
+	}
+	if (mSensitivityShadows.empty())
+		return 0;
+	if (!supportsParameterChange() || mStepGeneration || mGpuResidentStep) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Sensitivities require the support of parameter changes without step generation or steps on the device");
+		mSensitivityShadows.clear();
+		return 0;
+	}
+
+	mSensitivityAttributes.clear();
+	std::function<void(const String&, IdentifiedObject::Ptr)> addObject =
+		[&](const String& prefix, IdentifiedObject::Ptr obj) {
+		for (auto& attr : obj->attributes())
+			mSensitivityAttributes.emplace_back(prefix + "." + attr.first, attr.second);
+		if (auto powerComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(obj)) {
+			for (UInt i = 0; i < powerComp->virtualNodes().size(); ++i)
+				addObject(prefix + "/vnode" + std::to_string(i), powerComp->virtualNodes()[i]);
+			for (UInt i = 0; i < powerComp->subComponents().size(); ++i)
+				addObject(prefix + "/" + std::to_string(i), powerComp->subComponents()[i]);
+		}
+	};
+	for (UInt i = 0; i < mNodes.size(); ++i)
+		addObject("nodes/" + std::to_string(i), mNodes[i]);
+	for (UInt i = 0; i < mMNAComponents.size(); ++i) {
+		if (auto obj = std::dynamic_pointer_cast<IdentifiedObject>(mMNAComponents[i]))
+			addObject("components/" + std::to_string(i), obj);
+	}
+	for (UInt i = 0; i < mMNAIntfSwitches.size(); ++i) {
+		if (auto obj = std::dynamic_pointer_cast<IdentifiedObject>(mMNAIntfSwitches[i]))
+			addObject("switches/" + std::to_string(i), obj);
+	}
+	mSensitivitySignalTasks.clear();
+	for (UInt i = 0; i < mSimSignalComps.size(); ++i) {
+		addObject("signals/" + std::to_string(i), mSimSignalComps[i]);
+		for (auto task : mSimSignalComps[i]->getTasks())
+			mSensitivitySignalTasks.push_back(task);
+	}
+
+	if (!mSensitivities.getPtr())
+		mSensitivities = AttributeStatic<Matrix>::make();
+	SPDLOG_LOGGER_INFO(mSLog, "Computing the sensitivities to {} parameters", mSensitivityShadows.size());
+	return static_cast<UInt>(mSensitivityShadows.size());
+}
+
+template <typename VarType>
+Checkpoint MnaSolverDirect<VarType>::captureSensitivityState() const {
+	Checkpoint state;
+	for (auto& attr : mSensitivityAttributes)
+		state.capture(attr.first, attr.second);
+	return state;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::restoreSensitivityState(const Checkpoint& state) {
+	for (auto& attr : mSensitivityAttributes)
+		state.restore(attr.first, attr.second);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::setSensitivityParameter(SensitivityShadow& shadow, Real value) {
+	shadow.parameter.attribute->set(value);
+	if (auto varComp = std::dynamic_pointer_cast<CPS::MNAVariableTimeStepInterface>(shadow.comp))
+		varComp->mnaUpdateTimeStep(mTimeStep);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::initializeSensitivities() {
+	Checkpoint state = captureSensitivityState();
+	Eigen::Index size = mRightSideVector.rows();
+	for (auto& shadow : mSensitivityShadows) {
+		shadow.value = shadow.parameter.attribute->get();
+		shadow.step = shadow.parameter.perturbation * std::max(1., std::abs(shadow.value));
+		if (shadow.comp) {
+			SparseMatrix stamps = componentStamps({ shadow.comp });
+			setSensitivityParameter(shadow, shadow.value + shadow.step);
+			shadow.matrixChange = componentStamps({ shadow.comp }) - stamps;
+			setSensitivityParameter(shadow, shadow.value);
+		} else {
+			shadow.matrixChange = SparseMatrix(size, size);
+		}
+		shadow.state = state;
+		shadow.rightSide = mRightSideVector;
+	}
+	**mSensitivities = Matrix::Zero((**mLeftSideVector).rows(), mSensitivityShadows.size());
+	mSensitivitiesStarted = true;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::propagateSensitivities(Real time, Int timeStepCount) {
+	if (!mSensitivitiesStarted)
+		initializeSensitivities();
+
+	// All shadows are solved against the factorization of the solution
+	const Matrix solution = **mLeftSideVector;
+	Matrix rightSides(solution.rows(), mSensitivityShadows.size());
+	for (UInt i = 0; i < mSensitivityShadows.size(); ++i) {
+		auto& shadow = mSensitivityShadows[i];
+		rightSides.col(i) = shadow.rightSide - shadow.matrixChange * solution;
+	}
+	Matrix shadowSolutions;
+	mDirectLinearSolvers[mCurrentSwitchStatus][0]->solveInPlace(rightSides, shadowSolutions);
+	for (UInt i = 0; i < mSensitivityShadows.size(); ++i)
+		(**mSensitivities).col(i) = (shadowSolutions.col(i) - solution) / mSensitivityShadows[i].step;
+
+	// The shadows continue with their post-steps and the pre-steps of the next step
+	Checkpoint state = captureSensitivityState();
+	const Matrix rightSide = mRightSideVector;
+	try {
+		for (UInt i = 0; i < mSensitivityShadows.size(); ++i) {
+			auto& shadow = mSensitivityShadows[i];
+			restoreSensitivityState(shadow.state);
+			setSensitivityParameter(shadow, shadow.value + shadow.step);
+			**mLeftSideVector = shadowSolutions.col(i);
+			MnaSolver<VarType>::updateNodeVoltages();
+			for (auto comp : mMNAComponents) {
+				comp->mnaPostStep(time, timeStepCount, mLeftSideVector);
+				comp->mnaOutputStep(time, timeStepCount, mLeftSideVector);
+			}
+			for (auto comp : mMNAIntfSwitches)
+				comp->mnaPostStep(time, timeStepCount, mLeftSideVector);
+			for (auto task : mSensitivitySignalTasks)
+				task->execute(time, timeStepCount);
+			for (auto comp : mMNAComponents)
+				comp->mnaPreStep(time + mTimeStep, timeStepCount + 1);
+			for (auto comp : mMNAIntfSwitches)
+				comp->mnaPreStep(time + mTimeStep, timeStepCount + 1);
+			MnaSolver<VarType>::assembleRightSideVector();
+			shadow.rightSide = mRightSideVector;
+			shadow.state = captureSensitivityState();
+			setSensitivityParameter(shadow, shadow.value);
+		}
+	}
+	catch (...) {
+		restoreSensitivityState(state);
+		**mLeftSideVector = solution;
+		mRightSideVector = rightSide;
+		throw;
+	}
+	restoreSensitivityState(state);
+	**mLeftSideVector = solution;
+	mRightSideVector = rightSide;
+	MnaSolver<VarType>::updateNodeVoltages();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::stampFreeMatrixRows(SparseMatrix& sys) {
+	for (auto row : mFreeMatrixRows)
+		Math::addToMatrixElement(sys, row, row, VarType(1));
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::rebuildSwitchedMatrices(Bool keepSharedAnalysis) {
+	if (!keepSharedAnalysis)
+		mSharedAnalysis = nullptr;
+	resetIncrementalSolve();
+	mSwitchedMatrices.clear();
+	mDirectLinearSolvers.clear();
+	mSwitchedMatrixCacheOrder.clear();
+	createEmptySystemMatrix();
+	if (mLazySwitchedMatrices && mSwitches.size() > 0) {
+		switchedMatrixRequest(mCurrentSwitchStatus.to_ullong());
+	} else {
+		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
+			switchedMatrixEmpty(i);
+			switchedMatrixStamp(i, mMNAComponents);
+		}
+	}
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::supportsShiftFrequencyChange() {
+	if (!std::is_same<VarType, Complex>::value || mSystem.mFrequencies.size() != 1) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Shift frequency changes require a dynamic phasor simulation with a single frequency");
+		return false;
+	}
+	if (mFrequencyParallel || mSystemMatrixRecomputation || mBlockParallelSolve || mBatchedLinearSolver || mKronReduction) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Shift frequency changes require the switched system matrices without frequency parallelization, block solves, batched solves or Kron reduction");
+		return false;
+	}
+	mShiftFrequencyComps.clear();
+	std::set<String> assumedTypes;
+	for (auto comp : mMNAComponents) {
+		if (auto varComp = std::dynamic_pointer_cast<CPS::MNAVariableFrequencyInterface>(comp))
+			mShiftFrequencyComps.push_back(varComp);
+		else if (auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp))
+			assumedTypes.insert(idObj->type());
+	}
+	for (auto& type : assumedTypes)
+		SPDLOG_LOGGER_INFO(mSLog, "Components of type {} are assumed to not depend on the shift frequency", type);
+	return true;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::changeShiftFrequency(Real frequency, Real time) {
+	for (auto comp : mShiftFrequencyComps)
+		comp->mnaUpdateShiftFrequency(frequency, time, mTimeStep);
+
+	if (mPrefetch)
+		dropPrefetch();
+	// The systems of the other time steps belong to the previous frequency
+	mTimeStepSystems.clear();
+	SPDLOG_LOGGER_DEBUG(mSLog, "Factorizing system matrices for shift frequency {:f}", frequency);
+	rebuildSwitchedMatrices();
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::supportsTopologyEdits() {
+	if (mFrequencyParallel || mSystemMatrixRecomputation || mBlockParallelSolve || mBatchedLinearSolver || mKronReduction
+		|| mLowRankSystemMatrixUpdates || !mGpuResidentComps.empty() || mSensitivities.getPtr()) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Topology edits require the switched system matrices without frequency parallelization, block solves, batched solves, Kron reduction, low-rank updates, GPU resident steps or sensitivities");
+		return false;
+	}
+	return true;
+}
+
+template <typename VarType>
+typename SimNode<VarType>::List MnaSolverDirect<VarType>::componentVirtualNodes(const IdentifiedObject::Ptr& comp) {
+	typename SimNode<VarType>::List nodes;
+	auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+	if (!pComp)
+		return nodes;
+	for (UInt node = 0; node < pComp->virtualNodesNumber(); ++node)
+		nodes.push_back(pComp->virtualNode(node));
+	// Only the first level of subcomponents like in collectVirtualNodes()
+	if (pComp->hasSubComponents()) {
+		for (auto pSubComp : pComp->subComponents()) {
+			for (UInt node = 0; node < pSubComp->virtualNodesNumber(); ++node)
+				nodes.push_back(pSubComp->virtualNode(node));
+		}
+	}
+	return nodes;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::editTopology(const IdentifiedObject::List& added, const IdentifiedObject::List& removed) {
+	for (auto comp : added) {
+		if (std::dynamic_pointer_cast<CPS::MNAVariableCompInterface>(comp) && !std::dynamic_pointer_cast<CPS::MNASwitchInterface>(comp))
+			throw SystemError("Variable component " + comp->name() + " cannot be added during the simulation.");
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (!pComp)
+			continue;
+		for (auto node : pComp->topologicalNodes()) {
+			auto simNode = std::dynamic_pointer_cast<SimNode<VarType>>(node);
+			if (node && !node->isGround() && std::find(mNodes.begin(), mNodes.begin() + mNumNetNodes, simNode) == mNodes.begin() + mNumNetNodes)
+				throw SystemError("Component " + comp->name() + " connects to node " + node->name() + ", which is not part of solver " + mName);
+		}
+	}
+
+	if (mPrefetch)
+		dropPrefetch();
+	synchronizeGpuResidentState();
+	dropGeneratedStep();
+	// The systems of the other time steps have the previous topology
+	mTimeStepSystems.clear();
+	mSwitchStateIndices.clear();
+
+	for (auto comp : removed) {
+		for (auto node : componentVirtualNodes(comp)) {
+			for (auto row : node->matrixNodeIndices())
+				mFreeMatrixRows.push_back(row);
+			mNodes.erase(std::remove(mNodes.begin(), mNodes.end(), node), mNodes.end());
+		}
+		MnaSolver<VarType>::forgetComponent(comp);
+		SPDLOG_LOGGER_INFO(mSLog, "Removed {:s} '{:s}' from simulation.", comp->type(), comp->name());
+	}
+
+	for (auto comp : added) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (pComp) {
+			pComp->checkForUnconnectedTerminals();
+			if (this->mInitFromNodesAndTerminals)
+				pComp->initializeFromNodesAndTerminals(mSystem.mSystemFrequency);
+		}
+		// The virtual nodes of composite components exist after their initialization
+		for (auto node : componentVirtualNodes(comp)) {
+			UInt phases = node->phaseType() == PhaseType::ABC ? 3 : 1;
+			if (mFreeMatrixRows.size() < phases)
+				throw SystemError("Component " + comp->name() + " needs more matrix rows than the removed virtual nodes left free");
+			for (UInt phase = 0; phase < phases; ++phase) {
+				node->setMatrixNodeIndex(phase, mFreeMatrixRows.back());
+				mFreeMatrixRows.pop_back();
+			}
+			mNodes.push_back(node);
+		}
+
+		if (auto sigComp = std::dynamic_pointer_cast<SimSignalComp>(comp)) {
+			sigComp->initialize(mSystem.mSystemOmega, mTimeStep);
+			sigComp->setBehaviour(SimSignalComp::Behaviour::Simulation);
+		}
+		if (auto mnaComp = std::dynamic_pointer_cast<CPS::MNAInterface>(comp))
+			mnaComp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
+		if (pComp)
+			pComp->setBehaviour(TopologicalPowerComp::Behaviour::MNASimulation);
+
+		mSystem.mComponents.push_back(comp);
+		MnaSolver<VarType>::identifyComponent(comp);
+		SPDLOG_LOGGER_INFO(mSLog, "Added {:s} '{:s}' to simulation.", comp->type(), comp->name());
+	}
+	if (mSwitches.size() > SWITCH_NUM)
+		throw SystemError("Too many Switches.");
+
+	mRightVectorStamps.clear();
+	mRightVectorScatter.clear();
+	mRightVectorDenseStamps.clear();
+	for (auto comp : mMNAComponents)
+		MnaSolver<VarType>::collectRightVectorStamp(comp);
+	for (auto comp : mMNAIntfVariableComps)
+		MnaSolver<VarType>::collectRightVectorStamp(comp);
+	MnaSolver<VarType>::updateSwitchStatus();
+
+	// The analysis remains valid if the union of the patterns did not grow
+	Bool keepAnalysis = false;
+	if (mSharedAnalysis) {
+		SparseMatrix pattern(mSharedAnalysis->pattern.rows(), mSharedAnalysis->pattern.cols());
+		for (auto component : mMNAComponents)
+			component->mnaApplySystemMatrixStamp(pattern);
+		for (UInt i = 0; i < mSwitches.size(); ++i) {
+			mSwitches[i]->mnaApplySwitchSystemMatrixStamp(true, pattern, 0);
+			mSwitches[i]->mnaApplySwitchSystemMatrixStamp(false, pattern, 0);
+		}
+		stampFreeMatrixRows(pattern);
+		SparseMatrix merged = mSharedAnalysis->pattern;
+		merged += pattern;
+		merged.makeCompressed();
+		keepAnalysis = merged.nonZeros() == mSharedAnalysis->pattern.nonZeros() && !mSwitches.empty();
+	}
+	SPDLOG_LOGGER_INFO(mSLog, "Refactorizing system matrices after the topology edit, {} the shared symbolic analysis",
+		keepAnalysis ? "keeping" : "without");
+	rebuildSwitchedMatrices(keepAnalysis);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::reportMemory(MemoryReport& report) const {
+	String subsystem = "solver " + mName;
+	report.add(subsystem, "base system matrix", MemoryReport::sparseBytes(mBaseSystemMatrix));
+	report.add(subsystem, "variable system matrix", MemoryReport::sparseBytes(mVariableSystemMatrix)
+		+ MemoryReport::sparseBytes(mFactorizedSystemMatrix) + MemoryReport::vectorBytes(mBaseSystemValues));
+	if (mDirectLinearSolverVariableSystemMatrix)
+		report.add(subsystem, "variable system factorization", mDirectLinearSolverVariableSystemMatrix->memoryBytes());
+
+	// One matrix and factorization per switch status, which grow with 2^n for n switches
+	std::size_t matrixBytes = 0;
+	std::size_t matrices = 0;
+	for (auto& entry : mSwitchedMatrices) {
+		for (auto& matrix : entry.second) {
+			matrixBytes += MemoryReport::sparseBytes(matrix);
+			matrices++;
+		}
+	}
+	report.add(subsystem, std::to_string(matrices) + " switched system matrices", matrixBytes);
+	std::size_t factorizationBytes = 0;
+	std::size_t factorizations = 0;
+	for (auto& entry : mDirectLinearSolvers) {
+		for (auto& solver : entry.second) {
+			if (solver) {
+				factorizationBytes += solver->memoryBytes();
+				factorizations++;
+			}
+		}
+	}
+	report.add(subsystem, std::to_string(factorizations) + " switched system factorizations", factorizationBytes);
+
+	std::size_t blockBytes = 0;
+	for (auto& entry : mBlockGroupSystems) {
+		for (auto& system : entry.second) {
+			blockBytes += MemoryReport::sparseBytes(system.diagonal) + MemoryReport::sparseBytes(system.coupling);
+			if (system.solver)
+				blockBytes += system.solver->memoryBytes();
+		}
+	}
+	report.add(subsystem, "block systems", blockBytes);
+
+	std::size_t timeStepBytes = 0;
+	for (auto& entry : mTimeStepSystems) {
+		for (auto& matrices : entry.second.matrices) {
+			for (auto& matrix : matrices.second)
+				timeStepBytes += MemoryReport::sparseBytes(matrix);
+		}
+		for (auto& solvers : entry.second.solvers) {
+			for (auto& solver : solvers.second)
+				timeStepBytes += solver ? solver->memoryBytes() : 0;
+		}
+	}
+	report.add(subsystem, std::to_string(mTimeStepSystems.size()) + " other time step systems", timeStepBytes);
+
+	std::size_t vectorBytes = MemoryReport::denseBytes(mRightSideVector) + MemoryReport::denseBytes(**mLeftSideVector);
+	for (auto& vector : mRightSideVectorHarm)
+		vectorBytes += MemoryReport::denseBytes(vector);
+	for (auto& vector : mLeftSideVectorHarm)
+		vectorBytes += MemoryReport::denseBytes(**vector);
+	report.add(subsystem, "solution vectors", vectorBytes);
+	report.add(subsystem, "low-rank update", MemoryReport::denseBytes(mLowRankCorrection) + MemoryReport::denseBytes(mLowRankBasis));
+	std::size_t kronBytes = 0;
+	for (auto& cluster : mKronClusters)
+		kronBytes += MemoryReport::denseBytes(cluster.reconstruction);
+	report.add(subsystem, "Kron reduction", kronBytes);
+}
+
+template<typename VarType>
+void MnaSolverDirect<VarType>::logLUTimes() {
+	logFactorizationTime();
+	logRecomputationTime();
+	logSolveTime();
+
+	if (mEventLog) {
+		mEventLog->record(EventLog::Type::Timing, EventLog::Factorization,
+			static_cast<double>(mFactorizeTimes.count()), mFactorizeTimes.mean(), mFactorizeTimes.max());
+		mEventLog->record(EventLog::Type::Timing, EventLog::RecomputationTime,
+			static_cast<double>(mRecomputationTimes.count()), mRecomputationTimes.mean(), mRecomputationTimes.max());
+		mEventLog->record(EventLog::Type::Timing, EventLog::Solve,
+			static_cast<double>(mSolveTimes.count()), mSolveTimes.mean(), mSolveTimes.max());
+	}
+}
+
+template<typename VarType>
+void MnaSolverDirect<VarType>::logSolveTime(){
+	SPDLOG_LOGGER_INFO(mSLog, "Cumulative solve times: {:.12f}", mSolveTimes.sum());
+	mSolveTimes.log(mSLog, "Solve time");
+
+	for (auto& solvers : mDirectLinearSolvers) {
+		for (auto& solver : solvers.second)
+			solver->logStatistics();
+	}
+	if (mDirectLinearSolverVariableSystemMatrix)
+		mDirectLinearSolverVariableSystemMatrix->logStatistics();
+
+	if (mFrequencyParallel && mHarmonicDropTolerance > 0) {
+		for (UInt freq = 1; freq < mHarmonicSelections.size(); ++freq)
+			SPDLOG_LOGGER_INFO(mSLog, "Skipped solves of frequency {:d}: {:d}", freq, mHarmonicSelections[freq].skippedSolves);
+	}
+}
+
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::logFactorizationTime()
+{
+	mFactorizeTimes.log(mSLog, "LU factorization time");
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::logRecomputationTime(){
+	// Sometimes, refactorization is not used
+	if (mRecomputationTimes.count() != 0) {
+		SPDLOG_LOGGER_INFO(mSLog, "Cumulative refactorization times: {:.12f}", mRecomputationTimes.sum());
+		mRecomputationTimes.log(mSLog, "Refactorization time");
+	}
+	if (mLowRankSystemMatrixUpdates)
+		SPDLOG_LOGGER_INFO(mSLog, "Number of low-rank updates: {:d}", mNumLowRankUpdates);
+	if (mIncrementalSolve)
+		SPDLOG_LOGGER_INFO(mSLog, "Number of incremental solves: {:d}", mNumIncrementalSolves);
+}
+
+template<typename VarType>
+std::shared_ptr<DirectLinearSolver> MnaSolverDirect<VarType>::createDirectSolverImplementation(CPS::Logger::Log mSLog) {
+	switch(this->mImplementationInUse)
+	{
+		// The factorization precision is configured
+		case DirectLinearSolverImpl::DenseLU: {
+			auto solver = std::make_shared<DenseLUAdapter>(mSLog);
+			solver->setConfiguration(mConfigurationInUse);
+			return solver;
+		}
+		case DirectLinearSolverImpl::SparseLU: {
+			auto solver = std::make_shared<SparseLUAdapter>(mSLog);
+			solver->setConfiguration(mConfigurationInUse);
+			return solver;
+		}
+		case DirectLinearSolverImpl::DenseInverse:
+			return std::make_shared<DenseInverseAdapter>(mSLog);
+		case DirectLinearSolverImpl::ParallelSparseLU:
+			return std::make_shared<ParallelSparseLUAdapter>(mSLog);
+		// SP and DP system matrices are factorized in complex form
+		case DirectLinearSolverImpl::ComplexSparseLU:
+			return std::make_shared<ComplexSparseLUAdapter>(mSLog);
+		// Tolerance and preconditioner of the iterations are configured
+		case DirectLinearSolverImpl::Iterative: {
+			auto solver = std::make_shared<IterativeAdapter>(mSLog);
+			solver->setConfiguration(mConfigurationInUse);
+			return solver;
+		}
 		#ifdef WITH_KLU
 		case DirectLinearSolverImpl::KLU:
 			return std::make_shared<KLUAdapter>(mSLog);
 		#endif
 		#ifdef WITH_CUDA
-		case DirectLinearSolverImpl::CUDADense:
-			return std::make_shared<GpuDenseAdapter>(mSLog);
+		// GPU transfer settings apply to the solvers of all system matrices
+		case DirectLinearSolverImpl::CUDADense: {
+			auto solver = std::make_shared<GpuDenseAdapter>(mSLog);
+			solver->setConfiguration(mConfigurationInUse);
+			return solver;
+		}
 		#ifdef WITH_CUDA_SPARSE
-		case DirectLinearSolverImpl::CUDASparse:
-			return std::make_shared<GpuSparseAdapter>(mSLog);
+		case DirectLinearSolverImpl::CUDASparse: {
+			auto solver = std::make_shared<GpuSparseAdapter>(mSLog);
+			solver->setConfiguration(mConfigurationInUse);
+			return solver;
+		}
 		#endif
 		#ifdef WITH_MAGMA
 		case DirectLinearSolverImpl::CUDAMagma:
@@ -367,7 +2339,152 @@ std::shared_ptr<DirectLinearSolver> MnaSolverDirect<VarType>::createDirectSolver
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::setDirectLinearSolverImplementation(DirectLinearSolverImpl implementation) {
-	this->mImplementationInUse = implementation;
+	// The system is set up with sparse LU until the benchmarks at initialization selected an implementation
+	this->mAutoImplementation = implementation == DirectLinearSolverImpl::Auto;
+	this->mImplementationInUse = mAutoImplementation ? DirectLinearSolverImpl::SparseLU : implementation;
+}
+
+template <typename VarType>
+Real MnaSolverDirect<VarType>::benchmarkDirectSolver(const SparseMatrix& systemMatrix, UInt rounds) {
+	auto solver = createDirectSolverImplementation(mSLog);
+	if (mSystemMatrixRecomputation)
+		solver->setConfiguration(mConfigurationInUse);
+
+	SparseMatrix sys = systemMatrix;
+	Matrix rightSideVector = Matrix::Ones(sys.rows(), 1);
+	Matrix leftSideVector;
+	solver->preprocessing(sys, mListVariableSystemMatrixEntries);
+	solver->factorize(sys);
+
+	Real total = 0;
+	for (UInt round = 0; round < rounds; ++round) {
+		auto start = std::chrono::steady_clock::now();
+		if (mSystemMatrixRecomputation)
+			solver->partialRefactorize(sys, mListVariableSystemMatrixEntries);
+		solver->solveInPlace(rightSideVector, leftSideVector);
+		auto end = std::chrono::steady_clock::now();
+		std::chrono::duration<Real> diff = end-start;
+		total += diff.count();
+	}
+
+	if (!leftSideVector.allFinite() || (sys * leftSideVector - rightSideVector).norm() > 1e-8 * rightSideVector.norm())
+		return std::numeric_limits<Real>::infinity();
+	return total / rounds;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::selectDirectSolverImplementation() {
+	const SparseMatrix* systemMatrix = nullptr;
+	if (mSystemMatrixRecomputation) {
+		systemMatrix = &mVariableSystemMatrix;
+	} else {
+		auto sys = mSwitchedMatrices.find(mCurrentSwitchStatus);
+		if (sys != mSwitchedMatrices.end() && !sys->second.empty())
+			systemMatrix = &sys->second[0];
+	}
+	if (!systemMatrix || systemMatrix->nonZeros() == 0) {
+		SPDLOG_LOGGER_WARN(mSLog, "No system matrix to benchmark the linear solvers, using sparse LU");
+		return;
+	}
+
+	struct Candidate {
+		DirectLinearSolverImpl implementation;
+		DirectLinearSolverConfiguration configuration;
+		String name;
+	};
+	std::vector<Candidate> candidates;
+	const DirectLinearSolverConfiguration initial = mConfigurationInUse;
+	// The dense factorization grows with the cube of the dimension
+	if (systemMatrix->rows() <= 1000)
+		candidates.push_back({ DirectLinearSolverImpl::DenseLU, initial, "DenseLU" });
+	if (systemMatrix->rows() <= 256)
+		candidates.push_back({ DirectLinearSolverImpl::DenseInverse, initial, "DenseInverse" });
+	candidates.push_back({ DirectLinearSolverImpl::SparseLU, initial, "SparseLU" });
+	candidates.push_back({ DirectLinearSolverImpl::ParallelSparseLU, initial, "ParallelSparseLU" });
+	if (std::is_same<VarType, Complex>::value)
+		candidates.push_back({ DirectLinearSolverImpl::ComplexSparseLU, initial, "ComplexSparseLU" });
+#ifdef WITH_KLU
+	// The configuration is only applied to the variable system matrix
+	if (mSystemMatrixRecomputation) {
+		for (auto fillIn : { FILL_IN_REDUCTION_METHOD::AMD, FILL_IN_REDUCTION_METHOD::AMD_NV,
+			FILL_IN_REDUCTION_METHOD::AMD_RA, FILL_IN_REDUCTION_METHOD::COLAMD }) {
+			for (auto partial : { PARTIAL_REFACTORIZATION_METHOD::FACTORIZATION_PATH,
+				PARTIAL_REFACTORIZATION_METHOD::REFACTORIZATION_RESTART }) {
+				Candidate candidate { DirectLinearSolverImpl::KLU, initial, "KLU" };
+				candidate.configuration.setFillInReductionMethod(fillIn);
+				candidate.configuration.setPartialRefactorizationMethod(partial);
+				candidate.name += ", " + candidate.configuration.getFillInReductionMethodString()
+					+ ", " + candidate.configuration.getPartialRefactorizationMethodString();
+				candidates.push_back(candidate);
+			}
+		}
+	} else {
+		candidates.push_back({ DirectLinearSolverImpl::KLU, initial, "KLU" });
+	}
+#endif
+#ifdef WITH_CUDA
+	candidates.push_back({ DirectLinearSolverImpl::CUDADense, initial, "CUDADense" });
+#ifdef WITH_CUDA_SPARSE
+	candidates.push_back({ DirectLinearSolverImpl::CUDASparse, initial, "CUDASparse" });
+#endif
+#ifdef WITH_MAGMA
+	candidates.push_back({ DirectLinearSolverImpl::CUDAMagma, initial, "CUDAMagma" });
+#endif
+#endif
+
+	SPDLOG_LOGGER_INFO(mSLog, "Benchmarking {} linear solvers on the system matrix of dimension {} with {} nonzeros",
+		candidates.size(), systemMatrix->rows(), systemMatrix->nonZeros());
+	const Candidate* best = nullptr;
+	Real bestTime = std::numeric_limits<Real>::infinity();
+	for (auto& candidate : candidates) {
+		mImplementationInUse = candidate.implementation;
+		mConfigurationInUse = candidate.configuration;
+		Real time;
+		try {
+			time = benchmarkDirectSolver(*systemMatrix, 5);
+		} catch (const std::exception& e) {
+			SPDLOG_LOGGER_INFO(mSLog, "{}: not available ({})", candidate.name, e.what());
+			continue;
+		}
+		SPDLOG_LOGGER_INFO(mSLog, "{}: {:e} s per step", candidate.name, time);
+		if (time < bestTime) {
+			bestTime = time;
+			best = &candidate;
+		}
+	}
+
+	if (!best) {
+		SPDLOG_LOGGER_WARN(mSLog, "No linear solver passed the benchmark, using sparse LU");
+		mImplementationInUse = DirectLinearSolverImpl::SparseLU;
+		mConfigurationInUse = initial;
+		return;
+	}
+	SPDLOG_LOGGER_INFO(mSLog, "Selected linear solver {}", best->name);
+	mImplementationInUse = best->implementation;
+	mConfigurationInUse = best->configuration;
+	if (mImplementationInUse == DirectLinearSolverImpl::SparseLU)
+		return;
+
+	// Factorize the system matrices with the selected implementation, the shared
+	// analysis is created again with it for lazily built matrices
+	mSharedAnalysis = nullptr;
+	resetIncrementalSolve();
+	for (auto& sys : mSwitchedMatrices) {
+		auto& solvers = mDirectLinearSolvers[sys.first];
+		for (std::size_t i = 0; i < sys.second.size() && i < solvers.size(); ++i) {
+			solvers[i] = createDirectSolverImplementation(mSLog);
+			if (sys.second[i].nonZeros() == 0)
+				continue;
+			solvers[i]->preprocessing(sys.second[i], mListVariableSystemMatrixEntries);
+			solvers[i]->factorize(sys.second[i]);
+		}
+	}
+	if (mSystemMatrixRecomputation) {
+		mDirectLinearSolverVariableSystemMatrix = createDirectSolverImplementation(mSLog);
+		mDirectLinearSolverVariableSystemMatrix->setConfiguration(mConfigurationInUse);
+		mDirectLinearSolverVariableSystemMatrix->preprocessing(mVariableSystemMatrix, mListVariableSystemMatrixEntries);
+		mDirectLinearSolverVariableSystemMatrix->factorize(mVariableSystemMatrix);
+	}
 }
 
 template <typename VarType>
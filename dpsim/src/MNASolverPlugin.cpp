@@ -23,6 +23,7 @@ MnaSolverPlugin<VarType>::MnaSolverPlugin(String pluginName,
     MnaSolverDirect<VarType>(name, domain, logLevel),
 	mPluginName(pluginName),
 	mPlugin(nullptr),
+	mPluginV2(nullptr),
 	mDlHandle(nullptr)
 {
 }
@@ -32,6 +33,9 @@ MnaSolverPlugin<VarType>::~MnaSolverPlugin() {
 	if (mPlugin != nullptr) {
 		mPlugin->cleanup();
 	}
+	if (mPluginV2 != nullptr) {
+		mPluginV2->cleanup();
+	}
 	if (mDlHandle != nullptr) {
 		dlclose(mDlHandle);
 	}
@@ -43,6 +47,20 @@ extern "C" void pluginLogger(const char * str)
 	log->info(str);
 }
 
+template <typename VarType>
+int MnaSolverPlugin<VarType>::decompose(SparseMatrix& systemMatrix) {
+	int size = this->mRightSideVector.rows();
+	int nnz = systemMatrix.nonZeros();
+	struct dpsim_csr_matrix matrix = {
+		.values = systemMatrix.valuePtr(),
+		.rowIndex = systemMatrix.outerIndexPtr(),
+		.colIndex = systemMatrix.innerIndexPtr(),
+		.row_number = size,
+		.nnz = nnz,
+	};
+	return mPluginV2 ? mPluginV2->lu_decomp(&matrix) : mPlugin->lu_decomp(&matrix);
+}
+
 template <typename VarType>
 void MnaSolverPlugin<VarType>::recomputeSystemMatrix(Real time) {
 	// Start from base matrix
@@ -56,7 +74,7 @@ void MnaSolverPlugin<VarType>::recomputeSystemMatrix(Real time) {
 	for (auto comp : this->mMNAIntfVariableComps)
 		comp->mnaApplySystemMatrixStamp(this->mVariableSystemMatrix);
 
-    int size = this->mRightSideVector.rows();
+	int size = this->mRightSideVector.rows();
 	int nnz = this->mVariableSystemMatrix.nonZeros();
 	struct dpsim_csr_matrix matrix = {
 		.values = this->mVariableSystemMatrix.valuePtr(),
@@ -65,9 +83,17 @@ void MnaSolverPlugin<VarType>::recomputeSystemMatrix(Real time) {
 		.row_number = size,
 		.nnz = nnz,
 	};
-	// Refactorization of matrix assuming that structure remained
-	// constant by omitting analyzePattern
-	if (mPlugin->lu_decomp(&matrix) != 0) {
+
+	int ret;
+	if (mPluginV2 && mPluginV2->partial_refactor && !mVariableEntries.empty())
+		// Only the variable entries changed, the matrix is stamped in the same pattern
+		ret = mPluginV2->partial_refactor(&matrix);
+	else if (mPluginV2 && mPluginV2->refactor)
+		ret = mPluginV2->refactor(&matrix);
+	else
+		ret = decompose(this->mVariableSystemMatrix);
+
+	if (ret != 0) {
 		SPDLOG_LOGGER_ERROR(mSLog, "error recomputing decomposition");
 		return;
 	}
@@ -75,14 +101,7 @@ void MnaSolverPlugin<VarType>::recomputeSystemMatrix(Real time) {
 }
 
 template <typename VarType>
-void MnaSolverPlugin<VarType>::initialize() {
-    MnaSolver<VarType>::initialize();
-    int size = this->mRightSideVector.rows();
-	auto hMat = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
-	int nnz = hMat[0].nonZeros();
-
-	struct dpsim_mna_plugin* (*get_mna_plugin)(const char *);
-
+void MnaSolverPlugin<VarType>::loadPlugin() {
 	String pluginFileName = mPluginName + ".so";
 
 	if ((mDlHandle = dlopen(pluginFileName.c_str(), RTLD_NOW)) == nullptr) {
@@ -90,7 +109,21 @@ void MnaSolverPlugin<VarType>::initialize() {
 		throw CPS::SystemError("error opening dynamic library.");
 	}
 
-	get_mna_plugin = (struct dpsim_mna_plugin* (*)(const char *)) dlsym(mDlHandle, "get_mna_plugin");
+	auto get_mna_plugin_v2 = (struct dpsim_mna_plugin_v2* (*)(const char *)) dlsym(mDlHandle, "get_mna_plugin_v2");
+	if (get_mna_plugin_v2 != NULL) {
+		mPluginV2 = get_mna_plugin_v2(mPluginName.c_str());
+		if (mPluginV2 != nullptr && mPluginV2->abi_version < DPSIM_MNA_PLUGIN_ABI_VERSION) {
+			SPDLOG_LOGGER_ERROR(mSLog, "plugin {} reports unsupported interface version {}", mPluginName, mPluginV2->abi_version);
+			throw CPS::SystemError("unsupported plugin interface version.");
+		}
+		if (mPluginV2 != nullptr) {
+			SPDLOG_LOGGER_INFO(mSLog, "Loaded plugin {} with interface version {}", mPluginName, mPluginV2->abi_version);
+			mPluginV2->log = pluginLogger;
+			return;
+		}
+	}
+
+	auto get_mna_plugin = (struct dpsim_mna_plugin* (*)(const char *)) dlsym(mDlHandle, "get_mna_plugin");
 	if (get_mna_plugin == NULL) {
 		SPDLOG_LOGGER_ERROR(mSLog, "error reading symbol from library {}: {}", mPluginName, dlerror());
 		throw CPS::SystemError("error reading symbol from library.");
@@ -102,16 +135,46 @@ void MnaSolverPlugin<VarType>::initialize() {
 	}
 
 	mPlugin->log = pluginLogger;
+}
+
+template <typename VarType>
+void MnaSolverPlugin<VarType>::initialize() {
+	// The plugin is only handed the system matrix of the initial switch status
+	// and rebuilds the variable system matrix itself, solving it on its own
+	this->mLazySwitchedMatrices = false;
+	this->mBatchedLinearSolver = nullptr;
+	this->mLowRankSystemMatrixUpdates = false;
+	this->mIncrementalSystemMatrixStamping = false;
+	MnaSolver<VarType>::initialize();
+	int size = this->mRightSideVector.rows();
+
+	mPluginSwitchStatus = this->mCurrentSwitchStatus;
+	SparseMatrix& systemMatrix = this->mSystemMatrixRecomputation
+		? this->mVariableSystemMatrix
+		: this->mSwitchedMatrices[mPluginSwitchStatus][0];
+	int nnz = systemMatrix.nonZeros();
+
+	loadPlugin();
 
 	struct dpsim_csr_matrix matrix = {
-		.values = hMat[0].valuePtr(),
-		.rowIndex = hMat[0].outerIndexPtr(),
-		.colIndex = hMat[0].innerIndexPtr(),
+		.values = systemMatrix.valuePtr(),
+		.rowIndex = systemMatrix.outerIndexPtr(),
+		.colIndex = systemMatrix.innerIndexPtr(),
 		.row_number = size,
 		.nnz = nnz,
 	};
 
-	if (mPlugin->init(&matrix) != 0) {
+	int ret;
+	if (mPluginV2) {
+		mVariableEntries.clear();
+		for (auto& entry : this->mListVariableSystemMatrixEntries)
+			mVariableEntries.push_back({ static_cast<int>(entry.first), static_cast<int>(entry.second) });
+		ret = mPluginV2->init(&matrix, mVariableEntries.data(), static_cast<int>(mVariableEntries.size()));
+	} else {
+		ret = mPlugin->init(&matrix);
+	}
+
+	if (ret != 0) {
 		SPDLOG_LOGGER_ERROR(mSLog, "error initializing plugin");
 		return;
 	}
@@ -130,6 +193,12 @@ Task::List MnaSolverPlugin<VarType>::getTasks() {
 		for (auto task : node->mnaTasks())
 			l.push_back(task);
 	}
+	if (this->mSystemMatrixRecomputation) {
+		for (auto comp : this->mMNAIntfVariableComps) {
+			for (auto task : comp->mnaTasks())
+				l.push_back(task);
+		}
+	}
 	// TODO signal components should be moved out of MNA solver
 	for (auto comp : this->mSimSignalComps) {
 		for (auto task : comp->getTasks()) {
@@ -143,22 +212,28 @@ Task::List MnaSolverPlugin<VarType>::getTasks() {
 
 template <typename VarType>
 void MnaSolverPlugin<VarType>::solve(Real time, Int timeStepCount) {
-    // Reset source vector
-	this->mRightSideVector.setZero();
-
-    // Add together the right side vector (computed by the components'
-	// pre-step tasks)
-	for (const auto &stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+    // Reset and assemble source vector
+	this->assembleRightSideVector();
 
 	if (!this->mIsInInitialization)
 		this->updateSwitchStatus();
 
-	mPlugin->solve((double*)this->mRightSideVector.data(), (double*)this->leftSideVector().data());
+	if (this->mSystemMatrixRecomputation) {
+		if (this->hasVariableComponentChanged())
+			recomputeSystemMatrix(time);
+	} else if (mPluginSwitchStatus != this->mCurrentSwitchStatus) {
+		mPluginSwitchStatus = this->mCurrentSwitchStatus;
+		if (decompose(this->mSwitchedMatrices[mPluginSwitchStatus][0]) != 0)
+			SPDLOG_LOGGER_ERROR(mSLog, "error decomposing matrix of switch status {}", mPluginSwitchStatus.to_string());
+	}
+
+	if (mPluginV2)
+		mPluginV2->solve_in_place(this->mRightSideVector.data(), this->leftSideVector().data(), 1);
+	else
+		mPlugin->solve((double*)this->mRightSideVector.data(), (double*)this->leftSideVector().data());
 
-	// TODO split into separate task? (dependent on x, updating all v attributes)
-	for (UInt nodeIdx = 0; nodeIdx < this->mNumNetNodes; ++nodeIdx)
-		this->mNodes[nodeIdx]->mnaUpdateVoltage(**(this->mLeftSideVector));
+	// Single pass over all node voltages (dependent on x, updating all v attributes)
+	this->updateNodeVoltages();
 
 
 	// Components' states will be updated by the post-step tasks
@@ -0,0 +1,51 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/MemoryLoggerBackend.h>
+
+#include <algorithm>
+
+using namespace CPS;
+using namespace DPsim;
+
+MemoryLoggerBackend::MemoryLoggerBackend(UInt capacity) :
+	mCapacity(capacity),
+	mBuffer(std::make_shared<std::vector<Real>>()) {
+	if (mCapacity == 0)
+		throw SystemError("Memory logger requires a capacity of at least one row.");
+}
+
+Bool MemoryLoggerBackend::open(const fs::path& filename) {
+	// The rows of the previous run stay readable until the columns are set
+	mHasColumns = false;
+	return true;
+}
+
+void MemoryLoggerBackend::setColumns(const std::vector<String>& names, Notation notation) {
+	mNames.clear();
+	mNames.push_back("time");
+	mNames.insert(mNames.end(), names.begin(), names.end());
+	mColumns = static_cast<UInt>(mNames.size());
+
+	// A new buffer instead of resizing, views of the previous run keep their values
+	mBuffer = std::make_shared<std::vector<Real>>(static_cast<std::size_t>(mColumns) * mCapacity, 0);
+	mRowsWritten = 0;
+	mHasColumns = true;
+}
+
+void MemoryLoggerBackend::writeRow(Real time, const Real* values, UInt count) {
+	if (!mHasColumns)
+		return;
+
+	Real* row = mBuffer->data() + static_cast<std::size_t>(mRowsWritten % mCapacity) * mColumns;
+	row[0] = time;
+	UInt columns = std::min<UInt>(count, mColumns - 1);
+	std::copy(values, values + columns, row + 1);
+	std::fill(row + 1 + columns, row + mColumns, 0);
+	++mRowsWritten;
+}
@@ -0,0 +1,37 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/MemoryReport.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+std::size_t MemoryReport::total() const {
+	std::size_t bytes = 0;
+	for (auto& entry : mEntries)
+		bytes += entry.bytes;
+	return bytes;
+}
+
+std::map<String, std::size_t> MemoryReport::subsystems() const {
+	std::map<String, std::size_t> totals;
+	for (auto& entry : mEntries)
+		totals[entry.subsystem] += entry.bytes;
+	return totals;
+}
+
+void MemoryReport::log(Logger::Log log) const {
+	SPDLOG_LOGGER_INFO(log, "Memory: {:.3f} MiB in total", total() / 1048576.0);
+	for (auto& subsystem : subsystems()) {
+		SPDLOG_LOGGER_INFO(log, "  {}: {:.3f} MiB", subsystem.first, subsystem.second / 1048576.0);
+		for (auto& entry : mEntries) {
+			if (entry.subsystem == subsystem.first)
+				SPDLOG_LOGGER_DEBUG(log, "    {}: {} bytes", entry.item, entry.bytes);
+		}
+	}
+}
@@ -0,0 +1,319 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/ModalAnalysis.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <Eigen/Eigenvalues>
+
+#include <dpsim/DenseLUAdapter.h>
+#include <dpsim/SparseLUAdapter.h>
+#ifdef WITH_KLU
+#include <dpsim/KLUAdapter.h>
+#endif
+
+using namespace CPS;
+using namespace DPsim;
+
+namespace {
+	Bool isFlattened(Checkpoint::Type type) {
+		return type == Checkpoint::Type::Real || type == Checkpoint::Type::Complex
+			|| type == Checkpoint::Type::Matrix || type == Checkpoint::Type::MatrixComp;
+	}
+
+	Bool isComplex(Checkpoint::Type type) {
+		return type == Checkpoint::Type::Complex || type == Checkpoint::Type::MatrixComp;
+	}
+}
+
+ModalAnalysis::ModalAnalysis(String name, Simulation::Ptr simulation, Logger::Level logLevel)
+	: mLog(Logger::get(name, logLevel)), mName(name), mSimulation(simulation) { }
+
+Vector ModalAnalysis::flatten(const Checkpoint& state) const {
+	Vector values(mFlatStates.size());
+	for (std::size_t i = 0; i < mFlatStates.size(); ++i) {
+		auto value = state.values.find(mFlatStates[i].first);
+		if (value == state.values.end() || mFlatStates[i].second >= value->second.data.size())
+			throw SystemError("The state of simulation " + mSimulation->name() + " changed its structure during the modal analysis.");
+		values(i) = value->second.data[mFlatStates[i].second];
+	}
+	return values;
+}
+
+Checkpoint ModalAnalysis::unflatten(const Vector& values) const {
+	Checkpoint state = mOperatingPoint;
+	for (std::size_t i = 0; i < mFlatStates.size(); ++i)
+		state.values[mFlatStates[i].first].data[mFlatStates[i].second] = values(i);
+	return state;
+}
+
+Vector ModalAnalysis::stepFrom(const Vector& values) {
+	mSimulation->restoreState(unflatten(values));
+	mSimulation->step();
+	return flatten(mSimulation->captureState());
+}
+
+void ModalAnalysis::setLogging(DataLogger::List& loggers, Bool enabled) {
+	for (auto logger : loggers)
+		logger->setPaused(!enabled);
+}
+
+std::vector<UInt> ModalAnalysis::reduceStates(const SparseMatrix& jacobian) const {
+	UInt n = static_cast<UInt>(jacobian.rows());
+	std::vector<std::vector<UInt>> rows(n), cols(n);
+	std::vector<Real> diagonal(n, 0);
+	for (Int j = 0; j < jacobian.outerSize(); ++j) {
+		for (SparseMatrix::InnerIterator it(jacobian, j); it; ++it) {
+			if (it.row() == it.col()) {
+				diagonal[it.row()] = it.value();
+			} else {
+				cols[it.col()].push_back(static_cast<UInt>(it.row()));
+				rows[it.row()].push_back(static_cast<UInt>(it.col()));
+			}
+		}
+	}
+
+	// A state whose column or row only has a diagonal entry d splits off the
+	// eigenvalue d, removing the ones with zero and one may expose further ones
+	std::vector<Bool> active(n, true);
+	auto hasActive = [&active](const std::vector<UInt>& indices) {
+		return std::any_of(indices.begin(), indices.end(), [&active](UInt i) { return active[i]; });
+	};
+	Bool changed = true;
+	while (changed) {
+		changed = false;
+		for (UInt i = 0; i < n; ++i) {
+			if (!active[i])
+				continue;
+			Bool trivial = std::abs(diagonal[i]) <= mDropTolerance || std::abs(diagonal[i] - 1) <= mDropTolerance;
+			if (trivial && (!hasActive(cols[i]) || !hasActive(rows[i]))) {
+				active[i] = false;
+				changed = true;
+			}
+		}
+	}
+
+	std::vector<UInt> states;
+	for (UInt i = 0; i < n; ++i) {
+		if (active[i])
+			states.push_back(i);
+	}
+	return states;
+}
+
+void ModalAnalysis::linearize() {
+	mOperatingPoint = mSimulation->captureState();
+	Real timeStep = mSimulation->timeStep();
+	if (mSimulation->time() + timeStep > mSimulation->finalTime())
+		throw SystemError("Simulation " + mSimulation->name() + " has no step left before its final time for the modal analysis.");
+
+	mFlatStates.clear();
+	for (auto& entry : mOperatingPoint.values) {
+		if (!isFlattened(entry.second.type))
+			continue;
+		for (UInt k = 0; k < entry.second.data.size(); ++k)
+			mFlatStates.emplace_back(entry.first, k);
+	}
+	UInt n = static_cast<UInt>(mFlatStates.size());
+	if (n == 0)
+		throw SystemError("Simulation " + mSimulation->name() + " has no real or complex state for the modal analysis.");
+
+	DataLogger::List loggers;
+	DataLogger::List candidates = mSimulation->loggers();
+	for (auto solver : mSimulation->solvers()) {
+		for (auto logger : solver->dataLoggers())
+			candidates.push_back(logger);
+	}
+	for (auto logger : candidates) {
+		if (logger && logger->isEnabled() && !logger->isPaused())
+			loggers.push_back(logger);
+	}
+	setLogging(loggers, false);
+
+	Vector x0 = flatten(mOperatingPoint);
+	std::vector<Eigen::Triplet<Real>> triplets;
+	try {
+		Vector y0 = stepFrom(x0);
+		for (UInt j = 0; j < n; ++j) {
+			Real h = mPerturbation * std::max(1., std::abs(x0(j)));
+			Vector x = x0;
+			x(j) += h;
+			Vector column = (stepFrom(x) - y0) / h;
+			for (UInt i = 0; i < n; ++i) {
+				if (std::abs(column(i)) > mDropTolerance)
+					triplets.emplace_back(i, j, column(i));
+			}
+		}
+	}
+	catch (...) {
+		mSimulation->restoreState(mOperatingPoint);
+		setLogging(loggers, true);
+		throw;
+	}
+	mSimulation->restoreState(mOperatingPoint);
+	setLogging(loggers, true);
+
+	SparseMatrix jacobian(n, n);
+	jacobian.setFromTriplets(triplets.begin(), triplets.end());
+	std::vector<UInt> states = reduceStates(jacobian);
+	if (states.empty())
+		throw SystemError("Simulation " + mSimulation->name() + " has no dynamic state at its operating point.");
+
+	std::vector<Int> reduced(n, -1);
+	for (UInt i = 0; i < states.size(); ++i)
+		reduced[states[i]] = static_cast<Int>(i);
+	std::vector<Eigen::Triplet<Real>> stateTriplets;
+	for (auto& entry : triplets) {
+		Int row = reduced[entry.row()];
+		Int col = reduced[entry.col()];
+		if (row >= 0 && col >= 0)
+			stateTriplets.emplace_back(row, col, entry.value() / timeStep);
+	}
+	for (UInt i = 0; i < states.size(); ++i)
+		stateTriplets.emplace_back(i, i, -1. / timeStep);
+	mStateMatrix = SparseMatrix(states.size(), states.size());
+	mStateMatrix.setFromTriplets(stateTriplets.begin(), stateTriplets.end());
+	mStateMatrix.makeCompressed();
+
+	mStateNames.clear();
+	for (auto state : states) {
+		auto& flat = mFlatStates[state];
+		const auto& value = mOperatingPoint.values.at(flat.first);
+		if (isComplex(value.type))
+			mStateNames.push_back(flat.first + "[" + std::to_string(flat.second / 2) + "]" + (flat.second % 2 ? ".im" : ".re"));
+		else
+			mStateNames.push_back(flat.first + "[" + std::to_string(flat.second) + "]");
+	}
+
+	mLinearized = true;
+	SPDLOG_LOGGER_INFO(mLog, "Linearized simulation {} at time {}: {} of {} values are states, {} nonzeros",
+		mSimulation->name(), mOperatingPoint.time, states.size(), n, mStateMatrix.nonZeros());
+}
+
+std::shared_ptr<DirectLinearSolver> ModalAnalysis::createLinearSolver() const {
+	switch (mImplementation) {
+		case DirectLinearSolverImpl::DenseLU:
+			return std::make_shared<DenseLUAdapter>(mLog);
+		case DirectLinearSolverImpl::SparseLU:
+			return std::make_shared<SparseLUAdapter>(mLog);
+		#ifdef WITH_KLU
+		case DirectLinearSolverImpl::KLU:
+			return std::make_shared<KLUAdapter>(mLog);
+		#endif
+		default:
+			throw SystemError("unsupported linear solver implementation for the modal analysis.");
+	}
+}
+
+const std::vector<ModalAnalysis::Mode>& ModalAnalysis::computeModes() {
+	if (!mLinearized)
+		linearize();
+
+	// (A - shift I)(u + jw) = r + js as the real system [A - aI, bI; -bI, A - aI][u; w] = [r; s]
+	Int n = static_cast<Int>(mStateMatrix.rows());
+	Real a = mShift.real();
+	Real b = mShift.imag();
+	std::vector<Eigen::Triplet<Real>> triplets;
+	for (Int j = 0; j < mStateMatrix.outerSize(); ++j) {
+		for (SparseMatrix::InnerIterator it(mStateMatrix, j); it; ++it) {
+			triplets.emplace_back(it.row(), it.col(), it.value());
+			triplets.emplace_back(it.row() + n, it.col() + n, it.value());
+		}
+	}
+	for (Int i = 0; i < n; ++i) {
+		triplets.emplace_back(i, i, -a);
+		triplets.emplace_back(i + n, i + n, -a);
+		triplets.emplace_back(i, i + n, b);
+		triplets.emplace_back(i + n, i, -b);
+	}
+	SparseMatrix shifted(2 * n, 2 * n);
+	shifted.setFromTriplets(triplets.begin(), triplets.end());
+	shifted.makeCompressed();
+
+	auto solver = createLinearSolver();
+	std::vector<std::pair<UInt, UInt>> noVariableEntries;
+	solver->preprocessing(shifted, noVariableEntries);
+	solver->factorize(shifted);
+
+	Matrix rightSide(2 * n, 1);
+	Matrix solution(2 * n, 1);
+	auto applyInverse = [&](const VectorComp& v) {
+		rightSide.col(0).head(n) = v.real();
+		rightSide.col(0).tail(n) = v.imag();
+		solver->solveInPlace(rightSide, solution);
+		VectorComp result(n);
+		result.real() = solution.col(0).head(n);
+		result.imag() = solution.col(0).tail(n);
+		return result;
+	};
+
+	// Arnoldi iterations with reorthogonalization
+	Int m = std::min<Int>(std::max<UInt>(mKrylovDimension, 1), n);
+	MatrixComp basis = MatrixComp::Zero(n, m + 1);
+	MatrixComp hessenberg = MatrixComp::Zero(m + 1, m);
+	basis.col(0) = VectorComp::Ones(n) / std::sqrt(static_cast<Real>(n));
+	for (Int k = 0; k < m; ++k) {
+		VectorComp w = applyInverse(basis.col(k));
+		Real scale = w.norm();
+		for (UInt pass = 0; pass < 2; ++pass) {
+			for (Int i = 0; i <= k; ++i) {
+				Complex h = basis.col(i).dot(w);
+				hessenberg(i, k) += h;
+				w -= h * basis.col(i);
+			}
+		}
+		hessenberg(k + 1, k) = w.norm();
+		if (std::abs(hessenberg(k + 1, k)) <= 1e-12 * scale) {
+			// The subspace is invariant, its Ritz pairs are exact
+			m = k + 1;
+			break;
+		}
+		basis.col(k + 1) = w / hessenberg(k + 1, k);
+	}
+
+	Eigen::ComplexEigenSolver<MatrixComp> eigenSolver(hessenberg.topLeftCorner(m, m));
+	const VectorComp& ritzValues = eigenSolver.eigenvalues();
+	const MatrixComp& ritzVectors = eigenSolver.eigenvectors();
+	Real lastSubdiagonal = std::abs(hessenberg(m, m - 1));
+
+	std::vector<Int> order(m);
+	for (Int i = 0; i < m; ++i)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&ritzValues](Int i, Int j) {
+		return std::abs(ritzValues(i)) > std::abs(ritzValues(j));
+	});
+
+	Real timeStep = mSimulation->timeStep();
+	mModes.clear();
+	for (Int i : order) {
+		if (mModes.size() >= mNumModes)
+			break;
+		Complex nu = ritzValues(i);
+		if (std::abs(nu) == 0)
+			continue;
+		Complex theta = mShift + 1. / nu;
+		Complex multiplier = 1. + theta * timeStep;
+		if (std::abs(multiplier) == 0)
+			continue;
+
+		Mode mode;
+		mode.eigenvalue = std::log(multiplier) / timeStep;
+		mode.frequency = mode.eigenvalue.imag() / (2 * PI);
+		if (std::abs(mode.eigenvalue) > 0)
+			mode.dampingRatio = -mode.eigenvalue.real() / std::abs(mode.eigenvalue);
+		mode.residual = lastSubdiagonal * std::abs(ritzVectors(m - 1, i)) / std::abs(nu);
+		mode.shape = basis.leftCols(m) * ritzVectors.col(i);
+		Int largest;
+		mode.shape.cwiseAbs().maxCoeff(&largest);
+		mode.shape /= mode.shape(largest);
+		mModes.push_back(mode);
+	}
+
+	SPDLOG_LOGGER_INFO(mLog, "Computed {} modes of simulation {} around {}{:+}j with {} Arnoldi iterations",
+		mModes.size(), mSimulation->name(), mShift.real(), mShift.imag(), m);
+	for (auto& mode : mModes)
+		SPDLOG_LOGGER_INFO(mLog, "Mode {:.4f}{:+.4f}j: {:.3f} Hz, damping ratio {:.4f}, residual {:.1e}",
+			mode.eigenvalue.real(), mode.eigenvalue.imag(), mode.frequency, mode.dampingRatio, mode.residual);
+	return mModes;
+}
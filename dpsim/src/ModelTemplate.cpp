@@ -0,0 +1,139 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <exception>
+#include <unordered_map>
+
+#include <dpsim/ModelTemplate.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+ModelTemplate::ModelTemplate(String name, const SystemTopology& topology, Logger::Level logLevel)
+	: mName(name), mSLog(Logger::get(name, logLevel)),
+	  mSystemFrequency(topology.mSystemFrequency), mFrequencies(topology.mFrequencies) {
+
+	for (auto comp : topology.mComponents) {
+		if (!std::dynamic_pointer_cast<SimPowerComp<Real>>(comp) && !std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp))
+			throw SystemError("Component " + comp->name() + " of model template " + name + " is no power component.");
+	}
+	collect<Real>(topology, mRealIndex);
+	collect<Complex>(topology, mComplexIndex);
+
+	SPDLOG_LOGGER_INFO(mSLog, "Model template {} with {} nodes and {} components", mName,
+		mRealIndex.nodes.size() + mComplexIndex.nodes.size(),
+		mRealIndex.components.size() + mComplexIndex.components.size());
+}
+
+template <typename VarType>
+void ModelTemplate::collect(const SystemTopology& topology, Index<VarType>& index) {
+	std::unordered_map<const TopologicalNode*, Int> nodeIndex;
+	for (auto topoNode : topology.mNodes) {
+		auto node = std::dynamic_pointer_cast<SimNode<VarType>>(topoNode);
+		if (!node || node->isGround())
+			continue;
+		nodeIndex.emplace(node.get(), static_cast<Int>(index.nodes.size()));
+		index.nodes.push_back(node);
+	}
+
+	for (auto genComp : topology.mComponents) {
+		auto comp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(genComp);
+		if (!comp)
+			continue;
+		std::vector<Int> indices;
+		for (UInt nNode = 0; nNode < comp->terminalNumber(); nNode++) {
+			auto node = comp->node(nNode);
+			if (node->isGround()) {
+				indices.push_back(-1);
+				continue;
+			}
+			auto search = nodeIndex.find(node.get());
+			if (search == nodeIndex.end())
+				throw SystemError("Node " + node->name() + " of " + comp->name() + " is not part of the topology");
+			indices.push_back(search->second);
+		}
+		index.components.push_back(comp);
+		index.componentNodes.push_back(indices);
+	}
+}
+
+template <typename VarType>
+void ModelTemplate::clone(const Index<VarType>& index, SystemTopology& topology) const {
+	typename SimNode<VarType>::List nodes;
+	nodes.reserve(index.nodes.size());
+	for (auto& node : index.nodes) {
+		auto nodeCopy = SimNode<VarType>::make(node->name(), node->phaseType());
+		nodeCopy->setInitialVoltage(node->initialVoltage());
+		nodes.push_back(nodeCopy);
+		topology.addNode(nodeCopy);
+	}
+
+	for (std::size_t nComp = 0; nComp < index.components.size(); nComp++) {
+		auto& comp = index.components[nComp];
+		auto compCopy = comp->clone(comp->name());
+		if (!compCopy)
+			throw SystemError("copy() not implemented for " + comp->name());
+
+		typename SimNode<VarType>::List nodeCopies;
+		for (auto nodeIndex : index.componentNodes[nComp])
+			nodeCopies.push_back(nodeIndex < 0 ? SimNode<VarType>::GND : nodes[nodeIndex]);
+		compCopy->connect(nodeCopies);
+
+		// Terminal powers for the initialization from the power flow
+		for (UInt nTerminal = 0; nTerminal < comp->terminalNumber(); nTerminal++)
+			compCopy->terminal(nTerminal)->setPower(comp->terminal(nTerminal)->power());
+		topology.addComponent(compCopy);
+	}
+}
+
+SystemTopology ModelTemplate::instantiate() const {
+	auto pool = std::make_shared<ObjectPool>();
+	{
+		std::lock_guard<std::mutex> lock(mPoolsMutex);
+		mPools.push_back(pool);
+	}
+	ObjectPool::Scope poolScope(pool);
+
+	SystemTopology topology(mSystemFrequency);
+	topology.mFrequencies = mFrequencies;
+	clone<Real>(mRealIndex, topology);
+	clone<Complex>(mComplexIndex, topology);
+	topology.componentsAtNodeList();
+	return topology;
+}
+
+std::vector<SystemTopology> ModelTemplate::instantiate(UInt count, Bool parallel) const {
+	std::vector<SystemTopology> scenarios(count);
+	std::exception_ptr error;
+	#pragma omp parallel for schedule(dynamic) if(parallel)
+	for (Int i = 0; i < static_cast<Int>(count); ++i) {
+		try {
+			scenarios[i] = instantiate();
+		}
+		catch (...) {
+			#pragma omp critical
+			if (!error)
+				error = std::current_exception();
+		}
+	}
+	if (error)
+		std::rethrow_exception(error);
+
+	SPDLOG_LOGGER_INFO(mSLog, "Created {} scenarios of model template {}", count, mName);
+	return scenarios;
+}
+
+std::size_t ModelTemplate::scenarioBytes() const {
+	std::lock_guard<std::mutex> lock(mPoolsMutex);
+	std::size_t bytes = 0;
+	for (auto& weakPool : mPools) {
+		if (auto pool = weakPool.lock())
+			bytes += pool->reservedBytes();
+	}
+	return bytes;
+}
@@ -0,0 +1,102 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/MpiLink.h>
+
+#include <algorithm>
+
+using namespace CPS;
+using namespace DPsim;
+
+MpiLink::MpiLink(int peer, int tag, UInt depth, MPI_Comm comm) :
+	mPeer(peer),
+	mTag(tag),
+	mDepth(depth),
+	mComm(comm),
+	mSendBuffers(static_cast<std::size_t>(depth) * RecordSize),
+	mSendRequests(depth, MPI_REQUEST_NULL),
+	mRecvBuffers(static_cast<std::size_t>(depth) * RecordSize),
+	mRecvRequests(depth, MPI_REQUEST_NULL) {
+	if (mDepth == 0)
+		throw SystemError("MPI link requires a depth of at least one record.");
+
+	int initialized;
+	MPI_Initialized(&initialized);
+	if (!initialized)
+		throw SystemError("MPI has to be initialized before creating an MPI link.");
+
+	// Messages between two ranks with the same tag arrive in order, so the
+	// receives match the records in the order they are posted
+	for (UInt slot = 0; slot < mDepth; ++slot)
+		postReceive(slot);
+}
+
+MpiLink::~MpiLink() {
+	int finalized;
+	MPI_Finalized(&finalized);
+	if (finalized)
+		return;
+
+	MPI_Waitall(static_cast<int>(mDepth), mSendRequests.data(), MPI_STATUSES_IGNORE);
+	for (auto& request : mRecvRequests) {
+		if (request == MPI_REQUEST_NULL)
+			continue;
+		MPI_Cancel(&request);
+		MPI_Wait(&request, MPI_STATUS_IGNORE);
+	}
+}
+
+void MpiLink::postReceive(UInt slot) {
+	MPI_Irecv(&mRecvBuffers[slot * RecordSize], RecordSize, MPI_DOUBLE, mPeer, mTag, mComm, &mRecvRequests[slot]);
+}
+
+void MpiLink::sendRecord(uint64_t index, const Real* values) {
+	if (index != mSent)
+		throw SystemError("Records of an MPI link must be sent in order.");
+
+	// Reuse the slot once the record sent depth records ago has left the buffer
+	UInt slot = static_cast<UInt>(index % mDepth);
+	MPI_Wait(&mSendRequests[slot], MPI_STATUS_IGNORE);
+	Real* buffer = &mSendBuffers[slot * RecordSize];
+	std::copy(values, values + RecordSize, buffer);
+	MPI_Isend(buffer, RecordSize, MPI_DOUBLE, mPeer, mTag, mComm, &mSendRequests[slot]);
+	mSent++;
+}
+
+const Real* MpiLink::receiveRecord(uint64_t index) {
+	if (index + 2 < mReceived)
+		throw SystemError("Record of MPI link has already been discarded.");
+
+	while (mReceived <= index) {
+		UInt slot = static_cast<UInt>(mReceived % mDepth);
+		MPI_Wait(&mRecvRequests[slot], MPI_STATUS_IGNORE);
+		const Real* buffer = &mRecvBuffers[slot * RecordSize];
+		std::copy(buffer, buffer + RecordSize, mHistory[mReceived % 2]);
+		postReceive(slot);
+		mReceived++;
+	}
+	return mHistory[index % 2];
+}
+
+Complex MpiLink::exchangeInitialVoltage(Complex voltage) {
+	Real record[RecordSize] = { voltage.real(), voltage.imag(), 0, 0 };
+	sendRecord(0, record);
+	const Real* received = receiveRecord(0);
+	return { received[0], received[1] };
+}
+
+void MpiLink::send(Int timeStepCount, Complex voltage, Complex current) {
+	Real record[RecordSize] = { voltage.real(), voltage.imag(), current.real(), current.imag() };
+	sendRecord(static_cast<uint64_t>(timeStepCount) + 1, record);
+}
+
+void MpiLink::receive(Int timeStepCount, Complex& voltage, Complex& current) {
+	const Real* received = receiveRecord(static_cast<uint64_t>(timeStepCount) + 1);
+	voltage = { received[0], received[1] };
+	current = { received[2], received[3] };
+}
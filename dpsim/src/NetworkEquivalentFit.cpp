@@ -0,0 +1,269 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/SparseLU>
+
+#include <dpsim/NetworkEquivalentFit.h>
+#include <dpsim-models/Solver/MNAInterface.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+NetworkEquivalentFit::NetworkEquivalentFit(String name, const SystemTopology& external,
+	const std::vector<String>& boundaryNodes, Logger::Level logLevel)
+	: mName(name), mSLog(Logger::get(name, logLevel)),
+	  mTemplate(name + "_template", external, logLevel), mBoundaryNodes(boundaryNodes) {
+	if (boundaryNodes.empty())
+		throw SystemError("Network equivalent " + name + " has no boundary nodes.");
+}
+
+MatrixComp NetworkEquivalentFit::admittance(Real frequency) const {
+	// A fresh copy, as composite components create their sub components in the initialization
+	SystemTopology system = mTemplate.instantiate();
+
+	UInt index = 0;
+	auto assignIndices = [&index](const SimNode<Complex>::Ptr& node) {
+		UInt phases = node->phaseType() == PhaseType::ABC ? 3 : 1;
+		for (UInt phase = 0; phase < phases; ++phase)
+			node->setMatrixNodeIndex(phase, index++);
+	};
+	std::map<String, UInt> nodeIndices;
+	for (auto baseNode : system.mNodes) {
+		auto node = std::dynamic_pointer_cast<SimNode<Complex>>(baseNode);
+		if (!node || node->isGround())
+			continue;
+		nodeIndices[node->name()] = index;
+		assignIndices(node);
+	}
+
+	SimPowerComp<Complex>::List comps;
+	for (auto baseComp : system.mComponents) {
+		auto comp = std::dynamic_pointer_cast<SimPowerComp<Complex>>(baseComp);
+		if (!comp)
+			continue;
+		comp->initializeFromNodesAndTerminals(frequency);
+		comps.push_back(comp);
+	}
+	// Virtual nodes are placed after the network nodes as in the MNA solver
+	for (auto comp : comps) {
+		for (UInt node = 0; node < comp->virtualNodesNumber(); ++node)
+			assignIndices(comp->virtualNode(node));
+		for (auto subComp : comp->subComponents()) {
+			for (UInt node = 0; node < subComp->virtualNodesNumber(); ++node)
+				assignIndices(subComp->virtualNode(node));
+		}
+	}
+
+	// The time step is not used by the SP models
+	const Real omega = 2. * PI * frequency;
+	const UInt n = index;
+	auto leftVector = AttributeStatic<Matrix>::make(Matrix::Zero(2 * n, 1));
+	SparseMatrixRow stamped(2 * n, 2 * n);
+	for (auto comp : comps) {
+		auto mnaComp = std::dynamic_pointer_cast<MNAInterface>(comp);
+		if (!mnaComp)
+			continue;
+		mnaComp->mnaInitialize(omega, 1e-4, leftVector);
+		mnaComp->mnaApplySystemMatrixStamp(stamped);
+	}
+	SparseMatrix matrix = stamped;
+	matrix.makeCompressed();
+
+	Eigen::SparseLU<SparseMatrix> lu;
+	lu.compute(matrix);
+	if (lu.info() != Eigen::Success)
+		throw SystemError("System matrix of network equivalent " + mName + " is singular at " + std::to_string(frequency) + " Hz.");
+
+	// Impedance matrix at the boundary from unit current injections
+	const UInt ports = static_cast<UInt>(mBoundaryNodes.size());
+	std::vector<UInt> rows;
+	Matrix injections = Matrix::Zero(2 * n, ports);
+	for (UInt port = 0; port < ports; ++port) {
+		auto search = nodeIndices.find(mBoundaryNodes[port]);
+		if (search == nodeIndices.end())
+			throw SystemError("Boundary node " + mBoundaryNodes[port] + " is not part of network equivalent " + mName + ".");
+		rows.push_back(search->second);
+		injections(search->second, port) = 1;
+	}
+	Matrix solution = lu.solve(injections);
+	MatrixComp impedance(ports, ports);
+	for (UInt row = 0; row < ports; ++row) {
+		for (UInt col = 0; col < ports; ++col)
+			impedance(row, col) = Complex(solution(rows[row], col), solution(rows[row] + n, col));
+	}
+	return impedance.inverse();
+}
+
+void NetworkEquivalentFit::sweep(const std::vector<Real>& frequencies) {
+	mFrequencies = frequencies;
+	std::sort(mFrequencies.begin(), mFrequencies.end());
+	mAdmittances.clear();
+	for (Real frequency : mFrequencies)
+		mAdmittances.push_back(admittance(frequency));
+	SPDLOG_LOGGER_INFO(mSLog, "Computed the admittance at {} boundary nodes for {} frequencies",
+		mBoundaryNodes.size(), mFrequencies.size());
+}
+
+MatrixComp NetworkEquivalentFit::basis(const std::vector<Complex>& poles) const {
+	MatrixComp phi(mFrequencies.size(), poles.size());
+	for (std::size_t k = 0; k < mFrequencies.size(); ++k) {
+		Complex s(0, 2. * PI * mFrequencies[k]);
+		for (std::size_t i = 0; i < poles.size(); ++i) {
+			if (poles[i].imag() > 0) {
+				// Real coefficients c1, c2 give the residues c1 + j c2 and c1 - j c2 of the pair
+				phi(k, i) = 1. / (s - poles[i]) + 1. / (s - std::conj(poles[i]));
+				phi(k, i + 1) = Complex(0, 1) / (s - poles[i]) - Complex(0, 1) / (s - std::conj(poles[i]));
+				++i;
+			} else {
+				phi(k, i) = 1. / (s - poles[i]);
+			}
+		}
+	}
+	return phi;
+}
+
+MatrixComp NetworkEquivalentFit::responses() const {
+	const UInt ports = static_cast<UInt>(mBoundaryNodes.size());
+	MatrixComp f(ports * (ports + 1) / 2, mFrequencies.size());
+	for (std::size_t k = 0; k < mFrequencies.size(); ++k) {
+		UInt m = 0;
+		for (UInt row = 0; row < ports; ++row) {
+			for (UInt col = row; col < ports; ++col)
+				f(m++, k) = mAdmittances[k](row, col);
+		}
+	}
+	return f;
+}
+
+NetworkEquivalentFit::Model NetworkEquivalentFit::fit(UInt numPoles, UInt iterations) {
+	const UInt numFreqs = static_cast<UInt>(mFrequencies.size());
+	if (numPoles == 0 || 2 * numFreqs < 2 * numPoles + 1)
+		throw SystemError("Network equivalent " + mName + " needs more frequencies than poles.");
+
+	// Starting poles: weakly damped pairs spread logarithmically over the sweep,
+	// and a real pole if the number is odd
+	Real omegaMax = 2. * PI * mFrequencies.back();
+	Real omegaMin = std::max(2. * PI * mFrequencies.front(), omegaMax * 1e-3);
+	std::vector<Complex> poles;
+	if (numPoles % 2)
+		poles.push_back(-omegaMin);
+	UInt pairs = numPoles / 2;
+	for (UInt i = 0; i < pairs; ++i) {
+		Real beta = pairs > 1 ? omegaMin * std::pow(omegaMax / omegaMin, Real(i) / (pairs - 1)) : omegaMax;
+		poles.push_back(Complex(-beta / 100., beta));
+		poles.push_back(Complex(-beta / 100., -beta));
+	}
+
+	const MatrixComp f = responses();
+	const UInt numElements = static_cast<UInt>(f.rows());
+	for (UInt iteration = 0; iteration < iterations; ++iteration) {
+		// f * sigma = sum c_i phi_i + d with sigma = 1 + sum c~_i phi_i. The coefficients of
+		// each element are eliminated by a QR decomposition, the common c~ remain.
+		MatrixComp phi = basis(poles);
+		Matrix reduced(numElements * numPoles, numPoles);
+		Matrix reducedRhs(numElements * numPoles, 1);
+		for (UInt m = 0; m < numElements; ++m) {
+			MatrixComp a(numFreqs, 2 * numPoles + 1);
+			a.leftCols(numPoles) = phi;
+			a.col(numPoles).setOnes();
+			a.rightCols(numPoles) = -(f.row(m).transpose().asDiagonal() * phi);
+			Matrix aReal(2 * numFreqs, 2 * numPoles + 1);
+			aReal << a.real(), a.imag();
+			Matrix b(2 * numFreqs, 1);
+			b << f.row(m).transpose().real(), f.row(m).transpose().imag();
+
+			Eigen::HouseholderQR<Matrix> qr(aReal);
+			Matrix r = qr.matrixQR().topRows(2 * numPoles + 1).triangularView<Eigen::Upper>();
+			Matrix qb = qr.householderQ().adjoint() * b;
+			reduced.middleRows(m * numPoles, numPoles) = r.block(numPoles + 1, numPoles + 1, numPoles, numPoles);
+			reducedRhs.middleRows(m * numPoles, numPoles) = qb.middleRows(numPoles + 1, numPoles);
+		}
+		Matrix sigma = reduced.colPivHouseholderQr().solve(reducedRhs);
+
+		// The zeros of sigma are the new poles
+		Matrix a = Matrix::Zero(numPoles, numPoles);
+		Matrix b = Matrix::Zero(numPoles, 1);
+		for (UInt i = 0; i < numPoles; ++i) {
+			if (poles[i].imag() > 0) {
+				a(i, i) = a(i + 1, i + 1) = poles[i].real();
+				a(i, i + 1) = poles[i].imag();
+				a(i + 1, i) = -poles[i].imag();
+				b(i, 0) = 2;
+				++i;
+			} else {
+				a(i, i) = poles[i].real();
+				b(i, 0) = 1;
+			}
+		}
+		Eigen::EigenSolver<Matrix> eigen(a - b * sigma.transpose(), false);
+		std::vector<Complex> zeros;
+		for (Int i = 0; i < eigen.eigenvalues().size(); ++i) {
+			Complex zero = eigen.eigenvalues()(i);
+			// Unstable poles are flipped into the left half plane
+			if (zero.real() > 0)
+				zero = Complex(-zero.real(), zero.imag());
+			if (std::abs(zero.imag()) <= 1e-9 * std::abs(zero))
+				zeros.push_back(zero.real());
+			else if (zero.imag() > 0) {
+				zeros.push_back(zero);
+				zeros.push_back(std::conj(zero));
+			}
+		}
+		if (zeros.size() != numPoles)
+			break;
+		poles = zeros;
+	}
+
+	// Residues and constant part with the final poles
+	const UInt ports = static_cast<UInt>(mBoundaryNodes.size());
+	Model model;
+	model.constant = Matrix::Zero(ports, ports);
+	model.poles = poles;
+	model.residues.assign(numPoles, MatrixComp::Zero(ports, ports));
+
+	MatrixComp phi = basis(poles);
+	Matrix aReal(2 * numFreqs, numPoles + 1);
+	aReal << phi.real(), Matrix::Ones(numFreqs, 1), phi.imag(), Matrix::Zero(numFreqs, 1);
+	auto qr = aReal.colPivHouseholderQr();
+	UInt m = 0;
+	for (UInt row = 0; row < ports; ++row) {
+		for (UInt col = row; col < ports; ++col, ++m) {
+			Matrix b(2 * numFreqs, 1);
+			b << f.row(m).transpose().real(), f.row(m).transpose().imag();
+			Matrix c = qr.solve(b);
+			for (UInt i = 0; i < numPoles; ++i) {
+				Complex residue = c(i, 0);
+				if (poles[i].imag() > 0) {
+					residue = Complex(c(i, 0), c(i + 1, 0));
+					model.residues[i + 1](row, col) = model.residues[i + 1](col, row) = std::conj(residue);
+				}
+				model.residues[i](row, col) = model.residues[i](col, row) = residue;
+				if (poles[i].imag() > 0)
+					++i;
+			}
+			model.constant(row, col) = model.constant(col, row) = c(numPoles, 0);
+		}
+	}
+
+	Real maxAdmittance = 0;
+	Real maxDeviation = 0;
+	for (UInt k = 0; k < numFreqs; ++k) {
+		maxAdmittance = std::max(maxAdmittance, mAdmittances[k].cwiseAbs().maxCoeff());
+		maxDeviation = std::max(maxDeviation,
+			(model.admittance(2. * PI * mFrequencies[k]) - mAdmittances[k]).cwiseAbs().maxCoeff());
+	}
+	mFitError = maxAdmittance > 0 ? maxDeviation / maxAdmittance : maxDeviation;
+	SPDLOG_LOGGER_INFO(mSLog, "Fitted {} poles to {} frequencies with a relative error of {:e}",
+		numPoles, numFreqs, mFitError);
+	return model;
+}
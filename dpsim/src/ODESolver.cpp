@@ -6,38 +6,58 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+
 #include <dpsim/ODESolver.h>
 #include <dpsim-models/SimPowerComp.h>
 
 using namespace DPsim;
 
 ODESolver::ODESolver(String name, const CPS::ODEInterface::Ptr &comp, bool implicit_integration, Real timestep) :
+	ODESolver(name, CPS::ODEInterface::List{comp}, implicit_integration, timestep) { }
+
+ODESolver::ODESolver(String name, const CPS::ODEInterface::List &comps, bool implicit_integration, Real timestep) :
 	Solver(name, CPS::Logger::Level::info),
-	mComponent(comp),
+	mComponents(comps),
 	mImplicitIntegration(implicit_integration),
 	mTimestep(timestep) {
-	mProbDim = mComponent->mOdePreState->get().rows();
+	if (mComponents.empty())
+		throw CPS::SystemError("ODE solver " + name + " has no components");
+
+	mStateOffsets.push_back(0);
+	for (auto comp : mComponents)
+		mStateOffsets.push_back(mStateOffsets.back() + static_cast<Int>(comp->mOdePreState->get().rows()));
+	mProbDim = mStateOffsets.back();
 	initialize();
 }
 
 void ODESolver::initialize() {
-	mStates=N_VNew_Serial(mProbDim);
-	// Set initial value: (Different from DAESolver), only for already initialized components!
-	// XXX
-	N_VSetArrayPointer((**mComponent->mOdePostState).data(), mStates);
-	// Forbid SUNdials from deleting the underlying state vector (which is managed
-	// by our attribute / shared_ptr system)
-	NV_OWN_DATA_S(mStates) = false;
+	if (mComponents.size() == 1) {
+		mStates=N_VNew_Serial(mProbDim);
+		// Set initial value: (Different from DAESolver), only for already initialized components!
+		// XXX
+		N_VSetArrayPointer((**mComponents[0]->mOdePostState).data(), mStates);
+		// Forbid SUNdials from deleting the underlying state vector (which is managed
+		// by our attribute / shared_ptr system)
+		NV_OWN_DATA_S(mStates) = false;
+	} else {
+		// The states of the components are copied in and out in every step
+		mStates=N_VNew_Serial(mProbDim);
+	}
 
 	// Analogous to DAESolver
-	CPS::ODEInterface::Ptr dummy = mComponent;
-	mStSpFunction = [dummy](double t, const double y[], double ydot[]) {
-		dummy->odeStateSpace(t, y, ydot);
-	};
-	mJacFunction = [dummy](double t, const double y[], double fy[], double J[],
-	                       double tmp1[], double tmp2[], double tmp3[]) {
-		dummy->odeJacobian(t, y, fy, J, tmp1, tmp2, tmp3);
-	};
+	mStSpFunctions.clear();
+	mJacFunctions.clear();
+	for (auto comp : mComponents) {
+		CPS::ODEInterface::Ptr dummy = comp;
+		mStSpFunctions.push_back([dummy](double t, const double y[], double ydot[]) {
+			dummy->odeStateSpace(t, y, ydot);
+		});
+		mJacFunctions.push_back([dummy](double t, const double y[], double fy[], double J[],
+		                                double tmp1[], double tmp2[], double tmp3[]) {
+			dummy->odeJacobian(t, y, fy, J, tmp1, tmp2, tmp3);
+		});
+	}
 
 
 	// Causes numerical issues, better allocate in every step-> see step
@@ -95,7 +115,14 @@ int ODESolver::StateSpaceWrapper(realtype t, N_Vector y, N_Vector ydot, void *us
 }
 
 int ODESolver::StateSpace(realtype t, N_Vector y, N_Vector ydot){
-	mStSpFunction(t, NV_DATA_S(y), NV_DATA_S(ydot));
+	realtype* yData = NV_DATA_S(y);
+	realtype* ydotData = NV_DATA_S(ydot);
+	// The components are independent of each other
+#ifdef WITH_OPENMP
+	#pragma omp parallel for schedule(static) if(mComponents.size() > 1)
+#endif
+	for (Int c = 0; c < static_cast<Int>(mComponents.size()); ++c)
+		mStSpFunctions[c](t, yData + mStateOffsets[c], ydotData + mStateOffsets[c]);
 	return 0;
 }
 
@@ -105,13 +132,150 @@ int ODESolver::JacobianWrapper(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
 	return self->Jacobian(t, y, fy, J, tmp1, tmp2, tmp3);
 }
 
+void ODESolver::evaluateJacobianBlocks(realtype t, N_Vector y, N_Vector fy,
+                                       N_Vector tmp1, N_Vector tmp2, N_Vector tmp3) {
+	if (mJacobianBlocks.size() != mComponents.size()) {
+		mJacobianBlocks.resize(mComponents.size());
+		for (UInt c = 0; c < mComponents.size(); ++c) {
+			Int dim = mStateOffsets[c + 1] - mStateOffsets[c];
+			mJacobianBlocks[c].assign(dim * dim, 0.0);
+		}
+	}
+
+#ifdef WITH_OPENMP
+	#pragma omp parallel for schedule(static) if(mComponents.size() > 1)
+#endif
+	for (Int c = 0; c < static_cast<Int>(mComponents.size()); ++c) {
+		Int offset = mStateOffsets[c];
+		std::fill(mJacobianBlocks[c].begin(), mJacobianBlocks[c].end(), 0.0);
+		mJacFunctions[c](t, NV_DATA_S(y) + offset, NV_DATA_S(fy) + offset, mJacobianBlocks[c].data(),
+		                 NV_DATA_S(tmp1) + offset, NV_DATA_S(tmp2) + offset, NV_DATA_S(tmp3) + offset);
+	}
+}
+
 int ODESolver::Jacobian(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
                N_Vector tmp1, N_Vector tmp2, N_Vector tmp3){
-	mJacFunction(t, NV_DATA_S(y), NV_DATA_S(fy), SM_DATA_D(J),
-	             NV_DATA_S(tmp1), NV_DATA_S(tmp2), NV_DATA_S(tmp3));
+	if (SUNMatGetID(J) == SUNMATRIX_DENSE && mComponents.size() == 1) {
+		mJacFunctions[0](t, NV_DATA_S(y), NV_DATA_S(fy), SM_DATA_D(J),
+		                 NV_DATA_S(tmp1), NV_DATA_S(tmp2), NV_DATA_S(tmp3));
+		return 0;
+	}
+
+	// The components fill dense blocks, which are gathered into the block diagonal Jacobian
+	evaluateJacobianBlocks(t, y, fy, tmp1, tmp2, tmp3);
+
+	if (SUNMatGetID(J) == SUNMATRIX_SPARSE) {
+		std::copy(mJacobianColumnPointers.begin(), mJacobianColumnPointers.end(), SM_INDEXPTRS_S(J));
+		std::copy(mJacobianRowIndices.begin(), mJacobianRowIndices.end(), SM_INDEXVALS_S(J));
+		realtype* values = SM_DATA_S(J);
+		for (UInt c = 0; c < mComponents.size(); ++c) {
+			Int offset = mStateOffsets[c];
+			Int dim = mStateOffsets[c + 1] - offset;
+			for (Int col = offset; col < offset + dim; ++col) {
+				for (sunindextype k = mJacobianColumnPointers[col]; k < mJacobianColumnPointers[col + 1]; ++k)
+					values[k] = mJacobianBlocks[c][(col - offset) * dim + mJacobianRowIndices[k] - offset];
+			}
+		}
+		return 0;
+	}
+
+	SUNMatZero(J);
+	for (UInt c = 0; c < mComponents.size(); ++c) {
+		Int offset = mStateOffsets[c];
+		Int dim = mStateOffsets[c + 1] - offset;
+		for (Int col = 0; col < dim; ++col)
+			std::copy_n(mJacobianBlocks[c].data() + col * dim, dim, SM_COLUMN_D(J, offset + col) + offset);
+	}
 	return 0;
 }
 
+void ODESolver::setLinearSolver(SundialsLinearSolver linearSolver) {
+	mLinearSolver = linearSolver;
+}
+
+void ODESolver::initializeJacobianPattern() {
+	std::vector<std::pair<Int, Int>> entries;
+	for (UInt c = 0; c < mComponents.size(); ++c) {
+		Int offset = mStateOffsets[c];
+		Int dim = mStateOffsets[c + 1] - offset;
+		auto block = mComponents[c]->odeJacobianPattern();
+		if (block.empty()) {
+			for (Int col = 0; col < dim; ++col)
+				for (Int row = 0; row < dim; ++row)
+					block.emplace_back(row, col);
+		}
+		for (auto& entry : block) {
+			if (entry.first < 0 || entry.first >= dim || entry.second < 0 || entry.second >= dim)
+				throw CPS::SystemError("Jacobian pattern entry out of range");
+			entries.emplace_back(entry.first + offset, entry.second + offset);
+		}
+	}
+	// The diagonal is needed for the Newton matrix I - gamma J
+	for (Int k = 0; k < mProbDim; ++k)
+		entries.emplace_back(k, k);
+
+	// Column-major order without duplicates
+	std::sort(entries.begin(), entries.end(), [](const std::pair<Int, Int>& a, const std::pair<Int, Int>& b) {
+		return a.second < b.second || (a.second == b.second && a.first < b.first);
+	});
+	entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+	mJacobianColumnPointers.assign(mProbDim + 1, 0);
+	mJacobianRowIndices.clear();
+	for (auto& entry : entries) {
+		mJacobianRowIndices.push_back(entry.first);
+		++mJacobianColumnPointers[entry.second + 1];
+	}
+	for (Int col = 0; col < mProbDim; ++col)
+		mJacobianColumnPointers[col + 1] += mJacobianColumnPointers[col];
+}
+
+void ODESolver::createLinearSolver() {
+	switch (mLinearSolver) {
+	case SundialsLinearSolver::Dense:
+		// Initialize dense matrix data structure
+		A = SUNDenseMatrix(mProbDim, mProbDim);
+		if (check_flag((void *)A, "SUNDenseMatrix", 0)) throw CPS::Exception();
+
+		// Initialize linear solver
+		LS = SUNDenseLinearSolver(mStates, A);
+		if (check_flag((void *)LS, "SUNDenseLinearSolver", 0)) throw CPS::Exception();
+		break;
+
+	case SundialsLinearSolver::SparseKLU:
+#ifdef WITH_SUNDIALS_KLU
+		if (mJacobianRowIndices.empty())
+			initializeJacobianPattern();
+
+		A = SUNSparseMatrix(mProbDim, mProbDim, mJacobianRowIndices.size(), CSC_MAT);
+		if (check_flag((void *)A, "SUNSparseMatrix", 0)) throw CPS::Exception();
+
+		LS = SUNKLU(mStates, A);
+		if (check_flag((void *)LS, "SUNKLU", 0)) throw CPS::Exception();
+		break;
+#else
+		throw CPS::SystemError("The sparse ODE linear solver requires SUNDIALS with KLU support");
+#endif
+
+	case SundialsLinearSolver::GMRES:
+		// Matrix-free, the Jacobian-vector products are approximated by difference quotients
+		LS = SUNSPGMR(mStates, PREC_NONE, 0);
+		if (check_flag((void *)LS, "SUNSPGMR", 0)) throw CPS::Exception();
+
+		mFlag = ARKSpilsSetLinearSolver(mArkode_mem, LS);
+		if (check_flag(&mFlag, "ARKSpilsSetLinearSolver", 1)) throw CPS::Exception();
+		return;
+	}
+
+	// Attach matrix and linear solver
+	mFlag = ARKDlsSetLinearSolver(mArkode_mem, LS, A);
+	if (check_flag(&mFlag, "ARKDlsSetLinearSolver", 1)) throw CPS::Exception();
+
+	// Set Jacobian routine
+	mFlag = ARKDlsSetJacFn(mArkode_mem, &ODESolver::JacobianWrapper);
+	if (check_flag(&mFlag, "ARKDlsSetJacFn", 1)) throw CPS::Exception();
+}
+
 Real ODESolver::step(Real initial_time) {
 	// Not absolutely necessary; realtype by default double (same as Real)
 	realtype T0 = (realtype) initial_time;
@@ -122,7 +286,13 @@ Real ODESolver::step(Real initial_time) {
 	/// Number of error test fails
 	long int netf;
 
-	mComponent->mOdePostState->set(mComponent->mOdePreState->get());
+	for (auto comp : mComponents)
+		comp->mOdePostState->set(comp->mOdePreState->get());
+	if (mComponents.size() > 1) {
+		for (UInt c = 0; c < mComponents.size(); ++c)
+			std::copy_n((**mComponents[c]->mOdePostState).data(), mStateOffsets[c + 1] - mStateOffsets[c],
+			            NV_DATA_S(mStates) + mStateOffsets[c]);
+	}
 
 	// Better allocate the arkode memory here to prevent numerical problems
 	mArkode_mem= ARKodeCreate();
@@ -140,21 +310,7 @@ Real ODESolver::step(Real initial_time) {
  		mFlag = ARKodeInit(mArkode_mem, NULL, &ODESolver::StateSpaceWrapper, initial_time, mStates);
  		if (check_flag(&mFlag, "ARKodeInit", 1)) throw CPS::Exception();
 
- 		// Initialize dense matrix data structure
- 	  A = SUNDenseMatrix(mProbDim, mProbDim);
- 	  if (check_flag((void *)A, "SUNDenseMatrix", 0)) throw CPS::Exception();
-
- 		// Initialize linear solver
- 	  LS = SUNDenseLinearSolver(mStates, A);
- 	  if (check_flag((void *)LS, "SUNDenseLinearSolver", 0)) throw CPS::Exception();
-
- 		// Attach matrix and linear solver
- 		mFlag = ARKDlsSetLinearSolver(mArkode_mem, LS, A);
- 		if (check_flag(&mFlag, "ARKDlsSetLinearSolver", 1)) throw CPS::Exception();
-
- 		// Set Jacobian routine
- 		mFlag = ARKDlsSetJacFn(mArkode_mem, &ODESolver::JacobianWrapper);
- 		if (check_flag(&mFlag, "ARKDlsSetJacFn", 1)) throw CPS::Exception();
+ 		createLinearSolver();
  	}
  	else {
  		mFlag = ARKodeInit(mArkode_mem, &ODESolver::StateSpaceWrapper, NULL, initial_time, mStates);
@@ -173,6 +329,12 @@ Real ODESolver::step(Real initial_time) {
 		if (check_flag(&mFlag, "ARKode", 1))	break;
 	}
 
+	if (mComponents.size() > 1) {
+		for (UInt c = 0; c < mComponents.size(); ++c)
+			std::copy_n(NV_DATA_S(mStates) + mStateOffsets[c], mStateOffsets[c + 1] - mStateOffsets[c],
+			            (**mComponents[c]->mOdePostState).data());
+	}
+
 	// Get some statistics to check for numerical problems (instability, blow-up etc)
 	mFlag = ARKodeGetNumSteps(mArkode_mem, &nst);
 	 if(check_flag(&mFlag, "ARKodeGetNumSteps", 1))
@@ -182,8 +344,12 @@ Real ODESolver::step(Real initial_time) {
 		return 1;
 
 	ARKodeFree(&mArkode_mem);
-	SUNLinSolFree(LS);
-	SUNMatDestroy(A);
+	if (LS)
+		SUNLinSolFree(LS);
+	if (A)
+		SUNMatDestroy(A);
+	LS = nullptr;
+	A = nullptr;
 
 	// Print statistics:
 	//std::cout << "Number Computing Steps: "<< nst << " Number Error-Test-Fails: " << netf << std::endl;
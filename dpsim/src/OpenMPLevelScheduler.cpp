@@ -9,6 +9,7 @@
 #include <dpsim/OpenMPLevelScheduler.h>
 #include <omp.h>
 
+#include <algorithm>
 #include <iostream>
 
 using namespace CPS;
@@ -27,24 +28,28 @@ void OpenMPLevelScheduler::createSchedule(const Task::List& tasks, const Edges&
 	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
 	Scheduler::levelSchedule(ordered, inEdges, outEdges, mLevels);
 
+	// The OpenMP runtime keeps the threads of the team for the following
+	// parallel regions, so they are pinned once
+	if (mExecutor) {
+		mNumThreads = std::min<Int>(mNumThreads, mExecutor->concurrency());
+		#pragma omp parallel num_threads(mNumThreads)
+		mExecutor->pin(omp_get_thread_num());
+	}
+
 	if (!mOutMeasurementFile.empty())
 		Scheduler::initMeasurements(tasks);
 }
 
 void OpenMPLevelScheduler::step(Real time, Int timeStepCount) {
 	long i, level = 0;
-	std::chrono::steady_clock::time_point start, end;
 
 	if (!mOutMeasurementFile.empty()) {
-		#pragma omp parallel shared(time,timeStepCount) private(level, i, start, end) num_threads(mNumThreads)
+		#pragma omp parallel shared(time,timeStepCount) private(level, i) num_threads(mNumThreads)
 		for (level = 0; level < static_cast<long>(mLevels.size()); level++) {
 			{
 				#pragma omp for schedule(static)
 				for (i = 0; i < static_cast<long>(mLevels[level].size()); i++) {
-					start = std::chrono::steady_clock::now();
-					mLevels[level][i]->execute(time, timeStepCount);
-					end = std::chrono::steady_clock::now();
-					updateMeasurement(mLevels[level][i].get(), end-start);
+					measureTask(mLevels[level][i].get(), time, timeStepCount, omp_get_thread_num());
 				}
 			}
 		}
@@ -54,7 +59,7 @@ void OpenMPLevelScheduler::step(Real time, Int timeStepCount) {
 			{
 				#pragma omp for schedule(static)
 				for (i = 0; i < static_cast<long>(mLevels[level].size()); i++) {
-					mLevels[level][i]->execute(time, timeStepCount);
+					executeTask(mLevels[level][i].get(), time, timeStepCount, omp_get_thread_num());
 				}
 			}
 		}
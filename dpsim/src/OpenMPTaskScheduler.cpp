@@ -0,0 +1,102 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/OpenMPTaskScheduler.h>
+#include <omp.h>
+
+#include <algorithm>
+
+using namespace CPS;
+using namespace DPsim;
+
+OpenMPTaskScheduler::OpenMPTaskScheduler(Int threads, String outMeasurementFile, String inMeasurementFile) :
+	mOutMeasurementFile(outMeasurementFile), mInMeasurementFile(inMeasurementFile) {
+	if (threads >= 0)
+		mNumThreads = threads;
+	else
+		mNumThreads = omp_get_max_threads();
+}
+
+void OpenMPTaskScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, mTasks);
+
+	std::unordered_map<Task::Ptr, Int> indices;
+	for (std::size_t i = 0; i < mTasks.size(); i++)
+		indices[mTasks[i]] = static_cast<Int>(i);
+
+	mPredecessors.assign(mTasks.size(), std::vector<Int>());
+	for (std::size_t i = 0; i < mTasks.size(); i++) {
+		if (inEdges.find(mTasks[i]) == inEdges.end())
+			continue;
+		for (auto before : inEdges.at(mTasks[i])) {
+			auto it = indices.find(before);
+			if (it != indices.end())
+				mPredecessors[i].push_back(it->second);
+		}
+	}
+
+	// Scale the HLFET priorities to the priority range of the OpenMP runtime
+	std::unordered_map<String, TaskTime::rep> costs;
+	readTaskCosts(mInMeasurementFile, mTasks, costs);
+	std::unordered_map<Task::Ptr, int64_t> priorities;
+	hlfetPriorities(mTasks, outEdges, costs, priorities);
+
+	int64_t highest = 0;
+	for (auto& entry : priorities)
+		highest = std::max(highest, entry.second);
+	Int maxPriority = omp_get_max_task_priority();
+	mPriorities.assign(mTasks.size(), 0);
+	for (std::size_t i = 0; i < mTasks.size(); i++) {
+		if (highest > 0)
+			mPriorities[i] = static_cast<Int>(priorities[mTasks[i]] * maxPriority / highest);
+	}
+
+	mDependencies.assign(mTasks.size(), 0);
+
+	// The OpenMP runtime keeps the threads of the team for the following
+	// parallel regions, so they are pinned once
+	if (mExecutor) {
+		mNumThreads = std::min<Int>(mNumThreads, mExecutor->concurrency());
+		#pragma omp parallel num_threads(mNumThreads)
+		mExecutor->pin(omp_get_thread_num());
+	}
+
+	if (!mOutMeasurementFile.empty())
+		Scheduler::initMeasurements(mTasks);
+}
+
+void OpenMPTaskScheduler::step(Real time, Int timeStepCount) {
+	// Only referenced by the depend clauses, which GCC does not count as a use
+	[[maybe_unused]] char* deps = mDependencies.data();
+	Bool measure = !mOutMeasurementFile.empty();
+
+	#pragma omp parallel num_threads(mNumThreads)
+	#pragma omp single
+	{
+		for (Int i = 0; i < static_cast<Int>(mTasks.size()); i++) {
+			Task* task = mTasks[i].get();
+			const Int* preds = mPredecessors[i].data();
+			Int numPreds = static_cast<Int>(mPredecessors[i].size());
+
+			#pragma omp task firstprivate(task) depend(iterator(j=0:numPreds), in: deps[preds[j]]) depend(out: deps[i]) priority(mPriorities[i])
+			{
+				if (measure) {
+					measureTask(task, time, timeStepCount, omp_get_thread_num());
+				} else {
+					executeTask(task, time, timeStepCount, omp_get_thread_num());
+				}
+			}
+		}
+	}
+}
+
+void OpenMPTaskScheduler::stop() {
+	if (!mOutMeasurementFile.empty()) {
+		writeMeasurements(mOutMeasurementFile);
+	}
+}
@@ -8,6 +8,12 @@
 
 #include <dpsim/PFSolver.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/DenseLUAdapter.h>
+#include <dpsim-models/TopologyGraph.h>
+#include <dpsim/SparseLUAdapter.h>
+#ifdef WITH_KLU
+#include <dpsim/KLUAdapter.h>
+#endif
 #include <iostream>
 
 using namespace DPsim;
@@ -48,11 +54,45 @@ void PFSolver::initialize(){
 	determineNodeBaseVoltages();
     composeAdmittanceMatrix();
 
-	mJ.setZero(mNumUnknowns,mNumUnknowns);
+	mJ.resize(mNumUnknowns, mNumUnknowns);
+	mJacobianSolver = createLinearSolver();
+	mJacobianPatternAnalyzed = false;
+	mNumFactorizations = 0;
+	mNumSolves = 0;
+	mJacobianRightSide.setZero(mNumUnknowns, 1);
+	mJacobianSolution.setZero(mNumUnknowns, 1);
 	mX.setZero(mNumUnknowns);
 	mF.setZero(mNumUnknowns);
 }
 
+void PFSolver::setDirectLinearSolverImplementation(DirectLinearSolverImpl implementation) {
+	// To avoid regression we use SparseLU in case of undefined implementation, like the MNA solver factory
+	mImplementationInUse = implementation == DirectLinearSolverImpl::Undef ? DirectLinearSolverImpl::SparseLU : implementation;
+}
+
+void PFSolver::setDirectLinearSolverConfiguration(DirectLinearSolverConfiguration& configuration) {
+	mConfigurationInUse = configuration;
+}
+
+std::shared_ptr<DirectLinearSolver> PFSolver::createLinearSolver() {
+	switch (mImplementationInUse) {
+		case DirectLinearSolverImpl::DenseLU:
+			return std::make_shared<DenseLUAdapter>(mSLog);
+		case DirectLinearSolverImpl::SparseLU:
+			return std::make_shared<SparseLUAdapter>(mSLog);
+		#ifdef WITH_KLU
+		// Only KLU evaluates the configuration, e.g. the preordering
+		case DirectLinearSolverImpl::KLU: {
+			auto solver = std::make_shared<KLUAdapter>(mSLog);
+			solver->setConfiguration(mConfigurationInUse);
+			return solver;
+		}
+		#endif
+		default:
+			throw CPS::SystemError("unsupported linear solver implementation for the powerflow solver.");
+	}
+}
+
 void PFSolver::assignMatrixNodeIndices() {
 	SPDLOG_LOGGER_INFO(mSLog, "Assigning simulation nodes to topology nodes:");
 	UInt matrixNodeIndexIdx = 0;
@@ -132,12 +172,15 @@ void PFSolver::determinePFBusType() {
 	SPDLOG_LOGGER_INFO(mSLog, "-- Determine powerflow bus type for each node");
 
     // Determine powerflow bus type of each node through analysis of system topology
-	for (auto node : mSystem.mNodes) {
+	TopologyGraph<Complex> graph(mSystem.mNodes, mSystem.mComponents);
+	for (UInt k = 0; k < graph.nodeCount(); ++k) {
+		auto node = graph.node(k);
 		bool connectedPV = false;
 		bool connectedPQ = false;
 		bool connectedVD = false;
 
-		for (auto comp : mSystem.mComponentsAtNode[node]) {
+		for (const UInt* c = graph.nodeComponentsBegin(k); c != graph.nodeComponentsEnd(k); ++c) {
+			auto& comp = graph.component(*c);
 			if (std::shared_ptr<CPS::SP::Ph1::Load> load = std::dynamic_pointer_cast<CPS::SP::Ph1::Load>(comp)) {
 				if (load->mPowerflowBusType == CPS::PowerflowBusType::PQ) {
 					connectedPQ = true;
@@ -339,12 +382,65 @@ void PFSolver::composeAdmittanceMatrix() {
 		for(auto shunt : mShunts) {
 			shunt->pfApplyAdmittanceMatrixStamp(mY);
 		}
+		mY.makeCompressed();
 	}
 	if(mLines.empty() && mTransformers.empty()) {
 		throw std::invalid_argument("There are no bus");
 	}
 }
 
+Bool PFSolver::updateAdmittanceMatrix() {
+	Bool changed = false;
+	for (auto line : mLines) {
+		if (line->pfAdmittanceChanged())
+			changed |= line->pfApplyAdmittanceMatrixUpdate(mY);
+	}
+	for (auto trans : mTransformers) {
+		// Not part of the admittance matrix, see composeAdmittanceMatrix
+		if (**trans->mResistance == 0 && **trans->mInductance == 0)
+			continue;
+		if (trans->pfAdmittanceChanged())
+			changed |= trans->pfApplyAdmittanceMatrixUpdate(mY);
+	}
+	if (!changed)
+		return false;
+
+	// Inserting an entry leaves the matrix uncompressed
+	if (!mY.isCompressed())
+		throw CPS::SystemError("Admittance matrix update changed the sparsity pattern");
+	mAdmittanceMatrixChanged = true;
+	SPDLOG_LOGGER_INFO(mSLog, "Admittance matrix updated");
+	return true;
+}
+
+void PFSolver::composeSusceptanceMatrix(const std::vector<CPS::UInt>& buses, Bool withShunts, SparseMatrix& matrix) {
+	std::vector<Int> position(mY.rows(), -1);
+	for (UInt a = 0; a < buses.size(); ++a)
+		position[buses[a]] = a;
+
+	std::vector<Eigen::Triplet<Real>> triplets;
+	for (UInt a = 0; a < buses.size(); ++a) {
+		UInt k = buses[a];
+		Real diagonal = 0;
+		for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+			if (static_cast<UInt>(it.col()) == k) {
+				if (withShunts)
+					diagonal = -it.value().imag();
+				continue;
+			}
+			if (!withShunts)
+				diagonal += it.value().imag();
+			Int b = position[it.col()];
+			if (b >= 0)
+				triplets.emplace_back(a, b, -it.value().imag());
+		}
+		triplets.emplace_back(a, a, diagonal);
+	}
+	matrix.resize(buses.size(), buses.size());
+	matrix.setFromTriplets(triplets.begin(), triplets.end());
+	matrix.makeCompressed();
+}
+
 CPS::Real PFSolver::G(int i, int j) {
 	return mY.coeff(i, j).real();
 }
@@ -369,16 +465,33 @@ Bool PFSolver::solvePowerflow() {
     // Check whether model already converged
     isConverged = checkConvergence();
 
+	// With Jacobian reuse, the first iteration uses the factorization of the last step
+	Bool updateJacobian = !mJacobianReuse || !mJacobianPatternAnalyzed || mAdmittanceMatrixChanged;
+	mAdmittanceMatrixChanged = false;
+	Real mismatchNorm = mF.norm();
+
     mIterations = 0;
     for (unsigned i = 1; i < mMaxIterations && !isConverged; ++i) {
 
-        calculateJacobian();
-		auto sparseJ = mJ.sparseView();
-
-		// Solve system mJ*mX = mF
-        Eigen::SparseLU<SparseMatrix>lu(sparseJ);
+		if (updateJacobian) {
+			calculateJacobian();
+
+			// Solve system mJ*mX = mF, the symbolic analysis is reused for all iterations and steps
+			if (!mJacobianPatternAnalyzed) {
+				std::vector<std::pair<UInt, UInt>> noVariableEntries;
+				mJacobianSolver->preprocessing(mJ, noVariableEntries);
+				mJacobianSolver->factorize(mJ);
+				mJacobianPatternAnalyzed = true;
+			} else {
+				mJacobianSolver->refactorize(mJ);
+			}
+			++mNumFactorizations;
+		}
 
-		mX = lu.solve(mF);	/* code */
+		mJacobianRightSide.col(0) = mF;
+		mJacobianSolver->solveInPlace(mJacobianRightSide, mJacobianSolution);
+		mX = mJacobianSolution.col(0);
+		++mNumSolves;
 
 		// Calculate new solution based on mX increments obtained from equation system
 		updateSolution();
@@ -387,18 +500,29 @@ Bool PFSolver::solvePowerflow() {
         calculateMismatch();
 
 		SPDLOG_LOGGER_DEBUG(mSLog, "Mismatch vector at iteration {}: \n {}", i, mF);
-		mSLog->flush();
 
 		// Check convergence
         isConverged = checkConvergence();
         mIterations = i;
+
+		// Refresh the Jacobian if the last iteration did not contract the mismatch enough
+		if (mJacobianReuse) {
+			Real norm = mF.norm();
+			updateJacobian = norm > mJacobianReuseContraction * mismatchNorm;
+			mismatchNorm = norm;
+		}
     }
 	return isConverged;
 }
 
+void PFSolver::logLUTimes() {
+	SPDLOG_LOGGER_INFO(mSLog, "Jacobian factorizations: {}, linear solves: {}", mNumFactorizations, mNumSolves);
+}
+
 void PFSolver::SolveTask::execute(Real time, Int timeStepCount) {
-	// apply keepLastSolution to save computation time
-    mSolver.generateInitialSolution(time);
+	mSolver.updateAdmittanceMatrix();
+	// In warm-start mode, keep the last solution unless the last step did not converge
+    mSolver.generateInitialSolution(time, mSolver.mWarmStart && mSolver.isConverged);
 	mSolver.solvePowerflow();
 	mSolver.setSolution();
 }
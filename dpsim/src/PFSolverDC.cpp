@@ -0,0 +1,71 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/PFSolverDC.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+PFSolverDC::PFSolverDC(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep, CPS::Logger::Level logLevel)
+    : PFSolverPowerPolar(name, system, timeStep, logLevel) { }
+
+void PFSolverDC::initialize() {
+    PFSolverPowerPolar::initialize();
+
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+    composeSusceptanceMatrix(mPQPVBusIndices, false, mBPrime);
+    mPowerRightSide.setZero(npqpv, 1);
+    mAngles.setZero(npqpv, 1);
+    mBPrimeSolver = nullptr;
+    if (npqpv > 0) {
+        mBPrimeSolver = createLinearSolver();
+        std::vector<std::pair<UInt, UInt>> noVariableEntries;
+        mBPrimeSolver->preprocessing(mBPrime, noVariableEntries);
+        mBPrimeSolver->factorize(mBPrime);
+        ++mNumFactorizations;
+    }
+    SPDLOG_LOGGER_INFO(mSLog, "B' with {} nonzeros", mBPrime.nonZeros());
+}
+
+Bool PFSolverDC::updateAdmittanceMatrix() {
+    if (!PFSolverPowerPolar::updateAdmittanceMatrix())
+        return false;
+
+    // The sparsity pattern is unchanged, only the numerical factorization is repeated
+    if (mBPrimeSolver) {
+        composeSusceptanceMatrix(mPQPVBusIndices, false, mBPrime);
+        mBPrimeSolver->refactorize(mBPrime);
+        ++mNumFactorizations;
+    }
+    return true;
+}
+
+Bool PFSolverDC::solvePowerflow() {
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+
+    for (auto k : mPQBusIndices)
+        sol_V(k) = 1.0;
+
+    if (mBPrimeSolver) {
+        for (UInt a = 0; a < npqpv; ++a)
+            mPowerRightSide(a, 0) = Pesp.coeff(mPQPVBusIndices[a]);
+        mBPrimeSolver->solveInPlace(mPowerRightSide, mAngles);
+        ++mNumSolves;
+        // The angles are relative to the slack bus
+        for (UInt a = 0; a < npqpv; ++a)
+            sol_D(mPQPVBusIndices[a]) = mAngles(a, 0);
+    }
+
+    // The mismatch of the AC equations is only reported
+    calculateMismatch();
+    SPDLOG_LOGGER_DEBUG(mSLog, "AC mismatch vector of the DC solution: \n {}", mF);
+
+    mIterations = 1;
+    isConverged = true;
+    return isConverged;
+}
@@ -0,0 +1,99 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/PFSolverFastDecoupled.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+PFSolverFastDecoupled::PFSolverFastDecoupled(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep, CPS::Logger::Level logLevel)
+    : PFSolverPowerPolar(name, system, timeStep, logLevel) {
+    mMaxIterations = 50;
+}
+
+std::shared_ptr<DirectLinearSolver> PFSolverFastDecoupled::factorizeConstantMatrix(SparseMatrix& matrix) {
+    auto solver = createLinearSolver();
+    std::vector<std::pair<UInt, UInt>> noVariableEntries;
+    solver->preprocessing(matrix, noVariableEntries);
+    solver->factorize(matrix);
+    ++mNumFactorizations;
+    return solver;
+}
+
+void PFSolverFastDecoupled::initialize() {
+    PFSolverPowerPolar::initialize();
+
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+    composeSusceptanceMatrix(mPQPVBusIndices, false, mBPrime);
+    mBPrimeSolver = npqpv > 0 ? factorizeConstantMatrix(mBPrime) : nullptr;
+    mAngleRightSide.setZero(npqpv, 1);
+    mAngleIncrement.setZero(npqpv, 1);
+
+    composeSusceptanceMatrix(mPQBusIndices, true, mBDoublePrime);
+    mBDoublePrimeSolver = mNumPQBuses > 0 ? factorizeConstantMatrix(mBDoublePrime) : nullptr;
+    mMagnitudeRightSide.setZero(mNumPQBuses, 1);
+    mMagnitudeIncrement.setZero(mNumPQBuses, 1);
+
+    SPDLOG_LOGGER_INFO(mSLog, "B' with {} nonzeros, B'' with {} nonzeros", mBPrime.nonZeros(), mBDoublePrime.nonZeros());
+}
+
+Bool PFSolverFastDecoupled::updateAdmittanceMatrix() {
+    if (!PFSolverPowerPolar::updateAdmittanceMatrix())
+        return false;
+
+    // The sparsity patterns are unchanged, only the numerical factorizations are repeated
+    if (mBPrimeSolver) {
+        composeSusceptanceMatrix(mPQPVBusIndices, false, mBPrime);
+        mBPrimeSolver->refactorize(mBPrime);
+        ++mNumFactorizations;
+    }
+    if (mBDoublePrimeSolver) {
+        composeSusceptanceMatrix(mPQBusIndices, true, mBDoublePrime);
+        mBDoublePrimeSolver->refactorize(mBDoublePrime);
+        ++mNumFactorizations;
+    }
+    return true;
+}
+
+Bool PFSolverFastDecoupled::solvePowerflow() {
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+
+    calculateMismatch();
+    isConverged = checkConvergence();
+
+    mIterations = 0;
+    for (unsigned i = 1; i < mMaxIterations && !isConverged && npqpv > 0; ++i) {
+        // Angle update, the mismatch vector starts with the active powers of PQ and PV buses
+        for (UInt a = 0; a < npqpv; ++a)
+            mAngleRightSide(a, 0) = mF.coeff(a) / sol_V.coeff(mPQPVBusIndices[a]);
+        mBPrimeSolver->solveInPlace(mAngleRightSide, mAngleIncrement);
+        ++mNumSolves;
+        for (UInt a = 0; a < npqpv; ++a)
+            sol_D(mPQPVBusIndices[a]) += mAngleIncrement(a, 0);
+
+        calculateMismatch();
+
+        // Magnitude update, followed by the reactive powers of the PQ buses
+        if (mBDoublePrimeSolver) {
+            for (UInt a = 0; a < mNumPQBuses; ++a)
+                mMagnitudeRightSide(a, 0) = mF.coeff(a + npqpv) / sol_V.coeff(mPQBusIndices[a]);
+            mBDoublePrimeSolver->solveInPlace(mMagnitudeRightSide, mMagnitudeIncrement);
+            ++mNumSolves;
+            for (UInt a = 0; a < mNumPQBuses; ++a)
+                sol_V(mPQBusIndices[a]) += mMagnitudeIncrement(a, 0);
+
+            calculateMismatch();
+        }
+
+        SPDLOG_LOGGER_DEBUG(mSLog, "Mismatch vector at iteration {}: \n {}", i, mF);
+
+        isConverged = checkConvergence();
+        mIterations = i;
+    }
+    return isConverged;
+}
@@ -6,6 +6,8 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+
 #include <dpsim/PFSolverPowerPolar.h>
 
 using namespace DPsim;
@@ -15,8 +17,15 @@ PFSolverPowerPolar::PFSolverPowerPolar(CPS::String name, const CPS::SystemTopolo
     : PFSolver(name, system, timeStep, logLevel){ }
 
 void PFSolverPowerPolar::generateInitialSolution(Real time, bool keep_last_solution) {
-	resize_sol(mSystem.mNodes.size());
-	resize_complex_sol(mSystem.mNodes.size());
+	if (!keep_last_solution || !solutionInitialized) {
+		keep_last_solution = false;
+		resize_sol(mSystem.mNodes.size());
+		resize_complex_sol(mSystem.mNodes.size());
+	} else {
+		// Voltages are kept, the injections are summed up again below
+		sol_P.setZero();
+		sol_Q.setZero();
+	}
 
     // update all components for the new time
     for (auto comp : mSystem.mComponents) {
@@ -122,119 +131,243 @@ void PFSolverPowerPolar::generateInitialSolution(Real time, bool keep_last_solut
     mSLog->flush();
 }
 
+void PFSolverPowerPolar::initialize() {
+    PFSolver::initialize();
+    initializeResultTargets();
+}
+
+void PFSolverPowerPolar::initializeResultTargets() {
+    mLineAdmittances.clear();
+    for (auto line : mLines)
+        mLineAdmittances.push_back(line->Y_element());
+    mTransformerAdmittances.clear();
+    for (auto trafo : mTransformers)
+        mTransformerAdmittances.push_back(trafo->Y_element());
+    mBranchVoltage.setZero(2);
+    mBranchCurrent.setZero(2);
+    mBranchFlow.setZero(2);
+
+    std::vector<Int> pvPosition(mSystem.mNodes.size(), -1);
+    for (UInt i = 0; i < mPVBusIndices.size(); ++i)
+        pvPosition[mPVBusIndices[i]] = static_cast<Int>(i);
+    mPVBusGenerators.assign(mPVBusIndices.size(), {});
+    mInjectionLines.assign(mSystem.mNodes.size(), nullptr);
+    mInjectionTransformers.assign(mSystem.mNodes.size(), nullptr);
+
+    for (UInt i = 0; i < mSystem.mNodes.size(); ++i) {
+        auto node = mSystem.mNodes[i];
+        Int pv = pvPosition[node->matrixNodeIndex()];
+        for (auto comp : mSystem.mComponentsAtNode[node]) {
+            if (auto gen = std::dynamic_pointer_cast<CPS::SP::Ph1::SynchronGenerator>(comp)) {
+                if (pv >= 0 && gen->mPowerflowBusType == CPS::PowerflowBusType::PV)
+                    mPVBusGenerators[pv].push_back(gen);
+            }
+            else if (auto line = std::dynamic_pointer_cast<CPS::SP::Ph1::PiLine>(comp)) {
+                if (!mInjectionLines[i])
+                    mInjectionLines[i] = line;
+            }
+            else if (auto trafo = std::dynamic_pointer_cast<CPS::SP::Ph1::Transformer>(comp)) {
+                if (!mInjectionTransformers[i])
+                    mInjectionTransformers[i] = trafo;
+            }
+        }
+    }
+}
+
+Bool PFSolverPowerPolar::updateAdmittanceMatrix() {
+    if (!PFSolver::updateAdmittanceMatrix())
+        return false;
+    for (UInt i = 0; i < mLines.size(); ++i)
+        mLineAdmittances[i] = mLines[i]->Y_element();
+    for (UInt i = 0; i < mTransformers.size(); ++i)
+        mTransformerAdmittances[i] = mTransformers[i]->Y_element();
+    return true;
+}
+
+void PFSolverPowerPolar::updateVoltages() {
+    // One sine and cosine per bus, evaluated on the whole arrays
+    mVoltageReal = sol_V.array() * sol_D.array().cos();
+    mVoltageImag = sol_V.array() * sol_D.array().sin();
+}
+
+CPS::Complex PFSolverPowerPolar::S(UInt k) const {
+    // I_k = sum_j Y_kj V_j in rectangular coordinates
+    Real currentReal = 0.0, currentImag = 0.0;
+    for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        Real G = it.value().real();
+        Real B = it.value().imag();
+        Real Vr = mVoltageReal.coeff(it.col());
+        Real Vi = mVoltageImag.coeff(it.col());
+        currentReal += G * Vr - B * Vi;
+        currentImag += G * Vi + B * Vr;
+    }
+    // S_k = V_k conj(I_k)
+    Real Vr = mVoltageReal.coeff(k);
+    Real Vi = mVoltageImag.coeff(k);
+    return CPS::Complex(Vr * currentReal + Vi * currentImag, Vi * currentReal - Vr * currentImag);
+}
+
 void PFSolverPowerPolar::calculateMismatch() {
     UInt npqpv = mNumPQBuses+mNumPVBuses;
     UInt k;
     mF.setZero();
+    updateVoltages();
 
     for (UInt a = 0; a < npqpv; ++a) {
-        // For PQ and PV buses calculate active power mismatch
         k = mPQPVBusIndices[a];
-        mF(a) = Pesp.coeff(k) - P(k);
+        CPS::Complex Sk = S(k);
+        // For PQ and PV buses calculate active power mismatch
+        mF(a) = Pesp.coeff(k) - Sk.real();
 
         //only for PQ buses calculate reactive power mismatch
         if (a < mNumPQBuses)
-            mF(a + npqpv) = Qesp.coeff(k) - Q(k);
+            mF(a + npqpv) = Qesp.coeff(k) - Sk.imag();
     }
 }
 
-void PFSolverPowerPolar::calculateJacobian() {
+void PFSolverPowerPolar::initializeJacobianPattern() {
     UInt npqpv = mNumPQBuses + mNumPVBuses;
-    double val;
-    UInt k, j;
-    UInt da, db;
-
-    mJ.setZero();
+    UInt numBuses = static_cast<UInt>(mY.rows());
+
+    // Position of each bus among the unknowns, negative for VD buses
+    std::vector<Int> position(numBuses, -1);
+    for (UInt a = 0; a < npqpv; ++a)
+        position[mPQPVBusIndices[a]] = static_cast<Int>(a);
+
+    // Block entries of bus row a and bus column b, the Q rows and V columns only exist for PQ buses
+    auto blockEntries = [&](UInt a, UInt b, std::pair<UInt, UInt> entries[4], Bool present[4]) {
+        entries[0] = { a, b };
+        entries[1] = { a, b + npqpv };
+        entries[2] = { a + npqpv, b };
+        entries[3] = { a + npqpv, b + npqpv };
+        present[0] = true;
+        present[1] = b < mNumPQBuses;
+        present[2] = a < mNumPQBuses;
+        present[3] = a < mNumPQBuses && b < mNumPQBuses;
+    };
+
+    std::vector<Eigen::Triplet<Real>> triplets;
+    triplets.reserve(4 * (mY.nonZeros() + npqpv));
+    for (UInt a = 0; a < npqpv; ++a) {
+        UInt k = mPQPVBusIndices[a];
+        std::pair<UInt, UInt> entries[4];
+        Bool present[4];
+        blockEntries(a, a, entries, present);
+        for (UInt i = 0; i < 4; ++i) {
+            if (present[i])
+                triplets.emplace_back(entries[i].first, entries[i].second, 0.0);
+        }
 
-    //J1
-    for (UInt a = 0; a < npqpv; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        mJ.coeffRef(a, a) = -Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < npqpv; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                        - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                mJ.coeffRef(a, b) = val;
+        for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            Int b = position[it.col()];
+            if (it.col() == k || b < 0)
+                continue;
+            blockEntries(a, b, entries, present);
+            for (UInt i = 0; i < 4; ++i) {
+                if (present[i])
+                    triplets.emplace_back(entries[i].first, entries[i].second, 0.0);
             }
         }
     }
-
-    //J2
-    da = 0;
-    db = npqpv;
-    for (UInt a = 0; a < npqpv; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J2D:" << (a + da) << "," << (a + db) << std::endl;
-        if (a < mNumPQBuses)
-            mJ.coeffRef(a + da, a + db) = P(k) + G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < mNumPQBuses; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                        + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                //std::cout << "J2ij:" << (a + da) << "," << (b + db) << std::endl;
-                mJ.coeffRef(a + da, b + db) = val;
-            }
+    mJ.setFromTriplets(triplets.begin(), triplets.end());
+    mJ.makeCompressed();
+
+    auto slot = [this](const std::pair<UInt, UInt>& entry) {
+        const Int* begin = mJ.innerIndexPtr() + mJ.outerIndexPtr()[entry.first];
+        const Int* end = mJ.innerIndexPtr() + mJ.outerIndexPtr()[entry.first + 1];
+        return static_cast<Int>(std::lower_bound(begin, end, static_cast<Int>(entry.second)) - mJ.innerIndexPtr());
+    };
+    auto slots = [&](UInt a, UInt b) {
+        JacobianSlots result;
+        std::pair<UInt, UInt> entries[4];
+        Bool present[4];
+        blockEntries(a, b, entries, present);
+        for (UInt i = 0; i < 4; ++i)
+            result.block[i] = present[i] ? slot(entries[i]) : -1;
+        return result;
+    };
+
+    mJacobianDiagonal.assign(numBuses, JacobianSlots{ { -1, -1, -1, -1 } });
+    mJacobianOffDiagonal.assign(mY.nonZeros(), JacobianSlots{ { -1, -1, -1, -1 } });
+    UInt nonzero = 0;
+    for (UInt k = 0; k < numBuses; ++k) {
+        Int a = position[k];
+        if (a >= 0)
+            mJacobianDiagonal[k] = slots(a, a);
+        for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it, ++nonzero) {
+            Int b = position[it.col()];
+            if (a >= 0 && b >= 0 && it.col() != k)
+                mJacobianOffDiagonal[nonzero] = slots(a, b);
         }
     }
 
+    SPDLOG_LOGGER_INFO(mSLog, "Jacobian with {} unknowns and {} nonzeros", mNumUnknowns, mJ.nonZeros());
+}
 
-    //J3
-    da = npqpv;
-    db = 0;
-    for (UInt a = 0; a < mNumPQBuses; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J3:" << (a + da) << "," << (a + db) << std::endl;
-        mJ.coeffRef(a + da, a + db) = P(k) - G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < npqpv; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                        + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                //std::cout << "J3:" << (a + da) << "," << (b + db) << std::endl;
-                mJ.coeffRef(a + da, b + db) = -val;
-            }
+void PFSolverPowerPolar::calculateJacobian() {
+    if (mJ.nonZeros() == 0)
+        initializeJacobianPattern();
+
+    UInt numBuses = static_cast<UInt>(mY.rows());
+    Real* values = mJ.valuePtr();
+
+    UInt nonzero = 0;
+    for (UInt k = 0; k < numBuses; ++k) {
+        const JacobianSlots& diagonal = mJacobianDiagonal[k];
+        if (diagonal.block[0] < 0) {
+            // No Jacobian rows for VD buses
+            for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it)
+                ++nonzero;
+            continue;
         }
-    }
 
-    //J4
-    da = npqpv;
-    db = npqpv;
-    for (UInt a = 0; a < mNumPQBuses; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J4:" << (a + da) << "," << (a + db) << std::endl;
-        mJ.coeffRef(a + da, a + db) = Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < mNumPQBuses; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                        - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
-                if (val != 0.0) {
-                    //std::cout << "J4:" << (a + da) << "," << (b + db) << std::endl;
-                    mJ.coeffRef(a + da, b + db) = val;
-                }
+        Real Vk = sol_V.coeff(k);
+        Real Dk = sol_D.coeff(k);
+        Real sumP = 0.0, sumQ = 0.0;
+        Real Gkk = 0.0, Bkk = 0.0;
+
+        for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it, ++nonzero) {
+            UInt j = static_cast<UInt>(it.col());
+            Real Gkj = it.value().real();
+            Real Bkj = it.value().imag();
+            Real sinD = sin(Dk - sol_D.coeff(j));
+            Real cosD = cos(Dk - sol_D.coeff(j));
+            Real Vj = sol_V.coeff(j);
+
+            // Terms of P(k) and Q(k)
+            sumP += Vj * (Gkj * cosD + Bkj * sinD);
+            sumQ += Vj * (Gkj * sinD - Bkj * cosD);
+
+            if (j == k) {
+                Gkk = Gkj;
+                Bkk = Bkj;
+                continue;
             }
+
+            // The same two terms form the off-diagonal entries of all four blocks
+            const JacobianSlots& slots = mJacobianOffDiagonal[nonzero];
+            Real dPdD = Vk * Vj * (Gkj * sinD - Bkj * cosD);
+            Real dPdV = Vk * Vj * (Gkj * cosD + Bkj * sinD);
+            if (slots.block[0] >= 0)
+                values[slots.block[0]] = dPdD;
+            if (slots.block[1] >= 0)
+                values[slots.block[1]] = dPdV;
+            if (slots.block[2] >= 0)
+                values[slots.block[2]] = -dPdV;
+            if (slots.block[3] >= 0)
+                values[slots.block[3]] = dPdD;
         }
+
+        // Diagonal entries from the injections P(k) and Q(k) of the same pass
+        Real Pk = Vk * sumP;
+        Real Qk = Vk * sumQ;
+        values[diagonal.block[0]] = -Qk - Bkk * Vk * Vk;
+        if (diagonal.block[1] >= 0)
+            values[diagonal.block[1]] = Pk + Gkk * Vk * Vk;
+        if (diagonal.block[2] >= 0)
+            values[diagonal.block[2]] = Pk - Gkk * Vk * Vk;
+        if (diagonal.block[3] >= 0)
+            values[diagonal.block[3]] = Qk - Bkk * Vk * Vk;
     }
 }
 
@@ -265,6 +398,7 @@ void PFSolverPowerPolar::setSolution() {
 		SPDLOG_LOGGER_INFO(mSLog, "Not converged within {} iterations", mIterations);
     }
 	else {
+		updateVoltages();
 		calculatePAndQAtSlackBus();
         calculateQAtPVBuses();
 		SPDLOG_LOGGER_INFO(mSLog, "converged in {} iterations",mIterations);
@@ -274,9 +408,10 @@ void PFSolverPowerPolar::setSolution() {
 			SPDLOG_LOGGER_INFO(mSLog, "{}\t{}\t{}\t{}", sol_P[i], sol_Q[i], sol_V[i], sol_D[i]);
 		}
     }
+    updateVoltages();
     for (UInt i = 0; i < mSystem.mNodes.size(); ++i) {
         sol_S_complex(i) = CPS::Complex(sol_P.coeff(i), sol_Q.coeff(i));
-        sol_V_complex(i) = CPS::Complex(sol_V.coeff(i)*cos(sol_D.coeff(i)), sol_V.coeff(i)*sin(sol_D.coeff(i)));
+        sol_V_complex(i) = CPS::Complex(mVoltageReal.coeff(i), mVoltageImag.coeff(i));
     }
 
 // update voltage and power at each node
@@ -289,88 +424,72 @@ void PFSolverPowerPolar::setSolution() {
 }
 
 void PFSolverPowerPolar::calculateBranchFlow() {
-	for (auto line : mLines) {
-		VectorComp v(2);
-		v(0) = sol_V_complex.coeff(line->node(0)->matrixNodeIndex());
-		v(1) = sol_V_complex.coeff(line->node(1)->matrixNodeIndex());
+	auto updateFlow = [this](const MatrixComp& admittance, UInt bus0, UInt bus1) {
+		mBranchVoltage(0) = sol_V_complex.coeff(bus0);
+		mBranchVoltage(1) = sol_V_complex.coeff(bus1);
 		/// I = Y * V
-		VectorComp current = line->Y_element() * v;
+		mBranchCurrent.noalias() = admittance * mBranchVoltage;
 		/// pf on branch [S_01; S_10] = [V_0 * conj(I_0); V_1 * conj(I_1)]
-		VectorComp flow_on_branch = v.array()*current.conjugate().array();
-		line->updateBranchFlow(current,flow_on_branch);
+		mBranchFlow = mBranchVoltage.array() * mBranchCurrent.conjugate().array();
+	};
+	for (UInt i = 0; i < mLines.size(); ++i) {
+		auto line = mLines[i];
+		updateFlow(mLineAdmittances[i], line->node(0)->matrixNodeIndex(), line->node(1)->matrixNodeIndex());
+		line->updateBranchFlow(mBranchCurrent, mBranchFlow);
 	}
-	for (auto trafo : mTransformers) {
-		VectorComp v(2);
-		v(0) = sol_V_complex.coeff(trafo->node(0)->matrixNodeIndex());
-		v(1) = sol_V_complex.coeff(trafo->node(1)->matrixNodeIndex());
-		/// I = Y * V
-		VectorComp current = trafo->Y_element() * v;
-		/// pf on branch [S_01; S_10] = [V_0 * conj(I_0); V_1 * conj(I_1)]
-		VectorComp flow_on_branch = v.array()*current.conjugate().array();
-		trafo->updateBranchFlow(current, flow_on_branch);
+	for (UInt i = 0; i < mTransformers.size(); ++i) {
+		auto trafo = mTransformers[i];
+		updateFlow(mTransformerAdmittances[i], trafo->node(0)->matrixNodeIndex(), trafo->node(1)->matrixNodeIndex());
+		trafo->updateBranchFlow(mBranchCurrent, mBranchFlow);
 	}
 }
 
 void PFSolverPowerPolar::calculateNodalInjection() {
-	for (auto node : mSystem.mNodes) {
-		std::list<std::shared_ptr<CPS::SP::Ph1::PiLine>> lines;
-		for (auto comp : mSystem.mComponentsAtNode[node]) {
-			if (std::shared_ptr<CPS::SP::Ph1::PiLine> line = std::dynamic_pointer_cast<CPS::SP::Ph1::PiLine>(comp)) {
-				line->storeNodalInjection(sol_S_complex.coeff(node->matrixNodeIndex()));
-				lines.push_back(line);
-				break;
-			}
-		}
-		if (lines.empty()) {
-			for (auto comp : mSystem.mComponentsAtNode[node]) {
-				if (std::shared_ptr<CPS::SP::Ph1::Transformer> trafo = std::dynamic_pointer_cast<CPS::SP::Ph1::Transformer>(comp)) {
-					trafo->storeNodalInjection(sol_S_complex.coeff(node->matrixNodeIndex()));
-					break;
-				}
-			}
-		}
+	for (UInt i = 0; i < mSystem.mNodes.size(); ++i) {
+		Complex injection = sol_S_complex.coeff(mSystem.mNodes[i]->matrixNodeIndex());
+		if (mInjectionLines[i])
+			mInjectionLines[i]->storeNodalInjection(injection);
+		else if (mInjectionTransformers[i])
+			mInjectionTransformers[i]->storeNodalInjection(injection);
 	}
 }
 
 Real PFSolverPowerPolar::P(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
+    for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = static_cast<UInt>(it.col());
         val += sol_V.coeff(j)
-                *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * cos(sol_D.coeff(k) - sol_D.coeff(j))
+                + it.value().imag() * sin(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
 
 Real PFSolverPowerPolar::Q(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
+    for (CPS::SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = static_cast<UInt>(it.col());
         val += sol_V.coeff(j)
-                *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * sin(sol_D.coeff(k) - sol_D.coeff(j))
+                - it.value().imag() * cos(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
 
 void PFSolverPowerPolar::calculatePAndQAtSlackBus() {
     for (auto k: mVDBusIndices) {
-        CPS::Complex I(0.0, 0.0);
-        for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
-            I += mY.coeff(k, j) * sol_Vcx(j);
-        }
-        CPS::Complex S(0.0, 0.0);
-        S = sol_Vcx(k) * conj(I);
-        sol_P(k) = S.real();
-        sol_Q(k) = S.imag();
+        CPS::Complex Sk = S(k);
+        sol_P(k) = Sk.real();
+        sol_Q(k) = Sk.imag();
         for(auto extnet : mExternalGrids){
             if(extnet->mPowerflowBusType==CPS::PowerflowBusType::VD){
-			    extnet->updatePowerInjection(S*mBaseApparentPower);
+			    extnet->updatePowerInjection(Sk*mBaseApparentPower);
                 break;
             }
         }
         for(auto gen : mSynchronGenerators){
             if(gen->mPowerflowBusType==CPS::PowerflowBusType::VD){
-			    gen->updatePowerInjection(S*mBaseApparentPower);
+			    gen->updatePowerInjection(Sk*mBaseApparentPower);
                 break;
             }
         }
@@ -378,22 +497,11 @@ void PFSolverPowerPolar::calculatePAndQAtSlackBus() {
 }
 
 void PFSolverPowerPolar::calculateQAtPVBuses() {
-        for (auto k: mPVBusIndices) {
-        CPS::Complex I(0.0, 0.0);
-        for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
-            I += mY.coeff(k, j) * sol_Vcx(j);
-        }
-        CPS::Complex S(0.0, 0.0);
-        S = sol_Vcx(k) * conj(I);
-        sol_Q(k) = S.imag();
-
-        for (auto topoNode : mSystem.mNodes)
-            if (topoNode->matrixNodeIndex() == k)
-                for(auto comp : mSystem.mComponentsAtNode[topoNode])
-                    if(auto genPtr = std::dynamic_pointer_cast<CPS::SP::Ph1::SynchronGenerator>(comp))
-                        if (genPtr->mPowerflowBusType==CPS::PowerflowBusType::PV)
-                            genPtr->updateReactivePowerInjection(S*mBaseApparentPower);
-
+    for (UInt i = 0; i < mPVBusIndices.size(); ++i) {
+        CPS::Complex Sk = S(mPVBusIndices[i]);
+        sol_Q(mPVBusIndices[i]) = Sk.imag();
+        for (auto gen : mPVBusGenerators[i])
+            gen->updateReactivePowerInjection(Sk*mBaseApparentPower);
     }
 }
 
@@ -0,0 +1,245 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/PFSolverSweep.h>
+
+#include <map>
+
+using namespace DPsim;
+using namespace CPS;
+
+PFSolverSweep::PFSolverSweep(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep, CPS::Logger::Level logLevel)
+    : PFSolverPowerPolar(name, system, timeStep, logLevel) {
+    mMaxIterations = 100;
+}
+
+void PFSolverSweep::initialize() {
+    PFSolverPowerPolar::initialize();
+
+    if (mVDBusIndices.size() != 1)
+        throw SystemError("The sweep powerflow solver requires exactly one VD bus, found " + std::to_string(mVDBusIndices.size()));
+
+    buildTree();
+    mPVReactivePowers.setZero(mNumPVBuses);
+    SPDLOG_LOGGER_INFO(mSLog, "Sweep tree with {} buses and {} meshes", mOrder.size(), mLinks.size());
+}
+
+Bool PFSolverSweep::updateAdmittanceMatrix() {
+    if (!PFSolverPowerPolar::updateAdmittanceMatrix())
+        return false;
+
+    // Switching a line may change the tree, which is cheap to grow again
+    buildTree();
+    return true;
+}
+
+void PFSolverSweep::buildTree() {
+    UInt numBuses = static_cast<UInt>(mY.rows());
+
+    // Element admittances of the branches by pair of buses, oriented from the
+    // lower to the higher index, so that parallel branches are merged
+    std::map<std::pair<UInt, UInt>, MatrixComp> elements;
+    auto addElement = [&](UInt i, UInt j, const MatrixComp& y) {
+        if (i == j || y.coeff(0, 1) == Complex(0, 0))
+            return;
+        auto& element = elements[{ std::min(i, j), std::max(i, j) }];
+        if (element.size() == 0)
+            element = MatrixComp::Zero(2, 2);
+        if (i < j) {
+            element += y;
+        } else {
+            element(0, 0) += y.coeff(1, 1);
+            element(0, 1) += y.coeff(1, 0);
+            element(1, 0) += y.coeff(0, 1);
+            element(1, 1) += y.coeff(0, 0);
+        }
+    };
+    for (UInt i = 0; i < mLines.size(); ++i)
+        addElement(mLines[i]->node(0)->matrixNodeIndex(), mLines[i]->node(1)->matrixNodeIndex(), mLineAdmittances[i]);
+    for (UInt i = 0; i < mTransformers.size(); ++i) {
+        // Not part of the admittance matrix, see composeAdmittanceMatrix
+        if (**mTransformers[i]->mResistance == 0 && **mTransformers[i]->mInductance == 0)
+            continue;
+        addElement(mTransformers[i]->node(0)->matrixNodeIndex(), mTransformers[i]->node(1)->matrixNodeIndex(), mTransformerAdmittances[i]);
+    }
+
+    // The admittance to ground of a bus is what the branches leave of its diagonal entry
+    std::vector<std::vector<std::pair<UInt, const MatrixComp*>>> adjacent(numBuses);
+    mBusShunts.setZero(numBuses);
+    for (UInt k = 0; k < numBuses; ++k)
+        mBusShunts(k) = mY.coeff(k, k);
+    for (auto& entry : elements) {
+        UInt i = entry.first.first, j = entry.first.second;
+        adjacent[i].emplace_back(j, &entry.second);
+        adjacent[j].emplace_back(i, &entry.second);
+        mBusShunts(i) -= entry.second.coeff(0, 0);
+        mBusShunts(j) -= entry.second.coeff(1, 1);
+    }
+
+    // Breadth-first search from the VD bus, branches to visited buses close meshes
+    UInt root = mVDBusIndices[0];
+    std::vector<Bool> visited(numBuses, false);
+    std::vector<UInt> depth(numBuses, 0);
+    mOrder.assign(1, root);
+    mBranches.assign(numBuses, TreeBranch());
+    mPathImpedances.setZero(numBuses);
+    mLinks.clear();
+    mBranches[root].parent = root;
+    visited[root] = true;
+    for (UInt pos = 0; pos < mOrder.size(); ++pos) {
+        UInt p = mOrder[pos];
+        for (auto& neighbour : adjacent[p]) {
+            UInt k = neighbour.first;
+            // Entries of the element with p as first and k as second terminal
+            const MatrixComp& y = *neighbour.second;
+            Bool forward = p < k;
+            Complex ypp = forward ? y.coeff(0, 0) : y.coeff(1, 1);
+            Complex ypk = forward ? y.coeff(0, 1) : y.coeff(1, 0);
+            Complex ykp = forward ? y.coeff(1, 0) : y.coeff(0, 1);
+            Complex ykk = forward ? y.coeff(1, 1) : y.coeff(0, 0);
+
+            if (visited[k]) {
+                // Each link is seen from both ends, it is kept once
+                if (k != mBranches[p].parent && p < k)
+                    mLinks.push_back(Link { p, k, -ypk, ypp + ypk, ykk + ykp, ykp / ypk });
+                continue;
+            }
+            visited[k] = true;
+            depth[k] = depth[p] + 1;
+            mOrder.push_back(k);
+
+            auto& branch = mBranches[k];
+            branch.parent = p;
+            branch.self = ykk;
+            branch.toParent = ykp;
+            branch.fromParent = ypk;
+            branch.selfParent = ypp - ypk * ykp / ykk;
+            branch.parentGain = ypk / ykk;
+            mPathImpedances(k) = mPathImpedances(p) - 1. / ykp;
+        }
+    }
+
+    if (mOrder.size() != numBuses) {
+        for (UInt k = 0; k < numBuses; ++k) {
+            if (!visited[k])
+                throw SystemError("Bus " + mSystem.mNodes[k]->name() + " is not connected to the VD bus");
+        }
+    }
+
+    // Breakpoint impedance matrix: drawing current at bus a changes the voltage at bus b
+    // by the impedance of the common part of their tree paths, which ends at their
+    // lowest common ancestor
+    auto common = [&](UInt a, UInt b) {
+        while (a != b) {
+            if (depth[a] >= depth[b])
+                a = mBranches[a].parent;
+            else
+                b = mBranches[b].parent;
+        }
+        return mPathImpedances(a);
+    };
+    UInt numLinks = static_cast<UInt>(mLinks.size());
+    MatrixComp impedances = MatrixComp::Zero(numLinks, numLinks);
+    for (UInt l = 0; l < numLinks; ++l) {
+        for (UInt m = 0; m < numLinks; ++m) {
+            impedances(l, m) = common(mLinks[l].from, mLinks[m].from) - common(mLinks[l].from, mLinks[m].to)
+                - common(mLinks[l].to, mLinks[m].from) + common(mLinks[l].to, mLinks[m].to);
+        }
+        impedances(l, l) += 1. / mLinks[l].series;
+    }
+    if (numLinks > 0) {
+        mLinkImpedances.compute(impedances);
+        ++mNumFactorizations;
+    }
+    mLinkCurrents.setZero(numLinks);
+    mVoltages.setZero(numBuses);
+    mSubtreeCurrents.setZero(numBuses);
+}
+
+Bool PFSolverSweep::solvePowerflow() {
+    UInt numBuses = static_cast<UInt>(mY.rows());
+    UInt root = mOrder[0];
+
+    for (UInt k = 0; k < numBuses; ++k)
+        mVoltages(k) = std::polar(sol_V.coeff(k), sol_D.coeff(k));
+    // The set points are only given by the initial solution
+    std::vector<Real> pvSetPoints(mNumPVBuses);
+    for (UInt a = 0; a < mNumPVBuses; ++a)
+        pvSetPoints[a] = sol_V.coeff(mPVBusIndices[a]);
+
+    calculateMismatch();
+    isConverged = checkConvergence();
+
+    mIterations = 0;
+    for (unsigned i = 1; i < mMaxIterations && !isConverged; ++i) {
+        // Backward sweep: currents drawn by the loads, shunts and links of each bus plus its subtrees
+        for (UInt k = 0; k < numBuses; ++k) {
+            Complex injection(Pesp.coeff(k), Qesp.coeff(k));
+            mSubtreeCurrents(k) = mBusShunts.coeff(k) * mVoltages.coeff(k) - std::conj(injection / mVoltages.coeff(k));
+        }
+        for (UInt a = 0; a < mNumPVBuses; ++a) {
+            UInt k = mPVBusIndices[a];
+            mSubtreeCurrents(k) -= std::conj(Complex(0, mPVReactivePowers.coeff(a)) / mVoltages.coeff(k));
+        }
+        for (UInt l = 0; l < mLinks.size(); ++l) {
+            auto& link = mLinks[l];
+            mSubtreeCurrents(link.from) += mLinkCurrents.coeff(l) + link.shuntFrom * mVoltages.coeff(link.from);
+            mSubtreeCurrents(link.to) += -link.ratio * mLinkCurrents.coeff(l) + link.shuntTo * mVoltages.coeff(link.to);
+        }
+        for (UInt pos = static_cast<UInt>(mOrder.size()) - 1; pos > 0; --pos) {
+            UInt k = mOrder[pos];
+            auto& branch = mBranches[k];
+            mSubtreeCurrents(branch.parent) += branch.selfParent * mVoltages.coeff(branch.parent) - branch.parentGain * mSubtreeCurrents.coeff(k);
+        }
+
+        // Forward sweep: voltages from the VD bus to the leaves
+        for (UInt pos = 1; pos < mOrder.size(); ++pos) {
+            UInt k = mOrder[pos];
+            auto& branch = mBranches[k];
+            mVoltages(k) = -(mSubtreeCurrents.coeff(k) + branch.toParent * mVoltages.coeff(branch.parent)) / branch.self;
+        }
+        ++mNumSolves;
+
+        // Loop compensation: correct the link currents by their deviation from the voltage differences
+        if (!mLinks.empty()) {
+            VectorComp deviations(mLinks.size());
+            for (UInt l = 0; l < mLinks.size(); ++l) {
+                auto& link = mLinks[l];
+                deviations(l) = mVoltages.coeff(link.from) - mVoltages.coeff(link.to) - mLinkCurrents.coeff(l) / link.series;
+            }
+            mLinkCurrents += mLinkImpedances.solve(deviations);
+        }
+
+        // Reactive power of the PV buses from the voltage deviation and the reactance to the VD bus
+        Real pvDeviation = 0;
+        for (UInt a = 0; a < mNumPVBuses; ++a) {
+            UInt k = mPVBusIndices[a];
+            Real magnitude = std::abs(mVoltages.coeff(k));
+            Real reactance = mPathImpedances.coeff(k).imag();
+            if (reactance <= 0)
+                reactance = std::abs(mPathImpedances.coeff(k));
+            pvDeviation = std::max(pvDeviation, std::abs(pvSetPoints[a] - magnitude));
+            if (reactance > 0)
+                mPVReactivePowers(a) += (pvSetPoints[a] - magnitude) * magnitude / reactance;
+        }
+
+        for (UInt k = 0; k < numBuses; ++k) {
+            if (k == root)
+                continue;
+            sol_V(k) = std::abs(mVoltages.coeff(k));
+            sol_D(k) = std::arg(mVoltages.coeff(k));
+        }
+
+        calculateMismatch();
+        SPDLOG_LOGGER_DEBUG(mSLog, "Mismatch vector at iteration {}: \n {}", i, mF);
+
+        isConverged = checkConvergence() && pvDeviation <= mTolerance;
+        mIterations = i;
+    }
+    return isConverged;
+}
@@ -0,0 +1,331 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include <dpsim/ParallelSparseLUAdapter.h>
+#include <dpsim/BlockTriangularForm.h>
+#include <dpsim-models/TopologyPartitioner.h>
+
+using namespace DPsim;
+
+namespace {
+    Matrix gatherRows(const Matrix& matrix, const std::vector<UInt>& rows)
+    {
+        Matrix result(rows.size(), matrix.cols());
+        for (UInt r = 0; r < rows.size(); ++r)
+            result.row(r) = matrix.row(rows[r]);
+        return result;
+    }
+
+    void scatterRows(const Matrix& matrix, const std::vector<UInt>& rows, Matrix& result)
+    {
+        for (UInt r = 0; r < rows.size(); ++r)
+            result.row(rows[r]) = matrix.row(r);
+    }
+}
+
+namespace DPsim
+{
+    ParallelSparseLUAdapter::~ParallelSparseLUAdapter() = default;
+
+    void ParallelSparseLUAdapter::partition(const SparseMatrix& systemMatrix, UInt numDomains)
+    {
+        UInt size = static_cast<UInt>(systemMatrix.rows());
+
+        // Indices matched by the transversal form one vertex
+        BlockTriangularForm btf;
+        if (!btf.compute(systemMatrix))
+            throw CPS::SystemError("System matrix is structurally singular.");
+
+        std::vector<UInt> parent(size);
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&parent](UInt k) {
+            while (parent[k] != k)
+                k = parent[k] = parent[parent[k]];
+            return k;
+        };
+        for (UInt col = 0; col < size; ++col)
+            parent[find(col)] = find(btf.columnRows()[col]);
+
+        std::vector<UInt> indexVertices(size, size);
+        std::vector<UInt> weights;
+        for (UInt k = 0; k < size; ++k) {
+            UInt root = find(k);
+            if (indexVertices[root] == size) {
+                indexVertices[root] = static_cast<UInt>(weights.size());
+                weights.push_back(0);
+            }
+            indexVertices[k] = indexVertices[root];
+            weights[indexVertices[k]] += static_cast<UInt>(systemMatrix.outerIndexPtr()[k + 1] - systemMatrix.outerIndexPtr()[k]);
+        }
+
+        // Graph of the symmetrized pattern, edge weights count the coupling entries
+        std::vector<std::pair<UInt, UInt>> edges;
+        for (Int row = 0; row < systemMatrix.outerSize(); ++row) {
+            for (SparseMatrix::InnerIterator it(systemMatrix, row); it; ++it) {
+                UInt v0 = indexVertices[row], v1 = indexVertices[it.col()];
+                if (v0 != v1) {
+                    edges.emplace_back(v0, v1);
+                    edges.emplace_back(v1, v0);
+                }
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        std::vector<std::vector<std::pair<UInt, UInt>>> adjacency(weights.size());
+        for (UInt e = 0; e < edges.size(); ++e) {
+            if (e > 0 && edges[e] == edges[e - 1])
+                ++adjacency[edges[e].first].back().second;
+            else
+                adjacency[edges[e].first].emplace_back(edges[e].second, 1);
+        }
+
+        CPS::TopologyPartitioner partitioner("ParallelSparseLUPartitioner", CPS::Logger::Level::off);
+        auto vertexDomains = partitioner.partitionGraph(weights, adjacency, numDomains);
+
+        // Vertex separator covering the cut edges, greedily by the number of covered edges
+        std::vector<UInt> cutDegrees(weights.size(), 0);
+        for (UInt v = 0; v < weights.size(); ++v) {
+            for (auto& edge : adjacency[v]) {
+                if (vertexDomains[edge.first] != vertexDomains[v])
+                    ++cutDegrees[v];
+            }
+        }
+        std::set<std::pair<UInt, UInt>, std::greater<std::pair<UInt, UInt>>> candidates;
+        for (UInt v = 0; v < weights.size(); ++v) {
+            if (cutDegrees[v] > 0)
+                candidates.emplace(cutDegrees[v], v);
+        }
+        while (!candidates.empty()) {
+            UInt v = candidates.begin()->second;
+            candidates.erase(candidates.begin());
+            for (auto& edge : adjacency[v]) {
+                UInt w = edge.first;
+                if (vertexDomains[w] == numDomains || vertexDomains[w] == vertexDomains[v])
+                    continue;
+                candidates.erase({ cutDegrees[w], w });
+                if (--cutDegrees[w] > 0)
+                    candidates.emplace(cutDegrees[w], w);
+            }
+            vertexDomains[v] = numDomains;
+        }
+
+        mDomains.clear();
+        for (UInt d = 0; d < numDomains; ++d)
+            mDomains.push_back(std::make_unique<Domain>());
+        mSeparator.clear();
+        mIndexDomains.assign(size, numDomains);
+        mLocalIndices.assign(size, 0);
+        for (UInt k = 0; k < size; ++k) {
+            UInt domain = vertexDomains[indexVertices[k]];
+            mIndexDomains[k] = domain;
+            auto& indices = domain == numDomains ? mSeparator : mDomains[domain]->indices;
+            mLocalIndices[k] = static_cast<UInt>(indices.size());
+            indices.push_back(k);
+        }
+
+        // Separator indices coupled to each domain
+        for (Int row = 0; row < systemMatrix.outerSize(); ++row) {
+            for (SparseMatrix::InnerIterator it(systemMatrix, row); it; ++it) {
+                UInt rowDomain = mIndexDomains[row], colDomain = mIndexDomains[it.col()];
+                if (rowDomain < numDomains && colDomain == numDomains)
+                    mDomains[rowDomain]->borderColumns.push_back(mLocalIndices[it.col()]);
+                else if (rowDomain == numDomains && colDomain < numDomains)
+                    mDomains[colDomain]->borderRows.push_back(mLocalIndices[row]);
+            }
+        }
+        for (auto& domain : mDomains) {
+            for (auto border : { &domain->borderColumns, &domain->borderRows }) {
+                std::sort(border->begin(), border->end());
+                border->erase(std::unique(border->begin(), border->end()), border->end());
+            }
+        }
+
+        SPDLOG_LOGGER_INFO(mSLog, "Nested dissection of {} matrix indices into {} domains and a separator of {}",
+            size, numDomains, mSeparator.size());
+        for (UInt d = 0; d < numDomains; ++d)
+            SPDLOG_LOGGER_DEBUG(mSLog, "Domain {}: {} indices, {} border columns, {} border rows", d,
+                mDomains[d]->indices.size(), mDomains[d]->borderColumns.size(), mDomains[d]->borderRows.size());
+    }
+
+    void ParallelSparseLUAdapter::distribute(const SparseMatrix& systemMatrix)
+    {
+        UInt numDomains = static_cast<UInt>(mDomains.size());
+        std::vector<std::vector<Eigen::Triplet<Real>>> blockEntries(numDomains), columnEntries(numDomains), rowEntries(numDomains);
+        // Position of the separator indices in the border lists of the current domain
+        std::vector<std::vector<Int>> borderColumnPositions(numDomains), borderRowPositions(numDomains);
+        for (UInt d = 0; d < numDomains; ++d) {
+            borderColumnPositions[d].assign(mSeparator.size(), -1);
+            borderRowPositions[d].assign(mSeparator.size(), -1);
+            for (UInt b = 0; b < mDomains[d]->borderColumns.size(); ++b)
+                borderColumnPositions[d][mDomains[d]->borderColumns[b]] = static_cast<Int>(b);
+            for (UInt b = 0; b < mDomains[d]->borderRows.size(); ++b)
+                borderRowPositions[d][mDomains[d]->borderRows[b]] = static_cast<Int>(b);
+        }
+
+        mSchurComplement.setZero(mSeparator.size(), mSeparator.size());
+        for (Int row = 0; row < systemMatrix.outerSize(); ++row) {
+            for (SparseMatrix::InnerIterator it(systemMatrix, row); it; ++it) {
+                UInt rowDomain = mIndexDomains[row], colDomain = mIndexDomains[it.col()];
+                UInt localRow = mLocalIndices[row], localCol = mLocalIndices[it.col()];
+                if (rowDomain == numDomains && colDomain == numDomains) {
+                    mSchurComplement(localRow, localCol) += it.value();
+                } else if (rowDomain == colDomain) {
+                    blockEntries[rowDomain].emplace_back(localRow, localCol, it.value());
+                } else if (colDomain == numDomains) {
+                    Int position = borderColumnPositions[rowDomain][localCol];
+                    if (position < 0)
+                        throw CPS::SystemError("System matrix pattern differs from the partitioned pattern.");
+                    columnEntries[rowDomain].emplace_back(localRow, position, it.value());
+                } else if (rowDomain == numDomains) {
+                    Int position = borderRowPositions[colDomain][localRow];
+                    if (position < 0)
+                        throw CPS::SystemError("System matrix pattern differs from the partitioned pattern.");
+                    rowEntries[colDomain].emplace_back(position, localCol, it.value());
+                } else {
+                    throw CPS::SystemError("System matrix couples two domains of the partition.");
+                }
+            }
+        }
+
+        for (UInt d = 0; d < numDomains; ++d) {
+            auto& domain = *mDomains[d];
+            Int domainSize = static_cast<Int>(domain.indices.size());
+            domain.block.resize(domainSize, domainSize);
+            domain.block.setFromTriplets(blockEntries[d].begin(), blockEntries[d].end());
+            domain.columnCoupling.resize(domainSize, static_cast<Int>(domain.borderColumns.size()));
+            domain.columnCoupling.setFromTriplets(columnEntries[d].begin(), columnEntries[d].end());
+            domain.rowCoupling.resize(static_cast<Int>(domain.borderRows.size()), domainSize);
+            domain.rowCoupling.setFromTriplets(rowEntries[d].begin(), rowEntries[d].end());
+        }
+    }
+
+    void ParallelSparseLUAdapter::preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
+    {
+        UInt numDomains = 1;
+#ifdef WITH_OPENMP
+        numDomains = static_cast<UInt>(omp_get_max_threads());
+#endif
+        partition(systemMatrix, numDomains);
+        distribute(systemMatrix);
+        for (auto& domain : mDomains) {
+            if (!domain->indices.empty())
+                domain->lu.analyzePattern(domain->block);
+        }
+    }
+
+    void ParallelSparseLUAdapter::factorize(SparseMatrix& systemMatrix)
+    {
+        distribute(systemMatrix);
+
+        Int numDomains = static_cast<Int>(mDomains.size());
+        Bool success = true;
+#ifdef WITH_OPENMP
+        #pragma omp parallel for schedule(dynamic) reduction(&&: success)
+#endif
+        for (Int d = 0; d < numDomains; ++d) {
+            auto& domain = *mDomains[d];
+            if (domain.indices.empty())
+                continue;
+            domain.lu.factorize(domain.block);
+            if (domain.lu.info() != Eigen::Success) {
+                success = false;
+                continue;
+            }
+            // Update C_d * A_dd^-1 * B_d of the Schur complement
+            if (!domain.borderColumns.empty() && !domain.borderRows.empty()) {
+                Matrix coupling = domain.columnCoupling;
+                domain.schurUpdate = domain.rowCoupling * domain.lu.solve(coupling);
+            }
+        }
+        if (!success)
+            throw CPS::SystemError("Factorization of a domain block failed.");
+
+        for (auto& domain : mDomains) {
+            if (domain->indices.empty() || domain->borderColumns.empty() || domain->borderRows.empty())
+                continue;
+            for (UInt c = 0; c < domain->borderColumns.size(); ++c) {
+                for (UInt r = 0; r < domain->borderRows.size(); ++r)
+                    mSchurComplement(domain->borderRows[r], domain->borderColumns[c]) -= domain->schurUpdate(r, c);
+            }
+        }
+        if (!mSeparator.empty())
+            mSchurLU.compute(mSchurComplement);
+    }
+
+    void ParallelSparseLUAdapter::refactorize(SparseMatrix& systemMatrix)
+    {
+		/* Eigen's SparseLU does not use refactorization. Use regular factorization (numerical factorization and partial pivoting) here */
+        factorize(systemMatrix);
+    }
+
+    void ParallelSparseLUAdapter::partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
+    {
+		/* Eigen's SparseLU does not use refactorization. Use regular factorization (numerical factorization and partial pivoting) here */
+        factorize(systemMatrix);
+    }
+
+    Matrix ParallelSparseLUAdapter::solve(Matrix& mRightHandSideVector)
+    {
+        Matrix leftSideVector;
+        solveInPlace(mRightHandSideVector, leftSideVector);
+        return leftSideVector;
+    }
+
+    void ParallelSparseLUAdapter::solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector)
+    {
+        Int numDomains = static_cast<Int>(mDomains.size());
+        Int numColumns = static_cast<Int>(rightSideVector.cols());
+        leftSideVector.resize(rightSideVector.rows(), numColumns);
+
+        // Forward solves of the domains
+#ifdef WITH_OPENMP
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (Int d = 0; d < numDomains; ++d) {
+            auto& domain = *mDomains[d];
+            if (domain.indices.empty() || domain.borderRows.empty())
+                continue;
+            domain.solution = domain.lu.solve(gatherRows(rightSideVector, domain.indices));
+        }
+
+        Matrix separatorSolution;
+        if (!mSeparator.empty()) {
+            Matrix separatorVector = gatherRows(rightSideVector, mSeparator);
+            for (auto& domain : mDomains) {
+                if (domain->indices.empty() || domain->borderRows.empty())
+                    continue;
+                Matrix update = domain->rowCoupling * domain->solution;
+                for (UInt r = 0; r < domain->borderRows.size(); ++r)
+                    separatorVector.row(domain->borderRows[r]) -= update.row(r);
+            }
+            separatorSolution = mSchurLU.solve(separatorVector);
+            scatterRows(separatorSolution, mSeparator, leftSideVector);
+        }
+
+        // Backward solves of the domains with the separator solution
+#ifdef WITH_OPENMP
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (Int d = 0; d < numDomains; ++d) {
+            auto& domain = *mDomains[d];
+            if (domain.indices.empty())
+                continue;
+            Matrix domainVector = gatherRows(rightSideVector, domain.indices);
+            if (!domain.borderColumns.empty())
+                domainVector -= domain.columnCoupling * gatherRows(separatorSolution, domain.borderColumns);
+            scatterRows(domain.lu.solve(domainVector), domain.indices, leftSideVector);
+        }
+    }
+}
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/Parareal.h>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+
+using namespace CPS;
+using namespace DPsim;
+
+Parareal::Parareal(String name, Factory factory, UInt numSlices, Logger::Level logLevel)
+	: mLog(Logger::get(name, logLevel)), mName(name), mFactory(factory), mNumSlices(numSlices) { }
+
+void Parareal::initialize() {
+	if (mNumSlices == 0)
+		throw SystemError("Parareal " + mName + " requires at least one slice.");
+
+	mCoarse = mFactory(true);
+	mFine.clear();
+	for (UInt n = 0; n < mNumSlices; ++n)
+		mFine.push_back(mFactory(false));
+	if (!mCoarse || std::find(mFine.begin(), mFine.end(), nullptr) != mFine.end())
+		throw SystemError("The factory of Parareal " + mName + " did not create a simulation.");
+
+	mCoarse->initialize();
+	for (auto fine : mFine)
+		fine->initialize();
+
+	Real fineTimeStep = mFine[0]->timeStep();
+	Real coarseTimeStep = mCoarse->timeStep();
+	Real finalTime = mCoarse->finalTime();
+	for (auto fine : mFine) {
+		if (fine->timeStep() != fineTimeStep || fine->finalTime() != finalTime)
+			throw SystemError("All simulations of Parareal " + mName + " require the same final time and the fine ones the same time step.");
+	}
+	// The slice boundaries have to be steps of both propagators
+	UInt ratio = static_cast<UInt>(std::round(coarseTimeStep / fineTimeStep));
+	if (ratio == 0 || std::abs(ratio * fineTimeStep - coarseTimeStep) > 1e-9 * coarseTimeStep)
+		throw SystemError("The coarse time step of Parareal " + mName + " has to be a multiple of the fine time step.");
+	UInt totalSteps = static_cast<UInt>(std::round(finalTime / coarseTimeStep));
+	if (totalSteps < mNumSlices)
+		throw SystemError("Parareal " + mName + " has more slices than coarse time steps.");
+
+	mBoundaries.resize(mNumSlices + 1);
+	mCoarseSteps.resize(mNumSlices);
+	mFineSteps.resize(mNumSlices);
+	UInt previous = 0;
+	mBoundaries[0] = 0;
+	for (UInt n = 0; n < mNumSlices; ++n) {
+		UInt next = static_cast<UInt>((static_cast<uint64_t>(totalSteps) * (n + 1)) / mNumSlices);
+		mCoarseSteps[n] = next - previous;
+		mFineSteps[n] = mCoarseSteps[n] * ratio;
+		mBoundaries[n + 1] = next * coarseTimeStep;
+		previous = next;
+	}
+	if (mMaxIterations == 0)
+		mMaxIterations = mNumSlices;
+
+	SPDLOG_LOGGER_INFO(mLog, "Initialized Parareal {} with {} slices of {} coarse steps of {} s and {} fine steps of {} s",
+		mName, mNumSlices, mCoarseSteps[0], coarseTimeStep, mFineSteps[0], fineTimeStep);
+	mInitialized = true;
+}
+
+Checkpoint Parareal::propagate(Simulation::Ptr simulation, const Checkpoint& state, UInt slice, UInt steps) {
+	simulation->restoreState(state);
+	simulation->stepN(steps);
+	Checkpoint result = simulation->captureState();
+	// Avoid the rounding of the accumulated step times
+	result.time = mBoundaries[slice + 1];
+	return result;
+}
+
+Real Parareal::correct(Checkpoint& state, const Checkpoint& coarse, const Checkpoint& fine, const Checkpoint& previousCoarse) const {
+	Real change = 0;
+	Checkpoint corrected = fine;
+	for (auto& entry : corrected.values) {
+		auto& value = entry.second;
+		if (value.type != Checkpoint::Type::Real && value.type != Checkpoint::Type::Complex
+			&& value.type != Checkpoint::Type::Matrix && value.type != Checkpoint::Type::MatrixComp)
+			continue;
+		auto coarseValue = coarse.values.find(entry.first);
+		auto previousValue = previousCoarse.values.find(entry.first);
+		if (coarseValue == coarse.values.end() || previousValue == previousCoarse.values.end()
+			|| coarseValue->second.data.size() != value.data.size() || previousValue->second.data.size() != value.data.size())
+			continue;
+		for (std::size_t i = 0; i < value.data.size(); ++i)
+			value.data[i] += coarseValue->second.data[i] - previousValue->second.data[i];
+	}
+	for (auto& entry : corrected.values) {
+		auto oldValue = state.values.find(entry.first);
+		if (oldValue == state.values.end() || oldValue->second.data.size() != entry.second.data.size()) {
+			change = std::numeric_limits<Real>::infinity();
+			continue;
+		}
+		for (std::size_t i = 0; i < entry.second.data.size(); ++i) {
+			Real old = oldValue->second.data[i];
+			change = std::max(change, std::abs(entry.second.data[i] - old) / std::max(1., std::abs(old)));
+		}
+	}
+	state = std::move(corrected);
+	return change;
+}
+
+void Parareal::run() {
+	if (!mInitialized)
+		initialize();
+
+	mCoarse->start();
+	for (auto fine : mFine)
+		fine->start();
+
+	// Initial coarse propagation from the initialized state
+	mStates.assign(mNumSlices + 1, Checkpoint());
+	mCoarseStates.assign(mNumSlices + 1, Checkpoint());
+	mFineStates.assign(mNumSlices + 1, Checkpoint());
+	mStates[0] = mFine[0]->captureState();
+	mStates[0].time = mBoundaries[0];
+	for (UInt n = 0; n < mNumSlices; ++n) {
+		mCoarseStates[n + 1] = propagate(mCoarse, mStates[n], n, mCoarseSteps[n]);
+		mStates[n + 1] = mCoarseStates[n + 1];
+	}
+
+	mIterations = 0;
+	mConverged = false;
+	while (!mConverged && mIterations < mMaxIterations) {
+		// Slices before the iteration count start from exact states and are not run again
+		UInt first = mIterations;
+		UInt count = mNumSlices - first;
+		auto fineSlice = [this, first](UInt i) {
+			UInt n = first + i;
+			mFine[n]->reopenLoggers();
+			mFineStates[n + 1] = propagate(mFine[n], mStates[n], n, mFineSteps[n]);
+		};
+		if (mExecutor) {
+			mExecutor->parallelFor(count, fineSlice);
+		} else {
+			std::exception_ptr error;
+#ifdef WITH_OPENMP
+			#pragma omp parallel for schedule(dynamic)
+#endif
+			for (Int i = 0; i < static_cast<Int>(count); ++i) {
+				try {
+					fineSlice(static_cast<UInt>(i));
+				}
+				catch (...) {
+#ifdef WITH_OPENMP
+					#pragma omp critical
+#endif
+					if (!error)
+						error = std::current_exception();
+				}
+			}
+			if (error)
+				std::rethrow_exception(error);
+		}
+
+		// Sequential correction, the first slice starts from an unchanged state,
+		// so its coarse propagation cancels
+		mResidual = 0;
+		for (UInt n = first; n < mNumSlices; ++n) {
+			Checkpoint coarse = n == first ? mCoarseStates[n + 1] : propagate(mCoarse, mStates[n], n, mCoarseSteps[n]);
+			mResidual = std::max(mResidual, correct(mStates[n + 1], coarse, mFineStates[n + 1], mCoarseStates[n + 1]));
+			mCoarseStates[n + 1] = std::move(coarse);
+		}
+
+		++mIterations;
+		mConverged = mResidual <= mTolerance || mIterations == mNumSlices;
+		SPDLOG_LOGGER_INFO(mLog, "Parareal iteration {}: {} fine slices, largest relative change {}", mIterations, count, mResidual);
+	}
+
+	mCoarse->stop();
+	for (auto fine : mFine)
+		fine->stop();
+
+	if (mConverged)
+		SPDLOG_LOGGER_INFO(mLog, "Parareal {} converged after {} iterations", mName, mIterations);
+	else
+		SPDLOG_LOGGER_WARN(mLog, "Parareal {} did not converge in {} iterations, largest relative change {}", mName, mIterations, mResidual);
+	mLog->flush();
+}
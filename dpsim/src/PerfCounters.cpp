@@ -0,0 +1,92 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/PerfCounters.h>
+
+#ifdef __linux__
+  #include <cstring>
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+using namespace DPsim;
+
+PerfCounters& PerfCounters::thread() {
+	thread_local PerfCounters counters;
+	return counters;
+}
+
+const char* PerfCounters::eventName(UInt event) {
+	static const char* names[NumEvents] = { "cycles", "instructions", "llc_misses", "branch_misses" };
+	return event < NumEvents ? names[event] : "";
+}
+
+PerfCounters::PerfCounters() {
+	mFds.fill(-1);
+#ifdef __linux__
+	// The generic cache miss event counts misses of the last level cache
+	static const uint64_t configs[NumEvents] = {
+		PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+	};
+
+	for (UInt event = 0; event < NumEvents; event++) {
+		struct perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = configs[event];
+		attr.read_format = PERF_FORMAT_GROUP;
+		attr.disabled = (event == 0);
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+
+		int groupFd = (event == 0) ? -1 : mFds[0];
+		mFds[event] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+		if (mFds[event] < 0) {
+			for (UInt opened = 0; opened < event; opened++) {
+				close(mFds[opened]);
+				mFds[opened] = -1;
+			}
+			return;
+		}
+	}
+
+	mGroupFd = mFds[0];
+	ioctl(mGroupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(mGroupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+	for (int fd : mFds) {
+		if (fd >= 0)
+			close(fd);
+	}
+#endif
+}
+
+PerfCounters::Values PerfCounters::read() const {
+	Values values;
+	values.fill(0);
+#ifdef __linux__
+	if (mGroupFd < 0)
+		return values;
+
+	// Group format: number of events followed by the value of each event
+	uint64_t buffer[NumEvents + 1];
+	if (::read(mGroupFd, buffer, sizeof(buffer)) == static_cast<ssize_t>(sizeof(buffer))) {
+		for (UInt event = 0; event < NumEvents && event < buffer[0]; event++)
+			values[event] = buffer[event + 1];
+	}
+#endif
+	return values;
+}
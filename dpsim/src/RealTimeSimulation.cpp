@@ -8,17 +8,255 @@
 
 #include <chrono>
 #include <ctime>
+#include <dpsim/AllocationTracker.h>
+#include <dpsim/Checkpoint.h>
 #include <dpsim/RealTimeSimulation.h>
 #include <iomanip>
+#include <limits>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#endif
 
 using namespace CPS;
 using namespace DPsim;
 
+#ifdef __linux__
+namespace {
+	/// Touches the stack the steps may use, so that it is resident once the memory is locked
+	void prefaultStack() {
+		constexpr std::size_t size = 512 * 1024;
+		volatile unsigned char stack[size];
+		for (std::size_t i = 0; i < size; i += 4096)
+			stack[i] = 0;
+		(void) stack[0];
+	}
+}
+#endif
+
 RealTimeSimulation::RealTimeSimulation(String name, Logger::Level logLevel)
-	: Simulation(name, logLevel), mTimer() {
+	: Simulation(name, logLevel), mTimer(),
+	mOverruns(AttributeList::create<Int>("overruns", 0)),
+	mLatencyLast(AttributeList::create<Real>("latency_last", 0)),
+	mLatencyMax(AttributeList::create<Real>("latency_max", 0)),
+	mLatencyMean(AttributeList::create<Real>("latency_mean", 0)),
+	mSlack(AttributeList::create<Real>("slack", 0)),
+	mSlackMin(AttributeList::create<Real>("slack_min", 0)),
+	mDegradedPolicies(AttributeList::create<Int>("degraded_policies", 0)),
+	mAllocatingSteps(AttributeList::create<Int>("allocating_steps", 0)) {
+}
+
+void RealTimeSimulation::setBusyWait(Bool busyWait) {
+	int flags = mTimer.flags();
+	if (busyWait)
+		flags |= Timer::Flags::busy_wait;
+	else
+		flags &= ~Timer::Flags::busy_wait;
+	mTimer.setFlags(flags);
+}
+
+void RealTimeSimulation::addDegradationPolicy(const String& name, Real threshold,
+	std::function<void()> engage, std::function<void()> release) {
+	DegradationPolicy policy;
+	policy.name = name;
+	policy.threshold = threshold;
+	policy.engage = engage;
+	policy.release = release;
+	mDegradationPolicies.push_back(policy);
+}
+
+void RealTimeSimulation::addLoggerPausePolicy(Real threshold) {
+	addDegradationPolicy("pause loggers", threshold,
+		[this]() { for (auto logger : mLoggers) logger->setPaused(true); },
+		[this]() { for (auto logger : mLoggers) logger->setPaused(false); });
+}
+
+void RealTimeSimulation::addLoggerDownsamplingPolicy(Real threshold, UInt factor) {
+	if (factor == 0)
+		throw SystemError("Downsampling factor has to be at least 1");
+
+	auto original = std::make_shared<std::vector<UInt>>();
+	addDegradationPolicy("downsample loggers", threshold,
+		[this, original, factor]() {
+			original->clear();
+			for (auto logger : mLoggers) {
+				original->push_back(logger->downsampling());
+				logger->setDownsampling(logger->downsampling() * factor);
+			}
+		},
+		[this, original]() {
+			for (std::size_t i = 0; i < original->size() && i < mLoggers.size(); ++i)
+				mLoggers[i]->setDownsampling((*original)[i]);
+		});
+}
 
-	//addAttribute<Int >("overruns", nullptr, [=](){ return mTimer.overruns(); }, Flags::read);
-	//addAttribute<Int >("overruns", nullptr, nullptr, Flags::read);
+void RealTimeSimulation::addFreezePolicy(Real threshold) {
+	addDegradationPolicy("freeze variable components", threshold,
+		[this]() { for (auto solver : mSolvers) solver->setFreezeVariableComponents(true); },
+		[this]() { for (auto solver : mSolvers) solver->setFreezeVariableComponents(false); });
+}
+
+void RealTimeSimulation::addExportSuspendPolicy(Interface::Ptr intf, Real threshold) {
+	addDegradationPolicy("suspend exports", threshold,
+		[intf]() { intf->setExportsSuspended(true); },
+		[intf]() { intf->setExportsSuspended(false); });
+}
+
+void RealTimeSimulation::setDegradationHysteresis(UInt engageSteps, UInt releaseSteps, Real margin) {
+	mEngageSteps = std::max<UInt>(engageSteps, 1);
+	mReleaseSteps = std::max<UInt>(releaseSteps, 1);
+	mReleaseMargin = margin;
+}
+
+void RealTimeSimulation::monitorSlack() {
+	using Seconds = std::chrono::duration<Real>;
+
+	Real slack = std::chrono::duration_cast<Seconds>(mTimer.nextTick() - Timer::IntervalClock::now()).count();
+	**mSlack = slack;
+	**mSlackMin = std::min(**mSlackMin, slack);
+
+	Real ratio = slack / **mTimeStep;
+	for (auto& policy : mDegradationPolicies) {
+		if (ratio < policy.threshold) {
+			policy.stepsLow++;
+			policy.stepsHigh = 0;
+		} else if (ratio > policy.threshold + mReleaseMargin) {
+			policy.stepsHigh++;
+			policy.stepsLow = 0;
+		}
+
+		if (!policy.engaged && policy.stepsLow >= mEngageSteps) {
+			SPDLOG_LOGGER_WARN(mLog, "Slack {} s at {} s, engaging degradation policy '{}'", slack, mTime, policy.name);
+			policy.engage();
+			policy.engaged = true;
+			++**mDegradedPolicies;
+		} else if (policy.engaged && policy.stepsHigh >= mReleaseSteps) {
+			SPDLOG_LOGGER_INFO(mLog, "Releasing degradation policy '{}' at {} s", policy.name, mTime);
+			policy.release();
+			policy.engaged = false;
+			--**mDegradedPolicies;
+		}
+	}
+}
+
+void RealTimeSimulation::releaseDegradationPolicies() {
+	for (auto& policy : mDegradationPolicies) {
+		if (policy.engaged)
+			policy.release();
+		policy.engaged = false;
+		policy.stepsLow = policy.stepsHigh = 0;
+	}
+	**mDegradedPolicies = 0;
+}
+
+void RealTimeSimulation::warmUp() {
+	if (mWarmUpSteps == 0)
+		return;
+
+	Checkpoint state;
+	auto attributes = stateAttributes();
+	for (auto& attr : attributes)
+		state.capture(attr.first, attr.second);
+
+	DataLogger::List loggers = mLoggers;
+	for (auto solver : mSolvers) {
+		for (auto logger : solver->dataLoggers())
+			loggers.push_back(logger);
+	}
+	std::vector<Bool> paused;
+	for (auto logger : loggers) {
+		paused.push_back(logger && logger->isPaused());
+		if (logger)
+			logger->setPaused(true);
+	}
+	std::vector<std::pair<Bool, Bool>> suspended;
+	for (auto intf : mInterfaces) {
+		suspended.emplace_back(intf->importsSuspended(), intf->exportsSuspended());
+		intf->setImportsSuspended(true);
+		intf->setExportsSuspended(true);
+	}
+
+	// Events are not handled, they are due in the real run
+	auto start = std::chrono::steady_clock::now();
+	for (UInt step = 0; step < mWarmUpSteps; ++step)
+		mScheduler->step(mTime + step * **mTimeStep, mTimeStepCount + static_cast<Int>(step));
+	std::chrono::duration<Real> duration = std::chrono::steady_clock::now() - start;
+
+	for (auto& attr : attributes)
+		state.restore(attr.first, attr.second);
+	for (std::size_t i = 0; i < loggers.size(); ++i) {
+		if (loggers[i])
+			loggers[i]->setPaused(paused[i]);
+	}
+	for (std::size_t i = 0; i < mInterfaces.size(); ++i) {
+		mInterfaces[i]->setImportsSuspended(suspended[i].first);
+		mInterfaces[i]->setExportsSuspended(suspended[i].second);
+	}
+
+	SPDLOG_LOGGER_INFO(mLog, "Computed {} warm-up steps in {} s, restored {} state values",
+		mWarmUpSteps, duration.count(), state.values.size());
+}
+
+void RealTimeSimulation::trackedStep() {
+	if (!mTrackAllocations) {
+		step();
+		return;
+	}
+
+	uint64_t allocations = AllocationTracker::allocations();
+	uint64_t bytes = AllocationTracker::bytes();
+	AllocationTracker::arm();
+	step();
+	AllocationTracker::disarm();
+
+	if (AllocationTracker::allocations() == allocations)
+		return;
+
+	++**mAllocatingSteps;
+	if (**mAllocatingSteps <= AllocationReports)
+		SPDLOG_LOGGER_WARN(mLog, "Step {} at {} s made {} heap allocations of {} bytes",
+			mTimeStepCount - 1, mTime - **mTimeStep,
+			AllocationTracker::allocations() - allocations, AllocationTracker::bytes() - bytes);
+	if (**mAllocatingSteps == AllocationReports)
+		SPDLOG_LOGGER_WARN(mLog, "Not reporting further allocating steps");
+}
+
+void RealTimeSimulation::setupRealTime() {
+#ifdef __linux__
+	if (mLockMemory) {
+		if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0)
+			throw SystemError("Failed to lock memory");
+		prefaultStack();
+		SPDLOG_LOGGER_INFO(mLog, "Locked memory.");
+	}
+
+	if (mRealTimePriority > 0) {
+		struct sched_param param = {};
+		param.sched_priority = mRealTimePriority;
+		if (sched_setscheduler(0, SCHED_FIFO, &param) < 0)
+			throw SystemError("Failed to set real-time priority");
+		SPDLOG_LOGGER_INFO(mLog, "Set SCHED_FIFO priority {}.", mRealTimePriority);
+	}
+#else
+	if (mLockMemory || mRealTimePriority > 0)
+		SPDLOG_LOGGER_WARN(mLog, "Memory locking and real-time priority are not supported on this platform.");
+#endif
+
+	if (mTrackAllocations && !AllocationTracker::available()) {
+		SPDLOG_LOGGER_WARN(mLog, "DPsim was built without WITH_ALLOCATION_TRACKING, allocations are not tracked.");
+		mTrackAllocations = false;
+	}
+	**mAllocatingSteps = 0;
+}
+
+void RealTimeSimulation::updateTimerAttributes() {
+	using Seconds = std::chrono::duration<Real>;
+
+	**mOverruns = static_cast<Int>(mTimer.overruns());
+	**mLatencyLast = std::chrono::duration_cast<Seconds>(mTimer.latencyLast()).count();
+	**mLatencyMax = std::chrono::duration_cast<Seconds>(mTimer.latencyMax()).count();
+	**mLatencyMean = std::chrono::duration_cast<Seconds>(mTimer.latencyMean()).count();
 }
 
 void RealTimeSimulation::run(const Timer::StartClock::duration &startIn) {
@@ -29,6 +267,8 @@ void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
 	if (!mInitialized)
 		initialize();
 
+	warmUp();
+
 	SPDLOG_LOGGER_INFO(mLog, "Opening interfaces.");
 
 	for (auto intf : mInterfaces)
@@ -41,6 +281,9 @@ void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
 			  std::put_time(std::localtime(&now_time), "%F %T"),
 			  std::chrono::duration_cast<std::chrono::seconds>(startAt - Timer::StartClock::now()).count());
 
+	setupRealTime();
+	**mSlackMin = std::numeric_limits<Real>::infinity();
+
 	mTimer.setStartTime(startAt);
 	mTimer.setInterval(**mTimeStep);
 	mTimer.start();
@@ -48,7 +291,9 @@ void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
 	// main loop
 	do {
 		mTimer.sleep();
-		step();
+		updateTimerAttributes();
+		trackedStep();
+		monitorSlack();
 
 		if (mTimer.ticks() == 1)
 			SPDLOG_LOGGER_INFO(mLog, "Simulation started.");
@@ -56,13 +301,20 @@ void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
 
 	SPDLOG_LOGGER_INFO(mLog, "Simulation finished.");
 
+	// Loggers and interfaces are closed in their normal configuration
+	releaseDegradationPolicies();
+
 	mScheduler->stop();
 
 	for (auto intf : mInterfaces)
 		intf->close();
 
-	for (auto lg : mLoggers)
-		lg->close();
+	closeLoggers();
 
 	mTimer.stop();
+
+	SPDLOG_LOGGER_INFO(mLog, "Timer: {} overruns, wake-up latency mean {} s, max {} s, minimum slack {} s",
+		**mOverruns, **mLatencyMean, **mLatencyMax, **mSlackMin);
+	if (mTrackAllocations)
+		SPDLOG_LOGGER_INFO(mLog, "{} steps allocated on the heap", **mAllocatingSteps);
 }
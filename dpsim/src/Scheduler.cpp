@@ -8,11 +8,22 @@
 
 #include <dpsim/Scheduler.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 
+#include <limits>
+
+#ifdef __linux__
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
 using namespace CPS;
 using namespace DPsim;
 
@@ -22,10 +33,22 @@ void Scheduler::initMeasurements(const Task::List& tasks) {
 	// Fill map here already since it's not protected by a mutex
 	for (auto task : tasks) {
 		mMeasurements[task.get()] = std::vector<TaskTime>();
+		mMeasurementAverages[task.get()] = 0;
+		if (mPerfCounters)
+			mCounters[task.get()] = { PerfCounters::Values(), 0 };
 	}
+
+	if (mPerfCounters && !PerfCounters::thread().available())
+		SPDLOG_LOGGER_WARN(mSLog, "Hardware performance counters are not available, counts will be zero");
 }
 
 void Scheduler::updateMeasurement(Task* ptr, TaskTime time) {
+	if (mMeasurementSmoothing > 0) {
+		Real& avg = mMeasurementAverages[ptr];
+		Real value = static_cast<Real>(time.count());
+		avg = (avg == 0) ? value : avg + mMeasurementSmoothing * (value - avg);
+		return;
+	}
 	mMeasurements[ptr].push_back(time);
 }
 
@@ -40,6 +63,50 @@ void Scheduler::writeMeasurements(String filename) {
 		os << pair.first << "," << pair.second.count() << std::endl;
 	}
 	os.close();
+
+	if (mPerfCounters) {
+		auto dot = filename.find_last_of('.');
+		auto slash = filename.find_last_of('/');
+		if (dot == String::npos || (slash != String::npos && dot < slash))
+			dot = filename.size();
+		writeCounters(filename.substr(0, dot) + "_counters" + filename.substr(dot));
+	}
+}
+
+void Scheduler::updateCounters(Task* ptr, const PerfCounters::Values& start) {
+	auto end = PerfCounters::thread().read();
+	auto& entry = mCounters[ptr];
+	for (UInt event = 0; event < PerfCounters::NumEvents; event++)
+		entry.first[event] += end[event] - start[event];
+	entry.second++;
+}
+
+void Scheduler::writeCounters(String filename) {
+	// The task type is the part of the task name after the component name
+	std::map<String, std::pair<PerfCounters::Values, UInt>> types;
+	for (auto& pair : mCounters) {
+		String name = pair.first->toString();
+		auto& type = types[name.substr(name.find_last_of('.') + 1)];
+		for (UInt event = 0; event < PerfCounters::NumEvents; event++)
+			type.first[event] += pair.second.first[event];
+		type.second += pair.second.second;
+	}
+
+	std::ofstream os(filename);
+	os << "type,executions";
+	for (UInt event = 0; event < PerfCounters::NumEvents; event++)
+		os << "," << PerfCounters::eventName(event);
+	os << ",ipc" << std::endl;
+	for (auto& pair : types) {
+		auto& counts = pair.second.first;
+		os << pair.first << "," << pair.second.second;
+		for (UInt event = 0; event < PerfCounters::NumEvents; event++)
+			os << "," << counts[event];
+		Real ipc = counts[PerfCounters::Cycles] > 0 ?
+			static_cast<Real>(counts[PerfCounters::Instructions]) / counts[PerfCounters::Cycles] : 0;
+		os << "," << ipc << std::endl;
+	}
+	os.close();
 }
 
 void Scheduler::readMeasurements(String filename, std::unordered_map<String, TaskTime::rep>& measurements) {
@@ -61,7 +128,43 @@ void Scheduler::readMeasurements(String filename, std::unordered_map<String, Tas
 	}
 }
 
+void Scheduler::readTaskCosts(String filename, const Task::List& tasks, std::unordered_map<String, TaskTime::rep>& costs) {
+	if (!filename.empty()) {
+		readMeasurements(filename, costs);
+
+		// Check that measurements map is complete
+		for (auto task : tasks) {
+			if (costs.find(task->toString()) == costs.end())
+				throw SchedulingException();
+		}
+	} else {
+		// Insert constant cost for each task (HLFNET)
+		for (auto task : tasks) {
+			costs[task->toString()] = 1;
+		}
+	}
+}
+
+void Scheduler::hlfetPriorities(const Task::List& tasks, const Edges& outEdges,
+	const std::unordered_map<String, TaskTime::rep>& costs, std::unordered_map<Task::Ptr, int64_t>& priorities) {
+	for (auto it = tasks.rbegin(); it != tasks.rend(); ++it) {
+		auto task = *it;
+		int64_t maxLevel = 0;
+		if (outEdges.find(task) != outEdges.end()) {
+			for (auto dep : outEdges.at(task)) {
+				if (priorities[dep] > maxLevel) {
+					maxLevel = priorities[dep];
+				}
+			}
+		}
+		priorities[task] = costs.at(task->toString()) + maxLevel;
+	}
+}
+
 Scheduler::TaskTime Scheduler::getAveragedMeasurement(CPS::Task* task) {
+	if (mMeasurementSmoothing > 0)
+		return TaskTime(static_cast<TaskTime::rep>(mMeasurementAverages[task]));
+
 	TaskTime avg(0), tot(0);
 
 	for (TaskTime time : mMeasurements[task]) {
@@ -76,39 +179,458 @@ Scheduler::TaskTime Scheduler::getAveragedMeasurement(CPS::Task* task) {
 
 
 void Scheduler::resolveDeps(Task::List& tasks, Edges& inEdges, Edges& outEdges) {
+	uint64_t graphHash = 0;
+	TaskGraphCache::Graph cachedGraph;
+	if (mTaskGraphCache) {
+		graphHash = TaskGraphCache::hash(tasks);
+		if (mTaskGraphCache->lookup(graphHash, cachedGraph) && cachedGraph.numTasks == tasks.size() + 1) {
+			tasks.push_back(mRoot);
+			for (auto& edge : cachedGraph.edges) {
+				outEdges[tasks[edge.first]].push_back(tasks[edge.second]);
+				inEdges[tasks[edge.second]].push_back(tasks[edge.first]);
+			}
+			SPDLOG_LOGGER_INFO(mSLog, "Reused {} cached dependencies of {} tasks", cachedGraph.edges.size(), tasks.size());
+			return;
+		}
+	}
+
 	// Create graph (list of out/in edges for each node) from attribute dependencies
 	tasks.push_back(mRoot);
-	std::unordered_map<AttributeBase::Ptr, std::deque<Task::Ptr>, std::hash<AttributeBase::Ptr>, CPS::AttributeEq<AttributeBase>> dependencies;
-	std::unordered_set<AttributeBase::Ptr, std::hash<AttributeBase::Ptr>, CPS::AttributeEq<AttributeBase>> prevStepDependencies;
+
+	// The attributes get dense ids on first use. Their direct dependencies are
+	// looked up once, and the dependency closure of each attribute dependency of a
+	// task is collected by a depth first search which marks the visited attributes
+	// with the number of the search instead of building a set.
+	std::unordered_map<AttributeBase*, UInt> attributeIds;
+	std::vector<AttributeBase*> attributes;
+	std::vector<std::vector<UInt>> directDependencies;
+	std::vector<Bool> expanded;
+	std::vector<UInt> visited;
+	std::vector<Task::List> dependentTasks;
+	std::vector<Bool> prevStepDependencies;
+	auto attributeId = [&](const AttributeBase::Ptr& attr) {
+		auto result = attributeIds.emplace(attr.getPtr().get(), static_cast<UInt>(attributes.size()));
+		if (result.second) {
+			attributes.push_back(attr.getPtr().get());
+			directDependencies.emplace_back();
+			expanded.push_back(false);
+			visited.push_back(0);
+			dependentTasks.emplace_back();
+			prevStepDependencies.push_back(false);
+		}
+		return result.first->second;
+	};
+
+	UInt search = 0;
+	std::vector<UInt> stack;
+	AttributeBase::List directDeps;
 	for (auto task : tasks) {
 		for (AttributeBase::Ptr attr : task->getAttributeDependencies()) {
 			/// CHECK: Having external be the nullptr can lead to segfaults rather quickly. Maybe make it a special kind of attribute
-			if (attr.getPtr() != Scheduler::external.getPtr()) {
-				AttributeBase::Set attrDependencies = attr->getDependencies();
-				for (AttributeBase::Ptr dep : attrDependencies) {
-					dependencies[dep].push_back(task);
+			if (attr.getPtr() == Scheduler::external.getPtr()) {
+				dependentTasks[attributeId(attr)].push_back(task);
+				continue;
+			}
+
+			++search;
+			stack.assign(1, attributeId(attr));
+			while (!stack.empty()) {
+				UInt id = stack.back();
+				stack.pop_back();
+				if (visited[id] == search)
+					continue;
+				visited[id] = search;
+				dependentTasks[id].push_back(task);
+
+				if (!expanded[id]) {
+					expanded[id] = true;
+					directDeps.clear();
+					attributes[id]->appendDirectDependencies(directDeps);
+					std::vector<UInt> ids;
+					for (auto& dep : directDeps)
+						ids.push_back(attributeId(dep));
+					directDependencies[id] = std::move(ids);
+				}
+				for (UInt dep : directDependencies[id]) {
+					if (visited[dep] != search)
+						stack.push_back(dep);
 				}
-			} else {
-				dependencies[attr].push_back(task);
 			}
 		}
 		for (AttributeBase::Ptr attr : task->getPrevStepDependencies()) {
-			prevStepDependencies.insert(attr);
+			prevStepDependencies[attributeId(attr)] = true;
 		}
 	}
 
 	for (auto from : tasks) {
 		for (AttributeBase::Ptr attr : from->getModifiedAttributes()) {
-			for (auto to : dependencies[attr]) {
+			auto id = attributeIds.find(attr.getPtr().get());
+			if (id == attributeIds.end())
+				continue;
+			for (auto to : dependentTasks[id->second]) {
 				outEdges[from].push_back(to);
 				inEdges[to].push_back(from);
 			}
-			if (prevStepDependencies.count(attr)) {
+			if (prevStepDependencies[id->second]) {
 				outEdges[from].push_back(mRoot);
 				inEdges[mRoot].push_back(from);
 			}
 		}
 	}
+
+	if (mTaskGraphCache) {
+		// Record the edges in the order they were added above
+		std::unordered_map<Task*, uint32_t> taskIndex;
+		for (std::size_t i = 0; i < tasks.size(); ++i)
+			taskIndex.emplace(tasks[i].get(), static_cast<uint32_t>(i));
+
+		TaskGraphCache::Graph graph;
+		graph.numTasks = static_cast<UInt>(tasks.size());
+		for (auto from : tasks) {
+			auto out = outEdges.find(from);
+			if (out == outEdges.end())
+				continue;
+			for (auto& to : out->second)
+				graph.edges.emplace_back(taskIndex[from.get()], taskIndex[to.get()]);
+		}
+		mTaskGraphCache->store(graphHash, graph);
+	}
+}
+
+FusedTask::FusedTask(const Task::List& tasks) : Task(), mTasks(tasks) {
+	mName = tasks[0]->toString();
+	for (std::size_t i = 1; i < tasks.size(); ++i)
+		mName += "+" + tasks[i]->toString();
+
+	for (auto& task : tasks) {
+		for (auto& attr : task->getAttributeDependencies())
+			mAttributeDependencies.push_back(attr);
+		for (auto& attr : task->getModifiedAttributes())
+			mModifiedAttributes.push_back(attr);
+		for (auto& attr : task->getPrevStepDependencies())
+			mPrevStepDependencies.push_back(attr);
+	}
+}
+
+FusedTask::FusedTask(const Task::List& tasks, const AttributeBase::List& attributeDependencies,
+	const AttributeBase::List& modifiedAttributes, const AttributeBase::List& prevStepDependencies) : Task(), mTasks(tasks) {
+	mName = tasks[0]->toString();
+	for (std::size_t i = 1; i < tasks.size(); ++i)
+		mName += "+" + tasks[i]->toString();
+
+	mAttributeDependencies = attributeDependencies;
+	mModifiedAttributes = modifiedAttributes;
+	mPrevStepDependencies = prevStepDependencies;
+}
+
+Task::Ptr Scheduler::fuseTaskGraph(const Task::List& tasks) {
+	if (tasks.empty())
+		return nullptr;
+	if (tasks.size() == 1)
+		return tasks[0];
+
+	std::size_t numTasks = tasks.size();
+	std::unordered_map<AttributeBase*, std::vector<std::size_t>> modifiers;
+	for (std::size_t i = 0; i < numTasks; ++i) {
+		for (auto& attr : tasks[i]->getModifiedAttributes()) {
+			if (attr.getPtr() != external.getPtr())
+				modifiers[attr.getPtr().get()].push_back(i);
+		}
+	}
+
+	// Attributes an attribute depends on, including itself
+	auto closure = [](const AttributeBase::Ptr& attr, std::unordered_map<AttributeBase*, AttributeBase::Ptr>& attrs) {
+		AttributeBase::List stack(1, attr);
+		AttributeBase::List directDeps;
+		while (!stack.empty()) {
+			auto current = stack.back();
+			stack.pop_back();
+			if (!attrs.emplace(current.getPtr().get(), current).second)
+				continue;
+			directDeps.clear();
+			current->appendDirectDependencies(directDeps);
+			for (auto& dep : directDeps)
+				stack.push_back(dep);
+		}
+	};
+
+	// Dependencies between the tasks, a task reading the value of the previous
+	// step has to run before the task overwriting it
+	std::vector<std::set<std::size_t>> succ(numTasks);
+	std::vector<std::unordered_map<AttributeBase*, AttributeBase::Ptr>> deps(numTasks);
+	for (std::size_t j = 0; j < numTasks; ++j) {
+		for (auto& attr : tasks[j]->getAttributeDependencies()) {
+			if (attr.getPtr() != external.getPtr())
+				closure(attr, deps[j]);
+		}
+		for (auto& dep : deps[j]) {
+			auto it = modifiers.find(dep.first);
+			if (it == modifiers.end())
+				continue;
+			for (auto i : it->second) {
+				if (i != j)
+					succ[i].insert(j);
+			}
+		}
+		for (auto& attr : tasks[j]->getPrevStepDependencies()) {
+			auto it = modifiers.find(attr.getPtr().get());
+			if (it == modifiers.end())
+				continue;
+			for (auto i : it->second) {
+				if (i != j)
+					succ[j].insert(i);
+			}
+		}
+	}
+
+	// Kahn's algorithm, keeping the given order among independent tasks
+	std::vector<UInt> inDegree(numTasks, 0);
+	for (auto& s : succ) {
+		for (auto j : s)
+			++inDegree[j];
+	}
+	std::set<std::size_t> ready;
+	for (std::size_t i = 0; i < numTasks; ++i) {
+		if (inDegree[i] == 0)
+			ready.insert(i);
+	}
+	Task::List sortedTasks;
+	while (!ready.empty()) {
+		auto i = *ready.begin();
+		ready.erase(ready.begin());
+		sortedTasks.push_back(tasks[i]);
+		for (auto j : succ[i]) {
+			if (--inDegree[j] == 0)
+				ready.insert(j);
+		}
+	}
+	if (sortedTasks.size() != numTasks)
+		return nullptr;
+
+	// Keep the dependencies that do not lead to an attribute modified by the
+	// tasks, otherwise the fused task would depend on itself
+	AttributeBase::List attributeDependencies, modifiedAttributes, prevStepDependencies;
+	std::unordered_set<AttributeBase*> added;
+	for (std::size_t j = 0; j < numTasks; ++j) {
+		for (auto& attr : tasks[j]->getAttributeDependencies()) {
+			if (attr.getPtr() == external.getPtr() && added.insert(nullptr).second)
+				attributeDependencies.push_back(attr);
+		}
+		for (auto& dep : deps[j]) {
+			if (added.count(dep.first))
+				continue;
+			std::unordered_map<AttributeBase*, AttributeBase::Ptr> attrs;
+			closure(dep.second, attrs);
+			Bool internal = false;
+			for (auto& attr : attrs)
+				internal = internal || modifiers.count(attr.first);
+			if (!internal) {
+				added.insert(dep.first);
+				attributeDependencies.push_back(dep.second);
+			}
+		}
+	}
+	std::unordered_set<AttributeBase*> modified, prevStep;
+	for (auto& task : sortedTasks) {
+		for (auto& attr : task->getModifiedAttributes()) {
+			if (modified.insert(attr.getPtr().get()).second)
+				modifiedAttributes.push_back(attr);
+		}
+		for (auto& attr : task->getPrevStepDependencies()) {
+			if (prevStep.insert(attr.getPtr().get()).second)
+				prevStepDependencies.push_back(attr);
+		}
+	}
+
+	return std::make_shared<FusedTask>(sortedTasks, attributeDependencies, modifiedAttributes, prevStepDependencies);
+}
+
+MultiRateTask::MultiRateTask(Task::Ptr task, UInt multiple) :
+	Task(task->toString()), mTask(task), mMultiple(static_cast<Int>(multiple)) {
+	mAttributeDependencies = task->getAttributeDependencies();
+	mModifiedAttributes = task->getModifiedAttributes();
+	mPrevStepDependencies = task->getPrevStepDependencies();
+}
+
+void Scheduler::fuseTasks(Task::List& tasks, Edges& inEdges, Edges& outEdges) {
+	if (mFusionThreshold <= 0)
+		return;
+
+	std::unordered_map<String, TaskTime::rep> costs;
+	if (!mFusionMeasurementFile.empty())
+		readMeasurements(mFusionMeasurementFile, costs);
+
+	// Work on groups of tasks, initially one group per task
+	std::size_t numTasks = tasks.size();
+	std::unordered_map<Task::Ptr, std::size_t> indices;
+	for (std::size_t i = 0; i < numTasks; ++i)
+		indices[tasks[i]] = i;
+
+	std::vector<Task::List> members(numTasks);
+	std::vector<TaskTime::rep> cost(numTasks);
+	std::vector<Bool> fusible(numTasks), alive(numTasks, true);
+	std::vector<std::set<std::size_t>> pred(numTasks), succ(numTasks);
+	for (std::size_t i = 0; i < numTasks; ++i) {
+		auto& task = tasks[i];
+		members[i].push_back(task);
+		// The root and split tasks mark special points of the step and are never merged
+		fusible[i] = task != mRoot && !std::dynamic_pointer_cast<SplitTask>(task);
+		if (mFusionMeasurementFile.empty())
+			cost[i] = 1;
+		else if (costs.find(task->toString()) != costs.end())
+			cost[i] = costs.at(task->toString());
+		else
+			cost[i] = mFusionThreshold;
+
+		if (outEdges.find(task) == outEdges.end())
+			continue;
+		for (auto& after : outEdges.at(task)) {
+			auto it = indices.find(after);
+			if (it == indices.end() || it->second == i)
+				continue;
+			succ[i].insert(it->second);
+			pred[it->second].insert(i);
+		}
+	}
+
+	auto merge = [&](std::size_t into, std::size_t from) {
+		members[into].insert(members[into].end(), members[from].begin(), members[from].end());
+		cost[into] += cost[from];
+		for (auto p : pred[from]) {
+			succ[p].erase(from);
+			if (p != into) {
+				succ[p].insert(into);
+				pred[into].insert(p);
+			}
+		}
+		for (auto n : succ[from]) {
+			pred[n].erase(from);
+			if (n != into) {
+				pred[n].insert(into);
+				succ[into].insert(n);
+			}
+		}
+		pred[into].erase(from);
+		succ[into].erase(from);
+		alive[from] = false;
+	};
+
+	// Chains: a task whose only successor has no other predecessor
+	for (std::size_t i = 0; i < numTasks; ++i) {
+		if (!alive[i] || !fusible[i])
+			continue;
+		while (succ[i].size() == 1) {
+			auto next = *succ[i].begin();
+			if (!fusible[next] || pred[next].size() != 1 || cost[i] + cost[next] > mFusionThreshold)
+				break;
+			merge(i, next);
+		}
+	}
+
+	// Siblings: independent tasks with the same predecessors and successors
+	std::map<std::pair<std::set<std::size_t>, std::set<std::size_t>>, std::size_t> siblings;
+	for (std::size_t i = 0; i < numTasks; ++i) {
+		if (!alive[i] || !fusible[i])
+			continue;
+		auto key = std::make_pair(pred[i], succ[i]);
+		auto it = siblings.find(key);
+		if (it != siblings.end() && alive[it->second] && cost[it->second] + cost[i] <= mFusionThreshold) {
+			merge(it->second, i);
+			continue;
+		}
+		siblings[key] = i;
+	}
+
+	// Rebuild the graph from the groups
+	Task::List fusedTasks;
+	std::vector<Task::Ptr> groupTasks(numTasks);
+	for (std::size_t i = 0; i < numTasks; ++i) {
+		if (!alive[i])
+			continue;
+		groupTasks[i] = members[i].size() == 1 ? members[i][0] : std::make_shared<FusedTask>(members[i]);
+		fusedTasks.push_back(groupTasks[i]);
+	}
+
+	inEdges.clear();
+	outEdges.clear();
+	for (std::size_t i = 0; i < numTasks; ++i) {
+		if (!alive[i])
+			continue;
+		for (auto n : succ[i]) {
+			outEdges[groupTasks[i]].push_back(groupTasks[n]);
+			inEdges[groupTasks[n]].push_back(groupTasks[i]);
+		}
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "Task fusion merged {} tasks into {}", tasks.size(), fusedTasks.size());
+	tasks = fusedTasks;
+}
+
+void Scheduler::batchTasks(Task::List& tasks, Edges& inEdges, Edges& outEdges) {
+	if (!mTaskBatching)
+		return;
+
+	// Tasks in the same level do not depend on each other, and replacing tasks
+	// of one level by a batch keeps the levels a valid order of the graph
+	Task::List sortedTasks;
+	std::vector<Task::List> levels;
+	topologicalSort(tasks, inEdges, outEdges, sortedTasks);
+	levelSchedule(sortedTasks, inEdges, outEdges, levels);
+
+	std::unordered_map<Task::Ptr, Task::Ptr> replacements;
+	for (auto& level : levels) {
+		std::map<String, Task::List> groups;
+		for (auto& task : level) {
+			auto key = task->batchKey();
+			if (!key.empty())
+				groups[key].push_back(task);
+		}
+		for (auto& group : groups) {
+			if (group.second.size() < 2)
+				continue;
+			auto batch = group.second[0]->createBatch(group.second);
+			if (!batch)
+				continue;
+			for (auto& task : group.second)
+				replacements[task] = batch;
+			SPDLOG_LOGGER_DEBUG(mSLog, "Batched {} tasks into {}", group.second.size(), batch->toString());
+		}
+	}
+
+	auto replace = [&replacements](const Task::Ptr& task) {
+		auto it = replacements.find(task);
+		return it == replacements.end() ? task : it->second;
+	};
+
+	// Keep the order and the tasks not in the levels, like the root task
+	Task::List batchedTasks;
+	std::unordered_set<Task::Ptr> remaining;
+	for (auto& task : tasks) {
+		auto batched = replace(task);
+		if (remaining.insert(batched).second)
+			batchedTasks.push_back(batched);
+	}
+
+	// Rebuild the graph without duplicate edges
+	Edges batchedInEdges, batchedOutEdges;
+	std::set<std::pair<Task::Ptr, Task::Ptr>> edges;
+	for (auto& entry : outEdges) {
+		auto from = replace(entry.first);
+		if (!remaining.count(from))
+			continue;
+		for (auto& after : entry.second) {
+			auto to = replace(after);
+			if (remaining.count(to) && edges.insert(std::make_pair(from, to)).second) {
+				batchedOutEdges[from].push_back(to);
+				batchedInEdges[to].push_back(from);
+			}
+		}
+	}
+
+	SPDLOG_LOGGER_INFO(mSLog, "Task batching merged {} tasks into {}", tasks.size(), batchedTasks.size());
+	tasks = batchedTasks;
+	inEdges = batchedInEdges;
+	outEdges = batchedOutEdges;
 }
 
 void Scheduler::topologicalSort(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges, Task::List& sortedTasks) {
@@ -216,3 +738,37 @@ void BarrierTask::execute(Real time, Int timeStepCount) {
 		mBarriers[mBarriers.size()-1]->wait();
 	}
 }
+
+UInt AdaptiveWait::calibrate(Real microseconds) {
+	const UInt probe = 1000;
+	auto start = std::chrono::steady_clock::now();
+	for (UInt i = 0; i < probe; i++)
+		relax();
+	std::chrono::duration<Real, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+	Real perIteration = std::max(elapsed.count() / probe, 1e-4);
+	return static_cast<UInt>(microseconds / perIteration);
+}
+
+UInt AdaptiveWait::sSpinIterations = AdaptiveWait::calibrate(10);
+std::chrono::nanoseconds AdaptiveWait::sYieldTime = std::chrono::microseconds(50);
+
+void AdaptiveWait::setBudgets(Real spinMicroseconds, Real yieldMicroseconds) {
+	sSpinIterations = calibrate(spinMicroseconds);
+	sYieldTime = std::chrono::nanoseconds(static_cast<int64_t>(yieldMicroseconds * 1e3));
+}
+
+void AdaptiveWait::sleep(std::atomic<Int>& word, Int value) {
+#ifdef __linux__
+	static_assert(sizeof(std::atomic<Int>) == sizeof(int), "futex requires a plain int");
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+#else
+	// Without futexes, sleeping degrades to yielding
+	std::this_thread::yield();
+#endif
+}
+
+void AdaptiveWait::wakeAll(std::atomic<Int>& word) {
+#ifdef __linux__
+	syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+#endif
+}
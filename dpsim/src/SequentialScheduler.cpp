@@ -24,6 +24,14 @@ void SequentialScheduler::createSchedule(const Task::List& tasks, const Edges& i
 		Scheduler::initMeasurements(tasks);
 	Scheduler::topologicalSort(tasks, inEdges, outEdges, mSchedule);
 
+	mSplitIndex = mSchedule.size();
+	for (std::size_t i = 0; i < mSchedule.size(); ++i) {
+		if (std::dynamic_pointer_cast<SplitTask>(mSchedule[i])) {
+			mSplitIndex = i;
+			break;
+		}
+	}
+
 	for (auto task : mSchedule)
         SPDLOG_LOGGER_INFO(mSLog, "{}", task->toString());
 }
@@ -31,18 +39,28 @@ void SequentialScheduler::createSchedule(const Task::List& tasks, const Edges& i
 void SequentialScheduler::step(Real time, Int timeStepCount) {
 	if (mOutMeasurementFile.size() != 0) {
 		for (auto task : mSchedule) {
-			auto start = std::chrono::steady_clock::now();
-			task->execute(time, timeStepCount);
-			auto end = std::chrono::steady_clock::now();
-			updateMeasurement(task.get(), end-start);
+			measureTask(task.get(), time, timeStepCount);
 		}
 	} else {
 		for (auto it : mSchedule) {
-			it->execute(time, timeStepCount);
+			executeTask(it.get(), time, timeStepCount);
 		}
 	}
 }
 
+void SequentialScheduler::stepBeforeSplit(Real time, Int timeStepCount) {
+	for (std::size_t i = 0; i < mSplitIndex; ++i)
+		executeTask(mSchedule[i].get(), time, timeStepCount);
+
+	if (hasSplitTask())
+		std::static_pointer_cast<SplitTask>(mSchedule[mSplitIndex])->prepare(time, timeStepCount);
+}
+
+void SequentialScheduler::stepAfterSplit(Real time, Int timeStepCount) {
+	for (std::size_t i = mSplitIndex; i < mSchedule.size(); ++i)
+		executeTask(mSchedule[i].get(), time, timeStepCount);
+}
+
 void SequentialScheduler::stop() {
 	if (mOutMeasurementFile.size() != 0)
 		writeMeasurements(mOutMeasurementFile);
@@ -0,0 +1,122 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/SharedMemoryLoggerBackend.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+	"Shared memory logging requires lock-free 64 bit atomics");
+static_assert(sizeof(SharedMemoryLoggerBackend::Header) == 64,
+	"The shared memory header layout is read by other processes");
+
+SharedMemoryLoggerBackend::SharedMemoryLoggerBackend(UInt capacity) :
+	mCapacity(capacity) {
+	if (mCapacity == 0)
+		throw SystemError("Shared memory logger requires a capacity of at least one row.");
+}
+
+SharedMemoryLoggerBackend::~SharedMemoryLoggerBackend() {
+	close();
+}
+
+Bool SharedMemoryLoggerBackend::open(const fs::path& filename) {
+	close();
+
+	// Start from an empty object, readers of a previous run keep their mapping
+	mName = "/" + filename.filename().string();
+	shm_unlink(mName.c_str());
+	mFd = shm_open(mName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+	return mFd >= 0;
+}
+
+void SharedMemoryLoggerBackend::close() {
+	unmap();
+	if (mFd >= 0) {
+		::close(mFd);
+		mFd = -1;
+	}
+}
+
+void SharedMemoryLoggerBackend::unmap() {
+	if (mHeader) {
+		munmap(mHeader, mSize);
+		mHeader = nullptr;
+		mData = nullptr;
+	}
+	mSize = 0;
+}
+
+void SharedMemoryLoggerBackend::setColumns(const std::vector<String>& names, Notation notation) {
+	if (mFd < 0)
+		return;
+
+	String joined = "time";
+	for (auto& name : names)
+		joined += "," + name;
+
+	// The rows start at a multiple of the row size and of the page size
+	uint64_t namesOffset = sizeof(Header);
+	uint64_t namesSize = joined.size() + 1;
+	uint64_t dataOffset = (namesOffset + namesSize + 4095) / 4096 * 4096;
+	mColumns = static_cast<UInt>(names.size()) + 1;
+	std::size_t size = dataOffset + sizeof(Real) * mColumns * static_cast<std::size_t>(mCapacity);
+
+	unmap();
+	if (ftruncate(mFd, static_cast<off_t>(size)) != 0)
+		throw SystemError("Cannot resize shared memory object " + mName);
+	int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+	// Avoid page faults in the first pass through the ring buffer
+	flags |= MAP_POPULATE;
+#endif
+	void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, mFd, 0);
+	if (memory == MAP_FAILED)
+		throw SystemError("Cannot map shared memory object " + mName);
+	mSize = size;
+
+	// The object is zero-filled, readers wait for an even non-zero sequence
+	mHeader = new (memory) Header();
+	mHeader->sequence.store(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	std::memcpy(mHeader->magic, "DPSIMRB", 8);
+	mHeader->version = Version;
+	mHeader->columns = mColumns;
+	mHeader->capacity = mCapacity;
+	mHeader->namesOffset = namesOffset;
+	mHeader->namesSize = namesSize;
+	mHeader->dataOffset = dataOffset;
+	std::memcpy(static_cast<char*>(memory) + namesOffset, joined.c_str(), namesSize);
+	mData = reinterpret_cast<Real*>(static_cast<char*>(memory) + dataOffset);
+	mWriteIndex = 0;
+	mHeader->writeIndex.store(0, std::memory_order_relaxed);
+	mHeader->sequence.store(2, std::memory_order_release);
+}
+
+void SharedMemoryLoggerBackend::writeRow(Real time, const Real* values, UInt count) {
+	if (!mHeader)
+		return;
+
+	Real* row = mData + (mWriteIndex % mCapacity) * mColumns;
+	row[0] = time;
+	UInt columns = std::min<UInt>(count, mColumns - 1);
+	std::copy(values, values + columns, row + 1);
+	std::fill(row + 1 + columns, row + mColumns, 0);
+
+	// Publishes the row, readers loading the index with acquire see its values
+	mHeader->writeIndex.store(++mWriteIndex, std::memory_order_release);
+}
@@ -0,0 +1,181 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/ShmemLink.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+	"Shared memory links require lock-free atomics");
+
+namespace {
+	// The rings start on their own page after the header
+	constexpr std::size_t DataOffset = 4096;
+	static_assert(sizeof(ShmemLink::Header) <= DataOffset, "The shared memory link header does not fit");
+
+	inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#endif
+	}
+}
+
+ShmemLink::ShmemLink(const String& name, UInt side, UInt values, UInt capacity) :
+	mName(name.empty() || name[0] != '/' ? "/" + name : name),
+	mSide(side),
+	mValues(values),
+	mCapacity(capacity),
+	mRecord(values, 0) {
+	if (mSide > 1)
+		throw SystemError("The side of a shared memory link must be 0 or 1.");
+	if (mValues == 0 || mCapacity == 0)
+		throw SystemError("Shared memory link requires at least one value and one record.");
+
+	std::size_t ringSize = sizeof(Real) * mValues * static_cast<std::size_t>(mCapacity);
+	std::size_t size = DataOffset + 2 * ringSize;
+	void* memory = nullptr;
+
+	if (mSide == 0) {
+		// Start from a new object, a peer of a previous run still sees the old one as closed
+		shm_unlink(mName.c_str());
+		mFd = shm_open(mName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+		if (mFd < 0)
+			throw SystemError("Cannot create shared memory object " + mName);
+		if (ftruncate(mFd, static_cast<off_t>(size)) != 0)
+			throw SystemError("Cannot resize shared memory object " + mName);
+		memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+		if (memory == MAP_FAILED)
+			throw SystemError("Cannot map shared memory object " + mName);
+		mSize = size;
+
+		mHeader = new (memory) Header();
+		std::memcpy(mHeader->magic, "DPSIMLK", 8);
+		mHeader->version = Version;
+		mHeader->values = mValues;
+		mHeader->capacity = mCapacity;
+		mHeader->initialized.store(1, std::memory_order_release);
+	} else {
+		// Wait until side 0 has created and initialized the object
+		while (true) {
+			mFd = shm_open(mName.c_str(), O_RDWR, 0600);
+			struct stat info;
+			if (mFd >= 0 && fstat(mFd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= DataOffset) {
+				memory = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+				if (memory == MAP_FAILED)
+					throw SystemError("Cannot map shared memory object " + mName);
+				mHeader = static_cast<Header*>(memory);
+				mSize = info.st_size;
+
+				if (mHeader->initialized.load(std::memory_order_acquire) != 0
+					&& mHeader->sides[0].state.load(std::memory_order_acquire) != Closed)
+					break;
+				munmap(memory, mSize);
+				mHeader = nullptr;
+			}
+			if (mFd >= 0)
+				::close(mFd);
+			mFd = -1;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		if (std::memcmp(mHeader->magic, "DPSIMLK", 8) != 0 || mHeader->version != Version)
+			throw SystemError(mName + " is not a shared memory link.");
+		if (mHeader->values != mValues || mHeader->capacity != mCapacity || mSize < size)
+			throw SystemError("Both sides of shared memory link " + mName + " must use the same number of values and capacity.");
+	}
+
+	Real* rings = reinterpret_cast<Real*>(static_cast<char*>(memory) + DataOffset);
+	mOwnRing = rings + mSide * mValues * static_cast<std::size_t>(mCapacity);
+	mPeerRing = rings + (1 - mSide) * mValues * static_cast<std::size_t>(mCapacity);
+
+	// Handshake, both sides return once the other one is attached
+	mHeader->sides[mSide].state.store(Attached, std::memory_order_release);
+	while (mHeader->sides[1 - mSide].state.load(std::memory_order_acquire) == Detached)
+		std::this_thread::yield();
+}
+
+ShmemLink::~ShmemLink() {
+	if (mHeader) {
+		mHeader->sides[mSide].state.store(Closed, std::memory_order_release);
+		munmap(mHeader, mSize);
+	}
+	if (mFd >= 0)
+		::close(mFd);
+	if (mSide == 0)
+		shm_unlink(mName.c_str());
+}
+
+void ShmemLink::waitForPeer(const std::atomic<uint64_t>& counter, uint64_t minimum) const {
+	while (counter.load(std::memory_order_acquire) < minimum) {
+		if (mHeader->sides[1 - mSide].state.load(std::memory_order_acquire) == Closed
+			&& counter.load(std::memory_order_acquire) < minimum)
+			throw SystemError("The peer of shared memory link " + mName + " has closed.");
+		cpuRelax();
+	}
+}
+
+void ShmemLink::write(uint64_t index, const Real* values) {
+	Side& own = mHeader->sides[mSide];
+	if (index != own.written.load(std::memory_order_relaxed))
+		throw SystemError("Records of shared memory link " + mName + " must be written in order.");
+
+	// The slot still holds record index - capacity until the peer has released it
+	if (index >= mCapacity)
+		waitForPeer(mHeader->sides[1 - mSide].released, index - mCapacity + 1);
+
+	std::copy(values, values + mValues, mOwnRing + (index % mCapacity) * mValues);
+	own.written.store(index + 1, std::memory_order_release);
+}
+
+const Real* ShmemLink::read(uint64_t index) {
+	Side& own = mHeader->sides[mSide];
+	if (index < own.released.load(std::memory_order_relaxed))
+		throw SystemError("Record of shared memory link " + mName + " has already been released.");
+
+	// Older records are not read anymore and may be overwritten by the peer
+	own.released.store(index, std::memory_order_release);
+	waitForPeer(mHeader->sides[1 - mSide].written, index + 1);
+	return mPeerRing + (index % mCapacity) * mValues;
+}
+
+Complex ShmemLink::exchangeInitialVoltage(Complex voltage) {
+	if (mValues < 4)
+		throw SystemError("A decoupling line requires four values per record.");
+
+	mRecord[0] = voltage.real();
+	mRecord[1] = voltage.imag();
+	write(0, mRecord.data());
+	const Real* record = read(0);
+	return { record[0], record[1] };
+}
+
+void ShmemLink::send(Int timeStepCount, Complex voltage, Complex current) {
+	mRecord[0] = voltage.real();
+	mRecord[1] = voltage.imag();
+	mRecord[2] = current.real();
+	mRecord[3] = current.imag();
+	write(static_cast<uint64_t>(timeStepCount) + 1, mRecord.data());
+}
+
+void ShmemLink::receive(Int timeStepCount, Complex& voltage, Complex& current) {
+	const Real* record = read(static_cast<uint64_t>(timeStepCount) + 1);
+	voltage = { record[0], record[1] };
+	current = { record[2], record[3] };
+}
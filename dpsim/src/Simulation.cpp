@@ -4,17 +4,34 @@
 #include <iomanip>
 #include <algorithm>
 #include <typeindex>
+#include <optional>
+#include <set>
+#include <thread>
 
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/ThreadLevelScheduler.h>
+#include <dpsim/ThreadListScheduler.h>
+#include <dpsim/BinaryLoggerBackend.h>
+#include <dpsim/Checkpoint.h>
 #include <dpsim/Simulation.h>
 #include <dpsim/Utils.h>
 #include <dpsim-models/Utils.h>
 #include <dpsim/MNASolverFactory.h>
 #include <dpsim/PFSolverPowerPolar.h>
+#include <dpsim/PFSolverFastDecoupled.h>
+#include <dpsim/PFSolverSweep.h>
+#include <dpsim/PFSolverDC.h>
+#include <dpsim/LimSolver.h>
 #include <dpsim/DiakopticsSolver.h>
+#include <dpsim-models/TopologyPartitioner.h>
+#include <dpsim-models/AttributeArena.h>
 
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#ifdef WITH_OPENMP
+  #include <dpsim/OpenMPLevelScheduler.h>
+#endif
+
 #ifdef WITH_CIM
   #include <dpsim-models/CIM/Reader.h>
 #endif
@@ -28,12 +45,22 @@
 using namespace CPS;
 using namespace DPsim;
 
+namespace {
+	/// Components own the attributes below their key, e.g. "components/Name/sub.R" or "components/Name#2.R"
+	Bool isComponentKey(const String& name, const String& key) {
+		String prefix = "components/" + name;
+		return key.compare(0, prefix.size(), prefix) == 0 && key.size() > prefix.size()
+			&& (key[prefix.size()] == '.' || key[prefix.size()] == '/' || key[prefix.size()] == '#');
+	}
+}
+
 Simulation::Simulation(String name,	Logger::Level logLevel) :
 	mName(AttributeStatic<String>::make(name)),
 	mFinalTime(AttributeStatic<Real>::make(0.001)),
 	mTimeStep(AttributeStatic<Real>::make(0.001)),
 	mSplitSubnets(AttributeStatic<Bool>::make(true)),
 	mSteadyStateInit(AttributeStatic<Bool>::make(false)),
+	mObservedValues(AttributeStatic<Matrix>::make()),
 	mLogLevel(logLevel)  {
 	create();
 }
@@ -45,6 +72,7 @@ Simulation::Simulation(String name, CommandLineArgs& args) :
 	mTimeStep(AttributeStatic<Real>::make(args.timeStep)),
 	mSplitSubnets(AttributeStatic<Bool>::make(true)),
 	mSteadyStateInit(AttributeStatic<Bool>::make(false)),
+	mObservedValues(AttributeStatic<Matrix>::make()),
 	mLogLevel(args.logLevel),
 	mDomain(args.solver.domain),
 	mSolverType(args.solver.type),
@@ -52,6 +80,13 @@ Simulation::Simulation(String name, CommandLineArgs& args) :
 	create();
 }
 
+Simulation::~Simulation() {
+	if (mAsyncThread.joinable()) {
+		mAsyncCancel = true;
+		mAsyncThread.join();
+	}
+}
+
 void Simulation::create() {
 	// Logging
 	mLog = Logger::get(**mName, mLogLevel, std::max(Logger::Level::info, mLogLevel));
@@ -65,25 +100,237 @@ void Simulation::initialize() {
 	if (mInitialized)
 		return;
 
+	std::optional<CPS::ObjectPool::Scope> poolScope;
+	if (mObjectPooling) {
+		if (!mObjectPool)
+			mObjectPool = std::make_shared<CPS::ObjectPool>();
+		poolScope.emplace(mObjectPool);
+	}
+
 	mSolvers.clear();
 
-	switch (mDomain) {
-	case Domain::SP:
-		// Treat SP as DP
-	case Domain::DP:
-		createSolvers<Complex>();
-		break;
-	case Domain::EMT:
-		createSolvers<Real>();
-		break;
+	if (mQuasiDynamic)
+		setupQuasiDynamicMode();
+
+	if (mSolverType == Solver::Type::MNA && mSystem.isHybrid()) {
+		createHybridSolvers();
+	} else {
+		switch (mDomain) {
+		case Domain::SP:
+			// Treat SP as DP
+		case Domain::DP:
+			createSolvers<Complex>();
+			break;
+		case Domain::EMT:
+			createSolvers<Real>();
+			break;
+		}
+	}
+
+	if (mAdaptiveMaxLevel > 0)
+		setupAdaptiveTimeStepping();
+	else
+		mAdaptiveTimeStep = nullptr;
+	if (mEventInterpolation)
+		setupEventInterpolation();
+	mShiftFrequency = mSystem.mSystemFrequency;
+	mShiftAngle = 0;
+	mShiftTime = 0;
+	mShiftFrequencyChanges = 0;
+	if (mShiftFrequencySource.getPtr())
+		setupShiftFrequencyTracking();
+
+	if (mStepPhaseProfiling) {
+		if (!mStepPhases)
+			mStepPhases = std::make_shared<StepPhases>();
+		else
+			mStepPhases->reset();
+		for (auto solver : mSolvers)
+			solver->setStepPhases(mStepPhases);
+	} else {
+		mStepPhases = nullptr;
+	}
+	for (auto solver : mSolvers)
+		solver->setEventLog(mEventLog);
+	if (mExecutor) {
+		for (auto intf : mInterfaces)
+			intf->setExecutor(mExecutor);
+		for (auto logger : mLoggers)
+			logger->setExecutor(mExecutor);
 	}
 
 	mTime = 0;
 	mTimeStepCount = 0;
+	mPrefetchedEventTime = -1;
+	collectProtectionRelays();
+
+	// Lets in-memory loggers preallocate the rows of the run
+	UInt steps = static_cast<UInt>(std::ceil(**mFinalTime / **mTimeStep)) + 1;
+	for (auto logger : mLoggers)
+		logger->reserveSteps(steps);
+
+	if (mShardedLogging)
+		setupShardedLogging();
+
+	if (!mSensitivityParameters.empty())
+		setupSensitivities();
 
 	schedule();
 
+	if (mAttributeArena)
+		allocateAttributeArena();
+
+	// The scheduler needs the complete reference chains for the task dependencies
+	if (mAttributeFreezing)
+		freezeAttributes();
+
+	memoryReport().log(mLog);
+
+	// Captured after the steady-state initialization for reset()
+	mInitialStateAttributes = stateAttributes();
+	mInitialState = Checkpoint();
+	for (auto& attr : mInitialStateAttributes)
+		mInitialState.capture(attr.first, attr.second);
+	mParameterOverrides.clear();
+
 	mInitialized = true;
+
+	if (mAutoSchedulingSteps > 0)
+		selectScheduler();
+}
+
+void Simulation::selectScheduler() {
+	if (!mInterfaces.empty() || mAdaptiveTimeStep) {
+		SPDLOG_LOGGER_WARN(mLog, "Simulations with interfaces or adaptive time steps keep their scheduler");
+		return;
+	}
+	UInt steps = std::min<UInt>(mAutoSchedulingSteps,
+		static_cast<UInt>(std::floor((**mFinalTime - mTime) / **mTimeStep)));
+	if (steps == 0)
+		return;
+
+	std::vector<std::pair<String, std::function<std::shared_ptr<Scheduler>()>>> candidates;
+	candidates.push_back({ "sequential", []() { return std::make_shared<SequentialScheduler>(); } });
+	Int maxThreads = mAutoSchedulingMaxThreads > 0
+		? mAutoSchedulingMaxThreads : static_cast<Int>(std::thread::hardware_concurrency());
+	std::vector<Int> threadCounts;
+	for (Int threads = 2; threads < maxThreads; threads *= 2)
+		threadCounts.push_back(threads);
+	if (maxThreads > 1)
+		threadCounts.push_back(maxThreads);
+	for (Int threads : threadCounts) {
+		String suffix = " with " + std::to_string(threads) + " threads";
+		candidates.push_back({ "thread level" + suffix, [threads]() { return std::make_shared<ThreadLevelScheduler>(threads); } });
+		candidates.push_back({ "thread list" + suffix, [threads]() { return std::make_shared<ThreadListScheduler>(threads); } });
+#ifdef WITH_OPENMP
+		candidates.push_back({ "OpenMP level" + suffix, [threads]() { return std::make_shared<OpenMPLevelScheduler>(threads); } });
+#endif
+	}
+
+	Checkpoint state = captureState();
+	DataLogger::List loggers;
+	loggers.swap(mLoggers);
+	// Ends the threads of the scheduler scheduled during the initialization
+	mScheduler->stop();
+
+	std::size_t best = 0;
+	Real bestTime = std::numeric_limits<Real>::infinity();
+	for (std::size_t idx = 0; idx < candidates.size(); ++idx) {
+		mScheduler = candidates[idx].second();
+		schedule();
+		restoreState(state);
+		Histogram stepTimes;
+		for (UInt count = 0; count < steps; ++count) {
+			auto start = std::chrono::steady_clock::now();
+			step();
+			std::chrono::duration<double> diff = std::chrono::steady_clock::now() - start;
+			stepTimes.record(diff.count());
+		}
+		mScheduler->stop();
+
+		Real median = stepTimes.percentile(50);
+		SPDLOG_LOGGER_INFO(mLog, "Median step time of the {} scheduler: {:e} s", candidates[idx].first, median);
+		// Keep the fastest candidate, the sequential scheduler comes first and wins ties
+		if (median < bestTime) {
+			bestTime = median;
+			best = idx;
+		}
+	}
+
+	mLoggers.swap(loggers);
+	mScheduler = candidates[best].second();
+	schedule();
+	restoreState(state);
+	mStepTimes.reset();
+	SPDLOG_LOGGER_INFO(mLog, "Selected the {} scheduler after {} warm-up steps", candidates[best].first, steps);
+}
+
+void Simulation::setupSensitivities() {
+	auto attributes = stateAttributes();
+	std::vector<SensitivityParameter> parameters;
+	for (auto& param : mSensitivityParameters) {
+		auto attr = attributes.find(param.first);
+		auto realAttr = attr == attributes.end() ? nullptr : std::dynamic_pointer_cast<CPS::Attribute<Real>>(attr->second.getPtr());
+		if (!realAttr)
+			throw SystemError("Parameter " + param.first + " is not a real state attribute of simulation " + **mName);
+		IdentifiedObject::Ptr owner;
+		for (auto comp : mSystem.mComponents) {
+			if (isComponentKey(comp->name(), param.first))
+				owner = comp;
+		}
+		if (!owner)
+			throw SystemError("Parameter " + param.first + " does not belong to a component of simulation " + **mName);
+		parameters.push_back({ owner, realAttr, param.second });
+	}
+
+	UInt taken = 0;
+	for (auto solver : mSolvers)
+		taken += solver->setSensitivityParameters(parameters);
+	if (taken != parameters.size())
+		throw SystemError("The solvers of simulation " + **mName + " do not support the sensitivities of all parameters.");
+	SPDLOG_LOGGER_INFO(mLog, "Computing the sensitivities to {} parameters", parameters.size());
+}
+
+void Simulation::freezeAttributes() {
+	for (auto& attr : attributes())
+		attr.second->freeze();
+	for (auto& attr : stateAttributes())
+		attr.second->freeze();
+	SPDLOG_LOGGER_INFO(mLog, "Froze attribute references");
+}
+
+void Simulation::allocateAttributeArena() {
+	CPS::AttributeArena arena;
+	UInt added = 0;
+	auto addAttributes = [&arena, &added](const CPS::AttributeBase::Map& attributes) {
+		for (auto& attr : attributes)
+			added += arena.add(attr.second);
+	};
+
+	// Subcomponents and virtual nodes follow their component
+	std::function<void(IdentifiedObject::Ptr)> addComponent = [&](IdentifiedObject::Ptr comp) {
+		addAttributes(comp->attributes());
+
+		if (auto powerComp = std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp)) {
+			for (auto node : powerComp->virtualNodes())
+				addAttributes(node->attributes());
+			for (auto subComp : powerComp->subComponents())
+				addComponent(subComp);
+		} else if (auto powerComp = std::dynamic_pointer_cast<SimPowerComp<Real>>(comp)) {
+			for (auto node : powerComp->virtualNodes())
+				addAttributes(node->attributes());
+			for (auto subComp : powerComp->subComponents())
+				addComponent(subComp);
+		}
+	};
+
+	for (auto node : mSystem.mNodes)
+		addAttributes(node->attributes());
+	for (auto comp : mSystem.mComponents)
+		addComponent(comp);
+
+	UInt moved = arena.allocate();
+	SPDLOG_LOGGER_INFO(mLog, "Moved {} of {} static attribute values into the attribute arena, the others are shared", moved, added);
 }
 
 template <typename VarType>
@@ -91,21 +338,52 @@ void Simulation::createSolvers() {
 	Solver::Ptr solver;
 	switch (mSolverType) {
 		case Solver::Type::MNA:
-			createMNASolver<VarType>();
+			createMNASolver<VarType>(mSystem, mDomain);
 			break;
 #ifdef WITH_SUNDIALS
-		case Solver::Type::DAE:
-			solver = std::make_shared<DAESolver>(**mName, mSystem, **mTimeStep, 0.0);
+		case Solver::Type::DAE: {
+			auto daeSolver = std::make_shared<DAESolver>(**mName, mSystem, **mTimeStep, 0.0, mODELinearSolver);
+			daeSolver->doParallelResidual(mParallelDAEResidual);
+			solver = daeSolver;
 			mSolvers.push_back(solver);
 			break;
+		}
 #endif /* WITH_SUNDIALS */
 		case Solver::Type::NRP:
-			solver = std::make_shared<PFSolverPowerPolar>(**mName, mSystem, **mTimeStep, mLogLevel);
+		case Solver::Type::FDP:
+		case Solver::Type::DCP:
+		case Solver::Type::SWP: {
+			std::shared_ptr<PFSolver> pfSolver;
+			if (mSolverType == Solver::Type::FDP)
+				pfSolver = std::make_shared<PFSolverFastDecoupled>(**mName, mSystem, **mTimeStep, mLogLevel);
+			else if (mSolverType == Solver::Type::DCP)
+				pfSolver = std::make_shared<PFSolverDC>(**mName, mSystem, **mTimeStep, mLogLevel);
+			else if (mSolverType == Solver::Type::SWP)
+				pfSolver = std::make_shared<PFSolverSweep>(**mName, mSystem, **mTimeStep, mLogLevel);
+			else
+				pfSolver = std::make_shared<PFSolverPowerPolar>(**mName, mSystem, **mTimeStep, mLogLevel);
+			pfSolver->setDirectLinearSolverImplementation(mDirectImpl);
+			pfSolver->setDirectLinearSolverConfiguration(mDirectLinearSolverConfiguration);
+			pfSolver->doWarmStart(mPowerFlowWarmStart);
+			pfSolver->doJacobianReuse(mPowerFlowJacobianReuse);
+			solver = pfSolver;
 			solver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
 			solver->setSolverAndComponentBehaviour(mSolverBehaviour);
 			solver->initialize();
 			mSolvers.push_back(solver);
 			break;
+		}
+		case Solver::Type::LIM: {
+			if (mDomain != Domain::EMT)
+				throw SystemError("The LIM solver only supports the EMT domain.");
+			auto limSolver = std::make_shared<LimSolver>(**mName, mSystem, **mTimeStep, mLogLevel);
+			limSolver->setLatencyFactor(mLimLatencyFactor);
+			solver = limSolver;
+			solver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
+			solver->initialize();
+			mSolvers.push_back(solver);
+			break;
+		}
 		default:
 			throw UnsupportedSolverException();
 	}
@@ -113,58 +391,429 @@ void Simulation::createSolvers() {
 	// Some components require a dedicated ODE solver.
 	// This solver is independent of the system solver.
 #ifdef WITH_SUNDIALS
+	ODEInterface::List odeComps;
 	for (auto comp : mSystem.mComponents) {
 		auto odeComp = std::dynamic_pointer_cast<ODEInterface>(comp);
 		if (odeComp) {
-			// TODO explicit / implicit integration
+			if (mAggregatedODEIntegration) {
+				odeComps.push_back(odeComp);
+				continue;
+			}
+			String name = odeComp->mAttributeList->attributeTyped<String>("name")->get();
+			UInt multiple = timeStepMultiple({ name });
 			auto odeSolver = std::make_shared<ODESolver>(
-				odeComp->mAttributeList->attributeTyped<String>("name")->get() + "_ODE", odeComp, false, **mTimeStep);
+				name + "_ODE", odeComp, mImplicitODEIntegration || mQuasiDynamic, **mTimeStep * multiple);
+			odeSolver->setLinearSolver(mODELinearSolver);
+			odeSolver->setTimeStepMultiple(multiple);
 			mSolvers.push_back(odeSolver);
 		}
 	}
+	if (!odeComps.empty()) {
+		std::vector<String> names;
+		for (auto odeComp : odeComps)
+			names.push_back(odeComp->mAttributeList->attributeTyped<String>("name")->get());
+		UInt multiple = timeStepMultiple(names);
+		auto odeSolver = std::make_shared<ODESolver>(**mName + "_ODE", odeComps, mImplicitODEIntegration || mQuasiDynamic, **mTimeStep * multiple);
+		odeSolver->setLinearSolver(mODELinearSolver);
+		odeSolver->setTimeStepMultiple(multiple);
+		mSolvers.push_back(odeSolver);
+	}
 #endif /* WITH_SUNDIALS */
 }
 
 template <typename VarType>
-void Simulation::createMNASolver() {
+void Simulation::createMNASolver(SystemTopology& system, Domain domain, const String& nameSuffix) {
 	Solver::Ptr	 solver;
 	std::vector<SystemTopology> subnets;
+	if (mLineDecouplingDelaySteps > 0) {
+		if (domain == Domain::DP) {
+			auto lines = system.decoupleLines(**mTimeStep, mLineDecouplingDelaySteps);
+			SPDLOG_LOGGER_INFO(mLog, "Replaced {} lines by decoupling lines", lines.size());
+		} else {
+			SPDLOG_LOGGER_WARN(mLog, "Automatic line decoupling is only supported in the DP domain");
+		}
+	}
+	if (mAutomaticTearingPartitions > 1 && mTearComponents.empty()) {
+		TopologyPartitioner partitioner(**mName + "_Partitioner", mLogLevel);
+		mTearComponents = partitioner.partition<VarType>(system, mAutomaticTearingPartitions);
+		system.moveToTearComponents(mTearComponents);
+	}
 	// The Diakoptics solver splits the system at a later point.
 	// That is why the system is not split here if tear components exist.
 	if (**mSplitSubnets && mTearComponents.size() == 0)
-		mSystem.splitSubnets<VarType>(subnets);
+		system.splitSubnets<VarType>(subnets);
 	else
-		subnets.push_back(mSystem);
+		subnets.push_back(system);
+
+	std::vector<UInt> multiples;
+	for (auto& subnet : subnets) {
+		std::vector<String> names;
+		for (auto node : subnet.mNodes)
+			names.push_back(node->name());
+		for (auto comp : subnet.mComponents)
+			names.push_back(comp->name());
+		multiples.push_back(timeStepMultiple(names));
+	}
+	// The signal components are put into the first subnet. They couple the
+	// subnets, e.g. as decoupling lines, so they run with the fastest one.
+	auto fastest = std::distance(multiples.begin(), std::min_element(multiples.begin(), multiples.end()));
+	if (fastest > 0) {
+		auto& components = subnets[0].mComponents;
+		for (auto comp = components.begin(); comp != components.end();) {
+			if (std::dynamic_pointer_cast<SimSignalComp>(*comp)) {
+				subnets[fastest].mComponents.push_back(*comp);
+				comp = components.erase(comp);
+			} else {
+				++comp;
+			}
+		}
+	}
+
+	// Subnet solvers initialized later on the NUMA node of their scheduler thread
+	auto threadScheduler = std::dynamic_pointer_cast<ThreadScheduler>(mScheduler);
+	Bool numaLocal = mNumaLocalSubnets && subnets.size() > 1 && threadScheduler && mTearComponents.empty();
+	if (mNumaLocalSubnets && !numaLocal)
+		SPDLOG_LOGGER_INFO(mLog, "NUMA-local subnets require several subnets without tear components and a thread scheduler");
+	if (numaLocal && mExecutor && !threadScheduler->executor())
+		threadScheduler->setExecutor(mExecutor);
+	std::vector<Solver::Ptr> pending;
 
 	for (UInt net = 0; net < subnets.size(); ++net) {
 		String copySuffix;
 	   	if (subnets.size() > 1)
 			copySuffix = "_" + std::to_string(net);
+		Real timeStep = **mTimeStep * multiples[net];
+		if (multiples[net] > 1)
+			SPDLOG_LOGGER_INFO(mLog, "Subnet {} runs with {} times the time step", net, multiples[net]);
 
 		// TODO: In the future, here we could possibly even use different
 		// solvers for different subnets if deemed useful
 		if (mTearComponents.size() > 0) {
 			// Tear components available, use diakoptics
-			solver = std::make_shared<DiakopticsSolver<VarType>>(**mName,
-				subnets[net], mTearComponents, **mTimeStep, mLogLevel);
+			solver = std::make_shared<DiakopticsSolver<VarType>>(**mName + nameSuffix,
+				subnets[net], mTearComponents, timeStep, mLogLevel, mDirectImpl);
 		} else {
 			// Default case with lu decomposition from mna factory
-			solver = MnaSolverFactory::factory<VarType>(**mName + copySuffix, mDomain,
+			solver = MnaSolverFactory::factory<VarType>(**mName + nameSuffix + copySuffix, domain,
 												 mLogLevel, mDirectImpl, mSolverPluginName);
-			solver->setTimeStep(**mTimeStep);
+			solver->setTimeStep(timeStep);
 			solver->doSteadyStateInit(**mSteadyStateInit);
 			solver->doFrequencyParallelization(mFreqParallel);
+			solver->setHarmonicDropTolerance(mHarmonicDropTolerance);
 			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
 			solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
+			solver->setSteadStIniExtrapolationDepth(mSteadStIniExtrapolationDepth);
 			solver->setSystem(subnets[net]);
 			solver->setSolverAndComponentBehaviour(mSolverBehaviour);
 			solver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
 			solver->doSystemMatrixRecomputation(mSystemMatrixRecomputation);
+			solver->doSparseRightVectorAssembly(mSparseRightVectorAssembly);
+			solver->doLazySwitchedMatrices(mLazySwitchedMatrices);
+			solver->setSwitchedMatrixCacheSize(mSwitchedMatrixCacheSize);
+			solver->doSharedSymbolicAnalysis(mSharedSymbolicAnalysis);
+			solver->doLowRankSystemMatrixUpdates(mLowRankSystemMatrixUpdates);
+			solver->setLowRankUpdateMaxRank(mLowRankUpdateMaxRank);
+			solver->doIncrementalSystemMatrixStamping(mIncrementalSystemMatrixStamping);
+			solver->doIncrementalSolve(mIncrementalSolve);
+			solver->setIncrementalSolveMaxRows(mIncrementalSolveMaxRows);
+			solver->doKronReduction(mKronReduction);
+			solver->doSignalGraphFusion(mSignalGraphFusion);
+			solver->doGpuResidentStep(mGpuResidentStep);
+			solver->setGpuResidentCopyInterval(mGpuResidentCopyInterval);
+			solver->doStepGeneration(mStepGeneration);
+			solver->doBlockParallelSolve(mBlockParallelSolve);
+			solver->doMatrixNodeReordering(mMatrixNodeReordering);
+			solver->setMaxCorrectorIterations(mMaxCorrectorIterations);
+			solver->doParallelComponentInitialization(mParallelComponentInitialization);
+			solver->doParallelSwitchedMatrixInitialization(mParallelSwitchedMatrixInitialization);
+			solver->setExecutor(mExecutor);
+			solver->setObservedNodes(mObservedNodes, mObservedValues);
+			solver->setBatchedLinearSolver(mBatchedLinearSolver);
 			solver->setDirectLinearSolverConfiguration(mDirectLinearSolverConfiguration);
-			solver->initialize();
+			if (numaLocal) {
+				solver->setThreadHint(static_cast<Int>(net) % threadScheduler->threadCount());
+				pending.push_back(solver);
+			} else {
+				solver->initialize();
+			}
 		}
+		solver->setTimeStepMultiple(multiples[net]);
 		mSolvers.push_back(solver);
 	}
+
+	// The initialization allocates the system matrices, vectors and component
+	// states, so the memory pages are first touched by a thread pinned like the
+	// scheduler thread of the solver. The solvers share the logger and the
+	// signal components, that is why they are initialized one after another.
+	for (auto& pendingSolver : pending) {
+		std::exception_ptr error;
+		std::thread thread([&]() {
+			try {
+				if (!threadScheduler->pinThread(pendingSolver->threadHint()))
+					SPDLOG_LOGGER_WARN(mLog, "Scheduler thread {} is not pinned, the solver is initialized on any NUMA node",
+						pendingSolver->threadHint());
+				pendingSolver->initialize();
+			} catch (...) {
+				error = std::current_exception();
+			}
+		});
+		thread.join();
+		if (error)
+			std::rethrow_exception(error);
+	}
+}
+
+void Simulation::createHybridSolvers() {
+	if (!mTearComponents.empty() || mAutomaticTearingPartitions > 1)
+		throw SystemError("Hybrid EMT and SP/DP topologies do not support diakoptics.");
+
+	SystemTopology phasorSystem, emtSystem;
+	mSystem.splitDomains(phasorSystem, emtSystem);
+	Domain phasorDomain = mDomain == Domain::SP ? Domain::SP : Domain::DP;
+	SPDLOG_LOGGER_INFO(mLog, "Hybrid topology with {} {} and {} EMT nodes",
+		phasorSystem.mNodes.size(), phasorDomain == Domain::SP ? "SP" : "DP", emtSystem.mNodes.size());
+
+	createMNASolver<Complex>(phasorSystem, phasorDomain, phasorDomain == Domain::SP ? "_SP" : "_DP");
+	createMNASolver<Real>(emtSystem, Domain::EMT, "_EMT");
+}
+
+void Simulation::setupQuasiDynamicMode() {
+	if (mDomain != Domain::SP || mSolverType != Solver::Type::MNA || mSystem.isHybrid())
+		throw SystemError("The quasi-dynamic mode requires the MNA solver and an SP topology.");
+
+	UInt generators = 0;
+	for (auto comp : mSystem.mComponents) {
+		if (auto gen = std::dynamic_pointer_cast<Base::ReducedOrderSynchronGenerator<Complex>>(comp)) {
+			gen->setModelWithConstantConductance(true);
+			gen->doImplicitControllerIntegration(true);
+			++generators;
+		} else if (auto exciter = std::dynamic_pointer_cast<Signal::Exciter>(comp)) {
+			exciter->doImplicitIntegration(true);
+		} else if (auto governor = std::dynamic_pointer_cast<Signal::TurbineGovernorType1>(comp)) {
+			governor->doImplicitIntegration(true);
+		}
+	}
+	SPDLOG_LOGGER_INFO(mLog, "Quasi-dynamic mode with {} reduced order generators", generators);
+}
+
+void Simulation::setupAdaptiveTimeStepping() {
+	for (auto solver : mSolvers) {
+		if (solver->timeStepMultiple() != 1 || !solver->supportsTimeStepChange())
+			throw SystemError("Adaptive time steps require direct MNA solvers running at the simulation time step, see the solver logs.");
+	}
+	// The batched steps copy the companion model coefficients of the components
+	if (mScheduler && mScheduler->taskBatching())
+		throw SystemError("Adaptive time steps do not support task batching.");
+
+	mAdaptiveTimeStep = std::make_shared<AdaptiveTimeStep>(**mTimeStep,
+		mAdaptiveMaxLevel, mAdaptiveRelTol, mAdaptiveAbsTol, mAdaptiveHoldSteps);
+	setLoggerOutputGrids();
+	SPDLOG_LOGGER_INFO(mLog, "Adaptive time steps from {:e} to {:e}",
+		mAdaptiveTimeStep->timeStep(0), mAdaptiveTimeStep->timeStep(mAdaptiveMaxLevel));
+}
+
+void Simulation::advanceAdaptiveTimeStep() {
+	std::vector<const Matrix*> solutions;
+	for (auto solver : mSolvers)
+		solutions.push_back(solver->solution());
+	mAdaptiveTimeStep->addSolutions(solutions);
+
+	if (mAdaptiveTimeStep->advance(std::min(mEvents.nextTime(), **mFinalTime))) {
+		SPDLOG_LOGGER_DEBUG(mLog, "Time step {:e} from {:e}", mAdaptiveTimeStep->timeStep(), mTime);
+		for (auto solver : mSolvers)
+			solver->changeTimeStep(mAdaptiveTimeStep->timeStep());
+	}
+	mTime = mAdaptiveTimeStep->time();
+}
+
+void Simulation::setLoggerOutputGrids() {
+	for (auto logger : mLoggers) {
+		if (logger->outputGrid() <= 0)
+			logger->setOutputGrid(**mTimeStep * logger->downsampling());
+	}
+}
+
+void Simulation::setupEventInterpolation() {
+	if (mAdaptiveTimeStep)
+		throw SystemError("Event interpolation does not support adaptive time steps.");
+	for (auto solver : mSolvers) {
+		if (solver->timeStepMultiple() != 1 || !solver->supportsStateInterpolation())
+			throw SystemError("Event interpolation requires MNA solvers running at the simulation time step, see the solver logs.");
+	}
+	// The batched steps keep the companion model states outside of the components
+	if (mScheduler && mScheduler->taskBatching())
+		throw SystemError("Event interpolation does not support task batching.");
+
+	setLoggerOutputGrids();
+}
+
+Bool Simulation::stepInterpolatedEvent() {
+	Real timeStep = **mTimeStep;
+	Real previousTime = mTime - timeStep;
+	Real eventTime = mEvents.nextTime();
+	if (eventTime <= previousTime + EventQueue::timeTolerance || eventTime >= mTime - EventQueue::timeTolerance)
+		return false;
+
+	// The loggers only receive the interpolated states
+	std::vector<Bool> paused;
+	for (auto logger : mLoggers) {
+		paused.push_back(logger->isPaused());
+		logger->setPaused(true);
+	}
+
+	// Step over the event and go back to its instant
+	for (auto solver : mSolvers)
+		solver->saveState();
+	mScheduler->step(mTime, mTimeStepCount);
+	interpolateStates((eventTime - previousTime) / timeStep);
+	logInterpolatedState(eventTime, paused);
+	{
+		StepPhases::Scope phase(mStepPhases.get(), StepPhases::Events);
+		mEvents.handleEvents(eventTime);
+	}
+
+	// Half of a step after the event is a backward Euler step, which damps the chatter
+	mScheduler->step(eventTime + timeStep, mTimeStepCount);
+	interpolateStates(0.5);
+	Real time = eventTime + timeStep / 2;
+
+	// Back onto the grid, events up to it are executed at the next step
+	Real gridTime = mTime;
+	if (time > mTime + EventQueue::timeTolerance) {
+		gridTime += timeStep;
+		++mTimeStepCount;
+	}
+	if (gridTime - time > EventQueue::timeTolerance) {
+		logInterpolatedState(time, paused);
+		mScheduler->step(time + timeStep, mTimeStepCount);
+		interpolateStates((gridTime - time) / timeStep);
+	}
+	logInterpolatedState(gridTime, paused);
+	for (std::size_t i = 0; i < mLoggers.size(); ++i)
+		mLoggers[i]->setPaused(paused[i]);
+
+	mTime = gridTime + timeStep;
+	return true;
+}
+
+void Simulation::setupShiftFrequencyTracking() {
+	if (mDomain != Domain::DP)
+		throw SystemError("Shift frequency tracking requires a dynamic phasor simulation.");
+	for (auto solver : mSolvers) {
+		if (!solver->supportsShiftFrequencyChange())
+			throw SystemError("Shift frequency tracking requires direct MNA solvers, see the solver logs.");
+	}
+	// The batched steps copy the companion model coefficients of the components
+	if (mScheduler && mScheduler->taskBatching())
+		throw SystemError("Shift frequency tracking does not support task batching.");
+}
+
+void Simulation::trackShiftFrequency() {
+	Real frequency = **mShiftFrequencySource;
+	if (std::abs(frequency - mShiftFrequency) <= mShiftFrequencyTolerance)
+		return;
+
+	// The change applies from the next step on
+	mShiftAngle = shiftAngle();
+	mShiftTime = mTime;
+	mShiftFrequency = frequency;
+	++mShiftFrequencyChanges;
+	SPDLOG_LOGGER_DEBUG(mLog, "Shift frequency {:f} from {:e}", frequency, mTime);
+	for (auto solver : mSolvers)
+		solver->changeShiftFrequency(frequency, mTime);
+}
+
+void Simulation::prefetchSwitchedMatrices() {
+	Real eventTime = mEvents.nextTime();
+	if (eventTime == mPrefetchedEventTime || std::isinf(eventTime))
+		return;
+	mPrefetchedEventTime = eventTime;
+
+	std::vector<SwitchChange> changes;
+	for (auto event : mEvents.nextEvents())
+		event->switchChanges(changes);
+	if (changes.empty())
+		return;
+	for (auto solver : mSolvers)
+		solver->prefetchSwitchStates(changes);
+}
+
+void Simulation::collectProtectionRelays() {
+	mProtectionRelays.clear();
+	mSpeculating = false;
+	mTrippedRelays = 0;
+	if (!mSpeculativeFactorization)
+		return;
+	for (auto comp : mSystem.mComponents) {
+		if (auto relay = std::dynamic_pointer_cast<CPS::Signal::ProtectionRelay>(comp))
+			mProtectionRelays.push_back(relay);
+	}
+}
+
+void Simulation::speculateProtectionTrips() {
+	std::vector<SwitchChange> changes, trips;
+	for (auto& relay : mProtectionRelays) {
+		if (relay->tripImminent())
+			changes.push_back({ relay->switchState().getPtr().get(), false });
+		else if (**relay->mTripped)
+			trips.push_back({ relay->switchState().getPtr().get(), false });
+	}
+	// A trip in the last step is only picked up by the solve of this step
+	Bool newTrip = trips.size() > mTrippedRelays;
+	mTrippedRelays = static_cast<UInt>(trips.size());
+	if (changes.empty()) {
+		if (mSpeculating && !newTrip) {
+			for (auto solver : mSolvers)
+				solver->discardPrefetch();
+			// A dropped prefetch of the next events is requested again
+			mPrefetchedEventTime = -1;
+			mSpeculating = false;
+		}
+		return;
+	}
+	mSpeculating = true;
+	changes.insert(changes.end(), trips.begin(), trips.end());
+	for (auto solver : mSolvers)
+		solver->prefetchSwitchStates(changes);
+}
+
+void Simulation::interpolateStates(Real weight) {
+	for (auto solver : mSolvers) {
+		solver->interpolateState(weight);
+		solver->saveState();
+	}
+}
+
+void Simulation::logInterpolatedState(Real time, const std::vector<Bool>& paused) {
+	for (std::size_t i = 0; i < mLoggers.size(); ++i) {
+		if (paused[i])
+			continue;
+		mLoggers[i]->setPaused(false);
+		mLoggers[i]->log(time, mTimeStepCount);
+		mLoggers[i]->setPaused(true);
+	}
+}
+
+UInt Simulation::timeStepMultiple(const std::vector<String>& names) const {
+	UInt multiple = 0;
+	for (auto& name : names) {
+		auto search = mTimeStepMultiples.find(name);
+		if (search != mTimeStepMultiples.end() && (multiple == 0 || search->second < multiple))
+			multiple = search->second;
+	}
+	return multiple > 0 ? multiple : mDefaultTimeStepMultiple;
+}
+
+void Simulation::setTimeStepMultiple(const String& name, UInt multiple) {
+	if (multiple == 0)
+		throw SystemError("The time step multiple of " + name + " must be positive.");
+	mTimeStepMultiples[name] = multiple;
+}
+
+void Simulation::setDefaultTimeStepMultiple(UInt multiple) {
+	if (multiple == 0)
+		throw SystemError("The default time step multiple must be positive.");
+	mDefaultTimeStepMultiple = multiple;
 }
 
 void Simulation::sync() const {
@@ -184,7 +833,12 @@ void Simulation::prepSchedule() {
 	mTaskOutEdges.clear();
 	mTaskInEdges.clear();
 	for (auto solver : mSolvers) {
+		UInt multiple = solver->timeStepMultiple();
 		for (auto t : solver->getTasks()) {
+			if (multiple > 1)
+				t = std::make_shared<MultiRateTask>(t, multiple);
+			if (solver->threadHint() >= 0)
+				t->setThreadHint(solver->threadHint());
 			mTasks.push_back(t);
 		}
 	}
@@ -198,10 +852,42 @@ void Simulation::prepSchedule() {
 	for (auto logger : mLoggers) {
 		mTasks.push_back(logger->getTask());
 	}
+	if (mStepPhases) {
+		for (auto solver : mSolvers) {
+			for (auto t : solver->getTasks())
+				mStepPhases->setPhase(t.get(), StepPhases::phaseOfName(t->toString()));
+		}
+		for (auto intf : mInterfaces) {
+			for (auto t : intf->getTasks())
+				mStepPhases->setPhase(t.get(), StepPhases::Interfaces);
+		}
+		for (auto logger : mLoggers)
+			mStepPhases->setPhase(logger->getTask().get(), StepPhases::Logging);
+	}
+
 	if (!mScheduler) {
 		mScheduler = std::make_shared<SequentialScheduler>();
 	}
+	if (mExecutor && !mScheduler->executor())
+		mScheduler->setExecutor(mExecutor);
+	if (mTaskGraphCache)
+		mScheduler->setTaskGraphCache(mTaskGraphCache);
 	mScheduler->resolveDeps(mTasks, mTaskInEdges, mTaskOutEdges);
+	mScheduler->batchTasks(mTasks, mTaskInEdges, mTaskOutEdges);
+	mScheduler->fuseTasks(mTasks, mTaskInEdges, mTaskOutEdges);
+
+	if (mStepPhases) {
+		// Tasks created by the batching are assigned by name, fused tasks by their first task
+		auto phaseOf = [this](const Task::Ptr& task) {
+			auto phase = mStepPhases->phase(task.get());
+			return phase != StepPhases::Other ? phase : StepPhases::phaseOfName(task->toString());
+		};
+		for (auto& task : mTasks) {
+			auto fused = std::dynamic_pointer_cast<FusedTask>(task);
+			mStepPhases->setPhase(task.get(), fused ? phaseOf(fused->tasks().front()) : phaseOf(task));
+		}
+		mScheduler->setStepPhases(mStepPhases);
+	}
 }
 
 void Simulation::schedule() {
@@ -354,19 +1040,71 @@ void Simulation::stop() {
 	mSimulationEndTimePoint = std::chrono::steady_clock::now();
 	mSimulationCalculationTime = mSimulationEndTimePoint-mSimulationStartTimePoint;
 	SPDLOG_LOGGER_INFO(mLog, "Simulation calculation time: {:.6f}", mSimulationCalculationTime.count());
+	if (mAdaptiveTimeStep)
+		SPDLOG_LOGGER_INFO(mLog, "Adaptive time steps: {} steps, {} time step changes", mTimeStepCount, mAdaptiveTimeStep->changes());
+	mEvents.reportHandled(mLog);
+	if (mShiftFrequencySource.getPtr())
+		SPDLOG_LOGGER_INFO(mLog, "Shift frequency changes: {}, final shift frequency {:f}", mShiftFrequencyChanges, mShiftFrequency);
 
 	mScheduler->stop();
 
 	for (auto intf : mInterfaces)
 		intf->close();
 
-	for (auto lg : mLoggers)
-		lg->close();
+	closeLoggers();
 
 	SPDLOG_LOGGER_INFO(mLog, "Simulation finished.");
 	mLog->flush();
 }
 
+void Simulation::setupShardedLogging() {
+	mShardLoggers.clear();
+	DataLogger::List loggers = mLoggers;
+	for (auto solver : mSolvers) {
+		for (auto logger : solver->dataLoggers())
+			loggers.push_back(logger);
+	}
+
+	for (auto logger : loggers) {
+		if (!logger || !logger->isEnabled())
+			continue;
+		logger->setBackend(std::make_shared<BinaryLoggerBackend>());
+		logger->setAsync();
+		mShardLoggers.push_back(logger);
+	}
+	SPDLOG_LOGGER_INFO(mLog, "Logging to {} binary shards", mShardLoggers.size());
+}
+
+void Simulation::closeLoggers() {
+	for (auto lg : mLoggers)
+		lg->close();
+
+	if (mShardLoggers.empty())
+		return;
+
+	// Column layouts are known once the loggers are closed
+	fs::path indexFilename = CPS::Logger::logDir() + "/" + **mName + ".index";
+	std::ofstream index(indexFilename, std::ios_base::out|std::ios_base::trunc);
+	index << "column,shard,offset,stride\n";
+	for (auto logger : mShardLoggers) {
+		logger->close();
+		auto backend = std::dynamic_pointer_cast<BinaryLoggerBackend>(logger->backend());
+		// Skips loggers that never wrote a row
+		if (!backend || backend->dataOffset() == 0)
+			continue;
+
+		UInt columns = static_cast<UInt>(logger->columnNames().size()) + 1;
+		UInt offset = backend->dataOffset();
+		String shard = logger->filename().filename().string();
+		index << logger->name() << "/time," << shard << "," << offset << "," << columns * sizeof(Real) << "\n";
+		for (UInt i = 0; i < logger->columnNames().size(); ++i) {
+			index << logger->name() << "/" << logger->columnNames()[i] << "," << shard << ","
+				<< offset + (i + 1) * sizeof(Real) << "," << columns * sizeof(Real) << "\n";
+		}
+	}
+	SPDLOG_LOGGER_INFO(mLog, "Wrote index of the logger shards to {}", indexFilename.string());
+}
+
 Real Simulation::next() {
 	if (mTime < **mFinalTime)
 		step();
@@ -387,32 +1125,163 @@ void Simulation::run() {
 	stop();
 }
 
+Real Simulation::stepN(UInt count) {
+	for (UInt i = 0; i < count && mTime < **mFinalTime; ++i)
+		step();
+	return mTime;
+}
+
+Real Simulation::stepUntil(Real time) {
+	while (mTime < time && mTime < **mFinalTime)
+		step();
+	return mTime;
+}
+
+void Simulation::runAsync() {
+	if (mAsyncThread.joinable())
+		throw SystemError("Simulation " + **mName + " already has a background run.");
+
+	mAsyncCancel = false;
+	mAsyncError = nullptr;
+	mAsyncRunning = true;
+	mAsyncThread = std::thread([this]() {
+		try {
+			start();
+			while (mTime < **mFinalTime && !mAsyncCancel)
+				step();
+			stop();
+		}
+		catch (...) {
+			mAsyncError = std::current_exception();
+		}
+		mAsyncRunning = false;
+	});
+}
+
+void Simulation::waitAsync() {
+	if (mAsyncThread.joinable())
+		mAsyncThread.join();
+	if (mAsyncError) {
+		auto error = mAsyncError;
+		mAsyncError = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
 Real Simulation::step() {
 	auto start = std::chrono::steady_clock::now();
-	mEvents.handleEvents(mTime);
+	if (mEventLog)
+		mEventLog->setStep(mTime, mTimeStepCount);
+	{
+		StepPhases::Scope phase(mStepPhases.get(), StepPhases::Events);
+		mEvents.handleEvents(mTime);
+		if (mSwitchedMatrixPrefetch)
+			prefetchSwitchedMatrices();
+		if (!mProtectionRelays.empty())
+			speculateProtectionTrips();
+	}
 
-	mScheduler->step(mTime, mTimeStepCount);
+	if (!mEventInterpolation || !stepInterpolatedEvent()) {
+		mScheduler->step(mTime, mTimeStepCount);
+
+		if (mAdaptiveTimeStep)
+			advanceAdaptiveTimeStep();
+		else
+			mTime += **mTimeStep;
+	}
+	++mTimeStepCount;
+
+	if (mShiftFrequencySource.getPtr())
+		trackShiftFrequency();
+
+	auto end = std::chrono::steady_clock::now();
+	std::chrono::duration<double> diff = end-start;
+	mStepTimes.record(diff.count());
+	if (mStepPhases)
+		mStepPhases->finishStep();
+	return mTime;
+}
+
+void Simulation::stepBeforeBatchedSolve() {
+	auto scheduler = std::dynamic_pointer_cast<SequentialScheduler>(mScheduler);
+	if (!scheduler || !scheduler->hasSplitTask() || mEventInterpolation)
+		throw SystemError("Batched solves require a sequential scheduler and a direct MNA solver without system matrix recomputation or frequency parallelization, running at the simulation time step, and no event interpolation.");
+
+	auto start = std::chrono::steady_clock::now();
+	if (mEventLog)
+		mEventLog->setStep(mTime, mTimeStepCount);
+	{
+		StepPhases::Scope phase(mStepPhases.get(), StepPhases::Events);
+		mEvents.handleEvents(mTime);
+	}
+
+	scheduler->stepBeforeSplit(mTime, mTimeStepCount);
+
+	mSplitStepTime = std::chrono::steady_clock::now() - start;
+}
+
+Real Simulation::stepAfterBatchedSolve() {
+	auto start = std::chrono::steady_clock::now();
+	std::static_pointer_cast<SequentialScheduler>(mScheduler)->stepAfterSplit(mTime, mTimeStepCount);
 
 	mTime += **mTimeStep;
 	++mTimeStepCount;
 
 	auto end = std::chrono::steady_clock::now();
 	std::chrono::duration<double> diff = end-start;
-	mStepTimes.push_back(diff.count());
+	mStepTimes.record((diff + mSplitStepTime).count());
+	if (mStepPhases)
+		mStepPhases->finishStep();
 	return mTime;
 }
 
+MemoryReport Simulation::memoryReport() const {
+	MemoryReport report;
+	for (auto solver : mSolvers)
+		solver->reportMemory(report);
+
+	// Values of the attributes owned by the objects, derived attributes
+	// only reference them
+	auto attributeBytes = [](const IdentifiedObject::Ptr& obj) {
+		std::size_t bytes = 0;
+		for (auto& attr : obj->attributes()) {
+			if (attr.second->isStatic())
+				bytes += attr.second->serializedSize();
+		}
+		return bytes;
+	};
+	std::map<String, std::size_t> componentBytes;
+	for (auto comp : mSystem.mComponents)
+		componentBytes[comp->type()] += attributeBytes(comp);
+	for (auto& entry : componentBytes)
+		report.add("components", entry.first, entry.second);
+	std::size_t nodeBytes = 0;
+	for (auto node : mSystem.mNodes)
+		nodeBytes += attributeBytes(node);
+	report.add("nodes", "attributes", nodeBytes);
+
+	for (auto logger : mLoggers)
+		report.add("loggers", logger->filename().filename().string(), logger->memoryBytes());
+	for (UInt i = 0; i < mInterfaces.size(); ++i) {
+		auto& name = mInterfaces[i]->name();
+		report.add("interfaces", name.empty() ? std::to_string(i) : name, mInterfaces[i]->memoryBytes());
+	}
+	return report;
+}
+
 void Simulation::logStepTimes(String logName) {
 	auto stepTimeLog = Logger::get(logName, Logger::Level::info);
 	Logger::setLogPattern(stepTimeLog, "%v");
-	stepTimeLog->info("step_time");
-
-	Real stepTimeSum = 0;
-	for (auto meas : mStepTimes) {
-		stepTimeSum += meas;
-		stepTimeLog->info("{:f}", meas);
-	}
-	SPDLOG_LOGGER_INFO(mLog, "Average step time: {:.6f}", stepTimeSum / mStepTimes.size());
+	stepTimeLog->info("step_time,count");
+
+	for (auto bucket : mStepTimes.buckets())
+		stepTimeLog->info("{:.9f},{:d}", bucket.first, bucket.second);
+	mStepTimes.log(mLog, "Step time");
+	if (mStepPhases)
+		mStepPhases->log(mLog);
+	if (mEventLog)
+		mEventLog->record(EventLog::Type::Timing, EventLog::StepTime,
+			static_cast<double>(mStepTimes.count()), mStepTimes.mean(), mStepTimes.max());
 }
 
 void Simulation::logLUTimes() {
@@ -455,3 +1324,338 @@ void Simulation::logAttribute(String name, CPS::AttributeBase::Ptr attr) {
 		throw SystemError("Cannot log attributes when no logger is configured for this simulation!");
 	}
 }
+
+CPS::AttributeBase::Map Simulation::stateAttributes() {
+	CPS::AttributeBase::Map state;
+	// Objects are not required to have unique names, repeated names are numbered
+	std::map<String, UInt> occurrences;
+	auto uniqueKey = [&occurrences](const String& path) {
+		UInt count = ++occurrences[path];
+		return count > 1 ? path + "#" + std::to_string(count) : path;
+	};
+	auto addAttributes = [&state](const String& prefix, const CPS::AttributeBase::Map& attributes) {
+		for (auto& attr : attributes)
+			state[prefix + "." + attr.first] = attr.second;
+	};
+
+	std::function<void(const String&, IdentifiedObject::Ptr)> addComponent =
+		[&](const String& parent, IdentifiedObject::Ptr comp) {
+		String path = uniqueKey(parent + comp->name());
+		addAttributes(path, comp->attributes());
+
+		if (auto powerComp = std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp)) {
+			for (UInt i = 0; i < powerComp->virtualNodes().size(); ++i)
+				addAttributes(path + "/vnode" + std::to_string(i), powerComp->virtualNodes()[i]->attributes());
+			for (auto subComp : powerComp->subComponents())
+				addComponent(path + "/", subComp);
+		} else if (auto powerComp = std::dynamic_pointer_cast<SimPowerComp<Real>>(comp)) {
+			for (UInt i = 0; i < powerComp->virtualNodes().size(); ++i)
+				addAttributes(path + "/vnode" + std::to_string(i), powerComp->virtualNodes()[i]->attributes());
+			for (auto subComp : powerComp->subComponents())
+				addComponent(path + "/", subComp);
+		}
+	};
+
+	for (auto node : mSystem.mNodes)
+		addAttributes(uniqueKey("nodes/" + node->name()), node->attributes());
+	for (auto comp : mSystem.mComponents)
+		addComponent("components/", comp);
+	for (UInt i = 0; i < mSolvers.size(); ++i)
+		addAttributes("solvers/" + std::to_string(i), mSolvers[i]->stateAttributes());
+
+	return state;
+}
+
+Checkpoint Simulation::captureState() {
+	if (!mInitialized)
+		throw SystemError("Checkpoints can only be saved from an initialized simulation.");
+
+	Checkpoint checkpoint;
+	checkpoint.time = mTime;
+	checkpoint.timeStepCount = mTimeStepCount;
+	checkpoint.timeStep = **mTimeStep;
+	checkpoint.eventTimes = mEvents.pendingTimes();
+
+	UInt skipped = 0;
+	for (auto& attr : stateAttributes()) {
+		if (!checkpoint.capture(attr.first, attr.second))
+			++skipped;
+	}
+	SPDLOG_LOGGER_DEBUG(mLog, "Captured {} values at time {}, skipped {} dynamic or non-numeric attributes",
+		checkpoint.values.size(), mTime, skipped);
+	return checkpoint;
+}
+
+void Simulation::restoreState(const Checkpoint& state) {
+	if (mAsyncThread.joinable())
+		throw SystemError("The state of simulation " + **mName + " cannot be restored during a background run.");
+	if (!mInitialized)
+		initialize();
+	if (mAdaptiveTimeStep)
+		throw SystemError("The state of a simulation with adaptive time steps cannot be restored.");
+
+	UInt restored = 0;
+	for (auto& attr : stateAttributes()) {
+		if (state.restore(attr.first, attr.second))
+			++restored;
+	}
+	if (restored < state.values.size())
+		SPDLOG_LOGGER_WARN(mLog, "{} values of the state do not match an attribute of this simulation",
+			state.values.size() - restored);
+
+	for (auto solver : mSolvers)
+		solver->reset();
+
+	mTime = state.time;
+	mTimeStepCount = std::abs(state.timeStep - **mTimeStep) > 1e-12 * **mTimeStep
+		? static_cast<Int>(std::round(mTime / **mTimeStep)) : state.timeStepCount;
+	mPrefetchedEventTime = -1;
+
+	// Events up to the last step of the state have already been executed
+	mEvents.rewind();
+	mEvents.dropHandled(mTime - **mTimeStep);
+	if (mEvents.pendingTimes().size() != state.eventTimes.size())
+		SPDLOG_LOGGER_WARN(mLog, "The state has {} pending events, this simulation has {}",
+			state.eventTimes.size(), mEvents.pendingTimes().size());
+	mScheduler->restart(mTimeStepCount);
+
+	SPDLOG_LOGGER_DEBUG(mLog, "Restored {} values at time {}", restored, mTime);
+}
+
+Simulation::Ptr Simulation::fork(String name) {
+	if (!mInitialized)
+		throw SystemError("Only an initialized simulation can be forked.");
+	if (mAsyncThread.joinable())
+		throw SystemError("Simulation " + **mName + " cannot be forked during a background run.");
+	if (mAdaptiveTimeStep || mShiftFrequencySource.getPtr())
+		throw SystemError("Simulations with adaptive time steps or shift frequency tracking cannot be forked.");
+
+	Checkpoint state = captureState();
+	auto sim = std::make_shared<Simulation>(name.empty() ? **mName + "_fork" : name, mLogLevel);
+	sim->mSystem = mSystem.copy();
+
+	sim->mSolverPluginName = mSolverPluginName;
+	**sim->mFinalTime = **mFinalTime;
+	**sim->mTimeStep = **mTimeStep;
+	**sim->mSplitSubnets = **mSplitSubnets;
+	// The state is restored from this simulation
+	**sim->mSteadyStateInit = false;
+	sim->mDomain = mDomain;
+	sim->mSolverType = mSolverType;
+	sim->mSolverBehaviour = mSolverBehaviour;
+	sim->mDirectImpl = mDirectImpl;
+	sim->mDirectLinearSolverConfiguration = mDirectLinearSolverConfiguration;
+	sim->mExecutor = mExecutor;
+	sim->mTaskGraphCache = mTaskGraphCache;
+	sim->mEventInterpolation = mEventInterpolation;
+	sim->mSwitchedMatrixPrefetch = mSwitchedMatrixPrefetch;
+	sim->mSpeculativeFactorization = mSpeculativeFactorization;
+	sim->mInitFromNodesAndTerminals = mInitFromNodesAndTerminals;
+	sim->mSystemMatrixRecomputation = mSystemMatrixRecomputation;
+	sim->mSparseRightVectorAssembly = mSparseRightVectorAssembly;
+	sim->mLazySwitchedMatrices = mLazySwitchedMatrices;
+	sim->mSwitchedMatrixCacheSize = mSwitchedMatrixCacheSize;
+	sim->mSharedSymbolicAnalysis = mSharedSymbolicAnalysis;
+	sim->mLowRankSystemMatrixUpdates = mLowRankSystemMatrixUpdates;
+	sim->mLowRankUpdateMaxRank = mLowRankUpdateMaxRank;
+	sim->mIncrementalSystemMatrixStamping = mIncrementalSystemMatrixStamping;
+	sim->mIncrementalSolve = mIncrementalSolve;
+	sim->mIncrementalSolveMaxRows = mIncrementalSolveMaxRows;
+	sim->mKronReduction = mKronReduction;
+	sim->mSignalGraphFusion = mSignalGraphFusion;
+	sim->mGpuResidentStep = mGpuResidentStep;
+	sim->mGpuResidentCopyInterval = mGpuResidentCopyInterval;
+	sim->mStepGeneration = mStepGeneration;
+	sim->mBlockParallelSolve = mBlockParallelSolve;
+	sim->mMatrixNodeReordering = mMatrixNodeReordering;
+	sim->mMaxCorrectorIterations = mMaxCorrectorIterations;
+	sim->mParallelComponentInitialization = mParallelComponentInitialization;
+	sim->mParallelSwitchedMatrixInitialization = mParallelSwitchedMatrixInitialization;
+	sim->mAttributeFreezing = mAttributeFreezing;
+	sim->mAttributeArena = mAttributeArena;
+	sim->mObjectPooling = mObjectPooling;
+	sim->mObjectPool = mObjectPool;
+	sim->mPowerFlowWarmStart = mPowerFlowWarmStart;
+	sim->mPowerFlowJacobianReuse = mPowerFlowJacobianReuse;
+	sim->mLimLatencyFactor = mLimLatencyFactor;
+	sim->mImplicitODEIntegration = mImplicitODEIntegration;
+	sim->mODELinearSolver = mODELinearSolver;
+	sim->mParallelDAEResidual = mParallelDAEResidual;
+	sim->mAggregatedODEIntegration = mAggregatedODEIntegration;
+	sim->mQuasiDynamic = mQuasiDynamic;
+	// Lines were already decoupled and components torn in the copied topology
+	sim->mTimeStepMultiples = mTimeStepMultiples;
+	sim->mDefaultTimeStepMultiple = mDefaultTimeStepMultiple;
+	sim->mFreqParallel = mFreqParallel;
+	sim->mHarmonicDropTolerance = mHarmonicDropTolerance;
+	sim->mSensitivityParameters = mSensitivityParameters;
+	for (auto comp : mTearComponents) {
+		IdentifiedObject::Ptr copy;
+		for (auto components : { &sim->mSystem.mComponents, &sim->mSystem.mTearComponents }) {
+			for (auto candidate : *components) {
+				if (candidate->name() == comp->name())
+					copy = candidate;
+			}
+		}
+		if (!copy)
+			throw SystemError("Tear component " + comp->name() + " was not copied.");
+		sim->mTearComponents.push_back(copy);
+	}
+
+	sim->initialize();
+	sim->restoreState(state);
+	SPDLOG_LOGGER_INFO(mLog, "Forked simulation {} at time {}", **sim->mName, mTime);
+	return sim;
+}
+
+void Simulation::observeNodes(const std::vector<String>& names) {
+	if (mInitialized)
+		throw SystemError("Observed nodes have to be set before the initialization.");
+
+	mObservedNodes.clear();
+	UInt rows = 0;
+	for (auto& name : names) {
+		auto node = std::find_if(mSystem.mNodes.begin(), mSystem.mNodes.end(),
+			[&name](const TopologicalNode::Ptr& node) { return node->name() == name; });
+		if (node == mSystem.mNodes.end())
+			throw SystemError("Observed node " + name + " is not part of the system.");
+		mObservedNodes.emplace_back(name, rows);
+		UInt phases = (*node)->phaseType() == PhaseType::ABC ? 3 : 1;
+		rows += std::dynamic_pointer_cast<SimNode<Complex>>(*node) ? 2 * phases : phases;
+	}
+	// The size is fixed now, so that the values can be exported before the initialization
+	**mObservedValues = Matrix::Zero(rows, 1);
+	SPDLOG_LOGGER_INFO(mLog, "Observe {} nodes with {} values", mObservedNodes.size(), rows);
+}
+
+void Simulation::editTopology(const IdentifiedObject::List& added, const std::vector<String>& removed) {
+	if (!mInitialized)
+		throw SystemError("Topology edits require an initialized simulation, the system can be changed directly before.");
+	if (mAsyncThread.joinable())
+		throw SystemError("The topology of simulation " + **mName + " cannot be edited during a background run.");
+	if (mAdaptiveTimeStep || mShiftFrequencySource.getPtr())
+		throw SystemError("Simulations with adaptive time steps or shift frequency tracking do not support topology edits.");
+	if (mSolvers.size() != 1 || !mSolvers[0]->supportsTopologyEdits())
+		throw SystemError("Topology edits require a single solver that supports them.");
+
+	IdentifiedObject::List removedComps;
+	for (auto& name : removed) {
+		auto it = std::find_if(mSystem.mComponents.begin(), mSystem.mComponents.end(),
+			[&name](const IdentifiedObject::Ptr& comp) { return comp->name() == name; });
+		if (it == mSystem.mComponents.end())
+			throw SystemError("Component " + name + " is not part of simulation " + **mName);
+		removedComps.push_back(*it);
+		mSystem.removeComponent(*it);
+	}
+	for (auto comp : added) {
+		mSystem.addComponent(comp);
+		if (auto powerComp = std::dynamic_pointer_cast<TopologicalPowerComp>(comp)) {
+			for (auto node : powerComp->topologicalNodes())
+				mSystem.mComponentsAtNode[node].push_back(powerComp);
+		}
+	}
+
+	mSolvers[0]->editTopology(added, removedComps);
+	collectProtectionRelays();
+
+	prepSchedule();
+	mScheduler->recreateSchedule(mTasks, mTaskInEdges, mTaskOutEdges, mTimeStepCount);
+	if (mAttributeFreezing)
+		freezeAttributes();
+	SPDLOG_LOGGER_INFO(mLog, "Edited topology at time {}: removed {} and added {} components",
+		mTime, removedComps.size(), added.size());
+}
+
+void Simulation::saveCheckpoint(const fs::path& filename) {
+	Checkpoint checkpoint = captureState();
+	checkpoint.save(filename);
+
+	SPDLOG_LOGGER_INFO(mLog, "Saved {} values at time {} to checkpoint {}",
+		checkpoint.values.size(), mTime, filename.string());
+}
+
+void Simulation::reset(Real startTime, const std::map<String, Real>& parameters) {
+	if (mAsyncThread.joinable())
+		throw SystemError("Simulation " + **mName + " cannot be reset during a background run.");
+	if (!mInitialized)
+		initialize();
+	if (mAdaptiveTimeStep || mShiftFrequencySource.getPtr())
+		throw SystemError("Simulations with adaptive time steps or shift frequency tracking cannot be reset.");
+
+	// The initial values of the previous parameters are restored, so their stamps change as well
+	std::set<String> changedKeys;
+	for (auto& param : mParameterOverrides)
+		changedKeys.insert(param.first);
+	for (auto& param : parameters) {
+		auto attr = mInitialStateAttributes.find(param.first);
+		if (attr == mInitialStateAttributes.end() || !std::dynamic_pointer_cast<CPS::Attribute<Real>>(attr->second.getPtr()))
+			throw SystemError("Parameter " + param.first + " is not a real state attribute of simulation " + **mName);
+		changedKeys.insert(param.first);
+	}
+
+	IdentifiedObject::List changedComps;
+	for (auto comp : mSystem.mComponents) {
+		for (auto& key : changedKeys) {
+			if (isComponentKey(comp->name(), key)) {
+				changedComps.push_back(comp);
+				break;
+			}
+		}
+	}
+	for (auto solver : mSolvers) {
+		if (!changedComps.empty() && !solver->supportsParameterChange())
+			throw SystemError("The solvers of simulation " + **mName + " do not support parameter changes.");
+	}
+	for (auto solver : mSolvers) {
+		if (!changedComps.empty())
+			solver->beginParameterChange(changedComps);
+	}
+
+	for (auto& attr : mInitialStateAttributes)
+		mInitialState.restore(attr.first, attr.second);
+	for (auto& param : parameters)
+		std::dynamic_pointer_cast<CPS::Attribute<Real>>(mInitialStateAttributes.at(param.first).getPtr())->set(param.second);
+	mParameterOverrides = parameters;
+
+	for (auto solver : mSolvers) {
+		if (!changedComps.empty())
+			solver->finishParameterChange();
+		solver->reset();
+	}
+
+	mTime = startTime;
+	mTimeStepCount = static_cast<Int>(std::round(startTime / **mTimeStep));
+	mPrefetchedEventTime = -1;
+	mEvents.rewind();
+	mEvents.dropHandled(startTime - **mTimeStep);
+	mStepTimes.reset();
+	mScheduler->restart(mTimeStepCount);
+	reopenLoggers();
+
+	SPDLOG_LOGGER_INFO(mLog, "Reset to time {} with {} parameters, {} components changed their stamps",
+		mTime, parameters.size(), changedComps.size());
+}
+
+void Simulation::reopenLoggers() {
+	DataLogger::List loggers = mLoggers;
+	for (auto solver : mSolvers) {
+		for (auto logger : solver->dataLoggers())
+			loggers.push_back(logger);
+	}
+	for (auto logger : loggers) {
+		if (logger && logger->isEnabled())
+			logger->reopen();
+	}
+}
+
+void Simulation::loadCheckpoint(const fs::path& filename) {
+	if (!mInitialized)
+		initialize();
+
+	Checkpoint checkpoint = Checkpoint::load(filename);
+	if (std::abs(checkpoint.timeStep - **mTimeStep) > 1e-12 * **mTimeStep)
+		throw SystemError("Checkpoint " + filename.string() + " was saved with a different time step.");
+
+	restoreState(checkpoint);
+	SPDLOG_LOGGER_INFO(mLog, "Restored {} values at time {} from checkpoint {}", checkpoint.values.size(), mTime, filename.string());
+}
@@ -10,6 +10,14 @@ int example_solve(double *rhs_values,
 				  double *lhs_values);
 void example_log(const char *str);
 void example_cleanup(void);
+int example_init_v2(struct dpsim_csr_matrix *matrix,
+				  const struct dpsim_matrix_entry *variable_entries,
+				  int variable_entry_number);
+int example_refactor(struct dpsim_csr_matrix *matrix);
+int example_partial_refactor(struct dpsim_csr_matrix *matrix);
+int example_solve_in_place(const double *rhs_values,
+				  double *lhs_values,
+				  int rhs_number);
 
 static const char* PLUGIN_NAME = "plugin.so";
 static struct dpsim_mna_plugin example_plugin = {
@@ -29,6 +37,26 @@ struct dpsim_mna_plugin *get_mna_plugin(const char *name)
     return &example_plugin;
 }
 
+static struct dpsim_mna_plugin_v2 example_plugin_v2 = {
+	.abi_version = DPSIM_MNA_PLUGIN_ABI_VERSION,
+	.log = example_log,
+	.init = example_init_v2,
+	.lu_decomp = example_decomp,
+	.refactor = example_refactor,
+	.partial_refactor = example_partial_refactor,
+	.solve_in_place = example_solve_in_place,
+	.cleanup = example_cleanup,
+};
+
+struct dpsim_mna_plugin_v2 *get_mna_plugin_v2(const char *name)
+{
+    if (name == NULL || strcmp(name, PLUGIN_NAME) != 0) {
+        printf("error: name mismatch\n");
+        return NULL;
+    }
+    return &example_plugin_v2;
+}
+
 
 int example_init(struct dpsim_csr_matrix *matrix)
 {
@@ -49,6 +77,33 @@ int example_solve(double *rhs_values,
     return 0;
 }
 
+int example_init_v2(struct dpsim_csr_matrix *matrix,
+				  const struct dpsim_matrix_entry *variable_entries,
+				  int variable_entry_number)
+{
+    example_plugin_v2.log("initialize v2");
+    return 0;
+}
+
+int example_refactor(struct dpsim_csr_matrix *matrix)
+{
+    example_plugin_v2.log("refactor");
+    return 0;
+}
+
+int example_partial_refactor(struct dpsim_csr_matrix *matrix)
+{
+    example_plugin_v2.log("partial refactor");
+    return 0;
+}
+
+int example_solve_in_place(const double *rhs_values,
+				  double *lhs_values,
+				  int rhs_number)
+{
+    example_plugin_v2.log("solve in place");
+    return 0;
+}
 
 void example_cleanup(void)
 {
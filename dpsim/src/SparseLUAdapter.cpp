@@ -7,6 +7,7 @@
  *********************************************************************************/
 
 #include <dpsim/SparseLUAdapter.h>
+#include <dpsim/MemoryReport.h>
 
 using namespace DPsim;
 
@@ -14,30 +15,86 @@ namespace DPsim
 {
     SparseLUAdapter::~SparseLUAdapter() = default;
 
+    void SparseLUAdapter::applyConfiguration()
+    {
+        mMixedPrecision = mConfiguration.getFactorizationPrecision() == FACTORIZATION_PRECISION::MIXED;
+        SPDLOG_LOGGER_INFO(mSLog, "Sparse LU " + mConfiguration.getFactorizationPrecisionString());
+    }
+
     void SparseLUAdapter::preprocessing(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
     {
-        LUFactorizedSparse.analyzePattern(systemMatrix);
+        if (mMixedPrecision)
+            mLowPrecisionLU.analyzePattern(systemMatrix.cast<float>());
+        else
+            LUFactorizedSparse.analyzePattern(systemMatrix);
+    }
+
+    void SparseLUAdapter::compute(SparseMatrix& systemMatrix)
+    {
+        if (mMixedPrecision) {
+            mSystemMatrix = systemMatrix;
+            mLowPrecisionLU.factorize(systemMatrix.cast<float>());
+            mUseDoubleFactorization = false;
+        } else {
+            LUFactorizedSparse.factorize(systemMatrix);
+        }
+        mFactorized = true;
     }
 
     void SparseLUAdapter::factorize(SparseMatrix& systemMatrix)
     {
-        LUFactorizedSparse.factorize(systemMatrix);
+        compute(systemMatrix);
     }
 
     void SparseLUAdapter::refactorize(SparseMatrix& systemMatrix)
     {
 		/* Eigen's SparseLU does not use refactorization. Use regular factorization (numerical factorization and partial pivoting) here */
-        LUFactorizedSparse.factorize(systemMatrix);
+        compute(systemMatrix);
     }
 
     void SparseLUAdapter::partialRefactorize(SparseMatrix& systemMatrix, std::vector<std::pair<UInt, UInt>>& listVariableSystemMatrixEntries)
     {
 		/* Eigen's SparseLU does not use refactorization. Use regular factorization (numerical factorization and partial pivoting) here */
-        LUFactorizedSparse.factorize(systemMatrix);
+        compute(systemMatrix);
     }
 
     Matrix SparseLUAdapter::solve(Matrix& mRightHandSideVector)
     {
-        return LUFactorizedSparse.solve(mRightHandSideVector);
+        Matrix leftSideVector;
+        solveInPlace(mRightHandSideVector, leftSideVector);
+        return leftSideVector;
+    }
+
+    void SparseLUAdapter::solveInPlace(const Matrix& rightSideVector, Matrix& leftSideVector)
+    {
+        if (!mMixedPrecision || mUseDoubleFactorization) {
+            leftSideVector = LUFactorizedSparse.solve(rightSideVector);
+            return;
+        }
+
+        leftSideVector = mLowPrecisionLU.solve(Eigen::MatrixXf(rightSideVector.cast<float>())).cast<Real>();
+        auto correctionSolve = [this](const Matrix& residual) -> Matrix {
+            return mLowPrecisionLU.solve(Eigen::MatrixXf(residual.cast<float>())).cast<Real>();
+        };
+        if (!refineSolution(mSystemMatrix, rightSideVector, leftSideVector, correctionSolve)) {
+            SPDLOG_LOGGER_WARN(mSLog, "Mixed precision refinement did not converge, falling back to a double precision factorization");
+            LUFactorizedSparse.analyzePattern(mSystemMatrix);
+            LUFactorizedSparse.factorize(mSystemMatrix);
+            mUseDoubleFactorization = true;
+            leftSideVector = LUFactorizedSparse.solve(rightSideVector);
+        }
+    }
+
+    std::size_t SparseLUAdapter::memoryBytes() const
+    {
+        std::size_t bytes = MemoryReport::sparseBytes(mSystemMatrix);
+        if (!mFactorized)
+            return bytes;
+        // The supernodal factors hold a value and a row index per nonzero
+        if (mMixedPrecision)
+            bytes += static_cast<std::size_t>(mLowPrecisionLU.nnzL() + mLowPrecisionLU.nnzU()) * (sizeof(float) + sizeof(int));
+        if (!mMixedPrecision || mUseDoubleFactorization)
+            bytes += static_cast<std::size_t>(LUFactorizedSparse.nnzL() + LUFactorizedSparse.nnzU()) * (sizeof(Real) + sizeof(int));
+        return bytes;
     }
 }
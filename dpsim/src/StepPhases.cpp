@@ -0,0 +1,72 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/StepPhases.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+StepPhases::StepPhases() {
+	for (UInt phase = 0; phase < NumPhases; phase++) {
+		mCurrent[phase].store(0, std::memory_order_relaxed);
+		mTimes[phase] = create<Real>(name(phase), 0);
+	}
+}
+
+const char* StepPhases::name(UInt phase) {
+	static const char* names[NumPhases] = {
+		"events", "pre_step", "right_side", "recomputation", "solve", "node_update",
+		"post_step", "logging", "interfaces", "other"
+	};
+	return phase < NumPhases ? names[phase] : "";
+}
+
+StepPhases::Phase StepPhases::phaseOfName(const String& name) {
+	String type = name.substr(name.find_last_of('.') + 1);
+	if (type.find("PreStep") != String::npos)
+		return PreStep;
+	if (type.find("PostStep") != String::npos)
+		return PostStep;
+	if (type.find("Solve") != String::npos)
+		return Solve;
+	if (type == "Log")
+		return Logging;
+	return Other;
+}
+
+void StepPhases::finishStep() {
+	std::array<uint64_t, NumPhases> ns;
+	for (UInt phase = 0; phase < NumPhases; phase++)
+		ns[phase] = mCurrent[phase].exchange(0, std::memory_order_relaxed);
+
+	// The solver phases are measured within the solve tasks
+	uint64_t solverPhases = ns[RightSide] + ns[Recomputation] + ns[NodeUpdate];
+	ns[Solve] = ns[Solve] > solverPhases ? ns[Solve] - solverPhases : 0;
+
+	for (UInt phase = 0; phase < NumPhases; phase++) {
+		Real seconds = static_cast<Real>(ns[phase]) * 1e-9;
+		mTimes[phase]->set(seconds);
+		mHistograms[phase].record(seconds);
+	}
+}
+
+void StepPhases::reset() {
+	for (UInt phase = 0; phase < NumPhases; phase++) {
+		mCurrent[phase].store(0, std::memory_order_relaxed);
+		mHistograms[phase].reset();
+		mTimes[phase]->set(0);
+	}
+	mTaskPhases.clear();
+}
+
+void StepPhases::log(Logger::Log log) const {
+	for (UInt phase = 0; phase < NumPhases; phase++) {
+		if (mHistograms[phase].sum() > 0)
+			mHistograms[phase].log(log, String("Step phase ") + name(phase));
+	}
+}
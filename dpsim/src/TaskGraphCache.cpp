@@ -0,0 +1,154 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+#include <dpsim/TaskGraphCache.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+namespace {
+	template <typename T>
+	void writeValue(std::ofstream& file, const T& value) {
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	Bool readValue(std::ifstream& file, T& value) {
+		return static_cast<Bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+}
+
+TaskGraphCache::TaskGraphCache(const fs::path& directory) : mDirectory(directory) {
+	if (!mDirectory.empty())
+		fs::create_directories(mDirectory);
+}
+
+uint64_t TaskGraphCache::hash(const Task::List& tasks) {
+	// 64 bit FNV-1a
+	const uint64_t prime = 0x100000001b3;
+	uint64_t hash = 0xcbf29ce484222325;
+	auto update = [&hash, prime](const void* data, std::size_t size) {
+		auto bytes = static_cast<const unsigned char*>(data);
+		for (std::size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= prime;
+		}
+	};
+
+	// The attributes are numbered by their first appearance, so the hash covers
+	// which tasks share attributes and how the references of the dynamic
+	// attributes are wired, not only the names of the tasks
+	std::unordered_map<AttributeBase*, uint64_t> ids;
+	std::vector<AttributeBase*> attributes;
+	auto attributeId = [&ids, &attributes](const AttributeBase::Ptr& attr) {
+		auto result = ids.emplace(attr.getPtr().get(), static_cast<uint64_t>(ids.size()));
+		if (result.second)
+			attributes.push_back(attr.getPtr().get());
+		return result.first->second;
+	};
+	auto updateList = [&](const AttributeBase::List& list) {
+		uint64_t count = list.size();
+		update(&count, sizeof(count));
+		for (auto& attr : list) {
+			uint64_t id = attributeId(attr);
+			update(&id, sizeof(id));
+		}
+	};
+
+	for (auto& task : tasks) {
+		String name = task->toString();
+		uint64_t size = name.size();
+		update(&size, sizeof(size));
+		update(name.data(), name.size());
+		updateList(task->getAttributeDependencies());
+		updateList(task->getModifiedAttributes());
+		updateList(task->getPrevStepDependencies());
+	}
+
+	// Direct dependencies of every attribute reached, including the ones only
+	// reached through references, the external attribute is a nullptr
+	AttributeBase::List directDeps;
+	for (std::size_t idx = 0; idx < attributes.size(); ++idx) {
+		directDeps.clear();
+		if (attributes[idx] != nullptr)
+			attributes[idx]->appendDirectDependencies(directDeps);
+		updateList(directDeps);
+	}
+	return hash;
+}
+
+fs::path TaskGraphCache::filename(uint64_t hash) const {
+	std::ostringstream name;
+	name << std::hex << std::setw(16) << std::setfill('0') << hash << ".taskgraph";
+	return mDirectory / name.str();
+}
+
+Bool TaskGraphCache::lookup(uint64_t hash, Graph& graph) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto search = mGraphs.find(hash);
+	if (search != mGraphs.end()) {
+		graph = search->second;
+		++mHits;
+		return true;
+	}
+
+	if (!mDirectory.empty()) {
+		std::ifstream file(filename(hash), std::ios_base::in|std::ios_base::binary);
+		char magic[8];
+		uint32_t version = 0, numTasks = 0, numEdges = 0;
+		uint64_t fileHash = 0;
+		if (file.is_open() && file.read(magic, 8) && std::memcmp(magic, "DPSIMTGC", 8) == 0
+			&& readValue(file, version) && version == Version
+			&& readValue(file, fileHash) && fileHash == hash
+			&& readValue(file, numTasks) && readValue(file, numEdges)) {
+			Graph fileGraph;
+			fileGraph.numTasks = numTasks;
+			fileGraph.edges.resize(numEdges);
+			Bool complete = true;
+			for (auto& edge : fileGraph.edges)
+				complete = complete && readValue(file, edge.first) && readValue(file, edge.second)
+					&& edge.first < numTasks && edge.second < numTasks;
+			if (complete) {
+				graph = mGraphs[hash] = std::move(fileGraph);
+				++mHits;
+				return true;
+			}
+		}
+	}
+
+	++mMisses;
+	return false;
+}
+
+void TaskGraphCache::store(uint64_t hash, const Graph& graph) {
+	std::lock_guard<std::mutex> lock(mMutex);
+	mGraphs[hash] = graph;
+	if (mDirectory.empty())
+		return;
+
+	std::ofstream file(filename(hash), std::ios_base::out|std::ios_base::trunc|std::ios_base::binary);
+	if (!file.is_open())
+		throw SystemError("Cannot open task graph cache file " + filename(hash).string());
+	file.write("DPSIMTGC", 8);
+	writeValue<uint32_t>(file, Version);
+	writeValue<uint64_t>(file, hash);
+	writeValue<uint32_t>(file, static_cast<uint32_t>(graph.numTasks));
+	writeValue<uint32_t>(file, static_cast<uint32_t>(graph.edges.size()));
+	for (auto& edge : graph.edges) {
+		writeValue<uint32_t>(file, edge.first);
+		writeValue<uint32_t>(file, edge.second);
+	}
+	if (!file)
+		throw SystemError("Cannot write task graph cache file " + filename(hash).string());
+}
@@ -15,8 +15,8 @@
 using namespace CPS;
 using namespace DPsim;
 
-ThreadLevelScheduler::ThreadLevelScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariable, Bool sortTaskTypes) :
-	ThreadScheduler(threads, outMeasurementFile, useConditionVariable), mInMeasurementFile(inMeasurementFile), mSortTaskTypes(sortTaskTypes) {
+ThreadLevelScheduler::ThreadLevelScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariable, Bool sortTaskTypes, Bool useAdaptiveWait) :
+	ThreadScheduler(threads, outMeasurementFile, useConditionVariable, useAdaptiveWait), mInMeasurementFile(inMeasurementFile), mSortTaskTypes(sortTaskTypes) {
 }
 
 void ThreadLevelScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
@@ -28,6 +28,26 @@ void ThreadLevelScheduler::createSchedule(const Task::List& tasks, const Edges&
 
 	Scheduler::levelSchedule(ordered, inEdges, outEdges, levels);
 
+	if (mLatencyFirst) {
+		// Schedule all levels of the critical tasks before all levels of the
+		// others. Critical tasks only depend on critical tasks, so the order of
+		// each thread remains consistent with the dependencies.
+		auto critical = criticalTasks(ordered, inEdges);
+		std::vector<Task::List> splitLevels;
+		for (Bool pass : {true, false}) {
+			for (auto& level : levels) {
+				Task::List part;
+				for (auto task : level) {
+					if ((critical.count(task) > 0) == pass)
+						part.push_back(task);
+				}
+				if (!part.empty())
+					splitLevels.push_back(part);
+			}
+		}
+		levels = splitLevels;
+	}
+
 	if (!mInMeasurementFile.empty()) {
 		std::unordered_map<String, TaskTime::rep> measurements;
 		readMeasurements(mInMeasurementFile, measurements);
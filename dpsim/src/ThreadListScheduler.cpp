@@ -13,45 +13,41 @@
 using namespace CPS;
 using namespace DPsim;
 
-ThreadListScheduler::ThreadListScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariables) :
-	ThreadScheduler(threads, outMeasurementFile, useConditionVariables), mInMeasurementFile(inMeasurementFile) {
+ThreadListScheduler::ThreadListScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariables, Bool useAdaptiveWait) :
+	ThreadScheduler(threads, outMeasurementFile, useConditionVariables, useAdaptiveWait), mInMeasurementFile(inMeasurementFile) {
 }
 
 void ThreadListScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
-	Task::List ordered;
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, mOrdered);
+	Scheduler::initMeasurements(mOrdered);
+	mInEdges = inEdges;
+	mOutEdges = outEdges;
 
-	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
-	Scheduler::initMeasurements(ordered);
-
-	std::unordered_map<Task::Ptr, int64_t> priorities;
 	std::unordered_map<String, TaskTime::rep> measurements;
-	if (!mInMeasurementFile.empty()) {
-		readMeasurements(mInMeasurementFile, measurements);
+	readTaskCosts(mInMeasurementFile, mOrdered, measurements);
 
-		// Check that measurements map is complete
-		for (auto task : ordered) {
-			if (measurements.find(task->toString()) == measurements.end())
-				throw SchedulingException();
-		}
-	} else {
-		// Insert constant cost for each task (HLFNET)
-		for (auto task : ordered) {
-			measurements[task->toString()] = 1;
-		}
-	}
+	listSchedule(measurements, 0);
+}
+
+void ThreadListScheduler::listSchedule(const std::unordered_map<String, TaskTime::rep>& measurements, Int nextTimeStepCount) {
+	const Task::List& ordered = mOrdered;
+	const Edges& inEdges = mInEdges;
+	const Edges& outEdges = mOutEdges;
+
+	std::unordered_map<Task::Ptr, int64_t> priorities;
 
 	// HLFET
-	for (auto it = ordered.rbegin(); it != ordered.rend(); ++it) {
-		auto task = *it;
-		int64_t maxLevel = 0;
-		if (outEdges.find(task) != outEdges.end()) {
-			for (auto dep : outEdges.at(task)) {
-				if (priorities[dep] > maxLevel) {
-					maxLevel = priorities[dep];
-				}
-			}
-		}
-		priorities[task] = measurements.at(task->toString()) + maxLevel;
+	hlfetPriorities(ordered, outEdges, measurements, priorities);
+
+	if (mLatencyFirst) {
+		// Lift the critical tasks above all others, so that each of them is
+		// scheduled as soon as it is ready. Their dependencies are critical as
+		// well, so they form a prefix of the schedule.
+		int64_t maxPriority = 0;
+		for (auto& entry : priorities)
+			maxPriority = std::max(maxPriority, entry.second);
+		for (auto task : criticalTasks(ordered, inEdges))
+			priorities[task] += maxPriority + 1;
 	}
 
 	auto cmp = [&priorities](const Task::Ptr& p1, const Task::Ptr& p2) -> bool {
@@ -92,5 +88,27 @@ void ThreadListScheduler::createSchedule(const Task::List& tasks, const Edges& i
 		}
 	}
 
-	ThreadScheduler::finishSchedule(inEdges);
+	ThreadScheduler::finishSchedule(inEdges, nextTimeStepCount);
+}
+
+void ThreadListScheduler::doAdaptiveRescheduling(UInt interval, Real smoothing) {
+	mRescheduleInterval = interval;
+	mStepsSinceSchedule = 0;
+	setMeasurementSmoothing(interval > 0 ? smoothing : 0);
+	mMeasureTasks = interval > 0 || !mOutMeasurementFile.empty();
+}
+
+void ThreadListScheduler::step(Real time, Int timeStepCount) {
+	if (mRescheduleInterval > 0 && ++mStepsSinceSchedule > mRescheduleInterval) {
+		// All threads wait at the start barrier, so the schedule can be swapped
+		std::unordered_map<String, TaskTime::rep> measurements;
+		for (auto task : mOrdered)
+			measurements[task->toString()] = std::max<TaskTime::rep>(getAveragedMeasurement(task).count(), 1);
+
+		ThreadScheduler::clearSchedule();
+		listSchedule(measurements, timeStepCount);
+		mStepsSinceSchedule = 1;
+		SPDLOG_LOGGER_DEBUG(mSLog, "Recomputed schedule from measurements at step {}", timeStepCount);
+	}
+	ThreadScheduler::step(time, timeStepCount);
 }
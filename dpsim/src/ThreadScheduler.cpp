@@ -6,17 +6,30 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <dpsim/Config.h>
 #include <dpsim/ThreadScheduler.h>
 
 #include <iostream>
+#include <set>
+#include <unordered_map>
+
+#ifdef WITH_RT
+  #include <pthread.h>
+  #include <sched.h>
+#endif
 
 using namespace CPS;
 using namespace DPsim;
 
-ThreadScheduler::ThreadScheduler(Int threads, String outMeasurementFile, Bool useConditionVariable) :
-	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile), mStartBarrier(threads, useConditionVariable) {
+ThreadScheduler::ThreadScheduler(Int threads, String outMeasurementFile, Bool useConditionVariable, Bool useAdaptiveWait) :
+	mNumThreads(threads), mMeasureTasks(!outMeasurementFile.empty()), mUseAdaptiveWait(useAdaptiveWait), mOutMeasurementFile(outMeasurementFile),
+	mStartBarrier(threads, useConditionVariable, useAdaptiveWait), mInitBarrier(threads, useConditionVariable, useAdaptiveWait),
+	mStartedSteps(std::make_unique<Counter[]>(threads)), mPipelineEnd(-1) {
 	if (threads < 1)
 		throw SchedulingException();
+	mPublishedSteps.setAdaptiveWait(useAdaptiveWait);
+	for (Int i = 0; i < threads; i++)
+		mStartedSteps[i].setAdaptiveWait(useAdaptiveWait);
 	mTempSchedules.resize(threads);
 	mSchedules.resize(threads, nullptr);
 }
@@ -26,11 +39,118 @@ ThreadScheduler::~ThreadScheduler() {
 		delete[] mSchedules[i];
 }
 
+void ThreadScheduler::setRealTimeThreads(const std::vector<Int>& cpus, Int priority, Bool firstTouch) {
+	if (!mThreads.empty()) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Real-time options must be set before the threads are started");
+		throw SchedulingException();
+	}
+#ifndef WITH_RT
+	SPDLOG_LOGGER_ERROR(mSLog, "Real-time threads require DPsim to be built with WITH_RT");
+	throw SchedulingException();
+#endif
+	mCpus = cpus;
+	mPriority = priority;
+	mFirstTouch = firstTouch;
+}
+
+void ThreadScheduler::doPipelining(Bool pipelining) {
+	if (!mThreads.empty()) {
+		SPDLOG_LOGGER_ERROR(mSLog, "Pipelining must be set before the threads are started");
+		throw SchedulingException();
+	}
+	mPipelined = pipelining;
+}
+
+Bool ThreadScheduler::pinThread(Int idx) {
+	// CPUs set by setRealTimeThreads take precedence over the cores of the executor
+	if (mExecutor && mCpus.empty()) {
+		mExecutor->pin(idx);
+		return true;
+	}
+
+#ifdef WITH_RT
+	if (!mCpus.empty()) {
+		Int cpu = mCpus[idx % mCpus.size()];
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(cpu, &cpuSet);
+		if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0)
+			return true;
+		SPDLOG_LOGGER_WARN(mSLog, "Failed to pin thread {} to CPU {}", idx, cpu);
+	}
+#endif
+	return false;
+}
+
+void ThreadScheduler::initThread(Int idx) {
+	pinThread(idx);
+
+#ifdef WITH_RT
+	if (mPriority > 0) {
+		sched_param param = {};
+		param.sched_priority = mPriority;
+		if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0)
+			SPDLOG_LOGGER_WARN(mSLog, "Failed to set SCHED_FIFO priority {} of thread {}", mPriority, idx);
+	}
+#endif
+
+	if (mFirstTouch && !mSchedules[idx])
+		mSchedules[idx] = new ScheduleEntry[mTempSchedules[idx].size()];
+}
+
 void ThreadScheduler::scheduleTask(int thread, CPS::Task::Ptr task) {
+	// Keeping the appending order keeps the order of every thread topological
+	if (task->threadHint() >= 0)
+		thread = task->threadHint() % mNumThreads;
 	mTempSchedules[thread].push_back(task);
 }
 
-void ThreadScheduler::finishSchedule(const Edges& inEdges) {
+std::unordered_set<CPS::Task::Ptr> ThreadScheduler::criticalTasks(const Task::List& tasks, const Edges& inEdges) {
+	std::unordered_set<Task::Ptr> critical;
+	Task::List stack;
+	for (auto task : tasks) {
+		if (task->latencyCritical() && critical.insert(task).second)
+			stack.push_back(task);
+	}
+	while (!stack.empty()) {
+		auto task = stack.back();
+		stack.pop_back();
+		auto it = inEdges.find(task);
+		if (it == inEdges.end())
+			continue;
+		for (auto dep : it->second) {
+			if (critical.insert(dep).second)
+				stack.push_back(dep);
+		}
+	}
+	return critical;
+}
+
+void ThreadScheduler::clearSchedule() {
+	if (mPipelined)
+		drainPipeline();
+	for (int i = 0; i < mNumThreads; i++) {
+		delete[] mSchedules[i];
+		mSchedules[i] = nullptr;
+		mTempSchedules[i].clear();
+	}
+}
+
+void ThreadScheduler::startThreads(Int nextTimeStepCount) {
+	mPublishedSteps.set(nextTimeStepCount);
+	for (int i = 0; i < mNumThreads; i++)
+		mStartedSteps[i].set(nextTimeStepCount);
+	initThread(0);
+	for (int i = 1; i < mNumThreads; i++) {
+		mThreads.emplace_back(threadFunction, this, i);
+	}
+	mInitBarrier.wait();
+}
+
+void ThreadScheduler::finishSchedule(const Edges& inEdges, Int nextTimeStepCount) {
+	if (mThreads.empty())
+		startThreads(nextTimeStepCount);
+
 	std::map<CPS::Task::Ptr, Counter*> counters;
 	for (int thread = 0; thread < mNumThreads; thread++) {
 	//	std::cout << "Thread " << thread << std::endl;
@@ -40,10 +160,13 @@ void ThreadScheduler::finishSchedule(const Edges& inEdges) {
 	//		void *ref = *(reinterpret_cast<void**>(refpos));
 	//		std::cout << entry.task->toString() << " " << ref << std::endl;
 	//	}
-		mSchedules[thread] = new ScheduleEntry[mTempSchedules[thread].size()];
+		if (!mSchedules[thread])
+			mSchedules[thread] = new ScheduleEntry[mTempSchedules[thread].size()];
 		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
 			auto& task = mTempSchedules[thread][i];
 			mSchedules[thread][i].task = task.get();
+			mSchedules[thread][i].endCounter.set(nextTimeStepCount);
+			mSchedules[thread][i].endCounter.setAdaptiveWait(mUseAdaptiveWait);
 			counters[task] = &mSchedules[thread][i].endCounter;
 		}
 	}
@@ -57,16 +180,77 @@ void ThreadScheduler::finishSchedule(const Edges& inEdges) {
 			}
 		}
 	}
-	for (int i = 1; i < mNumThreads; i++) {
-		mThreads.emplace_back(threadFunction, this, i);
+
+	if (!mPipelined)
+		return;
+
+	// A task may start the next step once its successors and the tasks it shares
+	// attributes with across steps are done with the current step:
+	// - the producers of its previous step dependencies have written them
+	// - the tasks reading its outputs, also as previous step dependencies,
+	//   do not need the values anymore
+	std::unordered_map<CPS::Task*, std::set<CPS::Task*>> related;
+	std::unordered_map<CPS::AttributeBase*, std::vector<CPS::Task*>> producers, prevConsumers;
+	for (auto& entry : counters) {
+		for (auto& attr : entry.first->getModifiedAttributes())
+			producers[attr.get()].push_back(entry.first.get());
+		for (auto& attr : entry.first->getPrevStepDependencies())
+			prevConsumers[attr.get()].push_back(entry.first.get());
+	}
+	for (auto& entry : counters) {
+		auto task = entry.first.get();
+		for (auto& attr : task->getPrevStepDependencies()) {
+			for (auto producer : producers[attr.get()])
+				related[task].insert(producer);
+		}
+		for (auto& attr : task->getModifiedAttributes()) {
+			for (auto consumer : prevConsumers[attr.get()])
+				related[task].insert(consumer);
+		}
+		if (inEdges.find(entry.first) != inEdges.end()) {
+			for (auto& req : inEdges.at(entry.first))
+				related[req.get()].insert(task);
+		}
+	}
+
+	std::unordered_map<CPS::Task*, Counter*> taskCounters;
+	for (auto& entry : counters)
+		taskCounters[entry.first.get()] = entry.second;
+	for (int thread = 0; thread < mNumThreads; thread++) {
+		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
+			auto task = mTempSchedules[thread][i].get();
+			for (auto other : related[task]) {
+				auto it = taskCounters.find(other);
+				if (other != task && it != taskCounters.end())
+					mSchedules[thread][i].prevCounters.push_back(it->second);
+			}
+		}
+	}
+}
+
+void ThreadScheduler::drainPipeline() {
+	Int published = mPublishedSteps.get();
+	for (int thread = 1; thread < mNumThreads; thread++) {
+		if (mTempSchedules[thread].size() != 0)
+			mSchedules[thread][mTempSchedules[thread].size()-1].endCounter.wait(published);
 	}
 }
 
 void ThreadScheduler::step(Real time, Int timeStepCount) {
+	if (mPipelined) {
+		// The slot of the step is free once all threads started the step using it before
+		for (int thread = 1; thread < mNumThreads; thread++)
+			mStartedSteps[thread].wait(timeStepCount - mPipelineDepth + 1);
+		mPipelineTimes[timeStepCount % mPipelineDepth] = time;
+		mPublishedSteps.inc();
+		doStep(0, time, timeStepCount);
+		return;
+	}
+
 	mTime = time;
 	mTimeStepCount = timeStepCount;
 	mStartBarrier.wait();
-	doStep(0);
+	doStep(0, mTime, mTimeStepCount);
 	// since we don't have a final BarrierTask, wait for all threads to finish
 	// their last task explicitly
 	for (int thread = 1; thread < mNumThreads; thread++) {
@@ -75,47 +259,111 @@ void ThreadScheduler::step(Real time, Int timeStepCount) {
 	}
 }
 
-void ThreadScheduler::stop() {
-	if (!mThreads.empty()) {
+void ThreadScheduler::joinThreads() {
+	if (mThreads.empty() || mJoining)
+		return;
+
+	if (mPipelined) {
+		// Publish an end marker after the last step, which the threads reach in order
+		mPipelineEnd.store(mPublishedSteps.get(), std::memory_order_relaxed);
+		mPublishedSteps.inc();
+	} else {
 		mJoining = true;
 		mStartBarrier.wait();
-		for (size_t thread = 0; thread < mThreads.size(); thread++) {
-			mThreads[thread].join();
-		}
 	}
+	for (size_t thread = 0; thread < mThreads.size(); thread++) {
+		mThreads[thread].join();
+	}
+	mJoining = true;
+}
+
+void ThreadScheduler::restart(Int timeStepCount) {
+	// Pipelined threads count the steps themselves, so they are started again
+	if (mPipelined)
+		joinThreads();
+	if (mJoining) {
+		mThreads.clear();
+		mJoining = false;
+		mPipelineEnd = -1;
+	}
+
+	// Running threads wait at the start barrier and do not read the counters
+	for (int thread = 0; thread < mNumThreads; thread++) {
+		for (size_t i = 0; mSchedules[thread] && i < mTempSchedules[thread].size(); i++)
+			mSchedules[thread][i].endCounter.set(timeStepCount);
+	}
+	if (mThreads.empty()) {
+		startThreads(timeStepCount);
+	} else {
+		mPublishedSteps.set(timeStepCount);
+		for (int i = 0; i < mNumThreads; i++)
+			mStartedSteps[i].set(timeStepCount);
+	}
+}
+
+void ThreadScheduler::recreateSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges, Int timeStepCount) {
+	clearSchedule();
+	Scheduler::recreateSchedule(tasks, inEdges, outEdges, timeStepCount);
+}
+
+void ThreadScheduler::stop() {
+	joinThreads();
 	if (!mOutMeasurementFile.empty()) {
 		writeMeasurements(mOutMeasurementFile);
 	}
 }
 
 void ThreadScheduler::threadFunction(ThreadScheduler* sched, Int idx) {
+	sched->initThread(idx);
+	sched->mInitBarrier.wait();
+
+	if (sched->mPipelined) {
+		pipelineFunction(sched, idx);
+		return;
+	}
+
 	while (true) {
 		sched->mStartBarrier.wait();
 		if (sched->mJoining)
 			return;
 
-		sched->doStep(idx);
+		sched->doStep(idx, sched->mTime, sched->mTimeStepCount);
+	}
+}
+
+void ThreadScheduler::pipelineFunction(ThreadScheduler* sched, Int idx) {
+	Int timeStepCount = sched->mStartedSteps[idx].get();
+	while (true) {
+		sched->mPublishedSteps.wait(timeStepCount + 1);
+		if (timeStepCount == sched->mPipelineEnd.load(std::memory_order_relaxed))
+			return;
+
+		Real time = sched->mPipelineTimes[timeStepCount % mPipelineDepth];
+		sched->mStartedSteps[idx].inc();
+		sched->doStep(idx, time, timeStepCount);
+		timeStepCount++;
 	}
 }
 
-void ThreadScheduler::doStep(Int thread) {
-	if (mOutMeasurementFile.empty()) {
+void ThreadScheduler::doStep(Int thread, Real time, Int timeStepCount) {
+	if (!mMeasureTasks) {
 		for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
 			ScheduleEntry* entry = &mSchedules[thread][i];
+			for (Counter* counter : entry->prevCounters)
+				counter->wait(timeStepCount);
 			for (Counter* counter : entry->reqCounters)
-				counter->wait(mTimeStepCount+1);
-			entry->task->execute(mTime, mTimeStepCount);
+				counter->wait(timeStepCount+1);
+			executeTask(entry->task, time, timeStepCount, thread);
 			entry->endCounter.inc();
 		}
 	} else {
 		for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
 			ScheduleEntry* entry = &mSchedules[thread][i];
+			for (Counter* counter : entry->prevCounters)
+				counter->wait(timeStepCount);
 			for (Counter* counter : entry->reqCounters)
-				counter->wait(mTimeStepCount+1);
-			auto start = std::chrono::steady_clock::now();
-			entry->task->execute(mTime, mTimeStepCount);
-			auto end = std::chrono::steady_clock::now();
-			updateMeasurement(entry->task, end-start);
+				counter->wait(timeStepCount+1);
+			measureTask(entry->task, time, timeStepCount, thread);
 			entry->endCounter.inc();
 		}
 	}
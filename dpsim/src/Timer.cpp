@@ -6,6 +6,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
 #include <assert.h>
 #include <thread>
 
@@ -20,11 +21,23 @@
 using namespace DPsim;
 using CPS::SystemError;
 
+namespace {
+	inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#endif
+	}
+}
+
 Timer::Timer(int flags) :
 	mState(stopped),
 	mOverruns(0),
 	mTicks(0),
-	mFlags(flags) {
+	mFlags(flags),
+	mLatencyLast(0),
+	mLatencyMax(0),
+	mLatencySum(0),
+	mWakeups(0) {
 #ifdef HAVE_TIMERFD
 	mTimerFd = timerfd_create(CLOCK_MONOTONIC, 0);
 	if (mTimerFd < 0) {
@@ -46,25 +59,38 @@ Timer::~Timer() {
 
 void Timer::sleep() {
 	uint64_t ticks = 0, overruns;
-
+	IntervalTimePoint now;
+
+	if (mFlags & Flags::busy_wait) {
+		do {
+			cpuRelax();
+			now = IntervalClock::now();
+		} while (now < mNextTick);
+		ticks = 1 + (now - mNextTick) / mTickInterval;
+	} else {
 #ifdef HAVE_TIMERFD
-	ssize_t bytes;
+		ssize_t bytes;
 
-	bytes = read(mTimerFd, &ticks, sizeof(ticks));
-	if (bytes < 0) {
-		throw SystemError("Read from timerfd failed");
-	}
+		bytes = read(mTimerFd, &ticks, sizeof(ticks));
+		if (bytes < 0) {
+			throw SystemError("Read from timerfd failed");
+		}
+		now = IntervalClock::now();
 #else
-	std::this_thread::sleep_until(mNextTick);
-
-	auto now = IntervalClock::now();
+		std::this_thread::sleep_until(mNextTick);
 
-	while (mNextTick < now) {
-		mNextTick += mTickInterval;
-		ticks++;
+		now = IntervalClock::now();
+		ticks = 1 + (now - mNextTick) / mTickInterval;
+#endif
 	}
 
-#endif
+	// mNextTick is the deadline of the first of the expired ticks
+	mLatencyLast = now - mNextTick;
+	mLatencyMax = std::max(mLatencyMax, mLatencyLast);
+	mLatencySum += mLatencyLast;
+	mWakeups++;
+	mNextTick += ticks * mTickInterval;
+
 	overruns = ticks - 1;
 
 	mOverruns += overruns;
@@ -82,6 +108,8 @@ void Timer::start() {
 
 	mTicks = 0;
 	mOverruns = 0;
+	mLatencyLast = mLatencyMax = mLatencySum = Ticks::zero();
+	mWakeups = 0;
 
 	/* Determine offset between clocks */
 	auto rt     = StartClock::now();
@@ -96,18 +124,23 @@ void Timer::start() {
 			: steady.time_since_epoch();
 
 #ifdef HAVE_TIMERFD
-	int ret;
-	struct itimerspec ts = {
-		.it_interval = to_timespec(mTickInterval),
-		.it_value    = to_timespec(start)
-	};
-
-	ret = timerfd_settime(mTimerFd, TFD_TIMER_ABSTIME, &ts, 0);
-	if (ret < 0) {
-		throw SystemError("Failed to arm timerfd");
+	if (!(mFlags & Flags::busy_wait)) {
+		int ret;
+		struct itimerspec ts = {
+			.it_interval = to_timespec(mTickInterval),
+			.it_value    = to_timespec(start)
+		};
+
+		ret = timerfd_settime(mTimerFd, TFD_TIMER_ABSTIME, &ts, 0);
+		if (ret < 0) {
+			throw SystemError("Failed to arm timerfd");
+		}
 	}
-#endif
+	// The timerfd expires at the start time for the first time
+	mNextTick = IntervalTimePoint(start);
+#else
 	mNextTick = IntervalTimePoint(start) + mTickInterval;
+#endif
 	mState = State::running;
 }
 
@@ -115,15 +148,17 @@ void Timer::stop() {
 	assert(mState == State::running);
 
 #ifdef HAVE_TIMERFD
-	int ret;
-	struct itimerspec ts = {
-		.it_interval = { 0, 0},
-		.it_value = { 0, 0 }
-	};
-
-	ret = timerfd_settime(mTimerFd, 0, &ts, 0);
-	if (ret < 0) {
-		throw SystemError("Failed to arm timerfd");
+	if (!(mFlags & Flags::busy_wait)) {
+		int ret;
+		struct itimerspec ts = {
+			.it_interval = { 0, 0},
+			.it_value = { 0, 0 }
+		};
+
+		ret = timerfd_settime(mTimerFd, 0, &ts, 0);
+		if (ret < 0) {
+			throw SystemError("Failed to arm timerfd");
+		}
 	}
 #endif
 
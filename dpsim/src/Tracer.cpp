@@ -0,0 +1,72 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/Tracer.h>
+
+#include <fstream>
+#include <iomanip>
+
+using namespace CPS;
+using namespace DPsim;
+
+Tracer::Tracer(UInt threads, UInt capacity) :
+	mBuffers(threads), mStartTicks(now()), mStartTime(std::chrono::steady_clock::now()) {
+	if (capacity == 0)
+		throw SystemError("Tracer requires a capacity of at least one event.");
+	for (auto& buffer : mBuffers)
+		buffer.events.resize(capacity);
+}
+
+void Tracer::clear() {
+	for (auto& buffer : mBuffers) {
+		buffer.next = 0;
+		buffer.wrapped = false;
+	}
+}
+
+static String escapeJson(const String& str) {
+	String escaped;
+	for (char c : str) {
+		if (c == '"' || c == '\\')
+			escaped += '\\';
+		escaped += c;
+	}
+	return escaped;
+}
+
+void Tracer::writeChromeTrace(String filename) const {
+	// Calibrate the ticks against the steady clock over the traced period
+	uint64_t endTicks = now();
+	auto endTime = std::chrono::steady_clock::now();
+	Real ns = static_cast<Real>(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - mStartTime).count());
+	Real usPerTick = endTicks > mStartTicks ? ns / 1000. / static_cast<Real>(endTicks - mStartTicks) : 0;
+
+	std::ofstream os(filename);
+	if (!os.good())
+		throw SystemError("Cannot open trace file " + filename);
+
+	os << std::fixed << std::setprecision(3);
+	os << "{\"traceEvents\":[";
+	Bool first = true;
+	for (std::size_t thread = 0; thread < mBuffers.size(); thread++) {
+		auto& buffer = mBuffers[thread];
+		std::size_t count = buffer.wrapped ? buffer.events.size() : buffer.next;
+		std::size_t begin = buffer.wrapped ? buffer.next : 0;
+		for (std::size_t i = 0; i < count; i++) {
+			auto& event = buffer.events[(begin + i) % buffer.events.size()];
+			Real ts = static_cast<Real>(event.start - mStartTicks) * usPerTick;
+			Real dur = static_cast<Real>(event.end - event.start) * usPerTick;
+			if (!first)
+				os << ",";
+			first = false;
+			os << "\n{\"name\":\"" << escapeJson(event.task->toString()) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread
+			   << ",\"ts\":" << ts << ",\"dur\":" << dur << ",\"args\":{\"step\":" << event.timeStepCount << "}}";
+		}
+	}
+	os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
@@ -53,8 +53,8 @@ CommandLineArgs::CommandLineArgs(int argc, char *argv[],
 		{ "start-at",		required_argument,	0, 'a', "ISO8601", "Start time of real-time simulation" },
 		{ "start-in",		required_argument,	0, 'i', "SECS", "" },
 		{ "solver-domain",	required_argument,	0, 'D', "(SP|DP|EMT)", "Domain of solver" },
-		{ "solver-type",	required_argument,	0, 'T', "(NRP|MNA)", "Type of solver" },
-		{ "linear-solver-impl", required_argument, 0, 'U', "(DenseLU|SparseLU|KLU|CUDADense|CUDASparse)", "Type of direct linear solver implementation"},
+		{ "solver-type",	required_argument,	0, 'T', "(NRP|FDP|DCP|SWP|LIM|MNA)", "Type of solver" },
+		{ "linear-solver-impl", required_argument, 0, 'U', "(DenseLU|DenseInverse|SparseLU|ParallelSparseLU|ComplexSparseLU|Iterative|KLU|CUDADense|CUDASparse|Auto)", "Type of direct linear solver implementation"},
 		{ "option",		required_argument,	0, 'o', "KEY=VALUE", "User-definable options" },
 		{ "name",		required_argument,	0, 'n', "NAME", "Name of log files" },
 		{ "params",		required_argument,	0, 'p', "PATH", "Json file containing parametrization"},
@@ -108,8 +108,8 @@ CommandLineArgs::CommandLineArgs(
 		{ "start-at",		required_argument,	0, 'a', "ISO8601", "Start time of real-time simulation" },
 		{ "start-in",		required_argument,	0, 'i', "SECS", "" },
 		{ "solver-domain",	required_argument,	0, 'D', "(SP|DP|EMT)", "Domain of solver" },
-		{ "solver-type",	required_argument,	0, 'T', "(NRP|MNA)", "Type of solver" },
-		{ "linear-solver-impl", required_argument, 0, 'U', "(DenseLU|SparseLU|KLU|CUDADense|CUDASparse)", "Type of direct linear solver implementation"},
+		{ "solver-type",	required_argument,	0, 'T', "(NRP|FDP|DCP|SWP|LIM|MNA)", "Type of solver" },
+		{ "linear-solver-impl", required_argument, 0, 'U', "(DenseLU|DenseInverse|SparseLU|ParallelSparseLU|ComplexSparseLU|Iterative|KLU|CUDADense|CUDASparse|Auto)", "Type of direct linear solver implementation"},
 		{ "option",		required_argument,	0, 'o', "KEY=VALUE", "User-definable options" },
 		{ "name",		required_argument,	0, 'n', "NAME", "Name of log files" },
 		{ 0 }
@@ -228,29 +228,20 @@ void CommandLineArgs::parseArguments(int argc, char *argv[])
 					solver.type = Solver::Type::MNA;
 				else if (arg == "NRP")
 					solver.type = Solver::Type::NRP;
+				else if (arg == "FDP")
+					solver.type = Solver::Type::FDP;
+				else if (arg == "DCP")
+					solver.type = Solver::Type::DCP;
+				else if (arg == "SWP")
+					solver.type = Solver::Type::SWP;
+				else if (arg == "LIM")
+					solver.type = Solver::Type::LIM;
 				else
-					throw std::invalid_argument("Invalid value for --solver-type: must be a string of NRP or MNA");
+					throw std::invalid_argument("Invalid value for --solver-type: must be a string of NRP, FDP, DCP, SWP, LIM or MNA");
 				break;
 			}
 			case 'U': {
-				String arg = optarg;
-				if (arg == "DenseLU") {
-					directImpl = DirectLinearSolverImpl::DenseLU;
-				} else if (arg == "SparseLU") {
-					directImpl = DirectLinearSolverImpl::SparseLU;
-				} else if (arg == "KLU") {
-					directImpl = DirectLinearSolverImpl::KLU;
-				} else if (arg == "CUDADense") {
-					directImpl = DirectLinearSolverImpl::CUDADense;
-				} else if (arg == "CUDASparse") {
-					directImpl = DirectLinearSolverImpl::CUDASparse;
-				} else if (arg == "CUDAMagma") {
-					directImpl = DirectLinearSolverImpl::CUDAMagma;
-				} else if (arg == "Plugin") {
-					directImpl = DirectLinearSolverImpl::Plugin;
-				} else {
-					throw std::invalid_argument("Invalid value for --solver-mna-impl");
-				}
+				directImpl = directLinearSolverImpl(optarg);
 				break;
 			}
 			case 'P': {
@@ -306,6 +297,35 @@ void CommandLineArgs::parseArguments(int argc, char *argv[])
 		positional.push_back(argv[optind++]);
 }
 
+DirectLinearSolverImpl CommandLineArgs::directLinearSolverImpl(const String& name) {
+	if (name == "DenseLU")
+		return DirectLinearSolverImpl::DenseLU;
+	else if (name == "DenseInverse")
+		return DirectLinearSolverImpl::DenseInverse;
+	else if (name == "SparseLU")
+		return DirectLinearSolverImpl::SparseLU;
+	else if (name == "ParallelSparseLU")
+		return DirectLinearSolverImpl::ParallelSparseLU;
+	else if (name == "ComplexSparseLU")
+		return DirectLinearSolverImpl::ComplexSparseLU;
+	else if (name == "Iterative")
+		return DirectLinearSolverImpl::Iterative;
+	else if (name == "Auto")
+		return DirectLinearSolverImpl::Auto;
+	else if (name == "KLU")
+		return DirectLinearSolverImpl::KLU;
+	else if (name == "CUDADense")
+		return DirectLinearSolverImpl::CUDADense;
+	else if (name == "CUDASparse")
+		return DirectLinearSolverImpl::CUDASparse;
+	else if (name == "CUDAMagma")
+		return DirectLinearSolverImpl::CUDAMagma;
+	else if (name == "Plugin")
+		return DirectLinearSolverImpl::Plugin;
+	else
+		throw std::invalid_argument("Invalid value for --solver-mna-impl");
+}
+
 void CommandLineArgs::showUsage() {
 	std::cout << "Usage: " << mProgramName << " [OPTIONS] [FILES]" << std::endl;
 	std::cout << std::endl;
@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dpsim/WaveformRelaxation.h>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <thread>
+
+using namespace CPS;
+using namespace DPsim;
+
+class WaveformLink::End : public CPS::Signal::DecouplingLineChannel {
+public:
+	End(WaveformLink& link, UInt side) : mLink(link), mSide(side) { }
+
+	Complex exchangeInitialVoltage(Complex voltage) override {
+		return mLink.exchangeInitialVoltage(mSide, voltage);
+	}
+	void send(Int timeStepCount, Complex voltage, Complex current) override {
+		mLink.send(mSide, timeStepCount, voltage, current);
+	}
+	void receive(Int timeStepCount, Complex& voltage, Complex& current) override {
+		mLink.receive(mSide, timeStepCount, voltage, current);
+	}
+
+private:
+	WaveformLink& mLink;
+	UInt mSide;
+};
+
+namespace {
+	Real relativeChange(Complex value, Complex previous) {
+		return std::abs(value - previous) / std::max(1., std::abs(previous));
+	}
+}
+
+WaveformLink::WaveformLink() {
+	for (UInt side = 0; side < 2; ++side) {
+		mSides[side].channel = std::make_shared<End>(*this, side);
+		mSides[side].lowestRead = std::numeric_limits<Int>::max();
+	}
+}
+
+Signal::DecouplingLineChannel::Ptr WaveformLink::end(UInt side) {
+	if (side > 1)
+		throw SystemError("A waveform link has the sides 0 and 1.");
+	return mSides[side].channel;
+}
+
+Complex WaveformLink::exchangeInitialVoltage(UInt side, Complex voltage) {
+	std::unique_lock<std::mutex> lock(mMutex);
+	mSides[side].initialVoltage = voltage;
+	mSides[side].hasInitialVoltage = true;
+	mCondition.notify_all();
+	mCondition.wait(lock, [this, side]() { return mSides[1 - side].hasInitialVoltage; });
+	return mSides[1 - side].initialVoltage;
+}
+
+void WaveformLink::send(UInt side, Int timeStepCount, Complex voltage, Complex current) {
+	Int index = timeStepCount - mWindowStart;
+	if (index < 0 || index >= static_cast<Int>(mWindowSteps))
+		throw SystemError("Step " + std::to_string(timeStepCount) + " is outside of the window of the waveform link.");
+	mSides[side].sent[index] = { voltage, current };
+}
+
+void WaveformLink::receive(UInt side, Int timeStepCount, Complex& voltage, Complex& current) {
+	// Only the reading side is written, so both ends may run concurrently
+	Side& reader = mSides[side];
+	const Side& sender = mSides[1 - side];
+	reader.lowestRead = std::min(reader.lowestRead, timeStepCount);
+
+	Record record;
+	if (timeStepCount < mWindowStart) {
+		if (timeStepCount < sender.committedStart)
+			throw SystemError("Step " + std::to_string(timeStepCount) + " was already dropped by the waveform link.");
+		record = sender.committed[timeStepCount - sender.committedStart];
+	} else {
+		reader.readWindow = true;
+		UInt index = static_cast<UInt>(timeStepCount - mWindowStart);
+		if (sender.hasPrevious && index < sender.previous.size())
+			record = sender.previous[index];
+		else if (!sender.committed.empty())
+			record = sender.committed.back();
+		else
+			record = { sender.initialVoltage, 0 };
+	}
+	voltage = record.voltage;
+	current = record.current;
+}
+
+void WaveformLink::beginWindow(Int first, UInt steps) {
+	mWindowStart = first;
+	mWindowSteps = steps;
+	for (auto& side : mSides) {
+		if (side.committed.empty())
+			side.committedStart = first;
+		side.sent.assign(steps, Record());
+		side.previous.clear();
+		side.hasPrevious = false;
+		side.lowestRead = std::numeric_limits<Int>::max();
+		side.readWindow = false;
+	}
+	mReadWindow = false;
+}
+
+Real WaveformLink::exchange() {
+	mReadWindow = mSides[0].readWindow || mSides[1].readWindow;
+	Real change = 0;
+	for (auto& side : mSides) {
+		if (mReadWindow && !side.hasPrevious) {
+			change = std::numeric_limits<Real>::infinity();
+		} else if (mReadWindow) {
+			for (std::size_t k = 0; k < side.sent.size(); ++k) {
+				change = std::max(change, relativeChange(side.sent[k].voltage, side.previous[k].voltage));
+				change = std::max(change, relativeChange(side.sent[k].current, side.previous[k].current));
+			}
+		}
+		side.previous.swap(side.sent);
+		side.sent.resize(side.previous.size());
+		side.hasPrevious = true;
+		side.readWindow = false;
+	}
+	return change;
+}
+
+void WaveformLink::commitWindow() {
+	Int next = mWindowStart + static_cast<Int>(mWindowSteps);
+	for (UInt s = 0; s < 2; ++s) {
+		Side& sender = mSides[s];
+		const Side& reader = mSides[1 - s];
+		sender.committed.insert(sender.committed.end(), sender.previous.begin(), sender.previous.end());
+
+		// The reads of the next window start one window later, the last value is kept for the first iteration
+		Int keepFrom = next - 1;
+		if (reader.lowestRead != std::numeric_limits<Int>::max())
+			keepFrom = std::min(keepFrom, reader.lowestRead + static_cast<Int>(mWindowSteps));
+		while (!sender.committed.empty() && sender.committedStart < keepFrom) {
+			sender.committed.pop_front();
+			++sender.committedStart;
+		}
+	}
+}
+
+WaveformRelaxation::WaveformRelaxation(String name, Logger::Level logLevel)
+	: mLog(Logger::get(name, logLevel)), mName(name) { }
+
+void WaveformRelaxation::addSubnet(Simulation::Ptr subnet) {
+	if (mInitialized)
+		throw SystemError("Subnets cannot be added to an initialized waveform relaxation.");
+	mSubnets.push_back(subnet);
+}
+
+void WaveformRelaxation::initialize() {
+	if (mSubnets.empty())
+		throw SystemError("Waveform relaxation " + mName + " has no subnets.");
+	if (mWindowSteps == 0)
+		throw SystemError("The windows of waveform relaxation " + mName + " require at least one step.");
+
+	Real timeStep = mSubnets[0]->timeStep();
+	Real finalTime = mSubnets[0]->finalTime();
+	for (auto subnet : mSubnets) {
+		if (subnet->timeStep() != timeStep || subnet->finalTime() != finalTime)
+			throw SystemError("All subnets of a waveform relaxation require the same time step and final time.");
+	}
+
+	// The lines wait for the initial voltage of their other end
+	std::vector<std::exception_ptr> errors(mSubnets.size());
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < mSubnets.size(); ++i) {
+		threads.emplace_back([this, i, &errors]() {
+			try {
+				mSubnets[i]->initialize();
+			}
+			catch (...) {
+				errors[i] = std::current_exception();
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	for (auto& error : errors) {
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	mLoggers.clear();
+	for (auto subnet : mSubnets) {
+		DataLogger::List loggers = subnet->loggers();
+		for (auto solver : subnet->solvers()) {
+			for (auto logger : solver->dataLoggers())
+				loggers.push_back(logger);
+		}
+		for (auto logger : loggers) {
+			if (logger && logger->isEnabled() && !logger->isPaused())
+				mLoggers.push_back(logger);
+		}
+	}
+
+	SPDLOG_LOGGER_INFO(mLog, "Initialized waveform relaxation {} with {} subnets, {} links and windows of {} steps",
+		mName, mSubnets.size(), mLinks.size(), mWindowSteps);
+	mInitialized = true;
+}
+
+void WaveformRelaxation::setLogging(Bool enabled) {
+	for (auto logger : mLoggers)
+		logger->setPaused(!enabled);
+}
+
+void WaveformRelaxation::stepSubnets(UInt steps) {
+	if (mExecutor) {
+		mExecutor->parallelFor(static_cast<UInt>(mSubnets.size()), [this, steps](UInt i) {
+			mSubnets[i]->stepN(steps);
+		});
+		return;
+	}
+
+	std::exception_ptr error;
+#ifdef WITH_OPENMP
+	#pragma omp parallel for schedule(dynamic)
+#endif
+	for (Int i = 0; i < static_cast<Int>(mSubnets.size()); ++i) {
+		try {
+			mSubnets[i]->stepN(steps);
+		}
+		catch (...) {
+#ifdef WITH_OPENMP
+			#pragma omp critical
+#endif
+			if (!error)
+				error = std::current_exception();
+		}
+	}
+	if (error)
+		std::rethrow_exception(error);
+}
+
+void WaveformRelaxation::run() {
+	if (!mInitialized)
+		initialize();
+
+	for (auto subnet : mSubnets)
+		subnet->start();
+
+	Real timeStep = mSubnets[0]->timeStep();
+	Int totalSteps = static_cast<Int>(std::round(mSubnets[0]->finalTime() / timeStep));
+	mWindows = 0;
+	mIterations = 0;
+	mUnconvergedWindows = 0;
+	mExact = false;
+
+	while (mSubnets[0]->timeStepCount() < totalSteps) {
+		Int first = mSubnets[0]->timeStepCount();
+		UInt steps = static_cast<UInt>(std::min<Int>(mWindowSteps, totalSteps - first));
+		for (auto link : mLinks)
+			link->beginWindow(first, steps);
+
+		std::vector<Checkpoint> states;
+		for (auto subnet : mSubnets)
+			states.push_back(subnet->captureState());
+
+		Bool logged = mExact;
+		UInt iteration = 0;
+		while (true) {
+			if (iteration > 0) {
+				for (std::size_t i = 0; i < mSubnets.size(); ++i)
+					mSubnets[i]->restoreState(states[i]);
+			}
+			setLogging(logged);
+			stepSubnets(steps);
+			++iteration;
+
+			Real change = 0;
+			Bool readsWindow = false;
+			for (auto link : mLinks) {
+				change = std::max(change, link->exchange());
+				readsWindow = readsWindow || link->readsWindow();
+			}
+			if (mWindows == 0 && iteration == 1 && !readsWindow) {
+				mExact = true;
+				SPDLOG_LOGGER_INFO(mLog, "The line delays cover the windows, every window is run once");
+			}
+			SPDLOG_LOGGER_DEBUG(mLog, "Window at step {}, iteration {}: largest relative change {}", first, iteration, change);
+
+			if (logged)
+				break;
+			if (change <= mTolerance || iteration >= mMaxIterations) {
+				if (change > mTolerance) {
+					++mUnconvergedWindows;
+					SPDLOG_LOGGER_WARN(mLog, "Window at step {} did not converge in {} iterations, largest relative change {}",
+						first, iteration, change);
+				}
+				logged = true;
+			}
+		}
+
+		for (auto link : mLinks)
+			link->commitWindow();
+		mIterations += iteration;
+		++mWindows;
+	}
+
+	setLogging(true);
+	for (auto subnet : mSubnets)
+		subnet->stop();
+
+	SPDLOG_LOGGER_INFO(mLog, "Waveform relaxation {} finished {} windows with {} runs, {} windows did not converge",
+		mName, mWindows, mIterations, mUnconvergedWindows);
+	mLog->flush();
+}
@@ -0,0 +1,210 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/WorkStealingScheduler.h>
+
+#include <algorithm>
+#include <queue>
+
+using namespace CPS;
+using namespace DPsim;
+
+WorkStealingScheduler::WorkStealingScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariables) :
+	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile), mInMeasurementFile(inMeasurementFile),
+	mStartBarrier(threads, useConditionVariables), mEndBarrier(threads, useConditionVariables), mRemainingTasks(0) {
+	if (threads < 1)
+		throw SchedulingException();
+	for (Int i = 0; i < threads; i++)
+		mReadyQueues.push_back(std::make_unique<ReadyQueue>());
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+	if (!mThreads.empty() && !mJoining)
+		stop();
+}
+
+void WorkStealingScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, mTasks);
+	Scheduler::initMeasurements(mTasks);
+
+	std::unordered_map<String, TaskTime::rep> costs;
+	readTaskCosts(mInMeasurementFile, mTasks, costs);
+
+	std::unordered_map<Task::Ptr, int64_t> priorities;
+	hlfetPriorities(mTasks, outEdges, costs, priorities);
+
+	std::unordered_map<Task::Ptr, UInt> indices;
+	for (UInt i = 0; i < mTasks.size(); i++)
+		indices[mTasks[i]] = i;
+
+	UInt numTasks = static_cast<UInt>(mTasks.size());
+	mPriorities.assign(numTasks, 0);
+	mOwners.assign(numTasks, 0);
+	mNumPredecessors.assign(numTasks, 0);
+	mSuccessors.assign(numTasks, std::vector<UInt>());
+	mInitialTasks.clear();
+
+	for (UInt i = 0; i < numTasks; i++) {
+		mPriorities[i] = priorities[mTasks[i]];
+		if (outEdges.find(mTasks[i]) == outEdges.end())
+			continue;
+		for (auto after : outEdges.at(mTasks[i])) {
+			auto it = indices.find(after);
+			if (it == indices.end())
+				continue;
+			mSuccessors[i].push_back(it->second);
+			mNumPredecessors[it->second]++;
+		}
+	}
+	for (UInt i = 0; i < numTasks; i++) {
+		if (mNumPredecessors[i] == 0)
+			mInitialTasks.push_back(i);
+	}
+
+	// Seed the preferred threads by list scheduling in order of priority
+	auto cmp = [this](UInt t1, UInt t2) -> bool {
+		return mPriorities[t1] < mPriorities[t2];
+	};
+	std::priority_queue<UInt, std::vector<UInt>, decltype(cmp)> queue(cmp);
+	for (auto task : mInitialTasks)
+		queue.push(task);
+
+	std::vector<Int> remaining = mNumPredecessors;
+	std::vector<TaskTime::rep> totalTimes(mNumThreads, 0);
+	while (!queue.empty()) {
+		auto task = queue.top();
+		queue.pop();
+
+		auto minIt = std::min_element(totalTimes.begin(), totalTimes.end());
+		mOwners[task] = static_cast<Int>(minIt - totalTimes.begin());
+		*minIt += costs.at(mTasks[task]->toString());
+
+		for (auto after : mSuccessors[task]) {
+			if (--remaining[after] == 0)
+				queue.push(after);
+		}
+	}
+
+	mPendingPredecessors = std::make_unique<std::atomic<Int>[]>(numTasks);
+
+	for (UInt i = 0; i < numTasks; i++)
+		SPDLOG_LOGGER_INFO(mSLog, "{} (thread {}, priority {})", mTasks[i]->toString(), mOwners[i], mPriorities[i]);
+
+	// The calling thread works as thread 0
+	if (mExecutor)
+		mExecutor->pin(0);
+
+	for (Int i = 1; i < mNumThreads; i++)
+		mThreads.emplace_back(threadFunction, this, i);
+}
+
+void WorkStealingScheduler::pushReady(UInt task) {
+	auto& queue = *mReadyQueues[mOwners[task]];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	auto pos = std::upper_bound(queue.tasks.begin(), queue.tasks.end(), task,
+		[this](UInt t1, UInt t2) { return mPriorities[t1] < mPriorities[t2]; });
+	queue.tasks.insert(pos, task);
+}
+
+Bool WorkStealingScheduler::popReady(Int thread, UInt& task) {
+	for (Int i = 0; i < mNumThreads; i++) {
+		auto& queue = *mReadyQueues[(thread + i) % mNumThreads];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty()) {
+			task = queue.tasks.back();
+			queue.tasks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+void WorkStealingScheduler::step(Real time, Int timeStepCount) {
+	mTime = time;
+	mTimeStepCount = timeStepCount;
+
+	for (UInt i = 0; i < mTasks.size(); i++)
+		mPendingPredecessors[i].store(mNumPredecessors[i], std::memory_order_relaxed);
+	mRemainingTasks.store(static_cast<Int>(mTasks.size()), std::memory_order_relaxed);
+	for (auto task : mInitialTasks)
+		pushReady(task);
+
+	mStartBarrier.wait();
+	doStep(0);
+	mEndBarrier.wait();
+}
+
+void WorkStealingScheduler::joinThreads() {
+	if (!mThreads.empty()) {
+		mJoining = true;
+		mStartBarrier.wait();
+		for (size_t thread = 0; thread < mThreads.size(); thread++) {
+			mThreads[thread].join();
+		}
+		mThreads.clear();
+	}
+}
+
+void WorkStealingScheduler::recreateSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges, Int timeStepCount) {
+	// createSchedule starts new workers, so the waiting ones are joined first
+	joinThreads();
+	mJoining = false;
+	createSchedule(tasks, inEdges, outEdges);
+}
+
+void WorkStealingScheduler::stop() {
+	joinThreads();
+	if (!mOutMeasurementFile.empty()) {
+		writeMeasurements(mOutMeasurementFile);
+	}
+}
+
+void WorkStealingScheduler::restart(Int timeStepCount) {
+	// The steps do not depend on the time step count, only stopped threads are started again
+	if (!mJoining)
+		return;
+	mJoining = false;
+	for (Int i = 1; i < mNumThreads; i++)
+		mThreads.emplace_back(threadFunction, this, i);
+}
+
+void WorkStealingScheduler::threadFunction(WorkStealingScheduler* sched, Int idx) {
+	if (sched->mExecutor)
+		sched->mExecutor->pin(idx);
+
+	while (true) {
+		sched->mStartBarrier.wait();
+		if (sched->mJoining)
+			return;
+
+		sched->doStep(idx);
+		sched->mEndBarrier.wait();
+	}
+}
+
+void WorkStealingScheduler::doStep(Int thread) {
+	UInt task;
+	while (mRemainingTasks.load(std::memory_order_acquire) > 0) {
+		if (!popReady(thread, task)) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		if (mOutMeasurementFile.empty()) {
+			executeTask(mTasks[task].get(), mTime, mTimeStepCount, thread);
+		} else {
+			measureTask(mTasks[task].get(), mTime, mTimeStepCount, thread);
+		}
+
+		for (auto after : mSuccessors[task]) {
+			if (mPendingPredecessors[after].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				pushReady(after);
+		}
+		mRemainingTasks.fetch_sub(1, std::memory_order_acq_rel);
+	}
+}
@@ -13,17 +13,42 @@
 #include <DPsim.h>
 #include <dpsim-models/CSVReader.h>
 #include <dpsim/pybind/Utils.h>
+#include <pybind11/complex.h>
+#include <pybind11/numpy.h>
 
 PYBIND11_DECLARE_HOLDER_TYPE(T, CPS::AttributePointer<T>);
 
 namespace py = pybind11;
 using namespace pybind11::literals;
 
+namespace {
+	/// Buffer of the current value, valid until the matrix is resized or the attribute is referenced elsewhere
+	template <typename T>
+	py::buffer_info matrixBuffer(CPS::Attribute<CPS::MatrixVar<T>>& attr) {
+		auto& value = attr.get();
+		return py::buffer_info(value.data(), sizeof(T), py::format_descriptor<T>::format(), 2,
+			{ value.rows(), value.cols() },
+			{ static_cast<py::ssize_t>(sizeof(T)), static_cast<py::ssize_t>(sizeof(T) * value.rows()) });
+	}
+
+	/// NumPy array on the storage of the value, which is kept alive by the array
+	template <typename T>
+	py::array matrixView(CPS::Attribute<CPS::MatrixVar<T>>& attr) {
+		auto data = attr.asRawPointer();
+		auto owner = new std::shared_ptr<CPS::MatrixVar<T>>(data);
+		py::capsule base(owner, [](void* ptr) { delete static_cast<std::shared_ptr<CPS::MatrixVar<T>>*>(ptr); });
+		return py::array_t<T>({ data->rows(), data->cols() },
+			{ static_cast<py::ssize_t>(sizeof(T)), static_cast<py::ssize_t>(sizeof(T) * data->rows()) },
+			data->data(), base);
+	}
+}
+
 void addAttributes(py::module_ m) {
 
     py::class_<CPS::AttributeBase, CPS::AttributePointer<CPS::AttributeBase>>(m, "Attribute")
 		.def("__str__", &CPS::AttributeBase::toString)
-		.def("__repr__", &CPS::AttributeBase::toString);
+		.def("__repr__", &CPS::AttributeBase::toString)
+		.def("version", &CPS::AttributeBase::version);
 
 		// Class bindings for the most common attribute types. Allows for the usage of the `get` and `set` methods in Python.
 
@@ -51,8 +76,10 @@ void addAttributes(py::module_ m) {
 			.def("set_reference", &CPS::AttributeDynamic<CPS::Complex>::setReference);
 
 
-		py::class_<CPS::Attribute<CPS::Matrix>, CPS::AttributePointer<CPS::Attribute<CPS::Matrix>>, CPS::AttributeBase>(m, "AttributeMatrix")
+		py::class_<CPS::Attribute<CPS::Matrix>, CPS::AttributePointer<CPS::Attribute<CPS::Matrix>>, CPS::AttributeBase>(m, "AttributeMatrix", py::buffer_protocol())
+			.def_buffer(&matrixBuffer<CPS::Real>)
 			.def("get", &CPS::Attribute<CPS::Matrix>::get)
+			.def("as_array", &matrixView<CPS::Real>)
 			.def("set", &CPS::Attribute<CPS::Matrix>::set)
 			.def("derive_coeff", &CPS::Attribute<CPS::Matrix>::deriveCoeff<CPS::Real>);
 
@@ -61,8 +88,10 @@ void addAttributes(py::module_ m) {
 			.def("set_reference", &CPS::AttributeDynamic<CPS::Matrix>::setReference);
 
 
-		py::class_<CPS::Attribute<CPS::MatrixComp>, CPS::AttributePointer<CPS::Attribute<CPS::MatrixComp>>, CPS::AttributeBase>(m, "AttributeMatrixComp")
+		py::class_<CPS::Attribute<CPS::MatrixComp>, CPS::AttributePointer<CPS::Attribute<CPS::MatrixComp>>, CPS::AttributeBase>(m, "AttributeMatrixComp", py::buffer_protocol())
+			.def_buffer(&matrixBuffer<CPS::Complex>)
 			.def("get", &CPS::Attribute<CPS::MatrixComp>::get)
+			.def("as_array", &matrixView<CPS::Complex>)
 			.def("set", &CPS::Attribute<CPS::MatrixComp>::set)
 			.def("derive_coeff", &CPS::Attribute<CPS::MatrixComp>::deriveCoeff<CPS::Complex>);
 
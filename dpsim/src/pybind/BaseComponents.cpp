@@ -20,4 +20,13 @@ using namespace pybind11::literals;
 void addBaseComponents(py::module_ mBase) {
     py::class_<CPS::Base::Ph1::Switch, std::shared_ptr<CPS::Base::Ph1::Switch>>(mBase, "Switch");
     py::class_<CPS::Base::Ph3::Switch, std::shared_ptr<CPS::Base::Ph3::Switch>>(mBase, "SwitchPh3");
+
+    py::class_<CPS::Base::Converter, std::shared_ptr<CPS::Base::Converter>> converter(mBase, "Converter");
+    py::enum_<CPS::Base::Converter::Fidelity>(converter, "Fidelity")
+        .value("Averaged", CPS::Base::Converter::Fidelity::Averaged)
+        .value("SwitchingFunction", CPS::Base::Converter::Fidelity::SwitchingFunction);
+    converter
+        .def("set_switching_parameters", &CPS::Base::Converter::setSwitchingParameters, "dc_voltage"_a, "carrier_frequency"_a)
+        .def("set_fidelity", &CPS::Base::Converter::setFidelity, "fidelity"_a)
+        .def("fidelity", &CPS::Base::Converter::fidelity);
 }
@@ -87,6 +87,7 @@ void addDPPh1Components(py::module_ mDPPh1) {
 	py::class_<CPS::DP::Ph1::PiLine, std::shared_ptr<CPS::DP::Ph1::PiLine>, CPS::SimPowerComp<CPS::Complex>>(mDPPh1, "PiLine", py::multiple_inheritance())
         .def(py::init<std::string, CPS::Logger::Level>(), "name"_a, "loglevel"_a = CPS::Logger::Level::off)
         .def("set_parameters", &CPS::DP::Ph1::PiLine::setParameters, "series_resistance"_a, "series_inductance"_a, "parallel_capacitance"_a=0, "parallel_conductance"_a=0)
+		.def("set_flattened", &CPS::DP::Ph1::PiLine::setFlattened, "flattened"_a=true)
 		.def("connect", &CPS::DP::Ph1::PiLine::connect);
 
 	py::class_<CPS::DP::Ph1::RXLoad, std::shared_ptr<CPS::DP::Ph1::RXLoad>, CPS::SimPowerComp<CPS::Complex>>(mDPPh1, "RXLoad", py::multiple_inheritance())
@@ -107,6 +108,7 @@ void addDPPh1Components(py::module_ mDPPh1) {
 		.def("open", &CPS::DP::Ph1::varResSwitch::open)
 		.def("close", &CPS::DP::Ph1::varResSwitch::close)
 		.def("set_init_parameters", &CPS::DP::Ph1::varResSwitch::setInitParameters, "time_step"_a)
+		.def("set_parameter_change_threshold", &CPS::DP::Ph1::varResSwitch::setParameterChangeThreshold, "relative"_a, "absolute"_a)
 		.def("connect", &CPS::DP::Ph1::varResSwitch::connect);
 
 	py::class_<CPS::DP::Ph1::SynchronGeneratorTrStab, std::shared_ptr<CPS::DP::Ph1::SynchronGeneratorTrStab>, CPS::SimPowerComp<CPS::Complex>>(mDPPh1, "SynchronGeneratorTrStab", py::multiple_inheritance())
@@ -127,7 +129,9 @@ void addDPPh1Components(py::module_ mDPPh1) {
 		.def("set_base_parameters", &CPS::DP::Ph1::ReducedOrderSynchronGeneratorVBR::setBaseParameters, "nom_power"_a, "nom_voltage"_a, "nom_frequency"_a)
 		.def("set_initial_values", &CPS::DP::Ph1::ReducedOrderSynchronGeneratorVBR::setInitialValues, "init_complex_electrical_power"_a, "init_mechanical_power"_a, "init_complex_terminal_voltage"_a)
 		.def("scale_inertia_constant", &CPS::DP::Ph1::ReducedOrderSynchronGeneratorVBR::scaleInertiaConstant, "scaling_factor"_a)
-		.def("set_model_as_current_source", &CPS::DP::Ph1::ReducedOrderSynchronGeneratorVBR::setModelAsCurrentSource, "model_as_current_source"_a);
+		.def("set_model_as_current_source", &CPS::DP::Ph1::ReducedOrderSynchronGeneratorVBR::setModelAsCurrentSource, "model_as_current_source"_a)
+		.def("set_model_with_constant_conductance", &CPS::DP::Ph1::ReducedOrderSynchronGeneratorVBR::setModelWithConstantConductance, "model_with_constant_conductance"_a)
+		.def("set_corrector_tolerance", &CPS::DP::Ph1::ReducedOrderSynchronGeneratorVBR::setCorrectorTolerance, "tolerance"_a);
 
 	py::class_<CPS::DP::Ph1::SynchronGenerator3OrderVBR, std::shared_ptr<CPS::DP::Ph1::SynchronGenerator3OrderVBR>, CPS::DP::Ph1::ReducedOrderSynchronGeneratorVBR>(mDPPh1, "SynchronGenerator3OrderVBR", py::multiple_inheritance())
 		.def(py::init<std::string, CPS::Logger::Level>(), "name"_a, "loglevel"_a = CPS::Logger::Level::off)
@@ -142,7 +142,10 @@ void addEMTPh3Components(py::module_ mEMTPh3) {
 		.def("set_base_parameters", &CPS::EMT::Ph3::ReducedOrderSynchronGeneratorVBR::setBaseParameters, "nom_power"_a, "nom_voltage"_a, "nom_frequency"_a)
 		.def("set_initial_values", &CPS::EMT::Ph3::ReducedOrderSynchronGeneratorVBR::setInitialValues, "init_complex_electrical_power"_a, "init_mechanical_power"_a, "init_complex_terminal_voltage"_a)
 		.def("scale_inertia_constant", &CPS::EMT::Ph3::ReducedOrderSynchronGeneratorVBR::scaleInertiaConstant, "scaling_factor"_a)
-		.def("set_model_as_current_source", &CPS::EMT::Ph3::ReducedOrderSynchronGeneratorVBR::setModelAsCurrentSource, "model_as_current_source"_a);
+		.def("set_model_as_current_source", &CPS::EMT::Ph3::ReducedOrderSynchronGeneratorVBR::setModelAsCurrentSource, "model_as_current_source"_a)
+		.def("set_model_with_constant_conductance", &CPS::EMT::Ph3::ReducedOrderSynchronGeneratorVBR::setModelWithConstantConductance, "model_with_constant_conductance"_a)
+		.def("set_corrector_tolerance", &CPS::EMT::Ph3::ReducedOrderSynchronGeneratorVBR::setCorrectorTolerance, "tolerance"_a)
+		.def("set_parameter_change_threshold", &CPS::EMT::Ph3::ReducedOrderSynchronGeneratorVBR::setParameterChangeThreshold, "relative"_a, "absolute"_a);
 
 	py::class_<CPS::EMT::Ph3::SynchronGenerator3OrderVBR, std::shared_ptr<CPS::EMT::Ph3::SynchronGenerator3OrderVBR>, CPS::EMT::Ph3::ReducedOrderSynchronGeneratorVBR>(mEMTPh3, "SynchronGenerator3OrderVBR", py::multiple_inheritance())
 		.def(py::init<std::string, CPS::Logger::Level>(), "name"_a, "loglevel"_a = CPS::Logger::Level::off)
@@ -184,7 +187,7 @@ void addEMTPh3Components(py::module_ mEMTPh3) {
 
 	#endif
 
-	py::class_<CPS::EMT::Ph3::AvVoltageSourceInverterDQ, std::shared_ptr<CPS::EMT::Ph3::AvVoltageSourceInverterDQ>, CPS::SimPowerComp<CPS::Real>>(mEMTPh3, "AvVoltageSourceInverterDQ", py::multiple_inheritance())
+	py::class_<CPS::EMT::Ph3::AvVoltageSourceInverterDQ, std::shared_ptr<CPS::EMT::Ph3::AvVoltageSourceInverterDQ>, CPS::SimPowerComp<CPS::Real>, CPS::Base::Converter>(mEMTPh3, "AvVoltageSourceInverterDQ", py::multiple_inheritance())
         .def(py::init<std::string, CPS::Logger::Level>(), "name"_a, "loglevel"_a = CPS::Logger::Level::off)
 		.def(py::init<std::string, std::string, CPS::Logger::Level, CPS::Bool>(), "uid"_a, "name"_a, "loglevel"_a = CPS::Logger::Level::off, "with_trafo"_a = false) // cppcheck-suppress assignBoolToPointer
 		.def("set_parameters", &CPS::EMT::Ph3::AvVoltageSourceInverterDQ::setParameters, "sys_omega"_a, "sys_volt_nom"_a, "p_ref"_a, "q_ref"_a)
@@ -103,6 +103,7 @@ void addSPPh1Components(py::module_ mSPPh1) {
 		.def("open", &CPS::SP::Ph1::varResSwitch::open)
 		.def("close", &CPS::SP::Ph1::varResSwitch::close)
 		.def("set_init_parameters", &CPS::SP::Ph1::varResSwitch::setInitParameters, "time_step"_a)
+		.def("set_parameter_change_threshold", &CPS::SP::Ph1::varResSwitch::setParameterChangeThreshold, "relative"_a, "absolute"_a)
 		.def("connect", &CPS::SP::Ph1::varResSwitch::connect);
 
 	py::class_<CPS::SP::Ph1::SynchronGeneratorTrStab, std::shared_ptr<CPS::SP::Ph1::SynchronGeneratorTrStab>, CPS::SimPowerComp<CPS::Complex>>(mSPPh1, "SynchronGeneratorTrStab", py::multiple_inheritance())
@@ -121,7 +122,9 @@ void addSPPh1Components(py::module_ mSPPh1) {
 		.def("set_base_parameters", &CPS::SP::Ph1::ReducedOrderSynchronGeneratorVBR::setBaseParameters, "nom_power"_a, "nom_voltage"_a, "nom_frequency"_a)
 		.def("set_initial_values", &CPS::SP::Ph1::ReducedOrderSynchronGeneratorVBR::setInitialValues, "init_complex_electrical_power"_a, "init_mechanical_power"_a, "init_complex_terminal_voltage"_a)
 		.def("scale_inertia_constant", &CPS::SP::Ph1::ReducedOrderSynchronGeneratorVBR::scaleInertiaConstant, "scaling_factor"_a)
-		.def("set_model_as_current_source", &CPS::SP::Ph1::ReducedOrderSynchronGeneratorVBR::setModelAsCurrentSource, "model_as_current_source"_a);
+		.def("set_model_as_current_source", &CPS::SP::Ph1::ReducedOrderSynchronGeneratorVBR::setModelAsCurrentSource, "model_as_current_source"_a)
+		.def("set_model_with_constant_conductance", &CPS::SP::Ph1::ReducedOrderSynchronGeneratorVBR::setModelWithConstantConductance, "model_with_constant_conductance"_a)
+		.def("set_corrector_tolerance", &CPS::SP::Ph1::ReducedOrderSynchronGeneratorVBR::setCorrectorTolerance, "tolerance"_a);
 
 	py::class_<CPS::SP::Ph1::SynchronGenerator3OrderVBR, std::shared_ptr<CPS::SP::Ph1::SynchronGenerator3OrderVBR>, CPS::SP::Ph1::ReducedOrderSynchronGeneratorVBR>(mSPPh1, "SynchronGenerator3OrderVBR", py::multiple_inheritance())
 		.def(py::init<std::string, CPS::Logger::Level>(), "name"_a, "loglevel"_a = CPS::Logger::Level::off)
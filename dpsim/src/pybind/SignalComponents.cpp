@@ -34,13 +34,65 @@ void addSignalComponents(py::module_ mSignal) {
         .def("set_parameters", &CPS::Signal::DecouplingLineEMT::setParameters, "node_1"_a, "node_2"_a, "resistance"_a, "inductance"_a, "capacitance"_a)
         .def("get_line_components", &CPS::Signal::DecouplingLineEMT::getLineComponents);
 
+    py::class_<CPS::Signal::HybridInterface, std::shared_ptr<CPS::Signal::HybridInterface>, CPS::SimSignalComp>(mSignal, "HybridInterface", py::multiple_inheritance())
+        .def(py::init<std::string>())
+        .def(py::init<std::string, CPS::Logger::Level>())
+        .def("set_parameters", &CPS::Signal::HybridInterface::setParameters, "phasor_node"_a, "emt_node"_a, "averaging_steps"_a=1, "initial_current"_a=CPS::Complex(0))
+        .def("get_interface_components", &CPS::Signal::HybridInterface::getInterfaceComponents);
+
+    py::class_<CPS::Signal::FrequencyDependentLineEMT, std::shared_ptr<CPS::Signal::FrequencyDependentLineEMT>, CPS::SimSignalComp>(mSignal, "FrequencyDependentLineEMT", py::multiple_inheritance())
+        .def(py::init<std::string>())
+        .def(py::init<std::string, CPS::Logger::Level>())
+        .def("set_parameters", &CPS::Signal::FrequencyDependentLineEMT::setParameters, "node_1"_a, "node_2"_a, "delay"_a,
+            "yc_const"_a, "yc_poles"_a, "yc_residues"_a, "h_poles"_a, "h_residues"_a)
+        .def("get_line_components", &CPS::Signal::FrequencyDependentLineEMT::getLineComponents);
+
+    py::class_<CPS::Signal::DecouplingLineChannel, std::shared_ptr<CPS::Signal::DecouplingLineChannel>>(mSignal, "DecouplingLineChannel");
+
+    py::class_<CPS::Signal::DecouplingLineRemote, std::shared_ptr<CPS::Signal::DecouplingLineRemote>, CPS::SimSignalComp>(mSignal, "DecouplingLineRemote", py::multiple_inheritance())
+        .def(py::init<std::string>())
+        .def(py::init<std::string, CPS::Logger::Level>())
+        .def("set_parameters", &CPS::Signal::DecouplingLineRemote::setParameters, "node"_a, "resistance"_a, "inductance"_a, "capacitance"_a, "channel"_a)
+        .def("get_line_components", &CPS::Signal::DecouplingLineRemote::getLineComponents);
+
     py::class_<CPS::Signal::Exciter, std::shared_ptr<CPS::Signal::Exciter>, CPS::SimSignalComp>(mSignal, "Exciter", py::multiple_inheritance())
         .def(py::init<std::string>())
         .def(py::init<std::string, CPS::Logger::Level>())
-        .def("set_parameters", &CPS::Signal::Exciter::setParameters, "Ta"_a, "Ka"_a, "Te"_a, "Ke"_a, "Tf"_a, "Kf"_a, "Tr"_a, "max_vr"_a=1.0, "min_vr"_a=-0.9);
+        .def("set_parameters", &CPS::Signal::Exciter::setParameters, "Ta"_a, "Ka"_a, "Te"_a, "Ke"_a, "Tf"_a, "Kf"_a, "Tr"_a, "max_vr"_a=1.0, "min_vr"_a=-0.9)
+        .def("set_ceiling_function_table", &CPS::Signal::Exciter::setCeilingFunctionTable, "tolerance"_a, "max_ef"_a=10.);
 
     py::class_<CPS::Signal::TurbineGovernorType1, std::shared_ptr<CPS::Signal::TurbineGovernorType1>, CPS::SimSignalComp>(mSignal, "TurbineGovernorType1", py::multiple_inheritance())
         .def(py::init<std::string>())
         .def(py::init<std::string, CPS::Logger::Level>())
         .def("set_parameters", &CPS::Signal::TurbineGovernorType1::setParameters, "T3"_a, "T4"_a, "T5"_a, "Tc"_a, "Ts"_a, "R"_a, "Tmin"_a, "Tmax"_a, "OmRef"_a);
+
+    py::class_<CPS::Signal::Reduction, std::shared_ptr<CPS::Signal::Reduction>, CPS::SimSignalComp> reduction(mSignal, "Reduction", py::multiple_inheritance());
+    py::enum_<CPS::Signal::Reduction::Operation>(reduction, "Operation")
+        .value("sum", CPS::Signal::Reduction::Operation::Sum)
+        .value("mean", CPS::Signal::Reduction::Operation::Mean)
+        .value("min", CPS::Signal::Reduction::Operation::Min)
+        .value("max", CPS::Signal::Reduction::Operation::Max);
+    reduction
+        .def(py::init<std::string, CPS::Signal::Reduction::Operation, CPS::Logger::Level>(), "name"_a, "operation"_a=CPS::Signal::Reduction::Operation::Sum, "loglevel"_a=CPS::Logger::Level::off)
+        .def("set_operation", &CPS::Signal::Reduction::setOperation, "operation"_a)
+        .def("add_input", &CPS::Signal::Reduction::addInput, "input"_a, "weight"_a=1., "row"_a=0, "col"_a=0)
+        .def("set_chunks", &CPS::Signal::Reduction::setChunks, "chunks"_a)
+        .def("set_decimation", &CPS::Signal::Reduction::setDecimation, "factor"_a)
+        .def("argument", &CPS::Signal::Reduction::argument)
+        .def("num_inputs", &CPS::Signal::Reduction::numInputs);
+
+    py::class_<CPS::Signal::ProtectionRelay, std::shared_ptr<CPS::Signal::ProtectionRelay>, CPS::SimSignalComp>(mSignal, "ProtectionRelay", py::multiple_inheritance())
+        .def(py::init<std::string, CPS::Logger::Level>(), "name"_a, "loglevel"_a=CPS::Logger::Level::off)
+        .def("set_parameters", &CPS::Signal::ProtectionRelay::setParameters, "threshold"_a, "delay"_a=0., "speculation_margin"_a=0.9)
+        .def("set_switch", &CPS::Signal::ProtectionRelay::setSwitch, "switch_state"_a)
+        .def("trip_imminent", &CPS::Signal::ProtectionRelay::tripImminent);
+
+    py::class_<CPS::Signal::LoadProfileEngine, std::shared_ptr<CPS::Signal::LoadProfileEngine>, CPS::SimSignalComp>(mSignal, "LoadProfileEngine", py::multiple_inheritance())
+        .def(py::init<std::string, CPS::Logger::Level>(), "name"_a, "loglevel"_a=CPS::Logger::Level::off)
+        .def("set_times", &CPS::Signal::LoadProfileEngine::setTimes, "times"_a)
+        .def("add_load", py::overload_cast<CPS::AttributeBase::Ptr, CPS::AttributeBase::Ptr, const std::vector<CPS::Real>&, const std::vector<CPS::Real>&>(&CPS::Signal::LoadProfileEngine::addLoad),
+            "active_power"_a, "reactive_power"_a, "active_power_samples"_a, "reactive_power_samples"_a)
+        .def("num_loads", &CPS::Signal::LoadProfileEngine::numLoads)
+        .def("num_times", &CPS::Signal::LoadProfileEngine::numTimes)
+        .def("changed_loads", &CPS::Signal::LoadProfileEngine::changedLoads);
 }
@@ -14,13 +14,22 @@
 #include <pybind11/functional.h>
 #include <pybind11/eigen.h>
 #include <pybind11/iostream.h>
+#include <pybind11/numpy.h>
 
 #include <dpsim/Simulation.h>
 #include <dpsim/RealTimeSimulation.h>
+#include <dpsim/InterfaceReplay.h>
+#ifdef HAVE_RECVMMSG
+#include <dpsim/InterfaceUdp.h>
+#endif
+#ifdef HAVE_EPOLL
+#include <dpsim/InterfaceGroup.h>
+#endif
 #include <dpsim-models/IdentifiedObject.h>
 #include <DPsim.h>
 
 #include <dpsim-models/CSVReader.h>
+#include <dpsim-models/MatpowerReader.h>
 
 #include <dpsim/pybind/DPComponents.h>
 #include <dpsim/pybind/EMTComponents.h>
@@ -71,10 +80,87 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("set_scaling_method", &DPsim::DirectLinearSolverConfiguration::setScalingMethod)
 		.def("set_partial_refactorization_method", &DPsim::DirectLinearSolverConfiguration::setPartialRefactorizationMethod)
 		.def("set_btf", &DPsim::DirectLinearSolverConfiguration::setBTF)
+		.def("set_gpu_transfer_method", &DPsim::DirectLinearSolverConfiguration::setGpuTransferMethod)
+		.def("set_iterative_preconditioner", &DPsim::DirectLinearSolverConfiguration::setIterativePreconditioner)
+		.def("set_iterative_tolerance", &DPsim::DirectLinearSolverConfiguration::setIterativeTolerance)
+		.def("set_iterative_max_iterations", &DPsim::DirectLinearSolverConfiguration::setIterativeMaxIterations)
+		.def("set_preconditioner_refresh_iterations", &DPsim::DirectLinearSolverConfiguration::setPreconditionerRefreshIterations)
+		.def("set_factorization_precision", &DPsim::DirectLinearSolverConfiguration::setFactorizationPrecision)
+		.def("set_refinement_steps", &DPsim::DirectLinearSolverConfiguration::setRefinementSteps)
+		.def("set_refinement_tolerance", &DPsim::DirectLinearSolverConfiguration::setRefinementTolerance)
 		.def("get_scaling_method", &DPsim::DirectLinearSolverConfiguration::getScalingMethod)
 		.def("get_fill_in_reduction_method", &DPsim::DirectLinearSolverConfiguration::getFillInReductionMethod)
 		.def("get_partial_refactorization_method", &DPsim::DirectLinearSolverConfiguration::getPartialRefactorizationMethod)
-		.def("get_btf", &DPsim::DirectLinearSolverConfiguration::getBTF);
+		.def("get_btf", &DPsim::DirectLinearSolverConfiguration::getBTF)
+		.def("get_gpu_transfer_method", &DPsim::DirectLinearSolverConfiguration::getGpuTransferMethod)
+		.def("get_iterative_preconditioner", &DPsim::DirectLinearSolverConfiguration::getIterativePreconditioner)
+		.def("get_iterative_tolerance", &DPsim::DirectLinearSolverConfiguration::getIterativeTolerance)
+		.def("get_iterative_max_iterations", &DPsim::DirectLinearSolverConfiguration::getIterativeMaxIterations)
+		.def("get_preconditioner_refresh_iterations", &DPsim::DirectLinearSolverConfiguration::getPreconditionerRefreshIterations)
+		.def("get_factorization_precision", &DPsim::DirectLinearSolverConfiguration::getFactorizationPrecision)
+		.def("get_refinement_steps", &DPsim::DirectLinearSolverConfiguration::getRefinementSteps)
+		.def("get_refinement_tolerance", &DPsim::DirectLinearSolverConfiguration::getRefinementTolerance);
+
+	py::class_<DPsim::Histogram>(m, "Histogram")
+		.def("count", &DPsim::Histogram::count)
+		.def("sum", &DPsim::Histogram::sum)
+		.def("mean", &DPsim::Histogram::mean)
+		.def("min", &DPsim::Histogram::min)
+		.def("max", &DPsim::Histogram::max)
+		.def("percentile", &DPsim::Histogram::percentile, "percent"_a)
+		.def("buckets", &DPsim::Histogram::buckets)
+		.def("reset", &DPsim::Histogram::reset);
+
+	py::class_<DPsim::StepPhases, std::shared_ptr<DPsim::StepPhases>>(m, "StepPhases")
+		.def("attr", [](const DPsim::StepPhases &phases, const CPS::String &name) { return phases.attribute(name); }, "name"_a)
+		.def("names", []() {
+			std::vector<CPS::String> names;
+			for (CPS::UInt phase = 0; phase < DPsim::StepPhases::NumPhases; phase++)
+				names.push_back(DPsim::StepPhases::name(phase));
+			return names;
+		})
+		.def("last", [](const DPsim::StepPhases &phases) {
+			py::dict last;
+			for (CPS::UInt phase = 0; phase < DPsim::StepPhases::NumPhases; phase++)
+				last[DPsim::StepPhases::name(phase)] = **phases.time(static_cast<DPsim::StepPhases::Phase>(phase));
+			return last;
+		})
+		.def("histogram", [](const DPsim::StepPhases &phases, const CPS::String &name) -> const DPsim::Histogram& {
+			for (CPS::UInt phase = 0; phase < DPsim::StepPhases::NumPhases; phase++) {
+				if (name == DPsim::StepPhases::name(phase))
+					return phases.histogram(static_cast<DPsim::StepPhases::Phase>(phase));
+			}
+			throw py::key_error(name);
+		}, "name"_a, py::return_value_policy::reference_internal)
+		.def("reset", &DPsim::StepPhases::reset);
+
+	py::class_<DPsim::EventLog, std::shared_ptr<DPsim::EventLog>>(m, "EventLog")
+		.def(py::init<const CPS::String&, CPS::UInt>(), "filename"_a, "capacity"_a = 1 << 16)
+		.def("record", [](DPsim::EventLog &log, uint32_t code, double value0, double value1, double value2) {
+			log.record(DPsim::EventLog::Type::Custom, code, value0, value1, value2);
+		}, "code"_a, "value0"_a = 0, "value1"_a = 0, "value2"_a = 0)
+		.def("close", &DPsim::EventLog::close)
+		.def("dropped", &DPsim::EventLog::dropped)
+		.def("written", &DPsim::EventLog::written);
+
+	py::class_<DPsim::Executor, std::shared_ptr<DPsim::Executor>>(m, "Executor")
+		.def(py::init<const std::vector<CPS::Int>&>(), "cpus"_a = std::vector<CPS::Int>())
+		.def_static("global_executor", &DPsim::Executor::global)
+		.def("partition", &DPsim::Executor::partition, "cores"_a)
+		.def("split", &DPsim::Executor::split, "parts"_a)
+		.def("cpus", &DPsim::Executor::cpus)
+		.def("concurrency", &DPsim::Executor::concurrency)
+		.def("free_cores", &DPsim::Executor::freeCores);
+
+	py::class_<DPsim::MemoryReport>(m, "MemoryReport")
+		.def("entries", [](const DPsim::MemoryReport &report) {
+			std::vector<std::tuple<CPS::String, CPS::String, std::size_t>> entries;
+			for (auto& entry : report.entries())
+				entries.emplace_back(entry.subsystem, entry.item, entry.bytes);
+			return entries;
+		})
+		.def("total", &DPsim::MemoryReport::total)
+		.def("subsystems", &DPsim::MemoryReport::subsystems);
 
     py::class_<DPsim::Simulation>(m, "Simulation")
 	    .def(py::init<std::string, CPS::Logger::Level>(), "name"_a, "loglevel"_a = CPS::Logger::Level::off)
@@ -83,25 +169,98 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("set_final_time", &DPsim::Simulation::setFinalTime)
 		.def("add_logger", &DPsim::Simulation::addLogger)
 		.def("set_system", &DPsim::Simulation::setSystem)
-		.def("run", &DPsim::Simulation::run)
+		.def("run", &DPsim::Simulation::run, py::call_guard<py::gil_scoped_release>())
 		.def("set_solver", &DPsim::Simulation::setSolverType)
 		.def("set_domain", &DPsim::Simulation::setDomain)
-		.def("start", &DPsim::Simulation::start)
-		.def("next", &DPsim::Simulation::next)
+		.def("initialize", &DPsim::Simulation::initialize, py::call_guard<py::gil_scoped_release>())
+		.def("start", &DPsim::Simulation::start, py::call_guard<py::gil_scoped_release>())
+		.def("next", &DPsim::Simulation::next, py::call_guard<py::gil_scoped_release>())
+		.def("stop", &DPsim::Simulation::stop, py::call_guard<py::gil_scoped_release>())
+		.def("step_n", &DPsim::Simulation::stepN, "count"_a, py::call_guard<py::gil_scoped_release>())
+		.def("step_until", &DPsim::Simulation::stepUntil, "time"_a, py::call_guard<py::gil_scoped_release>())
+		.def("run_async", &DPsim::Simulation::runAsync)
+		.def("cancel_async", &DPsim::Simulation::cancelAsync)
+		.def("wait_async", &DPsim::Simulation::waitAsync, py::call_guard<py::gil_scoped_release>())
+		.def("is_running_async", &DPsim::Simulation::isRunningAsync)
+		.def("time", &DPsim::Simulation::time)
 		.def("get_idobj_attr", &DPsim::Simulation::getIdObjAttribute, "comp"_a, "attr"_a)
 		.def("add_interface", &DPsim::Simulation::addInterface, "interface"_a)
 		.def("log_idobj_attribute", &DPsim::Simulation::logIdObjAttribute, "comp"_a, "attr"_a)
 		.def("log_attribute", &DPsim::Simulation::logAttribute, "name"_a, "attr"_a)
 		.def("do_init_from_nodes_and_terminals", &DPsim::Simulation::doInitFromNodesAndTerminals)
 		.def("do_system_matrix_recomputation", &DPsim::Simulation::doSystemMatrixRecomputation)
+		.def("do_sparse_right_vector_assembly", &DPsim::Simulation::doSparseRightVectorAssembly)
+		.def("do_lazy_switched_matrices", &DPsim::Simulation::doLazySwitchedMatrices)
+		.def("set_switched_matrix_cache_size", &DPsim::Simulation::setSwitchedMatrixCacheSize)
+		.def("do_shared_symbolic_analysis", &DPsim::Simulation::doSharedSymbolicAnalysis)
+		.def("do_switched_matrix_prefetch", &DPsim::Simulation::doSwitchedMatrixPrefetch)
+		.def("do_speculative_factorization", &DPsim::Simulation::doSpeculativeFactorization, "value"_a = true)
+		.def("do_low_rank_system_matrix_updates", &DPsim::Simulation::doLowRankSystemMatrixUpdates)
+		.def("set_low_rank_update_max_rank", &DPsim::Simulation::setLowRankUpdateMaxRank)
+		.def("do_incremental_system_matrix_stamping", &DPsim::Simulation::doIncrementalSystemMatrixStamping)
+		.def("do_incremental_solve", &DPsim::Simulation::doIncrementalSolve)
+		.def("set_incremental_solve_max_rows", &DPsim::Simulation::setIncrementalSolveMaxRows)
+		.def("do_kron_reduction", &DPsim::Simulation::doKronReduction)
+		.def("do_signal_graph_fusion", &DPsim::Simulation::doSignalGraphFusion)
+		.def("do_gpu_resident_step", &DPsim::Simulation::doGpuResidentStep)
+		.def("set_gpu_resident_copy_interval", &DPsim::Simulation::setGpuResidentCopyInterval)
+		.def("do_step_generation", &DPsim::Simulation::doStepGeneration)
+		.def("do_block_parallel_solve", &DPsim::Simulation::doBlockParallelSolve)
+		.def("do_matrix_node_reordering", &DPsim::Simulation::doMatrixNodeReordering)
+		.def("set_max_corrector_iterations", &DPsim::Simulation::setMaxCorrectorIterations)
+		.def("do_parallel_component_initialization", &DPsim::Simulation::doParallelComponentInitialization)
+		.def("do_parallel_switched_matrix_initialization", &DPsim::Simulation::doParallelSwitchedMatrixInitialization)
+		.def("set_task_graph_cache", &DPsim::Simulation::setTaskGraphCache)
+		.def("do_attribute_freezing", &DPsim::Simulation::doAttributeFreezing)
+		.def("do_automatic_scheduling", &DPsim::Simulation::doAutomaticScheduling, "warmup_steps"_a = 200, "max_threads"_a = 0)
+		.def("observe_nodes", &DPsim::Simulation::observeNodes, "names"_a)
+		.def("observed_values", [](const DPsim::Simulation &sim) { return CPS::AttributeBase::Ptr(sim.mObservedValues); })
+		.def("do_step_phase_profiling", &DPsim::Simulation::doStepPhaseProfiling)
+		.def("set_event_log", &DPsim::Simulation::setEventLog)
+		.def("set_executor", &DPsim::Simulation::setExecutor)
+		.def("do_attribute_arena", &DPsim::Simulation::doAttributeArena)
+		.def("do_numa_local_subnets", &DPsim::Simulation::doNumaLocalSubnets)
+		.def("do_object_pooling", &DPsim::Simulation::doObjectPooling)
+		.def("do_power_flow_warm_start", &DPsim::Simulation::doPowerFlowWarmStart)
+		.def("do_power_flow_jacobian_reuse", &DPsim::Simulation::doPowerFlowJacobianReuse)
+		.def("set_lim_latency_factor", &DPsim::Simulation::setLimLatencyFactor)
+		.def("add_sensitivity_parameter", &DPsim::Simulation::addSensitivityParameter, "key"_a, "perturbation"_a = 1e-6)
+		.def("do_implicit_ode_integration", &DPsim::Simulation::doImplicitODEIntegration)
+		.def("set_ode_linear_solver", &DPsim::Simulation::setODELinearSolver)
+		.def("do_parallel_dae_residual", &DPsim::Simulation::doParallelDAEResidual)
+		.def("do_aggregated_ode_integration", &DPsim::Simulation::doAggregatedODEIntegration)
 		.def("do_steady_state_init", &DPsim::Simulation::doSteadyStateInit)
+		.def("set_steady_state_init_extrapolation_depth", &DPsim::Simulation::setSteadStIniExtrapolationDepth)
 		.def("do_frequency_parallelization", &DPsim::Simulation::doFrequencyParallelization)
+		.def("set_harmonic_drop_tolerance", &DPsim::Simulation::setHarmonicDropTolerance)
+		.def("do_quasi_dynamic_mode", &DPsim::Simulation::doQuasiDynamicMode)
+		.def("do_sharded_logging", &DPsim::Simulation::doShardedLogging, "value"_a = true)
+		.def("save_checkpoint", [](DPsim::Simulation &sim, const std::string &filename) { sim.saveCheckpoint(filename); }, "filename"_a)
+		.def("load_checkpoint", [](DPsim::Simulation &sim, const std::string &filename) { sim.loadCheckpoint(filename); }, "filename"_a)
+		.def("reset", &DPsim::Simulation::reset, "start_time"_a = 0, "parameters"_a = std::map<CPS::String, CPS::Real>())
+		.def("fork", &DPsim::Simulation::fork, "name"_a = "")
+		.def("edit_topology", &DPsim::Simulation::editTopology, "added"_a, "removed"_a = std::vector<CPS::String>())
 		.def("set_tearing_components", &DPsim::Simulation::setTearingComponents)
+		.def("do_automatic_tearing", &DPsim::Simulation::doAutomaticTearing)
+		.def("do_automatic_line_decoupling", &DPsim::Simulation::doAutomaticLineDecoupling)
+		.def("set_time_step_multiple", &DPsim::Simulation::setTimeStepMultiple, "name"_a, "multiple"_a)
+		.def("set_default_time_step_multiple", &DPsim::Simulation::setDefaultTimeStepMultiple)
+		.def("do_event_interpolation", &DPsim::Simulation::doEventInterpolation, "value"_a = true)
+		.def("set_shift_frequency_tracking", &DPsim::Simulation::setShiftFrequencyTracking, "frequency"_a, "tolerance"_a = 0.05)
+		.def("shift_frequency", &DPsim::Simulation::shiftFrequency)
+		.def("shift_angle", &DPsim::Simulation::shiftAngle)
+		.def("do_adaptive_time_stepping", &DPsim::Simulation::doAdaptiveTimeStepping,
+			"max_level"_a, "rel_tol"_a = 1e-3, "abs_tol"_a = 1e-6, "hold_steps"_a = 10)
 		.def("add_event", &DPsim::Simulation::addEvent)
+		.def("inject_event", &DPsim::Simulation::injectEvent)
 		.def("set_solver_component_behaviour", &DPsim::Simulation::setSolverAndComponentBehaviour)
 		.def("set_direct_solver_implementation", &DPsim::Simulation::setDirectLinearSolverImplementation)
 		.def("set_direct_linear_solver_configuration", &DPsim::Simulation::setDirectLinearSolverConfiguration)
-		.def("log_lu_times", &DPsim::Simulation::logLUTimes);
+		.def("log_lu_times", &DPsim::Simulation::logLUTimes)
+		.def("step_times", &DPsim::Simulation::stepTimes, py::return_value_policy::reference_internal)
+		.def("step_phases", &DPsim::Simulation::stepPhases)
+		.def("event_log", &DPsim::Simulation::eventLog)
+		.def("memory_report", &DPsim::Simulation::memoryReport);
 
 	py::class_<DPsim::RealTimeSimulation, DPsim::Simulation>(m, "RealTimeSimulation")
 		.def(py::init<std::string, CPS::Logger::Level>(), "name"_a, "loglevel"_a = CPS::Logger::Level::info)
@@ -110,9 +269,20 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("set_final_time", &DPsim::RealTimeSimulation::setFinalTime)
 		.def("add_logger", &DPsim::RealTimeSimulation::addLogger)
 		.def("set_system", &DPsim::RealTimeSimulation::setSystem)
-		.def("run", static_cast<void (DPsim::RealTimeSimulation::*)(CPS::Int startIn)>(&DPsim::RealTimeSimulation::run))
+		.def("run", static_cast<void (DPsim::RealTimeSimulation::*)(CPS::Int startIn)>(&DPsim::RealTimeSimulation::run), py::call_guard<py::gil_scoped_release>())
 		.def("set_solver", &DPsim::RealTimeSimulation::setSolverType)
-		.def("set_domain", &DPsim::RealTimeSimulation::setDomain);
+		.def("set_domain", &DPsim::RealTimeSimulation::setDomain)
+		.def("set_busy_wait", &DPsim::RealTimeSimulation::setBusyWait, "busy_wait"_a = true)
+		.def("set_realtime_priority", &DPsim::RealTimeSimulation::setRealTimePriority)
+		.def("set_lock_memory", &DPsim::RealTimeSimulation::setLockMemory, "lock"_a = true)
+		.def("set_warm_up", &DPsim::RealTimeSimulation::setWarmUp, "steps"_a)
+		.def("set_track_allocations", &DPsim::RealTimeSimulation::setTrackAllocations, "track"_a = true)
+		.def("add_degradation_policy", &DPsim::RealTimeSimulation::addDegradationPolicy, "name"_a, "threshold"_a, "engage"_a, "release"_a)
+		.def("add_logger_pause_policy", &DPsim::RealTimeSimulation::addLoggerPausePolicy, "threshold"_a)
+		.def("add_logger_downsampling_policy", &DPsim::RealTimeSimulation::addLoggerDownsamplingPolicy, "threshold"_a, "factor"_a)
+		.def("add_freeze_policy", &DPsim::RealTimeSimulation::addFreezePolicy, "threshold"_a)
+		.def("add_export_suspend_policy", &DPsim::RealTimeSimulation::addExportSuspendPolicy, "interface"_a, "threshold"_a)
+		.def("set_degradation_hysteresis", &DPsim::RealTimeSimulation::setDegradationHysteresis, "engage_steps"_a, "release_steps"_a, "margin"_a);
 
 	py::class_<CPS::SystemTopology, std::shared_ptr<CPS::SystemTopology>>(m, "SystemTopology")
         .def(py::init<CPS::Real, CPS::TopologicalNode::List, CPS::IdentifiedObject::List>())
@@ -126,6 +296,8 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("connect_component", py::overload_cast<CPS::SimPowerComp<CPS::Complex>::Ptr, CPS::SimNode<CPS::Complex>::List>(&DPsim::SystemTopology::connectComponentToNodes<CPS::Complex>))
 		.def("component", &DPsim::SystemTopology::component<CPS::TopologicalPowerComp>)
 		.def("add_tear_component", &DPsim::SystemTopology::addTearComponent)
+		.def("multiply", &DPsim::SystemTopology::multiply, "number_copies"_a, "parallel"_a = false)
+		.def_static("random_interconnections", &DPsim::SystemTopology::randomInterconnections, "number_copies"_a, "node_names"_a, "count"_a, "seed"_a = 0)
 #ifdef WITH_GRAPHVIZ
 		.def("_repr_svg_", &DPsim::SystemTopology::render)
 		.def("render_to_file", &DPsim::SystemTopology::renderToFile)
@@ -136,12 +308,133 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("list_idobjects", &DPsim::SystemTopology::listIdObjects)
 		.def("init_with_powerflow", &DPsim::SystemTopology::initWithPowerflow);
 
-	py::class_<DPsim::Interface, std::shared_ptr<DPsim::Interface>>(m, "Interface");
+	py::class_<DPsim::TaskGraphCache, std::shared_ptr<DPsim::TaskGraphCache>>(m, "TaskGraphCache")
+		.def(py::init([](const std::string& directory) { return std::make_shared<DPsim::TaskGraphCache>(directory); }), "directory"_a = "")
+		.def("hits", &DPsim::TaskGraphCache::hits)
+		.def("misses", &DPsim::TaskGraphCache::misses);
+
+	py::class_<DPsim::ModelTemplate, std::shared_ptr<DPsim::ModelTemplate>>(m, "ModelTemplate")
+		.def(py::init<std::string, const CPS::SystemTopology&, CPS::Logger::Level>(), "name"_a, "topology"_a, "loglevel"_a = CPS::Logger::Level::info)
+		.def("instantiate", py::overload_cast<>(&DPsim::ModelTemplate::instantiate, py::const_))
+		.def("instantiate", py::overload_cast<CPS::UInt, CPS::Bool>(&DPsim::ModelTemplate::instantiate, py::const_), "count"_a, "parallel"_a = false)
+		.def("scenario_bytes", &DPsim::ModelTemplate::scenarioBytes)
+		.def("name", &DPsim::ModelTemplate::name);
+
+	py::class_<DPsim::Interface, std::shared_ptr<DPsim::Interface>>(m, "Interface")
+		.def("set_synchronous", &DPsim::Interface::setSynchronous, "value"_a = true) // cppcheck-suppress assignBoolToPointer
+		.def("set_exports_suspended", &DPsim::Interface::setExportsSuspended, "value"_a)
+		.def("set_import_deadline", &DPsim::Interface::setImportDeadline, "deadline"_a, "order"_a = 1)
+		.def_property_readonly("extrapolated_imports", &DPsim::Interface::extrapolatedImports)
+		.def("record_imports", &DPsim::Interface::recordImports, "filename"_a);
+
+	py::class_<DPsim::InterfaceReplay, DPsim::Interface, std::shared_ptr<DPsim::InterfaceReplay>>(m, "InterfaceReplay")
+		.def(py::init<const CPS::String&, CPS::Real, const CPS::String&, CPS::UInt>(), "filename"_a, "real_time_step"_a = 0, "name"_a = "", "downsampling"_a = 1)
+		.def("import_attribute", &DPsim::InterfaceReplay::importAttribute, "attr"_a, "block_on_read"_a = false, "sync_on_start"_a = true, "downsampling"_a = 0) // cppcheck-suppress assignBoolToPointer
+		.def("export_attribute", &DPsim::InterfaceReplay::exportAttribute, "attr"_a, "downsampling"_a = 0);
+
+#ifdef HAVE_RECVMMSG
+	py::class_<DPsim::InterfaceUdp, DPsim::Interface, std::shared_ptr<DPsim::InterfaceUdp>>(m, "InterfaceUdp")
+		.def(py::init<const CPS::String&, CPS::UInt, const CPS::String&, CPS::UInt, const CPS::String&, CPS::UInt>(),
+			"local_address"_a, "local_port"_a, "remote_address"_a, "remote_port"_a, "name"_a = "", "downsampling"_a = 1)
+		.def("import_attribute", &DPsim::InterfaceUdp::importAttribute, "attr"_a, "block_on_read"_a = false, "sync_on_start"_a = true, "downsampling"_a = 0) // cppcheck-suppress assignBoolToPointer
+		.def("export_attribute", &DPsim::InterfaceUdp::exportAttribute, "attr"_a, "downsampling"_a = 0, "deadband"_a = 0, "on_change"_a = false) // cppcheck-suppress assignBoolToPointer
+		.def("set_busy_poll", &DPsim::InterfaceUdp::setBusyPoll, "microseconds"_a)
+		.def("set_send_batch", &DPsim::InterfaceUdp::setSendBatch, "frames"_a);
+#endif
+
+#ifdef HAVE_EPOLL
+	py::class_<DPsim::InterfaceGroup, std::shared_ptr<DPsim::InterfaceGroup>>(m, "InterfaceGroup")
+		.def(py::init<>())
+		.def("add_interface", &DPsim::InterfaceGroup::addInterface, "interface"_a);
+#endif
+
+	py::class_<DPsim::DataLoggerBackend, std::shared_ptr<DPsim::DataLoggerBackend>>(m, "LoggerBackend");
+	py::class_<DPsim::CSVLoggerBackend, DPsim::DataLoggerBackend, std::shared_ptr<DPsim::CSVLoggerBackend>>(m, "CSVLoggerBackend")
+		.def(py::init<>());
+	py::class_<DPsim::BinaryLoggerBackend, DPsim::DataLoggerBackend, std::shared_ptr<DPsim::BinaryLoggerBackend>>(m, "BinaryLoggerBackend")
+		.def(py::init<CPS::UInt>(), "buffer_rows"_a = 1024);
+	py::class_<DPsim::CompressedLoggerBackend, DPsim::DataLoggerBackend, std::shared_ptr<DPsim::CompressedLoggerBackend>>(m, "CompressedLoggerBackend")
+		.def(py::init<CPS::UInt>(), "chunk_rows"_a = 4096);
+#ifdef WITH_HDF5
+	py::class_<DPsim::HDF5LoggerBackend, DPsim::DataLoggerBackend, std::shared_ptr<DPsim::HDF5LoggerBackend>>(m, "HDF5LoggerBackend")
+		.def(py::init<CPS::UInt>(), "chunk_rows"_a = 4096);
+#endif
+#ifdef HAVE_SHM_OPEN
+	py::class_<DPsim::SharedMemoryLoggerBackend, DPsim::DataLoggerBackend, std::shared_ptr<DPsim::SharedMemoryLoggerBackend>>(m, "SharedMemoryLoggerBackend")
+		.def(py::init<CPS::UInt>(), "capacity"_a = 65536);
+#endif
+
+	py::class_<DPsim::MemoryLoggerBackend, DPsim::DataLoggerBackend, std::shared_ptr<DPsim::MemoryLoggerBackend>>(m, "MemoryLoggerBackend")
+		.def(py::init<CPS::UInt>(), "capacity"_a = 65536)
+		.def_property_readonly("column_names", &DPsim::MemoryLoggerBackend::columnNames)
+		.def_property_readonly("rows_written", &DPsim::MemoryLoggerBackend::rowsWritten)
+		.def_property_readonly("first_slot", &DPsim::MemoryLoggerBackend::firstSlot)
+		// View of the whole ring buffer without copying, row n is in slot n % capacity
+		.def("ring", [](const DPsim::MemoryLoggerBackend &backend) {
+			auto buffer = backend.buffer();
+			auto owner = new DPsim::MemoryLoggerBackend::Buffer(buffer);
+			py::capsule base(owner, [](void *ptr) { delete static_cast<DPsim::MemoryLoggerBackend::Buffer*>(ptr); });
+			py::ssize_t columns = backend.columns();
+			py::ssize_t rows = columns > 0 ? static_cast<py::ssize_t>(buffer->size()) / columns : 0;
+			return py::array_t<CPS::Real>({ rows, columns }, buffer->data(), base);
+		})
+		// Rows held in chronological order, a view unless the ring has wrapped around
+		.def("data", [](const DPsim::MemoryLoggerBackend &backend) {
+			auto buffer = backend.buffer();
+			auto owner = new DPsim::MemoryLoggerBackend::Buffer(buffer);
+			py::capsule base(owner, [](void *ptr) { delete static_cast<DPsim::MemoryLoggerBackend::Buffer*>(ptr); });
+			py::ssize_t columns = backend.columns();
+			py::ssize_t rows = backend.rows();
+			py::ssize_t first = backend.firstSlot();
+			if (first == 0)
+				return py::array_t<CPS::Real>({ rows, columns }, buffer->data(), base);
+
+			// The ring is full, the oldest row is in the first slot
+			py::array_t<CPS::Real> ordered({ rows, columns });
+			std::rotate_copy(buffer->begin(), buffer->begin() + first * columns, buffer->end(), ordered.mutable_data());
+			return ordered;
+		});
+
+	py::class_<DPsim::ColumnarLoggerBackend, DPsim::DataLoggerBackend, std::shared_ptr<DPsim::ColumnarLoggerBackend>>(m, "ColumnarLoggerBackend")
+		.def(py::init<CPS::UInt>(), "initial_rows"_a = 1024)
+		.def_property_readonly("column_names", &DPsim::ColumnarLoggerBackend::columnNames)
+		.def_property_readonly("rows", &DPsim::ColumnarLoggerBackend::rows)
+		// Columns by name as views of the storage without copying
+		.def("to_dict", [](const DPsim::ColumnarLoggerBackend &backend) {
+			auto storage = backend.storage();
+			py::capsule base(new DPsim::ColumnarLoggerBackend::StoragePtr(storage),
+				[](void *ptr) { delete static_cast<DPsim::ColumnarLoggerBackend::StoragePtr*>(ptr); });
+			py::dict columns;
+			for (CPS::UInt c = 0; c < backend.columnNames().size(); ++c)
+				columns[py::str(backend.columnNames()[c])] = py::array_t<CPS::Real>(backend.rows(), storage->column(c), base);
+			return columns;
+		})
+		.def("to_dataframe", [](py::object backend) {
+			auto frame = py::module_::import("pandas").attr("DataFrame")(backend.attr("to_dict")());
+			return frame.attr("set_index")("time");
+		});
 
 	py::class_<DPsim::DataLogger, std::shared_ptr<DPsim::DataLogger>>(m, "Logger")
         .def(py::init<std::string>())
+		.def(py::init<std::string, CPS::Bool, CPS::UInt, DPsim::DataLoggerBackend::Ptr>(), "name"_a, "enabled"_a = true, "downsampling"_a = 1, "backend"_a = nullptr)
+		.def("set_async", &DPsim::DataLogger::setAsync, "block_rows"_a = 1024, "blocks"_a = 4)
+		.def("set_decimation", &DPsim::DataLogger::setDecimation, "mode"_a)
+		.def("set_trigger_window", &DPsim::DataLogger::setTriggerWindow, "pre_rows"_a, "post_rows"_a, "log_outside"_a = false)
+		.def("add_trigger_time", &DPsim::DataLogger::addTriggerTime, "time"_a)
+		.def("add_threshold_trigger", &DPsim::DataLogger::addThresholdTrigger, "column"_a, "threshold"_a, "edge"_a = DPsim::DataLogger::Edge::Both)
+		.def("trigger", &DPsim::DataLogger::trigger)
+		.def("set_paused", &DPsim::DataLogger::setPaused, "paused"_a)
+		.def("set_log_on_change", &DPsim::DataLogger::setLogOnChange, "value"_a)
+		.def("set_downsampling", &DPsim::DataLogger::setDownsampling, "downsampling"_a)
+		.def("set_output_grid", &DPsim::DataLogger::setOutputGrid, "interval"_a)
+		.def("reserve_steps", &DPsim::DataLogger::reserveSteps, "steps"_a)
+		.def("name", &DPsim::DataLogger::name)
+		.def_property_readonly("backend", &DPsim::DataLogger::backend)
+		.def_static("set_default_backend", &DPsim::DataLogger::setDefaultBackend, "factory"_a)
 		.def_static("set_log_dir", &CPS::Logger::setLogDir)
 		.def_static("get_log_dir", &CPS::Logger::logDir)
+		.def_static("set_matrix_log_limit", &CPS::Logger::setMatrixLogLimit, "entries"_a)
+		.def_static("set_matrix_dump_limit", &CPS::Logger::setMatrixDumpLimit, "non_zeros"_a)
 		.def("log_attribute", py::overload_cast<const CPS::String&, CPS::AttributeBase::Ptr, CPS::UInt, CPS::UInt>(&DPsim::DataLogger::logAttribute), "name"_a, "attr"_a, "max_cols"_a = 0, "max_rows"_a = 0)
 		/// Compatibility method. Might be removed later when the python examples have been fully adapted.
 		.def("log_attribute", py::overload_cast<const std::vector<CPS::String>&, CPS::AttributeBase::Ptr>(&DPsim::DataLogger::logAttribute), "names"_a, "attr"_a)
@@ -203,17 +496,31 @@ PYBIND11_MODULE(dpsimpy, m) {
 	py::enum_<DPsim::Solver::Type>(m, "Solver")
 		.value("MNA", DPsim::Solver::Type::MNA)
 		.value("DAE", DPsim::Solver::Type::DAE)
-		.value("NRP", DPsim::Solver::Type::NRP);
+		.value("NRP", DPsim::Solver::Type::NRP)
+		.value("FDP", DPsim::Solver::Type::FDP)
+		.value("DCP", DPsim::Solver::Type::DCP)
+		.value("SWP", DPsim::Solver::Type::SWP)
+		.value("LIM", DPsim::Solver::Type::LIM);
 
 	py::enum_<DPsim::DirectLinearSolverImpl>(m, "DirectLinearSolverImpl")
 		.value("Undef", DPsim::DirectLinearSolverImpl::Undef)
 		.value("DenseLU", DPsim::DirectLinearSolverImpl::DenseLU)
+		.value("DenseInverse", DPsim::DirectLinearSolverImpl::DenseInverse)
 		.value("SparseLU", DPsim::DirectLinearSolverImpl::SparseLU)
+		.value("ParallelSparseLU", DPsim::DirectLinearSolverImpl::ParallelSparseLU)
+		.value("Iterative", DPsim::DirectLinearSolverImpl::Iterative)
+		.value("ComplexSparseLU", DPsim::DirectLinearSolverImpl::ComplexSparseLU)
+		.value("Auto", DPsim::DirectLinearSolverImpl::Auto)
 		.value("KLU", DPsim::DirectLinearSolverImpl::KLU)
 		.value("CUDADense", DPsim::DirectLinearSolverImpl::CUDADense)
 		.value("CUDASparse", DPsim::DirectLinearSolverImpl::CUDASparse)
 		.value("CUDAMagma", DPsim::DirectLinearSolverImpl::CUDAMagma);
 
+	py::enum_<DPsim::SundialsLinearSolver>(m, "SundialsLinearSolver")
+		.value("Dense", DPsim::SundialsLinearSolver::Dense)
+		.value("SparseKLU", DPsim::SundialsLinearSolver::SparseKLU)
+		.value("GMRES", DPsim::SundialsLinearSolver::GMRES);
+
 	py::enum_<DPsim::SCALING_METHOD>(m, "scaling_method")
 		.value("no_scaling", DPsim::SCALING_METHOD::NO_SCALING)
 		.value("sum_scaling", DPsim::SCALING_METHOD::SUM_SCALING)
@@ -234,6 +541,30 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.value("no_btf", DPsim::USE_BTF::NO_BTF)
 		.value("do_btf", DPsim::USE_BTF::DO_BTF);
 
+	py::enum_<DPsim::GPU_TRANSFER_METHOD>(m, "gpu_transfer_method")
+		.value("synchronous", DPsim::GPU_TRANSFER_METHOD::SYNCHRONOUS)
+		.value("pinned_async", DPsim::GPU_TRANSFER_METHOD::PINNED_ASYNC)
+		.value("pinned_async_graph", DPsim::GPU_TRANSFER_METHOD::PINNED_ASYNC_GRAPH);
+
+	py::enum_<DPsim::ITERATIVE_PRECONDITIONER>(m, "iterative_preconditioner")
+		.value("ilut", DPsim::ITERATIVE_PRECONDITIONER::ILUT)
+		.value("lu", DPsim::ITERATIVE_PRECONDITIONER::LU);
+
+	py::enum_<DPsim::FACTORIZATION_PRECISION>(m, "factorization_precision")
+		.value("double", DPsim::FACTORIZATION_PRECISION::DOUBLE)
+		.value("mixed", DPsim::FACTORIZATION_PRECISION::MIXED);
+
+	py::enum_<DPsim::DataLogger::Decimation>(m, "LoggerDecimation")
+		.value("Sample", DPsim::DataLogger::Decimation::Sample)
+		.value("Mean", DPsim::DataLogger::Decimation::Mean)
+		.value("Min", DPsim::DataLogger::Decimation::Min)
+		.value("Max", DPsim::DataLogger::Decimation::Max);
+
+	py::enum_<DPsim::DataLogger::Edge>(m, "LoggerEdge")
+		.value("Rising", DPsim::DataLogger::Edge::Rising)
+		.value("Falling", DPsim::DataLogger::Edge::Falling)
+		.value("Both", DPsim::DataLogger::Edge::Both);
+
 	py::enum_<CPS::CSVReader::Mode>(m, "CSVReaderMode")
 		.value("AUTO", CPS::CSVReader::Mode::AUTO)
 		.value("MANUAL", CPS::CSVReader::Mode::MANUAL);
@@ -247,12 +578,39 @@ PYBIND11_MODULE(dpsimpy, m) {
 #ifdef WITH_CIM
 	py::class_<CPS::CIM::Reader>(m, "CIMReader")
 		.def(py::init<std::string, CPS::Logger::Level, CPS::Logger::Level>(), "name"_a, "loglevel"_a = CPS::Logger::Level::info, "comploglevel"_a = CPS::Logger::Level::off)
-		.def("loadCIM", (CPS::SystemTopology (CPS::CIM::Reader::*)(CPS::Real, const std::list<CPS::String> &, CPS::Domain, CPS::PhaseType, CPS::GeneratorType)) &CPS::CIM::Reader::loadCIM);
+		.def("loadCIM", (CPS::SystemTopology (CPS::CIM::Reader::*)(CPS::Real, const std::list<CPS::String> &, CPS::Domain, CPS::PhaseType, CPS::GeneratorType)) &CPS::CIM::Reader::loadCIM)
+		.def("updateCIM", (CPS::TopologicalPowerComp::List (CPS::CIM::Reader::*)(const std::list<CPS::String> &)) &CPS::CIM::Reader::updateCIM)
+		.def("set_cache_directory", [](CPS::CIM::Reader &reader, const std::string &directory) { reader.setCacheDirectory(directory); }, "directory"_a);
 #endif
 
 	py::class_<CPS::CSVReader>(m, "CSVReader")
 		.def(py::init<std::string, const std::string &, std::map<std::string, std::string> &, CPS::Logger::Level>())
-		.def("assignLoadProfile", &CPS::CSVReader::assignLoadProfile);
+		.def("assignLoadProfile", &CPS::CSVReader::assignLoadProfile)
+		.def("do_stream_load_profiles", &CPS::CSVReader::doStreamLoadProfiles, "value"_a = true, "window_rows"_a = 1024)
+		.def("set_load_profile_engine", &CPS::CSVReader::setLoadProfileEngine, "engine"_a);
+
+	py::class_<CPS::MatpowerReader::Case>(m, "MatpowerCase")
+		.def(py::init<>())
+		.def_readwrite("base_mva", &CPS::MatpowerReader::Case::baseMVA)
+		.def_readwrite("bus", &CPS::MatpowerReader::Case::bus)
+		.def_readwrite("gen", &CPS::MatpowerReader::Case::gen)
+		.def_readwrite("branch", &CPS::MatpowerReader::Case::branch);
+
+	py::class_<CPS::MatpowerReader>(m, "MatpowerReader")
+		.def(py::init<std::string, CPS::Logger::Level, CPS::Logger::Level>(), "name"_a = "MatpowerReader", "loglevel"_a = CPS::Logger::Level::info, "comploglevel"_a = CPS::Logger::Level::off)
+		.def("set_frequency", &CPS::MatpowerReader::setFrequency)
+		.def("read_case", [](CPS::MatpowerReader &reader, const std::string &file) { return reader.readCase(file); }, "file"_a)
+		.def("load_case", [](CPS::MatpowerReader &reader, const std::string &file) { return reader.loadCase(file); }, "file"_a)
+		.def("create_system", &CPS::MatpowerReader::createSystem, "case"_a)
+		// Creates all components from the arrays of a case in one call
+		.def("create_system", [](CPS::MatpowerReader &reader, CPS::Real baseMVA, const CPS::Matrix &bus, const CPS::Matrix &gen, const CPS::Matrix &branch) {
+				CPS::MatpowerReader::Case data;
+				data.baseMVA = baseMVA;
+				data.bus = bus;
+				data.gen = gen;
+				data.branch = branch;
+				return reader.createSystem(data);
+			}, "base_mva"_a, "bus"_a, "gen"_a, "branch"_a);
 
 	//Base Classes
 
@@ -280,11 +638,14 @@ PYBIND11_MODULE(dpsimpy, m) {
 
 	//Events
 	py::module mEvent = m.def_submodule("event", "events");
-	py::class_<DPsim::Event, std::shared_ptr<DPsim::Event>>(mEvent, "Event");
+	py::class_<DPsim::Event, std::shared_ptr<DPsim::Event>>(mEvent, "Event")
+		.def("time", &DPsim::Event::time);
 	py::class_<DPsim::SwitchEvent, std::shared_ptr<DPsim::SwitchEvent>, DPsim::Event>(mEvent, "SwitchEvent", py::multiple_inheritance())
 		.def(py::init<CPS::Real,const std::shared_ptr<CPS::Base::Ph1::Switch>,CPS::Bool>());
 	py::class_<DPsim::SwitchEvent3Ph, std::shared_ptr<DPsim::SwitchEvent3Ph>, DPsim::Event>(mEvent, "SwitchEvent3Ph", py::multiple_inheritance())
 		.def(py::init<CPS::Real,const std::shared_ptr<CPS::Base::Ph3::Switch>,CPS::Bool>());
+	py::class_<DPsim::ConverterFidelityEvent, std::shared_ptr<DPsim::ConverterFidelityEvent>, DPsim::Event>(mEvent, "ConverterFidelityEvent", py::multiple_inheritance())
+		.def(py::init<CPS::Real,const std::shared_ptr<CPS::Base::Converter>,CPS::Base::Converter::Fidelity>());
 
 	//Components
 	py::module mBase = m.def_submodule("base", "base models");
@@ -303,6 +664,12 @@ PYBIND11_MODULE(dpsimpy, m) {
 	py::module mSignal = m.def_submodule("signal", "signal models");
 	addSignalComponents(mSignal);
 
+#ifdef HAVE_SHM_OPEN
+	// Registered after the signal components, which define the channel base class
+	py::class_<DPsim::ShmemLink, CPS::Signal::DecouplingLineChannel, std::shared_ptr<DPsim::ShmemLink>>(m, "ShmemLink")
+		.def(py::init<const CPS::String&, CPS::UInt, CPS::UInt, CPS::UInt>(), "name"_a, "side"_a, "values"_a = 4, "capacity"_a = 1024);
+#endif
+
 
 #ifdef VERSION_INFO
     m.attr("__version__") = VERSION_INFO;
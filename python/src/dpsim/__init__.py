@@ -1,9 +1,15 @@
 from . import matpower
 from .matpower import Reader
+from . import compressed
+from . import shards
+from . import shmlogger
+from .shmlogger import SharedMemoryReader
+from . import sweep
+from . import eventlog
 
 try:
     from dpsimpy import *
 except ImportError:  # pragma: no cover
     print('Error: Could not find dpsim C++ module.')
 
-__all__ = ['matpower']
+__all__ = ['matpower', 'compressed', 'shards', 'shmlogger', 'sweep', 'eventlog']
@@ -0,0 +1,64 @@
+import struct
+
+import numpy as np
+
+def _decode_column(data, rows):
+    """Decodes the XOR coded bit stream of a column chunk into a list of floats"""
+    position = 0
+
+    def read(bits):
+        nonlocal position
+        start, end = position >> 3, (position + bits + 7) >> 3
+        word = int.from_bytes(data[start:end], 'big')
+        shift = end * 8 - position - bits
+        position += bits
+        return (word >> shift) & ((1 << bits) - 1)
+
+    if rows == 0:
+        return []
+
+    previous = read(64)
+    words = [previous]
+    leading, trailing = 64, 0
+    for _ in range(rows - 1):
+        if read(1) == 0:
+            words.append(previous)
+            continue
+        if read(1) == 1:
+            leading = read(5)
+            significant = read(6) or 64
+            trailing = 64 - leading - significant
+        delta = read(64 - leading - trailing) << trailing
+        previous ^= delta
+        words.append(previous)
+
+    return list(struct.unpack('<%dd' % rows, struct.pack('<%dQ' % rows, *words)))
+
+def read(filename):
+    """Reads a file of a logger with a CompressedLoggerBackend.
+
+    Returns a dict of numpy arrays with the column names as keys, including the time.
+    """
+    with open(filename, 'rb') as f:
+        content = f.read()
+
+    if content[:8] != b'DPSIMXOR':
+        raise ValueError('Not a compressed DPsim log: ' + str(filename))
+    version, num_columns, names_size = struct.unpack_from('<III', content, 8)
+    if version != 1:
+        raise ValueError('Unsupported compressed DPsim log version %d' % version)
+    offset = 20
+    names = content[offset:offset + names_size].decode().split(',')
+    offset += names_size
+
+    columns = [[] for _ in range(num_columns)]
+    while offset < len(content):
+        rows, = struct.unpack_from('<I', content, offset)
+        offset += 4
+        for column in columns:
+            size, = struct.unpack_from('<I', content, offset)
+            offset += 4
+            column.extend(_decode_column(content[offset:offset + size], rows))
+            offset += size
+
+    return { name: np.array(column) for name, column in zip(names, columns) }
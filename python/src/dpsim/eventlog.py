@@ -0,0 +1,70 @@
+import struct
+
+import numpy as np
+
+# Layout of the header and of EventLog::Record
+_HEADER = struct.Struct('<8sII')
+RECORD = np.dtype([
+    ('time', '<f8'),
+    ('step', '<i8'),
+    ('type', '<u4'),
+    ('code', '<u4'),
+    ('values', '<f8', (3,)),
+])
+
+# EventLog::Type
+SWITCH_CHANGE = 1
+RECOMPUTATION = 2
+PIVOT_FAULT = 3
+TIMING = 4
+CUSTOM = 5
+
+TYPES = {
+    SWITCH_CHANGE: 'switch_change',
+    RECOMPUTATION: 'recomputation',
+    PIVOT_FAULT: 'pivot_fault',
+    TIMING: 'timing',
+    CUSTOM: 'custom',
+}
+
+# EventLog::Timer, the code of timing records
+TIMERS = {0: 'step', 1: 'factorization', 2: 'recomputation', 3: 'solve'}
+
+def read(path):
+    """Reads the records of an event log as numpy structured array with the
+    fields time, step, type, code and values.
+
+    Records of a log that is still written are returned up to the last complete one.
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+    if len(data) < _HEADER.size:
+        raise ValueError('Not an event log: ' + path)
+
+    magic, version, record_size = _HEADER.unpack_from(data, 0)
+    if magic != b'DPSIMEVT' or version != 1 or record_size != RECORD.itemsize:
+        raise ValueError('Unsupported event log: ' + path)
+
+    count = (len(data) - _HEADER.size) // record_size
+    return np.frombuffer(data, dtype = RECORD, count = count, offset = _HEADER.size)
+
+def select(records, type, code = None):
+    """Returns the records of the type, e.g. TIMING, and optionally the code"""
+    mask = records['type'] == type
+    if code is not None:
+        mask &= records['code'] == code
+    return records[mask]
+
+def to_dataframe(records):
+    """Converts the records to a pandas DataFrame with one column per value and the type names"""
+    import pandas as pd
+
+    df = pd.DataFrame({
+        'time': records['time'],
+        'step': records['step'],
+        'type': [TYPES.get(t, str(t)) for t in records['type']],
+        'code': records['code'],
+    })
+    for i in range(records['values'].shape[1]):
+        df['value' + str(i)] = records['values'][:, i]
+    return df
@@ -242,25 +242,14 @@ class Reader:
 
     def load_mpc(self):
 
-        dpsimpy_busses_dict, dpsimpy_comp_dict = self.create_dpsim_objects()
-
-        system_comp = []
-        system_nodes = []
-
-        for key, value in dpsimpy_comp_dict.items():
-            dpsimpy_component = value[0]
-            connection_nodes = value[1]
-            dpsimpy_component.connect(connection_nodes)
-
-            system_comp.append(dpsimpy_component)
-
-            for n in connection_nodes:
-                if n in system_nodes:
-                    continue
-                else:
-                    system_nodes.append(n)
+        self.process_mpc()
 
-        system = dpsimpy.SystemTopology(self.mpc_freq, system_nodes, system_comp)
+        # all components are created natively in one call from the case arrays
+        reader = dpsimpy.MatpowerReader()
+        reader.set_frequency(self.mpc_freq)
+        system = reader.create_system(float(self.mpc_base_power_MVA),
+                                      self.mpc_bus_data.to_numpy(dtype=float),
+                                      self.mpc_gen_data.to_numpy(dtype=float),
+                                      self.mpc_branch_data.to_numpy(dtype=float))
 
         return system
-
@@ -0,0 +1,35 @@
+import csv
+import os
+
+import numpy as np
+
+def read_index(filename):
+    """Reads the shards of a simulation with sharded logging.
+
+    `filename` is the <simulation name>.index file in the log directory.
+    Returns a dict with the "<logger>/<column>" names as keys and read-only
+    views into the memory mapped shards as values, without copying the data.
+    """
+    directory = os.path.dirname(filename)
+    with open(filename, newline='') as f:
+        entries = list(csv.DictReader(f))
+
+    # The time column is the first column of every shard
+    shards = {}
+    for entry in entries:
+        offset, stride = int(entry['offset']), int(entry['stride'])
+        base, _ = shards.get(entry['shard'], (offset, stride))
+        shards[entry['shard']] = (min(base, offset), stride)
+
+    matrices = {}
+    for shard, (base, stride) in shards.items():
+        path = os.path.join(directory, shard)
+        rows = (os.path.getsize(path) - base) // stride
+        matrices[shard] = np.memmap(path, dtype = np.float64, mode = 'r', offset = base,
+            shape = (rows, stride // 8))
+
+    columns = {}
+    for entry in entries:
+        base, _ = shards[entry['shard']]
+        columns[entry['column']] = matrices[entry['shard']][:, (int(entry['offset']) - base) // 8]
+    return columns
@@ -0,0 +1,63 @@
+import mmap
+import os
+import struct
+import time
+
+import numpy as np
+
+# Layout of SharedMemoryLoggerBackend::Header
+_HEADER = struct.Struct('<8sIIQQQQQQ')
+_SEQUENCE_OFFSET = 48
+_WRITE_INDEX_OFFSET = 56
+
+class SharedMemoryReader:
+    """Reads the ring buffer of a logger with a SharedMemoryLoggerBackend.
+
+    The logger with the name `name` writes to /dev/shm/`name`.shm.
+    """
+
+    def __init__(self, name, timeout = 10.0):
+        path = os.path.join('/dev/shm', name + '.shm')
+        deadline = time.monotonic() + timeout
+        while True:
+            if os.path.exists(path) and os.path.getsize(path) >= _HEADER.size:
+                with open(path, 'rb') as f:
+                    self._map = mmap.mmap(f.fileno(), 0, prot = mmap.PROT_READ)
+                if self._sequence() % 2 == 0 and self._sequence() > 0:
+                    break
+                self._map.close()
+            if time.monotonic() > deadline:
+                raise TimeoutError('No columns in shared memory logger ' + name)
+            time.sleep(0.01)
+
+        magic, version, self.num_columns, self.capacity, names_offset, names_size, data_offset, _, _ = \
+            _HEADER.unpack_from(self._map, 0)
+        if magic != b'DPSIMRB\0' or version != 1:
+            raise ValueError('Unsupported shared memory logger ' + name)
+
+        names = self._map[names_offset:names_offset + names_size - 1]
+        self.columns = names.decode().split(',')
+        self._data = np.frombuffer(self._map, dtype = np.float64,
+            count = self.capacity * self.num_columns, offset = data_offset).reshape(self.capacity, self.num_columns)
+
+    def _sequence(self):
+        return struct.unpack_from('<Q', self._map, _SEQUENCE_OFFSET)[0]
+
+    def write_index(self):
+        """Number of rows written so far"""
+        return struct.unpack_from('<Q', self._map, _WRITE_INDEX_OFFSET)[0]
+
+    def latest(self, n):
+        """Returns a copy of up to the latest n rows, one column per logged value with the time first"""
+        end = self.write_index()
+        begin = max(0, end - min(n, self.capacity))
+        slots = np.arange(begin, end) % self.capacity
+        rows = self._data[slots]
+
+        # Rows the writer may have overwritten while copying
+        valid = max(begin, self.write_index() - self.capacity + 1)
+        return rows[valid - begin:]
+
+    def close(self):
+        self._data = None
+        self._map.close()
@@ -0,0 +1,74 @@
+import concurrent.futures
+import itertools
+import os
+
+def grid(**axes):
+    """Returns the parameter sets of the cartesian product of the given values.
+
+    grid(load = [1e6, 2e6], fault = [0.1, 0.2]) yields four dicts with the keys
+    "load" and "fault".
+    """
+    names = list(axes)
+    return [dict(zip(names, values)) for values in itertools.product(*(axes[name] for name in names))]
+
+def _results(loggers):
+    """Columns of the loggers with an in-memory backend by logger name"""
+    results = {}
+    for logger in loggers:
+        backend = logger.backend
+        if hasattr(backend, 'to_dict'):
+            results[logger.name()] = backend.to_dict()
+        elif hasattr(backend, 'ring'):
+            results[logger.name()] = dict(zip(backend.column_names, backend.data().T))
+    return results
+
+def run(builder, parameters, template = None, num_workers = None):
+    """Runs one simulation per parameter set in worker threads of this process.
+
+    `builder(index, params, topology)` sets up the simulation of a parameter set
+    and returns it together with a list of its loggers. `topology` is a new
+    instance of `template`, a dpsimpy.ModelTemplate, or None without a template.
+    The instances of all parameter sets are created by the template in
+    parallel, so the model is only parsed once. The simulation names should
+    contain the index to keep their log files apart.
+
+    The simulations run with the GIL released, so the workers step them
+    concurrently. Yields (index, params, results) in the order in which the
+    simulations finish. `results` contains the columns of the loggers with a
+    ColumnarLoggerBackend or MemoryLoggerBackend as NumPy arrays, by logger
+    name. Other loggers write their files as usual.
+    """
+    parameters = list(parameters)
+    topologies = [None] * len(parameters)
+    if template is not None:
+        topologies = template.instantiate(len(parameters), parallel = True)
+
+    # Builders call into Python, only the runs are spread over the workers
+    scenarios = []
+    for index, params in enumerate(parameters):
+        simulation, loggers = builder(index, params, topologies[index])
+        scenarios.append((index, params, simulation, loggers))
+
+    def execute(scenario):
+        index, params, simulation, loggers = scenario
+        simulation.run()
+        return index, params, _results(loggers)
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers = num_workers or os.cpu_count()) as pool:
+        futures = [pool.submit(execute, scenario) for scenario in scenarios]
+        for future in concurrent.futures.as_completed(futures):
+            yield future.result()
+
+def rerun(simulation, loggers, parameters, start_time = 0.0):
+    """Runs one initialized simulation once per parameter set.
+
+    Each parameter set maps checkpoint keys of real state attributes, e.g.
+    "components/R1.R", to values. The simulation is reset before every run,
+    which keeps its solvers, factorizations and schedule and only updates the
+    stamps of the components owning the parameters, see Simulation.reset.
+    Yields (index, params, results) in order, with `results` as for run().
+    """
+    for index, params in enumerate(parameters):
+        simulation.reset(start_time, params)
+        simulation.run()
+        yield index, params, _results(loggers)